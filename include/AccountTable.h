@@ -0,0 +1,210 @@
+// AccountTable.h - Account PnL / position rows (pnl, pnlSingle, position, updatePortfolio) coalesced per field
+// SCOPE: Message thread builds AccountUpdates into an AccountQueue, one Redis Worker drains it into the table
+// and publishes the changed fields on its AccountTimer
+
+#pragma once
+
+#include <cfloat>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concurrentqueue.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tws_bridge {
+
+// account: risk dashboard feed - TWS:PNL:{ACCOUNT} (totals) and TWS:POSITION:{ACCOUNT}:{CONID} hashes
+struct AccountConfig {
+    bool enabled = false;
+    std::string id;                                 // "" = first account of managedAccounts
+    std::chrono::milliseconds interval{500};        // Changed fields of each row, at most once per interval
+};
+
+// Hash fields of a row (bit i of AccountUpdate::present / a row's dirty mask)
+enum class AccountField : std::uint8_t {
+    Position,
+    AverageCost,
+    MarketPrice,
+    MarketValue,
+    DailyPnl,
+    UnrealizedPnl,
+    RealizedPnl,
+    Value,
+    Count
+};
+
+inline constexpr std::size_t kAccountFieldCount = static_cast<std::size_t>(AccountField::Count);
+
+inline const char* accountFieldName(AccountField field) {
+    static constexpr const char* kNames[kAccountFieldCount] = {
+        "position", "avgCost", "marketPrice", "marketValue", "dailyPnl", "unrealizedPnl", "realizedPnl", "value"};
+    return kNames[static_cast<std::size_t>(field)];
+}
+
+// One callback's worth of fields for one row
+struct AccountUpdate {
+    std::string account;
+    int conId = 0;                                  // 0 = account totals (pnl)
+    std::string symbol;                             // Positions: contract symbol, "" = unchanged
+    std::uint16_t present = 0;                      // Bit per AccountField carried
+    double values[kAccountFieldCount] = {};
+
+    void set(AccountField field, double value) {
+        const std::size_t index = static_cast<std::size_t>(field);
+        values[index] = value;
+        present = static_cast<std::uint16_t>(present | (1u << index));
+    }
+
+    // REASON: TWS sends DBL_MAX for a value it does not know (yet) - left out, the row keeps its last one
+    void setReported(AccountField field, double value) {
+        if (value != DBL_MAX) {
+            set(field, value);
+        }
+    }
+};
+
+// BACKPRESSURE: Unbounded - a few updates per position per second at most (pnlSingle is ~1/s per position)
+using AccountQueue = moodycamel::ConcurrentQueue<AccountUpdate>;
+
+// Latest value of every field per row, with a dirty bit per field changed since the last flush
+// PERFORMANCE: pnlSingle ticks about once a second per position and updatePortfolio repeats what it
+// already said - a row is written once per interval with only the fields whose value moved, one HSET each
+// NOTE: Rows are never removed - a closed position keeps its hash with position 0
+class AccountTable {
+public:
+    // false if nothing changed (every field carried equals the stored value)
+    bool apply(const AccountUpdate& update) {
+        Row& row = rowFor(update.account, update.conId);
+        std::uint16_t changed = 0;
+        for (std::size_t i = 0; i < kAccountFieldCount; ++i) {
+            const std::uint16_t bit = static_cast<std::uint16_t>(1u << i);
+            if ((update.present & bit) == 0) {
+                continue;
+            }
+            const double value = update.values[i];
+            // REASON: NaN != NaN - an unchanged NaN would otherwise be rewritten every interval
+            const bool same = (row.known & bit) != 0
+                && (row.values[i] == value || (std::isnan(row.values[i]) && std::isnan(value)));
+            if (!same) {
+                row.values[i] = value;
+                row.known = static_cast<std::uint16_t>(row.known | bit);
+                changed = static_cast<std::uint16_t>(changed | bit);
+            }
+        }
+        const bool renamed = !update.symbol.empty() && update.symbol != row.symbol;
+        if (renamed) {
+            row.symbol = update.symbol;
+            row.symbolDirty = true;
+        }
+        row.dirty = static_cast<std::uint16_t>(row.dirty | changed);
+        const bool dirty = row.dirty != 0 || row.symbolDirty;
+        if (dirty && !row.listed) {
+            row.listed = true;
+            m_dirty.push_back(static_cast<std::uint32_t>(&row - m_rows.data()));
+        }
+        return changed != 0 || renamed;
+    }
+
+    // Calls hashSet(key, payload) once per row with changed fields (payload: "field\nvalue\n..." - the
+    // RedisCommand::HashSet layout), returns the number of rows written
+    template <typename HashSet>
+    std::size_t flush(HashSet&& hashSet) {
+        std::size_t rows = 0;
+        for (std::uint32_t index : m_dirty) {
+            Row& row = m_rows[index];
+            row.listed = false;
+            if (row.dirty == 0 && !row.symbolDirty) {
+                continue;
+            }
+            m_payload.clear();
+            if (row.symbolDirty) {
+                appendPart(m_payload, "symbol");
+                appendPart(m_payload, row.symbol);
+            }
+            for (std::size_t i = 0; i < kAccountFieldCount; ++i) {
+                if ((row.dirty & (1u << i)) != 0) {
+                    appendPart(m_payload, accountFieldName(static_cast<AccountField>(i)));
+                    appendValue(m_payload, row.values[i]);
+                }
+            }
+            row.dirty = 0;
+            row.symbolDirty = false;
+            hashSet(row.key, std::string_view(m_payload));
+            ++rows;
+        }
+        m_dirty.clear();
+        return rows;
+    }
+
+    std::size_t rows() const { return m_rows.size(); }
+
+    // TWS:PNL:{ACCOUNT} / TWS:POSITION:{ACCOUNT}:{CONID}
+    static std::string rowKey(std::string_view account, int conId) {
+        std::string key = conId == 0 ? "TWS:PNL:" : "TWS:POSITION:";
+        key.append(account.data(), account.size());
+        if (conId != 0) {
+            key += ':';
+            key += std::to_string(conId);
+        }
+        return key;
+    }
+
+private:
+    struct Row {
+        std::string key;                            // Built once
+        std::string symbol;
+        double values[kAccountFieldCount] = {};
+        std::uint16_t known = 0;                    // Fields ever received
+        std::uint16_t dirty = 0;                    // Changed since the last flush
+        bool symbolDirty = false;
+        bool listed = false;                        // In m_dirty
+    };
+
+    // PERFORMANCE: (account index, conId) as one integer - no key string built per update
+    Row& rowFor(const std::string& account, int conId) {
+        std::uint32_t accountIndex = 0;
+        while (accountIndex < m_accounts.size() && m_accounts[accountIndex] != account) {
+            ++accountIndex;
+        }
+        if (accountIndex == m_accounts.size()) {
+            m_accounts.push_back(account);
+        }
+        const std::uint64_t id = (static_cast<std::uint64_t>(accountIndex) << 32) | static_cast<std::uint32_t>(conId);
+        const auto it = m_index.find(id);
+        if (it != m_index.end()) {
+            return m_rows[it->second];
+        }
+        m_index.emplace(id, m_rows.size());
+        Row row;
+        row.key = rowKey(account, conId);
+        m_rows.push_back(std::move(row));
+        return m_rows.back();
+    }
+
+    static void appendPart(std::string& out, std::string_view part) {
+        if (!out.empty()) {
+            out += '\n';
+        }
+        out.append(part.data(), part.size());
+    }
+
+    // Shortest round-trip digits, "nan" / "inf" as Redis would print them
+    static void appendValue(std::string& out, double value) {
+        char text[32];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        appendPart(out, std::string_view(text, static_cast<std::size_t>(result.ptr - text)));
+    }
+
+    std::vector<std::string> m_accounts;            // Usually one (linear search)
+    std::unordered_map<std::uint64_t, std::size_t> m_index;
+    std::vector<Row> m_rows;
+    std::vector<std::uint32_t> m_dirty;             // Row indices with pending fields
+    std::string m_payload;                          // REASON: Reused for every HSET payload
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,83 @@
+// AdaptiveBatch.h - Queue-depth-driven batch and pipeline sizing for the Redis Worker loop
+// SCOPE: Redis Worker thread only (one AdaptiveBatcher per worker)
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace tws_bridge {
+
+// Replaces the fixed worker.batch_size / redis.batch.max_messages with limits that follow the backlog
+struct AdaptiveBatchConfig {
+    bool enabled = false;
+    std::size_t maxBatch = 4096;                    // Dequeue limit ceiling (updates per loop iteration)
+    std::size_t maxPipeline = 1024;                 // Pipeline ceiling (messages per round trip)
+    std::chrono::microseconds maxAddedLatency{500}; // Oldest buffered message never waits longer for its flush
+};
+
+/**
+ * Calm market: the queue is empty after every drain, limits stay at their base (worker.batch_size,
+ * redis.batch.max_messages) and every batch is flushed at once - lowest latency.
+ * Burst: while updates are left behind, both limits double per batch up to their ceiling and
+ * flushes wait for a full pipeline - bigger batches conflate more symbols, bigger pipelines cost
+ * fewer round trips. The queue running empty resets both.
+ *
+ * BACKPRESSURE: A flush forced by maxAddedLatency halves the pipeline limit - the burst is not
+ * draining fast enough for the latency budget, so buffering more would only add delay
+ */
+class AdaptiveBatcher {
+public:
+    AdaptiveBatcher(const AdaptiveBatchConfig& config, std::size_t baseBatch, std::size_t basePipeline)
+        : m_config(config)
+        , m_baseBatch(std::max<std::size_t>(baseBatch, 1))
+        , m_basePipeline(std::max<std::size_t>(basePipeline, 1))
+        , m_batchLimit(m_baseBatch)
+        , m_pipelineLimit(m_basePipeline) {
+        m_config.maxBatch = std::max(m_config.maxBatch, m_baseBatch);
+        m_config.maxPipeline = std::max(m_config.maxPipeline, m_basePipeline);
+    }
+
+    std::size_t batchLimit() const { return m_batchLimit; }
+    std::size_t pipelineLimit() const { return m_pipelineLimit; }
+    std::size_t maxBatch() const { return m_config.maxBatch; }
+
+    // After a drained batch: backlog = updates still queued (size_approx, 0 = caught up)
+    void observe(std::size_t backlog) {
+        if (backlog == 0) {
+            m_batchLimit = m_baseBatch;
+            m_pipelineLimit = m_basePipeline;
+            return;
+        }
+        // REASON: Grow only while the queue holds more than one batch - a small remainder is next batch's
+        if (backlog >= m_batchLimit) {
+            m_batchLimit = std::min(m_batchLimit * 2, m_config.maxBatch);
+        }
+        m_pipelineLimit = std::min(m_pipelineLimit * 2, m_config.maxPipeline);
+    }
+
+    // Flush the pending pipeline now? pendingAge = time since the oldest pending message was buffered
+    bool flushDue(std::size_t backlog, std::size_t pending, std::chrono::steady_clock::duration pendingAge) {
+        if (pending == 0) {
+            return false;
+        }
+        if (backlog == 0 || pending >= m_pipelineLimit) {
+            return true;
+        }
+        if (pendingAge >= m_config.maxAddedLatency) {
+            m_pipelineLimit = std::max(m_pipelineLimit / 2, m_basePipeline);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    AdaptiveBatchConfig m_config;
+    std::size_t m_baseBatch;
+    std::size_t m_basePipeline;
+    std::size_t m_batchLimit;
+    std::size_t m_pipelineLimit;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,192 @@
+// AllocationTracker.h - Per-thread heap allocation counters and the no-alloc hot-path guard
+// SCOPE: Counters are fed by the global operator new of src/AllocationHook.cpp (cmake -DTWS_BRIDGE_ALLOC_HOOK=ON);
+// without the hook every count stays 0 and nothing here costs more than a thread_local read
+
+#pragma once
+
+#include <sys/prctl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace tws_bridge {
+
+// What an allocation inside an AllocationGuard does once the guard is armed
+enum class AllocationGuardMode : std::uint8_t {
+    Off,    // Not checked (also: still warming up)
+    Count,  // tws_bridge_hot_allocations_total only
+    Log,    // Counted + one stderr line per power-of-two count per thread
+    Abort   // Counted + stderr line + std::abort() (core dump at the allocating call)
+};
+
+struct AllocationConfig {
+    AllocationGuardMode guard = AllocationGuardMode::Log;
+    std::chrono::milliseconds warmup{10000};        // After all connections are ready - pools, maps and buffers fill first
+};
+
+// One per thread name: threads that share a name (reconnects, tws-msg-N restarts) share the counters
+struct AllocationCounters {
+    char thread[16] = {};
+    std::atomic<bool> named{false};                 // thread is written (readers skip the slot until then)
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> hotAllocations{0};   // Inside an armed AllocationGuard
+};
+
+namespace alloc_detail {
+
+inline constexpr std::size_t kMaxThreadNames = 128;
+
+struct AllocationState {
+    AllocationCounters slots[kMaxThreadNames];
+    AllocationCounters overflow;                    // Names beyond kMaxThreadNames
+    std::atomic<std::size_t> used{0};
+    std::atomic<AllocationGuardMode> mode{AllocationGuardMode::Off};
+    std::atomic<bool> installed{false};             // Set by AllocationHook.cpp's static initializer
+};
+
+// PITFALL: Everything the hook touches is constant-initialized and trivially destructible - a lazily
+// constructed object would itself allocate, or be used before / after its lifetime by static init / exit
+inline AllocationState g_state;
+inline thread_local AllocationCounters* t_counters = nullptr;
+inline thread_local std::uint32_t t_hotDepth = 0;
+
+// REASON: prctl, not pthread_getname_np - no allocation, no /proc read
+inline AllocationCounters* claimCounters() {
+    char name[16] = {};
+    ::prctl(PR_GET_NAME, name, 0, 0, 0);
+    const std::size_t used = std::min(g_state.used.load(std::memory_order_acquire), kMaxThreadNames);
+    for (std::size_t i = 0; i < used; ++i) {
+        AllocationCounters& slot = g_state.slots[i];
+        if (slot.named.load(std::memory_order_acquire) && std::strncmp(slot.thread, name, sizeof(name)) == 0) {
+            return &slot;
+        }
+    }
+    const std::size_t index = g_state.used.fetch_add(1, std::memory_order_acq_rel);
+    if (index >= kMaxThreadNames) {
+        return &g_state.overflow;
+    }
+    // NOTE: Two threads naming themselves alike at once may claim two slots - the collector merges by name
+    AllocationCounters& slot = g_state.slots[index];
+    std::memcpy(slot.thread, name, sizeof(name));
+    slot.named.store(true, std::memory_order_release);
+    return &slot;
+}
+
+inline void writeStderr(const char* text) {
+    const ssize_t ignored = ::write(STDERR_FILENO, text, std::strlen(text));
+    (void)ignored;
+}
+
+inline void onHotAllocation(AllocationCounters& counters, std::size_t bytes) {
+    const AllocationGuardMode mode = g_state.mode.load(std::memory_order_relaxed);
+    if (mode == AllocationGuardMode::Off) {
+        return;
+    }
+    const std::uint64_t count = counters.hotAllocations.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (mode == AllocationGuardMode::Count) {
+        return;
+    }
+    // PERFORMANCE: 1, 2, 4, 8 ... per thread - a regression in a per-tick path cannot flood stderr
+    if (mode == AllocationGuardMode::Abort || (count & (count - 1)) == 0) {
+        // REASON: Formatted by hand - the hook must not allocate while reporting an allocation
+        char line[128] = "[ALLOC] Hot-path allocation on ";
+        std::strcat(line, counters.thread);         // NOTE: Always NUL-terminated (PR_GET_NAME, 16 bytes)
+        std::strcat(line, ": ");
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        *--end = '\0';
+        std::size_t value = bytes;
+        do {
+            *--end = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        std::strcat(line, end);
+        std::strcat(line, " bytes\n");
+        writeStderr(line);
+    }
+    if (mode == AllocationGuardMode::Abort) {
+        std::abort();
+    }
+}
+
+} // namespace alloc_detail
+
+// Called by the operator new hook for every allocation of the calling thread
+inline void recordAllocation(std::size_t bytes) {
+    using namespace alloc_detail;
+    if (!t_counters) {
+        t_counters = claimCounters();
+    }
+    t_counters->allocations.fetch_add(1, std::memory_order_relaxed);
+    t_counters->bytes.fetch_add(bytes, std::memory_order_relaxed);
+    if (t_hotDepth != 0) {
+        onHotAllocation(*t_counters, bytes);
+    }
+}
+
+// nameCurrentThread(): the next allocation claims the counters of the new name
+inline void allocationThreadRenamed() {
+    alloc_detail::t_counters = nullptr;
+}
+
+inline bool allocationHookInstalled() {
+    return alloc_detail::g_state.installed.load(std::memory_order_relaxed);
+}
+
+// Arms / disarms every AllocationGuard (main: config.allocations.guard once warm-up is over)
+inline void setAllocationGuardMode(AllocationGuardMode mode) {
+    alloc_detail::g_state.mode.store(mode, std::memory_order_relaxed);
+}
+
+inline AllocationGuardMode allocationGuardMode() {
+    return alloc_detail::g_state.mode.load(std::memory_order_relaxed);
+}
+
+// Allocations of the calling thread so far (tests: difference around the code under test)
+inline std::uint64_t threadAllocations() {
+    const AllocationCounters* counters = alloc_detail::t_counters;
+    return counters ? counters->allocations.load(std::memory_order_relaxed) : 0;
+}
+
+// Every named counter slot, plus the overflow slot once it was used (thread "other")
+template <typename Fn>
+void forEachAllocationCounters(Fn&& fn) {
+    using namespace alloc_detail;
+    const std::size_t used = g_state.used.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < std::min(used, kMaxThreadNames); ++i) {
+        if (g_state.slots[i].named.load(std::memory_order_acquire)) {
+            fn(g_state.slots[i].thread, g_state.slots[i]);
+        }
+    }
+    if (used > kMaxThreadNames) {
+        fn("other", g_state.overflow);
+    }
+}
+
+/**
+ * Marks a section that must not allocate once warm (TWS tick callbacks, the worker's batch apply).
+ * Nestable; an allocation inside is handled per AllocationGuardMode.
+ *
+ * PERFORMANCE: Compiled in only with TWS_BRIDGE_ALLOC_GUARD (Debug builds with the hook) - otherwise
+ * an empty object, release hot paths pay nothing
+ */
+class AllocationGuard {
+public:
+#ifdef TWS_BRIDGE_ALLOC_GUARD
+    AllocationGuard() { ++alloc_detail::t_hotDepth; }
+    ~AllocationGuard() { --alloc_detail::t_hotDepth; }
+#else
+    AllocationGuard() {}  // REASON: User-provided - no unused-variable warning at the call sites
+#endif
+
+    AllocationGuard(const AllocationGuard&) = delete;
+    AllocationGuard& operator=(const AllocationGuard&) = delete;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,207 @@
+// AsyncLogger.h - Lock-free asynchronous logger (binary records, formatted off the hot path)
+// SCOPE: Any thread logs (TWS callbacks, Redis workers); one background thread formats and writes
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "SpscRing.h"
+
+namespace tws_bridge {
+
+enum class LogLevel : std::uint8_t {
+    Debug,
+    Info,
+    Warn,   // Warn and above go to stderr
+    Error,
+    Off
+};
+
+// One captured argument - numbers by value, strings copied inline (truncated)
+struct LogArg {
+    static constexpr std::size_t kInlineString = 23;  // REASON: 32-byte args, 2 per cache line
+
+    enum class Type : std::uint8_t { Int, Uint, Double, Bool, String };
+    Type type = Type::Int;
+    std::uint8_t length = 0;  // String bytes in s
+    union {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        bool b;
+        char s[kInlineString];
+    };
+
+    LogArg() {}  // PERFORMANCE: Uninitialized - capture() writes every field it reads back
+};
+
+// PERFORMANCE: Fixed-size POD record - capture is a few stores, formatting happens on the log thread
+struct LogRecord {
+    static constexpr std::size_t kMaxArgs = 6;
+
+    std::int64_t timestampUs = 0;         // Wall clock
+    const char* format = nullptr;         // PITFALL: Must be a string literal (outlives the record)
+    LogLevel level = LogLevel::Info;
+    std::uint8_t argCount = 0;
+    LogArg args[kMaxArgs];
+};
+
+// Per call site limit: at most one record per interval (extra calls are counted, not queued)
+class LogRateLimit {
+public:
+    explicit LogRateLimit(std::chrono::milliseconds interval) : m_intervalUs(interval.count() * 1000) {}
+
+    bool allow(std::int64_t nowUs) {
+        std::int64_t next = m_nextUs.load(std::memory_order_relaxed);
+        if (nowUs < next) {
+            m_suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        // REASON: One winner per interval when several threads hit the same site
+        return m_nextUs.compare_exchange_strong(next, nowUs + m_intervalUs, std::memory_order_relaxed);
+    }
+
+    std::uint64_t suppressed() const { return m_suppressed.load(std::memory_order_relaxed); }
+
+private:
+    const std::int64_t m_intervalUs;
+    std::atomic<std::int64_t> m_nextUs{0};
+    std::atomic<std::uint64_t> m_suppressed{0};
+};
+
+struct LoggerCounters {
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> dropped{0};   // BACKPRESSURE: Thread's ring full, record discarded
+};
+
+// Process-wide logger: "{}" placeholders, formatted by the background thread
+// CRITICAL PATH: A disabled level costs one relaxed load; an enabled record one clock read + one
+// SPSC ring push (each logging thread owns a ring, the log thread drains them all)
+class AsyncLogger {
+public:
+    static constexpr std::size_t kRingCapacity = 4096;  // Records per logging thread
+
+    static AsyncLogger& instance();
+
+    // Records logged before start() stay queued until it runs
+    void start();
+    // Drains every queued record, then joins the log thread
+    void stop();
+
+    void setLevel(LogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+    LogLevel level() const { return m_level.load(std::memory_order_relaxed); }
+    bool enabled(LogLevel level) const { return level >= m_level.load(std::memory_order_relaxed); }
+
+    template <typename... Args>
+    void log(LogLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= LogRecord::kMaxArgs, "Too many log arguments");
+        LogRecord record;
+        record.timestampUs = nowUs();
+        record.format = format;
+        record.level = level;
+        record.argCount = static_cast<std::uint8_t>(sizeof...(Args));
+        std::size_t index = 0;
+        (capture(record.args[index++], args), ...);
+        (void)index;
+        // PERFORMANCE: Thread-owned ring - no CAS, no shared cache line with other producers
+        if (!threadRing()->try_enqueue(record)) {
+            m_counters.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Formats one record into `out` (appends, no newline) - exposed for tests
+    static void format(const LogRecord& record, std::string& out);
+
+    const LoggerCounters& counters() const { return m_counters; }
+    // Rings registered so far (one per logging thread) - exposed for tests
+    std::size_t rings();
+
+    static std::int64_t nowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    AsyncLogger() = default;
+    ~AsyncLogger() { stop(); }
+
+    // The calling thread's ring, registered by its first record (cold, once per thread)
+    // PITFALL: Not inline in log() - a thread_local in the template would be one per argument pack, each
+    // with its own ring, and one thread's records would no longer drain in order
+    SpscRing<LogRecord>* threadRing();
+    SpscRing<LogRecord>* registerThread();
+
+    template <typename T>
+    static void capture(LogArg& arg, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            arg.type = LogArg::Type::Bool;
+            arg.b = value;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            arg.type = LogArg::Type::Double;
+            arg.d = static_cast<double>(value);
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            arg.type = LogArg::Type::Int;
+            arg.i = static_cast<std::int64_t>(value);
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            arg.type = LogArg::Type::Uint;
+            arg.u = static_cast<std::uint64_t>(value);
+        } else {
+            captureString(arg, std::string_view(value));
+        }
+    }
+
+    static void captureString(LogArg& arg, std::string_view text) {
+        arg.type = LogArg::Type::String;
+        const std::size_t length = text.size() < LogArg::kInlineString ? text.size() : LogArg::kInlineString;
+        std::memcpy(arg.s, text.data(), length);
+        arg.length = static_cast<std::uint8_t>(length);
+    }
+
+    void run();
+    std::size_t drain(std::string& line);
+
+    std::atomic<LogLevel> m_level{LogLevel::Info};
+    std::mutex m_ringsMutex;                                  // Registration + log thread snapshot (cold)
+    std::vector<std::unique_ptr<SpscRing<LogRecord>>> m_rings;  // REASON: Never freed - a ring outlives its thread's last record
+    std::vector<SpscRing<LogRecord>*> m_drainRings;           // Log thread copy of m_rings
+    LoggerCounters m_counters;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
+
+// ========== Logging Macros ==========
+// REASON: Level check before argument capture - a disabled statement evaluates nothing else
+#define BRIDGE_LOG(level, ...)                                                  \
+    do {                                                                        \
+        ::tws_bridge::AsyncLogger& bridgeLogger_ = ::tws_bridge::AsyncLogger::instance(); \
+        if (bridgeLogger_.enabled(level)) {                                     \
+            bridgeLogger_.log(level, __VA_ARGS__);                              \
+        }                                                                       \
+    } while (0)
+
+// At most one record per `intervalMs` from this call site (e.g. per-tick error paths)
+#define BRIDGE_LOG_EVERY_MS(intervalMs, level, ...)                             \
+    do {                                                                        \
+        ::tws_bridge::AsyncLogger& bridgeLogger_ = ::tws_bridge::AsyncLogger::instance(); \
+        static ::tws_bridge::LogRateLimit bridgeLogLimit_{std::chrono::milliseconds(intervalMs)}; \
+        if (bridgeLogger_.enabled(level) && bridgeLogLimit_.allow(::tws_bridge::AsyncLogger::nowUs())) { \
+            bridgeLogger_.log(level, __VA_ARGS__);                              \
+        }                                                                       \
+    } while (0)
+
+#define LOG_DEBUG(...) BRIDGE_LOG(::tws_bridge::LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...) BRIDGE_LOG(::tws_bridge::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...) BRIDGE_LOG(::tws_bridge::LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(...) BRIDGE_LOG(::tws_bridge::LogLevel::Error, __VA_ARGS__)
@@ -0,0 +1,172 @@
+// BarBuilder.h - Incremental OHLCV bars from tick-by-tick trades (AllLast)
+// SCOPE: Redis Worker thread - one builder per slot that trades, replaces reqRealTimeBars lines
+
+#pragma once
+
+#include "BarSize.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+// One bar under construction or closed
+struct BuiltBar {
+    std::int64_t start = 0;      // Bucket start (ms, epoch-aligned)
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+    std::int64_t volume = 0;
+    double notional = 0.0;       // Sum of price x size (wap = notional / volume)
+    std::uint32_t count = 0;     // Trades
+
+    double wap() const { return volume > 0 ? notional / static_cast<double>(volume) : close; }
+};
+
+// Last closed bars of one timeframe, newest first
+// PERFORMANCE: Fixed array, overwrite-oldest - no allocation after the builder exists
+class BarRing {
+public:
+    static constexpr std::size_t kCapacity = 64;
+
+    void push(const BuiltBar& bar) {
+        m_head = (m_head + 1) % kCapacity;
+        m_bars[m_head] = bar;
+        if (m_count < kCapacity) {
+            ++m_count;
+        }
+    }
+
+    std::size_t size() const { return m_count; }
+    // age 0 = most recent closed bar (age < size())
+    const BuiltBar& operator[](std::size_t age) const { return m_bars[(m_head + kCapacity - age) % kCapacity]; }
+
+private:
+    std::array<BuiltBar, kCapacity> m_bars{};
+    std::size_t m_head = kCapacity - 1;
+    std::size_t m_count = 0;
+};
+
+// All timeframes of one instrument
+// NOTE: Buckets without trades produce no bar (a quiet minute is a gap, not a zero-volume bar)
+class BarBuilder {
+public:
+    static constexpr std::size_t kMaxTimeframes = 4;
+
+    // Open bar of one timeframe, for StateCheckpoint.h (the closed bar history is not part of it)
+    struct FrameState {
+        BarSize size = BarSize::Unknown;
+        bool open = false;
+        std::int64_t closedUntil = 0;
+        BuiltBar bar;
+    };
+
+    // timeframes: first kMaxTimeframes sizes of at most one hour are used, others ignored
+    BarBuilder(const BarSize* timeframes, std::size_t count) {
+        for (std::size_t i = 0; i < count && m_count < kMaxTimeframes; ++i) {
+            const std::int64_t seconds = barSizeSeconds(timeframes[i]);
+            if (seconds > 0 && seconds <= 3600) {
+                m_frames[m_count].size = timeframes[i];
+                m_frames[m_count].lengthMs = seconds * 1000;
+                ++m_count;
+            }
+        }
+    }
+
+    // Folds one trade into every timeframe; a trade in a later bucket first closes the open bar
+    // onClose(BarSize, const BuiltBar&) runs for each closed bar
+    // false: trade is older than an open / closed bar (late, not applied)
+    template <typename OnClose>
+    bool addTrade(std::int64_t timestampMs, double price, std::int64_t size, OnClose&& onClose) {
+        bool applied = true;
+        for (std::size_t i = 0; i < m_count; ++i) {
+            Frame& frame = m_frames[i];
+            const std::int64_t start = bucketStart(timestampMs, frame.lengthMs);
+            if (start < frame.closedUntil || (frame.open && start < frame.bar.start)) {
+                applied = false;  // REASON: Its bar was already published
+                continue;
+            }
+            if (frame.open && start != frame.bar.start) {
+                close(frame, onClose);
+            }
+            BuiltBar& bar = frame.bar;
+            if (!frame.open) {
+                frame.open = true;
+                bar = BuiltBar{};
+                bar.start = start;
+                bar.open = bar.high = bar.low = price;
+            }
+            bar.high = price > bar.high ? price : bar.high;
+            bar.low = price < bar.low ? price : bar.low;
+            bar.close = price;
+            bar.volume += size;
+            bar.notional += price * static_cast<double>(size);
+            ++bar.count;
+        }
+        return applied;
+    }
+
+    // Closes open bars whose bucket ended at least graceMs before nowMs (quiet instruments)
+    // REASON: graceMs absorbs trades TWS stamps before the boundary but delivers after it
+    template <typename OnClose>
+    void closeExpired(std::int64_t nowMs, std::int64_t graceMs, OnClose&& onClose) {
+        for (std::size_t i = 0; i < m_count; ++i) {
+            Frame& frame = m_frames[i];
+            if (frame.open && frame.bar.start + frame.lengthMs + graceMs <= nowMs) {
+                close(frame, onClose);
+            }
+        }
+    }
+
+    std::size_t timeframes() const { return m_count; }
+    BarSize timeframe(std::size_t index) const { return m_frames[index].size; }
+    const BarRing& history(std::size_t index) const { return m_frames[index].history; }
+
+    FrameState frameState(std::size_t index) const {
+        const Frame& frame = m_frames[index];
+        return {frame.size, frame.open, frame.closedUntil, frame.bar};
+    }
+
+    // Resumes the timeframe of the same size (ignored when that size is no longer configured)
+    // REASON: closedUntil comes along - a trade for an already published bar stays late after a restart
+    void restoreFrame(const FrameState& state) {
+        for (std::size_t i = 0; i < m_count; ++i) {
+            Frame& frame = m_frames[i];
+            if (state.size != BarSize::Unknown && frame.size == state.size) {
+                frame.open = state.open;
+                frame.closedUntil = state.closedUntil;
+                frame.bar = state.bar;
+                return;
+            }
+        }
+    }
+
+private:
+    struct Frame {
+        BarSize size = BarSize::Unknown;
+        std::int64_t lengthMs = 0;
+        std::int64_t closedUntil = 0;  // End of the last closed bar (later trades before it are late)
+        bool open = false;
+        BuiltBar bar;
+        BarRing history;
+    };
+
+    static std::int64_t bucketStart(std::int64_t timestampMs, std::int64_t lengthMs) {
+        const std::int64_t offset = timestampMs % lengthMs;
+        return timestampMs - (offset < 0 ? offset + lengthMs : offset);
+    }
+
+    template <typename OnClose>
+    void close(Frame& frame, OnClose& onClose) {
+        frame.open = false;
+        frame.closedUntil = frame.bar.start + frame.lengthMs;
+        frame.history.push(frame.bar);
+        onClose(frame.size, frame.bar);
+    }
+
+    std::array<Frame, kMaxTimeframes> m_frames{};
+    std::size_t m_count = 0;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,76 @@
+// BarSize.h - Compact bar duration codes (TickUpdate::flags bits 2-6 of Bar updates)
+// SCOPE: TwsClient (subscribe time: TWS barSize string → code), Redis Worker (bar store keys)
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace tws_bridge {
+
+// REASON: TickUpdate has no spare bytes - a 5-bit code names every TWS bar size
+enum class BarSize : std::uint8_t {
+    Unknown = 0,
+    Sec1, Sec5, Sec10, Sec15, Sec30,
+    Min1, Min2, Min3, Min5, Min10, Min15, Min20, Min30,
+    Hour1, Hour2, Hour3, Hour4, Hour8,
+    Day1, Week1, Month1,
+    Count
+};
+
+namespace bar_size_detail {
+
+struct BarSizeInfo {
+    const char* tws;       // reqHistoricalData barSize setting
+    const char* label;     // Redis key suffix
+    std::int64_t seconds;  // Nominal duration (month = 30 days)
+};
+
+inline constexpr BarSizeInfo kBarSizes[] = {
+    {"", "", 0},
+    {"1 secs", "1s", 1}, {"5 secs", "5s", 5}, {"10 secs", "10s", 10}, {"15 secs", "15s", 15},
+    {"30 secs", "30s", 30},
+    {"1 min", "1m", 60}, {"2 mins", "2m", 120}, {"3 mins", "3m", 180}, {"5 mins", "5m", 300},
+    {"10 mins", "10m", 600}, {"15 mins", "15m", 900}, {"20 mins", "20m", 1200}, {"30 mins", "30m", 1800},
+    {"1 hour", "1h", 3600}, {"2 hours", "2h", 7200}, {"3 hours", "3h", 10800}, {"4 hours", "4h", 14400},
+    {"8 hours", "8h", 28800},
+    {"1 day", "1d", 86400}, {"1 week", "1w", 7 * 86400}, {"1 month", "1M", 30 * 86400},
+};
+
+static_assert(sizeof(kBarSizes) / sizeof(kBarSizes[0]) == static_cast<std::size_t>(BarSize::Count),
+              "kBarSizes out of sync with BarSize");
+
+} // namespace bar_size_detail
+
+inline constexpr std::size_t kBarSizeCount = static_cast<std::size_t>(BarSize::Count);
+
+// "5 mins" → Min5 (Unknown if not a TWS bar size); "1 sec" / "1 secs" both accepted
+inline BarSize barSizeFromTws(std::string_view setting) {
+    for (std::size_t i = 1; i < kBarSizeCount; ++i) {
+        const std::string_view tws = bar_size_detail::kBarSizes[i].tws;
+        if (setting == tws || (tws.back() == 's' && setting == tws.substr(0, tws.size() - 1))) {
+            return static_cast<BarSize>(i);
+        }
+    }
+    return BarSize::Unknown;
+}
+
+// reqRealTimeBars barSize (seconds) → code
+inline BarSize barSizeFromSeconds(std::int64_t seconds) {
+    for (std::size_t i = 1; i < kBarSizeCount; ++i) {
+        if (bar_size_detail::kBarSizes[i].seconds == seconds) {
+            return static_cast<BarSize>(i);
+        }
+    }
+    return BarSize::Unknown;
+}
+
+inline const char* barSizeLabel(BarSize size) {
+    return bar_size_detail::kBarSizes[static_cast<std::size_t>(size) < kBarSizeCount ? static_cast<std::size_t>(size) : 0].label;
+}
+
+inline std::int64_t barSizeSeconds(BarSize size) {
+    return bar_size_detail::kBarSizes[static_cast<std::size_t>(size) < kBarSizeCount ? static_cast<std::size_t>(size) : 0].seconds;
+}
+
+} // namespace tws_bridge
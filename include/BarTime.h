@@ -0,0 +1,230 @@
+// BarTime.h - Bar.time parser (reqHistoricalData) → Unix ms
+// SCOPE: TwsClient message thread (historicalData callbacks) and BridgeReader dispatch (HISTORICAL_DATA
+// fast path), one parser per owner
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tws_bridge {
+
+namespace bar_time_detail {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's days_from_civil)
+constexpr std::int64_t daysFromCivil(int year, unsigned month, unsigned day) {
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+// 0 = Sunday
+constexpr unsigned weekday(std::int64_t days) {
+    return static_cast<unsigned>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+}
+
+// nth (1-based) Sunday of a month, or the last one (nth = 0)
+constexpr std::int64_t sunday(int year, unsigned month, unsigned nth) {
+    if (nth == 0) {
+        const std::int64_t last = month == 12 ? daysFromCivil(year, 12, 31) : daysFromCivil(year, month + 1, 1) - 1;
+        return last - weekday(last);
+    }
+    const std::int64_t first = daysFromCivil(year, month, 1);
+    return first + (7 - weekday(first)) % 7 + 7 * (nth - 1);
+}
+
+} // namespace bar_time_detail
+
+// Daylight saving rule of a zone
+enum class DstRule : std::uint8_t {
+    None,
+    UnitedStates,  // 2nd Sunday March 02:00 local → 1st Sunday November 02:00 local
+    Europe         // Last Sunday March 01:00 UTC → last Sunday October 01:00 UTC
+};
+
+struct TimeZoneInfo {
+    const char* name;
+    std::int32_t standardOffset;  // Seconds east of UTC
+    DstRule dst;
+};
+
+// REASON: Zones TWS reports for the venues we trade - no tz database dependency
+// NOTE: Unknown zones fail to parse (caller falls back), add rows as new venues come up
+inline constexpr TimeZoneInfo kTimeZones[] = {
+    {"US/Eastern", -5 * 3600, DstRule::UnitedStates},
+    {"America/New_York", -5 * 3600, DstRule::UnitedStates},
+    {"EST5EDT", -5 * 3600, DstRule::UnitedStates},
+    {"US/Central", -6 * 3600, DstRule::UnitedStates},
+    {"America/Chicago", -6 * 3600, DstRule::UnitedStates},
+    {"US/Mountain", -7 * 3600, DstRule::UnitedStates},
+    {"America/Denver", -7 * 3600, DstRule::UnitedStates},
+    {"US/Pacific", -8 * 3600, DstRule::UnitedStates},
+    {"America/Los_Angeles", -8 * 3600, DstRule::UnitedStates},
+    {"Europe/London", 0, DstRule::Europe},
+    {"GB", 0, DstRule::Europe},
+    {"Europe/Berlin", 3600, DstRule::Europe},
+    {"Europe/Paris", 3600, DstRule::Europe},
+    {"Europe/Amsterdam", 3600, DstRule::Europe},
+    {"Europe/Zurich", 3600, DstRule::Europe},
+    {"MET", 3600, DstRule::Europe},
+    {"CET", 3600, DstRule::Europe},
+    {"Asia/Tokyo", 9 * 3600, DstRule::None},
+    {"Japan", 9 * 3600, DstRule::None},
+    {"Asia/Hong_Kong", 8 * 3600, DstRule::None},
+    {"Hongkong", 8 * 3600, DstRule::None},
+    {"UTC", 0, DstRule::None},
+    {"GMT", 0, DstRule::None},
+    {"Etc/UTC", 0, DstRule::None},
+};
+
+// Parses the Bar.time formats TWS sends:
+// - "1700000000"                   formatDate=2 (intraday): Unix seconds
+// - "20240102"                     daily and longer bars: the date, stamped 00:00 UTC
+// - "20240102 09:30:00 US/Eastern" formatDate=1: local time in the named zone
+// - "20240102 09:30:00"            formatDate=1 without zone: defaultZone
+// - "20240102-14:30:00"            UTC
+// PERFORMANCE: No allocation, no libc time calls - the zone and its DST transitions for the
+// current year are cached, so a backfill pays one table scan and one transition calc per zone/year
+class BarTimeParser {
+public:
+    // defaultZone: zone of zone-less timestamps (the TWS login zone), must be in kTimeZones
+    explicit BarTimeParser(std::string_view defaultZone = "US/Eastern") {
+        m_defaultZone = findZone(defaultZone);
+    }
+
+    // false (epochMs untouched) if the text matches no format or names an unknown zone
+    bool parse(std::string_view text, std::int64_t& epochMs) {
+        while (!text.empty() && text.back() == ' ') {
+            text.remove_suffix(1);
+        }
+        std::int64_t seconds = 0;
+        if (text.size() > 8 && allDigits(text)) {
+            if (!digits(text, 0, text.size(), seconds)) {
+                return false;
+            }
+            epochMs = seconds * 1000;
+            return true;
+        }
+
+        std::int64_t year = 0, month = 0, day = 0;
+        if (text.size() < 8 || !digits(text, 0, 4, year) || !digits(text, 4, 2, month) || !digits(text, 6, 2, day)
+            || month < 1 || month > 12 || day < 1 || day > 31) {
+            return false;
+        }
+        const std::int64_t days = bar_time_detail::daysFromCivil(static_cast<int>(year),
+                                                                 static_cast<unsigned>(month),
+                                                                 static_cast<unsigned>(day));
+        if (text.size() == 8) {
+            epochMs = days * 86400 * 1000;
+            return true;
+        }
+
+        std::int64_t hour = 0, minute = 0, second = 0;
+        if (text.size() < 17 || (text[8] != ' ' && text[8] != '-') || text[11] != ':' || text[14] != ':'
+            || !digits(text, 9, 2, hour) || !digits(text, 12, 2, minute) || !digits(text, 15, 2, second)
+            || hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+        const std::int64_t wall = days * 86400 + hour * 3600 + minute * 60 + second;
+        if (text[8] == '-') {
+            if (text.size() != 17) {
+                return false;
+            }
+            epochMs = wall * 1000;
+            return true;
+        }
+
+        const TimeZoneInfo* zone = m_defaultZone;
+        if (text.size() > 17) {
+            if (text[17] != ' ') {
+                return false;
+            }
+            zone = cachedZone(text.substr(18));
+        }
+        if (!zone) {
+            return false;
+        }
+        epochMs = (wall - offsetAt(*zone, static_cast<int>(year), wall)) * 1000;
+        return true;
+    }
+
+    // Zone lookup (nullptr if unknown)
+    static const TimeZoneInfo* findZone(std::string_view name) {
+        for (const TimeZoneInfo& zone : kTimeZones) {
+            if (name == zone.name) {
+                return &zone;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    static bool allDigits(std::string_view text) {
+        for (char c : text) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool digits(std::string_view text, std::size_t pos, std::size_t count, std::int64_t& value) {
+        value = 0;
+        for (std::size_t i = pos; i < pos + count; ++i) {
+            const char c = text[i];
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    // PERFORMANCE: Consecutive bars name the same zone - compare against the last hit first
+    const TimeZoneInfo* cachedZone(std::string_view name) {
+        if (m_lastZone && name == m_lastZone->name) {
+            return m_lastZone;
+        }
+        const TimeZoneInfo* zone = findZone(name);
+        if (zone) {
+            m_lastZone = zone;
+        }
+        return zone;
+    }
+
+    // UTC offset in effect at a local wall-clock time (seconds since epoch, read as if UTC)
+    // NOTE: The repeated hour on the fall-back day resolves to daylight time
+    std::int32_t offsetAt(const TimeZoneInfo& zone, int year, std::int64_t wall) {
+        if (zone.dst == DstRule::None) {
+            return zone.standardOffset;
+        }
+        if (&zone != m_transitionZone || year != m_transitionYear) {
+            // REASON: Cached per zone/year - day-of-week math once per backfill, not per bar
+            m_transitionZone = &zone;
+            m_transitionYear = year;
+            if (zone.dst == DstRule::UnitedStates) {
+                m_dstStart = bar_time_detail::sunday(year, 3, 2) * 86400 + 2 * 3600;
+                m_dstEnd = bar_time_detail::sunday(year, 11, 1) * 86400 + 2 * 3600;
+            } else {
+                // 01:00 UTC in local wall time (standard before the switch, daylight before the end)
+                m_dstStart = bar_time_detail::sunday(year, 3, 0) * 86400 + 3600 + zone.standardOffset;
+                m_dstEnd = bar_time_detail::sunday(year, 10, 0) * 86400 + 3600 + zone.standardOffset + 3600;
+            }
+        }
+        const bool daylight = wall >= m_dstStart && wall < m_dstEnd;
+        return zone.standardOffset + (daylight ? 3600 : 0);
+    }
+
+    const TimeZoneInfo* m_defaultZone = nullptr;
+    const TimeZoneInfo* m_lastZone = nullptr;
+    const TimeZoneInfo* m_transitionZone = nullptr;
+    int m_transitionYear = 0;
+    std::int64_t m_dstStart = 0;  // Local wall seconds
+    std::int64_t m_dstEnd = 0;
+};
+
+} // namespace tws_bridge
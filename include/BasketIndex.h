@@ -0,0 +1,195 @@
+// BasketIndex.h - Weighted baskets of instruments (sector baskets, custom indexes) kept up to date
+// incrementally and published as synthetic instruments on TWS:TICKS:{BASKET}
+// SCOPE: BasketBook - Redis Workers (onTrade of the slots they own), any thread (values);
+// BasketPublisher - own thread + own Redis connection
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+struct BasketConstituent {
+    std::string symbol;
+    double weight = 0.0;
+};
+
+struct BasketDefinition {
+    std::string name;                               // Published as TWS:TICKS:{name}
+    std::vector<BasketConstituent> constituents;
+};
+
+// baskets: definitions + how often dirty baskets are published
+struct BasketConfig {
+    std::vector<BasketDefinition> baskets;
+    std::chrono::milliseconds interval{100};        // Publish cadence (a basket changed many times publishes once)
+    std::chrono::milliseconds socketTimeout{200};
+    std::chrono::milliseconds reconnectDelay{1000}; // Back-off after a Redis error
+};
+
+// "NAME=SYM:weight,SYM:weight,..." (baskets.definitions entry), false if malformed
+inline bool parseBasket(std::string_view text, BasketDefinition& out) {
+    const std::size_t equals = text.find('=');
+    if (equals == std::string_view::npos || equals == 0) {
+        return false;
+    }
+    out.name.assign(text.substr(0, equals));
+    out.constituents.clear();
+    text.remove_prefix(equals + 1);
+    while (!text.empty()) {
+        const std::size_t comma = text.find(',');
+        const std::string_view item = text.substr(0, comma);
+        text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+        const std::size_t colon = item.find(':');
+        if (colon == std::string_view::npos || colon == 0) {
+            return false;
+        }
+        BasketConstituent constituent;
+        constituent.symbol.assign(item.substr(0, colon));
+        const std::string_view weight = item.substr(colon + 1);
+        const std::from_chars_result result = std::from_chars(weight.data(), weight.data() + weight.size(),
+                                                              constituent.weight);
+        if (result.ec != std::errc() || result.ptr != weight.data() + weight.size() || !std::isfinite(constituent.weight)) {
+            return false;
+        }
+        out.constituents.push_back(std::move(constituent));
+    }
+    return !out.constituents.empty();
+}
+
+// Basket values as sums of fixed-point contributions (weight x last price, 1e-8 units)
+// PERFORMANCE:
+// - A trade costs one subtraction and one fetch_add per basket the symbol belongs to - O(1), never a
+//   re-sum of the constituents
+// - Fixed point: every contribution is replaced exactly, so the running sum never drifts (a double sum
+//   updated by deltas would accumulate rounding error over a session)
+// - Memberships are per slot and immutable after construction - workers read them without synchronization
+// PITFALL: Constituents must be registered before construction (slots resolved once) - main registers them
+class BasketBook {
+public:
+    static constexpr double kScale = 1e8;
+
+    BasketBook(InstrumentRegistry& registry, std::vector<BasketDefinition> baskets)
+        : m_definitions(std::move(baskets))
+        , m_baskets(std::make_unique<Basket[]>(m_definitions.size()))
+        , m_memberships(registry.capacity()) {
+        for (std::size_t basket = 0; basket < m_definitions.size(); ++basket) {
+            for (const BasketConstituent& constituent : m_definitions[basket].constituents) {
+                const SlotId slot = registry.registerInstrument(constituent.symbol);
+                if (slot == kInvalidSlot) {
+                    continue;  // NOTE: Registry full - the basket stays incomplete ("priced" tells)
+                }
+                m_memberships[slot].push_back(Membership{basket, constituent.weight, nullptr});
+            }
+        }
+        for (auto& memberships : m_memberships) {
+            for (Membership& membership : memberships) {
+                membership.contribution = std::make_unique<std::atomic<std::int64_t>>(kUnpriced);
+            }
+        }
+    }
+
+    BasketBook(const BasketBook&) = delete;
+    BasketBook& operator=(const BasketBook&) = delete;
+
+    // Owning worker of slot, on every live trade
+    void onTrade(SlotId slot, double price) {
+        if (slot >= m_memberships.size() || !std::isfinite(price)) {
+            return;
+        }
+        for (const Membership& membership : m_memberships[slot]) {
+            const auto contribution = static_cast<std::int64_t>(std::llround(membership.weight * price * kScale));
+            const std::int64_t previous = membership.contribution->exchange(contribution, std::memory_order_relaxed);
+            if (previous == contribution) {
+                continue;
+            }
+            Basket& basket = m_baskets[membership.basket];
+            if (previous == kUnpriced) {
+                basket.priced.fetch_add(1, std::memory_order_relaxed);
+                basket.value.fetch_add(contribution, std::memory_order_relaxed);
+            } else {
+                basket.value.fetch_add(contribution - previous, std::memory_order_relaxed);
+            }
+            basket.version.fetch_add(1, std::memory_order_release);  // NOTE: Marks it dirty for the publisher
+        }
+    }
+
+    bool contains(SlotId slot) const { return slot < m_memberships.size() && !m_memberships[slot].empty(); }
+
+    // ========== Any thread ==========
+    std::size_t size() const { return m_definitions.size(); }
+    const BasketDefinition& definition(std::size_t basket) const { return m_definitions[basket]; }
+    double value(std::size_t basket) const {
+        return static_cast<double>(m_baskets[basket].value.load(std::memory_order_relaxed)) / kScale;
+    }
+    std::size_t priced(std::size_t basket) const { return m_baskets[basket].priced.load(std::memory_order_relaxed); }
+    std::uint64_t version(std::size_t basket) const { return m_baskets[basket].version.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::int64_t kUnpriced = std::numeric_limits<std::int64_t>::min();
+
+    struct alignas(64) Basket {
+        std::atomic<std::int64_t> value{0};         // Sum of the priced constituents' contributions
+        std::atomic<std::uint32_t> priced{0};       // Constituents with a trade so far
+        std::atomic<std::uint64_t> version{0};      // Bumped per change
+    };
+
+    struct Membership {
+        std::size_t basket = 0;
+        double weight = 0.0;
+        // REASON: Atomic - a rebalanced slot's next trade may come from another worker
+        std::unique_ptr<std::atomic<std::int64_t>> contribution;
+    };
+
+    std::vector<BasketDefinition> m_definitions;
+    std::unique_ptr<Basket[]> m_baskets;
+    std::vector<std::vector<Membership>> m_memberships;  // By slot
+};
+
+// Lifetime counters (written by the publisher thread, readable from any thread)
+struct BasketCounters {
+    std::atomic<std::uint64_t> published{0};        // Basket snapshots
+    std::atomic<std::uint64_t> errors{0};
+};
+
+// Publishes every basket whose version moved since its last publish, once per interval, as one pipeline
+// ARCHITECTURE: Off the workers - a basket's constituents usually span shards, so no single worker can
+// own its publish order; conflating to the interval also bounds the output to one message per basket
+// per interval however busy its constituents are
+class BasketPublisher {
+public:
+    BasketPublisher(const std::string& uri, const BasketBook& book, BasketConfig config);
+    ~BasketPublisher();
+
+    BasketPublisher(const BasketPublisher&) = delete;
+    BasketPublisher& operator=(const BasketPublisher&) = delete;
+
+    void start();
+    void stop();
+
+    const BasketCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+
+    std::string m_uri;
+    const BasketBook& m_book;
+    BasketConfig m_config;
+    BasketCounters m_counters;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
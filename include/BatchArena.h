@@ -0,0 +1,95 @@
+// BatchArena.h - Monotonic arena for the temporaries of one drain-and-publish cycle
+// SCOPE: RedisPublisher pending batch (channel / payload copies), owned by one thread at a time
+
+#pragma once
+
+#include "PayloadPool.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+// PERFORMANCE: Copies are bump allocations into one reused block, reset() releases all of them in O(1)
+// REASON: A batch that outgrew the block (upstream heap) makes reset() grow the block to that high-water
+// mark, so the steady state never touches the allocator whatever the payload mix
+class BatchArena {
+public:
+    explicit BatchArena(std::size_t initialBytes = 64 * 1024)
+        : m_blockSize(initialBytes > 0 ? initialBytes : 1)
+        , m_block(new std::byte[m_blockSize]) {
+        m_resource.emplace(m_block.get(), m_blockSize, std::pmr::new_delete_resource());
+        m_referenced.reserve(16);
+    }
+
+    ~BatchArena() { releaseReferenced(); }
+
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    // Bytes stay valid until the next reset()
+    std::string_view copy(const char* data, std::size_t length) {
+        if (length == 0) {
+            return {};
+        }
+        char* bytes = static_cast<char*>(m_resource->allocate(length, 1));
+        std::memcpy(bytes, data, length);
+        m_used += length;
+        return {bytes, length};
+    }
+
+    // Bytes of a pooled payload instead of a copy: its block stays referenced until the next reset()
+    // PERFORMANCE: One reference per block, not per payload - consecutive payloads share the open block
+    std::string_view reference(const SharedPayload& payload) {
+        if (payload.block != m_lastReferenced) {
+            payload.block->retain();
+            m_referenced.push_back(payload.block);
+            m_lastReferenced = payload.block;
+        }
+        return payload.bytes;
+    }
+
+    // For std::pmr containers built during the batch (released with it)
+    std::pmr::memory_resource* resource() { return &*m_resource; }
+
+    // Drops every copy of the batch and its payload block references
+    void reset() {
+        releaseReferenced();
+        if (m_used > m_blockSize) {
+            // PITFALL: Only here - growing mid-batch would free bytes the pending messages still point to
+            m_resource.reset();
+            m_blockSize = m_used + m_used / 2;
+            m_block.reset(new std::byte[m_blockSize]);
+            ++m_grows;
+        }
+        m_resource.emplace(m_block.get(), m_blockSize, std::pmr::new_delete_resource());
+        m_used = 0;
+    }
+
+    std::size_t used() const { return m_used; }             // copy() bytes since the last reset()
+    std::size_t blockSize() const { return m_blockSize; }
+    std::size_t grows() const { return m_grows; }
+
+private:
+    void releaseReferenced() {
+        for (PayloadBlock* block : m_referenced) {
+            block->release();
+        }
+        m_referenced.clear();
+        m_lastReferenced = nullptr;
+    }
+
+    std::size_t m_blockSize;
+    std::unique_ptr<std::byte[]> m_block;
+    std::optional<std::pmr::monotonic_buffer_resource> m_resource;  // REASON: Not movable, re-emplaced on growth
+    std::size_t m_used = 0;
+    std::size_t m_grows = 0;
+    std::vector<PayloadBlock*> m_referenced;        // reference() blocks, released by reset()
+    PayloadBlock* m_lastReferenced = nullptr;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,220 @@
+// BinaryEncoder.h - Fixed-layout little-endian snapshot/bar encoding (BinaryWire.h), expanded from SnapshotFields.h
+// SCOPE: Redis Worker hot path, optional TWS:BIN:* channels alongside JSON
+
+#pragma once
+
+#include "BinaryWire.h"
+#include "MarketData.h"
+#include "SnapshotDelta.h"
+#include "SnapshotFields.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace binary_wire {
+
+// REASON: Byte-wise stores keep the format little-endian on any host (one mov on x86/ARM LE)
+template <typename T>
+inline char* storeLE(char* out, T value) {
+    static_assert(sizeof(T) <= sizeof(std::uint64_t), "storeLE supports up to 64-bit values");
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    return out + sizeof(T);
+}
+
+inline char* storeBytes(char* out, std::string_view value, std::size_t length) {
+    std::memcpy(out, value.data(), length);
+    return out + length;
+}
+
+inline char* storeHeader(char* out, Kind kind, std::uint8_t flags, std::size_t symbolLen, std::int32_t conId) {
+    out = storeLE(out, kVersion);
+    out = storeLE(out, static_cast<std::uint8_t>(kind));
+    out = storeLE(out, flags);
+    out = storeLE(out, static_cast<std::uint8_t>(symbolLen));
+    return storeLE(out, conId);
+}
+
+// ========== Table Expansion (SnapshotFields.h) ==========
+
+// Wire size of one row (String: length prefix only - the bytes follow)
+constexpr std::size_t fieldSize(tws_bridge::fields::FieldType type) {
+    using tws_bridge::fields::FieldType;
+    switch (type) {
+        case FieldType::String:
+            return 1;
+        case FieldType::Uint32:
+        case FieldType::Int32:
+        case FieldType::Quantity:
+            return 4;
+        case FieldType::Uint64:
+        case FieldType::Int64:
+        case FieldType::Price:
+        case FieldType::Double:
+        case FieldType::Conditions:
+            return 8;
+        default:
+            return 0;  // REASON: JSON-only rows, header flag (Bool), header length + trailer (Symbol)
+    }
+}
+
+template <tws_bridge::fields::FieldType Type, typename Value>
+inline char* storeField(char* out, const Value& value) {
+    using tws_bridge::fields::FieldType;
+    if constexpr (Type == FieldType::String) {
+        const std::size_t length = std::min(value.size(), kMaxStringSize);
+        out = storeLE(out, static_cast<std::uint8_t>(length));
+        return storeBytes(out, value, length);
+    } else if constexpr (Type == FieldType::Uint32) {
+        return storeLE(out, static_cast<std::uint32_t>(value));
+    } else if constexpr (Type == FieldType::Uint64 || Type == FieldType::Conditions) {
+        return storeLE(out, static_cast<std::uint64_t>(value));
+    } else if constexpr (Type == FieldType::Int32) {
+        return storeLE(out, static_cast<std::int32_t>(value));
+    } else if constexpr (Type == FieldType::Int64) {
+        return storeLE(out, static_cast<std::int64_t>(value));
+    } else if constexpr (Type == FieldType::Quantity) {
+        // SCOPE: Wire v1 keeps i32 whole-unit sizes - fractional sizes are JSON-only
+        const std::int64_t units = tws_bridge::wholeUnits(value);
+        constexpr std::int64_t kMax = std::numeric_limits<std::int32_t>::max();
+        return storeLE(out, static_cast<std::int32_t>(units > kMax ? kMax : units < -kMax ? -kMax : units));
+    } else {
+        static_assert(Type == FieldType::Price || Type == FieldType::Double, "FieldType without a binary layout");
+        return storeLE(out, static_cast<double>(value));
+    }
+}
+
+// Fixed body: rows marked binaryBody, in table order
+template <const auto& Table, typename Record>
+inline char* storeBody(char* out, const Record& record) {
+    using namespace tws_bridge::fields;
+    forEachField<Table>([&](auto index) {
+        constexpr auto& row = std::get<decltype(index)::value>(Table);
+        if constexpr (row.binaryBody) {
+            out = storeField<row.type>(out, row.get(record));
+        }
+    });
+    return out;
+}
+
+template <const auto& Table, std::size_t... I>
+constexpr std::size_t bodySize(std::index_sequence<I...>) {
+    return ((std::get<I>(Table).binaryBody ? fieldSize(std::get<I>(Table).type) : 0) + ... + 0);
+}
+
+// Delta fields: rows with a DeltaField bit, largest case (every bit set)
+template <std::size_t... I>
+constexpr std::size_t deltaFieldsSize(std::index_sequence<I...>) {
+    using namespace tws_bridge::fields;
+    return ((std::get<I>(kSnapshotFields).delta != kDeltaHeader ? fieldSize(std::get<I>(kSnapshotFields).type) : 0)
+            + ... + 0);
+}
+
+// PITFALL: v1 layouts are frozen - a table change that moves them needs a new kVersion
+static_assert(bodySize<tws_bridge::fields::kSnapshotFields>(
+                  std::make_index_sequence<tws_bridge::fields::kFieldCount<tws_bridge::fields::kSnapshotFields>>{})
+                  == kSnapshotBodySize,
+              "Binary snapshot body no longer matches wire format v1");
+static_assert(bodySize<tws_bridge::fields::kBarFields>(
+                  std::make_index_sequence<tws_bridge::fields::kFieldCount<tws_bridge::fields::kBarFields>>{})
+                  == kBarBodySize,
+              "Binary bar body no longer matches wire format v1");
+static_assert(DeltaBits::BidPrice == tws_bridge::DeltaField::BidPrice && DeltaBits::AskPrice == tws_bridge::DeltaField::AskPrice
+                  && DeltaBits::LastPrice == tws_bridge::DeltaField::LastPrice
+                  && DeltaBits::BidSize == tws_bridge::DeltaField::BidSize
+                  && DeltaBits::AskSize == tws_bridge::DeltaField::AskSize
+                  && DeltaBits::LastSize == tws_bridge::DeltaField::LastSize
+                  && DeltaBits::QuoteTime == tws_bridge::DeltaField::QuoteTime
+                  && DeltaBits::TradeTime == tws_bridge::DeltaField::TradeTime
+                  && DeltaBits::Exchange == tws_bridge::DeltaField::Exchange
+                  && DeltaBits::Conditions == tws_bridge::DeltaField::Conditions
+                  && DeltaBits::PastLimit == tws_bridge::DeltaField::PastLimit
+                  && DeltaBits::Derived == tws_bridge::DeltaField::Derived,
+              "Binary delta bits no longer match DeltaField");
+static_assert(deltaFieldsSize(std::make_index_sequence<tws_bridge::fields::kFieldCount<tws_bridge::fields::kSnapshotFields>>{})
+                  == kDeltaMaxFieldsSize,
+              "Binary delta fields no longer match wire format v1");
+
+} // namespace binary_wire
+
+/**
+ * @brief Encode InstrumentState as a v1 binary snapshot
+ *
+ * [PERFORMANCE] Fixed offsets, no number formatting. `out` keeps its capacity
+ * between calls (no allocation once warm).
+ */
+inline void encodeSnapshotBinary(const InstrumentState& state, std::string& out) {
+    using namespace binary_wire;
+
+    const std::size_t symbolLen = std::min(state.symbol.size(), kMaxStringSize);
+    const std::size_t exchangeLen = std::min(state.exchange.size(), kMaxStringSize);
+    const std::uint64_t sequence = state.sequence;
+    out.resize(kHeaderSize + kSnapshotBodySize + symbolLen + 1 + exchangeLen + (sequence != 0 ? 8 : 0));
+
+    char* p = &out[0];
+    const std::uint8_t flags = static_cast<std::uint8_t>((state.pastLimit ? Flags::PastLimit : 0)
+                                                         | (sequence != 0 ? Flags::Sequence : 0));
+    p = storeHeader(p, Kind::Snapshot, flags, symbolLen, static_cast<std::int32_t>(state.conId));
+    p = storeBody<tws_bridge::fields::kSnapshotFields>(p, state);
+    p = storeBytes(p, state.symbol, symbolLen);
+    p = storeLE(p, static_cast<std::uint8_t>(exchangeLen));
+    p = storeBytes(p, state.exchange, exchangeLen);
+    if (sequence != 0) {
+        storeLE(p, sequence);
+    }
+}
+
+/**
+ * @brief Encode the fields selected by `changed` (DeltaField bits) as a binary delta
+ *
+ * [PERFORMANCE] A quote tick is 58 bytes + symbol (snapshot: 69 + symbol + exchange), no unchanged fields
+ *
+ */
+inline void encodeSnapshotBinaryDelta(const InstrumentState& state, std::uint16_t changed, std::string& out) {
+    using namespace binary_wire;
+    using namespace tws_bridge::fields;
+
+    const std::size_t symbolLen = std::min(state.symbol.size(), kMaxStringSize);
+    const std::size_t exchangeLen = std::min(state.exchange.size(), kMaxStringSize);
+    out.resize(kHeaderSize + kDeltaFixedSize + kDeltaMaxFieldsSize + exchangeLen + symbolLen);
+
+    char* const begin = &out[0];
+    char* p = storeHeader(begin, Kind::Delta, state.pastLimit ? Flags::PastLimit : 0, symbolLen,
+                          static_cast<std::int32_t>(state.conId));
+    p = storeLE(p, state.sequence);
+    p = storeLE(p, changed);
+    p = storeLE(p, static_cast<std::int64_t>(std::max(state.quoteTimestamp, state.tradeTimestamp)));
+    forEachField<kSnapshotFields>([&](auto index) {
+        constexpr auto& row = std::get<decltype(index)::value>(kSnapshotFields);
+        if constexpr (row.delta != kDeltaHeader && row.type != FieldType::Bool) {  // REASON: PastLimit is a flag
+            if (changed & row.delta) {
+                p = storeField<row.type>(p, row.get(state));
+            }
+        }
+    });
+    p = storeBytes(p, state.symbol, symbolLen);
+    out.resize(static_cast<std::size_t>(p - begin));
+}
+
+/**
+ * @brief Encode a Bar TickUpdate as a v1 binary bar
+ *
+ * NOTE: Bars carry no conId, header conId is 0.
+ */
+inline void encodeBarBinary(const std::string& symbol, const TickUpdate& update, std::string& out) {
+    using namespace binary_wire;
+
+    const std::size_t symbolLen = std::min(symbol.size(), kMaxStringSize);
+    out.resize(kHeaderSize + kBarBodySize + symbolLen);
+
+    char* p = &out[0];
+    p = storeHeader(p, Kind::Bar, 0, symbolLen, 0);
+    p = storeBody<tws_bridge::fields::kBarFields>(p, update);
+    storeBytes(p, symbol, symbolLen);
+}
@@ -0,0 +1,410 @@
+// BinaryReader.h - Consumer SDK for binary wire v1: in-place message views, delta apply, fixed-layout rows
+// SCOPE: Header-only, C++17 std only (no bridge headers besides BinaryWire.h) - copy both into a consumer;
+// python/twswire.cpp wraps it for Python (buffer protocol rows → numpy structured arrays without a copy)
+
+#pragma once
+
+#include "BinaryWire.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace binary_wire {
+
+// REASON: Byte-wise loads keep the reader correct on any host (one mov on x86/ARM LE)
+template <typename T>
+inline T loadLE(const char* in) {
+    static_assert(sizeof(T) <= sizeof(std::uint64_t), "loadLE supports up to 64-bit values");
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+// ========== Views ==========
+// PERFORMANCE: parse() checks lengths once, accessors are a fixed-offset load from the payload bytes - no
+// per-field objects, no copies. A view borrows the payload: it must outlive the view
+
+// Header of any v1 message, false if shorter than a header or not version 1
+inline bool peekKind(std::string_view payload, Kind& kind) {
+    if (payload.size() < kHeaderSize || static_cast<std::uint8_t>(payload[0]) != kVersion) {
+        return false;
+    }
+    kind = static_cast<Kind>(payload[1]);
+    return true;
+}
+
+class SnapshotView {
+public:
+    // false if not a complete v1 snapshot
+    bool parse(std::string_view payload) {
+        Kind kind;
+        if (!peekKind(payload, kind) || kind != Kind::Snapshot || payload.size() < kHeaderSize + kSnapshotBodySize + 1) {
+            return false;
+        }
+        m_data = payload.data();
+        m_symbolLen = static_cast<std::uint8_t>(payload[3]);
+        const std::size_t exchangeAt = kHeaderSize + kSnapshotBodySize + m_symbolLen;
+        if (payload.size() < exchangeAt + 1) {
+            return false;
+        }
+        m_exchangeLen = static_cast<std::uint8_t>(payload[exchangeAt]);
+        const std::size_t end = exchangeAt + 1 + m_exchangeLen + ((flags() & Flags::Sequence) != 0 ? 8 : 0);
+        return payload.size() >= end;
+    }
+
+    std::uint8_t flags() const { return static_cast<std::uint8_t>(m_data[2]); }
+    bool pastLimit() const { return (flags() & Flags::PastLimit) != 0; }
+    std::int32_t conId() const { return loadLE<std::int32_t>(m_data + 4); }
+    std::int64_t timestamp() const { return loadLE<std::int64_t>(m_data + 8); }
+    double bid() const { return loadLE<double>(m_data + 16); }
+    double ask() const { return loadLE<double>(m_data + 24); }
+    double last() const { return loadLE<double>(m_data + 32); }
+    std::int32_t bidSize() const { return loadLE<std::int32_t>(m_data + 40); }
+    std::int32_t askSize() const { return loadLE<std::int32_t>(m_data + 44); }
+    std::int32_t lastSize() const { return loadLE<std::int32_t>(m_data + 48); }
+    std::int64_t quoteTimestamp() const { return loadLE<std::int64_t>(m_data + 52); }
+    std::int64_t tradeTimestamp() const { return loadLE<std::int64_t>(m_data + 60); }
+    std::string_view symbol() const { return {m_data + kHeaderSize + kSnapshotBodySize, m_symbolLen}; }
+    std::string_view exchange() const { return {m_data + kHeaderSize + kSnapshotBodySize + m_symbolLen + 1, m_exchangeLen}; }
+    // 0 when the bridge runs without sequences
+    std::uint64_t sequence() const {
+        return (flags() & Flags::Sequence) != 0
+            ? loadLE<std::uint64_t>(m_data + kHeaderSize + kSnapshotBodySize + m_symbolLen + 1 + m_exchangeLen)
+            : 0;
+    }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_symbolLen = 0;
+    std::size_t m_exchangeLen = 0;
+};
+
+class DeltaView {
+public:
+    // false if not a complete v1 delta - walks the changed bits once, accessors then load at a stored offset
+    bool parse(std::string_view payload) {
+        Kind kind;
+        if (!peekKind(payload, kind) || kind != Kind::Delta || payload.size() < kHeaderSize + kDeltaFixedSize) {
+            return false;
+        }
+        m_data = payload.data();
+        m_symbolLen = static_cast<std::uint8_t>(payload[3]);
+        std::size_t at = kHeaderSize + kDeltaFixedSize;
+        const std::uint16_t bits = changed();
+        for (int bit = 0; bit < DeltaBits::kCount; ++bit) {
+            m_offsets[bit] = static_cast<std::uint16_t>(at);
+            if ((bits & (1u << bit)) == 0) {
+                continue;
+            }
+            const std::uint16_t field = static_cast<std::uint16_t>(1u << bit);
+            if (field == DeltaBits::Exchange) {
+                if (payload.size() < at + 1) {
+                    return false;
+                }
+                at += 1 + static_cast<std::uint8_t>(payload[at]);
+            } else {
+                at += fieldSize(field);
+            }
+        }
+        m_symbolAt = at;
+        return payload.size() >= at + m_symbolLen;
+    }
+
+    bool has(std::uint16_t field) const { return (changed() & field) != 0; }
+
+    bool pastLimit() const { return (static_cast<std::uint8_t>(m_data[2]) & Flags::PastLimit) != 0; }
+    std::int32_t conId() const { return loadLE<std::int32_t>(m_data + 4); }
+    std::uint64_t sequence() const { return loadLE<std::uint64_t>(m_data + 8); }
+    std::uint16_t changed() const { return loadLE<std::uint16_t>(m_data + 16); }
+    std::int64_t timestamp() const { return loadLE<std::int64_t>(m_data + 18); }
+    std::string_view symbol() const { return {m_data + m_symbolAt, m_symbolLen}; }
+
+    // PITFALL: Only valid when has(the field's bit) - otherwise they read a neighbouring field
+    double bid() const { return load<double>(DeltaBits::BidPrice); }
+    double ask() const { return load<double>(DeltaBits::AskPrice); }
+    double last() const { return load<double>(DeltaBits::LastPrice); }
+    std::int32_t bidSize() const { return load<std::int32_t>(DeltaBits::BidSize); }
+    std::int32_t askSize() const { return load<std::int32_t>(DeltaBits::AskSize); }
+    std::int32_t lastSize() const { return load<std::int32_t>(DeltaBits::LastSize); }
+    std::int64_t quoteTimestamp() const { return load<std::int64_t>(DeltaBits::QuoteTime); }
+    std::int64_t tradeTimestamp() const { return load<std::int64_t>(DeltaBits::TradeTime); }
+    std::string_view exchange() const {
+        const char* at = m_data + offset(DeltaBits::Exchange);
+        return {at + 1, static_cast<std::uint8_t>(*at)};
+    }
+    std::uint64_t conditions() const { return load<std::uint64_t>(DeltaBits::Conditions); }
+    double mid() const { return load<double>(DeltaBits::Derived); }
+    double spread() const { return load<double>(DeltaBits::Derived, 8); }
+    double vwap() const { return load<double>(DeltaBits::Derived, 16); }
+    std::int64_t rollingVolume() const { return load<std::int64_t>(DeltaBits::Derived, 24); }
+
+private:
+    static constexpr std::size_t fieldSize(std::uint16_t field) {
+        switch (field) {
+        case DeltaBits::BidSize:
+        case DeltaBits::AskSize:
+        case DeltaBits::LastSize:
+            return 4;
+        case DeltaBits::PastLimit:
+            return 0;  // REASON: Carried by the header flag
+        case DeltaBits::Derived:
+            return 32;
+        default:
+            return 8;
+        }
+    }
+
+    std::size_t offset(std::uint16_t field) const {
+        int bit = 0;
+        while ((1u << bit) != field) {
+            ++bit;
+        }
+        return m_offsets[bit];
+    }
+
+    template <typename T>
+    T load(std::uint16_t field, std::size_t skip = 0) const {
+        return loadLE<T>(m_data + offset(field) + skip);
+    }
+
+    const char* m_data = nullptr;
+    std::size_t m_symbolLen = 0;
+    std::size_t m_symbolAt = 0;
+    std::uint16_t m_offsets[DeltaBits::kCount] = {};
+};
+
+class BarView {
+public:
+    // false if not a complete v1 bar
+    bool parse(std::string_view payload) {
+        Kind kind;
+        if (!peekKind(payload, kind) || kind != Kind::Bar || payload.size() < kHeaderSize + kBarBodySize) {
+            return false;
+        }
+        m_data = payload.data();
+        m_symbolLen = static_cast<std::uint8_t>(payload[3]);
+        return payload.size() >= kHeaderSize + kBarBodySize + m_symbolLen;
+    }
+
+    std::int64_t timestamp() const { return loadLE<std::int64_t>(m_data + 8); }
+    double open() const { return loadLE<double>(m_data + 16); }
+    double high() const { return loadLE<double>(m_data + 24); }
+    double low() const { return loadLE<double>(m_data + 32); }
+    double close() const { return loadLE<double>(m_data + 40); }
+    std::int64_t volume() const { return loadLE<std::int64_t>(m_data + 48); }
+    double wap() const { return loadLE<double>(m_data + 56); }
+    std::uint32_t barCount() const { return loadLE<std::uint32_t>(m_data + 64); }
+    std::string_view symbol() const { return {m_data + kHeaderSize + kBarBodySize, m_symbolLen}; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_symbolLen = 0;
+};
+
+// ========== Rows ==========
+// Fixed-layout, host-order records for batches: one memcpy-able struct per message, the layout a numpy
+// structured dtype (kTickRowFormat / kBarRowFormat, PEP 3118) maps without copying
+
+namespace RowFlags {
+constexpr std::uint8_t PastLimit = 1u << 0;
+constexpr std::uint8_t Stale = 1u << 1;         // Delta applied over a sequence gap (fields not in `changed` may be old)
+}
+
+inline constexpr std::size_t kRowSymbolBytes = 28;     // NUL-padded, longer symbols are truncated
+inline constexpr std::size_t kRowExchangeBytes = 16;
+
+struct TickRow {
+    std::int64_t timestamp;
+    double bid;
+    double ask;
+    double last;
+    std::int64_t quoteTimestamp;
+    std::int64_t tradeTimestamp;
+    std::uint64_t sequence;
+    std::uint64_t conditions;                   // Deltas only (snapshots: 0)
+    double mid;                                 // Derived: deltas with DeltaBits::Derived only
+    double spread;
+    double vwap;
+    std::int64_t rollingVolume;
+    std::int32_t bidSize;
+    std::int32_t askSize;
+    std::int32_t lastSize;
+    std::int32_t conId;
+    std::uint16_t changed;                      // DeltaBits this message carried (snapshot: DeltaBits::All)
+    std::uint8_t flags;                         // RowFlags
+    std::uint8_t kind;                          // Kind of the last message applied
+    char symbol[kRowSymbolBytes];
+    char exchange[kRowExchangeBytes];
+};
+
+struct BarRow {
+    std::int64_t timestamp;
+    double open;
+    double high;
+    double low;
+    double close;
+    std::int64_t volume;
+    double wap;
+    std::uint32_t barCount;
+    char symbol[kRowSymbolBytes];
+};
+
+static_assert(sizeof(TickRow) == 160 && offsetof(TickRow, symbol) == 116, "TickRow layout is kTickRowFormat");
+static_assert(sizeof(BarRow) == 88 && offsetof(BarRow, symbol) == 60, "BarRow layout is kBarRowFormat");
+
+// PEP 3118 struct strings of the rows (native order, standard sizes) - numpy.asarray(batch) reads the field names
+inline constexpr const char* kTickRowFormat =
+    "T{=q:timestamp:d:bid:d:ask:d:last:q:quote_timestamp:q:trade_timestamp:Q:sequence:Q:conditions:"
+    "d:mid:d:spread:d:vwap:q:rolling_volume:i:bid_size:i:ask_size:i:last_size:i:con_id:"
+    "H:changed:B:flags:B:kind:28s:symbol:16s:exchange:}";
+inline constexpr const char* kBarRowFormat =
+    "T{=q:timestamp:d:open:d:high:d:low:d:close:q:volume:d:wap:I:bar_count:28s:symbol:}";
+
+namespace reader_detail {
+
+template <std::size_t N>
+inline void copyText(char (&out)[N], std::string_view text) {
+    const std::size_t length = std::min(text.size(), N);
+    std::memcpy(out, text.data(), length);
+    std::memset(out + length, 0, N - length);
+}
+
+} // namespace reader_detail
+
+inline void applySnapshot(const SnapshotView& view, TickRow& row) {
+    row.timestamp = view.timestamp();
+    row.bid = view.bid();
+    row.ask = view.ask();
+    row.last = view.last();
+    row.quoteTimestamp = view.quoteTimestamp();
+    row.tradeTimestamp = view.tradeTimestamp();
+    row.sequence = view.sequence();
+    row.bidSize = view.bidSize();
+    row.askSize = view.askSize();
+    row.lastSize = view.lastSize();
+    row.conId = view.conId();
+    row.changed = DeltaBits::All;
+    row.flags = view.pastLimit() ? RowFlags::PastLimit : 0;  // REASON: A keyframe clears Stale
+    row.kind = static_cast<std::uint8_t>(Kind::Snapshot);
+    reader_detail::copyText(row.symbol, view.symbol());
+    reader_detail::copyText(row.exchange, view.exchange());
+}
+
+// Fields not in view.changed() keep the row's previous values (the symbol's last snapshot / deltas)
+inline void applyDelta(const DeltaView& view, TickRow& row) {
+    const bool contiguous = row.kind != 0 && view.sequence() == row.sequence + 1;
+    const std::uint16_t changed = view.changed();
+    if (changed & DeltaBits::BidPrice) {
+        row.bid = view.bid();
+    }
+    if (changed & DeltaBits::AskPrice) {
+        row.ask = view.ask();
+    }
+    if (changed & DeltaBits::LastPrice) {
+        row.last = view.last();
+    }
+    if (changed & DeltaBits::BidSize) {
+        row.bidSize = view.bidSize();
+    }
+    if (changed & DeltaBits::AskSize) {
+        row.askSize = view.askSize();
+    }
+    if (changed & DeltaBits::LastSize) {
+        row.lastSize = view.lastSize();
+    }
+    if (changed & DeltaBits::QuoteTime) {
+        row.quoteTimestamp = view.quoteTimestamp();
+    }
+    if (changed & DeltaBits::TradeTime) {
+        row.tradeTimestamp = view.tradeTimestamp();
+    }
+    if (changed & DeltaBits::Exchange) {
+        reader_detail::copyText(row.exchange, view.exchange());
+    }
+    if (changed & DeltaBits::Conditions) {
+        row.conditions = view.conditions();
+    }
+    if (changed & DeltaBits::Derived) {
+        row.mid = view.mid();
+        row.spread = view.spread();
+        row.vwap = view.vwap();
+        row.rollingVolume = view.rollingVolume();
+    }
+    row.timestamp = view.timestamp();
+    row.sequence = view.sequence();
+    row.conId = view.conId();
+    row.changed = changed;
+    row.flags = static_cast<std::uint8_t>((view.pastLimit() ? RowFlags::PastLimit : 0)
+                                          | (contiguous && (row.flags & RowFlags::Stale) == 0 ? 0 : RowFlags::Stale));
+    row.kind = static_cast<std::uint8_t>(Kind::Delta);
+    reader_detail::copyText(row.symbol, view.symbol());
+}
+
+inline void applyBar(const BarView& view, BarRow& row) {
+    row.timestamp = view.timestamp();
+    row.open = view.open();
+    row.high = view.high();
+    row.low = view.low();
+    row.close = view.close();
+    row.volume = view.volume();
+    row.wap = view.wap();
+    row.barCount = view.barCount();
+    reader_detail::copyText(row.symbol, view.symbol());
+}
+
+// Latest TickRow per symbol from TWS:BIN:TICKS:* payloads - deltas complete themselves from it
+// NOTE: A delta before the symbol's first snapshot (or after a gap) yields a Stale row until the next keyframe
+class TickBook {
+public:
+    // Row updated by payload, nullptr if it is not a v1 Snapshot / Delta (the book is unchanged)
+    const TickRow* apply(std::string_view payload) {
+        Kind kind;
+        if (!peekKind(payload, kind)) {
+            return nullptr;
+        }
+        if (kind == Kind::Snapshot) {
+            if (!m_snapshot.parse(payload)) {
+                return nullptr;
+            }
+            TickRow& row = rowFor(m_snapshot.symbol());
+            applySnapshot(m_snapshot, row);
+            return &row;
+        }
+        if (kind != Kind::Delta || !m_delta.parse(payload)) {
+            return nullptr;
+        }
+        TickRow& row = rowFor(m_delta.symbol());
+        applyDelta(m_delta, row);
+        return &row;
+    }
+
+    const TickRow* find(std::string_view symbol) const {
+        m_key.assign(symbol.data(), symbol.size());
+        const auto it = m_rows.find(m_key);
+        return it == m_rows.end() ? nullptr : &it->second;
+    }
+
+    std::size_t size() const { return m_rows.size(); }
+
+private:
+    TickRow& rowFor(std::string_view symbol) {
+        m_key.assign(symbol.data(), symbol.size());  // REASON: Reused buffer - no allocation per message once warm
+        const auto it = m_rows.find(m_key);
+        return it != m_rows.end() ? it->second : m_rows.emplace(m_key, TickRow{}).first->second;
+    }
+
+    std::unordered_map<std::string, TickRow> m_rows;
+    mutable std::string m_key;
+    SnapshotView m_snapshot;
+    DeltaView m_delta;
+};
+
+} // namespace binary_wire
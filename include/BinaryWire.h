@@ -0,0 +1,77 @@
+// BinaryWire.h - Binary wire format v1: layout, kinds, flags and sizes (shared by encoder and consumer SDK)
+// SCOPE: Standalone (C++17 std only) - BinaryEncoder.h writes it, BinaryReader.h / python/twswire.cpp read it
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Wire format v1 (all fields little-endian, no padding)
+ *
+ * Header (8 bytes), shared by every message kind:
+ *   u8 version | u8 kind | u8 flags | u8 symbolLen | i32 conId
+ *
+ * kind = Snapshot (60-byte body):
+ *   i64 timestamp | f64 bid | f64 ask | f64 last | i32 bidSize | i32 askSize | i32 lastSize
+ *   | i64 quoteTimestamp | i64 tradeTimestamp
+ *   then symbol[symbolLen] | u8 exchangeLen | exchange[exchangeLen]
+ *   then u64 sequence if flags & Sequence (InstrumentState::sequence, set by the worker)
+ *
+ * kind = Delta (18-byte fixed part, DeltaConfig):
+ *   u64 sequence (same counter as Snapshot) | u16 changed (DeltaField bits) | i64 timestamp
+ *   then, in bit order, only the changed fields: f64 bid | f64 ask | f64 last | i32 bidSize | i32 askSize
+ *   | i32 lastSize | i64 quoteTimestamp | i64 tradeTimestamp | u8 exchangeLen + exchange | u64 conditions
+ *   | (PastLimit: flags only) | f64 mid, f64 spread, f64 vwap, i64 rollingVolume
+ *   then symbol[symbolLen]
+ *
+ * kind = Bar (60-byte body):
+ *   i64 timestamp | f64 open | f64 high | f64 low | f64 close | i64 volume | f64 wap | u32 barCount
+ *   then symbol[symbolLen]
+ *
+ * Python: struct.unpack_from("<BBBBiqdddiiiqq", msg) / struct.unpack_from("<BBBBiqddddqdI", msg),
+ * or the twswire extension (python/twswire.cpp) for whole batches
+ *
+ * [ARCHITECTURE] Consumers MUST check version first; new fields are only appended.
+ */
+namespace binary_wire {
+
+constexpr std::uint8_t kVersion = 1;
+
+enum class Kind : std::uint8_t {
+    Snapshot = 1,
+    Bar = 2,
+    Delta = 3
+};
+
+namespace Flags {
+constexpr std::uint8_t PastLimit = 1u << 0;
+constexpr std::uint8_t Sequence = 1u << 1;      // Snapshot: u64 sequence after exchange (unset: sequence 0)
+}
+
+// Delta `changed` bits (tws_bridge::DeltaField - BinaryEncoder.h asserts they match)
+namespace DeltaBits {
+constexpr std::uint16_t BidPrice = 1u << 0;
+constexpr std::uint16_t AskPrice = 1u << 1;
+constexpr std::uint16_t LastPrice = 1u << 2;
+constexpr std::uint16_t BidSize = 1u << 3;
+constexpr std::uint16_t AskSize = 1u << 4;
+constexpr std::uint16_t LastSize = 1u << 5;
+constexpr std::uint16_t QuoteTime = 1u << 6;
+constexpr std::uint16_t TradeTime = 1u << 7;
+constexpr std::uint16_t Exchange = 1u << 8;
+constexpr std::uint16_t Conditions = 1u << 9;
+constexpr std::uint16_t PastLimit = 1u << 10;
+constexpr std::uint16_t Derived = 1u << 11;
+constexpr std::uint16_t All = (1u << 12) - 1;
+constexpr int kCount = 12;
+}
+
+constexpr std::size_t kHeaderSize = 8;
+constexpr std::size_t kSnapshotBodySize = 60;
+constexpr std::size_t kBarBodySize = 60;
+constexpr std::size_t kDeltaFixedSize = 18;
+constexpr std::size_t kDeltaMaxFieldsSize = 3 * 8 + 3 * 4 + 2 * 8 + 1 + 8 + 4 * 8;  // + exchange bytes
+constexpr std::size_t kMaxStringSize = 255;  // u8 length prefix, longer strings are truncated
+
+} // namespace binary_wire
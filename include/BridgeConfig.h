@@ -0,0 +1,166 @@
+// BridgeConfig.h - Every startup tunable in one place (config.yaml / --set, spec §2.3)
+// SCOPE: Built once in main() before any thread starts; SIGHUP re-reads it (see reloadableKeys)
+
+#pragma once
+
+#include "AccountTable.h"
+#include "AllocationTracker.h"
+#include "AsyncLogger.h"
+#include "BasketIndex.h"
+#include "BridgeReader.h"
+#include "CommandListener.h"
+#include "ConfigFile.h"
+#include "ContractCache.h"
+#include "GapBackfill.h"
+#include "HistoryCache.h"
+#include "JournalServer.h"
+#include "KafkaSink.h"
+#include "LeaderLease.h"
+#include "LoadShedder.h"
+#include "MarketScanner.h"
+#include "MemoryBudget.h"
+#include "NewsFeed.h"
+#include "PartitionMembership.h"
+#include "QueryServer.h"
+#include "QueueSizing.h"
+#include "ReconnectBackoff.h"
+#include "RedisPublisher.h"
+#include "RedisUri.h"
+#include "RedisWorker.h"
+#include "RequestPacer.h"
+#include "SamplingProfiler.h"
+#include "SessionReport.h"
+#include "ShardRebalancer.h"
+#include "ShardRouter.h"
+#include "SocketTuning.h"
+#include "StageWatchdog.h"
+#include "StatusHeartbeat.h"
+#include "StateCheckpoint.h"
+#include "SubscriptionCommand.h"
+#include "SubscriptionDemand.h"
+#include "TaskPool.h"
+#include "TickJournal.h"
+#include "ThreadAffinity.h"
+#include "TimeSeries.h"
+#include "TopMovers.h"
+#include "TraceExport.h"
+#include "UniverseWatcher.h"
+#include "WaitStrategy.h"
+#include "WarmStart.h"
+#include "WebSocketGateway.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+// Defaults = the values main() used to hardcode (a bridge started without --config behaves as before)
+struct BridgeConfig {
+    BridgeConfig();
+
+    // ========== tws ==========
+    std::string twsHost = "127.0.0.1";
+    unsigned int twsPort = 7497;                    // Paper trading port
+    std::vector<int> clientIds{1};                  // One TWS connection per client ID (1 = SPSC shard queues)
+    ReaderMode readerMode = ReaderMode::BridgeRing;
+    std::chrono::milliseconds readerPoll{100};      // Bridge reader's socket poll period, 0 = busy-poll
+    SocketTuning socket;                            // TCP options of each TWS connection
+    MessageFilterConfig messages;                   // Msg id allowlist (bridge_ring / inline readers)
+    PacingConfig pacing;
+    ReconnectPolicy reconnect;
+    BackfillPolicy backfill;                        // reqHistoricalTicks over each reconnect gap
+
+    // ========== redis ==========
+    std::string redisUri = "tcp://127.0.0.1:6379";
+    BatchPolicy batch;
+    StreamPolicy stream;
+    IoThreadPolicy io;                              // io.thread comes from threads.redis_io
+    OutagePolicy outage;
+    RedisConnectionPolicy connection;
+
+    // ========== ingest ==========
+    std::size_t shards = 1;                         // Worker shards (one core each)
+    std::size_t queueCapacity = 10000;              // Per shard queue
+    QueueSizingConfig sizing;                       // Occupancy telemetry, measured capacity (sizing.adopt)
+    std::size_t symbolCapacity = InstrumentRegistry::kDefaultCapacity;
+    WaitConfig wait;
+    IngestConfig ingest;                            // ingest.slotCapacity follows symbolCapacity
+    RebalanceConfig rebalance;                      // ingest.movableSlots follows rebalance.enabled
+
+    // ========== worker (output formats, conflation, ...) ==========
+    WorkerConfig worker;                            // worker.thread / shardId are set per shard
+    WarmStartConfig warmStart;                      // Startup symbols seeded from TWS:LVC:* (needs worker.last_value)
+    StateCheckpointConfig checkpoint;               // Worker state mirrored to shared memory, restored on restart
+
+    // ========== load_shed ==========
+    LoadShedConfig loadShed;                        // Overload controller (main thread, LoadShedder.h)
+
+    // ========== demand ==========
+    DemandConfig demand;                            // Startup symbols follow consumer interest (SubscriptionDemand.h)
+
+    // ========== commands ==========
+    CommandListenerConfig commands;                 // statusChannel follows worker.latency.status_channel
+
+    // ========== threads: {cpu, SCHED_FIFO priority} per thread, missing = float ==========
+    // Compact mode: the main thread reads the socket, decodes, aggregates and publishes (one connection,
+    // one shard) - forces reader: inline and no Redis I/O thread, threads.msg[0] places it
+    bool compact = false;
+    std::vector<ThreadConfig> msgThreads{{-1, 0}};     // Per connection
+    std::vector<ThreadConfig> readerThreads{{-1, 0}};  // Per connection
+    std::vector<ThreadConfig> workerThreads;           // Per shard
+    std::vector<ThreadConfig> redisIoThreads;          // Per shard
+    TaskPoolConfig background;                         // Background job pool (off the cores pinned above)
+
+    // ========== Optional outputs / services ==========
+    bool metricsEnabled = true;
+    std::uint16_t metricsPort = 9464;
+    bool journalEnabled = false;
+    std::string journalDir = "journal";
+    JournalFormat journalFormat = JournalFormat::Raw;
+    std::size_t journalBlockBytes = std::size_t{64} << 10;
+    bool journalIndex = true;
+    std::string snapshotArchive;                    // "" = off, else "{prefix}-{shard}.jsonl"
+    KafkaConfig kafka;                              // Snapshot sink producing to a Kafka topic (per worker)
+    WebSocketConfig websocket;                      // Embedded WebSocket server (one gateway, a sink of every worker)
+    QueryConfig query;                              // Point-in-time snapshot lookups (Unix datagram socket)
+    JournalServerConfig journalServer;              // --serve-journal: directory from the flag, redis from redis.*
+    LeaderConfig leader;                            // Active/standby pair (Redis lease key)
+    PartitionConfig partition;                      // Symbol set split across instances (Redis membership ZSET)
+    bool watchSubscribers = false;
+    ContractCacheConfig contracts;                  // path "" = off
+    AccountConfig account;                          // PnL / positions as TWS:PNL / TWS:POSITION hashes
+    NewsConfig news;                                // Broadtape headlines on TWS:NEWS:{SYMBOL}
+    TimeSeriesConfig timeSeries;                    // Chart history as TWS:TS:{SYMBOL}:* RedisTimeSeries keys
+    WatchdogConfig watchdog;                        // statusChannel follows worker.latency.status_channel
+    StatusConfig status;                            // Heartbeat; channel follows worker.latency.status_channel
+    SessionReportConfig report;                     // Per-session latency / throughput; sessionReset follows worker.derived_metrics
+    TraceConfig trace;                              // Sampled tick spans (Chrome trace-event file)
+    ProfilerConfig profiler;                        // On-demand stack sampling ({"action":"profile"})
+    AllocationConfig allocations;                   // Hot-path guard (builds with TWS_BRIDGE_ALLOC_HOOK only)
+    MemoryBudgetConfig memory;                      // Byte budgets of the growable buffers (shares set in main)
+    BasketConfig baskets;                           // Weighted baskets published as synthetic instruments
+    MoversConfig movers;                            // Top movers; sessionReset follows worker.derived_metrics
+    ScannerConfig scanner;                          // Market scans diffed onto TWS:SCAN:{ID}
+    LogLevel logLevel = LogLevel::Info;
+
+    // ========== Startup subscriptions (more arrive on TWS:COMMANDS) ==========
+    std::vector<std::string> symbols;               // Tick subscriptions, same path as a TWS:COMMANDS subscribe
+    FeedType feed = FeedType::Auto;
+    UniverseConfig universe;                        // Symbol universe file / Redis set, synced as diffs
+    std::vector<std::string> historicalBars{"SPY"};  // history.window of 5-min bars each
+    HistoryCacheConfig history;                     // Window, bar store as cache (incremental startup backfill)
+    std::vector<std::string> realTimeBars{"SPY"};    // 5-second TRADES bars
+    // historicalBars requests stay open (keepUpToDate): live in-progress / completed bars without realTimeBars
+    bool keepBarsUpToDate = false;
+};
+
+// Applies every key of file onto config, then validates the result
+// false (error lists every problem, one per line) on unknown keys, bad values or inconsistent settings
+bool applyConfig(const ConfigFile& file, BridgeConfig& config, std::string& error);
+
+// Keys a SIGHUP applies to the running bridge; any other changed key is reported as needing a restart
+// NOTE: Only settings read through an atomic qualify - worker / publisher configs are copied into their threads
+bool isReloadableKey(const std::string& key);
+
+} // namespace tws_bridge
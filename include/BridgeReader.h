@@ -0,0 +1,189 @@
+// BridgeReader.h - Bridge-side TWS socket reader (replaces EReader's locked deque)
+// SCOPE: Reader thread (socket → pooled buffers) + dispatch thread (decode → EWrapper callbacks)
+
+#pragma once
+
+#include "MessageFilter.h"
+#include "MirroredBuffer.h"
+#include "SpscRing.h"
+#include "StageWatchdog.h"
+#include "ThreadAffinity.h"
+#include "TickByTickDecoder.h"
+#include "TscClock.h"
+#include "EDecoder.h"
+#include <google/protobuf/arena.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class EClientSocket;
+class EWrapper;
+
+namespace tws_bridge {
+
+// Which reader feeds TwsClient::processMessages
+enum class ReaderMode {
+    TwsApi,     // Vendored EReader: mutex-guarded deque of shared_ptr<EMessage>, condvar signal
+    BridgeRing, // BridgeReader: SPSC ring of pooled buffers, eventfd signal
+    Inline      // BridgeReader without a reader thread: the caller reads, decodes and dispatches
+                // in place (no hand-off, no wake-up - pin the calling thread for best results)
+};
+
+struct BridgeReaderConfig {
+    std::size_t ringCapacity = 1024;                // Frames in flight reader → dispatch
+    std::size_t receiveBytes = 1024 * 1024;         // Receive ring (rounded up to a power of two)
+    std::size_t copyBuffers = 8;                    // Pooled buffers for frames that exceed (or wrap) the ring
+    std::size_t bufferReserve = 4096;               // Initial bytes per pooled buffer (grows, never shrinks)
+    // Socket poll period (bounds stop() latency), 0 = busy-poll: the reader never sleeps in the kernel, so
+    // a frame is picked up within the loop's own latency (pin the reader to an isolated core)
+    std::chrono::milliseconds pollTimeout{100};
+    bool quickAck = false;                          // Re-arms TCP_QUICKACK after every read (SocketTuning.h)
+    bool inlineDispatch = false;                    // ReaderMode::Inline (pollInline, no thread/ring/eventfd)
+    MessageFilter messages;                         // Msg ids decoded, the rest dropped after framing
+    ThreadConfig thread;                            // Reader thread placement (BridgeRing only)
+    Heartbeat* heartbeat = nullptr;                 // Beaten by the reader thread (BridgeRing only, outlives the reader)
+};
+
+// Lifetime counters (written by the reader thread, readable from any thread)
+struct BridgeReaderCounters {
+    std::atomic<std::uint64_t> messages{0};         // Frames handed to the dispatch thread
+    std::atomic<std::uint64_t> signals{0};          // eventfd writes (at most one per socket read)
+    std::atomic<std::uint64_t> poolStalls{0};       // Reads delayed: receive ring, frame ring or copy pool full
+    std::atomic<std::uint64_t> copiedFrames{0};     // Frames copied out of the ring (wrapped or oversized)
+    std::atomic<std::uint64_t> fastTicks{0};        // TICK_BY_TICK / TICK_PRICE / TICK_SIZE decoded by the fast path
+    std::atomic<std::uint64_t> fastBars{0};         // HISTORICAL_DATA bars decoded by the fast path (one batch per frame)
+    std::atomic<std::uint64_t> skipped{0};          // Frames dropped by the message filter (never decoded)
+    std::atomic<std::uint64_t> protobufFrames{0};   // Protobuf frames decoded into the dispatch arena
+};
+
+// Reads V100+ length-prefixed frames into a receive ring, dispatch decodes them in place
+//
+// PERFORMANCE (vs EReader::readSingleMsg / putMessageToQueue):
+// - Zero-copy: a frame is handed over as a view into the receive ring, bytes are released
+//   (in order) once decoded - no per-message EMessage, vector or memcpy
+// - Ring is mapped twice back to back, so no frame wraps its end - only frames larger than
+//   the ring (or any wrapping frame, if the mirror is unavailable) go through a recycled pool
+// - No mutex: reader → dispatch hand-off is a release store on the frame ring tail
+// - One eventfd write per socket read (not per message), and only while the dispatch thread sleeps
+// BACKPRESSURE: Ring / pool exhausted → reader stops reading the socket (TCP flow control), never grows
+class BridgeReader {
+public:
+    // fastTicks (optional): TICK_BY_TICK / TICK_PRICE / TICK_SIZE frames are decoded in place and
+    // delivered there instead of through EDecoder → EWrapper (anything unparsed still goes to EDecoder),
+    // HISTORICAL_DATA frames as one HistoricalBarBatch each
+    BridgeReader(EClientSocket* client, EWrapper* wrapper, BridgeReaderConfig config = {},
+                 FastTickHandler* fastTicks = nullptr);
+    ~BridgeReader();
+
+    BridgeReader(const BridgeReader&) = delete;
+    BridgeReader& operator=(const BridgeReader&) = delete;
+
+    // Starts the reader thread (inline: just validates); false if unsupported (pre-V100 protocol, no eventfd)
+    bool start();
+    void stop();
+    bool isAlive() const { return m_alive.load(std::memory_order_acquire); }
+
+    // ========== Dispatch thread ==========
+    // Blocks up to timeout; true if messages are ready (or the reader stopped)
+    bool waitForMessages(std::chrono::milliseconds timeout);
+    // Decodes every ready message into EWrapper callbacks, returns count
+    // PERFORMANCE: Frames are taken, and their bytes / buffers released, kDispatchBatch at a time
+    std::size_t processMsgs();
+
+    // ========== Inline mode (calling thread is reader AND dispatcher) ==========
+    // Waits up to pollTimeout for socket data, decodes every complete frame straight out of
+    // the read buffer into EWrapper callbacks, returns count
+    // PERFORMANCE: Callbacks run on the thread that called recv() - zero context switches
+    std::size_t pollInline();
+    // Same, waiting at most timeout (0 = no wait) - compact mode bounds it by the worker's next timer
+    std::size_t pollInline(std::chrono::milliseconds timeout);
+
+    const BridgeReaderCounters& counters() const { return m_counters; }
+
+    // Unix ns (TscClock.h) the socket read that completed the frame being decoded returned
+    // NOTE: Dispatch thread, inside the EWrapper / fast-tick callbacks of that frame
+    std::int64_t receiveNs() const { return m_dispatchReceiveNs; }
+
+private:
+    struct MessageBuffer {
+        std::vector<char> bytes;
+    };
+
+    static constexpr std::uint32_t kNoBuffer = 0xFFFFFFFF;
+    static constexpr std::size_t kDispatchBatch = 64;  // Frames taken off m_ready per bulk dequeue
+    static constexpr std::size_t kArenaBlock = 16 * 1024;  // Protobuf arena's reusable first block
+
+    // One decoded-in-order frame: a view into the ring, or a pooled copy
+    struct Frame {
+        std::uint64_t end;       // Ring position after the frame (released once decoded)
+        std::uint32_t offset;    // Body offset in m_receive (buffer == kNoBuffer)
+        std::uint32_t length;
+        std::uint32_t buffer;    // Pool index when copied, else kNoBuffer
+        std::int64_t receiveNs;  // Last socket read before the frame was framed (TscClock.h)
+    };
+
+    // ========== Reader thread ==========
+    void readLoop();
+    bool waitSocket(std::chrono::milliseconds timeout);
+    bool waitReceiveSpace();
+    bool fillInbound();
+    bool consumeFrames();
+    bool publish(const Frame& frame);
+    void copyOut(std::uint64_t position, char* dest, std::size_t count) const;
+    std::uint32_t acquireBuffer();
+    void notifyDispatch();
+
+    // ========== Dispatch thread (inline: the polling thread) ==========
+    void decodeFrame(const Frame& frame);    // Callbacks only - bytes / buffer stay held
+    void dispatchFrame(const Frame& frame);  // decodeFrame + release (inline mode: per frame)
+    void dispatch(const char* begin, const char* end);
+    bool decodeProtoBuf(int msgId, const char* body, const char* end);  // false: left to EDecoder
+    void resetArena();
+
+    EClientSocket* m_client;
+    EWrapper* m_wrapper;
+    EDecoder m_decoder;                      // Dispatch thread only (inline: the polling thread)
+    FastTickHandler* m_fastTicks;
+    int m_serverVersion;
+    BarTimeParser m_barTime;                 // Dispatch thread only: HISTORICAL_DATA bar times → ms
+    HistoricalBarBatch m_bars;               // Dispatch thread only: reused for every HISTORICAL_DATA frame
+    BridgeReaderConfig m_config;
+
+    // Protobuf messages of the current dispatch batch (dispatch thread only), reset once per batch
+    // PERFORMANCE: Reset keeps the first block - a batch that fits in it never calls malloc
+    std::vector<char> m_arenaBlock;
+    google::protobuf::Arena m_arena;
+    bool m_arenaUsed = false;
+
+    SpscRing<Frame> m_ready;                 // Reader → dispatch: frames in ring order
+    SpscRing<std::uint32_t> m_free;          // Dispatch → reader: recycled pool indices
+    std::vector<MessageBuffer> m_pool;       // REASON: Sized once, never reallocated (indices stay valid)
+
+    // Receive ring: positions are monotonic byte counts, masked into m_receive
+    // REASON: Never resized - dispatch may be reading any unreleased byte
+    // PERFORMANCE: Mirrored mapping - reads and frames never wrap (no split recv, no wrap copy)
+    MirroredBuffer m_receive;
+    std::size_t m_mask;
+    std::uint64_t m_written = 0;             // Reader only: bytes received
+    std::uint64_t m_parsed = 0;              // Reader only: start of the next unframed byte
+    std::int64_t m_receiveNs = 0;            // Reader only: when the last socket read returned
+    std::int64_t m_dispatchReceiveNs = 0;    // Dispatch only: receive stamp of the frame being decoded
+    alignas(64) std::atomic<std::uint64_t> m_released{0};  // Dispatch → reader: bytes decoded
+
+    // Frame larger than the ring: body is received straight into a pool buffer
+    std::uint32_t m_oversizeBuffer = kNoBuffer;
+    std::size_t m_oversizeFilled = 0;
+    std::size_t m_oversizeLength = 0;
+
+    int m_eventFd = -1;
+    std::atomic<bool> m_dispatchWaiting{false};
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_alive{false};
+    std::thread m_thread;
+    BridgeReaderCounters m_counters;
+};
+
+} // namespace tws_bridge
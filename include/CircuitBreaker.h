@@ -0,0 +1,84 @@
+// CircuitBreaker.h - Fail-fast gate in front of Redis pipelines during an outage
+// SCOPE: Redis sending thread (I/O thread, or the worker without one); state() from any thread
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+enum class CircuitState : std::uint8_t {
+    Closed,    // Pipelines go out
+    Open,      // Failing fast - nothing sent until the probe is due
+    HalfOpen   // Probe due - one trial decides between Closed and Open
+};
+
+struct CircuitBreakerPolicy {
+    bool enabled = true;
+    std::size_t failureThreshold = 3;                  // Consecutive failed pipelines that open the circuit
+    std::chrono::milliseconds probeInterval{250};      // Open → first probe
+    std::chrono::milliseconds maxProbeInterval{5000};  // Doubles per failed probe up to this
+};
+
+// REASON: During an outage every batch would otherwise pay a socket timeout + an exception + a log line -
+// open, the sender skips Redis entirely and only probes at a bounded (backed-off) rate
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit CircuitBreaker(CircuitBreakerPolicy policy = {})
+        : m_policy(policy)
+        , m_interval(policy.probeInterval) {
+    }
+
+    // May a pipeline (or probe) go out now? Open turns HalfOpen once the probe is due
+    bool allow(Clock::time_point now) {
+        const CircuitState state = m_state.load(std::memory_order_relaxed);
+        if (state != CircuitState::Open) {
+            return true;
+        }
+        if (now < m_nextProbe) {
+            return false;
+        }
+        m_state.store(CircuitState::HalfOpen, std::memory_order_relaxed);
+        return true;
+    }
+
+    void recordSuccess() {
+        m_failures = 0;
+        m_interval = m_policy.probeInterval;
+        m_state.store(CircuitState::Closed, std::memory_order_relaxed);
+    }
+
+    // Returns true if this failure opened the circuit (Closed → Open, or a failed HalfOpen probe)
+    bool recordFailure(Clock::time_point now) {
+        ++m_failures;
+        const CircuitState state = m_state.load(std::memory_order_relaxed);
+        if (!m_policy.enabled || (state == CircuitState::Closed && m_failures < m_policy.failureThreshold)) {
+            return false;
+        }
+        if (state == CircuitState::HalfOpen) {
+            // BACKPRESSURE: Longer outage, fewer probes
+            m_interval = std::min(m_interval * 2, m_policy.maxProbeInterval);
+        }
+        m_nextProbe = now + m_interval;
+        m_state.store(CircuitState::Open, std::memory_order_relaxed);
+        return true;
+    }
+
+    CircuitState state() const { return m_state.load(std::memory_order_relaxed); }
+    std::size_t consecutiveFailures() const { return m_failures; }
+
+private:
+    CircuitBreakerPolicy m_policy;
+    std::atomic<CircuitState> m_state{CircuitState::Closed};  // REASON: Read by metrics / isConnected()
+    std::size_t m_failures = 0;
+    std::chrono::milliseconds m_interval;
+    Clock::time_point m_nextProbe{};
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,106 @@
+// ClusterSlots.h - Redis Cluster hash slots (CRC16 / hash tags) and slot → node routing table
+// SCOPE: Redis sending thread (RedisPublisher cluster mode), rebuilt from CLUSTER SLOTS on topology change
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+constexpr std::size_t kClusterSlots = 16384;
+
+// CRC16-CCITT (XMODEM), the checksum Redis Cluster keys are hashed with
+inline std::uint16_t clusterCrc16(std::string_view bytes) {
+    // PERFORMANCE: Table built once (constexpr), one lookup per byte
+    struct Table {
+        std::array<std::uint16_t, 256> entries{};
+        constexpr Table() {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t crc = i << 8;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+                }
+                entries[i] = static_cast<std::uint16_t>(crc & 0xFFFF);
+            }
+        }
+    };
+    static constexpr Table table;
+    std::uint16_t crc = 0;
+    for (char c : bytes) {
+        crc = static_cast<std::uint16_t>((crc << 8) ^ table.entries[((crc >> 8) ^ static_cast<unsigned char>(c)) & 0xFF]);
+    }
+    return crc;
+}
+
+// Slot of a key (or sharded Pub/Sub channel): only the first non-empty {tag} is hashed, if present
+inline std::uint16_t clusterSlot(std::string_view key) {
+    const std::size_t open = key.find('{');
+    if (open != std::string_view::npos) {
+        const std::size_t close = key.find('}', open + 1);
+        if (close != std::string_view::npos && close > open + 1) {
+            key = key.substr(open + 1, close - open - 1);
+        }
+    }
+    return static_cast<std::uint16_t>(clusterCrc16(key) % kClusterSlots);
+}
+
+// Short hash tag that maps to a slot (addresses "the node owning slot N" through a key-routed API)
+// NOTE: Brute force over decimal strings - every slot is hit within 6 digits, run once per topology change
+inline std::string clusterTagForSlot(std::uint16_t slot) {
+    for (std::uint32_t candidate = 0;; ++candidate) {
+        std::string tag = std::to_string(candidate);
+        if (clusterSlot(tag) == slot) {
+            return tag;
+        }
+    }
+}
+
+// Which node (index into nodes()) serves each slot, from CLUSTER SLOTS
+class ClusterSlotMap {
+public:
+    static constexpr std::uint16_t kNoNode = 0xFFFF;
+
+    ClusterSlotMap() : m_owner(kClusterSlots, kNoNode) {}
+
+    // Assigns [first, last] to the node at endpoint "host:port" (added on first sight)
+    void assign(std::uint16_t first, std::uint16_t last, const std::string& endpoint) {
+        std::uint16_t node = 0;
+        while (node < m_nodes.size() && m_nodes[node] != endpoint) {
+            ++node;
+        }
+        if (node == m_nodes.size()) {
+            m_nodes.push_back(endpoint);
+            m_firstSlot.push_back(first);
+        }
+        for (std::uint32_t slot = first; slot <= last && slot < kClusterSlots; ++slot) {
+            m_owner[slot] = node;
+        }
+    }
+
+    // kNoNode while the slot is unassigned (resharding) - callers fall back to any node and let MOVED refresh
+    std::uint16_t node(std::uint16_t slot) const { return m_owner[slot]; }
+    std::uint16_t nodeOf(std::string_view key) const { return m_owner[clusterSlot(key)]; }
+
+    const std::vector<std::string>& nodes() const { return m_nodes; }
+    std::size_t nodeCount() const { return m_nodes.size(); }
+    // A slot the node serves (for clusterTagForSlot)
+    std::uint16_t firstSlot(std::size_t node) const { return m_firstSlot[node]; }
+
+    void clear() {
+        m_owner.assign(kClusterSlots, kNoNode);
+        m_nodes.clear();
+        m_firstSlot.clear();
+    }
+
+private:
+    std::vector<std::uint16_t> m_owner;             // By slot (32 KB)
+    std::vector<std::string> m_nodes;
+    std::vector<std::uint16_t> m_firstSlot;
+};
+
+} // namespace tws_bridge
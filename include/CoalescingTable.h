@@ -0,0 +1,177 @@
+// CoalescingTable.h - Latest-value mailboxes with a dirty bitmap
+// SCOPE: Producer (TwsClient callbacks) overwrites in place, consumer (RedisWorker) drains changed entries
+
+#pragma once
+
+#include "HugePages.h"
+#include "MarketData.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace tws_bridge {
+
+// One TickUpdate mailbox per key, newer writes replace older ones (memory bounded by key count)
+//
+// PERFORMANCE:
+// - Seqlock per entry: writer never waits, reader retries only if it raced a write
+// - Dirty bitmap in 64-bit words: consumer skips clean words with one load
+// PITFALL: Single writer per table (one producer thread per shard)
+class CoalescingTable {
+public:
+    // memory.enabled: mailboxes on prefaulted 2 MB pages (HugePages.h), the heap if the mapping fails
+    explicit CoalescingTable(std::size_t keys, HugePageConfig memory = {})
+        : m_keys(keys)
+        , m_words((keys + 63) / 64)
+        , m_dirty(new std::atomic<std::uint64_t>[m_words]) {
+        if (memory.enabled) {
+            m_region = HugePageRegion(keys * sizeof(Entry), memory.lock);
+        }
+        if (m_region.data()) {
+            // NOTE: 2 MB aligned - Entry's 64-byte alignment holds
+            m_entries = static_cast<Entry*>(m_region.data());
+            std::uninitialized_default_construct_n(m_entries, keys);
+        } else {
+            m_heap.reset(new Entry[keys]);
+            m_entries = m_heap.get();
+        }
+        for (std::size_t i = 0; i < m_words; ++i) {
+            m_dirty[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~CoalescingTable() {
+        if (m_region.data()) {
+            std::destroy_n(m_entries, m_keys);
+        }
+    }
+
+    CoalescingTable(const CoalescingTable&) = delete;
+    CoalescingTable& operator=(const CoalescingTable&) = delete;
+
+    std::size_t keys() const { return m_keys; }
+    // Mailbox array (NUMA placement - NumaPlacement.h)
+    const void* storage() const { return m_entries; }
+    std::size_t storageBytes() const { return m_keys * sizeof(Entry); }
+    // Start-up report (all false on the heap)
+    const HugePageBacking& backing() const { return m_region.backing(); }
+
+    // ========== Producer side ==========
+    // Returns true if an undrained value was replaced (superseded before the consumer saw it)
+    bool write(std::size_t key, const TickUpdate& update) {
+        Entry& entry = m_entries[key];
+        const std::uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+        entry.seq.store(seq + 1, std::memory_order_relaxed);  // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::uint64_t words[kWordsPerUpdate];
+        std::memcpy(words, &update, sizeof(TickUpdate));
+        for (std::size_t i = 0; i < kWordsPerUpdate; ++i) {
+            entry.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        entry.seq.store(seq + 2, std::memory_order_release);
+
+        const std::uint64_t bit = std::uint64_t{1} << (key % 64);
+        return (m_dirty[key / 64].fetch_or(bit, std::memory_order_release) & bit) != 0;
+    }
+
+    // REASON: Writer keeps coalescing into an entry the consumer has not drained yet
+    // (a newer update must not overtake it through another path)
+    bool isPending(std::size_t key) const {
+        return (m_dirty[key / 64].load(std::memory_order_acquire) >> (key % 64)) & 1;
+    }
+
+    // ========== Consumer side ==========
+    // Copies up to maxItems dirty entries to out and clears their bits, returns count
+    // NOTE: An entry rewritten while being drained is marked dirty again (delivered twice, never lost)
+    template <typename It>
+    std::size_t drain(It out, std::size_t maxItems) {
+        std::size_t count = 0;
+        for (std::size_t w = 0; w < m_words && count < maxItems; ++w) {
+            std::uint64_t bits = m_dirty[w].load(std::memory_order_acquire);
+            if (bits == 0) {
+                continue;
+            }
+            // Take at most the remaining budget from this word
+            std::uint64_t taken = 0;
+            for (std::size_t n = count; bits != 0 && n < maxItems; ++n) {
+                taken |= bits & (~bits + 1);  // Lowest set bit
+                bits &= bits - 1;
+            }
+            // PITFALL: Clear BEFORE reading - a write landing after the read re-sets the bit
+            // (clearing afterwards would erase that newer bit and lose the update)
+            m_dirty[w].fetch_and(~taken, std::memory_order_acq_rel);
+            while (taken != 0) {
+                *out++ = read(w * 64 + lowestBit(taken));
+                taken &= taken - 1;
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    // Takes one key's undrained value (shard rebalancing: a moving slot's entries stay with the old owner)
+    // false = nothing pending for key
+    bool take(std::size_t key, TickUpdate& out) {
+        const std::uint64_t bit = std::uint64_t{1} << (key % 64);
+        // PITFALL: Clear before reading, like drain()
+        if ((m_dirty[key / 64].fetch_and(~bit, std::memory_order_acq_rel) & bit) == 0) {
+            return false;
+        }
+        out = read(key);
+        return true;
+    }
+
+    bool hasPending() const {
+        for (std::size_t w = 0; w < m_words; ++w) {
+            if (m_dirty[w].load(std::memory_order_acquire) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr std::size_t kWordsPerUpdate = (sizeof(TickUpdate) + 7) / 8;
+    static_assert(sizeof(TickUpdate) % 8 == 0, "TickUpdate copied as whole 64-bit words");
+
+    // REASON: Word-wise atomics make the seqlock copy race-free (no torn reads are ever used)
+    struct alignas(64) Entry {
+        std::atomic<std::uint32_t> seq{0};
+        std::atomic<std::uint64_t> words[kWordsPerUpdate] = {};
+    };
+
+    static unsigned lowestBit(std::uint64_t bits) {
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+    }
+
+    TickUpdate read(std::size_t key) const {
+        const Entry& entry = m_entries[key];
+        std::uint64_t words[kWordsPerUpdate];
+        std::uint32_t before = 0;
+        std::uint32_t after = 0;
+        do {
+            before = entry.seq.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < kWordsPerUpdate; ++i) {
+                words[i] = entry.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = entry.seq.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        TickUpdate update;
+        std::memcpy(&update, words, sizeof(TickUpdate));
+        return update;
+    }
+
+    const std::size_t m_keys;
+    const std::size_t m_words;
+    HugePageRegion m_region;
+    std::unique_ptr<Entry[]> m_heap;
+    Entry* m_entries = nullptr;                     // m_region or m_heap
+    std::unique_ptr<std::atomic<std::uint64_t>[]> m_dirty;
+};
+
+} // namespace tws_bridge
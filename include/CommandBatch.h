@@ -0,0 +1,179 @@
+// CommandBatch.h - One burst of TWS:COMMANDS reduced to its net subscription change + one ack per command
+// SCOPE: Command listener thread only (filled per message, flushed per batch window, then cleared)
+
+#pragma once
+
+#include "SubscriptionCommand.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+enum class AckStatus {
+    Queued,      // Handed to the message thread (its pacer sends the request)
+    Coalesced,   // Superseded by a later command for the same symbol in the same batch - nothing sent
+    Rejected     // Invalid JSON / schema violation / demand.enabled is off (error says which)
+};
+
+inline const char* ackStatusName(AckStatus status) {
+    switch (status) {
+        case AckStatus::Queued: return "queued";
+        case AckStatus::Coalesced: return "coalesced";
+        case AckStatus::Rejected: return "rejected";
+    }
+    return "queued";
+}
+
+inline const char* commandActionName(CommandAction action) {
+    switch (action) {
+        case CommandAction::Subscribe: return "subscribe";
+        case CommandAction::Unsubscribe: return "unsubscribe";
+        case CommandAction::Interest: return "interest";
+        case CommandAction::Release: return "release";
+        case CommandAction::Profile: return "profile";
+    }
+    return "subscribe";
+}
+
+// One TWS:STATUS {"type": "command_ack"} reply, in arrival order
+struct CommandAck {
+    std::string requestId;
+    std::string symbol;
+    CommandAction action = CommandAction::Subscribe;
+    AckStatus status = AckStatus::Queued;
+    std::string error;        // Rejected only
+};
+
+// A command still to route + its TWS:COMMANDS message (SymbolPartition writes it to the universe)
+struct BatchedCommand {
+    SubscriptionCommand command;
+    std::string payload;
+};
+
+// REASON: A session transition sends "unsubscribe X" / "subscribe X" pairs by the hundred - per symbol
+// only the net change reaches the message thread, so the pacer never spends a request on a stream the
+// same burst cancels again
+// NOTE: Keyed by symbol + option chain or not - a chain and the symbol's own feed are separate requests
+class CommandBatch {
+public:
+    std::size_t size() const { return m_acks.size(); }
+    bool empty() const { return m_acks.empty(); }
+    // Commands this batch has dropped so far (subscribe / unsubscribe a later command superseded)
+    std::size_t coalesced() const { return m_coalesced; }
+
+    // Subscribe / unsubscribe
+    // - subscribe after subscribe: the earlier one is coalesced (the latest feed / priority wins)
+    // - unsubscribe after subscribe: the subscribe is coalesced, the unsubscribe still goes out (the
+    //   symbol may have been subscribed before the batch)
+    // - unsubscribe after unsubscribe: the later one is coalesced
+    void add(SubscriptionCommand command, std::string payload) {
+        const std::size_t ack = addAck(command, AckStatus::Queued, {});
+        std::string key = command.symbol;
+        if (command.feed == FeedType::OptionChain) {
+            key += "\x1f" "chain";
+        }
+        auto found = m_index.find(key);
+        if (found == m_index.end()) {
+            found = m_index.emplace(std::move(key), m_entries.size()).first;
+            m_entries.emplace_back();
+        }
+        Entry& entry = m_entries[found->second];
+        if (command.action == CommandAction::Subscribe) {
+            if (entry.hasSubscribe) {
+                coalesce(entry.subscribeAck);
+            }
+            entry.subscribe = BatchedCommand{std::move(command), std::move(payload)};
+            entry.subscribeAck = ack;
+            entry.hasSubscribe = true;
+            return;
+        }
+        if (entry.hasSubscribe) {
+            coalesce(entry.subscribeAck);
+            entry.hasSubscribe = false;
+        }
+        if (entry.hasUnsubscribe) {
+            coalesce(ack);
+            return;
+        }
+        entry.unsubscribe = BatchedCommand{std::move(command), std::move(payload)};
+        entry.hasUnsubscribe = true;
+    }
+
+    // Interest / release: routed as they are (SubscriptionDemand refcounts every one)
+    void addPassThrough(SubscriptionCommand command, std::string payload) {
+        addAck(command, AckStatus::Queued, {});
+        m_passThrough.push_back(BatchedCommand{std::move(command), std::move(payload)});
+    }
+
+    // Handled by the listener itself (profile): acked, never routed
+    void acknowledge(const SubscriptionCommand& command) {
+        addAck(command, AckStatus::Queued, {});
+    }
+
+    // command: whatever the parser filled in before it failed (requestId / symbol may be empty)
+    void reject(const SubscriptionCommand& command, std::string error) {
+        addAck(command, AckStatus::Rejected, std::move(error));
+    }
+
+    // The commands to route, symbols in first-seen order: per symbol the unsubscribe (if the batch ends
+    // unsubscribed or resubscribes after one), then the final subscribe, then every interest / release
+    // NOTE: Moves the commands out - clear() before the next batch
+    std::vector<BatchedCommand>& net() {
+        m_net.clear();
+        for (Entry& entry : m_entries) {
+            if (entry.hasUnsubscribe) {
+                m_net.push_back(std::move(entry.unsubscribe));
+            }
+            if (entry.hasSubscribe) {
+                m_net.push_back(std::move(entry.subscribe));
+            }
+        }
+        for (BatchedCommand& command : m_passThrough) {
+            m_net.push_back(std::move(command));
+        }
+        return m_net;
+    }
+
+    const std::vector<CommandAck>& acks() const { return m_acks; }
+
+    // PERFORMANCE: Keeps the vectors' capacity, the next burst of the same size allocates no slots
+    void clear() {
+        m_entries.clear();
+        m_index.clear();
+        m_passThrough.clear();
+        m_net.clear();
+        m_acks.clear();
+        m_coalesced = 0;
+    }
+
+private:
+    struct Entry {
+        BatchedCommand unsubscribe;
+        BatchedCommand subscribe;
+        std::size_t subscribeAck = 0;
+        bool hasUnsubscribe = false;
+        bool hasSubscribe = false;
+    };
+
+    std::size_t addAck(const SubscriptionCommand& command, AckStatus status, std::string error) {
+        m_acks.push_back(CommandAck{command.requestId, command.symbol, command.action, status, std::move(error)});
+        return m_acks.size() - 1;
+    }
+
+    void coalesce(std::size_t ack) {
+        m_acks[ack].status = AckStatus::Coalesced;
+        ++m_coalesced;
+    }
+
+    std::vector<Entry> m_entries;                          // First-seen order
+    std::unordered_map<std::string, std::size_t> m_index;  // Key → m_entries index
+    std::vector<BatchedCommand> m_passThrough;
+    std::vector<BatchedCommand> m_net;
+    std::vector<CommandAck> m_acks;
+    std::size_t m_coalesced = 0;
+};
+
+} // namespace tws_bridge
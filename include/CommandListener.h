@@ -0,0 +1,93 @@
+// CommandListener.h - TWS:COMMANDS subscriber (Thread 4)
+// SCOPE: Own thread + own Redis connection, only hands parsed commands to the message thread
+
+#pragma once
+
+#include "CommandBatch.h"
+#include "SamplingProfiler.h"
+#include "Serialization.h"
+#include "SubscriptionCommand.h"
+#include "SymbolPartition.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+struct CommandListenerConfig {
+    std::string channel = "TWS:COMMANDS";
+    std::chrono::milliseconds pollTimeout{100};      // Socket timeout per consume() (bounds stop() latency)
+    std::chrono::milliseconds reconnectDelay{1000};  // Back-off after a Redis error
+    // commands.batch_window: commands gathered this long after the first of a burst, coalesced per
+    // symbol and routed together, 0 = each command on its own
+    std::chrono::milliseconds batchWindow{20};
+    std::size_t maxBatch = 1024;                     // A fuller batch is routed before its window ends
+    bool acks = true;                                // One {"type": "command_ack"} per command on statusChannel
+    std::string statusChannel = "TWS:STATUS";        // Follows worker.latency.status_channel (main)
+};
+
+// Lifetime counters (written by the listener thread, readable from any thread)
+struct CommandListenerCounters {
+    std::atomic<std::uint64_t> received{0};   // Messages on the command channel
+    std::atomic<std::uint64_t> rejected{0};   // Invalid JSON / schema violations
+    std::atomic<std::uint64_t> reconnects{0};
+    std::atomic<std::uint64_t> batches{0};    // Batches routed (one per command with batch_window 0)
+    std::atomic<std::uint64_t> coalesced{0};  // Subscribe / unsubscribe superseded inside their batch
+    std::atomic<std::uint64_t> acks{0};       // Replies published on the status channel
+};
+
+// ARCHITECTURE: Blocking SUBSCRIBE lives on its own thread (spec §4.2) - it never touches
+// EClient or the slot tables, TwsClient::applyCommands() runs the requests on the message thread
+class CommandListener {
+public:
+    CommandListener(const std::string& uri, CommandQueue& commands, CommandListenerConfig config = {});
+    // One queue per TWS connection: each command goes to connectionFor(symbol) (ConnectionRouting.h)
+    CommandListener(const std::string& uri, std::vector<CommandQueue*> commands, CommandListenerConfig config = {});
+    ~CommandListener();
+
+    CommandListener(const CommandListener&) = delete;
+    CommandListener& operator=(const CommandListener&) = delete;
+
+    // partition.enabled: commands go through the partition (only owned symbols reach the queues)
+    // Before start() only
+    void setPartition(SymbolPartition* partition) { m_partition = partition; }
+    // demand.enabled: interest / release commands go here (main thread, SubscriptionDemand), else rejected
+    // Before start() only
+    void setInterestQueue(CommandQueue* interest) { m_interest = interest; }
+    // profiler.enabled: {"action":"profile"} starts a profile here, else rejected
+    // Before start() only
+    void setProfiler(SamplingProfiler* profiler) { m_profiler = profiler; }
+
+    void start();
+    void stop();
+
+    const CommandListenerCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+    void onMessage(const std::string& payload);
+    bool batchDue() const;
+    // Routes the batch's net change and serializes its acks into m_replies (run() pipelines them)
+    void flush();
+
+    std::string m_uri;
+    std::vector<CommandQueue*> m_commands;  // By connection index
+    SymbolPartition* m_partition = nullptr;
+    CommandQueue* m_interest = nullptr;
+    SamplingProfiler* m_profiler = nullptr;
+    CommandListenerConfig m_config;
+    CommandListenerCounters m_counters;
+    CommandBatch m_batch;
+    std::chrono::steady_clock::time_point m_batchStart;       // First command of m_batch
+    JsonBuffer m_ack;
+    std::vector<std::string> m_replies;                       // Acks of the last flush(), in arrival order
+    std::vector<std::vector<SubscriptionCommand>> m_routed;   // By connection index, reused per batch
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,305 @@
+// ConfigFile.h - config.yaml reader (YAML subset) + typed value parsing
+// SCOPE: Startup and SIGHUP reload (main thread), cold path
+
+#pragma once
+
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+// One leaf: a scalar or a list of scalars
+struct ConfigValue {
+    std::string text;                    // Scalar, quotes removed
+    std::vector<std::string> items;      // List
+    bool list = false;
+    int line = 0;                        // 0 = command line (--set)
+
+    bool operator==(const ConfigValue& other) const {
+        return list == other.list && text == other.text && items == other.items;
+    }
+    bool operator!=(const ConfigValue& other) const { return !(*this == other); }
+};
+
+// Flattened "section.key" → value
+// Accepted YAML: nested block mappings (spaces only), "key: scalar", quoted scalars, flow lists
+// "[a, b]", block lists ("- a" lines under "key:") and # comments - no anchors, multi-line
+// strings or lists of mappings (thread placement is cpus: [..] + priority: N instead)
+// REASON: A small subset parser instead of a YAML library dependency for one startup file
+class ConfigFile {
+public:
+    // false (error = "path:line: why") if unreadable or outside the subset; values parsed so far are kept
+    bool load(const std::string& path, std::string& error) {
+        std::ifstream in(path);
+        if (!in) {
+            error = path + ": cannot open";
+            return false;
+        }
+        std::stringstream text;
+        text << in.rdbuf();
+        if (!parse(text.str(), error)) {
+            error = path + ":" + error;
+            return false;
+        }
+        return true;
+    }
+
+    // error = "line: why"
+    bool parse(std::string_view text, std::string& error) {
+        struct Open {
+            std::size_t indent;
+            std::string path;
+        };
+        std::vector<Open> open;  // "key:" lines enclosing the current one
+        int lineNumber = 0;
+        while (!text.empty()) {
+            const std::size_t end = text.find('\n');
+            std::string_view line = text.substr(0, end);
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+            ++lineNumber;
+            auto fail = [&](const std::string& why) {
+                error = std::to_string(lineNumber) + ": " + why;
+                return false;
+            };
+
+            line = stripComment(line);
+            const std::size_t indent = line.find_first_not_of(' ');
+            if (indent == std::string_view::npos) {
+                continue;
+            }
+            if (line[indent] == '\t') {
+                return fail("tab indentation (use spaces)");
+            }
+            std::string_view body = trim(line.substr(indent));
+
+            if (body == "-" || body.substr(0, 2) == "- ") {
+                // PITFALL: YAML allows the items at the key's own indentation
+                while (!open.empty() && indent < open.back().indent) {
+                    open.pop_back();
+                }
+                if (open.empty()) {
+                    return fail("list item without a key");
+                }
+                const std::string& key = open.back().path;
+                if (hasChildren(key)) {
+                    return fail("'" + key + "' mixes keys and list items");
+                }
+                std::string item;
+                if (!unquote(trim(body.substr(1)), item) || item.empty()) {
+                    return fail("bad list item");
+                }
+                ConfigValue& value = m_values[key];
+                value.list = true;
+                value.line = lineNumber;
+                value.items.push_back(std::move(item));
+                continue;
+            }
+
+            while (!open.empty() && indent <= open.back().indent) {
+                open.pop_back();
+            }
+            const std::size_t colon = body.find(':');
+            if (colon == std::string_view::npos || (colon + 1 < body.size() && body[colon + 1] != ' ')) {
+                return fail("expected 'key: value'");
+            }
+            const std::string_view name = trim(body.substr(0, colon));
+            if (!isKey(name)) {
+                return fail("bad key '" + std::string(name) + "'");
+            }
+            const std::string parent = open.empty() ? std::string() : open.back().path;
+            if (!parent.empty() && m_values.count(parent)) {
+                return fail("'" + parent + "' mixes a value and keys");
+            }
+            std::string path = parent.empty() ? std::string(name) : parent + "." + std::string(name);
+            const std::string_view rest = trim(body.substr(colon + 1));
+            if (rest.empty()) {
+                open.push_back(Open{indent, std::move(path)});
+                continue;
+            }
+            ConfigValue value;
+            value.line = lineNumber;
+            if (!parseValue(rest, value)) {
+                return fail("bad value for '" + path + "'");
+            }
+            if (m_values.count(path)) {
+                return fail("duplicate key '" + path + "'");
+            }
+            m_values.emplace(std::move(path), std::move(value));
+        }
+        return true;
+    }
+
+    // Command-line override "section.key=value" (value in file syntax), replaces a file value
+    bool set(std::string_view assignment, std::string& error) {
+        const std::size_t equals = assignment.find('=');
+        const std::string_view key = equals == std::string_view::npos ? std::string_view() : trim(assignment.substr(0, equals));
+        ConfigValue value;
+        if (key.empty() || !parseValue(trim(assignment.substr(equals + 1)), value)) {
+            error = "bad --set '" + std::string(assignment) + "' (expected section.key=value)";
+            return false;
+        }
+        m_values[std::string(key)] = std::move(value);
+        return true;
+    }
+
+    const ConfigValue* find(const std::string& key) const {
+        const auto it = m_values.find(key);
+        return it == m_values.end() ? nullptr : &it->second;
+    }
+    const std::map<std::string, ConfigValue>& values() const { return m_values; }
+
+private:
+    static std::string_view trim(std::string_view s) {
+        const std::size_t first = s.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return s.substr(first, s.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    // '#' starts a comment at line start or after a space, outside quotes
+    static std::string_view stripComment(std::string_view line) {
+        char quote = 0;
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            const char c = line[i];
+            if (quote) {
+                quote = c == quote ? 0 : quote;
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == '#' && (i == 0 || line[i - 1] == ' ' || line[i - 1] == '\t')) {
+                return line.substr(0, i);
+            }
+        }
+        return line;
+    }
+
+    static bool isKey(std::string_view name) {
+        if (name.empty()) {
+            return false;
+        }
+        for (char c : name) {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-')) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool unquote(std::string_view s, std::string& out) {
+        if (!s.empty() && (s.front() == '"' || s.front() == '\'')) {
+            if (s.size() < 2 || s.back() != s.front()) {
+                return false;
+            }
+            out = std::string(s.substr(1, s.size() - 2));
+            return true;
+        }
+        out = std::string(s);
+        return true;
+    }
+
+    static bool parseValue(std::string_view text, ConfigValue& value) {
+        if (text.empty() || text.front() != '[') {
+            return unquote(text, value.text);
+        }
+        if (text.back() != ']') {
+            return false;
+        }
+        value.list = true;
+        std::string_view inner = trim(text.substr(1, text.size() - 2));
+        while (!inner.empty()) {
+            char quote = 0;
+            std::size_t comma = 0;
+            for (; comma < inner.size() && (quote || inner[comma] != ','); ++comma) {
+                if (inner[comma] == '"' || inner[comma] == '\'') {
+                    quote = quote == inner[comma] ? 0 : quote ? quote : inner[comma];
+                }
+            }
+            std::string item;
+            if (!unquote(trim(inner.substr(0, comma)), item) || item.empty()) {
+                return false;
+            }
+            value.items.push_back(std::move(item));
+            inner = comma < inner.size() ? trim(inner.substr(comma + 1)) : std::string_view();
+        }
+        return true;
+    }
+
+    bool hasChildren(const std::string& key) const {
+        const auto it = m_values.lower_bound(key + ".");
+        return it != m_values.end() && it->first.compare(0, key.size() + 1, key + ".") == 0;
+    }
+
+    std::map<std::string, ConfigValue> m_values;
+};
+
+// ========== Typed scalars ==========
+
+inline bool parseConfigInt(std::string_view text, long long& out) {
+    const char* last = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), last, out);
+    return !text.empty() && result.ec == std::errc() && result.ptr == last;
+}
+
+inline bool parseConfigDouble(std::string_view text, double& out) {
+    const std::string copy(text);  // REASON: strtod needs a terminator
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtod(copy.c_str(), &end);
+    return !copy.empty() && errno == 0 && end == copy.c_str() + copy.size();
+}
+
+inline bool parseConfigBool(std::string_view text, bool& out) {
+    if (text == "true" || text == "yes" || text == "on") {
+        out = true;
+        return true;
+    }
+    if (text == "false" || text == "no" || text == "off") {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+// "<integer><unit>", unit ns / us / ms / s / m / h (e.g. 500us, 100ms, 30s)
+// false if malformed or not a whole number of the target's ticks (500us into milliseconds)
+template <typename Rep, typename Period>
+bool parseConfigDuration(std::string_view text, std::chrono::duration<Rep, Period>& out) {
+    const std::size_t unit = text.find_first_not_of("0123456789");
+    long long count = 0;
+    if (unit == 0 || unit == std::string_view::npos || !parseConfigInt(text.substr(0, unit), count)) {
+        return false;
+    }
+    const std::string_view suffix = text.substr(unit);
+    std::chrono::nanoseconds value;
+    if (suffix == "ns") {
+        value = std::chrono::nanoseconds(count);
+    } else if (suffix == "us") {
+        value = std::chrono::microseconds(count);
+    } else if (suffix == "ms") {
+        value = std::chrono::milliseconds(count);
+    } else if (suffix == "s") {
+        value = std::chrono::seconds(count);
+    } else if (suffix == "m") {
+        value = std::chrono::minutes(count);
+    } else if (suffix == "h") {
+        value = std::chrono::hours(count);
+    } else {
+        return false;
+    }
+    const auto converted = std::chrono::duration_cast<std::chrono::duration<Rep, Period>>(value);
+    if (std::chrono::duration_cast<std::chrono::nanoseconds>(converted) != value) {
+        return false;
+    }
+    out = converted;
+    return true;
+}
+
+} // namespace tws_bridge
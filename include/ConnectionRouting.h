@@ -0,0 +1,29 @@
+// ConnectionRouting.h - Symbol → TWS connection assignment (one connection per client ID)
+// SCOPE: Startup subscriptions (main thread), CommandListener (routes TWS:COMMANDS per connection)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tws_bridge {
+
+// Connection index (0 .. connections - 1) owning a symbol
+// ARCHITECTURE: Stateless hash - subscribe and unsubscribe for a symbol always reach the same connection
+// (its tickerIds and subscription table live there), with no shared assignment table between threads
+// NOTE: Independent of the worker shard (slot % N) - any connection can feed any shard
+inline std::size_t connectionFor(std::string_view symbol, std::size_t connections) {
+    if (connections <= 1) {
+        return 0;
+    }
+    // REASON: FNV-1a, stable across runs and platforms (std::hash is not specified to be)
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : symbol) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(hash % connections);
+}
+
+} // namespace tws_bridge
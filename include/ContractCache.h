@@ -0,0 +1,145 @@
+// ContractCache.h - Persistent symbol → conId / primary exchange map (reqContractDetails results)
+// SCOPE: Loaded once at startup, read and written at subscribe time (every connection's message thread),
+// saved by the main thread - cold path only
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace tws_bridge {
+
+struct CachedContract {
+    int conId = 0;
+    std::string primaryExchange;   // e.g. "NASDAQ" (disambiguates SMART-routed symbols)
+    std::int64_t resolvedAt = 0;   // Epoch seconds of the reqContractDetails answer
+};
+
+struct ContractCacheConfig {
+    std::string path = "contracts.tsv";  // "" = off (every symbol subscribes by symbol, nothing resolved)
+    // Entries older than this still subscribe by conId, but are resolved again in the background
+    std::chrono::seconds maxAge{std::chrono::hours(24 * 7)};
+};
+
+// REASON: A resolved conId makes the subscribe unambiguous and saves a paced reqContractDetails
+// round trip per symbol on the next start
+// File: one "SYMBOL<TAB>conId<TAB>primaryExchange<TAB>resolvedAt" line per symbol
+class ContractCache {
+public:
+    // Missing file = empty cache (first start); false (error = "path:line: why") on a malformed line,
+    // the lines before it are kept
+    bool load(const std::string& path, std::string& error) {
+        std::ifstream in(path);
+        if (!in) {
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream fields(line);
+            std::string symbol;
+            std::string conId;
+            std::string exchange;
+            std::string resolvedAt;
+            CachedContract contract;
+            if (!std::getline(fields, symbol, '\t') || !std::getline(fields, conId, '\t')
+                || !std::getline(fields, exchange, '\t') || !std::getline(fields, resolvedAt, '\t')
+                || symbol.empty() || !parseInt(conId, contract.conId) || contract.conId <= 0
+                || !parseInt(resolvedAt, contract.resolvedAt)) {
+                error = path + ":" + std::to_string(lineNumber) + ": expected SYMBOL<TAB>conId<TAB>exchange<TAB>time";
+                return false;
+            }
+            contract.primaryExchange = std::move(exchange);
+            m_contracts[symbol] = std::move(contract);
+        }
+        return true;
+    }
+
+    // Writes path.tmp, then renames it over path (a crash never leaves a truncated cache)
+    bool save(const std::string& path, std::string& error) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::trunc);
+            if (!out) {
+                error = temporary + ": cannot open";
+                return false;
+            }
+            out << "# symbol\tconId\tprimaryExchange\tresolvedAt (tws-redis-bridge contract cache)\n";
+            for (const auto& [symbol, contract] : m_contracts) {
+                out << symbol << '\t' << contract.conId << '\t' << contract.primaryExchange << '\t'
+                    << contract.resolvedAt << '\n';
+            }
+            if (!out.flush()) {
+                error = temporary + ": write failed";
+                return false;
+            }
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            error = path + ": rename failed";
+            return false;
+        }
+        m_dirty = false;
+        return true;
+    }
+
+    bool find(const std::string& symbol, CachedContract& out) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_contracts.find(symbol);
+        if (it == m_contracts.end()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    void store(const std::string& symbol, CachedContract contract) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_contracts[symbol] = std::move(contract);
+        m_dirty = true;
+    }
+
+    // Unsaved entries since the last load / save
+    bool dirty() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_dirty;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_contracts.size();
+    }
+
+    // A cached entry past maxAge (now / resolvedAt in epoch seconds)
+    static bool stale(const CachedContract& contract, std::int64_t now, std::chrono::seconds maxAge) {
+        return now - contract.resolvedAt > maxAge.count();
+    }
+
+private:
+    template <typename Int>
+    static bool parseInt(const std::string& text, Int& out) {
+        if (text.empty()) {
+            return false;
+        }
+        std::istringstream in(text);
+        in >> out;
+        return !in.fail() && in.eof();
+    }
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, CachedContract> m_contracts;  // Sorted - stable, diffable file
+    bool m_dirty = false;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,49 @@
+// CorkedClientSocket.h - EClientSocket whose outbound requests can be held and sent as one write
+// SCOPE: Owned by TwsClient, used only by the thread that sends requests (the message thread)
+
+#pragma once
+
+#include "EWrapper.h"
+#include "EClientSocket.h"  // REASON: After EWrapper.h (EClient.h relies on its <map> include)
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class EReaderSignal;
+
+namespace tws_bridge {
+
+// EClientSocket with a corkable transport: between cork() and uncork() every encoded request is
+// appended to one buffer, uncork() hands the whole burst to ESocket in a single send()
+// PERFORMANCE: A pacing burst of N reqTickByTickData / cancel* = 1 syscall and one TCP segment
+// train instead of N small writes (and N Nagle / delayed-ACK interactions)
+// NOTE: Pacing is unchanged - TWS counts messages, not writes, and RequestPacer decides what
+// goes into a burst
+class CorkedClientSocket : public EClientSocket {
+public:
+    CorkedClientSocket(EWrapper* wrapper, EReaderSignal* signal);
+
+    void cork();
+    void uncork();                                  // Sends the held requests (no-op if none)
+
+    std::uint64_t corkedWrites() const { return m_corkedWrites; }  // Bursts sent as one write
+
+    // Corks for the guard's lifetime
+    class Batch {
+    public:
+        explicit Batch(CorkedClientSocket& client) : m_client(client) { m_client.cork(); }
+        ~Batch() { m_client.uncork(); }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+
+    private:
+        CorkedClientSocket& m_client;
+    };
+
+private:
+    class Transport;
+    Transport* m_corkable;                          // Owned by EClient::m_transport
+    std::uint64_t m_corkedWrites = 0;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,90 @@
+// Deadband.h - Per-instrument publish deadbands: a snapshot goes out only when its prices or sizes moved
+// far enough from the last one published, or when a held-back change has waited a heartbeat
+// SCOPE: Redis Worker thread (rules resolved once per slot, compared at publish time)
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+// One deadband: all zero = every change is significant
+struct DeadbandRule {
+    double minMove = 0.0;                           // Price units: mid (each side if one is missing) and last
+    double minSizeChange = 0.0;                     // Fraction of the published size (0.2 = 20%)
+    // A held-back change is published once the last publish is this old, 0 = held until a significant one
+    std::chrono::milliseconds heartbeat{0};
+};
+
+// Symbols sharing a rule (an instrument class; a single symbol for a per-instrument override)
+struct DeadbandClass {
+    std::string name;
+    std::vector<std::string> symbols;
+    DeadbandRule rule;
+};
+
+// worker.deadband: defaults + classes, first class listing the symbol wins
+struct DeadbandConfig {
+    bool enabled = false;
+    DeadbandRule defaults;
+    std::vector<DeadbandClass> classes;
+
+    // NOTE: Linear - resolved once per slot when it is bound, never per tick
+    const DeadbandRule& ruleFor(const std::string& symbol) const {
+        for (const DeadbandClass& deadbandClass : classes) {
+            for (const std::string& member : deadbandClass.symbols) {
+                if (member == symbol) {
+                    return deadbandClass.rule;
+                }
+            }
+        }
+        return defaults;
+    }
+};
+
+// The fields a deadband compares (the last published snapshot vs the current state)
+struct DeadbandQuote {
+    double bidPrice = 0.0;
+    double askPrice = 0.0;
+    double lastPrice = 0.0;
+    std::int64_t bidSize = 0;                       // Units at one scale (InstrumentState::sizeScale)
+    std::int64_t askSize = 0;
+    std::int64_t lastSize = 0;
+};
+
+// true: current differs from published by at least one of rule's thresholds
+// PERFORMANCE: A handful of compares on fields already in cache - a held-back change costs no encoding,
+// no payload and no pipeline entry
+// PITFALL: Thresholds are measured against the last published values, not the previous update - small
+// steps in one direction add up and publish once they cross the band
+inline bool deadbandMoved(const DeadbandRule& rule, const DeadbandQuote& published, const DeadbandQuote& current) {
+    // REASON: Tolerance - 100.01 - 100.00 is 0.00999... in binary, one tick must still count as one tick
+    auto moved = [&rule](double before, double after) {
+        const double distance = std::abs(after - before);
+        return rule.minMove > 0.0 ? distance >= rule.minMove * (1.0 - 1e-9) : distance != 0.0;
+    };
+    auto resized = [&rule](std::int64_t before, std::int64_t after) {
+        const double distance = std::abs(static_cast<double>(after) - static_cast<double>(before));
+        return rule.minSizeChange > 0.0 ? distance > rule.minSizeChange * static_cast<double>(before) : distance != 0.0;
+    };
+    // NOTE: Mid when both snapshots are two-sided - a band needs a move of the mid, not of either side alone
+    const bool twoSided = published.bidPrice > 0.0 && published.askPrice > 0.0
+                       && current.bidPrice > 0.0 && current.askPrice > 0.0;
+    if (twoSided && rule.minMove > 0.0) {
+        if (moved((published.bidPrice + published.askPrice) / 2.0, (current.bidPrice + current.askPrice) / 2.0)) {
+            return true;
+        }
+    } else if (moved(published.bidPrice, current.bidPrice) || moved(published.askPrice, current.askPrice)) {
+        return true;  // NOTE: Includes a side appearing or disappearing
+    }
+    return moved(published.lastPrice, current.lastPrice)
+        || resized(published.bidSize, current.bidSize)
+        || resized(published.askSize, current.askSize)
+        || resized(published.lastSize, current.lastSize);
+}
+
+} // namespace tws_bridge
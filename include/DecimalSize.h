@@ -0,0 +1,133 @@
+// DecimalSize.h - TWS Decimal (Intel BID64) → double / whole shares / Quantity, decoded in place for the
+// common encodings, libbid for the rest
+// SCOPE: TwsClient EWrapper callbacks, BridgeReader fast-path size fallback (links libbid)
+
+#pragma once
+
+#include "Decimal.h"
+#include "Quantity.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+namespace decimal_detail {
+
+// 10^0 .. 10^22 - every one exact as a double
+inline constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+inline constexpr int kMaxExactPow10 = 22;
+
+constexpr int kExponentBias = 398;
+
+} // namespace decimal_detail
+
+// Splits a BID64 value into sign, coefficient and power of ten (value = ±coefficient * 10^exponent)
+// false for the large-coefficient encoding (combination bits 11), infinities and NaN (UNSET_DECIMAL)
+// NOTE: That encoding only holds coefficients of 2^53 and above - never a size or price TWS sends
+inline bool decodeBid64(Decimal decimal, bool& negative, std::uint64_t& coefficient, int& exponent) {
+    const std::uint64_t bits = decimal;
+    if ((bits >> 61 & 0x3u) == 0x3u) {
+        return false;
+    }
+    negative = (bits >> 63) != 0;
+    exponent = static_cast<int>(bits >> 53 & 0x3FFu) - decimal_detail::kExponentBias;
+    coefficient = bits & ((std::uint64_t{1} << 53) - 1);
+    return true;
+}
+
+// DecimalFunctions::decimalToDouble without the libbid call for coefficients below 2^53 and |exponent| <= 22
+// PERFORMANCE: One multiply or divide of two exact doubles - correctly rounded, so bit-identical to
+// __bid64_to_binary64 (round to nearest) for every value it handles; libbid only for the rest
+inline double decimalToDouble(Decimal decimal) {
+    bool negative = false;
+    std::uint64_t coefficient = 0;
+    int exponent = 0;
+    if (decodeBid64(decimal, negative, coefficient, exponent) && exponent >= -decimal_detail::kMaxExactPow10
+        && exponent <= decimal_detail::kMaxExactPow10) {
+        double value = static_cast<double>(coefficient);  // REASON: < 2^53 - exact
+        value = exponent >= 0 ? value * decimal_detail::kPow10[exponent] : value / decimal_detail::kPow10[-exponent];
+        return negative ? -value : value;
+    }
+    return DecimalFunctions::decimalToDouble(decimal);
+}
+
+// PITFALL: Decimal is the raw bid64 bit pattern - static_cast<int>(decimal) is NOT the value
+// PERFORMANCE: Integer arithmetic for exponents -18..18 (whole and fractional sizes, half away from zero like
+// llround) - no double, no libbid
+inline std::int64_t decimalToShares(Decimal decimal) {
+    bool negative = false;
+    std::uint64_t coefficient = 0;
+    int exponent = 0;
+    if (decodeBid64(decimal, negative, coefficient, exponent) && exponent >= -18 && exponent <= 18) {
+        std::uint64_t shares = coefficient;
+        if (exponent < 0) {
+            const auto divisor = static_cast<std::uint64_t>(quantity_detail::kPow10[-exponent]);
+            shares = coefficient / divisor + (coefficient % divisor * 2 >= divisor ? 1 : 0);
+        } else if (exponent > 0) {
+            const auto factor = static_cast<std::uint64_t>(quantity_detail::kPow10[exponent]);
+            if (coefficient > static_cast<std::uint64_t>(INT64_MAX) / factor) {
+                return 0;  // NOTE: Past int64 - no share count is this large
+            }
+            shares = coefficient * factor;
+        }
+        const auto value = static_cast<std::int64_t>(shares);
+        return negative ? -value : value;
+    }
+    const double value = DecimalFunctions::decimalToDouble(decimal);
+    if (!std::isfinite(value)) {
+        return 0;  // UNSET_DECIMAL (NaN) / infinities
+    }
+    return static_cast<std::int64_t>(std::llround(value));
+}
+
+// Size as a scaled integer at the fewest decimal places that hold it - the exact value, not whole shares
+// PERFORMANCE: Integer arithmetic on the BID64 coefficient (trailing zeros stripped), libbid (whole units)
+// only for the encodings decodeBid64 leaves to it; UNSET_DECIMAL (NaN) → 0
+inline Quantity decimalToQuantity(Decimal decimal) {
+    bool negative = false;
+    std::uint64_t coefficient = 0;
+    int exponent = 0;
+    if (decodeBid64(decimal, negative, coefficient, exponent) && exponent >= -18 && exponent <= 18) {
+        while (exponent < 0 && coefficient != 0 && coefficient % 10 == 0) {
+            coefficient /= 10;
+            ++exponent;
+        }
+        Quantity quantity;
+        quantity.units = static_cast<std::int64_t>(coefficient);  // REASON: < 2^53
+        if (exponent > 0) {
+            quantity.units = rescaleUnits(quantity.units, 0, exponent);
+        } else if (exponent < 0) {
+            quantity.scale = -exponent;
+            if (quantity.scale > kMaxQuantityScale) {
+                quantity.units = rescaleUnits(quantity.units, quantity.scale, kMaxQuantityScale);
+                quantity.scale = kMaxQuantityScale;
+            }
+        }
+        if (negative) {
+            quantity.units = -quantity.units;
+        }
+        return quantity;
+    }
+    return Quantity{decimalToShares(decimal), 0};
+}
+
+// SizeFallback for parseTickByTick: fields parseQuantity does not take ("1E2") through the BID parse of
+// EDecoder::DecodeField(Decimal&), false if libbid cannot read it either
+inline bool bidTextToQuantity(std::string_view text, std::int64_t& units, int& scale) {
+    Quantity quantity;
+    if (!parseQuantity(text, quantity)) {
+        const Decimal decimal = DecimalFunctions::stringToDecimal(std::string(text));
+        if (!std::isfinite(DecimalFunctions::decimalToDouble(decimal))) {
+            return false;
+        }
+        quantity = decimalToQuantity(decimal);
+    }
+    units = quantity.units;
+    scale = quantity.scale;
+    return true;
+}
+
+} // namespace tws_bridge
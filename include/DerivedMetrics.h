@@ -0,0 +1,109 @@
+// DerivedMetrics.h - Incremental per-instrument metrics (mid, spread, session VWAP, rolling volume)
+// SCOPE: Redis Worker thread - part of InstrumentState, updated in O(1) per BidAsk / AllLast
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+// Trading session of a timestamp: days counted from sessionResetMs into the UTC day (floor, also before 1970)
+inline std::int64_t sessionNumber(std::int64_t timestampMs, std::int64_t sessionResetMs) {
+    constexpr std::int64_t kDayMs = 86400000;
+    const std::int64_t shifted = timestampMs - sessionResetMs;
+    return shifted >= 0 ? shifted / kDayMs : (shifted - kDayMs + 1) / kDayMs;
+}
+
+// Traded volume over a sliding time window, as of the last trade
+// PERFORMANCE: kBuckets sub-window buckets + running total - no per-trade history, amortized O(1)
+// NOTE: Window edge resolution is one bucket (window / kBuckets)
+class RollingVolume {
+public:
+    static constexpr std::size_t kBuckets = 60;
+
+    void setWindow(std::int64_t windowMs) {
+        m_bucketMs = windowMs >= static_cast<std::int64_t>(kBuckets) ? windowMs / static_cast<std::int64_t>(kBuckets) : 1;
+        reset();
+    }
+
+    void add(std::int64_t timestampMs, std::int64_t size) {
+        const std::int64_t bucket = timestampMs / m_bucketMs;
+        if (m_total == 0 && m_head == 0) {
+            m_head = bucket;
+        }
+        if (bucket > m_head) {
+            // REASON: Clearing is bounded by kBuckets even after a long quiet period
+            const std::int64_t steps = bucket - m_head;
+            const std::int64_t clear = steps < static_cast<std::int64_t>(kBuckets) ? steps : static_cast<std::int64_t>(kBuckets);
+            for (std::int64_t i = 1; i <= clear; ++i) {
+                std::int64_t& slot = m_buckets[index(m_head + i)];
+                m_total -= slot;
+                slot = 0;
+            }
+            m_head = bucket;
+        } else if (bucket <= m_head - static_cast<std::int64_t>(kBuckets)) {
+            return;  // Older than the window
+        }
+        m_buckets[index(bucket)] += size;
+        m_total += size;
+    }
+
+    std::int64_t total() const { return m_total; }
+
+    void reset() {
+        m_buckets.fill(0);
+        m_total = 0;
+        m_head = 0;
+    }
+
+private:
+    static std::size_t index(std::int64_t bucket) {
+        const std::int64_t i = bucket % static_cast<std::int64_t>(kBuckets);
+        return static_cast<std::size_t>(i < 0 ? i + static_cast<std::int64_t>(kBuckets) : i);
+    }
+
+    std::array<std::int64_t, kBuckets> m_buckets{};
+    std::int64_t m_bucketMs = 1000;
+    std::int64_t m_head = 0;     // Newest bucket number
+    std::int64_t m_total = 0;
+};
+
+// Snapshot "derived" fields - computed once at the bridge instead of in every consumer
+struct DerivedMetrics {
+    double mid = 0.0;            // (bid + ask) / 2, 0 until both sides are quoted
+    double spread = 0.0;         // ask - bid, 0 until both sides are quoted
+    double vwap = 0.0;           // Session volume-weighted trade price, 0 before the first trade
+    std::int64_t sessionVolume = 0;
+    double sessionNotional = 0.0;
+    std::int64_t sessionDay = -1;  // Session number of the last trade (see onTrade)
+    RollingVolume rolling;
+
+    void onQuote(double bidPrice, double askPrice) {
+        if (bidPrice > 0.0 && askPrice > 0.0) {
+            mid = (bidPrice + askPrice) * 0.5;
+            spread = askPrice - bidPrice;
+        } else {
+            mid = 0.0;
+            spread = 0.0;
+        }
+    }
+
+    // sessionResetMs: session boundary as an offset into the UTC day (e.g. 09:00 UTC = 32400000)
+    void onTrade(std::int64_t timestampMs, double price, std::int64_t size, std::int64_t sessionResetMs) {
+        const std::int64_t day = sessionNumber(timestampMs, sessionResetMs);
+        if (day != sessionDay) {
+            // REASON: VWAP is a session statistic - yesterday's notional must not leak into today
+            sessionDay = day;
+            sessionVolume = 0;
+            sessionNotional = 0.0;
+        }
+        sessionVolume += size;
+        sessionNotional += price * static_cast<double>(size);
+        vwap = sessionVolume > 0 ? sessionNotional / static_cast<double>(sessionVolume) : price;
+        rolling.add(timestampMs, size);
+    }
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,241 @@
+// EncoderPool.h - Aggregate arrays encoded (and compressed) on a pool of threads, published in order
+// SCOPE: Worker thread appends / submits / collects, the pool threads only encode
+
+#pragma once
+
+#include "Lz4Frame.h"
+#include "MarketData.h"
+#include "Serialization.h"
+#include "SnapshotEncoder.h"
+#include "ThreadAffinity.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <blockingconcurrentqueue.h>
+
+namespace tws_bridge {
+
+// How the pool encodes an array (the worker's snapshot settings, see WorkerConfig)
+struct ArrayEncoding {
+    SnapshotSchema schema = SnapshotSchema::Verbose;
+    bool withDerived = false;
+    bool withIsoTime = false;
+    PriceFormat prices = PriceFormat::Shortest;
+    bool sendTimestamps = false;                    // "sent" = when the pool thread encodes the snapshot
+    bool compress = false;                          // CompressionConfig::aggregate
+    std::size_t compressMinBytes = 512;
+};
+
+// Lifetime counters (readable from any thread)
+struct EncoderPoolCounters {
+    std::atomic<std::uint64_t> arrays{0};           // Arrays encoded
+    std::atomic<std::uint64_t> snapshots{0};        // Snapshots in them
+    std::atomic<std::uint64_t> stalls{0};           // Appends that waited for the oldest array (all in flight)
+};
+
+// The worker copies each aggregated snapshot's state into the open batch, submit() hands it to the pool
+// (its place in the in-flight FIFO is its sequence number), collect() publishes finished batches strictly
+// in submit order
+// ARCHITECTURE: Reassembly is a FIFO of in-flight batches on the worker - the head is published only
+// once encoded, so a later batch finished first waits; per-symbol (and array) order is the worker's
+// PERFORMANCE: Encoding + LZ4 scale with the threads, the worker keeps aggregation and the Redis pipeline
+// BACKPRESSURE: maxBatches bounds memory - with all of them in flight, the worker waits for the oldest
+class EncoderPool {
+public:
+    EncoderPool(std::size_t threads, std::size_t maxBatches, ArrayEncoding encoding, std::size_t shardId = 0,
+                ThreadConfig thread = {})
+        : m_threadCount(threads == 0 ? 1 : threads)
+        , m_encoding(encoding)
+        , m_shardId(shardId)
+        , m_thread(thread)
+        , m_jobs(maxBatches == 0 ? 1 : maxBatches)
+        , m_inFlight(maxBatches == 0 ? 1 : maxBatches) {
+        for (std::size_t i = 0; i < m_inFlight.size(); ++i) {
+            m_batches.push_back(std::make_unique<Batch>());
+            m_free.push_back(m_batches.back().get());
+        }
+    }
+
+    ~EncoderPool() { stop(); }
+
+    EncoderPool(const EncoderPool&) = delete;
+    EncoderPool& operator=(const EncoderPool&) = delete;
+
+    void start() {
+        if (!m_threads.empty()) {
+            return;
+        }
+        m_running.store(true, std::memory_order_release);
+        for (std::size_t i = 0; i < m_threadCount; ++i) {
+            m_threads.emplace_back([this, i]() { run(i); });
+        }
+    }
+
+    // Joins the pool threads - drain() first, a batch still queued is not encoded
+    void stop() {
+        m_running.store(false, std::memory_order_release);
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+        m_threads.clear();
+    }
+
+    // ========== Worker thread ==========
+    // Copies state into the open batch (opened on the first append after a submit)
+    // publish(std::string_view array): called for finished arrays if every batch is in flight
+    template <typename Publish>
+    void append(const InstrumentState& state, Publish&& publish) {
+        if (!m_open) {
+            if (m_free.empty()) {
+                m_counters.stalls.fetch_add(1, std::memory_order_relaxed);
+                publishOldest(publish);
+            }
+            m_open = m_free.back();
+            m_free.pop_back();
+            m_open->count = 0;
+        }
+        Batch& batch = *m_open;
+        if (batch.count == batch.states.size()) {
+            batch.states.push_back(state);
+        } else {
+            batch.states[batch.count] = state;  // REASON: Copy-assign keeps the symbol's capacity
+        }
+        ++batch.count;
+    }
+
+    // Snapshots in the open batch
+    std::size_t pending() const { return m_open ? m_open->count : 0; }
+
+    // Hands the open batch to the pool (no-op without one)
+    void submit() {
+        if (!m_open) {
+            return;
+        }
+        Batch* batch = m_open;
+        m_open = nullptr;
+        batch->done.store(false, std::memory_order_relaxed);
+        m_inFlight[(m_head + m_inFlightCount) % m_inFlight.size()] = batch;
+        ++m_inFlightCount;
+        m_jobs.enqueue(batch);  // NOTE: At most maxBatches queued (the capacity it was created with)
+    }
+
+    // Publishes finished arrays in submit order, returns how many
+    template <typename Publish>
+    std::size_t collect(Publish&& publish) {
+        std::size_t published = 0;
+        while (m_inFlightCount > 0 && m_inFlight[m_head]->done.load(std::memory_order_acquire)) {
+            release(publish);
+            ++published;
+        }
+        return published;
+    }
+
+    // Submits the open batch and publishes every array (waits for the pool)
+    template <typename Publish>
+    void drain(Publish&& publish) {
+        submit();
+        while (m_inFlightCount > 0) {
+            publishOldest(publish);
+        }
+    }
+
+    // Arrays submitted, not yet published (the worker must not park on them)
+    std::size_t inFlight() const { return m_inFlightCount; }
+    std::size_t threads() const { return m_threadCount; }
+    const EncoderPoolCounters& counters() const { return m_counters; }
+
+private:
+    struct Batch {
+        std::vector<InstrumentState> states;        // REASON: Capacity (and symbol strings) kept across reuse
+        std::size_t count = 0;
+        std::string array;                          // "[s1,s2,...]"
+        std::string compressed;
+        std::string_view payload;                   // array or compressed
+        std::atomic<bool> done{false};
+    };
+
+    // Oldest in-flight array, once its encoder finished it
+    template <typename Publish>
+    void publishOldest(Publish& publish) {
+        while (!m_inFlight[m_head]->done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        release(publish);
+    }
+
+    template <typename Publish>
+    void release(Publish& publish) {
+        Batch* batch = m_inFlight[m_head];
+        m_head = (m_head + 1) % m_inFlight.size();
+        --m_inFlightCount;
+        publish(batch->payload);
+        m_free.push_back(batch);
+    }
+
+    void run(std::size_t index) {
+        const std::string name = "tws-enc-" + std::to_string(m_shardId) + "-" + std::to_string(index);
+        configureCurrentThread(name.c_str(), m_thread);
+        JsonBuffer json;
+        Lz4Compressor lz4;
+        while (m_running.load(std::memory_order_acquire)) {
+            Batch* batch = nullptr;
+            // REASON: Bounded wait (μs) keeps stop() responsive
+            if (!m_jobs.wait_dequeue_timed(batch, std::int64_t{100000})) {
+                continue;
+            }
+            encode(*batch, json, lz4);
+            m_counters.arrays.fetch_add(1, std::memory_order_relaxed);
+            m_counters.snapshots.fetch_add(batch->count, std::memory_order_relaxed);
+            batch->done.store(true, std::memory_order_release);
+        }
+    }
+
+    // Same bytes as the worker's SnapshotArray + compress() would publish
+    void encode(Batch& batch, JsonBuffer& json, Lz4Compressor& lz4) const {
+        batch.array.clear();
+        for (std::size_t i = 0; i < batch.count; ++i) {
+            const std::int64_t sentNs = m_encoding.sendTimestamps
+                ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch()).count()
+                : 0;
+            encodeSnapshot(batch.states[i], json, m_encoding.schema, m_encoding.withDerived, m_encoding.withIsoTime,
+                           m_encoding.prices, sentNs);
+            batch.array += i == 0 ? '[' : ',';
+            batch.array.append(json.data(), json.size());
+        }
+        batch.array += ']';
+        batch.payload = batch.array;
+        if (m_encoding.compress && batch.array.size() >= m_encoding.compressMinBytes) {
+            batch.compressed.clear();
+            lz4.compressFrame(batch.array, batch.compressed);
+            if (batch.compressed.size() < batch.array.size()) {
+                batch.payload = batch.compressed;
+            }
+        }
+    }
+
+    const std::size_t m_threadCount;
+    const ArrayEncoding m_encoding;
+    const std::size_t m_shardId;
+    const ThreadConfig m_thread;
+    moodycamel::BlockingConcurrentQueue<Batch*> m_jobs;  // Worker → pool threads
+    std::vector<std::unique_ptr<Batch>> m_batches;
+    // Worker thread only
+    std::vector<Batch*> m_free;
+    Batch* m_open = nullptr;
+    std::vector<Batch*> m_inFlight;                 // Ring in submit order
+    std::size_t m_head = 0;
+    std::size_t m_inFlightCount = 0;
+
+    std::atomic<bool> m_running{false};
+    std::vector<std::thread> m_threads;
+    EncoderPoolCounters m_counters;
+};
+
+} // namespace tws_bridge
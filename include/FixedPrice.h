@@ -0,0 +1,50 @@
+// FixedPrice.h - Prices as int64 ticks of 1e-4, formatted with integer arithmetic only
+// SCOPE: Redis Worker snapshot encoder (PriceFormat::FixedPoint)
+
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+namespace tws_bridge {
+
+inline constexpr int kPriceDecimals = 4;
+inline constexpr std::int64_t kPriceScale = 10000;  // 10^kPriceDecimals (US equities quote in 1e-4 below $1)
+
+// Nearest tick; false for NaN / Inf / magnitudes that do not fit (caller keeps the double path)
+// NOTE: Exact for every price TWS sends with <= 4 decimals - the parsed double is within half an ulp
+// of the decimal, far below half a tick, so rounding recovers it
+inline bool toPriceTicks(double price, std::int64_t& ticks) {
+    if (!std::isfinite(price) || std::fabs(price) >= 9.0e14) {
+        return false;
+    }
+    ticks = std::llround(price * static_cast<double>(kPriceScale));
+    return true;
+}
+
+// "171.55", "-0.0001", "172.0": trailing zeros trimmed, at least one fractional digit (RapidJSON layout
+// for the same value), so switching formats changes no bytes for ordinary prices
+// out must hold 24 bytes
+inline char* writeFixedPrice(char* out, std::int64_t ticks) {
+    std::uint64_t magnitude = static_cast<std::uint64_t>(ticks);
+    if (ticks < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    out = std::to_chars(out, out + 20, magnitude / kPriceScale).ptr;
+    *out++ = '.';
+    std::uint64_t fraction = magnitude % kPriceScale;
+    int digits = kPriceDecimals;
+    while (digits > 1 && fraction % 10 == 0) {
+        fraction /= 10;
+        --digits;
+    }
+    for (int i = digits - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return out + digits;
+}
+
+} // namespace tws_bridge
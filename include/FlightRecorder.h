@@ -0,0 +1,147 @@
+// FlightRecorder.h - Stage timestamps of the last N published ticks, dumped to a file when one is slow
+// SCOPE: stage() / commit() on the Redis Worker thread (single writer), dumps on the recorder's own thread
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "MarketData.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+struct FlightRecorderConfig {
+    bool enabled = false;
+    std::size_t capacity = 65536;                   // Records kept (power of two): ~3 s at 20k ticks/s
+    std::chrono::microseconds threshold{5000};      // Callback → publish above this dumps the ring
+    std::chrono::seconds cooldown{10};              // At most one dump per shard this often
+    std::string dir = ".";                          // flight-{shard}-{epochMs}.csv
+};
+
+// One published snapshot, latencyNowNs() clock (0 = stage not reached)
+struct FlightRecord {
+    std::int64_t callbackNs;                        // TwsClient callback entry (TickStamps::ingestNs)
+    std::int64_t enqueueNs;                         // Handed to the shard queue
+    std::int64_t dequeueNs;                         // Worker took its batch
+    std::int64_t serializeNs;                       // Snapshot encoded
+    std::int64_t publishNs;                         // Pipeline flushed (sent, or handed to the I/O thread)
+    SlotId slot;
+    TickUpdateType type;                            // Update that made the snapshot
+};
+
+// What the dump is about, written as its header
+struct FlightTrigger {
+    FlightRecord slowest{};
+    std::uint64_t endSequence = 0;                  // Records before this one are dumped
+    std::size_t queueDepth = 0;                     // Shard queue at the trigger
+    std::int64_t redisRoundTripNs = 0;              // Publisher's last pipeline round trip
+};
+
+/**
+ * Seqlock'd ring of FlightRecords, overwritten oldest first. The worker buffers a batch's records
+ * (stage) and writes them once the pipeline carrying them was flushed (commit); a record over the
+ * threshold wakes the dump thread, which copies the ring while the worker keeps writing.
+ *
+ * PERFORMANCE: Worker side is two stores per record plus one vector push - no lock, no syscall;
+ * the condition variable is only touched on a trigger (at most once per cooldown)
+ * PITFALL: Records overwritten while the dump copies them are skipped (seq moved) - a dump can
+ * miss the oldest records under heavy load, never contain torn ones
+ */
+class FlightRecorder {
+public:
+    FlightRecorder(const FlightRecorderConfig& config, std::size_t shardId, const InstrumentRegistry* registry);
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Dump thread ("tws-flight-{shard}")
+    void start();
+    void stop();
+
+    // Worker: record of a snapshot serialized into the current pipeline
+    void stage(const FlightRecord& record) { m_pending.push_back(record); }
+    std::size_t pending() const { return m_pending.size(); }
+
+    // Worker: the pipeline went out at publishNs - staged records enter the ring
+    void commit(std::int64_t publishNs, std::size_t queueDepth, std::chrono::nanoseconds redisRoundTrip) {
+        const std::int64_t thresholdNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.threshold).count();
+        const FlightRecord* slowest = nullptr;
+        for (FlightRecord& record : m_pending) {
+            record.publishNs = publishNs;
+            write(record);
+            if (publishNs - record.callbackNs > thresholdNs
+                && (!slowest || record.callbackNs < slowest->callbackNs)) {
+                slowest = &record;
+            }
+        }
+        if (slowest && publishNs >= m_nextDumpNs) {
+            m_nextDumpNs = publishNs + std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.cooldown).count();
+            requestDump(*slowest, queueDepth, redisRoundTrip.count());
+        }
+        m_pending.clear();
+    }
+
+    std::uint64_t written() const { return m_written.load(std::memory_order_relaxed); }
+    std::uint64_t dumps() const { return m_dumps.load(std::memory_order_relaxed); }
+    // Path of the last dump file ("" = none yet, dump thread writes, any thread reads after dumps() moved)
+    std::string lastDump() const;
+
+    // Records still in the ring before endSequence, oldest first (any thread)
+    std::size_t copy(std::uint64_t endSequence, std::vector<FlightRecord>& out) const;
+
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> seq{0};          // 2n+1 while record n is written, 2n+2 once complete
+        FlightRecord record{};
+    };
+
+    void write(const FlightRecord& record) {
+        const std::uint64_t sequence = m_next;
+        Cell& cell = m_cells[sequence & m_mask];
+        cell.seq.store(2 * sequence + 1, std::memory_order_relaxed);
+        // REASON: Odd seq visible before any field changes (readers see a torn copy as torn)
+        std::atomic_thread_fence(std::memory_order_release);
+        cell.record = record;
+        cell.seq.store(2 * sequence + 2, std::memory_order_release);
+        m_next = sequence + 1;
+        m_written.store(m_next, std::memory_order_relaxed);
+    }
+
+    void requestDump(const FlightRecord& slowest, std::size_t queueDepth, std::int64_t roundTripNs);
+    void run();
+    void dump(const FlightTrigger& trigger);
+
+    FlightRecorderConfig m_config;
+    std::size_t m_shardId;
+    const InstrumentRegistry* m_registry;           // Symbol names in the dump (nullptr = slot numbers)
+    std::unique_ptr<Cell[]> m_cells;
+    std::size_t m_mask = 0;
+
+    // ========== Worker thread ==========
+    std::vector<FlightRecord> m_pending;            // Staged until their pipeline is flushed
+    std::uint64_t m_next = 0;                       // Next sequence
+    std::int64_t m_nextDumpNs = 0;                  // Cooldown
+
+    alignas(64) std::atomic<std::uint64_t> m_written{0};
+    std::atomic<std::uint64_t> m_dumps{0};
+
+    // ========== Dump thread ==========
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_dumpRequested = false;                   // Guarded by m_mutex
+    bool m_stopping = false;                        // Guarded by m_mutex
+    FlightTrigger m_trigger;                        // Guarded by m_mutex
+    std::string m_lastDump;                         // Guarded by m_mutex
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,74 @@
+// GapBackfill.h - Reconnect gap window and reqHistoricalTicks paging for the tick backfill
+// SCOPE: Message thread (reconnect replay, first live tick, historicalTicks* callbacks) - cold path
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace tws_bridge {
+
+// tws.backfill: after a reconnect, the ticks of the outage are fetched with reqHistoricalTicks (BID_ASK +
+// TRADES) and written to TWS:STREAM:{SYMBOL} as tagged batches - the live snapshot is never rewound
+// NOTE: Historical requests have their own TWS pacing (roughly 60 per 10 minutes) - meant for a watch list,
+// not for hundreds of symbols at once
+struct BackfillPolicy {
+    bool enabled = false;
+    std::chrono::seconds maxGap{600};               // Longer outages fetch their most recent part only
+    std::size_t maxPages = 10;                      // reqHistoricalTicks pages per kind and gap
+};
+
+// reqHistoricalTicks numberOfTicks (TWS maximum)
+// NOTE: TWS completes the last second of a page, so a page may hold a few more
+inline constexpr int kHistoricalTicksPage = 1000;
+
+// One symbol's outage in TWS tick time (ms): the newest tick before the drop, the first live tick after
+// it - both exclusive, they were streamed live
+struct GapWindow {
+    std::int64_t fromMs = 0;
+    std::int64_t toMs = 0;
+
+    bool empty() const { return toMs - fromMs <= 1000; }  // REASON: Historical ticks carry whole seconds
+
+    // Historical tick time (epoch seconds) strictly inside the gap
+    // PITFALL: The boundary seconds are skipped whole - a live tick-by-tick time is whole seconds as well,
+    // so ticks of those seconds would repeat; the rest of a boundary second is lost instead
+    bool contains(std::int64_t tickSeconds) const {
+        const std::int64_t ms = tickSeconds * 1000;
+        return ms > fromMs && ms < toMs;
+    }
+};
+
+inline GapWindow gapWindow(std::int64_t lastMs, std::int64_t firstLiveMs, std::chrono::seconds maxGap) {
+    const std::int64_t limitMs = std::chrono::duration_cast<std::chrono::milliseconds>(maxGap).count();
+    GapWindow window;
+    window.toMs = firstLiveMs;
+    window.fromMs = firstLiveMs - lastMs > limitMs ? firstLiveMs - limitMs : lastMs;
+    return window;
+}
+
+// Start of the next page, false when the gap is covered: a short page is the last one, and so is a page
+// reaching the first live tick
+inline bool nextBackfillPage(const GapWindow& window, std::size_t pageTicks, std::int64_t lastTickSeconds,
+                             std::int64_t& nextStartSeconds) {
+    if (pageTicks < static_cast<std::size_t>(kHistoricalTicksPage) || lastTickSeconds * 1000 >= window.toMs) {
+        return false;
+    }
+    nextStartSeconds = lastTickSeconds + 1;  // REASON: The page ended with every tick of its last second
+    return true;
+}
+
+// reqHistoricalTicks startDateTime in UTC: "20261015-14:30:05"
+inline std::string historicalTicksTime(std::int64_t epochSeconds) {
+    const std::time_t time = static_cast<std::time_t>(epochSeconds);
+    std::tm utc{};
+    gmtime_r(&time, &utc);
+    char text[32];
+    const std::size_t length = std::strftime(text, sizeof(text), "%Y%m%d-%H:%M:%S", &utc);
+    return std::string(text, length);
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,195 @@
+// GreeksChain.h - Per-chain option greeks table (TickUpdateType::Greeks) and its throttled batch encoder
+// SCOPE: Redis Worker thread - one table per chain slot, published on a timer (OptionChainConfig)
+
+#pragma once
+
+#include "MarketData.h"
+#include "SnapshotEncoder.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+// worker.options: TWS:CHAIN:{SYMBOL}:{EXPIRY} batches
+struct OptionChainConfig {
+    std::chrono::milliseconds interval{250};        // Changed legs of each expiry, at most once per interval
+    std::uint32_t keyframeEvery = 20;               // Every N-th batch of an expiry carries all its legs ("full")
+};
+
+// Dense leg table of one chain: a greek tick overwrites its leg in place, the timer publishes per expiry the
+// legs changed since the last batch
+// PERFORMANCE: Hundreds of strikes x model ticks several times a second become one PUBLISH per expiry per
+// interval - a leg updated ten times in between goes out once, with its latest values
+// NOTE: Delta batches carry changed legs only (each leg whole) - a consumer joining late is complete after
+// the next keyframe
+class GreeksChain {
+public:
+    // REASON: Bounds a malformed leg index - TwsClient numbers at most kMaxChainLegs (OptionChain.h)
+    static constexpr std::uint32_t kMaxLegs = 4096;
+
+    // channelPrefix: "TWS:CHAIN:{SYMBOL}:" (InstrumentChannels::chain), + expiry per batch
+    explicit GreeksChain(std::string channelPrefix)
+        : m_prefix(std::move(channelPrefix)) {}
+
+    // false if the leg index is out of range
+    bool apply(const TickUpdate& update) {
+        const std::uint32_t index = update.aux;
+        if (index >= kMaxLegs) {
+            return false;
+        }
+        if (index >= m_legs.size()) {
+            m_legs.resize(index + 1);
+        }
+        Leg& leg = m_legs[index];
+        if (!leg.known) {
+            // REASON: First tick of the leg files it under its expiry (cold - once per leg)
+            leg.known = true;
+            leg.expiry = expiryIndex(update.greeks.expiry);
+            m_expiries[leg.expiry].legs.push_back(index);
+        }
+        leg.values = update.greeks;
+        leg.put = (update.flags & TickFlags::Put) != 0;
+        leg.timestamp = update.timestamp;
+        if (!leg.dirty) {
+            leg.dirty = true;
+            m_expiries[leg.expiry].dirty.push_back(index);
+        }
+        return true;
+    }
+
+    // Encodes each expiry with changed legs (all of its legs on a keyframe) and calls
+    // publish(channel, payload); returns the number of batches
+    template <typename Publish>
+    std::size_t flush(std::string_view symbol, std::uint32_t keyframeEvery, JsonBuffer& out, Publish&& publish) {
+        std::size_t batches = 0;
+        for (Expiry& expiry : m_expiries) {
+            if (expiry.dirty.empty()) {
+                continue;
+            }
+            const bool full = keyframeEvery != 0 && expiry.batches % keyframeEvery == 0;
+            ++expiry.batches;
+            encode(symbol, expiry, full ? expiry.legs : expiry.dirty, full, out);
+            for (std::uint32_t index : expiry.dirty) {
+                m_legs[index].dirty = false;
+            }
+            expiry.dirty.clear();
+            publish(expiry.channel, std::string_view(out.data(), out.size()));
+            ++batches;
+        }
+        return batches;
+    }
+
+    std::size_t legs() const { return m_legs.size(); }
+    std::size_t expiries() const { return m_expiries.size(); }
+
+private:
+    struct Leg {
+        GreeksPayload values{};
+        std::int64_t timestamp = 0;
+        std::uint16_t expiry = 0;                   // Index into m_expiries
+        bool put = false;
+        bool known = false;
+        bool dirty = false;
+    };
+
+    struct Expiry {
+        std::uint32_t code = 0;                     // YYYYMMDD
+        std::string channel;                        // "TWS:CHAIN:{SYMBOL}:{YYYYMMDD}", built once
+        std::vector<std::uint32_t> legs;            // Every known leg (keyframes)
+        std::vector<std::uint32_t> dirty;           // Changed since the last batch
+        std::uint32_t batches = 0;
+    };
+
+    std::uint16_t expiryIndex(std::uint32_t code) {
+        for (std::size_t i = 0; i < m_expiries.size(); ++i) {
+            if (m_expiries[i].code == code) {
+                return static_cast<std::uint16_t>(i);
+            }
+        }
+        Expiry expiry;
+        expiry.code = code;
+        expiry.channel = m_prefix + std::to_string(code);
+        m_expiries.push_back(std::move(expiry));
+        return static_cast<std::uint16_t>(m_expiries.size() - 1);
+    }
+
+    // Shortest round-trip float, null for NaN (not computed)
+    static char* writeFloat(char* p, float value) {
+        if (!std::isfinite(value)) {
+            return snapshot_detail::copyFragment(p, snapshot_detail::fragment("null"));
+        }
+        return std::to_chars(p, p + 32, value).ptr;
+    }
+
+    // {"instrument":..,"expiry":"20261120","timestamp":..,"full":false,"legs":[{"k":450.0,"r":"C","iv":..,"d":..,
+    // "g":..,"v":..,"t":..,"p":..,"u":..},..]} - timestamp of the newest leg in the batch
+    void encode(std::string_view symbol, const Expiry& expiry, const std::vector<std::uint32_t>& legs, bool full,
+                JsonBuffer& out) const {
+        using namespace snapshot_detail;
+        // REASON: Every leg's timestamp is read before the header is written
+        std::int64_t timestamp = 0;
+        for (std::uint32_t index : legs) {
+            timestamp = std::max(timestamp, m_legs[index].timestamp);
+        }
+
+        out.buffer.Clear();
+        const std::size_t headerBound = 128 + 6 * symbol.size();
+        char* begin = out.buffer.Push(headerBound);
+        char* p = copyFragment(begin, fragment("{\"instrument\":"));
+        p = writeString(p, symbol);
+        p = copyFragment(p, fragment(",\"expiry\":\""));
+        p = writeUint64(p, expiry.code);
+        p = copyFragment(p, fragment("\",\"timestamp\":"));
+        p = writeInt64(p, timestamp);
+        p = full ? copyFragment(p, fragment(",\"full\":true,\"legs\":["))
+                 : copyFragment(p, fragment(",\"full\":false,\"legs\":["));
+        out.buffer.Pop(headerBound - static_cast<std::size_t>(p - begin));
+
+        // PERFORMANCE: Fixed bound per leg, the unused tail popped - no reallocation once the buffer is warm
+        constexpr std::size_t kLegBound = 320;
+        bool first = true;
+        for (std::uint32_t index : legs) {
+            const Leg& leg = m_legs[index];
+            begin = out.buffer.Push(kLegBound);
+            p = begin;
+            if (!first) {
+                *p++ = ',';
+            }
+            first = false;
+            p = copyFragment(p, fragment("{\"k\":"));
+            p = writeDouble(p, leg.values.strike);
+            p = leg.put ? copyFragment(p, fragment(",\"r\":\"P\",\"iv\":"))
+                        : copyFragment(p, fragment(",\"r\":\"C\",\"iv\":"));
+            p = writeFloat(p, leg.values.impliedVol);
+            p = copyFragment(p, fragment(",\"d\":"));
+            p = writeFloat(p, leg.values.delta);
+            p = copyFragment(p, fragment(",\"g\":"));
+            p = writeFloat(p, leg.values.gamma);
+            p = copyFragment(p, fragment(",\"v\":"));
+            p = writeFloat(p, leg.values.vega);
+            p = copyFragment(p, fragment(",\"t\":"));
+            p = writeFloat(p, leg.values.theta);
+            p = copyFragment(p, fragment(",\"p\":"));
+            p = writeDouble(p, leg.values.optionPrice);
+            p = copyFragment(p, fragment(",\"u\":"));
+            p = writeDouble(p, leg.values.underlyingPrice);
+            *p++ = '}';
+            out.buffer.Pop(kLegBound - static_cast<std::size_t>(p - begin));
+        }
+        begin = out.buffer.Push(2);
+        begin[0] = ']';
+        begin[1] = '}';
+    }
+
+    std::string m_prefix;
+    std::vector<Leg> m_legs;                        // By leg index (ChainSelection numbering)
+    std::vector<Expiry> m_expiries;                 // In order of first tick
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,80 @@
+// HistoryCache.h - Startup history backfill limited to the bars the bar store does not hold yet
+// SCOPE: Main thread at startup (own Redis connection), before the historical bar requests are queued
+
+#pragma once
+
+#include "BarSize.h"
+#include "GapBackfill.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+// subscriptions.incremental_history: the bar store (TWS:BARS:Z:{SYMBOL}:{barSize}) is the cache - a warm
+// restart asks TWS for the minutes since the newest stored bar, not for the whole window again
+struct HistoryCacheConfig {
+    bool incremental = false;                       // Needs worker.bar_store (the cache it reads)
+    std::chrono::seconds window{3600};              // subscriptions.history_window: bars kept / requested per symbol
+    std::size_t keysPerRequest = 256;               // Bar store keys per pipeline (ZCOUNT + two ZRANGEBYSCORE each)
+    std::chrono::milliseconds socketTimeout{1000};
+};
+
+// Stored bars of one key inside the window (bar start times, ms) - count 0 = nothing cached
+struct CachedBars {
+    std::int64_t oldestMs = 0;
+    std::int64_t newestMs = 0;
+    std::size_t count = 0;
+};
+
+// One reqHistoricalData to send: bars starting in [fromMs, toMs)
+struct HistoryRange {
+    std::int64_t fromMs = 0;
+    std::int64_t toMs = 0;
+    bool current = false;                           // Ends now - endDateTime "", may be kept up to date
+};
+
+// Ranges of [windowFromMs, nowMs) the cache does not cover, oldest first (at most two: before the oldest
+// stored bar, after the newest)
+// REASON: Holes between stored bars are not searched - a range is always stored whole, so a hole is a
+// closed market (useRTH), and asking for it again would only repeat the empty answer
+// NOTE: The newest stored bar is fetched again - it may have been stored while still in progress
+inline std::vector<HistoryRange> missingHistoryRanges(const CachedBars& cached, std::int64_t windowFromMs,
+                                                      std::int64_t nowMs, std::int64_t barMs) {
+    std::vector<HistoryRange> ranges;
+    if (cached.count == 0 || cached.newestMs < windowFromMs) {
+        ranges.push_back(HistoryRange{windowFromMs, nowMs, true});
+        return ranges;
+    }
+    if (cached.oldestMs - windowFromMs >= barMs) {
+        ranges.push_back(HistoryRange{windowFromMs, cached.oldestMs, false});
+    }
+    ranges.push_back(HistoryRange{std::max(cached.newestMs, windowFromMs), nowMs, true});
+    return ranges;
+}
+
+// reqHistoricalData durationStr covering [fromMs, toMs), rounded up to whole seconds
+// NOTE: Seconds up to a day ("900 S"), whole days above - TWS rejects "S" durations past 86400
+inline std::string historicalDuration(const HistoryRange& range) {
+    const std::int64_t seconds = std::max<std::int64_t>((range.toMs - range.fromMs + 999) / 1000, 1);
+    if (seconds <= 86400) {
+        return std::to_string(seconds) + " S";
+    }
+    return std::to_string((seconds + 86399) / 86400) + " D";
+}
+
+// reqHistoricalData endDateTime: "" for the current range, else its end in UTC ("20261015-14:30:05")
+inline std::string historicalEndTime(const HistoryRange& range) {
+    return range.current ? std::string() : historicalTicksTime(range.toMs / 1000);
+}
+
+// Stored bars at or after windowFromMs of every key (ZCOUNT + oldest / newest ZRANGEBYSCORE, pipelined
+// keysPerRequest keys at a time), by key order
+// Throws sw::redis::Error if Redis cannot be reached
+std::vector<CachedBars> loadCachedBars(const std::string& uri, const std::vector<std::string>& keys,
+                                       std::int64_t windowFromMs, const HistoryCacheConfig& config = {});
+
+} // namespace tws_bridge
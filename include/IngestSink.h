@@ -0,0 +1,100 @@
+// IngestSink.h - Compile-time ingest sink policies: where BasicTwsClient's callbacks hand their TickUpdates
+// SCOPE: Producer side (message thread) - one sink object per client, consumers drain the sink's target
+//
+// Policy interface (resolved at compile time - inlined into every callback, no virtual call per tick):
+//   using Target = ...;                    What the client is constructed with (shared with the consumers)
+//   explicit Sink(Target& target);
+//   void stage(const TickUpdate& update);  CRITICAL PATH: every emitted update
+//   std::size_t flush();                   End of each dispatch cycle, returns the updates dropped since the last one
+//
+// BasicIngestStage<Queue> (ShardRouter.h) is the production sink: staged bursts, bulk enqueue per shard
+
+#pragma once
+
+#include "CoalescingTable.h"
+#include "MarketData.h"
+#include "ShardRouter.h"
+#include "TickJournal.h"
+#include <cstddef>
+
+namespace tws_bridge {
+
+// One queue, one consumer, no routing or staging (SpscTickQueue / MpmcTickQueue)
+// NOTE: Full queue = update dropped (counted, reported by flush)
+template <typename Queue>
+class QueueSink {
+public:
+    using Target = Queue;
+
+    explicit QueueSink(Target& queue) : m_queue(queue) {}
+
+    void stage(const TickUpdate& update) {
+        m_dropped += m_queue.try_enqueue(update) ? 0 : 1;
+    }
+
+    std::size_t flush() {
+        const std::size_t dropped = m_dropped;
+        m_dropped = 0;
+        return dropped;
+    }
+
+private:
+    Queue& m_queue;
+    std::size_t m_dropped = 0;
+};
+
+// Latest BidAsk / AllLast per slot written in place (CoalescingTable key slot * 2 + type), every other
+// update (bars, depth, HistoryEnd) through the inner sink - IngestMode::Coalesce without a router
+// PITFALL: The table must hold 2 keys per registry slot - beyond it ticks go to the inner sink too
+template <typename Inner>
+class CoalescingSink {
+public:
+    struct Target {
+        CoalescingTable& table;
+        typename Inner::Target& inner;
+    };
+
+    explicit CoalescingSink(Target& target) : m_table(target.table), m_inner(target.inner) {}
+
+    void stage(const TickUpdate& update) {
+        const std::size_t key = static_cast<std::size_t>(update.slot) * 2 + coalescingLane(update.type);
+        if (isCoalescable(update) && key < m_table.keys()) {
+            m_table.write(key, update);
+            return;
+        }
+        m_inner.stage(update);
+    }
+
+    std::size_t flush() { return m_inner.flush(); }
+
+private:
+    CoalescingTable& m_table;
+    Inner m_inner;
+};
+
+// Captures every update to a started journal, then hands it to the inner sink
+// REASON: Compile-time counterpart of BasicTwsClient::setJournal (no per-tick null check) - for fixed
+// pipelines and benchmarks; the bridge keeps the runtime switch (journal.enabled)
+template <typename Inner>
+class JournalTee {
+public:
+    struct Target {
+        TickJournal& journal;
+        typename Inner::Target& inner;
+    };
+
+    explicit JournalTee(Target& target) : m_journal(target.journal), m_inner(target.inner) {}
+
+    void stage(const TickUpdate& update) {
+        m_journal.append(update);  // REASON: Before the inner sink - the capture includes what overflow drops
+        m_inner.stage(update);
+    }
+
+    std::size_t flush() { return m_inner.flush(); }
+
+private:
+    TickJournal& m_journal;
+    Inner m_inner;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,93 @@
+// InstrumentRegistry.h - Dense instrument slot assignment
+// SCOPE: Written at subscribe time (every connection's message thread), read by callbacks and Redis Worker
+
+#pragma once
+
+#include "TradeCodes.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tws_bridge {
+
+// REASON: Small integer slot replaces symbol strings on the hot path
+using SlotId = std::uint16_t;
+constexpr SlotId kInvalidSlot = 0xFFFF;
+
+// REASON: Redis keys/channels built once at subscribe time, not per publish
+struct InstrumentChannels {
+    std::string ticks;        // "TWS:TICKS:{SYMBOL}"
+    std::string bars;         // "TWS:BARS:{SYMBOL}"
+    std::string binaryTicks;  // "TWS:BIN:TICKS:{SYMBOL}"
+    std::string binaryBars;   // "TWS:BIN:BARS:{SYMBOL}"
+    std::string stream;       // "TWS:STREAM:{SYMBOL}"
+    std::string lastValue;    // "TWS:LVC:{SYMBOL}"
+    std::string depth;        // "TWS:DEPTH:{SYMBOL}"
+    std::string midPoint;     // "TWS:MID:{SYMBOL}"
+    std::string chain;        // "TWS:CHAIN:{SYMBOL}:" prefix, + expiry (option greeks batches, GreeksChain.h)
+    std::string history;      // "TWS:HISTORY:{SYMBOL}" (whole reqHistoricalData series)
+    std::string liveBar;      // "TWS:LIVEBAR:{SYMBOL}" (keepUpToDate in-progress bar, throttled revisions)
+    std::string barStore;     // "TWS:BARS:Z:{SYMBOL}:" key prefix, + barSizeLabel() (sorted set per bar size)
+    std::string series;       // "TWS:TS:{SYMBOL}:" key prefix, + seriesFieldName() (RedisTimeSeries, TimeSeries.h)
+    std::string tape;         // "TWS:TAS:{SYMBOL}" (time and sales list, TradeTape.h)
+};
+
+class InstrumentRegistry {
+public:
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
+    explicit InstrumentRegistry(std::size_t capacity = kDefaultCapacity);
+
+    // REASON: Non-copyable (slots are shared by reference across threads)
+    InstrumentRegistry(const InstrumentRegistry&) = delete;
+    InstrumentRegistry& operator=(const InstrumentRegistry&) = delete;
+
+    // Returns existing slot for symbol, or assigns the next free one
+    // Returns kInvalidSlot when capacity is exhausted (any subscribing thread, serialized)
+    // NOTE: tickerId of the first registration is kept for published snapshots
+    SlotId registerInstrument(const std::string& symbol, int tickerId = 0);
+
+    // Slot lookup by symbol (any subscribing thread, serialized), kInvalidSlot if unknown
+    SlotId find(const std::string& symbol) const;
+
+    // Symbol for a registered slot (any thread, slot must be < size())
+    const std::string& symbol(SlotId slot) const { return m_symbols[slot]; }
+    int tickerId(SlotId slot) const { return m_tickerIds[slot]; }
+    const InstrumentChannels& channels(SlotId slot) const { return m_channels[slot]; }
+    // Symbol as an escaped JSON string literal ("\"AAPL\""), built at registration
+    const std::string& symbolJson(SlotId slot) const { return m_symbolJson[slot]; }
+
+    // Resolved contract identity (ContractCache / reqContractDetails), may arrive after the first ticks
+    // NOTE: Any thread - conId and exchange are packed into one atomic, readers never see half of an update
+    void setContract(SlotId slot, int conId, ExchangeCode primaryExchange) {
+        m_contracts[slot].store(static_cast<std::uint32_t>(conId) | std::uint64_t{primaryExchange} << 32,
+                                std::memory_order_relaxed);
+    }
+    // 0 / kUnknownExchange until resolved
+    int conId(SlotId slot) const {
+        return static_cast<int>(static_cast<std::uint32_t>(m_contracts[slot].load(std::memory_order_relaxed)));
+    }
+    ExchangeCode primaryExchange(SlotId slot) const {
+        return static_cast<ExchangeCode>(m_contracts[slot].load(std::memory_order_relaxed) >> 32);
+    }
+
+    std::size_t size() const { return m_count.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return m_symbols.size(); }
+
+private:
+    std::vector<std::string> m_symbols;                     // Pre-sized, never reallocated
+    std::vector<int> m_tickerIds;                           // Parallel to m_symbols
+    std::vector<InstrumentChannels> m_channels;             // Parallel to m_symbols
+    std::vector<std::string> m_symbolJson;                  // Parallel to m_symbols
+    std::vector<std::atomic<std::uint64_t>> m_contracts;    // Parallel to m_symbols: conId | exchange << 32
+    std::unordered_map<std::string, SlotId> m_slotBySymbol; // Cold path only (m_mutex)
+    // REASON: Several TWS connections register symbols from their own message threads
+    mutable std::mutex m_mutex;                             // Serializes registerInstrument() / find()
+    std::atomic<std::size_t> m_count{0};                    // REASON: Release-publishes slot data
+};
+
+} // namespace tws_bridge
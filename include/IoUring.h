@@ -0,0 +1,191 @@
+// IoUring.h - Minimal io_uring instance over the raw syscalls (no liburing dependency)
+// SCOPE: One ring per owner thread (RespConnection on the Redis sending thread), never shared
+
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace tws_bridge {
+
+// Submission / completion rings mapped from the kernel, plus registered (pinned) buffers
+// PERFORMANCE: A linked chain (e.g. send → recv → timeout) is queued as several SQEs and handed
+// over with one io_uring_enter - one syscall per round trip instead of send() + recv() (+ poll)
+// PITFALL: Linux 5.6+ (IORING_OP_SEND / RECV); create() fails on older kernels or where
+// io_uring is disabled (seccomp, kernel.io_uring_disabled) - callers fall back to plain sockets
+class IoUring {
+public:
+    // nullptr (why = reason) if the kernel refuses
+    static std::unique_ptr<IoUring> create(unsigned entries, std::string& why) {
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+        io_uring_params params{};
+        const int fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            why = std::string("io_uring_setup: ") + std::strerror(errno);
+            return nullptr;
+        }
+        std::unique_ptr<IoUring> ring(new IoUring(fd));
+        if (!ring->map(params)) {
+            why = std::string("io_uring mmap: ") + std::strerror(errno);
+            return nullptr;
+        }
+        return ring;
+#else
+        (void)entries;
+        why = "io_uring syscalls not available in this build";
+        return nullptr;
+#endif
+    }
+
+    ~IoUring() {
+        if (m_sqes) {
+            ::munmap(m_sqes, m_sqesBytes);
+        }
+        if (m_cqRing && m_cqRing != m_sqRing) {
+            ::munmap(m_cqRing, m_cqRingBytes);
+        }
+        if (m_sqRing) {
+            ::munmap(m_sqRing, m_sqRingBytes);
+        }
+        ::close(m_fd);
+    }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    // Next free SQE (zeroed), nullptr when the submission ring is full
+    io_uring_sqe* nextSqe() {
+        const unsigned head = atomicLoad(m_sqHead);
+        if (m_sqTail - head >= m_sqEntries) {
+            return nullptr;
+        }
+        const unsigned index = m_sqTail & m_sqMask;
+        io_uring_sqe* sqe = &m_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        m_sqArray[index] = index;
+        ++m_sqTail;
+        return sqe;
+    }
+
+    // Publishes the queued SQEs and blocks until at least minComplete completions are ready
+    // false on error (errno set)
+    bool submitAndWait(unsigned minComplete) {
+        atomicStore(m_sqTailShared, m_sqTail);  // REASON: Release - SQE contents visible to the kernel first
+        const unsigned toSubmit = m_sqTail - m_sqSubmitted;
+        for (;;) {
+            const long result = ::syscall(__NR_io_uring_enter, m_fd, toSubmit, minComplete,
+                                          minComplete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (result >= 0) {
+                m_sqSubmitted += static_cast<unsigned>(result);  // Consumed SQEs (all, unless the kernel ran out)
+                return true;
+            }
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+    // Calls onCompletion(const io_uring_cqe&) for every ready completion, returns count
+    template <typename OnCompletion>
+    unsigned drain(OnCompletion&& onCompletion) {
+        unsigned head = *m_cqHead;
+        const unsigned tail = atomicLoad(m_cqTail);
+        unsigned count = 0;
+        for (; head != tail; ++head, ++count) {
+            onCompletion(m_cqes[head & m_cqMask]);
+        }
+        atomicStore(m_cqHead, head);  // REASON: Release - entries are read before the kernel reuses them
+        return count;
+    }
+
+    // Pins iovecs as fixed buffers 0..count-1 (replacing any previous set), false on error (errno set)
+    // PITFALL: Counts against RLIMIT_MEMLOCK on older kernels - keep the buffers small
+    bool registerBuffers(const iovec* buffers, unsigned count) {
+        if (m_buffersRegistered) {
+            ::syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            m_buffersRegistered = false;
+        }
+        m_buffersRegistered = ::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+        return m_buffersRegistered;
+    }
+
+private:
+    explicit IoUring(int fd) : m_fd(fd) {}
+
+    bool map(const io_uring_params& params) {
+        m_sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            m_sqRingBytes = m_cqRingBytes = m_sqRingBytes > m_cqRingBytes ? m_sqRingBytes : m_cqRingBytes;
+        }
+        m_sqRing = mapRegion(m_sqRingBytes, IORING_OFF_SQ_RING);
+        if (!m_sqRing) {
+            return false;
+        }
+        m_cqRing = single ? m_sqRing : mapRegion(m_cqRingBytes, IORING_OFF_CQ_RING);
+        m_sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe*>(mapRegion(m_sqesBytes, IORING_OFF_SQES));
+        if (!m_cqRing || !m_sqes) {
+            return false;
+        }
+        char* sq = static_cast<char*>(m_sqRing);
+        char* cq = static_cast<char*>(m_cqRing);
+        m_sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sqTailShared = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sqEntries = params.sq_entries;
+        m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sqTail = m_sqSubmitted = *m_sqTailShared;
+        m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void* mapRegion(std::size_t bytes, off_t offset) {
+        void* region = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, offset);
+        return region == MAP_FAILED ? nullptr : region;
+    }
+
+    // REASON: Ring indices are shared with the kernel - same reinterpret as StateCheckpoint's header
+    static unsigned atomicLoad(const unsigned* shared) {
+        return reinterpret_cast<const std::atomic<unsigned>*>(shared)->load(std::memory_order_acquire);
+    }
+    static void atomicStore(unsigned* shared, unsigned value) {
+        reinterpret_cast<std::atomic<unsigned>*>(shared)->store(value, std::memory_order_release);
+    }
+
+    int m_fd;
+    void* m_sqRing = nullptr;
+    void* m_cqRing = nullptr;
+    std::size_t m_sqRingBytes = 0;
+    std::size_t m_cqRingBytes = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    std::size_t m_sqesBytes = 0;
+    unsigned* m_sqHead = nullptr;
+    unsigned* m_sqTailShared = nullptr;
+    unsigned* m_sqArray = nullptr;
+    unsigned m_sqMask = 0;
+    unsigned m_sqEntries = 0;
+    unsigned m_sqTail = 0;                          // Local tail (published by submitAndWait)
+    unsigned m_sqSubmitted = 0;
+    unsigned* m_cqHead = nullptr;
+    unsigned* m_cqTail = nullptr;
+    unsigned m_cqMask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+    bool m_buffersRegistered = false;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,99 @@
+// IsoTimestamp.h - Allocation-free ISO 8601 UTC timestamp formatter ("2023-11-14T22:13:20.123Z")
+// SCOPE: Any thread (per-thread cache) - snapshots, logs, any human-readable time output
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace tws_bridge {
+
+// Formats Unix ms timestamps with the "YYYY-MM-DDTHH:MM:SS." prefix cached for the current second
+// PERFORMANCE: Same second = 3 digits written; same minute = 2 more; only a new minute does the
+// calendar math (days → y/m/d, no gmtime, no locale, no allocation)
+// NOTE: Not shared between threads - use one instance per thread (formatIsoTimestamp() does)
+class IsoTimestampFormatter {
+public:
+    static constexpr std::size_t kLength = 24;   // "YYYY-MM-DDTHH:MM:SS.mmmZ"
+
+    // Writes exactly kLength characters (no terminator), returns out + kLength
+    // Years are 0000-9999 (timestamps outside that range are clamped to it)
+    char* format(std::int64_t timestampMs, char* out) {
+        constexpr std::int64_t kMinMs = -62167219200000;   // 0000-01-01T00:00:00.000Z
+        constexpr std::int64_t kMaxMs = 253402300799999;   // 9999-12-31T23:59:59.999Z
+        timestampMs = timestampMs < kMinMs ? kMinMs : (timestampMs > kMaxMs ? kMaxMs : timestampMs);
+
+        const std::int64_t second = floorDiv(timestampMs, 1000);
+        if (second != m_second) {
+            const std::int64_t minute = floorDiv(second, 60);
+            if (minute != m_minute) {
+                writeMinute(minute);
+                m_minute = minute;
+            }
+            write2(m_prefix + 17, static_cast<unsigned>(second - minute * 60));
+            m_second = second;
+        }
+        std::memcpy(out, m_prefix, kPrefixLength);
+        const unsigned millis = static_cast<unsigned>(timestampMs - second * 1000);
+        out[20] = static_cast<char>('0' + millis / 100);
+        out[21] = static_cast<char>('0' + millis / 10 % 10);
+        out[22] = static_cast<char>('0' + millis % 10);
+        out[23] = 'Z';
+        return out + kLength;
+    }
+
+private:
+    static constexpr std::size_t kPrefixLength = 20;  // Through the '.'
+
+    static std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+        const std::int64_t quotient = value / divisor;
+        return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+    }
+
+    static void write2(char* out, unsigned value) {
+        out[0] = static_cast<char>('0' + value / 10);
+        out[1] = static_cast<char>('0' + value % 10);
+    }
+
+    void writeMinute(std::int64_t minute) {
+        const std::int64_t days = floorDiv(minute, 1440);
+        const unsigned minuteOfDay = static_cast<unsigned>(minute - days * 1440);
+
+        // REASON: Proleptic Gregorian days → civil date (H. Hinnant's civil_from_days), branch-free
+        const std::int64_t z = days + 719468;
+        const std::int64_t era = floorDiv(z, 146097);
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        const unsigned day = doy - (153 * mp + 2) / 5 + 1;
+        const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+        const unsigned year = static_cast<unsigned>(static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0));
+
+        write2(m_prefix, year / 100);
+        write2(m_prefix + 2, year % 100);
+        m_prefix[4] = '-';
+        write2(m_prefix + 5, month);
+        m_prefix[7] = '-';
+        write2(m_prefix + 8, day);
+        m_prefix[10] = 'T';
+        write2(m_prefix + 11, minuteOfDay / 60);
+        m_prefix[13] = ':';
+        write2(m_prefix + 14, minuteOfDay % 60);
+        m_prefix[16] = ':';
+        m_prefix[19] = '.';
+    }
+
+    std::int64_t m_second = INT64_MIN;
+    std::int64_t m_minute = INT64_MIN;
+    char m_prefix[kPrefixLength] = {};
+};
+
+// Thread-safe convenience: one cached formatter per calling thread
+inline char* formatIsoTimestamp(std::int64_t timestampMs, char* out) {
+    thread_local IsoTimestampFormatter formatter;
+    return formatter.format(timestampMs, out);
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,433 @@
+// JournalCodec.h - Compressed TickJournal blocks: per-slot deltas, zigzag varints, one LZ4 block each
+// SCOPE: TickJournal (encoder, message thread) and TickJournalReader (decoder) - JournalFormat::Compressed
+
+#pragma once
+
+#include "FixedPrice.h"
+#include "Lz4Frame.h"
+#include "MarketData.h"
+#include "TickJournal.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+/**
+ * Block payload (before LZ4) - a run of records, each:
+ *   u8 tag (TickUpdateType, or kSymbolTag) | u8 TickUpdate::flags | varint slot | zigzag receiveNs delta
+ *   Symbol: varint length + bytes
+ *   Tick:   zigzag timestamp delta (per slot) | varint aux | the active arm's fields (below)
+ * Prices are deltas of 1e-4 ticks against the slot's previous price of the same role (bid, ask, last,
+ * depth, bar open), shifted left one bit; bit 0 set = escape, the raw 8-byte double follows (NaN, 5+
+ * decimals, huge). Sizes are zigzag varints, Greeks their raw payload.
+ *
+ * [ARCHITECTURE] Every baseline (receive time, per-slot timestamp and prices) restarts at zero in each
+ * block, and each block repeats the Symbol record of every slot it holds - a block decodes with no state
+ * from the ones before it (a seek / restart point).
+ */
+namespace journal_codec {
+
+constexpr std::uint8_t kSymbolTag = 0x0F;
+constexpr std::int64_t kMaxDeltaTicks = std::int64_t{1} << 52;   // REASON: zigzag << 1 stays inside 64 bits
+
+// Longest record: tag + flags + slot + receive / timestamp deltas + aux, then a Bar (5 prices + volume) or
+// a Symbol record
+constexpr std::size_t kMaxRecordBytes = 2 + 3 + 10 + 10 + 5 + 6 * 10 + journal_detail::kMaxSymbolBytes;
+
+inline std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+inline char* putVarint(char* out, std::uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<char>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<char>(value);
+    return out;
+}
+
+inline bool getVarint(const char*& in, const char* end, std::uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && in < end; shift += 7) {
+        const std::uint8_t byte = static_cast<std::uint8_t>(*in++);
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline double ticksToPrice(std::int64_t ticks) {
+    return static_cast<double>(ticks) / static_cast<double>(kPriceScale);
+}
+
+// Ticks that decode back to the exact bits of price (so -0.0 and 6-decimal FX rates take the escape)
+inline bool exactPriceTicks(double price, std::int64_t& ticks) {
+    if (!toPriceTicks(price, ticks) || ticks >= kMaxDeltaTicks || ticks <= -kMaxDeltaTicks) {
+        return false;
+    }
+    const double decoded = ticksToPrice(ticks);
+    return std::memcmp(&decoded, &price, sizeof(price)) == 0;
+}
+
+// Per-slot baselines - valid while block matches the block being encoded / decoded
+struct SlotBaseline {
+    std::uint32_t block = 0;
+    bool announced = false;                        // Encoder: the block holds the slot's Symbol record
+    std::int64_t timestamp = 0;
+    std::int64_t bid = 0;
+    std::int64_t ask = 0;
+    std::int64_t last = 0;                         // AllLast / MidPoint
+    std::int64_t depth = 0;
+    std::int64_t bar = 0;                          // Bar open (high / low / close / wap are deltas to it)
+};
+
+} // namespace journal_codec
+
+// Appends records to the open block; TickJournal seals it (LZ4) into the active segment when full()
+// PERFORMANCE: Pointer stores into a preallocated buffer - a BidAsk record is ~12-20 bytes before LZ4
+class JournalBlockEncoder {
+public:
+    static constexpr std::size_t kDefaultBlockBytes = std::size_t{64} << 10;
+    static constexpr std::size_t kMaxBlockBytes = std::size_t{1} << 20;
+
+    explicit JournalBlockEncoder(std::size_t blockBytes = kDefaultBlockBytes, std::size_t slots = 0)
+        : m_blockBytes(std::clamp<std::size_t>(blockBytes, 4096, kMaxBlockBytes))
+        , m_buffer(m_blockBytes + 2 * journal_codec::kMaxRecordBytes)
+        , m_slots(slots) {
+    }
+
+    bool announced(SlotId slot) const {
+        return slot < m_slots.size() && m_slots[slot].block == m_block && m_slots[slot].announced;
+    }
+
+    void addSymbol(SlotId slot, std::string_view symbol, std::int64_t receiveNs) {
+        using namespace journal_codec;
+        symbol = symbol.substr(0, journal_detail::kMaxSymbolBytes);
+        char* out = beginRecord(kSymbolTag, 0, slot, receiveNs);
+        out = putVarint(out, symbol.size());
+        std::memcpy(out, symbol.data(), symbol.size());
+        m_used = static_cast<std::size_t>(out + symbol.size() - m_buffer.data());
+        baseline(slot).announced = true;
+    }
+
+    void addTick(const TickUpdate& update, std::int64_t receiveNs) {
+        using namespace journal_codec;
+        SlotBaseline& base = baseline(update.slot);
+        char* out = beginRecord(static_cast<std::uint8_t>(update.type), update.flags, update.slot, receiveNs);
+        out = putVarint(out, zigzag(update.timestamp - base.timestamp));
+        base.timestamp = update.timestamp;
+        out = putVarint(out, update.aux);
+        switch (update.type) {
+        case TickUpdateType::BidAsk:
+            out = putPrice(out, update.bidAsk.bidPrice, base.bid);
+            out = putPrice(out, update.bidAsk.askPrice, base.ask);
+            out = putVarint(out, zigzag(update.bidAsk.bidSize));
+            out = putVarint(out, zigzag(update.bidAsk.askSize));
+            break;
+        case TickUpdateType::AllLast:
+            out = putPrice(out, update.allLast.price, base.last);
+            out = putVarint(out, zigzag(update.allLast.size));
+            *out++ = static_cast<char>(update.allLast.exchange);
+            out = putVarint(out, update.allLast.conditions);
+            break;
+        case TickUpdateType::Depth:
+            out = putPrice(out, update.depth.price, base.depth);
+            out = putVarint(out, zigzag(update.depth.size));
+            *out++ = static_cast<char>(update.depth.position);
+            *out++ = static_cast<char>(update.depth.operation);
+            *out++ = static_cast<char>(update.depth.side);
+            break;
+        case TickUpdateType::MidPoint:
+            out = putPrice(out, update.midPoint.midPoint, base.last);
+            break;
+        case TickUpdateType::Bar: {
+            out = putPrice(out, update.bar.open, base.bar);
+            for (double price : {update.bar.high, update.bar.low, update.bar.close, update.bar.wap}) {
+                std::int64_t open = base.bar;  // REASON: Each one a delta to the open, not a chain
+                out = putPrice(out, price, open);
+            }
+            out = putVarint(out, zigzag(update.bar.volume));
+            break;
+        }
+        case TickUpdateType::Greeks:
+            std::memcpy(out, &update.greeks, sizeof(GreeksPayload));
+            out += sizeof(GreeksPayload);
+            break;
+        default:
+            break;  // HistoryEnd: header only
+        }
+        m_used = static_cast<std::size_t>(out - m_buffer.data());
+        ++m_ticks;
+    }
+
+    bool empty() const { return m_records == 0; }
+    bool full() const { return m_used >= m_blockBytes; }
+    std::uint32_t records() const { return m_records; }
+    std::uint32_t ticks() const { return m_ticks; }
+    std::int64_t firstReceiveNs() const { return m_firstReceiveNs; }
+    std::int64_t lastReceiveNs() const { return m_previousReceiveNs; }
+    std::string_view encoded() const { return std::string_view(m_buffer.data(), m_used); }
+    std::size_t blockBytes() const { return m_blockBytes; }
+
+    // Upper bound of seal() for a full block (TickJournal's minimum segment size)
+    std::size_t maxSealedBytes() const {
+        const std::size_t encoded = m_buffer.size();
+        return 4 + encoded + encoded / 255 + 16;
+    }
+
+    // LZ4 block of the open block (Lz4Compressor::appendBlock layout, stored as is when incompressible)
+    // PERFORMANCE: Same compressor and output buffer every block - no allocation once warm
+    std::string_view seal() {
+        m_sealed.clear();
+        m_lz4.appendBlock(encoded(), m_sealed);
+        return m_sealed;
+    }
+
+    // Starts the next block - every slot's baselines restart (lazily, by block number)
+    void reset() {
+        ++m_block;
+        m_used = 0;
+        m_records = 0;
+        m_ticks = 0;
+        m_firstReceiveNs = 0;
+        m_previousReceiveNs = 0;
+    }
+
+private:
+    journal_codec::SlotBaseline& baseline(SlotId slot) {
+        if (slot >= m_slots.size()) {
+            m_slots.resize(std::size_t{slot} + 1);  // PITFALL: Allocates - size the encoder to the registry
+        }
+        journal_codec::SlotBaseline& base = m_slots[slot];
+        if (base.block != m_block) {
+            base = journal_codec::SlotBaseline{};
+            base.block = m_block;
+        }
+        return base;
+    }
+
+    char* beginRecord(std::uint8_t tag, std::uint8_t flags, SlotId slot, std::int64_t receiveNs) {
+        using namespace journal_codec;
+        if (m_records == 0) {
+            m_firstReceiveNs = receiveNs;
+        }
+        ++m_records;
+        char* out = m_buffer.data() + m_used;
+        *out++ = static_cast<char>(tag);
+        *out++ = static_cast<char>(flags);
+        out = putVarint(out, slot);
+        out = putVarint(out, zigzag(receiveNs - m_previousReceiveNs));
+        m_previousReceiveNs = receiveNs;
+        return out;
+    }
+
+    static char* putPrice(char* out, double price, std::int64_t& base) {
+        using namespace journal_codec;
+        std::int64_t ticks = 0;
+        if (exactPriceTicks(price, ticks)) {
+            out = putVarint(out, zigzag(ticks - base) << 1);
+            base = ticks;
+            return out;
+        }
+        *out++ = 1;  // Escape - base unchanged
+        std::memcpy(out, &price, sizeof(price));
+        return out + sizeof(price);
+    }
+
+    std::size_t m_blockBytes;
+    std::vector<char> m_buffer;
+    std::size_t m_used = 0;
+    std::uint32_t m_block = 1;                     // REASON: SlotBaseline{} (block 0) is never current
+    std::uint32_t m_records = 0;
+    std::uint32_t m_ticks = 0;
+    std::int64_t m_firstReceiveNs = 0;
+    std::int64_t m_previousReceiveNs = 0;
+    std::vector<journal_codec::SlotBaseline> m_slots;
+    Lz4Compressor m_lz4;
+    std::string m_sealed;
+};
+
+// Reads the records of one sealed block back as JournalEntry values
+class JournalBlockDecoder {
+public:
+    // Decompresses a sealed block (exactly the seal() bytes), false if malformed or not encodedBytes long
+    bool load(std::string_view sealed, std::size_t encodedBytes) {
+        clear();
+        if (!decompressLz4Block(sealed, m_encoded) || !sealed.empty() || m_encoded.size() != encodedBytes) {
+            return false;
+        }
+        ++m_block;
+        m_previousReceiveNs = 0;
+        m_in = m_encoded.data();
+        m_end = m_in + m_encoded.size();
+        return true;
+    }
+
+    // Drops the undecoded rest of the block
+    void clear() {
+        m_encoded.clear();
+        m_in = m_end = nullptr;
+    }
+
+    bool exhausted() const { return m_in == m_end; }
+
+    // Next record of the block, false at its end or at a malformed record (the rest of the block is dropped)
+    bool next(JournalEntry& entry) {
+        using namespace journal_codec;
+        if (m_end - m_in < 2) {
+            m_in = m_end;
+            return false;
+        }
+        const std::uint8_t tag = static_cast<std::uint8_t>(*m_in++);
+        const std::uint8_t flags = static_cast<std::uint8_t>(*m_in++);
+        std::uint64_t slot = 0;
+        std::uint64_t receiveDelta = 0;
+        if (!getVarint(m_in, m_end, slot) || slot > 0xFFFF || !getVarint(m_in, m_end, receiveDelta)) {
+            return fail();
+        }
+        m_previousReceiveNs += unzigzag(receiveDelta);
+        entry.receiveNs = m_previousReceiveNs;
+        SlotBaseline& base = baseline(static_cast<SlotId>(slot));
+        if (tag == kSymbolTag) {
+            std::uint64_t length = 0;
+            if (!getVarint(m_in, m_end, length) || length > static_cast<std::uint64_t>(m_end - m_in)) {
+                return fail();
+            }
+            entry.kind = JournalRecordKind::Symbol;
+            entry.slot = static_cast<SlotId>(slot);
+            entry.symbol.assign(m_in, static_cast<std::size_t>(length));
+            m_in += length;
+            return true;
+        }
+        if (tag >= kTickUpdateTypeCount) {
+            return fail();
+        }
+        entry.kind = JournalRecordKind::Tick;
+        TickUpdate& update = entry.update;
+        update = TickUpdate{};
+        update.slot = static_cast<SlotId>(slot);
+        update.type = static_cast<TickUpdateType>(tag);
+        update.flags = flags;
+        std::uint64_t timestamp = 0;
+        std::uint64_t aux = 0;
+        if (!getVarint(m_in, m_end, timestamp) || !getVarint(m_in, m_end, aux) || aux > 0xFFFFFFFFu) {
+            return fail();
+        }
+        base.timestamp += unzigzag(timestamp);
+        update.timestamp = base.timestamp;
+        update.aux = static_cast<std::uint32_t>(aux);
+        bool ok = true;
+        switch (update.type) {
+        case TickUpdateType::BidAsk:
+            ok = getPrice(update.bidAsk.bidPrice, base.bid) && getPrice(update.bidAsk.askPrice, base.ask)
+                 && getSigned(update.bidAsk.bidSize) && getSigned(update.bidAsk.askSize);
+            break;
+        case TickUpdateType::AllLast:
+            ok = getPrice(update.allLast.price, base.last) && getSigned(update.allLast.size)
+                 && getByte(update.allLast.exchange) && getVarint(m_in, m_end, update.allLast.conditions);
+            break;
+        case TickUpdateType::Depth:
+            ok = getPrice(update.depth.price, base.depth) && getSigned(update.depth.size)
+                 && getByte(update.depth.position) && getByte(update.depth.operation) && getByte(update.depth.side);
+            break;
+        case TickUpdateType::MidPoint:
+            ok = getPrice(update.midPoint.midPoint, base.last);
+            break;
+        case TickUpdateType::Bar:
+            ok = getPrice(update.bar.open, base.bar);
+            for (double* price : {&update.bar.high, &update.bar.low, &update.bar.close, &update.bar.wap}) {
+                std::int64_t open = base.bar;
+                ok = ok && getPrice(*price, open);
+            }
+            ok = ok && getSigned(update.bar.volume);
+            break;
+        case TickUpdateType::Greeks:
+            ok = static_cast<std::size_t>(m_end - m_in) >= sizeof(GreeksPayload);
+            if (ok) {
+                std::memcpy(&update.greeks, m_in, sizeof(GreeksPayload));
+                m_in += sizeof(GreeksPayload);
+            }
+            break;
+        default:
+            break;
+        }
+        return ok || fail();
+    }
+
+private:
+    bool fail() {
+        m_in = m_end;
+        return false;
+    }
+
+    journal_codec::SlotBaseline& baseline(SlotId slot) {
+        if (slot >= m_slots.size()) {
+            m_slots.resize(std::size_t{slot} + 1);
+        }
+        journal_codec::SlotBaseline& base = m_slots[slot];
+        if (base.block != m_block) {
+            base = journal_codec::SlotBaseline{};
+            base.block = m_block;
+        }
+        return base;
+    }
+
+    bool getPrice(double& price, std::int64_t& base) {
+        using namespace journal_codec;
+        std::uint64_t code = 0;
+        if (!getVarint(m_in, m_end, code)) {
+            return false;
+        }
+        if (code & 1) {
+            if (static_cast<std::size_t>(m_end - m_in) < sizeof(price)) {
+                return false;
+            }
+            std::memcpy(&price, m_in, sizeof(price));
+            m_in += sizeof(price);
+            return true;
+        }
+        base += unzigzag(code >> 1);
+        price = ticksToPrice(base);
+        return true;
+    }
+
+    template <typename Int>
+    bool getSigned(Int& value) {
+        std::uint64_t code = 0;
+        if (!journal_codec::getVarint(m_in, m_end, code)) {
+            return false;
+        }
+        value = static_cast<Int>(journal_codec::unzigzag(code));
+        return true;
+    }
+
+    bool getByte(std::uint8_t& value) {
+        if (m_in == m_end) {
+            return false;
+        }
+        value = static_cast<std::uint8_t>(*m_in++);
+        return true;
+    }
+
+    std::string m_encoded;
+    const char* m_in = nullptr;
+    const char* m_end = nullptr;
+    std::uint32_t m_block = 0;
+    std::int64_t m_previousReceiveNs = 0;
+    std::vector<journal_codec::SlotBaseline> m_slots;
+};
+
+} // namespace tws_bridge
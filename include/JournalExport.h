@@ -0,0 +1,73 @@
+// JournalExport.h - End-of-day conversion of TickJournal segments into per-symbol Parquet files
+// SCOPE: Offline job (tws_bridge --export) on closed segments - separate process, never the live pipeline
+
+#pragma once
+
+#include "ParquetWriter.h"
+#include "TickJournal.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tws_bridge {
+
+// Output: {directory}/{session}/{quotes|trades|depth|bars}/{SYMBOL}.parquet
+// Columns: symbol (dictionary), time (TWS ms) and receive_time (capture ns) as delta-encoded UTC timestamps,
+// then the update's fields - pd.read_parquet / pl.read_parquet("export/<session>/quotes/*.parquet")
+struct ExportConfig {
+    std::string directory = "export";
+    std::size_t rowGroupRows = std::size_t{1} << 20;     // Per file (one page per column per row group)
+    std::size_t maxBufferedRows = std::size_t{8} << 20;  // BACKPRESSURE: Every table is flushed past this
+    JournalFilter filter;                                // Symbols / receive-time window (seeks via the .tjx)
+};
+
+struct ExportCounters {
+    std::uint64_t rows = 0;
+    std::uint64_t files = 0;
+    std::uint64_t rowGroups = 0;
+    std::uint64_t segments = 0;
+    std::uint64_t unmapped = 0;                      // Ticks of a slot with no Symbol record
+    std::uint64_t errors = 0;                        // Files that could not be written
+    std::uint64_t skippedBytes = 0;                  // Segment bytes the index let the filter skip
+};
+
+class JournalExporter {
+public:
+    explicit JournalExporter(ExportConfig config = {});
+
+    // path: one segment file, or a journal directory (every session, oldest first)
+    // false if no segment could be read or any output file failed
+    bool run(const std::string& path);
+
+    const ExportCounters& counters() const { return m_counters; }
+
+private:
+    enum Table : std::size_t { Quotes, Trades, Depth, Bars, kTableCount };
+
+    struct SymbolTables {
+        std::string symbol;
+        std::unique_ptr<ParquetWriter> tables[kTableCount];  // Created by the symbol's first row of that kind
+    };
+
+    void beginSession(const std::string& segmentPath);
+    void append(const JournalEntry& entry);
+    ParquetWriter& table(SymbolTables& tables, Table kind);
+    void flush(ParquetWriter& writer);
+    void finishSession();
+
+    ExportConfig m_config;
+    ExportCounters m_counters;
+
+    // ========== Current Session ==========
+    std::int64_t m_sessionStartNs = 0;
+    std::string m_session;
+    std::vector<std::uint32_t> m_slots;              // Journal slot → m_symbols index + 1 (0 = unmapped)
+    std::vector<SymbolTables> m_symbols;
+    std::unordered_map<std::string, std::uint32_t> m_symbolIndex;
+    std::size_t m_buffered = 0;                      // Rows held in memory across every table
+};
+
+} // namespace tws_bridge
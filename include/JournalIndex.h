@@ -0,0 +1,202 @@
+// JournalIndex.h - Sparse time / symbol index written next to each TickJournal segment (seek without a scan)
+// SCOPE: JournalIndexBuilder on the journal's message thread, file written by its sync thread at retire;
+// JournalIndex read by TickJournalScan (replay / export, TickJournal.h)
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// ========== On-Disk Format (native byte order) ==========
+// {directory}/{session}-{index:06}.tjx beside the .tjl it indexes, written when the segment is closed:
+// JournalIndexHeader | blocks × JournalIndexBlock | blocks × bitmapWords u64 (slots present, bit = slot)
+// | symbols × (u16 slot, u8 length, bytes) - the segment's slot → symbol table
+// NOTE: Optional - a missing, short or stale index (segmentBytes ≠ file size) means a sequential scan
+
+inline constexpr char kJournalIndexMagic[8] = {'T', 'W', 'S', 'J', 'I', 'D', 'X', '1'};
+inline constexpr const char* kJournalIndexExtension = ".tjx";
+
+struct JournalIndexHeader {
+    char magic[8];
+    std::uint32_t blocks;
+    std::uint32_t bitmapWords;        // u64 words per block bitmap
+    std::uint32_t symbols;
+    std::uint32_t reserved;
+    std::uint64_t segmentBytes;       // Size of the closed segment the index was written for
+};
+
+static_assert(sizeof(JournalIndexHeader) == 32, "Index header layout is part of the file format");
+
+// One seek target: a compressed block, or a span of raw records (~kJournalIndexSpanBytes)
+// A block ends where the next one starts (the last one at segmentBytes)
+struct JournalIndexBlock {
+    std::uint64_t offset;             // JournalBlockHeader / first JournalRecordHeader in the segment
+    std::uint32_t records;            // Ticks
+    std::uint32_t reserved;
+    std::int64_t firstReceiveNs;      // REASON: Min / max, not first / last - receive stamps of several
+    std::int64_t lastReceiveNs;       // sockets (sharded connections) interleave slightly out of order
+};
+
+static_assert(sizeof(JournalIndexBlock) == 32, "Index block layout is part of the file format");
+
+// Raw segments: records per index entry (~1.1k BidAsk) - the seek granularity
+inline constexpr std::size_t kJournalIndexSpanBytes = std::size_t{64} << 10;
+
+// Index entries of one segment (builder output, loaded file contents)
+struct JournalSegmentIndex {
+    std::vector<JournalIndexBlock> blocks;
+    std::vector<std::uint64_t> bitmaps;               // blocks × words
+    std::size_t words = 0;
+
+    bool empty() const { return blocks.empty(); }
+    bool contains(std::size_t block, SlotId slot) const {
+        const std::size_t word = slot / 64;
+        return word < words && (bitmaps[block * words + word] >> (slot % 64) & 1) != 0;
+    }
+};
+
+// Collects the open block's slots and receive range per record, closed into the segment's entries
+// CRITICAL PATH: add() = one bit set + two compares; close() copies `words` u64 once per block
+class JournalIndexBuilder {
+public:
+    explicit JournalIndexBuilder(std::size_t slots)
+        : m_open((slots + 63) / 64, 0) {
+        m_index.words = m_open.size();
+    }
+
+    void add(SlotId slot, std::int64_t receiveNs) {
+        const std::size_t word = slot / 64;
+        if (word < m_open.size()) {
+            m_open[word] |= std::uint64_t{1} << (slot % 64);
+        }
+        m_first = std::min(m_first, receiveNs);
+        m_last = std::max(m_last, receiveNs);
+        ++m_records;
+    }
+
+    // Raw records: starts a new entry at `offset` once the open one spans kJournalIndexSpanBytes
+    void addAt(std::size_t offset, SlotId slot, std::int64_t receiveNs) {
+        if (m_records != 0 && offset - m_offset >= kJournalIndexSpanBytes) {
+            close();
+        }
+        if (m_records == 0) {
+            m_offset = offset;
+        }
+        add(slot, receiveNs);
+    }
+
+    // Appends the open block (at `offset`, or where its first addAt() was) to the segment's entries
+    void close(std::size_t offset) {
+        m_offset = offset;
+        close();
+    }
+    void close() {
+        if (m_records == 0) {
+            return;
+        }
+        m_index.blocks.push_back({m_offset, m_records, 0, m_first, m_last});
+        m_index.bitmaps.insert(m_index.bitmaps.end(), m_open.begin(), m_open.end());
+        discard();
+    }
+
+    // Forgets the open block (its records were dropped)
+    void discard() {
+        std::fill(m_open.begin(), m_open.end(), 0);
+        m_records = 0;
+        m_first = std::numeric_limits<std::int64_t>::max();
+        m_last = std::numeric_limits<std::int64_t>::min();
+    }
+
+    // Closed entries of the segment being left (the open block stays - compressed blocks move with rotation)
+    JournalSegmentIndex take() {
+        JournalSegmentIndex index = std::move(m_index);
+        m_index = JournalSegmentIndex{};
+        m_index.words = m_open.size();
+        return index;
+    }
+
+private:
+    JournalSegmentIndex m_index;
+    std::vector<std::uint64_t> m_open;
+    std::size_t m_offset = 0;
+    std::uint32_t m_records = 0;
+    std::int64_t m_first = std::numeric_limits<std::int64_t>::max();
+    std::int64_t m_last = std::numeric_limits<std::int64_t>::min();
+};
+
+// A loaded .tjx - which byte ranges of its segment hold given slots in a receive-time window
+class JournalIndex {
+public:
+    // "{segment stem}.tjx"
+    static std::string pathFor(const std::string& segmentPath);
+
+    // Writes `index` with the symbols of every slot it holds (symbolOf(slot)), false on I/O error
+    template <typename SymbolOf>
+    static bool write(const std::string& path, const JournalSegmentIndex& index, std::size_t segmentBytes,
+                      SymbolOf&& symbolOf);
+
+    // false (and empty) if the file is missing, malformed, or not written for a segment of segmentBytes
+    bool load(const std::string& path, std::size_t segmentBytes);
+
+    const JournalSegmentIndex& entries() const { return m_index; }
+    const std::vector<std::pair<SlotId, std::string>>& symbols() const { return m_symbols; }
+
+    // [begin, end) offsets of the blocks holding a slot set in `slots` (nullptr = any) and a receive time in
+    // [fromNs, toNs], adjacent blocks merged into one range
+    std::vector<std::pair<std::size_t, std::size_t>> select(const std::vector<std::uint64_t>* slots,
+                                                            std::int64_t fromNs, std::int64_t toNs) const;
+
+private:
+    static bool writeFile(const std::string& path, const std::string& contents);
+
+    JournalSegmentIndex m_index;
+    std::vector<std::pair<SlotId, std::string>> m_symbols;
+};
+
+template <typename SymbolOf>
+bool JournalIndex::write(const std::string& path, const JournalSegmentIndex& index, std::size_t segmentBytes,
+                         SymbolOf&& symbolOf) {
+    std::vector<std::uint64_t> present(index.words, 0);
+    for (std::size_t i = 0; i < index.bitmaps.size(); ++i) {
+        present[i % index.words] |= index.bitmaps[i];
+    }
+    std::string symbols;
+    std::uint32_t symbolCount = 0;
+    for (std::size_t word = 0; word < present.size(); ++word) {
+        for (std::uint64_t bits = present[word]; bits != 0; bits &= bits - 1) {
+            const SlotId slot = static_cast<SlotId>(word * 64 + static_cast<std::size_t>(__builtin_ctzll(bits)));
+            const std::string& symbol = symbolOf(slot);
+            const std::uint8_t length = static_cast<std::uint8_t>(std::min<std::size_t>(symbol.size(), 255));
+            symbols.append(reinterpret_cast<const char*>(&slot), sizeof(slot));
+            symbols.push_back(static_cast<char>(length));
+            symbols.append(symbol.data(), length);
+            ++symbolCount;
+        }
+    }
+
+    JournalIndexHeader header{};
+    std::copy(std::begin(kJournalIndexMagic), std::end(kJournalIndexMagic), header.magic);
+    header.blocks = static_cast<std::uint32_t>(index.blocks.size());
+    header.bitmapWords = static_cast<std::uint32_t>(index.words);
+    header.symbols = symbolCount;
+    header.segmentBytes = segmentBytes;
+
+    std::string contents;
+    contents.reserve(sizeof(header) + index.blocks.size() * sizeof(JournalIndexBlock)
+                     + index.bitmaps.size() * sizeof(std::uint64_t) + symbols.size());
+    contents.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    contents.append(reinterpret_cast<const char*>(index.blocks.data()), index.blocks.size() * sizeof(JournalIndexBlock));
+    contents.append(reinterpret_cast<const char*>(index.bitmaps.data()), index.bitmaps.size() * sizeof(std::uint64_t));
+    contents.append(symbols);
+    return writeFile(path, contents);
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,67 @@
+// JournalReplay.h - Feeds recorded TickJournal segments into the shard queues in place of TwsClient
+// SCOPE: One thread - the shard queues' only producer (msgThread's role in live mode)
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "ShardRouter.h"
+#include "TickJournal.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+struct ReplayConfig {
+    double speed = 1.0;              // Recorded inter-arrival gaps divided by this (0 = as fast as possible)
+    bool latencyStamps = false;      // Stamp TickStamps at enqueue (WorkerConfig::latency needs it)
+    JournalFilter filter;            // Symbols / receive-time window (index-guided seeks when a .tjx exists)
+};
+
+// Totals of one run() (replay thread writes, any thread reads)
+struct ReplayCounters {
+    std::atomic<std::uint64_t> records{0};       // Ticks handed to the shard router
+    std::atomic<std::uint64_t> dropped{0};       // Rejected by the overflow policy (DropNewest / bars when full)
+    std::atomic<std::uint64_t> unmapped{0};      // Ticks of a slot with no Symbol record, or registry full
+    std::atomic<std::uint64_t> segments{0};
+    std::atomic<std::uint64_t> skippedBytes{0};  // Segment bytes the index let the filter skip
+};
+
+// Deterministic input: same updates, same order, same (scaled) gaps as the recorded session
+// NOTE: The live overflow policy still applies - at high speeds ConflateLatest conflates as it would in production
+template <typename Queue>
+class BasicJournalReplay {
+public:
+    BasicJournalReplay(BasicShardRouter<Queue>& router, InstrumentRegistry& registry, ReplayConfig config = {});
+
+    // path: one segment file, or a directory (every segment, oldest first)
+    // Returns false if no segment could be opened; stops early once `running` is false
+    bool run(const std::string& path, const std::atomic<bool>& running);
+
+    const ReplayCounters& counters() const { return m_counters; }
+
+private:
+    void replaySegment(TickJournalScan& reader, const std::atomic<bool>& running);
+    void pace(std::int64_t receiveNs);
+
+    BasicShardRouter<Queue>& m_router;
+    InstrumentRegistry& m_registry;
+    ReplayConfig m_config;
+    ReplayCounters m_counters;
+
+    // REASON: Slots are per recorded session - symbols are re-registered here, in journal order
+    std::vector<SlotId> m_slots;                     // Journal slot → registry slot
+    std::int64_t m_sessionStartNs = 0;
+    std::int64_t m_baseReceiveNs = 0;                // First record of the session (0 = not seen yet)
+    std::chrono::steady_clock::time_point m_baseTime;
+};
+
+extern template class BasicJournalReplay<MpmcTickQueue>;
+extern template class BasicJournalReplay<SpscTickQueue>;
+
+using JournalReplay = BasicJournalReplay<MpmcTickQueue>;
+using SpscJournalReplay = BasicJournalReplay<SpscTickQueue>;
+
+} // namespace tws_bridge
@@ -0,0 +1,124 @@
+// JournalServer.h - Serves recorded journal ranges (symbols × receive-time window) to research clients
+// SCOPE: Offline / side process (tws_bridge --serve-journal) - accept thread + one thread per request,
+// read-only mappings of closed segments, never the live pipeline
+
+#pragma once
+
+#include "RedisUri.h"
+#include "TickJournal.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace tws_bridge {
+
+// ========== Wire Protocol ==========
+// Request: one text line, "REPLAY [symbols=AAPL,SPY] [from=<time>] [to=<time>] [speed=1x|10x|max]
+// [session=<name>] [stream=<name>]\n" (times: parseJournalTime, defaults: everything at max speed)
+// Reply: frames (JournalFrameHeader + length bytes) until End or Error, then the server closes
+// - Segment before each segment's frames; Records / Blocks carry the same bytes as the segment file, so
+//   TickJournalReader's parsing applies (Records: kJournalVersion layout -
+//   a version 1 segment is re-encoded and its Segment frame carries kJournalVersion)
+// - stream=<name>: records go to the Redis stream TWS:REPLAY:<name> instead (one XADD per record, field
+//   "data" = the record bytes), the socket gets End / Error only
+
+enum class JournalFrameKind : std::uint32_t {
+    Segment = 1,    // JournalSegmentHeader of the segment the following frames come from
+    Records = 2,    // JournalRecordHeader records (Symbol + Tick), 8-byte aligned
+    Blocks = 3,     // JournalBlockHeader + LZ4 blocks, verbatim from a compressed segment
+    End = 4,        // u64 ticks served (index counts - an unindexed segment sent whole adds none), request done
+    Error = 5       // Reason (text)
+};
+
+struct JournalFrameHeader {
+    JournalFrameKind kind;
+    std::uint32_t length;             // Bytes that follow
+};
+
+static_assert(sizeof(JournalFrameHeader) == 8, "Frame header layout is part of the protocol");
+
+inline constexpr const char* kJournalReplayStreamPrefix = "TWS:REPLAY:";
+
+struct JournalServeRequest {
+    JournalFilter filter;
+    double speed = 0.0;                               // parseReplaySpeed (0 = as fast as possible)
+    std::string session;                              // "" = every session in the directory
+    std::string stream;                               // "" = frames on the socket
+};
+
+// false (error set) on an unknown verb / key or a malformed value
+bool parseServeRequest(std::string_view line, JournalServeRequest& request, std::string& error);
+
+// journal_server: --serve-journal <dir>
+struct JournalServerConfig {
+    std::string directory = "journal";
+    std::string bindAddress = "127.0.0.1";
+    std::uint16_t port = 9470;                        // 0 = ephemeral (see JournalServer::port())
+    std::size_t maxClients = 4;                       // Concurrent requests, more are refused (Error frame)
+    std::chrono::milliseconds ioTimeout{30000};       // Per send / request read - a stuck client frees its thread
+    std::chrono::milliseconds pollTimeout{100};       // accept() wait per loop (bounds stop() latency)
+    std::size_t streamMaxLen = 1000000;               // stream=: MAXLEN ~ of TWS:REPLAY:<name>
+    RedisEndpoint redis;                              // stream=: redis.uri
+    RedisConnectionPolicy connection;
+};
+
+// Lifetime counters (written by the server threads, readable from any thread)
+struct JournalServerCounters {
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> rejected{0};           // Malformed request or maxClients reached
+    std::atomic<std::uint64_t> failed{0};             // Client went away / Redis error mid-request
+    std::atomic<std::uint64_t> active{0};             // Requests being served (gauge)
+    std::atomic<std::uint64_t> ticks{0};
+    std::atomic<std::uint64_t> bytes{0};              // Frame bytes sent, zero-copy included
+    std::atomic<std::uint64_t> zeroCopyBytes{0};      // sendfile() straight from the page cache
+    std::atomic<std::uint64_t> streamEntries{0};      // XADDs to TWS:REPLAY:*
+};
+
+// ARCHITECTURE: The segment index (JournalIndex) picks the blocks a request needs. A block wholly inside
+// the window whose slots are all wanted goes out with sendfile() - no copy and no per-record work, the CPU
+// cost of serving a day of one symbol set is the index lookup. Edge blocks and blocks shared with other
+// symbols are decoded, filtered and re-encoded as kJournalVersion records, and so is every record of a
+// version 1 segment. Paced requests (speed ≠ max) always take that path, one record at its scaled receive time
+class JournalServer {
+public:
+    explicit JournalServer(JournalServerConfig config);
+    ~JournalServer();
+
+    JournalServer(const JournalServer&) = delete;
+    JournalServer& operator=(const JournalServer&) = delete;
+
+    // Binds + listens, false if the socket can't be opened (error logged)
+    bool start();
+    // Stops accepting, aborts the requests in flight (their sockets are shut down) and joins every thread
+    void stop();
+
+    std::uint16_t port() const { return m_boundPort.load(std::memory_order_acquire); }
+    const JournalServerCounters& counters() const { return m_counters; }
+
+private:
+    struct Client {
+        int fd = -1;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    void run();
+    void serve(Client& client);
+    void reap(bool all);
+
+    JournalServerConfig m_config;
+    JournalServerCounters m_counters;
+    int m_listenFd = -1;
+    std::list<std::unique_ptr<Client>> m_clients;     // Accept thread only
+    std::atomic<std::uint16_t> m_boundPort{0};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
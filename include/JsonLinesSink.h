@@ -0,0 +1,63 @@
+// JsonLinesSink.h - Snapshot archive sink: one JSON snapshot per line, appended to a file
+// SCOPE: Its SinkFanout thread only
+
+#pragma once
+
+#include "SnapshotSink.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+
+namespace tws_bridge {
+
+// REASON: Plain append-only text - replayable with `tail -f`, jq, or any log shipper, no bridge code needed
+// PERFORMANCE: stdio buffering, one fflush per batch (a write syscall per drain batch, on the sink thread)
+class JsonLinesSink : public SnapshotSink {
+public:
+    explicit JsonLinesSink(std::string path)
+        : m_path(std::move(path))
+        , m_file(std::fopen(m_path.c_str(), "ae")) {
+        if (!m_file) {
+            std::cerr << "[SINK] Cannot open " << m_path << ": " << std::strerror(errno) << "\n";
+        }
+    }
+
+    ~JsonLinesSink() override {
+        if (m_file) {
+            std::fclose(m_file);
+        }
+    }
+
+    JsonLinesSink(const JsonLinesSink&) = delete;
+    JsonLinesSink& operator=(const JsonLinesSink&) = delete;
+
+    const char* name() const override { return "jsonl"; }
+
+    void onBatch(const SnapshotRecord* records, std::size_t count) override {
+        if (!m_file) {
+            return;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            std::fwrite(records[i].payload.data(), 1, records[i].payload.size(), m_file);
+            std::fputc('\n', m_file);
+        }
+        std::fflush(m_file);
+    }
+
+    void onStop() override {
+        if (m_file) {
+            std::fflush(m_file);
+        }
+    }
+
+    bool isOpen() const { return m_file != nullptr; }
+
+private:
+    std::string m_path;
+    std::FILE* m_file;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,57 @@
+// JsonString.h - JSON string literal escaping (RapidJSON default rules), no RapidJSON dependency
+// SCOPE: SnapshotEncoder hot path, InstrumentRegistry pre-escaped symbols (subscribe time)
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+// Worst case output bytes for value (quotes + 6 bytes per \u00XX escape)
+constexpr std::size_t jsonStringBound(std::size_t size) {
+    return 2 + 6 * size;
+}
+
+// Quoted JSON string with RapidJSON's default escaping (quote, backslash, control characters)
+// out must hold jsonStringBound(value.size()) bytes, returns the end of the written literal
+inline char* writeJsonString(char* out, std::string_view value) {
+    static constexpr char kHex[] = "0123456789ABCDEF";
+
+    *out++ = '"';
+    for (unsigned char c : value) {
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            *out++ = static_cast<char>(c);
+            continue;
+        }
+        *out++ = '\\';
+        switch (c) {
+            case '"':  *out++ = '"'; break;
+            case '\\': *out++ = '\\'; break;
+            case '\b': *out++ = 'b'; break;
+            case '\f': *out++ = 'f'; break;
+            case '\n': *out++ = 'n'; break;
+            case '\r': *out++ = 'r'; break;
+            case '\t': *out++ = 't'; break;
+            default:
+                *out++ = 'u';
+                *out++ = '0';
+                *out++ = '0';
+                *out++ = kHex[c >> 4];
+                *out++ = kHex[c & 0xF];
+                break;
+        }
+    }
+    *out++ = '"';
+    return out;
+}
+
+// Cold path: escaped literal as a string (e.g. "AAPL" -> "\"AAPL\"")
+inline std::string escapeJsonString(std::string_view value) {
+    std::string literal(jsonStringBound(value.size()), '\0');
+    literal.resize(static_cast<std::size_t>(writeJsonString(literal.data(), value) - literal.data()));
+    return literal;
+}
+
+} // namespace tws_bridge
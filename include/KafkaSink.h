@@ -0,0 +1,87 @@
+// KafkaSink.h - Snapshot sink producing to a Kafka topic (librdkafka), one record per published snapshot
+// SCOPE: Its SinkFanout thread only (produce + delivery report polling); config helpers from any thread
+
+#pragma once
+
+#include "SnapshotSink.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// kafka.partitioner
+enum class KafkaPartitioner {
+    Symbol,     // Message key = symbol, librdkafka's murmur2 (same partition as a Java producer keyed the same)
+    Slot        // Partition = slot % partitions - an even spread of a watch list, key still the symbol
+};
+
+// kafka.format
+enum class KafkaFormat {
+    Json,       // The TWS:TICKS:* snapshot bytes
+    Binary      // BinaryEncoder.h v1 (TWS:BIN:TICKS:*) - roughly a third of the bytes on the brokers
+};
+
+// kafka: durable fan-out to other teams - a consumer group replays what it missed, Pub/Sub cannot
+// REASON: A sink, not part of the Redis pipeline - broker latency and retries stay on the sink thread
+// PITFALL: Needs a build with -DTWS_BRIDGE_KAFKA=ON (librdkafka), otherwise the start fails when enabled
+struct KafkaConfig {
+    bool enabled = false;
+    std::string brokers = "localhost:9092";         // bootstrap.servers
+    std::string topic = "tws.ticks";
+    KafkaPartitioner partitioner = KafkaPartitioner::Symbol;
+    KafkaFormat format = KafkaFormat::Binary;
+    std::chrono::milliseconds linger{5};            // linger.ms: wait this long to fill a broker batch
+    std::size_t batchBytes = 1048576;               // batch.size: broker batch limit per partition
+    std::string compression = "lz4";                // compression.type: none / gzip / snappy / lz4 / zstd
+    std::string acks = "all";                       // acks: all / 1 / 0
+    std::size_t queueMessages = 1000000;            // queue.buffering.max.messages (producer-side backlog)
+};
+
+// librdkafka producer properties for config, in the order they are set
+// NOTE: enable.idempotence with acks=all - retries neither reorder nor duplicate a partition's records
+inline std::vector<std::pair<std::string, std::string>> kafkaProperties(const KafkaConfig& config) {
+    std::vector<std::pair<std::string, std::string>> properties = {
+        {"bootstrap.servers", config.brokers},
+        {"linger.ms", std::to_string(config.linger.count())},
+        {"batch.size", std::to_string(config.batchBytes)},
+        {"compression.type", config.compression},
+        {"acks", config.acks},
+        {"queue.buffering.max.messages", std::to_string(config.queueMessages)},
+        {"partitioner", "murmur2_random"},
+    };
+    if (config.acks == "all") {
+        properties.emplace_back("enable.idempotence", "true");
+    }
+    return properties;
+}
+
+// Explicit partition of a slot (KafkaPartitioner::Slot), -1 = let the partitioner pick
+inline std::int32_t kafkaPartition(KafkaPartitioner partitioner, SlotId slot, std::int32_t partitions) {
+    if (partitioner != KafkaPartitioner::Slot || partitions <= 0 || slot == kInvalidSlot) {
+        return -1;
+    }
+    return static_cast<std::int32_t>(slot % static_cast<std::uint32_t>(partitions));
+}
+
+// Lifetime counters (written by the sink thread and librdkafka's delivery reports, readable from any thread)
+struct KafkaCounters {
+    std::atomic<std::uint64_t> delivered{0};        // Acknowledged by the brokers
+    std::atomic<std::uint64_t> failed{0};           // Delivery reports with an error (retries exhausted)
+    std::atomic<std::uint64_t> dropped{0};          // Producer queue full - not produced
+};
+
+// One producer per worker - a symbol's records stay in order on its partition
+// BACKPRESSURE: librdkafka's own queue buffers broker outages up to queueMessages, then records are dropped
+// and counted - the sink thread never blocks the fan-out for longer than one short poll
+// nullptr (with the reason on stderr) if the producer cannot be created or the build has no Kafka support
+// (counters: main-owned, shared by every worker's sink, outlive them)
+std::shared_ptr<SnapshotSink> makeKafkaSink(const KafkaConfig& config, const InstrumentRegistry& registry,
+                                            KafkaCounters& counters);
+
+} // namespace tws_bridge
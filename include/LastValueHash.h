@@ -0,0 +1,220 @@
+// LastValueHash.h - TWS:LVC:{SYMBOL} as a Redis hash: flat fields, each write an HSET of the changed ones
+// SCOPE: Redis Worker thread (one LastValueTrack per slot), main thread warm start (parseLastValueHash)
+
+#pragma once
+
+#include "MarketData.h"
+#include "Quantity.h"
+#include "SnapshotDelta.h"
+#include "TradeCodes.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace tws_bridge {
+
+// worker.last_value_format
+enum class LastValueFormat {
+    Json,   // SET TWS:LVC:{SYMBOL} <full snapshot> (GET / MGET)
+    Hash    // HSET TWS:LVC:{SYMBOL} <changed fields> (HGET / HMGET / HGETALL)
+};
+
+// Hash field names - flat, one per snapshot member (the JSON groups price / size / timestamps are spelled out)
+namespace lvc_field {
+inline constexpr std::string_view Instrument = "instrument";
+inline constexpr std::string_view ConId = "conId";
+inline constexpr std::string_view PrimaryExchange = "primaryExchange";
+inline constexpr std::string_view Sequence = "seq";
+inline constexpr std::string_view Bid = "bid";
+inline constexpr std::string_view Ask = "ask";
+inline constexpr std::string_view Last = "last";
+inline constexpr std::string_view BidSize = "bidSize";
+inline constexpr std::string_view AskSize = "askSize";
+inline constexpr std::string_view LastSize = "lastSize";
+inline constexpr std::string_view QuoteTime = "quoteTime";
+inline constexpr std::string_view TradeTime = "tradeTime";
+inline constexpr std::string_view Exchange = "exchange";
+inline constexpr std::string_view Conditions = "conditions";
+inline constexpr std::string_view PastLimit = "pastLimit";
+inline constexpr std::string_view Mid = "mid";
+inline constexpr std::string_view Spread = "spread";
+inline constexpr std::string_view Vwap = "vwap";
+inline constexpr std::string_view RollingVolume = "rollingVolume";
+}
+
+// Per-slot baseline of what the hash already holds
+// PERFORMANCE: A quote tick rewrites bid / bidSize / quoteTime / seq (~60 bytes) instead of the ~300-byte
+// snapshot - less Redis CPU, less replication traffic; readers HMGET only the fields they need
+// NOTE: "seq" is part of every write, so a reader can tell whether the hash moved since its last read
+class LastValueTrack {
+public:
+    // HSET payload for state ("field\nvalue\n..." - RedisCommand::HashSet), identity fields on the first write
+    void encode(const InstrumentState& state, bool withDerived, std::string& out) {
+        out.clear();
+        if (!m_synced || state.conId != m_conId || state.primaryExchange != m_primaryExchange) {
+            append(out, lvc_field::Instrument, state.symbol);
+            appendInt(out, lvc_field::ConId, state.conId);
+            append(out, lvc_field::PrimaryExchange, state.primaryExchange);
+            m_conId = state.conId;
+            m_primaryExchange = state.primaryExchange;
+        }
+        const std::uint16_t changed = m_synced ? m_baseline.changes(state, withDerived) : std::uint16_t{0xFFFF};
+        appendInt(out, lvc_field::Sequence, state.sequence);
+        if (changed & DeltaField::BidPrice) {
+            appendDouble(out, lvc_field::Bid, state.bidPrice);
+        }
+        if (changed & DeltaField::AskPrice) {
+            appendDouble(out, lvc_field::Ask, state.askPrice);
+        }
+        if (changed & DeltaField::LastPrice) {
+            appendDouble(out, lvc_field::Last, state.lastPrice);
+        }
+        if (changed & DeltaField::BidSize) {
+            appendQuantity(out, lvc_field::BidSize, state.bidQuantity());
+        }
+        if (changed & DeltaField::AskSize) {
+            appendQuantity(out, lvc_field::AskSize, state.askQuantity());
+        }
+        if (changed & DeltaField::LastSize) {
+            appendQuantity(out, lvc_field::LastSize, state.lastQuantity());
+        }
+        if (changed & DeltaField::QuoteTime) {
+            appendInt(out, lvc_field::QuoteTime, state.quoteTimestamp);
+        }
+        if (changed & DeltaField::TradeTime) {
+            appendInt(out, lvc_field::TradeTime, state.tradeTimestamp);
+        }
+        if (changed & DeltaField::Exchange) {
+            append(out, lvc_field::Exchange, state.exchange);
+        }
+        if (changed & DeltaField::Conditions) {
+            char text[kTradeConditionsMaxChars];
+            const char* end = writeTradeConditions(text, state.tradeConditions);
+            append(out, lvc_field::Conditions, std::string_view(text, static_cast<std::size_t>(end - text)));
+        }
+        if (changed & DeltaField::PastLimit) {
+            appendInt(out, lvc_field::PastLimit, state.pastLimit ? 1 : 0);
+        }
+        if (withDerived && (changed & DeltaField::Derived)) {
+            appendDouble(out, lvc_field::Mid, state.derived.mid);
+            appendDouble(out, lvc_field::Spread, state.derived.spread);
+            appendDouble(out, lvc_field::Vwap, state.derived.vwap);
+            appendInt(out, lvc_field::RollingVolume, state.derived.rolling.total());
+        }
+        m_baseline.capture(state);
+        m_synced = true;
+    }
+
+    // Next write carries every field (the key may have been deleted or expired)
+    void resync() { m_synced = false; }
+
+private:
+    static void append(std::string& out, std::string_view field, std::string_view value) {
+        if (!out.empty()) {
+            out += '\n';
+        }
+        out.append(field.data(), field.size());
+        out += '\n';
+        out.append(value.data(), value.size());
+    }
+
+    template <typename Int>
+    static void appendInt(std::string& out, std::string_view field, Int value) {
+        char text[24];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        append(out, field, std::string_view(text, static_cast<std::size_t>(result.ptr - text)));
+    }
+
+    static void appendQuantity(std::string& out, std::string_view field, Quantity quantity) {
+        char text[kQuantityMaxChars];
+        append(out, field, std::string_view(text, static_cast<std::size_t>(writeQuantity(text, quantity) - text)));
+    }
+
+    // Shortest round-trip digits (171.55, not 171.55000000000001)
+    static void appendDouble(std::string& out, std::string_view field, double value) {
+        char text[32];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        append(out, field, std::string_view(text, static_cast<std::size_t>(result.ptr - text)));
+    }
+
+    DeltaBaseline m_baseline;
+    int m_conId = 0;
+    std::string_view m_primaryExchange;             // Static TradeCodes.h name
+    bool m_synced = false;
+};
+
+namespace lvc_detail {
+
+template <typename Number>
+inline void read(std::string_view text, Number& out) {
+    Number value{};
+    const std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec == std::errc() && result.ptr == text.data() + text.size()) {
+        out = value;
+    }
+}
+
+// Size text ("100", "0.5") into one of state's sizes at state.sizeScale - the others widen with it
+inline void readSize(std::string_view text, InstrumentState& state, std::int64_t& out) {
+    const bool negative = !text.empty() && text.front() == '-';
+    Quantity quantity;
+    if (parseQuantity(negative ? text.substr(1) : text, quantity)) {
+        if (negative) {
+            quantity.units = -quantity.units;
+        }
+        out = state.sizeUnits(quantity);
+    }
+}
+
+} // namespace lvc_detail
+
+// Quote / trade fields of an HGETALL reply (field, value pairs) into state - same contract as parseLastValue
+// (WarmStart.h): unknown fields are ignored, missing ones keep the current value
+// false if the hash has no "seq" (not written by LastValueTrack)
+template <typename Pairs>
+bool parseLastValueHash(const Pairs& fields, InstrumentState& state) {
+    using namespace lvc_detail;
+    bool sequenced = false;
+    for (const auto& field : fields) {
+        const std::string_view name = field.first;
+        const std::string_view value = field.second;
+        if (name == lvc_field::Sequence) {
+            read(value, state.sequence);
+            sequenced = true;
+        } else if (name == lvc_field::ConId) {
+            read(value, state.conId);
+        } else if (name == lvc_field::PrimaryExchange) {
+            state.primaryExchange = exchangeName(exchangeCode(value));
+        } else if (name == lvc_field::Bid) {
+            read(value, state.bidPrice);
+        } else if (name == lvc_field::Ask) {
+            read(value, state.askPrice);
+        } else if (name == lvc_field::Last) {
+            read(value, state.lastPrice);
+        } else if (name == lvc_field::BidSize) {
+            readSize(value, state, state.bidSize);
+        } else if (name == lvc_field::AskSize) {
+            readSize(value, state, state.askSize);
+        } else if (name == lvc_field::LastSize) {
+            readSize(value, state, state.lastSize);
+        } else if (name == lvc_field::QuoteTime) {
+            read(value, state.quoteTimestamp);
+        } else if (name == lvc_field::TradeTime) {
+            read(value, state.tradeTimestamp);
+        } else if (name == lvc_field::Exchange) {
+            state.exchange = exchangeName(exchangeCode(value));
+        } else if (name == lvc_field::Conditions) {
+            state.tradeConditions = parseTradeConditions(value);
+        } else if (name == lvc_field::PastLimit) {
+            state.pastLimit = value == "1";
+        }
+    }
+    state.hasQuote = state.quoteTimestamp != 0;
+    state.hasTrade = state.tradeTimestamp != 0;
+    return sequenced;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,162 @@
+// LatencyHistogram.h - Per-stage pipeline latency (stamps, log-linear histograms, percentiles)
+// SCOPE: TwsClient stamps ingest on the message thread; worker and publisher record stages
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+// REASON: steady_clock is monotonic (vDSO, TSC-backed on x86) and comparable across threads
+inline std::int64_t latencyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Pipeline stages, in tick order
+enum class LatencyStage : std::uint8_t {
+    Ingest,     // TwsClient callback entry → enqueue
+    Queue,      // Enqueue → worker dequeue (includes time in the shard overflow table)
+    Serialize,  // Worker dequeue → snapshot encoded (aggregation, conflation window, encoding)
+    Publish,    // Batch handed to the publisher → pipeline reply received (I/O thread wait + round trip)
+    EndToEnd,   // Callback entry of a batch's oldest tick → its pipeline reply received
+    Count
+};
+
+inline constexpr std::size_t kLatencyStageCount = static_cast<std::size_t>(LatencyStage::Count);
+
+inline const char* latencyStageName(LatencyStage stage) {
+    static constexpr const char* kNames[kLatencyStageCount] = {"ingest", "queue", "serialize", "publish",
+                                                                 "endToEnd"};
+    return stage < LatencyStage::Count ? kNames[static_cast<std::size_t>(stage)] : "";
+}
+
+// Counts copied out of a LatencyHistogram - percentiles and interval deltas are computed here
+struct LatencySnapshot {
+    static constexpr unsigned kSubBucketBits = 5;                 // 32 linear sub-buckets per power of two
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr unsigned kMaxValueBits = 40;                 // ~18 min in ns, larger values are clamped
+    static constexpr std::size_t kBuckets = (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+    std::array<std::uint64_t, kBuckets> counts{};
+
+    // REASON: HDR-style log-linear index - exact below 64 ns, then ≤ 1/32 (~3%) relative error
+    static std::size_t bucketOf(std::int64_t value) {
+        if (value < 0) {
+            value = 0;
+        }
+        std::uint64_t v = static_cast<std::uint64_t>(value);
+        constexpr std::uint64_t kMax = (std::uint64_t{1} << kMaxValueBits) - 1;
+        if (v > kMax) {
+            v = kMax;
+        }
+        if (v < 2 * kSubBuckets) {
+            return static_cast<std::size_t>(v);
+        }
+        const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(v));
+        const unsigned shift = msb - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + static_cast<std::size_t>((v >> shift) - kSubBuckets);
+    }
+
+    // Highest value that lands in `bucket` (HDR "highest equivalent value")
+    static std::int64_t bucketUpperBound(std::size_t bucket) {
+        if (bucket < 2 * kSubBuckets) {
+            return static_cast<std::int64_t>(bucket);
+        }
+        const std::size_t shift = bucket / kSubBuckets - 1;
+        const std::uint64_t mantissa = bucket % kSubBuckets + kSubBuckets;
+        return static_cast<std::int64_t>(((mantissa + 1) << shift) - 1);
+    }
+
+    std::uint64_t total() const {
+        std::uint64_t sum = 0;
+        for (std::uint64_t count : counts) {
+            sum += count;
+        }
+        return sum;
+    }
+
+    // percentile in [0, 100], 0 when empty
+    std::int64_t valueAt(double percentile) const {
+        const std::uint64_t samples = total();
+        if (samples == 0) {
+            return 0;
+        }
+        std::uint64_t rank = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(samples) + 0.5);
+        rank = rank < 1 ? 1 : (rank > samples ? samples : rank);
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return bucketUpperBound(i);
+            }
+        }
+        return bucketUpperBound(kBuckets - 1);
+    }
+
+    std::int64_t max() const {
+        for (std::size_t i = kBuckets; i-- > 0;) {
+            if (counts[i] != 0) {
+                return bucketUpperBound(i);
+            }
+        }
+        return 0;
+    }
+
+    // Lifetime counts → samples recorded since `previous` (an earlier snapshot of the same histogram),
+    // `previous` takes the lifetime counts for the next interval
+    void advance(LatencySnapshot& previous) {
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            const std::uint64_t lifetime = counts[i];
+            counts[i] = lifetime - previous.counts[i];
+            previous.counts[i] = lifetime;
+        }
+    }
+};
+
+// Lifetime histogram of nanosecond durations: one writer thread, any reader thread
+// PERFORMANCE: record() is a relaxed load + store, no RMW - readers snapshot() and diff intervals
+class LatencyHistogram {
+public:
+    void record(std::int64_t valueNs) {
+        std::atomic<std::uint64_t>& count = m_counts[LatencySnapshot::bucketOf(valueNs)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void snapshot(LatencySnapshot& out) const {
+        for (std::size_t i = 0; i < LatencySnapshot::kBuckets; ++i) {
+            out.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::array<std::atomic<std::uint64_t>, LatencySnapshot::kBuckets> m_counts{};
+};
+
+// One interval's percentiles per stage (published to TWS:STATUS)
+struct LatencyReport {
+    struct Stage {
+        std::uint64_t count = 0;
+        std::int64_t p50 = 0;
+        std::int64_t p99 = 0;
+        std::int64_t p999 = 0;
+        std::int64_t max = 0;
+    };
+    std::array<Stage, kLatencyStageCount> stages{};
+
+    static Stage summarize(const LatencySnapshot& interval) {
+        Stage stage;
+        stage.count = interval.total();
+        stage.p50 = interval.valueAt(50.0);
+        stage.p99 = interval.valueAt(99.0);
+        stage.p999 = interval.valueAt(99.9);
+        stage.max = interval.max();
+        return stage;
+    }
+};
+
+} // namespace tws_bridge
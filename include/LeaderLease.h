@@ -0,0 +1,86 @@
+// LeaderLease.h - Active/standby election on a Redis lease key (SET NX PX, renewed while held)
+// SCOPE: Own thread + own Redis connection; main() reads leader() / lost()
+
+#pragma once
+
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace tws_bridge {
+
+// leader: two bridges on two hosts, one publishing - the standby keeps its TWS sessions up but
+// subscribes nothing until it holds the key
+struct LeaderConfig {
+    bool enabled = false;
+    std::string key = "TWS:LEADER";
+    std::string id;                                  // "" = hostname:pid (defaultInstanceId)
+    std::chrono::milliseconds ttl{2000};             // Key expiry - a crashed leader is replaced within this
+    std::chrono::milliseconds renewInterval{500};    // Renew (leader) / acquire attempt (standby) period
+    std::chrono::milliseconds socketTimeout{200};
+};
+
+// Lifetime counters (written by the lease thread, readable from any thread)
+struct LeaderCounters {
+    std::atomic<std::uint64_t> acquired{0};          // Standby -> leader transitions
+    std::atomic<std::uint64_t> renewals{0};
+    std::atomic<std::uint64_t> failures{0};          // Redis errors and lost ownership
+};
+
+// hostname:pid - default id of this bridge in a lease or a partition (SymbolPartition.h)
+inline std::string defaultInstanceId() {
+    char host[256] = {};
+    if (::gethostname(host, sizeof(host) - 1) != 0) {
+        host[0] = '\0';
+    }
+    return std::string(host[0] != '\0' ? host : "bridge") + ":" + std::to_string(::getpid());
+}
+
+// Last moment a leader whose renewals fail may keep publishing
+// REASON: One renew interval before the key can expire - this node stops before the standby can take
+// the key, so two leaders never publish at once (clock rates of both hosts assumed equal)
+inline std::chrono::steady_clock::time_point leaseStepDownAt(std::chrono::steady_clock::time_point lastRenewed,
+                                                             const LeaderConfig& config) {
+    return lastRenewed + config.ttl - config.renewInterval;
+}
+
+// Standby: SET key id NX PX ttl every renewInterval until it succeeds, then leader() turns true
+// Leader: compare-and-PEXPIRE (Lua, the key must still hold this id) every renewInterval
+// Step-down is one-way - lost() turns true when the key holds another id or no renewal succeeded
+// before leaseStepDownAt; main() then stops the bridge and the supervisor restarts it as a standby
+// ARCHITECTURE: Renewals run on this thread's connection, not in a worker's pipeline - a lease round trip
+// never waits behind a tick batch and a tick batch never waits on one
+class LeaderLease {
+public:
+    LeaderLease(const std::string& uri, LeaderConfig config);
+    ~LeaderLease();
+
+    LeaderLease(const LeaderLease&) = delete;
+    LeaderLease& operator=(const LeaderLease&) = delete;
+
+    void start();
+    // Joins the thread, then deletes the key if this node still holds it (the standby takes over within
+    // one renewInterval instead of waiting for the expiry)
+    void stop();
+
+    bool leader() const { return m_leader.load(std::memory_order_acquire); }
+    bool lost() const { return m_lost.load(std::memory_order_acquire); }
+    const std::string& id() const { return m_config.id; }
+    const LeaderCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+
+    std::string m_uri;
+    LeaderConfig m_config;
+    LeaderCounters m_counters;
+    std::atomic<bool> m_leader{false};
+    std::atomic<bool> m_lost{false};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
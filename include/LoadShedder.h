@@ -0,0 +1,99 @@
+// LoadShedder.h - Overload control: steps through degradation levels while the pipeline falls behind
+// SCOPE: Main thread samples and decides (100 ms), workers / message threads apply the level
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// Each level keeps the ones below it
+enum class ShedLevel : std::uint8_t {
+    Normal,
+    ConflateQuotes,  // Workers conflate every quote (LoadShedConfig::conflationWindow), trades still publish
+    DropTiers,       // Rate-tier outputs (TWS:{RATE}:TICKS:*) paused
+    DowngradeFeeds   // lowPriority symbols moved from tick-by-tick to top of book (reqMktData)
+};
+
+inline const char* shedLevelName(ShedLevel level) {
+    switch (level) {
+    case ShedLevel::Normal: return "normal";
+    case ShedLevel::ConflateQuotes: return "conflate_quotes";
+    case ShedLevel::DropTiers: return "drop_tiers";
+    case ShedLevel::DowngradeFeeds: return "downgrade_feeds";
+    }
+    return "unknown";
+}
+
+struct LoadShedConfig {
+    bool enabled = false;
+    std::chrono::milliseconds queueAge{250};        // Breach: oldest update waited longer in a shard queue
+    std::size_t queueDepth = 50000;                 // ... or this many updates queued in one shard
+    std::chrono::milliseconds publishLatency{200};  // ... or a Redis pipeline round trip took longer (or Redis is down)
+    std::chrono::seconds escalateAfter{2};          // Breached this long at one level: next level
+    std::chrono::seconds recoverAfter{10};          // Healthy this long: one level back
+    std::chrono::microseconds conflationWindow{50000};  // ConflateQuotes window (at least worker.conflation.window)
+    std::vector<std::string> lowPriority;           // DowngradeFeeds symbols (startup symbols only)
+};
+
+// Worst reading across shards at one sample
+struct LoadSample {
+    std::chrono::nanoseconds queueAge{0};
+    std::size_t queueDepth = 0;
+    std::chrono::nanoseconds publishLatency{0};
+    bool redisDown = false;                         // A circuit breaker is open
+};
+
+// Hysteresis: one level up per escalateAfter of continuous breach, one down per recoverAfter of health
+// REASON: Stepwise in both directions - a breach that persists through cheap measures escalates,
+// a recovering bridge re-enables the expensive outputs last
+class LoadShedder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit LoadShedder(LoadShedConfig config) : m_config(std::move(config)) {}
+
+    bool breached(const LoadSample& sample) const {
+        return sample.redisDown || sample.queueAge >= m_config.queueAge || sample.queueDepth >= m_config.queueDepth
+            || sample.publishLatency >= m_config.publishLatency;
+    }
+
+    // true when the level changed
+    bool update(const LoadSample& sample, Clock::time_point now) {
+        const ShedLevel before = m_level;
+        if (breached(sample)) {
+            m_healthySince = Clock::time_point{};
+            if (m_breachSince == Clock::time_point{}) {
+                m_breachSince = now;
+            } else if (now - m_breachSince >= m_config.escalateAfter && m_level != ShedLevel::DowngradeFeeds) {
+                m_level = static_cast<ShedLevel>(static_cast<std::uint8_t>(m_level) + 1);
+                m_breachSince = now;  // REASON: Each level gets a full escalateAfter to take effect
+            }
+        } else {
+            m_breachSince = Clock::time_point{};
+            if (m_healthySince == Clock::time_point{}) {
+                m_healthySince = now;
+            } else if (now - m_healthySince >= m_config.recoverAfter && m_level != ShedLevel::Normal) {
+                m_level = static_cast<ShedLevel>(static_cast<std::uint8_t>(m_level) - 1);
+                m_healthySince = now;
+            }
+        }
+        return m_level != before;
+    }
+
+    ShedLevel level() const { return m_level; }
+    const LoadShedConfig& config() const { return m_config; }
+
+private:
+    LoadShedConfig m_config;
+    ShedLevel m_level = ShedLevel::Normal;
+    Clock::time_point m_breachSince{};              // {} = not breaching
+    Clock::time_point m_healthySince{};             // {} = not healthy
+};
+
+} // namespace tws_bridge
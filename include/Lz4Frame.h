@@ -0,0 +1,276 @@
+// Lz4Frame.h - Dependency-free LZ4 frame compression for batched payloads (aggregate channel, stream entries)
+// SCOPE: One Lz4Compressor per thread (Redis Worker) - the match table is reused across payloads
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+/**
+ * Output is a standard LZ4 frame (lz4 CLI, python lz4.frame, lz4js decode it unchanged):
+ *   magic 04 22 4D 18 | FLG 0x60 (v1, independent blocks, no checksums) | BD 0x70 (4 MiB blocks) | HC
+ *   then per block: u32 LE size (bit 31 = stored uncompressed) + data, then u32 0 (end mark)
+ *
+ * [ARCHITECTURE] The magic's first byte (0x04) is the flag consumers test: JSON payloads start with
+ * '{' or '[', binary v1 with its version byte - a compressed payload is never ambiguous.
+ */
+namespace lz4_detail {
+
+constexpr std::uint8_t kMagic[4] = {0x04, 0x22, 0x4D, 0x18};
+constexpr std::uint8_t kFlags = 0x60;
+constexpr std::uint8_t kBlockDescriptor = 0x70;
+constexpr std::size_t kBlockMax = 4u << 20;
+constexpr std::size_t kMinMatch = 4;
+constexpr std::size_t kMatchStartLimit = 12;        // MFLIMIT: no match starts in the last 12 bytes
+constexpr std::size_t kLastLiterals = 5;            // ... and none reaches into the last 5
+constexpr std::size_t kMaxOffset = 65535;
+constexpr unsigned kHashLog = 12;
+constexpr std::uint32_t kUncompressedBit = 0x80000000u;
+
+// XXH32 of inputs shorter than 16 bytes (frame descriptor checksum)
+constexpr std::uint32_t xxh32Short(const std::uint8_t* data, std::size_t length, std::uint32_t seed = 0) {
+    constexpr std::uint32_t kPrime1 = 2654435761u;
+    constexpr std::uint32_t kPrime2 = 2246822519u;
+    constexpr std::uint32_t kPrime3 = 3266489917u;
+    constexpr std::uint32_t kPrime5 = 374761393u;
+    std::uint32_t hash = seed + kPrime5 + static_cast<std::uint32_t>(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        hash += data[i] * kPrime5;
+        hash = ((hash << 11) | (hash >> 21)) * kPrime1;
+    }
+    hash ^= hash >> 15;
+    hash *= kPrime2;
+    hash ^= hash >> 13;
+    hash *= kPrime3;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+constexpr std::uint8_t kDescriptor[2] = {kFlags, kBlockDescriptor};
+constexpr std::uint8_t kHeaderChecksum = static_cast<std::uint8_t>((xxh32Short(kDescriptor, 2) >> 8) & 0xFF);
+
+inline std::uint32_t read32(const char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline void appendLE32(std::string& out, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+// Length beyond a token nibble: 255-byte runs + remainder
+inline char* writeLength(char* out, std::size_t length) {
+    for (; length >= 255; length -= 255) {
+        *out++ = static_cast<char>(255);
+    }
+    *out++ = static_cast<char>(length);
+    return out;
+}
+
+} // namespace lz4_detail
+
+// Greedy single-probe LZ4 (the reference "fast" strategy at acceleration 1)
+// PERFORMANCE: One 16 KiB hash table, reset per block; JSON batches of repeated keys compress 4-8x
+class Lz4Compressor {
+public:
+    // Appends the LZ4 frame of input to out (out is not cleared)
+    void compressFrame(std::string_view input, std::string& out) {
+        using namespace lz4_detail;
+        out.append(reinterpret_cast<const char*>(kMagic), sizeof(kMagic));
+        out += static_cast<char>(kFlags);
+        out += static_cast<char>(kBlockDescriptor);
+        out += static_cast<char>(kHeaderChecksum);
+        for (std::size_t offset = 0; offset < input.size(); offset += kBlockMax) {
+            appendBlock(input.substr(offset, kBlockMax), out);
+        }
+        appendLE32(out, 0);
+    }
+
+    // Appends one frame block of input (at most lz4_detail::kBlockMax bytes): u32 LE size (bit 31 = stored)
+    // + data, no frame header / end mark - for containers with their own framing (TickJournal blocks)
+    void appendBlock(std::string_view block, std::string& out) {
+        using namespace lz4_detail;
+        const std::size_t sizeAt = out.size();
+        out.resize(sizeAt + 4 + block.size() + block.size() / 255 + 16);  // Worst case (incompressible)
+        char* const begin = &out[sizeAt + 4];
+        const std::size_t written = static_cast<std::size_t>(compressBlock(block, begin) - begin);
+        std::uint32_t header = static_cast<std::uint32_t>(written);
+        if (written >= block.size()) {
+            // REASON: Stored blocks never grow the payload by more than the 4-byte header
+            std::memcpy(begin, block.data(), block.size());
+            header = static_cast<std::uint32_t>(block.size()) | kUncompressedBit;
+        }
+        for (int i = 0; i < 4; ++i) {
+            out[sizeAt + static_cast<std::size_t>(i)] = static_cast<char>((header >> (8 * i)) & 0xFF);
+        }
+        out.resize(sizeAt + 4 + (header & ~kUncompressedBit));
+    }
+
+private:
+    char* compressBlock(std::string_view block, char* out) {
+        using namespace lz4_detail;
+        const char* const in = block.data();
+        const std::size_t size = block.size();
+        std::size_t anchor = 0;
+        if (size > kMatchStartLimit) {
+            std::fill(m_table.begin(), m_table.end(), 0u);
+            const std::size_t matchStartLimit = size - kMatchStartLimit;
+            const std::size_t matchEndLimit = size - kLastLiterals;
+            std::size_t ip = 0;
+            while (ip < matchStartLimit) {
+                const std::uint32_t sequence = read32(in + ip);
+                std::uint32_t& slot = m_table[hash(sequence)];
+                const std::size_t candidate = slot;
+                slot = static_cast<std::uint32_t>(ip);
+                if (candidate >= ip || ip - candidate > kMaxOffset || read32(in + candidate) != sequence) {
+                    ++ip;
+                    continue;
+                }
+                std::size_t length = kMinMatch;
+                while (ip + length < matchEndLimit && in[candidate + length] == in[ip + length]) {
+                    ++length;
+                }
+                out = writeSequence(out, in + anchor, ip - anchor, ip - candidate, length);
+                ip += length;
+                anchor = ip;
+            }
+        }
+        // Last literals (token with no match)
+        const std::size_t literals = size - anchor;
+        char* token = out++;
+        *token = static_cast<char>(std::min<std::size_t>(literals, 15) << 4);
+        if (literals >= 15) {
+            out = writeLength(out, literals - 15);
+        }
+        std::memcpy(out, in + anchor, literals);
+        return out + literals;
+    }
+
+    static char* writeSequence(char* out, const char* literals, std::size_t literalCount, std::size_t offset,
+                               std::size_t matchLength) {
+        using namespace lz4_detail;
+        const std::size_t matchCode = matchLength - kMinMatch;
+        *out++ = static_cast<char>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(matchCode, 15));
+        if (literalCount >= 15) {
+            out = writeLength(out, literalCount - 15);
+        }
+        std::memcpy(out, literals, literalCount);
+        out += literalCount;
+        *out++ = static_cast<char>(offset & 0xFF);
+        *out++ = static_cast<char>(offset >> 8);
+        if (matchCode >= 15) {
+            out = writeLength(out, matchCode - 15);
+        }
+        return out;
+    }
+
+    static std::size_t hash(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - lz4_detail::kHashLog);
+    }
+
+    std::vector<std::uint32_t> m_table = std::vector<std::uint32_t>(std::size_t{1} << lz4_detail::kHashLog);
+};
+
+// One frame block as Lz4Compressor::appendBlock writes it (u32 LE size + data) appended to out, the block's
+// bytes consumed from block; false if malformed
+inline bool decompressLz4Block(std::string_view& block, std::string& out) {
+    using namespace lz4_detail;
+    if (block.size() < 4) {
+        return false;
+    }
+    std::uint32_t header = 0;
+    for (int i = 0; i < 4; ++i) {
+        header |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(block[static_cast<std::size_t>(i)])) << (8 * i);
+    }
+    const std::size_t size = header & ~kUncompressedBit;
+    if (4 + size > block.size()) {
+        return false;
+    }
+    const char* in = block.data() + 4;
+    const char* const end = in + size;
+    block.remove_prefix(4 + size);
+    if (header & kUncompressedBit) {
+        out.append(in, size);
+        return true;
+    }
+    const std::size_t blockStart = out.size();
+    auto readLength = [&in, end](std::size_t length, bool& ok) {
+        if (length != 15) {
+            return length;
+        }
+        for (;;) {
+            if (in >= end) {
+                ok = false;
+                return length;
+            }
+            const std::uint8_t more = static_cast<std::uint8_t>(*in++);
+            length += more;
+            if (more != 255) {
+                return length;
+            }
+        }
+    };
+    while (in < end) {
+        bool ok = true;
+        const std::uint8_t token = static_cast<std::uint8_t>(*in++);
+        const std::size_t literals = readLength(token >> 4, ok);
+        if (!ok || static_cast<std::size_t>(end - in) < literals) {
+            return false;
+        }
+        out.append(in, literals);
+        in += literals;
+        if (in == end) {
+            break;  // Last sequence: literals only
+        }
+        if (end - in < 2) {
+            return false;
+        }
+        const std::size_t offset = static_cast<std::uint8_t>(in[0]) | (static_cast<std::size_t>(static_cast<std::uint8_t>(in[1])) << 8);
+        in += 2;
+        const std::size_t length = readLength(token & 0x0F, ok) + kMinMatch;
+        if (!ok || offset == 0 || offset > out.size() - blockStart) {
+            return false;
+        }
+        // REASON: Byte-wise - an overlapping match (offset < length) repeats its own output
+        const std::size_t from = out.size() - offset;
+        for (std::size_t i = 0; i < length; ++i) {
+            out += out[from + i];
+        }
+    }
+    return true;
+}
+
+// Frame written by Lz4Compressor (no checksums, no dictionary) into out (cleared), false if malformed
+// NOTE: Reference decoder for tests and replay tools - consumers use their LZ4 library
+inline bool decompressLz4Frame(std::string_view frame, std::string& out) {
+    using namespace lz4_detail;
+    out.clear();
+    if (frame.size() < 11 || std::memcmp(frame.data(), kMagic, sizeof(kMagic)) != 0 ||
+        static_cast<std::uint8_t>(frame[4]) != kFlags) {
+        return false;
+    }
+    std::string_view blocks = frame.substr(7);
+    for (;;) {
+        if (blocks.size() < 4) {
+            return false;
+        }
+        if (read32(blocks.data()) == 0) {
+            return blocks.size() == 4;  // REASON: End mark (zero is zero in either byte order)
+        }
+        if (!decompressLz4Block(blocks, out)) {
+            return false;
+        }
+    }
+}
+
+} // namespace tws_bridge
@@ -1,49 +1,301 @@
 #pragma once
 
+#include "BarSize.h"
+#include "DerivedMetrics.h"
+#include "Quantity.h"
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 /**
  * @brief Tick update types from TWS API callbacks
  */
-enum class TickUpdateType {
+enum class TickUpdateType : std::uint8_t {
     BidAsk,   // tickByTickBidAsk callback
     AllLast,  // tickByTickAllLast callback
-    Bar       // historicalData callback (for testing when markets closed)
+    Bar,      // historicalData callback (for testing when markets closed)
+    Depth,    // updateMktDepth / updateMktDepthL2 (one level change)
+    HistoryEnd, // historicalDataEnd: publish the slot's collected TickFlags::Historical bars
+    MidPoint,  // tickByTickMidPoint: midpoint only, published on its own channel (no InstrumentState merge)
+    Greeks,    // tickOptionComputation (model): one option leg of the slot's chain, TickUpdate::aux = leg
+    Handoff    // Shard rebalancing marker: the slot moves to another worker (ShardRouter.h SlotMigration)
 };
 
+// NOTE: Feed types only - Handoff is router-internal (never counted, journaled or replayed)
+inline constexpr std::size_t kTickUpdateTypeCount = 7;
+
+// Metric label / log name
+inline const char* tickUpdateTypeName(TickUpdateType type) {
+    static constexpr const char* kNames[kTickUpdateTypeCount] = {"bid_ask", "all_last", "bar", "depth", "history_end",
+                                                                            "mid_point", "greeks"};
+    const auto index = static_cast<std::size_t>(type);
+    return index < kTickUpdateTypeCount ? kNames[index] : "";
+}
+
+// REASON: Latest-value ticks may be coalesced; bars and depth changes are distinct records
+// NOTE: Greeks are latest-value too, but per leg - one slot key would keep one leg of the whole chain
+inline constexpr bool isCoalescable(TickUpdateType type) {
+    return type == TickUpdateType::BidAsk || type == TickUpdateType::AllLast || type == TickUpdateType::MidPoint;
+}
+
+// Coalescing key of a latest-value type within its slot (2 keys per slot)
+// REASON: MidPoint shares BidAsk's key - a symbol streams one or the other (FeedType), never both
+inline constexpr std::size_t coalescingLane(TickUpdateType type) {
+    return type == TickUpdateType::AllLast ? 1 : 0;
+}
+
 /**
- * @brief Normalized tick update structure
+ * @brief TickUpdate::flags bits
+ */
+namespace TickFlags {
+constexpr std::uint8_t PastLimit = 1u << 0;  // AllLast: trade outside regular hours
+constexpr std::uint8_t SessionSeed = 1u << 0; // Bar: daily bar seeding the session statistics (SessionStats.h)
+constexpr std::uint8_t Put = 1u << 0;        // Greeks: put leg (calls leave it clear)
+constexpr std::uint8_t Historical = 1u << 1; // Bar: part of a reqHistoricalData response (batched)
+constexpr std::uint8_t Backfill = 1u << 1;   // BidAsk / AllLast / HistoryEnd: reqHistoricalTicks gap backfill (GapBackfill.h)
+constexpr unsigned BarSizeShift = 2;           // Bar: bits 2-6 hold the tws_bridge::BarSize code
+constexpr std::uint8_t BarSizeMask = 0x1Fu << BarSizeShift;
+constexpr std::uint8_t Live = 1u << 7;         // Bar: keepUpToDate update of the in-progress bar (historicalDataUpdate)
+constexpr unsigned SizeScaleShift = 2;         // BidAsk / AllLast: bits 2-5 hold the sizes' decimal places
+constexpr std::uint8_t SizeScaleMask = 0x0Fu << SizeScaleShift;
+}
+
+static_assert(tws_bridge::kMaxQuantityScale <= (TickFlags::SizeScaleMask >> TickFlags::SizeScaleShift),
+              "Quantity scales must fit TickFlags::SizeScaleMask");
+
+static_assert(static_cast<unsigned>(tws_bridge::BarSize::Count) <= (TickFlags::BarSizeMask >> TickFlags::BarSizeShift),
+              "BarSize codes must fit TickFlags::BarSizeMask");
+
+// PITFALL: Payload structs must stay trivial (no member initializers) to live in the union
+
+// Latency stamps (LatencyHistogram.h), zero unless TwsClient latency stamping is on - receiveNs always set
+// REASON: Tick arms fill at most 24 of the 48 payload bytes - stamps ride in the spare tail, not the header
+struct TickStamps {
+    std::int64_t ingestNs;       // steady_clock at TwsClient callback entry
+    std::uint32_t enqueueNs;     // Callback entry → enqueue (delta)
+    std::uint32_t traceId;       // TraceExport sampled tick (0 = not sampled)
+    std::int64_t receiveNs;      // Unix ns the frame's socket read returned (TscClock.h), 0 = unknown
+};
+
+// BidAsk payload (tickByTickBidAsk), sizes are units at TickUpdate::sizeScale() (setQuoteSizes)
+struct BidAskPayload {
+    double bidPrice;
+    double askPrice;
+    std::int32_t bidSize;
+    std::int32_t askSize;
+    TickStamps stamps;
+};
+
+// AllLast payload (tickByTickAllLast), pastLimit lives in TickUpdate::flags, size is units at
+// TickUpdate::sizeScale() (setTradeSize)
+struct AllLastPayload {
+    double price;
+    std::int32_t size;
+    std::uint8_t exchange;                         // tws_bridge::ExchangeCode (TradeCodes.h)
+    std::uint64_t conditions;                      // tws_bridge::TradeConditions bits
+    TickStamps stamps;
+};
+
+// Depth payload (updateMktDepth / updateMktDepthL2), operation/side per OrderBook.h depth::
+struct DepthPayload {
+    double price;
+    std::int64_t size;
+    std::uint8_t position;
+    std::uint8_t operation;
+    std::uint8_t side;
+    TickStamps stamps;
+};
+
+// MidPoint payload (tickByTickMidPoint)
+struct MidPointPayload {
+    double midPoint;
+    TickStamps stamps;
+};
+
+// Greeks payload (tickOptionComputation, model computation), leg index in TickUpdate::aux, put in TickFlags::Put
+// REASON: Greeks as float (TWS's model is not more precise than that) - strike and expiry fit next to them,
+// so the worker files a leg without a copy of the chain layout
+// NOTE: No room for TickStamps - greeks are throttled per chain (GreeksChain.h), not latency-tracked;
+// NaN = TWS has not computed the value
+struct GreeksPayload {
+    double strike;
+    double optionPrice;                            // Model price
+    double underlyingPrice;
+    float impliedVol;
+    float delta;
+    float gamma;
+    float vega;
+    float theta;
+    std::uint32_t expiry;                          // YYYYMMDD
+};
+
+// Bar payload (historicalData / realtimeBar), barCount lives in TickUpdate::aux
+// NOTE: No room for TickStamps - bars are not latency-tracked
+struct BarPayload {
+    double open;
+    double high;
+    double low;
+    double close;
+    std::int64_t volume;
+    double wap;  // Weighted average price
+};
+
+/**
+ * @brief Normalized tick update structure (compact tagged record)
  * 
  * This struct is enqueued from EWrapper callbacks (Thread 2) to 
  * the lock-free queue for processing by the Redis Worker (Thread 3).
  * 
- * [PERFORMANCE] Keep this lightweight - only essential fields.
+ * Layout: 16-byte header + union payload selected by `type`.
+ * 
+ * [PERFORMANCE] One cache line per queued element - keep it that way.
  */
 struct TickUpdate {
-    int tickerId = 0;
+    // ========== Header (16 bytes) ==========
+    std::uint16_t slot = 0xFFFF;                   // InstrumentRegistry slot (dense state table index)
     TickUpdateType type = TickUpdateType::BidAsk;
-    long timestamp = 0;  // Unix timestamp (ms) from TWS
+    std::uint8_t flags = 0;                        // TickFlags bits
+    std::uint32_t aux = 0;                         // Bar: barCount, Greeks: chain leg
+    std::int64_t timestamp = 0;                    // Unix timestamp (ms) from TWS
     
-    // BidAsk fields
+    // ========== Payload (active member selected by type) ==========
+    union {
+        BarPayload bar{};                          // REASON: Largest member, zero-initializes all arms
+        BidAskPayload bidAsk;
+        AllLastPayload allLast;
+        DepthPayload depth;
+        MidPointPayload midPoint;
+        GreeksPayload greeks;
+    };
+    
+    bool pastLimit() const { return (flags & TickFlags::PastLimit) != 0; }
+    bool backfilled() const { return (flags & TickFlags::Backfill) != 0; }
+    tws_bridge::BarSize barSize() const {
+        return static_cast<tws_bridge::BarSize>((flags & TickFlags::BarSizeMask) >> TickFlags::BarSizeShift);
+    }
+    void setBarSize(tws_bridge::BarSize size) {
+        flags = static_cast<std::uint8_t>((flags & ~TickFlags::BarSizeMask)
+                                          | (static_cast<unsigned>(size) << TickFlags::BarSizeShift));
+    }
+    // BidAsk / AllLast: decimal places of the size fields (0 = whole units)
+    int sizeScale() const { return (flags & TickFlags::SizeScaleMask) >> TickFlags::SizeScaleShift; }
+    tws_bridge::Quantity bidQuantity() const { return {bidAsk.bidSize, sizeScale()}; }
+    tws_bridge::Quantity askQuantity() const { return {bidAsk.askSize, sizeScale()}; }
+    tws_bridge::Quantity tradeQuantity() const { return {allLast.size, sizeScale()}; }
+    // REASON: The payload has 32 bits per size (TickUpdate fills its cache line) - each tick carries its own
+    // scale, so a size only loses decimal places past ten significant digits (narrowQuantities)
+    void setQuoteSizes(tws_bridge::Quantity bid, tws_bridge::Quantity ask) {
+        const int scale = bid.scale > ask.scale ? bid.scale : ask.scale;
+        std::int64_t bidUnits = tws_bridge::rescaleUnits(bid.units, bid.scale, scale);
+        std::int64_t askUnits = tws_bridge::rescaleUnits(ask.units, ask.scale, scale);
+        setSizeScale(tws_bridge::narrowQuantities(bidUnits, askUnits, scale));
+        bidAsk.bidSize = static_cast<std::int32_t>(bidUnits);
+        bidAsk.askSize = static_cast<std::int32_t>(askUnits);
+    }
+    void setTradeSize(tws_bridge::Quantity size) {
+        std::int64_t units = size.units;
+        std::int64_t unused = 0;
+        setSizeScale(tws_bridge::narrowQuantities(units, unused, size.scale));
+        allLast.size = static_cast<std::int32_t>(units);
+    }
+    void setSizeScale(int scale) {
+        flags = static_cast<std::uint8_t>((flags & ~TickFlags::SizeScaleMask)
+                                          | (static_cast<unsigned>(scale) << TickFlags::SizeScaleShift));
+    }
+    // Stamps of the active tick arm, nullptr for bars / HistoryEnd / Greeks
+    const TickStamps* stamps() const {
+        switch (type) {
+        case TickUpdateType::BidAsk:
+            return &bidAsk.stamps;
+        case TickUpdateType::AllLast:
+            return &allLast.stamps;
+        case TickUpdateType::Depth:
+            return &depth.stamps;
+        case TickUpdateType::MidPoint:
+            return &midPoint.stamps;
+        default:
+            return nullptr;
+        }
+    }
+    TickStamps* stamps() { return const_cast<TickStamps*>(static_cast<const TickUpdate&>(*this).stamps()); }
+};
+
+static_assert(sizeof(TickUpdate) <= 64, "TickUpdate must fit one cache line");
+
+// REASON: A backfilled quote / trade is history, never the latest value of its slot
+inline bool isCoalescable(const TickUpdate& update) {
+    return isCoalescable(update.type) && !update.backfilled();
+}
+
+/**
+ * @brief Hot half of InstrumentState - what a BidAsk / AllLast apply reads and writes
+ *
+ * [PERFORMANCE] Starts on a cache line boundary: prices, sizes and the TWS timestamps fill the first
+ * line, receive time, trade attributes, flags and the sequence the second. The cold half
+ * (InstrumentMeta) and the derived metrics follow it, so a tick never pulls in the symbol string.
+ */
+struct alignas(64) InstrumentQuote {
+    // Quote / trade data (from tickByTickBidAsk / tickByTickAllLast)
     double bidPrice = 0.0;
     double askPrice = 0.0;
-    int bidSize = 0;
-    int askSize = 0;
-    
-    // AllLast fields
     double lastPrice = 0.0;
-    int lastSize = 0;
+    std::int64_t bidSize = 0;                      // Sizes: units at sizeScale (Quantity.h)
+    std::int64_t askSize = 0;
+    std::int64_t lastSize = 0;
+    long quoteTimestamp = 0;
+    long tradeTimestamp = 0;
+    
+    // Local receive time of the last quote / trade (TickStamps::receiveNs, Unix ns, 0 = unknown)
+    // REASON: TWS times are whole seconds - this orders ticks within one and measures feed latency
+    std::int64_t receiveNs = 0;
+    std::uint64_t sequence = 0;                    // Snapshots published for this slot ("seq"), 1 = first
+    
+    // Attributes (last trade)
+    std::uint64_t tradeConditions = 0;             // tws_bridge::TradeConditions bits
+    std::string_view exchange;                     // Static TradeCodes.h name - assigned per trade without copying
     bool pastLimit = false;
     
-    // Bar fields (for historicalData callback)
-    double open = 0.0;
-    double high = 0.0;
-    double low = 0.0;
-    double close = 0.0;
-    long volume = 0;
-    double wap = 0.0;  // Weighted average price
-    int barCount = 0;
+    bool hasQuote = false;
+    bool hasTrade = false;
+    
+    // Decimal places of bidSize / askSize / lastSize - the finest size this instrument has sent (never lowered)
+    // REASON: Per instrument, not per tick - a snapshot's three sizes share one scale, and equities stay at 0
+    std::uint8_t sizeScale = 0;
+    
+    // size as units at sizeScale - a finer size raises sizeScale first (stored sizes widened, exact)
+    std::int64_t sizeUnits(tws_bridge::Quantity size) {
+        if (size.scale > sizeScale) {
+            bidSize = tws_bridge::rescaleUnits(bidSize, sizeScale, size.scale);
+            askSize = tws_bridge::rescaleUnits(askSize, sizeScale, size.scale);
+            lastSize = tws_bridge::rescaleUnits(lastSize, sizeScale, size.scale);
+            sizeScale = static_cast<std::uint8_t>(size.scale);
+        }
+        return tws_bridge::rescaleUnits(size.units, size.scale, sizeScale);
+    }
+    tws_bridge::Quantity bidQuantity() const { return {bidSize, sizeScale}; }
+    tws_bridge::Quantity askQuantity() const { return {askSize, sizeScale}; }
+    tws_bridge::Quantity lastQuantity() const { return {lastSize, sizeScale}; }
+};
+
+// PITFALL: Three prices, three sizes and two timestamps are 64 bytes on their own - a new per-tick field
+// goes on the second line, and a third line is a layout change (check test_cache_layout)
+static_assert(sizeof(InstrumentQuote) == 128, "InstrumentQuote is two cache lines");
+
+/**
+ * @brief Cold half of InstrumentState - set when the slot is bound or its contract resolves
+ *
+ * Read by snapshots (symbol, conId, primary exchange), never by the per-tick apply.
+ * The slot's preformatted channel names stay registry-owned (InstrumentChannels).
+ */
+// REASON: Line-aligned as well - the ABI would otherwise lay the symbol into InstrumentQuote's tail padding
+struct alignas(64) InstrumentMeta {
+    std::string symbol;
+    std::string_view symbolJson;  // Pre-escaped "\"SYMBOL\"" (InstrumentRegistry-owned), empty = escaped per encode
+    int conId = 0;                                 // 0 until resolved (ContractCache / reqContractDetails)
+    int tickerId = 0;
+    std::string_view primaryExchange;              // Static TradeCodes.h name, empty until resolved
 };
 
 /**
@@ -53,27 +305,9 @@ struct TickUpdate {
  * JSON snapshots to Redis.
  * 
  * [ARCHITECTURE] Complete snapshots simplify downstream consumers (no merge logic).
+ * [PERFORMANCE] Hot / cold split - the quote fields (InstrumentQuote) come first, metadata after.
  */
-struct InstrumentState {
-    std::string symbol;
-    int conId = 0;
-    int tickerId = 0;
-    
-    // Quote data (from tickByTickBidAsk)
-    double bidPrice = 0.0;
-    double askPrice = 0.0;
-    int bidSize = 0;
-    int askSize = 0;
-    long quoteTimestamp = 0;
-    bool hasQuote = false;
-    
-    // Trade data (from tickByTickAllLast)
-    double lastPrice = 0.0;
-    int lastSize = 0;
-    long tradeTimestamp = 0;
-    bool hasTrade = false;
-    
-    // Attributes
-    std::string exchange;
-    bool pastLimit = false;
+struct InstrumentState : InstrumentQuote, InstrumentMeta {
+    // Derived (worker-maintained when WorkerConfig::derivedMetrics is enabled)
+    tws_bridge::DerivedMetrics derived;
 };
@@ -0,0 +1,220 @@
+// MarketScanner.h - TWS market scanner subscriptions: each scan cycle collected into reused rows, diffed
+// against the previous cycle and published as the ranks that changed (TWS:SCAN:{ID})
+// SCOPE: ScanCycle - message thread (scannerData / scannerDataEnd); ScanOutbox - message thread posts, the
+// publisher takes; ScanPublisher - own thread + own Redis connection
+
+#pragma once
+
+#include "SubscriptionCommand.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// One reqScannerSubscription
+struct ScanDefinition {
+    std::string id;                                 // Channel suffix: TWS:SCAN:{ID}
+    std::string scanCode;                           // e.g. TOP_PERC_GAIN, HOT_BY_VOLUME
+    std::string instrument;                         // e.g. STK (the location's first segment)
+    std::string location;                           // e.g. STK.US.MAJOR
+    int rows = 50;                                  // TWS caps a scan at 50
+};
+
+// "ID=SCAN_CODE@LOCATION[:rows]" (scanner.scans entry), e.g. "GAINERS=TOP_PERC_GAIN@STK.US.MAJOR:25";
+// false if malformed
+inline bool parseScanDefinition(std::string_view text, ScanDefinition& out) {
+    const std::size_t equals = text.find('=');
+    const std::size_t at = text.find('@');
+    if (equals == std::string_view::npos || equals == 0 || at == std::string_view::npos || at <= equals + 1) {
+        return false;
+    }
+    out.id.assign(text.substr(0, equals));
+    out.scanCode.assign(text.substr(equals + 1, at - equals - 1));
+    std::string_view location = text.substr(at + 1);
+    const std::size_t colon = location.find(':');
+    out.rows = 50;
+    if (colon != std::string_view::npos) {
+        const std::string_view rows = location.substr(colon + 1);
+        const std::from_chars_result result = std::from_chars(rows.data(), rows.data() + rows.size(), out.rows);
+        if (result.ec != std::errc() || result.ptr != rows.data() + rows.size() || out.rows < 1 || out.rows > 50) {
+            return false;
+        }
+        location = location.substr(0, colon);
+    }
+    if (location.empty()) {
+        return false;
+    }
+    out.location.assign(location);
+    out.instrument.assign(location.substr(0, location.find('.')));
+    return true;
+}
+
+// scanner: hot-symbol discovery without polling
+struct ScannerConfig {
+    std::vector<ScanDefinition> scans;
+    std::string channelPrefix = "TWS:SCAN:";        // + id: PUBLISH of the changed ranks + SET of the full list
+    bool autoSubscribe = false;                     // New entrants are subscribed like a TWS:COMMANDS subscribe
+    FeedType feed = FeedType::TopOfBook;            // Feed of the auto-subscribed entrants
+    int priority = -1;                              // Pacing order of those subscribes (below the configured symbols)
+    std::chrono::milliseconds socketTimeout{200};
+    std::chrono::milliseconds reconnectDelay{1000}; // Back-off after a Redis error
+};
+
+// One ranked row - the fields that identify the contract (and subscribe it)
+struct ScanRow {
+    long long conId = 0;
+    std::string symbol;
+    std::string secType;
+    std::string currency;
+    std::string primaryExchange;
+
+    bool sameContract(const ScanRow& other) const { return conId == other.conId && symbol == other.symbol; }
+};
+
+// One scan cycle, rank = index
+// PERFORMANCE: Rows are kept across cycles and overwritten in place - the strings keep their capacity, a
+// repeated scan allocates nothing once it has been as long as it gets
+struct ScanCycle {
+    std::vector<ScanRow> rows;                      // [0, size) valid, the rest is spare capacity
+    std::size_t size = 0;
+
+    // NOTE: TWS sends ranks in order, a gap (never seen) is left as an empty row
+    ScanRow& at(int rank) {
+        const auto index = static_cast<std::size_t>(rank < 0 ? 0 : rank);
+        if (index >= rows.size()) {
+            rows.resize(index + 1);
+        }
+        if (index >= size) {
+            for (std::size_t i = size; i < index; ++i) {
+                rows[i].conId = 0;
+                rows[i].symbol.clear();
+            }
+            size = index + 1;
+        }
+        return rows[index];
+    }
+
+    void clear() { size = 0; }
+};
+
+// Ranks of current that differ from previous (a new contract at the rank, or a rank previous did not have)
+// and the contracts of current previous did not list at all (entrants)
+// NOTE: Quadratic in the rows - a scan is at most 50, cheaper than hashing them
+inline void diffScan(const ScanCycle& previous, const ScanCycle& current, std::vector<std::size_t>& changed,
+                     std::vector<std::size_t>& entrants) {
+    changed.clear();
+    entrants.clear();
+    for (std::size_t rank = 0; rank < current.size; ++rank) {
+        const ScanRow& row = current.rows[rank];
+        if (rank >= previous.size || !row.sameContract(previous.rows[rank])) {
+            changed.push_back(rank);
+        }
+        bool listed = false;
+        for (std::size_t i = 0; i < previous.size && !listed; ++i) {
+            listed = row.sameContract(previous.rows[i]);
+        }
+        if (!listed && !row.symbol.empty()) {
+            entrants.push_back(rank);
+        }
+    }
+}
+
+// Completed cycles, message thread → publisher, one pending cycle per scan
+// PERFORMANCE: post() / take() swap cycles under a per-scan lock - neither side copies rows, and the
+// ready flag keeps the publisher's poll off the locks while nothing arrived
+// NOTE: An untaken cycle is replaced by the next one - the diff is against the last published, never lost
+class ScanOutbox {
+public:
+    explicit ScanOutbox(std::size_t scans)
+        : m_slots(std::make_unique<Slot[]>(scans))
+        , m_count(scans) {
+    }
+
+    std::size_t size() const { return m_count; }
+
+    // Message thread: cycle is left holding a spare cycle, cleared
+    void post(std::size_t scan, ScanCycle& cycle) {
+        Slot& slot = m_slots[scan];
+        {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            std::swap(slot.cycle, cycle);
+        }
+        slot.ready.store(true, std::memory_order_release);
+        cycle.clear();
+    }
+
+    // Publisher thread: false if nothing was posted since the last take
+    bool take(std::size_t scan, ScanCycle& out) {
+        Slot& slot = m_slots[scan];
+        if (!slot.ready.exchange(false, std::memory_order_acquire)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(slot.mutex);
+        std::swap(slot.cycle, out);
+        return true;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::mutex mutex;
+        ScanCycle cycle;
+        std::atomic<bool> ready{false};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_count;
+};
+
+// Lifetime counters (written by the publisher thread, readable from any thread)
+struct ScanCounters {
+    std::atomic<std::uint64_t> cycles{0};           // Completed scans taken
+    std::atomic<std::uint64_t> unchanged{0};        // Of those, same ranks as the previous cycle (nothing sent)
+    std::atomic<std::uint64_t> published{0};        // Deltas sent
+    std::atomic<std::uint64_t> subscribed{0};       // Entrants handed to the subscribe path
+    std::atomic<std::uint64_t> errors{0};
+};
+
+// Diffs each scan's cycles and sends the changed ranks - a consumer follows a repeated scan from a handful
+// of rows per change instead of the whole list every cycle
+class ScanPublisher {
+public:
+    // subscribe: routes an entrant's subscribe command (connection queue / partition), any thread
+    ScanPublisher(const std::string& uri, ScanOutbox& outbox, ScannerConfig config,
+                  std::function<void(SubscriptionCommand)> subscribe);
+    ~ScanPublisher();
+
+    ScanPublisher(const ScanPublisher&) = delete;
+    ScanPublisher& operator=(const ScanPublisher&) = delete;
+
+    void start();
+    void stop();
+
+    const ScanCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+    void subscribeEntrants(const ScanCycle& cycle, const std::vector<std::size_t>& entrants);
+
+    std::string m_uri;
+    ScanOutbox& m_outbox;
+    ScannerConfig m_config;
+    std::function<void(SubscriptionCommand)> m_subscribe;
+    std::unordered_set<std::string> m_subscribed;   // Entrants already submitted (publisher thread)
+    ScanCounters m_counters;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,79 @@
+// MemoryBudget.h - Byte budgets of the bridge's growable buffers (memory.*), one per subsystem
+// SCOPE: Read at startup (shares handed to each shard / publisher / the gateway); each subsystem measures
+// and enforces its own share on its own thread, the metrics thread sums them
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+// Buffers that grow with load rather than with the configuration
+enum class MemorySubsystem : std::uint8_t {
+    IngestSpill,   // ingest.overflow spill: secondary shard queues (degrade: newest updates dropped)
+    PublishSpill,  // Spill rings parked during a Redis outage (degrade: oldest messages evicted)
+    History,       // Historical bar series buffered until HistoryEnd (degrade: chunks published early, buffers freed)
+    WebSocket,     // Per-connection frame backlogs (degrade: the largest backlog's connection is closed)
+    Count
+};
+
+inline const char* memorySubsystemName(MemorySubsystem subsystem) {
+    switch (subsystem) {
+    case MemorySubsystem::IngestSpill:
+        return "ingest_spill";
+    case MemorySubsystem::PublishSpill:
+        return "publish_spill";
+    case MemorySubsystem::History:
+        return "history";
+    case MemorySubsystem::WebSocket:
+        return "websocket";
+    case MemorySubsystem::Count:
+        break;
+    }
+    return "unknown";
+}
+
+// memory: whole-bridge budgets in MiB, 0 = unbounded (measured and exported only)
+// NOTE: Split evenly across the instances holding the buffers (budgetShare) - per-shard buffers cannot
+// borrow from each other without a shared atomic on their paths
+struct MemoryBudgetConfig {
+    std::size_t ingestSpillMb = 0;
+    std::size_t publishSpillMb = 0;
+    std::size_t historyMb = 0;
+    std::size_t websocketMb = 0;
+
+    std::size_t megabytes(MemorySubsystem subsystem) const {
+        switch (subsystem) {
+        case MemorySubsystem::IngestSpill:
+            return ingestSpillMb;
+        case MemorySubsystem::PublishSpill:
+            return publishSpillMb;
+        case MemorySubsystem::History:
+            return historyMb;
+        case MemorySubsystem::WebSocket:
+            return websocketMb;
+        case MemorySubsystem::Count:
+            break;
+        }
+        return 0;
+    }
+
+    // Whole-bridge budget in bytes (0 = unbounded)
+    std::size_t bytes(MemorySubsystem subsystem) const { return megabytes(subsystem) << 20; }
+};
+
+// One instance's share of a budget (0 stays unbounded, a share is never rounded down to 0)
+inline std::size_t budgetShare(std::size_t budget, std::size_t instances) {
+    if (budget == 0) {
+        return 0;
+    }
+    return std::max<std::size_t>(1, budget / std::max<std::size_t>(1, instances));
+}
+
+inline bool overBudget(std::size_t bytes, std::size_t budget) {
+    return budget != 0 && bytes > budget;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,97 @@
+// MessageFilter.h - Inbound TWS message-id allowlist, checked right after framing
+// SCOPE: Built once at startup, read by the dispatch thread (BridgeReader) for every frame
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <vector>
+
+namespace tws_bridge {
+
+struct MessageFilterConfig {
+    bool enabled = true;
+    std::vector<int> allow;                         // Extra msg ids (EDecoder.h) on top of kBridgeMessageIds
+};
+
+// Inbound ids with a non-empty TwsClient callback (EDecoder.h numbering)
+// PITFALL: A new EWrapper override in TwsClient needs its id here, or its messages are dropped
+constexpr int kBridgeMessageIds[] = {
+    1,    // TICK_PRICE
+    2,    // TICK_SIZE
+    4,    // ERR_MSG
+    7,    // PORTFOLIO_VALUE
+    9,    // NEXT_VALID_ID
+    10,   // CONTRACT_DATA
+    12,   // MARKET_DEPTH
+    13,   // MARKET_DEPTH_L2
+    15,   // MANAGED_ACCTS
+    17,   // HISTORICAL_DATA
+    21,   // TICK_OPTION_COMPUTATION
+    46,   // TICK_STRING
+    50,   // REAL_TIME_BARS
+    52,   // CONTRACT_DATA_END
+    61,   // POSITION_DATA
+    75,   // SECURITY_DEFINITION_OPTION_PARAMETER
+    76,   // SECURITY_DEFINITION_OPTION_PARAMETER_END
+    84,   // TICK_NEWS
+    94,   // PNL
+    95,   // PNL_SINGLE
+    97,   // HISTORICAL_TICKS_BID_ASK
+    98,   // HISTORICAL_TICKS_LAST
+    99,   // TICK_BY_TICK
+    108,  // HISTORICAL_DATA_END
+};
+
+// PERFORMANCE: One bit test per frame - a dropped message is never field-decoded (no atoi/atof,
+// no std::string, no Contract / Order objects) and never reaches EWrapper
+class MessageFilter {
+public:
+    static constexpr int kMaxMsgId = 256;
+    static constexpr int kProtobufOffset = 200;     // PROTOBUF_MSG_ID: protobuf frames carry id + 200
+
+    // Default: every message passes (filter disabled)
+    MessageFilter() = default;
+
+    // kBridgeMessageIds + config.allow, or a pass-all filter when !config.enabled
+    static MessageFilter forBridge(const MessageFilterConfig& config) {
+        MessageFilter filter;
+        if (!config.enabled) {
+            return filter;
+        }
+        filter.m_enabled = true;
+        for (int msgId : kBridgeMessageIds) {
+            filter.allow(msgId);
+        }
+        for (int msgId : config.allow) {
+            filter.allow(msgId);
+        }
+        return filter;
+    }
+
+    void allow(int msgId) {
+        if (msgId >= 0 && msgId < kMaxMsgId) {
+            m_allowed.set(static_cast<std::size_t>(msgId));
+        }
+    }
+
+    // msgId as read off the wire (protobuf ids are mapped back to their EDecoder id)
+    // REASON: Ids beyond the table pass - EDecoder logs what it does not know, nothing is lost silently
+    bool allows(int msgId) const {
+        if (!m_enabled) {
+            return true;
+        }
+        if (msgId > kProtobufOffset) {
+            msgId -= kProtobufOffset;
+        }
+        return msgId < 0 || msgId >= kMaxMsgId || m_allowed.test(static_cast<std::size_t>(msgId));
+    }
+
+    bool enabled() const { return m_enabled; }
+
+private:
+    std::bitset<kMaxMsgId> m_allowed;
+    bool m_enabled = false;
+};
+
+} // namespace tws_bridge
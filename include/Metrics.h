@@ -0,0 +1,148 @@
+// Metrics.h - Hot-path counters + Prometheus text exposition (MetricsServer.h serves it)
+// SCOPE: Counters written by any pipeline thread, aggregated only by the scraping thread
+
+#pragma once
+
+#include "LatencyHistogram.h"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+// Dense per-process thread index for PerThreadCounter slots (assigned on a thread's first increment)
+inline std::size_t metricsThreadIndex() {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+// Counter with one cache line per writing thread, summed when scraped
+// PERFORMANCE: add() is a relaxed RMW on a line no other thread writes (no false sharing, no contention)
+// NOTE: Threads beyond kMaxThreads share slots (still correct, just contended)
+class PerThreadCounter {
+public:
+    static constexpr std::size_t kMaxThreads = 16;
+
+    void add(std::uint64_t n = 1) {
+        m_slots[metricsThreadIndex() % kMaxThreads].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    std::uint64_t value() const {
+        std::uint64_t sum = 0;
+        for (const Slot& slot : m_slots) {
+            sum += slot.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> value{0};
+    };
+    std::array<Slot, kMaxThreads> m_slots{};
+};
+
+// Prometheus text format 0.0.4 builder (scraping thread only)
+// labels: preformatted `key="value",...` without braces ("" = none)
+class PrometheusWriter {
+public:
+    // Default le buckets for LatencyHistogram (seconds): 1 μs ... 1 s
+    static constexpr std::array<std::int64_t, 13> kLatencyBucketsNs{
+        1000, 5000, 10000, 50000, 100000, 500000, 1000000, 5000000, 10000000, 50000000, 100000000,
+        500000000, 1000000000};
+
+    // # HELP / # TYPE once per metric family, before its first sample
+    void family(std::string_view name, std::string_view type, std::string_view help) {
+        m_out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+        m_out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+    }
+
+    void sample(std::string_view name, std::string_view labels, std::uint64_t value) {
+        appendName(name, labels);
+        appendNumber(value);
+        m_out.push_back('\n');
+    }
+
+    void sample(std::string_view name, std::string_view labels, double value) {
+        appendName(name, labels);
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        m_out.append(buffer, result.ptr);
+        m_out.push_back('\n');
+    }
+
+    // Histogram samples (_bucket / _sum / _count) of lifetime nanosecond counts, exported in seconds
+    // NOTE: A le bucket counts source buckets whose upper bound is ≤ le (≤ 1/32 boundary error)
+    void histogram(std::string_view name, std::string_view labels, const LatencySnapshot& snapshot) {
+        std::uint64_t cumulative = 0;
+        double sumNs = 0.0;
+        std::size_t bucket = 0;
+        const std::string bucketName = std::string(name) + "_bucket";
+        for (std::int64_t le : kLatencyBucketsNs) {
+            for (; bucket < LatencySnapshot::kBuckets && LatencySnapshot::bucketUpperBound(bucket) <= le; ++bucket) {
+                cumulative += snapshot.counts[bucket];
+                sumNs += static_cast<double>(snapshot.counts[bucket])
+                    * static_cast<double>(LatencySnapshot::bucketUpperBound(bucket));
+            }
+            appendBucket(bucketName, labels, static_cast<double>(le) / 1e9, cumulative);
+        }
+        for (; bucket < LatencySnapshot::kBuckets; ++bucket) {
+            cumulative += snapshot.counts[bucket];
+            sumNs += static_cast<double>(snapshot.counts[bucket])
+                * static_cast<double>(LatencySnapshot::bucketUpperBound(bucket));
+        }
+        appendName(bucketName, withLabel(labels, "le=\"+Inf\""));
+        appendNumber(cumulative);
+        m_out.push_back('\n');
+        sample(std::string(name) + "_sum", labels, sumNs / 1e9);  // REASON: Bucket upper bounds (HDR-style)
+        sample(std::string(name) + "_count", labels, cumulative);
+    }
+
+    void clear() { m_out.clear(); }
+    const std::string& str() const { return m_out; }
+
+private:
+    void appendName(std::string_view name, std::string_view labels) {
+        m_out.append(name);
+        if (!labels.empty()) {
+            m_out.push_back('{');
+            m_out.append(labels);
+            m_out.push_back('}');
+        }
+        m_out.push_back(' ');
+    }
+
+    void appendNumber(std::uint64_t value) {
+        char buffer[24];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        m_out.append(buffer, result.ptr);
+    }
+
+    void appendBucket(const std::string& name, std::string_view labels, double le, std::uint64_t count) {
+        char buffer[32];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), le);
+        std::string leLabel = "le=\"";
+        leLabel.append(buffer, result.ptr).push_back('"');
+        appendName(name, withLabel(labels, leLabel));
+        appendNumber(count);
+        m_out.push_back('\n');
+    }
+
+    static std::string withLabel(std::string_view labels, std::string_view label) {
+        std::string combined(labels);
+        if (!combined.empty()) {
+            combined.push_back(',');
+        }
+        combined.append(label);
+        return combined;
+    }
+
+    std::string m_out;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,70 @@
+// MetricsServer.h - Embedded HTTP listener for Prometheus scrapes (GET /metrics)
+// SCOPE: Own thread - runs the registered collectors per scrape, never touches the pipeline threads
+
+#pragma once
+
+#include "Metrics.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+struct MetricsServerConfig {
+    std::string bindAddress = "0.0.0.0";
+    std::uint16_t port = 9464;                        // 0 = ephemeral (see MetricsServer::port())
+    std::chrono::milliseconds pollTimeout{100};       // accept() wait per loop (bounds stop() latency)
+    std::chrono::milliseconds ioTimeout{1000};        // Per-connection read / write timeout
+};
+
+// Lifetime counters (written by the server thread, readable from any thread)
+struct MetricsServerCounters {
+    std::atomic<std::uint64_t> scrapes{0};
+    std::atomic<std::uint64_t> rejected{0};           // Not a GET /metrics (404) or unreadable request
+};
+
+// REASON: One connection at a time, Connection: close - a scrape every few seconds needs nothing more
+class MetricsServer {
+public:
+    // Appends one scrape's samples (reads atomics / size_approx only - runs on the server thread)
+    using Collector = std::function<void(PrometheusWriter&)>;
+
+    explicit MetricsServer(MetricsServerConfig config = {});
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // PITFALL: Register every collector before start() - the list is not synchronized
+    void addCollector(Collector collector) { m_collectors.push_back(std::move(collector)); }
+
+    // Binds + listens, false if the socket can't be opened (error logged)
+    bool start();
+    void stop();
+
+    // Bound port (the ephemeral one when configured with 0), 0 before start()
+    std::uint16_t port() const { return m_boundPort.load(std::memory_order_acquire); }
+    const MetricsServerCounters& counters() const { return m_counters; }
+
+    // One scrape's body (exposed for tests)
+    const std::string& render();
+
+private:
+    void run();
+    void serve(int client);
+
+    MetricsServerConfig m_config;
+    std::vector<Collector> m_collectors;
+    PrometheusWriter m_writer;                        // REASON: Reused per scrape (server thread only)
+    MetricsServerCounters m_counters;
+    int m_listenFd = -1;
+    std::atomic<std::uint16_t> m_boundPort{0};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,80 @@
+// MirroredBuffer.h - Ring storage mapped twice back to back (byte i and i + size() alias)
+// SCOPE: BridgeReader receive ring (frames and socket reads never wrap)
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace tws_bridge {
+
+// PERFORMANCE: Any run of up to size() bytes starting anywhere in [0, size()) is contiguous,
+// so a ring never needs a split recv() or a copy for a frame crossing the end
+// PITFALL: Linux memfd + MAP_FIXED - falls back to plain (unmirrored) memory if unavailable,
+// callers must check mirrored() before relying on the alias
+class MirroredBuffer {
+public:
+    // size: power of two, page multiple for the mirror (otherwise plain memory)
+    explicit MirroredBuffer(std::size_t size)
+        : m_size(size) {
+        if (!mapMirror()) {
+            m_plain.reset(new char[size]);
+            m_data = m_plain.get();
+        }
+    }
+
+    ~MirroredBuffer() {
+        if (m_mirrored) {
+            ::munmap(m_data, m_size * 2);
+        }
+    }
+
+    MirroredBuffer(const MirroredBuffer&) = delete;
+    MirroredBuffer& operator=(const MirroredBuffer&) = delete;
+
+    char* data() { return m_data; }
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool mirrored() const { return m_mirrored; }
+
+private:
+    bool mapMirror() {
+        const long page = ::sysconf(_SC_PAGESIZE);
+        if (page <= 0 || m_size == 0 || m_size % static_cast<std::size_t>(page) != 0) {
+            return false;
+        }
+        int fd = ::memfd_create("tws-bridge-ring", MFD_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ::ftruncate(fd, static_cast<off_t>(m_size)) == 0;
+
+        // Reserve 2 * size of address space, then map the same pages into both halves
+        void* base = ok ? ::mmap(nullptr, m_size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) : MAP_FAILED;
+        ok = base != MAP_FAILED;
+        char* bytes = static_cast<char*>(base);
+        if (ok) {
+            ok = ::mmap(bytes, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+                 && ::mmap(bytes + m_size, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+            if (!ok) {
+                ::munmap(base, m_size * 2);
+            }
+        }
+        ::close(fd);  // REASON: Mappings keep the memory alive
+        if (ok) {
+            m_data = bytes;
+            m_mirrored = true;
+        }
+        return ok;
+    }
+
+    const std::size_t m_size;
+    char* m_data = nullptr;
+    bool m_mirrored = false;
+    std::unique_ptr<char[]> m_plain;
+};
+
+} // namespace tws_bridge
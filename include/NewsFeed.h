@@ -0,0 +1,217 @@
+// NewsFeed.h - Broadtape news ticks (tickNews) from the message thread to TWS:NEWS:{SYMBOL}
+// SCOPE: Message threads intern provider codes and enqueue NewsItems, one Redis Worker drains the
+// NewsQueue on its NewsTimer (dedupe, serialize, publish)
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concurrentqueue.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+// news: headlines as they cross, {"type":"news"} on TWS:NEWS:{SYMBOL}
+struct NewsConfig {
+    bool enabled = false;
+    std::vector<std::string> providers = {"BRFG", "BRFUPDN", "DJNL"};  // Subscribed news providers (reqNewsProviders)
+    std::vector<std::string> symbols;               // [] = every startup symbol (subscriptions.symbols)
+    std::chrono::milliseconds interval{250};        // Worker drains the news lane this often
+    std::size_t maxPerPass = 256;                   // Headlines published per drain, the rest waits for the next
+    std::size_t queueLimit = 16384;                 // Headlines waiting in the lane, newer ones are dropped
+    std::size_t dedupeCapacity = 65536;             // Articles remembered per generation (two generations kept)
+};
+
+// reqMktData generic tick list of a news line: "mdoff,292:BRFG+DJNL" (292 = Broadtape news, no quotes)
+inline std::string newsGenericTicks(const std::vector<std::string>& providers) {
+    std::string ticks = "mdoff,292";
+    for (std::size_t i = 0; i < providers.size(); ++i) {
+        ticks += i == 0 ? ':' : '+';
+        ticks += providers[i];
+    }
+    return ticks;
+}
+
+/**
+ * Provider code ↔ small id, shared by every connection (writers) and the draining worker (reader).
+ *
+ * REASON: A handful of providers repeat on every headline - the item carries one byte instead of a string
+ * PERFORMANCE: Lookups scan the published codes without a lock; only a code seen for the first time takes
+ * the mutex (at most kMaxProviders times per process)
+ */
+class ProviderCodes {
+public:
+    static constexpr std::size_t kMaxProviders = 64;
+    static constexpr std::uint8_t kOther = 0xFF;    // Table full: published as "other"
+
+    std::uint8_t intern(std::string_view code) {
+        const std::uint8_t found = find(code, m_count.load(std::memory_order_acquire));
+        if (found != kOther) {
+            return found;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::size_t count = m_count.load(std::memory_order_relaxed);
+        const std::uint8_t again = find(code, count);
+        if (again != kOther || count == kMaxProviders) {
+            return again;
+        }
+        m_codes[count].assign(code.data(), code.size());
+        m_count.store(count + 1, std::memory_order_release);  // REASON: Publishes the string written above
+        return static_cast<std::uint8_t>(count);
+    }
+
+    std::string_view name(std::uint8_t id) const {
+        return id < m_count.load(std::memory_order_acquire) ? std::string_view(m_codes[id]) : std::string_view("other");
+    }
+
+    std::size_t size() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+    std::uint8_t find(std::string_view code, std::size_t count) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (m_codes[i] == code) {
+                return static_cast<std::uint8_t>(i);
+            }
+        }
+        return kOther;
+    }
+
+    std::array<std::string, kMaxProviders> m_codes;  // Written once each, before m_count covers it
+    std::atomic<std::size_t> m_count{0};
+    std::mutex m_mutex;
+};
+
+// One headline as tickNews delivered it
+struct NewsItem {
+    std::string symbol;
+    std::int64_t timestampMs = 0;                   // TWS time of the headline (Unix ms)
+    std::uint8_t provider = ProviderCodes::kOther;
+    std::string articleId;                          // reqNewsArticle key ("BRFG$0b3c1a2d")
+    std::string headline;
+    std::string extraData;                          // Provider metadata ("A:800015:L:en:K:-0.97:C:0.91"), may be ""
+};
+
+// BACKPRESSURE: Bounded by NewsConfig::queueLimit at the producer (size_approx check) - an earnings burst
+// drops the newest headlines, never blocks the message thread or the shard queues
+using NewsQueue = moodycamel::ConcurrentQueue<NewsItem>;
+
+// 64-bit fingerprint of (articleId, symbol): an article tagged with several symbols is news on each channel
+// REASON: FNV-1a + a 64-bit finalizer, as SymbolPartition - stable across runs, spread over the low bits
+inline std::uint64_t articleFingerprint(std::string_view articleId, std::string_view symbol) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto feed = [&hash](std::string_view text) {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+    };
+    feed(articleId);
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+    feed(symbol);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash | 1;  // REASON: 0 marks an empty bucket
+}
+
+/**
+ * Articles already published, as fingerprints in two open-addressing tables (linear probing).
+ *
+ * TWS repeats headlines: every reconnect re-subscribes the news lines and replays the recent ones, and
+ * providers re-send corrected stories under the same id. insert() answers "seen before" from either
+ * generation; when the current one is half full, the older one is cleared and becomes the current.
+ * PERFORMANCE: 8 bytes per article, no per-insert allocation, never rehashed - the newest
+ * `capacity` / 2 articles are always remembered, anything older may be published again
+ * SCOPE: Draining worker only
+ */
+class ArticleFilter {
+public:
+    explicit ArticleFilter(std::size_t capacity = 65536) {
+        std::size_t buckets = 16;
+        while (buckets < capacity) {
+            buckets <<= 1;
+        }
+        m_mask = buckets - 1;
+        m_tables[0].assign(buckets, 0);
+        m_tables[1].assign(buckets, 0);
+    }
+
+    // true if fingerprint is new (now remembered), false for a duplicate
+    bool insert(std::uint64_t fingerprint) {
+        if (contains(m_tables[m_current ^ 1], fingerprint)) {
+            return false;
+        }
+        std::vector<std::uint64_t>& table = m_tables[m_current];
+        for (std::size_t i = fingerprint & m_mask;; i = (i + 1) & m_mask) {
+            if (table[i] == fingerprint) {
+                return false;
+            }
+            if (table[i] == 0) {
+                table[i] = fingerprint;
+                break;
+            }
+        }
+        if (++m_size * 2 > table.size()) {
+            m_current ^= 1;
+            std::fill(m_tables[m_current].begin(), m_tables[m_current].end(), 0);
+            m_size = 0;
+        }
+        return true;
+    }
+
+private:
+    bool contains(const std::vector<std::uint64_t>& table, std::uint64_t fingerprint) const {
+        for (std::size_t i = fingerprint & m_mask; table[i] != 0; i = (i + 1) & m_mask) {
+            if (table[i] == fingerprint) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<std::uint64_t> m_tables[2];
+    std::size_t m_current = 0;
+    std::size_t m_size = 0;                         // Entries in m_tables[m_current]
+    std::size_t m_mask = 0;
+};
+
+// Lifetime counters (written by the message thread / the draining worker, readable from any thread)
+struct alignas(64) NewsCounters {
+    std::atomic<std::uint64_t> received{0};         // tickNews callbacks on a news line
+    std::atomic<std::uint64_t> dropped{0};          // Lane full (queueLimit)
+    std::atomic<std::uint64_t> duplicates{0};       // Article already published on the symbol's channel
+    std::atomic<std::uint64_t> published{0};
+};
+
+// The lane between the message threads and the draining worker (main-owned, outlives both)
+struct NewsLane {
+    explicit NewsLane(const NewsConfig& config) : config(config) {}
+
+    // Message thread: false (counted) when the lane is full
+    bool push(NewsItem&& item) {
+        counters.received.fetch_add(1, std::memory_order_relaxed);
+        if (queue.size_approx() >= config.queueLimit) {
+            counters.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue.enqueue(std::move(item));
+        return true;
+    }
+
+    const NewsConfig config;
+    NewsQueue queue;
+    ProviderCodes providers;
+    NewsCounters counters;
+};
+
+} // namespace tws_bridge
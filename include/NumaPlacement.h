@@ -0,0 +1,63 @@
+// NumaPlacement.h - NUMA node lookup and page migration (no libnuma dependency)
+// SCOPE: Thread start-up (RedisWorker::run after pinning) and placement reports - never on the tick path
+
+#pragma once
+
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace tws_bridge {
+
+// Node of the CPU the calling thread runs on (-1 if unknown)
+inline int currentNumaNode() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    return ::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? static_cast<int>(node) : -1;
+}
+
+// Memory nodes of this machine (1 on single-socket boxes or without /sys)
+inline int numaNodeCount() {
+    int count = 0;
+    if (DIR* dir = ::opendir("/sys/devices/system/node")) {
+        while (const dirent* entry = ::readdir(dir)) {
+            count += std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9';
+        }
+        ::closedir(dir);
+    }
+    return count > 0 ? count : 1;
+}
+
+// Node holding the page at addr, -1 if not faulted in yet or not queryable
+// NOTE: move_pages / mbind need CAP_SYS_NICE under the default Docker seccomp profile
+inline int numaNodeOf(const void* addr) {
+    const std::uintptr_t pageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    void* page = reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(addr) & ~(pageSize - 1));
+    int status = -1;
+    if (::syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) != 0) {
+        return -1;
+    }
+    return status >= 0 ? status : -1;
+}
+
+// Moves the whole pages inside [addr, addr + bytes) to node, and prefers node for their later faults
+// Returns false if the range holds no whole page, node is out of range or the kernel refused
+// PITFALL: Policy is per page - never pass memory whose pages another thread's hot data shares
+inline bool migrateToNumaNode(const void* addr, std::size_t bytes, int node) {
+    constexpr int kMaxNodes = 64;  // One nodemask word
+    const std::uintptr_t pageSize = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t begin = (reinterpret_cast<std::uintptr_t>(addr) + pageSize - 1) & ~(pageSize - 1);
+    const std::uintptr_t end = (reinterpret_cast<std::uintptr_t>(addr) + bytes) & ~(pageSize - 1);
+    if (node < 0 || node >= kMaxNodes || end <= begin) {
+        return false;
+    }
+    const unsigned long nodemask = 1UL << node;
+    // REASON: PREFERRED, not BIND - a full node falls back to another one instead of failing allocations
+    return ::syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, &nodemask, kMaxNodes + 1, MPOL_MF_MOVE) == 0;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,137 @@
+// OptionChain.h - Option chain layout (reqSecDefOptParams), leg selection / numbering and the layout cache
+// SCOPE: Message thread (chain subscribe, secdef callbacks) - cold path only; the worker side is GreeksChain.h
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tws_bridge {
+
+// One securityDefinitionOptionalParameter row: what is listed for the underlying on one exchange
+struct OptionChainLayout {
+    std::string exchange;                           // "SMART" preferred (chainRowRank)
+    std::string tradingClass;                       // e.g. "SPY" (weeklies may list under another class)
+    std::string multiplier;                         // "100"
+    std::vector<std::string> expirations;           // YYYYMMDD, ascending
+    std::vector<double> strikes;                    // Ascending, union over every expiration
+    std::int64_t resolvedAt = 0;                    // Epoch seconds of the answer
+};
+
+// TWS answers one row per exchange / trading class - the SMART row of the underlying's own class wins
+inline int chainRowRank(std::string_view exchange, std::string_view tradingClass, std::string_view symbol) {
+    return (exchange == "SMART" ? 2 : 0) + (tradingClass == symbol ? 1 : 0);
+}
+
+// Part of a chain to stream (TWS:COMMANDS "expiries" / "minStrike" / "maxStrike")
+struct ChainRequest {
+    int expiries = 1;                               // Nearest N expirations not yet expired
+    double minStrike = 0.0;                         // 0 = unbounded
+    double maxStrike = 0.0;                         // 0 = unbounded
+};
+
+// REASON: Every leg is one reqMktData line - a runaway strike range must not queue thousands of requests
+inline constexpr std::size_t kMaxChainLegs = 4096;
+
+// Streamed legs: expirations x strikes x {call, put}
+// leg = (expiry x strikes + strike) x 2 + put - dense, so the worker's table is a flat array (GreeksChain.h)
+struct ChainSelection {
+    std::vector<std::string> expirations;
+    std::vector<double> strikes;
+
+    std::size_t legCount() const { return expirations.size() * strikes.size() * 2; }
+    std::uint32_t leg(std::size_t expiry, std::size_t strike, bool put) const {
+        return static_cast<std::uint32_t>((expiry * strikes.size() + strike) * 2 + (put ? 1 : 0));
+    }
+    const std::string& expiryOf(std::uint32_t leg) const { return expirations[leg / 2 / strikes.size()]; }
+    double strikeOf(std::uint32_t leg) const { return strikes[leg / 2 % strikes.size()]; }
+    static bool isPut(std::uint32_t leg) { return (leg & 1) != 0; }
+};
+
+// "20261120" → 20261120, 0 if not 8 digits
+inline std::uint32_t expiryCode(std::string_view expiry) {
+    if (expiry.size() != 8) {
+        return 0;
+    }
+    std::uint32_t code = 0;
+    for (char c : expiry) {
+        if (c < '0' || c > '9') {
+            return 0;
+        }
+        code = code * 10 + static_cast<std::uint32_t>(c - '0');
+    }
+    return code;
+}
+
+// UTC date of an epoch-seconds time as YYYYMMDD
+inline std::uint32_t expiryCodeOn(std::time_t time) {
+    std::tm utc{};
+    gmtime_r(&time, &utc);
+    return static_cast<std::uint32_t>((utc.tm_year + 1900) * 10000 + (utc.tm_mon + 1) * 100 + utc.tm_mday);
+}
+
+// Nearest request.expiries expirations on or after today (YYYYMMDD), strikes inside the requested range
+// NOTE: Strikes are the union over all expirations - a leg TWS does not list answers error 200 and is dropped
+inline ChainSelection selectChain(const OptionChainLayout& layout, const ChainRequest& request, std::uint32_t today) {
+    ChainSelection selection;
+    const std::size_t wanted = static_cast<std::size_t>(request.expiries > 0 ? request.expiries : 1);
+    for (const std::string& expiry : layout.expirations) {
+        if (selection.expirations.size() == wanted) {
+            break;
+        }
+        if (expiryCode(expiry) >= today) {
+            selection.expirations.push_back(expiry);
+        }
+    }
+    for (double strike : layout.strikes) {
+        if ((request.minStrike <= 0.0 || strike >= request.minStrike)
+            && (request.maxStrike <= 0.0 || strike <= request.maxStrike)) {
+            selection.strikes.push_back(strike);
+        }
+    }
+    return selection;
+}
+
+// reqSecDefOptParams answers by underlying symbol, kept for the process lifetime
+// PERFORMANCE: A chain re-subscribed (or a second chain on the same underlying) starts its legs at once -
+// no paced secdef round trip, which for a large underlying is a multi-KB answer
+// NOTE: Listings change at most daily (new weeklies, strikes added on big moves) - entries past
+// kChainMaxAge are looked up again
+class OptionChainCache {
+public:
+    static constexpr std::chrono::hours kChainMaxAge{12};
+
+    // false on a miss or a stale entry (now in epoch seconds)
+    bool find(const std::string& symbol, std::int64_t now, OptionChainLayout& out) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = m_layouts.find(symbol);
+        if (it == m_layouts.end() || now - it->second.resolvedAt > std::chrono::seconds(kChainMaxAge).count()) {
+            return false;
+        }
+        out = it->second;
+        return true;
+    }
+
+    void store(const std::string& symbol, OptionChainLayout layout) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_layouts[symbol] = std::move(layout);
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_layouts.size();
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, OptionChainLayout> m_layouts;
+};
+
+} // namespace tws_bridge
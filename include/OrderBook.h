@@ -0,0 +1,109 @@
+// OrderBook.h - Fixed-depth L2 order book (updateMktDepth / updateMktDepthL2)
+// SCOPE: Redis Worker thread - one book per slot, built from TickUpdateType::Depth updates
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+// TWS depth semantics (EWrapper::updateMktDepth)
+namespace depth {
+constexpr int kInsert = 0;   // operation: new level at position, deeper levels shift down
+constexpr int kUpdate = 1;   // operation: replace level at position
+constexpr int kDelete = 2;   // operation: remove level at position, deeper levels shift up
+constexpr int kReset = 3;    // Bridge-only: TWS reset the depth stream (error 317), both sides cleared
+constexpr int kAsk = 0;      // side
+constexpr int kBid = 1;
+} // namespace depth
+
+struct DepthLevel {
+    double price = 0.0;
+    std::int64_t size = 0;
+};
+
+// One side: contiguous levels, best first
+// PERFORMANCE: Fixed array (no allocation, 4 levels per cache line), O(depth) shifts
+class DepthSide {
+public:
+    static constexpr std::size_t kMaxLevels = 20;  // REASON: reqMktDepth numRows is capped well below this
+
+    // Applies one TWS operation, false if rejected (position out of range, unknown operation)
+    bool apply(std::size_t position, int operation, double price, std::int64_t size) {
+        switch (operation) {
+        case depth::kInsert:
+            if (position > m_count || position >= kMaxLevels) {
+                return false;
+            }
+            if (m_count == kMaxLevels) {
+                --m_count;  // REASON: Deepest level falls off, TWS would send its delete next
+            }
+            for (std::size_t i = m_count; i > position; --i) {
+                m_levels[i] = m_levels[i - 1];
+            }
+            m_levels[position] = DepthLevel{price, size};
+            ++m_count;
+            return true;
+        case depth::kUpdate:
+            if (position >= m_count) {
+                // NOTE: TWS may update the first empty row instead of inserting it
+                if (position != m_count || position >= kMaxLevels) {
+                    return false;
+                }
+                ++m_count;
+            }
+            m_levels[position] = DepthLevel{price, size};
+            return true;
+        case depth::kDelete:
+            if (position >= m_count) {
+                return false;
+            }
+            for (std::size_t i = position + 1; i < m_count; ++i) {
+                m_levels[i - 1] = m_levels[i];
+            }
+            --m_count;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void clear() { m_count = 0; }
+    std::size_t size() const { return m_count; }
+    const DepthLevel& operator[](std::size_t position) const { return m_levels[position]; }
+
+private:
+    std::array<DepthLevel, kMaxLevels> m_levels{};
+    std::size_t m_count = 0;
+};
+
+// Bid + ask sides of one instrument
+struct OrderBook {
+    DepthSide bids;
+    DepthSide asks;
+    std::int64_t timestamp = 0;  // Last applied update (ms)
+
+    // side: depth::kBid / depth::kAsk (anything else rejected, except for depth::kReset)
+    bool apply(int side, std::size_t position, int operation, double price, std::int64_t size) {
+        if (operation == depth::kReset) {
+            clear();
+            return true;
+        }
+        if (side == depth::kBid) {
+            return bids.apply(position, operation, price, size);
+        }
+        if (side == depth::kAsk) {
+            return asks.apply(position, operation, price, size);
+        }
+        return false;
+    }
+
+    void clear() {
+        bids.clear();
+        asks.clear();
+    }
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,119 @@
+// ParquetWriter.h - Minimal dependency-free Apache Parquet file writer (flat schema, required columns)
+// SCOPE: One thread per writer - offline export (JournalExport.h), never on the live pipeline
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// Subset of Parquet written here: uncompressed, one data page per column chunk, no nulls
+// REASON: pyarrow / pandas / polars / DuckDB read it natively; no Arrow or Thrift build dependency
+enum class ParquetType : std::uint8_t {
+    Boolean,
+    Int32,
+    Int64,
+    Double,
+    String      // BYTE_ARRAY, UTF8
+};
+
+enum class ParquetEncoding : std::uint8_t {
+    Plain,
+    Delta,      // DELTA_BINARY_PACKED - Int64 only (timestamps: a few bits per row instead of 64)
+    Dictionary  // Dictionary page + RLE_DICTIONARY indices - String only
+};
+
+// Int64 annotated as a UTC timestamp
+enum class ParquetTimeUnit : std::uint8_t {
+    None,
+    Millis,
+    Nanos
+};
+
+struct ParquetColumnSpec {
+    std::string name;
+    ParquetType type = ParquetType::Int64;
+    ParquetEncoding encoding = ParquetEncoding::Plain;
+    ParquetTimeUnit timeUnit = ParquetTimeUnit::None;
+};
+
+// Values of one column for the row group being built
+class ParquetColumn {
+public:
+    explicit ParquetColumn(ParquetColumnSpec spec) : m_spec(std::move(spec)) {}
+
+    void append(std::int64_t value) { m_ints.push_back(value); }    // Boolean / Int32 / Int64
+    void append(double value) { m_doubles.push_back(value); }       // Double
+    void append(std::string_view value);                            // String (dictionary index)
+
+    std::size_t size() const;
+    void clear();
+
+    const ParquetColumnSpec& spec() const { return m_spec; }
+
+private:
+    friend class ParquetWriter;
+
+    ParquetColumnSpec m_spec;
+    std::vector<std::int64_t> m_ints;                 // Values, or dictionary indices for String
+    std::vector<double> m_doubles;
+    std::vector<std::string> m_dictionary;            // Per row group (column chunk)
+    std::unordered_map<std::string, std::uint32_t> m_lookup;
+    std::uint32_t m_lastIndex = 0;                    // PERFORMANCE: Runs of one value skip the hash lookup
+};
+
+// Buffers rows column by column and appends them as row groups; close() writes the footer
+// NOTE: The file is opened per flush (created by the first one) - thousands of writers hold no descriptors
+// PITFALL: The file is only readable once close() succeeded (Parquet metadata lives in the footer)
+class ParquetWriter {
+public:
+    ParquetWriter(std::string path, const std::vector<ParquetColumnSpec>& schema);
+
+    ParquetColumn& column(std::size_t index) { return m_columns[index]; }
+    std::size_t columnCount() const { return m_columns.size(); }
+    std::size_t bufferedRows() const { return m_columns.empty() ? 0 : m_columns.front().size(); }
+
+    // Buffered rows → one row group (no-op when empty), false on I/O error or ragged columns
+    bool flush();
+    // flush() + footer (key/value pairs land in the file metadata), false on I/O error
+    bool close(const std::vector<std::pair<std::string, std::string>>& metadata = {});
+
+    const std::string& path() const { return m_path; }
+    std::uint64_t rows() const { return m_rows; }
+    std::size_t rowGroups() const { return m_rowGroups.size(); }
+
+private:
+    struct ChunkMeta {
+        std::uint64_t numValues = 0;
+        std::uint64_t dictionaryOffset = 0;           // 0 = no dictionary page
+        std::uint64_t dataOffset = 0;
+        std::uint64_t bytes = 0;                      // Page headers included
+        bool hasStats = false;
+        std::int64_t min = 0;
+        std::int64_t max = 0;
+    };
+
+    struct RowGroupMeta {
+        std::uint64_t rows = 0;
+        std::uint64_t offset = 0;
+        std::uint64_t bytes = 0;
+        std::vector<ChunkMeta> chunks;
+    };
+
+    bool append(const std::string& bytes);
+
+    std::string m_path;
+    std::vector<ParquetColumn> m_columns;
+    std::vector<RowGroupMeta> m_rowGroups;
+    std::uint64_t m_offset = 0;                       // File size so far
+    std::uint64_t m_rows = 0;
+    bool m_failed = false;
+};
+
+} // namespace tws_bridge
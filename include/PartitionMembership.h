@@ -0,0 +1,74 @@
+// PartitionMembership.h - Bridge instances splitting the symbol set (Redis membership ZSET + heartbeats)
+// SCOPE: Own thread + own Redis connection; hands member lists to SymbolPartition
+
+#pragma once
+
+#include "SymbolPartition.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+// partition: N bridges (own IB logins / hosts) each subscribe ~1/N of the symbols, publishing the same
+// channel names - consumers cannot tell which instance a symbol comes from
+struct PartitionConfig {
+    bool enabled = false;
+    std::string membersKey = "TWS:MEMBERS";          // ZSET: instance id -> last heartbeat (Unix ms)
+    std::string universeKey = "TWS:UNIVERSE";        // HASH: symbol -> TWS:COMMANDS payload
+    std::string id;                                  // "" = hostname:pid (defaultInstanceId)
+    std::chrono::milliseconds heartbeat{1000};       // Heartbeat + member list read period
+    std::chrono::milliseconds memberTimeout{5000};   // A silent member's symbols move after this
+    std::chrono::milliseconds socketTimeout{200};
+};
+
+// Lifetime counters (written by the membership thread, readable from any thread)
+struct PartitionCounters {
+    std::atomic<std::uint64_t> heartbeats{0};
+    std::atomic<std::uint64_t> rebalances{0};        // Member list changes applied
+    std::atomic<std::uint64_t> moved{0};             // Subscribes + cancels enqueued by rebalances
+    std::atomic<std::uint64_t> errors{0};
+};
+
+// Each heartbeat is one pipelined round trip: ZADD self, ZREMRANGEBYSCORE (members silent for
+// memberTimeout), ZRANGE - and the owner's pending TWS:UNIVERSE writes
+// A changed member list reads the universe (HGETALL) and rebalances: only the symbols whose owner
+// changed are subscribed / cancelled
+// PITFALL: Heartbeats are Unix ms of each host - clocks must agree (NTP) well within memberTimeout
+// PITFALL: For up to one heartbeat after a join, a moved symbol can be subscribed on both instances
+// (the new owner subscribes at once, the old one cancels at its next heartbeat) - duplicate snapshots,
+// never a gap
+class PartitionMembership {
+public:
+    PartitionMembership(const std::string& uri, SymbolPartition& partition, PartitionConfig config);
+    ~PartitionMembership();
+
+    PartitionMembership(const PartitionMembership&) = delete;
+    PartitionMembership& operator=(const PartitionMembership&) = delete;
+
+    // First heartbeat on the calling thread, so the startup symbols are split before they are submitted
+    // False if Redis is unreachable (logged) - the instance then owns everything until a heartbeat succeeds
+    bool join();
+    void start();
+    // Leaves the ZSET (ZREM) - the others take this instance's symbols at their next heartbeat
+    void stop();
+
+    const PartitionCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+    void applyMembers(std::vector<std::string> members, std::vector<UniverseEntry> learned);
+
+    std::string m_uri;
+    SymbolPartition& m_partition;
+    PartitionConfig m_config;
+    PartitionCounters m_counters;
+    std::vector<std::string> m_members;              // Last applied list (membership thread)
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,134 @@
+// PayloadPool.h - Pooled, reference-counted blocks holding encoded snapshots for every consumer at once
+// SCOPE: Worker thread stores (one open block at a time); any thread holding a reference releases it
+// (Redis I/O thread, sink threads)
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <concurrentqueue.h>
+
+namespace tws_bridge {
+
+class PayloadPool;
+
+// Snapshots stored back to back; back in the pool once the worker moved on and the last holder released it
+class PayloadBlock {
+public:
+    void retain() { m_refs.fetch_add(1, std::memory_order_relaxed); }
+    inline void release();
+
+    PayloadBlock(const PayloadBlock&) = delete;
+    PayloadBlock& operator=(const PayloadBlock&) = delete;
+
+private:
+    friend class PayloadPool;
+
+    PayloadBlock(PayloadPool& pool, std::size_t capacity)
+        : m_pool(pool)
+        , m_bytes(new char[capacity])
+        , m_capacity(capacity) {
+    }
+
+    PayloadPool& m_pool;
+    std::unique_ptr<char[]> m_bytes;
+    std::size_t m_capacity;
+    std::size_t m_used = 0;                         // Worker thread, while the block is open
+    std::atomic<std::uint32_t> m_refs{0};
+};
+
+// One stored payload: its bytes and the block keeping them alive
+// NOTE: Valid while the block is open or referenced - consumers keep it with BatchArena::reference()
+struct SharedPayload {
+    std::string_view bytes;
+    PayloadBlock* block = nullptr;
+};
+
+// ARCHITECTURE: A snapshot is stored once and handed as a view to every consumer (Redis PUBLISH / SET / XADD,
+// sink batches); each consumer batch takes one reference per block it touches, not per payload, and drops
+// them when its batch is sent or delivered
+// PERFORMANCE: store() is a bump copy; blocks are recycled through a lock-free queue, so the steady state
+// allocates nothing - a new block is only allocated while every pooled one is still held
+class PayloadPool {
+public:
+    explicit PayloadPool(std::size_t blockBytes = 64 * 1024, std::size_t blocks = 8)
+        : m_blockBytes(blockBytes > 0 ? blockBytes : 1)
+        , m_free(blocks) {
+        for (std::size_t i = 0; i < blocks; ++i) {
+            m_free.enqueue(allocate(m_blockBytes));
+        }
+    }
+
+    // PITFALL: Every reference must be released first - the owner destroys the pool after its consumers
+    ~PayloadPool() {
+        if (m_open) {
+            m_open->release();
+        }
+    }
+
+    PayloadPool(const PayloadPool&) = delete;
+    PayloadPool& operator=(const PayloadPool&) = delete;
+
+    // ========== Worker thread ==========
+    SharedPayload store(std::string_view data) {
+        if (!m_open || m_open->m_capacity - m_open->m_used < data.size()) {
+            open(data.size());
+        }
+        char* bytes = m_open->m_bytes.get() + m_open->m_used;
+        std::memcpy(bytes, data.data(), data.size());
+        m_open->m_used += data.size();
+        m_stored.store(m_stored.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return SharedPayload{std::string_view(bytes, data.size()), m_open};
+    }
+
+    // ========== Any thread ==========
+    std::size_t blocks() const { return m_count.load(std::memory_order_relaxed); }
+    std::uint64_t stored() const { return m_stored.load(std::memory_order_relaxed); }
+
+private:
+    friend class PayloadBlock;
+
+    void open(std::size_t length) {
+        if (m_open) {
+            m_open->release();  // NOTE: The worker's own reference - holders keep the block until they are done
+        }
+        PayloadBlock* block = nullptr;
+        if (!m_free.try_dequeue(block) || block->m_capacity < length) {
+            if (block) {
+                m_free.enqueue(block);  // REASON: Too small for an oversized payload, still fine for the rest
+            }
+            block = allocate(length > m_blockBytes ? length : m_blockBytes);
+        }
+        block->m_used = 0;
+        block->m_refs.store(1, std::memory_order_relaxed);
+        m_open = block;
+    }
+
+    PayloadBlock* allocate(std::size_t capacity) {
+        m_blocks.push_back(std::unique_ptr<PayloadBlock>(new PayloadBlock(*this, capacity)));
+        m_count.store(m_blocks.size(), std::memory_order_relaxed);
+        return m_blocks.back().get();
+    }
+
+    void recycle(PayloadBlock* block) { m_free.enqueue(block); }
+
+    std::size_t m_blockBytes;
+    std::vector<std::unique_ptr<PayloadBlock>> m_blocks;  // Worker thread: owns every block
+    moodycamel::ConcurrentQueue<PayloadBlock*> m_free;    // Releasing threads → worker
+    PayloadBlock* m_open = nullptr;                 // Being filled, holds the worker's reference
+    std::atomic<std::size_t> m_count{0};
+    std::atomic<std::uint64_t> m_stored{0};
+};
+
+inline void PayloadBlock::release() {
+    if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_pool.recycle(this);
+    }
+}
+
+} // namespace tws_bridge
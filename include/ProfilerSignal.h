@@ -0,0 +1,118 @@
+// ProfilerSignal.h - Which bridge threads SIGPROF may interrupt
+// SCOPE: main() blocks it before the first thread starts (every thread inherits the block); the threads
+// below unblock it for themselves and are the only ones the SamplingProfiler arms a timer for
+//
+// Profiled (every blocking call audited to retry EINTR or restart under SA_RESTART):
+//   tws-msg-N    processMessages (EReaderOSSignal condvar, BridgeReader eventfd poll), reconnect back-off
+//   tws-reader   BridgeReader's socket poll and non-blocking receive
+//   tws-worker-N WaitStrategy park (ShardReactor epoll, semaphore), RedisPublisher without an I/O thread
+//   tws-redis-io WaitStrategy park, hiredis pipeline reads / writes (hiredis retries EINTR itself)
+// Everything else keeps it blocked - the vendored EReader's select disconnects on EINTR, and the servers'
+// poll loops, the command listener and the third-party threads were never audited
+// PITFALL: A profiled thread that calls into unaudited code holds a ProfilerSignalBlock around it -
+// eConnect (its handshake select) and every redis++ call that can open a connection (hiredis' connect
+// poll fails on EINTR); threads started inside the block (EReader::start) inherit the block
+
+#pragma once
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace tws_bridge {
+
+// A thread the profiler samples: its kernel tid (signal target) and its CPU-time clock (timer base)
+struct ProfiledThread {
+    std::int32_t tid = 0;
+    clockid_t clock{};
+};
+
+namespace profiler_detail {
+
+inline std::mutex g_mutex;
+inline std::vector<ProfiledThread> g_threads;       // Guarded by g_mutex
+
+// Drops the calling thread from the profiled set when it exits
+struct Enrollment {
+    std::int32_t tid = 0;
+    ~Enrollment() {
+        if (tid == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_threads.erase(std::remove_if(g_threads.begin(), g_threads.end(),
+                                       [this](const ProfiledThread& thread) { return thread.tid == tid; }),
+                        g_threads.end());
+    }
+};
+
+inline thread_local Enrollment t_enrollment;
+
+} // namespace profiler_detail
+
+// Blocks SIGPROF in the calling thread - main() calls it first, threads created later inherit it
+inline void blockProfilerSignal() {
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPROF);
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+}
+
+// Unblocks SIGPROF in the calling thread and adds it to the profiled set (until the thread exits)
+// Returns false if the thread has no CPU-time clock (it is then never sampled)
+// NOTE: Takes effect with the next profile - a profile already running keeps the threads it started with
+inline bool profileCurrentThread() {
+    profiler_detail::Enrollment& enrollment = profiler_detail::t_enrollment;
+    if (enrollment.tid != 0) {
+        return true;
+    }
+    ProfiledThread thread;
+    if (pthread_getcpuclockid(pthread_self(), &thread.clock) != 0) {
+        return false;
+    }
+    thread.tid = static_cast<std::int32_t>(syscall(SYS_gettid));
+    {
+        std::lock_guard<std::mutex> lock(profiler_detail::g_mutex);
+        profiler_detail::g_threads.push_back(thread);
+    }
+    enrollment.tid = thread.tid;
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPROF);
+    pthread_sigmask(SIG_UNBLOCK, &set, nullptr);
+    return true;
+}
+
+// Snapshot of the profiled set (the profiler arms one timer per entry)
+inline std::vector<ProfiledThread> profiledThreads() {
+    std::lock_guard<std::mutex> lock(profiler_detail::g_mutex);
+    return profiler_detail::g_threads;
+}
+
+// Holds SIGPROF off the calling thread for this scope, restores its mask on exit
+// NOTE: A tick that fires inside stays pending and is delivered (sampled) when the scope ends
+// PERFORMANCE: Two pthread_sigmask calls - for connect paths, never per message or per batch
+class ProfilerSignalBlock {
+public:
+    ProfilerSignalBlock() {
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGPROF);
+        pthread_sigmask(SIG_BLOCK, &set, &m_previous);
+    }
+    ~ProfilerSignalBlock() { pthread_sigmask(SIG_SETMASK, &m_previous, nullptr); }
+
+    ProfilerSignalBlock(const ProfilerSignalBlock&) = delete;
+    ProfilerSignalBlock& operator=(const ProfilerSignalBlock&) = delete;
+
+private:
+    sigset_t m_previous;
+};
+
+} // namespace tws_bridge
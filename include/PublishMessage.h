@@ -0,0 +1,139 @@
+// PublishMessage.h - Pipelined Redis command model + bounded spill ring of owned copies
+// SCOPE: Worker (buffers views), Redis sending thread (pipelines them, spills while the circuit is open)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+// Pipelined command kinds (one pending slot each)
+enum class RedisCommand : std::uint8_t {
+    Publish,    // PUBLISH channel payload
+    StreamAdd,  // XADD key MAXLEN ~ N * data payload
+    Set,        // SET key payload (last-value cache)
+    SortedSetAdd,  // ZREMRANGEBYSCORE key score score + ZADD key score payload (one member per score)
+    SortedSetTrim,  // ZREMRANGEBYSCORE key -inf (score (drop members scored below)
+    HashSet,    // HSET key field value [field value ...] (payload: "field\nvalue\nfield\nvalue")
+    TimeSeriesAdd,  // TS.MADD key timestamp value [...] (payload: "key\ntimestamp\nvalue\n...", no channel)
+    ListPush    // LPUSH key element [...] + LTRIM key 0 score-1 (payload: "element\nelement\n...", oldest first)
+};
+
+// Calls fn(part) for each '\n'-separated part of a HashSet / TimeSeriesAdd payload (fields and values alternate)
+// NOTE: Parts are field names and formatted numbers / symbols - never contain a newline themselves; a value
+// may be empty ("conditions\n" = empty conditions), an empty payload has no parts
+template <typename Fn>
+inline std::size_t forEachHashPart(std::string_view payload, Fn&& fn) {
+    if (payload.empty()) {
+        return 0;
+    }
+    std::size_t parts = 0;
+    std::size_t start = 0;
+    for (;;) {
+        const std::size_t end = payload.find('\n', start);
+        fn(payload.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+        ++parts;
+        if (end == std::string_view::npos) {
+            return parts;
+        }
+        start = end + 1;
+    }
+}
+
+// Channel (or key) + payload pair for batched publishing
+// NOTE: Views - buffered messages point into the pending batch's BatchArena, or a pooled payload block it
+// references (valid until it is sent)
+struct PublishMessage {
+    std::string_view channel;
+    std::string_view payload;
+    RedisCommand command = RedisCommand::Publish;
+    double score = 0.0;                             // SortedSetAdd / SortedSetTrim, ListPush: elements kept
+};
+
+// Messages parked while Redis is unreachable, replayed in order once it is back
+// BACKPRESSURE: Fixed slot count - a full ring evicts the oldest (the newest state matters most)
+// PERFORMANCE: Slot strings keep their capacity, a warm ring copies without allocating
+class SpillRing {
+public:
+    explicit SpillRing(std::size_t capacity) : m_slots(capacity) {}
+
+    SpillRing(const SpillRing&) = delete;
+    SpillRing& operator=(const SpillRing&) = delete;
+
+    // Copies the message in, returns true if the oldest one was evicted to make room
+    // (capacity 0: nothing is kept, always true)
+    bool push(const PublishMessage& message) {
+        if (m_slots.empty()) {
+            return true;
+        }
+        const bool evict = m_count == m_slots.size();
+        if (evict) {
+            pop(1);
+        }
+        Slot& slot = m_slots[(m_head + m_count) % m_slots.size()];
+        slot.channel.assign(message.channel.data(), message.channel.size());
+        slot.payload.assign(message.payload.data(), message.payload.size());
+        slot.command = message.command;
+        slot.score = message.score;
+        m_bytes += slot.channel.size() + slot.payload.size();
+        ++m_count;
+        return evict;
+    }
+
+    // Evicts the oldest messages until the parked bytes fit budget, freeing their slots' buffers
+    // Returns the number evicted
+    // REASON: Freed, not kept for reuse - a budget breach means the retained capacity itself is the problem
+    std::size_t trim(std::size_t budget) {
+        std::size_t evicted = 0;
+        while (m_count > 0 && m_bytes > budget) {
+            Slot& slot = m_slots[m_head];
+            pop(1);
+            std::string().swap(slot.channel);
+            std::string().swap(slot.payload);
+            ++evicted;
+        }
+        return evicted;
+    }
+
+    // i-th oldest parked message (i < size()), views valid until it is popped or overwritten
+    PublishMessage at(std::size_t i) const {
+        const Slot& slot = m_slots[(m_head + i) % m_slots.size()];
+        return PublishMessage{slot.channel, slot.payload, slot.command, slot.score};
+    }
+
+    // Drops the n oldest
+    void pop(std::size_t n) {
+        n = n < m_count ? n : m_count;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Slot& slot = m_slots[(m_head + i) % m_slots.size()];
+            m_bytes -= slot.channel.size() + slot.payload.size();
+        }
+        m_head = m_slots.empty() ? 0 : (m_head + n) % m_slots.size();
+        m_count -= n;
+    }
+
+    std::size_t size() const { return m_count; }
+    // Channel + payload bytes of the parked messages
+    std::size_t bytes() const { return m_bytes; }
+    bool empty() const { return m_count == 0; }
+    std::size_t capacity() const { return m_slots.size(); }
+
+private:
+    struct Slot {
+        std::string channel;
+        std::string payload;
+        RedisCommand command = RedisCommand::Publish;
+        double score = 0.0;
+    };
+
+    std::vector<Slot> m_slots;
+    std::size_t m_head = 0;
+    std::size_t m_count = 0;
+    std::size_t m_bytes = 0;
+};
+
+} // namespace tws_bridge
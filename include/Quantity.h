@@ -0,0 +1,177 @@
+// Quantity.h - Scaled-integer sizes: units * 10^-scale, decoded from the wire text without Decimal or double
+// SCOPE: TwsClient / TickByTickDecoder (decode), Redis Worker (InstrumentState sizes), snapshot encoders (text)
+
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+// Finest size kept - 10^-8 (crypto); finer wire digits are rounded half away from zero
+inline constexpr int kMaxQuantityScale = 8;
+
+// REASON: Fractional FX / crypto / odd-lot sizes stay exact - whole shares (llround) dropped the fraction
+// NOTE: scale is the number of decimal places; 0 for every integral size (US equities)
+struct Quantity {
+    std::int64_t units = 0;
+    int scale = 0;
+};
+
+namespace quantity_detail {
+
+inline constexpr std::int64_t kPow10[] = {1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+                                          100000000LL, 1000000000LL, 10000000000LL, 100000000000LL,
+                                          1000000000000LL, 10000000000000LL, 100000000000000LL,
+                                          1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+                                          1000000000000000000LL};
+
+} // namespace quantity_detail
+
+// units at scale from → units at scale to: exact when to >= from (saturating at int64), rounded half away
+// from zero otherwise
+inline std::int64_t rescaleUnits(std::int64_t units, int from, int to) {
+    if (to == from) {
+        return units;
+    }
+    if (to > from) {
+        const std::int64_t factor = quantity_detail::kPow10[to - from];
+        const std::int64_t limit = std::numeric_limits<std::int64_t>::max() / factor;
+        if (units > limit || units < -limit) {
+            return units > 0 ? std::numeric_limits<std::int64_t>::max() : std::numeric_limits<std::int64_t>::min();
+        }
+        return units * factor;
+    }
+    const std::int64_t divisor = quantity_detail::kPow10[from - to];
+    const std::int64_t quotient = units / divisor;
+    const std::int64_t remainder = units % divisor;
+    if (remainder * 2 >= divisor) {
+        return quotient + 1;
+    }
+    if (remainder * 2 <= -divisor) {
+        return quotient - 1;
+    }
+    return quotient;
+}
+
+// Rounded to whole units (volume aggregates, bar / profile / mover analytics)
+inline std::int64_t wholeUnits(Quantity quantity) {
+    return rescaleUnits(quantity.units, quantity.scale, 0);
+}
+
+inline double quantityToDouble(Quantity quantity) {
+    return static_cast<double>(quantity.units) / static_cast<double>(quantity_detail::kPow10[quantity.scale]);
+}
+
+// "digits[.digits]" → units at the fewest decimal places that hold it ("1.50" → 15 at scale 1)
+// false for anything else (sign, exponent, empty, more than 18 significant digits) - the libbid fallback's
+// PERFORMANCE: One pass over the field, integer multiply-adds only
+inline bool parseQuantity(std::string_view text, Quantity& out) {
+    const std::size_t dot = text.find('.');
+    std::string_view whole = text.substr(0, dot);
+    std::string_view fraction = dot == std::string_view::npos ? std::string_view() : text.substr(dot + 1);
+    while (!fraction.empty() && fraction.back() == '0') {
+        fraction.remove_suffix(1);
+    }
+    if (whole.empty() && fraction.empty() && (dot == std::string_view::npos || text.size() == 1)) {
+        return false;  // REASON: "" and "." are not numbers ("0." / ".0" are)
+    }
+    std::size_t skipped = 0;
+    while (skipped < whole.size() && whole[skipped] == '0') {
+        ++skipped;
+    }
+    whole.remove_prefix(skipped);
+    const std::size_t kept = fraction.size() < std::size_t{kMaxQuantityScale} ? fraction.size()
+                                                                                : std::size_t{kMaxQuantityScale};
+    if (whole.size() + kept > 18) {
+        return false;
+    }
+    std::int64_t units = 0;
+    for (char c : whole) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        units = units * 10 + (c - '0');
+    }
+    for (std::size_t i = 0; i < fraction.size(); ++i) {
+        const char c = fraction[i];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        if (i < kept) {
+            units = units * 10 + (c - '0');
+        } else if (i == kept && c >= '5') {
+            ++units;  // NOTE: Past kMaxQuantityScale - rounded on the first dropped digit
+        }
+    }
+    out.units = units;
+    out.scale = static_cast<int>(kept);
+    return true;
+}
+
+// Narrows two sizes of one scale into 32-bit tick payload fields, dropping decimal places only when one would
+// not fit (saturating at scale 0) - returns the scale the two are left at
+// NOTE: At its own scale a size loses nothing below 2^31 units - ten significant digits
+inline int narrowQuantities(std::int64_t& first, std::int64_t& second, int scale) {
+    constexpr std::int64_t kLimit = std::numeric_limits<std::int32_t>::max();
+    auto fits = [&]() { return first <= kLimit && first >= -kLimit && second <= kLimit && second >= -kLimit; };
+    while (!fits() && scale > 0) {
+        first = rescaleUnits(first, scale, scale - 1);
+        second = rescaleUnits(second, scale, scale - 1);
+        --scale;
+    }
+    if (!fits()) {
+        first = first > kLimit ? kLimit : first < -kLimit ? -kLimit : first;
+        second = second > kLimit ? kLimit : second < -kLimit ? -kLimit : second;
+    }
+    return scale;
+}
+
+// Longest quantity text: sign, 19 digits, '.', "0." padding of a scale-8 value below one
+inline constexpr std::size_t kQuantityMaxChars = 24;
+
+// JSON number text: "100", "0.5", "-1.25" - trailing fraction zeros dropped, so a whole value prints as an
+// integer at every scale (scale 0 output is unchanged)
+inline char* writeQuantity(char* out, Quantity quantity) {
+    std::uint64_t magnitude = static_cast<std::uint64_t>(quantity.units);
+    if (quantity.units < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;  // REASON: Well-defined for INT64_MIN
+    }
+    int scale = quantity.scale;
+    while (scale > 0 && magnitude % 10 == 0) {
+        magnitude /= 10;
+        --scale;
+    }
+    char digits[20];
+    const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), magnitude);
+    const int length = static_cast<int>(result.ptr - digits);
+    if (scale == 0) {
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        return out + length;
+    }
+    if (length <= scale) {
+        *out++ = '0';
+        *out++ = '.';
+        std::memset(out, '0', static_cast<std::size_t>(scale - length));
+        out += scale - length;
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        return out + length;
+    }
+    std::memcpy(out, digits, static_cast<std::size_t>(length - scale));
+    out += length - scale;
+    *out++ = '.';
+    std::memcpy(out, digits + length - scale, static_cast<std::size_t>(scale));
+    return out + scale;
+}
+
+inline void appendQuantity(std::string& out, Quantity quantity) {
+    char text[kQuantityMaxChars];
+    out.append(text, static_cast<std::size_t>(writeQuantity(text, quantity) - text));
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,81 @@
+// QueryServer.h - Point-in-time snapshot lookups over a Unix datagram socket, answered from the QuoteTable
+// SCOPE: Own thread - reads the QuoteTable and the registry, never touches the pipeline threads
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "QuoteTable.h"
+#include "Serialization.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace tws_bridge {
+
+// query: "current price of X" without subscribing to everything or polling Redis
+struct QueryConfig {
+    bool enabled = false;
+    std::string socketPath = "/tmp/tws-bridge-query.sock";  // AF_UNIX SOCK_DGRAM, replaced on start
+    std::chrono::milliseconds pollTimeout{100};     // recv wait per loop (bounds stop() latency)
+};
+
+// Snapshot layout of the replies (the worker's TWS:TICKS settings)
+struct QueryEncoding {
+    SnapshotSchema schema = SnapshotSchema::Verbose;
+    PriceFormat prices = PriceFormat::Shortest;
+    bool withIsoTime = false;
+};
+
+// Lifetime counters (written by the server thread, readable from any thread)
+struct QueryCounters {
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> found{0};            // Symbols answered with a snapshot
+    std::atomic<std::uint64_t> missed{0};           // Unknown symbols or no data yet (null)
+};
+
+// Request: one datagram of symbols separated by spaces / commas ("AAPL MSFT"), at most kMaxSymbols
+// Reply: one datagram, a JSON array in request order - each the symbol's TWS:TICKS snapshot (no "derived")
+// or null
+// ARCHITECTURE: No TWS request and no Redis round trip - the reply is encoded from the workers' last
+// published state (QuoteTable seqlock read), so a lookup costs two datagrams and one encode per symbol
+// PITFALL: Datagram clients must bind their own address (e.g. Linux autobind) to receive the reply
+class QueryServer {
+public:
+    static constexpr std::size_t kMaxSymbols = 64;
+
+    QueryServer(const InstrumentRegistry& registry, const QuoteTable& quotes, QueryConfig config,
+                QueryEncoding encoding = {});
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    // Binds the socket, false if it can't be opened (error logged)
+    bool start();
+    void stop();
+
+    const QueryCounters& counters() const { return m_counters; }
+
+    // Reply for one request (exposed for tests)
+    const std::string& answer(std::string_view request);
+
+private:
+    void run();
+
+    const InstrumentRegistry& m_registry;
+    const QuoteTable& m_quotes;
+    QueryConfig m_config;
+    QueryEncoding m_encoding;
+    QueryCounters m_counters;
+    InstrumentState m_state;                        // REASON: Reused per answer (server thread only)
+    JsonBuffer m_json;
+    std::string m_reply;
+    int m_fd = -1;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
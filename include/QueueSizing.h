@@ -0,0 +1,206 @@
+// QueueSizing.h - Shard queue occupancy telemetry and the capacity it calls for (ingest.sizing)
+// SCOPE: QueueOccupancy is written by the shard's worker and read by any thread (metrics, main);
+// the recommendation and its file are main thread only (start-up and shutdown)
+
+#pragma once
+
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace tws_bridge {
+
+// ingest.sizing: replaces the guessed ingest.queue_capacity with one measured against this deployment's
+// bursts and Redis stalls
+struct QueueSizingConfig {
+    bool enabled = false;                           // Track occupancy, recommend a capacity at shutdown
+    bool adopt = false;                             // Start with the saved recommendation, not queue_capacity
+    std::string path = "queue-sizing.txt";          // Recommendation written at shutdown ("" = logged only)
+    double stallPercentile = 99.99;                 // Redis round trip the queue must absorb at peak rate
+    double headroom = 1.5;                          // Multiplier on the covered backlog
+    std::size_t minCapacity = 1024;
+    std::size_t maxCapacity = std::size_t{1} << 22;
+};
+
+/**
+ * Backlog of one shard queue as its worker sees it: high-water mark, backlog per dequeue, how long the
+ * queue stayed non-empty (a burst), and the peak arrival rate over one-second windows.
+ *
+ * REASON: Arrivals are derived on the consumer side (dequeued + backlog change per window) - the
+ * producer's enqueue path stays untouched
+ * PERFORMANCE: One size_approx() and one clock read per dequeued batch, never per tick; plain
+ * load + store updates (single writer), like LatencyHistogram
+ * NOTE: Depth and burst histograms reuse LatencyHistogram's log-linear buckets (updates / ns)
+ */
+class QueueOccupancy {
+public:
+    // Worker: a batch of `dequeued` updates left `remaining` in the queue
+    void sample(std::size_t dequeued, std::size_t remaining, std::int64_t nowNs) {
+        const std::size_t backlog = dequeued + remaining;
+        if (backlog > m_highWater.load(std::memory_order_relaxed)) {
+            m_highWater.store(backlog, std::memory_order_relaxed);
+        }
+        m_depth.record(static_cast<std::int64_t>(backlog));
+
+        // Burst: from the first batch that could not empty the queue to the first one that did
+        if (remaining > 0 && m_burstStartNs == 0) {
+            m_burstStartNs = nowNs;
+        } else if (remaining == 0 && m_burstStartNs != 0) {
+            m_bursts.record(nowNs - m_burstStartNs);
+            m_burstStartNs = 0;
+        }
+
+        if (m_windowStartNs == 0) {
+            m_windowStartNs = nowNs;
+            m_windowStartRemaining = remaining;
+            return;
+        }
+        m_windowDequeued += dequeued;
+        const std::int64_t elapsedNs = nowNs - m_windowStartNs;
+        if (elapsedNs >= kWindowNs) {
+            // REASON: Arrivals = what left + what piled up - a stall shows its arrival rate, not the drain rate after
+            const double arrivals = static_cast<double>(m_windowDequeued) + static_cast<double>(remaining)
+                                  - static_cast<double>(m_windowStartRemaining);
+            const double rate = std::max(arrivals, 0.0) * 1e9 / static_cast<double>(elapsedNs);
+            if (rate > m_peakRate.load(std::memory_order_relaxed)) {
+                m_peakRate.store(rate, std::memory_order_relaxed);
+            }
+            m_windowStartNs = nowNs;
+            m_windowStartRemaining = remaining;
+            m_windowDequeued = 0;
+        }
+    }
+
+    std::size_t highWater() const { return m_highWater.load(std::memory_order_relaxed); }
+    // Updates per second, busiest one-second window so far
+    double peakRate() const { return m_peakRate.load(std::memory_order_relaxed); }
+    // Backlog per dequeued batch (updates)
+    void depth(LatencySnapshot& out) const { m_depth.snapshot(out); }
+    // Completed bursts (ns)
+    void bursts(LatencySnapshot& out) const { m_bursts.snapshot(out); }
+
+private:
+    static constexpr std::int64_t kWindowNs = 1000000000;
+
+    std::atomic<std::size_t> m_highWater{0};
+    std::atomic<double> m_peakRate{0.0};
+    LatencyHistogram m_depth;
+    LatencyHistogram m_bursts;
+    // Worker-private
+    std::int64_t m_burstStartNs = 0;
+    std::int64_t m_windowStartNs = 0;
+    std::size_t m_windowStartRemaining = 0;
+    std::uint64_t m_windowDequeued = 0;
+};
+
+// Smallest power of two covering max(peak rate × stall, observed high water) × headroom, clamped to
+// [minCapacity, maxCapacity]
+// REASON: Powers of two - SpscRing rounds up to one anyway, moodycamel preallocates 32-slot blocks
+inline std::size_t recommendQueueCapacity(double peakRate, std::int64_t stallNs, std::size_t highWater,
+                                          const QueueSizingConfig& config) {
+    const double stallBacklog = peakRate * static_cast<double>(std::max<std::int64_t>(stallNs, 0)) / 1e9;
+    const double covered = std::max(stallBacklog, static_cast<double>(highWater)) * config.headroom;
+    const double wanted = std::min(std::ceil(covered), static_cast<double>(config.maxCapacity));
+    std::size_t capacity = 1;
+    while (static_cast<double>(capacity) < wanted) {
+        capacity <<= 1;
+    }
+    return std::clamp(capacity, config.minCapacity, config.maxCapacity);
+}
+
+// One shard's evidence and the capacity it calls for (logged at shutdown, written to the sizing file)
+struct QueueSizingReport {
+    std::size_t shard = 0;
+    std::size_t configured = 0;                     // Capacity this run started with
+    std::size_t highWater = 0;
+    std::int64_t depthP99 = 0;                      // Backlog per dequeue (updates)
+    std::int64_t burstP99Ns = 0;
+    std::int64_t burstMaxNs = 0;
+    double peakRate = 0.0;                          // Updates per second
+    std::int64_t stallNs = 0;                       // Redis round trip at stallPercentile
+    std::size_t recommended = 0;
+};
+
+inline QueueSizingReport summarizeQueueSizing(std::size_t shard, std::size_t configured,
+                                              const QueueOccupancy& occupancy, const LatencySnapshot& roundTrips,
+                                              const QueueSizingConfig& config) {
+    QueueSizingReport report;
+    report.shard = shard;
+    report.configured = configured;
+    report.highWater = occupancy.highWater();
+    report.peakRate = occupancy.peakRate();
+    report.stallNs = roundTrips.valueAt(config.stallPercentile);
+    LatencySnapshot snapshot;
+    occupancy.depth(snapshot);
+    report.depthP99 = snapshot.valueAt(99.0);
+    occupancy.bursts(snapshot);
+    report.burstP99Ns = snapshot.valueAt(99.0);
+    report.burstMaxNs = snapshot.max();
+    report.recommended = recommendQueueCapacity(report.peakRate, report.stallNs, report.highWater, config);
+    return report;
+}
+
+// File: "queue_capacity N" plus one "# shard ..." comment line of evidence per shard
+// Missing file = nothing to adopt (true, capacity unchanged); false (error says why) on a malformed file
+inline bool loadQueueCapacity(const std::string& path, std::size_t& capacity, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        return true;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string key;
+        unsigned long long value = 0;
+        if (!(fields >> key >> value) || key != "queue_capacity" || value == 0) {
+            error = path + ": expected \"queue_capacity N\"";
+            return false;
+        }
+        capacity = static_cast<std::size_t>(value);
+        return true;
+    }
+    error = path + ": no queue_capacity line";
+    return false;
+}
+
+// Writes path.tmp, then renames it over path (a crash never leaves a truncated file)
+inline bool saveQueueCapacity(const std::string& path, std::size_t capacity, const QueueSizingReport* reports,
+                              std::size_t count, std::string& error) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc);
+        if (!out) {
+            error = temporary + ": cannot open";
+            return false;
+        }
+        out << "# tws-redis-bridge ingest.sizing recommendation (ingest.sizing.adopt: true starts with it)\n";
+        for (std::size_t i = 0; i < count; ++i) {
+            const QueueSizingReport& report = reports[i];
+            out << "# shard " << report.shard << ": configured " << report.configured << ", high water "
+                << report.highWater << ", peak " << static_cast<std::uint64_t>(report.peakRate) << "/s, stall "
+                << report.stallNs / 1000 << " us, burst p99 " << report.burstP99Ns / 1000 << " us\n";
+        }
+        out << "queue_capacity " << capacity << '\n';
+        if (!out.flush()) {
+            error = temporary + ": write failed";
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        error = path + ": rename failed";
+        return false;
+    }
+    return true;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,63 @@
+// QuoteBatch.h - Drops the quotes of a drain batch that a later quote of the same slot overwrites
+// SCOPE: Redis Worker thread (one reducer per worker, sized to the registry capacity)
+
+#pragma once
+
+#include "MarketData.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tws_bridge {
+
+// Group-by-slot over one batch: a BidAsk is kept only if no later BidAsk of its slot follows it
+// PERFORMANCE:
+// - One backward pass, O(batch) - slots are dense 16-bit ids, so a generation-stamped table replaces a
+//   sort (no clearing between batches, no reordering across slots)
+// - The kept updates are compacted in place, so a burst of N quotes on one symbol costs one state apply
+// PITFALL: Only valid while quotes are conflated - each dropped quote would otherwise have been its own
+// snapshot. A trade that publishes on its own (ConflationConfig::publishTradesIndividually) reads the
+// quote of its moment, so it fences: quotes before it are not superseded by quotes after it
+class QuoteBatchReducer {
+public:
+    QuoteBatchReducer() = default;
+    explicit QuoteBatchReducer(std::size_t slots) : m_covered(slots, 0) {}
+
+    std::size_t slots() const { return m_covered.size(); }
+
+    // Compacts batch[0, count): the kept updates end up in batch[first, count) in their original order.
+    // Returns first - the number of quotes dropped
+    std::size_t reduce(TickUpdate* batch, std::size_t count, bool tradesFence) {
+        if (++m_generation == 0) {
+            // REASON: Wrapped - a stamp from 2^32 batches ago must not read as "covered"
+            std::fill(m_covered.begin(), m_covered.end(), 0);
+            m_generation = 1;
+        }
+        std::size_t first = count;
+        for (std::size_t i = count; i-- > 0;) {
+            const TickUpdate& update = batch[i];
+            if (update.slot < m_covered.size()) {
+                std::uint32_t& covered = m_covered[update.slot];
+                if (update.type == TickUpdateType::BidAsk && !update.backfilled()) {
+                    if (covered == m_generation) {
+                        continue;  // Overwritten by a later quote of the slot
+                    }
+                    covered = m_generation;
+                } else if (tradesFence && update.type == TickUpdateType::AllLast) {
+                    covered = 0;
+                }
+            }
+            if (--first != i) {
+                batch[first] = update;
+            }
+        }
+        return first;
+    }
+
+private:
+    std::vector<std::uint32_t> m_covered;  // == m_generation: a later quote of this batch follows
+    std::uint32_t m_generation = 0;
+};
+
+} // namespace tws_bridge
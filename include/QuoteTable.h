@@ -0,0 +1,160 @@
+// QuoteTable.h - Latest state of every slot, readable from any thread without locks
+// SCOPE: Written by the Redis workers (each only its own slots, once per drain batch), read by the
+// query endpoint (QueryServer.h)
+
+#pragma once
+
+#include "MarketData.h"
+#include "TradeCodes.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace tws_bridge {
+
+// What a point-in-time lookup answers with - the snapshot's fields without the derived metrics
+struct QuoteRecord {
+    double bidPrice;
+    double askPrice;
+    double lastPrice;
+    std::int64_t quoteTimestamp;
+    std::int64_t tradeTimestamp;
+    std::int64_t receiveNs;
+    std::uint64_t tradeConditions;
+    std::uint64_t sequence;                         // Last published "seq"
+    std::int64_t bidSize;                           // Units at sizeScale (Quantity.h)
+    std::int64_t askSize;
+    std::int64_t lastSize;
+    std::int32_t conId;
+    ExchangeCode primaryExchange;
+    ExchangeCode exchange;
+    bool hasQuote;
+    bool hasTrade;
+    bool pastLimit;
+    std::uint8_t sizeScale;
+    std::uint8_t reserved[2];                       // REASON: Whole 64-bit words (copied word-wise)
+};
+
+static_assert(std::is_trivially_copyable_v<QuoteRecord>, "QuoteRecord is copied word-wise");
+static_assert(sizeof(QuoteRecord) % 8 == 0, "QuoteRecord copied as whole 64-bit words");
+
+inline QuoteRecord makeQuoteRecord(const InstrumentState& state) {
+    QuoteRecord record{};
+    record.bidPrice = state.bidPrice;
+    record.askPrice = state.askPrice;
+    record.lastPrice = state.lastPrice;
+    record.quoteTimestamp = state.quoteTimestamp;
+    record.tradeTimestamp = state.tradeTimestamp;
+    record.receiveNs = state.receiveNs;
+    record.tradeConditions = state.tradeConditions;
+    record.sequence = state.sequence;
+    record.bidSize = state.bidSize;
+    record.askSize = state.askSize;
+    record.lastSize = state.lastSize;
+    record.sizeScale = state.sizeScale;
+    record.conId = state.conId;
+    record.primaryExchange = exchangeCode(state.primaryExchange);
+    record.exchange = exchangeCode(state.exchange);
+    record.hasQuote = state.hasQuote;
+    record.hasTrade = state.hasTrade;
+    record.pastLimit = state.pastLimit;
+    return record;
+}
+
+// Fills the record's fields of state (symbol / tickerId are the caller's)
+inline void restoreQuoteRecord(const QuoteRecord& record, InstrumentState& state) {
+    state.bidPrice = record.bidPrice;
+    state.askPrice = record.askPrice;
+    state.lastPrice = record.lastPrice;
+    state.quoteTimestamp = static_cast<long>(record.quoteTimestamp);
+    state.tradeTimestamp = static_cast<long>(record.tradeTimestamp);
+    state.receiveNs = record.receiveNs;
+    state.tradeConditions = record.tradeConditions;
+    state.sequence = record.sequence;
+    state.bidSize = record.bidSize;
+    state.askSize = record.askSize;
+    state.lastSize = record.lastSize;
+    state.sizeScale = record.sizeScale;
+    state.conId = record.conId;
+    state.primaryExchange = exchangeName(record.primaryExchange);
+    state.exchange = exchangeName(record.exchange);
+    state.hasQuote = record.hasQuote;
+    state.hasTrade = record.hasTrade;
+    state.pastLimit = record.pastLimit;
+}
+
+// One seqlock'd record per registry slot
+// PERFORMANCE:
+// - Writer never waits (two seq stores around a word copy), readers retry only if they raced a write
+// - One cache-line-aligned entry per slot - a read never shares a line with another slot's writes
+// PITFALL: One writer per slot at a time (the slot's owning worker)
+class QuoteTable {
+public:
+    explicit QuoteTable(std::size_t capacity)
+        : m_capacity(capacity)
+        , m_entries(new Entry[capacity]) {
+    }
+
+    QuoteTable(const QuoteTable&) = delete;
+    QuoteTable& operator=(const QuoteTable&) = delete;
+
+    std::size_t capacity() const { return m_capacity; }
+
+    // Owning worker thread only
+    void write(std::size_t slot, const QuoteRecord& record) {
+        if (slot >= m_capacity) {
+            return;
+        }
+        std::uint64_t words[kWords];
+        std::memcpy(words, &record, sizeof(record));
+        Entry& entry = m_entries[slot];
+        const std::uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+        entry.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) {
+            entry.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        entry.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Any thread; false if the slot was never written
+    bool read(std::size_t slot, QuoteRecord& out) const {
+        if (slot >= m_capacity) {
+            return false;
+        }
+        const Entry& entry = m_entries[slot];
+        std::uint64_t words[kWords];
+        std::uint32_t before = 0;
+        std::uint32_t after = 0;
+        do {
+            before = entry.seq.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < kWords; ++i) {
+                words[i] = entry.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = entry.seq.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+        if (before == 0) {
+            return false;
+        }
+        std::memcpy(&out, words, sizeof(out));
+        return true;
+    }
+
+private:
+    static constexpr std::size_t kWords = sizeof(QuoteRecord) / 8;
+
+    // REASON: Word-wise atomics make the seqlock copy race-free (no torn reads are ever used)
+    struct alignas(64) Entry {
+        std::atomic<std::uint32_t> seq{0};          // 0 = never written, odd = being written
+        std::atomic<std::uint64_t> words[kWords] = {};
+    };
+
+    const std::size_t m_capacity;
+    std::unique_ptr<Entry[]> m_entries;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,46 @@
+// ReconnectBackoff.h - Exponential back-off between TWS reconnect attempts (spec §5.5)
+// SCOPE: Message thread (BasicTwsClient::reconnect), after the socket is lost
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+namespace tws_bridge {
+
+struct ReconnectPolicy {
+    bool enabled = true;                              // false: a lost connection stops the bridge (old behavior)
+    std::chrono::milliseconds initialDelay{250};      // First attempt - a Gateway restart is usually back in 1-3 s
+    std::chrono::milliseconds maxDelay{30000};        // Doubling stops here
+    std::size_t maxAttempts = 0;                      // 0 = retry until shutdown
+};
+
+// Delay before each attempt: initialDelay, 2x, 4x, ... capped at maxDelay
+class ReconnectBackoff {
+public:
+    explicit ReconnectBackoff(ReconnectPolicy policy) : m_policy(policy), m_delay(policy.initialDelay) {}
+
+    // Delay to wait before the next attempt (counts the attempt)
+    std::chrono::milliseconds next() {
+        const std::chrono::milliseconds delay = std::min(m_delay, m_policy.maxDelay);
+        ++m_attempts;
+        m_delay = std::min(m_delay * 2, m_policy.maxDelay);
+        return delay;
+    }
+
+    bool exhausted() const { return m_policy.maxAttempts != 0 && m_attempts >= m_policy.maxAttempts; }
+    std::size_t attempts() const { return m_attempts; }
+
+    void reset() {
+        m_attempts = 0;
+        m_delay = m_policy.initialDelay;
+    }
+
+private:
+    ReconnectPolicy m_policy;
+    std::chrono::milliseconds m_delay;
+    std::size_t m_attempts = 0;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,129 @@
+// RedisFunction.h - Server-side batch writes: the tws_bridge Redis Function library (FUNCTION LOAD) and the
+// FCALL arguments that replace a batch's PUBLISH / SET / XADD commands
+// SCOPE: Redis sending thread (worker, or the I/O thread when enabled)
+
+#pragma once
+
+#include "PublishMessage.h"
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+constexpr const char* kBridgeFunctionName = "tws_publish";
+
+// FCALL tws_publish numkeys key... maxlen approx ops channel payload [ops channel payload ...]
+// ops: one letter per command of a snapshot, in batch order - P = PUBLISH channel, S = SET and X = XADD of the
+// next key (KEYS are consumed in order); payload is sent once for all of them
+// NOTE: Loaded with FUNCTION LOAD REPLACE - a new bridge version replaces the library of the previous one
+constexpr const char* kBridgeFunctionLibrary = R"LUA(#!lua name=tws_bridge
+local function publish(keys, args)
+  local maxlen = tonumber(args[1])
+  local approx = args[2] == '1'
+  local k = 1
+  for i = 3, #args, 3 do
+    local ops, channel, payload = args[i], args[i + 1], args[i + 2]
+    for j = 1, #ops do
+      local op = string.byte(ops, j)
+      if op == 80 then
+        redis.call('PUBLISH', channel, payload)
+      elseif op == 83 then
+        redis.call('SET', keys[k], payload)
+        k = k + 1
+      elseif maxlen <= 0 then
+        redis.call('XADD', keys[k], '*', 'data', payload)
+        k = k + 1
+      elseif approx then
+        redis.call('XADD', keys[k], 'MAXLEN', '~', maxlen, '*', 'data', payload)
+        k = k + 1
+      else
+        redis.call('XADD', keys[k], 'MAXLEN', maxlen, '*', 'data', payload)
+        k = k + 1
+      end
+    end
+  end
+  return k - 1
+end
+redis.register_function('tws_publish', publish)
+)LUA";
+
+// Builds one FCALL from a run of PUBLISH / SET / XADD messages
+// PERFORMANCE: Adjacent messages carrying the same stored payload (PayloadPool: one snapshot's PUBLISH, XADD
+// and SET reference the same bytes) become one group - the snapshot crosses the wire and is parsed once
+// instead of once per command, and Redis parses one command per batch instead of three per snapshot
+// NOTE: Groups only form from identical views, never by comparing bytes - a compressed stream payload or a
+// separately encoded one stays its own group
+class FunctionBatch {
+public:
+    // Publish / Set / StreamAdd can go into the function (sharded Pub/Sub needs SPUBLISH, kept out)
+    static bool fusable(const PublishMessage& message) {
+        return message.command == RedisCommand::Publish || message.command == RedisCommand::Set
+            || message.command == RedisCommand::StreamAdd;
+    }
+
+    // Arguments of the FCALL covering messages[0, count) (every one fusable), views valid until the next build
+    const std::vector<std::string_view>& build(const PublishMessage* messages, std::size_t count, long long maxLen,
+                                               bool approximate) {
+        m_keys.clear();
+        m_values.clear();
+        m_ops.clear();
+        m_ops.reserve(count);  // REASON: No reallocation below - argument views point into the entries
+        const PublishMessage* group = nullptr;
+        std::size_t letters = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const PublishMessage& message = messages[i];
+            const char op = message.command == RedisCommand::Publish ? 'P'
+                          : message.command == RedisCommand::Set ? 'S' : 'X';
+            const bool joins = group && letters < kMaxOps && message.payload.data() == group->payload.data()
+                            && message.payload.size() == group->payload.size()
+                            && (op != 'P' || m_values[m_values.size() - 2].empty());
+            if (!joins) {
+                m_ops.emplace_back();
+                letters = 0;
+                group = &message;
+                m_values.emplace_back();
+                m_values.emplace_back();  // Channel, set by the group's PUBLISH ("" if none)
+                m_values.push_back(message.payload);
+            }
+            m_ops.back()[letters++] = op;
+            m_values[m_values.size() - 3] = std::string_view(m_ops.back().data(), letters);
+            if (op == 'P') {
+                m_values[m_values.size() - 2] = message.channel;
+            } else {
+                m_keys.push_back(message.channel);
+            }
+        }
+        m_args.clear();
+        m_args.push_back("FCALL");
+        m_args.push_back(kBridgeFunctionName);
+        m_args.push_back(format(m_numKeys, static_cast<long long>(m_keys.size())));
+        m_args.insert(m_args.end(), m_keys.begin(), m_keys.end());
+        m_args.push_back(format(m_maxLen, maxLen));
+        m_args.push_back(approximate ? "1" : "0");
+        m_args.insert(m_args.end(), m_values.begin(), m_values.end());
+        return m_args;
+    }
+
+    std::size_t groups() const { return m_ops.size(); }
+
+private:
+    static constexpr std::size_t kMaxOps = 8;       // Commands per group (a snapshot issues at most 3)
+    using Number = std::array<char, 24>;
+
+    static std::string_view format(Number& out, long long value) {
+        const std::to_chars_result result = std::to_chars(out.data(), out.data() + out.size(), value);
+        return std::string_view(out.data(), static_cast<std::size_t>(result.ptr - out.data()));
+    }
+
+    std::vector<std::array<char, kMaxOps>> m_ops;   // By group
+    std::vector<std::string_view> m_keys;
+    std::vector<std::string_view> m_values;         // ops, channel, payload per group
+    std::vector<std::string_view> m_args;
+    Number m_numKeys{};
+    Number m_maxLen{};
+};
+
+} // namespace tws_bridge
@@ -3,35 +3,307 @@
 
 #pragma once
 
+#include "BatchArena.h"
+#include "CircuitBreaker.h"
+#include "ClusterSlots.h"
+#include "LatencyHistogram.h"
+#include "PayloadPool.h"
+#include "PublishMessage.h"
+#include "RedisFunction.h"
+#include "RedisUri.h"
+#include "RespConnection.h"
+#include "ThreadAffinity.h"
+#include "WaitStrategy.h"
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <concurrentqueue.h>
 #include <sw/redis++/redis++.h>
 
 namespace tws_bridge {
 
+// Outcome of a publish / pipeline (no exceptions on the publish path)
+enum class PublishStatus : std::uint8_t {
+    Ok,
+    Failed,       // Redis raised (connection, timeout, error reply) - counted, logged at most once a second
+    CircuitOpen   // Not attempted - Redis is failing, the messages were spilled (SpillRing) or dropped
+};
+
+// REASON: Flush pending messages when EITHER limit is reached
+struct BatchPolicy {
+    std::size_t maxMessages = 64;                   // Size limit (messages per pipeline)
+    std::chrono::microseconds maxDelay{500};        // Time limit (age of oldest pending message)
+};
+
+// Redis Streams output (XADD), consumers resume from an entry ID via consumer groups
+struct StreamPolicy {
+    long long maxLen = 10000;                       // Per-stream entry cap
+    bool approximate = true;                        // PERFORMANCE: MAXLEN ~ trims whole macro nodes (cheap)
+};
+
+// Dedicated Redis I/O thread: worker only buffers, round trips happen off the aggregation thread
+// REASON: A Redis stall (e.g. RDB fork) must not block aggregation and back up the tick queue
+struct IoThreadPolicy {
+    bool enabled = false;
+    std::size_t maxInFlightBatches = 16;            // Backpressure bound (batches queued to I/O thread)
+    ThreadConfig thread;                            // I/O thread placement
+};
+
+// Redis outage handling: fail fast instead of a timeout + error per batch, park recent messages meanwhile
+struct OutagePolicy {
+    CircuitBreakerPolicy breaker;
+    std::size_t spillCapacity = 4096;               // Messages parked while open (oldest evicted), 0 = drop
+    std::size_t spillBudget = 0;                    // Bytes parked (memory.publish_spill_mb share), 0 = unbounded
+};
+
+// Lifetime counters (readable from any thread)
+// REASON: Own cache line - the metrics thread's reads never pull the sending thread's state along
+struct alignas(64) PublisherCounters {
+    std::atomic<std::uint64_t> sent{0};             // Messages written by successful pipelines
+    std::atomic<std::uint64_t> failed{0};           // Messages in pipelines that raised an error
+    std::atomic<std::uint64_t> dropped{0};          // Backpressure: I/O thread backlog full
+    std::atomic<std::uint64_t> errors{0};           // Pipelines that raised (each counts its messages in failed)
+    std::atomic<std::uint64_t> reconnects{0};       // Successful reconnect() calls
+    std::atomic<std::uint64_t> circuitOpens{0};     // Closed / HalfOpen → Open transitions
+    std::atomic<std::uint64_t> spilled{0};          // Messages parked while the circuit was open
+    std::atomic<std::uint64_t> evicted{0};          // Parked messages lost to a full spill ring (or capacity 0)
+    std::atomic<std::uint64_t> overBudget{0};       // Parked messages evicted by spillBudget (also counted in evicted)
+    std::atomic<std::uint64_t> spillBytes{0};       // Bytes parked right now (gauge)
+    std::atomic<std::uint64_t> replayed{0};         // Parked messages sent once Redis was back
+    std::atomic<std::uint64_t> slotRefreshes{0};    // Cluster mode: CLUSTER SLOTS reloads (startup, after errors)
+    std::atomic<std::uint64_t> functionCalls{0};    // FCALL tws_publish sent (redis.function_batches)
+    std::atomic<std::uint64_t> functionLoads{0};    // FUNCTION LOAD of the library (startup, after a Redis restart)
+};
+
+// Pipeline latency of batches carrying latency-stamped ticks, written by the sending thread
+struct PublisherLatency {
+    LatencyHistogram publish;                       // LatencyStage::Publish
+    LatencyHistogram endToEnd;                      // LatencyStage::EndToEnd (oldest tick of the batch)
+    LatencyHistogram roundTrip;                     // Every pipeline, stamped or not (ingest.sizing's Redis stall)
+};
+
 // REASON: Abstracts redis-plus-plus library, provides clean interface
 class RedisPublisher {
 public:
-    explicit RedisPublisher(const std::string& uri);
+    // uri: see parseRedisUri (tcp://host:port, unix:///path/redis.sock, ...)
+    // NOTE: Throws if the URI is malformed or Redis is unreachable at construction (startup check) - never afterwards
+    explicit RedisPublisher(const std::string& uri, BatchPolicy policy = {}, StreamPolicy streamPolicy = {},
+                            IoThreadPolicy ioPolicy = {}, OutagePolicy outagePolicy = {},
+                            RedisConnectionPolicy connection = {});
     ~RedisPublisher();
 
     // REASON: Non-copyable (manages connection resource)
     RedisPublisher(const RedisPublisher&) = delete;
     RedisPublisher& operator=(const RedisPublisher&) = delete;
 
-    // Publish JSON message to Redis channel
+    // Publish JSON message to Redis channel (one round trip, not pipelined, not spilled)
     // PERFORMANCE: Uses redis-plus-plus connection pool internally
-    void publish(const std::string& channel, const std::string& message);
+    PublishStatus publish(const std::string& channel, const std::string& message);
+
+    // Publish a batch of messages in ONE network round trip (redis-plus-plus Pipeline), through the
+    // circuit breaker: open, the batch is spilled and Ok is never returned until a probe succeeds
+    // NOTE: Sending thread only (the I/O thread when enabled) - same as flush()
+    PublishStatus publishBatch(const PublishMessage* messages, std::size_t count);
+    PublishStatus publishBatch(const std::vector<PublishMessage>& messages) {
+        return publishBatch(messages.data(), messages.size());
+    }
+
+    // Buffer message for pipelined publish; flushes when size limit is reached
+    void publishBuffered(const std::string& channel, const std::string& message) {
+        publishBuffered(channel, message.data(), message.size());
+    }
+    // PERFORMANCE: Raw-buffer overload (e.g. JsonBuffer), copied into the batch arena
+    void publishBuffered(const std::string& channel, const char* data, std::size_t length) {
+        enqueuePending(RedisCommand::Publish, channel, data, length);
+    }
+
+    // PERFORMANCE: Pooled-payload overload (payloads().store()) - the batch references the stored bytes
+    // instead of copying them, so PUBLISH / SET / XADD of one snapshot share a single stored copy
+    void publishBuffered(const std::string& channel, const SharedPayload& payload) {
+        enqueueShared(RedisCommand::Publish, channel, payload);
+    }
+
+    // Buffer SET of `key` (latest value), same batch as Pub/Sub messages
+    void setBuffered(const std::string& key, const char* data, std::size_t length) {
+        enqueuePending(RedisCommand::Set, key, data, length);
+    }
+    void setBuffered(const std::string& key, const SharedPayload& payload) {
+        enqueueShared(RedisCommand::Set, key, payload);
+    }
+
+    // Buffer XADD to stream `key` (trimmed per StreamPolicy), same batch as Pub/Sub messages
+    void streamAddBuffered(const std::string& key, const char* data, std::size_t length) {
+        enqueuePending(RedisCommand::StreamAdd, key, data, length);
+    }
+    void streamAddBuffered(const std::string& key, const SharedPayload& payload) {
+        enqueueShared(RedisCommand::StreamAdd, key, payload);
+    }
+
+    // Pool the worker stores encoded snapshots in (worker thread), shared with its sinks
+    // REASON: Owned here - pending and in-flight batches reference its blocks until they are sent, and the
+    // publisher outlives the worker that fills it
+    PayloadPool& payloads() { return m_payloads; }
+    const PayloadPool& payloads() const { return m_payloads; }
+
+    // Buffer sorted-set upsert: `data` becomes THE member scored `score` (replaces a previous one)
+    // REASON: A re-sent bar (backfill overlap, revised last bar) must not duplicate its timestamp
+    void sortedSetAddBuffered(const std::string& key, double score, const char* data, std::size_t length) {
+        enqueuePending(RedisCommand::SortedSetAdd, key, data, length, score);
+    }
+
+    // Buffer HSET of `key`: data is "field\nvalue\n..." (changed fields only, AccountTable)
+    void hashSetBuffered(const std::string& key, const char* data, std::size_t length) {
+        enqueuePending(RedisCommand::HashSet, key, data, length);
+    }
+
+    // Buffer TS.MADD: data is "key\ntimestamp\nvalue\n..." (every series sample of a drain batch, TimeSeriesBatch)
+    // PITFALL: Standalone Redis only - the keys span hash slots, there is no channel to route by
+    void timeSeriesAddBuffered(const std::string& data) {
+        enqueuePending(RedisCommand::TimeSeriesAdd, std::string(), data.data(), data.size());
+    }
+
+    // Buffer LPUSH of data's '\n'-separated elements (oldest first) to list `key`, then LTRIM to the newest `keep`
+    void listPushBuffered(const std::string& key, const std::string& data, std::size_t keep) {
+        enqueuePending(RedisCommand::ListPush, key, data.data(), data.size(), static_cast<double>(keep));
+    }
+
+    // Buffer removal of every member of `key` scored below `minScore` (age trim)
+    void sortedSetTrimBuffered(const std::string& key, double minScore) {
+        enqueuePending(RedisCommand::SortedSetTrim, key, "", 0, minScore);
+    }
+
+    // Oldest TickStamps::ingestNs behind the pending messages (0 = none), measured when their pipeline completes
+    // PERFORMANCE: Per batch, not per message - two clock reads per round trip
+    void markIngest(std::int64_t ingestNs) {
+        if (ingestNs != 0 && (m_pendingIngestNs == 0 || ingestNs < m_pendingIngestNs)) {
+            m_pendingIngestNs = ingestNs;
+        }
+    }
+
+    // Flush if time limit reached (call from worker loop, also when queue is idle)
+    // Returns number of messages sent (handed to the I/O thread when enabled)
+    std::size_t flushIfDue();
+
+    // Flush all pending messages now (never throws - failures are counted, see PublishStatus)
+    // NOTE: With the I/O thread a full backlog drops the batch (counted) instead of blocking
+    std::size_t flush();
+
+    // Shutdown: flush() that waits for a free I/O batch instead of dropping, then for the I/O thread to send
+    // everything queued - both until deadline; false = deadline hit (the destructor still sends the rest)
+    bool drain(std::chrono::steady_clock::time_point deadline);
+
+    std::size_t pendingCount() const { return m_pendingCount; }
+    // When the oldest pending message was buffered (meaningless while pendingCount() == 0)
+    std::chrono::steady_clock::time_point oldestPending() const { return m_oldestPending; }
+    // Size limit of the next pipelines (AdaptiveBatcher), same thread as the Buffered calls
+    void setMaxMessages(std::size_t maxMessages) { m_policy.maxMessages = maxMessages > 0 ? maxMessages : 1; }
+    const BatchPolicy& batchPolicy() const { return m_policy; }
+    const StreamPolicy& streamPolicy() const { return m_streamPolicy; }
+    const PublisherCounters& counters() const { return m_counters; }
+    const PublisherLatency& latency() const { return m_latency; }
+    // Duration of the last pipeline round trip (any thread, LoadShedder input)
+    std::chrono::nanoseconds lastRoundTrip() const {
+        return std::chrono::nanoseconds(m_lastRoundTripNs.load(std::memory_order_relaxed));
+    }
+
+    // Batches queued to or being sent by the I/O thread (0 when disabled)
+    std::size_t inFlightBatches() const;
     
-    // Connection health check
-    bool isConnected() const;
+    // Connection health, non-blocking: false while the circuit breaker is open (Redis failing)
+    bool isConnected() const { return m_breaker.state() != CircuitState::Open; }
+    CircuitState circuitState() const { return m_breaker.state(); }
     
     // Reconnect if connection lost
     void reconnect();
 
 private:
+    // Filled pending slots handed to the I/O thread (recycled, never freed while running)
+    struct Batch {
+        std::vector<PublishMessage> messages;
+        std::unique_ptr<BatchArena> arena;          // Bytes behind messages, reset once sent
+        std::size_t count = 0;
+        std::int64_t ingestNs = 0;                  // markIngest() stamp, 0 = not measured
+        std::int64_t handOffNs = 0;
+    };
+
+    sw::redis::Pipeline& pipeline();
+    sw::redis::Pipeline& nodePipeline(std::uint16_t node);
+    std::size_t appendCommand(sw::redis::Pipeline& pipe, const PublishMessage& message);  // Commands appended
+    void appendBatch(sw::redis::Pipeline& pipe, const PublishMessage* messages, std::size_t count);
+    bool loadFunction(sw::redis::Pipeline& pipe);
+    void sendCluster(const PublishMessage* messages, std::size_t count);
+    void refreshSlots();
+    void enqueuePending(RedisCommand command, const std::string& channel, const char* data, std::size_t length,
+                        double score = 0.0);
+    void enqueueShared(RedisCommand command, const std::string& channel, const SharedPayload& payload);
+    PublishMessage& nextPending();
+    PublishStatus sendPipeline(const PublishMessage* messages, std::size_t count);
+    PublishStatus sendCounted(const PublishMessage* messages, std::size_t count);
+    void spill(const PublishMessage* messages, std::size_t count);
+    bool replaySpill();
+    bool probe();
+    void connect();
+    std::size_t handOff(std::size_t count, std::int64_t ingestNs);
+    void recordLatency(std::int64_t ingestNs, std::int64_t handOffNs);
+    void ioLoop();
+
     std::unique_ptr<sw::redis::Redis> m_redis;
+    std::unique_ptr<sw::redis::RedisCluster> m_cluster;        // Cluster mode instead of m_redis
+    std::unique_ptr<RespConnection> m_resp;                    // directResp: batches bypass m_pipeline (m_redis kept for the rest)
     std::string m_uri;
+    RedisEndpoint m_endpoint;
+    RedisConnectionPolicy m_connection;
+
+    // ========== Pipelined Batch State ==========
+    PayloadPool m_payloads;                                    // PITFALL: Before the arenas - destroyed after their references
+    BatchPolicy m_policy;
+    StreamPolicy m_streamPolicy;
+    std::unique_ptr<sw::redis::Pipeline> m_pipeline;           // REASON: Reused across flushes (holds one pooled connection)
+    std::vector<PublishMessage> m_pending;                     // REASON: Slots reused, capacity never shrinks
+    std::unique_ptr<BatchArena> m_arena;                       // Channel / payload bytes of m_pending (swapped with Batch::arena)
+    std::size_t m_pendingCount = 0;
+    std::chrono::steady_clock::time_point m_oldestPending{};
+    PublisherCounters m_counters;
+    std::int64_t m_pendingIngestNs = 0;
+    PublisherLatency m_latency;
+    alignas(64) std::atomic<std::int64_t> m_lastRoundTripNs{0};  // Sending thread writes, any thread reads
+
+    // ========== Outage State (sending thread) ==========
+    CircuitBreaker m_breaker;
+    SpillRing m_spill;
+    std::size_t m_spillBudget = 0;
+    std::vector<PublishMessage> m_replay;                      // REASON: Reused views of one spill chunk
+
+    // ========== Cluster State (sending thread) ==========
+    ClusterSlotMap m_slots;
+    std::vector<std::string> m_nodeTags;                       // By node: hash tag routed to it (pipeline(tag))
+    std::vector<std::unique_ptr<sw::redis::Pipeline>> m_nodePipelines;  // By node, reused like m_pipeline
+    std::vector<std::uint16_t> m_messageNodes;                 // REASON: Scratch - owning node per batch message
+    std::vector<std::pair<sw::redis::StringView, sw::redis::StringView>> m_hashFields;  // Scratch - HSET pairs
+    std::vector<sw::redis::StringView> m_commandArgs;          // Scratch - TS.MADD arguments
+    bool m_slotsStale = false;                                 // Reload CLUSTER SLOTS before the next batch
+
+    // ========== Function Batches (sending thread, redis.function_batches) ==========
+    FunctionBatch m_function;
+    bool m_functionPending = false;                            // FUNCTION LOAD before the next batch
+    bool m_functionReady = false;                              // Loaded - fusable runs go out as FCALL
+    std::vector<std::size_t> m_functionReplies;                // Scratch - reply index of each FCALL in the pipeline
+
+    // ========== I/O Thread State ==========
+    IoThreadPolicy m_ioPolicy;
+    std::vector<std::unique_ptr<Batch>> m_batches;             // Owns every batch buffer
+    moodycamel::ConcurrentQueue<Batch*> m_readyBatches;        // Worker → I/O thread (FIFO, preserves order)
+    moodycamel::ConcurrentQueue<Batch*> m_freeBatches;         // I/O thread → worker (recycled)
+    ConsumerWaiter m_ioWaiter;
+    std::atomic<bool> m_ioRunning{false};
+    std::thread m_ioThread;                                    // REASON: Declared last, started after all state exists
 };
 
 } // namespace tws_bridge
@@ -0,0 +1,731 @@
+// RedisWorker.h - Consumer thread: bulk dequeue, state aggregation, pipelined publish
+// SCOPE: Thread 2 (Redis Worker) - exclusive owner of InstrumentState map
+
+#pragma once
+
+#include "AccountTable.h"
+#include "AdaptiveBatch.h"
+#include "BarBuilder.h"
+#include "BasketIndex.h"
+#include "Deadband.h"
+#include "EncoderPool.h"
+#include "FlightRecorder.h"
+#include "GreeksChain.h"
+#include "MarketData.h"
+#include "InstrumentRegistry.h"
+#include "LastValueHash.h"
+#include "LatencyHistogram.h"
+#include "LoadShedder.h"
+#include "Lz4Frame.h"
+#include "NewsFeed.h"
+#include "OrderBook.h"
+#include "QuoteBatch.h"
+#include "QuoteTable.h"
+#include "RedisPublisher.h"
+#include "Serialization.h"
+#include "ShmRing.h"
+#include "SnapshotDelta.h"
+#include "SnapshotEncoder.h"
+#include "SnapshotSink.h"
+#include "StageWatchdog.h"
+#include "StateCheckpoint.h"
+#include "SlotColumns.h"
+#include "SubscriberTracker.h"
+#include "TickFilter.h"
+#include "TimeSeries.h"
+#include "WaitStrategy.h"
+#include "SessionStats.h"
+#include "ShardRouter.h"
+#include "ThreadAffinity.h"
+#include "TimerWheel.h"
+#include "TopMovers.h"
+#include "TradeTape.h"
+#include "TraceExport.h"
+#include "VolumeProfile.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+// Per-symbol conflation: only the latest snapshot per symbol is published
+struct ConflationConfig {
+    bool enabled = false;
+    std::chrono::microseconds window{0};            // 0 = conflate within one drain batch
+    bool publishTradesIndividually = true;          // Trades bypass conflation (one publish per trade)
+    bool reduceBatch = false;                       // Skip quotes a later quote of the slot in the batch overwrites
+};
+
+// Multi-symbol channel: one PUBLISH carries a JSON array of every snapshot published in the batch / window
+// PERFORMANCE: A firehose consumer SUBSCRIBEs one channel instead of PSUBSCRIBE TWS:TICKS:* - Redis
+// skips the per-message pattern match and fans out one message per batch instead of one per tick
+// PITFALL: Not under TWS:TICKS:* - pattern subscribers expect one snapshot object per message (and
+// "ALL" is a listed symbol); each shard publishes its own arrays to the same channel
+struct AggregateConfig {
+    bool enabled = false;
+    std::string channel = "TWS:ALL:TICKS";
+    std::chrono::microseconds window{0};            // 0 = one array per drain batch
+    std::size_t maxSnapshots = 1024;                // Window cut short once the array holds this many
+    bool perSymbol = true;                          // false: skip PUBLISH TWS:TICKS:{SYMBOL} (stream / LVC unchanged)
+    // PERFORMANCE: > 0 = arrays encoded + compressed on this many threads per worker (EncoderPool.h), published
+    // in order - with perSymbol false (and no LVC / stream / shm / sinks) the worker then encodes nothing
+    std::size_t encoderThreads = 0;
+    std::size_t encoderBatches = 16;                // BACKPRESSURE: Arrays in flight before the worker waits
+};
+
+// Throttled copy of the tick channels: the latest snapshot of each symbol that changed, once per interval
+// PERFORMANCE: A 1 Hz dashboard costs one PUBLISH per changed symbol per second, whatever the tick rate
+// NOTE: TWS:{name}:TICKS:{SYMBOL}, outside TWS:TICKS:* so pattern subscribers never see tier copies
+struct RateTier {
+    std::string name;                               // Channel segment, e.g. "1HZ"
+    std::chrono::microseconds interval{1000000};
+};
+
+// LZ4 frame compression (Lz4Frame.h) of large payloads - consumers check the first byte (0x04 = LZ4 frame)
+// PERFORMANCE: Batched JSON (repeated keys, similar numbers) shrinks 4-8x - for bandwidth-bound replication links
+struct CompressionConfig {
+    bool aggregate = false;                         // AggregateConfig arrays
+    bool stream = false;                            // TWS:STREAM:* entry data
+    std::size_t minBytes = 512;                     // Smaller payloads stay plain (single snapshots barely shrink)
+};
+
+// Snapshot delivery for TWS:TICKS:* (bars are always Pub/Sub)
+enum class TickOutput {
+    PubSub,   // PUBLISH TWS:TICKS:{SYMBOL} (fire-and-forget)
+    Stream,   // XADD TWS:STREAM:{SYMBOL} MAXLEN ~ N (resumable, see StreamPolicy)
+    Both
+};
+
+// When a quote / trade update produces a TWS:TICKS:{SYMBOL} snapshot
+enum class PublishPolicy {
+    AnyChange,     // First BidAsk or AllLast already publishes (the missing side stays 0)
+    WhenComplete,  // Only once both a quote and a trade were seen (illiquid names may wait minutes)
+    FieldChange    // Like AnyChange, but only when a PublishPolicyConfig::fields value changed
+};
+
+// PublishPolicyConfig::fields bits
+namespace SnapshotFields {
+constexpr std::uint8_t BidPrice = 1u << 0;
+constexpr std::uint8_t AskPrice = 1u << 1;
+constexpr std::uint8_t LastPrice = 1u << 2;
+constexpr std::uint8_t BidSize = 1u << 3;
+constexpr std::uint8_t AskSize = 1u << 4;
+constexpr std::uint8_t LastSize = 1u << 5;
+constexpr std::uint8_t Prices = BidPrice | AskPrice | LastPrice;
+constexpr std::uint8_t All = Prices | BidSize | AskSize | LastSize;
+}
+
+struct PublishPolicyConfig {
+    PublishPolicy policy = PublishPolicy::WhenComplete;
+    std::uint8_t fields = SnapshotFields::Prices;   // FieldChange: compared against the last published snapshot
+};
+
+// L2 delivery for TWS:DEPTH:{SYMBOL}
+enum class DepthOutput {
+    Snapshot, // Top-N levels per side, once per drain batch per changed book (conflated)
+    Delta,    // Every insert / update / delete as received (consumers maintain their own book)
+    Both
+};
+
+struct DepthConfig {
+    DepthOutput output = DepthOutput::Snapshot;
+    std::size_t levels = 10;                        // Snapshot: levels per side
+};
+
+// Bar persistence: ZADD TWS:BARS:Z:{SYMBOL}:{barSize}, score = bar timestamp (ms), member =
+// serializeBarCompact - chart backends load a range with one ZRANGEBYSCORE
+struct BarStoreConfig {
+    bool enabled = false;
+    std::size_t retainBars = 20000;                 // Age limit = retainBars x bar size (5s: ~28h, 1d: ~55y), 0 = keep all
+    std::chrono::seconds trimInterval{60};          // Min wall time between age trims of one key
+};
+
+// Server-side bars from AllLast trades (no reqRealTimeBars line), published to
+// TWS:BARS:{SYMBOL}:{barSize} with the serializeBarData schema (+ bar store when enabled)
+struct BarBuilderConfig {
+    bool enabled = false;
+    std::array<BarSize, BarBuilder::kMaxTimeframes> timeframes{BarSize::Sec1, BarSize::Sec5, BarSize::Min1,
+                                                               BarSize::Unknown};  // Unknown = unused
+    std::chrono::milliseconds grace{1500};          // Quiet bars close this long after their bucket ends
+};
+
+// Snapshot "derived" object (DerivedMetrics.h): mid, spread, session VWAP, rolling volume
+struct DerivedMetricsConfig {
+    bool enabled = false;
+    std::chrono::minutes sessionReset{9 * 60};      // VWAP session boundary, UTC time of day (09:00 = before US pre-open)
+    std::chrono::seconds rollingWindow{60};         // Rolling volume window
+};
+
+// Per-stage pipeline latency (LatencyHistogram.h): percentiles of each interval published to statusChannel
+// NOTE: Needs TwsClient::setLatencyStamps(true) - unstamped ticks (and bars) are not measured
+struct LatencyConfig {
+    bool enabled = false;
+    std::chrono::seconds interval{10};              // Report period (percentiles cover this interval only)
+    std::string statusChannel = "TWS:STATUS";
+};
+
+// Consumer lag: age of the oldest update at dequeue, TWS:STATUS "queue_lag" event when it crosses a threshold
+// REASON: Queue depth says how much is waiting, not how stale it is - age rises before anything is dropped
+// NOTE: Needs TwsClient::setLatencyStamps(true), like LatencyConfig - bars carry no stamps
+struct LagConfig {
+    bool enabled = false;
+    std::chrono::milliseconds warn{100};
+    std::chrono::milliseconds critical{1000};
+};
+
+enum class LagLevel : std::uint8_t { Ok, Warn, Critical };
+
+inline const char* lagLevelName(LagLevel level) {
+    switch (level) {
+    case LagLevel::Ok: return "ok";
+    case LagLevel::Warn: return "warn";
+    case LagLevel::Critical: return "critical";
+    }
+    return "unknown";
+}
+
+struct WorkerConfig {
+    std::size_t shardId = 0;                        // Log tag when running a sharded pool
+    std::size_t batchSize = 256;                    // Max updates per try_dequeue_bulk (adaptive: the base)
+    AdaptiveBatchConfig adaptive;
+    std::chrono::seconds statsInterval{10};         // Batch statistics report period
+    std::chrono::seconds overflowLogInterval{1};    // Rate limit for ingest overflow warnings
+    std::chrono::milliseconds drainTimeout{2000};   // Shutdown: budget for publishing what is still queued
+    SnapshotSchema snapshotSchema = SnapshotSchema::Verbose;  // TWS:TICKS:* field names
+    PriceFormat priceFormat = PriceFormat::Shortest;          // TWS:TICKS:* bid / ask / last layout
+    bool isoTimestamps = false;                     // Also "time" (compact "tm"): ISO 8601 copy of "timestamp"
+    bool sendTimestamps = false;                    // Also "sent" (compact "sn"): wall clock at encoding, Unix ns
+    PublishPolicyConfig publishPolicy;
+    bool suppressDuplicates = true;                 // Skip snapshots identical to the slot's last published one
+    DeadbandConfig deadband;                        // Skip snapshots whose prices / sizes barely moved
+    TickFilterConfig tickFilter;                    // Screen quotes / trades before they reach the state
+    VolumeProfileConfig volumeProfile;              // TWS:PROFILE:{SYMBOL} volume at price
+    SessionStatsConfig sessionStats;                // TWS:SESSION:{SYMBOL} open / high / low / previous close
+    TickOutput tickOutput = TickOutput::PubSub;
+    bool writeLastValue = false;                    // Also SET TWS:LVC:{SYMBOL} (clients start with one MGET)
+    LastValueFormat lastValueFormat = LastValueFormat::Json;  // Hash: HSET of the changed fields instead
+    bool publishBinary = false;                     // Also publish TWS:BIN:TICKS/BARS:* (BinaryEncoder.h v1)
+    ConflationConfig conflation;
+    AggregateConfig aggregate;
+    DeltaConfig delta;                              // TWS:TICKS:* / TWS:BIN:TICKS:* carry changed fields only
+    CompressionConfig compression;
+    std::vector<RateTier> tiers;                    // Extra low-rate outputs (full rate stays on TWS:TICKS:*)
+    DepthConfig depth;
+    OptionChainConfig options;                      // TWS:CHAIN:{SYMBOL}:{EXPIRY} greeks batches
+    std::size_t historyChunkBars = 5000;            // Historical bars per TWS:HISTORY payload (longer series are chunked)
+    // keepUpToDate bars: min time between TWS:LIVEBAR:{SYMBOL} / bar store revisions of a symbol's in-progress bar
+    // PERFORMANCE: TWS revises it every few seconds per symbol - only the latest revision goes out per interval
+    std::chrono::milliseconds liveBarInterval{1000};
+    // Newest prints kept in TWS:TAS:{SYMBOL} (time and sales, LRANGE 0 -1 = newest first), 0 = off
+    std::size_t tapeLength = 0;
+    // Bytes of buffered historical bars (memory.history_mb share), 0 = unbounded
+    // BACKPRESSURE: Past it, the buffered chunk is published early and its buffer freed (smaller payloads, no loss)
+    std::size_t historyBudget = 0;
+    BarStoreConfig barStore;
+    BarBuilderConfig barBuilder;
+    DerivedMetricsConfig derivedMetrics;
+    LatencyConfig latency;
+    LagConfig lag;
+    FlightRecorderConfig flight;                    // Needs stamped ticks, like LatencyConfig
+    ShmRingConfig shm;                              // Also write TWS:TICKS:* snapshots to a host-local ring
+    ThreadConfig thread;                            // Placement of the thread calling run() ("tws-worker-{shardId}")
+    bool numaLocal = false;                         // run(): state tables + shard queue on this thread's NUMA node
+    HugePageConfig memory;                          // run(): state table on 2 MB pages (IngestConfig::memory)
+    bool trackQueueAge = false;                     // queueAge() without LatencyConfig (needs stamped ticks)
+    bool trackOccupancy = false;                    // ingest.sizing: sample the shard's QueueOccupancy per batch
+    std::chrono::microseconds shedConflationWindow{50000};  // Window while shedding at ConflateQuotes or above
+};
+
+// Lifetime counters (written by worker, readable from any thread)
+// REASON: Own cache line - the metrics thread's reads never pull the worker's private fields along
+struct alignas(64) WorkerCounters {
+    std::atomic<std::uint64_t> published{0};        // Snapshots handed to the publisher
+    std::atomic<std::uint64_t> conflated{0};        // Updates absorbed into a later snapshot
+    std::atomic<std::uint64_t> unchanged{0};        // PublishPolicy::FieldChange: no selected field changed
+    std::atomic<std::uint64_t> duplicates{0};       // suppressDuplicates: snapshot identical to the last one
+    std::atomic<std::uint64_t> deadbanded{0};       // DeadbandConfig: change within the slot's deadband
+    std::atomic<std::uint64_t> badTicks[kBadTickReasons] = {};  // TickFilterConfig: by BadTick
+    std::atomic<std::uint64_t> depthRejected{0};    // Depth changes that did not fit the book (out of sync)
+    std::atomic<std::uint64_t> lateTrades{0};       // Trades older than an already published built bar
+    std::atomic<std::uint64_t> unwatched{0};        // watchSubscribers: snapshot skipped, nobody subscribed
+    std::atomic<std::uint64_t> lagAlerts{0};        // LagConfig: rises to warn / critical
+    std::atomic<std::uint64_t> seriesSamples{0};    // writeTimeSeries: samples sent with TS.MADD
+    std::atomic<std::uint64_t> profiles{0};         // VolumeProfileConfig: profile deltas published
+    std::atomic<std::uint64_t> sessions{0};         // SessionStatsConfig: TWS:SESSION:* updates published
+    std::atomic<std::uint64_t> tapePrints{0};       // tapeLength: prints pushed to TWS:TAS:*
+    std::atomic<std::int64_t> historyBytes{0};      // Capacity of the buffered historical bar series (gauge)
+    std::atomic<std::uint64_t> historyTrims{0};     // historyBudget: chunks published early / buffers freed
+};
+
+// Worker-side stage histograms (lifetime, readable from any thread) - Publish / EndToEnd: PublisherLatency
+struct WorkerLatency {
+    LatencyHistogram ingest;                        // LatencyStage::Ingest (TickStamps::enqueueNs)
+    LatencyHistogram queue;                         // LatencyStage::Queue
+    LatencyHistogram serialize;                     // LatencyStage::Serialize
+};
+
+// Batch statistics for the last reporting interval
+struct WorkerBatchStats {
+    double batchesPerSecond = 0.0;
+    std::size_t medianBatchSize = 0;
+    std::uint64_t updates = 0;
+    std::uint64_t published = 0;
+    std::uint64_t conflated = 0;
+    std::uint64_t unchanged = 0;
+    std::uint64_t duplicates = 0;
+    std::uint64_t redisDropped = 0;                 // Backpressure drops (publisher I/O thread full)
+    std::size_t redisInFlight = 0;                  // Batches queued to the I/O thread at report time
+    std::uint64_t ingestDropped = 0;                // Shard overflow (see OverflowPolicy)
+    std::uint64_t ingestConflated = 0;
+    std::uint64_t ingestSpilled = 0;
+    std::uint64_t ingestSuperseded = 0;             // Coalesced ticks overwritten before publish
+};
+
+// Queue: ingest queue type (MpmcTickQueue or SpscTickQueue), instantiated in RedisWorker.cpp
+template <typename Queue>
+class BasicRedisWorker {
+public:
+    // shard: ingest queue, overflow storage and wake-up of the shard this worker owns
+    BasicRedisWorker(BasicShard<Queue>& shard,
+                     const InstrumentRegistry& registry,
+                     RedisPublisher& redis,
+                     WorkerConfig config = {});
+
+    // Extra backend fed with every published TWS:TICKS:* snapshot (before run() only)
+    // NOTE: Runs on its own thread behind a bounded queue - a slow sink never stalls Redis or other sinks
+    void addSink(std::shared_ptr<SnapshotSink> sink, SinkPolicy policy = {});
+
+    // Skip encoding snapshots of symbols with no TWS:TICKS subscriber (before run() only, table outlives the worker)
+    // NOTE: Only honored for plain Pub/Sub output - a stream, LVC key, shm ring or sink wants every snapshot
+    void watchSubscribers(const SubscriberTable& table);
+
+    // Drains account PnL / position updates (TwsClient::subscribeAccount) every interval into an AccountTable,
+    // one HSET of the changed fields per row (before run() only, feed outlives the worker)
+    void streamAccount(AccountQueue& feed, std::chrono::milliseconds interval) {
+        m_accountFeed = &feed;
+        m_accountInterval = interval;
+    }
+
+    // Drains headlines (TwsClient::subscribeNews) every lane.config.interval: drops articles already published
+    // on the symbol's channel, one PUBLISH on TWS:NEWS:{SYMBOL} per new one (before run() only, lane outlives
+    // the worker)
+    void streamNews(NewsLane& lane) {
+        m_newsLane = &lane;
+        m_newsFilter = ArticleFilter(lane.config.dedupeCapacity);
+    }
+
+    // Adds bid / ask / last / volume samples of every published snapshot to TWS:TS:{SYMBOL}:* - one TS.MADD per
+    // drain batch, for the slots whose series the catalog has created (before run() only, catalog outlives the worker)
+    void writeTimeSeries(const TimeSeriesCatalog& catalog) {
+        m_seriesCatalog = &catalog;
+        m_series.resize(m_registry.capacity());
+    }
+
+    // Applies every live trade of a basket constituent to the book's running values (before run() only,
+    // book outlives the worker)
+    void computeBaskets(BasketBook& book) { m_baskets = &book; }
+
+    // Ranks this worker's slots by change and session volume, posting its top rows to the exchange once per
+    // interval when they moved (before run() only, exchange outlives the worker)
+    void rankMovers(MoversExchange& exchange, const MoversConfig& config) {
+        m_moversExchange = &exchange;
+        m_moversConfig = config;
+        m_movers = std::make_unique<MoverBoard>(m_registry.capacity(), config.sessionReset);
+    }
+
+    // Seeds a slot's quote / trade fields from its last published snapshot (WarmStart.h, before run() only)
+    // REASON: WhenComplete needs a quote AND a trade - a restarted illiquid symbol would stay silent until
+    // both arrive again; seeded, its next tick publishes a complete snapshot
+    // NOTE: Nothing is published by the seed itself, duplicate suppression starts from the next snapshot
+    void warmStart(SlotId slot, const InstrumentState& seed);
+
+    // Mirrors slot state into a shared-memory checkpoint (StateCheckpoint.h) once per drain batch; a slot whose
+    // symbol is in restore resumes from it when bound, warm start included (before run() only, both outlive the worker)
+    void checkpointTo(StateCheckpoint& checkpoint, const CheckpointImage* restore);
+
+    // Mirrors slot state into quotes (QuoteTable.h) once per drain batch, for point-in-time lookups
+    // (before run() only, quotes outlives the worker)
+    void serveQuotes(QuoteTable& quotes);
+
+    // Records the worker stages of sampled ticks (TraceExport.h, before run() only, trace outlives the worker)
+    // NOTE: Ticks are sampled by TwsClient::setTraceExport - the worker follows their TickStamps::traceId
+    void traceTo(TraceExport& trace) {
+        m_trace = &trace;
+        m_config.trackQueueAge = true;  // REASON: Dequeue time of the batch (Queued span end)
+    }
+
+    // Shard rebalancing (ShardRebalancer.h, before run() only): hands moving slots over to / adopts them from
+    // peers - every worker of the router by shard index, all outliving each other's run()
+    // NOTE: A new owner waits at most handoffTimeout for the old one, then restarts the slot from its own state
+    void rebalanceWith(SlotMigration& migration, std::vector<BasicRedisWorker*> peers,
+                       std::chrono::milliseconds handoffTimeout);
+
+    // Worker loop (blocks until running == false), then drains the shard within WorkerConfig::drainTimeout
+    // NOTE: Stop the producers first - updates queued after the drain are lost
+    void run(std::atomic<bool>& running);
+
+    // run() in phases, for a caller that owns the loop (compact mode: reader, decode and publish on one thread)
+    // start() once, then poll() - one batch applied and flushed, or the idle publishes (returns false, never
+    // waits) - until shutdown, then finish() (the drain). All three on the same thread.
+    // NOTE: nextDeadline() is the timer wheel's next due time - the longest the caller may block between polls
+    void start();
+    bool poll();
+    std::chrono::steady_clock::time_point nextDeadline() const;
+    void finish();
+
+    // Last reported batch statistics (worker thread only)
+    const WorkerBatchStats& lastStats() const { return m_lastStats; }
+    const WorkerCounters& counters() const { return m_counters; }
+    const WorkerLatency& latency() const { return m_latency; }
+    // Percentiles of the last LatencyConfig interval (worker thread only)
+    const LatencyReport& lastLatency() const { return m_lastLatency; }
+    // Shared-memory ring (nullptr when disabled or not created), counters readable from any thread
+    const ShmRingWriter* shmRing() const { return m_shm.get(); }
+    // Sink fan-out (nullptr without sinks), counters readable from any thread
+    const SinkFanout* sinks() const { return m_sinks.get(); }
+    // Spike-triggered stage dumps (nullptr when disabled), counters readable from any thread
+    const FlightRecorder* flightRecorder() const { return m_flight.get(); }
+    // Time the oldest update of the last drained batch waited since ingest, 0 when idle (any thread)
+    // NOTE: Measured only with WorkerConfig::trackQueueAge or LatencyConfig, from stamped ticks
+    std::chrono::nanoseconds queueAge() const {
+        return std::chrono::nanoseconds(m_queueAgeNs.load(std::memory_order_relaxed));
+    }
+    // Beats once per loop iteration (StageWatchdog, Stage::Worker)
+    const Heartbeat& heartbeat() const { return m_heartbeat; }
+    // Last LagConfig level (any thread)
+    LagLevel lagLevel() const { return m_lagLevel.load(std::memory_order_relaxed); }
+    // Load-shedding level (any thread, LoadShedder.h) - applied at the worker's next loop iteration
+    void setShedLevel(ShedLevel level) { m_requestedShedLevel.store(level, std::memory_order_relaxed); }
+
+private:
+    // Snapshot-visible values of the last published snapshot (FieldChange / suppressDuplicates)
+    struct PublishedFields {
+        double bidPrice = 0.0;
+        double askPrice = 0.0;
+        double lastPrice = 0.0;
+        std::int64_t bidSize = 0;
+        std::int64_t askSize = 0;
+        std::int64_t lastSize = 0;
+        std::uint8_t sizeScale = 0;
+        long quoteTimestamp = 0;
+        long tradeTimestamp = 0;
+        std::uint64_t trades = 0;
+        bool pastLimit = false;
+        bool valid = false;  // Nothing published yet
+        std::chrono::steady_clock::time_point at{};  // DeadbandConfig: heartbeat reference
+    };
+
+    struct StateEntry {
+        InstrumentState state;
+        const InstrumentChannels* channels = nullptr;  // Registry-owned, set on first update
+        bool dirty = false;  // Pending conflated publish
+        bool resolved = false;  // state.conId / primaryExchange copied from the registry
+        bool unwatched = false;  // Last snapshot skipped (no subscriber) - re-published once watched
+        std::uint64_t trades = 0;  // AllLast count - a repeated identical trade is still a new trade
+        PublishedFields published;
+        TickStamps stamps{};       // FlightRecorder: last stamped update since the last snapshot
+        TickUpdateType stampedType = TickUpdateType::BidAsk;
+        std::uint32_t traceId = 0;  // TraceExport: sampled update not yet in a snapshot
+        DeadbandRule deadband;      // DeadbandConfig: resolved when the slot is bound
+        bool deadbandHeld = false;  // A change within the deadband waits in m_deadbandHeld for the heartbeat
+        TickBand band;              // TickFilterConfig: last good mid + rolling spread
+    };
+
+    void placeOnLocalNode();
+    void placeOnHugePages();
+    void drainOnShutdown(std::vector<TickUpdate>& batch);
+    bool bindSlot(StateEntry& entry, SlotId slot);  // true: restored from the checkpoint image
+    void restoreSlot(StateEntry& entry, SlotId slot, const SlotCheckpoint& saved);
+    void markCheckpoint(SlotId slot);
+    void writeCheckpoint();
+    void applyUpdate(const TickUpdate& update);
+    bool rejectTick(StateEntry& entry, const TickUpdate& update);
+    void handOffSlot();
+    void adoptMigrating();
+    void adoptSlot(BasicRedisWorker& source, SlotId slot);
+    void applyDepth(StateEntry& entry, const TickUpdate& update);
+    void publishHistory(StateEntry& entry, SlotId slot, bool complete);
+    bool historyOverBudget() const {
+        return m_config.historyBudget > 0
+            && m_counters.historyBytes.load(std::memory_order_relaxed)
+                   > static_cast<std::int64_t>(m_config.historyBudget);
+    }
+    void publishBackfill(StateEntry& entry, SlotId slot, bool complete);
+    void storeBar(const StateEntry& entry, const TickUpdate& update);
+    void publishBar(const StateEntry& entry, const TickUpdate& update);
+    void applyLiveBar(const StateEntry& entry, const TickUpdate& update);
+    void trackLiveBar(SlotId slot);
+    void publishLiveBars();
+    struct BuiltBarSlot;
+    BuiltBarSlot& builtBars(const StateEntry& entry, SlotId slot);
+    void buildBar(const StateEntry& entry, const TickUpdate& update);
+    void publishBuiltBar(SlotId slot, BuiltBarSlot& built, BarSize size, const BuiltBar& bar);
+    void closeExpiredBars();
+    void publishDepth();
+    void applyGreeks(StateEntry& entry, const TickUpdate& update);
+    void trackChain(SlotId slot);
+    void publishChains();
+    void publishAccount();
+    void publishNews();
+    void postMovers();
+    void profileTrade(const StateEntry& entry, const TickUpdate& update);
+    void publishProfiles();
+    void markSession(SlotId slot, bool wasDirty);
+    void publishSessions();
+    void rollSessions();
+    void armSessionRoll(std::chrono::steady_clock::time_point now);
+    void publishTimeSeries();
+    void publishTape();
+    void publishState(StateEntry& entry);
+    void publishDelta(StateEntry& entry, DeltaTrack& track, bool keyframe, bool perSymbol);
+    // "sent" value of the snapshot being encoded (0 = field omitted)
+    std::int64_t sentNs() const {
+        return m_config.sendTimestamps ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::system_clock::now().time_since_epoch()).count()
+                                       : 0;
+    }
+    bool selectedFieldsChanged(const StateEntry& entry) const;
+    bool isDuplicate(const StateEntry& entry) const;
+    bool withinDeadband(StateEntry& entry);
+    void publishHeld(std::chrono::steady_clock::time_point now);
+    void markDirty(StateEntry& entry);
+    void publishDirty();
+    void publishDirtyIfDue();
+    void publishAggregate();
+    void publishAggregateIfDue();
+    void publishArray(std::string_view payload);
+    void collectEncoded();
+    std::string_view compress(std::string_view payload);
+    void markTiers(SlotId slot);
+    void publishTier(std::size_t tier);
+    void publishNewlyWatched();
+    std::size_t dequeueBatch(TickUpdate* out, std::size_t maxItems);
+    std::size_t drainOverflow(TickUpdate* out, std::size_t maxItems);
+    void recordBatch(std::size_t size);
+    bool adaptiveFlushDue();
+    void recordDequeue(const TickUpdate* updates, std::size_t count);
+    void armTimers();
+    void runTimers();
+    void onTimer(std::uint32_t tag, std::chrono::steady_clock::time_point now);
+    void publishLatency(std::chrono::steady_clock::time_point now);
+    void reportStats(std::chrono::steady_clock::time_point now);
+    void logOverflow();
+    void applyShedLevel();
+    void checkLag(std::int64_t ageNs);
+    void commitFlight();
+    void applyTraced(const TickUpdate& update);
+    void commitTrace();
+
+    BasicShard<Queue>& m_shard;
+    Queue& m_queue;
+    const InstrumentRegistry& m_registry;
+    RedisPublisher& m_redis;
+    ConsumerWaiter& m_waiter;
+    WorkerConfig m_config;
+    AdaptiveBatcher m_batcher;                   // Used when m_config.adaptive.enabled
+
+    // PERFORMANCE: Dense state table indexed by registry slot (no hashing, no strings)
+    std::vector<StateEntry> m_states;
+    
+    // ========== Conflation ==========
+    std::vector<StateEntry*> m_dirty;            // REASON: m_states is sized once, never reallocated
+    std::chrono::steady_clock::time_point m_windowStart{};
+    WorkerCounters m_counters;
+    JsonBuffer m_json;                           // REASON: Reused for every publish (worker thread only)
+    std::string m_binary;                        // REASON: Reused for every binary publish
+    SnapshotArray m_aggregate;                   // AggregateConfig: snapshots since the last array publish
+    std::unique_ptr<EncoderPool> m_encoderPool;  // AggregateConfig::encoderThreads > 0: replaces m_aggregate
+    std::chrono::steady_clock::time_point m_aggregateStart{};
+    std::vector<DeltaTrack> m_deltas;            // By slot, empty unless DeltaConfig::enabled
+    std::vector<LastValueTrack> m_lastValues;    // By slot, empty unless LastValueFormat::Hash
+    std::string m_lastValuePayload;              // REASON: Reused for every LVC HSET payload
+    struct TierState {
+        std::chrono::steady_clock::time_point nextAt{};
+        SlotColumn sent;                         // m_publishSeq at the tier's last tick (differs = republish)
+        std::vector<std::string> channels;       // By slot, "TWS:{name}:TICKS:{SYMBOL}" built on first use
+    };
+    std::vector<TierState> m_tiers;              // By WorkerConfig::tiers index
+    // PERFORMANCE: One increment per full-rate publish whatever the tier count, tiers find their changed
+    // slots with a vectorized column compare (SlotColumns.h)
+    SlotColumn m_publishSeq;                     // By slot: full-rate publishes (tiers only)
+    std::vector<SlotId> m_deadbandHeld;          // Slots holding back a change with a heartbeat (DeadbandTimer)
+
+    // ========== Timers ==========
+    // Periodic work, driven by the run loop (one clock read per iteration); tier i uses TierTimer + i
+    enum TimerTag : std::uint32_t {
+        StatsTimer, LatencyTimer, OverflowTimer, BarSweepTimer, ChainTimer, AccountTimer, MoversTimer,
+        DeadbandTimer, ProfileTimer, SessionTimer, SessionRollTimer, LiveBarTimer, NewsTimer, TierTimer
+    };
+    TimerWheel m_timers;
+    static constexpr std::chrono::milliseconds kDeadbandSweep{100};  // PERFORMANCE: Heartbeat granularity
+    Lz4Compressor m_lz4;                         // CompressionConfig (worker thread only)
+    std::string m_compressed;                    // REASON: Reused for every compressed payload
+    std::unique_ptr<ShmRingWriter> m_shm;        // Co-located consumers (ShmRingConfig)
+    std::unique_ptr<SinkFanout> m_sinks;         // Extra backends (addSink), committed once per drain batch
+    std::unique_ptr<FlightRecorder> m_flight;    // FlightRecorderConfig
+    TraceExport* m_trace = nullptr;              // traceTo (main-owned)
+    struct TracedSnapshot {
+        std::int64_t serializedNs;
+        std::uint32_t traceId;
+        SlotId slot;
+    };
+    std::vector<TracedSnapshot> m_tracePending;  // Serialized, pipeline not flushed yet
+    const SubscriberTable* m_watch = nullptr;    // watchSubscribers (SubscriberTracker-owned)
+    bool m_skipUnwatched = false;                // Decided once in run()
+    QuoteBatchReducer m_quoteReducer;            // conflation.reduceBatch (QuoteBatch.h), sized in start()
+    bool m_reduceQuotes = false;                 // Decided once in start()
+    std::uint64_t m_watchGeneration = 0;         // Last SubscriberTable::generation() acted on
+    const TimeSeriesCatalog* m_seriesCatalog = nullptr;  // writeTimeSeries (main-owned)
+    std::vector<TimeSeriesTrack> m_series;       // By slot, empty unless writeTimeSeries
+    std::unique_ptr<TapeBatch> m_tape;           // tapeLength > 0: the batch's trades
+    BasketBook* m_baskets = nullptr;             // computeBaskets (main-owned)
+    MoversExchange* m_moversExchange = nullptr;  // rankMovers (main-owned), posted by MoversTimer
+    MoversConfig m_moversConfig;
+    std::unique_ptr<MoverBoard> m_movers;        // rankMovers: this worker's slots in rank order
+    MoverRanking m_moversScratch;                // REASON: Swapped with the exchange's copy - reused every post
+    TimeSeriesBatch m_seriesBatch;               // Samples of the current drain batch (one TS.MADD)
+    
+    // ========== L2 Depth ==========
+    // REASON: Created on a slot's first depth update (most slots never get one), never freed
+    std::vector<std::unique_ptr<OrderBook>> m_books;
+    std::vector<SlotId> m_depthDirty;            // Books changed in this batch (Snapshot output)
+    std::vector<std::uint8_t> m_depthPending;    // By slot: already in m_depthDirty
+    
+    // ========== Option Chains ==========
+    // REASON: Created on a chain's first greek (most slots never get one), never freed
+    std::vector<std::unique_ptr<GreeksChain>> m_chains;
+    std::vector<SlotId> m_chainSlots;            // Slots with a chain, published by ChainTimer (armed with the first)
+    
+    // ========== Account ==========
+    AccountQueue* m_accountFeed = nullptr;       // streamAccount (main-owned), drained by AccountTimer
+    std::chrono::milliseconds m_accountInterval{500};
+    AccountTable m_account;
+    std::vector<AccountUpdate> m_accountBatch;   // REASON: Dequeue scratch, elements keep their string capacity
+
+    // ========== News ==========
+    NewsLane* m_newsLane = nullptr;              // streamNews (main-owned), drained by NewsTimer
+    ArticleFilter m_newsFilter{16};              // streamNews sizes it (dedupeCapacity)
+    std::vector<NewsItem> m_newsBatch;           // REASON: Dequeue scratch, elements keep their string capacity
+    std::string m_newsChannel;                   // REASON: Reused "TWS:NEWS:{SYMBOL}"
+    
+    // ========== Historical Bars ==========
+    // REASON: One HISTORICAL_DATA message = one series, its bars arrive back to back per slot
+    std::vector<std::vector<TickUpdate>> m_history;  // By slot, capacity kept (≤ historyChunkBars)
+    
+    // ========== Gap Backfill ==========
+    // REASON: Backfilled quotes / trades never touch the live state - kept aside, XADDed as one batch per
+    // reqHistoricalTicks answer (HistoryEnd + TickFlags::Backfill) or per kBackfillChunk ticks
+    static constexpr std::size_t kBackfillChunk = 1000;
+    std::vector<std::vector<TickUpdate>> m_backfill;  // By slot, capacity kept (≤ kBackfillChunk)
+    
+    // ========== Bar Store ==========
+    struct BarSeries {
+        std::string key;                         // "TWS:BARS:Z:{SYMBOL}:{barSize}", built on first bar
+        std::int64_t nextTrimMs = 0;             // Wall clock (ms)
+    };
+    struct BarStoreSlot {
+        BarSeries series[kBarSizeCount];         // By BarSize code
+    };
+    // REASON: Created on a slot's first stored bar (tick-only slots never get one), never freed
+    std::vector<std::unique_ptr<BarStoreSlot>> m_barStore;
+    
+    // ========== keepUpToDate bars (TickFlags::Live) ==========
+    struct LiveBar {
+        TickUpdate bar;                          // In-progress bar, latest revision (timestamp 0 = none yet)
+        bool pending = false;                    // Revised since LiveBarTimer last published it
+    };
+    // REASON: Created on a slot's first revision, never freed - the slot stays in m_liveBarSlots
+    std::vector<std::unique_ptr<LiveBar>> m_liveBars;
+    std::vector<SlotId> m_liveBarSlots;          // Published by LiveBarTimer (armed with the first)
+    
+    // ========== Bar Builder ==========
+    struct BuiltBarSlot {
+        explicit BuiltBarSlot(const BarBuilderConfig& config)
+            : builder(config.timeframes.data(), config.timeframes.size()) {}
+        BarBuilder builder;
+        std::string channels[BarBuilder::kMaxTimeframes];  // By builder timeframe index
+    };
+    // REASON: Created on a slot's first trade, never freed (m_barBuilderSlots lists them for the sweep)
+    std::vector<std::unique_ptr<BuiltBarSlot>> m_barBuilders;
+    std::vector<SlotId> m_barBuilderSlots;
+
+    // ========== Volume Profile ==========
+    // REASON: Created on a slot's first trade (quote-only slots never get one), never freed
+    std::vector<std::unique_ptr<VolumeProfile>> m_profiles;  // By slot, empty unless VolumeProfileConfig::enabled
+    std::vector<SlotId> m_profileDirty;          // Traded since the last ProfileTimer
+    std::vector<std::uint8_t> m_profilePending;  // By slot: already in m_profileDirty
+    std::string m_profilePayload;                // REASON: Reused for every delta / full profile
+
+    // ========== Session Statistics ==========
+    std::vector<SessionStats> m_sessions;        // By slot, empty unless SessionStatsConfig::enabled
+    std::vector<SlotId> m_sessionDirty;          // Changed since the last SessionTimer (SessionStats::dirty: listed)
+    std::int64_t m_sessionResetMs = 0;
+    std::string m_sessionChannel;                // REASON: Reused - "TWS:SESSION:" + symbol per publish
+    std::string m_sessionPayload;
+
+    // ========== State Checkpoint ==========
+    StateCheckpoint* m_checkpoint = nullptr;     // checkpointTo (main-owned)
+    QuoteTable* m_quotes = nullptr;              // serveQuotes (main-owned)
+    const CheckpointImage* m_restore = nullptr;  // Previous process's slots, by symbol
+    std::vector<SlotId> m_checkpointDirty;       // Slots changed since the last write (checkpoint and / or quotes)
+    std::vector<std::uint8_t> m_checkpointPending;  // By slot: already in m_checkpointDirty
+
+    // ========== Shard Rebalancing ==========
+    SlotMigration* m_migration = nullptr;        // rebalanceWith (router-owned)
+    std::vector<BasicRedisWorker*> m_peers;      // By shard index
+    std::chrono::milliseconds m_handoffTimeout{1000};
+    SlotId m_handoffSlot = kInvalidSlot;         // Handoff marker applied in this batch, handed off after it
+    std::uint32_t m_handoffGeneration = 0;
+
+    // ========== Batch Statistics ==========
+    std::vector<std::uint64_t> m_batchSizeCounts;  // Histogram: index = batch size
+    std::uint64_t m_batchCount = 0;
+    std::uint64_t m_updateCount = 0;
+    std::uint64_t m_publishedAtStart = 0;
+    std::uint64_t m_conflatedAtStart = 0;
+    std::uint64_t m_unchangedAtStart = 0;
+    std::uint64_t m_duplicatesAtStart = 0;
+    std::uint64_t m_droppedAtStart = 0;
+    std::uint64_t m_ingestDroppedAtStart = 0;
+    std::uint64_t m_ingestConflatedAtStart = 0;
+    std::uint64_t m_ingestSpilledAtStart = 0;
+    std::uint64_t m_ingestSupersededAtStart = 0;
+    std::chrono::steady_clock::time_point m_statsStart;
+    std::vector<TickUpdate> m_batch;             // PERFORMANCE: Sized once by start()
+    
+    // ========== Latency ==========
+    WorkerLatency m_latency;
+    std::int64_t m_batchDequeueNs = 0;           // Last stamped batch (Serialize stage start)
+    std::vector<LatencySnapshot> m_latencyPrevious;  // By LatencyStage, lifetime counts at the last report
+    LatencySnapshot m_latencyInterval;           // REASON: Scratch for the report (~9 KB, off the stack)
+    std::chrono::steady_clock::time_point m_latencyReportAt{};
+    LatencyReport m_lastLatency;
+    
+    // ========== Overflow Warnings (rate-limited, worker thread) ==========
+    std::uint64_t m_overflowLogged = 0;          // dropped + conflated + spilled at last warning
+    WorkerBatchStats m_lastStats;
+
+    Heartbeat m_heartbeat;
+
+    // ========== Consumer Lag ==========
+    // PERFORMANCE: Worker-written and main-written atomics on separate cache lines (both read by the other side)
+    alignas(64) std::atomic<LagLevel> m_lagLevel{LagLevel::Ok};  // Worker writes, any thread reads
+
+    // ========== Load Shedding ==========
+    std::atomic<std::int64_t> m_queueAgeNs{0};   // Worker writes, any thread reads
+    alignas(64) std::atomic<ShedLevel> m_requestedShedLevel{ShedLevel::Normal};  // setShedLevel (main thread)
+    ShedLevel m_shedLevel = ShedLevel::Normal;   // Level in effect (worker thread only)
+};
+
+extern template class BasicRedisWorker<MpmcTickQueue>;
+extern template class BasicRedisWorker<SpscTickQueue>;
+
+using RedisWorker = BasicRedisWorker<MpmcTickQueue>;
+using SpscRedisWorker = BasicRedisWorker<SpscTickQueue>;
+
+} // namespace tws_bridge
@@ -0,0 +1,186 @@
+// RequestPacer.h - Token-bucket scheduler for outbound TWS requests
+// SCOPE: Any thread submits (subscribe / cancel), the message thread pumps (sends via EClient)
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace tws_bridge {
+
+struct PacingConfig {
+    double messagesPerSecond = 45.0;   // REASON: TWS disconnects above 50 msg/s - keep headroom
+    double burst = 10.0;               // Bucket size (messages sendable back to back)
+    std::size_t maxTickByTick = 0;     // Concurrent tick-by-tick streams (account limit), 0 = unlimited
+};
+
+// Lifetime counters (pump thread writes, any thread reads)
+struct PacingCounters {
+    std::uint64_t sent = 0;            // Requests handed to EClient
+    std::uint64_t messages = 0;        // Outbound messages they cost
+    std::uint64_t withdrawn = 0;       // Removed before sending (superseded by a cancel)
+    std::uint64_t streamWaits = 0;     // Pump passes where a request waited for a free stream
+};
+
+// Orders requests by priority (FIFO within one priority), sends them no faster than the bucket
+// refills and never beyond the tick-by-tick stream limit
+// REASON: Cold path (subscriptions) - a mutex is fine, callbacks never touch the pacer
+// NOTE: send callbacks run outside the lock, on the pumping thread (EClient is not thread-safe)
+class RequestPacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Ticket = std::uint64_t;
+
+    // Priorities: higher first (cancels jump ahead - they free streams and never count against them)
+    static constexpr int kCancelPriority = 1 << 20;
+
+    explicit RequestPacer(PacingConfig config = {}, Clock::time_point now = Clock::now())
+        : m_config(config)
+        , m_tokens(config.burst)
+        , m_lastRefill(now) {
+    }
+
+    // cost: outbound messages, streams: tick-by-tick streams opened (> 0) or closed (< 0)
+    Ticket submit(int priority, unsigned cost, int streams, std::function<void()> send) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Ticket ticket = ++m_nextTicket;
+        m_pending.push_back(Request{priority, ticket, cost, streams, std::move(send)});
+        return ticket;
+    }
+
+    // Removes a request that has not been sent yet, false if already sent (or unknown)
+    bool withdraw(Ticket ticket) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+            if (it->ticket == ticket) {
+                m_pending.erase(it);
+                ++m_counters.withdrawn;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Sends every request the bucket and stream limit allow right now, returns count
+    std::size_t pump(Clock::time_point now = Clock::now()) {
+        std::vector<std::function<void()>> ready;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            refill(now);
+            bool streamBlocked = false;
+            while (!m_pending.empty()) {
+                std::size_t next = pickNext(streamBlocked);
+                if (next == m_pending.size()) {
+                    break;
+                }
+                Request& request = m_pending[next];
+                if (m_tokens < static_cast<double>(request.cost)) {
+                    break;  // REASON: Strict priority - lower ones don't overtake a waiting higher one
+                }
+                m_tokens -= static_cast<double>(request.cost);
+                m_activeStreams = static_cast<std::size_t>(static_cast<long long>(m_activeStreams) + request.streams);
+                m_counters.messages += request.cost;
+                ++m_counters.sent;
+                ready.push_back(std::move(request.send));
+                m_pending.erase(m_pending.begin() + static_cast<std::ptrdiff_t>(next));
+            }
+            if (streamBlocked) {
+                ++m_counters.streamWaits;
+            }
+        }
+        for (auto& send : ready) {
+            send();
+        }
+        return ready.size();
+    }
+
+    // New TWS session (reconnect, or error 1101 - data lost): TWS dropped every stream, so pending
+    // cancels are obsolete and the stream count restarts at 0; pending subscriptions stay queued
+    // Returns the cancels dropped
+    std::size_t resetSession() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::size_t before = m_pending.size();
+        m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                       [](const Request& request) {
+                                           return request.priority == kCancelPriority || request.streams < 0;
+                                       }),
+                        m_pending.end());
+        m_activeStreams = 0;
+        return before - m_pending.size();
+    }
+
+    std::size_t pending() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    std::size_t activeStreams() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_activeStreams;
+    }
+
+    PacingCounters counters() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_counters;
+    }
+
+private:
+    struct Request {
+        int priority;
+        Ticket ticket;      // Also the FIFO sequence within a priority
+        unsigned cost;
+        int streams;
+        std::function<void()> send;
+    };
+
+    void refill(Clock::time_point now) {
+        if (now <= m_lastRefill) {
+            return;
+        }
+        const double elapsed = std::chrono::duration<double>(now - m_lastRefill).count();
+        m_lastRefill = now;
+        m_tokens += elapsed * m_config.messagesPerSecond;
+        if (m_tokens > m_config.burst) {
+            m_tokens = m_config.burst;
+        }
+    }
+
+    bool streamsAvailable(const Request& request) const {
+        return request.streams <= 0 || m_config.maxTickByTick == 0
+               || m_activeStreams + static_cast<std::size_t>(request.streams) <= m_config.maxTickByTick;
+    }
+
+    // Highest priority request that may be sent (stream-blocked ones are skipped, not waited on)
+    // PERFORMANCE: Linear scan - pending lists are a few hundred entries at most, scanned per pump
+    std::size_t pickNext(bool& blocked) const {
+        std::size_t best = m_pending.size();
+        for (std::size_t i = 0; i < m_pending.size(); ++i) {
+            const Request& request = m_pending[i];
+            if (!streamsAvailable(request)) {
+                blocked = true;
+                continue;
+            }
+            if (best == m_pending.size() || request.priority > m_pending[best].priority
+                || (request.priority == m_pending[best].priority && request.ticket < m_pending[best].ticket)) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    PacingConfig m_config;
+    mutable std::mutex m_mutex;
+    std::vector<Request> m_pending;
+    double m_tokens;
+    Clock::time_point m_lastRefill;
+    std::size_t m_activeStreams = 0;
+    Ticket m_nextTicket = 0;
+    PacingCounters m_counters;
+};
+
+} // namespace tws_bridge
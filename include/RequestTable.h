@@ -0,0 +1,62 @@
+// RequestTable.h - Flat TWS request id → instrument slot table
+// SCOPE: Written at subscribe time (any thread), read by every market data callback
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace tws_bridge {
+
+// Fixed-capacity array indexed by reqId (replaces unordered_map<int, SlotId>)
+// PERFORMANCE: One bounds check + one load per callback, no hashing, no locks
+// REASON: Entries are individually atomic - subscribing while callbacks run is safe
+class RequestTable {
+public:
+    static constexpr std::size_t kDefaultCapacity = 65536;  // Covers tickerId + 10000 AllLast convention
+
+    explicit RequestTable(std::size_t capacity = kDefaultCapacity)
+        : m_capacity(capacity)
+        , m_slots(new std::atomic<SlotId>[capacity]) {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_slots[i].store(kInvalidSlot, std::memory_order_relaxed);
+        }
+    }
+
+    RequestTable(const RequestTable&) = delete;
+    RequestTable& operator=(const RequestTable&) = delete;
+
+    // Returns false if reqId is outside [0, capacity)
+    // NOTE: Release store - a callback that sees the slot also sees its registry data
+    bool publish(long long reqId, SlotId slot) {
+        if (!inRange(reqId)) {
+            return false;
+        }
+        m_slots[static_cast<std::size_t>(reqId)].store(slot, std::memory_order_release);
+        return true;
+    }
+
+    // CRITICAL PATH: kInvalidSlot for unknown or out-of-range ids
+    SlotId lookup(long long reqId) const {
+        if (!inRange(reqId)) {
+            return kInvalidSlot;
+        }
+        return m_slots[static_cast<std::size_t>(reqId)].load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    // REASON: Unsigned compare rejects negative ids in the same branch
+    // (long long: TickerId is long, no narrowing before the check)
+    bool inRange(long long reqId) const {
+        return static_cast<unsigned long long>(reqId) < m_capacity;
+    }
+
+    const std::size_t m_capacity;
+    std::unique_ptr<std::atomic<SlotId>[]> m_slots;
+};
+
+} // namespace tws_bridge
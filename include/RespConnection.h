@@ -0,0 +1,68 @@
+// RespConnection.h - Dedicated Redis socket fed by RespEncoder (no redis++ / hiredis on the batch path)
+// SCOPE: Redis sending thread only (worker, or the I/O thread when enabled)
+
+#pragma once
+
+#include "IoUring.h"
+#include "PublishMessage.h"
+#include "RedisUri.h"
+#include "RespEncoder.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+// One connection, one batch in flight: encode → one send → scan replies until all are in
+// PERFORMANCE: Per command cost is the byte copies into the encode buffer - no argv, no
+// redisReply objects, no per-command formatting call
+// NOTE: Single node only (no MOVED / ASK handling) - RedisPublisher keeps redis++ for Cluster mode
+// RespBackend::IoUring: the batch send, the reply read (into the registered reply buffer) and its
+// timeout are one linked chain - one io_uring_enter per round trip, completions drive the reply count
+class RespConnection {
+public:
+    RespConnection(RedisEndpoint endpoint, RedisConnectionPolicy policy, long long streamMaxLen, bool approximateTrim);
+    ~RespConnection();
+
+    RespConnection(const RespConnection&) = delete;
+    RespConnection& operator=(const RespConnection&) = delete;
+
+    // Pipelines the batch (connecting first if needed), returns once every reply arrived
+    // Throws std::runtime_error on a socket error, timeout or error reply - the connection is
+    // dropped and reopened by the next call
+    void send(const PublishMessage* messages, std::size_t count);
+
+    // Connects (and AUTH / SELECT) now instead of on the first batch; throws like send()
+    void open();
+    void close();
+    bool isOpen() const { return m_fd >= 0; }
+    bool usingIoUring() const { return m_ring != nullptr; }
+
+private:
+    void connectSocket();
+    std::size_t roundTrip(std::size_t expected, std::string& firstError);
+    void writeAll(const std::string& bytes);
+    ssize_t receive(char* into, std::size_t length);      // recv() semantics (-1 + errno)
+    ssize_t ringReceive(char* into, std::size_t length);  // Sends m_unsent first (same chain)
+    void registerInput();
+    // Blocks until `expected` replies arrived, returns how many were errors (first one's text in firstError)
+    std::size_t readReplies(std::size_t expected, std::string& firstError);
+
+    RedisEndpoint m_endpoint;
+    RedisConnectionPolicy m_policy;
+    RespEncoder m_encoder;
+    std::vector<char> m_input;                      // REASON: Reply bytes, capacity kept across batches
+    int m_fd = -1;
+
+    // ========== IoUring backend ==========
+    std::unique_ptr<IoUring> m_ring;                // nullptr = Socket backend (or io_uring unavailable)
+    const char* m_unsent = nullptr;                 // Request bytes not yet sent (go out with the next read)
+    std::size_t m_unsentLength = 0;
+    const char* m_registeredInput = nullptr;        // m_input as registered fixed buffer 0 (nullptr = plain RECV)
+    std::size_t m_registeredLength = 0;
+    __kernel_timespec m_timeout{};                  // Per read, like SO_RCVTIMEO on the Socket backend
+};
+
+} // namespace tws_bridge
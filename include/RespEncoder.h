@@ -0,0 +1,264 @@
+// RespEncoder.h - Direct RESP2 encoding of pipelined batches + bulk reply scanning
+// SCOPE: Redis sending thread (RespConnection), one encoder / scanner per connection
+
+#pragma once
+
+#include "PublishMessage.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+// Encodes a whole batch of PublishMessage commands into one reusable buffer (one write per batch)
+// PERFORMANCE (vs redis++ Pipeline → hiredis redisFormatCommandArgv):
+// - No argv / argvlen arrays, no per-command sds allocation - bytes are appended in place
+// - Command heads ("*3\r\n$7\r\nPUBLISH\r\n") are constants, the XADD MAXLEN tail is built once
+// - The buffer keeps its capacity across batches (no allocation in steady state)
+class RespEncoder {
+public:
+    RespEncoder(long long streamMaxLen = 10000, bool approximateTrim = true) {
+        // XADD key MAXLEN [~] N * data payload
+        m_streamHead = approximateTrim ? "*8\r\n$4\r\nXADD\r\n" : "*7\r\n$4\r\nXADD\r\n";
+        m_streamTail = approximateTrim ? "$6\r\nMAXLEN\r\n$1\r\n~\r\n" : "$6\r\nMAXLEN\r\n";
+        appendBulk(m_streamTail, std::to_string(streamMaxLen));
+        m_streamTail += "$1\r\n*\r\n$4\r\ndata\r\n";
+    }
+
+    // Appends the command(s) for message, returns the replies they produce
+    std::size_t append(const PublishMessage& message) {
+        switch (message.command) {
+        case RedisCommand::StreamAdd:
+            m_buffer += m_streamHead;
+            appendBulk(m_buffer, message.channel);
+            m_buffer += m_streamTail;
+            appendBulk(m_buffer, message.payload);
+            return 1;
+        case RedisCommand::Set:
+            m_buffer += "*3\r\n$3\r\nSET\r\n";
+            appendBulk(m_buffer, message.channel);
+            appendBulk(m_buffer, message.payload);
+            return 1;
+        case RedisCommand::SortedSetAdd: {
+            // REASON: Same pair as RedisPublisher::appendCommand - the score's previous member is replaced
+            char score[32];
+            const std::string_view text = formatScore(message.score, score, sizeof(score));
+            m_buffer += "*4\r\n$16\r\nZREMRANGEBYSCORE\r\n";
+            appendBulk(m_buffer, message.channel);
+            appendBulk(m_buffer, text);
+            appendBulk(m_buffer, text);
+            m_buffer += "*4\r\n$4\r\nZADD\r\n";
+            appendBulk(m_buffer, message.channel);
+            appendBulk(m_buffer, text);
+            appendBulk(m_buffer, message.payload);
+            return 2;
+        }
+        case RedisCommand::SortedSetTrim: {
+            char score[32];
+            score[0] = '(';  // Exclusive: members scored below minScore
+            const std::string_view text = formatScore(message.score, score + 1, sizeof(score) - 1);
+            m_buffer += "*4\r\n$16\r\nZREMRANGEBYSCORE\r\n";
+            appendBulk(m_buffer, message.channel);
+            m_buffer += "$4\r\n-inf\r\n";
+            appendBulk(m_buffer, std::string_view(score, text.size() + 1));
+            return 1;
+        }
+        case RedisCommand::HashSet: {
+            const std::size_t parts = forEachHashPart(message.payload, [](std::string_view) {});
+            m_buffer += '*';
+            m_buffer += std::to_string(2 + parts);
+            m_buffer += "\r\n$4\r\nHSET\r\n";
+            appendBulk(m_buffer, message.channel);
+            forEachHashPart(message.payload, [this](std::string_view part) { appendBulk(m_buffer, part); });
+            return 1;
+        }
+        case RedisCommand::TimeSeriesAdd: {
+            const std::size_t parts = forEachHashPart(message.payload, [](std::string_view) {});
+            m_buffer += '*';
+            m_buffer += std::to_string(1 + parts);
+            m_buffer += "\r\n$7\r\nTS.MADD\r\n";
+            forEachHashPart(message.payload, [this](std::string_view part) { appendBulk(m_buffer, part); });
+            return 1;
+        }
+        case RedisCommand::ListPush: {
+            const std::size_t parts = forEachHashPart(message.payload, [](std::string_view) {});
+            m_buffer += '*';
+            m_buffer += std::to_string(2 + parts);
+            m_buffer += "\r\n$5\r\nLPUSH\r\n";
+            appendBulk(m_buffer, message.channel);
+            forEachHashPart(message.payload, [this](std::string_view part) { appendBulk(m_buffer, part); });
+            m_buffer += "*4\r\n$5\r\nLTRIM\r\n";
+            appendBulk(m_buffer, message.channel);
+            m_buffer += "$1\r\n0\r\n";
+            appendBulk(m_buffer, std::to_string(static_cast<long long>(message.score) - 1));
+            return 2;
+        }
+        case RedisCommand::Publish:
+            break;
+        }
+        m_buffer += "*3\r\n$7\r\nPUBLISH\r\n";
+        appendBulk(m_buffer, message.channel);
+        appendBulk(m_buffer, message.payload);
+        return 1;
+    }
+
+    // Any command (connection setup: AUTH, SELECT), one reply
+    std::size_t appendCommand(std::initializer_list<std::string_view> args) {
+        m_buffer += '*';
+        m_buffer += std::to_string(args.size());
+        m_buffer += "\r\n";
+        for (std::string_view arg : args) {
+            appendBulk(m_buffer, arg);
+        }
+        return 1;
+    }
+
+    const std::string& buffer() const { return m_buffer; }
+    void clear() { m_buffer.clear(); }  // REASON: Capacity kept for the next batch
+
+private:
+    static void appendBulk(std::string& out, std::string_view bytes) {
+        char length[24];
+        const int digits = std::snprintf(length, sizeof(length), "$%zu\r\n", bytes.size());
+        out.append(length, static_cast<std::size_t>(digits));
+        out.append(bytes.data(), bytes.size());
+        out += "\r\n";
+    }
+
+    // REASON: %.17g round-trips every double (bar timestamps are integral ms - printed without exponent)
+    static std::string_view formatScore(double score, char* out, std::size_t size) {
+        const int length = std::snprintf(out, size, "%.17g", score);
+        return std::string_view(out, length > 0 ? static_cast<std::size_t>(length) : 0);
+    }
+
+    std::string m_buffer;
+    std::string m_streamHead;
+    std::string m_streamTail;                       // MAXLEN [~] N * data
+};
+
+// Outcome of scanning the reply bytes received so far
+struct RespScan {
+    std::size_t replies = 0;                        // Complete top-level replies
+    std::size_t errors = 0;                         // Of which error replies (-ERR ...)
+    std::size_t consumed = 0;                       // Bytes they span (the rest is a partial reply)
+    bool malformed = false;                         // Not RESP - the connection must be dropped
+    std::string_view firstError;                    // Text of the first error reply (view into the input)
+};
+
+// Skims replies without building reply objects - a publish batch only needs "how many, any errors"
+// PERFORMANCE: One pass over the received bytes, no allocation (hiredis builds a redisReply per reply)
+inline RespScan scanRespReplies(const char* data, std::size_t size, std::size_t maxReplies) {
+    RespScan scan;
+    const char* const end = data + size;
+    const char* p = data;
+
+    // Line after the type byte: [p, CR), returns the byte after LF or nullptr if incomplete
+    auto line = [end](const char* from, std::string_view& text) -> const char* {
+        for (const char* q = from; q + 1 < end; ++q) {
+            if (q[0] == '\r' && q[1] == '\n') {
+                text = std::string_view(from, static_cast<std::size_t>(q - from));
+                return q + 2;
+            }
+        }
+        return nullptr;
+    };
+    auto number = [](std::string_view text, long long& value) {
+        bool negative = !text.empty() && text.front() == '-';
+        if (negative) {
+            text.remove_prefix(1);
+        }
+        if (text.empty()) {
+            return false;
+        }
+        value = 0;
+        for (char c : text) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        value = negative ? -value : value;
+        return true;
+    };
+
+    // One reply (arrays recurse), 1 = complete, 0 = incomplete, -1 = malformed
+    auto skip = [&](auto& self, const char*& at, bool topLevel) -> int {
+        if (at >= end) {
+            return 0;
+        }
+        const char type = *at;
+        std::string_view text;
+        const char* next = line(at + 1, text);
+        if (!next) {
+            return 0;
+        }
+        long long count = 0;
+        switch (type) {
+        case '+':
+        case ':':
+        case '_':  // RESP3 null, double, boolean, big number
+        case ',':
+        case '#':
+        case '(':
+            at = next;
+            return 1;
+        case '-':
+            if (topLevel) {
+                if (scan.errors++ == 0) {
+                    scan.firstError = text;
+                }
+            }
+            at = next;
+            return 1;
+        case '$':
+            if (!number(text, count)) {
+                return -1;
+            }
+            if (count < 0) {
+                at = next;
+                return 1;
+            }
+            if (end - next < count + 2) {
+                return 0;
+            }
+            at = next + count + 2;
+            return 1;
+        case '*':
+        case '%':  // RESP3 map (2 elements per entry), set, push
+        case '~':
+        case '>':
+            if (!number(text, count)) {
+                return -1;
+            }
+            count = type == '%' ? count * 2 : count;
+            at = next;
+            for (long long i = 0; i < count; ++i) {
+                const int element = self(self, at, false);
+                if (element != 1) {
+                    return element;
+                }
+            }
+            return 1;
+        default:
+            return -1;
+        }
+    };
+
+    while (scan.replies < maxReplies) {
+        const char* at = p;
+        const int result = skip(skip, at, true);
+        if (result <= 0) {
+            scan.malformed = result < 0;
+            break;  // REASON: A partial reply is scanned again once the rest arrived
+        }
+        p = at;
+        ++scan.replies;
+    }
+    scan.consumed = static_cast<std::size_t>(p - data);
+    return scan;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,112 @@
+// SamplingProfiler.h - On-demand CPU sampling of the bridge's own threads, written as folded stacks
+// SCOPE: SIGPROF handler on the profiled threads (lock-free record, see ProfilerSignal.h), own thread otherwise
+// (waits for {"action":"profile"} from the command listener, symbolizes, writes the file / Redis key)
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace tws_bridge {
+
+// profiler: {"action":"profile","duration":30} on TWS:COMMANDS samples the running bridge - no perf,
+// no ptrace, no CAP_SYS_ADMIN in the container
+struct ProfilerConfig {
+    bool enabled = false;                           // Off: profile commands are rejected
+    int frequency = 99;                             // Samples per CPU second of each profiled thread
+    std::chrono::seconds defaultDuration{30};       // Command without "duration"
+    std::chrono::seconds maxDuration{300};          // Longer requests are capped
+    std::size_t maxSamples = 32768;                 // ~400 bytes each, allocated by the first profile and kept
+    std::string dir = ".";                          // profile-{epochMs}.folded
+    std::string key;                                // Non-empty: the folded text is also SET here (Redis)
+};
+
+// One stack: frames innermost first, as the SIGPROF handler found them
+struct ProfileSample {
+    static constexpr int kMaxFrames = 48;
+
+    std::atomic<bool> ready{false};                 // Handler finished writing (aggregation skips the rest)
+    std::int32_t tid = 0;
+    std::int32_t depth = 0;
+    void* frames[kMaxFrames];
+};
+
+// Folded-stack text (flamegraph.pl / speedscope / inferno): "thread;outer;...;inner count", one line per
+// distinct stack, sorted by stack
+// REASON: Pure function of the aggregated counts - unit-testable without a signal or a symbol table
+std::string formatFoldedStacks(const std::map<std::string, std::uint64_t>& stacks);
+
+/**
+ * One CPU-time timer per profiled thread (ProfilerSignal.h: tws-msg, tws-reader, the workers, tws-redis-io)
+ * at `frequency` Hz of that thread's own CPU time, each sending SIGPROF to its thread only - samples land
+ * in proportion to the CPU each thread burns (idle threads are never sampled). The handler claims the next preallocated sample with one fetch_add and fills it with
+ * backtrace(); the profiler thread folds the samples by thread name (/proc/self/task/{tid}/comm) and
+ * symbol (dladdr + demangle) once the duration has elapsed.
+ *
+ * PERFORMANCE: Nothing is armed between profiles. While one runs, each sample costs the interrupted
+ * thread one signal delivery plus an unwind (a few microseconds) - 99 Hz is ~0.05% of one core
+ * PITFALL: SIGPROF interrupts blocking system calls; SA_RESTART resumes most of them, but poll / epoll /
+ * select / nanosleep return EINTR. Every other thread keeps SIGPROF blocked (main() blocks it before the
+ * first thread starts) and is never sampled - profiling a new thread means auditing each of its blocking
+ * calls first, then profileCurrentThread()
+ * PITFALL: Frames resolve through the dynamic symbol table (tws_bridge links with ENABLE_EXPORTS) - static
+ * and anonymous-namespace functions show as module+0xoffset (addr2line -f -C -e <module> 0xoffset)
+ * NOTE: One profiler per process (the SIGPROF handler is process-wide) - a second instance's requests
+ * are rejected
+ */
+class SamplingProfiler {
+public:
+    SamplingProfiler(const std::string& redisUri, const ProfilerConfig& config);
+    ~SamplingProfiler();
+
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    // Profiler thread ("tws-profiler")
+    void start();
+    void stop();
+
+    // Any thread: sample for duration (0 = defaultDuration, capped at maxDuration)
+    // false (error says why) while a profile is already running
+    bool request(std::chrono::seconds duration, std::string& error);
+
+    std::uint64_t profiles() const { return m_profiles.load(std::memory_order_relaxed); }
+    std::uint64_t samples() const { return m_samplesTaken.load(std::memory_order_relaxed); }
+    // Samples lost because maxSamples was reached
+    std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    // Path of the last folded file ("" = none yet)
+    std::string lastProfile() const;
+
+private:
+    void run();
+    void profile(std::chrono::seconds duration);
+    std::map<std::string, std::uint64_t> fold(std::size_t count);
+    void write(const std::string& folded, std::size_t count);
+
+    std::string m_redisUri;
+    ProfilerConfig m_config;
+    std::unique_ptr<ProfileSample[]> m_samples;     // maxSamples, shared with the SIGPROF handler while armed
+    bool m_owner = false;                           // This instance holds the process's SIGPROF
+
+    std::atomic<std::uint64_t> m_profiles{0};
+    std::atomic<std::uint64_t> m_samplesTaken{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_busy = false;                            // Requested or sampling, guarded by m_mutex
+    bool m_stopping = false;                        // Guarded by m_mutex
+    std::chrono::seconds m_duration{0};             // Guarded by m_mutex
+    std::string m_lastProfile;                      // Guarded by m_mutex
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
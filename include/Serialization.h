@@ -1,58 +1,134 @@
 #pragma once
 
+#include "CommandBatch.h"
+#include "IsoTimestamp.h"
+#include "LatencyHistogram.h"
+#include "LoadShedder.h"
+#include "MarketScanner.h"
 #include "MarketData.h"
+#include "NewsFeed.h"
+#include "Quantity.h"
+#include "OrderBook.h"
+#include "SessionReport.h"
+#include "StatusHeartbeat.h"
+#include "TopMovers.h"
+#include "TradeCodes.h"
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
+#include <algorithm>
+#include <cstddef>
 #include <string>
-#include <sstream>
-#include <iomanip>
-#include <ctime>
+#include <string_view>
 
 /**
- * @brief Format Unix timestamp (ms) to ISO 8601 string
+ * @brief Format Unix timestamp (ms) to ISO 8601 string ("2023-11-14T22:13:20.123Z")
  * 
- * [PERFORMANCE] Simple implementation for MVP. For production, consider
- * C++20 std::format or Howard Hinnant's date library.
+ * [PERFORMANCE] Allocating convenience wrapper - hot paths write straight into their
+ * buffer with tws_bridge::formatIsoTimestamp() (cached per thread, no gmtime / locale).
  */
 inline std::string formatTimestamp(long timestampMs) {
-    std::time_t seconds = timestampMs / 1000;
-    int milliseconds = timestampMs % 1000;
+    char buffer[tws_bridge::IsoTimestampFormatter::kLength];
+    tws_bridge::formatIsoTimestamp(timestampMs, buffer);
+    return std::string(buffer, sizeof(buffer));
+}
+
+/**
+ * @brief Snapshot field-name schema
+ * 
+ * [PERFORMANCE] Compact cuts payload size roughly in half for >100K msg/s setups
+ * (docs/PROJECT-SPECIFICATION.md §3.4.2, "Compact Field Names").
+ */
+enum class SnapshotSchema {
+    Verbose,  // "instrument", "price": {"bid", ...} (default, §3.4.2)
+    Compact   // "sym", "p": {"b", ...}
+};
+
+// Number layout of snapshot prices (bid / ask / last) - encodeSnapshot() only
+enum class PriceFormat {
+    Shortest,   // Shortest round-trip double (RapidJSON Writer::Double layout)
+    FixedPoint  // Rounded to 1e-4 ticks, integer formatting (FixedPrice.h) - no 171.55000000000001
+};
+
+/**
+ * @brief Reusable JSON output buffer + writer (one per serializing thread)
+ * 
+ * [PERFORMANCE] Clear() keeps the buffer capacity and Reset() keeps the
+ * writer's level stack, so after warm-up serialization does no heap allocation.
+ */
+struct JsonBuffer {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer{buffer};
     
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&seconds), "%Y-%m-%dT%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << milliseconds << 'Z';
+    rapidjson::Writer<rapidjson::StringBuffer>& reset() {
+        buffer.Clear();
+        writer.Reset(buffer);
+        return writer;
+    }
     
-    return ss.str();
+    const char* data() const { return buffer.GetString(); }
+    std::size_t size() const { return buffer.GetSize(); }
+    std::string str() const { return std::string(data(), size()); }
+};
+
+/**
+ * @brief Write a scaled-integer size (Quantity.h) as a JSON number
+ *
+ * [NOTE] Whole sizes go through Int64 as before; fractional ones as raw number text, the same
+ * digits SnapshotEncoder writes ("0.5", "1.25").
+ */
+inline void writeQuantity(rapidjson::Writer<rapidjson::StringBuffer>& writer, tws_bridge::Quantity quantity) {
+    if (quantity.scale == 0) {
+        writer.Int64(quantity.units);
+        return;
+    }
+    char text[tws_bridge::kQuantityMaxChars];
+    const char* end = tws_bridge::writeQuantity(text, quantity);
+    writer.RawValue(text, static_cast<std::size_t>(end - text), rapidjson::kNumberType);
 }
 
 /**
- * @brief Serialize InstrumentState to JSON using RapidJSON Writer API
+ * @brief Serialize InstrumentState to JSON into a reusable buffer
  * 
- * [PERFORMANCE] Uses SAX-style Writer (not DOM) for minimal allocations.
+ * [PERFORMANCE] Uses SAX-style Writer (not DOM), no allocation once `out` is warm.
  * Target: 10-50μs per message.
  * 
  * @param state Complete instrument state snapshot
- * @return JSON string matching schema in docs/PROJECT-SPECIFICATION.md §3.4.2
+ * @param out Caller-owned buffer, cleared first (result in out.data()/out.size())
+ * @param withDerived Append "derived": {"mid", "spread", "vwap", "rollingVolume"} (state.derived)
+ * @param withIsoTime Add "time": "YYYY-MM-DDTHH:MM:SS.mmmZ" (same instant as "timestamp")
+ * "received" (local receive time, Unix ns) is written whenever state.receiveNs is set.
  */
-inline std::string serializeState(const InstrumentState& state) {
-    using namespace rapidjson;
-    
-    StringBuffer buffer;
-    Writer<StringBuffer> writer(buffer);
+inline void serializeState(const InstrumentState& state, JsonBuffer& out, bool withDerived = false,
+                           bool withIsoTime = false) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
     
     writer.StartObject();
     
     // Metadata
     writer.Key("instrument");
-    writer.String(state.symbol.c_str());
+    writer.String(state.symbol.data(), static_cast<rapidjson::SizeType>(state.symbol.size()));
+    writer.Key("seq");
+    writer.Uint64(state.sequence);
     
     writer.Key("conId");
     writer.Int(state.conId);
+    writer.Key("primaryExchange");
+    writer.String(state.primaryExchange.data(), static_cast<rapidjson::SizeType>(state.primaryExchange.size()));
     
     // Use most recent timestamp (quote or trade)
     long latestTimestamp = std::max(state.quoteTimestamp, state.tradeTimestamp);
     writer.Key("timestamp");
     writer.Int64(latestTimestamp);
+    if (withIsoTime) {
+        char iso[tws_bridge::IsoTimestampFormatter::kLength];
+        tws_bridge::formatIsoTimestamp(latestTimestamp, iso);
+        writer.Key("time");
+        writer.String(iso, static_cast<rapidjson::SizeType>(sizeof(iso)));
+    }
+    if (state.receiveNs != 0) {
+        writer.Key("received");
+        writer.Int64(state.receiveNs);
+    }
     
     // Price nested object
     writer.Key("price");
@@ -65,9 +141,9 @@ inline std::string serializeState(const InstrumentState& state) {
     // Size nested object
     writer.Key("size");
     writer.StartObject();
-    writer.Key("bid"); writer.Int(state.bidSize);
-    writer.Key("ask"); writer.Int(state.askSize);
-    writer.Key("last"); writer.Int(state.lastSize);
+    writer.Key("bid"); writeQuantity(writer, state.bidQuantity());
+    writer.Key("ask"); writeQuantity(writer, state.askQuantity());
+    writer.Key("last"); writeQuantity(writer, state.lastQuantity());
     writer.EndObject();
     
     // Separate timestamps for quote vs trade
@@ -77,9 +153,13 @@ inline std::string serializeState(const InstrumentState& state) {
     writer.Key("trade"); writer.Int64(state.tradeTimestamp);
     writer.EndObject();
     
-    // Exchange
+    // Exchange + sale conditions of the last trade
     writer.Key("exchange");
-    writer.String(state.exchange.c_str());
+    writer.String(state.exchange.data(), static_cast<rapidjson::SizeType>(state.exchange.size()));
+    char conditions[tws_bridge::kTradeConditionsMaxChars];
+    writer.Key("conditions");
+    writer.String(conditions, static_cast<rapidjson::SizeType>(
+                                  tws_bridge::writeTradeConditions(conditions, state.tradeConditions) - conditions));
     
     // Tick attributes
     writer.Key("tickAttrib");
@@ -87,58 +167,700 @@ inline std::string serializeState(const InstrumentState& state) {
     writer.Key("pastLimit"); writer.Bool(state.pastLimit);
     writer.EndObject();
     
-    writer.EndObject();
+    if (withDerived) {
+        writer.Key("derived");
+        writer.StartObject();
+        writer.Key("mid"); writer.Double(state.derived.mid);
+        writer.Key("spread"); writer.Double(state.derived.spread);
+        writer.Key("vwap"); writer.Double(state.derived.vwap);
+        writer.Key("rollingVolume"); writer.Int64(state.derived.rolling.total());
+        writer.EndObject();
+    }
     
-    return buffer.GetString();
+    writer.EndObject();
 }
 
 /**
- * @brief Serialize bar data to JSON using RapidJSON Writer API
+ * @brief Serialize InstrumentState with compact field names into a reusable buffer
  * 
- * [PERFORMANCE] SAX-style Writer for minimal allocations.
- * Used for historical bar data (reqHistoricalData callbacks).
- * 
- * @param symbol Instrument symbol
- * @param update TickUpdate containing bar data
- * @return JSON string with OHLCV data
+ * Reference implementation for SnapshotSchema::Compact (see encodeSnapshot()).
  */
-inline std::string serializeBarData(const std::string& symbol, const TickUpdate& update) {
-    using namespace rapidjson;
+inline void serializeStateCompact(const InstrumentState& state, JsonBuffer& out, bool withDerived = false,
+                                  bool withIsoTime = false) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
     
-    StringBuffer buffer;
-    Writer<StringBuffer> writer(buffer);
+    writer.Key("sym");
+    writer.String(state.symbol.data(), static_cast<rapidjson::SizeType>(state.symbol.size()));
+    writer.Key("sq"); writer.Uint64(state.sequence);
+    writer.Key("cid"); writer.Int(state.conId);
+    writer.Key("pex");
+    writer.String(state.primaryExchange.data(), static_cast<rapidjson::SizeType>(state.primaryExchange.size()));
+    writer.Key("ts"); writer.Int64(std::max(state.quoteTimestamp, state.tradeTimestamp));
+    if (withIsoTime) {
+        char iso[tws_bridge::IsoTimestampFormatter::kLength];
+        tws_bridge::formatIsoTimestamp(std::max(state.quoteTimestamp, state.tradeTimestamp), iso);
+        writer.Key("tm"); writer.String(iso, static_cast<rapidjson::SizeType>(sizeof(iso)));
+    }
+    if (state.receiveNs != 0) {
+        writer.Key("rc"); writer.Int64(state.receiveNs);
+    }
     
+    writer.Key("p");
     writer.StartObject();
+    writer.Key("b"); writer.Double(state.bidPrice);
+    writer.Key("a"); writer.Double(state.askPrice);
+    writer.Key("l"); writer.Double(state.lastPrice);
+    writer.EndObject();
     
-    writer.Key("symbol");
-    writer.String(symbol.c_str());
+    writer.Key("s");
+    writer.StartObject();
+    writer.Key("b"); writeQuantity(writer, state.bidQuantity());
+    writer.Key("a"); writeQuantity(writer, state.askQuantity());
+    writer.Key("l"); writeQuantity(writer, state.lastQuantity());
+    writer.EndObject();
+    
+    writer.Key("tss");
+    writer.StartObject();
+    writer.Key("q"); writer.Int64(state.quoteTimestamp);
+    writer.Key("t"); writer.Int64(state.tradeTimestamp);
+    writer.EndObject();
+    
+    writer.Key("ex");
+    writer.String(state.exchange.data(), static_cast<rapidjson::SizeType>(state.exchange.size()));
+    char conditions[tws_bridge::kTradeConditionsMaxChars];
+    writer.Key("cnd");
+    writer.String(conditions, static_cast<rapidjson::SizeType>(
+                                  tws_bridge::writeTradeConditions(conditions, state.tradeConditions) - conditions));
+    
+    writer.Key("attr");
+    writer.StartObject();
+    writer.Key("pl"); writer.Bool(state.pastLimit);
+    writer.EndObject();
+    
+    if (withDerived) {
+        writer.Key("d");
+        writer.StartObject();
+        writer.Key("m"); writer.Double(state.derived.mid);
+        writer.Key("sp"); writer.Double(state.derived.spread);
+        writer.Key("vw"); writer.Double(state.derived.vwap);
+        writer.Key("rv"); writer.Int64(state.derived.rolling.total());
+        writer.EndObject();
+    }
     
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize InstrumentState to a JSON string (allocating convenience wrapper)
+ * 
+ * @return JSON string matching schema in docs/PROJECT-SPECIFICATION.md §3.4.2
+ */
+inline std::string serializeState(const InstrumentState& state) {
+    JsonBuffer out;
+    serializeState(state, out);
+    return out.str();
+}
+
+// OHLCV fields of one bar (shared by single-bar and history payloads)
+inline void writeBarFields(rapidjson::Writer<rapidjson::StringBuffer>& writer, const TickUpdate& update) {
     writer.Key("timestamp");
     writer.Int64(update.timestamp);
     
     writer.Key("open");
-    writer.Double(update.open);
+    writer.Double(update.bar.open);
     
     writer.Key("high");
-    writer.Double(update.high);
+    writer.Double(update.bar.high);
     
     writer.Key("low");
-    writer.Double(update.low);
+    writer.Double(update.bar.low);
     
     writer.Key("close");
-    writer.Double(update.close);
+    writer.Double(update.bar.close);
     
     writer.Key("volume");
-    writer.Int64(update.volume);
+    writer.Int64(update.bar.volume);
     
     writer.Key("wap");
-    writer.Double(update.wap);
+    writer.Double(update.bar.wap);
     
     writer.Key("barCount");
-    writer.Int(update.barCount);
+    writer.Uint(update.aux);
+}
+
+/**
+ * @brief Serialize bar data to JSON into a reusable buffer
+ * 
+ * [PERFORMANCE] SAX-style Writer, no allocation once `out` is warm.
+ * Used for real-time bars (historical series go through serializeBarHistory).
+ * 
+ * @param symbol Instrument symbol
+ * @param update TickUpdate containing bar data
+ * @param out Caller-owned buffer, cleared first (OHLCV JSON)
+ */
+inline void serializeBarData(const std::string& symbol, const TickUpdate& update, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    
+    writer.Key("symbol");
+    writer.String(symbol.data(), static_cast<rapidjson::SizeType>(symbol.size()));
+    
+    writeBarFields(writer, update);
+    
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize a historical bar series (one reqHistoricalData response) as one payload
+ * 
+ * {"symbol", "complete", "bars": [{"timestamp", "open", ...}, ...]} - bar objects match
+ * serializeBarData without the symbol. complete = false: more chunks of the series follow.
+ */
+inline void serializeBarHistory(const std::string& symbol, const TickUpdate* bars, std::size_t count,
+                                bool complete, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("symbol");
+    writer.String(symbol.data(), static_cast<rapidjson::SizeType>(symbol.size()));
+    writer.Key("complete");
+    writer.Bool(complete);
+    writer.Key("bars");
+    writer.StartArray();
+    for (std::size_t i = 0; i < count; ++i) {
+        writer.StartObject();
+        writeBarFields(writer, bars[i]);
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one bar as a positional array (TWS:BARS:Z:* sorted-set member)
+ *
+ * [timestamp, open, high, low, close, volume, wap, barCount] - no keys, no symbol (both are
+ * in the sorted-set key); ZRANGEBYSCORE returns thousands of these per chart load.
+ */
+inline void serializeBarCompact(const TickUpdate& update, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+
+    writer.StartArray();
+    writer.Int64(update.timestamp);
+    writer.Double(update.bar.open);
+    writer.Double(update.bar.high);
+    writer.Double(update.bar.low);
+    writer.Double(update.bar.close);
+    writer.Int64(update.bar.volume);
+    writer.Double(update.bar.wap);
+    writer.Uint(update.aux);
+    writer.EndArray();
+}
+
+/**
+ * @brief Serialize bar data to a JSON string (allocating convenience wrapper)
+ */
+inline std::string serializeBarData(const std::string& symbol, const TickUpdate& update) {
+    JsonBuffer out;
+    serializeBarData(symbol, update, out);
+    return out.str();
+}
+
+/**
+ * @brief Serialize the top levels of an order book into a reusable buffer
+ * 
+ * [PERFORMANCE] SAX-style Writer, no allocation once `out` is warm.
+ * Levels are [price, size] pairs, best first: {"symbol", "timestamp", "bids": [[p, s], ...], "asks": [...]}
+ * 
+ * @param levels Max levels per side (fewer if the book is shallower)
+ */
+inline void serializeDepthSnapshot(const std::string& symbol, const tws_bridge::OrderBook& book, std::size_t levels,
+                                   JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    auto writeSide = [&writer, levels](const tws_bridge::DepthSide& side) {
+        writer.StartArray();
+        const std::size_t count = std::min(levels, side.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            writer.StartArray();
+            writer.Double(side[i].price);
+            writer.Int64(side[i].size);
+            writer.EndArray();
+        }
+        writer.EndArray();
+    };
+    
+    writer.StartObject();
+    writer.Key("symbol");
+    writer.String(symbol.data(), static_cast<rapidjson::SizeType>(symbol.size()));
+    writer.Key("timestamp");
+    writer.Int64(book.timestamp);
+    writer.Key("bids");
+    writeSide(book.bids);
+    writer.Key("asks");
+    writeSide(book.asks);
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one depth change (DepthOutput::Delta) into a reusable buffer
+ * 
+ * {"symbol", "timestamp", "side": "bid"|"ask", "op": "insert"|"update"|"delete"|"reset", "position", "price", "size"}
+ */
+inline void serializeDepthDelta(const std::string& symbol, const TickUpdate& update, JsonBuffer& out) {
+    static constexpr const char* kOperations[] = {"insert", "update", "delete", "reset"};
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("symbol");
+    writer.String(symbol.data(), static_cast<rapidjson::SizeType>(symbol.size()));
+    writer.Key("timestamp");
+    writer.Int64(update.timestamp);
+    writer.Key("side");
+    writer.String(update.depth.side == tws_bridge::depth::kBid ? "bid" : "ask");
+    writer.Key("op");
+    writer.String(update.depth.operation <= tws_bridge::depth::kReset ? kOperations[update.depth.operation] : "unknown");
+    writer.Key("position");
+    writer.Uint(update.depth.position);
+    writer.Key("price");
+    writer.Double(update.depth.price);
+    writer.Key("size");
+    writer.Int64(update.depth.size);
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one interval's per-stage latency percentiles (TWS:STATUS) into a reusable buffer
+ * 
+ * {"type": "latency", "shard", "timestamp", "intervalMs", "unit": "ns",
+ *  "stages": {"ingest": {"count", "p50", "p99", "p999", "max"}, "queue", "serialize", "publish", "endToEnd"}}
+ */
+inline void serializeLatencyStatus(std::size_t shard, std::int64_t timestampMs, std::int64_t intervalMs,
+                                   const tws_bridge::LatencyReport& report, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("latency");
+    writer.Key("shard");
+    writer.Uint64(shard);
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("intervalMs");
+    writer.Int64(intervalMs);
+    writer.Key("unit");
+    writer.String("ns");
+    writer.Key("stages");
+    writer.StartObject();
+    for (std::size_t i = 0; i < tws_bridge::kLatencyStageCount; ++i) {
+        const tws_bridge::LatencyReport::Stage& stage = report.stages[i];
+        writer.Key(tws_bridge::latencyStageName(static_cast<tws_bridge::LatencyStage>(i)));
+        writer.StartObject();
+        writer.Key("count");
+        writer.Uint64(stage.count);
+        writer.Key("p50");
+        writer.Int64(stage.p50);
+        writer.Key("p99");
+        writer.Int64(stage.p99);
+        writer.Key("p999");
+        writer.Int64(stage.p999);
+        writer.Key("max");
+        writer.Int64(stage.max);
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize a shard's consumer lag level change (TWS:STATUS) into a reusable buffer
+ * 
+ * {"type": "queue_lag", "shard", "timestamp", "level", "previous", "ageMs", "queueDepth"}
+ */
+inline void serializeLagStatus(std::size_t shard, std::int64_t timestampMs, const char* level, const char* previous,
+                               std::int64_t ageMs, std::size_t queueDepth, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("queue_lag");
+    writer.Key("shard");
+    writer.Uint64(shard);
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("level");
+    writer.String(level);
+    writer.Key("previous");
+    writer.String(previous);
+    writer.Key("ageMs");
+    writer.Int64(ageMs);
+    writer.Key("queueDepth");
+    writer.Uint64(queueDepth);
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize a stage watchdog report (TWS:STATUS) into a reusable buffer
+ * 
+ * {"type": "stall" | "stall_cleared", "stage", "index", "timestamp", "silentMs"}
+ */
+inline void serializeStallStatus(bool stalled, const char* stage, std::size_t index, std::int64_t timestampMs,
+                                 std::int64_t silentMs, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String(stalled ? "stall" : "stall_cleared");
+    writer.Key("stage");
+    writer.String(stage);
+    writer.Key("index");
+    writer.Uint64(index);
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("silentMs");
+    writer.Int64(silentMs);
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one TWS:COMMANDS reply (TWS:STATUS) into a reusable buffer
+ * 
+ * {"type": "command_ack", "timestamp", "requestId", "action", "symbol", "status", "error" (rejected only)}
+ */
+inline void serializeCommandAck(const tws_bridge::CommandAck& ack, std::int64_t timestampMs, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("command_ack");
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("requestId");
+    writer.String(ack.requestId.data(), static_cast<rapidjson::SizeType>(ack.requestId.size()));
+    writer.Key("action");
+    writer.String(tws_bridge::commandActionName(ack.action));
+    writer.Key("symbol");
+    writer.String(ack.symbol.data(), static_cast<rapidjson::SizeType>(ack.symbol.size()));
+    writer.Key("status");
+    writer.String(tws_bridge::ackStatusName(ack.status));
+    if (ack.status == tws_bridge::AckStatus::Rejected) {
+        writer.Key("error");
+        writer.String(ack.error.data(), static_cast<rapidjson::SizeType>(ack.error.size()));
+    }
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one headline (TWS:NEWS:{SYMBOL}) into a reusable buffer
+ * 
+ * {"type": "news", "instrument", "timestamp" (TWS time, ms), "provider", "articleId", "headline",
+ *  "extraData" (when the provider sent any)}
+ */
+inline void serializeNews(const tws_bridge::NewsItem& item, std::string_view provider, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("news");
+    writer.Key("instrument");
+    writer.String(item.symbol.data(), static_cast<rapidjson::SizeType>(item.symbol.size()));
+    writer.Key("timestamp");
+    writer.Int64(item.timestampMs);
+    writer.Key("provider");
+    writer.String(provider.data(), static_cast<rapidjson::SizeType>(provider.size()));
+    writer.Key("articleId");
+    writer.String(item.articleId.data(), static_cast<rapidjson::SizeType>(item.articleId.size()));
+    writer.Key("headline");
+    writer.String(item.headline.data(), static_cast<rapidjson::SizeType>(item.headline.size()));
+    if (!item.extraData.empty()) {
+        writer.Key("extraData");
+        writer.String(item.extraData.data(), static_cast<rapidjson::SizeType>(item.extraData.size()));
+    }
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one heartbeat interval (TWS:STATUS) into a reusable buffer
+ * 
+ * {"type": "heartbeat", "timestamp", "intervalMs", "rates": {"ingest", "publish", "redis"} (per second),
+ *  "dropped", "conflated" (this interval), "queueAgeMs", "queueDepth", "redisRttUs", "redisDown",
+ *  "tws": {"connected", "total"}, "subscriptions"}
+ */
+inline void serializeHeartbeatStatus(std::int64_t timestampMs, const tws_bridge::StatusReport& report, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    const tws_bridge::StatusSample& current = report.current;
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("heartbeat");
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("intervalMs");
+    writer.Int64(report.intervalMs);
+    writer.Key("rates");
+    writer.StartObject();
+    writer.Key("ingest");
+    writer.Uint64(static_cast<std::uint64_t>(report.ticksInPerSecond + 0.5));  // REASON: Whole units keep it compact
+    writer.Key("publish");
+    writer.Uint64(static_cast<std::uint64_t>(report.publishedPerSecond + 0.5));
+    writer.Key("redis");
+    writer.Uint64(static_cast<std::uint64_t>(report.sentPerSecond + 0.5));
+    writer.EndObject();
+    writer.Key("dropped");
+    writer.Uint64(report.dropped);
+    writer.Key("conflated");
+    writer.Uint64(report.conflated);
+    writer.Key("queueAgeMs");
+    writer.Int64(std::chrono::duration_cast<std::chrono::milliseconds>(current.queueAge).count());
+    writer.Key("queueDepth");
+    writer.Uint64(current.queueDepth);
+    writer.Key("redisRttUs");
+    writer.Int64(std::chrono::duration_cast<std::chrono::microseconds>(current.redisRtt).count());
+    writer.Key("redisDown");
+    writer.Uint64(current.redisDown);
+    writer.Key("tws");
+    writer.StartObject();
+    writer.Key("connected");
+    writer.Uint64(current.twsConnected);
+    writer.Key("total");
+    writer.Uint64(current.twsConnections);
+    writer.EndObject();
+    writer.Key("subscriptions");
+    writer.Uint64(current.subscriptions);
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize one session report (report.directory/session-{DATE}.json) into a reusable buffer
+ * 
+ * {"type": "session_report", "session" (date), "start", "end", "complete", "totals": {...}, "peaks": {...},
+ *  "histograms": {"<name>": {"count", "p50", "p99", "p999", "max", "buckets": [[upper, count], ...]}}}
+ * NOTE: "buckets" lists the non-empty LatencySnapshot buckets by highest equivalent value (ns) - lossless,
+ * LatencySnapshot::bucketOf(upper) restores the bucket, so sessions merge and diff exactly
+ */
+inline void serializeSessionReport(const tws_bridge::SessionReport& report, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    const std::string date = tws_bridge::sessionDate(report.session);
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("session_report");
+    writer.Key("session");
+    writer.String(date.data(), static_cast<rapidjson::SizeType>(date.size()));
+    writer.Key("start");
+    writer.Int64(report.startMs);
+    writer.Key("end");
+    writer.Int64(report.endMs);
+    writer.Key("complete");
+    writer.Bool(report.complete);
+    writer.Key("totals");
+    writer.StartObject();
+    writer.Key("ticksIn");
+    writer.Uint64(report.ticksIn);
+    writer.Key("published");
+    writer.Uint64(report.published);
+    writer.Key("sent");
+    writer.Uint64(report.sent);
+    writer.Key("dropped");
+    writer.Uint64(report.dropped);
+    writer.Key("conflated");
+    writer.Uint64(report.conflated);
+    writer.Key("suppressed");
+    writer.Uint64(report.suppressed);
+    writer.Key("twsReconnects");
+    writer.Uint64(report.twsReconnects);
+    writer.Key("redisReconnects");
+    writer.Uint64(report.redisReconnects);
+    writer.EndObject();
+    writer.Key("peaks");
+    writer.StartObject();
+    writer.Key("ingest");
+    writer.Uint64(static_cast<std::uint64_t>(report.peakTicksIn + 0.5));
+    writer.Key("publish");
+    writer.Uint64(static_cast<std::uint64_t>(report.peakPublished + 0.5));
+    writer.Key("redis");
+    writer.Uint64(static_cast<std::uint64_t>(report.peakSent + 0.5));
+    writer.Key("queueDepth");
+    writer.Uint64(report.peakQueueDepth);
+    writer.Key("queueAgeNs");
+    writer.Int64(report.peakQueueAgeNs);
+    writer.EndObject();
+    writer.Key("histograms");
+    writer.StartObject();
+    for (std::size_t i = 0; i < tws_bridge::kSessionHistogramCount; ++i) {
+        const tws_bridge::LatencySnapshot& histogram = report.histograms[i];
+        writer.Key(tws_bridge::sessionHistogramName(static_cast<tws_bridge::SessionHistogram>(i)));
+        writer.StartObject();
+        writer.Key("count");
+        writer.Uint64(histogram.total());
+        writer.Key("p50");
+        writer.Int64(histogram.valueAt(50.0));
+        writer.Key("p99");
+        writer.Int64(histogram.valueAt(99.0));
+        writer.Key("p999");
+        writer.Int64(histogram.valueAt(99.9));
+        writer.Key("max");
+        writer.Int64(histogram.max());
+        writer.Key("buckets");
+        writer.StartArray();
+        for (std::size_t bucket = 0; bucket < tws_bridge::LatencySnapshot::kBuckets; ++bucket) {
+            if (histogram.counts[bucket] != 0) {
+                writer.StartArray();
+                writer.Int64(tws_bridge::LatencySnapshot::bucketUpperBound(bucket));
+                writer.Uint64(histogram.counts[bucket]);
+                writer.EndArray();
+            }
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
+    writer.EndObject();
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize a basket's synthetic snapshot (TWS:TICKS:{BASKET}) into a reusable buffer
+ * 
+ * {"instrument", "type": "basket", "value", "priced", "constituents", "seq", "timestamp"}
+ * NOTE: value sums the priced constituents only - compare priced with constituents before trusting it
+ */
+inline void serializeBasketSnapshot(const std::string& name, double value, std::size_t priced, std::size_t constituents,
+                                    std::uint64_t sequence, std::int64_t timestampMs, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("instrument");
+    writer.String(name.data(), static_cast<rapidjson::SizeType>(name.size()));
+    writer.Key("type");
+    writer.String("basket");
+    writer.Key("value");
+    writer.Double(value);
+    writer.Key("priced");
+    writer.Uint64(priced);
+    writer.Key("constituents");
+    writer.Uint64(constituents);
+    writer.Key("seq");
+    writer.Uint64(sequence);
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.EndObject();
+}
+
+/**
+ * @brief Serialize the bridge-wide movers ranking (TWS:MOVERS) into a reusable buffer
+ * 
+ * {"type": "movers", "timestamp", "gainers": [...], "losers": [...], "volume": [...]}
+ * Rows: {"instrument", "last", "change" (% from the session's first trade), "volume" (session)}
+ */
+inline void serializeMovers(const tws_bridge::MoverRanking& ranking, const tws_bridge::InstrumentRegistry& registry, std::int64_t timestampMs,
+                            JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    auto rows = [&](const char* key, const std::vector<tws_bridge::MoverRow>& list) {
+        writer.Key(key);
+        writer.StartArray();
+        for (const tws_bridge::MoverRow& row : list) {
+            const std::string& symbol = registry.symbol(row.slot);
+            writer.StartObject();
+            writer.Key("instrument");
+            writer.String(symbol.data(), static_cast<rapidjson::SizeType>(symbol.size()));
+            writer.Key("last");
+            writer.Double(row.last);
+            writer.Key("change");
+            writer.Double(row.change);
+            writer.Key("volume");
+            writer.Int64(row.volume);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    };
     
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("movers");
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    rows("gainers", ranking.gainers);
+    rows("losers", ranking.losers);
+    rows("volume", ranking.volume);
     writer.EndObject();
+}
+
+/**
+ * @brief Serialize a scan's ranks (TWS:SCAN:{ID}) into a reusable buffer
+ * 
+ * {"type": "scan", "scan", "seq", "timestamp", "size", "ranks": [{"rank", "instrument", "conId", "secType"}, ...]}
+ * ranks = the changed ones (nullptr = every rank, the stored full list); ranks at or past size are gone
+ */
+inline void serializeScan(const std::string& id, const tws_bridge::ScanCycle& cycle, const std::vector<std::size_t>* ranks,
+                          std::uint64_t sequence, std::int64_t timestampMs, JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    auto row = [&](std::size_t rank) {
+        const tws_bridge::ScanRow& scanRow = cycle.rows[rank];
+        writer.StartObject();
+        writer.Key("rank");
+        writer.Uint64(rank);
+        writer.Key("instrument");
+        writer.String(scanRow.symbol.data(), static_cast<rapidjson::SizeType>(scanRow.symbol.size()));
+        writer.Key("conId");
+        writer.Int64(scanRow.conId);
+        writer.Key("secType");
+        writer.String(scanRow.secType.data(), static_cast<rapidjson::SizeType>(scanRow.secType.size()));
+        writer.EndObject();
+    };
     
-    return buffer.GetString();
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("scan");
+    writer.Key("scan");
+    writer.String(id.data(), static_cast<rapidjson::SizeType>(id.size()));
+    writer.Key("seq");
+    writer.Uint64(sequence);
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("size");
+    writer.Uint64(cycle.size);
+    writer.Key("ranks");
+    writer.StartArray();
+    if (ranks) {
+        for (std::size_t rank : *ranks) {
+            row(rank);
+        }
+    } else {
+        for (std::size_t rank = 0; rank < cycle.size; ++rank) {
+            row(rank);
+        }
+    }
+    writer.EndArray();
+    writer.EndObject();
 }
 
+/**
+ * @brief Serialize a shard's load-shedding level change (TWS:STATUS) into a reusable buffer
+ * 
+ * {"type": "load_shed", "shard", "timestamp", "level", "previous", "queueAgeMs", "queueDepth"}
+ */
+inline void serializeShedStatus(std::size_t shard, std::int64_t timestampMs, tws_bridge::ShedLevel level,
+                                tws_bridge::ShedLevel previous, std::int64_t queueAgeMs, std::size_t queueDepth,
+                                JsonBuffer& out) {
+    rapidjson::Writer<rapidjson::StringBuffer>& writer = out.reset();
+    
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("load_shed");
+    writer.Key("shard");
+    writer.Uint64(shard);
+    writer.Key("timestamp");
+    writer.Int64(timestampMs);
+    writer.Key("level");
+    writer.String(tws_bridge::shedLevelName(level));
+    writer.Key("previous");
+    writer.String(tws_bridge::shedLevelName(previous));
+    writer.Key("queueAgeMs");
+    writer.Int64(queueAgeMs);
+    writer.Key("queueDepth");
+    writer.Uint64(queueDepth);
+    writer.EndObject();
+}
@@ -0,0 +1,282 @@
+// SessionReport.h - One trading session's latency and throughput, persisted from the lifetime counters and
+// histograms the stages already keep (report: TWS:REPORT:{DATE} hash + reports/session-{DATE}.json)
+// SCOPE: Own thread + own Redis connection, like StatusHeartbeat; the final (partial) session is written by
+// main after the workers drained
+
+#pragma once
+
+#include "DerivedMetrics.h"
+#include "IsoTimestamp.h"
+#include "LatencyHistogram.h"
+#include "StatusHeartbeat.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// report: regressions are tracked across releases against real market days, not synthetic runs
+struct SessionReportConfig {
+    bool enabled = false;
+    std::chrono::milliseconds interval{1000};       // Throughput peaks are the busiest interval of the session
+    std::chrono::minutes sessionReset{9 * 60};      // Follows worker.derived_metrics.session_reset
+    std::string directory = "reports";              // {directory}/session-{DATE}.json ("" = hash only)
+    std::string keyPrefix = "TWS:REPORT:";          // HSET {keyPrefix}{DATE} ("" = file only)
+    std::chrono::hours retention{90 * 24};          // Hash TTL (0h = kept)
+    std::chrono::milliseconds socketTimeout{1000};
+    std::chrono::milliseconds reconnectDelay{1000}; // Back-off after a Redis error
+};
+
+// Histograms a report carries, in report order
+enum class SessionHistogram : std::uint8_t {
+    Ingest, Queue, Serialize, Publish, EndToEnd,    // LatencyStage order
+    RedisRoundTrip,                                 // PublisherLatency::roundTrip
+    TwsReconnect,                                   // TwsClientCounters::reconnectTime
+    Count
+};
+
+inline constexpr std::size_t kSessionHistogramCount = static_cast<std::size_t>(SessionHistogram::Count);
+
+inline const char* sessionHistogramName(SessionHistogram histogram) {
+    static constexpr const char* kNames[kSessionHistogramCount] = {"ingest", "queue", "serialize", "publish",
+                                                                     "endToEnd", "redisRtt", "twsReconnect"};
+    return histogram < SessionHistogram::Count ? kNames[static_cast<std::size_t>(histogram)] : "";
+}
+
+using SessionHistograms = std::array<LatencySnapshot, kSessionHistogramCount>;
+
+// Lifetime totals summed over shards / publishers / connections (the status collector plus what only the
+// report keeps)
+struct SessionSample {
+    StatusSample status;
+    std::uint64_t suppressed = 0;                   // Unchanged + duplicate + deadband + unwatched snapshots
+    std::uint64_t twsReconnects = 0;
+    std::uint64_t redisReconnects = 0;
+};
+
+struct SessionReport {
+    std::int64_t session = 0;                       // sessionNumber() of startMs
+    std::int64_t startMs = 0;
+    std::int64_t endMs = 0;
+    bool complete = false;                          // false: cut short by shutdown (or started mid-session)
+    // This session's counts
+    std::uint64_t ticksIn = 0;
+    std::uint64_t published = 0;
+    std::uint64_t sent = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t conflated = 0;
+    std::uint64_t suppressed = 0;
+    std::uint64_t twsReconnects = 0;
+    std::uint64_t redisReconnects = 0;
+    // Busiest interval (per second) and worst gauges
+    double peakTicksIn = 0.0;
+    double peakPublished = 0.0;
+    double peakSent = 0.0;
+    std::size_t peakQueueDepth = 0;
+    std::int64_t peakQueueAgeNs = 0;
+    SessionHistograms histograms;                   // This session's samples (ns)
+};
+
+// "2026-10-15" - the UTC day a session is numbered by
+inline std::string sessionDate(std::int64_t session) {
+    char iso[32];
+    formatIsoTimestamp(session * 86400000, iso);
+    return std::string(iso, 10);
+}
+
+// Key / file suffix: the date for a whole session, date + start time (UTC) for a partial one - a restart
+// mid-session never overwrites the report of the run before it
+inline std::string sessionReportId(const SessionReport& report) {
+    std::string id = sessionDate(report.session);
+    if (!report.complete) {
+        char iso[32];
+        formatIsoTimestamp(report.startMs, iso);  // "2026-10-15T13:20:05.123Z" → "2026-10-15-132005"
+        id += '-';
+        id.append(iso + 11, 2).append(iso + 14, 2).append(iso + 17, 2);
+    }
+    return id;
+}
+
+/**
+ * Session bookkeeping: lifetime values at the session start, peaks since, deltas at the end.
+ *
+ * REASON: Every input is a lifetime total the stages keep for /metrics - a report is two snapshots and a
+ * subtraction (LatencySnapshot::advance), nothing is recorded twice on a pipeline thread
+ * NOTE: Peaks are per sampling interval - a burst shorter than report.interval is averaged into it
+ * SCOPE: One thread at a time (the reporter thread, then main for the final session)
+ */
+class SessionAccumulator {
+public:
+    SessionAccumulator() : m_report(std::make_unique<SessionReport>()), m_start(std::make_unique<SessionHistograms>()) {}
+
+    // First sample of the process: the session it falls in is incomplete
+    void begin(std::int64_t nowMs, std::int64_t sessionResetMs, const SessionSample& sample,
+               const SessionHistograms& lifetime) {
+        m_sessionResetMs = sessionResetMs;
+        m_startSample = sample;
+        *m_start = lifetime;
+        resetPeaks();
+        m_report->session = sessionNumber(nowMs, sessionResetMs);
+        m_report->startMs = nowMs;
+        m_startedAtBoundary = false;
+    }
+
+    // One interval: throughput and gauges for the peaks
+    void observe(const StatusReport& interval) {
+        SessionReport& report = *m_report;
+        report.peakTicksIn = std::max(report.peakTicksIn, interval.ticksInPerSecond);
+        report.peakPublished = std::max(report.peakPublished, interval.publishedPerSecond);
+        report.peakSent = std::max(report.peakSent, interval.sentPerSecond);
+        report.peakQueueDepth = std::max(report.peakQueueDepth, interval.current.queueDepth);
+        report.peakQueueAgeNs = std::max<std::int64_t>(report.peakQueueAgeNs, interval.current.queueAge.count());
+    }
+
+    // Has nowMs left the session being accumulated?
+    bool rolled(std::int64_t nowMs) const { return sessionNumber(nowMs, m_sessionResetMs) != m_report->session; }
+
+    // Closes the session at nowMs (atBoundary: the session ended, not the process); `lifetime` is the current
+    // lifetime histograms. The report stays valid until the next finish(), next() starts the following
+    // session from these values
+    const SessionReport& finish(std::int64_t nowMs, const SessionSample& sample, const SessionHistograms& lifetime,
+                                bool atBoundary) {
+        SessionReport& report = *m_report;
+        auto delta = [](std::uint64_t before, std::uint64_t after) { return after >= before ? after - before : 0; };
+        const StatusSample& from = m_startSample.status;
+        report.endMs = nowMs;
+        report.complete = m_startedAtBoundary && atBoundary;
+        report.ticksIn = delta(from.ticksIn, sample.status.ticksIn);
+        report.published = delta(from.published, sample.status.published);
+        report.sent = delta(from.sent, sample.status.sent);
+        report.dropped = delta(from.dropped, sample.status.dropped);
+        report.conflated = delta(from.conflated, sample.status.conflated);
+        report.suppressed = delta(m_startSample.suppressed, sample.suppressed);
+        report.twsReconnects = delta(m_startSample.twsReconnects, sample.twsReconnects);
+        report.redisReconnects = delta(m_startSample.redisReconnects, sample.redisReconnects);
+        for (std::size_t i = 0; i < kSessionHistogramCount; ++i) {
+            report.histograms[i] = lifetime[i];
+            report.histograms[i].advance((*m_start)[i]);  // NOTE: m_start now holds `lifetime` for the next session
+        }
+        m_startSample = sample;
+        return report;
+    }
+
+    // After finish(): the next session starts at its boundary, peaks cleared
+    void next() {
+        SessionReport& report = *m_report;
+        report.session = sessionNumber(report.endMs, m_sessionResetMs);
+        report.startMs = report.endMs;
+        m_startedAtBoundary = true;
+        resetPeaks();
+    }
+
+    std::int64_t session() const { return m_report->session; }
+
+private:
+    void resetPeaks() {
+        m_report->peakTicksIn = m_report->peakPublished = m_report->peakSent = 0.0;
+        m_report->peakQueueDepth = 0;
+        m_report->peakQueueAgeNs = 0;
+    }
+
+    // REASON: Heap - a report and a baseline are ~64 KiB of bucket counts each
+    std::unique_ptr<SessionReport> m_report;
+    std::unique_ptr<SessionHistograms> m_start;     // Lifetime histograms at the session start
+    SessionSample m_startSample;
+    std::int64_t m_sessionResetMs = 0;
+    bool m_startedAtBoundary = false;
+};
+
+// HSET fields of a report: counts, peaks, and count / p50 / p99 / p999 / max (ns) per histogram
+// NOTE: The bucket counts only go to the JSON file - the hash is for dashboards and quick diffs
+inline std::vector<std::pair<std::string, std::string>> sessionReportFields(const SessionReport& report,
+                                                                            const std::string& file) {
+    std::vector<std::pair<std::string, std::string>> fields;
+    auto add = [&fields](std::string name, auto value) { fields.emplace_back(std::move(name), std::to_string(value)); };
+    add("start", report.startMs);
+    add("end", report.endMs);
+    fields.emplace_back("complete", report.complete ? "1" : "0");
+    add("ticks_in", report.ticksIn);
+    add("published", report.published);
+    add("sent", report.sent);
+    add("dropped", report.dropped);
+    add("conflated", report.conflated);
+    add("suppressed", report.suppressed);
+    add("tws_reconnects", report.twsReconnects);
+    add("redis_reconnects", report.redisReconnects);
+    add("peak_ticks_in_per_second", static_cast<std::uint64_t>(report.peakTicksIn));
+    add("peak_published_per_second", static_cast<std::uint64_t>(report.peakPublished));
+    add("peak_sent_per_second", static_cast<std::uint64_t>(report.peakSent));
+    add("peak_queue_depth", static_cast<std::uint64_t>(report.peakQueueDepth));
+    add("peak_queue_age_ns", report.peakQueueAgeNs);
+    for (std::size_t i = 0; i < kSessionHistogramCount; ++i) {
+        const LatencySnapshot& histogram = report.histograms[i];
+        const std::string name = sessionHistogramName(static_cast<SessionHistogram>(i));
+        add(name + "_count", histogram.total());
+        add(name + "_p50_ns", histogram.valueAt(50.0));
+        add(name + "_p99_ns", histogram.valueAt(99.0));
+        add(name + "_p999_ns", histogram.valueAt(99.9));
+        add(name + "_max_ns", histogram.max());
+    }
+    if (!file.empty()) {
+        fields.emplace_back("file", file);
+    }
+    return fields;
+}
+
+// Lifetime counters (written by the reporter / main, readable from any thread)
+struct SessionReportCounters {
+    std::atomic<std::uint64_t> written{0};          // Reports persisted (hash and / or file)
+    std::atomic<std::uint64_t> errors{0};           // Redis or file errors (the other target may still have it)
+};
+
+/**
+ * Samples the stages every interval for the peaks and writes one report per session boundary it crosses.
+ *
+ * ARCHITECTURE: Same collector contract as StatusHeartbeat - relaxed loads of atomics the stages keep anyway;
+ * histogram copies only at a session boundary
+ * PITFALL: Everything the collectors read must outlive finish()
+ */
+class SessionReporter {
+public:
+    using Collect = std::function<void(SessionSample&)>;
+    using CollectHistograms = std::function<void(SessionHistograms&)>;
+
+    SessionReporter(const std::string& uri, SessionReportConfig config, Collect collect, CollectHistograms histograms);
+    ~SessionReporter();
+
+    SessionReporter(const SessionReporter&) = delete;
+    SessionReporter& operator=(const SessionReporter&) = delete;
+
+    void start();
+    void stop();
+    // Main, after stop() and the worker drain: writes the session in progress (complete: false)
+    void finish();
+
+    const SessionReportCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+    void write(const SessionReport& report);
+
+    std::string m_uri;
+    SessionReportConfig m_config;
+    Collect m_collect;
+    CollectHistograms m_collectHistograms;
+    SessionAccumulator m_accumulator;
+    std::unique_ptr<SessionHistograms> m_lifetime;  // REASON: Scratch for the boundary copies (~64 KiB)
+    bool m_begun = false;
+    SessionReportCounters m_counters;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
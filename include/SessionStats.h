@@ -0,0 +1,140 @@
+// SessionStats.h - Session open / high / low / last / previous close / volume per instrument, kept as trades
+// arrive, seeded from one daily-bar request per symbol and published at a low rate (TWS:SESSION:{SYMBOL})
+// SCOPE: Redis Worker thread (one SessionStats per slot, moved with the slot when rebalancing)
+
+#pragma once
+
+#include "DerivedMetrics.h"
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+// worker.session_stats
+struct SessionStatsConfig {
+    bool enabled = false;
+    std::chrono::milliseconds interval{1000};       // Publish throttle (a slot publishes at most once per interval)
+    std::chrono::minutes sessionReset{9 * 60};      // Follows worker.derived_metrics.session_reset
+};
+
+// Session of a daily bar's date (reqHistoricalData "yyyyMMdd", parsed as UTC midnight)
+// REASON: Session N starts at sessionReset into UTC day N - the bar of day N is session N, whatever the reset
+inline std::int64_t sessionOfDate(std::int64_t dateMs) {
+    constexpr std::int64_t kDayMs = 86400000;
+    return dateMs >= 0 ? dateMs / kDayMs : (dateMs - kDayMs + 1) / kDayMs;
+}
+
+// Unix ms at which the session after the one holding nowMs starts (rollover timer deadline)
+inline std::int64_t nextSessionStartMs(std::int64_t nowMs, std::int64_t sessionResetMs) {
+    return (sessionNumber(nowMs, sessionResetMs) + 1) * 86400000 + sessionResetMs;
+}
+
+// One slot's session statistics
+// PERFORMANCE: A trade is two compares and two stores - consumers no longer issue their own daily-bar
+// history request per symbol to learn the open or the previous close
+// NOTE: 0 = unknown (no trade this session and no seed bar yet)
+struct SessionStats {
+    std::int64_t session = -1;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double last = 0.0;
+    double prevClose = 0.0;
+    std::int64_t volume = 0;
+    bool seeded = false;                            // A daily bar arrived (open / previous close are TWS's)
+    bool dirty = false;                             // Changed since the last publish
+
+    // Starts session next: the last trade becomes the previous close
+    // NOTE: Driven by the rollover timer as well - a symbol that does not trade still rolls over on time
+    void roll(std::int64_t next) {
+        if (next <= session) {
+            return;
+        }
+        if (session >= 0 && last > 0.0) {
+            prevClose = last;
+        }
+        session = next;
+        open = high = low = 0.0;
+        volume = 0;
+        dirty = true;
+    }
+
+    void onTrade(std::int64_t tradeSession, double price, std::int64_t size) {
+        if (!(price > 0.0) || tradeSession < session) {
+            return;  // REASON: A late print of the previous session must not reopen it
+        }
+        roll(tradeSession);
+        if (open == 0.0) {
+            open = high = low = price;
+        } else if (price > high) {
+            high = price;
+        } else if (price < low) {
+            low = price;
+        }
+        last = price;
+        volume += size > 0 ? size : 0;
+        dirty = true;
+    }
+
+    // Daily bar of the seed request (ascending dates): an earlier session's bar gives the previous close,
+    // the current session's bar the open and what traded before the bridge started
+    // NOTE: The bar covers regular hours (useRTH) - its open replaces a pre-market first print, high / low /
+    // volume are merged since live trades may already have counted part of it
+    void seed(std::int64_t barSession, std::int64_t current, double barOpen, double barHigh, double barLow,
+              double barClose, std::int64_t barVolume) {
+        roll(current);
+        if (barSession < current) {
+            prevClose = barClose;
+        } else if (barSession == current) {
+            open = barOpen;
+            high = high > barHigh ? high : barHigh;
+            low = low > 0.0 && low < barLow ? low : barLow;
+            volume = volume > barVolume ? volume : barVolume;
+            if (last == 0.0) {
+                last = barClose;
+            }
+        } else {
+            return;  // PITFALL: A bar dated after the local session (clock skew) is not trusted
+        }
+        seeded = true;
+        dirty = true;
+    }
+
+    // {"instrument","session","open","high","low","last","prev_close","change","volume","seeded"}
+    // change = % of last against the previous close, 0 until both are known
+    void encode(std::string_view symbolJson, std::string& out) const {
+        out.clear();
+        out += "{\"instrument\":";
+        out.append(symbolJson.data(), symbolJson.size());
+        out += ",\"session\":";
+        appendNumber(out, session);
+        out += ",\"open\":";
+        appendNumber(out, open);
+        out += ",\"high\":";
+        appendNumber(out, high);
+        out += ",\"low\":";
+        appendNumber(out, low);
+        out += ",\"last\":";
+        appendNumber(out, last);
+        out += ",\"prev_close\":";
+        appendNumber(out, prevClose);
+        out += ",\"change\":";
+        appendNumber(out, prevClose > 0.0 && last > 0.0 ? (last - prevClose) / prevClose * 100.0 : 0.0);
+        out += ",\"volume\":";
+        appendNumber(out, volume);
+        out += seeded ? ",\"seeded\":true}" : ",\"seeded\":false}";
+    }
+
+private:
+    template <typename T>
+    static void appendNumber(std::string& out, T value) {
+        char number[32];
+        const std::to_chars_result result = std::to_chars(number, number + sizeof(number), value);
+        out.append(number, static_cast<std::size_t>(result.ptr - number));
+    }
+};
+
+} // namespace tws_bridge
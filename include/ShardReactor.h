@@ -0,0 +1,167 @@
+// ShardReactor.h - One epoll loop per consumer: producer wake-up (eventfd), next deadline (timerfd), extra fds
+// SCOPE: wake() from any thread, everything else on the owning consumer thread (RedisWorker via ConsumerWaiter)
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace tws_bridge {
+
+// Lifetime counters (consumer thread writes)
+struct ReactorCounters {
+    std::uint64_t waits = 0;                        // epoll_wait calls
+    std::uint64_t wakes = 0;                        // ... ended by wake()
+    std::uint64_t deadlines = 0;                    // ... ended by the timerfd
+    std::uint64_t events = 0;                       // Registered fd events handled
+};
+
+// The consumer parks in epoll_wait until a producer calls wake(), its deadline passes or a registered fd
+// (a socket, a command channel) is ready - whichever comes first, with no polling in between
+// ARCHITECTURE: add(fd, events, handler) is the extension point - a capability that brings an fd runs
+// its handler on the shard's own thread instead of starting a thread with its own sleep loop
+// PERFORMANCE: Deadlines are armed absolute on CLOCK_MONOTONIC (steady_clock) - a timer fires when it
+// is due, not at the next poll; re-arming is skipped while the deadline is unchanged
+// PITFALL: Handlers run inside wait() on the consumer thread - they must not block
+class ShardReactor {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Handler = std::function<void(std::uint32_t events)>;
+
+    ShardReactor()
+        : m_epoll(epoll_create1(EPOLL_CLOEXEC))
+        , m_wake(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , m_timer(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) {
+        watch(m_wake, EPOLLIN, kWakeTag);
+        watch(m_timer, EPOLLIN, kTimerTag);
+    }
+
+    ~ShardReactor() {
+        for (int fd : {m_epoll, m_wake, m_timer}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+
+    ShardReactor(const ShardReactor&) = delete;
+    ShardReactor& operator=(const ShardReactor&) = delete;
+
+    // false if the kernel refused one of the three fds (callers fall back to their own wait)
+    bool valid() const { return m_epoll >= 0 && m_wake >= 0 && m_timer >= 0; }
+
+    // ========== Any thread ==========
+    // Ends the current (or next) wait()
+    // NOTE: Wakes coalesce in the eventfd counter - n calls before a wait() end one wait
+    void wake() {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(m_wake, &one, sizeof(one));
+    }
+
+    // ========== Consumer thread ==========
+    // Runs handler(epoll events) from wait() whenever fd is ready - false if epoll refused it
+    // NOTE: fd stays owned by the caller, remove() it before closing
+    bool add(int fd, std::uint32_t events, Handler handler) {
+        std::size_t index = 0;
+        while (index < m_handlers.size() && m_handlers[index].fd >= 0) {
+            ++index;
+        }
+        if (!watch(fd, events, index)) {
+            return false;
+        }
+        if (index == m_handlers.size()) {
+            m_handlers.push_back(Registration{});
+        }
+        m_handlers[index] = Registration{fd, std::move(handler)};
+        return true;
+    }
+
+    void remove(int fd) {
+        for (Registration& registration : m_handlers) {
+            if (registration.fd == fd) {
+                epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+                registration = Registration{};
+            }
+        }
+    }
+
+    // Blocks until wake(), deadline (Clock::time_point::max() = none) or a registered fd; runs the
+    // ready fds' handlers, returns the number of events handled
+    std::size_t wait(Clock::time_point deadline) {
+        arm(deadline);
+        ++m_counters.waits;
+        epoll_event ready[kMaxEvents];
+        const int count = epoll_wait(m_epoll, ready, kMaxEvents, -1);
+        if (count <= 0) {
+            return 0;  // REASON: EINTR - the caller re-checks its work and waits again
+        }
+        for (int i = 0; i < count; ++i) {
+            const std::uint64_t tag = ready[i].data.u64;
+            std::uint64_t value = 0;
+            if (tag == kWakeTag) {
+                [[maybe_unused]] const ssize_t read = ::read(m_wake, &value, sizeof(value));
+                ++m_counters.wakes;
+            } else if (tag == kTimerTag) {
+                [[maybe_unused]] const ssize_t read = ::read(m_timer, &value, sizeof(value));
+                m_armed = Clock::time_point::max();  // REASON: One-shot - expired, nothing armed any more
+                ++m_counters.deadlines;
+            } else if (tag < m_handlers.size() && m_handlers[tag].fd >= 0) {
+                ++m_counters.events;
+                m_handlers[tag].handler(ready[i].events);
+            }
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    const ReactorCounters& counters() const { return m_counters; }
+
+private:
+    static constexpr int kMaxEvents = 16;
+    static constexpr std::uint64_t kWakeTag = ~std::uint64_t{0};
+    static constexpr std::uint64_t kTimerTag = ~std::uint64_t{0} - 1;
+
+    struct Registration {
+        int fd = -1;
+        Handler handler;
+    };
+
+    bool watch(int fd, std::uint32_t events, std::uint64_t tag) {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = tag;
+        return fd >= 0 && epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    void arm(Clock::time_point deadline) {
+        if (deadline == m_armed) {
+            return;
+        }
+        itimerspec spec{};  // Zero = disarm
+        if (deadline != Clock::time_point::max()) {
+            const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                deadline.time_since_epoch()).count();
+            // REASON: it_value 0 would disarm - a deadline at (or before) the epoch fires at once
+            spec.it_value.tv_sec = ns > 0 ? static_cast<time_t>(ns / 1000000000) : 0;
+            spec.it_value.tv_nsec = ns > 0 ? static_cast<long>(ns % 1000000000) : 1;
+        }
+        timerfd_settime(m_timer, TFD_TIMER_ABSTIME, &spec, nullptr);
+        m_armed = deadline;
+    }
+
+    const int m_epoll;
+    const int m_wake;
+    const int m_timer;
+    Clock::time_point m_armed = Clock::time_point::max();
+    std::vector<Registration> m_handlers;           // By epoll tag
+    ReactorCounters m_counters;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,123 @@
+// ShardRebalancer.h - Hot-symbol detection: per-slot tick-rate EWMA, shard loads, which slot to move where
+// SCOPE: Main thread observes and plans (RebalanceConfig::interval), ShardRouter / workers carry the move out
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace tws_bridge {
+
+struct RebalanceConfig {
+    bool enabled = false;
+    std::chrono::seconds interval{5};               // Observe + at most one move per interval
+    std::chrono::seconds halfLife{30};              // Tick-rate EWMA half-life (a burst must last to move a symbol)
+    double threshold = 1.5;                         // Move only while the busiest shard carries > threshold x mean load
+    double minRate = 50.0;                          // Ticks/s a move must take off the busiest shard (a handoff costs)
+    std::chrono::milliseconds handoffTimeout{1000}; // New owner's wait for the old one (SlotMigration)
+};
+
+struct RebalanceMove {
+    SlotId slot = kInvalidSlot;
+    std::size_t from = 0;
+    std::size_t to = 0;
+    double rate = 0.0;                              // The slot's ticks/s
+};
+
+// Load = sum of the owned slots' tick-rate EWMAs; a move takes the slot from the busiest shard to the idlest
+// whose rate best halves their gap
+// REASON: Moving rate r lowers the busier of the two by min(r, gap - r) - a slot about as busy as the gap
+// would only move the hot spot, so that gain must reach minRate
+// NOTE: Rates come from the producer's per-slot counters (ShardRouter::ticks), not from worker timings -
+// a symbol costs roughly the same per tick on any shard
+class ShardRebalancer {
+public:
+    ShardRebalancer(RebalanceConfig config, std::size_t slots, std::size_t shards)
+        : m_config(config)
+        , m_rates(slots, 0.0)
+        , m_last(slots, 0)
+        , m_loads(shards == 0 ? 1 : shards) {
+        for (std::atomic<double>& load : m_loads) {
+            load.store(0.0, std::memory_order_relaxed);
+        }
+    }
+
+    // Folds the ticks counted since the last call into each slot's rate
+    // ticks(slot): cumulative count (wraps), slots: registered so far, seconds: since the last call
+    template <typename Ticks>
+    void observe(Ticks&& ticks, std::size_t slots, double seconds) {
+        if (seconds <= 0.0) {
+            return;
+        }
+        const double halfLife = std::chrono::duration<double>(m_config.halfLife).count();
+        const double alpha = halfLife > 0.0 ? 1.0 - std::exp2(-seconds / halfLife) : 1.0;
+        const std::size_t count = slots < m_rates.size() ? slots : m_rates.size();
+        for (std::size_t slot = 0; slot < count; ++slot) {
+            const std::uint32_t now = ticks(static_cast<SlotId>(slot));
+            const std::uint32_t delta = now - m_last[slot];  // REASON: Unsigned difference survives the wrap
+            m_last[slot] = now;
+            m_rates[slot] += alpha * (delta / seconds - m_rates[slot]);
+        }
+    }
+
+    // Recomputes the shard loads from owner(slot), returns the move that evens out the busiest shard, if any
+    template <typename Owner>
+    std::optional<RebalanceMove> plan(Owner&& owner, std::size_t slots) {
+        const std::size_t shards = m_loads.size();
+        std::vector<double>& loads = m_scratch;
+        loads.assign(shards, 0.0);
+        const std::size_t count = slots < m_rates.size() ? slots : m_rates.size();
+        double total = 0.0;
+        for (std::size_t slot = 0; slot < count; ++slot) {
+            loads[owner(static_cast<SlotId>(slot))] += m_rates[slot];
+            total += m_rates[slot];
+        }
+        std::size_t hot = 0;
+        std::size_t cold = 0;
+        for (std::size_t shard = 0; shard < shards; ++shard) {
+            m_loads[shard].store(loads[shard], std::memory_order_relaxed);
+            hot = loads[shard] > loads[hot] ? shard : hot;
+            cold = loads[shard] < loads[cold] ? shard : cold;
+        }
+        const double mean = total / static_cast<double>(shards);
+        if (shards < 2 || mean <= 0.0 || loads[hot] <= m_config.threshold * mean) {
+            return std::nullopt;
+        }
+        const double gap = loads[hot] - loads[cold];
+        std::optional<RebalanceMove> best;
+        double bestGain = 0.0;
+        for (std::size_t slot = 0; slot < count; ++slot) {
+            const double rate = m_rates[slot];
+            const double gain = rate < gap - rate ? rate : gap - rate;
+            if (gain < m_config.minRate || owner(static_cast<SlotId>(slot)) != hot) {
+                continue;
+            }
+            if (!best || gain > bestGain) {
+                best = RebalanceMove{static_cast<SlotId>(slot), hot, cold, rate};
+                bestGain = gain;
+            }
+        }
+        return best;
+    }
+
+    double rate(SlotId slot) const { return slot < m_rates.size() ? m_rates[slot] : 0.0; }
+    // Ticks/s owned by shard at the last plan() (any thread)
+    double load(std::size_t shard) const { return m_loads[shard].load(std::memory_order_relaxed); }
+    std::size_t shardCount() const { return m_loads.size(); }
+    const RebalanceConfig& config() const { return m_config; }
+
+private:
+    const RebalanceConfig m_config;
+    std::vector<double> m_rates;                    // By slot, ticks/s EWMA
+    std::vector<std::uint32_t> m_last;              // By slot, counter at the last observe()
+    std::vector<std::atomic<double>> m_loads;       // By shard (metrics thread reads)
+    std::vector<double> m_scratch;
+};
+
+} // namespace tws_bridge
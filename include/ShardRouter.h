@@ -0,0 +1,504 @@
+// ShardRouter.h - Slot-partitioned ingest queues for the Redis worker pool
+// SCOPE: Producer (TwsClient callbacks) routes, each RedisWorker consumes one shard
+
+#pragma once
+
+#include "MarketData.h"
+#include "InstrumentRegistry.h"
+#include "WaitStrategy.h"
+#include "SpscRing.h"
+#include "CoalescingTable.h"
+#include "QueueSizing.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <concurrentqueue.h>
+
+namespace tws_bridge {
+
+// Ingest queue types (TwsClient callbacks → RedisWorker)
+using MpmcTickQueue = moodycamel::ConcurrentQueue<TickUpdate>;
+using SpscTickQueue = SpscRing<TickUpdate>;  // PERFORMANCE: Exactly one producer + one consumer per shard
+
+// What the producer does when a shard queue is full
+// BACKPRESSURE: Never blocks the callback thread, never logs on it (see OverflowCounters)
+enum class OverflowPolicy : std::uint8_t {
+    DropNewest,      // Reject the incoming update
+    ConflateLatest,  // Keep only the latest BidAsk / AllLast per symbol in place (bounded memory)
+    Spill,           // Secondary queue (no loss, memory grows with the backlog up to IngestConfig::spillBudget)
+    PrioritizeTrades // AllLast on their own bounded lane, drained first; BidAsk conflated like ConflateLatest
+                     // REASON: A lost trade corrupts volume / VWAP, a lost quote is replaced by the next one
+};
+
+// How BidAsk / AllLast reach the worker (bars always go through the queue)
+enum class IngestMode : std::uint8_t {
+    Queue,    // One TickUpdate per tick through the shard queue
+    Coalesce  // Latest value per symbol written in place, worker publishes changed symbols only
+              // (constant memory under any burst, ticks can't overflow - intermediate ticks are lost)
+};
+
+struct IngestConfig {
+    IngestMode mode = IngestMode::Queue;
+    OverflowPolicy policy = OverflowPolicy::DropNewest;
+    std::size_t slotCapacity = InstrumentRegistry::kDefaultCapacity;  // Coalescing table size
+    // Spill: bytes per shard the spill queue may hold (memory.ingest_spill_mb share), 0 = unbounded
+    // BACKPRESSURE: At the budget the newest update is dropped (counted as dropped + spillOverBudget)
+    std::size_t spillBudget = 0;
+    // Shard rebalancing (ShardRebalancer.h): per-slot owner table + tick counters, coalescing keyed by slot
+    // NOTE: Single producer only, not with PrioritizeTrades (its trade lane cannot hand one slot over)
+    bool movableSlots = false;
+    // ingest.huge_pages / lock_memory: SPSC queue + coalescing table (and worker state) on prefaulted 2 MB pages
+    // NOTE: MpmcTickQueue (several connections, spill, trade lane) allocates its own blocks - heap pages
+    HugePageConfig memory;
+};
+
+// Coalescing key of a slot's BidAsk / AllLast / MidPoint with IngestConfig::movableSlots (the slot keeps its key
+// on any shard)
+inline std::size_t slotCoalescingKey(SlotId slot, TickUpdateType type) {
+    return static_cast<std::size_t>(slot) * 2 + coalescingLane(type);
+}
+
+// One slot moving between shards, at most one at a time
+// Idle → Requested (main thread, requestMigration) → Flipped (producer: Handoff marker queued behind the
+// slot's last updates on the old shard, new updates routed to the new one) → HandedOff (old worker: marker
+// reached, the slot's last updates applied and sent) → Idle (new worker: slot state adopted)
+// ARCHITECTURE: The new worker holds the slot's updates until HandedOff - per-symbol order survives the move
+// and the state is swapped between the workers once, never shared
+enum class MigrationPhase : std::uint8_t { Idle, Requested, Flipped, HandedOff };
+
+struct SlotMigration {
+    std::atomic<MigrationPhase> phase{MigrationPhase::Idle};
+    // REASON: Atomics - a timed-out move lets the main thread request the next while the old worker still reads
+    std::atomic<std::uint32_t> generation{0};       // Handoff marker's TickUpdate::aux (a stale marker is ignored)
+    std::atomic<SlotId> slot{kInvalidSlot};
+    std::atomic<std::uint16_t> from{0};
+    std::atomic<std::uint16_t> to{0};
+    std::atomic<std::uint64_t> completed{0};        // Moves adopted by the new owner
+    std::atomic<std::uint64_t> abandoned{0};        // New owner gave up waiting (slot state restarted there)
+};
+
+// Lock-free overflow counters (written by the producer, read by the worker for rate-limited logs)
+// REASON: Own cache line - producer-written while the worker polls the shard's queue pointers (hasOverflow)
+struct alignas(64) OverflowCounters {
+    std::atomic<std::uint64_t> dropped{0};    // DropNewest (or Spill past its budget): updates lost
+    std::atomic<std::uint64_t> conflated{0};  // ConflateLatest: updates written to the coalescing table
+    std::atomic<std::uint64_t> spilled{0};    // Spill: updates diverted to the secondary queue
+    std::atomic<std::uint64_t> superseded{0}; // Coalescing table entries overwritten before the worker drained them
+    std::atomic<std::uint64_t> tradesDropped{0};  // PrioritizeTrades: trade lane full (also counted in dropped)
+    std::atomic<std::uint64_t> spillOverBudget{0};  // Spill: refused at spillBudget (also counted in dropped)
+};
+
+// One producer thread's enqueue handle on one shard queue (see BasicIngestStage)
+// PITFALL: moodycamel only keeps FIFO order within one producer - a thread using a token must use it for
+// every enqueue on that queue (tokenless enqueues go to another sub-queue and can overtake)
+// NOTE: An explicit producer keeps the blocks it once used - with several connections the preallocated
+// capacity is shared first come, first served
+template <typename Queue>
+struct ProducerHandle;
+
+template <>
+struct ProducerHandle<MpmcTickQueue> {
+    explicit ProducerHandle(MpmcTickQueue& queue) : token(queue) {}
+    bool push(MpmcTickQueue& queue, const TickUpdate& update) { return queue.try_enqueue(token, update); }
+    bool pushBulk(MpmcTickQueue& queue, const TickUpdate* updates, std::size_t count) {
+        return queue.try_enqueue_bulk(token, updates, count);
+    }
+    moodycamel::ProducerToken token;
+};
+
+template <>
+struct ProducerHandle<SpscTickQueue> {
+    explicit ProducerHandle(SpscTickQueue&) {}
+    bool push(SpscTickQueue& queue, const TickUpdate& update) { return queue.try_enqueue(update); }
+    bool pushBulk(SpscTickQueue& queue, const TickUpdate* updates, std::size_t count) {
+        return queue.try_enqueue_bulk(updates, count);
+    }
+};
+
+// One worker's inbox: queue + overflow + wake-up, on its own cache lines
+// REASON: Producer touches several shards per burst, avoid false sharing between them
+template <typename Queue>
+struct alignas(64) BasicShard {
+    BasicShard(std::size_t queueCapacity, WaitConfig waitConfig, IngestMode ingestMode,
+               OverflowPolicy overflowPolicy, std::size_t coalescingKeys, HugePageConfig memory = {})
+        : queue(makeQueue(queueCapacity, memory))
+        , waiter(waitConfig)
+        , mode(ingestMode)
+        , policy(overflowPolicy) {
+        if (mode == IngestMode::Coalesce || policy == OverflowPolicy::ConflateLatest
+            || policy == OverflowPolicy::PrioritizeTrades) {
+            coalescing = std::make_unique<CoalescingTable>(coalescingKeys, memory);
+        }
+        if (policy == OverflowPolicy::Spill) {
+            spill = std::make_unique<MpmcTickQueue>(queueCapacity);
+        }
+        if (policy == OverflowPolicy::PrioritizeTrades) {
+            trades = std::make_unique<MpmcTickQueue>(queueCapacity);
+        }
+    }
+
+    // REASON: Guaranteed elision - neither queue type is movable
+    static Queue makeQueue(std::size_t capacity, HugePageConfig memory) {
+        if constexpr (std::is_same_v<Queue, SpscTickQueue>) {
+            return Queue(capacity, memory);
+        } else {
+            return Queue(capacity);
+        }
+    }
+
+    // Bytes parked on the spill queue (approximate, as size_approx)
+    // PITFALL: Counts queued updates, not the blocks moodycamel keeps after a drain - the budget caps the peak
+    std::size_t spillBytes() const { return spill ? spill->size_approx() * sizeof(TickUpdate) : 0; }
+
+    // Consumer side: anything parked outside the main queue
+    bool hasOverflow() const {
+        return (spill && spill->size_approx() > 0) || (coalescing && coalescing->hasPending())
+            || (trades && trades->size_approx() > 0);
+    }
+
+    Queue queue;  // Single producer (EReader msg thread), single consumer
+    ConsumerWaiter waiter;
+    const IngestMode mode;
+    const OverflowPolicy policy;
+    std::unique_ptr<CoalescingTable> coalescing;  // Coalesce mode or ConflateLatest only
+    std::unique_ptr<MpmcTickQueue> spill;         // Spill only (enqueue allocates when needed)
+    std::size_t spillLimit = 0;                   // Spill: updates the spill queue may hold, 0 = unbounded
+    std::unique_ptr<MpmcTickQueue> trades;        // PrioritizeTrades only: every AllLast (bounded, preallocated)
+    OverflowCounters overflow;
+    QueueOccupancy occupancy;                     // ingest.sizing: sampled by the worker (WorkerConfig::trackOccupancy)
+};
+
+// Routes each TickUpdate to the shard owning its instrument slot
+// ARCHITECTURE: slot % N - slots are dense, so symbols spread round-robin across workers.
+// One symbol always lands on the same shard: per-symbol ordering and thread-private state.
+// With IngestConfig::movableSlots a slot's owner can change through a SlotMigration (hot-symbol rebalancing)
+template <typename Queue>
+class BasicShardRouter {
+public:
+    using QueueType = Queue;
+    using Shard = BasicShard<Queue>;
+
+    BasicShardRouter(std::size_t shardCount, std::size_t queueCapacityPerShard, WaitConfig waitConfig = {},
+                     IngestConfig ingest = {}) {
+        if (shardCount == 0) {
+            shardCount = 1;
+        }
+        // REASON: A shard only sees slots s with s % N == i, so its table holds ceil(capacity / N) symbols -
+        // unless slots move, then any slot may land on any shard
+        m_movable = ingest.movableSlots;
+        const std::size_t slotsPerShard = m_movable ? ingest.slotCapacity
+                                                    : (ingest.slotCapacity + shardCount - 1) / shardCount;
+        m_shards.reserve(shardCount);
+        for (std::size_t i = 0; i < shardCount; ++i) {
+            m_shards.push_back(std::make_unique<Shard>(queueCapacityPerShard, waitConfig, ingest.mode,
+                                                       ingest.policy, slotsPerShard * kTickTypes, ingest.memory));
+            if (ingest.spillBudget > 0) {
+                m_shards.back()->spillLimit = std::max<std::size_t>(1, ingest.spillBudget / sizeof(TickUpdate));
+            }
+        }
+        if (m_movable) {
+            m_slots = ingest.slotCapacity;
+            m_owners = std::make_unique<std::atomic<std::uint16_t>[]>(m_slots);
+            m_ticks = std::make_unique<std::atomic<std::uint32_t>[]>(m_slots);
+            for (std::size_t slot = 0; slot < m_slots; ++slot) {
+                m_owners[slot].store(static_cast<std::uint16_t>(slot % shardCount), std::memory_order_relaxed);
+                m_ticks[slot].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    BasicShardRouter(const BasicShardRouter&) = delete;
+    BasicShardRouter& operator=(const BasicShardRouter&) = delete;
+
+    std::size_t shardCount() const { return m_shards.size(); }
+    // Any thread (a moved slot's owner is a relaxed load)
+    std::size_t shardFor(SlotId slot) const {
+        return m_owners && slot < m_slots ? m_owners[slot].load(std::memory_order_relaxed) : slot % m_shards.size();
+    }
+    Shard& shard(std::size_t index) { return *m_shards[index]; }
+
+    // ========== Shard rebalancing (IngestConfig::movableSlots) ==========
+    bool movableSlots() const { return m_movable; }
+
+    // Producer side: one more update routed for slot
+    // PERFORMANCE: Single producer - plain load + store, no locked RMW on the callback thread
+    void countTick(SlotId slot) {
+        if (m_ticks && slot < m_slots) {
+            std::atomic<std::uint32_t>& ticks = m_ticks[slot];
+            ticks.store(ticks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    // Updates routed for slot since start (wraps, any thread)
+    std::uint32_t ticks(SlotId slot) const {
+        return m_ticks && slot < m_slots ? m_ticks[slot].load(std::memory_order_relaxed) : 0;
+    }
+
+    // Main thread: starts moving slot to shard `to`; false = a move is still in flight or nothing to move
+    bool requestMigration(SlotId slot, std::size_t to) {
+        if (!m_owners || slot >= m_slots || to >= m_shards.size()
+            || m_migration.phase.load(std::memory_order_acquire) != MigrationPhase::Idle) {
+            return false;
+        }
+        const std::size_t from = shardFor(slot);
+        if (from == to) {
+            return false;
+        }
+        m_migration.generation.fetch_add(1, std::memory_order_relaxed);
+        m_migration.slot.store(slot, std::memory_order_relaxed);
+        m_migration.from.store(static_cast<std::uint16_t>(from), std::memory_order_relaxed);
+        m_migration.to.store(static_cast<std::uint16_t>(to), std::memory_order_relaxed);
+        m_migration.phase.store(MigrationPhase::Requested, std::memory_order_release);
+        return true;
+    }
+
+    bool migrationRequested() const {
+        return m_migration.phase.load(std::memory_order_acquire) == MigrationPhase::Requested;
+    }
+
+    SlotMigration& migration() { return m_migration; }
+    const SlotMigration& migration() const { return m_migration; }
+
+    // Producer side, between two dispatch cycles (nothing staged): queues the Handoff marker on the old shard
+    // and routes the slot to the new one; false = old shard full, retried at the next cycle
+    // handle: the producer's handle on the old shard (its FIFO is the one the slot's updates went through)
+    bool handOff(ProducerHandle<Queue>& handle) {
+        const SlotId slot = m_migration.slot.load(std::memory_order_relaxed);
+        const std::size_t from = m_migration.from.load(std::memory_order_relaxed);
+        TickUpdate marker;
+        marker.slot = slot;
+        marker.type = TickUpdateType::Handoff;
+        marker.aux = m_migration.generation.load(std::memory_order_relaxed);
+        // REASON: Flipped before the marker is visible - the old worker checks it when the marker arrives
+        m_migration.phase.store(MigrationPhase::Flipped, std::memory_order_release);
+        Shard& source = *m_shards[from];
+        // REASON: Same path as the slot's last updates - behind them in the queue, or on the spill queue once spilling
+        const bool spilling = source.policy == OverflowPolicy::Spill && source.spill->size_approx() > 0;
+        bool queued = !spilling && handle.push(source.queue, marker);
+        if (!queued && source.policy == OverflowPolicy::Spill) {
+            source.spill->enqueue(marker);
+            queued = true;
+        }
+        if (!queued) {
+            m_migration.phase.store(MigrationPhase::Requested, std::memory_order_release);
+            return false;
+        }
+        m_owners[slot].store(m_migration.to.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        source.waiter.notify();
+        return true;
+    }
+
+    // CRITICAL PATH: Non-blocking enqueue + wake the owning worker if parked
+    // Returns false only when the update was dropped (DropNewest, or a bar / out-of-range slot under ConflateLatest)
+    bool try_enqueue(const TickUpdate& update) {
+        Shard& target = *m_shards[shardFor(update.slot)];
+        const bool accepted = route(target, update, [](Queue& queue, const TickUpdate& item) {
+            return queue.try_enqueue(item);
+        });
+        if (accepted) {
+            target.waiter.notify();
+        }
+        return accepted;
+    }
+
+    // One staged burst for one shard (BasicIngestStage::flush), same policies as try_enqueue
+    // PERFORMANCE: Plain Queue mode with nothing parked = one bulk enqueue + one wake-up; otherwise (full
+    // queue, coalescing, spilling) the burst falls back to per-update routing
+    // Returns the number of updates dropped
+    std::size_t enqueueBulk(std::size_t index, ProducerHandle<Queue>& handle, const TickUpdate* updates,
+                            std::size_t count) {
+        Shard& target = *m_shards[index];
+        // NOTE: PrioritizeTrades always routes per update - a burst mixes both lanes
+        const bool bulk = target.mode == IngestMode::Queue
+            && (target.policy == OverflowPolicy::DropNewest
+                || (target.policy == OverflowPolicy::ConflateLatest && !target.coalescing->hasPending())
+                || (target.policy == OverflowPolicy::Spill && target.spill->size_approx() == 0));
+        std::size_t dropped = 0;
+        if (!bulk || !handle.pushBulk(target.queue, updates, count)) {
+            auto push = [&handle](Queue& queue, const TickUpdate& item) { return handle.push(queue, item); };
+            for (std::size_t i = 0; i < count; ++i) {
+                dropped += route(target, updates[i], push) ? 0 : 1;
+            }
+        }
+        if (dropped < count) {
+            target.waiter.notify();
+        }
+        return dropped;
+    }
+
+private:
+    static constexpr std::size_t kTickTypes = 2;  // Coalesced: BidAsk (or MidPoint), AllLast
+
+    // Applies the shard's ingest mode and overflow policy; push(queue, update) is the producer's enqueue
+    // false = dropped (no wake-up needed)
+    template <typename Push>
+    bool route(Shard& target, const TickUpdate& update, Push&& push) {
+        if (target.policy == OverflowPolicy::PrioritizeTrades && update.type == TickUpdateType::AllLast) {
+            // REASON: Every trade takes the lane (not only on overflow) - the worker drains it first, so a
+            // trade left in the main queue would be applied after newer ones
+            // PERFORMANCE: try_enqueue never allocates - the lane is bounded by its preallocated capacity
+            if (!target.trades->try_enqueue(update)) {
+                target.overflow.dropped.fetch_add(1, std::memory_order_relaxed);
+                target.overflow.tradesDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        }
+        if (target.mode == IngestMode::Coalesce && isCoalescable(update)) {
+            const std::size_t key = coalescingKey(update);
+            if (key < target.coalescing->keys()) {
+                // PERFORMANCE: No queue traffic per tick - one in-place write + one bitmap OR
+                coalesce(target, key, update);
+                return true;
+            }
+        }
+        switch (target.policy) {
+        case OverflowPolicy::DropNewest:
+            if (!push(target.queue, update)) {
+                target.overflow.dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            break;
+        case OverflowPolicy::ConflateLatest:
+        case OverflowPolicy::PrioritizeTrades: {
+            // PITFALL: While a key is pending, keep coalescing - a queued newer update would be
+            // applied before the older coalesced one
+            // REASON: Bars / depth changes are distinct records, never coalesced (dropped like DropNewest when full)
+            const std::size_t key = coalescingKey(update);
+            if (!isCoalescable(update) || key >= target.coalescing->keys()) {
+                if (!push(target.queue, update)) {
+                    target.overflow.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+            }
+            if (target.coalescing->isPending(key) || !push(target.queue, update)) {
+                coalesce(target, key, update);
+                target.overflow.conflated.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+        case OverflowPolicy::Spill:
+            // REASON: Once spilling, stay on the spill queue until the worker drains it (per-symbol order)
+            if (target.spill->size_approx() > 0 || !push(target.queue, update)) {
+                // PERFORMANCE: size_approx only on the spill path - the queued path never reads it
+                if (target.spillLimit > 0 && target.spill->size_approx() >= target.spillLimit) {
+                    target.overflow.spillOverBudget.fetch_add(1, std::memory_order_relaxed);
+                    target.overflow.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                target.spill->enqueue(update);
+                target.overflow.spilled.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+        }
+        return true;
+    }
+
+    static void coalesce(Shard& target, std::size_t key, const TickUpdate& update) {
+        if (target.coalescing->write(key, update)) {
+            target.overflow.superseded.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t coalescingKey(const TickUpdate& update) const {
+        if (m_movable) {
+            return slotCoalescingKey(update.slot, update.type);
+        }
+        const std::size_t local = update.slot / m_shards.size();
+        return local * kTickTypes + coalescingLane(update.type);
+    }
+
+    std::vector<std::unique_ptr<Shard>> m_shards;  // REASON: Shard is non-movable (atomics, semaphore)
+    bool m_movable = false;
+    std::size_t m_slots = 0;
+    std::unique_ptr<std::atomic<std::uint16_t>[]> m_owners;  // By slot (movableSlots), written by the producer
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_ticks;   // By slot (movableSlots), written by the producer
+    SlotMigration m_migration;
+};
+
+// Producer-local staging: what one dispatch cycle (EReader::processMsgs) routes, one small buffer per shard
+// PERFORMANCE: One bulk enqueue and at most one wake-up per shard per cycle instead of one per tick - queue
+// atomics are amortized over the burst, and the worker sees the burst as one unit
+// SCOPE: Exactly one producer thread; flush() at the end of every cycle (staged updates are not visible before)
+template <typename Queue>
+class BasicIngestStage {
+public:
+    using Target = BasicShardRouter<Queue>;  // Ingest sink policy (IngestSink.h)
+
+    static constexpr std::size_t kCapacity = 64;  // Per shard, a full buffer is flushed right away
+
+    explicit BasicIngestStage(BasicShardRouter<Queue>& router) : m_router(router) {
+        for (std::size_t i = 0; i < router.shardCount(); ++i) {
+            m_buffers.push_back(std::make_unique<Buffer>(router.shard(i).queue));
+        }
+        m_pending.reserve(router.shardCount());
+    }
+
+    BasicIngestStage(const BasicIngestStage&) = delete;
+    BasicIngestStage& operator=(const BasicIngestStage&) = delete;
+
+    // NOTE: Overflow is decided at flush - a staged update is not dropped yet
+    void stage(const TickUpdate& update) {
+        const std::size_t index = m_router.shardFor(update.slot);
+        m_router.countTick(update.slot);
+        Buffer& buffer = *m_buffers[index];
+        if (!buffer.pending) {
+            buffer.pending = true;
+            m_pending.push_back(index);
+        }
+        buffer.updates[buffer.count++] = update;
+        if (buffer.count == kCapacity) {
+            flushShard(index);
+        }
+    }
+
+    // Returns the number of updates dropped by the overflow policy
+    std::size_t flush() {
+        std::size_t dropped = 0;
+        for (const std::size_t index : m_pending) {
+            dropped += flushShard(index);
+            m_buffers[index]->pending = false;
+        }
+        m_pending.clear();
+        // REASON: A move takes effect between two cycles - everything staged for the slot is queued before its marker
+        if (m_router.migrationRequested()) {
+            m_router.handOff(m_buffers[m_router.migration().from.load(std::memory_order_relaxed)]->handle);
+        }
+        return dropped;
+    }
+
+    bool empty() const { return m_pending.empty(); }
+
+private:
+    struct Buffer {
+        explicit Buffer(Queue& queue) : handle(queue) {}
+        std::array<TickUpdate, kCapacity> updates;
+        std::size_t count = 0;
+        bool pending = false;  // Listed in m_pending
+        ProducerHandle<Queue> handle;
+    };
+
+    std::size_t flushShard(std::size_t index) {
+        Buffer& buffer = *m_buffers[index];
+        const std::size_t count = buffer.count;
+        buffer.count = 0;
+        return count == 0 ? 0 : m_router.enqueueBulk(index, buffer.handle, buffer.updates.data(), count);
+    }
+
+    BasicShardRouter<Queue>& m_router;
+    std::vector<std::unique_ptr<Buffer>> m_buffers;  // By shard (ProducerToken is non-movable)
+    std::vector<std::size_t> m_pending;              // Shards with staged updates since the last flush
+};
+
+using ShardRouter = BasicShardRouter<MpmcTickQueue>;
+using SpscShardRouter = BasicShardRouter<SpscTickQueue>;
+using IngestStage = BasicIngestStage<MpmcTickQueue>;
+using SpscIngestStage = BasicIngestStage<SpscTickQueue>;
+
+} // namespace tws_bridge
@@ -0,0 +1,272 @@
+// ShmRing.h - Shared-memory snapshot ring for co-located consumers (SPMC, seqlock'd slots)
+// SCOPE: Writer = one Redis worker (its shard's snapshots), readers = any process on this host
+// NOTE: Self-contained (POSIX + C++17 only) - local strategies include this header as the reader library
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+struct ShmRingConfig {
+    bool enabled = false;
+    std::string name = "/tws-bridge-ticks";         // shm_open name, "-{shardId}" appended per worker
+    std::size_t slots = 4096;                       // Rounded up to a power of two
+    std::size_t slotBytes = 512;                    // Channel + payload per record (larger ones are skipped, counted)
+};
+
+namespace shm_detail {
+
+constexpr std::uint32_t kMagic = 0x52534254;        // "TBSR" little-endian
+constexpr std::uint32_t kVersion = 1;
+
+// PERFORMANCE: Own cache line - readers poll it, the writer bumps it once per record
+struct alignas(64) RingHeader {
+    std::uint32_t magic;                            // Stored last (release) - readers skip a half-built ring
+    std::uint32_t version;
+    std::uint32_t slotBytes;
+    std::uint32_t slotCount;                        // Power of two
+    alignas(64) std::atomic<std::uint64_t> published;  // Records written so far (next sequence)
+};
+
+// Seqlock: 2n+1 while record n is written, 2n+2 once it is complete
+struct alignas(64) SlotHeader {
+    std::atomic<std::uint64_t> seq;
+    std::uint32_t channelBytes;
+    std::uint32_t payloadBytes;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared-memory atomics must be lock-free");
+
+inline std::size_t slotStride(std::size_t slotBytes) {
+    return (sizeof(SlotHeader) + slotBytes + 63) / 64 * 64;
+}
+
+inline std::size_t mappingBytes(std::size_t slotCount, std::size_t slotBytes) {
+    return sizeof(RingHeader) + slotCount * slotStride(slotBytes);
+}
+
+} // namespace shm_detail
+
+// Single producer: the owning worker thread publishes every snapshot it also sends to Redis
+// CRITICAL PATH: write() = two memcpy + three stores, no syscall, never waits for a reader
+// BACKPRESSURE: None - a reader that falls a full ring behind loses records (counted on its side)
+class ShmRingWriter {
+public:
+    // Creates (or replaces) /dev/shm/{name}; nullptr on failure (logged)
+    static std::unique_ptr<ShmRingWriter> create(const std::string& name, std::size_t slots, std::size_t slotBytes) {
+        std::size_t count = 1;
+        while (count < slots) {
+            count <<= 1;
+        }
+        const std::size_t bytes = shm_detail::mappingBytes(count, slotBytes);
+        ::shm_unlink(name.c_str());  // REASON: A stale ring from a crashed run may have another geometry
+        const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            std::cerr << "[SHM] Cannot create " << name << ": " << std::strerror(errno) << "\n";
+            return nullptr;
+        }
+        void* base = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0
+            ? ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            std::cerr << "[SHM] Cannot map " << name << ": " << std::strerror(errno) << "\n";
+            ::shm_unlink(name.c_str());
+            return nullptr;
+        }
+        return std::unique_ptr<ShmRingWriter>(new ShmRingWriter(name, static_cast<char*>(base), bytes, count, slotBytes));
+    }
+
+    ~ShmRingWriter() {
+        ::munmap(m_base, m_bytes);
+        ::shm_unlink(m_name.c_str());  // NOTE: Attached readers keep their mapping until they close it
+    }
+
+    ShmRingWriter(const ShmRingWriter&) = delete;
+    ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+
+    // False if the record does not fit a slot (skipped)
+    bool write(std::string_view channel, std::string_view payload) {
+        if (channel.size() + payload.size() > m_slotBytes) {
+            m_oversized.store(m_oversized.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        const std::uint64_t sequence = m_next;
+        char* slot = slotAt(sequence);
+        auto* header = reinterpret_cast<shm_detail::SlotHeader*>(slot);
+        header->seq.store(2 * sequence + 1, std::memory_order_relaxed);
+        // REASON: Odd seq visible before any payload byte changes (readers see a torn copy as torn)
+        std::atomic_thread_fence(std::memory_order_release);
+        header->channelBytes = static_cast<std::uint32_t>(channel.size());
+        header->payloadBytes = static_cast<std::uint32_t>(payload.size());
+        char* data = slot + sizeof(shm_detail::SlotHeader);
+        std::memcpy(data, channel.data(), channel.size());
+        std::memcpy(data + channel.size(), payload.data(), payload.size());
+        header->seq.store(2 * sequence + 2, std::memory_order_release);
+        m_next = sequence + 1;
+        m_ring->published.store(m_next, std::memory_order_release);
+        return true;
+    }
+
+    std::uint64_t published() const { return m_ring->published.load(std::memory_order_relaxed); }
+    std::uint64_t oversized() const { return m_oversized.load(std::memory_order_relaxed); }
+    const std::string& name() const { return m_name; }
+
+private:
+    ShmRingWriter(std::string name, char* base, std::size_t bytes, std::size_t count, std::size_t slotBytes)
+        : m_name(std::move(name))
+        , m_base(base)
+        , m_bytes(bytes)
+        , m_ring(reinterpret_cast<shm_detail::RingHeader*>(base))
+        , m_mask(count - 1)
+        , m_stride(shm_detail::slotStride(slotBytes))
+        , m_slotBytes(slotBytes) {
+        // REASON: ftruncate zero-fills - every slot seq starts at 0 (no record), published at 0
+        m_ring->version = shm_detail::kVersion;
+        m_ring->slotBytes = static_cast<std::uint32_t>(slotBytes);
+        m_ring->slotCount = static_cast<std::uint32_t>(count);
+        std::atomic_thread_fence(std::memory_order_release);
+        reinterpret_cast<std::atomic<std::uint32_t>*>(&m_ring->magic)->store(shm_detail::kMagic, std::memory_order_release);
+    }
+
+    char* slotAt(std::uint64_t sequence) const {
+        return m_base + sizeof(shm_detail::RingHeader) + static_cast<std::size_t>(sequence & m_mask) * m_stride;
+    }
+
+    std::string m_name;
+    char* m_base;
+    std::size_t m_bytes;
+    shm_detail::RingHeader* m_ring;
+    std::size_t m_mask;
+    std::size_t m_stride;
+    std::size_t m_slotBytes;
+    std::uint64_t m_next = 0;
+    std::atomic<std::uint64_t> m_oversized{0};      // Readable from any thread (metrics)
+};
+
+// One record, views into the reader's copy buffer (valid until the next read())
+struct ShmRecord {
+    std::string_view channel;                       // Redis channel it was also published on (TWS:TICKS:{SYMBOL})
+    std::string_view payload;                       // Same snapshot JSON as on Redis
+    std::uint64_t sequence = 0;
+};
+
+enum class ShmReadStatus {
+    Ok,
+    Empty                                           // Caught up - poll again (spin, yield or sleep: reader's choice)
+};
+
+// Any number of independent readers, each with its own position; never writes to the mapping
+// PITFALL: Seqlock copy - the payload is copied first and only trusted if seq did not move meanwhile
+class ShmRingReader {
+public:
+    // Maps an existing ring read-only; nullptr if absent, still initializing or another version
+    // fromOldest: start at the oldest record still in the ring instead of the next new one
+    static std::unique_ptr<ShmRingReader> open(const std::string& name, bool fromOldest = false) {
+        const int fd = ::shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info {};
+        void* base = ::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(shm_detail::RingHeader)
+            ? ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            return nullptr;
+        }
+        const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+        auto* ring = static_cast<const shm_detail::RingHeader*>(base);
+        const std::uint32_t magic =
+            reinterpret_cast<const std::atomic<std::uint32_t>*>(&ring->magic)->load(std::memory_order_acquire);
+        if (magic != shm_detail::kMagic || ring->version != shm_detail::kVersion
+            || bytes < shm_detail::mappingBytes(ring->slotCount, ring->slotBytes)) {
+            ::munmap(base, bytes);
+            return nullptr;
+        }
+        return std::unique_ptr<ShmRingReader>(new ShmRingReader(static_cast<const char*>(base), bytes, fromOldest));
+    }
+
+    ~ShmRingReader() { ::munmap(const_cast<char*>(m_base), m_bytes); }
+
+    ShmRingReader(const ShmRingReader&) = delete;
+    ShmRingReader& operator=(const ShmRingReader&) = delete;
+
+    ShmReadStatus read(ShmRecord& record) {
+        for (;;) {
+            const std::uint64_t published = m_ring->published.load(std::memory_order_acquire);
+            if (m_next >= published) {
+                return ShmReadStatus::Empty;
+            }
+            if (published - m_next > m_slotCount) {
+                // BACKPRESSURE: Lapped - jump to the oldest record not yet overwritten
+                m_lost += published - m_slotCount - m_next;
+                m_next = published - m_slotCount;
+            }
+            const char* slot = m_base + sizeof(shm_detail::RingHeader)
+                               + static_cast<std::size_t>(m_next & (m_slotCount - 1)) * m_stride;
+            auto* header = reinterpret_cast<const shm_detail::SlotHeader*>(slot);
+            const std::uint64_t expected = 2 * m_next + 2;
+            const std::uint64_t before = header->seq.load(std::memory_order_acquire);
+            if (before == expected) {
+                const std::uint32_t channelBytes = header->channelBytes;
+                const std::uint32_t payloadBytes = header->payloadBytes;
+                if (static_cast<std::size_t>(channelBytes) + payloadBytes <= m_buffer.size()) {
+                    std::memcpy(m_buffer.data(), slot + sizeof(shm_detail::SlotHeader), channelBytes + payloadBytes);
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (header->seq.load(std::memory_order_relaxed) == expected) {
+                        record.channel = std::string_view(m_buffer.data(), channelBytes);
+                        record.payload = std::string_view(m_buffer.data() + channelBytes, payloadBytes);
+                        record.sequence = m_next++;
+                        return ShmReadStatus::Ok;
+                    }
+                }
+            }
+            // REASON: Overwritten while (or before) we copied it - count and move on
+            ++m_lost;
+            ++m_next;
+        }
+    }
+
+    // Records overwritten before this reader got to them
+    std::uint64_t lost() const { return m_lost; }
+    std::uint64_t position() const { return m_next; }
+
+private:
+    ShmRingReader(const char* base, std::size_t bytes, bool fromOldest)
+        : m_base(base)
+        , m_bytes(bytes)
+        , m_ring(reinterpret_cast<const shm_detail::RingHeader*>(base))
+        , m_slotCount(m_ring->slotCount)
+        , m_stride(shm_detail::slotStride(m_ring->slotBytes))
+        , m_buffer(m_ring->slotBytes) {
+        const std::uint64_t published = m_ring->published.load(std::memory_order_acquire);
+        m_next = !fromOldest ? published : published > m_slotCount ? published - m_slotCount : 0;
+    }
+
+    const char* m_base;
+    std::size_t m_bytes;
+    const shm_detail::RingHeader* m_ring;
+    std::uint64_t m_slotCount;
+    std::size_t m_stride;
+    std::vector<char> m_buffer;
+    std::uint64_t m_next = 0;
+    std::uint64_t m_lost = 0;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,93 @@
+// SlotColumns.h - Per-slot counter columns (struct of arrays) and a vectorized "changed since" sweep
+// SCOPE: One worker thread owns its columns (RedisWorker tier sweeps)
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tws_bridge {
+
+// One uint32 per slot, zero-initialized, padded to whole 64-slot blocks (the sweep reads no tail)
+// REASON: A column per counter instead of a field in the per-slot entry - a sweep streams 4 bytes per slot
+// instead of one cache line per slot
+class SlotColumn {
+public:
+    static constexpr std::size_t kBlock = 64;  // Slots per sweep step (one 64-bit change mask)
+
+    SlotColumn() = default;
+    explicit SlotColumn(std::size_t slots) : m_values((slots + kBlock - 1) / kBlock * kBlock, 0) {}
+
+    std::uint32_t& operator[](std::size_t slot) { return m_values[slot]; }
+    std::uint32_t operator[](std::size_t slot) const { return m_values[slot]; }
+    std::uint32_t* data() { return m_values.data(); }
+    const std::uint32_t* data() const { return m_values.data(); }
+    std::size_t size() const { return m_values.size(); }
+
+    // Same size required (columns of one worker are sized from the same registry capacity)
+    void assign(const SlotColumn& other) { std::memcpy(data(), other.data(), size() * sizeof(std::uint32_t)); }
+
+private:
+    std::vector<std::uint32_t> m_values;
+};
+
+// Bit i set: current[i] != seen[i], for the 64 slots starting at both pointers
+// PERFORMANCE: AVX2 compares 8 slots per instruction (-DTWS_BRIDGE_AVX2=ON), SSE2 (x86-64 baseline) 4;
+// other targets compare one by one - the compiler vectorizes that loop where it can
+inline std::uint64_t changedMask(const std::uint32_t* current, const std::uint32_t* seen) {
+    std::uint64_t mask = 0;
+#if defined(__AVX2__)
+    for (unsigned i = 0; i < SlotColumn::kBlock; i += 8) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(seen + i));
+        const __m256i equalLanes = _mm256_cmpeq_epi32(a, b);
+        const unsigned equal = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equalLanes)));
+        mask |= static_cast<std::uint64_t>(~equal & 0xFFu) << i;
+    }
+#elif defined(__SSE2__)
+    for (unsigned i = 0; i < SlotColumn::kBlock; i += 4) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seen + i));
+        const unsigned equal = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+        mask |= static_cast<std::uint64_t>(~equal & 0xFu) << i;
+    }
+#else
+    for (unsigned i = 0; i < SlotColumn::kBlock; ++i) {
+        mask |= static_cast<std::uint64_t>(current[i] != seen[i]) << i;
+    }
+#endif
+    return mask;
+}
+
+// Calls fn(slot) for every slot below `slots` whose current value differs from seen, in slot order, and
+// brings seen up to date
+// PERFORMANCE: Unchanged blocks cost one mask each - a sweep over 5,000 slots reads 40 KB in ~80 steps
+template <typename Fn>
+void forEachChanged(const SlotColumn& current, SlotColumn& seen, std::size_t slots, Fn&& fn) {
+    const std::size_t end = slots < current.size() ? slots : current.size();
+    for (std::size_t base = 0; base < end; base += SlotColumn::kBlock) {
+        std::uint64_t mask = changedMask(current.data() + base, seen.data() + base);
+        if (mask == 0) {
+            continue;
+        }
+        const std::size_t count = end - base < SlotColumn::kBlock ? end - base : SlotColumn::kBlock;
+        if (count < SlotColumn::kBlock) {
+            mask &= (std::uint64_t{1} << count) - 1;
+        }
+        std::memcpy(seen.data() + base, current.data() + base, count * sizeof(std::uint32_t));
+        while (mask != 0) {
+            fn(base + static_cast<unsigned>(__builtin_ctzll(mask)));
+            mask &= mask - 1;
+        }
+    }
+}
+
+} // namespace tws_bridge
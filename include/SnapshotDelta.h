@@ -0,0 +1,141 @@
+// SnapshotDelta.h - Per-symbol baseline for delta snapshots (changed fields + sequence, periodic keyframes)
+// SCOPE: Redis Worker thread - one DeltaTrack per slot, encoders in SnapshotEncoder.h / BinaryEncoder.h
+
+#pragma once
+
+#include "MarketData.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace tws_bridge {
+
+// Delta snapshots on TWS:TICKS:* / TWS:BIN:TICKS:* (stream, LVC, shm, sinks keep full snapshots)
+struct DeltaConfig {
+    bool enabled = false;
+    std::uint32_t keyframeEvery = 100;              // Full snapshot after this many deltas
+    std::chrono::seconds keyframeInterval{5};       // ... or once this much event time has passed
+};
+
+// Fields a delta carries (bit order = wire order in the binary Delta kind)
+namespace DeltaField {
+constexpr std::uint16_t BidPrice = 1u << 0;
+constexpr std::uint16_t AskPrice = 1u << 1;
+constexpr std::uint16_t LastPrice = 1u << 2;
+constexpr std::uint16_t BidSize = 1u << 3;
+constexpr std::uint16_t AskSize = 1u << 4;
+constexpr std::uint16_t LastSize = 1u << 5;
+constexpr std::uint16_t QuoteTime = 1u << 6;
+constexpr std::uint16_t TradeTime = 1u << 7;
+constexpr std::uint16_t Exchange = 1u << 8;
+constexpr std::uint16_t Conditions = 1u << 9;
+constexpr std::uint16_t PastLimit = 1u << 10;
+constexpr std::uint16_t Derived = 1u << 11;  // mid / spread / vwap / rollingVolume, sent together
+}
+
+// Last values sent on the delta channel for one symbol
+// NOTE: Exact compares - TWS resends the same double for an unchanged price
+struct DeltaBaseline {
+    double bidPrice = 0.0;
+    double askPrice = 0.0;
+    double lastPrice = 0.0;
+    std::int64_t bidSize = 0;
+    std::int64_t askSize = 0;
+    std::int64_t lastSize = 0;
+    std::uint8_t sizeScale = 0;
+    long quoteTimestamp = 0;
+    long tradeTimestamp = 0;
+    std::string_view exchange;                      // Static TradeCodes.h name (pointer-stable)
+    std::uint64_t tradeConditions = 0;
+    bool pastLimit = false;
+    double mid = 0.0;
+    double spread = 0.0;
+    double vwap = 0.0;
+    std::int64_t rollingVolume = 0;
+
+    std::uint16_t changes(const InstrumentState& state, bool withDerived) const {
+        std::uint16_t mask = 0;
+        mask |= state.bidPrice != bidPrice ? DeltaField::BidPrice : 0;
+        mask |= state.askPrice != askPrice ? DeltaField::AskPrice : 0;
+        mask |= state.lastPrice != lastPrice ? DeltaField::LastPrice : 0;
+        mask |= state.bidSize != bidSize ? DeltaField::BidSize : 0;
+        mask |= state.askSize != askSize ? DeltaField::AskSize : 0;
+        mask |= state.lastSize != lastSize ? DeltaField::LastSize : 0;
+        if (state.sizeScale != sizeScale) {
+            mask |= DeltaField::BidSize | DeltaField::AskSize | DeltaField::LastSize;  // REASON: Units rescaled
+        }
+        mask |= state.quoteTimestamp != quoteTimestamp ? DeltaField::QuoteTime : 0;
+        mask |= state.tradeTimestamp != tradeTimestamp ? DeltaField::TradeTime : 0;
+        mask |= state.exchange != exchange ? DeltaField::Exchange : 0;
+        mask |= state.tradeConditions != tradeConditions ? DeltaField::Conditions : 0;
+        mask |= state.pastLimit != pastLimit ? DeltaField::PastLimit : 0;
+        if (withDerived) {
+            const DerivedMetrics& derived = state.derived;
+            const bool changed = derived.mid != mid || derived.spread != spread || derived.vwap != vwap
+                              || derived.rolling.total() != rollingVolume;
+            mask |= changed ? DeltaField::Derived : 0;
+        }
+        return static_cast<std::uint16_t>(mask);
+    }
+
+    void capture(const InstrumentState& state) {
+        bidPrice = state.bidPrice;
+        askPrice = state.askPrice;
+        lastPrice = state.lastPrice;
+        bidSize = state.bidSize;
+        askSize = state.askSize;
+        lastSize = state.lastSize;
+        sizeScale = state.sizeScale;
+        quoteTimestamp = state.quoteTimestamp;
+        tradeTimestamp = state.tradeTimestamp;
+        exchange = state.exchange;
+        tradeConditions = state.tradeConditions;
+        pastLimit = state.pastLimit;
+        mid = state.derived.mid;
+        spread = state.derived.spread;
+        vwap = state.derived.vwap;
+        rollingVolume = state.derived.rolling.total();
+    }
+};
+
+// Per-slot delta channel state: baseline and keyframe schedule (the sequence is InstrumentState::sequence)
+class DeltaTrack {
+public:
+    // Next message: keyframe (full snapshot) or delta against the baseline
+    // REASON: Interval measured in event time (snapshot timestamps) - no clock read per publish
+    bool keyframeDue(const InstrumentState& state, const DeltaConfig& config) const {
+        if (!m_synced || m_sinceKeyframe >= config.keyframeEvery) {
+            return true;
+        }
+        const std::int64_t latest = std::max(state.quoteTimestamp, state.tradeTimestamp);
+        const std::int64_t intervalMs = std::chrono::duration_cast<std::chrono::milliseconds>(config.keyframeInterval).count();
+        return intervalMs > 0 && latest - m_keyframeAtMs >= intervalMs;
+    }
+
+    // Records a sent message
+    void sent(const InstrumentState& state, bool keyframe) {
+        if (keyframe) {
+            m_synced = true;
+            m_sinceKeyframe = 0;
+            m_keyframeAtMs = std::max(state.quoteTimestamp, state.tradeTimestamp);
+        } else {
+            ++m_sinceKeyframe;
+        }
+        m_baseline.capture(state);
+    }
+
+    // Next message is a keyframe (e.g. a consumer just subscribed)
+    void resync() { m_synced = false; }
+
+    const DeltaBaseline& baseline() const { return m_baseline; }
+
+private:
+    DeltaBaseline m_baseline;
+    std::int64_t m_keyframeAtMs = 0;
+    std::uint32_t m_sinceKeyframe = 0;
+    bool m_synced = false;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,640 @@
+// SnapshotEncoder.h - Fixed-schema InstrumentState / bar JSON encoders, expanded from SnapshotFields.h
+// SCOPE: Redis Worker hot path (serializeState stays as the RapidJSON reference)
+
+#pragma once
+
+#include "FixedPrice.h"
+#include "IsoTimestamp.h"
+#include "JsonString.h"
+#include "TradeCodes.h"
+#include "SnapshotDelta.h"
+#include "SnapshotFields.h"
+#include "MarketData.h"
+#include "Serialization.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace snapshot_detail {
+
+// ========== Constant Fragments ==========
+// NOTE: Member keys are generated from the field table (SnapshotFields.h memberKey / groupOpener)
+struct Fragment {
+    const char* data;
+    std::size_t size;
+};
+
+template <std::size_t N>
+constexpr Fragment fragment(const char (&text)[N]) {
+    return Fragment{text, N - 1};
+}
+
+inline char* copyFragment(char* out, Fragment fragment) {
+    std::memcpy(out, fragment.data, fragment.size);
+    return out + fragment.size;
+}
+
+// PERFORMANCE: Two digits per step from a lookup table, one branch per digit pair
+inline char* writeUint64(char* out, std::uint64_t value) {
+    static constexpr char kDigitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    char tmp[20];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+    while (value >= 100) {
+        const unsigned pair = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--p = kDigitPairs[pair + 1];
+        *--p = kDigitPairs[pair];
+    }
+    if (value >= 10) {
+        const unsigned pair = static_cast<unsigned>(value) * 2;
+        *--p = kDigitPairs[pair + 1];
+        *--p = kDigitPairs[pair];
+    } else {
+        *--p = static_cast<char>('0' + value);
+    }
+
+    const std::size_t length = static_cast<std::size_t>(end - p);
+    std::memcpy(out, p, length);
+    return out + length;
+}
+
+inline char* writeInt64(char* out, std::int64_t value) {
+    std::uint64_t magnitude = static_cast<std::uint64_t>(value);
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;  // REASON: Well-defined for INT64_MIN
+    }
+    return writeUint64(out, magnitude);
+}
+
+inline char* writeExponent(char* out, int exponent) {
+    if (exponent < 0) {
+        *out++ = '-';
+        exponent = -exponent;
+    }
+    return writeUint64(out, static_cast<std::uint64_t>(exponent));
+}
+
+/**
+ * @brief Shortest round-trip double, formatted exactly like rapidjson::Writer::Double
+ *
+ * [PERFORMANCE] std::to_chars (Ryu-based in libstdc++/MSVC) produces the shortest
+ * digits; the layout rules below mirror RapidJSON's Prettify() so the output is
+ * byte-identical to the reference path.
+ *
+ * PITFALL: NaN/Inf are not valid JSON (RapidJSON writes nothing), encoded as null.
+ */
+inline char* writeDouble(char* out, double value) {
+    if (!std::isfinite(value)) {
+        return copyFragment(out, fragment("null"));
+    }
+    if (value == 0.0) {
+        return std::signbit(value) ? copyFragment(out, fragment("-0.0")) : copyFragment(out, fragment("0.0"));
+    }
+    if (value < 0) {
+        *out++ = '-';
+        value = -value;
+    }
+
+    // Scientific form "d.ddde±XX" gives digits + decimal exponent
+    char sci[32];
+    const std::to_chars_result result = std::to_chars(sci, sci + sizeof(sci), value, std::chars_format::scientific);
+
+    char digits[20];
+    int length = 0;
+    const char* p = sci;
+    for (; p != result.ptr && *p != 'e'; ++p) {
+        if (*p != '.') {
+            digits[length++] = *p;
+        }
+    }
+    int exponent10 = 0;
+    std::from_chars(p + (*(p + 1) == '+' ? 2 : 1), result.ptr, exponent10);
+
+    const int kk = exponent10 + 1;   // 10^(kk-1) <= value < 10^kk
+    const int k = kk - length;       // value = digits * 10^k
+
+    if (0 <= k && kk <= 21) {
+        // 1234e7 -> 12340000000.0
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        std::memset(out + length, '0', static_cast<std::size_t>(k));
+        out += kk;
+        *out++ = '.';
+        *out++ = '0';
+        return out;
+    }
+    if (0 < kk && kk <= 21) {
+        // 1234e-2 -> 12.34
+        std::memcpy(out, digits, static_cast<std::size_t>(kk));
+        out[kk] = '.';
+        std::memcpy(out + kk + 1, digits + kk, static_cast<std::size_t>(length - kk));
+        return out + length + 1;
+    }
+    if (-6 < kk && kk <= 0) {
+        // 1234e-6 -> 0.001234
+        *out++ = '0';
+        *out++ = '.';
+        std::memset(out, '0', static_cast<std::size_t>(-kk));
+        out += -kk;
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        return out + length;
+    }
+    if (length == 1) {
+        // 1e30
+        *out++ = digits[0];
+        *out++ = 'e';
+        return writeExponent(out, kk - 1);
+    }
+    // 1234e30 -> 1.234e33
+    *out++ = digits[0];
+    *out++ = '.';
+    std::memcpy(out, digits + 1, static_cast<std::size_t>(length - 1));
+    out += length - 1;
+    *out++ = 'e';
+    return writeExponent(out, kk - 1);
+}
+
+// JSON string with RapidJSON's default escaping (JsonString.h)
+inline char* writeString(char* out, std::string_view value) {
+    return tws_bridge::writeJsonString(out, value);
+}
+
+// Pre-escaped literal when the caller has one (InstrumentState::symbolJson), escaped here otherwise
+inline char* writeEscaped(char* out, std::string_view escaped, std::string_view value) {
+    if (escaped.empty()) {
+        return writeString(out, value);
+    }
+    std::memcpy(out, escaped.data(), escaped.size());
+    return out + escaped.size();
+}
+
+// Snapshot price in the configured layout (PriceFormat::FixedPoint falls back to writeDouble for NaN / Inf)
+inline char* writePrice(char* out, double value, PriceFormat format) {
+    std::int64_t ticks = 0;
+    if (format == PriceFormat::FixedPoint && tws_bridge::toPriceTicks(value, ticks)) {
+        return tws_bridge::writeFixedPrice(out, ticks);
+    }
+    return writeDouble(out, value);
+}
+
+// ========== Table Expansion (SnapshotFields.h) ==========
+
+// Runtime switches of one encode call (Presence rows)
+struct EncodeOptions {
+    bool withDerived = false;
+    bool withIsoTime = false;
+    PriceFormat prices = PriceFormat::Shortest;
+    std::int64_t sentNs = 0;
+};
+
+template <tws_bridge::fields::Presence P>
+inline bool present(const EncodeOptions& options, const InstrumentState& state) {
+    using tws_bridge::fields::Presence;
+    if constexpr (P == Presence::IsoTime) {
+        return options.withIsoTime;
+    } else if constexpr (P == Presence::Sent) {
+        return options.sentNs != 0;
+    } else if constexpr (P == Presence::Received) {
+        return state.receiveNs != 0;
+    } else if constexpr (P == Presence::Derived) {
+        return options.withDerived;
+    } else {
+        return true;  // REASON: DeltaOnly / SnapshotOnly rows are dropped at compile time by each encoder
+    }
+}
+
+// One row's value as JSON (key already written)
+template <tws_bridge::fields::FieldType Type, typename Value>
+inline char* writeValue(char* out, const Value& value, const EncodeOptions& options) {
+    using tws_bridge::fields::FieldType;
+    if constexpr (Type == FieldType::Symbol) {
+        return writeEscaped(out, value.escaped, value.value);  // PERFORMANCE: One memcpy once the worker set it
+    } else if constexpr (Type == FieldType::String) {
+        return writeString(out, value);
+    } else if constexpr (Type == FieldType::Uint32 || Type == FieldType::Uint64) {
+        return writeUint64(out, value);
+    } else if constexpr (Type == FieldType::Int32 || Type == FieldType::Int64) {
+        return writeInt64(out, value);
+    } else if constexpr (Type == FieldType::Quantity) {
+        return tws_bridge::writeQuantity(out, value);
+    } else if constexpr (Type == FieldType::Price) {
+        return writePrice(out, value, options.prices);
+    } else if constexpr (Type == FieldType::Double) {
+        return writeDouble(out, value);
+    } else if constexpr (Type == FieldType::IsoTime) {
+        out = tws_bridge::formatIsoTimestamp(value, out);
+        *out++ = '"';
+        return out;
+    } else if constexpr (Type == FieldType::Sent) {
+        return writeInt64(out, options.sentNs);
+    } else if constexpr (Type == FieldType::Conditions) {
+        out = tws_bridge::writeTradeConditions(out, value);
+        *out++ = '"';
+        return out;
+    } else if constexpr (Type == FieldType::Bool) {
+        return value ? copyFragment(out, fragment("true")) : copyFragment(out, fragment("false"));
+    } else {
+        static_assert(Type == FieldType::DeltaFlag, "FieldType without a JSON writer");
+        return copyFragment(out, fragment("true"));
+    }
+}
+
+// PERFORMANCE: Compile-time size - the copy is a few fixed stores, no length-dependent loop
+template <std::size_t Skip = 0>
+inline char* copyKey(char* out, const tws_bridge::fields::KeyText& key) {
+    std::memcpy(out, key.data + Skip, key.size - Skip);
+    return out + key.size - Skip;
+}
+
+// Worst case of a value, string contents excluded (6 bytes per character, added per call)
+constexpr std::size_t valueUpperBound(tws_bridge::fields::FieldType type) {
+    using tws_bridge::fields::FieldType;
+    switch (type) {
+        case FieldType::Symbol:
+        case FieldType::String:
+            return 2;
+        case FieldType::Price:
+        case FieldType::Double:
+            return 25;
+        case FieldType::Quantity:
+            return tws_bridge::kQuantityMaxChars;
+        case FieldType::IsoTime:
+            return tws_bridge::IsoTimestampFormatter::kLength + 1;
+        case FieldType::Conditions:
+            return tws_bridge::kTradeConditionsMaxChars + 1;
+        case FieldType::Bool:
+        case FieldType::DeltaFlag:
+            return 5;
+        default:
+            return 20;
+    }
+}
+
+// Every row present, each key as long as it gets (delta: ',' + group opener + member) + group close
+template <const auto& Table, std::size_t... I>
+constexpr std::size_t jsonUpperBound(std::index_sequence<I...>) {
+    using namespace tws_bridge::fields;
+    return 2 + ((1 + groupOpener(std::get<I>(Table).group, false).size
+                 + std::max(deltaMemberKey(std::get<I>(Table), false).size, deltaMemberKey(std::get<I>(Table), true).size)
+                 + valueUpperBound(std::get<I>(Table).type) + 1) + ...);
+}
+
+template <const auto& Table>
+inline constexpr std::size_t kJsonUpperBound =
+    jsonUpperBound<Table>(std::make_index_sequence<tws_bridge::fields::kFieldCount<Table>>{});
+
+// String characters of a record (Symbol / String rows)
+template <const auto& Table, typename Record>
+inline std::size_t stringChars(const Record& record) {
+    using namespace tws_bridge::fields;
+    std::size_t chars = 0;
+    forEachField<Table>([&](auto index) {
+        constexpr auto& row = std::get<decltype(index)::value>(Table);
+        if constexpr (row.type == FieldType::Symbol) {
+            chars += row.get(record).value.size();
+        } else if constexpr (row.type == FieldType::String) {
+            chars += row.get(record).size();
+        }
+    });
+    return chars;
+}
+
+template <bool Compact>
+inline char* writeSnapshot(char* p, const InstrumentState& state, const EncodeOptions& options) {
+    using namespace tws_bridge::fields;
+    *p++ = '{';
+    forEachField<kSnapshotFields>([&](auto index) {
+        constexpr std::size_t I = decltype(index)::value;
+        constexpr auto& row = std::get<I>(kSnapshotFields);
+        if constexpr (row.presence != Presence::DeltaOnly) {
+            if (!present<row.presence>(options, state)) {
+                return;
+            }
+            p = copyKey<I == 0 ? 1 : 0>(p, kMemberKey<kSnapshotFields, I, Compact>);
+            p = writeValue<row.type>(p, row.get(state), options);
+            if constexpr (closesGroup<kSnapshotFields, I>()) {
+                *p++ = '}';
+            }
+        }
+    });
+    *p++ = '}';
+    return p;
+}
+
+// Groups are opened by their first changed member (',"price":{"bid":...'), closed by the next row outside them
+template <bool Compact>
+inline char* writeSnapshotDelta(char* p, const InstrumentState& state, std::uint16_t changed,
+                                const EncodeOptions& options) {
+    using namespace tws_bridge::fields;
+    Group open = Group::Top;
+    auto closeOpen = [&]() {
+        if (open != Group::Top) {
+            *p++ = '}';
+            open = Group::Top;
+        }
+    };
+    *p++ = '{';
+    forEachField<kSnapshotFields>([&](auto index) {
+        constexpr std::size_t I = decltype(index)::value;
+        constexpr auto& row = std::get<I>(kSnapshotFields);
+        if constexpr (row.presence == Presence::SnapshotOnly) {
+            return;
+        } else if constexpr (row.delta == kDeltaHeader) {
+            if (!present<row.presence>(options, state)) {
+                return;
+            }
+            p = copyKey<I == 0 ? 1 : 0>(p, kMemberKey<kSnapshotFields, I, Compact>);
+            p = writeValue<row.type>(p, row.get(state), options);
+        } else {
+            if ((changed & row.delta) == 0) {
+                return;
+            }
+            if constexpr (row.group == Group::Top) {
+                closeOpen();
+                p = copyKey(p, kMemberKey<kSnapshotFields, I, Compact>);
+            } else {
+                if (open == row.group) {
+                    *p++ = ',';
+                } else {
+                    closeOpen();
+                    p = copyKey(p, kGroupOpener<row.group, Compact>);
+                    open = row.group;
+                }
+                p = copyKey(p, kDeltaMemberKey<kSnapshotFields, I, Compact>);
+            }
+            p = writeValue<row.type>(p, row.get(state), options);
+        }
+    });
+    closeOpen();
+    *p++ = '}';
+    return p;
+}
+
+// Bar rows: members of an object (after "symbol" or as the first members) or a positional array
+template <bool Keys, bool First>
+inline char* writeBarFields(char* p, const TickUpdate& update) {
+    using namespace tws_bridge::fields;
+    const EncodeOptions options;
+    forEachField<kBarFields>([&](auto index) {
+        constexpr std::size_t I = decltype(index)::value;
+        constexpr auto& row = std::get<I>(kBarFields);
+        if constexpr (Keys) {
+            p = copyKey<First && I == 0 ? 1 : 0>(p, kMemberKey<kBarFields, I, false>);
+        } else if constexpr (I != 0) {
+            *p++ = ',';
+        }
+        p = writeValue<row.type>(p, row.get(update), options);
+    });
+    return p;
+}
+
+} // namespace snapshot_detail
+
+/**
+ * @brief Encode InstrumentState with a precomputed fixed-schema template
+ *
+ * [PERFORMANCE] Same bytes as serializeState() / serializeStateCompact(), without
+ * the generic Writer's per-key state machine: the rows of kSnapshotFields (SnapshotFields.h)
+ * expand into constant key copies and direct number formatting, one instantiation per schema.
+ * "received" (compact "rc", local receive time in Unix ns) follows "sent" whenever state.receiveNs is set.
+ *
+ * @param state Complete instrument state snapshot
+ * @param out Caller-owned buffer, cleared first (no allocation once warm)
+ * @param schema Verbose (§3.4.2) or compact field names
+ * @param withDerived Append the "derived" object (state.derived)
+ * @param withIsoTime Add "time" (compact "tm") after "timestamp", same instant as ISO 8601
+ * @param prices Layout of bid / ask / last (FixedPoint: integer formatting of 1e-4 ticks)
+ * @param sentNs Add "sent" (compact "sn") after "timestamp": Unix ns, 0 = omitted
+ */
+inline void encodeSnapshot(const InstrumentState& state, JsonBuffer& out,
+                           SnapshotSchema schema = SnapshotSchema::Verbose, bool withDerived = false,
+                           bool withIsoTime = false, PriceFormat prices = PriceFormat::Shortest,
+                           std::int64_t sentNs = 0) {
+    using namespace snapshot_detail;
+    using tws_bridge::fields::kSnapshotFields;
+    const EncodeOptions options{withDerived, withIsoTime, prices, sentNs};
+
+    // REASON: Worst case 6 bytes per string character (\u00XX escape)
+    const std::size_t bound = kJsonUpperBound<kSnapshotFields> + 6 * stringChars<kSnapshotFields>(state);
+
+    out.buffer.Clear();
+    char* const begin = out.buffer.Push(bound);
+    char* const end = schema == SnapshotSchema::Compact ? writeSnapshot<true>(begin, state, options)
+                                                        : writeSnapshot<false>(begin, state, options);
+    out.buffer.Pop(bound - static_cast<std::size_t>(end - begin));
+}
+
+/**
+ * @brief Encode only the fields selected by `changed` (DeltaField bits) as a delta snapshot
+ *
+ * {"instrument":"AAPL","seq":N,"delta":true,"timestamp":T, changed groups / members...}
+ * Groups (price, size, timestamps, derived) appear only with their changed members; "seq" is
+ * state.sequence, shared with the full snapshots (keyframes, LVC, stream) of the same slot.
+ *
+ * [PERFORMANCE] Same table expansion as encodeSnapshot - a quote tick sends ~60 bytes instead of ~300.
+ * "received" is part of the header like "timestamp" (the receive time of the tick behind the delta).
+ *
+ * @param changed DeltaBaseline::changes() of the slot's baseline
+ * @param sentNs Add "sent" (compact "sn") after "timestamp": Unix ns, 0 = omitted
+ */
+inline void encodeSnapshotDelta(const InstrumentState& state, std::uint16_t changed, JsonBuffer& out,
+                                SnapshotSchema schema = SnapshotSchema::Verbose, bool withIsoTime = false,
+                                PriceFormat prices = PriceFormat::Shortest, std::int64_t sentNs = 0) {
+    using namespace snapshot_detail;
+    using tws_bridge::fields::kSnapshotFields;
+    const EncodeOptions options{false, withIsoTime, prices, sentNs};
+
+    const std::size_t bound = kJsonUpperBound<kSnapshotFields> + 6 * stringChars<kSnapshotFields>(state);
+
+    out.buffer.Clear();
+    char* const begin = out.buffer.Push(bound);
+    char* const end = schema == SnapshotSchema::Compact ? writeSnapshotDelta<true>(begin, state, changed, options)
+                                                        : writeSnapshotDelta<false>(begin, state, changed, options);
+    out.buffer.Pop(bound - static_cast<std::size_t>(end - begin));
+}
+
+/**
+ * @brief Encode a Bar TickUpdate - same bytes as serializeBarData()
+ *
+ * {"symbol", "timestamp", "open", "high", "low", "close", "volume", "wap", "barCount"} (kBarFields)
+ */
+inline void encodeBar(std::string_view symbol, const TickUpdate& update, JsonBuffer& out) {
+    using namespace snapshot_detail;
+    using tws_bridge::fields::kBarFields;
+    const std::size_t bound = 16 + kJsonUpperBound<kBarFields> + 6 * symbol.size();
+
+    out.buffer.Clear();
+    char* const begin = out.buffer.Push(bound);
+    char* p = copyFragment(begin, fragment("{\"symbol\":"));
+    p = writeString(p, symbol);
+    p = writeBarFields<true, false>(p, update);
+    *p++ = '}';
+    out.buffer.Pop(bound - static_cast<std::size_t>(p - begin));
+}
+
+/**
+ * @brief Encode a historical bar series - same bytes as serializeBarHistory()
+ *
+ * {"symbol", "complete", "bars": [{"timestamp", "open", ...}, ...]}
+ */
+inline void encodeBarHistory(std::string_view symbol, const TickUpdate* bars, std::size_t count, bool complete,
+                             JsonBuffer& out) {
+    using namespace snapshot_detail;
+    using tws_bridge::fields::kBarFields;
+    constexpr std::size_t kBarBound = kJsonUpperBound<kBarFields> + 1;  // + separator
+
+    out.buffer.Clear();
+    const std::size_t headBound = 48 + 6 * symbol.size();
+    char* const head = out.buffer.Push(headBound);
+    char* p = copyFragment(head, fragment("{\"symbol\":"));
+    p = writeString(p, symbol);
+    p = complete ? copyFragment(p, fragment(",\"complete\":true,\"bars\":["))
+                 : copyFragment(p, fragment(",\"complete\":false,\"bars\":["));
+    out.buffer.Pop(headBound - static_cast<std::size_t>(p - head));
+    for (std::size_t i = 0; i < count; ++i) {
+        char* const begin = out.buffer.Push(kBarBound);
+        p = begin;
+        if (i != 0) {
+            *p++ = ',';
+        }
+        *p++ = '{';
+        p = writeBarFields<true, true>(p, bars[i]);
+        *p++ = '}';
+        out.buffer.Pop(kBarBound - static_cast<std::size_t>(p - begin));
+    }
+    std::memcpy(out.buffer.Push(2), "]}", 2);
+}
+
+/**
+ * @brief Encode one bar as a positional array - same bytes as serializeBarCompact()
+ *
+ * [timestamp, open, high, low, close, volume, wap, barCount] (kBarFields order)
+ */
+inline void encodeBarArray(const TickUpdate& update, JsonBuffer& out) {
+    using namespace snapshot_detail;
+    using tws_bridge::fields::kBarFields;
+    constexpr std::size_t kBound = kJsonUpperBound<kBarFields>;
+
+    out.buffer.Clear();
+    char* const begin = out.buffer.Push(kBound);
+    char* p = begin;
+    *p++ = '[';
+    p = writeBarFields<false, true>(p, update);
+    *p++ = ']';
+    out.buffer.Pop(kBound - static_cast<std::size_t>(p - begin));
+}
+
+/**
+ * @brief Encode a MidPoint TickUpdate (TWS:MID:{SYMBOL})
+ *
+ * {"instrument", "mid", "timestamp"[, "received"]} - "received" as in snapshots, only when stamped
+ *
+ * [PERFORMANCE] ~80 bytes against ~300 for a full snapshot, no state merge or table expansion
+ */
+inline void encodeMidPoint(std::string_view symbol, const TickUpdate& update, JsonBuffer& out) {
+    using namespace snapshot_detail;
+    const std::size_t bound = 128 + 6 * symbol.size();
+
+    out.buffer.Clear();
+    char* const begin = out.buffer.Push(bound);
+    char* p = copyFragment(begin, fragment("{\"instrument\":"));
+    p = writeString(p, symbol);
+    p = copyFragment(p, fragment(",\"mid\":"));
+    p = writeDouble(p, update.midPoint.midPoint);
+    p = copyFragment(p, fragment(",\"timestamp\":"));
+    p = writeInt64(p, update.timestamp);
+    if (update.midPoint.stamps.receiveNs != 0) {
+        p = copyFragment(p, fragment(",\"received\":"));
+        p = writeInt64(p, update.midPoint.stamps.receiveNs);
+    }
+    *p++ = '}';
+    out.buffer.Pop(bound - static_cast<std::size_t>(p - begin));
+}
+
+/**
+ * @brief Encode a batch of backfilled quotes / trades (reqHistoricalTicks after a reconnect, GapBackfill.h)
+ *
+ * {"instrument", "backfill": true, "complete", "ticks": [{"type": "quote", "bid", "ask", "bidSize", "askSize",
+ * "timestamp"} | {"type": "trade", "price", "size", "timestamp"}, ...]} - in arrival order, quotes and trades
+ * as separate runs (one reqHistoricalTicks kind each)
+ */
+inline void encodeTickBackfill(std::string_view symbol, const TickUpdate* ticks, std::size_t count, bool complete,
+                               JsonBuffer& out) {
+    using namespace snapshot_detail;
+    constexpr std::size_t kTickBound = 192;
+
+    out.buffer.Clear();
+    const std::size_t headBound = 80 + 6 * symbol.size();
+    char* const head = out.buffer.Push(headBound);
+    char* p = copyFragment(head, fragment("{\"instrument\":"));
+    p = writeString(p, symbol);
+    p = complete ? copyFragment(p, fragment(",\"backfill\":true,\"complete\":true,\"ticks\":["))
+                 : copyFragment(p, fragment(",\"backfill\":true,\"complete\":false,\"ticks\":["));
+    out.buffer.Pop(headBound - static_cast<std::size_t>(p - head));
+    for (std::size_t i = 0; i < count; ++i) {
+        const TickUpdate& tick = ticks[i];
+        char* const begin = out.buffer.Push(kTickBound);
+        p = begin;
+        if (i != 0) {
+            *p++ = ',';
+        }
+        if (tick.type == TickUpdateType::BidAsk) {
+            p = copyFragment(p, fragment("{\"type\":\"quote\",\"bid\":"));
+            p = writeDouble(p, tick.bidAsk.bidPrice);
+            p = copyFragment(p, fragment(",\"ask\":"));
+            p = writeDouble(p, tick.bidAsk.askPrice);
+            p = copyFragment(p, fragment(",\"bidSize\":"));
+            p = tws_bridge::writeQuantity(p, tick.bidQuantity());
+            p = copyFragment(p, fragment(",\"askSize\":"));
+            p = tws_bridge::writeQuantity(p, tick.askQuantity());
+        } else {
+            p = copyFragment(p, fragment("{\"type\":\"trade\",\"price\":"));
+            p = writeDouble(p, tick.allLast.price);
+            p = copyFragment(p, fragment(",\"size\":"));
+            p = tws_bridge::writeQuantity(p, tick.tradeQuantity());
+        }
+        p = copyFragment(p, fragment(",\"timestamp\":"));
+        p = writeInt64(p, tick.timestamp);
+        *p++ = '}';
+        out.buffer.Pop(kTickBound - static_cast<std::size_t>(p - begin));
+    }
+    std::memcpy(out.buffer.Push(2), "]}", 2);
+}
+
+// JSON array of already encoded snapshots - the aggregate channel payload (AggregateConfig)
+// PERFORMANCE: Snapshots are appended as bytes (no re-encode), the buffer keeps its capacity across batches
+class SnapshotArray {
+public:
+    void append(std::string_view snapshot) {
+        m_buffer += m_count == 0 ? '[' : ',';
+        m_buffer.append(snapshot.data(), snapshot.size());
+        ++m_count;
+    }
+
+    // "[s1,s2,...]" - valid until the next append / clear
+    std::string_view close() {
+        m_buffer += ']';
+        return m_buffer;
+    }
+
+    void clear() {
+        m_buffer.clear();
+        m_count = 0;
+    }
+
+    std::size_t count() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+private:
+    std::string m_buffer;
+    std::size_t m_count = 0;
+};
@@ -0,0 +1,283 @@
+// SnapshotFields.h - Compile-time field tables of the snapshot and bar payloads (one source for every encoder)
+// SCOPE: Read by the JSON (SnapshotEncoder.h) and binary (BinaryEncoder.h) generators - no runtime reflection,
+// each field is a constexpr row expanded into inlined writer code per encoder and schema
+
+#pragma once
+
+#include "MarketData.h"
+#include "SnapshotDelta.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tws_bridge {
+namespace fields {
+
+// How a value is written (JSON text / binary wire type)
+enum class FieldType : std::uint8_t {
+    Symbol,      // JSON: pre-escaped literal when available (EscapedString) | binary: header length + trailer bytes
+    String,      // JSON: escaped string | binary: u8 length + bytes
+    Uint32,      // JSON: integer | binary: u32
+    Uint64,      // JSON: integer | binary: u64
+    Int32,       // JSON: integer | binary: i32
+    Int64,       // JSON: integer | binary: i64
+    Quantity,    // JSON: scaled-integer text (Quantity.h) | binary: i32 whole units (wire v1 layout)
+    Price,       // JSON: PriceFormat layout | binary: f64
+    Double,      // JSON: shortest round-trip | binary: f64
+    IsoTime,     // JSON only: ISO 8601 string of an Int64 ms timestamp
+    Sent,        // JSON only: the encoder's sentNs (the getter is unused)
+    Conditions,  // JSON: TradeCodes.h text | binary: u64 bits
+    Bool,        // JSON: true / false | binary: header flag
+    DeltaFlag    // JSON delta marker, always true
+};
+
+// Nested JSON object a field belongs to (Top = the snapshot object itself)
+enum class Group : std::uint8_t {
+    Top,
+    Price,
+    Size,
+    Timestamps,
+    TickAttrib,
+    Derived
+};
+
+// When a field is written at all
+enum class Presence : std::uint8_t {
+    Always,
+    IsoTime,       // withIsoTime
+    Sent,          // sentNs != 0
+    Received,      // state.receiveNs != 0
+    Derived,       // withDerived (snapshots) - deltas follow the DeltaField::Derived bit
+    SnapshotOnly,  // Full snapshots, never in deltas
+    DeltaOnly      // Deltas only
+};
+
+struct Names {
+    const char* verbose;
+    const char* compact;
+};
+
+constexpr Names kGroupNames[] = {
+    {"", ""},
+    {"price", "p"},
+    {"size", "s"},
+    {"timestamps", "tss"},
+    {"tickAttrib", "attr"},
+    {"derived", "d"},
+};
+
+// DeltaField bit of a field, kDeltaHeader: part of every delta (instrument, seq, timestamp ...)
+constexpr std::uint16_t kDeltaHeader = 0;
+
+template <typename Get>
+struct Field {
+    Names names;
+    FieldType type;
+    Group group;
+    Presence presence;
+    std::uint16_t delta;
+    bool binaryBody;       // Fixed body of the binary snapshot / bar (wire order = table order)
+    Get get;
+};
+
+template <typename Get>
+constexpr Field<Get> field(Names names, FieldType type, Group group, Presence presence, std::uint16_t delta,
+                           bool binaryBody, Get get) {
+    return Field<Get>{names, type, group, presence, delta, binaryBody, get};
+}
+
+// Symbol value: the worker's pre-escaped "\"SYMBOL\"" literal (may be empty) and the raw text
+struct EscapedString {
+    std::string_view escaped;
+    std::string_view value;
+};
+
+// ========== InstrumentState (docs/PROJECT-SPECIFICATION.md §3.4.2) ==========
+// PITFALL: Row order is the wire order of every format - JSON members, binary body and binary delta fields.
+// Binary v1 is frozen (BinaryEncoder.h static_asserts its sizes): append rows only, and only after
+// the binary fields of their kind
+inline constexpr auto kSnapshotFields = std::make_tuple(
+    field({"instrument", "sym"}, FieldType::Symbol, Group::Top, Presence::Always, kDeltaHeader, false,
+          [](const InstrumentState& s) { return EscapedString{s.symbolJson, s.symbol}; }),
+    field({"seq", "sq"}, FieldType::Uint64, Group::Top, Presence::Always, kDeltaHeader, false,
+          [](const InstrumentState& s) { return s.sequence; }),
+    field({"delta", "dl"}, FieldType::DeltaFlag, Group::Top, Presence::DeltaOnly, kDeltaHeader, false,
+          [](const InstrumentState&) { return true; }),
+    field({"conId", "cid"}, FieldType::Int32, Group::Top, Presence::SnapshotOnly, kDeltaHeader, false,
+          [](const InstrumentState& s) { return s.conId; }),
+    field({"primaryExchange", "pex"}, FieldType::String, Group::Top, Presence::SnapshotOnly, kDeltaHeader, false,
+          [](const InstrumentState& s) { return s.primaryExchange; }),
+    field({"timestamp", "ts"}, FieldType::Int64, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const InstrumentState& s) { return static_cast<std::int64_t>(std::max(s.quoteTimestamp, s.tradeTimestamp)); }),
+    field({"time", "tm"}, FieldType::IsoTime, Group::Top, Presence::IsoTime, kDeltaHeader, false,
+          [](const InstrumentState& s) { return static_cast<std::int64_t>(std::max(s.quoteTimestamp, s.tradeTimestamp)); }),
+    field({"sent", "sn"}, FieldType::Sent, Group::Top, Presence::Sent, kDeltaHeader, false,
+          [](const InstrumentState&) { return std::int64_t{0}; }),
+    field({"received", "rc"}, FieldType::Int64, Group::Top, Presence::Received, kDeltaHeader, false,
+          [](const InstrumentState& s) { return s.receiveNs; }),
+    field({"bid", "b"}, FieldType::Price, Group::Price, Presence::Always, DeltaField::BidPrice, true,
+          [](const InstrumentState& s) { return s.bidPrice; }),
+    field({"ask", "a"}, FieldType::Price, Group::Price, Presence::Always, DeltaField::AskPrice, true,
+          [](const InstrumentState& s) { return s.askPrice; }),
+    field({"last", "l"}, FieldType::Price, Group::Price, Presence::Always, DeltaField::LastPrice, true,
+          [](const InstrumentState& s) { return s.lastPrice; }),
+    field({"bid", "b"}, FieldType::Quantity, Group::Size, Presence::Always, DeltaField::BidSize, true,
+          [](const InstrumentState& s) { return s.bidQuantity(); }),
+    field({"ask", "a"}, FieldType::Quantity, Group::Size, Presence::Always, DeltaField::AskSize, true,
+          [](const InstrumentState& s) { return s.askQuantity(); }),
+    field({"last", "l"}, FieldType::Quantity, Group::Size, Presence::Always, DeltaField::LastSize, true,
+          [](const InstrumentState& s) { return s.lastQuantity(); }),
+    field({"quote", "q"}, FieldType::Int64, Group::Timestamps, Presence::Always, DeltaField::QuoteTime, true,
+          [](const InstrumentState& s) { return static_cast<std::int64_t>(s.quoteTimestamp); }),
+    field({"trade", "t"}, FieldType::Int64, Group::Timestamps, Presence::Always, DeltaField::TradeTime, true,
+          [](const InstrumentState& s) { return static_cast<std::int64_t>(s.tradeTimestamp); }),
+    field({"exchange", "ex"}, FieldType::String, Group::Top, Presence::Always, DeltaField::Exchange, false,
+          [](const InstrumentState& s) { return s.exchange; }),
+    field({"conditions", "cnd"}, FieldType::Conditions, Group::Top, Presence::Always, DeltaField::Conditions, false,
+          [](const InstrumentState& s) { return s.tradeConditions; }),
+    field({"pastLimit", "pl"}, FieldType::Bool, Group::TickAttrib, Presence::Always, DeltaField::PastLimit, false,
+          [](const InstrumentState& s) { return s.pastLimit; }),
+    field({"mid", "m"}, FieldType::Double, Group::Derived, Presence::Derived, DeltaField::Derived, false,
+          [](const InstrumentState& s) { return s.derived.mid; }),
+    field({"spread", "sp"}, FieldType::Double, Group::Derived, Presence::Derived, DeltaField::Derived, false,
+          [](const InstrumentState& s) { return s.derived.spread; }),
+    field({"vwap", "vw"}, FieldType::Double, Group::Derived, Presence::Derived, DeltaField::Derived, false,
+          [](const InstrumentState& s) { return s.derived.vwap; }),
+    field({"rollingVolume", "rv"}, FieldType::Int64, Group::Derived, Presence::Derived, DeltaField::Derived, false,
+          [](const InstrumentState& s) { return static_cast<std::int64_t>(s.derived.rolling.total()); }));
+
+// ========== Bar TickUpdate (TWS:BARS:*, history, bar store, TWS:BIN:BARS:*) ==========
+// NOTE: One schema - compact names equal the verbose ones; "symbol" is written by the encoders (not in history bars)
+inline constexpr auto kBarFields = std::make_tuple(
+    field({"timestamp", "timestamp"}, FieldType::Int64, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.timestamp; }),
+    field({"open", "open"}, FieldType::Double, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.bar.open; }),
+    field({"high", "high"}, FieldType::Double, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.bar.high; }),
+    field({"low", "low"}, FieldType::Double, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.bar.low; }),
+    field({"close", "close"}, FieldType::Double, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.bar.close; }),
+    field({"volume", "volume"}, FieldType::Int64, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.bar.volume; }),
+    field({"wap", "wap"}, FieldType::Double, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.bar.wap; }),
+    field({"barCount", "barCount"}, FieldType::Uint32, Group::Top, Presence::Always, kDeltaHeader, true,
+          [](const TickUpdate& u) { return u.aux; }));
+
+// ========== Table Expansion ==========
+
+template <const auto& Table>
+inline constexpr std::size_t kFieldCount = std::tuple_size_v<std::decay_t<decltype(Table)>>;
+
+// fn(std::integral_constant<std::size_t, I>) for every row, in order - the row is std::get<I>(Table) in fn
+template <const auto& Table, typename Fn, std::size_t... I>
+constexpr void forEachFieldIndex(Fn&& fn, std::index_sequence<I...>) {
+    (fn(std::integral_constant<std::size_t, I>{}), ...);
+}
+
+template <const auto& Table, typename Fn>
+constexpr void forEachField(Fn&& fn) {
+    forEachFieldIndex<Table>(fn, std::make_index_sequence<kFieldCount<Table>>{});
+}
+
+template <const auto& Table, std::size_t I>
+constexpr Group previousGroup() {
+    if constexpr (I == 0) {
+        return Group::Top;
+    } else {
+        return std::get<I - 1>(Table).group;
+    }
+}
+
+// Last row of a nested object: the full encoders close it after the value
+template <const auto& Table, std::size_t I>
+constexpr bool closesGroup() {
+    constexpr Group group = std::get<I>(Table).group;
+    if constexpr (group == Group::Top) {
+        return false;
+    } else if constexpr (I + 1 == kFieldCount<Table>) {
+        return true;
+    } else {
+        return std::get<I + 1>(Table).group != group;
+    }
+}
+
+// ========== Constant Key Text (built at compile time from the rows) ==========
+
+struct KeyText {
+    char data[48] = {};
+    std::size_t size = 0;
+
+    constexpr void append(const char* text) {
+        while (*text != '\0') {
+            data[size++] = *text++;
+        }
+    }
+    constexpr void append(char c) { data[size++] = c; }
+};
+
+constexpr bool opensQuote(FieldType type) {
+    return type == FieldType::IsoTime || type == FieldType::Conditions;  // REASON: Writers emit unquoted text
+}
+
+// ',"name":' - or ',"group":{"name":' for the first row of a nested object; the leading ',' is skipped
+// for the first member of an object
+template <typename Get>
+constexpr KeyText memberKey(const Field<Get>& row, Group previous, bool compact) {
+    KeyText key;
+    key.append(',');
+    if (row.group != Group::Top && row.group != previous) {
+        const Names& group = kGroupNames[static_cast<std::size_t>(row.group)];
+        key.append('"');
+        key.append(compact ? group.compact : group.verbose);
+        key.append("\":{");
+    }
+    key.append('"');
+    key.append(compact ? row.names.compact : row.names.verbose);
+    key.append("\":");
+    if (opensQuote(row.type)) {
+        key.append('"');
+    }
+    return key;
+}
+
+// '"name":' inside a delta group (DeltaGroup writes the opener and the separators)
+template <typename Get>
+constexpr KeyText deltaMemberKey(const Field<Get>& row, bool compact) {
+    KeyText key;
+    key.append('"');
+    key.append(compact ? row.names.compact : row.names.verbose);
+    key.append("\":");
+    if (opensQuote(row.type)) {
+        key.append('"');
+    }
+    return key;
+}
+
+// ',"group":{'
+constexpr KeyText groupOpener(Group group, bool compact) {
+    const Names& names = kGroupNames[static_cast<std::size_t>(group)];
+    KeyText key;
+    key.append(",\"");
+    key.append(compact ? names.compact : names.verbose);
+    key.append("\":{");
+    return key;
+}
+
+template <const auto& Table, std::size_t I, bool Compact>
+inline constexpr KeyText kMemberKey = memberKey(std::get<I>(Table), previousGroup<Table, I>(), Compact);
+
+template <const auto& Table, std::size_t I, bool Compact>
+inline constexpr KeyText kDeltaMemberKey = deltaMemberKey(std::get<I>(Table), Compact);
+
+template <Group G, bool Compact>
+inline constexpr KeyText kGroupOpener = groupOpener(G, Compact);
+
+} // namespace fields
+} // namespace tws_bridge
@@ -0,0 +1,252 @@
+// SnapshotSink.h - Extra snapshot backends fed by a worker, each on its own thread
+// SCOPE: Worker thread appends / commits, one thread per sink calls onBatch
+
+#pragma once
+
+#include "BatchArena.h"
+#include "InstrumentRegistry.h"
+#include "SpscRing.h"
+#include "StageWatchdog.h"
+#include "ThreadAffinity.h"
+#include "WaitStrategy.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <concurrentqueue.h>
+
+namespace tws_bridge {
+
+// One published snapshot as every sink sees it
+// NOTE: Encoded ONCE by the worker and stored once (the same pooled bytes that go to Redis) - sinks only read them
+struct SnapshotRecord {
+    std::string_view channel;                       // TWS:TICKS:{SYMBOL} (names the symbol for any backend)
+    std::string_view payload;                       // Snapshot JSON
+    SlotId slot = kInvalidSlot;
+    std::string_view binary;                        // BinaryEncoder.h v1 snapshot, empty unless a sink wantsBinary()
+};
+
+// Backend interface (journal file, message bus, ...)
+// REASON: Redis stays the worker's inline pipeline and the shared-memory ring its inline write (both
+// latency-critical); sinks are for backends that may be slow without holding anyone else up
+class SnapshotSink {
+public:
+    virtual ~SnapshotSink() = default;
+
+    virtual const char* name() const = 0;
+    // Also needs SnapshotRecord::binary (asked once, before start())
+    virtual bool wantsBinary() const { return false; }
+    // Sink thread only; records (and their bytes) are valid until it returns
+    virtual void onBatch(const SnapshotRecord* records, std::size_t count) = 0;
+    // Sink thread, after the last batch (flush / close)
+    virtual void onStop() {}
+};
+
+struct SinkPolicy {
+    std::size_t maxQueuedBatches = 64;              // BACKPRESSURE: Per sink - a full queue drops that sink's copy only
+    WaitConfig wait{WaitMode::Blocking, 0, 0, std::chrono::microseconds(1000)};
+    ThreadConfig thread;                            // Sink thread placement ("tws-sink-{name}")
+};
+
+// Lifetime counters per sink (readable from any thread)
+struct SinkCounters {
+    std::atomic<std::uint64_t> batches{0};          // onBatch calls
+    std::atomic<std::uint64_t> records{0};
+    std::atomic<std::uint64_t> dropped{0};          // Batches not queued (this sink's backlog was full)
+};
+
+// Hands each committed batch to every sink without copying it per sink
+// ARCHITECTURE: One pooled batch (records + arena) is shared by reference count; the last sink to finish
+// recycles it, so the steady state allocates nothing and a stalled sink only loses its own copies
+class SinkFanout {
+public:
+    explicit SinkFanout(std::size_t poolBatches = 128)
+        : m_freeBatches(poolBatches) {
+        for (std::size_t i = 0; i < poolBatches; ++i) {
+            m_batches.push_back(std::make_unique<Batch>());
+            m_freeBatches.enqueue(m_batches.back().get());
+        }
+    }
+
+    ~SinkFanout() { stop(); }
+
+    SinkFanout(const SinkFanout&) = delete;
+    SinkFanout& operator=(const SinkFanout&) = delete;
+
+    // Before start() only
+    void add(std::shared_ptr<SnapshotSink> sink, SinkPolicy policy = {}) {
+        m_wantsBinary = m_wantsBinary || sink->wantsBinary();
+        m_runners.push_back(std::make_unique<Runner>(std::move(sink), policy));
+    }
+
+    void start() {
+        for (auto& runner : m_runners) {
+            if (runner->thread.joinable()) {
+                continue;
+            }
+            runner->running.store(true, std::memory_order_release);
+            runner->thread = std::thread([this, raw = runner.get()]() { run(*raw); });
+        }
+    }
+
+    // Delivers every queued batch, then calls onStop() and joins (uncommitted appends are dropped)
+    void stop() {
+        for (auto& runner : m_runners) {
+            if (runner->thread.joinable()) {
+                runner->running.store(false, std::memory_order_release);
+                runner->waiter.notify();
+                runner->thread.join();
+            }
+        }
+    }
+
+    // ========== Worker thread ==========
+    // PERFORMANCE: The worker encodes the binary copy only when some sink reads it
+    bool wantsBinary() const { return m_wantsBinary; }
+
+    void append(std::string_view channel, std::string_view payload, SlotId slot, std::string_view binary = {}) {
+        if (!reserve()) {
+            return;
+        }
+        m_current->records.push_back(SnapshotRecord{m_current->arena.copy(channel.data(), channel.size()),
+                                                    m_current->arena.copy(payload.data(), payload.size()), slot,
+                                                    binary.empty() ? std::string_view()
+                                                                   : m_current->arena.copy(binary.data(), binary.size())});
+    }
+
+    // PERFORMANCE: Pooled-payload overload - the batch references the stored snapshot instead of copying it
+    // (the block returns to the pool when the last sink has delivered the batch)
+    void append(std::string_view channel, const SharedPayload& payload, SlotId slot, std::string_view binary = {}) {
+        if (!reserve()) {
+            return;
+        }
+        m_current->records.push_back(SnapshotRecord{m_current->arena.copy(channel.data(), channel.size()),
+                                                    m_current->arena.reference(payload), slot,
+                                                    binary.empty() ? std::string_view()
+                                                                   : m_current->arena.copy(binary.data(), binary.size())});
+    }
+
+    // Hands the appended records to every sink (call once per drain batch)
+    void commit() {
+        if (!m_current) {
+            return;
+        }
+        Batch* batch = m_current;
+        m_current = nullptr;
+        if (batch->records.empty()) {
+            m_freeBatches.enqueue(batch);
+            return;
+        }
+        // REASON: All references taken up front - a fast sink may release before the last one is queued
+        batch->refs.store(m_runners.size(), std::memory_order_relaxed);
+        for (auto& runner : m_runners) {
+            if (runner->queue.try_enqueue(batch)) {
+                runner->waiter.notify();
+            } else {
+                runner->counters.dropped.fetch_add(1, std::memory_order_relaxed);
+                release(batch);
+            }
+        }
+    }
+
+    std::size_t sinkCount() const { return m_runners.size(); }
+    const char* sinkName(std::size_t i) const { return m_runners[i]->sink->name(); }
+    const SinkCounters& counters(std::size_t i) const { return m_runners[i]->counters; }
+    // Beats once per delivery loop iteration (StageWatchdog, Stage::Sink)
+    const Heartbeat& heartbeat(std::size_t i) const { return m_runners[i]->heartbeat; }
+    // Records not appended because no pooled batch was free
+    std::uint64_t exhausted() const { return m_exhausted.load(std::memory_order_relaxed); }
+
+private:
+    struct Batch {
+        std::vector<SnapshotRecord> records;        // REASON: Capacity kept across reuse
+        BatchArena arena{16 * 1024};
+        std::atomic<std::size_t> refs{0};
+    };
+
+    struct Runner {
+        Runner(std::shared_ptr<SnapshotSink> s, SinkPolicy p)
+            : sink(std::move(s))
+            , policy(p)
+            , queue(p.maxQueuedBatches)
+            , waiter(p.wait) {
+        }
+        std::shared_ptr<SnapshotSink> sink;
+        SinkPolicy policy;
+        SpscRing<Batch*> queue;                     // Worker → sink thread
+        ConsumerWaiter waiter;
+        std::atomic<bool> running{false};
+        std::thread thread;
+        SinkCounters counters;
+        Heartbeat heartbeat;
+    };
+
+    // A batch to append to (false: none free, counted)
+    bool reserve() {
+        if (m_runners.empty()) {
+            return false;
+        }
+        if (!m_current && !m_freeBatches.try_dequeue(m_current)) {
+            // BACKPRESSURE: Every pooled batch is still held by some sink
+            m_exhausted.store(m_exhausted.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    void release(Batch* batch) {
+        if (batch->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            batch->records.clear();
+            batch->arena.reset();
+            m_freeBatches.enqueue(batch);
+        }
+    }
+
+    void run(Runner& runner) {
+        const std::string name = std::string("tws-sink-") + runner.sink->name();
+        configureCurrentThread(name.c_str(), runner.policy.thread);
+        runner.heartbeat.attach();
+        auto deliver = [this, &runner]() {
+            Batch* batch = nullptr;
+            if (!runner.queue.try_dequeue(batch)) {
+                return false;
+            }
+            runner.sink->onBatch(batch->records.data(), batch->records.size());
+            runner.counters.batches.fetch_add(1, std::memory_order_relaxed);
+            runner.counters.records.fetch_add(batch->records.size(), std::memory_order_relaxed);
+            release(batch);
+            return true;
+        };
+        for (;;) {
+            runner.heartbeat.beat();
+            if (deliver()) {
+                runner.waiter.reset();
+                continue;
+            }
+            if (!runner.running.load(std::memory_order_acquire)) {
+                // PITFALL: A commit may have landed between the empty dequeue and the stop flag - drain again
+                while (deliver()) {
+                }
+                break;
+            }
+            runner.waiter.idle([&runner]() {
+                return runner.queue.size_approx() > 0 || !runner.running.load(std::memory_order_acquire);
+            });
+        }
+        runner.heartbeat.park(true);
+        runner.sink->onStop();
+    }
+
+    std::vector<std::unique_ptr<Batch>> m_batches;
+    moodycamel::ConcurrentQueue<Batch*> m_freeBatches;  // Sink threads → worker (recycled)
+    std::vector<std::unique_ptr<Runner>> m_runners;
+    Batch* m_current = nullptr;                     // Worker thread: batch being appended
+    bool m_wantsBinary = false;
+    std::atomic<std::uint64_t> m_exhausted{0};
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,65 @@
+// SocketTuning.h - Latency options of the TWS socket (Nagle, receive buffer, busy polling, delayed ACKs)
+// SCOPE: Applied once per session right after eConnect (message thread / connect thread); TCP_QUICKACK is
+// re-armed by the socket reader after each read
+
+#pragma once
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace tws_bridge {
+
+// tws.socket
+struct SocketTuning {
+    bool noDelay = true;                            // TCP_NODELAY: requests leave at once (no Nagle wait for an ACK)
+    std::size_t receiveBuffer = 0;                  // SO_RCVBUF bytes, 0 = kernel default (autotuned)
+    int busyPollUs = 0;                             // SO_BUSY_POLL: µs the kernel spins on the NIC queue per read, 0 = off
+    bool quickAck = false;                          // TCP_QUICKACK after every read: no delayed-ACK hold on TWS's side
+};
+
+// Applies tuning to fd; failed lists the options the kernel refused ("SO_BUSY_POLL: Operation not permitted"),
+// "" if every one was set
+// NOTE: Not fatal - the connection works with whatever was set (SO_BUSY_POLL above net.core.busy_read needs
+// CAP_NET_ADMIN, SO_RCVBUF is capped at net.core.rmem_max)
+// PITFALL: The socket is already connected - the window scale was negotiated in the handshake, so a buffer
+// far above the default may only be used up to what that scale allows (raise tcp_rmem's default instead)
+inline bool applySocketTuning(int fd, const SocketTuning& tuning, std::string& failed) {
+    failed.clear();
+    auto set = [fd, &failed](int level, int option, int value, const char* name) {
+        if (::setsockopt(fd, level, option, &value, sizeof(value)) != 0) {
+            failed += failed.empty() ? "" : ", ";
+            failed += std::string(name) + ": " + std::strerror(errno);
+        }
+    };
+    set(IPPROTO_TCP, TCP_NODELAY, tuning.noDelay ? 1 : 0, "TCP_NODELAY");
+    if (tuning.receiveBuffer > 0) {
+        set(SOL_SOCKET, SO_RCVBUF, static_cast<int>(tuning.receiveBuffer), "SO_RCVBUF");
+    }
+#ifdef SO_BUSY_POLL
+    if (tuning.busyPollUs > 0) {
+        set(SOL_SOCKET, SO_BUSY_POLL, tuning.busyPollUs, "SO_BUSY_POLL");
+    }
+#else
+    if (tuning.busyPollUs > 0) {
+        failed += failed.empty() ? "SO_BUSY_POLL: unsupported" : ", SO_BUSY_POLL: unsupported";
+    }
+#endif
+    if (tuning.quickAck) {
+        set(IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK");
+    }
+    return failed.empty();
+}
+
+// PITFALL: TCP_QUICKACK is not sticky - the kernel falls back to delayed ACKs on its own, so the reader
+// sets it again after every read that returned data (one setsockopt per read, not per message)
+inline void rearmQuickAck(int fd) {
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+}
+
+} // namespace tws_bridge
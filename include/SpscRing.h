@@ -0,0 +1,143 @@
+// SpscRing.h - Bounded single-producer/single-consumer ring buffer
+// SCOPE: Callback → worker hop (exactly one EReader message thread, one worker per shard)
+
+#pragma once
+
+#include "HugePages.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace tws_bridge {
+
+// Drop-in for the moodycamel::ConcurrentQueue subset used on the ingest path
+// (try_enqueue / try_enqueue_bulk / try_dequeue / try_dequeue_bulk / size_approx)
+//
+// PERFORMANCE:
+// - Head and tail on separate cache lines, each side caches the other's index
+//   and only re-reads it (one cross-core load) when the cached value says full/empty
+// - try_dequeue_bulk publishes the head ONCE per batch
+// PITFALL: Exactly one producer thread and one consumer thread, no runtime check
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing stores elements by plain copy");
+
+public:
+    // Capacity is rounded up to a power of two (index masking, no modulo)
+    // memory.enabled: slots on prefaulted 2 MB pages (HugePages.h), the heap if the mapping fails
+    explicit SpscRing(std::size_t capacity, HugePageConfig memory = {})
+        : m_mask(roundUpPow2(capacity < 2 ? 2 : capacity) - 1) {
+        if (memory.enabled) {
+            m_region = HugePageRegion(storageBytes(), memory.lock);
+        }
+        if (m_region.data()) {
+            // REASON: Trivially copyable - default-initialized slots need no destructor call
+            m_slots = static_cast<T*>(m_region.data());
+            std::uninitialized_default_construct_n(m_slots, m_mask + 1);
+        } else {
+            m_heap.reset(new T[m_mask + 1]);
+            m_slots = m_heap.get();
+        }
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // ========== Producer side ==========
+    bool try_enqueue(const T& item) {
+        const std::size_t tail = m_tail.value.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead.value == capacity()) {
+            m_cachedHead.value = m_head.value.load(std::memory_order_acquire);
+            if (tail - m_cachedHead.value == capacity()) {
+                return false;  // Full
+            }
+        }
+        m_slots[tail & m_mask] = item;
+        m_tail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // All or nothing (false when fewer than count slots are free), the tail is published ONCE
+    template <typename It>
+    bool try_enqueue_bulk(It items, std::size_t count) {
+        const std::size_t tail = m_tail.value.load(std::memory_order_relaxed);
+        if (capacity() - (tail - m_cachedHead.value) < count) {
+            m_cachedHead.value = m_head.value.load(std::memory_order_acquire);
+            if (capacity() - (tail - m_cachedHead.value) < count) {
+                return false;
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            m_slots[(tail + i) & m_mask] = *items++;
+        }
+        m_tail.value.store(tail + count, std::memory_order_release);
+        return true;
+    }
+
+    // REASON: Bounded ring never allocates, enqueue == try_enqueue (fails when full)
+    bool enqueue(const T& item) { return try_enqueue(item); }
+
+    // ========== Consumer side ==========
+    bool try_dequeue(T& item) {
+        return try_dequeue_bulk(&item, 1) == 1;
+    }
+
+    template <typename It>
+    std::size_t try_dequeue_bulk(It out, std::size_t maxItems) {
+        const std::size_t head = m_head.value.load(std::memory_order_relaxed);
+        std::size_t available = m_cachedTail.value - head;
+        if (available < maxItems) {
+            m_cachedTail.value = m_tail.value.load(std::memory_order_acquire);
+            available = m_cachedTail.value - head;
+        }
+        const std::size_t count = available < maxItems ? available : maxItems;
+        for (std::size_t i = 0; i < count; ++i) {
+            *out++ = m_slots[(head + i) & m_mask];
+        }
+        if (count > 0) {
+            m_head.value.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // ========== Any thread ==========
+    std::size_t size_approx() const {
+        const std::size_t head = m_head.value.load(std::memory_order_acquire);
+        const std::size_t tail = m_tail.value.load(std::memory_order_acquire);
+        return tail >= head ? tail - head : 0;
+    }
+
+    std::size_t capacity() const { return m_mask + 1; }
+    // Element array (NUMA placement - NumaPlacement.h)
+    const void* storage() const { return m_slots; }
+    std::size_t storageBytes() const { return capacity() * sizeof(T); }
+    // Start-up report (all false on the heap)
+    const HugePageBacking& backing() const { return m_region.backing(); }
+
+private:
+    static std::size_t roundUpPow2(std::size_t value) {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    // REASON: One index per cache line (no false sharing between producer and consumer)
+    template <typename V>
+    struct alignas(64) Padded {
+        V value{};
+    };
+
+    const std::size_t m_mask;
+    HugePageRegion m_region;
+    std::unique_ptr<T[]> m_heap;
+    T* m_slots = nullptr;                      // m_region or m_heap
+    Padded<std::atomic<std::size_t>> m_head;   // Written by consumer
+    Padded<std::size_t> m_cachedTail;          // Consumer-private copy of m_tail
+    Padded<std::atomic<std::size_t>> m_tail;   // Written by producer
+    Padded<std::size_t> m_cachedHead;          // Producer-private copy of m_head
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,161 @@
+// StageWatchdog.h - Per-stage heartbeats checked by a low-frequency watchdog thread
+// SCOPE: Heartbeat::beat() / park() on the stage's own thread, everything else on the watchdog thread
+
+#pragma once
+
+#include <pthread.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+enum class Stage : std::uint8_t {
+    Reader,    // BridgeReader socket thread (per connection, BridgeRing mode only)
+    Dispatch,  // Message thread: callbacks, pacer, commands (per connection)
+    Worker,    // Redis Worker loop (per shard)
+    Sink       // SinkFanout delivery thread (per sink and shard)
+};
+
+inline const char* stageName(Stage stage) {
+    switch (stage) {
+    case Stage::Reader: return "reader";
+    case Stage::Dispatch: return "dispatch";
+    case Stage::Worker: return "worker";
+    case Stage::Sink: return "sink";
+    }
+    return "unknown";
+}
+
+struct WatchdogConfig {
+    bool enabled = false;
+    std::chrono::milliseconds interval{1000};       // Check period
+    std::chrono::milliseconds stallAfter{5000};     // No beat for this long = stalled
+    bool stackDump = true;                          // Stalled thread prints its backtrace to stderr (SIGUSR2)
+    bool reconnect = false;                         // Reader / dispatch stall: TWS socket shut down, reconnect() takes over
+    std::string statusChannel = "TWS:STATUS";       // {"type": "stall"} / {"type": "stall_cleared"} events
+};
+
+// One per stage thread; every stage loop wakes at least every ~100 ms (poll / wait timeouts),
+// so a beat missing for WatchdogConfig::stallAfter means the thread is stuck, not idle
+// PERFORMANCE: beat() is a relaxed load + store on a line of its own - no RMW on the hot loop
+class Heartbeat {
+public:
+    void beat() { m_beats.store(m_beats.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    // Owning thread, at its start: recorded for the stack dump, clears park()
+    void attach() {
+        m_thread = pthread_self();
+        m_attached.store(true, std::memory_order_release);
+        park(false);
+    }
+    // Owning thread: not expected to beat (backing off before a reconnect, thread exited)
+    void park(bool parked) {
+        beat();  // REASON: The stall timer restarts from here when un-parked
+        m_parked.store(parked, std::memory_order_relaxed);
+    }
+
+    std::uint64_t beats() const { return m_beats.load(std::memory_order_relaxed); }
+    bool parked() const { return m_parked.load(std::memory_order_relaxed); }
+    bool attached() const { return m_attached.load(std::memory_order_acquire); }
+    pthread_t thread() const { return m_thread; }
+
+private:
+    alignas(64) std::atomic<std::uint64_t> m_beats{0};
+    std::atomic<bool> m_parked{true};               // REASON: Not watched until the thread attaches
+    std::atomic<bool> m_attached{false};
+    pthread_t m_thread{};
+};
+
+/**
+ * Every interval the watchdog compares each stage's beat count with the previous check. A stage
+ * that has not moved for stallAfter is reported once: log line, stack dump of the stuck thread,
+ * status event, then the stage's recover action (WatchdogConfig::reconnect). The first beat
+ * afterwards clears it.
+ *
+ * REASON: Stalls used to show up only as flat lines on dashboards - a blocked Redis call or a
+ * stuck socket read now surfaces within stallAfter + interval
+ * NOTE: Detects stuck threads, not silent feeds - a half-open socket whose reader keeps polling beats normally
+ */
+class StageWatchdog {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Watched {
+        Stage stage;
+        std::size_t index;                          // Connection / shard (sinks: shard)
+        const Heartbeat* heartbeat;
+        std::function<void()> recover;              // Optional, WatchdogConfig::reconnect only
+        std::uint64_t lastBeats = 0;
+        Clock::time_point lastChange{};
+        bool stalled = false;
+        std::atomic<std::uint64_t> stalls{0};       // Lifetime (metrics thread reads)
+    };
+
+    // redisUri: status events go out on a dedicated connection ("" = log only)
+    explicit StageWatchdog(WatchdogConfig config, std::string redisUri = {})
+        : m_config(std::move(config))
+        , m_redisUri(std::move(redisUri)) {}
+    ~StageWatchdog();
+
+    StageWatchdog(const StageWatchdog&) = delete;
+    StageWatchdog& operator=(const StageWatchdog&) = delete;
+
+    // Before start() only - heartbeat must outlive the watchdog (stop() first)
+    void watch(Stage stage, std::size_t index, const Heartbeat& heartbeat, std::function<void()> recover = {}) {
+        auto entry = std::make_unique<Watched>();
+        entry->stage = stage;
+        entry->index = index;
+        entry->heartbeat = &heartbeat;
+        entry->recover = std::move(recover);
+        m_watched.push_back(std::move(entry));
+    }
+
+    void start();
+    void stop();
+
+    // One check at now: onStall(watched, silentFor) / onClear(watched) for each stage that changed state
+    // NOTE: Parked stages are skipped and their timer restarts - a reconnect back-off is not a stall
+    template <typename OnStall, typename OnClear>
+    void check(Clock::time_point now, OnStall&& onStall, OnClear&& onClear) {
+        for (auto& entry : m_watched) {
+            Watched& watched = *entry;
+            const std::uint64_t beats = watched.heartbeat->beats();
+            if (beats != watched.lastBeats || watched.lastChange == Clock::time_point{} || watched.heartbeat->parked()) {
+                watched.lastBeats = beats;
+                watched.lastChange = now;
+                if (watched.stalled) {
+                    watched.stalled = false;
+                    onClear(watched);
+                }
+                continue;
+            }
+            if (!watched.stalled && now - watched.lastChange >= m_config.stallAfter) {
+                watched.stalled = true;
+                watched.stalls.fetch_add(1, std::memory_order_relaxed);
+                onStall(watched, now - watched.lastChange);
+            }
+        }
+    }
+
+    const std::vector<std::unique_ptr<Watched>>& watched() const { return m_watched; }
+    const WatchdogConfig& config() const { return m_config; }
+
+private:
+    void run();
+    void report(const Watched& watched, bool stalled, Clock::duration silentFor);
+
+    WatchdogConfig m_config;
+    std::string m_redisUri;
+    std::vector<std::unique_ptr<Watched>> m_watched;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,240 @@
+// StateCheckpoint.h - Worker slot state mirrored into POSIX shared memory for restart-in-place
+// SCOPE: Written by the Redis workers (each only its own slots, once per drain batch), read once at startup
+// by the next bridge process - survives a crash or an upgrade of the process, not a reboot
+
+#pragma once
+
+#include "BarBuilder.h"
+#include "DerivedMetrics.h"
+#include "TradeCodes.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace tws_bridge {
+
+struct StateCheckpointConfig {
+    bool enabled = false;
+    std::string name = "/tws-bridge-state";         // shm_open name, one segment for all shards
+};
+
+// What a restarted worker cannot rebuild from a snapshot: session VWAP, rolling volume, open built bars
+// PERFORMANCE: Trivially copyable - written and restored with plain copies, nothing is parsed
+struct SlotCheckpoint {
+    static constexpr std::size_t kSymbolBytes = 32;
+
+    char symbol[kSymbolBytes];                      // NUL-padded (longer symbols are not checkpointed)
+    std::int32_t conId;
+    ExchangeCode primaryExchange;
+    ExchangeCode exchange;                          // Last trade
+    bool hasQuote;
+    bool hasTrade;
+    bool pastLimit;
+    std::uint8_t sizeScale;                         // Decimal places of the three sizes (Quantity.h)
+    double bidPrice;
+    double askPrice;
+    double lastPrice;
+    std::int64_t bidSize;
+    std::int64_t askSize;
+    std::int64_t lastSize;
+    std::int64_t quoteTimestamp;
+    std::int64_t tradeTimestamp;
+    std::uint64_t tradeConditions;
+    std::uint64_t trades;                           // AllLast count (duplicate suppression)
+    std::uint64_t sequence;                         // Last published "seq" (consumers see no reset on restart)
+    DerivedMetrics derived;
+    std::array<BarBuilder::FrameState, BarBuilder::kMaxTimeframes> bars;  // size Unknown = unused
+};
+
+static_assert(std::is_trivially_copyable_v<SlotCheckpoint>, "SlotCheckpoint is copied into shared memory");
+
+// Settings the checkpointed derived metrics depend on - a restart with other values drops them
+struct CheckpointLayout {
+    std::int64_t sessionResetMs = 0;
+    std::int64_t rollingWindowMs = 0;
+};
+
+// Previous process's checkpoint, keyed by symbol (slots are reassigned on every start)
+struct CheckpointImage {
+    std::unordered_map<std::string, SlotCheckpoint> slots;
+    bool derivedValid = false;                      // Written with the same CheckpointLayout
+
+    const SlotCheckpoint* find(const std::string& symbol) const {
+        const auto it = slots.find(symbol);
+        return it == slots.end() ? nullptr : &it->second;
+    }
+};
+
+namespace checkpoint_detail {
+
+constexpr std::uint32_t kMagic = 0x4B435354;        // "TSCK" little-endian
+constexpr std::uint32_t kVersion = 3;              // 2: SlotCheckpoint::sequence, 3: scaled int64 sizes
+
+struct alignas(64) Header {
+    std::uint32_t magic;                            // Stored last (release) - a half-built segment is ignored
+    std::uint32_t version;
+    std::uint32_t recordBytes;                      // REASON: Another build's SlotCheckpoint layout is rejected
+    std::uint32_t capacity;
+    std::int64_t sessionResetMs;
+    std::int64_t rollingWindowMs;
+};
+
+// Seqlock: 0 = never written, odd = being written (left odd by a crash mid-copy), even = complete
+struct alignas(64) Record {
+    std::atomic<std::uint64_t> seq;
+    SlotCheckpoint data;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared-memory atomics must be lock-free");
+
+inline std::size_t mappingBytes(std::size_t capacity) {
+    return sizeof(Header) + capacity * sizeof(Record);
+}
+
+} // namespace checkpoint_detail
+
+// One record per registry slot; a slot is only ever written by the worker that owns it
+// CRITICAL PATH: write() = two seq stores + one fence around the copy, no syscall
+// NOTE: The segment outlives the process on purpose - remove /dev/shm/{name} to start cold
+class StateCheckpoint {
+public:
+    // Creates (or replaces) /dev/shm/{name}; nullptr on failure (logged)
+    // PITFALL: Load the previous image first - this discards it
+    static std::unique_ptr<StateCheckpoint> create(const std::string& name, std::size_t capacity,
+                                                   const CheckpointLayout& layout) {
+        const std::size_t bytes = checkpoint_detail::mappingBytes(capacity);
+        ::shm_unlink(name.c_str());  // REASON: The previous segment may have another capacity or layout
+        const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            std::cerr << "[CHECKPOINT] Cannot create " << name << ": " << std::strerror(errno) << "\n";
+            return nullptr;
+        }
+        void* base = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0
+            ? ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            std::cerr << "[CHECKPOINT] Cannot map " << name << ": " << std::strerror(errno) << "\n";
+            ::shm_unlink(name.c_str());
+            return nullptr;
+        }
+        return std::unique_ptr<StateCheckpoint>(new StateCheckpoint(name, static_cast<char*>(base), bytes, capacity, layout));
+    }
+
+    // Complete records of the segment a previous process left behind
+    // Empty image (why = reason) when there is none or it was written by another build
+    static CheckpointImage load(const std::string& name, const CheckpointLayout& layout, std::string& why) {
+        CheckpointImage image;
+        const int fd = ::shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+        if (fd < 0) {
+            why = "no checkpoint";
+            return image;
+        }
+        struct stat info {};
+        void* base = ::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(checkpoint_detail::Header)
+            ? ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            why = "unreadable checkpoint";
+            return image;
+        }
+        const std::size_t bytes = static_cast<std::size_t>(info.st_size);
+        const auto* header = static_cast<const checkpoint_detail::Header*>(base);
+        const std::uint32_t magic =
+            reinterpret_cast<const std::atomic<std::uint32_t>*>(&header->magic)->load(std::memory_order_acquire);
+        if (magic != checkpoint_detail::kMagic || header->version != checkpoint_detail::kVersion
+            || header->recordBytes != sizeof(checkpoint_detail::Record)
+            || bytes < checkpoint_detail::mappingBytes(header->capacity)) {
+            ::munmap(base, bytes);
+            why = "checkpoint written by another version";
+            return image;
+        }
+        image.derivedValid = header->sessionResetMs == layout.sessionResetMs && header->rollingWindowMs == layout.rollingWindowMs;
+        const auto* records = reinterpret_cast<const checkpoint_detail::Record*>(static_cast<const char*>(base) + sizeof(*header));
+        image.slots.reserve(header->capacity);
+        for (std::size_t i = 0; i < header->capacity; ++i) {
+            const checkpoint_detail::Record& record = records[i];
+            const std::uint64_t before = record.seq.load(std::memory_order_acquire);
+            if (before == 0 || (before & 1) != 0) {
+                continue;  // Never written, or torn by a crash
+            }
+            SlotCheckpoint data;
+            std::memcpy(&data, &record.data, sizeof(data));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // REASON: An upgrade may start while the old process still writes
+            if (record.seq.load(std::memory_order_relaxed) != before) {
+                continue;
+            }
+            const std::size_t length = ::strnlen(data.symbol, SlotCheckpoint::kSymbolBytes);
+            if (length > 0 && length < SlotCheckpoint::kSymbolBytes) {
+                image.slots[std::string(data.symbol, length)] = data;
+            }
+        }
+        ::munmap(base, bytes);
+        return image;
+    }
+
+    // REASON: No shm_unlink - the next process restores from it
+    ~StateCheckpoint() { ::munmap(m_base, m_bytes); }
+
+    StateCheckpoint(const StateCheckpoint&) = delete;
+    StateCheckpoint& operator=(const StateCheckpoint&) = delete;
+
+    // fill(SlotCheckpoint&) overwrites the slot's record in place (owning worker thread only)
+    template <typename Fill>
+    void write(std::size_t slot, Fill&& fill) {
+        if (slot >= m_capacity) {
+            return;
+        }
+        checkpoint_detail::Record& record = m_records[slot];
+        const std::uint64_t seq = record.seq.load(std::memory_order_relaxed);
+        record.seq.store(seq + 1, std::memory_order_relaxed);
+        // REASON: Odd seq visible before any field changes (a crash mid-copy leaves the record torn, not wrong)
+        std::atomic_thread_fence(std::memory_order_release);
+        fill(record.data);
+        record.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+    const std::string& name() const { return m_name; }
+
+private:
+    StateCheckpoint(std::string name, char* base, std::size_t bytes, std::size_t capacity, const CheckpointLayout& layout)
+        : m_name(std::move(name))
+        , m_base(base)
+        , m_bytes(bytes)
+        , m_records(reinterpret_cast<checkpoint_detail::Record*>(base + sizeof(checkpoint_detail::Header)))
+        , m_capacity(capacity) {
+        // REASON: ftruncate zero-fills - every record seq starts at 0 (nothing to restore)
+        auto* header = reinterpret_cast<checkpoint_detail::Header*>(base);
+        header->version = checkpoint_detail::kVersion;
+        header->recordBytes = static_cast<std::uint32_t>(sizeof(checkpoint_detail::Record));
+        header->capacity = static_cast<std::uint32_t>(capacity);
+        header->sessionResetMs = layout.sessionResetMs;
+        header->rollingWindowMs = layout.rollingWindowMs;
+        std::atomic_thread_fence(std::memory_order_release);
+        reinterpret_cast<std::atomic<std::uint32_t>*>(&header->magic)->store(checkpoint_detail::kMagic, std::memory_order_release);
+    }
+
+    std::string m_name;
+    char* m_base;
+    std::size_t m_bytes;
+    checkpoint_detail::Record* m_records;
+    std::size_t m_capacity;
+};
+
+} // namespace tws_bridge
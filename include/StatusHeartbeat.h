@@ -0,0 +1,105 @@
+// StatusHeartbeat.h - Compact bridge status published to TWS:STATUS once per interval
+// SCOPE: Own thread + own Redis connection; samples the stages' lifetime atomics (relaxed loads), never
+// pauses or locks a pipeline thread
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace tws_bridge {
+
+// status: {"type":"heartbeat"} so monitoring can subscribe instead of scraping /metrics
+struct StatusConfig {
+    bool enabled = true;
+    std::chrono::milliseconds interval{1000};
+    std::string channel = "TWS:STATUS";             // Follows worker.latency.status_channel
+    std::chrono::milliseconds socketTimeout{200};
+    std::chrono::milliseconds reconnectDelay{1000}; // Back-off after a Redis error
+};
+
+// Lifetime totals and current gauges, summed over shards / publishers / connections by the collector
+struct StatusSample {
+    std::uint64_t ticksIn = 0;                      // TWS callbacks handed to the shard router
+    std::uint64_t published = 0;                    // Snapshots the workers handed to the publishers
+    std::uint64_t sent = 0;                         // Redis commands acknowledged
+    std::uint64_t dropped = 0;                      // Ingest overflow drops + Redis drops / failures
+    std::uint64_t conflated = 0;                    // Ingest + worker conflation
+    std::chrono::nanoseconds queueAge{0};           // Worst shard
+    std::size_t queueDepth = 0;                     // Worst shard
+    std::chrono::nanoseconds redisRtt{0};           // Worst publisher's last pipeline round trip
+    std::size_t redisDown = 0;                      // Publishers without a connection
+    std::size_t twsConnected = 0;
+    std::size_t twsConnections = 0;
+    std::size_t subscriptions = 0;
+};
+
+// One interval: per-stage rates and counts from two samples, gauges from the later one
+struct StatusReport {
+    double ticksInPerSecond = 0.0;                  // Stage 1: TWS → shard queues
+    double publishedPerSecond = 0.0;                // Stage 2: workers → publishers
+    double sentPerSecond = 0.0;                     // Stage 3: publishers → Redis
+    std::uint64_t dropped = 0;                      // This interval
+    std::uint64_t conflated = 0;                    // This interval
+    std::int64_t intervalMs = 0;
+    StatusSample current;
+};
+
+// REASON: Totals only grow - a counter that went backwards (component replaced) counts as 0, not 2^64
+inline StatusReport makeStatusReport(const StatusSample& previous, const StatusSample& current,
+                                     std::chrono::nanoseconds elapsed) {
+    auto delta = [](std::uint64_t before, std::uint64_t after) { return after >= before ? after - before : 0; };
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    auto rate = [seconds](std::uint64_t count) { return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0; };
+    StatusReport report;
+    report.ticksInPerSecond = rate(delta(previous.ticksIn, current.ticksIn));
+    report.publishedPerSecond = rate(delta(previous.published, current.published));
+    report.sentPerSecond = rate(delta(previous.sent, current.sent));
+    report.dropped = delta(previous.dropped, current.dropped);
+    report.conflated = delta(previous.conflated, current.conflated);
+    report.intervalMs = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    report.current = current;
+    return report;
+}
+
+// Lifetime counters (written by the heartbeat thread, readable from any thread)
+struct StatusCounters {
+    std::atomic<std::uint64_t> published{0};
+    std::atomic<std::uint64_t> errors{0};
+};
+
+// ARCHITECTURE: The collector runs on this thread and only reads atomics the stages already keep for
+// /metrics - the cost to the pipeline is nothing, the cost to Redis one PUBLISH per interval
+// PITFALL: Everything the collector reads must outlive stop()
+class StatusHeartbeat {
+public:
+    using Collect = std::function<void(StatusSample&)>;
+
+    StatusHeartbeat(const std::string& uri, StatusConfig config, Collect collect);
+    ~StatusHeartbeat();
+
+    StatusHeartbeat(const StatusHeartbeat&) = delete;
+    StatusHeartbeat& operator=(const StatusHeartbeat&) = delete;
+
+    void start();
+    void stop();
+
+    const StatusCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+
+    std::string m_uri;
+    StatusConfig m_config;
+    Collect m_collect;
+    StatusCounters m_counters;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,114 @@
+// SubscriberTracker.h - Which TWS:TICKS:* channels have Pub/Sub subscribers (periodic PUBSUB NUMSUB)
+// SCOPE: Own thread + own Redis connection writes per-slot flags, Redis workers read them
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace tws_bridge {
+
+// Per-slot "has a subscriber" flags
+// REASON: Fail open - every slot starts watched and markAllWatched() restores that after a probe error,
+// so a Redis hiccup never silences a symbol someone is looking at
+class SubscriberTable {
+public:
+    explicit SubscriberTable(std::size_t capacity)
+        : m_capacity(capacity)
+        , m_watched(std::make_unique<std::atomic<std::uint8_t>[]>(capacity)) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            m_watched[i].store(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Any thread (worker hot path: one relaxed byte load)
+    bool watched(SlotId slot) const {
+        return slot >= m_capacity || m_watched[slot].load(std::memory_order_relaxed) != 0;
+    }
+    // Bumped whenever a slot turns watched (workers re-publish those slots once)
+    std::uint64_t generation() const { return m_generation.load(std::memory_order_acquire); }
+
+    // ========== Tracker thread ==========
+    void update(SlotId slot, bool subscribed) {
+        if (slot >= m_capacity) {
+            return;
+        }
+        const std::uint8_t previous = m_watched[slot].exchange(subscribed ? 1 : 0, std::memory_order_relaxed);
+        if (subscribed && previous == 0) {
+            m_turnedWatched = true;
+        }
+    }
+
+    void markAllWatched() {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            update(static_cast<SlotId>(i), true);
+        }
+        publish();
+    }
+
+    // Ends a probe pass: workers see the new generation only if some slot turned watched
+    void publish() {
+        if (m_turnedWatched) {
+            m_turnedWatched = false;
+            m_generation.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+
+private:
+    std::size_t m_capacity;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> m_watched;  // By slot
+    std::atomic<std::uint64_t> m_generation{0};
+    bool m_turnedWatched = false;                            // Tracker thread only
+};
+
+struct SubscriberTrackerConfig {
+    std::chrono::milliseconds probeInterval{1000};   // A newly watched symbol publishes within this
+    std::size_t slotsPerProbe = 128;                 // Slots per PUBSUB NUMSUB round trip (two channels each)
+    std::chrono::milliseconds socketTimeout{200};
+    std::chrono::milliseconds reconnectDelay{1000};  // Back-off after a Redis error
+};
+
+// Lifetime counters (written by the tracker thread, readable from any thread)
+struct SubscriberTrackerCounters {
+    std::atomic<std::uint64_t> probes{0};            // Full passes over the registry
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<std::uint64_t> watched{0};           // Slots with a subscriber after the last pass (gauge)
+};
+
+// ARCHITECTURE: The worker never waits on Redis for this - it reads the table; a symbol without
+// subscribers keeps aggregating, only its encode + publish are skipped
+// PITFALL: Classic Pub/Sub only - in Redis Cluster NUMSUB counts the queried node's subscribers
+class SubscriberTracker {
+public:
+    SubscriberTracker(const std::string& uri, const InstrumentRegistry& registry,
+                      SubscriberTrackerConfig config = {});
+    ~SubscriberTracker();
+
+    SubscriberTracker(const SubscriberTracker&) = delete;
+    SubscriberTracker& operator=(const SubscriberTracker&) = delete;
+
+    void start();
+    void stop();
+
+    const SubscriberTable& table() const { return m_table; }
+    const SubscriberTrackerCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+
+    std::string m_uri;
+    const InstrumentRegistry& m_registry;
+    SubscriberTrackerConfig m_config;
+    SubscriberTrackerCounters m_counters;
+    SubscriberTable m_table;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,64 @@
+// SubscriptionCommand.h - TWS:COMMANDS message model + parser (spec §3.4.2)
+// SCOPE: Command listener thread (parse + enqueue), message thread (apply between processMessages)
+
+#pragma once
+
+#include "OptionChain.h"
+#include <concurrentqueue.h>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace tws_bridge {
+
+enum class CommandAction {
+    Subscribe,    // reqTickByTickData BidAsk + AllLast (or reqMktData, see FeedType)
+    Unsubscribe,  // Cancels whichever feed is active, callbacks for the ids stop routing
+    Interest,     // Consumer wants the symbol for "ttl" seconds (demand.enabled, see SubscriptionDemand.h)
+    Release,      // Consumer no longer wants the symbol
+    Profile       // Sample the bridge's own stacks for "duration" seconds (profiler.enabled, see SamplingProfiler.h)
+};
+
+// Which TWS feed a subscription uses (TickByTick / TopOfBook publish the same TWS:TICKS channels)
+enum class FeedType {
+    Auto,         // Tick-by-tick while streams are left (PacingConfig::maxTickByTick), else TopOfBook
+    TickByTick,   // reqTickByTickData: every trade / quote change (2 of the account's few streams)
+    TopOfBook,    // reqMktData (L1): aggregated snapshots, no stream limit - hundreds of symbols
+    MidPoint,     // reqTickByTickData MidPoint: midpoint only, on TWS:MID:{SYMBOL} (1 stream, no snapshot)
+    OptionChain   // reqSecDefOptParams + one reqMktData per leg: model greeks on TWS:CHAIN:{SYMBOL}:{EXPIRY}
+};
+
+// One subscription request, defaults per the command schema
+struct SubscriptionCommand {
+    CommandAction action = CommandAction::Subscribe;
+    std::string symbol;
+    std::string secType = "STK";
+    std::string exchange = "SMART";
+    std::string currency = "USD";
+    std::string primaryExchange;   // Optional disambiguation
+    std::string requestId;         // Client tracking id, echoed in logs
+    int priority = 0;              // Pacing order, higher first (e.g. liquidity rank)
+    FeedType feed = FeedType::Auto;
+    ChainRequest chain;            // FeedType::OptionChain only: "expiries", "minStrike", "maxStrike"
+    std::string consumer;          // Interest / Release only: refcount key (required)
+    std::chrono::seconds ttl{0};   // Interest only: heartbeat period, 0 = demand.default_ttl
+    std::chrono::seconds duration{0};  // Profile only: sampling time, 0 = profiler.default_duration
+};
+
+// Listener → message thread
+// REASON: Lock-free - the message thread polls it between every processMessages() call
+using CommandQueue = moodycamel::ConcurrentQueue<SubscriptionCommand>;
+
+// Parses one command payload, false (error describes why) on invalid JSON or schema violation
+// e.g. {"action":"subscribe","symbol":"AAPL","secType":"STK","requestId":"req-12345"}
+// Optional "feed": "auto" (default), "tickByTick", "topOfBook", "midPoint" or "optionChain"
+// e.g. {"action":"subscribe","symbol":"SPY","feed":"optionChain","expiries":2,"minStrike":540,"maxStrike":600}
+// e.g. {"action":"interest","symbol":"AAPL","consumer":"desk-7","ttl":30} - repeat within ttl to keep it alive
+// e.g. {"action":"profile","duration":30} - no symbol
+bool parseSubscriptionCommand(const char* data, std::size_t length, SubscriptionCommand& out, std::string& error);
+
+inline bool parseSubscriptionCommand(const std::string& payload, SubscriptionCommand& out, std::string& error) {
+    return parseSubscriptionCommand(payload.data(), payload.size(), out, error);
+}
+
+} // namespace tws_bridge
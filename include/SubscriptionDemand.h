@@ -0,0 +1,191 @@
+// SubscriptionDemand.h - Demand-driven feeds: a symbol streams tick-by-tick only while a consumer wants it
+// SCOPE: Main thread - interest from TWS:COMMANDS (refcounted per consumer, TTL heartbeats) and / or Pub/Sub
+// subscribers (SubscriberTable), transitions applied as subscribe / unsubscribe commands
+
+#pragma once
+
+#include "SubscriptionCommand.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// Feed of a tracked symbol
+enum class DemandLevel : std::uint8_t {
+    Off,     // Not subscribed (untracked, or idle with DemandIdle::None)
+    Idle,    // Nobody interested: the idle feed
+    Active   // Interested: the active feed
+};
+
+inline const char* demandLevelName(DemandLevel level) {
+    switch (level) {
+    case DemandLevel::Off: return "off";
+    case DemandLevel::Idle: return "idle";
+    case DemandLevel::Active: return "active";
+    }
+    return "unknown";
+}
+
+// What an idle symbol keeps
+enum class DemandIdle : std::uint8_t {
+    TopOfBook,  // reqMktData L1 - no stream used, the last value stays fresh
+    None        // Unsubscribed - no line used at all
+};
+
+struct DemandConfig {
+    bool enabled = false;
+    FeedType activeFeed = FeedType::Auto;           // Auto: tick-by-tick while streams are left, else L1
+    DemandIdle idleFeed = DemandIdle::TopOfBook;
+    bool subscribers = false;                       // Pub/Sub subscribers count as interest (redis.watch_subscribers)
+    std::chrono::seconds defaultTtl{30};            // Interest without "ttl" lapses after this without a heartbeat
+    std::chrono::seconds maxTtl{3600};              // Longer "ttl" values are capped
+    std::chrono::milliseconds upgradeAfter{0};      // Interested this long before the active feed is requested
+    std::chrono::seconds downgradeAfter{30};        // Nobody interested this long before the idle feed returns
+};
+
+// Lifetime counters (main thread writes, metrics read - plain integers, same thread)
+struct DemandCounters {
+    std::uint64_t upgrades = 0;
+    std::uint64_t downgrades = 0;
+    std::uint64_t expired = 0;                      // Interests that lapsed without a heartbeat or release
+};
+
+// Hysteresis: a symbol turns Active after upgradeAfter of continuous interest, Idle after downgradeAfter
+// without - a consumer reconnecting (or a NUMSUB probe missing a subscriber once) never flaps the feed
+// REASON: Interest is refcounted by consumer id - one consumer's release leaves the others' streams alone,
+// and a consumer that dies without releasing lapses after its TTL instead of holding the line forever
+class SubscriptionDemand {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SubscriptionDemand(DemandConfig config) : m_config(std::move(config)) {}
+
+    // Puts symbol under demand control (no-op if it already is) - update() decides its first feed
+    void track(const std::string& symbol) { m_symbols.emplace(symbol, Entry{}); }
+
+    // "interest" command: (re)declares consumer's interest for ttl (0 = defaultTtl), tracks the symbol
+    void interest(const std::string& symbol, const std::string& consumer, std::chrono::seconds ttl, Clock::time_point now) {
+        if (ttl.count() <= 0) {
+            ttl = m_config.defaultTtl;
+        }
+        if (ttl > m_config.maxTtl) {
+            ttl = m_config.maxTtl;
+        }
+        m_symbols[symbol].consumers[consumer] = now + ttl;
+    }
+
+    // "release" command: drops consumer's interest (the feed follows after downgradeAfter)
+    void release(const std::string& symbol, const std::string& consumer) {
+        auto it = m_symbols.find(symbol);
+        if (it != m_symbols.end()) {
+            it->second.consumers.erase(consumer);
+        }
+    }
+
+    // Expires lapsed interests and moves symbols between levels
+    // subscribed(symbol): Pub/Sub interest (consulted with DemandConfig::subscribers only)
+    // onChange(symbol, from, to) for every transition, in symbol order
+    template <typename Subscribed, typename OnChange>
+    void update(Clock::time_point now, Subscribed&& subscribed, OnChange&& onChange) {
+        for (auto& [symbol, entry] : m_symbols) {
+            for (auto it = entry.consumers.begin(); it != entry.consumers.end();) {
+                if (it->second <= now) {
+                    ++m_counters.expired;
+                    it = entry.consumers.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            const bool wanted = !entry.consumers.empty() || (m_config.subscribers && subscribed(symbol));
+            const DemandLevel before = entry.level;
+            if (wanted) {
+                entry.unwantedSince = Clock::time_point{};
+                if (entry.wantedSince == Clock::time_point{}) {
+                    entry.wantedSince = now;
+                }
+                if (entry.level != DemandLevel::Active && now - entry.wantedSince >= m_config.upgradeAfter) {
+                    entry.level = DemandLevel::Active;
+                    ++m_counters.upgrades;
+                }
+            } else {
+                entry.wantedSince = Clock::time_point{};
+                if (entry.unwantedSince == Clock::time_point{}) {
+                    entry.unwantedSince = now;
+                }
+                // REASON: A newly tracked symbol takes its idle feed at once - hysteresis guards streams only
+                if (entry.level == DemandLevel::Active && now - entry.unwantedSince >= m_config.downgradeAfter) {
+                    entry.level = idleLevel();
+                    ++m_counters.downgrades;
+                } else if (!entry.started) {
+                    entry.level = idleLevel();
+                }
+            }
+            entry.started = true;
+            if (entry.level != before) {
+                onChange(symbol, before, entry.level);
+            }
+        }
+    }
+
+    DemandLevel level(const std::string& symbol) const {
+        auto it = m_symbols.find(symbol);
+        return it != m_symbols.end() ? it->second.level : DemandLevel::Off;
+    }
+    // Consumers currently interested in symbol (refcount)
+    std::size_t interested(const std::string& symbol) const {
+        auto it = m_symbols.find(symbol);
+        return it != m_symbols.end() ? it->second.consumers.size() : 0;
+    }
+    std::size_t tracked() const { return m_symbols.size(); }
+    std::size_t active() const {
+        std::size_t count = 0;
+        for (const auto& entry : m_symbols) {
+            count += entry.second.level == DemandLevel::Active ? 1 : 0;
+        }
+        return count;
+    }
+    const DemandCounters& counters() const { return m_counters; }
+    const DemandConfig& config() const { return m_config; }
+
+    // Subscribe / unsubscribe commands that move a symbol from one level to another (requestId "demand")
+    std::vector<SubscriptionCommand> commands(const std::string& symbol, DemandLevel from, DemandLevel to) const {
+        std::vector<SubscriptionCommand> out;
+        SubscriptionCommand command;
+        command.symbol = symbol;
+        command.requestId = "demand";
+        if (from != DemandLevel::Off) {
+            command.action = CommandAction::Unsubscribe;
+            out.push_back(command);
+        }
+        if (to != DemandLevel::Off) {
+            command.action = CommandAction::Subscribe;
+            command.feed = to == DemandLevel::Active ? m_config.activeFeed : FeedType::TopOfBook;
+            out.push_back(command);
+        }
+        return out;
+    }
+
+private:
+    struct Entry {
+        std::map<std::string, Clock::time_point> consumers;  // Consumer id → interest expiry
+        DemandLevel level = DemandLevel::Off;
+        bool started = false;                               // First update() done
+        Clock::time_point wantedSince{};                    // {} = not wanted
+        Clock::time_point unwantedSince{};                  // {} = wanted
+    };
+
+    DemandLevel idleLevel() const {
+        return m_config.idleFeed == DemandIdle::TopOfBook ? DemandLevel::Idle : DemandLevel::Off;
+    }
+
+    DemandConfig m_config;
+    DemandCounters m_counters;
+    std::map<std::string, Entry> m_symbols;  // PERFORMANCE: Cold path (100 ms main loop), ordered for stable logs
+};
+
+} // namespace tws_bridge
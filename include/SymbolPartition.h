@@ -0,0 +1,195 @@
+// SymbolPartition.h - Which bridge instance subscribes which symbol (rendezvous hashing over the members)
+// SCOPE: Startup symbols (main thread), TWS:COMMANDS (listener thread) and membership changes
+// (membership thread) all go through one SymbolPartition, which feeds the per-connection command queues
+
+#pragma once
+
+#include "ConnectionRouting.h"
+#include "SubscriptionCommand.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// Weight of a (member, symbol) pair - the highest weight owns the symbol
+inline std::uint64_t rendezvousWeight(std::string_view member, std::string_view symbol) {
+    // REASON: FNV-1a (stable across hosts and runs) + a 64-bit finalizer - FNV alone clusters on
+    // symbols that differ in the last character
+    std::uint64_t hash = 14695981039346656037ull;
+    auto feed = [&hash](std::string_view text) {
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+    };
+    feed(member);
+    hash ^= 0xff;  // REASON: Separator - ("AB", "C") and ("A", "BC") weigh differently
+    hash *= 1099511628211ull;
+    feed(symbol);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Index into members of the symbol's owner (members.size() if there are none)
+// ARCHITECTURE: Rendezvous (highest random weight) hashing - a joining or leaving member moves only the
+// symbols it gains or held (~1/N of them), and every instance computes the same owner from the same
+// member list without a shared assignment table
+inline std::size_t partitionOwner(std::string_view symbol, const std::vector<std::string>& members) {
+    std::size_t owner = members.size();
+    std::uint64_t best = 0;
+    for (std::size_t i = 0; i < members.size(); ++i) {
+        const std::uint64_t weight = rendezvousWeight(members[i], symbol);
+        if (owner == members.size() || weight > best || (weight == best && members[i] < members[owner])) {
+            owner = i;
+            best = weight;
+        }
+    }
+    return owner;
+}
+
+// A subscription the whole cluster knows about, with the TWS:COMMANDS payload it came from
+// ("" = startup symbol, every instance has it in its own config)
+struct UniverseEntry {
+    SubscriptionCommand command;
+    std::string payload;
+};
+
+// Universe write for the membership thread (TWS:UNIVERSE hash: symbol -> payload, "" payload = HDEL)
+struct UniverseWrite {
+    std::string symbol;
+    std::string payload;
+};
+
+// Every instance sees every command (Pub/Sub fan-out) and the same member list, so each one keeps the
+// whole universe and subscribes only the symbols it owns
+// REASON: One mutex around the universe and the enqueue - a rebalance and a command for the same symbol
+// reach the command queue in the order they were decided
+// PERFORMANCE: Cold path only (commands and membership changes) - the tick path never sees it
+class SymbolPartition {
+public:
+    SymbolPartition(std::string self, std::vector<CommandQueue*> queues)
+        : m_self(std::move(self))
+        , m_queues(std::move(queues))
+        , m_members{m_self} {
+    }
+
+    SymbolPartition(const SymbolPartition&) = delete;
+    SymbolPartition& operator=(const SymbolPartition&) = delete;
+
+    const std::string& self() const { return m_self; }
+
+    // Records the command in the universe, enqueues it if this instance owns the symbol
+    // payload: the TWS:COMMANDS message (written to the shared universe by the owner), "" for startup symbols
+    void submit(SubscriptionCommand command, std::string payload = {}) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const std::string symbol = command.symbol;
+        const bool owner = ownsLocked(symbol);
+        if (command.action == CommandAction::Subscribe) {
+            if (owner) {
+                m_owned.insert(symbol);
+                enqueue(command);
+                if (!payload.empty()) {
+                    m_writes.push_back({symbol, payload});
+                }
+            }
+            m_universe[symbol] = UniverseEntry{std::move(command), std::move(payload)};
+            return;
+        }
+        m_universe.erase(symbol);
+        if (owner) {
+            m_writes.push_back({symbol, {}});
+        }
+        // NOTE: Cancelled wherever it is subscribed - ownership may have moved since the subscribe
+        if (m_owned.erase(symbol) > 0) {
+            enqueue(std::move(command));
+        }
+    }
+
+    // New member list (sorted, including this instance): subscribes what moved here, cancels what moved away
+    // learned: the shared universe (symbols subscribed before this instance joined), merged first
+    // Returns the number of commands enqueued
+    std::size_t rebalance(std::vector<std::string> members, std::vector<UniverseEntry> learned = {}) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (UniverseEntry& entry : learned) {
+            const std::string symbol = entry.command.symbol;
+            m_universe.emplace(symbol, std::move(entry));  // NOTE: Never overrides a command seen live
+        }
+        m_members = std::move(members);
+        return applyLocked();
+    }
+
+    bool owns(std::string_view symbol) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return ownsLocked(symbol);
+    }
+
+    std::size_t members() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_members.size();
+    }
+
+    std::size_t owned() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_owned.size();
+    }
+
+    // Membership thread: pending universe writes, oldest first
+    std::vector<UniverseWrite> takeWrites() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::exchange(m_writes, {});
+    }
+
+private:
+    bool ownsLocked(std::string_view symbol) const {
+        const std::size_t owner = partitionOwner(symbol, m_members);
+        return owner < m_members.size() && m_members[owner] == m_self;
+    }
+
+    std::size_t applyLocked() {
+        std::size_t enqueued = 0;
+        for (const auto& [symbol, entry] : m_universe) {
+            const bool owner = ownsLocked(symbol);
+            const bool subscribed = m_owned.count(symbol) > 0;
+            if (owner && !subscribed) {
+                m_owned.insert(symbol);
+                enqueue(entry.command);
+                ++enqueued;
+            } else if (!owner && subscribed) {
+                m_owned.erase(symbol);
+                SubscriptionCommand cancel;
+                cancel.action = CommandAction::Unsubscribe;
+                cancel.symbol = symbol;
+                cancel.requestId = "partition";
+                enqueue(std::move(cancel));
+                ++enqueued;
+            }
+        }
+        return enqueued;
+    }
+
+    void enqueue(SubscriptionCommand command) {
+        // REASON: Same connection hash as everywhere else - a symbol's subscribe and cancel meet in one TwsClient
+        m_queues[connectionFor(command.symbol, m_queues.size())]->enqueue(std::move(command));
+    }
+
+    const std::string m_self;
+    const std::vector<CommandQueue*> m_queues;     // By connection index
+    mutable std::mutex m_mutex;
+    std::vector<std::string> m_members;            // Sorted; just this instance until the first heartbeat
+    std::unordered_map<std::string, UniverseEntry> m_universe;
+    std::set<std::string> m_owned;                 // Subscribed here (enqueued, not necessarily acknowledged)
+    std::vector<UniverseWrite> m_writes;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,208 @@
+// TaskPool.h - Work-stealing pool for background jobs (contract cache saves, LVC warm-start loads, ...)
+// SCOPE: Any thread submits, the pool threads ("tws-bg-N") run the jobs - nothing on the tick path waits on one
+
+#pragma once
+
+#include "ThreadAffinity.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// threads.background
+struct TaskPoolConfig {
+    static constexpr std::size_t kAutoThreads = 4;  // REASON: Background jobs are few - a 64-core box needs no 64 threads
+    std::size_t threads = 0;                        // 0 = one per allowed core, 1 to kAutoThreads
+    std::vector<int> cpus;                          // Cores the pool may run on (empty = every core no threads.* pins)
+};
+
+// Lifetime counters (readable from any thread)
+struct TaskPoolCounters {
+    std::atomic<std::uint64_t> executed{0};         // Jobs run
+    std::atomic<std::uint64_t> stolen{0};           // ... of them taken from another thread's deque
+};
+
+// One deque per pool thread: a job submitted from a pool thread goes to its own deque (the owner pops the
+// newest), others are dealt round-robin; an idle thread steals the oldest job of another deque
+// ARCHITECTURE: Jobs that fan out (a job submitting jobs) stay on the thread whose caches hold their data,
+// and a slow job (a Redis round trip, a file rewrite) never holds up the jobs queued behind it
+// PERFORMANCE: Pool threads run SCHED_BATCH on cores no latency-critical thread is pinned to - a job never
+// preempts the reader, msgThread, workers or Redis I/O
+// PITFALL: Blocking jobs occupy their thread - handshakes that must overlap keep their own std::async
+class TaskPool {
+public:
+    TaskPool(std::size_t threads, std::vector<int> cpus, std::string name = "tws-bg")
+        : m_name(std::move(name))
+        , m_cpus(std::move(cpus))
+        , m_queues(threads == 0 ? 1 : threads) {
+        for (std::size_t i = 0; i < m_queues.size(); ++i) {
+            m_queues[i] = std::make_unique<Queue>();
+        }
+        for (std::size_t i = 0; i < m_queues.size(); ++i) {
+            m_threads.emplace_back([this, i]() { run(i); });
+        }
+    }
+
+    ~TaskPool() { stop(); }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Runs fn() on a pool thread, the future carries its result (or exception)
+    template <typename F>
+    auto submit(F&& fn) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        // REASON: std::function needs a copyable target - the packaged_task is shared, not copied
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        std::future<Result> result = task->get_future();
+        post([task]() { (*task)(); });
+        return result;
+    }
+
+    // Runs job on a pool thread, no result (an exception escaping job is logged and dropped)
+    void post(std::function<void()> job) {
+        const std::size_t target = t_pool == this
+            ? t_index
+            : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        {
+            std::lock_guard<std::mutex> lock(m_queues[target]->mutex);
+            m_queues[target]->jobs.push_back(std::move(job));
+        }
+        {
+            // REASON: Counted under the sleep mutex - a thread between its check and its wait cannot miss it
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            ++m_queued;
+        }
+        m_wake.notify_one();
+    }
+
+    // Runs every queued job, then joins the pool threads (idempotent)
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+        m_threads.clear();
+    }
+
+    std::size_t threads() const { return m_queues.size(); }
+    const std::vector<int>& cpus() const { return m_cpus; }
+    const TaskPoolCounters& counters() const { return m_counters; }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    void run(std::size_t index) {
+        t_pool = this;
+        t_index = index;
+        const std::string name = m_name + "-" + std::to_string(index);
+        nameCurrentThread(name.c_str());
+        if (!m_cpus.empty() && !pinCurrentThreadTo(m_cpus)) {
+            std::cerr << "[THREAD] " << name << ": cannot restrict to the background cores\n";
+        }
+        setCurrentThreadBatch();
+        std::function<void()> job;
+        while (take(index, job)) {
+            try {
+                job();
+            } catch (const std::exception& e) {
+                std::cerr << "[POOL] " << name << ": job failed: " << e.what() << "\n";
+            } catch (...) {
+                std::cerr << "[POOL] " << name << ": job failed\n";
+            }
+            job = nullptr;  // REASON: Captures are released now, not when the next job replaces them
+            m_counters.executed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Next job for thread index - false once stopping and every deque is empty
+    bool take(std::size_t index, std::function<void()>& job) {
+        while (true) {
+            if (popOwn(index, job) || steal(index, job)) {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                --m_queued;
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this]() { return m_queued > 0 || m_stopping; });
+            if (m_queued <= 0) {
+                return false;
+            }
+        }
+    }
+
+    bool popOwn(std::size_t index, std::function<void()>& job) {
+        Queue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) {
+            return false;
+        }
+        job = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    // Oldest job of the next non-empty deque, starting after index
+    bool steal(std::size_t index, std::function<void()>& job) {
+        for (std::size_t n = 1; n < m_queues.size(); ++n) {
+            Queue& queue = *m_queues[(index + n) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.jobs.empty()) {
+                job = std::move(queue.jobs.front());
+                queue.jobs.pop_front();
+                m_counters.stolen.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline static thread_local const TaskPool* t_pool = nullptr;
+    inline static thread_local std::size_t t_index = 0;
+
+    const std::string m_name;
+    const std::vector<int> m_cpus;
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::atomic<std::size_t> m_next{0};             // Round-robin target for outside submitters
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    // REASON: Signed - a job is popped before post() counts it, the count dips below 0 for that moment
+    std::ptrdiff_t m_queued = 0;                    // Jobs in all deques (m_sleepMutex)
+    bool m_stopping = false;                        // m_sleepMutex
+
+    std::vector<std::thread> m_threads;
+    TaskPoolCounters m_counters;
+};
+
+// Pool for threads.background: on config.cpus, or on every core the hot-path threads leave free
+// (all cores when they pin none, floating when they pin them all)
+inline std::unique_ptr<TaskPool> makeBackgroundPool(const TaskPoolConfig& config, const std::vector<int>& pinned) {
+    std::vector<int> cpus = config.cpus.empty() ? spareCpus(pinned) : config.cpus;
+    const std::size_t threads = config.threads > 0 ? config.threads
+        : std::clamp<std::size_t>(cpus.size(), 1, TaskPoolConfig::kAutoThreads);
+    return std::make_unique<TaskPool>(threads, std::move(cpus));
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,149 @@
+// ThreadAffinity.h - Per-thread placement: name, CPU core, real-time priority
+// SCOPE: Every bridge thread names itself; latency-critical ones (reader, msgThread, workers, Redis I/O)
+// take a ThreadConfig
+
+#pragma once
+
+#include "AllocationTracker.h"
+#include <pthread.h>
+#include <sched.h>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace tws_bridge {
+
+// Defaults leave the thread as the OS created it (floating, SCHED_OTHER)
+struct ThreadConfig {
+    int cpu = -1;            // Core to pin to (-1 = float) - ideally isolated (isolcpus= / nohz_full=)
+    int fifoPriority = 0;    // SCHED_FIFO 1-99 (0 = normal scheduling), needs CAP_SYS_NICE or an rtprio limit
+};
+
+// Returns false if cpu is negative (pinning disabled) or the kernel refused
+// PERFORMANCE: No migrations - warm caches and no scheduler hops on the tick path
+inline bool pinCurrentThread(int cpu) {
+    if (cpu < 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Lets the calling thread run on any of cpus - returns false if cpus is empty or the kernel refused
+inline bool pinCurrentThreadTo(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Cores this process may run on minus pinned (the hot-path threads' cores), ascending
+// Empty if pinned covers them all - the caller floats
+inline std::vector<int> spareCpus(const std::vector<int>& pinned) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return {};
+    }
+    for (int cpu : pinned) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_CLR(cpu, &set);
+        }
+    }
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// SCHED_BATCH: the scheduler never preempts a running thread to wake this one (no privileges needed)
+// REASON: Background jobs yield to whatever latency-critical thread shares their core
+inline bool setCurrentThreadBatch() {
+    sched_param param{};
+    return pthread_setschedparam(pthread_self(), SCHED_BATCH, &param) == 0;
+}
+
+// Shown by top -H, perf, gdb and /proc/<pid>/task/*/comm
+// NOTE: Linux keeps 15 characters - longer names are truncated
+inline void nameCurrentThread(const char* name) {
+    char shortName[16];
+    std::strncpy(shortName, name, sizeof(shortName) - 1);
+    shortName[sizeof(shortName) - 1] = '\0';
+    pthread_setname_np(pthread_self(), shortName);
+    allocationThreadRenamed();  // REASON: Allocation counters are kept per thread name
+}
+
+// Returns false if priority is 0 (disabled) or the kernel refused (EPERM without CAP_SYS_NICE)
+// PITFALL: A SCHED_FIFO thread that spins starves every normal thread on its core - pin it to its own core
+inline bool setCurrentThreadFifo(int priority) {
+    if (priority <= 0) {
+        return false;
+    }
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+// Names, pins and prioritizes the calling thread - refusals are logged, never fatal (the thread runs unplaced)
+inline void configureCurrentThread(const char* name, const ThreadConfig& config) {
+    nameCurrentThread(name);
+    if (config.cpu >= 0) {
+        if (pinCurrentThread(config.cpu)) {
+            std::cout << "[THREAD] " << name << " pinned to CPU " << config.cpu << "\n";
+        } else {
+            std::cerr << "[THREAD] " << name << ": cannot pin to CPU " << config.cpu << "\n";
+        }
+    }
+    if (config.fifoPriority > 0) {
+        if (setCurrentThreadFifo(config.fifoPriority)) {
+            std::cout << "[THREAD] " << name << " running SCHED_FIFO priority " << config.fifoPriority << "\n";
+        } else {
+            std::cerr << "[THREAD] " << name << ": SCHED_FIFO " << config.fifoPriority
+                      << " refused (needs CAP_SYS_NICE or ulimit -r)\n";
+        }
+    }
+}
+
+// Places the calling thread for this scope, restores its name, affinity and policy on exit
+// REASON: Threads created inside the scope inherit all three - the only hook into threads that
+// third-party code starts (EReader::start)
+class ScopedThreadConfig {
+public:
+    ScopedThreadConfig(const char* name, const ThreadConfig& config) {
+        pthread_getname_np(pthread_self(), m_name, sizeof(m_name));
+        m_restoreAffinity = pthread_getaffinity_np(pthread_self(), sizeof(m_affinity), &m_affinity) == 0;
+        m_restorePolicy = pthread_getschedparam(pthread_self(), &m_policy, &m_param) == 0;
+        configureCurrentThread(name, config);
+    }
+    ~ScopedThreadConfig() {
+        pthread_setname_np(pthread_self(), m_name);
+        if (m_restoreAffinity) {
+            pthread_setaffinity_np(pthread_self(), sizeof(m_affinity), &m_affinity);
+        }
+        if (m_restorePolicy) {
+            pthread_setschedparam(pthread_self(), m_policy, &m_param);
+        }
+    }
+
+    ScopedThreadConfig(const ScopedThreadConfig&) = delete;
+    ScopedThreadConfig& operator=(const ScopedThreadConfig&) = delete;
+
+private:
+    char m_name[16] = {};
+    cpu_set_t m_affinity{};
+    bool m_restoreAffinity = false;
+    int m_policy = SCHED_OTHER;
+    sched_param m_param{};
+    bool m_restorePolicy = false;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,396 @@
+// TickByTickDecoder.h - Fast-path decoder for TWS market data frames
+// TICK_BY_TICK (msg id 99) + L1 TICK_PRICE / TICK_SIZE (msg ids 1, 2) + HISTORICAL_DATA bar batches (msg id 17)
+// SCOPE: BridgeReader dispatch, ahead of EDecoder (every other message type still goes to EDecoder)
+
+#pragma once
+
+#include "BarTime.h"
+#include "FieldScanner.h"
+#include "Quantity.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+namespace tick_by_tick {
+
+constexpr int kMsgId = 99;                   // TICK_BY_TICK (EDecoder.h)
+constexpr int kTickPriceMsgId = 1;           // TICK_PRICE (reqMktData)
+constexpr int kTickSizeMsgId = 2;            // TICK_SIZE (reqMktData)
+constexpr int kHistoricalDataMsgId = 17;     // HISTORICAL_DATA (reqHistoricalData)
+constexpr int kServerVersionHistoryEnd = 196;  // MIN_SERVER_VER_HISTORICAL_DATA_END: no version / dates / hasGaps
+constexpr int kServerVersionRawMsgId = 201;  // MIN_SERVER_VER_PROTOBUF: msg id sent as 4-byte big-endian int
+
+// tickType field values (EDecoder::processTickByTickDataMsg)
+constexpr int kLast = 1;
+constexpr int kAllLast = 2;
+constexpr int kBidAsk = 3;
+constexpr int kMidPoint = 4;
+
+// L1 TickType values (EWrapper.h TickType enum)
+constexpr int kBidSize = 0;
+constexpr int kBid = 1;
+constexpr int kAsk = 2;
+constexpr int kAskSize = 3;
+constexpr int kLastPrice = 4;
+constexpr int kLastSize = 5;
+
+// DELAYED_BID (66) ... DELAYED_LAST_SIZE (71) → live type, anything else unchanged
+// NOTE: Not a fixed offset - delayed prices come first, then the sizes
+constexpr int liveTickType(int tickType) {
+    switch (tickType) {
+    case 66: return kBid;
+    case 67: return kAsk;
+    case 68: return kLastPrice;
+    case 69: return kBidSize;
+    case 70: return kAskSize;
+    case 71: return kLastSize;
+    default: return tickType;
+    }
+}
+
+} // namespace tick_by_tick
+
+// Decoded fields, views point into the frame (valid until the frame buffer is reused)
+struct TickByTickFields {
+    int reqId = 0;
+    int tickType = 0;
+    std::int64_t time = 0;        // Unix seconds
+    double price = 0.0;           // Last / AllLast
+    std::int64_t size = 0;        // Sizes: units at sizeScale (Quantity.h)
+    double bidPrice = 0.0;        // BidAsk
+    double askPrice = 0.0;
+    std::int64_t bidSize = 0;
+    std::int64_t askSize = 0;
+    int sizeScale = 0;            // Decimal places of size / bidSize / askSize (BidAsk: the finer of the two)
+    double midPoint = 0.0;        // MidPoint
+    int attrMask = 0;             // bit 0: pastLimit / bidPastLow, bit 1: unreported / askPastHigh
+    std::string_view exchange;
+    std::string_view specialConditions;
+};
+
+// Decoded L1 tick (reqMktData): TICK_PRICE carries price + paired size, TICK_SIZE just a size
+struct MarketDataTickFields {
+    int reqId = 0;
+    int tickType = 0;             // TickType of the price (or of the size for TICK_SIZE)
+    double price = 0.0;
+    std::int64_t size = 0;        // Units at sizeScale (Quantity.h)
+    int sizeScale = 0;
+    bool hasPrice = false;        // TICK_PRICE
+    int attrMask = 0;             // TICK_PRICE: bit 0 canAutoExecute, bit 1 pastLimit, bit 2 preOpen
+};
+
+// Decoded HISTORICAL_DATA message: one column per Bar field, bar i across all of them
+// PERFORMANCE: Reused for every message - clear() keeps the capacity, so once the longest backfill has
+// been seen a message decodes without a heap allocation (EDecoder: a Bar + std::string time per bar)
+struct HistoricalBarBatch {
+    int reqId = 0;
+    std::vector<std::int64_t> time;     // Bar start, Unix ms (BarTimeParser)
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<std::int64_t> volume;   // Whole shares (decimalToShares rounding)
+    std::vector<double> wap;
+    std::vector<int> count;
+
+    std::size_t size() const { return time.size(); }
+
+    void clear() {
+        time.clear();
+        open.clear();
+        high.clear();
+        low.clear();
+        close.clear();
+        volume.clear();
+        wap.clear();
+        count.clear();
+    }
+
+    void reserve(std::size_t bars) {
+        time.reserve(bars);
+        open.reserve(bars);
+        high.reserve(bars);
+        low.reserve(bars);
+        close.reserve(bars);
+        volume.reserve(bars);
+        wap.reserve(bars);
+        count.reserve(bars);
+    }
+};
+
+// Receives fast-decoded ticks (TwsClient implements it next to EWrapper)
+class FastTickHandler {
+public:
+    virtual ~FastTickHandler() = default;
+    virtual void onTickByTick(const TickByTickFields& fields) = 0;
+    // NOTE: One call per TICK_PRICE (EDecoder makes two: tickPrice + tickSize)
+    virtual void onMarketDataTick(const MarketDataTickFields& fields) = 0;
+    // NOTE: One call per HISTORICAL_DATA message (EDecoder: one historicalData per bar)
+    virtual void onHistoricalBars(const HistoricalBarBatch& batch) = 0;
+};
+
+enum class TickByTickParse {
+    Parsed,        // fields filled, dispatch to FastTickHandler
+    OtherMessage,  // not a fast-path message, hand the frame to EDecoder
+    Fallback       // fast-path message but not fast-path friendly (malformed, no size fallback) - EDecoder
+};
+
+// Converts a size field parseQuantity cannot take ("1E2") to units at a scale, false if unparseable
+// REASON: Decoder stays libbid-free (unit-testable), BridgeReader plugs in the BID conversion
+using SizeFallback = bool (*)(std::string_view text, std::int64_t& units, int& scale);
+
+namespace tick_by_tick_detail {
+
+// Cursor over NUL-terminated fields
+// PERFORMANCE: from_chars straight from the frame, no atoi/atof, no std::string; terminators come from
+// a FieldIndex when one is attached (one SIMD pass per frame), memchr per field otherwise
+struct FieldReader {
+    const char* ptr;
+    const char* end;
+    SizeFallback sizeFallback;
+    const FieldIndex* index = nullptr;   // Built over [base, end)
+    const char* base = nullptr;
+    std::size_t nextField = 0;           // Next index entry
+
+    // Scans the rest of the frame once, next() then reads terminators from the index
+    void attach(FieldIndex& frameIndex) {
+        scanFieldTerminators(ptr, end, frameIndex);
+        index = &frameIndex;
+        base = ptr;
+        nextField = 0;
+    }
+
+    bool next(std::string_view& field) {
+        if (ptr >= end) {
+            return false;
+        }
+        const char* nul = nullptr;
+        if (index && nextField < index->count) {
+            nul = base + index->ends[nextField++];
+        } else if (index && index->complete) {
+            return false;  // REASON: No terminator left in the frame (same as memchr miss)
+        } else {
+            nul = static_cast<const char*>(std::memchr(ptr, 0, static_cast<std::size_t>(end - ptr)));
+        }
+        if (!nul) {
+            return false;
+        }
+        field = std::string_view(ptr, static_cast<std::size_t>(nul - ptr));
+        ptr = nul + 1;
+        return true;
+    }
+
+    // REASON: Whole field must parse - anything else (e.g. "100.5") is left to EDecoder
+    template <typename Int>
+    bool integer(Int& value) {
+        std::string_view field;
+        if (!next(field)) {
+            return false;
+        }
+        if (field.empty()) {
+            value = 0;  // Same as atoi("")
+            return true;
+        }
+        auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == std::errc() && result.ptr == field.data() + field.size();
+    }
+
+    // PERFORMANCE: US equity sizes are integral - from_chars only; fractional sizes ("0.5", "1200.25")
+    // become scaled integers in place; SizeFallback (BID) only for the rest of what carries a '.' or exponent
+    bool size(std::int64_t& value, int& scale) {
+        const char* start = ptr;
+        scale = 0;
+        if (integer(value)) {
+            return true;
+        }
+        if (ptr == start) {
+            return false;  // Field had no terminator
+        }
+        std::string_view field(start, static_cast<std::size_t>(ptr - start - 1));
+        Quantity quantity;
+        if (parseQuantity(field, quantity)) {
+            value = quantity.units;
+            scale = quantity.scale;
+            return true;
+        }
+        if (!sizeFallback || field.find_first_of(".eE") == std::string_view::npos) {
+            return false;  // Not fallback-eligible
+        }
+        return sizeFallback(field, value, scale);
+    }
+
+    bool real(double& value) {
+        std::string_view field;
+        if (!next(field)) {
+            return false;
+        }
+        if (field.empty()) {
+            value = 0.0;  // Same as atof("")
+            return true;
+        }
+        auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == std::errc() && result.ptr == field.data() + field.size();
+    }
+
+    bool text(std::string_view& value) { return next(value); }
+};
+
+inline bool readMsgId(FieldReader& reader, int serverVersion, int& msgId) {
+    if (serverVersion >= tick_by_tick::kServerVersionRawMsgId) {
+        if (reader.end - reader.ptr < 4) {
+            return false;
+        }
+        const auto* bytes = reinterpret_cast<const unsigned char*>(reader.ptr);
+        msgId = static_cast<int>((std::uint32_t{bytes[0]} << 24) | (std::uint32_t{bytes[1]} << 16)
+                                 | (std::uint32_t{bytes[2]} << 8) | std::uint32_t{bytes[3]});
+        reader.ptr += 4;
+        return true;
+    }
+    return reader.integer(msgId);
+}
+
+} // namespace tick_by_tick_detail
+
+// Reads the msg id, body points at the first field after it (false if the frame is too short)
+inline bool readMessageId(const char* begin, const char* end, int serverVersion, int& msgId, const char*& body) {
+    tick_by_tick_detail::FieldReader reader{begin, end, nullptr};
+    if (!tick_by_tick_detail::readMsgId(reader, serverVersion, msgId)) {
+        return false;
+    }
+    body = reader.ptr;
+    return true;
+}
+
+// CRITICAL PATH: Fields after the msg id, order mirrors EDecoder::processTickByTickDataMsg
+inline TickByTickParse parseTickByTickFields(const char* body, const char* end, TickByTickFields& out,
+                                             SizeFallback sizeFallback = nullptr) {
+    tick_by_tick_detail::FieldReader reader{body, end, sizeFallback};
+    FieldIndex index;
+    reader.attach(index);
+
+    if (!reader.integer(out.reqId) || !reader.integer(out.tickType) || !reader.integer(out.time)) {
+        return TickByTickParse::Fallback;
+    }
+
+    switch (out.tickType) {
+    case tick_by_tick::kLast:
+    case tick_by_tick::kAllLast:
+        if (reader.real(out.price) && reader.size(out.size, out.sizeScale) && reader.integer(out.attrMask)
+            && reader.text(out.exchange) && reader.text(out.specialConditions)) {
+            return TickByTickParse::Parsed;
+        }
+        return TickByTickParse::Fallback;
+    case tick_by_tick::kBidAsk: {
+        int askScale = 0;
+        if (reader.real(out.bidPrice) && reader.real(out.askPrice) && reader.size(out.bidSize, out.sizeScale)
+            && reader.size(out.askSize, askScale) && reader.integer(out.attrMask)) {
+            // REASON: One scale per tick - the coarser size is widened (exact)
+            if (askScale > out.sizeScale) {
+                out.bidSize = rescaleUnits(out.bidSize, out.sizeScale, askScale);
+                out.sizeScale = askScale;
+            } else {
+                out.askSize = rescaleUnits(out.askSize, askScale, out.sizeScale);
+            }
+            return TickByTickParse::Parsed;
+        }
+        return TickByTickParse::Fallback;
+    }
+    case tick_by_tick::kMidPoint:
+        return reader.real(out.midPoint) ? TickByTickParse::Parsed : TickByTickParse::Fallback;
+    default:
+        return TickByTickParse::Fallback;
+    }
+}
+
+// CRITICAL PATH: TICK_PRICE fields (EDecoder::processTickPriceMsg): version, id, type, price, size, attrMask
+inline TickByTickParse parseTickPriceFields(const char* body, const char* end, MarketDataTickFields& out,
+                                            SizeFallback sizeFallback = nullptr) {
+    tick_by_tick_detail::FieldReader reader{body, end, sizeFallback};
+    FieldIndex index;
+    reader.attach(index);
+    int version = 0;
+    out.hasPrice = true;
+    if (reader.integer(version) && reader.integer(out.reqId) && reader.integer(out.tickType)
+        && reader.real(out.price) && reader.size(out.size, out.sizeScale) && reader.integer(out.attrMask)) {
+        return TickByTickParse::Parsed;
+    }
+    return TickByTickParse::Fallback;
+}
+
+// TICK_SIZE fields (EDecoder::processTickSizeMsg): version, id, type, size
+inline TickByTickParse parseTickSizeFields(const char* body, const char* end, MarketDataTickFields& out,
+                                           SizeFallback sizeFallback = nullptr) {
+    tick_by_tick_detail::FieldReader reader{body, end, sizeFallback};
+    FieldIndex index;
+    reader.attach(index);
+    int version = 0;
+    out.hasPrice = false;
+    if (reader.integer(version) && reader.integer(out.reqId) && reader.integer(out.tickType)
+        && reader.size(out.size, out.sizeScale)) {
+        return TickByTickParse::Parsed;
+    }
+    return TickByTickParse::Fallback;
+}
+
+// HISTORICAL_DATA fields (EDecoder::processHistoricalDataMsg): reqId, itemCount, then per bar time, open,
+// high, low, close, volume, wap, count - into out (cleared first), times through the caller's parser
+// Fallback for servers before MIN_SERVER_VER_HISTORICAL_DATA_END (EDecoder also sends historicalDataEnd
+// there) and for any bar time BarTimeParser cannot read (TwsClient::historicalData decides what to do)
+inline TickByTickParse parseHistoricalDataFields(const char* body, const char* end, int serverVersion,
+                                                 BarTimeParser& times, HistoricalBarBatch& out,
+                                                 SizeFallback sizeFallback = nullptr) {
+    out.clear();
+    if (serverVersion < tick_by_tick::kServerVersionHistoryEnd) {
+        return TickByTickParse::Fallback;
+    }
+    tick_by_tick_detail::FieldReader reader{body, end, sizeFallback};
+    FieldIndex index;
+    reader.attach(index);
+    int items = 0;
+    if (!reader.integer(out.reqId) || !reader.integer(items) || items < 0) {
+        return TickByTickParse::Fallback;
+    }
+    // REASON: A bar takes at least 8 bytes (8 terminators) - a corrupt count cannot reserve past the frame
+    out.reserve(std::min(static_cast<std::size_t>(items), static_cast<std::size_t>(end - reader.ptr) / 8));
+    for (int i = 0; i < items; ++i) {
+        std::string_view timeText;
+        std::int64_t timeMs = 0;
+        double open = 0.0, high = 0.0, low = 0.0, close = 0.0, wap = 0.0;
+        std::int64_t volume = 0;
+        int volumeScale = 0;
+        int bars = 0;
+        if (!reader.text(timeText) || !times.parse(timeText, timeMs) || !reader.real(open) || !reader.real(high)
+            || !reader.real(low) || !reader.real(close) || !reader.size(volume, volumeScale) || !reader.real(wap)
+            || !reader.integer(bars)) {
+            out.clear();
+            return TickByTickParse::Fallback;
+        }
+        out.time.push_back(timeMs);
+        out.open.push_back(open);
+        out.high.push_back(high);
+        out.low.push_back(low);
+        out.close.push_back(close);
+        out.volume.push_back(rescaleUnits(volume, volumeScale, 0));
+        out.wap.push_back(wap);
+        out.count.push_back(bars);
+    }
+    return TickByTickParse::Parsed;
+}
+
+// Parse one frame (without the 4-byte length prefix), OtherMessage unless TICK_BY_TICK
+inline TickByTickParse parseTickByTick(const char* begin, const char* end, int serverVersion,
+                                       TickByTickFields& out, SizeFallback sizeFallback = nullptr) {
+    int msgId = 0;
+    const char* body = nullptr;
+    if (!readMessageId(begin, end, serverVersion, msgId, body) || msgId != tick_by_tick::kMsgId) {
+        return TickByTickParse::OtherMessage;
+    }
+    return parseTickByTickFields(body, end, out, sizeFallback);
+}
+
+} // namespace tws_bridge
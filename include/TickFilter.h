@@ -0,0 +1,111 @@
+// TickFilter.h - Bad-tick screen of the aggregation step: zero prices, crossed / locked quotes and prints
+// or mid jumps far outside the slot's rolling spread, caught before they reach the state and the encoders
+// SCOPE: Redis Worker thread (one TickBand per slot, in its StateEntry)
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace tws_bridge {
+
+// Why a tick failed the screen (index of WorkerCounters::badTicks)
+enum class BadTick : std::uint8_t {
+    None,
+    ZeroPrice,   // bid / ask / last <= 0 (TWS's -1 / 0 "no price" defaults)
+    Crossed,     // bid > ask
+    Locked,      // bid == ask (TickFilterConfig::rejectLocked)
+    Outlier      // Beyond outlierSpreads x the rolling spread from the last good mid
+};
+
+constexpr std::size_t kBadTickReasons = 5;
+
+inline const char* badTickName(BadTick reason) {
+    switch (reason) {
+    case BadTick::None: return "none";
+    case BadTick::ZeroPrice: return "zero_price";
+    case BadTick::Crossed: return "crossed";
+    case BadTick::Locked: return "locked";
+    case BadTick::Outlier: return "outlier";
+    }
+    return "unknown";
+}
+
+// worker.tick_filter
+struct TickFilterConfig {
+    bool enabled = false;
+    bool drop = true;                               // false: counted only, still applied (tuning thresholds)
+    bool rejectLocked = true;
+    double outlierSpreads = 0.0;                    // N x rolling spread, 0 = no outlier check
+    std::size_t spreadWindow = 32;                  // Quotes the rolling spread averages over (EWMA)
+    // Consecutive outliers that establish a new level (a gap at a reopen, not a bad print)
+    std::uint32_t outlierConfirm = 3;
+};
+
+// A slot's reference: last good mid + rolling spread
+// PERFORMANCE: Every check is computed, the reasons are packed into a mask and the first one is looked up -
+// one branch for the common good tick instead of a compare-and-jump per rule
+class TickBand {
+public:
+    // Quote: the reason it fails, or None (then it becomes the reference)
+    BadTick screenQuote(const TickFilterConfig& config, double bid, double ask) {
+        const double mid = (bid + ask) / 2.0;
+        const unsigned outlier = isOutlier(config, mid);
+        const unsigned mask = static_cast<unsigned>(!(bid > 0.0) | !(ask > 0.0))
+                            | static_cast<unsigned>(bid > ask) << 1
+                            | static_cast<unsigned>(bid == ask && config.rejectLocked) << 2
+                            | outlier << 3;
+        const BadTick reason = firstReason(mask);
+        if (reason == BadTick::Outlier && ++m_quoteRun < config.outlierConfirm) {
+            return reason;
+        }
+        if (reason != BadTick::None && reason != BadTick::Outlier) {
+            return reason;
+        }
+        // REASON: Good, or an outlier confirmed often enough to be the new level
+        m_quoteRun = 0;
+        const double alpha = 2.0 / (static_cast<double>(config.spreadWindow) + 1.0);
+        m_spread = m_mid > 0.0 ? m_spread + alpha * ((ask - bid) - m_spread) : ask - bid;
+        m_mid = mid;
+        return BadTick::None;
+    }
+
+    // Trade: the reason it fails, or None
+    // NOTE: Measured against the quotes' mid - prints never move the reference
+    BadTick screenTrade(const TickFilterConfig& config, double price) {
+        const unsigned mask = static_cast<unsigned>(!(price > 0.0)) | isOutlier(config, price) << 3;
+        const BadTick reason = firstReason(mask);
+        if (reason == BadTick::Outlier && ++m_tradeRun < config.outlierConfirm) {
+            return reason;
+        }
+        m_tradeRun = 0;
+        return reason == BadTick::Outlier ? BadTick::None : reason;
+    }
+
+    double mid() const { return m_mid; }
+    double spread() const { return m_spread; }
+
+private:
+    unsigned isOutlier(const TickFilterConfig& config, double price) const {
+        // NOTE: Off until a spread is known (first quotes, locked-only books)
+        return static_cast<unsigned>(config.outlierSpreads > 0.0 && m_spread > 0.0
+                                     && std::abs(price - m_mid) > config.outlierSpreads * m_spread);
+    }
+
+    static BadTick firstReason(unsigned mask) {
+        static constexpr BadTick kFirst[16] = {
+            BadTick::None, BadTick::ZeroPrice, BadTick::Crossed, BadTick::ZeroPrice,
+            BadTick::Locked, BadTick::ZeroPrice, BadTick::Crossed, BadTick::ZeroPrice,
+            BadTick::Outlier, BadTick::ZeroPrice, BadTick::Crossed, BadTick::ZeroPrice,
+            BadTick::Locked, BadTick::ZeroPrice, BadTick::Crossed, BadTick::ZeroPrice};
+        return kFirst[mask & 15u];
+    }
+
+    double m_mid = 0.0;
+    double m_spread = 0.0;
+    std::uint32_t m_quoteRun = 0;                   // Consecutive outlier quotes
+    std::uint32_t m_tradeRun = 0;                   // Consecutive outlier prints
+};
+
+} // namespace tws_bridge
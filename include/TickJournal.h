@@ -0,0 +1,395 @@
+// TickJournal.h - Memory-mapped binary capture of every TickUpdate the bridge receives (audit / replay)
+// SCOPE: append() on the message thread (single writer); own thread msyncs, pre-opens and retires segments
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "JournalIndex.h"
+#include "LatencyHistogram.h"
+#include "MarketData.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace tws_bridge {
+
+// ========== On-Disk Format (native byte order) ==========
+// {directory}/{session}-{index:06}.tjl, session = UTC start "YYYYMMDDTHHMMSSmmmZ" (one per start())
+// Segment: JournalSegmentHeader, then 8-byte aligned records up to a zero header or the end of file
+// NOTE: Closed segments are truncated to their records; a crashed session leaves a zero-filled tail
+// Compressed segments (version 2): JournalSegmentHeader, then 8-byte aligned JournalBlockHeader + LZ4 block
+// of delta / varint encoded records (JournalCodec.h) up to a zero header or the end of file
+// Closed segments get a {session}-{index:06}.tjx seek index beside them (JournalIndex.h)
+
+inline constexpr char kJournalMagic[8] = {'T', 'W', 'S', 'J', 'R', 'N', 'L', '1'};
+inline constexpr std::uint32_t kJournalVersion = 3;            // Raw records, AllLast with exchange / conditions
+inline constexpr std::uint32_t kJournalCompressedVersion = 2;
+inline constexpr std::uint32_t kJournalLegacyVersion = 1;      // Raw records, AllLast without them (read only)
+inline constexpr const char* kJournalExtension = ".tjl";
+
+struct JournalSegmentHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t segmentIndex;       // 0-based, per session
+    std::int64_t sessionStartNs;      // Wall clock (ns since epoch)
+    std::int64_t createdNs;
+    std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(JournalSegmentHeader) == 64, "Segment header is one cache line");
+
+enum class JournalRecordKind : std::uint16_t {
+    End = 0,        // Unwritten (zero-filled) space
+    Tick = 1,       // TickUpdate header + active payload arm, TickStamps dropped
+    Symbol = 2      // uint16 slot + symbol bytes, precedes a slot's first tick in every segment
+};
+
+struct JournalRecordHeader {
+    JournalRecordKind kind;
+    std::uint16_t length;             // Payload bytes (record = header + length rounded up to 8)
+    std::uint32_t reserved;
+    std::int64_t receiveNs;           // Wall clock at capture (ns since epoch)
+};
+
+static_assert(sizeof(JournalRecordHeader) == 16, "Record header layout is part of the file format");
+
+inline constexpr std::uint32_t kJournalBlockMagic = 0x4B4C424A;  // "JBLK" little-endian
+
+// One restart point of a compressed segment - decodes without the blocks before it
+struct JournalBlockHeader {
+    std::uint32_t magic;              // kJournalBlockMagic (a zero-filled tail is the end)
+    std::uint32_t sealedBytes;        // LZ4 block that follows (u32 size + data), padded to 8 on disk
+    std::uint32_t encodedBytes;       // Records before LZ4
+    std::uint32_t records;            // Tick + Symbol records
+    std::int64_t firstReceiveNs;
+    std::int64_t lastReceiveNs;
+};
+
+static_assert(sizeof(JournalBlockHeader) == 32, "Block header layout is part of the file format");
+
+namespace journal_detail {
+
+inline constexpr std::size_t kTickHeaderBytes = 16;  // TickUpdate slot/type/flags/aux/timestamp
+inline constexpr std::size_t kMaxSymbolBytes = 64;   // Longer symbols are truncated in the journal
+// Version 1 AllLast: price + size only - read back with exchange and conditions zero
+inline constexpr std::size_t kLegacyAllLastBytes = kTickHeaderBytes + 16;
+
+// REASON: Only the active arm is stored - a BidAsk record is 56 bytes instead of 16 + 64
+inline std::size_t tickPayloadBytes(TickUpdateType type) {
+    switch (type) {
+    case TickUpdateType::BidAsk:
+        return kTickHeaderBytes + offsetof(BidAskPayload, stamps);
+    case TickUpdateType::AllLast:
+        return kTickHeaderBytes + offsetof(AllLastPayload, stamps);
+    case TickUpdateType::Depth:
+        return kTickHeaderBytes + offsetof(DepthPayload, stamps);
+    case TickUpdateType::MidPoint:
+        return kTickHeaderBytes + offsetof(MidPointPayload, stamps);
+    case TickUpdateType::Bar:
+        return kTickHeaderBytes + sizeof(BarPayload);
+    case TickUpdateType::Greeks:
+        return kTickHeaderBytes + sizeof(GreeksPayload);
+    default:
+        return kTickHeaderBytes;
+    }
+}
+
+inline constexpr std::size_t recordBytes(std::size_t payload) {
+    return (sizeof(JournalRecordHeader) + payload + 7) & ~std::size_t{7};
+}
+
+inline constexpr std::size_t kMaxRecordBytes = recordBytes(kTickHeaderBytes + sizeof(BarPayload));
+inline constexpr std::size_t kMaxSymbolRecordBytes = recordBytes(sizeof(std::uint16_t) + kMaxSymbolBytes);
+
+inline std::int64_t wallClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace journal_detail
+
+enum class JournalFormat : std::uint8_t {
+    Raw,            // Fixed-layout records, one memcpy each (56 bytes per BidAsk)
+    Compressed      // Delta + varint records sealed into LZ4 blocks (JournalCodec.h), several times smaller
+};
+
+struct JournalConfig {
+    std::string directory = "journal";
+    JournalFormat format = JournalFormat::Raw;
+    std::size_t blockBytes = std::size_t{64} << 10;     // Compressed: encoded bytes per block (4 KiB - 1 MiB)
+    bool index = true;                                  // Time / symbol index (.tjx) beside each closed segment
+    std::size_t segmentBytes = std::size_t{256} << 20;  // Preallocated per file (~4.7M BidAsk records)
+    std::chrono::milliseconds syncInterval{1000};       // msync period of the active segment
+    std::size_t prefaultBytes = std::size_t{16} << 20;  // Pages write-faulted ahead of the cursor per sync
+};
+
+// Lifetime counters (readable from any thread)
+struct JournalCounters {
+    std::atomic<std::uint64_t> records{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> segments{0};           // Segment files opened
+    std::atomic<std::uint64_t> blocks{0};             // Compressed blocks sealed
+    std::atomic<std::uint64_t> stalls{0};             // Rotation found no pre-opened segment (waited / opened inline)
+    std::atomic<std::uint64_t> dropped{0};            // No segment could be opened - record lost
+    std::atomic<std::uint64_t> syncErrors{0};
+};
+
+class JournalBlockEncoder;
+class JournalBlockDecoder;
+
+// Append-only capture to preallocated mmap'd segments
+// CRITICAL PATH: append() = at most one clock read + one memcpy into the mapping + a release store; the
+// sync thread keeps the next segment opened, fallocated, mapped and pre-faulted, so rotation is a pointer swap
+// Compressed: append() encodes into the open block; a full block (or one older than syncInterval) is sealed
+// with LZ4 into the mapping on the message thread
+// PITFALL: A crash loses the open block - at most blockBytes of records or syncInterval of quiet time
+class TickJournal {
+public:
+    explicit TickJournal(const InstrumentRegistry& registry, JournalConfig config = {});
+    ~TickJournal();
+
+    TickJournal(const TickJournal&) = delete;
+    TickJournal& operator=(const TickJournal&) = delete;
+
+    // Starts a session: opens the first segment and the sync thread, false on I/O error (logged)
+    bool start();
+    // Syncs and closes the session (truncates the last segment) - no append() may run concurrently
+    void stop();
+
+    // Message thread only (same thread as every TwsClient callback)
+    void append(const TickUpdate& update) {
+        using namespace journal_detail;
+        // PERFORMANCE: A tick reuses its socket-read stamp, or its callback-entry clock read (steady → wall
+        // offset taken when the segment was opened), so the journal adds no clock read of its own
+        const TickStamps* stamps = update.stamps();
+        const std::int64_t receiveNs = stamps && stamps->receiveNs != 0 ? stamps->receiveNs
+                                     : stamps && stamps->ingestNs != 0 ? stamps->ingestNs + m_wallOffsetNs
+                                                                        : wallClockNs();
+        if (m_encoder) {
+            appendEncoded(update, receiveNs);
+            return;
+        }
+        const std::size_t payload = tickPayloadBytes(update.type);
+        const std::size_t size = recordBytes(payload);
+        // REASON: Room for the slot's Symbol record too - a tick never starts a segment without it
+        if (static_cast<std::size_t>(m_limit - m_cursor) < size + kMaxSymbolRecordBytes && !rotate()) {
+            bump(m_counters.dropped);
+            return;
+        }
+        if (m_index) {
+            m_index->addAt(static_cast<std::size_t>(m_cursor - m_current->base), update.slot, receiveNs);
+        }
+        if (update.slot < m_announced.size() && m_announced[update.slot] != m_segmentSerial) {
+            appendSymbol(update.slot, receiveNs);
+        }
+        JournalRecordHeader header{JournalRecordKind::Tick, static_cast<std::uint16_t>(payload), 0, receiveNs};
+        std::memcpy(m_cursor, &header, sizeof(header));
+        std::memcpy(m_cursor + sizeof(header), &update, payload);
+        m_cursor += size;
+        // PERFORMANCE: Single writer - plain load + store, no locked RMW
+        m_current->used.store(static_cast<std::size_t>(m_cursor - m_current->base), std::memory_order_release);
+        bump(m_counters.records);
+        m_counters.bytes.store(m_counters.bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+    }
+
+    bool running() const { return m_running.load(std::memory_order_relaxed); }
+    const std::string& session() const { return m_session; }
+    const JournalCounters& counters() const { return m_counters; }
+
+private:
+    struct Segment {
+        int fd = -1;
+        char* base = nullptr;
+        std::size_t capacity = 0;
+        std::uint32_t index = 0;
+        std::string path;
+        std::atomic<std::size_t> used{0};             // Bytes written (header included), release-published
+        std::size_t synced = 0;                       // Sync thread only
+        std::size_t prefaulted = 0;                   // Sync thread only (page-aligned)
+        std::int64_t wallOffsetNs = 0;                // system_clock - steady_clock when opened
+        JournalSegmentIndex seekIndex;                // Handed over at rotation, written beside it at retire
+    };
+
+    static void bump(std::atomic<std::uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void appendSymbol(SlotId slot, std::int64_t receiveNs);
+    void appendEncoded(const TickUpdate& update, std::int64_t receiveNs);
+    void sealBlock();
+    bool rotate();
+    void activate(std::unique_ptr<Segment> segment);
+    std::unique_ptr<Segment> openSegment(std::uint32_t index);
+    void syncSegment(Segment& segment);
+    void prefault(Segment& segment);
+    void retire(std::unique_ptr<Segment> segment);
+    void run();
+
+    const InstrumentRegistry& m_registry;
+    JournalConfig m_config;
+    JournalCounters m_counters;
+    std::string m_session;
+    std::int64_t m_sessionStartNs = 0;
+
+    // ========== Message Thread ==========
+    char* m_cursor = nullptr;
+    char* m_limit = nullptr;
+    std::uint32_t m_segmentSerial = 0;                // index + 1 of the active segment
+    std::int64_t m_wallOffsetNs = 0;                  // Active segment's steady → wall offset
+    bool m_inlineOpenFailed = false;                  // BACKPRESSURE: Drop until the sync thread has a spare
+    std::vector<std::uint32_t> m_announced;           // By slot: serial of the segment holding its Symbol record
+    std::unique_ptr<JournalBlockEncoder> m_encoder;   // JournalFormat::Compressed only
+    std::unique_ptr<JournalIndexBuilder> m_index;     // JournalConfig::index only
+
+    // ========== Shared With The Sync Thread (m_mutex) ==========
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    Segment* m_current = nullptr;                     // REASON: Owned via m_active - only the sync thread frees segments
+    std::unique_ptr<Segment> m_active;
+    std::unique_ptr<Segment> m_spare;                 // Next segment, opened ahead of rotation
+    bool m_spareOpening = false;                      // Sync thread is opening m_spare (index already taken)
+    std::condition_variable m_spareReady;
+    std::vector<std::unique_ptr<Segment>> m_retired;  // Full segments waiting for the final msync + truncate
+    std::uint32_t m_nextIndex = 0;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+// One record read back from a segment
+struct JournalEntry {
+    JournalRecordKind kind = JournalRecordKind::End;
+    std::int64_t receiveNs = 0;
+    TickUpdate update;                                // Tick (stamps zero)
+    SlotId slot = kInvalidSlot;                       // Symbol: slot the session used for it
+    std::string symbol;                               // Symbol
+};
+
+// Appends entry as a kJournalVersion record (what TickJournal writes for a raw segment)
+inline void appendJournalRecord(std::string& out, const JournalEntry& entry) {
+    using namespace journal_detail;
+    const bool tick = entry.kind == JournalRecordKind::Tick;
+    const std::size_t symbolBytes = std::min(entry.symbol.size(), kMaxSymbolBytes);
+    const std::size_t payload = tick ? tickPayloadBytes(entry.update.type) : sizeof(SlotId) + symbolBytes;
+    const JournalRecordHeader header{entry.kind, static_cast<std::uint16_t>(payload), 0, entry.receiveNs};
+    const std::size_t start = out.size();
+    out.resize(start + recordBytes(payload), '\0');
+    char* record = &out[start];
+    std::memcpy(record, &header, sizeof(header));
+    if (tick) {
+        std::memcpy(record + sizeof(header), &entry.update, payload);
+    } else {
+        std::memcpy(record + sizeof(header), &entry.slot, sizeof(SlotId));
+        std::memcpy(record + sizeof(header) + sizeof(SlotId), entry.symbol.data(), symbolBytes);
+    }
+}
+
+// Sequential reader of one segment file (read-only mapping)
+class TickJournalReader {
+public:
+    TickJournalReader();
+    ~TickJournalReader();
+
+    TickJournalReader(const TickJournalReader&) = delete;
+    TickJournalReader& operator=(const TickJournalReader&) = delete;
+
+    // false if the file can't be mapped or has no valid JournalSegmentHeader
+    bool open(const std::string& path);
+    void close();
+
+    // Next record, false at the end of the segment (or at a truncated / corrupt record)
+    // NOTE: Both formats - compressed blocks are decoded here, one block buffered at a time
+    bool next(JournalEntry& entry);
+
+    // Restricts next() to [begin, end) - one JournalIndex::select() range; false if outside the records
+    bool seek(std::size_t begin, std::size_t end);
+
+    const JournalSegmentHeader& header() const { return m_header; }
+    std::size_t size() const { return m_size; }
+    bool compressed() const { return m_header.version == kJournalCompressedVersion; }
+    // Raw records in the version 1 layout - decoded record by record, never copied verbatim
+    bool legacy() const { return m_header.version == kJournalLegacyVersion; }
+
+    // PERFORMANCE: Read-ahead window - one huge page, hinted (MADV_WILLNEED) half a window early
+    static constexpr std::size_t kPrefetchBytes = std::size_t{2} << 20;
+
+    // Segment files in `directory`, oldest first (one session when `session` is not empty)
+    static std::vector<std::string> segments(const std::string& directory, const std::string& session = "");
+
+private:
+    void prefetch();
+    bool nextBlock();
+
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_offset = 0;
+    std::size_t m_end = 0;                            // next() stops here (m_size unless seek())
+    std::size_t m_prefetched = 0;                     // Hinted up to here (page aligned)
+    JournalSegmentHeader m_header{};
+    std::unique_ptr<JournalBlockDecoder> m_block;     // Compressed segments only
+};
+
+// Record selection of replay / export: symbols (empty = every one) and an inclusive receive-time window
+struct JournalFilter {
+    std::vector<std::string> symbols;
+    std::int64_t fromNs = std::numeric_limits<std::int64_t>::min();
+    std::int64_t toNs = std::numeric_limits<std::int64_t>::max();
+
+    bool all() const {
+        return symbols.empty() && fromNs == std::numeric_limits<std::int64_t>::min()
+            && toNs == std::numeric_limits<std::int64_t>::max();
+    }
+};
+
+// "2026-10-15T14:30:00Z", "2026-10-15T14:30:00.250Z" (UTC) or seconds since the epoch → ns, false if malformed
+bool parseJournalTime(const std::string& text, std::int64_t& ns);
+
+// Replay pacing: "1x", "10x", "2.5" → 1, 10, 2.5; "max" → 0; false if not a positive speed
+bool parseReplaySpeed(const std::string& text, double& speed);
+
+// Filtered read of one segment at a time: the Symbol entries of the wanted symbols, then their ticks inside
+// the window, in journal order
+// PERFORMANCE: With a current .tjx, only the blocks holding a wanted slot in the window are read (seek per
+// merged range) - one symbol out of hundreds or a 10-minute window touches a few MiB of a 256 MiB segment;
+// without one (crashed session, index disabled) every record is read and filtered here
+class TickJournalScan {
+public:
+    explicit TickJournalScan(JournalFilter filter = {});
+
+    // false if the file can't be mapped or has no valid JournalSegmentHeader
+    bool open(const std::string& path);
+    bool next(JournalEntry& entry);
+
+    const JournalSegmentHeader& header() const { return m_reader.header(); }
+    bool indexed() const { return m_indexed; }
+    std::uint64_t skippedBytes() const { return m_skippedBytes; }  // Lifetime: never read thanks to the index
+
+private:
+    bool wantedSymbol(const std::string& symbol) const {
+        return m_symbols.empty() || m_symbols.count(symbol) != 0;
+    }
+    bool wantedSlot(SlotId slot) const { return m_symbols.empty() || (m_wanted[slot / 64] >> (slot % 64) & 1) != 0; }
+
+    TickJournalReader m_reader;
+    JournalFilter m_filter;
+    std::unordered_set<std::string> m_symbols;
+    std::vector<std::uint64_t> m_wanted;              // By journal slot of the open segment
+    JournalIndex m_index;
+    bool m_indexed = false;
+    std::vector<std::pair<std::size_t, std::size_t>> m_ranges;
+    std::size_t m_range = 0;                          // Next range to seek to
+    bool m_inRange = false;
+    std::size_t m_announce = 0;                       // Index symbols handed out so far
+    std::uint64_t m_skippedBytes = 0;
+};
+
+} // namespace tws_bridge
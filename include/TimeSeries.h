@@ -0,0 +1,215 @@
+// TimeSeries.h - RedisTimeSeries sink: TWS:TS:{SYMBOL}:{bid|ask|last|volume}, one TS.MADD per drain batch
+// SCOPE: Redis Worker thread (TimeSeriesTrack per slot, TimeSeriesBatch), catalog thread (TimeSeriesCatalog:
+// series creation, retention and compaction rules)
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "MarketData.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+// One downsampled copy of every series: {series}:{bucket label}, prices keep the bucket's last value,
+// volume its sum
+struct TimeSeriesCompaction {
+    std::chrono::milliseconds bucket{60000};
+    std::chrono::milliseconds retention{0};         // 0 = keep all
+};
+
+// worker.time_series: chart history in the RedisTimeSeries module
+// PITFALL: Needs the RedisTimeSeries module, standalone Redis only - TS.MADD spans every symbol's key (CROSSSLOT)
+struct TimeSeriesConfig {
+    bool enabled = false;
+    std::chrono::milliseconds retention{86400000};  // Raw samples (24h), 0 = keep all
+    std::vector<TimeSeriesCompaction> compactions;
+    std::chrono::milliseconds scanInterval{500};    // Catalog: new symbols get their series within this
+    std::chrono::milliseconds socketTimeout{1000};  // Catalog connection
+    std::chrono::milliseconds reconnectDelay{1000}; // Catalog back-off after a Redis error
+};
+
+// Series of a symbol (key suffix after TWS:TS:{SYMBOL}:)
+enum class SeriesField : std::uint8_t {
+    Bid,
+    Ask,
+    Last,
+    Volume,
+    Count
+};
+
+inline constexpr std::size_t kSeriesFieldCount = static_cast<std::size_t>(SeriesField::Count);
+
+inline const char* seriesFieldName(SeriesField field) {
+    static constexpr const char* kNames[kSeriesFieldCount] = {"bid", "ask", "last", "volume"};
+    return kNames[static_cast<std::size_t>(field)];
+}
+
+// REASON: TWS tick times are whole seconds - several prices share a timestamp (the last one stands), several
+// trades share one too (their sizes add up)
+inline const char* seriesDuplicatePolicy(SeriesField field) {
+    return field == SeriesField::Volume ? "SUM" : "LAST";
+}
+
+inline const char* seriesAggregation(SeriesField field) {
+    return field == SeriesField::Volume ? "sum" : "last";
+}
+
+// Compaction key suffix: 500ms, 30s, 1m, 1h, 1d (largest whole unit)
+inline std::string bucketLabel(std::chrono::milliseconds bucket) {
+    static constexpr struct { std::int64_t ms; const char* unit; } kUnits[] = {
+        {86400000, "d"}, {3600000, "h"}, {60000, "m"}, {1000, "s"}};
+    const std::int64_t ms = bucket.count();
+    for (const auto& unit : kUnits) {
+        if (ms > 0 && ms % unit.ms == 0) {
+            return std::to_string(ms / unit.ms) + unit.unit;
+        }
+    }
+    return std::to_string(ms) + "ms";
+}
+
+// TS.MADD arguments of one drain batch: "key\ntimestamp\nvalue\n..." (RedisCommand::TimeSeriesAdd payload)
+// PERFORMANCE: One command for every sample of the batch - the module ingests them in one call instead of a
+// TS.ADD round through the command table per tick
+class TimeSeriesBatch {
+public:
+    // prefix: InstrumentChannels::series ("TWS:TS:{SYMBOL}:")
+    void add(std::string_view prefix, SeriesField field, std::int64_t timestampMs, double value) {
+        if (!m_payload.empty()) {
+            m_payload += '\n';
+        }
+        m_payload.append(prefix.data(), prefix.size());
+        m_payload += seriesFieldName(field);
+        m_payload += '\n';
+        appendNumber(timestampMs);
+        m_payload += '\n';
+        appendNumber(value);
+        ++m_samples;
+    }
+
+    bool empty() const { return m_samples == 0; }
+    std::size_t samples() const { return m_samples; }
+    const std::string& payload() const { return m_payload; }
+
+    void clear() {
+        m_payload.clear();  // NOTE: Keeps its capacity
+        m_samples = 0;
+    }
+
+private:
+    // Shortest round-trip digits (171.55, not 171.55000000000001)
+    template <typename Number>
+    void appendNumber(Number value) {
+        char text[32];
+        const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+        m_payload.append(text, static_cast<std::size_t>(result.ptr - text));
+    }
+
+    std::string m_payload;
+    std::size_t m_samples = 0;
+};
+
+// Per-slot memory of what the series already hold
+// NOTE: A price is sampled when it moves, at the TWS time of its tick; volume is the sum of the trades since
+// the last sample (onTrade) - a conflated snapshot still accounts for every trade it absorbed
+class TimeSeriesTrack {
+public:
+    void onTrade(int size) {
+        if (size > 0) {
+            m_volume += size;
+        }
+    }
+
+    // Appends this slot's new samples, returns how many
+    std::size_t collect(const InstrumentState& state, std::string_view prefix, TimeSeriesBatch& batch) {
+        std::size_t samples = 0;
+        if (state.hasQuote && state.quoteTimestamp != 0) {
+            if (state.bidPrice != m_bid) {
+                batch.add(prefix, SeriesField::Bid, state.quoteTimestamp, state.bidPrice);
+                m_bid = state.bidPrice;
+                ++samples;
+            }
+            if (state.askPrice != m_ask) {
+                batch.add(prefix, SeriesField::Ask, state.quoteTimestamp, state.askPrice);
+                m_ask = state.askPrice;
+                ++samples;
+            }
+        }
+        if (state.hasTrade && state.tradeTimestamp != 0) {
+            if (state.lastPrice != m_last || state.tradeTimestamp != m_tradeTimestamp) {
+                batch.add(prefix, SeriesField::Last, state.tradeTimestamp, state.lastPrice);
+                m_last = state.lastPrice;
+                m_tradeTimestamp = state.tradeTimestamp;
+                ++samples;
+            }
+            if (m_volume > 0) {
+                batch.add(prefix, SeriesField::Volume, state.tradeTimestamp, static_cast<double>(m_volume));
+                m_volume = 0;
+                ++samples;
+            }
+        }
+        return samples;
+    }
+
+    // Series not created yet - nothing to add to, the volume of this wait is not carried into them
+    void skip() { m_volume = 0; }
+
+private:
+    double m_bid = 0.0;
+    double m_ask = 0.0;
+    double m_last = 0.0;
+    long m_tradeTimestamp = 0;
+    std::int64_t m_volume = 0;
+};
+
+// Lifetime counters (written by the catalog thread, readable from any thread)
+struct TimeSeriesCatalogCounters {
+    std::atomic<std::uint64_t> created{0};          // Slots whose series (and rules) are in place
+    std::atomic<std::uint64_t> errors{0};
+};
+
+// Creates every registered symbol's series on its own connection, then flags the slot ready
+// REASON: TS.MADD on a missing key creates it with the server defaults (no retention, BLOCK duplicates, no
+// rules) - and TS.CREATE / TS.CREATERULE answer errors for existing keys / rules, which would fail a worker's
+// whole pipelined batch; the worker adds a slot's samples only once its flag is set
+// ARCHITECTURE: Same shape as SubscriberTracker - the worker reads one byte per slot, never waits
+class TimeSeriesCatalog {
+public:
+    TimeSeriesCatalog(const std::string& uri, const InstrumentRegistry& registry, TimeSeriesConfig config);
+    ~TimeSeriesCatalog();
+
+    TimeSeriesCatalog(const TimeSeriesCatalog&) = delete;
+    TimeSeriesCatalog& operator=(const TimeSeriesCatalog&) = delete;
+
+    void start();
+    void stop();
+
+    // Any thread (worker hot path)
+    bool ready(SlotId slot) const {
+        return slot < m_capacity && m_ready[slot].load(std::memory_order_acquire) != 0;
+    }
+
+    const TimeSeriesCatalogCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+
+    std::string m_uri;
+    const InstrumentRegistry& m_registry;
+    TimeSeriesConfig m_config;
+    TimeSeriesCatalogCounters m_counters;
+    std::size_t m_capacity;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> m_ready;  // By slot
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
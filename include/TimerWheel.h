@@ -0,0 +1,266 @@
+// TimerWheel.h - Hierarchical timer wheel for deadline-driven work (tiers, bar sweeps, stats reports)
+// SCOPE: Owned and driven by one thread (Redis Worker loop) - no locking, callbacks run inside advance()
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace tws_bridge {
+
+// Returned by arm(), invalid once the timer fired or was cancelled (generation check)
+struct TimerHandle {
+    std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+};
+
+/**
+ * 4 levels x 64 slots of `resolution` ticks (1 ms: level 0 spans 64 ms, level 3 about 4.6 h; later
+ * deadlines park in the last level and are re-placed when it cascades).
+ *
+ * [ARCHITECTURE] Timers carry a caller-defined tag instead of a callback - advance() hands the tag of
+ * each expired timer to one visitor, so arming allocates nothing once the node pool has grown.
+ *
+ * PERFORMANCE: arm / cancel O(1) (intrusive lists); advance() jumps straight to the next occupied
+ * slot via per-level occupancy bitmaps, so an idle gap costs O(levels), not O(ticks)
+ * NOTE: Never fires early - deadlines round up to the next tick
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr unsigned kLevels = 4;
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr unsigned kSlots = 1u << kSlotBits;
+
+    explicit TimerWheel(Clock::time_point origin = Clock::now(),
+                        std::chrono::microseconds resolution = std::chrono::milliseconds(1))
+        : m_origin(origin)
+        , m_resolution(resolution.count() > 0 ? resolution : std::chrono::microseconds(1)) {
+        m_heads.fill(kNil);
+    }
+
+    TimerHandle arm(Clock::time_point deadline, std::uint32_t tag) {
+        std::uint32_t index = m_free;
+        if (index == kNil) {
+            index = static_cast<std::uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        } else {
+            m_free = m_nodes[index].next;
+        }
+        Node& node = m_nodes[index];
+        node.tag = tag;
+        // REASON: A deadline already reached fires on the next advance(), never inside arm()
+        node.expires = std::max(tickAtOrAfter(deadline), m_now + 1);
+        place(index);
+        ++m_count;
+        return TimerHandle{index, node.generation};
+    }
+
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerHandle handle) {
+        if (!armed(handle)) {
+            return false;
+        }
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+    }
+
+    bool armed(TimerHandle handle) const {
+        return handle.index < m_nodes.size() && m_nodes[handle.index].generation == handle.generation
+            && m_nodes[handle.index].bucket != kNoBucket;
+    }
+
+    // Fires every timer due at now in deadline order, same-tick timers in arming order (onExpired(tag)); returns the count
+    // NOTE: onExpired may arm and cancel timers, including ones due in this same call
+    template <typename OnExpired>
+    std::size_t advance(Clock::time_point now, OnExpired&& onExpired) {
+        const std::uint64_t target = tickAtOrBefore(now);
+        std::size_t fired = 0;
+        while (m_now < target) {
+            const std::uint64_t next = nextTick();
+            if (next > target) {
+                m_now = target;
+                break;
+            }
+            m_now = next;
+            cascade();
+            // REASON: Slot moved to the expiring list first - callbacks may re-arm into this slot
+            // NOTE: Buckets push at the head, the move reverses them back into arming order
+            moveBucket(bucketOf(0, m_now), kExpiring);
+            while (m_heads[kExpiring] != kNil) {
+                const std::uint32_t index = m_heads[kExpiring];
+                const std::uint32_t tag = m_nodes[index].tag;
+                unlink(index);
+                release(index);
+                ++fired;
+                onExpired(tag);
+            }
+        }
+        return fired;
+    }
+
+    // Earliest time a timer can fire (or a cascade must run), Clock::time_point::max() if none is armed
+    // NOTE: Lower bound - waking then and calling advance() is always correct
+    Clock::time_point nextDeadline() const {
+        const std::uint64_t next = nextTick();
+        if (next == kNever) {
+            return Clock::time_point::max();
+        }
+        return m_origin + std::chrono::duration_cast<Clock::duration>(m_resolution * static_cast<std::int64_t>(next));
+    }
+
+    std::size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+private:
+    static constexpr std::uint32_t kNil = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint16_t kNoBucket = std::numeric_limits<std::uint16_t>::max();
+    static constexpr std::uint16_t kExpiring = kLevels * kSlots;
+    static constexpr std::uint64_t kNever = std::numeric_limits<std::uint64_t>::max();
+    static constexpr std::uint64_t kSpan = std::uint64_t{1} << (kSlotBits * kLevels);
+
+    struct Node {
+        std::uint64_t expires = 0;   // Tick
+        std::uint32_t tag = 0;
+        std::uint32_t generation = 0;
+        std::uint32_t prev = kNil;
+        std::uint32_t next = kNil;   // Free list link while released
+        std::uint16_t bucket = kNoBucket;
+    };
+
+    std::uint64_t tickAtOrAfter(Clock::time_point at) const {
+        if (at <= m_origin) {
+            return 0;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(at - m_origin);
+        const auto whole = elapsed / m_resolution;
+        return static_cast<std::uint64_t>(whole) + (elapsed % m_resolution != elapsed.zero() ? 1 : 0);
+    }
+
+    std::uint64_t tickAtOrBefore(Clock::time_point at) const {
+        if (at <= m_origin) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(at - m_origin) / m_resolution);
+    }
+
+    static std::uint16_t bucketOf(unsigned level, std::uint64_t tick) {
+        return static_cast<std::uint16_t>(level * kSlots + ((tick >> (kSlotBits * level)) & (kSlots - 1)));
+    }
+
+    // Level by distance: level 0 holds the next 63 ticks, level L the ticks that share its slot's block
+    void place(std::uint32_t index) {
+        Node& node = m_nodes[index];
+        const std::uint64_t delta = node.expires - m_now;
+        unsigned level = 0;
+        while (level + 1 < kLevels && delta >= (std::uint64_t{1} << (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        // PITFALL: Beyond the wheel's span - parked in the slot that cascades last, re-placed from there
+        const std::uint64_t slotTick = delta < kSpan ? node.expires : m_now + kSpan - 1;
+        link(index, bucketOf(level, slotTick));
+    }
+
+    void link(std::uint32_t index, std::uint16_t bucket) {
+        Node& node = m_nodes[index];
+        node.bucket = bucket;
+        node.prev = kNil;
+        node.next = m_heads[bucket];
+        if (node.next != kNil) {
+            m_nodes[node.next].prev = index;
+        }
+        m_heads[bucket] = index;
+        if (bucket != kExpiring) {
+            m_occupied[bucket / kSlots] |= std::uint64_t{1} << (bucket % kSlots);
+        }
+    }
+
+    void unlink(std::uint32_t index) {
+        Node& node = m_nodes[index];
+        if (node.prev != kNil) {
+            m_nodes[node.prev].next = node.next;
+        } else {
+            m_heads[node.bucket] = node.next;
+        }
+        if (node.next != kNil) {
+            m_nodes[node.next].prev = node.prev;
+        }
+        if (m_heads[node.bucket] == kNil && node.bucket != kExpiring) {
+            m_occupied[node.bucket / kSlots] &= ~(std::uint64_t{1} << (node.bucket % kSlots));
+        }
+        node.bucket = kNoBucket;
+    }
+
+    void release(std::uint32_t index) {
+        Node& node = m_nodes[index];
+        ++node.generation;
+        node.next = m_free;
+        m_free = index;
+        --m_count;
+    }
+
+    void moveBucket(std::uint16_t from, std::uint16_t to) {
+        while (m_heads[from] != kNil) {
+            const std::uint32_t index = m_heads[from];
+            unlink(index);
+            link(index, to);
+        }
+    }
+
+    // At a block boundary of level L, that level's current slot is re-placed into the levels below
+    // REASON: Lower levels first - a higher level only reaches its boundary when the lower one wraps
+    void cascade() {
+        for (unsigned level = 1; level < kLevels; ++level) {
+            if ((m_now & ((std::uint64_t{1} << (kSlotBits * level)) - 1)) != 0) {
+                break;
+            }
+            const std::uint16_t bucket = bucketOf(level, m_now);
+            while (m_heads[bucket] != kNil) {
+                const std::uint32_t index = m_heads[bucket];
+                unlink(index);
+                place(index);
+            }
+        }
+    }
+
+    // Next tick with work: a level-0 expiry or a level-L cascade of an occupied slot
+    std::uint64_t nextTick() const {
+        std::uint64_t next = kNever;
+        for (unsigned level = 0; level < kLevels; ++level) {
+            const std::uint64_t occupied = m_occupied[level];
+            if (occupied == 0) {
+                continue;
+            }
+            const unsigned shift = kSlotBits * level;
+            const std::uint64_t block = m_now >> shift;
+            // REASON: Slot distance 1..64 from the current one (level 0's current slot already ran)
+            const unsigned from = static_cast<unsigned>((block + 1) & (kSlots - 1));
+            const std::uint64_t rotated = (occupied >> from) | (from == 0 ? 0 : occupied << (kSlots - from));
+            const std::uint64_t distance = static_cast<std::uint64_t>(countTrailingZeros(rotated)) + 1;
+            next = std::min(next, (block + distance) << shift);
+        }
+        return next;
+    }
+
+    static unsigned countTrailingZeros(std::uint64_t value) {
+        return static_cast<unsigned>(__builtin_ctzll(value));
+    }
+
+    Clock::time_point m_origin;
+    std::chrono::microseconds m_resolution;
+    std::uint64_t m_now = 0;                                  // Last processed tick
+    std::vector<Node> m_nodes;
+    std::uint32_t m_free = kNil;
+    std::size_t m_count = 0;
+    std::array<std::uint32_t, kLevels * kSlots + 1> m_heads{};  // + expiring list
+    std::array<std::uint64_t, kLevels> m_occupied{};
+};
+
+} // namespace tws_bridge
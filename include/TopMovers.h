@@ -0,0 +1,275 @@
+// TopMovers.h - Top gainers / losers / volume leaders kept in order as trades arrive, merged across workers
+// and published once per interval on TWS:MOVERS
+// SCOPE: MoverBoard - Redis Worker thread (one per worker, the slots it owns); MoversExchange - workers post,
+// the publisher merges; MoversPublisher - own thread + own Redis connection
+
+#pragma once
+
+#include "DerivedMetrics.h"
+#include "InstrumentRegistry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// movers: rankings dashboards would otherwise compute by polling every symbol
+struct MoversConfig {
+    bool enabled = false;
+    std::size_t top = 10;                           // Rows per ranking
+    std::chrono::milliseconds interval{1000};
+    std::string channel = "TWS:MOVERS";             // PUBLISH per interval + SET of the latest (late joiners GET it)
+    std::chrono::minutes sessionReset{9 * 60};      // Follows worker.derived_metrics.session_reset
+    std::chrono::milliseconds socketTimeout{200};
+    std::chrono::milliseconds reconnectDelay{1000}; // Back-off after a Redis error
+};
+
+struct MoverRow {
+    SlotId slot = kInvalidSlot;
+    double last = 0.0;
+    double change = 0.0;                            // % from the session's first trade
+    std::int64_t volume = 0;                        // Session volume
+};
+
+struct MoverRanking {
+    std::vector<MoverRow> gainers;                  // change > 0, largest first
+    std::vector<MoverRow> losers;                   // change < 0, most negative first
+    std::vector<MoverRow> volume;                   // Largest session volume first
+
+    void clear() {
+        gainers.clear();
+        losers.clear();
+        volume.clear();
+    }
+};
+
+// One worker's slots ordered by change and by session volume
+// PERFORMANCE:
+// - A trade repositions its slot in two ordered sets: O(log n), no scan of the other symbols
+// - Repositioning moves the set node (extract / insert) - no allocation once every slot has traded
+// - top() walks n entries from either end of each set
+// NOTE: Change is measured from the session's first trade - the tick-by-tick feed carries no previous close
+class MoverBoard {
+public:
+    MoverBoard(std::size_t capacity, std::chrono::minutes sessionReset)
+        : m_entries(capacity)
+        , m_sessionResetMs(std::chrono::duration_cast<std::chrono::milliseconds>(sessionReset).count()) {
+    }
+
+    MoverBoard(const MoverBoard&) = delete;
+    MoverBoard& operator=(const MoverBoard&) = delete;
+
+    void onTrade(SlotId slot, std::int64_t timestampMs, double price, std::int64_t size) {
+        if (slot >= m_entries.size() || !(price > 0.0)) {
+            return;
+        }
+        Entry& entry = m_entries[slot];
+        const std::int64_t session = sessionNumber(timestampMs, m_sessionResetMs);
+        if (session != entry.session) {
+            entry.session = session;
+            entry.reference = price;
+            entry.volume = 0;
+        }
+        entry.last = price;
+        entry.volume += size;
+        const double change = (price - entry.reference) / entry.reference * 100.0;
+        if (!entry.ranked) {
+            entry.byChange = m_byChange.insert({change, slot}).first;  // NOTE: First trade - the only allocation
+            entry.byVolume = m_byVolume.insert({entry.volume, slot}).first;
+            entry.ranked = true;
+        } else {
+            if (entry.byChange->first != change) {
+                entry.byChange = reposition(m_byChange, entry.byChange, ChangeKey{change, slot});
+            }
+            if (entry.byVolume->first != entry.volume) {
+                entry.byVolume = reposition(m_byVolume, entry.byVolume, VolumeKey{entry.volume, slot});
+            }
+        }
+        m_dirty = true;
+    }
+
+    // Moves slot's entry from source (rebalancing; source's worker is parked for the handoff)
+    void adopt(MoverBoard& source, SlotId slot) {
+        if (slot >= m_entries.size() || !source.m_entries[slot].ranked) {
+            return;
+        }
+        Entry& from = source.m_entries[slot];
+        Entry& to = m_entries[slot];
+        to.reference = from.reference;
+        to.last = from.last;
+        to.volume = from.volume;
+        to.session = from.session;
+        // REASON: Node handles move between sets of the same type - no allocation, no re-ranking
+        to.byChange = m_byChange.insert(source.m_byChange.extract(from.byChange)).position;
+        to.byVolume = m_byVolume.insert(source.m_byVolume.extract(from.byVolume)).position;
+        to.ranked = true;
+        from = Entry{};
+        m_dirty = true;
+        source.m_dirty = true;
+    }
+
+    // Something to post: a trade since the last top(), or a session boundary that retired the ranked entries
+    bool due(std::int64_t nowMs) const { return m_dirty || sessionNumber(nowMs, m_sessionResetMs) != m_postedSession; }
+
+    // Fills out with this session's top n of each ranking (earlier sessions' entries are skipped)
+    void top(std::size_t n, std::int64_t nowMs, MoverRanking& out) {
+        out.clear();
+        const std::int64_t session = sessionNumber(nowMs, m_sessionResetMs);
+        auto row = [this](SlotId slot) {
+            const Entry& entry = m_entries[slot];
+            return MoverRow{slot, entry.last, entry.byChange->first, entry.volume};
+        };
+        for (auto it = m_byChange.rbegin(); it != m_byChange.rend() && it->first > 0.0 && out.gainers.size() < n; ++it) {
+            if (m_entries[it->second].session == session) {
+                out.gainers.push_back(row(it->second));
+            }
+        }
+        for (auto it = m_byChange.begin(); it != m_byChange.end() && it->first < 0.0 && out.losers.size() < n; ++it) {
+            if (m_entries[it->second].session == session) {
+                out.losers.push_back(row(it->second));
+            }
+        }
+        for (auto it = m_byVolume.rbegin(); it != m_byVolume.rend() && out.volume.size() < n; ++it) {
+            if (m_entries[it->second].session == session) {
+                out.volume.push_back(row(it->second));
+            }
+        }
+        m_dirty = false;
+        m_postedSession = session;
+    }
+
+private:
+    using ChangeKey = std::pair<double, SlotId>;
+    using VolumeKey = std::pair<std::int64_t, SlotId>;
+    using ChangeSet = std::set<ChangeKey>;
+    using VolumeSet = std::set<VolumeKey>;
+    static constexpr std::int64_t kNoSession = std::numeric_limits<std::int64_t>::min();
+
+    struct Entry {
+        double reference = 0.0;                     // Session's first trade
+        double last = 0.0;
+        std::int64_t volume = 0;
+        std::int64_t session = kNoSession;
+        bool ranked = false;                        // Has nodes in both sets
+        ChangeSet::iterator byChange;
+        VolumeSet::iterator byVolume;
+    };
+
+    template <typename Set>
+    static typename Set::iterator reposition(Set& set, typename Set::iterator it, typename Set::value_type key) {
+        auto node = set.extract(it);
+        node.value() = key;
+        return set.insert(std::move(node)).position;
+    }
+
+    std::vector<Entry> m_entries;                   // By slot
+    ChangeSet m_byChange;
+    VolumeSet m_byVolume;
+    std::int64_t m_sessionResetMs;
+    std::int64_t m_postedSession = kNoSession;
+    bool m_dirty = false;
+};
+
+// Each worker's latest top rows, merged into the bridge-wide ranking by the publisher
+// REASON: The top n overall is within the union of every shard's top n - merging k x n rows per interval
+// replaces ranking every symbol in one place
+// PERFORMANCE: post() swaps vectors under a per-shard lock once per interval - the worker keeps the old
+// vectors (and their capacity) as its next scratch
+class MoversExchange {
+public:
+    explicit MoversExchange(std::size_t shards)
+        : m_shards(std::make_unique<Shard[]>(shards))
+        , m_count(shards) {
+    }
+
+    // Worker thread of shard (ranking is left holding the previous post)
+    void post(std::size_t shard, MoverRanking& ranking) {
+        std::lock_guard<std::mutex> lock(m_shards[shard].mutex);
+        std::swap(m_shards[shard].ranking, ranking);
+    }
+
+    // Publisher thread: the top n of all shards' rows
+    // NOTE: A slot mid-migration can sit in two shards' rows for one interval - the first (best) row wins
+    void merge(std::size_t n, MoverRanking& out) {
+        out.clear();
+        for (std::size_t i = 0; i < m_count; ++i) {
+            std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+            const MoverRanking& ranking = m_shards[i].ranking;
+            out.gainers.insert(out.gainers.end(), ranking.gainers.begin(), ranking.gainers.end());
+            out.losers.insert(out.losers.end(), ranking.losers.begin(), ranking.losers.end());
+            out.volume.insert(out.volume.end(), ranking.volume.begin(), ranking.volume.end());
+        }
+        keepTop(out.gainers, n, [](const MoverRow& a, const MoverRow& b) { return a.change > b.change; });
+        keepTop(out.losers, n, [](const MoverRow& a, const MoverRow& b) { return a.change < b.change; });
+        keepTop(out.volume, n, [](const MoverRow& a, const MoverRow& b) { return a.volume > b.volume; });
+    }
+
+private:
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        MoverRanking ranking;
+    };
+
+    template <typename Before>
+    static void keepTop(std::vector<MoverRow>& rows, std::size_t n, Before before) {
+        std::stable_sort(rows.begin(), rows.end(), before);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < rows.size() && kept < n; ++i) {
+            const bool seen = std::any_of(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(kept),
+                                          [&](const MoverRow& row) { return row.slot == rows[i].slot; });
+            if (!seen) {
+                rows[kept++] = rows[i];
+            }
+        }
+        rows.resize(kept);
+    }
+
+    std::unique_ptr<Shard[]> m_shards;
+    std::size_t m_count;
+};
+
+// Lifetime counters (written by the publisher thread, readable from any thread)
+struct MoversCounters {
+    std::atomic<std::uint64_t> published{0};
+    std::atomic<std::uint64_t> errors{0};
+};
+
+// Merges the shards' rows once per interval and sends one message - consumers read one channel instead of
+// every symbol's snapshot
+class MoversPublisher {
+public:
+    MoversPublisher(const std::string& uri, MoversExchange& exchange, const InstrumentRegistry& registry,
+                    MoversConfig config);
+    ~MoversPublisher();
+
+    MoversPublisher(const MoversPublisher&) = delete;
+    MoversPublisher& operator=(const MoversPublisher&) = delete;
+
+    void start();
+    void stop();
+
+    const MoversCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+
+    std::string m_uri;
+    MoversExchange& m_exchange;
+    const InstrumentRegistry& m_registry;
+    MoversConfig m_config;
+    MoversCounters m_counters;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,127 @@
+// TraceExport.h - Chrome trace-event spans of sampled ticks (chrome://tracing, ui.perfetto.dev)
+// SCOPE: record() on any bridge thread, the file is written by the exporter's own thread
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <concurrentqueue.h>
+
+namespace tws_bridge {
+
+struct TraceConfig {
+    bool enabled = false;
+    std::uint32_t sampleEvery = 1000;               // 1 in N stamped ticks, per TWS connection
+    std::size_t bufferSpans = 65536;                // Waiting for the writer - beyond that spans are dropped
+    std::chrono::milliseconds flushInterval{500};
+    std::string path = "tws-bridge-trace.json";
+};
+
+// Stages of one sampled tick, in order
+enum class TraceStage : std::uint8_t {
+    Enqueue,    // Message thread: callback entry → staged for the shard queue (L1 aggregation, journal)
+    Queued,     // Staged → dequeued by the worker (async slice - no thread runs it)
+    Aggregate,  // Worker: update applied to InstrumentState
+    Serialize,  // Worker: snapshot encoded and buffered (a conflated snapshot carries its latest sampled update)
+    Publish,    // Worker: snapshot buffered → pipeline flushed / handed to the Redis I/O thread
+    Count
+};
+
+inline const char* traceStageName(TraceStage stage) {
+    static constexpr const char* kNames[] = {"enqueue", "queued", "aggregate", "serialize", "publish"};
+    return stage < TraceStage::Count ? kNames[static_cast<std::size_t>(stage)] : "";
+}
+
+// latencyNowNs() clock
+struct TraceSpan {
+    std::int64_t beginNs;
+    std::int64_t endNs;
+    std::uint32_t traceId;                          // Sampled tick (TickStamps::traceId)
+    std::uint32_t tid;                              // Thread that recorded the span
+    SlotId slot;
+    TraceStage stage;
+};
+
+/**
+ * Spans go through a lock-free queue to the "tws-trace" thread, which appends them to a JSON
+ * array file (Chrome trace-event format) every flushInterval. Each sampled tick shows as one
+ * span per stage on the thread that ran it, with a flow arrow from the message thread to the
+ * worker. Per-tick args hold the trace id and the symbol.
+ *
+ * PERFORMANCE: Unsampled ticks cost a countdown decrement on the message thread and a zero check
+ * on the worker; a sampled tick costs two clock reads and one queue push per stage
+ * NOTE: The file is a valid trace while the bridge runs (viewers accept a missing closing bracket)
+ */
+class TraceExport {
+public:
+    TraceExport(TraceConfig config, const InstrumentRegistry* registry);
+    ~TraceExport();
+
+    TraceExport(const TraceExport&) = delete;
+    TraceExport& operator=(const TraceExport&) = delete;
+
+    // Opens config.path and starts the writer thread (false: file not writable, error logged)
+    bool start();
+    // Writes every queued span and closes the array
+    void stop();
+
+    const TraceConfig& config() const { return m_config; }
+
+    // Id of a newly sampled tick (never 0)
+    std::uint32_t nextTraceId() {
+        std::uint32_t id = m_nextId.fetch_add(1, std::memory_order_relaxed);
+        return id != 0 ? id : m_nextId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void record(TraceStage stage, std::int64_t beginNs, std::int64_t endNs, std::uint32_t traceId, SlotId slot) {
+        // BACKPRESSURE: try_enqueue never allocates - a full buffer drops the span, not the tick
+        if (!m_queue.try_enqueue(TraceSpan{beginNs, endNs, traceId, currentTid(), slot, stage})) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer thread's loop body, public for tests: appends every queued span to the file
+    std::size_t flush();
+
+    std::uint64_t written() const { return m_written.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    // PERFORMANCE: One syscall per thread, cached
+    static std::uint32_t currentTid() {
+        thread_local const std::uint32_t tid = static_cast<std::uint32_t>(::syscall(SYS_gettid));
+        return tid;
+    }
+    void run();
+    void writeThreadName(std::uint32_t tid);
+    void writeSpan(const TraceSpan& span);
+    void writeEvent(const char* ph, const char* name, std::int64_t ns, std::uint32_t tid, const TraceSpan& span,
+                    std::int64_t durationNs);
+
+    TraceConfig m_config;
+    const InstrumentRegistry* m_registry;           // Symbol args (nullptr = slot numbers)
+    moodycamel::ConcurrentQueue<TraceSpan> m_queue;
+    std::atomic<std::uint32_t> m_nextId{1};
+    std::atomic<std::uint64_t> m_written{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+
+    // ========== Writer thread ==========
+    std::FILE* m_file = nullptr;
+    bool m_firstEvent = true;
+    std::unordered_set<std::uint32_t> m_namedThreads;  // thread_name metadata already written
+    std::vector<TraceSpan> m_scratch;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,40 @@
+// Tracepoints.h - USDT probes on pipeline boundaries (provider "tws_bridge")
+// SCOPE: Any thread - integer arguments only, attach with bpftrace / perf probe sdt_tws_bridge:*
+
+#pragma once
+
+// REASON: Compiled in only with -DTWS_BRIDGE_USDT (CMake option, on when <sys/sdt.h> is installed);
+// otherwise every probe expands to nothing and its arguments are not evaluated
+#if defined(TWS_BRIDGE_USDT) && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define BRIDGE_TRACEPOINTS 1
+#endif
+#endif
+
+#ifdef BRIDGE_TRACEPOINTS
+
+// PERFORMANCE: A disabled probe is one nop plus its argument registers - no branch, no memory access;
+// bpftrace patches the nop into a breakpoint only while attached
+#define BRIDGE_TRACE1(probe, a) DTRACE_PROBE1(tws_bridge, probe, a)
+#define BRIDGE_TRACE2(probe, a, b) DTRACE_PROBE2(tws_bridge, probe, a, b)
+#define BRIDGE_TRACE3(probe, a, b, c) DTRACE_PROBE3(tws_bridge, probe, a, b, c)
+
+#else
+
+// PITFALL: Arguments vanish with the probe - never compute a value only for a probe
+#define BRIDGE_TRACE1(probe, a) ((void)0)
+#define BRIDGE_TRACE2(probe, a, b) ((void)0)
+#define BRIDGE_TRACE3(probe, a, b, c) ((void)0)
+
+#endif
+
+// Probes (arguments in order):
+//   tick_callback(reqId, type)               TwsClient callback entry (BidAsk / AllLast / Depth), message thread
+//   tick_enqueue(slot, type)                 Update staged for its shard queue, message thread
+//   worker_dequeue(shard, count)             Worker took a batch
+//   snapshot_serialized(shard, slot, bytes)  Snapshot encoded and buffered into the pipeline
+//   publish_done(count, status, roundTripNs) Pipeline reply received (worker or Redis I/O thread)
+//   tws_reconnect(clientId)                  TWS connection lost, reconnect starts
+//   tws_reconnected(clientId, attempts, ms)  TWS session re-established
+// NOTE: type = TickUpdateType, status = PublishStatus (numeric values)
@@ -0,0 +1,108 @@
+// TradeCodes.h - Small integer codes for a trade's exchange and sale conditions
+// SCOPE: Message thread (tickByTickAllLast → TickUpdate), Redis Worker (snapshot exchange / conditions)
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace tws_bridge {
+
+// ========== Exchange Codes ==========
+// REASON: Immutable table, lookups need no lock and no allocation (code = index + 1, 0 = unknown / none)
+using ExchangeCode = std::uint8_t;
+constexpr ExchangeCode kUnknownExchange = 0;
+
+// PITFALL: Keep sorted (binary search) - appending in the middle renumbers the codes after it, which is
+// fine for Redis output (names are published) but changes journaled codes of older captures
+inline constexpr std::string_view kExchangeNames[] = {
+    "AMEX", "ARCA", "BATS", "BEX", "BYX", "CBOE", "CHX", "DRCTEDGE", "EDGEA", "EDGX", "FINRA", "IBEOS",
+    "IBKRATS", "IEX", "ISE", "ISLAND", "LTSE", "MEMX", "NASDAQ", "NYSE", "NYSENAT", "OVERNIGHT", "PEARL",
+    "PHLX", "PSX", "SMART", "TPLUS1",
+};
+
+inline constexpr std::size_t kExchangeCount = std::size(kExchangeNames);
+static_assert(kExchangeCount < 0xFF, "ExchangeCode must fit one byte");
+
+namespace trade_codes_detail {
+constexpr bool sortedNames() {
+    for (std::size_t i = 1; i < kExchangeCount; ++i) {
+        if (!(kExchangeNames[i - 1] < kExchangeNames[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+static_assert(trade_codes_detail::sortedNames(), "kExchangeNames must stay sorted");
+
+// PERFORMANCE: ~5 short compares, no hashing (exchange is a view into the TWS frame)
+inline ExchangeCode exchangeCode(std::string_view exchange) {
+    const auto it = std::lower_bound(std::begin(kExchangeNames), std::end(kExchangeNames), exchange);
+    if (it == std::end(kExchangeNames) || *it != exchange) {
+        return kUnknownExchange;
+    }
+    return static_cast<ExchangeCode>(it - std::begin(kExchangeNames) + 1);
+}
+
+// Static name for a code ("" for kUnknownExchange and out-of-range codes)
+inline std::string_view exchangeName(ExchangeCode code) {
+    return code != kUnknownExchange && code <= kExchangeCount ? kExchangeNames[code - 1] : std::string_view{};
+}
+
+// ========== Trade Conditions ==========
+// TWS specialConditions: space-separated one-character sale condition codes (e.g. "F I", "  T")
+// Bits 0-9 = '0'-'9', 10-35 = 'A'-'Z', 36 = '@' (regular sale), 63 = any other code
+using TradeConditions = std::uint64_t;
+
+namespace TradeCondition {
+constexpr unsigned kAtBit = 36;
+constexpr unsigned kOtherBit = 63;
+constexpr TradeConditions Other = TradeConditions{1} << kOtherBit;
+}
+
+inline constexpr int tradeConditionBit(char code) {
+    if (code >= '0' && code <= '9') {
+        return code - '0';
+    }
+    if (code >= 'A' && code <= 'Z') {
+        return 10 + (code - 'A');
+    }
+    return code == '@' ? static_cast<int>(TradeCondition::kAtBit) : static_cast<int>(TradeCondition::kOtherBit);
+}
+
+// PERFORMANCE: One pass over the view, no tokenizing into strings
+inline TradeConditions parseTradeConditions(std::string_view conditions) {
+    TradeConditions mask = 0;
+    for (char code : conditions) {
+        if (code != ' ') {
+            mask |= TradeConditions{1} << tradeConditionBit(code);
+        }
+    }
+    return mask;
+}
+
+// Longest writeTradeConditions() output: 37 codes + "?" for Other, space-separated
+inline constexpr std::size_t kTradeConditionsMaxChars = 2 * 38 - 1;
+
+// Codes in bit order, space-separated ("" for none, "?" for Other) - not quoted, never needs escaping
+inline char* writeTradeConditions(char* out, TradeConditions mask) {
+    static constexpr char kCodes[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ@";
+    bool first = true;
+    while (mask != 0) {
+        const unsigned bit = static_cast<unsigned>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+        if (!first) {
+            *out++ = ' ';
+        }
+        first = false;
+        *out++ = bit <= TradeCondition::kAtBit ? kCodes[bit] : '?';
+    }
+    return out;
+}
+
+} // namespace tws_bridge
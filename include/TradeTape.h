@@ -0,0 +1,105 @@
+// TradeTape.h - Time and sales per symbol: the newest prints kept in TWS:TAS:{SYMBOL}, one LPUSH + LTRIM
+// per symbol per drain batch
+// SCOPE: Redis Worker thread (TapeBatch per worker)
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "MarketData.h"
+#include "Quantity.h"
+#include "TradeCodes.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tws_bridge {
+
+// One print as a compact JSON element: {"time","price","size","exchange","conditions"} (+ "pastLimit" if set)
+// NOTE: Exchange names and condition codes never need escaping (TradeCodes.h)
+inline void appendTapePrint(const TickUpdate& update, std::string& out) {
+    char number[32];
+    auto append = [&](auto value) {
+        const std::to_chars_result result = std::to_chars(number, number + sizeof(number), value);
+        out.append(number, static_cast<std::size_t>(result.ptr - number));
+    };
+    out += "{\"time\":";
+    append(update.timestamp);
+    out += ",\"price\":";
+    append(update.allLast.price);  // REASON: Shortest round-trip digits, like the snapshots' prices
+    out += ",\"size\":";
+    appendQuantity(out, update.tradeQuantity());
+    out += ",\"exchange\":\"";
+    const std::string_view exchange = exchangeName(update.allLast.exchange);
+    out.append(exchange.data(), exchange.size());
+    out += "\",\"conditions\":\"";
+    char conditions[kTradeConditionsMaxChars];
+    out.append(conditions, static_cast<std::size_t>(writeTradeConditions(conditions, update.allLast.conditions) - conditions));
+    out += '"';
+    if (update.pastLimit()) {
+        out += ",\"pastLimit\":true";
+    }
+    out += '}';
+}
+
+// A drain batch's trades, written per symbol at the end of the batch
+// PERFORMANCE:
+// - add() copies the update into storage reserved for a whole batch - nothing allocates while applying
+// - One LPUSH of all the symbol's prints + one LTRIM per symbol per batch, not a trim per print; the
+//   list briefly holds more than keep entries between the two (same pipeline, same connection)
+// - Prints the trim would drop anyway are never encoded (a burst beyond keep in one batch)
+class TapeBatch {
+public:
+    // capacity: the worker's batch size (at most one print per drained update)
+    TapeBatch(std::size_t keep, std::size_t capacity)
+        : m_keep(std::max<std::size_t>(1, keep)) {
+        m_prints.reserve(capacity);
+    }
+
+    // Worker thread, while applying the batch
+    void add(const TickUpdate& update) {
+        if (m_prints.size() < m_prints.capacity()) {
+            m_prints.push_back(update);
+        }
+    }
+
+    bool empty() const { return m_prints.empty(); }
+    std::size_t keep() const { return m_keep; }
+
+    // fn(slot, payload, prints): payload is the slot's '\n'-separated prints, oldest first (RedisCommand::ListPush)
+    // Clears the batch
+    template <typename Fn>
+    void flush(Fn&& fn) {
+        // REASON: Stable - a symbol's prints keep their arrival order, the newest ends up at the list head
+        std::stable_sort(m_prints.begin(), m_prints.end(),
+                         [](const TickUpdate& a, const TickUpdate& b) { return a.slot < b.slot; });
+        for (std::size_t begin = 0; begin < m_prints.size();) {
+            std::size_t end = begin;
+            while (end < m_prints.size() && m_prints[end].slot == m_prints[begin].slot) {
+                ++end;
+            }
+            m_payload.clear();  // NOTE: Keeps its capacity
+            for (std::size_t i = end - std::min(end - begin, m_keep); i < end; ++i) {
+                if (!m_payload.empty()) {
+                    m_payload += '\n';
+                }
+                appendTapePrint(m_prints[i], m_payload);
+            }
+            fn(m_prints[begin].slot, m_payload, std::min(end - begin, m_keep));
+            begin = end;
+        }
+        m_prints.clear();
+    }
+
+    void clear() { m_prints.clear(); }
+
+private:
+    std::size_t m_keep;
+    std::vector<TickUpdate> m_prints;
+    std::string m_payload;
+};
+
+} // namespace tws_bridge
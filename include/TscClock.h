@@ -0,0 +1,148 @@
+// TscClock.h - Wall-clock nanoseconds from the invariant TSC (receive stamps of every socket read)
+// SCOPE: Any thread reads nowNs(); the main loop rebases about once a second
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace tws_bridge {
+
+inline std::int64_t systemNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Unix ns = anchor ns + (rdtsc - anchor tsc) x ns per tick, the rate measured against system_clock
+// PERFORMANCE: One rdtsc and a multiply-add - no clock_gettime per socket read
+// REASON: Wall clock, not steady_clock - the stamp is published next to TWS's exchange time
+// PITFALL: Without an invariant TSC (frequency scaling, non-x86) nowNs() is plain system_clock
+// NOTE: Each rebase() re-anchors to system_clock - a stamp may step by the drift since the last one
+// (sub-microsecond at one rebase a second), NTP slews are followed the same way
+class TscClock {
+public:
+    explicit TscClock(std::chrono::milliseconds calibration = std::chrono::milliseconds(10))
+        : m_invariant(invariantTsc()) {
+        if (!m_invariant) {
+            return;
+        }
+        m_first = sample();
+        std::this_thread::sleep_for(calibration);
+        rebase();
+    }
+
+    TscClock(const TscClock&) = delete;
+    TscClock& operator=(const TscClock&) = delete;
+
+    bool invariant() const { return m_invariant; }
+
+    // CRITICAL PATH: Reader threads, once per socket read
+    std::int64_t nowNs() const {
+        if (!m_invariant) {
+            return systemNowNs();
+        }
+        const std::uint64_t tsc = readTsc();
+        while (true) {
+            const std::uint32_t sequence = m_sequence.load(std::memory_order_acquire);
+            const std::int64_t baseNs = m_baseNs.load(std::memory_order_relaxed);
+            const std::uint64_t baseTsc = m_baseTsc.load(std::memory_order_relaxed);
+            const double nsPerTick = m_nsPerTick.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((sequence & 1) == 0 && m_sequence.load(std::memory_order_relaxed) == sequence) {
+                // REASON: Signed - a TSC read before a concurrent rebase lies just behind the new anchor
+                return baseNs + static_cast<std::int64_t>(
+                    static_cast<double>(static_cast<std::int64_t>(tsc - baseTsc)) * nsPerTick);
+            }
+        }
+    }
+
+    // Re-anchors to system_clock, rate over the whole run since construction (single caller)
+    void rebase() {
+        if (!m_invariant) {
+            return;
+        }
+        const Anchor now = sample();
+        if (now.tsc <= m_first.tsc) {
+            return;
+        }
+        const double nsPerTick = static_cast<double>(now.ns - m_first.ns) / static_cast<double>(now.tsc - m_first.tsc);
+        // REASON: Seqlock - an odd sequence marks the anchor as being rewritten
+        const std::uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_baseNs.store(now.ns, std::memory_order_relaxed);
+        m_baseTsc.store(now.tsc, std::memory_order_relaxed);
+        m_nsPerTick.store(nsPerTick, std::memory_order_relaxed);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Measured TSC rate (0 without an invariant TSC)
+    double ticksPerNs() const {
+        const double nsPerTick = m_nsPerTick.load(std::memory_order_relaxed);
+        return m_invariant && nsPerTick > 0.0 ? 1.0 / nsPerTick : 0.0;
+    }
+
+private:
+    struct Anchor {
+        std::uint64_t tsc = 0;
+        std::int64_t ns = 0;
+    };
+
+    static std::uint64_t readTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    // CPUID 0x80000007 EDX bit 8: the TSC ticks at a constant rate in every P-, C- and T-state
+    static bool invariantTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned eax = 0;
+        unsigned ebx = 0;
+        unsigned ecx = 0;
+        unsigned edx = 0;
+        return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    // REASON: The clock read between two TSC reads - the tightest of a few pairs (no preemption inside)
+    static Anchor sample() {
+        Anchor best;
+        std::uint64_t bestSpread = ~std::uint64_t{0};
+        for (int attempt = 0; attempt < 5; ++attempt) {
+            const std::uint64_t before = readTsc();
+            const std::int64_t ns = systemNowNs();
+            const std::uint64_t after = readTsc();
+            if (after - before < bestSpread) {
+                bestSpread = after - before;
+                best = Anchor{before + (after - before) / 2, ns};
+            }
+        }
+        return best;
+    }
+
+    const bool m_invariant;
+    Anchor m_first;                                 // Construction anchor (rebase() only)
+    std::atomic<std::uint32_t> m_sequence{0};
+    std::atomic<std::int64_t> m_baseNs{0};
+    std::atomic<std::uint64_t> m_baseTsc{0};
+    std::atomic<double> m_nsPerTick{0.0};
+};
+
+// Process-wide receive clock, calibrated on first use (main touches it before the readers start)
+inline TscClock& receiveClock() {
+    static TscClock clock;
+    return clock;
+}
+
+} // namespace tws_bridge
@@ -13,37 +13,220 @@
 #include "EReader.h"
 #include "IErrorHandler.h"
 #include "EReaderOSSignal.h"
+#include "AccountTable.h"
+#include "BarTime.h"
 #include "MarketData.h"
+#include "InstrumentRegistry.h"
+#include "OptionChain.h"
+#include "Quantity.h"
+#include "LatencyHistogram.h"
+#include "MarketScanner.h"
+#include "NewsFeed.h"
+#include "Metrics.h"
+#include "RequestTable.h"
+#include "RequestPacer.h"
+#include "BridgeReader.h"
+#include "ContractCache.h"
+#include "GapBackfill.h"
+#include "ReconnectBackoff.h"
+#include "IngestSink.h"
+#include "ShardRouter.h"
+#include "SocketTuning.h"
+#include "StageWatchdog.h"
+#include "SubscriptionCommand.h"
+#include "ThreadAffinity.h"
+#include "TraceExport.h"
+#include "TradeCodes.h"
+#include "TscClock.h"
 #include <memory>
+#include <mutex>
 #include <string>
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <unordered_map>
-#include <concurrentqueue.h>
+#include <vector>
 
 class EClientSocket;
+struct Contract;
 
 namespace tws_bridge {
 
+class CorkedClientSocket;
+class TickJournal;
+
+// Lifetime counters (written by the callback thread, summed by the metrics scrape)
+struct TwsClientCounters {
+    PerThreadCounter ticksIn[kTickUpdateTypeCount];  // Updates handed to the shard router, by TickUpdateType
+    std::atomic<std::uint64_t> reconnects{0};        // Sessions re-established after a lost socket
+    std::atomic<std::uint64_t> replays{0};           // Subscription replays (reconnect or error 1101)
+    std::atomic<std::uint64_t> contractHits{0};      // Subscribes sent by cached conId
+    std::atomic<std::uint64_t> contractLookups{0};   // reqContractDetails sent (cache miss or stale entry)
+    std::atomic<std::uint64_t> contractFailures{0};  // Lookups TWS answered with an error (unknown symbol)
+    LatencyHistogram reconnectTime;                  // Socket lost → session re-established (ns)
+};
+
 // Bidirectional TWS adapter: implements callbacks (EWrapper) + manages connection (EClientSocket)
-class TwsClient : public IErrorHandler {
+// Sink: ingest sink policy the callbacks hand their updates to (IngestSink.h) - queue type, staging and overflow
+// strategy fixed at compile time, instantiated in TwsClient.cpp
+// FastTickHandler: TICK_BY_TICK / TICK_PRICE / TICK_SIZE frames decoded by BridgeReader's fast path
+// (BridgeRing / Inline)
+template <typename Sink>
+class BasicTwsClient : public EWrapper, public FastTickHandler {
 public:
-    explicit TwsClient(moodycamel::ConcurrentQueue<TickUpdate>& queue);
-    ~TwsClient();
+    // target: what the sink feeds (ShardedTwsClient: per-worker shard queues, each update goes to the shard
+    // owning its slot)
+    // pacing: outbound request rate / tick-by-tick stream limits (every EClient request goes through it)
+    BasicTwsClient(typename Sink::Target& target, InstrumentRegistry& registry, PacingConfig pacing = {});
+    ~BasicTwsClient();
 
     // ========== Outbound API: Commands WE send TO TWS ==========
-    bool createConnection(const std::string& host, unsigned int port, int clientId);
+    // readerMode: TwsApi (vendored EReader), BridgeRing or Inline (BridgeReader, falls back to TwsApi if unsupported)
+    bool createConnection(const std::string& host, unsigned int port, int clientId,
+                          ReaderMode readerMode = ReaderMode::TwsApi);
     void disconnect();
     bool isConnected() const;
-    void subscribeTickByTick(const std::string& symbol, int tickerId);
+    // Any thread (StageWatchdog): shuts the TWS socket down so a stuck read or write returns and
+    // the message thread's reconnect() runs - the connection is re-established, not given up
+    void abortConnection();
+    // In-process reconnect after a lost socket: back-off (ReconnectPolicy), then replays every active
+    // subscription through the pacer under its old tickerId - slots, worker state and Redis stay warm
+    // Returns false on shutdown (running cleared), reconnect disabled or attempts exhausted
+    // NOTE: Message thread only (same thread as processMessages) - blocks while backing off
+    bool reconnect(const std::atomic<bool>& running);
+    // Connection gone for good (reconnect() gave up or is disabled) - readable from any thread
+    bool isConnectionLost() const { return m_connectionLost.load(); }
+    // nextValidId received since the last (re)connect - readable from any thread
+    // NOTE: Requests queued before that wait in the pacer, processMessages() sends them once it fires
+    bool isReady() const { return m_ready.load(); }
+    // When this session's nextValidId arrived (valid once isReady())
+    // REASON: Stamped by the callback - a poller sees readiness up to one poll interval late
+    std::chrono::steady_clock::time_point readyAt() const {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(m_readyAt.load()));
+    }
+    // Subscribe calls queue paced requests - sent by processMessages(), highest priority first
+    // (e.g. priority = liquidity rank, so the most active symbols stream first)
+    void subscribeTickByTick(const std::string& symbol, int tickerId, int priority = 0);
+    // L1 (reqMktData): same InstrumentState + channels as tick-by-tick, no stream limit
+    // REASON: Covers hundreds of symbols, keeps the few tick-by-tick streams for the most active
+    void subscribeMarketData(const std::string& symbol, int tickerId, int priority = 0);
+    // Tick-by-tick midpoint only (1 stream instead of 2), published as is to TWS:MID:{SYMBOL}
+    // REASON: Monitoring a large ETF universe needs no quote / trade snapshots - a fraction of the bytes
+    void subscribeMidPoint(const std::string& symbol, int tickerId, int priority = 0);
+    // Cancels whichever feed the symbol is subscribed with
+    void unsubscribe(const std::string& symbol);
+    // L2 (reqMktDepth): order book kept by the worker, published to TWS:DEPTH:{SYMBOL}
+    // smartDepth: aggregate across exchanges (updateMktDepthL2), else the contract's exchange only
+    void subscribeMarketDepth(const std::string& symbol, int tickerId, int numRows = 10,
+                              bool smartDepth = true, int priority = 0);
+    void unsubscribeMarketDepth(const std::string& symbol);
+    // Option chain of an underlying: reqSecDefOptParams (cached, OptionChainCache), then one reqMktData per leg
+    // of the selected expirations x strikes; model greeks go out batched per expiry on TWS:CHAIN:{SYMBOL}:{EXPIRY}
+    // NOTE: Needs the underlying's conId - from the contract cache, else the chain waits for its lookup
+    // PITFALL: Message thread (applyCommands) or before createConnection() - the leg routes are read by the
+    // callbacks without a lock
+    void subscribeOptionChain(const std::string& symbol, ChainRequest request = {}, int priority = 0);
+    void unsubscribeOptionChain(const std::string& symbol);
+    // keepUpToDate: the request stays open - historicalDataUpdate revises the in-progress bar, the worker
+    // publishes it throttled (TWS:LIVEBAR:{SYMBOL}) and appends each completed bar (TWS:BARS, bar store)
+    // NOTE: Kept open across reconnects like real-time bars (one-shot requests are not replayed)
     void subscribeHistoricalBars(const std::string& symbol, int tickerId, 
                                   const std::string& duration = "1 D", 
-                                  const std::string& barSize = "5 mins");
+                                  const std::string& barSize = "5 mins",
+                                  bool keepUpToDate = false);
+    // One-shot reqHistoricalData ending at endDateTime (UTC "yyyymmdd-hh:mm:ss") under an id of its own -
+    // the older part of a window the bar store does not cover (subscriptions.incremental_history)
+    // NOTE: Paced like every historical request, its bars merge into the bar store by timestamp
+    void backfillHistoricalBars(const std::string& symbol, const std::string& endDateTime,
+                                const std::string& duration, const std::string& barSize = "5 mins");
     void subscribeRealTimeBars(const std::string& symbol, int tickerId, 
                                 int barSize = 5, 
                                 const std::string& whatToShow = "TRADES");
     
-    // Message processing loop (dispatches callbacks from EReader thread)
+    // Applies queued TWS:COMMANDS requests, returns count
+    // REASON: Call from the message thread between processMessages() calls - requests are sent
+    // from the thread that dispatches callbacks, callbacks never wait on a subscription change
+    std::size_t applyCommands(CommandQueue& commands);
+
+    const RequestPacer& pacer() const { return m_pacer; }
+    const TwsClientCounters& counters() const { return m_counters; }
+    // StageWatchdog: Stage::Reader (BridgeRing reader thread, attached by it) and Stage::Dispatch
+    // (beats in processMessages(); the calling thread attaches and parks it around reconnect())
+    const Heartbeat& readerHeartbeat() const { return m_readerHeartbeat; }
+    Heartbeat& dispatchHeartbeat() { return m_dispatchHeartbeat; }
+    // Symbols with an active tick-by-tick / L1 subscription (takes the subscribe mutex - cold path)
+    std::size_t subscriptionCount();
+
+    // Stamps each BidAsk / AllLast / Depth update with TickStamps (two steady_clock reads per tick)
+    // NOTE: Read by the message thread - WorkerConfig::latency turns the worker side on
+    void setLatencyStamps(bool enabled) { m_latencyStamps.store(enabled, std::memory_order_relaxed); }
+
+    // Captures every update handed to the shard router (nullptr = off), journal must be started
+    // PITFALL: Set before createConnection() - read by the message thread without synchronization
+    void setJournal(TickJournal* journal) { m_journal = journal; }
+
+    // Samples every sampleEvery-th stamped update for the trace (nullptr = off), needs setLatencyStamps(true)
+    // PITFALL: Set before createConnection() - read by the message thread without synchronization
+    void setTraceExport(TraceExport* trace) {
+        m_trace = trace;
+        m_traceCountdown = trace ? trace->config().sampleEvery : 0;
+    }
+
+    // Socket reader thread placement ("tws-reader"), applied by createConnection()
+    // NOTE: ReaderMode::Inline has no reader thread - place the thread calling processMessages() instead
+    void setReaderThread(ThreadConfig config) { m_readerThread = config; }
+
+    // Inbound msg ids decoded by BridgeReader, the rest dropped after framing (set before createConnection())
+    // NOTE: ReaderMode::TwsApi decodes everything - the vendored EReader / EDecoder are not filtered
+    void setMessageFilter(MessageFilter filter) { m_messageFilter = filter; }
+
+    // Socket options applied after each eConnect, and the bridge reader's poll period (0 = busy-poll)
+    // (set before createConnection())
+    void setSocketTuning(SocketTuning tuning, std::chrono::milliseconds readerPoll) {
+        m_socketTuning = tuning;
+        m_readerPoll = readerPoll;
+    }
+
+    // Back-off between reconnect attempts (set before createConnection())
+    void setReconnectPolicy(ReconnectPolicy policy) { m_reconnectPolicy = policy; }
+
+    // Refetches each quote / trade subscription's outage window after a reconnect (set before createConnection())
+    void setBackfillPolicy(BackfillPolicy policy) { m_backfillPolicy = policy; }
+
+    // One daily-bar reqHistoricalData per subscribed symbol (previous close, session open), delivered as
+    // TickFlags::SessionSeed bars for RedisWorker's session statistics (set before the first subscribe)
+    void setSessionSeeding(bool enabled) { m_sessionSeeding = enabled; }
+
+    // Streams account PnL (reqPnL), positions (reqPositions, one reqPnLSingle each) and portfolio values
+    // (reqAccountUpdates) of account into feed ("" = first managed account), replayed on reconnect
+    // NOTE: Once per client - the feed outlives the connection (RedisWorker::streamAccount drains it)
+    void subscribeAccount(AccountQueue& feed, const std::string& account);
+
+    // Runs config's scans (reqScannerSubscription), each completed cycle posted to outbox, replayed on reconnect
+    // NOTE: Once per client - the outbox outlives the connection (ScanPublisher diffs and publishes it)
+    void subscribeScanners(const ScannerConfig& config, ScanOutbox& outbox);
+
+    // One Broadtape news line (reqMktData, generic tick 292) per symbol for lane's providers, headlines pushed
+    // to lane, replayed on reconnect
+    // NOTE: Once per client - the lane outlives the connection (RedisWorker::streamNews drains it)
+    void subscribeNews(NewsLane& lane, const std::vector<std::string>& symbols);
+
+    // STK / USD subscribes go out by cached conId + primary exchange; misses and entries older than
+    // maxAge are resolved with a low-priority reqContractDetails, the answer updates cache and registry
+    // (nullptr = off). Cache shared by every connection, owned and saved by the caller
+    // PITFALL: Set before any subscribe - read without synchronization
+    void setContractCache(ContractCache* cache, std::chrono::seconds maxAge) {
+        m_contractCache = cache;
+        m_contractMaxAge = maxAge;
+    }
+
+    // Message processing loop (dispatches callbacks from the reader thread)
+    // NOTE: Also sends due paced requests first (same thread as every other EClient call)
+    // The cycle's updates reach the shard queues when it returns (or when a shard's staging buffer fills)
+    // ReaderMode::Inline: also reads the socket - call from one dedicated (ideally pinned) thread
     void processMessages();
+    // ReaderMode::Inline with the socket wait capped at inlineWait (compact mode: the worker's next timer)
+    void processMessages(std::chrono::milliseconds inlineWait);
 
     // ========== Inbound API: Callbacks TWS invokes ON us (EWrapper interface) ==========
     // These are called by EReader thread when TWS sends us data
@@ -55,17 +238,43 @@ public:
     void tickByTickAllLast(int reqId, int tickType, time_t time, double price, 
                            Decimal size, const TickAttribLast& tickAttribLast, 
                            const std::string& exchange, const std::string& specialConditions);
+    void tickByTickMidPoint(int reqId, time_t time, double midPoint);
+
+    // ========== Inbound API: Fast path (FastTickHandler, BridgeReader modes only) ==========
+    // Same TickUpdate as the EWrapper callbacks above, built straight from the decoded fields
+    void onTickByTick(const TickByTickFields& fields) override;
+    void onMarketDataTick(const MarketDataTickFields& fields) override;
+    void onHistoricalBars(const HistoricalBarBatch& batch) override;
     
     void nextValidId(OrderId orderId);
     void connectionClosed();
     void error(int id, time_t errorTime, int errorCode, const std::string& errorString, const std::string& advancedOrderRejectJson);
     void connectAck();
+
+    // ========== Option Chains (reqSecDefOptParams + per-leg reqMktData) ==========
+    void tickOptionComputation(TickerId tickerId, TickType tickType, int tickAttrib, double impliedVol, double delta,
+                               double optPrice, double pvDividend, double gamma, double vega, double theta,
+                               double undPrice);
+    void securityDefinitionOptionalParameter(int reqId, const std::string& exchange, int underlyingConId,
+                                             const std::string& tradingClass, const std::string& multiplier,
+                                             const std::set<std::string>& expirations, const std::set<double>& strikes);
+    void securityDefinitionOptionalParameterEnd(int reqId);
+
+    // ========== Gap Backfill (reqHistoricalTicks after a reconnect) ==========
+    void historicalTicksBidAsk(int reqId, const std::vector<HistoricalTickBidAsk>& ticks, bool done);
+    void historicalTicksLast(int reqId, const std::vector<HistoricalTickLast>& ticks, bool done);
+
+    // ========== Market Scanner (reqScannerSubscription, subscribeScanners) ==========
+    void scannerData(int reqId, int rank, const ContractDetails& contractDetails, const std::string& /*distance*/,
+                     const std::string& /*benchmark*/, const std::string& /*projection*/, const std::string& /*legsStr*/);
+    void scannerDataEnd(int reqId);
+
+    // ========== News (reqMktData generic tick 292, subscribeNews) ==========
+    void tickNews(int tickerId, time_t timeStamp, const std::string& providerCode, const std::string& articleId,
+                  const std::string& headline, const std::string& extraData);
     
     // ========== Unused EWrapper callbacks (stub implementations) ==========
     // TWS API requires implementing 90+ callbacks, most unused for tick-by-tick
-    void tickOptionComputation(TickerId /*tickerId*/, TickType /*tickType*/, int /*tickAttrib*/, double /*impliedVol*/, 
-                               double /*delta*/, double /*optPrice*/, double /*pvDividend*/, double /*gamma*/, 
-                               double /*vega*/, double /*theta*/, double /*undPrice*/) {}
     void tickGeneric(TickerId /*tickerId*/, TickType /*tickType*/, double /*value*/) {}
     void tickEFP(TickerId /*tickerId*/, TickType /*tickType*/, double /*basisPoints*/, const std::string& /*formattedBasisPoints*/,
                  double /*totalDividends*/, int /*holdDays*/, const std::string& /*futureLastTradeDate*/, 
@@ -78,29 +287,27 @@ public:
     void winError(const std::string& /*str*/, int /*lastError*/) {}
     void updateAccountValue(const std::string& /*key*/, const std::string& /*val*/, const std::string& /*currency*/, 
                             const std::string& /*accountName*/) {}
-    void updatePortfolio(const Contract& /*contract*/, Decimal /*position*/, double /*marketPrice*/, double /*marketValue*/,
-                         double /*averageCost*/, double /*unrealizedPNL*/, double /*realizedPNL*/, 
-                         const std::string& /*accountName*/) {}
+    void updatePortfolio(const Contract& contract, Decimal position, double marketPrice, double marketValue,
+                         double averageCost, double unrealizedPNL, double realizedPNL,
+                         const std::string& accountName);
     void updateAccountTime(const std::string& /*timeStamp*/) {}
     void accountDownloadEnd(const std::string& /*accountName*/) {}
-    void contractDetails(int /*reqId*/, const ContractDetails& /*contractDetails*/) {}
+    void contractDetails(int reqId, const ContractDetails& contractDetails);
     void bondContractDetails(int /*reqId*/, const ContractDetails& /*contractDetails*/) {}
-    void contractDetailsEnd(int /*reqId*/) {}
+    void contractDetailsEnd(int reqId);
     void execDetails(int /*reqId*/, const Contract& /*contract*/, const Execution& /*execution*/) {}
     void execDetailsEnd(int /*reqId*/) {}
-    void updateMktDepth(TickerId /*id*/, int /*position*/, int /*operation*/, int /*side*/, double /*price*/, Decimal /*size*/) {}
-    void updateMktDepthL2(TickerId /*id*/, int /*position*/, const std::string& /*marketMaker*/, int /*operation*/, 
-                          int /*side*/, double /*price*/, Decimal /*size*/, bool /*isSmartDepth*/) {}
+    void updateMktDepth(TickerId id, int position, int operation, int side, double price, Decimal size);
+    void updateMktDepthL2(TickerId id, int position, const std::string& marketMaker, int operation,
+                          int side, double price, Decimal size, bool isSmartDepth);
     void updateNewsBulletin(int /*msgId*/, int /*msgType*/, const std::string& /*newsMessage*/, 
                             const std::string& /*originExch*/) {}
-    void managedAccounts(const std::string& /*accountsList*/) {}
+    void managedAccounts(const std::string& accountsList);
     void receiveFA(faDataType /*pFaDataType*/, const std::string& /*cxml*/) {}
     void historicalData(TickerId reqId, const Bar& bar);
     void historicalDataEnd(int reqId, const std::string& startDateStr, const std::string& endDateStr);
+    void historicalDataUpdate(TickerId reqId, const Bar& bar);
     void scannerParameters(const std::string& /*xml*/) {}
-    void scannerData(int /*reqId*/, int /*rank*/, const ContractDetails& /*contractDetails*/, const std::string& /*distance*/,
-                     const std::string& /*benchmark*/, const std::string& /*projection*/, const std::string& /*legsStr*/) {}
-    void scannerDataEnd(int /*reqId*/) {}
     void realtimeBar(TickerId reqId, long time, double open, double high, double low, double close,
                      Decimal volume, Decimal wap, int count);
     void currentTime(long /*time*/) {}
@@ -109,7 +316,7 @@ public:
     void tickSnapshotEnd(int /*reqId*/) {}
     void marketDataType(TickerId /*reqId*/, int /*marketDataType*/) {}
     void commissionAndFeesReport(const CommissionAndFeesReport& /*commissionAndFeesReport*/) {}
-    void position(const std::string& /*account*/, const Contract& /*contract*/, Decimal /*position*/, double /*avgCost*/) {}
+    void position(const std::string& account, const Contract& contract, Decimal position, double avgCost);
     void positionEnd() {}
     void accountSummary(int /*reqId*/, const std::string& /*account*/, const std::string& /*tag*/, const std::string& /*value*/, 
                         const std::string& /*currency*/) {}
@@ -126,16 +333,10 @@ public:
     void accountUpdateMulti(int /*reqId*/, const std::string& /*account*/, const std::string& /*modelCode*/, 
                             const std::string& /*key*/, const std::string& /*value*/, const std::string& /*currency*/) {}
     void accountUpdateMultiEnd(int /*reqId*/) {}
-    void securityDefinitionOptionalParameter(int /*reqId*/, const std::string& /*exchange*/, int /*underlyingConId*/,
-                                             const std::string& /*tradingClass*/, const std::string& /*multiplier*/,
-                                             const std::set<std::string>& /*expirations*/, const std::set<double>& /*strikes*/) {}
-    void securityDefinitionOptionalParameterEnd(int /*reqId*/) {}
     void softDollarTiers(int /*reqId*/, const std::vector<SoftDollarTier>& /*tiers*/) {}
     void familyCodes(const std::vector<FamilyCode>& /*familyCodes*/) {}
     void symbolSamples(int /*reqId*/, const std::vector<ContractDescription>& /*contractDescriptions*/) {}
     void mktDepthExchanges(const std::vector<DepthMktDataDescription>& /*depthMktDataDescriptions*/) {}
-    void tickNews(int /*tickerId*/, time_t /*timeStamp*/, const std::string& /*providerCode*/, const std::string& /*articleId*/, 
-                  const std::string& /*headline*/, const std::string& /*extraData*/) {}
     void smartComponents(int /*reqId*/, const SmartComponentsMap& /*theMap*/) {}
     void tickReqParams(int /*tickerId*/, double /*minTick*/, const std::string& /*bboExchange*/, int /*snapshotPermissions*/) {}
     void newsProviders(const std::vector<NewsProvider>& /*newsProviders*/) {}
@@ -145,16 +346,13 @@ public:
     void historicalNewsEnd(int /*requestId*/, bool /*hasMore*/) {}
     void headTimestamp(int /*reqId*/, const std::string& /*headTimestamp*/) {}
     void histogramData(int /*reqId*/, const HistogramDataVector& /*data*/) {}
-    void historicalDataUpdate(TickerId /*reqId*/, const Bar& /*bar*/) {}
+
     void rerouteMktDataReq(int /*reqId*/, int /*conid*/, const std::string& /*exchange*/) {}
     void rerouteMktDepthReq(int /*reqId*/, int /*conid*/, const std::string& /*exchange*/) {}
     void marketRule(int /*marketRuleId*/, const std::vector<PriceIncrement>& /*priceIncrements*/) {}
-    void pnl(int /*reqId*/, double /*dailyPnL*/, double /*unrealizedPnL*/, double /*realizedPnL*/) {}
-    void pnlSingle(int /*reqId*/, Decimal /*pos*/, double /*dailyPnL*/, double /*unrealizedPnL*/, double /*realizedPnL*/, double /*value*/) {}
+    void pnl(int reqId, double dailyPnL, double unrealizedPnL, double realizedPnL);
+    void pnlSingle(int reqId, Decimal pos, double dailyPnL, double unrealizedPnL, double realizedPnL, double value);
     void historicalTicks(int /*reqId*/, const std::vector<HistoricalTick>& /*ticks*/, bool /*done*/) {}
-    void historicalTicksBidAsk(int /*reqId*/, const std::vector<HistoricalTickBidAsk>& /*ticks*/, bool /*done*/) {}
-    void historicalTicksLast(int /*reqId*/, const std::vector<HistoricalTickLast>& /*ticks*/, bool /*done*/) {}
-    void tickByTickMidPoint(int /*reqId*/, time_t /*time*/, double /*midPoint*/) {}
     void orderBound(long long /*permId*/, int /*clientId*/, int /*orderId*/) {}
     void completedOrder(const Contract& /*contract*/, const Order& /*order*/, const OrderState& /*orderState*/) {}
     void completedOrdersEnd() {}
@@ -175,20 +373,336 @@ public:
     void errorProtoBuf(const protobuf::ErrorMessage& /*errorProto*/) {}
 
 private:
-    // ========== Data Flow: Callbacks → Queue → Redis Worker ==========
-    moodycamel::ConcurrentQueue<TickUpdate>& m_queue;  // Zero-copy enqueue from callbacks
+    // ========== Data Flow: Callbacks → Sink → Redis Worker ==========
+    // PERFORMANCE: Callbacks stage, processMessages() flushes (BasicIngestStage: one bulk enqueue per shard
+    // per processMsgs())
+    Sink m_sink;
+    
+    void dispatchMessages(std::chrono::milliseconds inlineWait);
+    bool enqueueUpdate(const TickUpdate& update);
+    TwsClientCounters m_counters;
+    TickJournal* m_journal = nullptr;                  // Audit / replay capture, before the enqueue
+    // Shared by the EWrapper callbacks and the fast path (timestamp in ms)
+    void emitBidAsk(int reqId, std::int64_t timestamp, double bidPrice, double askPrice,
+                    Quantity bidSize, Quantity askSize);
+    void emitAllLast(int reqId, std::int64_t timestamp, double price, Quantity size, bool pastLimit,
+                     ExchangeCode exchange = kUnknownExchange, TradeConditions conditions = 0);
+    void emitDepth(int reqId, int position, int operation, int side, double price, std::int64_t size);
+    void emitMidPoint(int reqId, std::int64_t timestamp, double midPoint);
+    void emitGreeks(SlotId slot, std::uint32_t leg, std::uint32_t expiry, bool put, double strike,
+                    double impliedVol, double delta, double gamma, double vega, double theta, double optionPrice,
+                    double underlyingPrice);
+    
+    // ========== Latency Stamps ==========
+    std::atomic<bool> m_latencyStamps{false};
+    // Callback entry stamp, 0 when stamping is off
+    std::int64_t latencyEntry() const {
+        return m_latencyStamps.load(std::memory_order_relaxed) ? latencyNowNs() : 0;
+    }
+    // Writes ingest + enqueue stamps right before the update is enqueued
+    void stampUpdate(TickUpdate& update, std::int64_t entryNs) {
+        if (entryNs != 0) {
+            TickStamps* stamps = update.stamps();
+            const std::int64_t nowNs = latencyNowNs();
+            stamps->ingestNs = entryNs;
+            stamps->enqueueNs = static_cast<std::uint32_t>(nowNs - entryNs);
+            if (m_trace && --m_traceCountdown == 0) {
+                m_traceCountdown = m_trace->config().sampleEvery;
+                stamps->traceId = m_trace->nextTraceId();
+                m_trace->record(TraceStage::Enqueue, entryNs, nowNs, stamps->traceId, update.slot);
+            }
+        }
+    }
+    // Receive stamp of the tick being emitted: its frame's socket read (BridgeReader), else now
+    // NOTE: ReaderMode::TwsApi - the vendored EReader has no hook, callback entry is the closest point
+    std::int64_t receiveStamp() const {
+        return m_bridgeReader ? m_bridgeReader->receiveNs() : receiveClock().nowNs();
+    }
+    TraceExport* m_trace = nullptr;
+    std::uint32_t m_traceCountdown = 0;                // Message thread: stamped updates until the next sample
+    
+    // ========== L1 Aggregation (reqMktData) ==========
+    // TWS sends L1 field by field - the latest quote per slot is rebuilt here, each change is
+    // emitted as the same BidAsk / AllLast update a tick-by-tick stream produces
+    // REASON: Message thread only (every callback runs there) - plain fields, no atomics
+    struct TopOfBook {
+        double bidPrice = 0.0;
+        double askPrice = 0.0;
+        double lastPrice = 0.0;
+        Quantity bidSize;
+        Quantity askSize;
+        bool lastPastLimit = false;
+    };
+    std::vector<TopOfBook> m_topOfBook;                      // By slot, sized once to the registry
+    // price: TICK_PRICE (nullptr for TICK_SIZE), size: paired or standalone size (nullptr if none yet)
+    void applyTopOfBook(int reqId, int tickType, const double* price, const Quantity* size, bool pastLimit);
+    
+    // ========== Historical Bars ==========
+    BarTimeParser m_barTime;                     // Bar.time → ms (message thread only, caches zone + DST)
+    // By reqId: BarSize code stamped on each bar (written before the request is published)
+    std::vector<std::atomic<BarSize>> m_barSizes;
+    void setBarSize(int tickerId, BarSize size);
+    BarSize barSizeOf(TickerId reqId) const;
     
+    // ========== Outbound Pacing ==========
+    RequestPacer m_pacer;                        // REASON: TWS 50 msg/s + tick-by-tick stream limits
+    std::size_t m_maxTickByTick;                 // FeedType::Auto falls back to L1 beyond it (0 = unlimited)
+    
+    // Paced request that opens a subscription, kept to resubmit it as-is on a new session
+    struct Replay {
+        int priority;
+        unsigned cost;
+        int streams;
+        std::function<void()> send;
+    };
+    RequestPacer::Ticket submit(const Replay& replay) {
+        return m_pacer.submit(replay.priority, replay.cost, replay.streams, replay.send);
+    }
+    
+    // REASON: Declared before the reader - destroyed after its thread is joined
+    Heartbeat m_readerHeartbeat;
+    Heartbeat m_dispatchHeartbeat;
+
     // ========== TWS API Components ==========
     std::unique_ptr<EReaderOSSignal> m_signal;   // Thread synchronization primitive
-    std::unique_ptr<EClientSocket> m_client;     // Command interface (sends to TWS)
+    std::unique_ptr<CorkedClientSocket> m_client; // Command interface (sends to TWS, pacing bursts corked)
     std::unique_ptr<EReader> m_reader;           // Socket reader thread (receives from TWS)
+    std::unique_ptr<BridgeReader> m_bridgeReader; // BridgeRing / Inline replacement for m_reader
+    ReaderMode m_readerMode = ReaderMode::TwsApi;
+    ThreadConfig m_readerThread;
+    SocketTuning m_socketTuning;
+    std::chrono::milliseconds m_readerPoll{100};
+    MessageFilter m_messageFilter;
     
     // ========== Connection State ==========
-    std::atomic<bool> m_connected{false};
+    // PERFORMANCE: Own cache line - written on (re)connect by the msgThread, polled by main; never on the
+    // line of the routing table the callbacks read per tick
+    alignas(64) std::atomic<bool> m_connected{false};
+    std::atomic<bool> m_connectionLost{false};
     std::atomic<OrderId> m_nextValidOrderId{0};
+    std::atomic<bool> m_ready{false};            // nextValidId seen this session (gates m_pacer.pump())
+    std::atomic<std::chrono::steady_clock::rep> m_readyAt{0};  // steady_clock ticks, stored before m_ready
+    // Reconnect target (createConnection() arguments), message thread only afterwards
+    std::string m_host;
+    unsigned int m_port = 0;
+    int m_clientId = 0;
+    ReaderMode m_requestedReaderMode = ReaderMode::TwsApi;  // REASON: m_readerMode may have fallen back
+    ReconnectPolicy m_reconnectPolicy;
+    bool m_replayRequested = false;              // Error 1101 seen (message thread only)
+    
+    bool openConnection();
+    void releaseConnection();
+    // New session: drops obsolete cancels, resubmits every active subscription (returns count)
+    std::size_t replaySubscriptions();
     
     // ========== Symbol Routing ==========
-    std::unordered_map<int, std::string> m_tickerToSymbol;  // tickerId → symbol lookup
+    InstrumentRegistry& m_registry;                          // symbol ↔ dense slot
+    alignas(64) RequestTable m_requests;                     // tickerId → slot (flat, atomic entries)
+    std::mutex m_subscribeMutex;                             // Serializes subscribers only (cold path)
+    
+    // PERFORMANCE: Callbacks only ever do m_requests.lookup() - subscribe / unsubscribe publish or
+    // clear individual atomic entries, readers never lock and never see a torn table
+    struct Subscription {
+        int tickerId;                                        // BidAsk id (AllLast = +10000) / reqMktData id
+        RequestPacer::Ticket ticket;                         // Withdrawn instead of cancelled if unsent
+        FeedType feed;                                       // TickByTick, TopOfBook or MidPoint
+        Replay replay;
+        std::shared_ptr<const Contract> contract;            // As subscribed - the gap backfill asks for the same
+    };
+    std::unordered_map<std::string, Subscription> m_subscriptions;  // By symbol (m_subscribeMutex)
+    std::size_t m_tickByTickStreams = 0;                     // Requested streams, 2 per symbol, 1 per midpoint (m_subscribeMutex)
+    struct DepthSubscription {
+        int tickerId;
+        RequestPacer::Ticket ticket;
+        bool smartDepth;                                     // cancelMktDepth must repeat it
+        Replay replay;
+    };
+    std::unordered_map<std::string, DepthSubscription> m_depth;  // By symbol (m_subscribeMutex)
+    // REASON: reqRealTimeBars is a stream too - replayed after a reconnect (historical bars are one-shot,
+    // unless keepUpToDate)
+    struct BarSubscription {
+        RequestPacer::Ticket ticket;
+        Replay replay;
+    };
+    std::unordered_map<int, BarSubscription> m_realTimeBars;  // By tickerId (m_subscribeMutex)
+    // REASON: Own id range - past the tick ids (< 20000) and the startup bar ids, inside the RequestTable
+    static constexpr int kHistoryReqIdBase = 40000;
+    int m_nextHistoryReqId = kHistoryReqIdBase;              // Wraps at RequestTable capacity (m_subscribeMutex)
+    int m_nextCommandTickerId = 1;                           // Dynamic ids (m_subscribeMutex)
+    
+    // ========== Contract Resolution (cold path) ==========
+    // REASON: Own id range - contract details never collide with tickerIds (< 20000) or bar requests
+    static constexpr int kContractReqIdBase = 1000000;
+    ContractCache* m_contractCache = nullptr;
+    std::chrono::seconds m_contractMaxAge{0};
+    struct ContractLookup {
+        std::string symbol;
+        int answers = 0;                                     // > 1: ambiguous, the first one is kept
+    };
+    std::unordered_map<int, ContractLookup> m_contractLookups;  // By reqId (m_subscribeMutex)
+    std::unordered_map<std::string, int> m_resolving;        // Symbol → reqId in flight (m_subscribeMutex)
+    int m_nextContractReqId = kContractReqIdBase;            // (m_subscribeMutex)
+    
+    SlotId registerRequest(const std::string& symbol, int tickerId);
+    bool mapRequest(int reqId, SlotId slot);
+    // Fills conId / primaryExchange from the cache, queues a lookup on a miss or stale entry
+    void resolveContract(Contract& contract, SlotId slot);
+    void finishContractLookup(int reqId, bool failed);
+    void requestTickByTick(Contract contract, int tickerId, int priority);
+    void requestMarketData(Contract contract, int tickerId, int priority);
+    void requestMidPoint(Contract contract, int tickerId, int priority);
+    
+    // ========== Option Chains (cold path, except the leg routes) ==========
+    // REASON: Own id ranges - secdef requests and leg lines never collide with tickerIds or contract lookups
+    static constexpr int kChainReqIdBase = 2000000;
+    static constexpr int kOptionTickerIdBase = 3000000;
+    struct OptionLegRoute {
+        SlotId slot = kInvalidSlot;                          // Underlying's slot, kInvalidSlot = unrouted
+        std::uint32_t leg = 0;                               // ChainSelection numbering
+        std::uint32_t expiry = 0;                            // YYYYMMDD
+        bool put = false;
+        double strike = 0.0;
+    };
+    // By tickerId - kOptionTickerIdBase: one block of ids per started chain, never reused
+    // REASON: Message thread only (secdef callback, commands, greeks ticks) - a flat array, no lock per tick
+    std::vector<OptionLegRoute> m_optionLegs;
+    int m_nextOptionTickerId = kOptionTickerIdBase;
+    struct ChainSubscription {
+        SlotId slot = kInvalidSlot;
+        ChainRequest request;
+        int priority = 0;
+        bool awaitingConId = false;                          // Contract lookup in flight (contractDetails)
+        int definitionReqId = 0;                             // reqSecDefOptParams unanswered, 0 otherwise
+        RequestPacer::Ticket definitionTicket = 0;
+        int conId = 0;
+        OptionChainLayout layout;                            // Best row so far (chainRowRank)
+        int layoutRank = -1;
+        ChainSelection selection;                            // Empty until the legs are started
+        int firstTickerId = 0;
+        std::vector<RequestPacer::Ticket> tickets;           // By leg
+        std::vector<bool> listed;                            // By leg, cleared by error 200 (not replayed)
+    };
+    std::unordered_map<std::string, ChainSubscription> m_chains;  // By underlying (m_subscribeMutex)
+    std::unordered_map<int, std::string> m_chainDefinitions;      // reqId → underlying (m_subscribeMutex)
+    int m_nextChainReqId = kChainReqIdBase;                       // (m_subscribeMutex)
+    OptionChainCache m_chainCache;
+    // Callers hold m_subscribeMutex
+    void requestChainDefinition(const std::string& symbol, ChainSubscription& chain);
+    bool startChainLegs(const std::string& symbol, ChainSubscription& chain);  // false: nothing to stream
+    RequestPacer::Ticket submitChainLeg(const std::string& symbol, const ChainSubscription& chain,
+                                        std::uint32_t leg);
+    void dropChain(std::string symbol, const char* reason);
+    
+    // ========== Gap Backfill ==========
+    // REASON: Own id range, after the option legs
+    static constexpr int kBackfillReqIdBase = 4000000;
+    BackfillPolicy m_backfillPolicy;
+    // By slot, message thread only: TWS time of the newest live quote / trade, gap open until the next one
+    // PERFORMANCE: One store + one load on the same entry per tick - the open gap is the rare branch
+    struct TickWatermark {
+        std::int64_t lastMs = 0;
+        bool gapOpen = false;
+    };
+    std::vector<TickWatermark> m_watermarks;                 // Sized once to the registry
+    struct OpenGap {
+        std::int64_t lastMs;
+        std::shared_ptr<const Contract> contract;
+    };
+    std::unordered_map<SlotId, OpenGap> m_openGaps;          // Replayed, no live tick yet (message thread)
+    struct BackfillJob {
+        SlotId slot;
+        std::shared_ptr<const Contract> contract;
+        GapWindow window;
+        bool trades;                                         // TRADES, else BID_ASK
+        std::int64_t startSeconds = 0;                       // Current page
+        std::size_t pages = 0;
+        std::size_t ticks = 0;                               // Inside the window so far
+        RequestPacer::Ticket ticket = 0;
+    };
+    std::unordered_map<int, BackfillJob> m_backfillJobs;     // By reqId (message thread)
+    int m_nextBackfillReqId = kBackfillReqIdBase;
+    void noteLiveTick(SlotId slot, std::int64_t timestamp) {
+        TickWatermark& mark = m_watermarks[slot];
+        if (mark.gapOpen) {
+            closeGap(slot, timestamp);
+        }
+        mark.lastMs = timestamp;
+    }
+    void openGaps();
+    void closeGap(SlotId slot, std::int64_t firstLiveMs);
+    void submitBackfill(int reqId, BackfillJob& job);
+    void finishBackfillPage(int reqId, std::size_t pageTicks, std::int64_t lastTickSeconds);
+
+    // ========== Account ==========
+    // REASON: Own id range, after the backfill jobs - reqPnL takes the base, reqPnLSingle the ids above it
+    static constexpr int kAccountReqIdBase = 5000000;
+    AccountQueue* m_accountFeed = nullptr;                   // subscribeAccount (m_subscribeMutex), then read-only
+    std::string m_accountId;                                 // As subscribed, "" = m_managedAccount
+    Replay m_accountReplay;
+    RequestPacer::Ticket m_accountTicket = 0;
+    std::string m_managedAccount;                            // First of managedAccounts (message thread)
+    std::string m_account;                                   // Requested this session (message thread)
+    std::unordered_map<int, int> m_pnlSingleReqIds;          // conId → reqPnLSingle id (message thread)
+    std::unordered_map<int, int> m_pnlSingleConIds;          // reqPnLSingle id → conId (message thread)
+    int m_nextPnlSingleReqId = kAccountReqIdBase + 1;
+    void requestPnlSingle(int conId);
+    void emitAccount(AccountUpdate&& update) { m_accountFeed->enqueue(std::move(update)); }
+
+    // ========== Market Scanner ==========
+    // REASON: Own id range, after the account requests - scan i is kScannerReqIdBase + i
+    static constexpr int kScannerReqIdBase = 6000000;
+    ScanOutbox* m_scanOutbox = nullptr;                      // subscribeScanners (m_subscribeMutex), then read-only
+    std::vector<Replay> m_scanReplays;                       // By scan
+    std::vector<RequestPacer::Ticket> m_scanTickets;
+    std::vector<ScanCycle> m_scanCycles;                     // Being filled, by scan (message thread)
+    std::size_t scanIndex(int reqId) const {
+        const auto index = static_cast<std::size_t>(reqId - kScannerReqIdBase);
+        return reqId >= kScannerReqIdBase && index < m_scanCycles.size() ? index : m_scanCycles.size();
+    }
+
+    // ========== Session Statistics Seed ==========
+    // REASON: Own id range, after the scanner - the seed of slot s is kSessionSeedReqIdBase + s
+    static constexpr int kSessionSeedReqIdBase = 7000000;
+    bool m_sessionSeeding = false;
+    struct SessionSeed {
+        RequestPacer::Ticket ticket;
+        Replay replay;
+        bool answered = false;                               // historicalDataEnd or an error - never asked again
+    };
+    std::unordered_map<SlotId, SessionSeed> m_sessionSeeds;  // By slot (m_subscribeMutex)
+    SlotId seedSlot(int reqId) const {
+        return reqId >= kSessionSeedReqIdBase && reqId - kSessionSeedReqIdBase < static_cast<int>(m_registry.capacity())
+            ? static_cast<SlotId>(reqId - kSessionSeedReqIdBase) : kInvalidSlot;
+    }
+    void requestSessionSeed(SlotId slot, const Contract& contract);  // Callers hold m_subscribeMutex
+    void finishSessionSeed(SlotId slot);
+
+    // ========== News ==========
+    // REASON: Own id range, after the session seeds - the news line of symbol i is kNewsTickerIdBase + i
+    static constexpr int kNewsTickerIdBase = 8000000;
+    NewsLane* m_newsLane = nullptr;                          // subscribeNews (m_subscribeMutex), then read-only
+    std::vector<std::string> m_newsSymbols;                  // By news line
+    std::vector<Replay> m_newsReplays;
+    std::vector<RequestPacer::Ticket> m_newsTickets;
+    std::size_t newsIndex(int tickerId) const {
+        const auto index = static_cast<std::size_t>(tickerId - kNewsTickerIdBase);
+        return tickerId >= kNewsTickerIdBase && index < m_newsSymbols.size() ? index : m_newsSymbols.size();
+    }
+
+    void applyCommand(const SubscriptionCommand& command);
+    int allocateTickerId();
 };
 
+extern template class BasicTwsClient<BasicIngestStage<MpmcTickQueue>>;
+extern template class BasicTwsClient<BasicIngestStage<SpscTickQueue>>;
+extern template class BasicTwsClient<QueueSink<SpscTickQueue>>;
+extern template class BasicTwsClient<CoalescingSink<QueueSink<SpscTickQueue>>>;
+extern template class BasicTwsClient<JournalTee<BasicIngestStage<SpscTickQueue>>>;
+
+// Production client: staged, sharded ingest (Queue per shard: MpmcTickQueue or SpscTickQueue)
+template <typename Queue>
+using ShardedTwsClient = BasicTwsClient<BasicIngestStage<Queue>>;
+using TwsClient = ShardedTwsClient<MpmcTickQueue>;
+using SpscTwsClient = ShardedTwsClient<SpscTickQueue>;
+
 } // namespace tws_bridge
@@ -0,0 +1,120 @@
+// UniverseWatcher.h - Symbol universe from a file or a Redis set, applied as subscription diffs
+// SCOPE: Own thread (+ own Redis connection for universe.key); hands diffs to main()'s command routing
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge {
+
+// subscriptions.universe_file / universe_key: the symbols the bridge should be subscribed to, kept in
+// sync while it runs (subscriptions.symbols stay subscribed regardless)
+struct UniverseConfig {
+    std::string path;                                // "" = off; one symbol per line, # comments
+    std::string key;                                 // "" = off; Redis SET of symbols (SMEMBERS)
+    std::chrono::milliseconds pollInterval{5000};    // File stat / SMEMBERS period
+    std::chrono::milliseconds socketTimeout{500};
+};
+
+// Lifetime counters (written by the watcher thread, readable from any thread)
+struct UniverseCounters {
+    std::atomic<std::uint64_t> loads{0};             // Universe versions applied
+    std::atomic<std::uint64_t> added{0};             // Subscribes issued
+    std::atomic<std::uint64_t> removed{0};           // Cancels issued
+    std::atomic<std::uint64_t> errors{0};
+    std::atomic<std::uint64_t> size{0};              // Symbols in the current universe (gauge)
+};
+
+struct UniverseDiff {
+    std::vector<std::string> added;
+    std::vector<std::string> removed;
+};
+
+// Symbols of a universe file: whitespace / comma separated, "#" to end of line is a comment
+// Returns them sorted, duplicates removed
+inline std::vector<std::string> parseUniverse(std::string_view text) {
+    std::vector<std::string> symbols;
+    while (!text.empty()) {
+        const std::size_t start = text.find_first_not_of(" ,\t\r\n");
+        if (start == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(start);
+        if (text.front() == '#') {
+            const std::size_t end = text.find('\n');
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end);
+            continue;
+        }
+        const std::size_t length = std::min(text.find_first_of(" ,\t\r\n#"), text.size());
+        symbols.emplace_back(text.substr(0, length));
+        text.remove_prefix(length);
+    }
+    std::sort(symbols.begin(), symbols.end());
+    symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+    return symbols;
+}
+
+// What changes from current to next (both sorted, unique), leaving out the pinned symbols (sorted)
+// PERFORMANCE: Two merges over sorted lists - a 2,000-symbol universe changed by 10 names yields 10 commands
+inline UniverseDiff diffUniverse(const std::vector<std::string>& current, const std::vector<std::string>& next,
+                                 const std::vector<std::string>& pinned = {}) {
+    UniverseDiff diff;
+    std::vector<std::string> changed;
+    std::set_difference(next.begin(), next.end(), current.begin(), current.end(), std::back_inserter(changed));
+    std::set_difference(changed.begin(), changed.end(), pinned.begin(), pinned.end(), std::back_inserter(diff.added));
+    changed.clear();
+    std::set_difference(current.begin(), current.end(), next.begin(), next.end(), std::back_inserter(changed));
+    std::set_difference(changed.begin(), changed.end(), pinned.begin(), pinned.end(), std::back_inserter(diff.removed));
+    return diff;
+}
+
+// ARCHITECTURE: Only diffs leave this class - the subscribes / cancels take the TWS:COMMANDS path
+// (command queues, then the connection's RequestPacer), never a full resubscribe
+// PITFALL: A universe that cannot be read (missing file, Redis error) is skipped, not treated as empty -
+// a bad deploy must not cancel every subscription
+class UniverseWatcher {
+public:
+    using Apply = std::function<void(const UniverseDiff&)>;
+
+    // pinned: subscriptions.symbols (never added or cancelled through the universe)
+    UniverseWatcher(const std::string& uri, UniverseConfig config, std::vector<std::string> pinned, Apply apply);
+    ~UniverseWatcher();
+
+    UniverseWatcher(const UniverseWatcher&) = delete;
+    UniverseWatcher& operator=(const UniverseWatcher&) = delete;
+
+    // First load on the calling thread (startup), false if the universe could not be read (logged)
+    bool load();
+    void start();
+    void stop();
+
+    const UniverseCounters& counters() const { return m_counters; }
+
+private:
+    void run();
+    // True with next filled if the universe changed since the last read
+    bool readFile(std::vector<std::string>& next);
+    void applyNext(std::vector<std::string> next);
+
+    std::string m_uri;
+    UniverseConfig m_config;
+    std::vector<std::string> m_pinned;               // Sorted
+    Apply m_apply;
+    UniverseCounters m_counters;
+    std::vector<std::string> m_current;              // Last applied universe (sorted)
+    std::int64_t m_fileStamp = -1;                   // mtime (ns) of the last file read
+    std::int64_t m_fileSize = -1;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,194 @@
+// VolumeProfile.h - Session volume at price per instrument, kept as trades arrive and published as
+// throttled deltas of the buckets that changed (TWS:PROFILE:{SYMBOL})
+// SCOPE: Redis Worker thread (one VolumeProfile per traded slot, moved with the slot when rebalancing)
+
+#pragma once
+
+#include "DerivedMetrics.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+// worker.volume_profile
+struct VolumeProfileConfig {
+    bool enabled = false;
+    double bucketWidth = 0.01;                      // Price units per bucket (a tick, or coarser)
+    std::size_t chunkBuckets = 64;                  // Growth step when a trade lands past either end
+    std::size_t maxBuckets = 4096;                  // Past it, trades fold into the edge bucket
+    std::chrono::milliseconds interval{1000};       // Publish throttle (a slot publishes at most once per interval)
+    std::chrono::minutes sessionReset{9 * 60};      // Follows worker.derived_metrics.session_reset
+};
+
+// One slot's session profile: fixed-width buckets centered on the session's first trade
+// PERFORMANCE:
+// - A trade is an index computation and an add - O(1), no search, no map
+// - The array grows by whole chunks at the end a trade fell past - a trending session reallocates once
+//   per chunk, not per new price
+// - Changed buckets are listed once each, a delta walks only them
+// NOTE: Buckets hold the session total, not increments - a consumer that missed a delta is repaired by
+// the next one touching the bucket, or by the full profile (GET TWS:PROFILE:{SYMBOL})
+class VolumeProfile {
+public:
+    VolumeProfile(const VolumeProfileConfig& config, std::string channel)
+        : m_channel(std::move(channel))
+        , m_width(config.bucketWidth > 0.0 ? config.bucketWidth : 0.01)
+        , m_chunk(std::max<std::size_t>(1, config.chunkBuckets))
+        , m_max(std::max(m_chunk, config.maxBuckets))
+        , m_sessionResetMs(std::chrono::duration_cast<std::chrono::milliseconds>(config.sessionReset).count()) {
+        // REASON: Decimals of the bucket width - prices print as 100.05, not 100.05000000000001
+        for (double step = m_width; m_decimals < 8 && std::abs(step - std::round(step)) > 1e-9; step *= 10.0) {
+            ++m_decimals;
+        }
+    }
+
+    void onTrade(std::int64_t timestampMs, double price, std::int64_t size) {
+        if (!(price > 0.0) || size <= 0) {
+            return;
+        }
+        const std::int64_t session = sessionNumber(timestampMs, m_sessionResetMs);
+        if (session != m_session || m_volumes.empty()) {
+            startSession(session, price);
+        }
+        std::int64_t bucket = std::llround((price - m_open) / m_width);
+        if (bucket < m_low || bucket >= m_low + static_cast<std::int64_t>(m_volumes.size())) {
+            bucket = grow(bucket);
+        }
+        const std::size_t index = static_cast<std::size_t>(bucket - m_low);
+        m_volumes[index] += size;
+        m_total += size;
+        if (m_changedFlags[index] == 0) {
+            m_changedFlags[index] = 1;
+            m_changed.push_back(bucket);
+        }
+    }
+
+    bool changed() const { return !m_changed.empty() || m_reset; }
+    const std::string& channel() const { return m_channel; }
+    std::size_t buckets() const { return m_volumes.size(); }
+    std::int64_t volumeAt(double price) const {
+        const std::int64_t bucket = std::llround((price - m_open) / m_width) - m_low;
+        return bucket >= 0 && bucket < static_cast<std::int64_t>(m_volumes.size())
+            ? m_volumes[static_cast<std::size_t>(bucket)] : 0;
+    }
+
+    // {"instrument","session","open","width","seq","total","reset","buckets":[[price,volume],...]}
+    // full = every non-empty bucket (the stored profile), otherwise the changed ones; a delta ends the
+    // round (seq moves on, changes are cleared)
+    // NOTE: "reset" = a new session started, consumers drop the buckets they hold
+    void encode(std::string_view symbolJson, bool full, std::string& out) {
+        out.clear();
+        out += "{\"instrument\":";
+        out.append(symbolJson.data(), symbolJson.size());
+        out += ",\"session\":";
+        appendInt(out, m_session);
+        out += ",\"open\":";
+        appendPrice(out, m_open);
+        out += ",\"width\":";
+        appendPrice(out, m_width);
+        out += ",\"seq\":";
+        appendInt(out, static_cast<std::int64_t>(full ? m_seq : m_seq + 1));
+        out += ",\"total\":";
+        appendInt(out, m_total);
+        if (m_reset || full) {
+            out += ",\"reset\":true";
+        }
+        out += ",\"buckets\":[";
+        bool first = true;
+        auto bucket = [&](std::int64_t number) {
+            out += first ? "[" : ",[";
+            first = false;
+            appendPrice(out, m_open + static_cast<double>(number) * m_width);
+            out += ',';
+            appendInt(out, m_volumes[static_cast<std::size_t>(number - m_low)]);
+            out += ']';
+        };
+        if (full) {
+            for (std::size_t i = 0; i < m_volumes.size(); ++i) {
+                if (m_volumes[i] != 0) {
+                    bucket(m_low + static_cast<std::int64_t>(i));
+                }
+            }
+        } else {
+            std::sort(m_changed.begin(), m_changed.end());
+            for (std::int64_t number : m_changed) {
+                bucket(number);
+                m_changedFlags[static_cast<std::size_t>(number - m_low)] = 0;
+            }
+            m_changed.clear();
+            m_reset = false;
+            ++m_seq;
+        }
+        out += "]}";
+    }
+
+private:
+    void startSession(std::int64_t session, double open) {
+        m_session = session;
+        m_open = open;
+        m_low = -static_cast<std::int64_t>(m_chunk / 2);
+        m_volumes.assign(m_chunk, 0);  // NOTE: Keeps the capacity of the previous session
+        m_changedFlags.assign(m_chunk, 0);
+        m_changed.clear();
+        m_total = 0;
+        m_reset = true;
+    }
+
+    // Extends the array by whole chunks towards bucket, or folds it into the edge bucket at maxBuckets
+    std::int64_t grow(std::int64_t bucket) {
+        const auto size = static_cast<std::int64_t>(m_volumes.size());
+        const auto chunk = static_cast<std::int64_t>(m_chunk);
+        const std::int64_t room = static_cast<std::int64_t>(m_max) - size;
+        if (bucket < m_low) {
+            const std::int64_t add = std::min(room, (m_low - bucket + chunk - 1) / chunk * chunk);
+            m_volumes.insert(m_volumes.begin(), static_cast<std::size_t>(add), 0);
+            m_changedFlags.insert(m_changedFlags.begin(), static_cast<std::size_t>(add), 0);
+            m_low -= add;
+            return std::max(bucket, m_low);
+        }
+        const std::int64_t high = m_low + size;
+        const std::int64_t add = std::min(room, (bucket - high + chunk) / chunk * chunk);
+        m_volumes.resize(m_volumes.size() + static_cast<std::size_t>(add), 0);
+        m_changedFlags.resize(m_volumes.size(), 0);
+        return std::min(bucket, m_low + static_cast<std::int64_t>(m_volumes.size()) - 1);
+    }
+
+    static void appendInt(std::string& out, std::int64_t value) {
+        char number[24];
+        const std::to_chars_result result = std::to_chars(number, number + sizeof(number), value);
+        out.append(number, static_cast<std::size_t>(result.ptr - number));
+    }
+
+    void appendPrice(std::string& out, double value) const {
+        char number[48];
+        const std::to_chars_result result = std::to_chars(number, number + sizeof(number), value,
+                                                          std::chars_format::fixed, m_decimals);
+        out.append(number, static_cast<std::size_t>(result.ptr - number));
+    }
+
+    std::string m_channel;                          // "TWS:PROFILE:{SYMBOL}" (PUBLISH deltas, SET full)
+    double m_width;
+    std::size_t m_chunk;
+    std::size_t m_max;
+    std::int64_t m_sessionResetMs;
+    int m_decimals = 0;
+    std::int64_t m_session = 0;
+    double m_open = 0.0;                            // Session's first trade, center of bucket 0
+    std::int64_t m_low = 0;                         // Bucket number of m_volumes[0]
+    std::vector<std::int64_t> m_volumes;
+    std::vector<std::uint8_t> m_changedFlags;       // Parallel to m_volumes: listed in m_changed
+    std::vector<std::int64_t> m_changed;            // Bucket numbers changed since the last delta
+    std::int64_t m_total = 0;
+    std::uint64_t m_seq = 0;                        // Deltas published
+    bool m_reset = false;
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,148 @@
+// WaitStrategy.h - Consumer idle strategy (busy-spin / hybrid / blocking / reactor)
+// SCOPE: Shared by producer (TwsClient callbacks) and consumer (RedisWorker)
+
+#pragma once
+
+#include "ShardReactor.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <lightweightsemaphore.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace tws_bridge {
+
+enum class WaitMode {
+    BusySpin,  // Lowest latency, burns one core
+    Hybrid,    // Spin N iterations → yield → park
+    Blocking,  // Park immediately, lowest CPU usage
+    Reactor    // Park immediately in epoll (ShardReactor): woken by the producer or the consumer's next deadline
+};
+
+struct WaitConfig {
+    WaitMode mode = WaitMode::Hybrid;
+    std::uint32_t spinIterations = 2000;            // Hybrid: pause-loop iterations before yielding
+    std::uint32_t yieldIterations = 50;             // Hybrid: sched_yield() calls before parking
+    std::chrono::microseconds parkTimeout{1000};    // Max park time (bounds shutdown/flush latency)
+};
+
+// PERFORMANCE: CPU hint for spin loops (reduces power + pipeline flush on exit)
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Consumer-side idle strategy with producer wake-up
+// REASON: Producer pays one relaxed-cost atomic load per enqueue, signals ONLY when consumer is parked
+class ConsumerWaiter {
+public:
+    explicit ConsumerWaiter(WaitConfig config = {}) : m_config(config) {
+        if (m_config.mode == WaitMode::Reactor) {
+            m_reactor = std::make_unique<ShardReactor>();
+            if (!m_reactor->valid()) {
+                m_reactor.reset();  // REASON: No epoll / eventfd / timerfd - parks on the semaphore instead
+            }
+        }
+    }
+
+    ConsumerWaiter(const ConsumerWaiter&) = delete;
+    ConsumerWaiter& operator=(const ConsumerWaiter&) = delete;
+
+    // ========== Producer side (after a successful enqueue) ==========
+    void notify() {
+        // REASON: seq_cst pairs with the consumer's store + queue re-check (no lost wake-up)
+        if (m_parked.load(std::memory_order_seq_cst) && m_parked.exchange(false, std::memory_order_seq_cst)) {
+            if (m_reactor) {
+                m_reactor->wake();
+            } else {
+                m_semaphore.signal();
+            }
+        }
+    }
+
+    // ========== Consumer side ==========
+    // Called after an empty dequeue. hasWork() re-checks the queue before parking.
+    // deadline: the consumer's next timer (Reactor mode wakes exactly then, others ignore it)
+    template <typename HasWork>
+    void idle(HasWork&& hasWork, std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()) {
+        switch (m_config.mode) {
+        case WaitMode::BusySpin:
+            cpuRelax();
+            return;
+        case WaitMode::Hybrid:
+            if (m_idleRounds < m_config.spinIterations) {
+                ++m_idleRounds;
+                cpuRelax();
+                return;
+            }
+            if (m_idleRounds < m_config.spinIterations + m_config.yieldIterations) {
+                ++m_idleRounds;
+                std::this_thread::yield();
+                return;
+            }
+            park(hasWork, deadline);
+            return;
+        case WaitMode::Blocking:
+        case WaitMode::Reactor:
+            park(hasWork, deadline);
+            return;
+        }
+    }
+
+    // Called after a successful dequeue (restart spin phase)
+    void reset() { m_idleRounds = 0; }
+
+    std::uint64_t parkCount() const { return m_parks; }
+    const WaitConfig& config() const { return m_config; }
+    // Reactor mode only (nullptr otherwise) - consumer thread adds its other fds here
+    ShardReactor* reactor() { return m_reactor.get(); }
+
+private:
+    template <typename HasWork>
+    void park(HasWork& hasWork, std::chrono::steady_clock::time_point deadline) {
+        m_parked.store(true, std::memory_order_seq_cst);
+        
+        // PITFALL: Producer may have enqueued before seeing m_parked - re-check before sleeping
+        if (hasWork()) {
+            m_parked.store(false, std::memory_order_relaxed);
+            return;
+        }
+        
+        ++m_parks;
+        if (m_reactor) {
+            // NOTE: parkTimeout still caps the wait - conflation / aggregate windows and pipeline flushes
+            // are not timers yet
+            const auto cap = std::chrono::steady_clock::now() + m_config.parkTimeout;
+            m_reactor->wait(deadline < cap ? deadline : cap);
+            // REASON: A racing wake() stays in the eventfd - at most one spurious wake-up, like below
+            m_parked.store(false, std::memory_order_seq_cst);
+            return;
+        }
+        bool signalled = m_semaphore.wait(static_cast<std::int64_t>(m_config.parkTimeout.count()));
+        if (!signalled) {
+            // REASON: Timed out - withdraw; a racing signal costs at most one spurious wake-up
+            if (!m_parked.exchange(false, std::memory_order_seq_cst)) {
+                m_semaphore.tryWait();
+            }
+        }
+    }
+
+    WaitConfig m_config;
+    // PERFORMANCE: Own cache line - a spinning consumer bumps m_idleRounds every pause, the producer
+    // reads m_parked on every enqueue; sharing a line would turn each notify() into a miss
+    alignas(64) std::uint32_t m_idleRounds = 0;      // Consumer thread only
+    std::uint64_t m_parks = 0;           // Consumer thread only
+    alignas(64) std::atomic<bool> m_parked{false};
+    moodycamel::LightweightSemaphore m_semaphore;
+    std::unique_ptr<ShardReactor> m_reactor;         // Reactor mode
+};
+
+} // namespace tws_bridge
@@ -0,0 +1,43 @@
+// WarmStart.h - Instrument state rebuilt from the Redis last-value cache (TWS:LVC:*) at startup
+// SCOPE: Main thread before the workers start (own Redis connection) - cold path
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "LastValueHash.h"
+#include "MarketData.h"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace tws_bridge {
+
+struct WarmStartConfig {
+    // Needs WorkerConfig::writeLastValue on in the previous run - without TWS:LVC:* keys nothing is restored
+    bool enabled = true;
+    std::size_t keysPerRequest = 512;                    // Keys per MGET / HGETALL pipeline (one round trip each)
+    LastValueFormat format = LastValueFormat::Json;      // As written (WorkerConfig::lastValueFormat)
+    std::chrono::milliseconds socketTimeout{1000};
+};
+
+// Quote / trade fields of a published snapshot (either SnapshotSchema, either PriceFormat) into state:
+// sequence, prices, sizes, timestamps, exchange, conditions, pastLimit, conId, primaryExchange
+// hasQuote / hasTrade follow the snapshot's quote / trade timestamps (0 = never seen)
+// false if data is not a snapshot object; symbol, tickerId and derived metrics are left alone
+bool parseLastValue(const char* data, std::size_t length, InstrumentState& state);
+
+struct WarmStartEntry {
+    SlotId slot;
+    InstrumentState state;
+};
+
+// MGET of the slots' TWS:LVC:* keys (LastValueFormat::Hash: one pipelined HGETALL per key),
+// ceil(slots / keysPerRequest) round trips
+// Returns the keys that exist and parse (missing / malformed / other-format ones start cold)
+// Throws sw::redis::Error if Redis cannot be reached
+// PITFALL: Not for Redis Cluster - one MGET spans hash slots (CROSSSLOT)
+std::vector<WarmStartEntry> loadLastValues(const std::string& uri, const InstrumentRegistry& registry,
+                                           const std::vector<SlotId>& slots, const WarmStartConfig& config = {});
+
+} // namespace tws_bridge
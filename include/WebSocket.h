@@ -0,0 +1,263 @@
+// WebSocket.h - RFC 6455 pieces the gateway needs: upgrade handshake, server frame headers, client frame parsing
+// SCOPE: WebSocket gateway thread (WebSocketGateway.h) and its feeding sink threads (frame headers)
+
+#pragma once
+
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tws_bridge {
+
+namespace ws_detail {
+
+inline std::uint32_t rotl(std::uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// SHA-1 of data - the handshake's Sec-WebSocket-Accept only (not used for anything security related)
+inline std::array<std::uint8_t, 20> sha1(std::string_view data) {
+    std::uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    std::string message(data);
+    const std::uint64_t bits = static_cast<std::uint64_t>(data.size()) * 8;
+    message += static_cast<char>(0x80);
+    while (message.size() % 64 != 56) {
+        message += '\0';
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        message += static_cast<char>((bits >> shift) & 0xFF);
+    }
+    for (std::size_t chunk = 0; chunk < message.size(); chunk += 64) {
+        std::uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* p = reinterpret_cast<const std::uint8_t*>(message.data() + chunk + 4 * i);
+            w[i] = (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            std::uint32_t f = 0;
+            std::uint32_t k = 0;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const std::uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+    std::array<std::uint8_t, 20> digest{};
+    for (int i = 0; i < 20; ++i) {
+        digest[i] = static_cast<std::uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    return digest;
+}
+
+inline std::string base64(const std::uint8_t* data, std::size_t length) {
+    static constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (std::size_t i = 0; i < length; i += 3) {
+        const std::uint32_t chunk = (std::uint32_t{data[i]} << 16)
+                                  | (i + 1 < length ? std::uint32_t{data[i + 1]} << 8 : 0)
+                                  | (i + 2 < length ? std::uint32_t{data[i + 2]} : 0);
+        out += kAlphabet[(chunk >> 18) & 0x3F];
+        out += kAlphabet[(chunk >> 12) & 0x3F];
+        out += i + 1 < length ? kAlphabet[(chunk >> 6) & 0x3F] : '=';
+        out += i + 2 < length ? kAlphabet[chunk & 0x3F] : '=';
+    }
+    return out;
+}
+
+// Value of header `name` (case-insensitive, trimmed), empty if absent
+inline std::string_view headerValue(std::string_view request, std::string_view name) {
+    std::size_t line = request.find("\r\n");
+    while (line != std::string_view::npos && line + 2 < request.size()) {
+        const std::size_t start = line + 2;
+        const std::size_t end = request.find("\r\n", start);
+        const std::string_view header = request.substr(start, end == std::string_view::npos ? end : end - start);
+        const std::size_t colon = header.find(':');
+        if (colon == name.size()) {
+            bool same = true;
+            for (std::size_t i = 0; i < colon && same; ++i) {
+                same = std::tolower(static_cast<unsigned char>(header[i]))
+                    == std::tolower(static_cast<unsigned char>(name[i]));
+            }
+            if (same) {
+                std::string_view value = header.substr(colon + 1);
+                while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+                    value.remove_prefix(1);
+                }
+                while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+                    value.remove_suffix(1);
+                }
+                return value;
+            }
+        }
+        line = end;
+    }
+    return {};
+}
+
+inline bool containsToken(std::string_view value, std::string_view token) {
+    for (std::size_t i = 0; i + token.size() <= value.size(); ++i) {
+        bool same = true;
+        for (std::size_t j = 0; j < token.size() && same; ++j) {
+            same = std::tolower(static_cast<unsigned char>(value[i + j])) == token[j];
+        }
+        if (same) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace ws_detail
+
+enum class WsOpcode : std::uint8_t {
+    Continuation = 0x0,
+    Text = 0x1,
+    Binary = 0x2,
+    Close = 0x8,
+    Ping = 0x9,
+    Pong = 0xA
+};
+
+// Largest server frame header: 2 bytes + 64-bit length
+inline constexpr std::size_t kWsMaxHeader = 10;
+
+// Sec-WebSocket-Accept for a client's Sec-WebSocket-Key
+inline std::string websocketAccept(std::string_view key) {
+    std::string input(key);
+    input += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    const std::array<std::uint8_t, 20> digest = ws_detail::sha1(input);
+    return ws_detail::base64(digest.data(), digest.size());
+}
+
+// Sec-WebSocket-Key of a complete upgrade request (through the blank line), empty if it is not one
+inline std::string_view upgradeKey(std::string_view request) {
+    if (request.rfind("GET ", 0) != 0
+        || !ws_detail::containsToken(ws_detail::headerValue(request, "Upgrade"), "websocket")) {
+        return {};
+    }
+    return ws_detail::headerValue(request, "Sec-WebSocket-Key");
+}
+
+inline std::string upgradeResponse(std::string_view key) {
+    std::string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                           "Sec-WebSocket-Accept: ";
+    response += websocketAccept(key);
+    response += "\r\n\r\n";
+    return response;
+}
+
+// Unmasked single-frame header (server → client), returns its length (2, 4 or 10 bytes)
+inline std::size_t writeFrameHeader(char* out, WsOpcode opcode, std::size_t payloadLength) {
+    out[0] = static_cast<char>(0x80 | static_cast<std::uint8_t>(opcode));  // FIN
+    if (payloadLength < 126) {
+        out[1] = static_cast<char>(payloadLength);
+        return 2;
+    }
+    if (payloadLength <= 0xFFFF) {
+        out[1] = 126;
+        out[2] = static_cast<char>(payloadLength >> 8);
+        out[3] = static_cast<char>(payloadLength);
+        return 4;
+    }
+    out[1] = 127;
+    for (int i = 0; i < 8; ++i) {
+        out[2 + i] = static_cast<char>(static_cast<std::uint64_t>(payloadLength) >> (56 - 8 * i));
+    }
+    return 10;
+}
+
+// Complete server frame (header + payload)
+inline void appendFrame(std::string& out, WsOpcode opcode, std::string_view payload) {
+    char header[kWsMaxHeader];
+    out.append(header, writeFrameHeader(header, opcode, payload.size()));
+    out.append(payload.data(), payload.size());
+}
+
+struct WsFrame {
+    bool fin = false;
+    WsOpcode opcode = WsOpcode::Text;
+    std::string_view payload;                       // Unmasked, points into the parsed buffer
+};
+
+enum class WsParse {
+    Incomplete,                                     // Need more bytes
+    Frame,
+    Error                                           // Protocol violation - close the connection
+};
+
+// One client frame at the start of data; unmasks its payload in place, consumed = frame length
+// PITFALL: Client frames must be masked (RFC 6455 5.1) - an unmasked one is an error, as is a payload over
+// maxPayload (subscription commands are short) or a reserved bit
+inline WsParse parseClientFrame(char* data, std::size_t size, std::size_t maxPayload, WsFrame& frame,
+                                std::size_t& consumed) {
+    if (size < 2) {
+        return WsParse::Incomplete;
+    }
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+    if ((bytes[0] & 0x70) != 0 || (bytes[1] & 0x80) == 0) {
+        return WsParse::Error;
+    }
+    std::size_t header = 2;
+    std::uint64_t length = bytes[1] & 0x7F;
+    if (length == 126) {
+        header = 4;
+        if (size < header) {
+            return WsParse::Incomplete;
+        }
+        length = (std::uint64_t{bytes[2]} << 8) | bytes[3];
+    } else if (length == 127) {
+        header = 10;
+        if (size < header) {
+            return WsParse::Incomplete;
+        }
+        length = 0;
+        for (int i = 0; i < 8; ++i) {
+            length = (length << 8) | bytes[2 + i];
+        }
+    }
+    if (length > maxPayload) {
+        return WsParse::Error;
+    }
+    if (size < header + 4 + length) {
+        return WsParse::Incomplete;
+    }
+    const std::uint8_t* mask = bytes + header;
+    char* payload = data + header + 4;
+    for (std::size_t i = 0; i < length; ++i) {
+        payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+    }
+    frame.fin = (bytes[0] & 0x80) != 0;
+    frame.opcode = static_cast<WsOpcode>(bytes[0] & 0x0F);
+    frame.payload = std::string_view(payload, static_cast<std::size_t>(length));
+    consumed = header + 4 + static_cast<std::size_t>(length);
+    return WsParse::Frame;
+}
+
+} // namespace tws_bridge
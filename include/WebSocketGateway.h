@@ -0,0 +1,144 @@
+// WebSocketGateway.h - Embedded WebSocket server: browsers subscribe to symbols, snapshots go out directly
+// SCOPE: Worker sink threads frame snapshots (onBatch), the gateway thread owns every socket (epoll)
+
+#pragma once
+
+#include "InstrumentRegistry.h"
+#include "SnapshotSink.h"
+#include "WebSocket.h"
+#include <atomic>
+#include <chrono>
+#include <concurrentqueue.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace tws_bridge {
+
+// websocket: UI feed without the Redis + web backend hops
+struct WebSocketConfig {
+    bool enabled = false;
+    std::string bindAddress = "0.0.0.0";
+    std::uint16_t port = 8765;                      // 0 = ephemeral (see WebSocketGateway::port())
+    bool binary = false;                            // Binary frames with the BinaryEncoder.h v1 snapshot, else text JSON
+    std::size_t maxConnections = 256;
+    std::chrono::milliseconds stallTimeout{10000};  // A connection that accepts no bytes this long is closed
+    std::size_t maxQueuedFrames = 65536;            // BACKPRESSURE: Sink threads → gateway thread, newest dropped
+    // Bytes of connection backlogs (memory.websocket_mb), 0 = unbounded
+    // BACKPRESSURE: Past it, the connection with the largest backlog is closed (checked every 100ms)
+    std::size_t memoryBudget = 0;
+};
+
+// Lifetime counters (written by the gateway / sink threads, readable from any thread)
+struct WebSocketCounters {
+    std::atomic<std::uint64_t> connections{0};      // Open upgraded connections (gauge)
+    std::atomic<std::uint64_t> accepted{0};
+    std::atomic<std::uint64_t> rejected{0};         // Bad handshake, connection limit or protocol error
+    std::atomic<std::uint64_t> frames{0};           // Snapshot frames written (per connection)
+    std::atomic<std::uint64_t> conflated{0};        // Frames replaced by a newer one of the same symbol before sending
+    std::atomic<std::uint64_t> stalled{0};          // Connections closed by stallTimeout
+    std::atomic<std::uint64_t> dropped{0};          // Frames not queued to the gateway thread (maxQueuedFrames)
+    std::atomic<std::uint64_t> bufferedBytes{0};    // Unsent frame + unparsed input bytes of all connections (gauge)
+    std::atomic<std::uint64_t> overBudget{0};       // Connections closed by memoryBudget
+};
+
+// Client protocol (text frames): "SUBSCRIBE AAPL MSFT", "UNSUBSCRIBE AAPL", "SUBSCRIBE *" (every symbol);
+// a symbol not registered yet is subscribed once the bridge registers it. Each subscribed symbol's latest
+// snapshot is sent right away, then every snapshot the workers publish for it.
+// ARCHITECTURE: Added as a sink to every worker - each snapshot is framed ONCE on a sink thread into a
+// refcounted buffer; the gateway thread hands the same buffer to every subscribed connection and writes a
+// connection's queue with one writev (scatter-gather, no per-client copy)
+// BACKPRESSURE: Per-connection conflation - a queued, unsent frame is replaced by the symbol's next one, so a
+// slow client holds at most one frame per subscribed symbol and always catches up to the latest state
+class WebSocketGateway : public SnapshotSink {
+public:
+    using Frame = std::shared_ptr<const std::string>;  // Header + payload, shared by every connection
+
+    WebSocketGateway(const InstrumentRegistry& registry, WebSocketConfig config);
+    ~WebSocketGateway() override;
+
+    WebSocketGateway(const WebSocketGateway&) = delete;
+    WebSocketGateway& operator=(const WebSocketGateway&) = delete;
+
+    // Binds + listens, false if the socket can't be opened (error logged)
+    bool start();
+    void stop();
+
+    // Bound port (the ephemeral one when configured with 0), 0 before start()
+    std::uint16_t port() const { return m_boundPort.load(std::memory_order_acquire); }
+    const WebSocketCounters& counters() const { return m_counters; }
+
+    // ========== SnapshotSink (every worker's sink thread, concurrently) ==========
+    const char* name() const override { return "websocket"; }
+    bool wantsBinary() const override { return m_config.binary; }
+    void onBatch(const SnapshotRecord* records, std::size_t count) override;
+
+private:
+    struct Pending {
+        Frame frame;
+        SlotId slot = kInvalidSlot;                 // kInvalidSlot: control frame (never conflated)
+    };
+
+    struct Connection {
+        int fd = -1;
+        bool upgraded = false;
+        bool writable = true;                       // false while EPOLLOUT is armed
+        bool all = false;                           // SUBSCRIBE *
+        bool dirty = false;                         // Listed in m_dirty
+        std::string input;                          // Unparsed request / client frame bytes
+        std::vector<Pending> queue;                 // Oldest first, from head
+        std::size_t head = 0;
+        std::size_t offset = 0;                     // Bytes of queue[head] already written
+        std::unordered_map<SlotId, std::size_t> queued;  // Slot → queue index of its unsent frame
+        std::vector<SlotId> slots;                  // Subscribed
+        std::vector<std::string> unresolved;        // Subscribed symbols not registered yet
+        std::chrono::steady_clock::time_point blockedSince{};  // First EAGAIN of the current backlog
+    };
+
+    struct Published {
+        SlotId slot;
+        Frame frame;
+    };
+
+    void run();
+    void accept();
+    bool readFrom(Connection& connection);          // false: close it
+    bool handshake(Connection& connection);
+    void command(Connection& connection, std::string_view text);
+    void subscribe(Connection& connection, SlotId slot);
+    void unsubscribe(Connection& connection, SlotId slot);
+    void resolvePending();
+    void broadcast(const Published& published);
+    void enqueue(Connection& connection, SlotId slot, const Frame& frame);
+    bool flush(Connection& connection);             // false: close it
+    void close(int fd);
+    void checkStalls();
+
+    const InstrumentRegistry& m_registry;
+    WebSocketConfig m_config;
+    WebSocketCounters m_counters;
+    moodycamel::ConcurrentQueue<Published> m_feed;  // Sink threads → gateway thread
+    int m_listenFd = -1;
+    int m_wakeFd = -1;                              // eventfd: frames queued (open until destruction - sinks may outlive stop())
+    int m_epollFd = -1;
+    std::atomic<std::uint16_t> m_boundPort{0};
+    std::atomic<bool> m_running{false};
+
+    // ========== Gateway thread ==========
+    std::unordered_map<int, std::unique_ptr<Connection>> m_connections;  // By fd
+    std::vector<std::vector<Connection*>> m_subscribers;  // By slot
+    std::vector<Connection*> m_allSubscribers;      // SUBSCRIBE *
+    std::vector<Frame> m_latest;                    // By slot - sent on subscribe
+    std::vector<int> m_dirty;                       // fds with frames queued since the last flush
+    std::vector<Published> m_batch;                 // REASON: Dequeue scratch
+    std::size_t m_registered = 0;                   // registry.size() at the last resolvePending()
+    std::chrono::steady_clock::time_point m_lastStallCheck{};
+    std::thread m_thread;                           // REASON: Declared last, started after all state exists
+};
+
+} // namespace tws_bridge
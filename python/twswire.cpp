@@ -0,0 +1,287 @@
+// twswire.cpp - Python extension over BinaryReader.h: TWS:BIN:* payloads → row batches (buffer protocol)
+// SCOPE: Consumer side (-DTWS_BRIDGE_PYTHON=ON builds twswire.<abi>.so) - no numpy build dependency,
+// numpy.asarray(batch) views the rows as a structured array through the PEP 3118 format, without a copy
+//
+//   import twswire, numpy as np
+//   book = twswire.TickBook()
+//   rows = np.asarray(book.decode(pubsub_payloads))      # rows["bid"], rows["symbol"], rows["changed"] ...
+//   bars = np.asarray(twswire.decode_bars(stream_values))
+//
+// PERFORMANCE: Payloads are read in place through the buffer protocol (bytes, bytearray, memoryview), each
+// message is one fixed-offset decode into a preallocated row - no per-field Python objects, no json.loads
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "BinaryReader.h"
+#include <new>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using binary_wire::BarRow;
+using binary_wire::TickRow;
+
+// ========== Batch: contiguous rows + buffer export ==========
+
+template <typename Row>
+struct Batch {
+    PyObject_HEAD
+    std::vector<Row>* rows;
+    Py_ssize_t skipped;                     // Payloads that were not a v1 message of the batch's kind
+    Py_ssize_t shape[1];
+    Py_ssize_t strides[1];
+};
+
+template <typename Row>
+const char* rowFormat();
+template <>
+const char* rowFormat<TickRow>() { return binary_wire::kTickRowFormat; }
+template <>
+const char* rowFormat<BarRow>() { return binary_wire::kBarRowFormat; }
+
+template <typename Row>
+void batchDealloc(PyObject* self) {
+    delete reinterpret_cast<Batch<Row>*>(self)->rows;
+    Py_TYPE(self)->tp_free(self);
+}
+
+template <typename Row>
+int batchGetBuffer(PyObject* self, Py_buffer* view, int flags) {
+    auto* batch = reinterpret_cast<Batch<Row>*>(self);
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "twswire batches are read-only");
+        view->obj = nullptr;
+        return -1;
+    }
+    batch->shape[0] = static_cast<Py_ssize_t>(batch->rows->size());
+    batch->strides[0] = sizeof(Row);
+    view->buf = batch->rows->data();
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = static_cast<Py_ssize_t>(batch->rows->size() * sizeof(Row));
+    view->readonly = 1;
+    view->itemsize = sizeof(Row);
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(rowFormat<Row>()) : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? batch->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? batch->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+template <typename Row>
+Py_ssize_t batchLength(PyObject* self) {
+    return static_cast<Py_ssize_t>(reinterpret_cast<Batch<Row>*>(self)->rows->size());
+}
+
+template <typename Row>
+PyObject* batchSkipped(PyObject* self, void*) {
+    return PyLong_FromSsize_t(reinterpret_cast<Batch<Row>*>(self)->skipped);
+}
+
+template <typename Row>
+PyBufferProcs kBatchBuffer = {batchGetBuffer<Row>, nullptr};  // REASON: Rows never change after decode
+template <typename Row>
+PySequenceMethods kBatchSequence = {batchLength<Row>};
+template <typename Row>
+PyGetSetDef kBatchGetSet[] = {
+    {const_cast<char*>("skipped"), batchSkipped<Row>, nullptr,
+     const_cast<char*>("Payloads that were not a binary v1 message of this kind"), nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyTypeObject TickBatchType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+PyTypeObject BarBatchType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+template <typename Row>
+void initBatchType(PyTypeObject& type, const char* name, const char* doc) {
+    type.tp_name = name;
+    type.tp_doc = doc;
+    type.tp_basicsize = sizeof(Batch<Row>);
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_dealloc = batchDealloc<Row>;
+    type.tp_as_buffer = &kBatchBuffer<Row>;
+    type.tp_as_sequence = &kBatchSequence<Row>;
+    type.tp_getset = kBatchGetSet<Row>;
+}
+
+template <typename Row>
+Batch<Row>* newBatch(PyTypeObject& type, std::size_t reserve) {
+    auto* batch = PyObject_New(Batch<Row>, &type);
+    if (batch == nullptr) {
+        return nullptr;
+    }
+    batch->rows = new (std::nothrow) std::vector<Row>();
+    batch->skipped = 0;
+    if (batch->rows == nullptr) {
+        Py_DECREF(batch);
+        PyErr_NoMemory();
+        return nullptr;
+    }
+    batch->rows->reserve(reserve);
+    return batch;
+}
+
+// fn(std::string_view payload) for every item of `payloads` (any iterable of bytes-like objects)
+template <typename Fn>
+bool forEachPayload(PyObject* payloads, Fn&& fn) {
+    PyObject* iterator = PyObject_GetIter(payloads);
+    if (iterator == nullptr) {
+        return false;
+    }
+    while (PyObject* item = PyIter_Next(iterator)) {
+        Py_buffer buffer;
+        const bool ok = PyObject_GetBuffer(item, &buffer, PyBUF_SIMPLE) == 0;
+        if (ok) {
+            fn(std::string_view(static_cast<const char*>(buffer.buf), static_cast<std::size_t>(buffer.len)));
+            PyBuffer_Release(&buffer);
+        }
+        Py_DECREF(item);
+        if (!ok) {
+            Py_DECREF(iterator);
+            return false;
+        }
+    }
+    Py_DECREF(iterator);
+    return !PyErr_Occurred();
+}
+
+Py_ssize_t lengthHint(PyObject* payloads) {
+    const Py_ssize_t hint = PyObject_LengthHint(payloads, 0);
+    if (hint < 0) {
+        PyErr_Clear();
+        return 0;
+    }
+    return hint;
+}
+
+// ========== TickBook ==========
+
+struct TickBookObject {
+    PyObject_HEAD
+    binary_wire::TickBook* book;
+};
+
+PyObject* tickBookNew(PyTypeObject* type, PyObject*, PyObject*) {
+    auto* self = reinterpret_cast<TickBookObject*>(type->tp_alloc(type, 0));
+    if (self != nullptr) {
+        self->book = new (std::nothrow) binary_wire::TickBook();
+        if (self->book == nullptr) {
+            Py_DECREF(self);
+            return PyErr_NoMemory();
+        }
+    }
+    return reinterpret_cast<PyObject*>(self);
+}
+
+void tickBookDealloc(PyObject* self) {
+    delete reinterpret_cast<TickBookObject*>(self)->book;
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyObject* decodeTicksInto(binary_wire::TickBook& book, PyObject* payloads) {
+    Batch<TickRow>* batch = newBatch<TickRow>(TickBatchType, static_cast<std::size_t>(lengthHint(payloads)));
+    if (batch == nullptr) {
+        return nullptr;
+    }
+    const bool ok = forEachPayload(payloads, [&](std::string_view payload) {
+        if (const TickRow* row = book.apply(payload)) {
+            batch->rows->push_back(*row);
+        } else {
+            ++batch->skipped;
+        }
+    });
+    if (!ok) {
+        Py_DECREF(batch);
+        return nullptr;
+    }
+    return reinterpret_cast<PyObject*>(batch);
+}
+
+PyObject* tickBookDecode(PyObject* self, PyObject* payloads) {
+    return decodeTicksInto(*reinterpret_cast<TickBookObject*>(self)->book, payloads);
+}
+
+Py_ssize_t tickBookLength(PyObject* self) {
+    return static_cast<Py_ssize_t>(reinterpret_cast<TickBookObject*>(self)->book->size());
+}
+
+PyMethodDef kTickBookMethods[] = {
+    {"decode", tickBookDecode, METH_O,
+     "decode(payloads) -> TickBatch: one row per Snapshot / Delta payload, deltas completed from the book"},
+    {nullptr, nullptr, 0, nullptr}};
+
+PySequenceMethods kTickBookSequence = {tickBookLength};
+
+PyTypeObject TickBookType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+// ========== Module ==========
+
+PyObject* decodeTicks(PyObject*, PyObject* payloads) {
+    binary_wire::TickBook book;
+    return decodeTicksInto(book, payloads);
+}
+
+PyObject* decodeBars(PyObject*, PyObject* payloads) {
+    Batch<BarRow>* batch = newBatch<BarRow>(BarBatchType, static_cast<std::size_t>(lengthHint(payloads)));
+    if (batch == nullptr) {
+        return nullptr;
+    }
+    binary_wire::BarView view;
+    const bool ok = forEachPayload(payloads, [&](std::string_view payload) {
+        if (view.parse(payload)) {
+            binary_wire::applyBar(view, batch->rows->emplace_back());
+        } else {
+            ++batch->skipped;
+        }
+    });
+    if (!ok) {
+        Py_DECREF(batch);
+        return nullptr;
+    }
+    return reinterpret_cast<PyObject*>(batch);
+}
+
+PyMethodDef kModuleMethods[] = {
+    {"decode_ticks", decodeTicks, METH_O,
+     "decode_ticks(payloads) -> TickBatch: TWS:BIN:TICKS payloads, deltas completed within this call only"},
+    {"decode_bars", decodeBars, METH_O, "decode_bars(payloads) -> BarBatch: TWS:BIN:BARS payloads"},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyModuleDef kModule = {PyModuleDef_HEAD_INIT, "twswire",
+                       "Binary wire v1 decoding (tws-redis-bridge BinaryReader.h) into numpy-viewable row batches",
+                       -1, kModuleMethods, nullptr, nullptr, nullptr, nullptr};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_twswire() {
+    initBatchType<TickRow>(TickBatchType, "twswire.TickBatch", "Tick rows (buffer protocol, format TICK_FORMAT)");
+    initBatchType<BarRow>(BarBatchType, "twswire.BarBatch", "Bar rows (buffer protocol, format BAR_FORMAT)");
+    TickBookType.tp_name = "twswire.TickBook";
+    TickBookType.tp_doc = "Latest tick row per symbol - completes TWS:BIN:TICKS deltas across decode() calls";
+    TickBookType.tp_basicsize = sizeof(TickBookObject);
+    TickBookType.tp_flags = Py_TPFLAGS_DEFAULT;
+    TickBookType.tp_new = tickBookNew;
+    TickBookType.tp_dealloc = tickBookDealloc;
+    TickBookType.tp_methods = kTickBookMethods;
+    TickBookType.tp_as_sequence = &kTickBookSequence;
+    if (PyType_Ready(&TickBatchType) < 0 || PyType_Ready(&BarBatchType) < 0 || PyType_Ready(&TickBookType) < 0) {
+        return nullptr;
+    }
+    PyObject* module = PyModule_Create(&kModule);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    Py_INCREF(&TickBookType);
+    if (PyModule_AddObject(module, "TickBook", reinterpret_cast<PyObject*>(&TickBookType)) < 0
+        || PyModule_AddStringConstant(module, "TICK_FORMAT", binary_wire::kTickRowFormat) < 0
+        || PyModule_AddStringConstant(module, "BAR_FORMAT", binary_wire::kBarRowFormat) < 0
+        || PyModule_AddIntConstant(module, "FLAG_PAST_LIMIT", binary_wire::RowFlags::PastLimit) < 0
+        || PyModule_AddIntConstant(module, "FLAG_STALE", binary_wire::RowFlags::Stale) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# consumer_decode_bench.py - Python consumer side of benchmark_consumer_decode: the same corpus, decoded the
+# way a Python subscriber does it (json.loads + dict rows, twswire.TickBook, lz4.frame + json.loads)
+#
+# Usage: benchmark_consumer_decode --dump corpus.bin && scripts/consumer_decode_bench.py corpus.bin [options]
+#   --passes N      Timed passes over each corpus (default 5, the best one is reported)
+#   --format F      text | csv (default text)
+#
+# NOTE: binary / binary_delta need the twswire extension (-DTWS_BRIDGE_PYTHON=ON, on PYTHONPATH),
+# json_lz4_batch the lz4 package (pip install lz4) - formats without their decoder are skipped
+# NOTE: twswire decodes one list per call (its batch API) - per-message calls would time the call overhead
+# NOTE: Python has no allocation counter; "peak KiB" is tracemalloc's high-water mark over one untimed pass
+
+import argparse
+import json
+import struct
+import sys
+import time
+import tracemalloc
+
+try:
+    import twswire
+except ImportError:
+    twswire = None
+
+try:
+    import lz4.frame as lz4frame
+except ImportError:
+    lz4frame = None
+
+MAGIC = b"TWSDEC1\n"
+FORMATS = ["json", "json_compact", "json_delta", "binary", "binary_delta", "json_lz4_batch"]
+RECORD = struct.Struct("<BII")
+
+# Verbose / compact names: symbol, seq, timestamp, exchange, price, size, timestamps
+VERBOSE = ("instrument", "seq", "timestamp", "exchange", "price", "size", "timestamps")
+COMPACT = ("sym", "sq", "ts", "ex", "p", "s", "tss")
+
+
+def load(path):
+    corpus = {name: [] for name in FORMATS}
+    with open(path, "rb") as f:
+        data = f.read()
+    if not data.startswith(MAGIC):
+        sys.exit(f"{path}: not a benchmark_consumer_decode corpus")
+    offset = len(MAGIC)
+    while offset + RECORD.size <= len(data):
+        fmt, ticks, length = RECORD.unpack_from(data, offset)
+        offset += RECORD.size
+        if fmt >= len(FORMATS) or offset + length > len(data):
+            sys.exit(f"{path}: truncated or unknown format {fmt}")
+        corpus[FORMATS[fmt]].append((data[offset:offset + length], ticks))
+        offset += length
+    return corpus
+
+
+def apply_json(book, message, names):
+    symbol, seq, timestamp, exchange, price, size, timestamps = names
+    row = book.get(message[symbol])
+    if row is None:
+        row = book[message[symbol]] = {}
+    # Groups merge member by member - a delta carries only the members that changed
+    for key, value in message.items():
+        if key == price or key == size or key == timestamps:
+            group = row.get(key)
+            if group is None:
+                row[key] = dict(value)
+            else:
+                group.update(value)
+        elif key != symbol:
+            row[key] = value
+    return 1
+
+
+def decoder(name):
+    if name in ("binary", "binary_delta"):
+        if twswire is None:
+            return None
+
+        def decode_binary(messages):
+            batch = twswire.TickBook().decode([payload for payload, _ in messages])
+            return len(memoryview(batch))  # NOTE: Rows through the buffer protocol (shape[0])
+        return decode_binary
+    if name == "json_lz4_batch":
+        if lz4frame is None:
+            return None
+
+        def decode_batches(messages):
+            book, ticks = {}, 0
+            for payload, _ in messages:
+                for snapshot in json.loads(lz4frame.decompress(payload)):
+                    ticks += apply_json(book, snapshot, VERBOSE)
+            return ticks
+        return decode_batches
+    names = COMPACT if name == "json_compact" else VERBOSE
+
+    def decode_json(messages):
+        book, ticks = {}, 0
+        for payload, _ in messages:
+            ticks += apply_json(book, json.loads(payload), names)
+        return ticks
+    return decode_json
+
+
+def measure(decode, messages, passes):
+    wire = sum(len(payload) for payload, _ in messages)
+    carried = sum(ticks for _, ticks in messages) or 1
+    tracemalloc.start()
+    decode(messages)
+    _, peak = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    best = None
+    ticks = 0
+    for _ in range(passes):
+        start = time.perf_counter_ns()
+        ticks = decode(messages)
+        elapsed = time.perf_counter_ns() - start
+        best = elapsed if best is None else min(best, elapsed)
+    ns = best / ticks if ticks else 0.0
+    return ticks, wire / carried, ns, peak / 1024.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Python consumer decode cost per bridge output format")
+    parser.add_argument("corpus")
+    parser.add_argument("--passes", type=int, default=5)
+    parser.add_argument("--format", choices=["text", "csv"], default="text")
+    args = parser.parse_args()
+
+    corpus = load(args.corpus)
+    text = args.format == "text"
+    if text:
+        print("=== Consumer Decode Benchmark (Python %d.%d) ===" % sys.version_info[:2])
+        print(f"Corpus: {args.corpus} | Passes: {max(args.passes, 1)} (best)\n")
+        print(f"{'format':<16}{'ticks':>10}{'bytes/tick':>12}{'ns/tick':>12}{'peak KiB':>12}")
+    else:
+        print("format,ticks,bytes_per_tick,ns_per_tick,peak_kib")
+    for name in FORMATS:
+        messages = corpus[name]
+        if not messages:
+            continue
+        decode = decoder(name)
+        if decode is None:
+            if text:
+                print(f"{name:<16}  skipped ({'twswire' if name.startswith('binary') else 'lz4'} not importable)")
+            continue
+        ticks, per_tick, ns, peak = measure(decode, messages, max(args.passes, 1))
+        if text:
+            print(f"{name:<16}{ticks:>10}{per_tick:>12.1f}{ns:>12.1f}{peak:>12.1f}")
+        else:
+            print(f"{name},{ticks},{per_tick:.1f},{ns:.1f},{peak:.1f}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
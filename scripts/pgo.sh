@@ -0,0 +1,105 @@
+#!/usr/bin/env bash
+# pgo.sh - Profile-guided optimization build of tws_bridge, trained on a recorded session
+#
+# Usage: scripts/pgo.sh <journal dir> [build dir]        (make pgo JOURNAL=<journal dir>)
+#
+# 1. Instrumented build (-DTWS_BRIDGE_PGO=GENERATE) of tws_bridge and fake_tws
+# 2. Training, both against a scratch Redis and a JSON-lines sink (archive.prefix):
+#    a. decode:  fake_tws replays the session at full speed over the TWS wire protocol, tws_bridge
+#               decodes (fast path + EDecoder), aggregates, serializes and publishes it
+#    b. replay:  tws_bridge --replay <session> --speed max (aggregate / serialize / publish at full volume)
+# 3. Rebuild in the same directory with the profile (-DTWS_BRIDGE_PGO=USE)
+#
+# Environment:
+#   CMAKE_ARGS     Extra configure arguments (e.g. the Conan toolchain file, -DCMAKE_CXX_COMPILER=clang++)
+#   LTO=ON         Also link-time optimize across tws_api and tws_bridge
+#   SYMBOLS        Symbols of the session to subscribe in the decode run (default: synthetic ticks for
+#                  config.yaml's subscriptions instead of the recorded ones)
+#   TRAIN_SECONDS  Length of the decode run (default 60)
+#   REDIS_URI      Redis to publish to (default: redis-server on port 6390 if installed, else tcp://127.0.0.1:6379)
+#
+# NOTE: fake_tws is built with the tests (Catch2 found at configure time)
+# NOTE: The profile is only as good as the session - record one with the production symbol mix and feed types
+
+set -euo pipefail
+
+JOURNAL=${1:?"Usage: $0 <journal dir> [build dir]"}
+BUILD=${2:-build-pgo}
+TRAIN_SECONDS=${TRAIN_SECONDS:-60}
+LTO=${LTO:-OFF}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+PROFILE="$(cd "$ROOT" && mkdir -p "$BUILD" && cd "$BUILD" && pwd)/pgo-profile"
+SCRATCH=$(mktemp -d)
+FAKE_PORT=7597
+PIDS=()
+
+cleanup() {
+    for pid in ${PIDS[@]+"${PIDS[@]}"}; do
+        kill "$pid" 2>/dev/null || true
+    done
+    rm -rf "$SCRATCH"
+}
+trap cleanup EXIT
+
+configure() {
+    # shellcheck disable=SC2086
+    cmake -S "$ROOT" -B "$ROOT/$BUILD" -DCMAKE_BUILD_TYPE=Release -DTWS_BRIDGE_PGO="$1" \
+        -DTWS_BRIDGE_PGO_DIR="$PROFILE" -DTWS_BRIDGE_LTO="$LTO" ${CMAKE_ARGS:-}
+}
+
+echo "=== PGO 1/3: instrumented build ==="
+rm -rf "$PROFILE"
+configure GENERATE
+cmake --build "$ROOT/$BUILD" -j"$(nproc)" --target tws_bridge fake_tws
+
+echo "=== PGO 2/3: training on $JOURNAL ==="
+if [[ -z "${REDIS_URI:-}" ]]; then
+    if command -v redis-server >/dev/null; then
+        redis-server --port 6390 --save "" --appendonly no >"$SCRATCH/redis.log" 2>&1 &
+        PIDS+=($!)
+        REDIS_URI=tcp://127.0.0.1:6390
+        sleep 1
+    else
+        REDIS_URI=tcp://127.0.0.1:6379  # REASON: make docker-up
+    fi
+fi
+BRIDGE=("$ROOT/$BUILD/tws_bridge" --config "$ROOT/config.yaml" --set "redis.uri=$REDIS_URI"
+        --set "archive.prefix=$SCRATCH/archive" --set "journal.enabled=false" --set "metrics.enabled=false")
+
+# a. Decode: the wire protocol path, at the session's symbols when known
+FAKE=("$ROOT/$BUILD/tests/fake_tws" --port "$FAKE_PORT")
+if [[ -n "${SYMBOLS:-}" ]]; then
+    FAKE+=(--journal "$JOURNAL" --speed 0)
+    BRIDGE_SYMBOLS=(--subscribe "$SYMBOLS")
+else
+    FAKE+=(--rate 0)
+    BRIDGE_SYMBOLS=()
+fi
+"${FAKE[@]}" >"$SCRATCH/fake_tws.log" 2>&1 &
+FAKE_PID=$!
+PIDS+=("$FAKE_PID")
+sleep 1
+"${BRIDGE[@]}" --host 127.0.0.1 --port "$FAKE_PORT" ${BRIDGE_SYMBOLS[@]+"${BRIDGE_SYMBOLS[@]}"} >"$SCRATCH/decode.log" 2>&1 &
+BRIDGE_PID=$!
+sleep "$TRAIN_SECONDS"
+# REASON: Graceful stop - the profile is written by the exiting process
+kill -INT "$BRIDGE_PID"
+wait "$BRIDGE_PID" || { echo "Decode run failed:"; tail -20 "$SCRATCH/decode.log"; exit 1; }
+kill "$FAKE_PID" 2>/dev/null || true
+
+# b. Replay: recorded updates straight into the shard queues
+"${BRIDGE[@]}" --replay "$JOURNAL" --speed max | grep "\[REPLAY\]"
+
+if [[ -z $(find "$PROFILE" -type f 2>/dev/null | head -1) ]]; then
+    echo "No profile data in $PROFILE - was the instrumented binary run?"
+    exit 1
+fi
+if compgen -G "$PROFILE/*.profraw" >/dev/null; then
+    # REASON: Clang writes raw per-process files, -fprofile-use reads one merged file
+    llvm-profdata merge -output="$PROFILE/merged.profdata" "$PROFILE"/*.profraw
+fi
+
+echo "=== PGO 3/3: optimized build ==="
+configure USE
+cmake --build "$ROOT/$BUILD" -j"$(nproc)" --target tws_bridge
+echo "PGO build: $ROOT/$BUILD/tws_bridge (compare with replay_diff / benchmark_pipeline against a plain Release build)"
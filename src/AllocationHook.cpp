@@ -0,0 +1,69 @@
+// AllocationHook.cpp - Global operator new / delete counting every allocation per thread
+// SCOPE: Linked only with cmake -DTWS_BRIDGE_ALLOC_HOOK=ON (tws_bridge, test_allocation_tracker)
+// NOTE: malloc / free underneath, same as libstdc++'s defaults - only the counting is added
+
+#include "AllocationTracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// REASON: Static initializer, not a flag in the header - the collector must know whether counts are real zeros
+const bool kInstalled = (tws_bridge::alloc_detail::g_state.installed.store(true, std::memory_order_relaxed), true);
+
+void* allocate(std::size_t size) {
+    tws_bridge::recordAllocation(size);
+    return std::malloc(size != 0 ? size : 1);  // REASON: new(0) must return a unique pointer
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    tws_bridge::recordAllocation(size);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // PITFALL: aligned_alloc needs size to be a multiple of the alignment
+    const std::size_t rounded = ((size != 0 ? size : 1) + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded);
+}
+
+void* allocateOrThrow(std::size_t size) {
+    void* ptr = allocate(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment) {
+    void* ptr = allocateAligned(size, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { std::free(ptr); }
@@ -0,0 +1,164 @@
+// AsyncLogger.cpp - Background formatting thread of the async logger
+
+#include "AsyncLogger.h"
+#include "ThreadAffinity.h"
+#include <charconv>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+
+namespace tws_bridge {
+
+namespace {
+
+const char* levelTag(LogLevel level) {
+    switch (level) {
+    case LogLevel::Debug:
+        return "DEBUG ";
+    case LogLevel::Info:
+        return "INFO  ";
+    case LogLevel::Warn:
+        return "WARN  ";
+    case LogLevel::Error:
+        return "ERROR ";
+    default:
+        return "";
+    }
+}
+
+void appendArg(const LogArg& arg, std::string& out) {
+    char buffer[32];
+    switch (arg.type) {
+    case LogArg::Type::Int: {
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), arg.i);
+        out.append(buffer, result.ptr);
+        break;
+    }
+    case LogArg::Type::Uint: {
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), arg.u);
+        out.append(buffer, result.ptr);
+        break;
+    }
+    case LogArg::Type::Double: {
+        // REASON: Matches the iostream output these messages used to have (6 significant digits)
+        const int length = std::snprintf(buffer, sizeof(buffer), "%g", arg.d);
+        out.append(buffer, length > 0 ? static_cast<std::size_t>(length) : 0);
+        break;
+    }
+    case LogArg::Type::Bool:
+        out.append(arg.b ? "true" : "false");
+        break;
+    case LogArg::Type::String:
+        out.append(arg.s, arg.length);
+        break;
+    }
+}
+
+} // namespace
+
+AsyncLogger& AsyncLogger::instance() {
+    // REASON: Function-local static - initialized on first use from any thread, destroyed after main
+    static AsyncLogger logger;
+    return logger;
+}
+
+SpscRing<LogRecord>* AsyncLogger::threadRing() {
+    thread_local SpscRing<LogRecord>* ring = registerThread();
+    return ring;
+}
+
+std::size_t AsyncLogger::rings() {
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    return m_rings.size();
+}
+
+SpscRing<LogRecord>* AsyncLogger::registerThread() {
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    m_rings.push_back(std::make_unique<SpscRing<LogRecord>>(kRingCapacity));
+    return m_rings.back().get();
+}
+
+void AsyncLogger::start() {
+    bool expected = false;
+    if (!m_running.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void AsyncLogger::stop() {
+    if (m_running.exchange(false) && m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void AsyncLogger::format(const LogRecord& record, std::string& out) {
+    // "HH:MM:SS.uuuuuu LEVEL message"
+    const std::time_t seconds = static_cast<std::time_t>(record.timestampUs / 1000000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char stamp[32];
+    const int length = std::snprintf(stamp, sizeof(stamp), "%02d:%02d:%02d.%06lld ", utc.tm_hour, utc.tm_min,
+                                     utc.tm_sec, static_cast<long long>(record.timestampUs % 1000000));
+    out.append(stamp, length > 0 ? static_cast<std::size_t>(length) : 0);
+    out.append(levelTag(record.level));
+
+    std::size_t next = 0;
+    for (const char* p = record.format; *p; ++p) {
+        if (p[0] == '{' && p[1] == '}') {
+            if (next < record.argCount) {
+                appendArg(record.args[next++], out);
+            }
+            ++p;
+        } else {
+            out.push_back(*p);
+        }
+    }
+}
+
+std::size_t AsyncLogger::drain(std::string& line) {
+    {
+        std::lock_guard<std::mutex> lock(m_ringsMutex);
+        if (m_drainRings.size() != m_rings.size()) {
+            for (std::size_t i = m_drainRings.size(); i < m_rings.size(); ++i) {
+                m_drainRings.push_back(m_rings[i].get());
+            }
+        }
+    }
+    // NOTE: Ordered per thread; records of different threads interleave by drain pass, not by time
+    LogRecord records[64];
+    std::size_t total = 0;
+    for (SpscRing<LogRecord>* ring : m_drainRings) {
+        std::size_t count = 0;
+        while ((count = ring->try_dequeue_bulk(records, 64)) > 0) {
+            for (std::size_t i = 0; i < count; ++i) {
+                line.clear();
+                format(records[i], line);
+                line.push_back('\n');
+                std::ostream& stream = records[i].level >= LogLevel::Warn ? std::cerr : std::cout;
+                stream.write(line.data(), static_cast<std::streamsize>(line.size()));
+            }
+            total += count;
+        }
+    }
+    if (total > 0) {
+        std::cout.flush();
+        m_counters.written.fetch_add(total, std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void AsyncLogger::run() {
+    nameCurrentThread("tws-logger");
+    std::string line;
+    line.reserve(256);
+    while (m_running.load(std::memory_order_relaxed)) {
+        if (drain(line) == 0) {
+            // REASON: Log latency is not critical - producers never pay for a wake-up
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    drain(line);  // Records queued right before stop()
+}
+
+} // namespace tws_bridge
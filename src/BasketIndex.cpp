@@ -0,0 +1,101 @@
+// BasketIndex.cpp - Basket publisher implementation
+
+#include "BasketIndex.h"
+#include "AsyncLogger.h"
+#include "Serialization.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <utility>
+
+namespace tws_bridge {
+
+BasketPublisher::BasketPublisher(const std::string& uri, const BasketBook& book, BasketConfig config)
+    : m_uri(uri)
+    , m_book(book)
+    , m_config(std::move(config)) {
+}
+
+BasketPublisher::~BasketPublisher() {
+    stop();
+}
+
+void BasketPublisher::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void BasketPublisher::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void BasketPublisher::run() {
+    nameCurrentThread("tws-baskets");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    std::vector<std::string> channels;
+    for (std::size_t i = 0; i < m_book.size(); ++i) {
+        channels.push_back("TWS:TICKS:" + m_book.definition(i).name);
+    }
+    std::vector<std::uint64_t> published(m_book.size(), 0);  // Version at the last publish
+    std::vector<std::string> payloads;
+    JsonBuffer json;
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - basket publishes never queue behind a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.connect_timeout = m_config.socketTimeout;
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+            while (m_running.load()) {
+                pause(m_config.interval);
+                if (!m_running.load()) {
+                    break;
+                }
+                const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                auto pipe = redis.pipeline(false);
+                payloads.clear();
+                std::vector<std::pair<std::size_t, std::uint64_t>> sent;  // (basket, version)
+                for (std::size_t i = 0; i < m_book.size(); ++i) {
+                    const std::uint64_t version = m_book.version(i);
+                    if (version == published[i]) {
+                        continue;  // NOTE: Unchanged since the last interval
+                    }
+                    serializeBasketSnapshot(m_book.definition(i).name, m_book.value(i), m_book.priced(i),
+                                            m_book.definition(i).constituents.size(), version, nowMs, json);
+                    payloads.emplace_back(json.data(), json.size());
+                    sent.emplace_back(i, version);
+                }
+                if (sent.empty()) {
+                    continue;
+                }
+                for (std::size_t j = 0; j < sent.size(); ++j) {
+                    pipe.publish(channels[sent[j].first], payloads[j]);
+                }
+                pipe.exec();
+                for (const auto& [basket, version] : sent) {
+                    published[basket] = version;  // REASON: Only once Redis took it - a failed interval is re-sent
+                }
+                m_counters.published.fetch_add(sent.size(), std::memory_order_relaxed);
+            }
+        } catch (const sw::redis::Error& e) {
+            BRIDGE_LOG_EVERY_MS(10000, LogLevel::Error, "[BASKETS] Redis error: {}", e.what());
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            pause(m_config.reconnectDelay);
+        }
+    }
+}
+
+} // namespace tws_bridge
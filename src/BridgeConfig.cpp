@@ -0,0 +1,973 @@
+// BridgeConfig.cpp - config.yaml keys → BridgeConfig, startup validation
+
+#include "BridgeConfig.h"
+#include "BarSize.h"
+#include <algorithm>
+#include <cctype>
+#include <initializer_list>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+namespace tws_bridge {
+
+BridgeConfig::BridgeConfig() {
+    // REASON: Library defaults differ from what the bridge runs with - these were main()'s constants
+    io.enabled = true;
+    ingest.policy = OverflowPolicy::ConflateLatest;
+    worker.numaLocal = true;
+}
+
+namespace {
+
+// Reads typed values out of a ConfigFile, collecting every error instead of stopping at the first
+class ConfigBinder {
+public:
+    explicit ConfigBinder(const ConfigFile& file) : m_file(file) {}
+
+    void bind(const char* key, std::string& target) {
+        if (const ConfigValue* value = scalar(key)) {
+            target = value->text;
+        }
+    }
+
+    void bind(const char* key, bool& target) {
+        const ConfigValue* value = scalar(key);
+        if (value && !parseConfigBool(value->text, target)) {
+            fail(key, *value, "expected true / false");
+        }
+    }
+
+    template <typename T>
+    void bind(const char* key, T& target, long long min, long long max) {
+        static_assert(std::is_integral_v<T>, "Integer keys only");
+        long long parsed = 0;
+        if (const ConfigValue* value = scalar(key); value && integer(key, *value, value->text, min, max, parsed)) {
+            target = static_cast<T>(parsed);
+        }
+    }
+
+    void bind(const char* key, double& target, double min) {
+        const ConfigValue* value = scalar(key);
+        double parsed = 0.0;
+        if (value && (!parseConfigDouble(value->text, parsed) || parsed < min)) {
+            fail(key, *value, "expected a number >= " + std::to_string(min));
+        } else if (value) {
+            target = parsed;
+        }
+    }
+
+    template <typename Rep, typename Period>
+    void bind(const char* key, std::chrono::duration<Rep, Period>& target) {
+        const ConfigValue* value = scalar(key);
+        if (value && !parseConfigDuration(value->text, target)) {
+            fail(key, *value, "expected a duration such as 500us, 100ms, 30s (whole units of the setting)");
+        }
+    }
+
+    template <typename E>
+    void bindEnum(const char* key, E& target, std::initializer_list<std::pair<const char*, E>> names) {
+        const ConfigValue* value = scalar(key);
+        if (!value) {
+            return;
+        }
+        std::string expected;
+        for (const auto& [name, option] : names) {
+            if (value->text == name) {
+                target = option;
+                return;
+            }
+            expected += expected.empty() ? name : std::string(" / ") + name;
+        }
+        fail(key, *value, "expected " + expected);
+    }
+
+    void bind(const char* key, std::vector<std::string>& target) {
+        if (const ConfigValue* value = list(key)) {
+            target = value->items;
+        }
+    }
+
+    void bind(const char* key, std::vector<int>& target, long long min, long long max) {
+        const ConfigValue* value = list(key);
+        if (!value) {
+            return;
+        }
+        std::vector<int> parsed;
+        for (const std::string& item : value->items) {
+            long long number = 0;
+            if (!integer(key, *value, item, min, max, number)) {
+                return;
+            }
+            parsed.push_back(static_cast<int>(number));
+        }
+        target = std::move(parsed);
+    }
+
+    // prefix.cpus: [..] (one per thread, -1 = float) + prefix.priority (SCHED_FIFO for all of them)
+    void bindThreads(const std::string& prefix, std::vector<ThreadConfig>& target) {
+        std::vector<int> cpus;
+        for (const ThreadConfig& thread : target) {
+            cpus.push_back(thread.cpu);
+        }
+        int priority = target.empty() ? 0 : target.front().fifoPriority;
+        const std::string cpusKey = prefix + ".cpus";
+        const std::string priorityKey = prefix + ".priority";
+        bind(cpusKey.c_str(), cpus, -1, 1023);
+        bind(priorityKey.c_str(), priority, 0, 99);
+        target.clear();
+        for (int cpu : cpus) {
+            target.push_back(ThreadConfig{cpu, priority});
+        }
+    }
+
+    // Anything in the file nobody asked for is a typo or a stale key
+    void rejectUnknown() {
+        for (const auto& [key, value] : m_file.values()) {
+            if (!m_used.count(key)) {
+                fail(key.c_str(), value, "unknown key");
+            }
+        }
+    }
+
+    void error(const std::string& message) { m_errors.push_back(message); }
+
+    bool finish(std::string& error) const {
+        error.clear();
+        for (const std::string& message : m_errors) {
+            error += (error.empty() ? "" : "\n") + message;
+        }
+        return m_errors.empty();
+    }
+
+private:
+    const ConfigValue* find(const char* key) {
+        m_used.insert(key);
+        return m_file.find(key);
+    }
+
+    const ConfigValue* scalar(const char* key) {
+        const ConfigValue* value = find(key);
+        if (value && value->list) {
+            fail(key, *value, "expected a single value, not a list");
+            return nullptr;
+        }
+        return value;
+    }
+
+    const ConfigValue* list(const char* key) {
+        const ConfigValue* value = find(key);
+        if (value && !value->list) {
+            fail(key, *value, "expected a list ([a, b] or '- a' lines)");
+            return nullptr;
+        }
+        return value;
+    }
+
+    bool integer(const char* key, const ConfigValue& value, const std::string& text, long long min, long long max,
+                 long long& out) {
+        if (!parseConfigInt(text, out) || out < min || out > max) {
+            fail(key, value, "expected an integer in [" + std::to_string(min) + ", " + std::to_string(max) + "]");
+            return false;
+        }
+        return true;
+    }
+
+    void fail(const char* key, const ConfigValue& value, const std::string& why) {
+        const std::string where = value.line > 0 ? "line " + std::to_string(value.line) : "--set";
+        m_errors.push_back(std::string(key) + " (" + where + "): " + why);
+    }
+
+    const ConfigFile& m_file;
+    std::set<std::string> m_used;
+    std::vector<std::string> m_errors;
+};
+
+constexpr long long kMaxSize = std::numeric_limits<std::int32_t>::max();
+
+// "NAME=SYM,SYM,... move=0.01 size=20% heartbeat=5s" (worker.deadband.classes entry), settings left out
+// keep out.rule's values (the worker.deadband defaults); false if malformed
+bool parseDeadbandClass(std::string_view text, DeadbandClass& out) {
+    const std::size_t space = text.find(' ');
+    const std::string_view head = text.substr(0, space);
+    const std::size_t equals = head.find('=');
+    if (equals == std::string_view::npos || equals == 0 || equals + 1 == head.size()) {
+        return false;
+    }
+    out.name.assign(head.substr(0, equals));
+    out.symbols.clear();
+    for (std::string_view symbols = head.substr(equals + 1); !symbols.empty();) {
+        const std::size_t comma = symbols.find(',');
+        const std::string_view symbol = symbols.substr(0, comma);
+        if (symbol.empty()) {
+            return false;
+        }
+        out.symbols.emplace_back(symbol);
+        symbols.remove_prefix(comma == std::string_view::npos ? symbols.size() : comma + 1);
+    }
+    std::string_view rest = space == std::string_view::npos ? std::string_view() : text.substr(space);
+    while (!rest.empty()) {
+        const std::size_t begin = rest.find_first_not_of(' ');
+        if (begin == std::string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(begin);
+        const std::string_view setting = rest.substr(0, rest.find(' '));
+        rest.remove_prefix(setting.size());
+        const std::size_t assign = setting.find('=');
+        const std::string_view key = setting.substr(0, assign);
+        const std::string_view value = assign == std::string_view::npos ? std::string_view() : setting.substr(assign + 1);
+        double number = 0.0;
+        if (key == "move" && parseConfigDouble(value, number) && number >= 0.0) {
+            out.rule.minMove = number;
+        } else if (key == "size" && !value.empty() && value.back() == '%'
+                   && parseConfigDouble(value.substr(0, value.size() - 1), number) && number >= 0.0) {
+            out.rule.minSizeChange = number / 100.0;
+        } else if (key != "heartbeat" || !parseConfigDuration(value, out.rule.heartbeat)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bindTws(ConfigBinder& in, BridgeConfig& config) {
+    in.bind("tws.host", config.twsHost);
+    in.bind("tws.port", config.twsPort, 1, 65535);
+    in.bind("tws.client_ids", config.clientIds, 0, kMaxSize);
+    in.bindEnum("tws.reader", config.readerMode, {{"tws_api", ReaderMode::TwsApi},
+                                                  {"bridge_ring", ReaderMode::BridgeRing},
+                                                  {"inline", ReaderMode::Inline}});
+    in.bind("tws.reader_poll", config.readerPoll);
+    in.bind("tws.socket.no_delay", config.socket.noDelay);
+    in.bind("tws.socket.receive_buffer", config.socket.receiveBuffer, 0, kMaxSize);
+    in.bind("tws.socket.busy_poll_us", config.socket.busyPollUs, 0, 1000000);
+    in.bind("tws.socket.quick_ack", config.socket.quickAck);
+    in.bind("tws.messages.filter", config.messages.enabled);
+    in.bind("tws.messages.allow", config.messages.allow, 0, MessageFilter::kMaxMsgId - 1);
+    in.bind("tws.pacing.messages_per_second", config.pacing.messagesPerSecond, 0.1);
+    in.bind("tws.pacing.burst", config.pacing.burst, 1.0);
+    in.bind("tws.pacing.max_tick_by_tick", config.pacing.maxTickByTick, 0, kMaxSize);
+    in.bind("tws.reconnect.enabled", config.reconnect.enabled);
+    in.bind("tws.reconnect.initial_delay", config.reconnect.initialDelay);
+    in.bind("tws.reconnect.max_delay", config.reconnect.maxDelay);
+    in.bind("tws.reconnect.max_attempts", config.reconnect.maxAttempts, 0, kMaxSize);
+    in.bind("tws.backfill.enabled", config.backfill.enabled);
+    in.bind("tws.backfill.max_gap", config.backfill.maxGap);
+    in.bind("tws.backfill.max_pages", config.backfill.maxPages, 1, 1000);
+}
+
+void bindRedis(ConfigBinder& in, BridgeConfig& config) {
+    in.bind("redis.uri", config.redisUri);
+    in.bind("redis.pool_size", config.connection.poolSize, 1, 1024);
+    in.bind("redis.connect_timeout", config.connection.connectTimeout);
+    in.bind("redis.socket_timeout", config.connection.socketTimeout);
+    in.bind("redis.wait_timeout", config.connection.waitTimeout);
+    in.bind("redis.keep_alive", config.connection.keepAlive);
+    in.bind("redis.cluster", config.connection.cluster);
+    in.bind("redis.sharded_pubsub", config.connection.shardedPubSub);
+    in.bind("redis.direct_resp", config.connection.directResp);
+    in.bind("redis.function_batches", config.connection.functionBatches);
+    in.bindEnum("redis.resp_backend", config.connection.respBackend, {{"socket", RespBackend::Socket},
+                                                                      {"io_uring", RespBackend::IoUring}});
+    in.bind("redis.batch.max_messages", config.batch.maxMessages, 1, kMaxSize);
+    in.bind("redis.batch.max_delay", config.batch.maxDelay);
+    in.bind("redis.stream.max_len", config.stream.maxLen, 0, std::numeric_limits<long long>::max());
+    in.bind("redis.stream.approximate", config.stream.approximate);
+    in.bind("redis.io_thread.enabled", config.io.enabled);
+    in.bind("redis.io_thread.max_in_flight", config.io.maxInFlightBatches, 1, kMaxSize);
+    in.bind("redis.breaker.enabled", config.outage.breaker.enabled);
+    in.bind("redis.breaker.failure_threshold", config.outage.breaker.failureThreshold, 1, kMaxSize);
+    in.bind("redis.breaker.probe_interval", config.outage.breaker.probeInterval);
+    in.bind("redis.breaker.max_probe_interval", config.outage.breaker.maxProbeInterval);
+    in.bind("redis.spill_capacity", config.outage.spillCapacity, 0, kMaxSize);
+    in.bind("redis.watch_subscribers", config.watchSubscribers);
+}
+
+void bindIngest(ConfigBinder& in, BridgeConfig& config) {
+    in.bind("ingest.shards", config.shards, 1, 256);
+    in.bind("ingest.queue_capacity", config.queueCapacity, 1, kMaxSize);
+    in.bind("ingest.sizing.enabled", config.sizing.enabled);
+    in.bind("ingest.sizing.adopt", config.sizing.adopt);
+    in.bind("ingest.sizing.path", config.sizing.path);
+    in.bind("ingest.sizing.stall_percentile", config.sizing.stallPercentile, 50.0);
+    in.bind("ingest.sizing.headroom", config.sizing.headroom, 1.0);
+    in.bind("ingest.sizing.min_capacity", config.sizing.minCapacity, 1, kMaxSize);
+    in.bind("ingest.sizing.max_capacity", config.sizing.maxCapacity, 1, kMaxSize);
+    in.bind("ingest.symbol_capacity", config.symbolCapacity, 1, kMaxSize);
+    in.bindEnum("ingest.mode", config.ingest.mode, {{"queue", IngestMode::Queue}, {"coalesce", IngestMode::Coalesce}});
+    in.bindEnum("ingest.overflow", config.ingest.policy, {{"drop_newest", OverflowPolicy::DropNewest},
+                                                         {"conflate_latest", OverflowPolicy::ConflateLatest},
+                                                         {"spill", OverflowPolicy::Spill},
+                                                         {"prioritize_trades", OverflowPolicy::PrioritizeTrades}});
+    in.bindEnum("ingest.wait.mode", config.wait.mode, {{"busy_spin", WaitMode::BusySpin},
+                                                      {"hybrid", WaitMode::Hybrid},
+                                                      {"blocking", WaitMode::Blocking},
+                                                      {"reactor", WaitMode::Reactor}});
+    in.bind("ingest.wait.spin_iterations", config.wait.spinIterations, 0, kMaxSize);
+    in.bind("ingest.wait.yield_iterations", config.wait.yieldIterations, 0, kMaxSize);
+    in.bind("ingest.wait.park_timeout", config.wait.parkTimeout);
+    in.bind("ingest.huge_pages", config.ingest.memory.enabled);
+    in.bind("ingest.lock_memory", config.ingest.memory.lock);
+    in.bind("ingest.rebalance.enabled", config.rebalance.enabled);
+    in.bind("ingest.rebalance.interval", config.rebalance.interval);
+    in.bind("ingest.rebalance.half_life", config.rebalance.halfLife);
+    in.bind("ingest.rebalance.threshold", config.rebalance.threshold, 1.0);
+    in.bind("ingest.rebalance.min_rate", config.rebalance.minRate, 0.0);
+    in.bind("ingest.rebalance.handoff_timeout", config.rebalance.handoffTimeout);
+}
+
+void bindWorker(ConfigBinder& in, BridgeConfig& config) {
+    WorkerConfig& worker = config.worker;
+    in.bind("worker.batch_size", worker.batchSize, 1, kMaxSize);
+    in.bind("worker.adaptive.enabled", worker.adaptive.enabled);
+    in.bind("worker.adaptive.max_batch", worker.adaptive.maxBatch, 1, kMaxSize);
+    in.bind("worker.adaptive.max_pipeline", worker.adaptive.maxPipeline, 1, kMaxSize);
+    in.bind("worker.adaptive.max_added_latency", worker.adaptive.maxAddedLatency);
+    in.bind("worker.stats_interval", worker.statsInterval);
+    in.bind("worker.drain_timeout", worker.drainTimeout);
+    in.bindEnum("worker.schema", worker.snapshotSchema, {{"verbose", SnapshotSchema::Verbose},
+                                                         {"compact", SnapshotSchema::Compact}});
+    in.bindEnum("worker.price_format", worker.priceFormat, {{"shortest", PriceFormat::Shortest},
+                                                            {"fixed_point", PriceFormat::FixedPoint}});
+    in.bind("worker.iso_timestamps", worker.isoTimestamps);
+    in.bind("worker.send_timestamps", worker.sendTimestamps);
+    in.bindEnum("worker.publish_policy", worker.publishPolicy.policy, {{"any_change", PublishPolicy::AnyChange},
+                                                                       {"when_complete", PublishPolicy::WhenComplete},
+                                                                       {"field_change", PublishPolicy::FieldChange}});
+    std::vector<std::string> fields;
+    in.bind("worker.publish_fields", fields);
+    if (!fields.empty()) {
+        static const std::pair<const char*, std::uint8_t> kFields[] = {
+            {"bid_price", SnapshotFields::BidPrice}, {"ask_price", SnapshotFields::AskPrice},
+            {"last_price", SnapshotFields::LastPrice}, {"bid_size", SnapshotFields::BidSize},
+            {"ask_size", SnapshotFields::AskSize}, {"last_size", SnapshotFields::LastSize}};
+        worker.publishPolicy.fields = 0;
+        for (const std::string& field : fields) {
+            const auto* match = std::find_if(std::begin(kFields), std::end(kFields),
+                                             [&field](const auto& entry) { return field == entry.first; });
+            if (match == std::end(kFields)) {
+                in.error("worker.publish_fields: unknown field '" + field + "'");
+            } else {
+                worker.publishPolicy.fields |= match->second;
+            }
+        }
+    }
+    in.bind("worker.suppress_duplicates", worker.suppressDuplicates);
+    in.bind("worker.deadband.enabled", worker.deadband.enabled);
+    in.bind("worker.deadband.min_move", worker.deadband.defaults.minMove, 0.0);
+    double sizeChangePct = worker.deadband.defaults.minSizeChange * 100.0;
+    in.bind("worker.deadband.min_size_change_pct", sizeChangePct, 0.0);
+    worker.deadband.defaults.minSizeChange = sizeChangePct / 100.0;
+    in.bind("worker.deadband.heartbeat", worker.deadband.defaults.heartbeat);
+    std::vector<std::string> deadbandClasses;
+    in.bind("worker.deadband.classes", deadbandClasses);
+    worker.deadband.classes.clear();
+    for (const std::string& text : deadbandClasses) {
+        DeadbandClass parsed;
+        parsed.rule = worker.deadband.defaults;
+        if (!parseDeadbandClass(text, parsed)) {
+            in.error("worker.deadband.classes: '" + text
+                     + "' is not NAME=SYMBOL,... [move=0.01] [size=20%] [heartbeat=5s]");
+            continue;
+        }
+        worker.deadband.classes.push_back(std::move(parsed));
+    }
+    in.bind("worker.volume_profile.enabled", worker.volumeProfile.enabled);
+    in.bind("worker.volume_profile.bucket_width", worker.volumeProfile.bucketWidth, 0.0);
+    in.bind("worker.volume_profile.chunk_buckets", worker.volumeProfile.chunkBuckets, 1, 65536);
+    in.bind("worker.volume_profile.max_buckets", worker.volumeProfile.maxBuckets, 1, 1 << 20);
+    in.bind("worker.volume_profile.interval", worker.volumeProfile.interval);
+    in.bind("worker.session_stats.enabled", worker.sessionStats.enabled);
+    in.bind("worker.session_stats.interval", worker.sessionStats.interval);
+    in.bind("worker.tick_filter.enabled", worker.tickFilter.enabled);
+    in.bindEnum("worker.tick_filter.action", worker.tickFilter.drop, {{"drop", true}, {"count", false}});
+    in.bind("worker.tick_filter.reject_locked", worker.tickFilter.rejectLocked);
+    in.bind("worker.tick_filter.outlier_spreads", worker.tickFilter.outlierSpreads, 0.0);
+    in.bind("worker.tick_filter.spread_window", worker.tickFilter.spreadWindow, 1, 100000);
+    in.bind("worker.tick_filter.outlier_confirm", worker.tickFilter.outlierConfirm, 1, 1000);
+    in.bindEnum("worker.tick_output", worker.tickOutput, {{"pubsub", TickOutput::PubSub},
+                                                          {"stream", TickOutput::Stream},
+                                                          {"both", TickOutput::Both}});
+    in.bind("worker.last_value", worker.writeLastValue);
+    in.bindEnum("worker.last_value_format", worker.lastValueFormat, {{"json", LastValueFormat::Json},
+                                                                     {"hash", LastValueFormat::Hash}});
+    in.bind("worker.warm_start", config.warmStart.enabled);
+    in.bind("worker.checkpoint.enabled", config.checkpoint.enabled);
+    in.bind("worker.checkpoint.name", config.checkpoint.name);
+    in.bind("worker.binary", worker.publishBinary);
+    in.bind("worker.numa_local", worker.numaLocal);
+    in.bind("worker.history_chunk_bars", worker.historyChunkBars, 1, kMaxSize);
+    in.bind("worker.live_bar_interval", worker.liveBarInterval);
+    in.bind("worker.tape_length", worker.tapeLength, 0, 100000);
+    in.bind("worker.conflation.enabled", worker.conflation.enabled);
+    in.bind("worker.conflation.window", worker.conflation.window);
+    in.bind("worker.conflation.trades_individually", worker.conflation.publishTradesIndividually);
+    in.bind("worker.conflation.reduce_batch", worker.conflation.reduceBatch);
+    in.bind("worker.aggregate.enabled", worker.aggregate.enabled);
+    in.bind("worker.aggregate.channel", worker.aggregate.channel);
+    in.bind("worker.aggregate.window", worker.aggregate.window);
+    in.bind("worker.aggregate.max_snapshots", worker.aggregate.maxSnapshots, 1, kMaxSize);
+    in.bind("worker.aggregate.per_symbol", worker.aggregate.perSymbol);
+    in.bind("worker.aggregate.encoder_threads", worker.aggregate.encoderThreads, 0, 64);
+    in.bind("worker.aggregate.encoder_batches", worker.aggregate.encoderBatches, 1, 4096);
+    in.bind("worker.delta.enabled", worker.delta.enabled);
+    in.bind("worker.delta.keyframe_every", worker.delta.keyframeEvery, 1, 1000000);
+    in.bind("worker.delta.keyframe_interval", worker.delta.keyframeInterval);
+    in.bind("worker.compression.aggregate", worker.compression.aggregate);
+    in.bind("worker.compression.stream", worker.compression.stream);
+    in.bind("worker.compression.min_bytes", worker.compression.minBytes, 0, kMaxSize);
+    std::vector<std::string> tiers;
+    in.bind("worker.tiers", tiers);
+    if (tiers.size() > 4) {
+        in.error("worker.tiers: at most 4");
+    }
+    worker.tiers.clear();
+    for (const std::string& tier : tiers) {
+        // "10hz" -> channel segment "10HZ", interval 100ms
+        const std::size_t digits = tier.find_first_not_of("0123456789");
+        std::string unit = digits == std::string::npos ? std::string() : tier.substr(digits);
+        std::transform(unit.begin(), unit.end(), unit.begin(), [](unsigned char c) { return std::toupper(c); });
+        const int hz = digits == 0 || digits > 4 ? 0 : std::stoi(tier.substr(0, digits));
+        if (unit != "HZ" || hz < 1 || hz > 1000) {
+            in.error("worker.tiers: '" + tier + "' is not a rate from 1hz to 1000hz");
+            continue;
+        }
+        worker.tiers.push_back({std::to_string(hz) + unit, std::chrono::microseconds(1000000 / hz)});
+    }
+    in.bindEnum("worker.depth.output", worker.depth.output, {{"snapshot", DepthOutput::Snapshot},
+                                                             {"delta", DepthOutput::Delta},
+                                                             {"both", DepthOutput::Both}});
+    in.bind("worker.depth.levels", worker.depth.levels, 1, 100);
+    in.bind("worker.options.interval", worker.options.interval);
+    in.bind("worker.options.keyframe_every", worker.options.keyframeEvery, 0, 1000000);
+    in.bind("worker.bar_store.enabled", worker.barStore.enabled);
+    in.bind("worker.bar_store.retain_bars", worker.barStore.retainBars, 0, kMaxSize);
+    in.bind("worker.bar_store.trim_interval", worker.barStore.trimInterval);
+    in.bind("worker.bar_builder.enabled", worker.barBuilder.enabled);
+    std::vector<std::string> timeframes;
+    in.bind("worker.bar_builder.timeframes", timeframes);
+    if (!timeframes.empty()) {
+        if (timeframes.size() > BarBuilder::kMaxTimeframes) {
+            in.error("worker.bar_builder.timeframes: at most " + std::to_string(BarBuilder::kMaxTimeframes));
+        }
+        worker.barBuilder.timeframes.fill(BarSize::Unknown);
+        for (std::size_t i = 0; i < timeframes.size() && i < BarBuilder::kMaxTimeframes; ++i) {
+            BarSize size = BarSize::Unknown;
+            for (std::size_t code = 1; code < kBarSizeCount; ++code) {
+                if (timeframes[i] == barSizeLabel(static_cast<BarSize>(code))) {
+                    size = static_cast<BarSize>(code);
+                }
+            }
+            if (size == BarSize::Unknown || barSizeSeconds(size) > 3600) {
+                in.error("worker.bar_builder.timeframes: '" + timeframes[i] + "' is not a bar size up to 1h (1s, 5s, 1m, ...)");
+            }
+            worker.barBuilder.timeframes[i] = size;
+        }
+    }
+    in.bind("worker.bar_builder.grace", worker.barBuilder.grace);
+    in.bind("worker.derived_metrics.enabled", worker.derivedMetrics.enabled);
+    in.bind("worker.derived_metrics.session_reset", worker.derivedMetrics.sessionReset);
+    in.bind("worker.derived_metrics.rolling_window", worker.derivedMetrics.rollingWindow);
+    in.bind("worker.latency.enabled", worker.latency.enabled);
+    in.bind("worker.latency.interval", worker.latency.interval);
+    in.bind("worker.latency.status_channel", worker.latency.statusChannel);
+    in.bind("worker.lag.enabled", worker.lag.enabled);
+    in.bind("worker.lag.warn", worker.lag.warn);
+    in.bind("worker.lag.critical", worker.lag.critical);
+    in.bind("worker.flight.enabled", worker.flight.enabled);
+    in.bind("worker.flight.capacity", worker.flight.capacity, 2, 1 << 24);
+    in.bind("worker.flight.threshold", worker.flight.threshold);
+    in.bind("worker.flight.cooldown", worker.flight.cooldown);
+    in.bind("worker.flight.dir", worker.flight.dir);
+    in.bind("worker.shm.enabled", worker.shm.enabled);
+    in.bind("worker.shm.name", worker.shm.name);
+    in.bind("worker.shm.slots", worker.shm.slots, 1, kMaxSize);
+    in.bind("worker.shm.slot_bytes", worker.shm.slotBytes, 64, kMaxSize);
+}
+
+void bindLoadShed(ConfigBinder& in, BridgeConfig& config) {
+    LoadShedConfig& shed = config.loadShed;
+    in.bind("load_shed.enabled", shed.enabled);
+    in.bind("load_shed.queue_age", shed.queueAge);
+    in.bind("load_shed.queue_depth", shed.queueDepth, 1, kMaxSize);
+    in.bind("load_shed.publish_latency", shed.publishLatency);
+    in.bind("load_shed.escalate_after", shed.escalateAfter);
+    in.bind("load_shed.recover_after", shed.recoverAfter);
+    in.bind("load_shed.conflation_window", shed.conflationWindow);
+    in.bind("load_shed.low_priority", shed.lowPriority);
+}
+
+void bindDemand(ConfigBinder& in, BridgeConfig& config) {
+    DemandConfig& demand = config.demand;
+    in.bind("demand.enabled", demand.enabled);
+    in.bindEnum("demand.active_feed", demand.activeFeed, {{"auto", FeedType::Auto},
+                                                          {"tick_by_tick", FeedType::TickByTick},
+                                                          {"mid_point", FeedType::MidPoint}});
+    in.bindEnum("demand.idle_feed", demand.idleFeed, {{"top_of_book", DemandIdle::TopOfBook},
+                                                      {"none", DemandIdle::None}});
+    in.bind("demand.subscribers", demand.subscribers);
+    in.bind("demand.default_ttl", demand.defaultTtl);
+    in.bind("demand.max_ttl", demand.maxTtl);
+    in.bind("demand.upgrade_after", demand.upgradeAfter);
+    in.bind("demand.downgrade_after", demand.downgradeAfter);
+}
+
+void bindServices(ConfigBinder& in, BridgeConfig& config) {
+    in.bind("threads.compact", config.compact);
+    in.bindThreads("threads.msg", config.msgThreads);
+    in.bindThreads("threads.reader", config.readerThreads);
+    in.bindThreads("threads.worker", config.workerThreads);
+    in.bindThreads("threads.redis_io", config.redisIoThreads);
+    in.bind("threads.background.threads", config.background.threads, 0, 64);
+    in.bind("threads.background.cpus", config.background.cpus, 0, 1023);
+    in.bind("metrics.enabled", config.metricsEnabled);
+    in.bind("metrics.port", config.metricsPort, 1, 65535);
+    in.bind("journal.enabled", config.journalEnabled);
+    in.bind("journal.dir", config.journalDir);
+    in.bindEnum("journal.format", config.journalFormat, {{"raw", JournalFormat::Raw},
+                                                         {"compressed", JournalFormat::Compressed}});
+    in.bind("journal.block_bytes", config.journalBlockBytes, 4096, 1 << 20);
+    in.bind("journal.index", config.journalIndex);
+    in.bind("archive.prefix", config.snapshotArchive);
+    in.bind("kafka.enabled", config.kafka.enabled);
+    in.bind("kafka.brokers", config.kafka.brokers);
+    in.bind("kafka.topic", config.kafka.topic);
+    in.bindEnum("kafka.partitioner", config.kafka.partitioner, {{"symbol", KafkaPartitioner::Symbol},
+                                                                {"slot", KafkaPartitioner::Slot}});
+    in.bindEnum("kafka.format", config.kafka.format, {{"json", KafkaFormat::Json}, {"binary", KafkaFormat::Binary}});
+    in.bind("kafka.linger", config.kafka.linger);
+    in.bind("kafka.batch_bytes", config.kafka.batchBytes, 1, kMaxSize);
+    in.bind("kafka.compression", config.kafka.compression);
+    in.bind("kafka.acks", config.kafka.acks);
+    in.bind("kafka.queue_messages", config.kafka.queueMessages, 1, 10000000);
+    in.bind("websocket.enabled", config.websocket.enabled);
+    in.bind("websocket.bind", config.websocket.bindAddress);
+    in.bind("websocket.port", config.websocket.port, 1, 65535);
+    in.bindEnum("websocket.format", config.websocket.binary, {{"json", false}, {"binary", true}});
+    in.bind("websocket.max_connections", config.websocket.maxConnections, 1, 65536);
+    in.bind("websocket.stall_timeout", config.websocket.stallTimeout);
+    in.bind("query.enabled", config.query.enabled);
+    in.bind("query.socket", config.query.socketPath);
+    in.bind("journal_server.bind", config.journalServer.bindAddress);
+    in.bind("journal_server.port", config.journalServer.port, 0, 65535);
+    in.bind("journal_server.max_clients", config.journalServer.maxClients, 1, 1024);
+    in.bind("journal_server.io_timeout", config.journalServer.ioTimeout);
+    in.bind("journal_server.stream_max_len", config.journalServer.streamMaxLen, 1, 1000000000);
+    in.bind("leader.enabled", config.leader.enabled);
+    in.bind("leader.key", config.leader.key);
+    in.bind("leader.id", config.leader.id);
+    in.bind("leader.ttl", config.leader.ttl);
+    in.bind("leader.renew_interval", config.leader.renewInterval);
+    in.bind("partition.enabled", config.partition.enabled);
+    in.bind("partition.members_key", config.partition.membersKey);
+    in.bind("partition.universe_key", config.partition.universeKey);
+    in.bind("partition.id", config.partition.id);
+    in.bind("partition.heartbeat", config.partition.heartbeat);
+    in.bind("partition.member_timeout", config.partition.memberTimeout);
+    in.bind("contracts.cache_path", config.contracts.path);
+    in.bind("contracts.max_age", config.contracts.maxAge);
+    in.bind("account.enabled", config.account.enabled);
+    in.bind("account.id", config.account.id);
+    in.bind("account.interval", config.account.interval);
+    in.bind("news.enabled", config.news.enabled);
+    in.bind("news.providers", config.news.providers);
+    in.bind("news.symbols", config.news.symbols);
+    in.bind("news.interval", config.news.interval);
+    in.bind("news.max_per_pass", config.news.maxPerPass, 1, kMaxSize);
+    in.bind("news.queue_limit", config.news.queueLimit, 1, kMaxSize);
+    in.bind("news.dedupe_capacity", config.news.dedupeCapacity, 16, 1LL << 26);
+    in.bind("time_series.enabled", config.timeSeries.enabled);
+    in.bind("time_series.retention", config.timeSeries.retention);
+    std::vector<std::string> compactions;
+    in.bind("time_series.compactions", compactions);
+    for (const std::string& compaction : compactions) {
+        // "<bucket>:<retention>", e.g. 1m:720h
+        const std::size_t colon = compaction.find(':');
+        TimeSeriesCompaction parsed;
+        if (colon == std::string::npos || !parseConfigDuration(std::string_view(compaction).substr(0, colon), parsed.bucket)
+            || !parseConfigDuration(std::string_view(compaction).substr(colon + 1), parsed.retention)
+            || parsed.bucket.count() <= 0) {
+            in.error("time_series.compactions: '" + compaction + "' is not <bucket>:<retention> (e.g. 1m:720h)");
+            continue;
+        }
+        config.timeSeries.compactions.push_back(parsed);
+    }
+    in.bind("watchdog.enabled", config.watchdog.enabled);
+    in.bind("watchdog.interval", config.watchdog.interval);
+    in.bind("watchdog.stall_after", config.watchdog.stallAfter);
+    in.bind("watchdog.stack_dump", config.watchdog.stackDump);
+    in.bind("watchdog.reconnect", config.watchdog.reconnect);
+    in.bind("status.enabled", config.status.enabled);
+    in.bind("status.interval", config.status.interval);
+    in.bind("report.enabled", config.report.enabled);
+    in.bind("report.interval", config.report.interval);
+    in.bind("report.directory", config.report.directory);
+    in.bind("report.key_prefix", config.report.keyPrefix);
+    in.bind("report.retention", config.report.retention);
+    in.bind("trace.enabled", config.trace.enabled);
+    in.bind("trace.sample_every", config.trace.sampleEvery, 1, 1 << 30);
+    in.bind("trace.buffer", config.trace.bufferSpans, 1024, 1 << 24);
+    in.bind("trace.flush_interval", config.trace.flushInterval);
+    in.bind("trace.path", config.trace.path);
+    in.bind("profiler.enabled", config.profiler.enabled);
+    in.bind("profiler.frequency", config.profiler.frequency, 1, 1000);
+    in.bind("profiler.default_duration", config.profiler.defaultDuration);
+    in.bind("profiler.max_duration", config.profiler.maxDuration);
+    in.bind("profiler.max_samples", config.profiler.maxSamples, 1024, 1 << 22);
+    in.bind("profiler.dir", config.profiler.dir);
+    in.bind("profiler.key", config.profiler.key);
+    in.bindEnum("allocations.guard", config.allocations.guard, {{"off", AllocationGuardMode::Off},
+                                                                {"count", AllocationGuardMode::Count},
+                                                                {"log", AllocationGuardMode::Log},
+                                                                {"abort", AllocationGuardMode::Abort}});
+    in.bind("allocations.warmup", config.allocations.warmup);
+    in.bind("memory.ingest_spill_mb", config.memory.ingestSpillMb, 0, 1 << 20);
+    in.bind("memory.publish_spill_mb", config.memory.publishSpillMb, 0, 1 << 20);
+    in.bind("memory.history_mb", config.memory.historyMb, 0, 1 << 20);
+    in.bind("memory.websocket_mb", config.memory.websocketMb, 0, 1 << 20);
+    std::vector<std::string> baskets;
+    in.bind("baskets.definitions", baskets);
+    for (const std::string& basket : baskets) {
+        BasketDefinition parsed;
+        if (!parseBasket(basket, parsed)) {
+            in.error("baskets.definitions: '" + basket + "' is not NAME=SYMBOL:weight,... (e.g. SEMIS=NVDA:0.5,AMD:0.5)");
+            continue;
+        }
+        config.baskets.baskets.push_back(std::move(parsed));
+    }
+    in.bind("baskets.interval", config.baskets.interval);
+    in.bind("movers.enabled", config.movers.enabled);
+    in.bind("movers.top", config.movers.top, 1, 1000);
+    in.bind("movers.interval", config.movers.interval);
+    in.bind("movers.channel", config.movers.channel);
+    std::vector<std::string> scans;
+    in.bind("scanner.scans", scans);
+    for (const std::string& scan : scans) {
+        ScanDefinition parsed;
+        if (!parseScanDefinition(scan, parsed)) {
+            in.error("scanner.scans: '" + scan + "' is not ID=SCAN_CODE@LOCATION[:rows] (e.g. GAINERS=TOP_PERC_GAIN@STK.US.MAJOR:25)");
+            continue;
+        }
+        config.scanner.scans.push_back(std::move(parsed));
+    }
+    in.bind("scanner.channel_prefix", config.scanner.channelPrefix);
+    in.bind("scanner.auto_subscribe", config.scanner.autoSubscribe);
+    in.bindEnum("scanner.feed", config.scanner.feed, {{"auto", FeedType::Auto},
+                                                      {"tick_by_tick", FeedType::TickByTick},
+                                                      {"top_of_book", FeedType::TopOfBook},
+                                                      {"mid_point", FeedType::MidPoint}});
+    in.bind("scanner.priority", config.scanner.priority, -1000000, 1000000);
+    in.bindEnum("log.level", config.logLevel, {{"debug", LogLevel::Debug}, {"info", LogLevel::Info},
+                                               {"warn", LogLevel::Warn}, {"error", LogLevel::Error},
+                                               {"off", LogLevel::Off}});
+    in.bind("subscriptions.symbols", config.symbols);
+    in.bindEnum("subscriptions.feed", config.feed, {{"auto", FeedType::Auto},
+                                                    {"tick_by_tick", FeedType::TickByTick},
+                                                    {"top_of_book", FeedType::TopOfBook},
+                                                    {"mid_point", FeedType::MidPoint}});
+    in.bind("subscriptions.universe_file", config.universe.path);
+    in.bind("subscriptions.universe_key", config.universe.key);
+    in.bind("subscriptions.universe_poll", config.universe.pollInterval);
+    in.bind("subscriptions.historical_bars", config.historicalBars);
+    in.bind("subscriptions.realtime_bars", config.realTimeBars);
+    in.bind("subscriptions.keep_bars_up_to_date", config.keepBarsUpToDate);
+    in.bind("subscriptions.history_window", config.history.window);
+    in.bind("subscriptions.incremental_history", config.history.incremental);
+    in.bind("commands.channel", config.commands.channel);
+    in.bind("commands.batch_window", config.commands.batchWindow);
+    in.bind("commands.max_batch", config.commands.maxBatch, 1, 1 << 20);
+    in.bind("commands.acks", config.commands.acks);
+}
+
+// Settings that parse individually but do not work together
+void validate(ConfigBinder& in, const BridgeConfig& config) {
+    if (config.clientIds.empty()) {
+        in.error("tws.client_ids: at least one client ID");
+    }
+    std::vector<int> ids = config.clientIds;
+    std::sort(ids.begin(), ids.end());
+    if (std::adjacent_find(ids.begin(), ids.end()) != ids.end()) {
+        in.error("tws.client_ids: duplicate client ID (TWS rejects the second connection)");
+    }
+    if (config.reconnect.maxDelay < config.reconnect.initialDelay) {
+        in.error("tws.reconnect.max_delay: below initial_delay");
+    }
+    if (config.readerPoll.count() < 0) {
+        in.error("tws.reader_poll: must not be negative (0 = busy-poll)");
+    }
+    RedisEndpoint endpoint;
+    try {
+        endpoint = parseRedisUri(config.redisUri);
+    } catch (const std::invalid_argument& e) {
+        in.error(std::string("redis.uri: ") + e.what());
+    }
+    if (config.connection.cluster && endpoint.unixSocket) {
+        in.error("redis.cluster: needs a tcp:// node address, not a unix socket");
+    }
+    if (config.connection.shardedPubSub && !config.connection.cluster) {
+        in.error("redis.sharded_pubsub: needs redis.cluster");
+    }
+    if (config.connection.directResp && config.connection.cluster) {
+        in.error("redis.direct_resp: single node only, not with redis.cluster");
+    }
+    if (config.connection.respBackend != RespBackend::Socket && !config.connection.directResp) {
+        in.error("redis.resp_backend: needs redis.direct_resp");
+    }
+    if (config.connection.functionBatches && (config.connection.cluster || config.connection.directResp)) {
+        in.error("redis.function_batches: pipelined single node only, not with redis.cluster / redis.direct_resp");
+    }
+    if (config.watchSubscribers && config.connection.cluster) {
+        in.error("redis.watch_subscribers: PUBSUB NUMSUB only sees one cluster node's subscribers");
+    }
+    if (config.worker.conflation.window.count() > 0 && !config.worker.conflation.enabled) {
+        in.error("worker.conflation.window: set but worker.conflation.enabled is false");
+    }
+    if (config.worker.conflation.reduceBatch && !config.worker.conflation.enabled) {
+        in.error("worker.conflation.reduce_batch: needs worker.conflation.enabled (every quote is its own snapshot)");
+    }
+    if (config.worker.aggregate.enabled && config.worker.aggregate.channel.empty()) {
+        in.error("worker.aggregate.channel: must not be empty");
+    }
+    if (!config.worker.aggregate.perSymbol && !config.worker.aggregate.enabled) {
+        in.error("worker.aggregate.per_symbol: false needs worker.aggregate.enabled (snapshots would go nowhere)");
+    }
+    if (config.worker.aggregate.encoderThreads > 0 && !config.worker.aggregate.enabled) {
+        in.error("worker.aggregate.encoder_threads: set but worker.aggregate.enabled is false");
+    }
+    if (config.rebalance.enabled) {
+        if (config.shards < 2) {
+            in.error("ingest.rebalance.enabled: needs ingest.shards > 1");
+        }
+        // REASON: The handoff marker must follow the slot's last updates through the one producer's FIFO
+        if (config.clientIds.size() > 1) {
+            in.error("ingest.rebalance.enabled: needs a single TWS connection (tws.client_ids)");
+        }
+        if (config.ingest.policy == OverflowPolicy::PrioritizeTrades) {
+            in.error("ingest.rebalance.enabled: not with ingest.overflow prioritize_trades (one trade lane per shard)");
+        }
+        if (config.rebalance.interval.count() <= 0) {
+            in.error("ingest.rebalance.interval: must be positive");
+        }
+    }
+    if (config.ingest.memory.lock && !config.ingest.memory.enabled) {
+        in.error("ingest.lock_memory: needs ingest.huge_pages");
+    }
+    if (config.sizing.stallPercentile > 100.0) {
+        in.error("ingest.sizing.stall_percentile: must be at most 100");
+    }
+    if (config.sizing.minCapacity > config.sizing.maxCapacity) {
+        in.error("ingest.sizing.min_capacity: must not exceed ingest.sizing.max_capacity");
+    }
+    if (config.sizing.adopt && (!config.sizing.enabled || config.sizing.path.empty())) {
+        in.error("ingest.sizing.adopt: needs ingest.sizing.enabled and ingest.sizing.path");
+    }
+    if (config.worker.liveBarInterval.count() <= 0) {
+        in.error("worker.live_bar_interval: must be positive");
+    }
+    if (config.history.window.count() <= 0) {
+        in.error("subscriptions.history_window: must be positive");
+    }
+    if (config.commands.batchWindow.count() < 0) {
+        in.error("commands.batch_window: must not be negative");
+    }
+    if (config.history.incremental) {
+        if (!config.worker.barStore.enabled) {
+            in.error("subscriptions.incremental_history: needs worker.bar_store.enabled (the cache it reads)");
+        }
+        if (config.connection.cluster) {
+            in.error("subscriptions.incremental_history: not with Redis Cluster (one pipeline spans hash slots)");
+        }
+    }
+    if (config.demand.enabled) {
+        if (config.demand.subscribers && !config.watchSubscribers) {
+            in.error("demand.subscribers: needs redis.watch_subscribers (the PUBSUB NUMSUB probe)");
+        }
+        if (config.demand.defaultTtl.count() <= 0 || config.demand.defaultTtl > config.demand.maxTtl) {
+            in.error("demand.default_ttl: must be positive and at most demand.max_ttl");
+        }
+        if (config.demand.downgradeAfter.count() <= 0) {
+            in.error("demand.downgrade_after: must be positive");
+        }
+        if (config.demand.upgradeAfter.count() < 0) {
+            in.error("demand.upgrade_after: must not be negative");
+        }
+    }
+    if (config.account.enabled && config.account.interval.count() <= 0) {
+        in.error("account.interval: must be positive");
+    }
+    if (config.news.enabled) {
+        if (config.news.interval.count() <= 0) {
+            in.error("news.interval: must be positive");
+        }
+        if (config.news.providers.empty()) {
+            in.error("news.providers: at least one provider code");
+        }
+        for (const std::string& provider : config.news.providers) {
+            // REASON: Joined into the generic tick list "mdoff,292:BRFG+DJNL"
+            if (provider.empty() || provider.find_first_of("+:, ") != std::string::npos) {
+                in.error("news.providers: \"" + provider + "\" is not a provider code");
+            }
+        }
+    }
+    if (config.kafka.enabled) {
+        const std::set<std::string> compressions{"none", "gzip", "snappy", "lz4", "zstd"};
+        if (!compressions.count(config.kafka.compression)) {
+            in.error("kafka.compression: expected none / gzip / snappy / lz4 / zstd");
+        }
+        if (config.kafka.acks != "all" && config.kafka.acks != "1" && config.kafka.acks != "0") {
+            in.error("kafka.acks: expected all / 1 / 0");
+        }
+        if (config.kafka.brokers.empty() || config.kafka.topic.empty()) {
+            in.error("kafka.brokers / kafka.topic: must not be empty");
+        }
+    }
+    if (config.query.enabled && (config.query.socketPath.empty() || config.query.socketPath.size() > 107)) {
+        in.error("query.socket: expected a path of 1-107 bytes");
+    }
+    // REASON: At least one more renewal attempt fits before the step-down deadline (leaseStepDownAt)
+    if (config.leader.enabled && (config.leader.renewInterval.count() <= 0 || config.leader.renewInterval * 2 > config.leader.ttl)) {
+        in.error("leader.renew_interval: must be positive and at most half of leader.ttl");
+    }
+    if (config.leader.enabled && config.leader.key.empty()) {
+        in.error("leader.key: must not be empty");
+    }
+    if (!config.universe.path.empty() && !config.universe.key.empty()) {
+        in.error("subscriptions.universe_file / universe_key: set one of them");
+    }
+    if (config.universe.pollInterval.count() <= 0) {
+        in.error("subscriptions.universe_poll: must be positive");
+    }
+    // REASON: One late heartbeat must not move a live member's symbols away and back
+    if (config.partition.enabled
+        && (config.partition.heartbeat.count() <= 0 || config.partition.memberTimeout < config.partition.heartbeat * 3)) {
+        in.error("partition.member_timeout: must be at least 3 heartbeats");
+    }
+    if (config.partition.enabled && (config.partition.membersKey.empty() || config.partition.universeKey.empty())) {
+        in.error("partition.members_key / partition.universe_key: must not be empty");
+    }
+    if (config.websocket.enabled && config.websocket.stallTimeout.count() <= 0) {
+        in.error("websocket.stall_timeout: must be positive");
+    }
+    if (config.timeSeries.enabled && config.connection.cluster) {
+        in.error("time_series.enabled: standalone Redis only (one TS.MADD spans every symbol's key)");
+    }
+    if (config.status.enabled && config.status.interval.count() <= 0) {
+        in.error("status.interval: must be positive");
+    }
+    if (config.report.enabled) {
+        if (config.report.interval.count() <= 0) {
+            in.error("report.interval: must be positive");
+        }
+        if (config.report.directory.empty() && config.report.keyPrefix.empty()) {
+            in.error("report.directory: empty together with report.key_prefix (nowhere to write the report)");
+        }
+        if (config.report.retention.count() < 0) {
+            in.error("report.retention: must not be negative");
+        }
+    }
+    std::vector<std::string> basketNames;
+    for (const BasketDefinition& basket : config.baskets.baskets) {
+        basketNames.push_back(basket.name);
+    }
+    std::sort(basketNames.begin(), basketNames.end());
+    if (std::adjacent_find(basketNames.begin(), basketNames.end()) != basketNames.end()) {
+        in.error("baskets.definitions: duplicate basket name (both would publish on one channel)");
+    }
+    if (!config.baskets.baskets.empty() && config.baskets.interval.count() <= 0) {
+        in.error("baskets.interval: must be positive");
+    }
+    // REASON: A basket's value needs every constituent's trades - split across instances, each would publish a fraction
+    if (!config.baskets.baskets.empty() && config.partition.enabled) {
+        in.error("baskets.definitions: not with partition.enabled (constituents must all trade on one instance)");
+    }
+    if (config.movers.enabled && (config.movers.interval.count() <= 0 || config.movers.channel.empty())) {
+        in.error("movers.interval / movers.channel: must be positive / not empty");
+    }
+    if (config.movers.enabled && config.partition.enabled) {
+        in.error("movers.enabled: not with partition.enabled (each instance would publish its own share as the ranking)");
+    }
+    std::vector<std::string> scanIds;
+    for (const ScanDefinition& scan : config.scanner.scans) {
+        scanIds.push_back(scan.id);
+    }
+    std::sort(scanIds.begin(), scanIds.end());
+    if (std::adjacent_find(scanIds.begin(), scanIds.end()) != scanIds.end()) {
+        in.error("scanner.scans: duplicate scan id (both would publish on one channel)");
+    }
+    if (!config.scanner.scans.empty() && config.scanner.channelPrefix.empty()) {
+        in.error("scanner.channel_prefix: must not be empty");
+    }
+    const VolumeProfileConfig& profile = config.worker.volumeProfile;
+    if (profile.enabled && (!(profile.bucketWidth > 0.0) || profile.interval.count() <= 0)) {
+        in.error("worker.volume_profile.bucket_width / interval: must be positive");
+    }
+    if (config.worker.sessionStats.enabled && config.worker.sessionStats.interval.count() <= 0) {
+        in.error("worker.session_stats.interval: must be positive");
+    }
+    if (config.watchdog.enabled && config.watchdog.stallAfter <= config.watchdog.interval) {
+        in.error("watchdog.stall_after: must be longer than watchdog.interval");
+    }
+    if (config.trace.enabled && config.trace.path.empty()) {
+        in.error("trace.path: must not be empty");
+    }
+    if (config.profiler.enabled
+        && (config.profiler.defaultDuration.count() <= 0 || config.profiler.defaultDuration > config.profiler.maxDuration)) {
+        in.error("profiler.default_duration: must be positive and at most profiler.max_duration");
+    }
+    if (config.worker.lag.enabled && config.worker.lag.warn >= config.worker.lag.critical) {
+        in.error("worker.lag.warn: must be below worker.lag.critical");
+    }
+    if (config.worker.shm.enabled && (config.worker.shm.name.empty() || config.worker.shm.name.front() != '/')) {
+        in.error("worker.shm.name: must start with '/' (shm_open name)");
+    }
+    if (config.checkpoint.enabled && (config.checkpoint.name.empty() || config.checkpoint.name.front() != '/')) {
+        in.error("worker.checkpoint.name: must start with '/' (shm_open name)");
+    }
+    auto tooMany = [&in](const std::vector<ThreadConfig>& threads, std::size_t count, const char* key, const char* per) {
+        if (threads.size() > count) {
+            in.error(std::string(key) + ": " + std::to_string(threads.size()) + " entries for " + std::to_string(count)
+                     + " " + per);
+        }
+    };
+    if (config.compact && config.clientIds.size() != 1) {
+        in.error("threads.compact: needs exactly one tws.client_ids entry");
+    }
+    if (config.compact && config.shards != 1) {
+        in.error("threads.compact: needs ingest.shards: 1");
+    }
+    tooMany(config.msgThreads, config.clientIds.size(), "threads.msg.cpus", "connections");
+    tooMany(config.readerThreads, config.clientIds.size(), "threads.reader.cpus", "connections");
+    tooMany(config.workerThreads, config.shards, "threads.worker.cpus", "shards");
+    tooMany(config.redisIoThreads, config.shards, "threads.redis_io.cpus", "shards");
+}
+
+} // namespace
+
+bool applyConfig(const ConfigFile& file, BridgeConfig& config, std::string& error) {
+    ConfigBinder in(file);
+    bindTws(in, config);
+    bindRedis(in, config);
+    bindIngest(in, config);
+    bindWorker(in, config);
+    bindLoadShed(in, config);
+    bindDemand(in, config);
+    bindServices(in, config);
+    in.rejectUnknown();
+    config.ingest.slotCapacity = config.symbolCapacity;
+    config.ingest.movableSlots = config.rebalance.enabled;
+    config.warmStart.format = config.worker.lastValueFormat;  // REASON: Read back the way it is written
+    if (config.compact) {
+        // REASON: A reader thread or an I/O thread would bring back the hand-offs compact mode removes
+        config.readerMode = ReaderMode::Inline;
+        config.io.enabled = false;
+    }
+    validate(in, config);
+    return in.finish(error);
+}
+
+bool isReloadableKey(const std::string& key) {
+    return key == "log.level";
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,551 @@
+// BridgeReader.cpp - Bridge-side TWS socket reader implementation
+// Mirrors EReader's V100+ framing and socket handling, minus the locks and allocations
+// (threaded: socket → receive ring → frame views → dispatch, inline: socket → decode on one thread)
+
+#include "BridgeReader.h"
+#include "DecimalSize.h"
+#include "ProfilerSignal.h"
+#include "SocketTuning.h"
+#include "EWrapper.h"
+#include "EClientSocket.h"  // REASON: After EWrapper.h (EClient.h relies on its <map> include)
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace tws_bridge {
+
+static_assert(tick_by_tick::kMsgId == TICK_BY_TICK, "TICK_BY_TICK id out of sync with EDecoder.h");
+static_assert(tick_by_tick::kTickPriceMsgId == TICK_PRICE && tick_by_tick::kTickSizeMsgId == TICK_SIZE,
+              "L1 msg ids out of sync with EDecoder.h");
+static_assert(tick_by_tick::liveTickType(DELAYED_BID) == BID && tick_by_tick::liveTickType(DELAYED_LAST) == LAST
+                  && tick_by_tick::liveTickType(DELAYED_BID_SIZE) == BID_SIZE
+                  && tick_by_tick::liveTickType(DELAYED_LAST_SIZE) == LAST_SIZE,
+              "Delayed tick types out of sync with EWrapper.h");
+static_assert(tick_by_tick::kServerVersionRawMsgId == MIN_SERVER_VER_PROTOBUF,
+              "Raw msg id server version out of sync with EDecoder.h");
+static_assert(MessageFilter::kProtobufOffset == ibapi::client_constants::PROTOBUF_MSG_ID,
+              "Protobuf msg id offset out of sync with EClient.h");
+
+namespace {
+
+google::protobuf::ArenaOptions arenaOptions(std::vector<char>& block) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block.data();
+    options.initial_block_size = block.size();
+    return options;
+}
+
+std::size_t roundUpPowerOfTwo(std::size_t value) {
+    std::size_t result = 4096;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+BridgeReader::BridgeReader(EClientSocket* client, EWrapper* wrapper, BridgeReaderConfig config,
+                           FastTickHandler* fastTicks)
+    : m_client(client)
+    , m_wrapper(wrapper)
+    , m_decoder(client->EClient::serverVersion(), wrapper, client)
+    , m_fastTicks(fastTicks)
+    , m_serverVersion(client->EClient::serverVersion())
+    , m_config(config)
+    , m_arenaBlock(kArenaBlock)
+    , m_arena(arenaOptions(m_arenaBlock))
+    , m_ready(config.ringCapacity)
+    , m_free(config.copyBuffers)
+    , m_pool(m_free.capacity())
+    , m_receive(roundUpPowerOfTwo(config.receiveBytes))  // REASON: Power of two ≥ 4 KiB (page multiple for the mirror)
+    , m_mask(m_receive.size() - 1) {
+    for (std::uint32_t i = 0; i < m_pool.size(); ++i) {
+        m_pool[i].bytes.resize(m_config.bufferReserve);
+        m_free.try_enqueue(i);
+    }
+}
+
+BridgeReader::~BridgeReader() {
+    stop();
+    if (m_eventFd >= 0) {
+        ::close(m_eventFd);
+    }
+}
+
+bool BridgeReader::start() {
+    // REASON: Only length-prefixed framing is handled (every supported TWS/Gateway build uses V100+)
+    if (!m_client->usingV100Plus()) {
+        std::cerr << "[READER] Pre-V100 protocol, bridge reader unavailable\n";
+        return false;
+    }
+    if (m_config.inlineDispatch) {
+        m_alive.store(true, std::memory_order_release);
+        return true;
+    }
+    m_eventFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_eventFd < 0) {
+        std::cerr << "[READER] eventfd failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    m_running.store(true);
+    m_alive.store(true, std::memory_order_release);
+    m_thread = std::thread([this]() { readLoop(); });
+    return true;
+}
+
+void BridgeReader::stop() {
+    m_running.store(false);
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id()) {
+        m_thread.join();
+    }
+}
+
+// ========== Reader thread ==========
+
+void BridgeReader::readLoop() {
+    configureCurrentThread("tws-reader", m_config.thread);
+    profileCurrentThread();  // REASON: waitSocket takes EINTR for a timeout, receive() never blocks
+    if (m_config.heartbeat) {
+        m_config.heartbeat->attach();
+    }
+    while (m_running.load(std::memory_order_relaxed) && m_client->isSocketOK()) {
+        if (m_config.heartbeat) {
+            m_config.heartbeat->beat();
+        }
+        if (!waitReceiveSpace() || !waitSocket(m_config.pollTimeout)) {
+            continue;
+        }
+        if (!fillInbound() || !consumeFrames()) {
+            break;
+        }
+    }
+
+    if (m_config.heartbeat) {
+        m_config.heartbeat->park(true);  // REASON: A reconnect starts the next reader thread
+    }
+    // Same exit path as EReader::readToQueue: report socket state, wake the dispatch thread
+    if (m_running.load()) {
+        m_client->handleSocketError();
+    }
+    m_alive.store(false, std::memory_order_release);
+    notifyDispatch();
+}
+
+bool BridgeReader::waitSocket(std::chrono::milliseconds timeout) {
+    const int fd = m_client->fd();
+    if (fd < 0) {
+        return false;
+    }
+    pollfd pfd{};
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    if (!m_client->getTransport()->isOutBufferEmpty()) {
+        pfd.events |= POLLOUT;
+    }
+
+    int ret = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (ret <= 0) {
+        if (ret < 0 && errno != EINTR) {
+            m_client->eDisconnect();
+        }
+        return false;
+    }
+    if (pfd.revents & (POLLERR | POLLHUP)) {
+        m_client->onError();
+    }
+    if (pfd.revents & POLLOUT) {
+        if (m_config.inlineDispatch) {
+            m_client->onSend();
+        } else {
+            // REASON: Outbound buffer is flushed by the dispatch thread (processMsgs → onSend)
+            notifyDispatch();
+        }
+    }
+    return (pfd.revents & POLLIN) != 0;
+}
+
+bool BridgeReader::waitReceiveSpace() {
+    // REASON: Oversized body goes to its pool buffer (ring positions already skip past it)
+    if (m_oversizeBuffer != kNoBuffer) {
+        return true;
+    }
+    if (m_written - m_released.load(std::memory_order_acquire) < m_receive.size()) {
+        return true;
+    }
+
+    // BACKPRESSURE: Dispatch still holds the whole ring - stop reading until it releases bytes
+    m_counters.poolStalls.fetch_add(1, std::memory_order_relaxed);
+    notifyDispatch();
+    while (m_running.load(std::memory_order_relaxed)) {
+        if (m_written - m_released.load(std::memory_order_acquire) < m_receive.size()) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+bool BridgeReader::fillInbound() {
+    // PERFORMANCE: Read whatever the kernel has (until a short read or a full ring),
+    // framing then runs once over the whole burst
+    for (;;) {
+        char* dest = nullptr;
+        std::size_t space = 0;
+        if (m_oversizeBuffer != kNoBuffer) {
+            dest = m_pool[m_oversizeBuffer].bytes.data() + m_oversizeFilled;
+            space = m_oversizeLength - m_oversizeFilled;
+        } else {
+            const std::size_t used = static_cast<std::size_t>(m_written - m_released.load(std::memory_order_acquire));
+            const std::size_t start = static_cast<std::size_t>(m_written & m_mask);
+            dest = m_receive.data() + start;
+            space = m_receive.size() - used;
+            if (!m_receive.mirrored()) {
+                space = std::min(space, m_receive.size() - start);  // Up to the ring end, rest next pass
+            }
+        }
+        if (space == 0) {
+            return true;  // Ring full / oversized body complete - frame what we have
+        }
+
+        int received = m_client->receive(dest, space);
+        if (received <= 0) {
+            return m_client->isSocketOK();  // 0: would block or peer closed (receive() disconnects)
+        }
+        // PERFORMANCE: One TSC read per socket read, shared by every frame it completes
+        m_receiveNs = receiveClock().nowNs();
+        if (m_config.quickAck) {
+            rearmQuickAck(m_client->fd());
+        }
+        if (m_oversizeBuffer != kNoBuffer) {
+            m_oversizeFilled += static_cast<std::size_t>(received);
+        } else {
+            m_written += static_cast<std::uint64_t>(received);
+        }
+        if (static_cast<std::size_t>(received) < space) {
+            return true;  // Kernel buffer drained
+        }
+    }
+}
+
+void BridgeReader::copyOut(std::uint64_t position, char* dest, std::size_t count) const {
+    const std::size_t start = static_cast<std::size_t>(position & m_mask);
+    const std::size_t first = std::min(count, m_receive.size() - start);
+    std::memcpy(dest, m_receive.data() + start, first);
+    std::memcpy(dest + first, m_receive.data(), count - first);
+}
+
+bool BridgeReader::consumeFrames() {
+    bool published = false;
+
+    for (;;) {
+        if (m_oversizeBuffer != kNoBuffer) {
+            if (m_oversizeFilled < m_oversizeLength) {
+                break;  // Body still arriving
+            }
+            Frame frame{m_parsed, 0, static_cast<std::uint32_t>(m_oversizeLength), m_oversizeBuffer, m_receiveNs};
+            m_oversizeBuffer = kNoBuffer;
+            if (!publish(frame)) {
+                return false;
+            }
+            published = true;
+            continue;
+        }
+
+        const std::uint64_t available = m_written - m_parsed;
+        std::uint32_t length = 0;
+        if (available < sizeof(length)) {
+            break;
+        }
+        copyOut(m_parsed, reinterpret_cast<char*>(&length), sizeof(length));  // Header may wrap (unmirrored)
+        length = ntohl(length);
+        if (length == 0 || length > static_cast<std::uint32_t>(MAX_MSG_LEN)) {
+            std::cerr << "[READER] Invalid frame length " << length << "\n";
+            return false;
+        }
+        const std::uint64_t body = m_parsed + sizeof(length);
+
+        if (sizeof(length) + length > m_receive.size()) {
+            // Oversized: move what arrived into a pool buffer, receive the rest straight into it
+            // REASON: Ring positions skip the frame (released as a whole once it is decoded)
+            std::uint32_t index = acquireBuffer();
+            if (index == kNoBuffer) {
+                return false;  // Stopping
+            }
+            std::vector<char>& bytes = m_pool[index].bytes;
+            if (bytes.size() < length) {
+                bytes.resize(length);
+            }
+            m_oversizeFilled = static_cast<std::size_t>(available - sizeof(length));
+            copyOut(body, bytes.data(), m_oversizeFilled);
+            m_oversizeLength = length;
+            m_oversizeBuffer = index;
+            m_parsed = body + length;
+            m_written = m_parsed;
+            m_counters.copiedFrames.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (available < sizeof(length) + length) {
+            break;  // Partial frame, wait for more bytes
+        }
+
+        Frame frame{body + length, static_cast<std::uint32_t>(body & m_mask), length, kNoBuffer, m_receiveNs};
+        if (!m_receive.mirrored() && frame.offset + length > m_receive.size()) {
+            // Body wraps the ring end - EDecoder needs contiguous bytes (mirror unavailable)
+            frame.buffer = acquireBuffer();
+            if (frame.buffer == kNoBuffer) {
+                return false;  // Stopping
+            }
+            std::vector<char>& bytes = m_pool[frame.buffer].bytes;
+            if (bytes.size() < length) {
+                bytes.resize(length);
+            }
+            copyOut(body, bytes.data(), length);
+            m_counters.copiedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_parsed = frame.end;
+        if (!publish(frame)) {
+            return false;
+        }
+        published = true;
+    }
+
+    if (published && !m_config.inlineDispatch) {
+        notifyDispatch();
+    }
+    return true;
+}
+
+bool BridgeReader::publish(const Frame& frame) {
+    m_counters.messages.fetch_add(1, std::memory_order_relaxed);
+    if (m_config.inlineDispatch) {
+        // CRITICAL PATH: Decode in place, callbacks run before the next frame is looked at
+        // NOTE: Ring is not touched while decoding (callbacks never re-enter the reader)
+        dispatchFrame(frame);
+        return true;
+    }
+    if (m_ready.try_enqueue(frame)) {
+        return true;
+    }
+
+    // BACKPRESSURE: Frame ring full - wake dispatch, wait for a free entry
+    m_counters.poolStalls.fetch_add(1, std::memory_order_relaxed);
+    notifyDispatch();
+    while (m_running.load(std::memory_order_relaxed)) {
+        if (m_ready.try_enqueue(frame)) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+std::uint32_t BridgeReader::acquireBuffer() {
+    std::uint32_t index = kNoBuffer;
+    if (m_free.try_dequeue(index)) {
+        return index;
+    }
+
+    // BACKPRESSURE: Every buffer in flight - make sure dispatch is awake, then wait for a return
+    m_counters.poolStalls.fetch_add(1, std::memory_order_relaxed);
+    notifyDispatch();
+    while (m_running.load(std::memory_order_relaxed)) {
+        if (m_free.try_dequeue(index)) {
+            return index;
+        }
+        std::this_thread::yield();
+    }
+    return kNoBuffer;
+}
+
+void BridgeReader::notifyDispatch() {
+    // PERFORMANCE: Syscall only when the dispatch thread is (about to be) asleep
+    if (m_dispatchWaiting.exchange(false, std::memory_order_seq_cst) || !isAlive()) {
+        std::uint64_t one = 1;
+        ssize_t written = ::write(m_eventFd, &one, sizeof(one));
+        (void)written;  // REASON: EAGAIN means the counter is already non-zero (wake-up pending)
+        m_counters.signals.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ========== Dispatch thread ==========
+
+bool BridgeReader::waitForMessages(std::chrono::milliseconds timeout) {
+    if (m_ready.size_approx() > 0) {
+        return true;
+    }
+
+    m_dispatchWaiting.store(true, std::memory_order_seq_cst);
+    // PITFALL: Reader may have published before seeing the flag - re-check before sleeping
+    if (m_ready.size_approx() > 0 || !isAlive()) {
+        m_dispatchWaiting.store(false, std::memory_order_relaxed);
+        return true;
+    }
+
+    pollfd pfd{};
+    pfd.fd = m_eventFd;
+    pfd.events = POLLIN;
+    int ret = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    m_dispatchWaiting.store(false, std::memory_order_relaxed);
+    if (ret > 0) {
+        std::uint64_t value = 0;
+        ssize_t bytes = ::read(m_eventFd, &value, sizeof(value));  // Reset the eventfd counter
+        (void)bytes;
+    }
+    return m_ready.size_approx() > 0 || !isAlive();
+}
+
+std::size_t BridgeReader::processMsgs() {
+    // REASON: Same as EReader::processMsgs - flush queued outbound requests first
+    m_client->onSend();
+
+    Frame batch[kDispatchBatch];
+    std::uint32_t returned[kDispatchBatch];
+    std::size_t total = 0;
+    std::size_t count = 0;
+    while ((count = m_ready.try_dequeue_bulk(batch, kDispatchBatch)) > 0) {
+        std::size_t buffers = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            decodeFrame(batch[i]);
+            if (batch[i].buffer != kNoBuffer) {
+                returned[buffers++] = batch[i].buffer;
+            }
+        }
+        // PERFORMANCE: One bulk buffer return and one release store per batch, not per frame -
+        // the reader's cache line is touched once per burst
+        if (buffers > 0) {
+            m_free.try_enqueue_bulk(returned, buffers);  // REASON: Cannot fail, ring capacity == pool size
+        }
+        m_released.store(batch[count - 1].end, std::memory_order_release);
+        resetArena();
+        total += count;
+    }
+    return total;
+}
+
+void BridgeReader::decodeFrame(const Frame& frame) {
+    const char* begin = frame.buffer == kNoBuffer ? m_receive.data() + frame.offset
+                                                  : m_pool[frame.buffer].bytes.data();
+    m_dispatchReceiveNs = frame.receiveNs;
+    dispatch(begin, begin + frame.length);
+}
+
+void BridgeReader::dispatchFrame(const Frame& frame) {
+    decodeFrame(frame);
+    if (frame.buffer != kNoBuffer) {
+        m_free.try_enqueue(frame.buffer);  // REASON: Cannot fail, ring capacity == pool size
+    }
+    // Frames are decoded in ring order - everything before frame.end is done with
+    m_released.store(frame.end, std::memory_order_release);
+}
+
+void BridgeReader::dispatch(const char* begin, const char* end) {
+    int msgId = 0;
+    const char* body = nullptr;
+    if (!readMessageId(begin, end, m_serverVersion, msgId, body)) {
+        m_decoder.parseAndProcessMsg(begin, end);  // REASON: Too short to filter - EDecoder reports it
+        return;
+    }
+    // PERFORMANCE: Unwanted messages are dropped before any field is decoded
+    if (!m_config.messages.allows(msgId)) {
+        m_counters.skipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (msgId > MessageFilter::kProtobufOffset && decodeProtoBuf(msgId - MessageFilter::kProtobufOffset, body, end)) {
+        return;
+    }
+    if (m_fastTicks) {
+        // CRITICAL PATH: Market data skips EDecoder (atoi/atof, Decimal, std::string per field)
+        // Integral sizes never touch libbid, fractional ones take the BID parse per field
+        if (msgId == tick_by_tick::kMsgId) {
+            TickByTickFields fields;
+            if (parseTickByTickFields(body, end, fields, &bidTextToQuantity) == TickByTickParse::Parsed) {
+                m_fastTicks->onTickByTick(fields);
+                m_counters.fastTicks.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        } else if (msgId == tick_by_tick::kTickPriceMsgId || msgId == tick_by_tick::kTickSizeMsgId) {
+            MarketDataTickFields fields;
+            TickByTickParse parsed = msgId == tick_by_tick::kTickPriceMsgId
+                                         ? parseTickPriceFields(body, end, fields, &bidTextToQuantity)
+                                         : parseTickSizeFields(body, end, fields, &bidTextToQuantity);
+            if (parsed == TickByTickParse::Parsed) {
+                m_fastTicks->onMarketDataTick(fields);
+                m_counters.fastTicks.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        } else if (msgId == tick_by_tick::kHistoricalDataMsgId) {
+            // PERFORMANCE: Columns reused frame to frame, times parsed here - one callback per backfill
+            // message instead of a Bar + std::string per bar
+            if (parseHistoricalDataFields(body, end, m_serverVersion, m_barTime, m_bars, &bidTextToQuantity)
+                == TickByTickParse::Parsed) {
+                m_fastTicks->onHistoricalBars(m_bars);
+                m_counters.fastBars.fetch_add(m_bars.size(), std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    m_decoder.parseAndProcessMsg(begin, end);
+}
+
+// Mirrors EDecoder::process*MsgProtoBuf, with the message on m_arena instead of the heap
+// NOTE: Only ERR_MSG - the order / execution messages are rebuilt into Order / Contract objects by
+// EDecoder (and dropped by the default message filter anyway)
+bool BridgeReader::decodeProtoBuf(int msgId, const char* body, const char* end) {
+    if (msgId != ERR_MSG) {
+        return false;
+    }
+    auto* proto = google::protobuf::Arena::CreateMessage<protobuf::ErrorMessage>(&m_arena);
+    m_arenaUsed = true;
+    if (!proto->ParseFromArray(body, static_cast<int>(end - body))) {
+        return false;  // REASON: EDecoder reports the malformed message
+    }
+    m_wrapper->errorProtoBuf(*proto);
+    // PERFORMANCE: Strings passed by reference into the arena, not copied out
+    m_wrapper->error(proto->has_id() ? proto->id() : 0,
+                     proto->has_errortime() ? static_cast<time_t>(proto->errortime()) : 0,
+                     proto->has_errorcode() ? proto->errorcode() : 0,
+                     proto->errormsg(), proto->advancedorderrejectjson());
+    m_counters.protobufFrames.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void BridgeReader::resetArena() {
+    if (m_arenaUsed) {
+        m_arena.Reset();
+        m_arenaUsed = false;
+    }
+}
+
+// ========== Inline mode ==========
+
+std::size_t BridgeReader::pollInline() {
+    return pollInline(m_config.pollTimeout);
+}
+
+std::size_t BridgeReader::pollInline(std::chrono::milliseconds timeout) {
+    if (!isAlive()) {
+        return 0;
+    }
+    // REASON: Same as processMsgs - flush queued outbound requests first
+    m_client->onSend();
+
+    // NOTE: Inline releases each frame as it is decoded, the ring only ever holds a partial frame
+    if (!m_client->isSocketOK() || !waitReceiveSpace() || !waitSocket(timeout)) {
+        return 0;
+    }
+    const std::uint64_t before = m_counters.messages.load(std::memory_order_relaxed);
+    if (!fillInbound() || !consumeFrames()) {
+        // Same exit path as the reader thread (socket error / bad frame)
+        m_client->handleSocketError();
+        m_alive.store(false, std::memory_order_release);
+    }
+    resetArena();
+    return static_cast<std::size_t>(m_counters.messages.load(std::memory_order_relaxed) - before);
+}
+
+} // namespace tws_bridge
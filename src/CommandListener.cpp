@@ -0,0 +1,192 @@
+// CommandListener.cpp - TWS:COMMANDS subscriber implementation
+
+#include "CommandListener.h"
+#include "ConnectionRouting.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+namespace tws_bridge {
+
+CommandListener::CommandListener(const std::string& uri, CommandQueue& commands, CommandListenerConfig config)
+    : CommandListener(uri, std::vector<CommandQueue*>{&commands}, std::move(config)) {
+}
+
+CommandListener::CommandListener(const std::string& uri, std::vector<CommandQueue*> commands,
+                                 CommandListenerConfig config)
+    : m_uri(uri)
+    , m_commands(std::move(commands))
+    , m_config(std::move(config))
+    , m_routed(m_commands.size()) {
+}
+
+CommandListener::~CommandListener() {
+    stop();
+}
+
+void CommandListener::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void CommandListener::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CommandListener::run() {
+    nameCurrentThread("tws-commands");
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - a subscribed connection can't run other commands
+            sw::redis::ConnectionOptions opts(m_uri);
+            // REASON: consume() returns at least once per window, an open batch is routed on time
+            opts.socket_timeout = m_config.batchWindow.count() > 0 ? std::min(m_config.pollTimeout, m_config.batchWindow)
+                                                                   : m_config.pollTimeout;
+            sw::redis::Redis redis(opts);
+            auto subscriber = redis.subscriber();
+            subscriber.on_message([this](std::string /*channel*/, std::string payload) {
+                onMessage(payload);
+            });
+            subscriber.subscribe(m_config.channel);
+            // NOTE: The pool's connection, not the subscriber's - acks go out between two consume() calls
+            auto replies = redis.pipeline(false);
+            std::cout << "[COMMANDS] Listening on " << m_config.channel << "\n";
+
+            while (m_running.load()) {
+                try {
+                    subscriber.consume();
+                } catch (const sw::redis::TimeoutError&) {
+                    // REASON: Timeout is the idle path, re-check m_running
+                }
+                if (!batchDue()) {
+                    continue;
+                }
+                flush();
+                if (m_replies.empty()) {
+                    continue;
+                }
+                // PERFORMANCE: One round trip for the whole batch's replies
+                for (const std::string& reply : m_replies) {
+                    replies.publish(m_config.statusChannel, reply);
+                }
+                replies.exec();
+                m_counters.acks.fetch_add(m_replies.size(), std::memory_order_relaxed);
+            }
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[COMMANDS] Redis error: " << e.what() << ", retrying in "
+                      << m_config.reconnectDelay.count() << "ms\n";
+            m_counters.reconnects.fetch_add(1, std::memory_order_relaxed);
+            // NOTE: Commands already received still run - only their acks are lost with the connection
+            if (!m_batch.empty()) {
+                flush();
+            }
+            // REASON: Sleep in pollTimeout steps so stop() stays responsive
+            auto deadline = std::chrono::steady_clock::now() + m_config.reconnectDelay;
+            while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(m_config.pollTimeout);
+            }
+        }
+    }
+    if (!m_batch.empty()) {
+        flush();
+    }
+    std::cout << "[COMMANDS] Listener stopped\n";
+}
+
+void CommandListener::onMessage(const std::string& payload) {
+    m_counters.received.fetch_add(1, std::memory_order_relaxed);
+    if (m_batch.empty()) {
+        m_batchStart = std::chrono::steady_clock::now();
+    }
+
+    SubscriptionCommand command;
+    std::string error;
+    if (!parseSubscriptionCommand(payload, command, error)) {
+        m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "[COMMANDS] Rejected command (" << error << "): " << payload << "\n";
+        m_batch.reject(command, std::move(error));
+        return;
+    }
+    if (command.action == CommandAction::Profile) {
+        if (!m_profiler) {
+            error = "profiler.enabled is off";
+        } else if (m_profiler->request(command.duration, error)) {
+            m_batch.acknowledge(command);
+            return;
+        }
+        m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "[COMMANDS] Rejected command (" << error << "): " << payload << "\n";
+        m_batch.reject(command, std::move(error));
+        return;
+    }
+    if (command.action == CommandAction::Interest || command.action == CommandAction::Release) {
+        if (!m_interest) {
+            m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "[COMMANDS] Rejected command (demand.enabled is off): " << payload << "\n";
+            m_batch.reject(command, "demand.enabled is off");
+        } else if (!m_partition || m_partition->owns(command.symbol)) {
+            m_batch.addPassThrough(std::move(command), payload);  // NOTE: Another instance owns the rest
+        }
+        return;
+    }
+    m_batch.add(std::move(command), payload);
+}
+
+bool CommandListener::batchDue() const {
+    if (m_batch.empty()) {
+        return false;
+    }
+    return m_batch.size() >= m_config.maxBatch
+        || std::chrono::steady_clock::now() - m_batchStart >= m_config.batchWindow;
+}
+
+void CommandListener::flush() {
+    m_counters.batches.fetch_add(1, std::memory_order_relaxed);
+    m_counters.coalesced.fetch_add(m_batch.coalesced(), std::memory_order_relaxed);
+    for (BatchedCommand& next : m_batch.net()) {
+        SubscriptionCommand& command = next.command;
+        if (command.action == CommandAction::Interest || command.action == CommandAction::Release) {
+            m_interest->enqueue(std::move(command));
+        } else if (m_partition) {
+            m_partition->submit(std::move(command), std::move(next.payload));  // NOTE: Same queues, owned symbols only
+        } else {
+            // REASON: Same connection as the symbol's earlier subscribe - its tickerIds live in that TwsClient
+            m_routed[connectionFor(command.symbol, m_commands.size())].push_back(std::move(command));
+        }
+    }
+    // NOTE: Unbounded - the message thread drains them every iteration (the pacer spaces the requests)
+    // PERFORMANCE: One bulk enqueue per connection instead of one per command
+    for (std::size_t i = 0; i < m_routed.size(); ++i) {
+        if (!m_routed[i].empty()) {
+            m_commands[i]->enqueue_bulk(std::make_move_iterator(m_routed[i].begin()), m_routed[i].size());
+            m_routed[i].clear();
+        }
+    }
+
+    m_replies.clear();
+    if (m_config.acks) {
+        const std::int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        for (const CommandAck& ack : m_batch.acks()) {
+            // REASON: Every instance receives every command - only the symbol's owner answers for it
+            // (a rejection has no reliable symbol and a profile none at all, each instance sends its own)
+            if (ack.status != AckStatus::Rejected && !ack.symbol.empty() && m_partition
+                && !m_partition->owns(ack.symbol)) {
+                continue;
+            }
+            serializeCommandAck(ack, now, m_ack);
+            m_replies.emplace_back(m_ack.data(), m_ack.size());
+        }
+    }
+    m_batch.clear();
+}
+
+} // namespace tws_bridge
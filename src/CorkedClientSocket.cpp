@@ -0,0 +1,58 @@
+// CorkedClientSocket.cpp - Corkable ESocket transport behind EClientSocket
+// REASON: EClient sends through its protected m_transport - swapping the ESocket for a subclass
+// batches requests without patching the vendored client
+
+#include "CorkedClientSocket.h"
+#include "EMessage.h"
+#include "ESocket.h"
+
+namespace tws_bridge {
+
+// Still an ESocket: EClientSocket::getTransport() static_casts m_transport to it (fd, onSend, ...)
+class CorkedClientSocket::Transport : public ESocket {
+public:
+    int send(EMessage* message) override {
+        if (!m_corked) {
+            return ESocket::send(message);
+        }
+        m_held.insert(m_held.end(), message->begin(), message->end());
+        return static_cast<int>(message->end() - message->begin());
+    }
+
+    void cork() { m_corked = true; }
+
+    // true if a held burst was written
+    bool uncork() {
+        m_corked = false;
+        if (m_held.empty()) {
+            return false;
+        }
+        // NOTE: Partial writes land in ESocket's out buffer, flushed by onSend() like any request
+        EMessage burst(m_held);
+        ESocket::send(&burst);
+        m_held.clear();  // REASON: Capacity kept - the next burst appends without reallocating
+        return true;
+    }
+
+private:
+    std::vector<char> m_held;
+    bool m_corked = false;
+};
+
+CorkedClientSocket::CorkedClientSocket(EWrapper* wrapper, EReaderSignal* signal)
+    : EClientSocket(wrapper, signal)
+    , m_corkable(new Transport()) {
+    m_transport.reset(m_corkable);
+}
+
+void CorkedClientSocket::cork() {
+    m_corkable->cork();
+}
+
+void CorkedClientSocket::uncork() {
+    if (m_corkable->uncork()) {
+        ++m_corkedWrites;
+    }
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,151 @@
+// FlightRecorder.cpp - Dump thread: ring copy and CSV file
+
+#include "FlightRecorder.h"
+#include "ThreadAffinity.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace tws_bridge {
+
+FlightRecorder::FlightRecorder(const FlightRecorderConfig& config, std::size_t shardId,
+                               const InstrumentRegistry* registry)
+    : m_config(config)
+    , m_shardId(shardId)
+    , m_registry(registry) {
+    std::size_t capacity = 1;
+    while (capacity < std::max<std::size_t>(config.capacity, 2)) {
+        capacity <<= 1;
+    }
+    m_cells = std::make_unique<Cell[]>(capacity);
+    m_mask = capacity - 1;
+    m_pending.reserve(1024);
+}
+
+FlightRecorder::~FlightRecorder() {
+    stop();
+}
+
+void FlightRecorder::start() {
+    if (m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void FlightRecorder::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::string FlightRecorder::lastDump() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastDump;
+}
+
+std::size_t FlightRecorder::copy(std::uint64_t endSequence, std::vector<FlightRecord>& out) const {
+    out.clear();
+    const std::uint64_t capacity = m_mask + 1;
+    const std::uint64_t begin = endSequence > capacity ? endSequence - capacity : 0;
+    for (std::uint64_t sequence = begin; sequence < endSequence; ++sequence) {
+        const Cell& cell = m_cells[sequence & m_mask];
+        const std::uint64_t expected = 2 * sequence + 2;
+        if (cell.seq.load(std::memory_order_acquire) != expected) {
+            continue;  // Overwritten by a newer record (or still being written)
+        }
+        // PITFALL: Seqlock copy - only kept if seq did not move meanwhile
+        const FlightRecord record = cell.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (cell.seq.load(std::memory_order_relaxed) == expected) {
+            out.push_back(record);
+        }
+    }
+    return out.size();
+}
+
+void FlightRecorder::requestDump(const FlightRecord& slowest, std::size_t queueDepth, std::int64_t roundTripNs) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_dumpRequested) {
+            return;  // REASON: Previous dump still being written - its ring already covers this spike
+        }
+        m_dumpRequested = true;
+        m_trigger.slowest = slowest;
+        m_trigger.endSequence = m_next;
+        m_trigger.queueDepth = queueDepth;
+        m_trigger.redisRoundTripNs = roundTripNs;
+    }
+    m_wake.notify_one();
+}
+
+void FlightRecorder::run() {
+    const std::string name = "tws-flight-" + std::to_string(m_shardId);
+    nameCurrentThread(name.c_str());
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this]() { return m_dumpRequested || m_stopping; });
+        if (!m_dumpRequested) {
+            return;  // NOTE: A pending dump is still written on stop - it explains the spike
+        }
+        const FlightTrigger trigger = m_trigger;
+        lock.unlock();
+        dump(trigger);
+        lock.lock();
+        m_dumpRequested = false;
+    }
+}
+
+// CSV: one row per record, stage columns in microseconds after the callback
+void FlightRecorder::dump(const FlightTrigger& trigger) {
+    std::vector<FlightRecord> records;
+    copy(trigger.endSequence, records);
+    const std::int64_t epochMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string path = m_config.dir + "/flight-" + std::to_string(m_shardId) + "-" + std::to_string(epochMs) + ".csv";
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "[FLIGHT] Cannot write " << path << "\n";
+        return;
+    }
+    auto symbolOf = [this](SlotId slot) {
+        return m_registry ? m_registry->symbol(slot) : std::to_string(slot);
+    };
+    auto micros = [](std::int64_t from, std::int64_t to) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.1f", to != 0 ? static_cast<double>(to - from) / 1000.0 : 0.0);
+        return std::string(text);
+    };
+    const FlightRecord& slowest = trigger.slowest;
+    out << "# shard " << m_shardId << ", trigger " << symbolOf(slowest.slot) << " "
+        << tickUpdateTypeName(slowest.type) << " " << micros(slowest.callbackNs, slowest.publishNs)
+        << " us callback -> publish (threshold " << m_config.threshold.count() << " us)\n";
+    out << "# queue_depth " << trigger.queueDepth << ", redis_rtt_us " << micros(0, trigger.redisRoundTripNs) << ", "
+        << records.size() << " records\n";
+    out << "symbol,type,callback_ns,enqueue_us,dequeue_us,serialize_us,publish_us\n";
+    for (const FlightRecord& record : records) {
+        out << symbolOf(record.slot) << ',' << tickUpdateTypeName(record.type) << ',' << record.callbackNs << ','
+            << micros(record.callbackNs, record.enqueueNs) << ',' << micros(record.callbackNs, record.dequeueNs) << ','
+            << micros(record.callbackNs, record.serializeNs) << ',' << micros(record.callbackNs, record.publishNs) << '\n';
+    }
+    out.close();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lastDump = path;
+    }
+    m_dumps.fetch_add(1, std::memory_order_relaxed);
+    std::cout << "[FLIGHT] Latency spike (shard " << m_shardId << "): " << records.size() << " records written to "
+              << path << "\n";
+}
+
+} // namespace tws_bridge
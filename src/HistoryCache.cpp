@@ -0,0 +1,68 @@
+// HistoryCache.cpp - Bar store extents for the incremental startup backfill (redis++ pipeline, cold path)
+
+#include "HistoryCache.h"
+#include <sw/redis++/redis++.h>
+#include <charconv>
+#include <string_view>
+
+namespace tws_bridge {
+
+namespace {
+
+// Score of a single-member WITHSCORES reply ([member, score]), false for an empty range
+bool replyScore(const redisReply& reply, std::int64_t& out) {
+    if (reply.type != REDIS_REPLY_ARRAY || reply.elements < 2) {
+        return false;
+    }
+    const redisReply* score = reply.element[1];
+    if (score->type != REDIS_REPLY_STRING && score->type != REDIS_REPLY_DOUBLE) {
+        return false;
+    }
+    // REASON: Scores are whole ms written from an int64 - no fraction to parse
+    const std::string_view text(score->str, score->len);
+    return std::from_chars(text.data(), text.data() + text.size(), out).ec == std::errc();
+}
+
+} // namespace
+
+std::vector<CachedBars> loadCachedBars(const std::string& uri, const std::vector<std::string>& keys,
+                                       std::int64_t windowFromMs, const HistoryCacheConfig& config) {
+    std::vector<CachedBars> cached(keys.size());
+    if (keys.empty()) {
+        return cached;
+    }
+    sw::redis::ConnectionOptions opts(uri);
+    opts.socket_timeout = config.socketTimeout;
+    sw::redis::Redis redis(opts);
+
+    const std::string from = std::to_string(windowFromMs);
+    const std::size_t perRequest = std::max<std::size_t>(config.keysPerRequest, 1);
+    for (std::size_t first = 0; first < keys.size(); first += perRequest) {
+        const std::size_t last = std::min(keys.size(), first + perRequest);
+        // PERFORMANCE: One round trip per chunk - hundreds of symbols cost a few ms before the first request
+        sw::redis::Pipeline pipe = redis.pipeline(false);
+        for (std::size_t i = first; i < last; ++i) {
+            pipe.command("ZCOUNT", keys[i], from, "+inf");
+            pipe.command("ZRANGEBYSCORE", keys[i], from, "+inf", "WITHSCORES", "LIMIT", "0", "1");
+            pipe.command("ZREVRANGEBYSCORE", keys[i], "+inf", from, "WITHSCORES", "LIMIT", "0", "1");
+        }
+        sw::redis::QueuedReplies replies = pipe.exec();
+        if (replies.size() != (last - first) * 3) {
+            throw sw::redis::Error("Unexpected bar store replies");
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            const std::size_t base = (i - first) * 3;
+            const redisReply& count = replies.get(base);
+            CachedBars& bars = cached[i];
+            if (count.type != REDIS_REPLY_INTEGER || count.integer <= 0
+                || !replyScore(replies.get(base + 1), bars.oldestMs) || !replyScore(replies.get(base + 2), bars.newestMs)) {
+                bars = CachedBars{};  // NOTE: Unreadable = not cached, the whole window is requested
+                continue;
+            }
+            bars.count = static_cast<std::size_t>(count.integer);
+        }
+    }
+    return cached;
+}
+
+} // namespace tws_bridge
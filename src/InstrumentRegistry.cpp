@@ -0,0 +1,62 @@
+// InstrumentRegistry.cpp - Dense instrument slot assignment
+
+#include "InstrumentRegistry.h"
+#include "JsonString.h"
+
+namespace tws_bridge {
+
+InstrumentRegistry::InstrumentRegistry(std::size_t capacity)
+    // PITFALL: kInvalidSlot is reserved, cap the usable range below it
+    : m_symbols(capacity < kInvalidSlot ? capacity : kInvalidSlot)
+    , m_tickerIds(m_symbols.size(), 0)
+    , m_channels(m_symbols.size())
+    , m_symbolJson(m_symbols.size())
+    , m_contracts(m_symbols.size()) {
+}
+
+SlotId InstrumentRegistry::registerInstrument(const std::string& symbol, int tickerId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_slotBySymbol.find(symbol);
+    if (it != m_slotBySymbol.end()) {
+        return it->second;
+    }
+    
+    std::size_t slot = m_count.load(std::memory_order_relaxed);
+    if (slot >= m_symbols.size()) {
+        return kInvalidSlot;
+    }
+    
+    // REASON: Write slot data BEFORE publishing the new count
+    m_symbols[slot] = symbol;
+    m_tickerIds[slot] = tickerId;
+    // PERFORMANCE: Escaped once here, snapshots memcpy it (no per-tick escaping)
+    m_symbolJson[slot] = escapeJsonString(symbol);
+    InstrumentChannels& channels = m_channels[slot];
+    channels.ticks = "TWS:TICKS:" + symbol;
+    channels.bars = "TWS:BARS:" + symbol;
+    // PITFALL: Not "TWS:TICKS:BIN:*" - JSON consumers PSUBSCRIBE "TWS:TICKS:*" and would receive binary
+    channels.binaryTicks = "TWS:BIN:TICKS:" + symbol;
+    channels.binaryBars = "TWS:BIN:BARS:" + symbol;
+    channels.stream = "TWS:STREAM:" + symbol;
+    channels.lastValue = "TWS:LVC:" + symbol;
+    channels.depth = "TWS:DEPTH:" + symbol;
+    channels.midPoint = "TWS:MID:" + symbol;
+    channels.chain = "TWS:CHAIN:" + symbol + ":";
+    // PITFALL: Not "TWS:BARS:*" - array payloads would reach single-bar subscribers
+    channels.history = "TWS:HISTORY:" + symbol;
+    channels.liveBar = "TWS:LIVEBAR:" + symbol;  // REASON: Not "TWS:BARS:*" either - revisions are not closed bars
+    channels.barStore = "TWS:BARS:Z:" + symbol + ":";
+    channels.series = "TWS:TS:" + symbol + ":";
+    channels.tape = "TWS:TAS:" + symbol;
+    m_slotBySymbol.emplace(symbol, static_cast<SlotId>(slot));
+    m_count.store(slot + 1, std::memory_order_release);
+    return static_cast<SlotId>(slot);
+}
+
+SlotId InstrumentRegistry::find(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_slotBySymbol.find(symbol);
+    return it != m_slotBySymbol.end() ? it->second : kInvalidSlot;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,238 @@
+// JournalExport.cpp - Journal records → per-symbol, per-kind Parquet tables
+
+#include "JournalExport.h"
+#include "BarSize.h"
+#include <sys/stat.h>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+constexpr const char* kTableNames[] = {"quotes", "trades", "depth", "bars"};
+
+// Leading columns shared by every table
+std::vector<ParquetColumnSpec> withKeys(std::vector<ParquetColumnSpec> fields) {
+    std::vector<ParquetColumnSpec> schema = {
+        {"symbol", ParquetType::String, ParquetEncoding::Dictionary},
+        {"time", ParquetType::Int64, ParquetEncoding::Delta, ParquetTimeUnit::Millis},
+        {"receive_time", ParquetType::Int64, ParquetEncoding::Delta, ParquetTimeUnit::Nanos},
+    };
+    schema.insert(schema.end(), fields.begin(), fields.end());
+    return schema;
+}
+
+const std::vector<ParquetColumnSpec>& tableSchema(std::size_t table) {
+    static const std::vector<ParquetColumnSpec> kSchemas[] = {
+        withKeys({{"bid", ParquetType::Double}, {"ask", ParquetType::Double},
+                  {"bid_size", ParquetType::Int32}, {"ask_size", ParquetType::Int32},
+                  {"size_scale", ParquetType::Int32}}),  // NOTE: Sizes are units * 10^-size_scale (Quantity.h)
+        withKeys({{"price", ParquetType::Double}, {"size", ParquetType::Int32},
+                  {"past_limit", ParquetType::Boolean}, {"size_scale", ParquetType::Int32}}),
+        withKeys({{"position", ParquetType::Int32}, {"operation", ParquetType::Int32},
+                  {"side", ParquetType::Int32}, {"price", ParquetType::Double}, {"size", ParquetType::Int64}}),
+        withKeys({{"bar_size", ParquetType::String, ParquetEncoding::Dictionary},
+                  {"open", ParquetType::Double}, {"high", ParquetType::Double}, {"low", ParquetType::Double},
+                  {"close", ParquetType::Double}, {"volume", ParquetType::Int64}, {"wap", ParquetType::Double},
+                  {"count", ParquetType::Int32}, {"historical", ParquetType::Boolean}}),
+    };
+    return kSchemas[table];
+}
+
+// "BRK B" → "BRK_B": symbols become file names
+std::string fileName(const std::string& symbol) {
+    std::string name = symbol.empty() ? "_" : symbol;
+    for (char& c : name) {
+        const bool safe = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')
+                          || c == '.' || c == '-' || c == '_';
+        c = safe ? c : '_';
+    }
+    return name;
+}
+
+} // namespace
+
+JournalExporter::JournalExporter(ExportConfig config)
+    : m_config(std::move(config))
+    , m_slots(std::size_t{std::numeric_limits<SlotId>::max()} + 1, 0) {
+}
+
+bool JournalExporter::run(const std::string& path) {
+    struct stat info {};
+    const bool directory = ::stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    const std::vector<std::string> paths = directory ? TickJournalReader::segments(path)
+                                                     : std::vector<std::string>{path};
+    TickJournalScan reader(m_config.filter);
+    bool opened = false;
+    for (const std::string& segment : paths) {
+        if (!reader.open(segment)) {
+            std::cerr << "[EXPORT] Not a journal segment: " << segment << "\n";
+            continue;
+        }
+        opened = true;
+        ++m_counters.segments;
+        if (m_session.empty() || reader.header().sessionStartNs != m_sessionStartNs) {
+            finishSession();
+            m_sessionStartNs = reader.header().sessionStartNs;
+            beginSession(segment);
+        }
+        JournalEntry entry;
+        while (reader.next(entry)) {
+            append(entry);
+        }
+    }
+    finishSession();
+    m_counters.skippedBytes = reader.skippedBytes();
+    return opened && m_counters.errors == 0;
+}
+
+// Session name from the segment file name ({session}-{index}.tjl)
+void JournalExporter::beginSession(const std::string& segmentPath) {
+    const std::string stem = std::filesystem::path(segmentPath).stem().string();
+    const std::size_t dash = stem.rfind('-');
+    m_session = dash == std::string::npos ? stem : stem.substr(0, dash);
+    std::fill(m_slots.begin(), m_slots.end(), 0);
+}
+
+void JournalExporter::append(const JournalEntry& entry) {
+    if (entry.kind == JournalRecordKind::Symbol) {
+        // REASON: Symbol records repeat in every segment - one table set per symbol for the whole session
+        const auto [it, inserted] = m_symbolIndex.emplace(entry.symbol, static_cast<std::uint32_t>(m_symbols.size()));
+        if (inserted) {
+            m_symbols.emplace_back();
+            m_symbols.back().symbol = entry.symbol;
+        }
+        m_slots[entry.slot] = it->second + 1;
+        return;
+    }
+    const TickUpdate& update = entry.update;
+    Table kind;
+    switch (update.type) {
+    case TickUpdateType::BidAsk:
+        kind = Quotes;
+        break;
+    case TickUpdateType::AllLast:
+        kind = Trades;
+        break;
+    case TickUpdateType::Depth:
+        kind = Depth;
+        break;
+    case TickUpdateType::Bar:
+        kind = Bars;
+        break;
+    default:
+        return;  // HistoryEnd: a publish trigger, no data; MidPoint: derived from the quotes, no table;
+                 // Greeks: model output, not market data
+    }
+    const std::uint32_t mapped = m_slots[update.slot];
+    if (mapped == 0) {
+        ++m_counters.unmapped;
+        return;
+    }
+    SymbolTables& tables = m_symbols[mapped - 1];
+    ParquetWriter& writer = table(tables, kind);
+
+    std::size_t column = 0;
+    writer.column(column++).append(std::string_view(tables.symbol));
+    writer.column(column++).append(static_cast<std::int64_t>(update.timestamp));
+    writer.column(column++).append(static_cast<std::int64_t>(entry.receiveNs));
+    switch (kind) {
+    case Quotes:
+        writer.column(column++).append(update.bidAsk.bidPrice);
+        writer.column(column++).append(update.bidAsk.askPrice);
+        writer.column(column++).append(static_cast<std::int64_t>(update.bidAsk.bidSize));
+        writer.column(column++).append(static_cast<std::int64_t>(update.bidAsk.askSize));
+        writer.column(column++).append(static_cast<std::int64_t>(update.sizeScale()));
+        break;
+    case Trades:
+        writer.column(column++).append(update.allLast.price);
+        writer.column(column++).append(static_cast<std::int64_t>(update.allLast.size));
+        writer.column(column++).append(static_cast<std::int64_t>(update.pastLimit()));
+        writer.column(column++).append(static_cast<std::int64_t>(update.sizeScale()));
+        break;
+    case Depth:
+        writer.column(column++).append(static_cast<std::int64_t>(update.depth.position));
+        writer.column(column++).append(static_cast<std::int64_t>(update.depth.operation));
+        writer.column(column++).append(static_cast<std::int64_t>(update.depth.side));
+        writer.column(column++).append(update.depth.price);
+        writer.column(column++).append(static_cast<std::int64_t>(update.depth.size));
+        break;
+    default:
+        writer.column(column++).append(std::string_view(barSizeLabel(update.barSize())));
+        writer.column(column++).append(update.bar.open);
+        writer.column(column++).append(update.bar.high);
+        writer.column(column++).append(update.bar.low);
+        writer.column(column++).append(update.bar.close);
+        writer.column(column++).append(static_cast<std::int64_t>(update.bar.volume));
+        writer.column(column++).append(update.bar.wap);
+        writer.column(column++).append(static_cast<std::int64_t>(update.aux));
+        writer.column(column++).append(static_cast<std::int64_t>((update.flags & TickFlags::Historical) != 0));
+        break;
+    }
+    ++m_counters.rows;
+    ++m_buffered;
+
+    if (writer.bufferedRows() >= m_config.rowGroupRows) {
+        flush(writer);
+    }
+    if (m_buffered >= m_config.maxBufferedRows) {
+        for (SymbolTables& symbol : m_symbols) {
+            for (auto& other : symbol.tables) {
+                if (other) {
+                    flush(*other);
+                }
+            }
+        }
+    }
+}
+
+ParquetWriter& JournalExporter::table(SymbolTables& tables, Table kind) {
+    std::unique_ptr<ParquetWriter>& writer = tables.tables[kind];
+    if (!writer) {
+        const std::filesystem::path directory = std::filesystem::path(m_config.directory) / m_session / kTableNames[kind];
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (error) {
+            std::cerr << "[EXPORT] Cannot create " << directory.string() << ": " << error.message() << "\n";
+        }
+        // NOTE: A failed directory still gets a writer - its flush reports the error once, rows are dropped
+        writer = std::make_unique<ParquetWriter>((directory / (fileName(tables.symbol) + ".parquet")).string(),
+                                                 tableSchema(kind));
+    }
+    return *writer;
+}
+
+void JournalExporter::flush(ParquetWriter& writer) {
+    const std::size_t rows = writer.bufferedRows();
+    const std::size_t groups = writer.rowGroups();
+    writer.flush();  // NOTE: A failed writer drops its rows and fails close() - counted there, once
+    m_buffered -= rows;
+    m_counters.rowGroups += writer.rowGroups() - groups;
+}
+
+void JournalExporter::finishSession() {
+    for (SymbolTables& tables : m_symbols) {
+        for (auto& writer : tables.tables) {
+            if (!writer) {
+                continue;
+            }
+            flush(*writer);
+            if (writer->close({{"tws_bridge.session", m_session}, {"tws_bridge.symbol", tables.symbol}})) {
+                ++m_counters.files;
+            } else {
+                ++m_counters.errors;
+                std::error_code error;
+                std::filesystem::remove(writer->path(), error);  // REASON: No footer = unreadable, don't leave it behind
+            }
+        }
+    }
+    m_symbols.clear();
+    m_symbolIndex.clear();
+    m_buffered = 0;
+    m_session.clear();
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,584 @@
+// JournalServer.cpp - Request parsing, index-guided range selection, sendfile / filtered copy, pacing
+
+#include "JournalServer.h"
+#include "PublishMessage.h"
+#include "RespConnection.h"
+#include "ThreadAffinity.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+namespace {
+
+constexpr std::size_t kFlushBytes = std::size_t{256} << 10;       // Copy path: frame bytes per send()
+constexpr std::size_t kMaxFrameBytes = std::size_t{1} << 30;      // Zero-copy ranges are split below this
+constexpr std::size_t kStreamBatch = 512;                         // XADDs per pipelined round trip
+constexpr std::size_t kMaxRequestBytes = 4096;
+
+bool validStreamName(const std::string& name) {
+    return !name.empty() && name.size() <= 64 && std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_' || c == '-'
+            || c == '.' || c == ':';
+    });
+}
+
+// One request's output: frames on the client socket, or records to a Redis stream
+// REASON: Thrown through the segment loops as std::runtime_error - the client or Redis is gone, nothing to resume
+class RequestWriter {
+public:
+    RequestWriter(int fd, const JournalServerConfig& config, const std::string& stream, JournalServerCounters& counters)
+        : m_fd(fd), m_counters(counters) {
+        if (!stream.empty()) {
+            m_streamKey = kJournalReplayStreamPrefix + stream;
+            m_redis = std::make_unique<RespConnection>(config.redis, config.connection,
+                                                       static_cast<long long>(config.streamMaxLen), true);
+        }
+        m_out.reserve(kFlushBytes + journal_detail::kMaxSymbolRecordBytes);
+    }
+
+    bool toStream() const { return m_redis != nullptr; }
+
+    void segment(const JournalSegmentHeader& header) {
+        if (!m_redis) {
+            frame(JournalFrameKind::Segment, &header, sizeof(header));
+        }
+    }
+
+    void record(const JournalEntry& entry) {
+        if (m_redis) {
+            m_recordEnds.push_back(appendTo(m_records, entry));
+            if (m_recordEnds.size() == kStreamBatch) {
+                flush();
+            }
+            return;
+        }
+        if (m_recordsFrame == std::string::npos) {
+            m_recordsFrame = m_out.size();
+            m_out.append(sizeof(JournalFrameHeader), '\0');
+        }
+        appendJournalRecord(m_out, entry);
+        if (m_out.size() >= kFlushBytes) {
+            flush();
+        }
+    }
+
+    // PERFORMANCE: Page cache → socket inside the kernel, the range is never mapped or copied here
+    void sendFile(int fileFd, JournalFrameKind kind, std::size_t offset, std::size_t length) {
+        if (m_recordsFrame != std::string::npos) {
+            flush();  // REASON: Closes the open Records frame - its length must not count this header
+        }
+        const JournalFrameHeader header{kind, static_cast<std::uint32_t>(length)};
+        m_out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        flush();
+        off_t position = static_cast<off_t>(offset);
+        std::size_t left = length;
+        while (left > 0) {
+            const ssize_t sent = ::sendfile(m_fd, fileFd, &position, left);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                throw std::runtime_error(sent < 0 ? std::strerror(errno) : "segment shrank during sendfile");
+            }
+            left -= static_cast<std::size_t>(sent);
+        }
+        m_counters.bytes.fetch_add(length, std::memory_order_relaxed);
+        m_counters.zeroCopyBytes.fetch_add(length, std::memory_order_relaxed);
+    }
+
+    void end(std::uint64_t ticks) {
+        frame(JournalFrameKind::End, &ticks, sizeof(ticks));
+        flush();
+    }
+
+    void error(const std::string& reason) {
+        m_recordsFrame = std::string::npos;
+        m_out.clear();
+        frame(JournalFrameKind::Error, reason.data(), reason.size());
+        flush();
+    }
+
+    // Sends / XADDs everything buffered
+    void flush() {
+        if (m_redis && !m_recordEnds.empty()) {
+            m_messages.clear();
+            std::size_t begin = 0;
+            for (const std::size_t end : m_recordEnds) {
+                m_messages.push_back(PublishMessage{m_streamKey, std::string_view(m_records).substr(begin, end - begin),
+                                                    RedisCommand::StreamAdd});
+                begin = end;
+            }
+            m_redis->send(m_messages.data(), m_messages.size());  // Throws std::runtime_error
+            m_counters.streamEntries.fetch_add(m_recordEnds.size(), std::memory_order_relaxed);
+            m_records.clear();
+            m_recordEnds.clear();
+        }
+        if (m_recordsFrame != std::string::npos) {
+            const JournalFrameHeader header{JournalFrameKind::Records,
+                static_cast<std::uint32_t>(m_out.size() - m_recordsFrame - sizeof(JournalFrameHeader))};
+            std::memcpy(&m_out[m_recordsFrame], &header, sizeof(header));
+            m_recordsFrame = std::string::npos;
+        }
+        const char* data = m_out.data();
+        std::size_t left = m_out.size();
+        while (left > 0) {
+            const ssize_t sent = ::send(m_fd, data, left, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                throw std::runtime_error(sent < 0 ? std::strerror(errno) : "connection closed");
+            }
+            data += sent;
+            left -= static_cast<std::size_t>(sent);
+        }
+        m_counters.bytes.fetch_add(m_out.size(), std::memory_order_relaxed);
+        m_out.clear();
+    }
+
+private:
+    static std::size_t appendTo(std::string& out, const JournalEntry& entry) {
+        appendJournalRecord(out, entry);
+        return out.size();
+    }
+
+    void frame(JournalFrameKind kind, const void* payload, std::size_t length) {
+        if (m_recordsFrame != std::string::npos) {
+            flush();
+        }
+        const JournalFrameHeader header{kind, static_cast<std::uint32_t>(length)};
+        m_out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_out.append(static_cast<const char*>(payload), length);
+    }
+
+    int m_fd;
+    JournalServerCounters& m_counters;
+    std::string m_out;
+    std::size_t m_recordsFrame = std::string::npos;   // Open Records frame's header in m_out
+    std::string m_streamKey;
+    std::unique_ptr<RespConnection> m_redis;
+    std::string m_records;                            // Stream batch: record bytes back to back
+    std::vector<std::size_t> m_recordEnds;
+    std::vector<PublishMessage> m_messages;
+};
+
+// Holds each tick until its scaled offset from the request's first tick (JournalReplay's pacing)
+class RequestPacer {
+public:
+    explicit RequestPacer(double speed) : m_speed(speed) {}
+
+    bool paced() const { return m_speed > 0.0; }
+
+    // false if `running` dropped while waiting
+    template <typename Flush>
+    bool wait(std::int64_t receiveNs, const std::atomic<bool>& running, Flush&& flush) {
+        if (m_baseReceiveNs == 0) {
+            m_baseReceiveNs = receiveNs;
+            m_baseTime = std::chrono::steady_clock::now();
+            return true;
+        }
+        const double offsetNs = static_cast<double>(receiveNs - m_baseReceiveNs) / m_speed;
+        const auto due = m_baseTime + std::chrono::nanoseconds(static_cast<std::int64_t>(offsetNs));
+        if (due - std::chrono::steady_clock::now() <= std::chrono::microseconds(50)) {
+            return true;  // REASON: A recorded burst goes out back to back, as it arrived
+        }
+        flush();  // REASON: What is due now reaches the client before this thread sleeps
+        while (running.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < due) {
+            std::this_thread::sleep_until(std::min(due, std::chrono::steady_clock::now() + std::chrono::milliseconds(100)));
+        }
+        return running.load(std::memory_order_relaxed);
+    }
+
+private:
+    double m_speed;
+    std::int64_t m_baseReceiveNs = 0;
+    std::chrono::steady_clock::time_point m_baseTime;
+};
+
+// A run of whole index blocks served the same way
+struct Piece {
+    std::size_t begin;
+    std::size_t end;
+    bool zeroCopy;
+    std::uint64_t ticks;                              // zeroCopy: from the index
+};
+
+struct ScopedFd {
+    int fd = -1;
+    ~ScopedFd() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+bool subsetOf(const JournalSegmentIndex& entries, std::size_t block, const std::vector<std::uint64_t>& wanted) {
+    for (std::size_t word = 0; word < entries.words; ++word) {
+        if ((entries.bitmaps[block * entries.words + word] & ~wanted[word]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseServeRequest(std::string_view line, JournalServeRequest& request, std::string& error) {
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+        line.remove_suffix(1);
+    }
+    request = JournalServeRequest{};
+    bool verb = true;
+    while (!line.empty()) {
+        const std::size_t space = line.find(' ');
+        const std::string_view token = line.substr(0, space);
+        line = space == std::string_view::npos ? std::string_view{} : line.substr(space + 1);
+        if (token.empty()) {
+            continue;
+        }
+        if (verb) {
+            if (token != "REPLAY") {
+                error = "expected REPLAY";
+                return false;
+            }
+            verb = false;
+            continue;
+        }
+        const std::size_t equals = token.find('=');
+        const std::string key(token.substr(0, equals));
+        const std::string value(equals == std::string_view::npos ? std::string_view{} : token.substr(equals + 1));
+        if (key == "symbols") {
+            std::size_t start = 0;
+            while (start <= value.size()) {
+                const std::size_t comma = std::min(value.find(',', start), value.size());
+                if (comma > start) {
+                    request.filter.symbols.push_back(value.substr(start, comma - start));
+                }
+                start = comma + 1;
+            }
+        } else if (key == "from" || key == "to") {
+            if (!parseJournalTime(value, key == "from" ? request.filter.fromNs : request.filter.toNs)) {
+                error = "bad " + key + " time: " + value;
+                return false;
+            }
+        } else if (key == "speed") {
+            if (!parseReplaySpeed(value, request.speed)) {
+                error = "bad speed: " + value;
+                return false;
+            }
+        } else if (key == "session") {
+            request.session = value;
+        } else if (key == "stream") {
+            if (!validStreamName(value)) {
+                error = "bad stream name (1-64 of A-Z a-z 0-9 _ - . :)";
+                return false;
+            }
+            request.stream = value;
+        } else {
+            error = "unknown key: " + key;
+            return false;
+        }
+    }
+    if (verb) {
+        error = "empty request";
+        return false;
+    }
+    if (request.filter.fromNs > request.filter.toNs) {
+        error = "from is after to";
+        return false;
+    }
+    return true;
+}
+
+JournalServer::JournalServer(JournalServerConfig config)
+    : m_config(std::move(config)) {
+}
+
+JournalServer::~JournalServer() {
+    stop();
+}
+
+bool JournalServer::start() {
+    if (m_running.load()) {
+        return true;
+    }
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "[JOURNAL-SERVER] socket() failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    const int reuse = 1;
+    ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_config.port);
+    if (::inet_pton(AF_INET, m_config.bindAddress.c_str(), &address.sin_addr) != 1
+        || ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(m_listenFd, 16) != 0) {
+        std::cerr << "[JOURNAL-SERVER] Cannot listen on " << m_config.bindAddress << ":" << m_config.port << ": "
+                  << std::strerror(errno) << "\n";
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    m_boundPort.store(ntohs(address.sin_port), std::memory_order_release);
+
+    m_running.store(true);
+    m_thread = std::thread([this]() { run(); });
+    std::cout << "[JOURNAL-SERVER] Serving " << m_config.directory << " on " << m_config.bindAddress << ":" << port()
+              << "\n";
+    return true;
+}
+
+void JournalServer::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        m_listenFd = -1;
+    }
+}
+
+// Joins finished requests (all: aborts and joins every one - stop())
+void JournalServer::reap(bool all) {
+    for (auto it = m_clients.begin(); it != m_clients.end();) {
+        Client& client = **it;
+        if (!all && !client.done.load(std::memory_order_acquire)) {
+            ++it;
+            continue;
+        }
+        if (all) {
+            ::shutdown(client.fd, SHUT_RDWR);  // REASON: Unblocks a send() to a client that stopped reading
+        }
+        client.thread.join();
+        ::close(client.fd);
+        it = m_clients.erase(it);
+    }
+}
+
+void JournalServer::run() {
+    nameCurrentThread("tws-jserve");
+    while (m_running.load()) {
+        reap(false);
+        pollfd listener{m_listenFd, POLLIN, 0};
+        if (::poll(&listener, 1, static_cast<int>(m_config.pollTimeout.count())) <= 0) {
+            continue;
+        }
+        const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        timeval timeout{};
+        timeout.tv_sec = static_cast<time_t>(m_config.ioTimeout.count() / 1000);
+        timeout.tv_usec = static_cast<suseconds_t>((m_config.ioTimeout.count() % 1000) * 1000);
+        ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if (m_clients.size() >= m_config.maxClients) {
+            m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            try {
+                RequestWriter(fd, m_config, "", m_counters).error("busy: " + std::to_string(m_config.maxClients)
+                                                                  + " requests in flight, retry later");
+            } catch (const std::runtime_error&) {
+            }
+            ::close(fd);
+            continue;
+        }
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+        Client& started = *client;
+        m_clients.push_back(std::move(client));
+        started.thread = std::thread([this, &started]() {
+            serve(started);
+            started.done.store(true, std::memory_order_release);
+        });
+    }
+    reap(true);
+}
+
+void JournalServer::serve(Client& client) {
+    nameCurrentThread("tws-jserve-req");
+    std::string line;
+    char buffer[512];
+    while (line.find('\n') == std::string::npos && line.size() < kMaxRequestBytes) {
+        const ssize_t received = ::recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        line.append(buffer, static_cast<std::size_t>(received));
+    }
+    line.resize(std::min(line.find('\n'), line.size()));
+
+    JournalServeRequest request;
+    std::string error;
+    if (!parseServeRequest(line, request, error)) {
+        m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        try {
+            RequestWriter(client.fd, m_config, "", m_counters).error(error);
+        } catch (const std::runtime_error&) {
+        }
+        return;
+    }
+    m_counters.requests.fetch_add(1, std::memory_order_relaxed);
+    m_counters.active.fetch_add(1, std::memory_order_relaxed);
+    try {
+        RequestWriter writer(client.fd, m_config, request.stream, m_counters);
+        const JournalFilter& filter = request.filter;
+        RequestPacer pacer(request.speed);
+        const bool zeroCopy = !pacer.paced() && !writer.toStream();
+        std::vector<std::uint64_t> wanted((std::size_t{std::numeric_limits<SlotId>::max()} + 1) / 64);
+        const auto wantedSymbol = [&filter](const std::string& symbol) {
+            return filter.symbols.empty()
+                || std::find(filter.symbols.begin(), filter.symbols.end(), symbol) != filter.symbols.end();
+        };
+        const auto wantedSlot = [&](SlotId slot) {
+            return filter.symbols.empty() || (wanted[slot / 64] >> (slot % 64) & 1) != 0;
+        };
+
+        std::uint64_t ticks = 0;
+        TickJournalReader reader;
+        JournalIndex index;
+        std::vector<Piece> pieces;
+        JournalEntry entry;
+        for (const std::string& path : TickJournalReader::segments(m_config.directory, request.session)) {
+            if (!m_running.load(std::memory_order_relaxed)) {
+                throw std::runtime_error("server stopping");
+            }
+            if (!reader.open(path)) {
+                continue;
+            }
+            std::fill(wanted.begin(), wanted.end(), 0);
+            // REASON: Version 1 records are re-encoded in the current layout, never sent verbatim
+            const bool verbatim = zeroCopy && !reader.legacy();
+            const bool indexed = index.load(JournalIndex::pathFor(path), reader.size());
+            const JournalSegmentIndex& entries = index.entries();
+            const std::size_t firstRecord = sizeof(JournalSegmentHeader);
+
+            // ========== Pieces: whole index blocks, zero-copy when every record in them is wanted ==========
+            pieces.clear();
+            if (!indexed) {
+                // REASON: No block boundaries to split at - only a whole unfiltered segment goes out as is
+                const bool whole = verbatim && filter.all() && reader.size() - firstRecord < kMaxFrameBytes;
+                pieces.push_back({firstRecord, reader.size(), whole, 0});
+            } else {
+                for (const auto& [slot, symbol] : index.symbols()) {
+                    if (wantedSymbol(symbol)) {
+                        wanted[slot / 64] |= std::uint64_t{1} << (slot % 64);
+                    }
+                }
+                for (std::size_t i = 0; i < entries.blocks.size(); ++i) {
+                    const JournalIndexBlock& block = entries.blocks[i];
+                    if (block.lastReceiveNs < filter.fromNs || block.firstReceiveNs > filter.toNs) {
+                        continue;
+                    }
+                    bool holds = filter.symbols.empty();
+                    for (std::size_t word = 0; !holds && word < entries.words; ++word) {
+                        holds = (entries.bitmaps[i * entries.words + word] & wanted[word]) != 0;
+                    }
+                    if (!holds) {
+                        continue;
+                    }
+                    const std::size_t end = i + 1 < entries.blocks.size() ? entries.blocks[i + 1].offset : reader.size();
+                    const bool whole = verbatim && block.firstReceiveNs >= filter.fromNs
+                        && block.lastReceiveNs <= filter.toNs && (filter.symbols.empty() || subsetOf(entries, i, wanted));
+                    if (!pieces.empty() && pieces.back().end == block.offset && pieces.back().zeroCopy == whole
+                        && end - pieces.back().begin < kMaxFrameBytes) {
+                        pieces.back().end = end;
+                        pieces.back().ticks += block.records;
+                    } else {
+                        pieces.push_back({static_cast<std::size_t>(block.offset), end, whole, block.records});
+                    }
+                }
+                if (pieces.empty()) {
+                    continue;  // REASON: Nothing wanted here - not even its Segment frame
+                }
+            }
+
+            JournalSegmentHeader announced = reader.header();
+            if (reader.legacy()) {
+                announced.version = kJournalVersion;  // NOTE: Clients parse the Records frames that follow by it
+            }
+            writer.segment(announced);
+            if (indexed) {
+                // REASON: Raw segments announce a slot once - the blocks skipped may hold its Symbol record
+                for (const auto& [slot, symbol] : index.symbols()) {
+                    if (wantedSlot(slot)) {
+                        entry.kind = JournalRecordKind::Symbol;
+                        entry.receiveNs = 0;
+                        entry.slot = slot;
+                        entry.symbol = symbol;
+                        writer.record(entry);
+                    }
+                }
+            }
+            ScopedFd file;
+            for (const Piece& piece : pieces) {
+                if (piece.zeroCopy) {
+                    if (file.fd < 0 && (file.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC)) < 0) {
+                        throw std::runtime_error(path + ": " + std::strerror(errno));
+                    }
+                    writer.sendFile(file.fd, reader.compressed() ? JournalFrameKind::Blocks : JournalFrameKind::Records,
+                                    piece.begin, piece.end - piece.begin);
+                    ticks += piece.ticks;
+                    continue;
+                }
+                reader.seek(piece.begin, piece.end);
+                while (reader.next(entry)) {
+                    if (entry.kind == JournalRecordKind::Symbol) {
+                        if (indexed) {
+                            continue;  // REASON: Announced from the index above
+                        }
+                        const bool wantedNow = wantedSymbol(entry.symbol);
+                        std::uint64_t& word = wanted[entry.slot / 64];
+                        const std::uint64_t bit = std::uint64_t{1} << (entry.slot % 64);
+                        word = wantedNow ? word | bit : word & ~bit;
+                        if (wantedNow) {
+                            writer.record(entry);
+                        }
+                        continue;
+                    }
+                    if (!wantedSlot(entry.update.slot) || entry.receiveNs < filter.fromNs || entry.receiveNs > filter.toNs) {
+                        continue;
+                    }
+                    if (pacer.paced() && !pacer.wait(entry.receiveNs, m_running, [&writer]() { writer.flush(); })) {
+                        throw std::runtime_error("server stopping");
+                    }
+                    writer.record(entry);
+                    ++ticks;
+                }
+            }
+        }
+        writer.end(ticks);
+        m_counters.ticks.fetch_add(ticks, std::memory_order_relaxed);
+    } catch (const std::runtime_error& e) {
+        m_counters.failed.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "[JOURNAL-SERVER] Request aborted (" << line << "): " << e.what() << "\n";
+        try {
+            RequestWriter(client.fd, m_config, "", m_counters).error(e.what());
+        } catch (const std::runtime_error&) {
+        }
+    }
+    m_counters.active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,155 @@
+// KafkaSink.cpp - librdkafka producer behind the snapshot sink interface
+
+#include "KafkaSink.h"
+#include <iostream>
+
+#ifdef TWS_BRIDGE_KAFKA
+#include "AsyncLogger.h"
+#include <librdkafka/rdkafka.h>
+#endif
+
+namespace tws_bridge {
+
+#ifdef TWS_BRIDGE_KAFKA
+
+namespace {
+
+class KafkaSink : public SnapshotSink {
+public:
+    KafkaSink(const KafkaConfig& config, const InstrumentRegistry& registry, KafkaCounters& counters)
+        : m_config(config)
+        , m_registry(registry)
+        , m_counters(counters) {
+    }
+
+    ~KafkaSink() override {
+        if (m_topic) {
+            rd_kafka_topic_destroy(m_topic);
+        }
+        if (m_producer) {
+            rd_kafka_destroy(m_producer);
+        }
+    }
+
+    KafkaSink(const KafkaSink&) = delete;
+    KafkaSink& operator=(const KafkaSink&) = delete;
+
+    // false with the reason on stderr
+    bool open() {
+        char error[512];
+        rd_kafka_conf_t* conf = rd_kafka_conf_new();
+        for (const auto& [key, value] : kafkaProperties(m_config)) {
+            if (rd_kafka_conf_set(conf, key.c_str(), value.c_str(), error, sizeof(error)) != RD_KAFKA_CONF_OK) {
+                std::cerr << "[KAFKA] " << key << "=" << value << ": " << error << "\n";
+                rd_kafka_conf_destroy(conf);
+                return false;
+            }
+        }
+        rd_kafka_conf_set_dr_msg_cb(conf, &KafkaSink::onDelivery);
+        rd_kafka_conf_set_opaque(conf, this);
+        m_producer = rd_kafka_new(RD_KAFKA_PRODUCER, conf, error, sizeof(error));  // NOTE: Owns conf on success
+        if (!m_producer) {
+            std::cerr << "[KAFKA] Producer: " << error << "\n";
+            rd_kafka_conf_destroy(conf);
+            return false;
+        }
+        m_topic = rd_kafka_topic_new(m_producer, m_config.topic.c_str(), nullptr);
+        if (!m_topic) {
+            std::cerr << "[KAFKA] Topic " << m_config.topic << ": " << rd_kafka_err2str(rd_kafka_last_error()) << "\n";
+            return false;
+        }
+        if (m_config.partitioner == KafkaPartitioner::Slot) {
+            // REASON: Partition count read once - slot % partitions must not move records between partitions
+            const rd_kafka_metadata_t* metadata = nullptr;
+            const rd_kafka_resp_err_t result = rd_kafka_metadata(m_producer, 0, m_topic, &metadata, 5000);
+            if (result != RD_KAFKA_RESP_ERR_NO_ERROR || metadata->topic_cnt != 1 || metadata->topics[0].err) {
+                std::cerr << "[KAFKA] Metadata of " << m_config.topic << ": " << rd_kafka_err2str(result)
+                          << " (topic must exist for partitioner: slot)\n";
+                if (metadata) {
+                    rd_kafka_metadata_destroy(metadata);
+                }
+                return false;
+            }
+            m_partitions = metadata->topics[0].partition_cnt;
+            rd_kafka_metadata_destroy(metadata);
+        }
+        return true;
+    }
+
+    const char* name() const override { return "kafka"; }
+    bool wantsBinary() const override { return m_config.format == KafkaFormat::Binary; }
+
+    void onBatch(const SnapshotRecord* records, std::size_t count) override {
+        for (std::size_t i = 0; i < count; ++i) {
+            const SnapshotRecord& record = records[i];
+            const std::string_view value = m_config.format == KafkaFormat::Binary ? record.binary : record.payload;
+            const std::string& key = m_registry.symbol(record.slot);
+            const std::int32_t partition = kafkaPartition(m_config.partitioner, record.slot, m_partitions);
+            // PERFORMANCE: F_COPY - record bytes belong to the shared batch, librdkafka batches its own copy
+            for (int attempt = 0;; ++attempt) {
+                if (rd_kafka_produce(m_topic, partition < 0 ? RD_KAFKA_PARTITION_UA : partition, RD_KAFKA_MSG_F_COPY,
+                                     const_cast<char*>(value.data()), value.size(), key.data(), key.size(),
+                                     nullptr) == 0) {
+                    break;
+                }
+                if (rd_kafka_last_error() != RD_KAFKA_RESP_ERR__QUEUE_FULL || attempt == 1) {
+                    m_counters.dropped.fetch_add(1, std::memory_order_relaxed);
+                    BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[KAFKA] Produce to {} failed: {}", m_config.topic,
+                                        rd_kafka_err2str(rd_kafka_last_error()));
+                    break;
+                }
+                // BACKPRESSURE: One short wait for delivery reports to free queue space, then drop
+                rd_kafka_poll(m_producer, 10);
+            }
+        }
+        rd_kafka_poll(m_producer, 0);  // REASON: Serves delivery reports (counters) without waiting
+    }
+
+    void onStop() override {
+        // REASON: linger.ms may still hold the last records - give the brokers a bounded chance to take them
+        if (rd_kafka_flush(m_producer, 5000) != RD_KAFKA_RESP_ERR_NO_ERROR) {
+            std::cerr << "[KAFKA] " << rd_kafka_outq_len(m_producer) << " records undelivered at shutdown\n";
+        }
+    }
+
+private:
+    // Sink thread (served by rd_kafka_poll / rd_kafka_flush)
+    static void onDelivery(rd_kafka_t*, const rd_kafka_message_t* message, void* opaque) {
+        KafkaSink* self = static_cast<KafkaSink*>(opaque);
+        if (message->err) {
+            self->m_counters.failed.fetch_add(1, std::memory_order_relaxed);
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[KAFKA] Delivery failed: {}", rd_kafka_err2str(message->err));
+        } else {
+            self->m_counters.delivered.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    KafkaConfig m_config;
+    const InstrumentRegistry& m_registry;
+    KafkaCounters& m_counters;
+    rd_kafka_t* m_producer = nullptr;
+    rd_kafka_topic_t* m_topic = nullptr;
+    std::int32_t m_partitions = 0;
+};
+
+} // namespace
+
+std::shared_ptr<SnapshotSink> makeKafkaSink(const KafkaConfig& config, const InstrumentRegistry& registry,
+                                            KafkaCounters& counters) {
+    auto sink = std::make_shared<KafkaSink>(config, registry, counters);
+    if (!sink->open()) {
+        return nullptr;
+    }
+    return sink;
+}
+
+#else
+
+std::shared_ptr<SnapshotSink> makeKafkaSink(const KafkaConfig&, const InstrumentRegistry&, KafkaCounters&) {
+    std::cerr << "[KAFKA] Built without Kafka support (cmake -DTWS_BRIDGE_KAFKA=ON, needs librdkafka)\n";
+    return nullptr;
+}
+
+#endif
+
+} // namespace tws_bridge
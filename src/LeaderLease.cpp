@@ -0,0 +1,123 @@
+// LeaderLease.cpp - Redis lease key acquire / renew / release implementation
+
+#include "LeaderLease.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+// REASON: Compare-and-act in one script - a plain PEXPIRE / DEL could extend or delete the key after
+// it expired and the other node took it
+const char* const kRenewScript =
+    "if redis.call('GET', KEYS[1]) == ARGV[1] then return redis.call('PEXPIRE', KEYS[1], ARGV[2]) end return 0";
+const char* const kReleaseScript =
+    "if redis.call('GET', KEYS[1]) == ARGV[1] then return redis.call('DEL', KEYS[1]) end return 0";
+
+} // namespace
+
+LeaderLease::LeaderLease(const std::string& uri, LeaderConfig config)
+    : m_uri(uri)
+    , m_config(std::move(config)) {
+    if (m_config.id.empty()) {
+        m_config.id = defaultInstanceId();
+    }
+}
+
+LeaderLease::~LeaderLease() {
+    stop();
+}
+
+void LeaderLease::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void LeaderLease::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void LeaderLease::run() {
+    nameCurrentThread("tws-lease");
+    const std::string ttl = std::to_string(m_config.ttl.count());
+    auto lastRenewed = std::chrono::steady_clock::time_point{};
+    auto expired = [&]() {
+        return m_leader.load() && std::chrono::steady_clock::now() >= leaseStepDownAt(lastRenewed, m_config);
+    };
+    // REASON: Sleep in short steps so stop() and a due step-down are never a whole interval late
+    auto pause = [&](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(50));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && !expired() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    auto stepDown = [this](const char* reason) {
+        std::cerr << "[LEASE] Stepping down (" << reason << ")\n";
+        m_leader.store(false, std::memory_order_release);
+        m_lost.store(true, std::memory_order_release);
+    };
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - a renewal never queues behind a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.socket_timeout = m_config.socketTimeout;
+            opts.connect_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+
+            while (m_running.load()) {
+                if (expired()) {
+                    stepDown("no renewal before the lease ran out");
+                    return;
+                }
+                // NOTE: Stamped before the round trip - the key's expiry is counted from no earlier than this
+                const auto sentAt = std::chrono::steady_clock::now();
+                if (!m_leader.load()) {
+                    sw::redis::ReplyUPtr reply = redis.command("SET", m_config.key, m_config.id, "NX", "PX", ttl);
+                    if (reply && reply->type == REDIS_REPLY_STATUS) {
+                        lastRenewed = sentAt;
+                        m_leader.store(true, std::memory_order_release);
+                        m_counters.acquired.fetch_add(1, std::memory_order_relaxed);
+                        std::cout << "[LEASE] Leader: " << m_config.key << " held as " << m_config.id << "\n";
+                    }
+                } else {
+                    sw::redis::ReplyUPtr reply = redis.command("EVAL", kRenewScript, "1", m_config.key, m_config.id, ttl);
+                    if (!reply || reply->type != REDIS_REPLY_INTEGER) {
+                        throw sw::redis::Error("Unexpected EVAL reply");
+                    }
+                    if (reply->integer != 1) {
+                        m_counters.failures.fetch_add(1, std::memory_order_relaxed);
+                        stepDown("key expired or held by another node");
+                        return;
+                    }
+                    lastRenewed = sentAt;
+                    m_counters.renewals.fetch_add(1, std::memory_order_relaxed);
+                }
+                pause(m_config.renewInterval);
+            }
+            if (m_leader.load()) {
+                redis.command("EVAL", kReleaseScript, "1", m_config.key, m_config.id);
+                m_leader.store(false, std::memory_order_release);
+                std::cout << "[LEASE] Released " << m_config.key << "\n";
+            }
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[LEASE] Redis error: " << e.what() << "\n";
+            m_counters.failures.fetch_add(1, std::memory_order_relaxed);
+            if (!m_running.load()) {
+                break;  // NOTE: Release failed - the key expires on its own within the ttl
+            }
+            pause(m_config.renewInterval);
+        }
+    }
+}
+
+} // namespace tws_bridge
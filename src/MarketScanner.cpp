@@ -0,0 +1,126 @@
+// MarketScanner.cpp - Scan publisher implementation
+
+#include "MarketScanner.h"
+#include "AsyncLogger.h"
+#include "Serialization.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <utility>
+
+namespace tws_bridge {
+
+ScanPublisher::ScanPublisher(const std::string& uri, ScanOutbox& outbox, ScannerConfig config,
+                             std::function<void(SubscriptionCommand)> subscribe)
+    : m_uri(uri)
+    , m_outbox(outbox)
+    , m_config(std::move(config))
+    , m_subscribe(std::move(subscribe)) {
+}
+
+ScanPublisher::~ScanPublisher() {
+    stop();
+}
+
+void ScanPublisher::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void ScanPublisher::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void ScanPublisher::run() {
+    nameCurrentThread("tws-scans");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    const std::size_t scans = m_config.scans.size();
+    std::vector<ScanCycle> published(scans);        // Last cycle sent per scan, the diff's reference
+    std::vector<std::uint64_t> sequences(scans, 0);
+    std::vector<std::string> channels;
+    for (const ScanDefinition& scan : m_config.scans) {
+        channels.push_back(m_config.channelPrefix + scan.id);
+    }
+    ScanCycle cycle;
+    std::vector<std::size_t> changed;
+    std::vector<std::size_t> entrants;
+    JsonBuffer delta;
+    JsonBuffer full;
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - scan deltas never queue behind a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.connect_timeout = m_config.socketTimeout;
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+            while (m_running.load()) {
+                // NOTE: TWS refreshes a scan every ~30s - a 100ms poll adds nothing a consumer would notice
+                pause(std::chrono::milliseconds(100));
+                for (std::size_t i = 0; i < scans && m_running.load(); ++i) {
+                    if (!m_outbox.take(i, cycle)) {
+                        continue;
+                    }
+                    m_counters.cycles.fetch_add(1, std::memory_order_relaxed);
+                    diffScan(published[i], cycle, changed, entrants);
+                    if (changed.empty() && cycle.size == published[i].size) {
+                        m_counters.unchanged.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                    const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+                    serializeScan(m_config.scans[i].id, cycle, &changed, sequences[i] + 1, nowMs, delta);
+                    serializeScan(m_config.scans[i].id, cycle, nullptr, sequences[i] + 1, nowMs, full);
+                    auto pipe = redis.pipeline(false);
+                    pipe.publish(channels[i], sw::redis::StringView(delta.data(), delta.size()));
+                    pipe.set(channels[i], sw::redis::StringView(full.data(), full.size()));  // NOTE: Late joiners GET it
+                    pipe.exec();
+                    // REASON: Only a sent cycle becomes the reference - after an error the next delta covers both
+                    std::swap(published[i], cycle);
+                    ++sequences[i];
+                    m_counters.published.fetch_add(1, std::memory_order_relaxed);
+                    if (m_config.autoSubscribe) {
+                        subscribeEntrants(published[i], entrants);
+                    }
+                }
+            }
+        } catch (const sw::redis::Error& e) {
+            BRIDGE_LOG_EVERY_MS(10000, LogLevel::Error, "[SCAN] Redis error: {}", e.what());
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            pause(m_config.reconnectDelay);
+        }
+    }
+}
+
+void ScanPublisher::subscribeEntrants(const ScanCycle& cycle, const std::vector<std::size_t>& entrants) {
+    for (std::size_t rank : entrants) {
+        const ScanRow& row = cycle.rows[rank];
+        // REASON: Once per symbol - a name dropping out and back in is already streaming
+        if (!m_subscribed.insert(row.symbol).second) {
+            continue;
+        }
+        SubscriptionCommand command;
+        command.symbol = row.symbol;
+        command.secType = row.secType.empty() ? command.secType : row.secType;
+        command.currency = row.currency.empty() ? command.currency : row.currency;
+        command.primaryExchange = row.primaryExchange;
+        command.requestId = "scanner";
+        command.priority = m_config.priority;
+        command.feed = m_config.feed;
+        m_subscribe(std::move(command));
+        m_counters.subscribed.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace tws_bridge
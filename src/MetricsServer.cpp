@@ -0,0 +1,149 @@
+// MetricsServer.cpp - Minimal blocking HTTP/1.1 server for the Prometheus text format
+
+#include "MetricsServer.h"
+#include "ThreadAffinity.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+void sendAll(int fd, const char* data, std::size_t length) {
+    while (length > 0) {
+        const ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return;  // REASON: Scraper went away or timed out - nothing to recover
+        }
+        data += sent;
+        length -= static_cast<std::size_t>(sent);
+    }
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(MetricsServerConfig config)
+    : m_config(std::move(config)) {
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start() {
+    if (m_running.load()) {
+        return true;
+    }
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "[METRICS] socket() failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    const int reuse = 1;
+    ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_config.port);
+    if (::inet_pton(AF_INET, m_config.bindAddress.c_str(), &address.sin_addr) != 1
+        || ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(m_listenFd, 8) != 0) {
+        std::cerr << "[METRICS] Cannot listen on " << m_config.bindAddress << ":" << m_config.port << ": "
+                  << std::strerror(errno) << "\n";
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    m_boundPort.store(ntohs(address.sin_port), std::memory_order_release);
+
+    m_running.store(true);
+    m_thread = std::thread([this]() { run(); });
+    std::cout << "[METRICS] Prometheus endpoint on " << m_config.bindAddress << ":" << port() << "/metrics\n";
+    return true;
+}
+
+void MetricsServer::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        m_listenFd = -1;
+    }
+}
+
+const std::string& MetricsServer::render() {
+    m_writer.clear();
+    for (const Collector& collector : m_collectors) {
+        collector(m_writer);
+    }
+    return m_writer.str();
+}
+
+void MetricsServer::run() {
+    nameCurrentThread("tws-metrics");
+    while (m_running.load()) {
+        // REASON: poll() with a timeout instead of a blocking accept() - stop() never waits on a scrape
+        pollfd listener{m_listenFd, POLLIN, 0};
+        const int ready = ::poll(&listener, 1, static_cast<int>(m_config.pollTimeout.count()));
+        if (ready <= 0) {
+            continue;
+        }
+        const int client = ::accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        serve(client);
+        ::close(client);
+    }
+}
+
+void MetricsServer::serve(int client) {
+    timeval timeout{};
+    timeout.tv_sec = static_cast<time_t>(m_config.ioTimeout.count() / 1000);
+    timeout.tv_usec = static_cast<suseconds_t>((m_config.ioTimeout.count() % 1000) * 1000);
+    ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // NOTE: Only the request line matters - headers are read up to the blank line and ignored
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        const ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<std::size_t>(received));
+    }
+
+    const bool isMetrics = request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET /metrics?", 0) == 0
+        || request.rfind("GET / ", 0) == 0;
+    if (!isMetrics) {
+        m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        static constexpr char kNotFound[] =
+            "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        sendAll(client, kNotFound, sizeof(kNotFound) - 1);
+        return;
+    }
+
+    m_counters.scrapes.fetch_add(1, std::memory_order_relaxed);
+    const std::string& body = render();
+    std::string header = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                         "Connection: close\r\nContent-Length: ";
+    header.append(std::to_string(body.size())).append("\r\n\r\n");
+    sendAll(client, header.data(), header.size());
+    sendAll(client, body.data(), body.size());
+}
+
+} // namespace tws_bridge
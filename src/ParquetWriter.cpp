@@ -0,0 +1,564 @@
+// ParquetWriter.cpp - Parquet pages, Thrift compact metadata and the file footer
+
+#include "ParquetWriter.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace tws_bridge {
+
+namespace {
+
+// ========== parquet.thrift Enums ==========
+namespace pq {
+constexpr std::int32_t kBoolean = 0, kInt32 = 1, kInt64 = 2, kDouble = 5, kByteArray = 6;  // Type
+constexpr std::int32_t kRequired = 0;                                                      // FieldRepetitionType
+constexpr std::int32_t kUtf8 = 0, kTimestampMillis = 9;                                    // ConvertedType
+constexpr std::int32_t kPlain = 0, kRle = 3, kDeltaBinaryPacked = 5, kRleDictionary = 8;   // Encoding
+constexpr std::int32_t kDataPage = 0, kDictionaryPage = 2;                                 // PageType
+constexpr std::int32_t kUncompressed = 0;                                                  // CompressionCodec
+constexpr const char kMagic[] = "PAR1";
+} // namespace pq
+
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+void putLittleEndian(std::string& out, std::uint64_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+unsigned bitWidth(std::uint64_t value) {
+    unsigned width = 0;
+    while (value != 0) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+// Parquet bit packing: value i occupies bits [i * width, (i + 1) * width), least significant first
+void packBits(std::string& out, const std::uint64_t* values, std::size_t count, unsigned width) {
+    unsigned pending = 0;
+    unsigned pendingBits = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t value = values[i];
+        for (unsigned remaining = width; remaining > 0;) {
+            const unsigned take = std::min(remaining, 8 - pendingBits);
+            pending |= static_cast<unsigned>(value & ((1u << take) - 1)) << pendingBits;
+            value >>= take;
+            remaining -= take;
+            pendingBits += take;
+            if (pendingBits == 8) {
+                out.push_back(static_cast<char>(pending));
+                pending = 0;
+                pendingBits = 0;
+            }
+        }
+    }
+    if (pendingBits > 0) {
+        out.push_back(static_cast<char>(pending));
+    }
+}
+
+// Thrift compact protocol - the encoding of every Parquet header and of the footer
+class CompactWriter {
+public:
+    enum : std::uint8_t { kTrue = 1, kFalse = 2, kI32 = 5, kI64 = 6, kBinary = 8, kList = 9, kStruct = 12 };
+
+    explicit CompactWriter(std::string& out) : m_out(out) {}
+
+    void i32(std::int16_t id, std::int32_t value) {
+        field(id, kI32);
+        putVarint(m_out, zigzag(value));
+    }
+    void i64(std::int16_t id, std::int64_t value) {
+        field(id, kI64);
+        putVarint(m_out, zigzag(value));
+    }
+    void boolean(std::int16_t id, bool value) { field(id, value ? kTrue : kFalse); }
+    void binary(std::int16_t id, std::string_view value) {
+        field(id, kBinary);
+        bytes(value);
+    }
+    void beginStruct(std::int16_t id) {
+        field(id, kStruct);
+        beginElement();
+    }
+    void endStruct() {
+        m_out.push_back(0);  // Stop field
+        m_last = m_stack.back();
+        m_stack.pop_back();
+    }
+    void beginList(std::int16_t id, std::uint8_t elementType, std::size_t size) {
+        field(id, kList);
+        if (size < 15) {
+            m_out.push_back(static_cast<char>(size << 4 | elementType));
+        } else {
+            m_out.push_back(static_cast<char>(0xF0 | elementType));
+            putVarint(m_out, size);
+        }
+    }
+    // List elements
+    void beginElement() {
+        m_stack.push_back(m_last);
+        m_last = 0;
+    }
+    void element(std::int32_t value) { putVarint(m_out, zigzag(value)); }
+    void bytes(std::string_view value) {
+        putVarint(m_out, value.size());
+        m_out.append(value.data(), value.size());
+    }
+    // End of the top-level struct
+    void stop() { m_out.push_back(0); }
+
+private:
+    void field(std::int16_t id, std::uint8_t type) {
+        const int delta = id - m_last;
+        if (delta > 0 && delta <= 15) {
+            m_out.push_back(static_cast<char>(delta << 4 | type));
+        } else {
+            m_out.push_back(static_cast<char>(type));
+            putVarint(m_out, zigzag(id));
+        }
+        m_last = id;
+    }
+
+    std::string& m_out;
+    std::int16_t m_last = 0;
+    std::vector<std::int16_t> m_stack;
+};
+
+// DELTA_BINARY_PACKED: blocks of 128 deltas, 4 miniblocks of 32, each bit-packed at its own width
+// PERFORMANCE: Exchange / receive timestamps a few ms apart pack into ~10-20 bits per row
+void encodeDelta(std::string& out, const std::vector<std::int64_t>& values) {
+    constexpr std::size_t kBlockValues = 128;
+    constexpr std::size_t kMiniblocks = 4;
+    constexpr std::size_t kMiniblockValues = kBlockValues / kMiniblocks;
+    putVarint(out, kBlockValues);
+    putVarint(out, kMiniblocks);
+    putVarint(out, values.size());
+    putVarint(out, zigzag(values.empty() ? 0 : values.front()));
+
+    std::uint64_t deltas[kBlockValues];
+    for (std::size_t first = 1; first < values.size(); first += kBlockValues) {
+        const std::size_t count = std::min(kBlockValues, values.size() - first);
+        // REASON: Two's complement wrap-around, as readers reconstruct it
+        std::int64_t minDelta = std::numeric_limits<std::int64_t>::max();
+        for (std::size_t i = 0; i < count; ++i) {
+            deltas[i] = static_cast<std::uint64_t>(values[first + i]) - static_cast<std::uint64_t>(values[first + i - 1]);
+            minDelta = std::min(minDelta, static_cast<std::int64_t>(deltas[i]));
+        }
+        std::uint8_t widths[kMiniblocks] = {};
+        for (std::size_t i = 0; i < kBlockValues; ++i) {
+            deltas[i] = i < count ? deltas[i] - static_cast<std::uint64_t>(minDelta) : 0;  // Zero padding
+        }
+        for (std::size_t m = 0; m * kMiniblockValues < count; ++m) {
+            std::uint64_t bits = 0;
+            for (std::size_t i = m * kMiniblockValues; i < (m + 1) * kMiniblockValues; ++i) {
+                bits |= deltas[i];
+            }
+            widths[m] = static_cast<std::uint8_t>(bitWidth(bits));
+        }
+        putVarint(out, zigzag(minDelta));
+        out.append(reinterpret_cast<const char*>(widths), kMiniblocks);
+        // NOTE: Miniblocks past the last value are not written (their widths stay 0)
+        for (std::size_t m = 0; m * kMiniblockValues < count; ++m) {
+            packBits(out, deltas + m * kMiniblockValues, kMiniblockValues, widths[m]);
+        }
+    }
+}
+
+// RLE / bit-packed hybrid (dictionary indices): runs of 8+ equal values as RLE, the rest bit-packed
+void encodeHybrid(std::string& out, const std::vector<std::int64_t>& values, unsigned width) {
+    std::vector<std::uint64_t> literal;
+    auto flushLiteral = [&]() {
+        if (literal.empty()) {
+            return;
+        }
+        const std::size_t groups = (literal.size() + 7) / 8;
+        literal.resize(groups * 8, 0);  // Only ever padded at the end of the page (num_values bounds it)
+        putVarint(out, groups << 1 | 1);
+        packBits(out, literal.data(), literal.size(), width);
+        literal.clear();
+    };
+    for (std::size_t i = 0; i < values.size();) {
+        std::size_t run = 1;
+        while (i + run < values.size() && values[i + run] == values[i]) {
+            ++run;
+        }
+        // REASON: A bit-packed run holds multiples of 8 values - RLE may only start on a group boundary
+        if (run >= 8 && literal.size() % 8 == 0) {
+            flushLiteral();
+            putVarint(out, run << 1);
+            putLittleEndian(out, static_cast<std::uint64_t>(values[i]), (width + 7) / 8);
+            i += run;
+        } else {
+            literal.push_back(static_cast<std::uint64_t>(values[i]));
+            ++i;
+        }
+    }
+    flushLiteral();
+}
+
+void encodePlain(std::string& out, ParquetType type, const std::vector<std::int64_t>& ints,
+                 const std::vector<double>& doubles) {
+    switch (type) {
+    case ParquetType::Boolean: {
+        std::vector<std::uint64_t> bits(ints.begin(), ints.end());
+        packBits(out, bits.data(), bits.size(), 1);
+        break;
+    }
+    case ParquetType::Int32:
+        for (const std::int64_t value : ints) {
+            putLittleEndian(out, static_cast<std::uint32_t>(value), 4);
+        }
+        break;
+    case ParquetType::Int64:
+        for (const std::int64_t value : ints) {
+            putLittleEndian(out, static_cast<std::uint64_t>(value), 8);
+        }
+        break;
+    case ParquetType::Double:
+        for (const double value : doubles) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            putLittleEndian(out, bits, 8);
+        }
+        break;
+    case ParquetType::String:
+        break;  // Always dictionary encoded
+    }
+}
+
+std::int32_t physicalType(ParquetType type) {
+    switch (type) {
+    case ParquetType::Boolean:
+        return pq::kBoolean;
+    case ParquetType::Int32:
+        return pq::kInt32;
+    case ParquetType::Int64:
+        return pq::kInt64;
+    case ParquetType::Double:
+        return pq::kDouble;
+    case ParquetType::String:
+        return pq::kByteArray;
+    }
+    return pq::kInt64;
+}
+
+std::int32_t dataEncoding(const ParquetColumnSpec& spec) {
+    switch (spec.encoding) {
+    case ParquetEncoding::Delta:
+        return pq::kDeltaBinaryPacked;
+    case ParquetEncoding::Dictionary:
+        return pq::kRleDictionary;
+    default:
+        return pq::kPlain;
+    }
+}
+
+void writePageHeader(std::string& out, std::int32_t pageType, std::size_t bodyBytes, std::size_t numValues,
+                     std::int32_t encoding) {
+    CompactWriter writer(out);
+    writer.i32(1, pageType);
+    writer.i32(2, static_cast<std::int32_t>(bodyBytes));  // Uncompressed
+    writer.i32(3, static_cast<std::int32_t>(bodyBytes));  // Compressed (same - codec UNCOMPRESSED)
+    if (pageType == pq::kDictionaryPage) {
+        writer.beginStruct(7);
+        writer.i32(1, static_cast<std::int32_t>(numValues));
+        writer.i32(2, encoding);
+        writer.endStruct();
+    } else {
+        writer.beginStruct(5);
+        writer.i32(1, static_cast<std::int32_t>(numValues));
+        writer.i32(2, encoding);
+        writer.i32(3, pq::kRle);  // Definition levels (none written - required column)
+        writer.i32(4, pq::kRle);  // Repetition levels (none written - flat schema)
+        writer.endStruct();
+    }
+    writer.stop();
+}
+
+} // namespace
+
+// ========== ParquetColumn ==========
+
+void ParquetColumn::append(std::string_view value) {
+    if (m_lastIndex < m_dictionary.size() && m_dictionary[m_lastIndex] == value) {
+        m_ints.push_back(m_lastIndex);
+        return;
+    }
+    const auto [it, inserted] = m_lookup.emplace(std::string(value), static_cast<std::uint32_t>(m_dictionary.size()));
+    if (inserted) {
+        m_dictionary.emplace_back(value);
+    }
+    m_lastIndex = it->second;
+    m_ints.push_back(m_lastIndex);
+}
+
+std::size_t ParquetColumn::size() const {
+    return m_spec.type == ParquetType::Double ? m_doubles.size() : m_ints.size();
+}
+
+void ParquetColumn::clear() {
+    m_ints.clear();
+    m_doubles.clear();
+    m_dictionary.clear();
+    m_lookup.clear();
+    m_lastIndex = 0;
+}
+
+// ========== ParquetWriter ==========
+
+ParquetWriter::ParquetWriter(std::string path, const std::vector<ParquetColumnSpec>& schema)
+    : m_path(std::move(path)) {
+    m_columns.reserve(schema.size());
+    for (const ParquetColumnSpec& spec : schema) {
+        m_columns.emplace_back(spec);
+    }
+}
+
+bool ParquetWriter::flush() {
+    const std::size_t rows = bufferedRows();
+    if (rows == 0) {
+        return !m_failed;
+    }
+    for (const ParquetColumn& column : m_columns) {
+        if (!m_failed && column.size() != rows) {
+            std::cerr << "[PARQUET] " << m_path << ": column " << column.spec().name << " has " << column.size()
+                      << " values, expected " << rows << "\n";
+            m_failed = true;
+        }
+    }
+    if (m_failed) {
+        // BACKPRESSURE: A failed file keeps no rows - memory stays bounded while the export goes on
+        for (ParquetColumn& column : m_columns) {
+            column.clear();
+        }
+        return false;
+    }
+
+    std::string bytes = m_offset == 0 ? pq::kMagic : "";
+    RowGroupMeta group;
+    group.rows = rows;
+    group.offset = m_offset + bytes.size();
+    std::string body;
+    for (ParquetColumn& column : m_columns) {
+        const ParquetColumnSpec& spec = column.spec();
+        ChunkMeta chunk;
+        chunk.numValues = rows;
+        const std::uint64_t start = m_offset + bytes.size();
+
+        body.clear();
+        if (spec.encoding == ParquetEncoding::Dictionary) {
+            for (const std::string& value : column.m_dictionary) {
+                putLittleEndian(body, value.size(), 4);
+                body += value;
+            }
+            chunk.dictionaryOffset = start;
+            writePageHeader(bytes, pq::kDictionaryPage, body.size(), column.m_dictionary.size(), pq::kPlain);
+            bytes += body;
+
+            body.clear();
+            const unsigned width = std::max(1u, bitWidth(column.m_dictionary.size() - 1));
+            body.push_back(static_cast<char>(width));
+            encodeHybrid(body, column.m_ints, width);
+        } else if (spec.encoding == ParquetEncoding::Delta) {
+            encodeDelta(body, column.m_ints);
+        } else {
+            encodePlain(body, spec.type, column.m_ints, column.m_doubles);
+        }
+        if (body.size() > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+            std::cerr << "[PARQUET] " << m_path << ": page over 2 GiB, lower the row group size\n";
+            m_failed = true;
+            for (ParquetColumn& other : m_columns) {
+                other.clear();
+            }
+            return false;
+        }
+        chunk.dataOffset = m_offset + bytes.size();
+        writePageHeader(bytes, pq::kDataPage, body.size(), rows, dataEncoding(spec));
+        bytes += body;
+        chunk.bytes = m_offset + bytes.size() - start;
+
+        // REASON: Integer min / max let readers skip row groups (time range filters)
+        if (spec.type == ParquetType::Int32 || spec.type == ParquetType::Int64) {
+            const auto [min, max] = std::minmax_element(column.m_ints.begin(), column.m_ints.end());
+            chunk.hasStats = true;
+            chunk.min = *min;
+            chunk.max = *max;
+        }
+        group.chunks.push_back(chunk);
+        column.clear();
+    }
+    group.bytes = m_offset + bytes.size() - group.offset;
+    if (!append(bytes)) {
+        return false;
+    }
+    m_rowGroups.push_back(std::move(group));
+    m_rows += rows;
+    return true;
+}
+
+bool ParquetWriter::close(const std::vector<std::pair<std::string, std::string>>& metadata) {
+    if (!flush()) {
+        return false;
+    }
+    std::string footer;
+    CompactWriter writer(footer);
+    writer.i32(1, 2);  // FileMetaData.version
+
+    // Schema: root group, then one required leaf per column
+    writer.beginList(2, CompactWriter::kStruct, m_columns.size() + 1);
+    writer.beginElement();
+    writer.binary(4, "schema");
+    writer.i32(5, static_cast<std::int32_t>(m_columns.size()));
+    writer.endStruct();
+    for (const ParquetColumn& column : m_columns) {
+        const ParquetColumnSpec& spec = column.spec();
+        writer.beginElement();
+        writer.i32(1, physicalType(spec.type));
+        writer.i32(3, pq::kRequired);
+        writer.binary(4, spec.name);
+        if (spec.type == ParquetType::String) {
+            writer.i32(6, pq::kUtf8);
+            writer.beginStruct(10);   // LogicalType
+            writer.beginStruct(1);    // STRING
+            writer.endStruct();
+            writer.endStruct();
+        } else if (spec.timeUnit != ParquetTimeUnit::None) {
+            if (spec.timeUnit == ParquetTimeUnit::Millis) {
+                writer.i32(6, pq::kTimestampMillis);
+            }
+            writer.beginStruct(10);   // LogicalType
+            writer.beginStruct(8);    // TIMESTAMP
+            writer.boolean(1, true);  // isAdjustedToUTC
+            writer.beginStruct(2);    // TimeUnit
+            writer.beginStruct(spec.timeUnit == ParquetTimeUnit::Millis ? 1 : 3);
+            writer.endStruct();
+            writer.endStruct();
+            writer.endStruct();
+            writer.endStruct();
+        }
+        writer.endStruct();
+    }
+    writer.i64(3, static_cast<std::int64_t>(m_rows));
+
+    writer.beginList(4, CompactWriter::kStruct, m_rowGroups.size());
+    for (const RowGroupMeta& group : m_rowGroups) {
+        writer.beginElement();
+        writer.beginList(1, CompactWriter::kStruct, group.chunks.size());
+        for (std::size_t i = 0; i < group.chunks.size(); ++i) {
+            const ChunkMeta& chunk = group.chunks[i];
+            const ParquetColumnSpec& spec = m_columns[i].spec();
+            const std::uint64_t start = chunk.dictionaryOffset != 0 ? chunk.dictionaryOffset : chunk.dataOffset;
+            writer.beginElement();
+            writer.i64(2, static_cast<std::int64_t>(start));
+            writer.beginStruct(3);    // ColumnMetaData
+            writer.i32(1, physicalType(spec.type));
+            if (spec.encoding == ParquetEncoding::Dictionary) {
+                writer.beginList(2, CompactWriter::kI32, 2);
+                writer.element(pq::kPlain);
+                writer.element(pq::kRleDictionary);
+            } else {
+                writer.beginList(2, CompactWriter::kI32, 1);
+                writer.element(dataEncoding(spec));
+            }
+            writer.beginList(3, CompactWriter::kBinary, 1);
+            writer.bytes(spec.name);
+            writer.i32(4, pq::kUncompressed);
+            writer.i64(5, static_cast<std::int64_t>(chunk.numValues));
+            writer.i64(6, static_cast<std::int64_t>(chunk.bytes));
+            writer.i64(7, static_cast<std::int64_t>(chunk.bytes));
+            writer.i64(9, static_cast<std::int64_t>(chunk.dataOffset));
+            if (chunk.dictionaryOffset != 0) {
+                writer.i64(11, static_cast<std::int64_t>(chunk.dictionaryOffset));
+            }
+            if (chunk.hasStats) {
+                const std::size_t width = spec.type == ParquetType::Int32 ? 4 : 8;
+                std::string max;
+                std::string min;
+                putLittleEndian(max, static_cast<std::uint64_t>(chunk.max), width);
+                putLittleEndian(min, static_cast<std::uint64_t>(chunk.min), width);
+                writer.beginStruct(12);  // Statistics
+                writer.i64(3, 0);         // null_count
+                writer.binary(5, max);    // max_value
+                writer.binary(6, min);    // min_value
+                writer.endStruct();
+            }
+            writer.endStruct();
+            writer.endStruct();
+        }
+        writer.i64(2, static_cast<std::int64_t>(group.bytes));
+        writer.i64(3, static_cast<std::int64_t>(group.rows));
+        writer.i64(5, static_cast<std::int64_t>(group.offset));
+        writer.i64(6, static_cast<std::int64_t>(group.bytes));
+        writer.endStruct();
+    }
+
+    if (!metadata.empty()) {
+        writer.beginList(5, CompactWriter::kStruct, metadata.size());
+        for (const auto& [key, value] : metadata) {
+            writer.beginElement();
+            writer.binary(1, key);
+            writer.binary(2, value);
+            writer.endStruct();
+        }
+    }
+    writer.binary(6, "tws-redis-bridge version 0.1.0");
+    writer.stop();
+
+    std::string bytes = m_offset == 0 ? pq::kMagic : "";  // No rows: header magic + footer only
+    bytes += footer;
+    putLittleEndian(bytes, footer.size(), 4);
+    bytes += pq::kMagic;
+    return append(bytes);
+}
+
+bool ParquetWriter::append(const std::string& bytes) {
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (m_offset == 0 ? O_TRUNC : O_APPEND);
+    const int fd = ::open(m_path.c_str(), flags, 0644);
+    if (fd < 0) {
+        std::cerr << "[PARQUET] Cannot open " << m_path << ": " << std::strerror(errno) << "\n";
+        m_failed = true;
+        return false;
+    }
+    std::size_t written = 0;
+    while (written < bytes.size()) {
+        const ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            std::cerr << "[PARQUET] Cannot write " << m_path << ": " << std::strerror(errno) << "\n";
+            ::close(fd);
+            m_failed = true;
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    if (::close(fd) != 0) {
+        std::cerr << "[PARQUET] Cannot close " << m_path << ": " << std::strerror(errno) << "\n";
+        m_failed = true;
+        return false;
+    }
+    m_offset += bytes.size();
+    return true;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,170 @@
+// PartitionMembership.cpp - Membership heartbeats and universe sync implementation
+
+#include "PartitionMembership.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+std::int64_t unixMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+sw::redis::ConnectionOptions connectionOptions(const std::string& uri, const PartitionConfig& config) {
+    sw::redis::ConnectionOptions opts(uri);
+    opts.socket_timeout = config.socketTimeout;
+    opts.connect_timeout = config.socketTimeout;
+    return opts;
+}
+
+// One round trip: the universe writes, the heartbeat, expiry of silent members and the member list (sorted)
+std::vector<std::string> heartbeatRound(sw::redis::Redis& redis, const PartitionConfig& config, const std::string& self,
+                                        const std::vector<UniverseWrite>& writes) {
+    const std::int64_t now = unixMs();
+    auto pipeline = redis.pipeline(false);
+    for (const UniverseWrite& write : writes) {
+        if (write.payload.empty()) {
+            pipeline.command("HDEL", config.universeKey, write.symbol);
+        } else {
+            pipeline.command("HSET", config.universeKey, write.symbol, write.payload);
+        }
+    }
+    pipeline.command("ZADD", config.membersKey, std::to_string(now), self);
+    pipeline.command("ZREMRANGEBYSCORE", config.membersKey, "-inf", "(" + std::to_string(now - config.memberTimeout.count()));
+    pipeline.command("ZRANGE", config.membersKey, "0", "-1");
+    auto replies = pipeline.exec();
+    if (replies.size() != writes.size() + 3) {
+        throw sw::redis::Error("Unexpected membership reply count");
+    }
+    const redisReply& list = replies.get(replies.size() - 1);
+    if (list.type != REDIS_REPLY_ARRAY) {
+        throw sw::redis::Error("Unexpected ZRANGE reply");
+    }
+    std::vector<std::string> members;
+    for (std::size_t i = 0; i < list.elements; ++i) {
+        members.emplace_back(list.element[i]->str, list.element[i]->len);
+    }
+    // REASON: ZRANGE orders by heartbeat time - every instance must see the same list to agree on owners
+    std::sort(members.begin(), members.end());
+    if (!std::binary_search(members.begin(), members.end(), self)) {
+        members.insert(std::upper_bound(members.begin(), members.end(), self), self);  // NOTE: Expired by a skewed clock
+    }
+    return members;
+}
+
+// TWS:UNIVERSE: symbol -> the TWS:COMMANDS payload that subscribed it
+std::vector<UniverseEntry> readUniverse(sw::redis::Redis& redis, const PartitionConfig& config) {
+    sw::redis::ReplyUPtr reply = redis.command("HGETALL", config.universeKey);
+    std::vector<UniverseEntry> entries;
+    if (!reply || reply->type != REDIS_REPLY_ARRAY) {
+        return entries;
+    }
+    for (std::size_t i = 0; i + 1 < reply->elements; i += 2) {
+        UniverseEntry entry;
+        entry.payload.assign(reply->element[i + 1]->str, reply->element[i + 1]->len);
+        std::string error;
+        if (parseSubscriptionCommand(entry.payload, entry.command, error)
+            && entry.command.action == CommandAction::Subscribe) {
+            entries.push_back(std::move(entry));
+        }
+    }
+    return entries;
+}
+
+} // namespace
+
+PartitionMembership::PartitionMembership(const std::string& uri, SymbolPartition& partition, PartitionConfig config)
+    : m_uri(uri)
+    , m_partition(partition)
+    , m_config(std::move(config))
+    , m_members{partition.self()} {
+}
+
+PartitionMembership::~PartitionMembership() {
+    stop();
+}
+
+bool PartitionMembership::join() {
+    try {
+        sw::redis::Redis redis(connectionOptions(m_uri, m_config));
+        std::vector<std::string> members = heartbeatRound(redis, m_config, m_partition.self(), {});
+        m_counters.heartbeats.fetch_add(1, std::memory_order_relaxed);
+        applyMembers(std::move(members), readUniverse(redis, m_config));
+        return true;
+    } catch (const sw::redis::Error& e) {
+        std::cerr << "[PARTITION] Cannot join " << m_config.membersKey << ": " << e.what()
+                  << " (owning every symbol until a heartbeat succeeds)\n";
+        m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+}
+
+void PartitionMembership::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void PartitionMembership::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void PartitionMembership::applyMembers(std::vector<std::string> members, std::vector<UniverseEntry> learned) {
+    if (members == m_members && learned.empty()) {
+        return;
+    }
+    std::cout << "[PARTITION] " << members.size() << " members (was " << m_members.size() << ")\n";
+    m_members = members;
+    const std::size_t moved = m_partition.rebalance(std::move(members), std::move(learned));
+    m_counters.rebalances.fetch_add(1, std::memory_order_relaxed);
+    m_counters.moved.fetch_add(moved, std::memory_order_relaxed);
+    std::cout << "[PARTITION] Owning " << m_partition.owned() << " symbols, " << moved << " moved\n";
+}
+
+void PartitionMembership::run() {
+    nameCurrentThread("tws-partition");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - heartbeats never queue behind a worker's pipeline
+            sw::redis::Redis redis(connectionOptions(m_uri, m_config));
+            while (m_running.load()) {
+                // NOTE: Taken before the round trip - lost with it on a Redis error (the symbol is still
+                // subscribed here, only a later joiner will not learn it)
+                const std::vector<UniverseWrite> writes = m_partition.takeWrites();
+                std::vector<std::string> members = heartbeatRound(redis, m_config, m_partition.self(), writes);
+                m_counters.heartbeats.fetch_add(1, std::memory_order_relaxed);
+                if (members != m_members) {
+                    applyMembers(std::move(members), readUniverse(redis, m_config));
+                }
+                pause(m_config.heartbeat);
+            }
+            redis.command("ZREM", m_config.membersKey, m_partition.self());
+            std::cout << "[PARTITION] Left " << m_config.membersKey << "\n";
+        } catch (const sw::redis::Error& e) {
+            // NOTE: The last member list stays in force - an outage does not move symbols
+            std::cerr << "[PARTITION] Redis error: " << e.what() << "\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            pause(m_config.heartbeat);
+        }
+    }
+}
+
+} // namespace tws_bridge
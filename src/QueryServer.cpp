@@ -0,0 +1,131 @@
+// QueryServer.cpp - Unix datagram snapshot lookup implementation
+
+#include "QueryServer.h"
+#include "SnapshotEncoder.h"
+#include "ThreadAffinity.h"
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+QueryServer::QueryServer(const InstrumentRegistry& registry, const QuoteTable& quotes, QueryConfig config,
+                         QueryEncoding encoding)
+    : m_registry(registry)
+    , m_quotes(quotes)
+    , m_config(std::move(config))
+    , m_encoding(encoding) {
+}
+
+QueryServer::~QueryServer() {
+    stop();
+}
+
+bool QueryServer::start() {
+    if (m_running.load()) {
+        return true;
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (m_config.socketPath.empty() || m_config.socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "[QUERY] Socket path must be 1-" << sizeof(address.sun_path) - 1 << " bytes\n";
+        return false;
+    }
+    std::memcpy(address.sun_path, m_config.socketPath.c_str(), m_config.socketPath.size());
+    m_fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (m_fd < 0) {
+        std::cerr << "[QUERY] socket() failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    ::unlink(m_config.socketPath.c_str());  // REASON: Left behind by an earlier run
+    if (::bind(m_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "[QUERY] Cannot bind " << m_config.socketPath << ": " << std::strerror(errno) << "\n";
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    m_running.store(true);
+    m_thread = std::thread([this]() { run(); });
+    std::cout << "[QUERY] Snapshot lookups on " << m_config.socketPath << "\n";
+    return true;
+}
+
+void QueryServer::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+        ::unlink(m_config.socketPath.c_str());
+    }
+}
+
+const std::string& QueryServer::answer(std::string_view request) {
+    m_counters.requests.fetch_add(1, std::memory_order_relaxed);
+    m_reply.assign(1, '[');
+    std::size_t symbols = 0;
+    while (!request.empty() && symbols < kMaxSymbols) {
+        const std::size_t start = request.find_first_not_of(" ,\t\r\n");
+        if (start == std::string_view::npos) {
+            break;
+        }
+        request.remove_prefix(start);
+        const std::size_t length = std::min(request.find_first_of(" ,\t\r\n"), request.size());
+        const std::string symbol(request.substr(0, length));
+        request.remove_prefix(length);
+        if (symbols++ > 0) {
+            m_reply += ',';
+        }
+        const SlotId slot = m_registry.find(symbol);
+        QuoteRecord record{};
+        if (slot == kInvalidSlot || !m_quotes.read(slot, record)) {
+            m_counters.missed.fetch_add(1, std::memory_order_relaxed);
+            m_reply += "null";
+            continue;
+        }
+        m_state.symbol = m_registry.symbol(slot);
+        m_state.symbolJson = m_registry.symbolJson(slot);
+        m_state.tickerId = m_registry.tickerId(slot);
+        restoreQuoteRecord(record, m_state);
+        encodeSnapshot(m_state, m_json, m_encoding.schema, false, m_encoding.withIsoTime, m_encoding.prices);
+        m_reply.append(m_json.data(), m_json.size());
+        m_counters.found.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_reply += ']';
+    return m_reply;
+}
+
+void QueryServer::run() {
+    nameCurrentThread("tws-query");
+    char request[4096];
+    while (m_running.load()) {
+        // REASON: poll() with a timeout instead of a blocking recv() - stop() never waits on a client
+        pollfd pending{m_fd, POLLIN, 0};
+        if (::poll(&pending, 1, static_cast<int>(m_config.pollTimeout.count())) <= 0) {
+            continue;
+        }
+        sockaddr_un client{};
+        socklen_t clientLength = sizeof(client);
+        const ssize_t received = ::recvfrom(m_fd, request, sizeof(request), MSG_DONTWAIT,
+                                            reinterpret_cast<sockaddr*>(&client), &clientLength);
+        if (received < 0) {
+            continue;
+        }
+        const std::string& reply = answer(std::string_view(request, static_cast<std::size_t>(received)));
+        if (clientLength <= sizeof(sa_family_t)) {
+            continue;  // NOTE: Unbound sender - nowhere to reply to
+        }
+        // REASON: Non-blocking - a client that stopped reading loses its reply, the next lookup is not delayed
+        ::sendto(m_fd, reply.data(), reply.size(), MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&client), clientLength);
+    }
+}
+
+} // namespace tws_bridge
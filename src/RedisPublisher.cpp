@@ -1,83 +1,687 @@
 // RedisPublisher.cpp - Redis Pub/Sub adapter implementation
 
 #include "RedisPublisher.h"
+#include "AsyncLogger.h"
+#include "MemoryBudget.h"
+#include "ProfilerSignal.h"
+#include "Tracepoints.h"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
 
 namespace tws_bridge {
 
-RedisPublisher::RedisPublisher(const std::string& uri)
-    : m_uri(uri) {
+namespace {
+
+// REASON: redis++ StringView is its own class before C++17 builds of the library - (data, size) works for both
+sw::redis::StringView view(std::string_view bytes) {
+    return sw::redis::StringView(bytes.data(), bytes.size());
+}
+
+} // namespace
+
+RedisPublisher::RedisPublisher(const std::string& uri, BatchPolicy policy, StreamPolicy streamPolicy,
+                               IoThreadPolicy ioPolicy, OutagePolicy outagePolicy, RedisConnectionPolicy connection)
+    : m_uri(uri)
+    , m_endpoint(parseRedisUri(uri))
+    , m_connection(connection)
+    , m_policy(policy)
+    , m_streamPolicy(streamPolicy)
+    , m_breaker(outagePolicy.breaker)
+    , m_spill(outagePolicy.spillCapacity)
+    , m_spillBudget(outagePolicy.spillBudget)
+    , m_ioPolicy(ioPolicy)
+    , m_readyBatches(ioPolicy.maxInFlightBatches)
+    , m_freeBatches(ioPolicy.maxInFlightBatches)
+    , m_ioWaiter(WaitConfig{WaitMode::Blocking, 0, 0, std::chrono::microseconds(1000)}) {
+    // REASON: Pre-size pending slots; their bytes go to the batch arena (no per-message strings)
+    m_pending.resize(m_policy.maxMessages > 0 ? m_policy.maxMessages : 1);
+    m_arena = std::make_unique<BatchArena>();
+    m_replay.reserve(m_pending.size());
+
     try {
-        // REASON: redis-plus-plus automatically manages connection pool
-        sw::redis::ConnectionOptions opts;
-        opts.host = "127.0.0.1";
-        opts.port = 6379;
-        opts.socket_timeout = std::chrono::milliseconds(100);
-        
-        // REASON: Connection pool with 3 connections for thread-safety
-        sw::redis::ConnectionPoolOptions pool_opts;
-        pool_opts.size = 3;
-        pool_opts.wait_timeout = std::chrono::milliseconds(100);
-        
-        m_redis = std::make_unique<sw::redis::Redis>(opts, pool_opts);
-        
-        // REASON: Test connection with PING
-        m_redis->ping();
-        
+        connect();
     } catch (const std::exception& e) {
         std::cerr << "[REDIS] Connection failed: " << e.what() << "\n";
         throw;
     }
+    
+    if (m_ioPolicy.enabled && m_ioPolicy.maxInFlightBatches > 0) {
+        // REASON: All batch buffers allocated up front, steady state only recycles them
+        for (std::size_t i = 0; i < m_ioPolicy.maxInFlightBatches; ++i) {
+            auto batch = std::make_unique<Batch>();
+            batch->messages.resize(m_pending.size());
+            batch->arena = std::make_unique<BatchArena>();
+            m_freeBatches.enqueue(batch.get());
+            m_batches.push_back(std::move(batch));
+        }
+        m_ioRunning.store(true, std::memory_order_release);
+        m_ioThread = std::thread([this]() { ioLoop(); });
+    }
 }
 
 RedisPublisher::~RedisPublisher() {
+    // REASON: Don't lose buffered messages on shutdown (flush never throws)
+    flush();
+    if (m_ioThread.joinable()) {
+        // REASON: I/O thread drains every queued batch before exiting
+        m_ioRunning.store(false, std::memory_order_release);
+        m_ioWaiter.notify();
+        m_ioThread.join();
+    }
     std::cout << "[REDIS] Disconnecting...\n";
 }
 
-void RedisPublisher::publish(const std::string& channel, const std::string& message) {
+PublishStatus RedisPublisher::publish(const std::string& channel, const std::string& message) {
+    // PERFORMANCE: Fail fast during an outage (state is an atomic, readable from any thread)
+    if (m_breaker.state() == CircuitState::Open) {
+        return PublishStatus::CircuitOpen;
+    }
     try {
         // PERFORMANCE: PUBLISH is O(N+M) where N=subscribers, M=channels
         // For single channel with few subscribers, this is ~100μs
-        long long subscribers = m_redis->publish(channel, message);
-        
-        // PERFORMANCE: Reduce logging in production
-        if (subscribers == 0) {
-            // PITFALL: No subscribers is not an error (Redis doesn't buffer)
-            // std::cout << "[REDIS] No subscribers for channel: " << channel << "\n";
+        // PITFALL: No subscribers (0) is not an error (Redis doesn't buffer)
+        if (m_cluster && m_connection.shardedPubSub) {
+            m_cluster->command("SPUBLISH", channel, message);  // REASON: Routed by its first argument (the channel)
+        } else if (m_cluster) {
+            m_cluster->publish(channel, message);
+        } else if (m_connection.shardedPubSub) {
+            m_redis->command("SPUBLISH", channel, message);
+        } else {
+            m_redis->publish(channel, message);
         }
+        return PublishStatus::Ok;
     } catch (const std::exception& e) {
-        std::cerr << "[REDIS] Publish error: " << e.what() << "\n";
-        throw;
+        m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[REDIS] Publish error: {}", e.what());
+        return PublishStatus::Failed;
+    }
+}
+
+PublishStatus RedisPublisher::publishBatch(const PublishMessage* messages, std::size_t count) {
+    if (count == 0 && m_spill.empty()) {
+        return PublishStatus::Ok;
+    }
+    const CircuitBreaker::Clock::time_point now = CircuitBreaker::Clock::now();
+    // PERFORMANCE: Open circuit - no socket timeout, no exception, no log line per batch
+    if (!m_breaker.allow(now)) {
+        spill(messages, count);
+        return PublishStatus::CircuitOpen;
+    }
+    if (m_breaker.state() == CircuitState::HalfOpen) {
+        // REASON: A PING decides, not a full batch (it would time out and count as failed messages)
+        if (!probe()) {
+            if (m_breaker.recordFailure(now)) {
+                m_counters.circuitOpens.fetch_add(1, std::memory_order_relaxed);
+            }
+            spill(messages, count);
+            return PublishStatus::CircuitOpen;
+        }
+        m_breaker.recordSuccess();
+        std::cout << "[REDIS] Redis reachable again, circuit closed (" << m_spill.size() << " spilled messages to replay)\n";
+    }
+    // REASON: Parked messages go first - per-channel order holds across the outage
+    if (!replaySpill()) {
+        spill(messages, count);
+        return PublishStatus::Failed;
+    }
+    if (count == 0) {
+        return PublishStatus::Ok;
+    }
+    const PublishStatus status = sendCounted(messages, count);
+    if (status == PublishStatus::Ok) {
+        m_breaker.recordSuccess();
+    } else if (m_breaker.recordFailure(now)) {
+        m_counters.circuitOpens.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "[REDIS] " << m_breaker.consecutiveFailures() << " failed pipelines, circuit open - spilling\n";
+    }
+    return status;
+}
+
+PublishStatus RedisPublisher::sendPipeline(const PublishMessage* messages, std::size_t count) {
+    try {
+        if (m_cluster) {
+            sendCluster(messages, count);
+            return PublishStatus::Ok;
+        }
+        if (m_resp) {
+            // PERFORMANCE: Whole batch encoded into one buffer, one send(), replies skimmed in bulk
+            m_resp->send(messages, count);
+            return PublishStatus::Ok;
+        }
+        // PERFORMANCE: One round trip for the whole batch instead of one per message
+        sw::redis::Pipeline& pipe = pipeline();
+        if (m_functionPending && loadFunction(pipe)) {
+            m_functionReady = true;
+        }
+        if (!m_functionReady) {
+            for (std::size_t i = 0; i < count; ++i) {
+                appendCommand(pipe, messages[i]);
+            }
+            pipe.exec();
+            return PublishStatus::Ok;
+        }
+        appendBatch(pipe, messages, count);
+        auto replies = pipe.exec();
+        for (std::size_t index : m_functionReplies) {
+            try {
+                replies.get(index);  // NOTE: Throws on an error reply - plain pipelined commands are not checked
+            } catch (const sw::redis::ReplyError& e) {
+                if (std::string_view(e.what()).find("not found") == std::string_view::npos) {
+                    throw;
+                }
+                // REASON: Redis restarted without the library (no persistence) - the FCALLs did nothing, the
+                // plain commands between them ran: resend the fusable messages only, reload before the next batch
+                BRIDGE_LOG_EVERY_MS(10000, LogLevel::Warn, "[REDIS] Function library missing, reloading");
+                m_functionReady = false;
+                m_functionPending = true;
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (FunctionBatch::fusable(messages[i])) {
+                        appendCommand(pipe, messages[i]);
+                    }
+                }
+                pipe.exec();
+                return PublishStatus::Ok;
+            }
+        }
+        return PublishStatus::Ok;
+    } catch (const std::exception& e) {
+        // PITFALL: Pipeline connection is broken after an error, rebuild on next batch
+        m_pipeline.reset();
+        for (auto& pipe : m_nodePipelines) {
+            pipe.reset();
+        }
+        // REASON: MOVED / ASK / a failed node all mean the slot map may be out of date
+        m_slotsStale = m_cluster != nullptr;
+        // REASON: Rate-limited and async - an outage must not turn into a stderr flood on this thread
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[REDIS] Batch publish error ({} messages): {}", count, e.what());
+        return PublishStatus::Failed;
+    }
+}
+
+// Fusable runs as one FCALL each, everything else as its own commands - batch order is kept
+void RedisPublisher::appendBatch(sw::redis::Pipeline& pipe, const PublishMessage* messages, std::size_t count) {
+    m_functionReplies.clear();
+    std::size_t replies = 0;
+    std::size_t i = 0;
+    while (i < count) {
+        if (!FunctionBatch::fusable(messages[i])) {
+            replies += appendCommand(pipe, messages[i]);
+            ++i;
+            continue;
+        }
+        std::size_t end = i + 1;
+        while (end < count && FunctionBatch::fusable(messages[end])) {
+            ++end;
+        }
+        const std::vector<std::string_view>& args = m_function.build(messages + i, end - i, m_streamPolicy.maxLen,
+                                                                     m_streamPolicy.approximate);
+        m_commandArgs.clear();
+        for (std::string_view arg : args) {
+            m_commandArgs.push_back(view(arg));
+        }
+        pipe.command(m_commandArgs.begin(), m_commandArgs.end());
+        m_functionReplies.push_back(replies++);
+        m_counters.functionCalls.fetch_add(1, std::memory_order_relaxed);
+        i = end;
     }
 }
 
-bool RedisPublisher::isConnected() const {
+// FUNCTION LOAD REPLACE in its own round trip; false (plain commands from now on) if Redis refuses it
+// NOTE: A connection error propagates - the batch fails as usual and the load is retried with the next one
+bool RedisPublisher::loadFunction(sw::redis::Pipeline& pipe) {
+    pipe.command("FUNCTION", "LOAD", "REPLACE", sw::redis::StringView(kBridgeFunctionLibrary));
+    auto replies = pipe.exec();
+    m_functionPending = false;
     try {
-        // REASON: PING is a lightweight health check
-        m_redis->ping();
+        replies.get(0);
+    } catch (const sw::redis::ReplyError& e) {
+        // REASON: Redis < 7 (no FUNCTION) or an ACL without it - the bridge still works, one command per write
+        std::cerr << "[REDIS] FUNCTION LOAD refused (" << e.what() << "), function batches off\n";
+        return false;
+    }
+    m_counters.functionLoads.fetch_add(1, std::memory_order_relaxed);
+    std::cout << "[REDIS] Function library loaded, batches sent as FCALL " << kBridgeFunctionName << "\n";
+    return true;
+}
+
+std::size_t RedisPublisher::appendCommand(sw::redis::Pipeline& pipe, const PublishMessage& message) {
+    if (message.command == RedisCommand::StreamAdd) {
+        // REASON: Single "data" field carries the serialized snapshot
+        const std::pair<sw::redis::StringView, sw::redis::StringView> field{"data", view(message.payload)};
+        pipe.xadd(view(message.channel), "*", &field, &field + 1,
+                  m_streamPolicy.maxLen, m_streamPolicy.approximate);
+    } else if (message.command == RedisCommand::Set) {
+        pipe.set(view(message.channel), view(message.payload));
+    } else if (message.command == RedisCommand::SortedSetAdd) {
+        pipe.zremrangebyscore(view(message.channel), sw::redis::BoundedInterval<double>(
+                                  message.score, message.score, sw::redis::BoundType::CLOSED));
+        pipe.zadd(view(message.channel), view(message.payload), message.score);
+        return 2;
+    } else if (message.command == RedisCommand::HashSet) {
+        m_hashFields.clear();
+        sw::redis::StringView field;
+        const std::size_t parts = forEachHashPart(message.payload, [&](std::string_view part) {
+            if (field.data() == nullptr) {
+                field = view(part);
+            } else {
+                m_hashFields.emplace_back(field, view(part));
+                field = sw::redis::StringView();
+            }
+        });
+        if (parts < 2) {
+            return 0;
+        }
+        pipe.hset(view(message.channel), m_hashFields.begin(), m_hashFields.end());
+    } else if (message.command == RedisCommand::TimeSeriesAdd) {
+        m_commandArgs.assign(1, sw::redis::StringView("TS.MADD"));
+        forEachHashPart(message.payload, [&](std::string_view part) { m_commandArgs.push_back(view(part)); });
+        pipe.command(m_commandArgs.begin(), m_commandArgs.end());
+    } else if (message.command == RedisCommand::ListPush) {
+        // REASON: One LTRIM per LPUSH of a batch's prints - the trim is amortized over every print it pushed
+        m_commandArgs.assign(1, sw::redis::StringView("LPUSH"));
+        m_commandArgs.push_back(view(message.channel));
+        forEachHashPart(message.payload, [&](std::string_view part) { m_commandArgs.push_back(view(part)); });
+        pipe.command(m_commandArgs.begin(), m_commandArgs.end());
+        pipe.ltrim(view(message.channel), 0, static_cast<long long>(message.score) - 1);
+        return 2;
+    } else if (message.command == RedisCommand::SortedSetTrim) {
+        pipe.zremrangebyscore(view(message.channel), sw::redis::RightBoundedInterval<double>(
+                                  message.score, sw::redis::BoundType::RIGHT_OPEN));
+    } else if (m_connection.shardedPubSub) {
+        // PERFORMANCE: Delivered by the channel's shard only, not broadcast over the cluster bus
+        pipe.command("SPUBLISH", view(message.channel), view(message.payload));
+    } else {
+        pipe.publish(view(message.channel), view(message.payload));
+    }
+    return 1;
+}
+
+// One pipeline per owning node, commands in batch order within each (per-key order is kept)
+// NOTE: Nodes are sent back to back on this thread - Pipeline::exec writes and reads in one call; across
+// shards the publishers' own I/O threads already talk to the cluster concurrently
+void RedisPublisher::sendCluster(const PublishMessage* messages, std::size_t count) {
+    if (m_slotsStale) {
+        refreshSlots();
+    }
+    m_messageNodes.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint16_t node = m_slots.nodeOf(messages[i].channel);
+        // REASON: Unassigned slot (resharding) - any node answers MOVED, which triggers a refresh
+        m_messageNodes[i] = node == ClusterSlotMap::kNoNode ? 0 : node;
+    }
+    for (std::uint16_t node = 0; node < m_slots.nodeCount(); ++node) {
+        sw::redis::Pipeline* pipe = nullptr;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (m_messageNodes[i] == node) {
+                if (!pipe) {
+                    pipe = &nodePipeline(node);
+                }
+                appendCommand(*pipe, messages[i]);
+            }
+        }
+        if (pipe) {
+            pipe->exec();
+        }
+    }
+}
+
+sw::redis::Pipeline& RedisPublisher::nodePipeline(std::uint16_t node) {
+    std::unique_ptr<sw::redis::Pipeline>& pipe = m_nodePipelines[node];
+    if (!pipe) {
+        // REASON: Routed by a hash tag of a slot the node owns, connection kept like m_pipeline
+        ProfilerSignalBlock noSigprof;  // REASON: May connect - hiredis' connect poll fails on EINTR
+        pipe = std::make_unique<sw::redis::Pipeline>(m_cluster->pipeline(m_nodeTags[node], false));
+    }
+    return *pipe;
+}
+
+// Rebuilds slot → node from CLUSTER SLOTS (startup, and before the first batch after an error)
+void RedisPublisher::refreshSlots() {
+    m_nodePipelines.clear();  // REASON: Return every node connection before borrowing one for the query
+    ProfilerSignalBlock noSigprof;  // REASON: May connect - hiredis' connect poll fails on EINTR
+    sw::redis::Redis node = m_cluster->redis(m_nodeTags.empty() ? "0" : m_nodeTags.front(), false);
+    sw::redis::ReplyUPtr reply = node.command("CLUSTER", "SLOTS");
+    ClusterSlotMap slots;
+    for (std::size_t i = 0; reply && reply->type == REDIS_REPLY_ARRAY && i < reply->elements; ++i) {
+        // [first, last, [host, port, id], replicas...]
+        const redisReply* range = reply->element[i];
+        if (range->type != REDIS_REPLY_ARRAY || range->elements < 3 || range->element[2]->type != REDIS_REPLY_ARRAY
+            || range->element[2]->elements < 2) {
+            continue;
+        }
+        const redisReply* master = range->element[2];
+        const std::string endpoint = std::string(master->element[0]->str, master->element[0]->len) + ":"
+                                     + std::to_string(master->element[1]->integer);
+        slots.assign(static_cast<std::uint16_t>(range->element[0]->integer),
+                     static_cast<std::uint16_t>(range->element[1]->integer), endpoint);
+    }
+    if (slots.nodeCount() == 0) {
+        throw std::runtime_error("CLUSTER SLOTS returned no masters (not a cluster?)");
+    }
+    m_slots = std::move(slots);
+    m_nodeTags.clear();
+    for (std::size_t i = 0; i < m_slots.nodeCount(); ++i) {
+        m_nodeTags.push_back(clusterTagForSlot(m_slots.firstSlot(i)));
+    }
+    m_nodePipelines.resize(m_slots.nodeCount());
+    m_slotsStale = false;
+    m_counters.slotRefreshes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RedisPublisher::spill(const PublishMessage* messages, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (m_spill.push(messages[i])) {
+            m_counters.evicted.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    m_counters.spilled.fetch_add(count, std::memory_order_relaxed);
+    // BACKPRESSURE: Large payloads can breach the byte budget long before the slot count - oldest go first
+    if (overBudget(m_spill.bytes(), m_spillBudget)) {
+        const std::size_t evicted = m_spill.trim(m_spillBudget);
+        m_counters.evicted.fetch_add(evicted, std::memory_order_relaxed);
+        m_counters.overBudget.fetch_add(evicted, std::memory_order_relaxed);
+    }
+    m_counters.spillBytes.store(m_spill.bytes(), std::memory_order_relaxed);
+}
+
+bool RedisPublisher::replaySpill() {
+    // PERFORMANCE: Same pipeline size as live batches, the ring drains at full pipeline speed
+    const std::size_t chunk = m_pending.size();
+    while (!m_spill.empty()) {
+        const std::size_t count = std::min(m_spill.size(), chunk);
+        m_replay.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            m_replay.push_back(m_spill.at(i));
+        }
+        if (sendCounted(m_replay.data(), count) != PublishStatus::Ok) {
+            // REASON: Chunk stays parked (retried after the next probe)
+            if (m_breaker.recordFailure(CircuitBreaker::Clock::now())) {
+                m_counters.circuitOpens.fetch_add(1, std::memory_order_relaxed);
+            }
+            return false;
+        }
+        m_spill.pop(count);
+        m_counters.replayed.fetch_add(count, std::memory_order_relaxed);
+        m_counters.spillBytes.store(m_spill.bytes(), std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool RedisPublisher::probe() {
+    try {
+        if (m_cluster) {
+            refreshSlots();  // REASON: Reaches a node and picks up a failover that happened during the outage
+        } else {
+            ProfilerSignalBlock noSigprof;  // REASON: Reconnects a broken pooled connection
+            m_redis->ping();
+        }
         return true;
-    } catch (...) {
+    } catch (const std::exception&) {
         return false;
     }
 }
 
+PublishMessage& RedisPublisher::nextPending() {
+    if (m_pendingCount == 0) {
+        m_oldestPending = std::chrono::steady_clock::now();
+    }
+    if (m_pendingCount == m_pending.size()) {
+        m_pending.emplace_back();
+    }
+    return m_pending[m_pendingCount++];
+}
+
+void RedisPublisher::enqueuePending(RedisCommand command, const std::string& channel,
+                                    const char* data, std::size_t length, double score) {
+    // PERFORMANCE: Bump copies into the batch arena (no allocation once its block fits a batch)
+    PublishMessage& slot = nextPending();
+    slot.channel = m_arena->copy(channel.data(), channel.size());
+    slot.payload = m_arena->copy(data, length);
+    slot.command = command;
+    slot.score = score;
+    
+    if (m_pendingCount >= m_policy.maxMessages) {
+        flush();
+    }
+}
+
+void RedisPublisher::enqueueShared(RedisCommand command, const std::string& channel, const SharedPayload& payload) {
+    PublishMessage& slot = nextPending();
+    slot.channel = m_arena->copy(channel.data(), channel.size());
+    slot.payload = m_arena->reference(payload);  // REASON: No copy - the arena holds the block until the batch is sent
+    slot.command = command;
+    slot.score = 0.0;
+    
+    if (m_pendingCount >= m_policy.maxMessages) {
+        flush();
+    }
+}
+
+std::size_t RedisPublisher::flushIfDue() {
+    if (m_pendingCount == 0) {
+        if (!m_ioThread.joinable() && !m_spill.empty()) {
+            publishBatch(nullptr, 0);  // REASON: Quiet market - spilled messages still go out once Redis is back
+        }
+        return 0;
+    }
+    if (std::chrono::steady_clock::now() - m_oldestPending < m_policy.maxDelay) {
+        return 0;
+    }
+    return flush();
+}
+
+std::size_t RedisPublisher::flush() {
+    // REASON: Reset count before sending - a failed batch is dropped, not retried in a loop
+    std::size_t count = m_pendingCount;
+    m_pendingCount = 0;
+    const std::int64_t ingestNs = m_pendingIngestNs;
+    m_pendingIngestNs = 0;
+    if (count == 0) {
+        return 0;
+    }
+    if (m_ioThread.joinable()) {
+        return handOff(count, ingestNs);
+    }
+    const std::int64_t handOffNs = ingestNs != 0 ? latencyNowNs() : 0;
+    // REASON: Arena released even when the pipeline throws (the batch is dropped either way)
+    struct ArenaReset {
+        BatchArena& arena;
+        ~ArenaReset() { arena.reset(); }
+    } release{*m_arena};
+    if (publishBatch(m_pending.data(), count) != PublishStatus::Ok) {
+        return 0;
+    }
+    recordLatency(ingestNs, handOffNs);
+    return count;
+}
+
+bool RedisPublisher::drain(std::chrono::steady_clock::time_point deadline) {
+    if (!m_ioThread.joinable()) {
+        flush();  // REASON: Synchronous - sent (or spilled) when it returns
+        return true;
+    }
+    // REASON: flush() drops on a full backlog - during shutdown there is time to wait for a free batch
+    while (m_pendingCount > 0 && m_freeBatches.size_approx() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    flush();
+    while (inFlightBatches() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return inFlightBatches() == 0;
+}
+
+void RedisPublisher::recordLatency(std::int64_t ingestNs, std::int64_t handOffNs) {
+    if (ingestNs == 0) {
+        return;
+    }
+    const std::int64_t nowNs = latencyNowNs();
+    m_latency.publish.record(nowNs - handOffNs);
+    m_latency.endToEnd.record(nowNs - ingestNs);
+}
+
+PublishStatus RedisPublisher::sendCounted(const PublishMessage* messages, std::size_t count) {
+    // PERFORMANCE: Two clock reads per round trip, not per message
+    const auto start = std::chrono::steady_clock::now();
+    const PublishStatus status = sendPipeline(messages, count);
+    const std::int64_t roundTripNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    m_lastRoundTripNs.store(roundTripNs, std::memory_order_relaxed);
+    m_latency.roundTrip.record(roundTripNs);
+    BRIDGE_TRACE3(publish_done, count, static_cast<int>(status), roundTripNs);
+    if (status == PublishStatus::Ok) {
+        m_counters.sent.fetch_add(count, std::memory_order_relaxed);
+    } else {
+        m_counters.failed.fetch_add(count, std::memory_order_relaxed);
+        m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+    }
+    return status;
+}
+
+std::size_t RedisPublisher::handOff(std::size_t count, std::int64_t ingestNs) {
+    Batch* batch = nullptr;
+    if (!m_freeBatches.try_dequeue(batch)) {
+        // BACKPRESSURE: I/O thread is behind (Redis stall) - drop instead of blocking aggregation
+        m_counters.dropped.fetch_add(count, std::memory_order_relaxed);
+        m_arena->reset();
+        return 0;
+    }
+    
+    // PERFORMANCE: Swap slot vectors and arenas (no copy), worker keeps filling the recycled ones
+    batch->messages.swap(m_pending);
+    batch->arena.swap(m_arena);
+    batch->count = count;
+    batch->ingestNs = ingestNs;
+    batch->handOffNs = ingestNs != 0 ? latencyNowNs() : 0;
+    if (m_pending.size() < batch->messages.size()) {
+        m_pending.resize(batch->messages.size());
+    }
+    m_readyBatches.enqueue(batch);
+    m_ioWaiter.notify();
+    return count;
+}
+
+void RedisPublisher::ioLoop() {
+    configureCurrentThread("tws-redis-io", m_ioPolicy.thread);
+    profileCurrentThread();  // NOTE: Pipelines connect under a ProfilerSignalBlock, hiredis retries EINTR otherwise
+    std::cout << "[REDIS] I/O thread started (max " << m_ioPolicy.maxInFlightBatches << " batches in flight)\n";
+    
+    Batch* batch = nullptr;
+    while (true) {
+        if (m_readyBatches.try_dequeue(batch)) {
+            m_ioWaiter.reset();
+            // NOTE: Failures are logged and counted inside; pipeline rebuilds on the next batch
+            if (publishBatch(batch->messages.data(), batch->count) == PublishStatus::Ok) {
+                recordLatency(batch->ingestNs, batch->handOffNs);
+            }
+            batch->arena->reset();  // PERFORMANCE: O(1), before the worker can refill it
+            m_freeBatches.enqueue(batch);
+            continue;
+        }
+        if (!m_ioRunning.load(std::memory_order_acquire)) {
+            break;
+        }
+        if (!m_spill.empty()) {
+            publishBatch(nullptr, 0);  // REASON: No new batch - replay parked messages once Redis is back
+        }
+        m_ioWaiter.idle([this]() {
+            return m_readyBatches.size_approx() > 0 || !m_ioRunning.load(std::memory_order_acquire);
+        });
+    }
+    
+    std::cout << "[REDIS] I/O thread stopped\n";
+}
+
+std::size_t RedisPublisher::inFlightBatches() const {
+    if (m_batches.empty()) {
+        return 0;
+    }
+    std::size_t free = m_freeBatches.size_approx();
+    return free < m_batches.size() ? m_batches.size() - free : 0;
+}
+
+sw::redis::Pipeline& RedisPublisher::pipeline() {
+    if (!m_pipeline) {
+        // REASON: new_connection=false borrows one connection from the pool and keeps it
+        ProfilerSignalBlock noSigprof;  // REASON: May connect - hiredis' connect poll fails on EINTR
+        m_pipeline = std::make_unique<sw::redis::Pipeline>(m_redis->pipeline(false));
+    }
+    return *m_pipeline;
+}
+
+void RedisPublisher::connect() {
+    sw::redis::ConnectionOptions opts;
+    if (m_connection.cluster && m_endpoint.unixSocket) {
+        throw std::invalid_argument("Redis Cluster needs a tcp:// URI (nodes announce TCP endpoints)");
+    }
+    if (m_connection.cluster && m_connection.directResp) {
+        throw std::invalid_argument("Direct RESP batches need a single Redis node (no Cluster redirects)");
+    }
+    if (m_connection.functionBatches && (m_connection.cluster || m_connection.directResp)) {
+        throw std::invalid_argument("Function batches need the pipelined path (no Cluster, no direct RESP)");
+    }
+    if (m_endpoint.unixSocket) {
+        opts.type = sw::redis::ConnectionType::UNIX;
+        opts.path = m_endpoint.path;
+    } else {
+        // NOTE: hiredis sets TCP_NODELAY on every TCP connection - small pipelines are not Nagle-delayed
+        opts.host = m_endpoint.host;
+        opts.port = m_endpoint.port;
+    }
+    opts.password = m_endpoint.password;
+    opts.db = m_endpoint.db;
+    opts.keep_alive = m_connection.keepAlive;
+    opts.connect_timeout = m_connection.connectTimeout;
+    opts.socket_timeout = m_connection.socketTimeout;
+
+    // REASON: Single writer (worker or I/O thread) - the pipeline borrows the one pooled connection and keeps it
+    // PITFALL: publish() from another thread waits up to waitTimeout for it (raise poolSize if that matters)
+    sw::redis::ConnectionPoolOptions poolOpts;
+    poolOpts.size = m_connection.poolSize > 0 ? m_connection.poolSize : 1;
+    poolOpts.wait_timeout = m_connection.waitTimeout;
+
+    if (m_connection.cluster) {
+        // NOTE: Pool options apply per node; the seed node in the URI is only used to discover the others
+        m_cluster = std::make_unique<sw::redis::RedisCluster>(opts, poolOpts);
+        m_nodeTags.clear();
+        refreshSlots();
+        std::cout << "[REDIS] Cluster: " << m_slots.nodeCount() << " masters"
+                  << (m_connection.shardedPubSub ? ", sharded Pub/Sub" : "") << "\n";
+        return;
+    }
+    m_redis = std::make_unique<sw::redis::Redis>(opts, poolOpts);
+    // REASON: Test connection with PING
+    m_redis->ping();
+    // NOTE: Loaded by the sending thread with its first batch (the pipeline holds the pooled connection)
+    m_functionPending = m_connection.functionBatches;
+    m_functionReady = false;
+    if (m_connection.directResp) {
+        // NOTE: A second connection - publish() / probe() / PUBSUB still go through m_redis
+        m_resp = std::make_unique<RespConnection>(m_endpoint, m_connection, m_streamPolicy.maxLen,
+                                                  m_streamPolicy.approximate);
+        m_resp->open();
+        std::cout << "[REDIS] Direct RESP batches enabled\n";
+    }
+}
+
 void RedisPublisher::reconnect() {
     std::cout << "[REDIS] Attempting reconnection...\n";
     
+    // PITFALL: The I/O thread owns m_pipeline, swapping m_redis under it is a data race
+    if (m_ioThread.joinable()) {
+        std::cerr << "[REDIS] Reconnect skipped: I/O thread active (pool reconnects automatically)\n";
+        return;
+    }
+    
+    // REASON: Pipeline holds a connection from the old pool
+    m_pipeline.reset();
+    
     try {
-        sw::redis::ConnectionOptions opts;
-        opts.host = "127.0.0.1";
-        opts.port = 6379;
-        opts.socket_timeout = std::chrono::milliseconds(100);
-        
-        sw::redis::ConnectionPoolOptions pool_opts;
-        pool_opts.size = 3;
-        pool_opts.wait_timeout = std::chrono::milliseconds(100);
-        
-        m_redis = std::make_unique<sw::redis::Redis>(opts, pool_opts);
-        m_redis->ping();
-        
+        connect();
+        m_counters.reconnects.fetch_add(1, std::memory_order_relaxed);
         std::cout << "[REDIS] Reconnection successful\n";
     } catch (const std::exception& e) {
         std::cerr << "[REDIS] Reconnection failed: " << e.what() << "\n";
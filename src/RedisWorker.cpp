@@ -0,0 +1,2379 @@
+// RedisWorker.cpp - Consumer thread implementation
+// Drains the lock-free queue in bulk, aggregates state, publishes one pipeline per batch
+
+#include "RedisWorker.h"
+#include "AllocationTracker.h"
+#include "AsyncLogger.h"
+#include "SnapshotEncoder.h"
+#include "BinaryEncoder.h"
+#include "NumaPlacement.h"
+#include "ProfilerSignal.h"
+#include "TradeCodes.h"
+#include "Tracepoints.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+// Shard queue element array, for NUMA migration
+std::pair<const void*, std::size_t> queueStorage(const SpscTickQueue& queue) {
+    return {queue.storage(), queue.storageBytes()};
+}
+
+// REASON: moodycamel owns a list of blocks, not one array - left where it was allocated
+std::pair<const void*, std::size_t> queueStorage(const MpmcTickQueue&) {
+    return {nullptr, 0};
+}
+
+// Shard queue page backing (nullptr: moodycamel blocks, always heap pages)
+const HugePageBacking* queueBacking(const SpscTickQueue& queue) {
+    return &queue.backing();
+}
+
+const HugePageBacking* queueBacking(const MpmcTickQueue&) {
+    return nullptr;
+}
+
+void reportBacking(const char* what, std::size_t bytes, const HugePageBacking& backing) {
+    std::cout << ", " << what << " " << bytes / 1024 << " KiB on "
+              << (backing.hugetlb ? "hugetlb pages" : backing.transparent ? "THP" : "4 KiB pages");
+    if (backing.prefaulted) {
+        std::cout << " (prefaulted" << (backing.locked ? ", locked)" : ")");
+    }
+}
+
+void reportNode(const char* what, const void* storage, std::size_t bytes, bool moved) {
+    std::cout << ", " << what << " " << bytes / 1024 << " KiB ";
+    const int node = numaNodeOf(storage);
+    if (node >= 0) {
+        std::cout << "on node " << node;
+    } else {
+        std::cout << "on node ?";
+    }
+    if (!moved) {
+        std::cout << " (not migrated)";
+    }
+}
+
+} // namespace
+
+template <typename Queue>
+BasicRedisWorker<Queue>::BasicRedisWorker(BasicShard<Queue>& shard,
+                                          const InstrumentRegistry& registry,
+                                          RedisPublisher& redis,
+                                          WorkerConfig config)
+    : m_shard(shard)
+    , m_queue(shard.queue)
+    , m_registry(registry)
+    , m_redis(redis)
+    , m_waiter(shard.waiter)
+    , m_config(config)
+    , m_batcher(config.adaptive, config.batchSize, redis.batchPolicy().maxMessages) {
+    if (m_config.batchSize == 0) {
+        m_config.batchSize = 1;
+    }
+    if (m_config.adaptive.enabled) {
+        m_config.batchSize = m_batcher.maxBatch();  // REASON: Batch array and histogram sized for the ceiling
+    }
+    m_batchSizeCounts.assign(m_config.batchSize + 1, 0);
+    if (m_config.tapeLength > 0) {
+        m_tape = std::make_unique<TapeBatch>(m_config.tapeLength, m_config.batchSize);
+    }
+    
+    // REASON: One entry per possible slot, allocated up front
+    m_states.resize(m_registry.capacity());
+    m_dirty.reserve(m_registry.capacity());
+    m_books.resize(m_registry.capacity());
+    m_chains.resize(m_registry.capacity());
+    m_depthDirty.reserve(m_registry.capacity());
+    m_depthPending.assign(m_registry.capacity(), 0);
+    m_history.resize(m_registry.capacity());
+    m_backfill.resize(m_registry.capacity());
+    m_barStore.resize(m_registry.capacity());
+    m_liveBars.resize(m_registry.capacity());
+    m_liveBarSlots.reserve(m_registry.capacity());
+    m_barBuilders.resize(m_registry.capacity());
+    m_barBuilderSlots.reserve(m_registry.capacity());
+    if (m_config.delta.enabled) {
+        m_deltas.resize(m_registry.capacity());
+    }
+    if (m_config.writeLastValue && m_config.lastValueFormat == LastValueFormat::Hash) {
+        m_lastValues.resize(m_registry.capacity());
+    }
+    m_tiers.resize(m_config.tiers.size());
+    for (TierState& tier : m_tiers) {
+        tier.sent = SlotColumn(m_registry.capacity());
+        tier.channels.resize(m_registry.capacity());
+    }
+    if (!m_tiers.empty()) {
+        m_publishSeq = SlotColumn(m_registry.capacity());
+    }
+    if (m_config.deadband.enabled) {
+        m_deadbandHeld.reserve(m_registry.capacity());
+    }
+    if (m_config.volumeProfile.enabled) {
+        m_profiles.resize(m_registry.capacity());
+        m_profileDirty.reserve(m_registry.capacity());
+        m_profilePending.assign(m_registry.capacity(), 0);
+    }
+    if (m_config.sessionStats.enabled) {
+        m_sessions.resize(m_registry.capacity());
+        m_sessionDirty.reserve(m_registry.capacity());
+        m_sessionResetMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            m_config.sessionStats.sessionReset).count();
+    }
+    if (m_config.historyChunkBars == 0) {
+        m_config.historyChunkBars = 1;
+    }
+    if (m_config.latency.enabled) {
+        m_latencyPrevious.resize(kLatencyStageCount);
+    }
+    if (m_config.lag.enabled || m_config.flight.enabled) {
+        m_config.trackQueueAge = true;  // REASON: Lag levels follow queueAge(), flight records need the dequeue time
+    }
+    if (m_config.flight.enabled) {
+        m_flight = std::make_unique<FlightRecorder>(m_config.flight, m_config.shardId, &m_registry);
+    }
+    if (m_config.aggregate.enabled && m_config.aggregate.encoderThreads > 0) {
+        const ArrayEncoding encoding{m_config.snapshotSchema, m_config.derivedMetrics.enabled, m_config.isoTimestamps,
+                                     m_config.priceFormat, m_config.sendTimestamps, m_config.compression.aggregate,
+                                     m_config.compression.minBytes};
+        m_encoderPool = std::make_unique<EncoderPool>(m_config.aggregate.encoderThreads,
+                                                      m_config.aggregate.encoderBatches, encoding, m_config.shardId);
+    }
+    if (m_config.shm.enabled) {
+        // REASON: One ring per shard - single producer, readers map every shard they want
+        const std::string name = m_config.shm.name + "-" + std::to_string(m_config.shardId);
+        m_shm = ShmRingWriter::create(name, m_config.shm.slots, m_config.shm.slotBytes);
+        if (m_shm) {
+            std::cout << "[WORKER] Shared-memory ring " << name << " (" << m_config.shm.slots << " x "
+                      << m_config.shm.slotBytes << " B)\n";
+        }
+    }
+}
+
+// Moves what this worker touches per update onto the NUMA node it runs on (after pinning, before the first update)
+// PERFORMANCE: No cross-socket loads on the state table / queue (p99 jitter on dual-socket hosts)
+template <typename Queue>
+void BasicRedisWorker<Queue>::placeOnLocalNode() {
+    const int node = currentNumaNode();
+
+    // REASON: First touch - the (still empty) tables are rebuilt by this thread, so their pages fault on
+    // its node; unlike mbind this needs no capability. JSON / binary buffers grow here already.
+    std::vector<StateEntry>(m_states.size()).swap(m_states);
+    std::vector<std::uint8_t>(m_depthPending.size(), 0).swap(m_depthPending);
+    std::vector<DeltaTrack>(m_deltas.size()).swap(m_deltas);
+    std::vector<LastValueTrack>(m_lastValues.size()).swap(m_lastValues);
+    std::vector<TimeSeriesTrack>(m_series.size()).swap(m_series);
+    std::vector<std::unique_ptr<OrderBook>>(m_books.size()).swap(m_books);
+    std::vector<std::unique_ptr<GreeksChain>>(m_chains.size()).swap(m_chains);
+    std::vector<std::vector<TickUpdate>>(m_history.size()).swap(m_history);
+    m_counters.historyBytes.store(0, std::memory_order_relaxed);
+    std::vector<std::vector<TickUpdate>>(m_backfill.size()).swap(m_backfill);
+    std::vector<std::unique_ptr<BarStoreSlot>>(m_barStore.size()).swap(m_barStore);
+    std::vector<std::unique_ptr<LiveBar>>(m_liveBars.size()).swap(m_liveBars);
+    std::vector<std::unique_ptr<BuiltBarSlot>>(m_barBuilders.size()).swap(m_barBuilders);
+    std::vector<std::uint64_t>(m_batchSizeCounts.size(), 0).swap(m_batchSizeCounts);
+    auto rebuildReserved = [](auto& list) {
+        std::remove_reference_t<decltype(list)> local;
+        local.reserve(list.capacity());
+        list.swap(local);
+    };
+    rebuildReserved(m_dirty);
+    rebuildReserved(m_depthDirty);
+    rebuildReserved(m_barBuilderSlots);
+    rebuildReserved(m_liveBarSlots);
+    for (TierState& tier : m_tiers) {
+        tier.sent = SlotColumn(tier.sent.size());
+        std::vector<std::string>(tier.channels.size()).swap(tier.channels);
+    }
+    m_publishSeq = SlotColumn(m_publishSeq.size());
+    if (m_checkpoint || m_quotes) {
+        std::vector<std::uint8_t>(m_checkpointPending.size(), 0).swap(m_checkpointPending);
+        rebuildReserved(m_checkpointDirty);
+    }
+
+    // Shard storage is shared with the producer (allocated by main) - migrated, best effort
+    const auto [queue, queueBytes] = queueStorage(m_queue);
+    const bool queueMoved = queue && migrateToNumaNode(queue, queueBytes, node);
+    const CoalescingTable* coalescing = m_shard.coalescing.get();
+    const bool coalescingMoved = coalescing && migrateToNumaNode(coalescing->storage(), coalescing->storageBytes(), node);
+
+    std::cout << "[NUMA] Worker shard " << m_config.shardId << ": CPU " << sched_getcpu() << ", node " << node
+              << " of " << numaNodeCount();
+    reportNode("state table", m_states.data(), m_states.size() * sizeof(StateEntry), true);
+    if (queue) {
+        reportNode("queue", queue, queueBytes, queueMoved);
+    }
+    if (coalescing) {
+        reportNode("coalescing table", coalescing->storage(), coalescing->storageBytes(), coalescingMoved);
+    }
+    std::cout << "\n";
+}
+
+// State table onto 2 MB pages, prefaulted (the router mapped queue + coalescing table that way already)
+// PERFORMANCE: Fewer TLB misses on the per-update state lookups, no page faults on the day's first ticks
+// NOTE: A std::vector buffer - only its whole 2 MB pages can be collapsed, the ends stay 4 KiB pages
+template <typename Queue>
+void BasicRedisWorker<Queue>::placeOnHugePages() {
+    const std::size_t stateBytes = m_states.size() * sizeof(StateEntry);
+    const HugePageBacking states = adviseHugePages(m_states.data(), stateBytes, m_config.memory.lock);
+    std::cout << "[MEMORY] Worker shard " << m_config.shardId;
+    reportBacking("state table", stateBytes, states);
+    if (const HugePageBacking* queue = queueBacking(m_queue)) {
+        reportBacking("queue", queueStorage(m_queue).second, *queue);
+    }
+    if (const CoalescingTable* coalescing = m_shard.coalescing.get()) {
+        reportBacking("coalescing table", coalescing->storageBytes(), coalescing->backing());
+    }
+    std::cout << "\n";
+    if (m_config.memory.lock && !states.locked) {
+        std::cerr << "[MEMORY] Worker shard " << m_config.shardId
+                  << ": mlock refused (raise ulimit -l / LimitMEMLOCK or grant CAP_IPC_LOCK)\n";
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::addSink(std::shared_ptr<SnapshotSink> sink, SinkPolicy policy) {
+    if (!m_sinks) {
+        m_sinks = std::make_unique<SinkFanout>();
+    }
+    std::cout << "[WORKER] Snapshot sink: " << sink->name() << " (shard " << m_config.shardId << ")\n";
+    m_sinks->add(std::move(sink), policy);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::watchSubscribers(const SubscriberTable& table) {
+    m_watch = &table;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::checkpointTo(StateCheckpoint& checkpoint, const CheckpointImage* restore) {
+    m_checkpoint = &checkpoint;
+    m_restore = restore;
+    m_checkpointPending.assign(m_registry.capacity(), 0);
+    m_checkpointDirty.reserve(m_registry.capacity());
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::serveQuotes(QuoteTable& quotes) {
+    // REASON: Rides on the checkpoint's change tracking - both copy each changed slot once per batch
+    m_quotes = &quotes;
+    m_checkpointPending.assign(m_registry.capacity(), 0);
+    m_checkpointDirty.reserve(m_registry.capacity());
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::run(std::atomic<bool>& running) {
+    const std::string threadName = "tws-worker-" + std::to_string(m_config.shardId);
+    configureCurrentThread(threadName.c_str(), m_config.thread);
+    profileCurrentThread();  // NOTE: Its waits and Redis calls are EINTR-safe (ProfilerSignal.h)
+    start();
+    while (running.load()) {
+        if (!poll()) {
+            // REASON: Spin / yield / park per configured WaitMode (producer wakes us when parked)
+            // NOTE: Arrays in flight keep it from parking - nobody would wake it when they are encoded
+            // NOTE: Reactor mode sleeps until the timer wheel's next deadline (tiers, bar sweeps, stats)
+            m_waiter.idle([this]() {
+                return m_queue.size_approx() > 0 || m_shard.hasOverflow()
+                    || (m_encoderPool && m_encoderPool->inFlight() > 0);
+            }, m_timers.nextDeadline());
+        }
+    }
+    finish();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::start() {
+    m_heartbeat.attach();
+    std::cout << "[WORKER] Redis worker started (shard " << m_config.shardId
+              << ", batch size " << m_config.batchSize << ")\n";
+    if (m_config.numaLocal) {
+        placeOnLocalNode();
+    }
+    if (m_config.memory.enabled) {
+        placeOnHugePages();  // REASON: After the NUMA rebuild - advises the state table this thread will keep
+    }
+    
+    // PERFORMANCE: Fixed-size batch array, allocated once
+    m_batch.resize(m_config.batchSize);
+    m_statsStart = std::chrono::steady_clock::now();
+    m_latencyReportAt = m_statsStart;
+    armTimers();
+    if (m_sinks) {
+        m_sinks->start();
+    }
+    if (m_flight) {
+        m_flight->start();
+    }
+    if (m_encoderPool) {
+        m_encoderPool->start();
+    }
+    if (m_watch) {
+        m_skipUnwatched = m_config.tickOutput == TickOutput::PubSub && !m_config.writeLastValue && !m_shm && !m_sinks
+                       && !m_config.aggregate.enabled && m_tiers.empty() && m_series.empty();
+        if (!m_skipUnwatched) {
+            std::cout << "[WORKER] Subscriber tracking ignored (shard " << m_config.shardId
+                      << "): stream / LVC / shm / sink / aggregate / tier / time series output needs every snapshot\n";
+        }
+    }
+    if (m_config.conflation.enabled && m_config.conflation.reduceBatch) {
+        // REASON: The tick filter's band and a sampled trace both need every quote, not the last one
+        m_reduceQuotes = !m_config.tickFilter.enabled && !m_trace;
+        if (m_reduceQuotes) {
+            m_quoteReducer = QuoteBatchReducer(m_registry.capacity());
+        } else {
+            std::cout << "[WORKER] Batch quote reduction ignored (shard " << m_config.shardId
+                      << "): tick filter / trace export sees every quote\n";
+        }
+    }
+}
+
+template <typename Queue>
+bool BasicRedisWorker<Queue>::poll() {
+    m_heartbeat.beat();
+    applyShedLevel();
+    const std::size_t limit = m_config.adaptive.enabled ? m_batcher.batchLimit() : m_batch.size();
+    const std::size_t count = dequeueBatch(m_batch.data(), limit);
+    
+    if (count > 0) {
+        m_waiter.reset();
+        if (m_migration) {
+            adoptMigrating();  // REASON: Before the batch - it may hold a moved slot's first updates
+        }
+        BRIDGE_TRACE2(worker_dequeue, m_config.shardId, count);
+        recordBatch(count);
+        if (m_config.trackOccupancy) {
+            m_shard.occupancy.sample(count, m_queue.size_approx(), latencyNowNs());
+        }
+        if (m_config.latency.enabled || m_config.trackQueueAge) {
+            recordDequeue(m_batch.data(), count);
+        }
+        
+        // PERFORMANCE: Quotes overwritten later in the batch never reach the state - counted as conflated
+        std::size_t first = 0;
+        if (m_reduceQuotes) {
+            first = m_quoteReducer.reduce(m_batch.data(), count, m_config.conflation.publishTradesIndividually);
+            m_counters.conflated.fetch_add(first, std::memory_order_relaxed);
+        }
+        
+        // REASON: Apply whole batch to state first; payloads are buffered, not sent
+        // NOTE: Guarded in Debug builds - state, books and bars are preallocated per slot
+        {
+            AllocationGuard noAlloc;
+            for (std::size_t i = first; i < count; ++i) {
+                if (m_trace) {
+                    applyTraced(m_batch[i]);
+                } else {
+                    applyUpdate(m_batch[i]);
+                }
+            }
+        }
+        publishDirtyIfDue();
+        publishNewlyWatched();
+        publishAggregateIfDue();
+        collectEncoded();
+        publishDepth();
+        publishTimeSeries();
+        publishTape();
+        runTimers();
+        writeCheckpoint();
+        
+        // PERFORMANCE: Whole batch goes out as one pipelined round trip (adaptive: several batches
+        // share one while a burst is queued)
+        // NOTE: Never throws - during a Redis outage the batch is spilled, not retried here
+        if (!m_config.adaptive.enabled || adaptiveFlushDue()) {
+            m_redis.flush();
+        }
+        commitFlight();
+        commitTrace();
+        if (m_sinks) {
+            m_sinks->commit();
+        }
+        if (m_handoffSlot != kInvalidSlot) {
+            handOffSlot();
+        }
+        return true;
+    }
+    
+    m_queueAgeNs.store(0, std::memory_order_relaxed);  // REASON: Nothing waiting
+    if (m_migration) {
+        adoptMigrating();  // REASON: Ends the move even before the slot's next update
+    }
+    if (m_config.lag.enabled) {
+        checkLag(0);
+    }
+    try {
+        publishDirtyIfDue();
+        publishNewlyWatched();
+        publishAggregateIfDue();
+        collectEncoded();
+        publishTimeSeries();
+        publishTape();
+        runTimers();
+        m_redis.flushIfDue();
+        commitFlight();
+        commitTrace();
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+    if (m_sinks) {
+        m_sinks->commit();  // REASON: Conflation window expiry publishes without a new batch
+    }
+    writeCheckpoint();  // REASON: Quiet bars close without a new batch
+    return false;
+}
+
+template <typename Queue>
+std::chrono::steady_clock::time_point BasicRedisWorker<Queue>::nextDeadline() const {
+    return m_timers.nextDeadline();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::finish() {
+    m_heartbeat.park(true);  // REASON: The drain has its own deadline
+    drainOnShutdown(m_batch);
+    if (m_sinks) {
+        m_sinks->commit();
+        m_sinks->stop();  // REASON: Sinks deliver everything committed, then flush / close
+    }
+    if (m_flight) {
+        m_flight->stop();
+    }
+    if (m_encoderPool) {
+        m_encoderPool->stop();  // REASON: drainOnShutdown published every array
+        const EncoderPoolCounters& counters = m_encoderPool->counters();
+        std::cout << "[WORKER] Encoder pool (shard " << m_config.shardId << "): " << counters.arrays.load()
+                  << " arrays, " << counters.snapshots.load() << " snapshots, " << counters.stalls.load()
+                  << " stalls\n";
+    }
+    
+    std::cout << "[WORKER] Redis worker stopped (shard " << m_config.shardId << ")\n";
+}
+
+// Second shutdown phase: the producers are stopped, everything still queued goes out before the deadline
+// REASON: A planned restart must not lose the ticks between the last batch and the stop
+template <typename Queue>
+void BasicRedisWorker<Queue>::drainOnShutdown(std::vector<TickUpdate>& batch) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + m_config.drainTimeout;
+    std::uint64_t drained = 0;
+    bool complete = true;
+    try {
+        for (;;) {
+            const std::size_t count = dequeueBatch(batch.data(), batch.size());
+            if (count == 0) {
+                break;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                complete = false;
+                break;
+            }
+            if (m_migration) {
+                adoptMigrating();
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                applyUpdate(batch[i]);
+            }
+            drained += count;
+            // NOTE: Conflation window ignored - every slot changed by the batch publishes once
+            publishDirty();
+            publishAggregate();
+            publishDepth();
+            publishTimeSeries();
+            publishTape();
+            if (m_handoffSlot != kInvalidSlot) {
+                handOffSlot();
+            }
+            // BACKPRESSURE: Waits for the I/O thread instead of dropping the batch (bounded by the deadline)
+            complete = m_redis.drain(deadline) && complete;
+        }
+        publishDirty();  // REASON: Don't drop the last partial batch on shutdown
+        publishAggregate();
+        if (m_encoderPool) {
+            // REASON: Every array submitted so far reaches the pipeline before its drain
+            m_encoderPool->drain([this](std::string_view payload) { publishArray(payload); });
+        }
+        for (std::size_t tier = 0; tier < m_tiers.size(); ++tier) {
+            publishTier(tier);  // REASON: Tier consumers see the final state, not the last tick before it
+        }
+        publishDepth();
+        publishChains();
+        publishTimeSeries();
+        publishTape();
+        complete = m_redis.drain(deadline) && complete;
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        complete = false;
+    }
+    writeCheckpoint();
+    std::cout << "[WORKER] Shutdown drain (shard " << m_config.shardId << "): " << drained << " queued updates in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+              << " ms" << (complete ? "\n" : ", deadline hit - rest dropped\n");
+}
+
+template <typename Queue>
+bool BasicRedisWorker<Queue>::bindSlot(StateEntry& entry, SlotId slot) {
+    // REASON: Symbol/tickerId copied once per slot, not per tick
+    InstrumentState& state = entry.state;
+    state.symbol = m_registry.symbol(slot);
+    state.symbolJson = m_registry.symbolJson(slot);
+    state.tickerId = m_registry.tickerId(slot);
+    entry.channels = &m_registry.channels(slot);
+    if (m_config.deadband.enabled) {
+        entry.deadband = m_config.deadband.ruleFor(state.symbol);
+    }
+    state.derived.rolling.setWindow(
+        std::chrono::duration_cast<std::chrono::milliseconds>(m_config.derivedMetrics.rollingWindow).count());
+    const SlotCheckpoint* saved = m_restore ? m_restore->find(state.symbol) : nullptr;
+    if (saved) {
+        restoreSlot(entry, slot, *saved);
+    }
+    return saved != nullptr;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::restoreSlot(StateEntry& entry, SlotId slot, const SlotCheckpoint& saved) {
+    InstrumentState& state = entry.state;
+    state.bidPrice = saved.bidPrice;
+    state.askPrice = saved.askPrice;
+    state.bidSize = saved.bidSize;
+    state.askSize = saved.askSize;
+    state.sizeScale = saved.sizeScale;
+    state.quoteTimestamp = saved.quoteTimestamp;
+    state.hasQuote = saved.hasQuote;
+    state.lastPrice = saved.lastPrice;
+    state.lastSize = saved.lastSize;
+    state.tradeTimestamp = saved.tradeTimestamp;
+    state.hasTrade = saved.hasTrade;
+    state.exchange = exchangeName(saved.exchange);
+    state.tradeConditions = saved.tradeConditions;
+    state.pastLimit = saved.pastLimit;
+    if (m_registry.conId(slot) == 0) {
+        state.conId = saved.conId;
+        state.primaryExchange = exchangeName(saved.primaryExchange);
+    }
+    entry.resolved = state.conId != 0;
+    entry.trades = saved.trades;
+    state.sequence = saved.sequence;
+    if (m_restore->derivedValid) {
+        // REASON: Session VWAP / rolling volume cannot be rebuilt without the session's trades
+        state.derived = saved.derived;
+    }
+    if (m_config.barBuilder.enabled) {
+        BuiltBarSlot& built = builtBars(entry, slot);
+        for (const BarBuilder::FrameState& frame : saved.bars) {
+            built.builder.restoreFrame(frame);  // NOTE: An expired open bar is closed by the next sweep
+        }
+    }
+    markCheckpoint(slot);  // REASON: Carried over even if the slot stays quiet in this run
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::markCheckpoint(SlotId slot) {
+    if ((m_checkpoint || m_quotes) && !m_checkpointPending[slot]) {
+        m_checkpointPending[slot] = 1;
+        m_checkpointDirty.push_back(slot);
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::writeCheckpoint() {
+    // PERFORMANCE: Once per drain batch per changed slot, however many ticks it took
+    for (const SlotId slot : m_checkpointDirty) {
+        m_checkpointPending[slot] = 0;
+        const StateEntry& entry = m_states[slot];
+        const InstrumentState& state = entry.state;
+        if (m_quotes) {
+            m_quotes->write(slot, makeQuoteRecord(state));
+        }
+        if (!m_checkpoint || state.symbol.size() >= SlotCheckpoint::kSymbolBytes) {
+            continue;
+        }
+        const BuiltBarSlot* built = m_barBuilders[slot].get();
+        m_checkpoint->write(slot, [&](SlotCheckpoint& out) {
+            std::memset(out.symbol, 0, sizeof(out.symbol));
+            std::memcpy(out.symbol, state.symbol.data(), state.symbol.size());
+            out.conId = state.conId;
+            out.primaryExchange = exchangeCode(state.primaryExchange);
+            out.exchange = exchangeCode(state.exchange);
+            out.hasQuote = state.hasQuote;
+            out.hasTrade = state.hasTrade;
+            out.pastLimit = state.pastLimit;
+            out.bidPrice = state.bidPrice;
+            out.askPrice = state.askPrice;
+            out.lastPrice = state.lastPrice;
+            out.bidSize = state.bidSize;
+            out.askSize = state.askSize;
+            out.lastSize = state.lastSize;
+            out.sizeScale = state.sizeScale;
+            out.quoteTimestamp = state.quoteTimestamp;
+            out.tradeTimestamp = state.tradeTimestamp;
+            out.tradeConditions = state.tradeConditions;
+            out.trades = entry.trades;
+            out.sequence = state.sequence;
+            out.derived = state.derived;
+            for (std::size_t i = 0; i < BarBuilder::kMaxTimeframes; ++i) {
+                out.bars[i] = built && i < built->builder.timeframes() ? built->builder.frameState(i) : BarBuilder::FrameState{};
+            }
+        });
+    }
+    m_checkpointDirty.clear();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::warmStart(SlotId slot, const InstrumentState& seed) {
+    if (slot >= m_states.size() || slot >= m_registry.size()) {
+        return;
+    }
+    StateEntry& entry = m_states[slot];
+    InstrumentState& state = entry.state;
+    if (!entry.channels && bindSlot(entry, slot)) {
+        return;  // REASON: The shared-memory checkpoint is a superset of the last snapshot
+    }
+    state.bidPrice = seed.bidPrice;
+    state.askPrice = seed.askPrice;
+    state.bidSize = seed.bidSize;
+    state.askSize = seed.askSize;
+    state.sizeScale = seed.sizeScale;
+    state.quoteTimestamp = seed.quoteTimestamp;
+    state.hasQuote = seed.hasQuote;
+    state.lastPrice = seed.lastPrice;
+    state.lastSize = seed.lastSize;
+    state.tradeTimestamp = seed.tradeTimestamp;
+    state.hasTrade = seed.hasTrade;
+    state.exchange = seed.exchange;
+    state.tradeConditions = seed.tradeConditions;
+    state.pastLimit = seed.pastLimit;
+    state.sequence = seed.sequence;
+    // NOTE: A conId already resolved in this run (contract cache) wins over the previous run's
+    if (m_registry.conId(slot) != 0) {
+        state.conId = m_registry.conId(slot);
+        state.primaryExchange = exchangeName(m_registry.primaryExchange(slot));
+    } else {
+        state.conId = seed.conId;
+        state.primaryExchange = seed.primaryExchange;
+    }
+    entry.resolved = state.conId != 0;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::rebalanceWith(SlotMigration& migration, std::vector<BasicRedisWorker*> peers,
+                                            std::chrono::milliseconds handoffTimeout) {
+    m_migration = &migration;
+    m_peers = std::move(peers);
+    m_handoffTimeout = handoffTimeout;
+}
+
+// Old owner: the moving slot's Handoff marker was in the last batch - everything routed here for it is applied
+template <typename Queue>
+void BasicRedisWorker<Queue>::handOffSlot() {
+    const SlotId slot = m_handoffSlot;
+    m_handoffSlot = kInvalidSlot;
+    if (!m_migration || m_migration->generation.load(std::memory_order_acquire) != m_handoffGeneration
+        || m_migration->slot.load(std::memory_order_relaxed) != slot) {
+        return;  // REASON: Stale marker - its move timed out, the new owner already runs the slot
+    }
+    // REASON: Values the slot left in the coalescing table are older than its marker - applied here, the new
+    // owner only ever sees newer ones
+    if (m_shard.coalescing) {
+        TickUpdate update;
+        for (const TickUpdateType type : {TickUpdateType::BidAsk, TickUpdateType::AllLast}) {
+            const std::size_t key = slotCoalescingKey(slot, type);
+            if (key < m_shard.coalescing->keys() && m_shard.coalescing->take(key, update)) {
+                applyUpdate(update);
+            }
+        }
+    }
+    // NOTE: Flushes the whole shard's conflation window / changed books early - once per move
+    publishDirty();
+    publishDepth();
+    for (TierState& tier : m_tiers) {
+        tier.sent[slot] = m_publishSeq[slot];  // REASON: The new owner republishes tiers from the adopted state
+    }
+    m_barBuilderSlots.erase(std::remove(m_barBuilderSlots.begin(), m_barBuilderSlots.end(), slot),
+                            m_barBuilderSlots.end());
+    // REASON: Legs changed before the marker go out from here - the slot stays listed (its table moves, the
+    // entry is skipped while empty), so ChainTimer stays armed exactly once
+    publishChains();
+    writeCheckpoint();
+    // PITFALL: The new owner publishes on its own connection - this worker's last snapshots of the slot go out
+    // first, or subscribers could see them after the new owner's
+    m_redis.drain(std::chrono::steady_clock::now() + m_handoffTimeout / 2);
+    MigrationPhase expected = MigrationPhase::Flipped;
+    m_migration->phase.compare_exchange_strong(expected, MigrationPhase::HandedOff, std::memory_order_acq_rel);
+}
+
+// New owner: a slot moving here is adopted before any of its updates is applied
+// PERFORMANCE: One acquire load per batch while nothing moves
+template <typename Queue>
+void BasicRedisWorker<Queue>::adoptMigrating() {
+    SlotMigration& migration = *m_migration;
+    MigrationPhase phase = migration.phase.load(std::memory_order_acquire);
+    if ((phase != MigrationPhase::Flipped && phase != MigrationPhase::HandedOff)
+        || migration.to.load(std::memory_order_relaxed) != m_config.shardId) {
+        return;
+    }
+    // BACKPRESSURE: Holds this shard until the old owner drained the slot (one batch + one Redis drain)
+    const auto deadline = std::chrono::steady_clock::now() + m_handoffTimeout;
+    while (phase == MigrationPhase::Flipped) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            if (migration.phase.compare_exchange_strong(phase, MigrationPhase::Idle, std::memory_order_acq_rel)) {
+                migration.abandoned.fetch_add(1, std::memory_order_relaxed);
+                BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn,
+                                    "[WORKER] Slot {} handoff timed out (shard {}), continuing from this shard's state",
+                                    migration.slot.load(std::memory_order_relaxed), m_config.shardId);
+                return;
+            }
+            continue;  // NOTE: The failed exchange reloaded phase
+        }
+        m_heartbeat.beat();
+        std::this_thread::yield();
+        phase = migration.phase.load(std::memory_order_acquire);
+    }
+    if (phase != MigrationPhase::HandedOff) {
+        return;  // REASON: The marker did not fit the old shard - nothing was routed here, the move is retried
+    }
+    adoptSlot(*m_peers[migration.from.load(std::memory_order_relaxed)], migration.slot.load(std::memory_order_relaxed));
+    migration.completed.fetch_add(1, std::memory_order_relaxed);
+    migration.phase.store(MigrationPhase::Idle, std::memory_order_release);
+}
+
+// PERFORMANCE: Swapped, never copied - state strings, books, bar builders and history change owner with a few
+// pointer writes
+// NOTE: The old owner keeps this worker's stale entries for the slot, never read unless the slot comes back
+// (then swapped again)
+template <typename Queue>
+void BasicRedisWorker<Queue>::adoptSlot(BasicRedisWorker& source, SlotId slot) {
+    std::swap(m_states[slot], source.m_states[slot]);
+    if (!m_deltas.empty()) {
+        std::swap(m_deltas[slot], source.m_deltas[slot]);
+    }
+    if (!m_lastValues.empty()) {
+        std::swap(m_lastValues[slot], source.m_lastValues[slot]);
+    }
+    if (!m_series.empty()) {
+        std::swap(m_series[slot], source.m_series[slot]);
+    }
+    m_books[slot].swap(source.m_books[slot]);
+    m_chains[slot].swap(source.m_chains[slot]);
+    if (m_chains[slot]) {
+        trackChain(slot);
+    }
+    m_history[slot].swap(source.m_history[slot]);
+    // NOTE: Atomics - the buffer's bytes move with it between the two workers' gauges
+    const auto moved = static_cast<std::int64_t>(m_history[slot].capacity() * sizeof(TickUpdate));
+    m_counters.historyBytes.fetch_add(moved, std::memory_order_relaxed);
+    source.m_counters.historyBytes.fetch_sub(moved, std::memory_order_relaxed);
+    m_backfill[slot].swap(source.m_backfill[slot]);
+    m_barStore[slot].swap(source.m_barStore[slot]);
+    m_liveBars[slot].swap(source.m_liveBars[slot]);
+    if (m_liveBars[slot]) {
+        trackLiveBar(slot);  // NOTE: A pending revision goes out on this worker's next LiveBarTimer
+    }
+    m_barBuilders[slot].swap(source.m_barBuilders[slot]);
+    if (m_barBuilders[slot]) {
+        m_barBuilderSlots.push_back(slot);
+    }
+    if (m_movers && source.m_movers) {
+        m_movers->adopt(*source.m_movers, slot);
+    }
+    if (!m_tiers.empty()) {
+        ++m_publishSeq[slot];  // REASON: Tier subscribers get the adopted state at the next tier tick
+    }
+    if (!m_profiles.empty()) {
+        m_profiles[slot].swap(source.m_profiles[slot]);
+        if (m_profiles[slot] && m_profiles[slot]->changed() && !m_profilePending[slot]) {
+            m_profilePending[slot] = 1;  // NOTE: The source skips it - its entry for the slot is now empty
+            m_profileDirty.push_back(slot);
+        }
+    }
+    if (!m_sessions.empty()) {
+        std::swap(m_sessions[slot], source.m_sessions[slot]);
+        if (m_sessions[slot].dirty) {
+            m_sessionDirty.push_back(slot);  // NOTE: The source skips it - its entry for the slot is now clean
+        }
+    }
+    if (m_states[slot].deadbandHeld) {
+        m_deadbandHeld.push_back(slot);  // REASON: The source's list no longer reaches it (its flag moved here)
+    }
+    markCheckpoint(slot);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::applyUpdate(const TickUpdate& update) {
+    if (update.slot >= m_states.size()) {
+        return;
+    }
+    
+    // PERFORMANCE: State aggregation logic (merge BidAsk + AllLast), O(1) slot index
+    StateEntry& entry = m_states[update.slot];
+    InstrumentState& state = entry.state;
+    // PERFORMANCE: Bound / resolved are tested on the entry, not the symbol or conId - the cold half of the
+    // state (InstrumentMeta) stays out of cache on the per-tick path
+    if (!entry.channels) {
+        bindSlot(entry, update.slot);
+    }
+    if (!entry.resolved) {
+        // REASON: Resolved in the background (reqContractDetails) - may land after the first ticks,
+        // one relaxed load per update until it has
+        const int conId = m_registry.conId(update.slot);
+        if (conId != 0) {
+            state.conId = conId;
+            state.primaryExchange = exchangeName(m_registry.primaryExchange(update.slot));
+            entry.resolved = true;
+        }
+    }
+    const std::string& symbol = state.symbol;
+    
+    if (update.backfilled() && update.type != TickUpdateType::Bar) {
+        // REASON: History of a reconnect gap - older than the live state, written to the stream only
+        if (update.type == TickUpdateType::HistoryEnd) {
+            publishBackfill(entry, update.slot, true);
+            return;
+        }
+        std::vector<TickUpdate>& ticks = m_backfill[update.slot];
+        ticks.push_back(update);
+        if (ticks.size() >= kBackfillChunk) {
+            publishBackfill(entry, update.slot, false);
+        }
+        return;
+    }
+    if ((update.type == TickUpdateType::BidAsk || update.type == TickUpdateType::AllLast)
+        && m_config.tickFilter.enabled && rejectTick(entry, update)) {
+        return;  // PERFORMANCE: Never reaches the state - no encode, no publish, no consumer has to discard it
+    }
+    if (update.type == TickUpdateType::BidAsk) {
+        state.bidPrice = update.bidAsk.bidPrice;
+        state.askPrice = update.bidAsk.askPrice;
+        // PERFORMANCE: Integer rescale only when the tick's scale differs from the instrument's
+        state.bidSize = state.sizeUnits(update.bidQuantity());
+        state.askSize = state.sizeUnits(update.askQuantity());
+        state.quoteTimestamp = update.timestamp;
+        state.receiveNs = update.bidAsk.stamps.receiveNs;
+        state.hasQuote = true;
+        if (m_config.derivedMetrics.enabled) {
+            state.derived.onQuote(state.bidPrice, state.askPrice);
+        }
+    } else if (update.type == TickUpdateType::AllLast) {
+        state.lastPrice = update.allLast.price;
+        state.lastSize = state.sizeUnits(update.tradeQuantity());
+        state.tradeTimestamp = update.timestamp;
+        state.receiveNs = update.allLast.stamps.receiveNs;
+        state.hasTrade = true;
+        ++entry.trades;
+        // NOTE: Volume analytics count whole units - only the snapshot sizes keep the fraction
+        const std::int64_t shares = wholeUnits(update.tradeQuantity());
+        if (!m_series.empty()) {
+            m_series[update.slot].onTrade(shares);
+        }
+        if (m_tape) {
+            m_tape->add(update);
+        }
+        if (m_baskets) {
+            m_baskets->onTrade(update.slot, update.allLast.price);
+        }
+        if (m_movers) {
+            m_movers->onTrade(update.slot, update.timestamp, update.allLast.price, shares);
+        }
+        if (!m_profiles.empty()) {
+            profileTrade(entry, update);
+        }
+        if (!m_sessions.empty()) {
+            SessionStats& stats = m_sessions[update.slot];
+            const bool wasDirty = stats.dirty;
+            stats.onTrade(sessionNumber(update.timestamp, m_sessionResetMs), update.allLast.price, shares);
+            markSession(update.slot, wasDirty);
+        }
+        state.pastLimit = update.pastLimit();
+        state.exchange = exchangeName(update.allLast.exchange);  // PERFORMANCE: Static name, view assignment
+        state.tradeConditions = update.allLast.conditions;
+        if (m_config.derivedMetrics.enabled) {
+            // PERFORMANCE: O(1) running sums - consumers no longer rescan trade history per tick
+            state.derived.onTrade(update.timestamp, update.allLast.price, shares,
+                                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      m_config.derivedMetrics.sessionReset).count());
+        }
+        if (m_config.barBuilder.enabled) {
+            buildBar(entry, update);
+        }
+    } else if (update.type == TickUpdateType::Bar) {
+        if ((update.flags & TickFlags::SessionSeed) != 0) {
+            // REASON: Daily bar of the session statistics seed - not part of the bar feed, never published
+            if (!m_sessions.empty()) {
+                SessionStats& stats = m_sessions[update.slot];
+                const bool wasDirty = stats.dirty;
+                const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                stats.seed(sessionOfDate(update.timestamp), sessionNumber(nowMs, m_sessionResetMs), update.bar.open,
+                           update.bar.high, update.bar.low, update.bar.close, update.bar.volume);
+                markSession(update.slot, wasDirty);
+            }
+            return;
+        }
+        if ((update.flags & TickFlags::Live) != 0) {
+            applyLiveBar(entry, update);
+            return;
+        }
+        if ((update.flags & TickFlags::Historical) != 0) {
+            // PERFORMANCE: Backfill goes out as one payload on HistoryEnd, not one PUBLISH per bar
+            if (m_config.barStore.enabled) {
+                storeBar(entry, update);
+            }
+            std::vector<TickUpdate>& bars = m_history[update.slot];
+            const std::size_t capacity = bars.capacity();
+            bars.push_back(update);
+            if (bars.capacity() != capacity) {
+                m_counters.historyBytes.fetch_add(
+                    static_cast<std::int64_t>((bars.capacity() - capacity) * sizeof(TickUpdate)), std::memory_order_relaxed);
+            }
+            if (bars.size() >= m_config.historyChunkBars) {
+                publishHistory(entry, update.slot, false);
+            } else if (historyOverBudget()) {
+                m_counters.historyTrims.fetch_add(1, std::memory_order_relaxed);
+                publishHistory(entry, update.slot, false);
+            }
+            return;
+        }
+        
+        // Real-time bar: publish immediately (no aggregation needed)
+        publishBar(entry, update);
+        return;  // Skip tick aggregation logic
+    } else if (update.type == TickUpdateType::HistoryEnd) {
+        publishHistory(entry, update.slot, true);
+        return;
+    } else if (update.type == TickUpdateType::Depth) {
+        applyDepth(entry, update);
+        return;  // Own channel, independent of the quote/trade snapshot
+    } else if (update.type == TickUpdateType::MidPoint) {
+        // PERFORMANCE: Published as is - no InstrumentState merge, conflation window or snapshot encode
+        // NOTE: Already conflated upstream in coalesce mode (shares the slot's BidAsk key)
+        try {
+            encodeMidPoint(symbol, update, m_json);
+            m_redis.publishBuffered(entry.channels->midPoint, m_json.data(), m_json.size());
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+        return;
+    } else if (update.type == TickUpdateType::Greeks) {
+        applyGreeks(entry, update);
+        return;  // Own channels, published by ChainTimer
+    } else if (update.type == TickUpdateType::Handoff) {
+        // REASON: Handed off after the whole batch - overflow drained behind the marker may still be the slot's
+        m_handoffSlot = update.slot;
+        m_handoffGeneration = update.aux;
+        return;
+    }
+    
+    markCheckpoint(update.slot);
+    if (m_flight) {
+        const TickStamps* stamps = update.stamps();
+        if (stamps != nullptr && stamps->ingestNs != 0) {
+            entry.stamps = *stamps;
+            entry.stampedType = update.type;
+        }
+    }
+    if (m_trace) {
+        const TickStamps* stamps = update.stamps();
+        if (stamps != nullptr && stamps->traceId != 0) {
+            entry.traceId = stamps->traceId;
+        }
+    }
+    
+    // REASON: WhenComplete waits for both BidAsk AND AllLast, the other policies publish the first partial
+    if (m_config.publishPolicy.policy == PublishPolicy::WhenComplete && (!state.hasQuote || !state.hasTrade)) {
+        return;
+    }
+    
+    // BACKPRESSURE: Shedding conflates quotes even with conflation disabled - trades still publish one by one
+    const bool conflate = m_config.conflation.enabled || m_shedLevel >= ShedLevel::ConflateQuotes;
+    const bool bypass = update.type == TickUpdateType::AllLast
+        && (m_config.conflation.publishTradesIndividually || !m_config.conflation.enabled);
+    if (conflate && !bypass) {
+        markDirty(entry);
+    } else {
+        publishState(entry);
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishHistory(StateEntry& entry, SlotId slot, bool complete) {
+    std::vector<TickUpdate>& bars = m_history[slot];
+    try {
+        encodeBarHistory(entry.state.symbol, bars.data(), bars.size(), complete, m_json);
+        m_redis.publishBuffered(entry.channels->history, m_json.data(), m_json.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+    if (complete) {
+        std::cout << "[WORKER] Historical series: " << entry.state.symbol << " (" << bars.size() << " bars in last chunk)\n";
+    }
+    if (historyOverBudget()) {
+        // REASON: Freed instead of kept for the next backfill - the budget says the retained capacity is too much
+        m_counters.historyBytes.fetch_sub(static_cast<std::int64_t>(bars.capacity() * sizeof(TickUpdate)),
+                                          std::memory_order_relaxed);
+        std::vector<TickUpdate>().swap(bars);
+        return;
+    }
+    bars.clear();  // REASON: Capacity kept for the next backfill
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishBackfill(StateEntry& entry, SlotId slot, bool complete) {
+    std::vector<TickUpdate>& ticks = m_backfill[slot];
+    if (ticks.empty() && !complete) {
+        return;
+    }
+    try {
+        // NOTE: XADD whatever TickOutput says - the stream is where consumers resume, a gap filled on
+        // Pub/Sub would reach nobody who missed it
+        encodeTickBackfill(entry.state.symbol, ticks.data(), ticks.size(), complete, m_json);
+        m_redis.streamAddBuffered(entry.channels->stream, m_json.data(), m_json.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+    ticks.clear();  // REASON: Capacity kept for the next gap
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::storeBar(const StateEntry& entry, const TickUpdate& update) {
+    const BarSize size = update.barSize();
+    if (size == BarSize::Unknown) {
+        return;  // REASON: No key to file it under (bar size not a TWS setting)
+    }
+    const BarStoreConfig& config = m_config.barStore;
+    const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::int64_t cutoffMs = config.retainBars == 0
+        ? 0 : nowMs - static_cast<std::int64_t>(config.retainBars) * barSizeSeconds(size) * 1000;
+    if (config.retainBars != 0 && update.timestamp < cutoffMs) {
+        return;  // REASON: Backfill older than the age limit would be trimmed right away
+    }
+    
+    std::unique_ptr<BarStoreSlot>& store = m_barStore[update.slot];
+    if (!store) {
+        store = std::make_unique<BarStoreSlot>();
+    }
+    BarSeries& series = store->series[static_cast<std::size_t>(size)];
+    if (series.key.empty()) {
+        series.key = entry.channels->barStore + barSizeLabel(size);
+    }
+    
+    try {
+        // PERFORMANCE: Buffered into the batch pipeline like every publish - no extra round trip
+        encodeBarArray(update, m_json);
+        m_redis.sortedSetAddBuffered(series.key, static_cast<double>(update.timestamp), m_json.data(), m_json.size());
+        if (config.retainBars != 0 && nowMs >= series.nextTrimMs) {
+            // REASON: One ZREMRANGEBYSCORE per key per interval, not per bar
+            series.nextTrimMs = nowMs + std::chrono::duration_cast<std::chrono::milliseconds>(config.trimInterval).count();
+            m_redis.sortedSetTrimBuffered(series.key, static_cast<double>(cutoffMs));
+        }
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+// Closed bar: TWS:BARS:{SYMBOL} (+ binary), appended to the bar store
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishBar(const StateEntry& entry, const TickUpdate& update) {
+    try {
+        encodeBar(entry.state.symbol, update, m_json);
+        m_redis.publishBuffered(entry.channels->bars, m_json.data(), m_json.size());
+        if (m_config.publishBinary) {
+            encodeBarBinary(entry.state.symbol, update, m_binary);
+            m_redis.publishBuffered(entry.channels->binaryBars, m_binary);
+        }
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+    if (m_config.barStore.enabled) {
+        storeBar(entry, update);
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::applyLiveBar(const StateEntry& entry, const TickUpdate& update) {
+    std::unique_ptr<LiveBar>& live = m_liveBars[update.slot];
+    if (!live) {
+        live = std::make_unique<LiveBar>();
+        trackLiveBar(update.slot);
+    }
+    TickUpdate& current = live->bar;
+    if (current.timestamp != 0 && current.barSize() == update.barSize()) {
+        if (update.timestamp < current.timestamp) {
+            return;  // REASON: Revision of a bar that already closed (reordered behind its successor)
+        }
+        if (update.timestamp > current.timestamp) {
+            // REASON: The next bar started - the last revision of this one is final, appended like a real-time bar
+            // NOTE: Replaces its throttled revision in the bar store (same score)
+            publishBar(entry, current);
+        }
+    }
+    // PERFORMANCE: In place - nothing encoded until LiveBarTimer, however often TWS revises it
+    current = update;
+    current.flags = static_cast<std::uint8_t>(update.flags & ~TickFlags::Live);
+    live->pending = true;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::trackLiveBar(SlotId slot) {
+    if (std::find(m_liveBarSlots.begin(), m_liveBarSlots.end(), slot) != m_liveBarSlots.end()) {
+        return;
+    }
+    if (m_liveBarSlots.empty()) {
+        m_timers.arm(std::chrono::steady_clock::now() + m_config.liveBarInterval, LiveBarTimer);
+    }
+    m_liveBarSlots.push_back(slot);
+}
+
+// Latest revision of every in-progress bar revised since the last run: TWS:LIVEBAR:{SYMBOL}, bar store upsert
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishLiveBars() {
+    for (SlotId slot : m_liveBarSlots) {
+        LiveBar* live = m_liveBars[slot].get();
+        if (!live || !live->pending) {
+            continue;  // NOTE: Handed off to another worker, or unchanged since the last run
+        }
+        live->pending = false;
+        const StateEntry& entry = m_states[slot];
+        try {
+            encodeBar(entry.state.symbol, live->bar, m_json);
+            m_redis.publishBuffered(entry.channels->liveBar, m_json.data(), m_json.size());
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+        if (m_config.barStore.enabled) {
+            storeBar(entry, live->bar);  // REASON: Same score as its backfilled row - revised in place
+        }
+    }
+}
+
+template <typename Queue>
+typename BasicRedisWorker<Queue>::BuiltBarSlot& BasicRedisWorker<Queue>::builtBars(const StateEntry& entry, SlotId slot) {
+    std::unique_ptr<BuiltBarSlot>& built = m_barBuilders[slot];
+    if (!built) {
+        built = std::make_unique<BuiltBarSlot>(m_config.barBuilder);
+        for (std::size_t i = 0; i < built->builder.timeframes(); ++i) {
+            built->channels[i] = entry.channels->bars + ":" + barSizeLabel(built->builder.timeframe(i));
+        }
+        m_barBuilderSlots.push_back(slot);
+    }
+    return *built;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::buildBar(const StateEntry& entry, const TickUpdate& update) {
+    // PERFORMANCE: O(timeframes) per trade, closed bars go straight into the batch pipeline
+    BuiltBarSlot& bars = builtBars(entry, update.slot);
+    const std::int64_t shares = wholeUnits(update.tradeQuantity());
+    const bool applied = bars.builder.addTrade(update.timestamp, update.allLast.price, shares,
+                                               [&](BarSize size, const BuiltBar& bar) {
+                                                   publishBuiltBar(update.slot, bars, size, bar);
+                                               });
+    if (!applied) {
+        m_counters.lateTrades.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishBuiltBar(SlotId slot, BuiltBarSlot& built, BarSize size, const BuiltBar& bar) {
+    markCheckpoint(slot);  // REASON: Closed - a restart must not publish it again
+    const StateEntry& entry = m_states[slot];
+    // REASON: Same record as a TWS bar - one schema (kBarFields) and bar store path for both
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::Bar;
+    update.setBarSize(size);
+    update.timestamp = bar.start;
+    update.bar.open = bar.open;
+    update.bar.high = bar.high;
+    update.bar.low = bar.low;
+    update.bar.close = bar.close;
+    update.bar.volume = bar.volume;
+    update.bar.wap = bar.wap();
+    update.aux = bar.count;
+    
+    std::size_t index = 0;
+    while (index + 1 < built.builder.timeframes() && built.builder.timeframe(index) != size) {
+        ++index;
+    }
+    try {
+        encodeBar(entry.state.symbol, update, m_json);
+        m_redis.publishBuffered(built.channels[index], m_json.data(), m_json.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+    if (m_config.barStore.enabled) {
+        storeBar(entry, update);
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::closeExpiredBars() {
+    if (m_barBuilderSlots.empty()) {
+        return;
+    }
+    const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::int64_t graceMs = m_config.barBuilder.grace.count();
+    for (SlotId slotId : m_barBuilderSlots) {
+        BuiltBarSlot& built = *m_barBuilders[slotId];
+        built.builder.closeExpired(nowMs, graceMs, [&](BarSize size, const BuiltBar& bar) {
+            publishBuiltBar(slotId, built, size, bar);
+        });
+    }
+}
+
+// true: update failed the tick filter and is dropped (counted per reason either way)
+template <typename Queue>
+bool BasicRedisWorker<Queue>::rejectTick(StateEntry& entry, const TickUpdate& update) {
+    const TickFilterConfig& filter = m_config.tickFilter;
+    const BadTick reason = update.type == TickUpdateType::BidAsk
+        ? entry.band.screenQuote(filter, update.bidAsk.bidPrice, update.bidAsk.askPrice)
+        : entry.band.screenTrade(filter, update.allLast.price);
+    if (reason == BadTick::None) {
+        return false;
+    }
+    m_counters.badTicks[static_cast<std::size_t>(reason)].fetch_add(1, std::memory_order_relaxed);
+    return filter.drop;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::applyDepth(StateEntry& entry, const TickUpdate& update) {
+    std::unique_ptr<OrderBook>& book = m_books[update.slot];
+    if (!book) {
+        book = std::make_unique<OrderBook>();
+    }
+    // PERFORMANCE: O(depth) shift in a fixed array, no allocation
+    if (!book->apply(update.depth.side, update.depth.position, update.depth.operation, update.depth.price,
+                     update.depth.size)) {
+        m_counters.depthRejected.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    book->timestamp = update.timestamp;
+    
+    const DepthOutput output = m_config.depth.output;
+    if (output != DepthOutput::Snapshot) {
+        try {
+            serializeDepthDelta(entry.state.symbol, update, m_json);
+            m_redis.publishBuffered(entry.channels->depth, m_json.data(), m_json.size());
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+    }
+    if (output != DepthOutput::Delta && !m_depthPending[update.slot]) {
+        // REASON: A burst of level changes for one book becomes one snapshot per batch
+        m_depthPending[update.slot] = 1;
+        m_depthDirty.push_back(update.slot);
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::applyGreeks(StateEntry& entry, const TickUpdate& update) {
+    std::unique_ptr<GreeksChain>& chain = m_chains[update.slot];
+    if (!chain) {
+        chain = std::make_unique<GreeksChain>(entry.channels->chain);
+        trackChain(update.slot);
+    }
+    // PERFORMANCE: In place - the leg's slot in the dense table, nothing encoded until ChainTimer
+    chain->apply(update);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::trackChain(SlotId slot) {
+    if (std::find(m_chainSlots.begin(), m_chainSlots.end(), slot) != m_chainSlots.end()) {
+        return;
+    }
+    if (m_chainSlots.empty()) {
+        m_timers.arm(std::chrono::steady_clock::now() + m_config.options.interval, ChainTimer);
+    }
+    m_chainSlots.push_back(slot);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishChains() {
+    for (SlotId slot : m_chainSlots) {
+        GreeksChain* chain = m_chains[slot].get();
+        if (!chain) {
+            continue;
+        }
+        try {
+            chain->flush(m_states[slot].state.symbol, m_config.options.keyframeEvery, m_json,
+                         [this](const std::string& channel, std::string_view payload) {
+                             m_redis.publishBuffered(channel, payload.data(), payload.size());
+                         });
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+    }
+}
+
+// REASON: Skipped while nothing traded - the exchange keeps the last post (unless a session boundary retired it)
+template <typename Queue>
+void BasicRedisWorker<Queue>::postMovers() {
+    const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (!m_movers->due(nowMs)) {
+        return;
+    }
+    m_movers->top(m_moversConfig.top, nowMs, m_moversScratch);
+    m_moversExchange->post(m_config.shardId, m_moversScratch);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::profileTrade(const StateEntry& entry, const TickUpdate& update) {
+    std::unique_ptr<VolumeProfile>& profile = m_profiles[update.slot];
+    if (!profile) {
+        profile = std::make_unique<VolumeProfile>(m_config.volumeProfile, "TWS:PROFILE:" + entry.state.symbol);
+    }
+    profile->onTrade(update.timestamp, update.allLast.price, wholeUnits(update.tradeQuantity()));
+    if (!m_profilePending[update.slot]) {
+        m_profilePending[update.slot] = 1;
+        m_profileDirty.push_back(update.slot);
+    }
+}
+
+// PERFORMANCE: Throttled - a slot trading thousands of times per interval sends one delta of the buckets
+// it touched (PUBLISH) and one full profile for late joiners (SET), whatever its print count
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishProfiles() {
+    for (SlotId slot : m_profileDirty) {
+        m_profilePending[slot] = 0;
+        VolumeProfile* profile = m_profiles[slot].get();
+        if (!profile || !profile->changed()) {
+            continue;  // NOTE: Moved to another worker since it traded here
+        }
+        const std::string_view symbolJson = m_states[slot].state.symbolJson;
+        try {
+            profile->encode(symbolJson, false, m_profilePayload);
+            m_redis.publishBuffered(profile->channel(), m_profilePayload);
+            profile->encode(symbolJson, true, m_profilePayload);
+            m_redis.setBuffered(profile->channel(), m_profilePayload.data(), m_profilePayload.size());
+            m_counters.profiles.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+    }
+    m_profileDirty.clear();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::markSession(SlotId slot, bool wasDirty) {
+    if (!wasDirty && m_sessions[slot].dirty) {
+        m_sessionDirty.push_back(slot);
+    }
+}
+
+// PERFORMANCE: Throttled - one PUBLISH + SET per changed slot and interval, whatever its print count
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishSessions() {
+    for (SlotId slot : m_sessionDirty) {
+        SessionStats& stats = m_sessions[slot];
+        if (!stats.dirty) {
+            continue;  // NOTE: Moved to another worker since it changed here
+        }
+        stats.dirty = false;
+        const InstrumentState& state = m_states[slot].state;
+        m_sessionChannel.assign("TWS:SESSION:");
+        m_sessionChannel += state.symbol;
+        try {
+            stats.encode(state.symbolJson, m_sessionPayload);
+            m_redis.publishBuffered(m_sessionChannel, m_sessionPayload);
+            m_redis.setBuffered(m_sessionChannel, m_sessionPayload.data(), m_sessionPayload.size());
+            m_counters.sessions.fetch_add(1, std::memory_order_relaxed);
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+    }
+    m_sessionDirty.clear();
+}
+
+// Session boundary: every slot rolls over at once, quiet ones included (their previous close is set and
+// published before their first trade of the new session)
+template <typename Queue>
+void BasicRedisWorker<Queue>::rollSessions() {
+    const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::int64_t current = sessionNumber(nowMs, m_sessionResetMs);
+    for (std::size_t slot = 0; slot < m_sessions.size(); ++slot) {
+        SessionStats& stats = m_sessions[slot];
+        if (stats.session < 0) {
+            continue;  // Never traded nor seeded here
+        }
+        const bool wasDirty = stats.dirty;
+        stats.roll(current);
+        markSession(static_cast<SlotId>(slot), wasDirty);
+    }
+}
+
+// PITFALL: The wheel runs on steady_clock and the boundary is wall-clock time - the deadline is re-derived
+// from system_clock after every rollover, so a clock step only shifts one rollover
+template <typename Queue>
+void BasicRedisWorker<Queue>::armSessionRoll(std::chrono::steady_clock::time_point now) {
+    const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_timers.arm(now + std::chrono::milliseconds(nextSessionStartMs(nowMs, m_sessionResetMs) - nowMs),
+                 SessionRollTimer);
+}
+
+// PERFORMANCE: Everything queued since the last interval is folded into the table first - a position's
+// pnlSingle / updatePortfolio repeats become one HSET of the fields that moved
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishAccount() {
+    constexpr std::size_t kAccountBulk = 256;
+    m_accountBatch.resize(kAccountBulk);
+    std::size_t count;
+    while ((count = m_accountFeed->try_dequeue_bulk(m_accountBatch.begin(), kAccountBulk)) != 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            m_account.apply(m_accountBatch[i]);
+        }
+    }
+    try {
+        m_account.flush([this](const std::string& key, std::string_view payload) {
+            m_redis.hashSetBuffered(key, payload.data(), payload.size());
+        });
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+// BACKPRESSURE: At most maxPerPass headlines per interval - a news burst (earnings, a market-wide story on
+// hundreds of symbols) waits in its own lane instead of taking the worker from the shard queue it drains
+// PERFORMANCE: Duplicates (reconnect replays, provider re-sends) are dropped on an 8-byte fingerprint before
+// any serialization; the PUBLISHes join the pipeline of the next drain batch
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishNews() {
+    NewsLane& lane = *m_newsLane;
+    m_newsBatch.resize(std::min<std::size_t>(lane.config.maxPerPass, 256));
+    std::size_t budget = lane.config.maxPerPass;
+    std::size_t count;
+    while (budget > 0
+           && (count = lane.queue.try_dequeue_bulk(m_newsBatch.begin(), std::min(budget, m_newsBatch.size()))) != 0) {
+        budget -= count;
+        for (std::size_t i = 0; i < count; ++i) {
+            const NewsItem& item = m_newsBatch[i];
+            if (!m_newsFilter.insert(articleFingerprint(item.articleId, item.symbol))) {
+                lane.counters.duplicates.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            m_newsChannel.assign("TWS:NEWS:");
+            m_newsChannel += item.symbol;
+            serializeNews(item, lane.providers.name(item.provider), m_json);
+            try {
+                m_redis.publishBuffered(m_newsChannel, m_json.data(), m_json.size());
+                lane.counters.published.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::exception& e) {
+                BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+            }
+        }
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishDepth() {
+    for (SlotId slot : m_depthDirty) {
+        m_depthPending[slot] = 0;
+        const StateEntry& entry = m_states[slot];
+        try {
+            serializeDepthSnapshot(entry.state.symbol, *m_books[slot], m_config.depth.levels, m_json);
+            m_redis.publishBuffered(entry.channels->depth, m_json.data(), m_json.size());
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+    }
+    m_depthDirty.clear();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishState(StateEntry& entry) {
+    if (entry.dirty) {
+        // REASON: Pending conflated update is carried by this snapshot
+        entry.dirty = false;
+        m_counters.conflated.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!m_series.empty()) {
+        // REASON: Ahead of the publish filters - a price the snapshot policy ignores still belongs on the chart
+        const SlotId slot = static_cast<SlotId>(&entry - m_states.data());
+        if (m_seriesCatalog->ready(slot)) {
+            m_series[slot].collect(entry.state, entry.channels->series, m_seriesBatch);
+        } else {
+            m_series[slot].skip();
+        }
+    }
+    if (m_skipUnwatched) {
+        if (!m_watch->watched(static_cast<SlotId>(&entry - m_states.data()))) {
+            // PERFORMANCE: Nobody subscribed - no encode, no PUBLISH; state keeps aggregating for when someone does
+            entry.unwatched = true;
+            m_counters.unwatched.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        entry.unwatched = false;
+    }
+    
+    const InstrumentState& state = entry.state;
+    const bool fieldChange = m_config.publishPolicy.policy == PublishPolicy::FieldChange;
+    if (fieldChange || m_config.suppressDuplicates || m_config.deadband.enabled) {
+        // PERFORMANCE: Checked at publish time - conflated bursts compare once, not per update
+        if (fieldChange && !selectedFieldsChanged(entry)) {
+            m_counters.unchanged.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (m_config.suppressDuplicates && isDuplicate(entry)) {
+            // REASON: Field compare instead of serialize + memcmp - skipped snapshots cost no encoding
+            m_counters.duplicates.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (m_config.deadband.enabled && withinDeadband(entry)) {
+            // PERFORMANCE: Before any encoding - the cheapest snapshot is the one never serialized
+            m_counters.deadbanded.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        PublishedFields& published = entry.published;
+        published.bidPrice = state.bidPrice;
+        published.askPrice = state.askPrice;
+        published.lastPrice = state.lastPrice;
+        published.bidSize = state.bidSize;
+        published.askSize = state.askSize;
+        published.lastSize = state.lastSize;
+        published.sizeScale = state.sizeScale;
+        published.quoteTimestamp = state.quoteTimestamp;
+        published.tradeTimestamp = state.tradeTimestamp;
+        published.trades = entry.trades;
+        published.pastLimit = state.pastLimit;
+        published.valid = true;
+    }
+    // REASON: Counts snapshots actually sent - a consumer seeing seq jump knows Pub/Sub dropped messages
+    ++entry.state.sequence;
+    markCheckpoint(static_cast<SlotId>(&entry - m_states.data()));  // NOTE: A restart continues the sequence
+    const std::int64_t traceBeginNs = entry.traceId != 0 ? latencyNowNs() : 0;
+    try {
+        DeltaTrack* track = m_deltas.empty() ? nullptr : &m_deltas[static_cast<SlotId>(&entry - m_states.data())];
+        const bool keyframe = track && track->keyframeDue(state, m_config.delta);
+        // PERFORMANCE: A delta-only setup (Pub/Sub, no LVC / stream / shm / sinks / aggregate) skips the
+        // full encode between keyframes
+        const bool fullSnapshot = !track || keyframe || m_shm || m_sinks || m_config.tickOutput != TickOutput::PubSub
+                               || (m_config.writeLastValue && m_lastValues.empty())
+                               || (m_config.aggregate.enabled && !m_encoderPool);
+        if (fullSnapshot) {
+            // PERFORMANCE: Fixed-schema encoder, reused buffer + precomputed channel (no per-tick allocation)
+            encodeSnapshot(state, m_json, m_config.snapshotSchema, m_config.derivedMetrics.enabled,
+                           m_config.isoTimestamps, m_config.priceFormat, sentNs());
+            if (m_config.latency.enabled && m_batchDequeueNs != 0) {
+                m_latency.serialize.record(latencyNowNs() - m_batchDequeueNs);
+            }
+        }
+        if (m_shm) {
+            // PERFORMANCE: Before the Redis enqueue - co-located readers see it without waiting for the pipeline
+            m_shm->write(entry.channels->ticks, std::string_view(m_json.data(), m_json.size()));
+        }
+        const bool perSymbol = m_config.tickOutput != TickOutput::Stream && m_config.aggregate.perSymbol;
+        const bool rawStream = m_config.tickOutput != TickOutput::PubSub && !m_config.compression.stream;
+        const bool lastValueJson = m_lastValues.empty() && m_config.writeLastValue;
+        // PERFORMANCE: Stored once in the publisher's payload pool - PUBLISH, SET, XADD and every sink then
+        // reference the same bytes instead of each taking its own copy
+        SharedPayload stored;
+        if (fullSnapshot && (m_sinks || (perSymbol && !track) || rawStream || lastValueJson)) {
+            stored = m_redis.payloads().store(std::string_view(m_json.data(), m_json.size()));
+        }
+        bool binaryEncoded = false;
+        if (m_sinks) {
+            std::string_view binary;
+            if (m_sinks->wantsBinary()) {
+                encodeSnapshotBinary(state, m_binary);
+                binary = m_binary;
+                binaryEncoded = true;
+            }
+            // PERFORMANCE: Same stored bytes, referenced by the batch every sink shares
+            m_sinks->append(entry.channels->ticks, stored, static_cast<SlotId>(&entry - m_states.data()), binary);
+        }
+        if (perSymbol && !track) {
+            m_redis.publishBuffered(entry.channels->ticks, stored);
+        }
+        if (m_encoderPool) {
+            if (m_encoderPool->pending() == 0) {
+                m_aggregateStart = std::chrono::steady_clock::now();
+            }
+            // PERFORMANCE: A state copy instead of an encode - the pool serializes the array
+            m_encoderPool->append(state, [this](std::string_view payload) { publishArray(payload); });
+        } else if (m_config.aggregate.enabled) {
+            if (m_aggregate.empty()) {
+                m_aggregateStart = std::chrono::steady_clock::now();
+            }
+            m_aggregate.append(std::string_view(m_json.data(), m_json.size()));
+        }
+        if (rawStream) {
+            m_redis.streamAddBuffered(entry.channels->stream, stored);
+        } else if (m_config.tickOutput != TickOutput::PubSub) {
+            const std::string_view data = compress(std::string_view(m_json.data(), m_json.size()));
+            m_redis.streamAddBuffered(entry.channels->stream, data.data(), data.size());
+        }
+        if (!m_lastValues.empty()) {
+            // PERFORMANCE: Only the fields that moved since this slot's last write - a quote rewrites 4 of ~15
+            m_lastValues[static_cast<SlotId>(&entry - m_states.data())].encode(
+                state, m_config.derivedMetrics.enabled, m_lastValuePayload);
+            m_redis.hashSetBuffered(entry.channels->lastValue, m_lastValuePayload.data(), m_lastValuePayload.size());
+        } else if (m_config.writeLastValue) {
+            // PERFORMANCE: Same pipeline, no MULTI - zero extra round trips
+            m_redis.setBuffered(entry.channels->lastValue, stored);
+        }
+        if (m_config.publishBinary && !track) {
+            if (!binaryEncoded) {
+                encodeSnapshotBinary(state, m_binary);
+            }
+            m_redis.publishBuffered(entry.channels->binaryTicks, m_binary);
+        }
+        if (track) {
+            publishDelta(entry, *track, keyframe, perSymbol);
+        }
+        m_counters.published.fetch_add(1, std::memory_order_relaxed);
+        BRIDGE_TRACE3(snapshot_serialized, m_config.shardId, &entry - m_states.data(), m_json.size());
+        if (!m_tiers.empty()) {
+            markTiers(static_cast<SlotId>(&entry - m_states.data()));
+        }
+        if (m_flight && entry.stamps.ingestNs != 0) {
+            // NOTE: Conflated snapshots carry the stamps of their latest update
+            m_flight->stage(FlightRecord{entry.stamps.ingestNs, entry.stamps.ingestNs + entry.stamps.enqueueNs,
+                                         m_batchDequeueNs, latencyNowNs(), 0,
+                                         static_cast<SlotId>(&entry - m_states.data()), entry.stampedType});
+            entry.stamps.ingestNs = 0;
+        }
+        if (entry.traceId != 0) {
+            const std::int64_t serializedNs = latencyNowNs();
+            const SlotId slot = static_cast<SlotId>(&entry - m_states.data());
+            m_trace->record(TraceStage::Serialize, traceBeginNs, serializedNs, entry.traceId, slot);
+            m_tracePending.push_back(TracedSnapshot{serializedNs, entry.traceId, slot});
+            entry.traceId = 0;
+        }
+        
+        // PERFORMANCE: Async, Debug level - a disabled level costs one relaxed load per snapshot
+        LOG_DEBUG("[WORKER] Published: {} | Bid: {} | Ask: {} | Last: {}", state.symbol, state.bidPrice,
+                  state.askPrice, state.lastPrice);
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+// Pub/Sub tick channels in delta mode (DeltaConfig): changed fields only, the full snapshot as keyframe
+// REASON: Last user of m_json in publishState - a delta overwrites the full snapshot
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishDelta(StateEntry& entry, DeltaTrack& track, bool keyframe, bool perSymbol) {
+    const InstrumentState& state = entry.state;
+    const std::uint16_t changed = keyframe ? 0 : track.baseline().changes(state, m_config.derivedMetrics.enabled);
+    track.sent(state, keyframe);
+    if (perSymbol) {
+        if (!keyframe) {
+            encodeSnapshotDelta(state, changed, m_json, m_config.snapshotSchema, m_config.isoTimestamps,
+                                m_config.priceFormat, sentNs());
+            if (m_config.latency.enabled && m_batchDequeueNs != 0) {
+                m_latency.serialize.record(latencyNowNs() - m_batchDequeueNs);
+            }
+        }
+        m_redis.publishBuffered(entry.channels->ticks, m_json.data(), m_json.size());
+    }
+    if (m_config.publishBinary) {
+        if (keyframe) {
+            encodeSnapshotBinary(state, m_binary);
+        } else {
+            encodeSnapshotBinaryDelta(state, changed, m_binary);
+        }
+        m_redis.publishBuffered(entry.channels->binaryTicks, m_binary);
+    }
+}
+
+template <typename Queue>
+bool BasicRedisWorker<Queue>::selectedFieldsChanged(const StateEntry& entry) const {
+    const PublishedFields& published = entry.published;
+    if (!published.valid) {
+        return true;
+    }
+    const InstrumentState& state = entry.state;
+    const std::uint8_t fields = m_config.publishPolicy.fields;
+    // NOTE: Exact compare - TWS resends the same double for an unchanged price
+    return ((fields & SnapshotFields::BidPrice) && state.bidPrice != published.bidPrice)
+        || ((fields & SnapshotFields::AskPrice) && state.askPrice != published.askPrice)
+        || ((fields & SnapshotFields::LastPrice) && state.lastPrice != published.lastPrice)
+        || ((fields & SnapshotFields::BidSize) && state.bidSize != published.bidSize)
+        || ((fields & SnapshotFields::AskSize) && state.askSize != published.askSize)
+        || ((fields & SnapshotFields::LastSize) && state.lastSize != published.lastSize)
+        || ((fields & (SnapshotFields::BidSize | SnapshotFields::AskSize | SnapshotFields::LastSize))
+            && state.sizeScale != published.sizeScale);
+}
+
+template <typename Queue>
+bool BasicRedisWorker<Queue>::isDuplicate(const StateEntry& entry) const {
+    const PublishedFields& published = entry.published;
+    const InstrumentState& state = entry.state;
+    // NOTE: Derived metrics only move with quotes / trades, covered by the fields below
+    return published.valid
+        && state.bidPrice == published.bidPrice && state.askPrice == published.askPrice
+        && state.lastPrice == published.lastPrice && state.bidSize == published.bidSize
+        && state.askSize == published.askSize && state.lastSize == published.lastSize
+        && state.sizeScale == published.sizeScale
+        && state.quoteTimestamp == published.quoteTimestamp && state.tradeTimestamp == published.tradeTimestamp
+        && entry.trades == published.trades && state.pastLimit == published.pastLimit;
+}
+
+// true: the change stays within the slot's deadband and the last publish is younger than its heartbeat
+// (held back; with a heartbeat, DeadbandTimer publishes it once the heartbeat expires)
+template <typename Queue>
+bool BasicRedisWorker<Queue>::withinDeadband(StateEntry& entry) {
+    PublishedFields& published = entry.published;
+    const InstrumentState& state = entry.state;
+    const DeadbandRule& rule = entry.deadband;
+    const auto now = std::chrono::steady_clock::now();
+    // NOTE: A size scale change is never within the deadband (the units are not comparable)
+    if (published.valid && (rule.heartbeat.count() == 0 || now - published.at < rule.heartbeat)
+        && state.sizeScale == published.sizeScale
+        && !deadbandMoved(rule,
+                          DeadbandQuote{published.bidPrice, published.askPrice, published.lastPrice,
+                                        published.bidSize, published.askSize, published.lastSize},
+                          DeadbandQuote{state.bidPrice, state.askPrice, state.lastPrice,
+                                        state.bidSize, state.askSize, state.lastSize})) {
+        if (rule.heartbeat.count() > 0 && !entry.deadbandHeld) {
+            entry.deadbandHeld = true;
+            m_deadbandHeld.push_back(static_cast<SlotId>(&entry - m_states.data()));
+        }
+        return true;
+    }
+    entry.deadbandHeld = false;
+    published.at = now;
+    return false;
+}
+
+// DeadbandTimer: held-back changes whose heartbeat expired go out as they are
+// NOTE: Heartbeats are honoured to kDeadbandSweep granularity
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishHeld(std::chrono::steady_clock::time_point now) {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_deadbandHeld.size(); ++i) {
+        const SlotId slot = m_deadbandHeld[i];
+        StateEntry& entry = m_states[slot];
+        if (!entry.deadbandHeld) {
+            continue;  // NOTE: Published since, or moved to another worker with its entry
+        }
+        if (now - entry.published.at < entry.deadband.heartbeat) {
+            m_deadbandHeld[kept++] = slot;
+            continue;
+        }
+        // REASON: Cleared first - an unwatched / unchanged outcome must not keep it in the list forever
+        entry.deadbandHeld = false;
+        publishState(entry);
+    }
+    m_deadbandHeld.resize(kept);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::markDirty(StateEntry& entry) {
+    if (entry.dirty) {
+        // PERFORMANCE: Superseded before it was published
+        m_counters.conflated.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (m_dirty.empty()) {
+        m_windowStart = std::chrono::steady_clock::now();
+    }
+    entry.dirty = true;
+    m_dirty.push_back(&entry);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishDirty() {
+    for (StateEntry* entry : m_dirty) {
+        if (entry->dirty) {
+            entry->dirty = false;
+            publishState(*entry);
+        }
+    }
+    m_dirty.clear();
+}
+
+// Every series sample of the batch as one TS.MADD, ahead of the batch's pipeline flush
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishTimeSeries() {
+    if (m_seriesBatch.empty()) {
+        return;
+    }
+    try {
+        m_redis.timeSeriesAddBuffered(m_seriesBatch.payload());
+        m_counters.seriesSamples.fetch_add(m_seriesBatch.samples(), std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+    m_seriesBatch.clear();
+}
+
+// Every trade of the batch into its symbol's TWS:TAS list - one LPUSH + LTRIM per symbol, same pipeline as the snapshots
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishTape() {
+    if (!m_tape || m_tape->empty()) {
+        return;
+    }
+    try {
+        m_tape->flush([this](SlotId slot, const std::string& payload, std::size_t prints) {
+            m_redis.listPushBuffered(m_registry.channels(slot).tape, payload, m_tape->keep());
+            m_counters.tapePrints.fetch_add(prints, std::memory_order_relaxed);
+        });
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        m_tape->clear();  // REASON: Not re-sent with the next batch - the list would get them twice
+    }
+}
+
+// Latest snapshot for symbols that just gained a subscriber (even if nothing changed since the skip)
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishNewlyWatched() {
+    if (!m_skipUnwatched) {
+        return;
+    }
+    // PERFORMANCE: One acquire load per batch - the table scan only runs after a slot turned watched
+    const std::uint64_t generation = m_watch->generation();
+    if (generation == m_watchGeneration) {
+        return;
+    }
+    m_watchGeneration = generation;
+    for (std::size_t slot = 0; slot < m_states.size(); ++slot) {
+        StateEntry& entry = m_states[slot];
+        if (entry.unwatched && m_watch->watched(static_cast<SlotId>(slot))) {
+            entry.published.valid = false;  // REASON: Bypass FieldChange / duplicate checks for this one
+            if (!m_deltas.empty()) {
+                m_deltas[slot].resync();  // REASON: The new subscriber has no baseline
+            }
+            publishState(entry);
+        }
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishDirtyIfDue() {
+    if (m_dirty.empty()) {
+        return;
+    }
+    // REASON: window == 0 conflates per drain batch; otherwise hold until window elapses
+    const auto window = m_shedLevel >= ShedLevel::ConflateQuotes
+        ? std::max(m_config.conflation.window, m_config.shedConflationWindow) : m_config.conflation.window;
+    if (window.count() > 0 && std::chrono::steady_clock::now() - m_windowStart < window) {
+        return;
+    }
+    publishDirty();
+}
+
+// One PUBLISH of every snapshot collected since the last one (AggregateConfig)
+// NOTE: With the encoder pool the array is only submitted here - collectEncoded() publishes it
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishAggregate() {
+    if (m_encoderPool) {
+        m_encoderPool->submit();
+        return;
+    }
+    if (m_aggregate.empty()) {
+        return;
+    }
+    std::string_view payload = m_aggregate.close();
+    if (m_config.compression.aggregate) {
+        payload = compress(payload);
+    }
+    publishArray(payload);
+    m_aggregate.clear();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishAggregateIfDue() {
+    const std::size_t count = m_encoderPool ? m_encoderPool->pending() : m_aggregate.count();
+    if (count == 0) {
+        return;
+    }
+    // REASON: Same rule as publishDirtyIfDue - window == 0 sends one array per drain batch
+    const auto window = m_config.aggregate.window;
+    if (count < m_config.aggregate.maxSnapshots && window.count() > 0
+        && std::chrono::steady_clock::now() - m_aggregateStart < window) {
+        return;
+    }
+    publishAggregate();
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishArray(std::string_view payload) {
+    try {
+        m_redis.publishBuffered(m_config.aggregate.channel, payload.data(), payload.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+// Arrays the pool finished, in submit order (a later one encoded first waits for its predecessors)
+template <typename Queue>
+void BasicRedisWorker<Queue>::collectEncoded() {
+    if (m_encoderPool) {
+        m_encoderPool->collect([this](std::string_view payload) { publishArray(payload); });
+    }
+}
+
+// NOTE: Equality is all the tiers compare - a wrapped counter is still "changed"
+template <typename Queue>
+void BasicRedisWorker<Queue>::markTiers(SlotId slot) {
+    ++m_publishSeq[slot];
+}
+
+// Latest snapshot of every symbol published since the tier's last tick, on its own channels (RateTier)
+// PERFORMANCE: A tier's cost is bounded by its rate x changed symbols, not by the tick rate - the sweep
+// itself is one column compare over the registered slots (microseconds for thousands of symbols)
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishTier(std::size_t index) {
+    TierState& tier = m_tiers[index];
+    if (m_shedLevel >= ShedLevel::DropTiers) {
+        // BACKPRESSURE: Shedding - the interval is skipped, the next one after recovery starts fresh
+        tier.sent.assign(m_publishSeq);
+        return;
+    }
+    // REASON: Registered count, not capacity - slots past it were never published
+    forEachChanged(m_publishSeq, tier.sent, m_registry.size(), [&](std::size_t slot) {
+        const InstrumentState& state = m_states[slot].state;
+        std::string& channel = tier.channels[slot];
+        if (channel.empty()) {
+            channel = "TWS:" + m_config.tiers[index].name + ":TICKS:" + state.symbol;
+        }
+        try {
+            // NOTE: Re-encoded - the full-rate snapshot buffer has been overwritten by later symbols
+            encodeSnapshot(state, m_json, m_config.snapshotSchema, m_config.derivedMetrics.enabled,
+                           m_config.isoTimestamps, m_config.priceFormat, sentNs());
+            m_redis.publishBuffered(channel, m_json.data(), m_json.size());
+        } catch (const std::exception& e) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+        }
+    });
+}
+
+// LZ4 frame of payload when it is large enough and actually shrinks, payload itself otherwise
+// NOTE: The view into m_compressed is valid until the next call
+template <typename Queue>
+std::string_view BasicRedisWorker<Queue>::compress(std::string_view payload) {
+    if (payload.size() < m_config.compression.minBytes) {
+        return payload;
+    }
+    m_compressed.clear();
+    m_lz4.compressFrame(payload, m_compressed);
+    return m_compressed.size() < payload.size() ? std::string_view(m_compressed) : payload;
+}
+
+// Trade lane first (PrioritizeTrades), then the main queue, then whatever overflowed it
+// REASON: Main queue before overflow - overflow only holds updates newer than what it contains
+template <typename Queue>
+std::size_t BasicRedisWorker<Queue>::dequeueBatch(TickUpdate* out, std::size_t maxItems) {
+    std::size_t count = m_shard.trades ? m_shard.trades->try_dequeue_bulk(out, maxItems) : 0;
+    if (count < maxItems) {
+        // PERFORMANCE: One bulk dequeue amortizes queue atomics across the batch
+        count += m_queue.try_dequeue_bulk(out + count, maxItems - count);
+    }
+    if (count < maxItems) {
+        count += drainOverflow(out + count, maxItems - count);
+    }
+    return count;
+}
+
+template <typename Queue>
+std::size_t BasicRedisWorker<Queue>::drainOverflow(TickUpdate* out, std::size_t maxItems) {
+    std::size_t count = 0;
+    if (m_shard.spill) {
+        count += m_shard.spill->try_dequeue_bulk(out, maxItems);
+    }
+    if (m_shard.coalescing && count < maxItems) {
+        // PERFORMANCE: Bitmap scan, one word load per 64 keys, only changed symbols copied
+        count += m_shard.coalescing->drain(out + count, maxItems - count);
+    }
+    return count;
+}
+
+// Hands the backlog this batch left behind to the controller; true = send the pipeline now
+// PERFORMANCE: The clock is read only while a burst is deferring flushes
+template <typename Queue>
+bool BasicRedisWorker<Queue>::adaptiveFlushDue() {
+    const std::size_t backlog = m_queue.size_approx() + (m_shard.hasOverflow() ? 1 : 0);
+    m_batcher.observe(backlog);
+    m_redis.setMaxMessages(m_batcher.pipelineLimit());
+    const std::size_t pending = m_redis.pendingCount();
+    const auto age = pending > 0 && backlog > 0 ? std::chrono::steady_clock::now() - m_redis.oldestPending()
+                                                : std::chrono::steady_clock::duration::zero();
+    return m_batcher.flushDue(backlog, pending, age);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::recordBatch(std::size_t size) {
+    ++m_batchSizeCounts[size];
+    ++m_batchCount;
+    m_updateCount += size;
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::recordDequeue(const TickUpdate* updates, std::size_t count) {
+    // PERFORMANCE: One clock read per batch - every update of the batch was dequeued at once
+    const std::int64_t nowNs = latencyNowNs();
+    const bool histograms = m_config.latency.enabled;  // REASON: Off with trackQueueAge alone
+    std::int64_t oldestNs = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const TickStamps* stamps = updates[i].stamps();
+        if (stamps == nullptr || stamps->ingestNs == 0) {
+            continue;
+        }
+        if (histograms) {
+            m_latency.ingest.record(stamps->enqueueNs);
+            m_latency.queue.record(nowNs - stamps->ingestNs - stamps->enqueueNs);
+        }
+        if (oldestNs == 0 || stamps->ingestNs < oldestNs) {
+            oldestNs = stamps->ingestNs;
+        }
+    }
+    const std::int64_t ageNs = oldestNs != 0 ? nowNs - oldestNs : 0;
+    m_queueAgeNs.store(ageNs, std::memory_order_relaxed);
+    if (m_config.lag.enabled && oldestNs != 0) {
+        checkLag(ageNs);
+    }
+    if (oldestNs != 0 && (m_flight || m_trace)) {
+        m_batchDequeueNs = nowNs;
+    }
+    if (histograms && oldestNs != 0) {
+        m_batchDequeueNs = nowNs;
+        // REASON: Publish / EndToEnd are measured by the publisher once this batch's pipeline completes
+        m_redis.markIngest(oldestNs);
+    }
+}
+
+// Staged flight records enter the ring once nothing of their pipeline is left buffered
+template <typename Queue>
+void BasicRedisWorker<Queue>::commitFlight() {
+    if (m_flight && m_flight->pending() > 0 && m_redis.pendingCount() == 0) {
+        m_flight->commit(latencyNowNs(), m_queue.size_approx(), m_redis.lastRoundTrip());
+    }
+}
+
+// Sampled update: queue wait and state update as trace spans
+template <typename Queue>
+void BasicRedisWorker<Queue>::applyTraced(const TickUpdate& update) {
+    const TickStamps* stamps = update.stamps();
+    if (stamps == nullptr || stamps->traceId == 0) {
+        applyUpdate(update);
+        return;
+    }
+    const std::int64_t beginNs = latencyNowNs();
+    applyUpdate(update);
+    m_trace->record(TraceStage::Queued, stamps->ingestNs + stamps->enqueueNs, m_batchDequeueNs, stamps->traceId,
+                    update.slot);
+    m_trace->record(TraceStage::Aggregate, beginNs, latencyNowNs(), stamps->traceId, update.slot);
+}
+
+// Publish spans of traced snapshots end once nothing of their pipeline is left buffered (like commitFlight)
+template <typename Queue>
+void BasicRedisWorker<Queue>::commitTrace() {
+    if (m_tracePending.empty() || m_redis.pendingCount() != 0) {
+        return;
+    }
+    const std::int64_t nowNs = latencyNowNs();
+    for (const TracedSnapshot& traced : m_tracePending) {
+        m_trace->record(TraceStage::Publish, traced.serializedNs, nowNs, traced.traceId, traced.slot);
+    }
+    m_tracePending.clear();
+}
+
+// Level of the oldest update's age, announced on the status channel when it changes
+template <typename Queue>
+void BasicRedisWorker<Queue>::checkLag(std::int64_t ageNs) {
+    const LagLevel current = m_lagLevel.load(std::memory_order_relaxed);
+    const std::int64_t warnNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.lag.warn).count();
+    const std::int64_t criticalNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.lag.critical).count();
+    LagLevel level = ageNs >= criticalNs ? LagLevel::Critical : ageNs >= warnNs ? LagLevel::Warn : LagLevel::Ok;
+    // REASON: Steps down only below half the current threshold - a lag hovering at it would flap
+    if (level < current && ageNs >= (current == LagLevel::Critical ? criticalNs : warnNs) / 2) {
+        level = current;
+    }
+    if (level == current) {
+        return;
+    }
+    m_lagLevel.store(level, std::memory_order_relaxed);
+    if (level > current) {
+        m_counters.lagAlerts.fetch_add(1, std::memory_order_relaxed);
+    }
+    const std::int64_t ageMs = ageNs / 1000000;
+    const std::size_t depth = m_queue.size_approx();
+    BRIDGE_LOG(level > current ? LogLevel::Warn : LogLevel::Info,
+               "[WORKER] Queue lag (shard {}): {} -> {} (oldest update {} ms old, {} queued)", m_config.shardId,
+               lagLevelName(current), lagLevelName(level), ageMs, depth);
+    try {
+        const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        serializeLagStatus(m_config.shardId, nowMs, lagLevelName(level), lagLevelName(current), ageMs, depth, m_json);
+        m_redis.publishBuffered(m_config.latency.statusChannel, m_json.data(), m_json.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+// Takes over the level set by setShedLevel and announces the change on the status channel
+template <typename Queue>
+void BasicRedisWorker<Queue>::applyShedLevel() {
+    const ShedLevel level = m_requestedShedLevel.load(std::memory_order_relaxed);
+    if (level == m_shedLevel) {
+        return;
+    }
+    const ShedLevel previous = m_shedLevel;
+    m_shedLevel = level;
+    if (level < ShedLevel::ConflateQuotes && !m_config.conflation.enabled) {
+        publishDirty();  // REASON: Quotes held by shedding go out now, conflation is off again
+    }
+    const std::int64_t queueAgeMs = std::chrono::duration_cast<std::chrono::milliseconds>(queueAge()).count();
+    std::cout << "[WORKER] Load shedding (shard " << m_config.shardId << "): " << shedLevelName(previous)
+              << " -> " << shedLevelName(level) << " (queue age " << queueAgeMs << " ms)\n";
+    try {
+        const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        serializeShedStatus(m_config.shardId, nowMs, level, previous, queueAgeMs, m_queue.size_approx(), m_json);
+        m_redis.publishBuffered(m_config.latency.statusChannel, m_json.data(), m_json.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::armTimers() {
+    const auto now = std::chrono::steady_clock::now();
+    m_timers = TimerWheel(now);
+    m_timers.arm(now + m_config.statsInterval, StatsTimer);
+    m_timers.arm(now + m_config.overflowLogInterval, OverflowTimer);
+    if (m_config.latency.enabled) {
+        m_timers.arm(now + m_config.latency.interval, LatencyTimer);
+    }
+    if (m_config.barBuilder.enabled) {
+        m_timers.arm(now, BarSweepTimer);
+    }
+    if (!m_chainSlots.empty()) {
+        m_timers.arm(now + m_config.options.interval, ChainTimer);
+    }
+    if (m_accountFeed) {
+        m_timers.arm(now + m_accountInterval, AccountTimer);
+    }
+    if (m_newsLane) {
+        m_timers.arm(now + m_newsLane->config.interval, NewsTimer);
+    }
+    if (m_movers) {
+        m_timers.arm(now + m_moversConfig.interval, MoversTimer);
+    }
+    if (m_config.deadband.enabled) {
+        m_timers.arm(now + kDeadbandSweep, DeadbandTimer);
+    }
+    if (!m_profiles.empty()) {
+        m_timers.arm(now + m_config.volumeProfile.interval, ProfileTimer);
+    }
+    if (!m_sessions.empty()) {
+        m_timers.arm(now + m_config.sessionStats.interval, SessionTimer);
+        armSessionRoll(now);
+    }
+    for (std::size_t i = 0; i < m_tiers.size(); ++i) {
+        m_tiers[i].nextAt = now + m_config.tiers[i].interval;
+        m_timers.arm(m_tiers[i].nextAt, TierTimer + static_cast<std::uint32_t>(i));
+    }
+}
+
+// PERFORMANCE: One clock read and a bitmap probe per loop iteration, whatever the number of timers
+template <typename Queue>
+void BasicRedisWorker<Queue>::runTimers() {
+    const auto now = std::chrono::steady_clock::now();
+    m_timers.advance(now, [this, now](std::uint32_t tag) { onTimer(tag, now); });
+}
+
+// Runs the expired timer's work and re-arms it (every worker timer is periodic)
+template <typename Queue>
+void BasicRedisWorker<Queue>::onTimer(std::uint32_t tag, std::chrono::steady_clock::time_point now) {
+    switch (tag) {
+    case StatsTimer:
+        reportStats(now);
+        m_timers.arm(now + m_config.statsInterval, StatsTimer);
+        return;
+    case LatencyTimer:
+        publishLatency(now);
+        m_timers.arm(now + m_config.latency.interval, LatencyTimer);
+        return;
+    case OverflowTimer:
+        logOverflow();
+        m_timers.arm(now + m_config.overflowLogInterval, OverflowTimer);
+        return;
+    case BarSweepTimer:
+        closeExpiredBars();
+        m_timers.arm(now + std::chrono::milliseconds(100), BarSweepTimer);  // PERFORMANCE: Sweep granularity
+        return;
+    case ChainTimer:
+        publishChains();
+        m_timers.arm(now + m_config.options.interval, ChainTimer);
+        return;
+    case AccountTimer:
+        publishAccount();
+        m_timers.arm(now + m_accountInterval, AccountTimer);
+        return;
+    case MoversTimer:
+        postMovers();
+        m_timers.arm(now + m_moversConfig.interval, MoversTimer);
+        return;
+    case DeadbandTimer:
+        publishHeld(now);
+        m_timers.arm(now + kDeadbandSweep, DeadbandTimer);
+        return;
+    case ProfileTimer:
+        publishProfiles();
+        m_timers.arm(now + m_config.volumeProfile.interval, ProfileTimer);
+        return;
+    case SessionTimer:
+        publishSessions();
+        m_timers.arm(now + m_config.sessionStats.interval, SessionTimer);
+        return;
+    case SessionRollTimer:
+        rollSessions();
+        armSessionRoll(now);
+        return;
+    case LiveBarTimer:
+        publishLiveBars();
+        m_timers.arm(now + m_config.liveBarInterval, LiveBarTimer);
+        return;
+    case NewsTimer:
+        publishNews();
+        m_timers.arm(now + m_newsLane->config.interval, NewsTimer);
+        return;
+    default:
+        break;
+    }
+    const std::size_t index = tag - TierTimer;
+    publishTier(index);
+    // REASON: Fixed cadence (consumers sample on whole intervals); after a stall restart from now
+    TierState& tier = m_tiers[index];
+    const auto interval = m_config.tiers[index].interval;
+    tier.nextAt = now - tier.nextAt >= interval ? now + interval : tier.nextAt + interval;
+    m_timers.arm(tier.nextAt, tag);
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::publishLatency(std::chrono::steady_clock::time_point now) {
+    const auto elapsed = now - m_latencyReportAt;
+    m_latencyReportAt = now;
+    
+    // REASON: Histograms are lifetime counts (the publisher's are written by its I/O thread) -
+    // an interval is the difference to the previous report, nothing is reset across threads
+    const LatencyHistogram* histograms[kLatencyStageCount] = {
+        &m_latency.ingest, &m_latency.queue, &m_latency.serialize,
+        &m_redis.latency().publish, &m_redis.latency().endToEnd};
+    for (std::size_t i = 0; i < kLatencyStageCount; ++i) {
+        histograms[i]->snapshot(m_latencyInterval);
+        m_latencyInterval.advance(m_latencyPrevious[i]);
+        m_lastLatency.stages[i] = LatencyReport::summarize(m_latencyInterval);
+    }
+    
+    try {
+        const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        serializeLatencyStatus(m_config.shardId, nowMs,
+                               std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(),
+                               m_lastLatency, m_json);
+        m_redis.publishBuffered(m_config.latency.statusChannel, m_json.data(), m_json.size());
+    } catch (const std::exception& e) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Error, "[WORKER] Redis publish error: {}", e.what());
+    }
+}
+
+template <typename Queue>
+void BasicRedisWorker<Queue>::reportStats(std::chrono::steady_clock::time_point now) {
+    auto elapsed = now - m_statsStart;
+    
+    // REASON: Median from the batch-size histogram (no per-batch sample storage)
+    std::size_t median = 0;
+    std::uint64_t seen = 0;
+    for (std::size_t size = 1; size < m_batchSizeCounts.size(); ++size) {
+        seen += m_batchSizeCounts[size];
+        if (seen * 2 >= m_batchCount && m_batchCount > 0) {
+            median = size;
+            break;
+        }
+    }
+    
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    m_lastStats.batchesPerSecond = m_batchCount / seconds;
+    m_lastStats.medianBatchSize = median;
+    m_lastStats.updates = m_updateCount;
+    
+    std::uint64_t published = m_counters.published.load(std::memory_order_relaxed);
+    std::uint64_t conflated = m_counters.conflated.load(std::memory_order_relaxed);
+    m_lastStats.published = published - m_publishedAtStart;
+    m_lastStats.conflated = conflated - m_conflatedAtStart;
+    m_publishedAtStart = published;
+    m_conflatedAtStart = conflated;
+    
+    std::uint64_t unchanged = m_counters.unchanged.load(std::memory_order_relaxed);
+    std::uint64_t duplicates = m_counters.duplicates.load(std::memory_order_relaxed);
+    m_lastStats.unchanged = unchanged - m_unchangedAtStart;
+    m_lastStats.duplicates = duplicates - m_duplicatesAtStart;
+    m_unchangedAtStart = unchanged;
+    m_duplicatesAtStart = duplicates;
+    
+    // REASON: Publisher backpressure surfaces here (Redis stalls show up as drops + backlog)
+    std::uint64_t dropped = m_redis.counters().dropped.load(std::memory_order_relaxed);
+    m_lastStats.redisDropped = dropped - m_droppedAtStart;
+    m_lastStats.redisInFlight = m_redis.inFlightBatches();
+    m_droppedAtStart = dropped;
+    
+    const OverflowCounters& overflow = m_shard.overflow;
+    std::uint64_t ingestDropped = overflow.dropped.load(std::memory_order_relaxed);
+    std::uint64_t ingestConflated = overflow.conflated.load(std::memory_order_relaxed);
+    std::uint64_t ingestSpilled = overflow.spilled.load(std::memory_order_relaxed);
+    std::uint64_t ingestSuperseded = overflow.superseded.load(std::memory_order_relaxed);
+    m_lastStats.ingestDropped = ingestDropped - m_ingestDroppedAtStart;
+    m_lastStats.ingestConflated = ingestConflated - m_ingestConflatedAtStart;
+    m_lastStats.ingestSpilled = ingestSpilled - m_ingestSpilledAtStart;
+    m_lastStats.ingestSuperseded = ingestSuperseded - m_ingestSupersededAtStart;
+    m_ingestDroppedAtStart = ingestDropped;
+    m_ingestConflatedAtStart = ingestConflated;
+    m_ingestSpilledAtStart = ingestSpilled;
+    m_ingestSupersededAtStart = ingestSuperseded;
+    
+    std::cout << "[WORKER] Shard " << m_config.shardId
+              << " | Batches: " << m_lastStats.batchesPerSecond << "/s"
+              << " | Median batch: " << median
+              << " | Updates: " << m_updateCount
+              << " | Published: " << m_lastStats.published
+              << " | Conflated: " << m_lastStats.conflated
+              << " | Suppressed unchanged/duplicate: " << m_lastStats.unchanged << "/" << m_lastStats.duplicates
+              << " | Redis in-flight: " << m_lastStats.redisInFlight
+              << " | Redis dropped: " << m_lastStats.redisDropped
+              << " | Ingest dropped/conflated/spilled: " << m_lastStats.ingestDropped
+              << "/" << m_lastStats.ingestConflated << "/" << m_lastStats.ingestSpilled
+              << " | Superseded: " << m_lastStats.ingestSuperseded << "\n";
+    
+    std::fill(m_batchSizeCounts.begin(), m_batchSizeCounts.end(), 0);
+    m_batchCount = 0;
+    m_updateCount = 0;
+    m_statsStart = now;
+}
+
+// REASON: Overflow is counted on the producer, reported here - no I/O on the callback thread
+template <typename Queue>
+void BasicRedisWorker<Queue>::logOverflow() {
+    const OverflowCounters& overflow = m_shard.overflow;
+    std::uint64_t dropped = overflow.dropped.load(std::memory_order_relaxed);
+    std::uint64_t conflated = overflow.conflated.load(std::memory_order_relaxed);
+    std::uint64_t spilled = overflow.spilled.load(std::memory_order_relaxed);
+    std::uint64_t total = dropped + conflated + spilled;
+    if (total == m_overflowLogged) {
+        return;
+    }
+    std::cerr << "[WORKER] Shard " << m_config.shardId << " ingest queue overflow: "
+              << (total - m_overflowLogged) << " updates since last warning (total dropped "
+              << dropped << ", conflated " << conflated << ", spilled " << spilled;
+    if (m_shard.trades) {
+        std::cerr << ", trades dropped " << overflow.tradesDropped.load(std::memory_order_relaxed);
+    }
+    std::cerr << ")\n";
+    m_overflowLogged = total;
+}
+
+template class BasicRedisWorker<MpmcTickQueue>;
+template class BasicRedisWorker<SpscTickQueue>;
+
+} // namespace tws_bridge
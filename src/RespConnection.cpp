@@ -0,0 +1,364 @@
+// RespConnection.cpp - Blocking socket I/O for direct RESP batches
+
+#include "RespConnection.h"
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+[[noreturn]] void fail(const std::string& what) {
+    throw std::runtime_error("RESP " + what + ": " + std::strerror(errno));
+}
+
+timeval toTimeval(std::chrono::milliseconds timeout) {
+    timeval value{};
+    value.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    value.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+    return value;
+}
+
+// Non-blocking connect bounded by timeout, socket left blocking
+bool connectWithin(int fd, const sockaddr* address, socklen_t length, std::chrono::milliseconds timeout) {
+    const int flags = ::fcntl(fd, F_GETFL, 0);
+    ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    int result = ::connect(fd, address, length);
+    if (result != 0 && errno == EINPROGRESS) {
+        // REASON: A signal (SamplingProfiler's SIGPROF) cuts the poll short - wait out the rest of the timeout
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        pollfd pfd{fd, POLLOUT, 0};
+        do {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            result = ::poll(&pfd, 1, static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0)));
+        } while (result < 0 && errno == EINTR);
+        if (result == 0) {
+            errno = ETIMEDOUT;
+            return false;
+        }
+        int error = 0;
+        socklen_t size = sizeof(error);
+        if (result < 0 || ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != 0) {
+            return false;
+        }
+        errno = error;
+        result = error == 0 ? 0 : -1;
+    }
+    ::fcntl(fd, F_SETFL, flags);
+    return result == 0;
+}
+
+} // namespace
+
+RespConnection::RespConnection(RedisEndpoint endpoint, RedisConnectionPolicy policy, long long streamMaxLen,
+                               bool approximateTrim)
+    : m_endpoint(std::move(endpoint))
+    , m_policy(policy)
+    , m_encoder(streamMaxLen, approximateTrim) {
+    m_input.resize(16 * 1024);
+    if (m_policy.respBackend == RespBackend::IoUring) {
+        std::string why;
+        m_ring = IoUring::create(8, why);  // REASON: A chain is 3 SQEs, one chain in flight
+        if (!m_ring) {
+            std::cerr << "[REDIS] io_uring unavailable (" << why << "), direct RESP uses blocking sockets\n";
+        }
+        m_timeout.tv_sec = m_policy.socketTimeout.count() / 1000;
+        m_timeout.tv_nsec = (m_policy.socketTimeout.count() % 1000) * 1000000;
+    }
+}
+
+RespConnection::~RespConnection() {
+    close();
+}
+
+void RespConnection::send(const PublishMessage* messages, std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (!isOpen()) {
+        open();
+    }
+    m_encoder.clear();
+    std::size_t replies = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        replies += m_encoder.append(messages[i]);
+    }
+    std::string firstError;
+    std::size_t errors = 0;
+    try {
+        // PERFORMANCE: The whole batch in one send() - replies are read after, in bulk
+        errors = roundTrip(replies, firstError);
+    } catch (...) {
+        close();  // REASON: Replies may still be in flight - the stream is out of sync
+        throw;
+    }
+    // NOTE: Connection kept - every reply was consumed, the next batch starts in sync
+    if (errors > 0) {
+        throw std::runtime_error("Redis error reply (" + std::to_string(errors) + "): " + firstError);
+    }
+}
+
+void RespConnection::open() {
+    close();
+    connectSocket();
+    m_encoder.clear();
+    std::size_t replies = 0;
+    if (!m_endpoint.password.empty()) {
+        replies += m_encoder.appendCommand({"AUTH", m_endpoint.password});
+    }
+    if (m_endpoint.db != 0) {
+        replies += m_encoder.appendCommand({"SELECT", std::to_string(m_endpoint.db)});
+    }
+    if (replies == 0) {
+        return;
+    }
+    std::string firstError;
+    try {
+        if (roundTrip(replies, firstError) > 0) {
+            throw std::runtime_error("Redis connection setup: " + firstError);
+        }
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+void RespConnection::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_unsentLength = 0;
+}
+
+std::size_t RespConnection::roundTrip(std::size_t expected, std::string& firstError) {
+    if (!m_ring) {
+        writeAll(m_encoder.buffer());
+        return readReplies(expected, firstError);
+    }
+    // REASON: Queued only - the first read submits it, linked ahead of the recv
+    m_unsent = m_encoder.buffer().data();
+    m_unsentLength = m_encoder.buffer().size();
+    return readReplies(expected, firstError);
+}
+
+void RespConnection::connectSocket() {
+    if (m_endpoint.unixSocket) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (m_endpoint.path.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("RESP connect: unix socket path too long");
+        }
+        std::memcpy(address.sun_path, m_endpoint.path.c_str(), m_endpoint.path.size() + 1);
+        m_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (m_fd < 0 || !connectWithin(m_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address),
+                                       m_policy.connectTimeout)) {
+            const int error = errno;
+            close();
+            errno = error;
+            fail("connect " + m_endpoint.path);
+        }
+    } else {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* found = nullptr;
+        const std::string port = std::to_string(m_endpoint.port);
+        if (::getaddrinfo(m_endpoint.host.c_str(), port.c_str(), &hints, &found) != 0 || !found) {
+            throw std::runtime_error("RESP connect: cannot resolve " + m_endpoint.host);
+        }
+        int error = 0;
+        for (addrinfo* candidate = found; candidate && m_fd < 0; candidate = candidate->ai_next) {
+            m_fd = ::socket(candidate->ai_family, candidate->ai_socktype | SOCK_CLOEXEC, candidate->ai_protocol);
+            if (m_fd >= 0 && !connectWithin(m_fd, candidate->ai_addr, candidate->ai_addrlen, m_policy.connectTimeout)) {
+                error = errno;
+                close();
+            }
+        }
+        ::freeaddrinfo(found);
+        if (m_fd < 0) {
+            errno = error;
+            fail("connect " + m_endpoint.host + ":" + port);
+        }
+        // REASON: Same as hiredis - a batch is one write, waiting for an ACK only adds latency
+        const int one = 1;
+        ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        if (m_policy.keepAlive) {
+            ::setsockopt(m_fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+        }
+    }
+    if (m_ring && m_registeredInput != m_input.data()) {
+        registerInput();
+    }
+    // Per round trip bound, like redis++ socket_timeout
+    const timeval timeout = toTimeval(m_policy.socketTimeout);
+    ::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(m_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+void RespConnection::writeAll(const std::string& bytes) {
+    std::size_t sent = 0;
+    while (sent < bytes.size()) {
+        // PITFALL: MSG_NOSIGNAL - a closed peer must surface as EPIPE, not kill the process
+        const ssize_t result = ::send(m_fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fail("send");
+        }
+        sent += static_cast<std::size_t>(result);
+    }
+}
+
+std::size_t RespConnection::readReplies(std::size_t expected, std::string& firstError) {
+    std::size_t filled = 0;
+    std::size_t start = 0;         // First byte of the partial reply
+    std::size_t replies = 0;
+    std::size_t errors = 0;
+    while (replies < expected) {
+        if (filled == m_input.size()) {
+            if (start > 0) {
+                std::memmove(m_input.data(), m_input.data() + start, filled - start);
+                filled -= start;
+                start = 0;
+            } else {
+                m_input.resize(m_input.size() * 2);  // REASON: One reply larger than the buffer
+                registerInput();
+            }
+        }
+        const ssize_t received = receive(m_input.data() + filled, m_input.size() - filled);
+        if (received <= 0) {
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received == 0) {
+                errno = ECONNRESET;
+            }
+            fail(received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) ? "reply timeout" : "recv");
+        }
+        filled += static_cast<std::size_t>(received);
+        const RespScan scan = scanRespReplies(m_input.data() + start, filled - start, expected - replies);
+        if (scan.malformed) {
+            throw std::runtime_error("RESP protocol error in reply");
+        }
+        if (scan.errors > 0 && errors == 0) {
+            firstError.assign(scan.firstError.data(), scan.firstError.size());
+        }
+        errors += scan.errors;
+        replies += scan.replies;
+        start += scan.consumed;
+    }
+    return errors;
+}
+
+ssize_t RespConnection::receive(char* into, std::size_t length) {
+    return m_ring ? ringReceive(into, length) : ::recv(m_fd, into, length, 0);
+}
+
+ssize_t RespConnection::ringReceive(char* into, std::size_t length) {
+    enum : std::uint64_t { kSend = 1, kRecv, kTimeout };
+    for (;;) {
+        unsigned queued = 0;
+        if (m_unsentLength > 0) {
+            io_uring_sqe* send = m_ring->nextSqe();
+            send->opcode = IORING_OP_SEND;
+            send->fd = m_fd;
+            send->addr = reinterpret_cast<std::uint64_t>(m_unsent);
+            send->len = static_cast<std::uint32_t>(m_unsentLength);
+            send->msg_flags = MSG_NOSIGNAL;  // PITFALL: Same as writeAll (WRITE_FIXED cannot suppress SIGPIPE)
+            send->flags = IOSQE_IO_LINK;     // Read starts once the whole batch is sent
+            send->user_data = kSend;
+            ++queued;
+        }
+        io_uring_sqe* recv = m_ring->nextSqe();
+        const bool fixed = m_registeredInput && into >= m_registeredInput
+                           && into + length <= m_registeredInput + m_registeredLength;
+        // PERFORMANCE: Registered buffer - the kernel skips pinning / mapping the pages per read
+        recv->opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_RECV;
+        recv->fd = m_fd;
+        recv->addr = reinterpret_cast<std::uint64_t>(into);
+        recv->len = static_cast<std::uint32_t>(length);
+        recv->buf_index = 0;
+        recv->flags = IOSQE_IO_LINK;
+        recv->user_data = kRecv;
+        io_uring_sqe* timeout = m_ring->nextSqe();
+        timeout->opcode = IORING_OP_LINK_TIMEOUT;
+        timeout->addr = reinterpret_cast<std::uint64_t>(&m_timeout);
+        timeout->len = 1;
+        timeout->user_data = kTimeout;
+        queued += 2;
+
+        if (!m_ring->submitAndWait(queued)) {
+            return -1;
+        }
+        int sent = 0;
+        int received = 0;
+        bool timedOut = false;
+        unsigned completed = 0;
+        while (completed < queued) {
+            completed += m_ring->drain([&](const io_uring_cqe& cqe) {
+                if (cqe.user_data == kSend) {
+                    sent = cqe.res;
+                } else if (cqe.user_data == kRecv) {
+                    received = cqe.res;
+                } else {
+                    timedOut = cqe.res == -ETIME;
+                }
+            });
+            if (completed < queued && !m_ring->submitAndWait(queued - completed)) {
+                return -1;
+            }
+        }
+        if (m_unsentLength > 0) {
+            if (sent < 0) {
+                errno = -sent;
+                return -1;
+            }
+            // REASON: A short send breaks the chain (recv cancelled) - the rest goes out next pass
+            m_unsent += sent;
+            m_unsentLength -= static_cast<std::size_t>(sent);
+        }
+        if (received >= 0) {
+            return received;
+        }
+        if (received == -ECANCELED && !timedOut) {
+            continue;  // Cancelled by the short send above
+        }
+        if (received == -EINTR) {
+            continue;
+        }
+        errno = received == -ECANCELED ? EAGAIN : -received;  // REASON: Timed out - reported like SO_RCVTIMEO
+        return -1;
+    }
+}
+
+void RespConnection::registerInput() {
+    if (!m_ring) {
+        return;
+    }
+    const iovec buffer{m_input.data(), m_input.size()};
+    if (m_ring->registerBuffers(&buffer, 1)) {
+        m_registeredInput = m_input.data();
+        m_registeredLength = m_input.size();
+    } else {
+        m_registeredInput = nullptr;  // REASON: RLIMIT_MEMLOCK etc. - plain RECV works the same, minus the pinning
+        m_registeredLength = 0;
+    }
+}
+
+} // namespace tws_bridge
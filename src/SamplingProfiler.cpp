@@ -0,0 +1,320 @@
+// SamplingProfiler.cpp - SIGPROF handler, stack folding and the folded-stack file / Redis key
+
+#include "SamplingProfiler.h"
+#include "ProfilerSignal.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: Older glibc headers only name the union member
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace tws_bridge {
+
+namespace {
+
+// ========== Shared with the SIGPROF handler (async-signal-safe: atomics and plain stores only) ==========
+std::atomic<bool> g_claimed{false};                 // A SamplingProfiler owns SIGPROF
+std::atomic<bool> g_armed{false};
+ProfileSample* g_samples = nullptr;                 // Set before g_armed (release), read after it (acquire)
+std::size_t g_capacity = 0;
+std::atomic<std::size_t> g_next{0};
+
+// Frames 0 and 1 of every sample: the handler and the kernel's signal trampoline
+constexpr int kSkipFrames = 2;
+
+void onSigprof(int /*signal*/, siginfo_t* /*info*/, void* /*context*/) {
+    if (!g_armed.load(std::memory_order_acquire)) {
+        return;  // NOTE: A tick already pending when the timer was disarmed
+    }
+    const int savedErrno = errno;
+    const std::size_t index = g_next.fetch_add(1, std::memory_order_relaxed);
+    if (index < g_capacity) {
+        ProfileSample& sample = g_samples[index];
+        sample.tid = static_cast<std::int32_t>(syscall(SYS_gettid));
+        sample.depth = backtrace(sample.frames, ProfileSample::kMaxFrames);
+        sample.ready.store(true, std::memory_order_release);
+    }
+    errno = savedErrno;
+}
+
+// One timer per profiled thread on that thread's CPU-time clock, signalling that thread only
+// REASON: Not ITIMER_PROF - its SIGPROF goes to any thread that does not block it, and a tick landing on
+// an idle profiled thread would be charged the CPU the others burned
+std::vector<timer_t> armProfileTimers(int frequency) {
+    const long intervalNs = std::max(1000000000L / std::max(frequency, 1), 1000L);
+    itimerspec spec{};
+    spec.it_interval.tv_sec = intervalNs / 1000000000L;
+    spec.it_interval.tv_nsec = intervalNs % 1000000000L;
+    spec.it_value = spec.it_interval;
+    std::vector<timer_t> timers;
+    for (const ProfiledThread& thread : profiledThreads()) {
+        sigevent event{};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = thread.tid;
+        timer_t timer;
+        if (timer_create(thread.clock, &event, &timer) != 0) {
+            continue;  // NOTE: Exited since the snapshot
+        }
+        timer_settime(timer, 0, &spec, nullptr);
+        timers.push_back(timer);
+    }
+    return timers;
+}
+
+void disarmProfileTimers(const std::vector<timer_t>& timers) {
+    for (timer_t timer : timers) {
+        timer_delete(timer);
+    }
+}
+
+std::string threadName(std::int32_t tid) {
+    std::ifstream in("/proc/self/task/" + std::to_string(tid) + "/comm");
+    std::string name;
+    if (!std::getline(in, name) || name.empty()) {
+        return "tid-" + std::to_string(tid);  // NOTE: Exited since the sample
+    }
+    return name;
+}
+
+// Demangled symbol ("tws_bridge::RedisWorker::run()"), else module+offset ("libc.so.6+0x9a1c3")
+std::string frameName(void* pc) {
+    Dl_info info{};
+    char text[64];
+    if (dladdr(pc, &info) == 0) {
+        std::snprintf(text, sizeof(text), "%p", pc);
+        return text;
+    }
+    std::string name;
+    if (info.dli_sname) {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        name = status == 0 && demangled ? demangled : info.dli_sname;
+        std::free(demangled);
+    } else {
+        const char* module = info.dli_fname ? info.dli_fname : "?";
+        if (const char* slash = std::strrchr(module, '/')) {
+            module = slash + 1;
+        }
+        std::snprintf(text, sizeof(text), "+0x%zx",
+                      static_cast<std::size_t>(static_cast<char*>(pc) - static_cast<char*>(info.dli_fbase)));
+        name = std::string(module) + text;
+    }
+    std::replace(name.begin(), name.end(), ';', ':');  // REASON: ';' separates the frames of a folded line
+    return name;
+}
+
+} // namespace
+
+std::string formatFoldedStacks(const std::map<std::string, std::uint64_t>& stacks) {
+    std::string out;
+    for (const auto& [stack, count] : stacks) {
+        out += stack;
+        out += ' ';
+        out += std::to_string(count);
+        out += '\n';
+    }
+    return out;
+}
+
+SamplingProfiler::SamplingProfiler(const std::string& redisUri, const ProfilerConfig& config)
+    : m_redisUri(redisUri)
+    , m_config(config)
+    , m_owner(!g_claimed.exchange(true)) {
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    stop();
+    if (m_owner) {
+        g_claimed.store(false);
+    }
+}
+
+void SamplingProfiler::start() {
+    if (m_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = false;
+    }
+    if (m_owner) {
+        // NOTE: Installed for good - SIGPROF's default action kills the process, a late tick (or a stray
+        // kill -PROF) must find a handler; it ignores every tick outside a profile
+        struct sigaction action{};
+        action.sa_sigaction = onSigprof;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGPROF, &action, nullptr);
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void SamplingProfiler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool SamplingProfiler::request(std::chrono::seconds duration, std::string& error) {
+    if (!m_owner) {
+        error = "another profiler owns SIGPROF";
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_busy) {
+            error = "a profile is already running";
+            return false;
+        }
+        m_busy = true;
+        m_duration = std::min(duration.count() > 0 ? duration : m_config.defaultDuration, m_config.maxDuration);
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+std::string SamplingProfiler::lastProfile() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastProfile;
+}
+
+void SamplingProfiler::run() {
+    nameCurrentThread("tws-profiler");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this]() { return m_duration.count() > 0 || m_stopping; });
+        if (m_duration.count() == 0) {
+            return;
+        }
+        const std::chrono::seconds duration = m_duration;
+        lock.unlock();
+        profile(duration);
+        lock.lock();
+        m_duration = std::chrono::seconds(0);
+        m_busy = false;
+    }
+}
+
+void SamplingProfiler::profile(std::chrono::seconds duration) {
+    const std::size_t capacity = std::max<std::size_t>(m_config.maxSamples, 1);
+    if (!m_samples) {
+        m_samples = std::make_unique<ProfileSample[]>(capacity);
+    }
+    for (std::size_t i = 0; i < capacity; ++i) {
+        m_samples[i].ready.store(false, std::memory_order_relaxed);
+    }
+    // REASON: The first backtrace() loads libgcc_s (dlopen + malloc) - never let that happen in the handler
+    void* warm[4];
+    backtrace(warm, 4);
+
+    g_samples = m_samples.get();
+    g_capacity = capacity;
+    g_next.store(0, std::memory_order_relaxed);
+    g_armed.store(true, std::memory_order_release);
+    const std::vector<timer_t> timers = armProfileTimers(m_config.frequency);
+    std::cout << "[PROFILER] Sampling " << timers.size() << " threads at " << m_config.frequency << " Hz for "
+              << duration.count() << "s\n";
+
+    {
+        // NOTE: stop() ends the profile early - what was sampled so far is still written
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait_for(lock, duration, [this]() { return m_stopping; });
+    }
+    disarmProfileTimers(timers);
+    g_armed.store(false, std::memory_order_release);
+
+    const std::size_t claimed = g_next.load(std::memory_order_relaxed);
+    const std::size_t count = std::min(claimed, capacity);
+    m_samplesTaken.fetch_add(count, std::memory_order_relaxed);
+    m_dropped.fetch_add(claimed - count, std::memory_order_relaxed);
+    if (claimed > capacity) {
+        std::cerr << "[PROFILER] " << (claimed - capacity) << " samples dropped (profiler.max_samples "
+                  << capacity << ")\n";
+    }
+    write(formatFoldedStacks(fold(count)), count);
+}
+
+// "thread;outermost;...;innermost" → samples
+std::map<std::string, std::uint64_t> SamplingProfiler::fold(std::size_t count) {
+    std::unordered_map<void*, std::string> symbols;
+    std::unordered_map<std::int32_t, std::string> threads;
+    std::map<std::string, std::uint64_t> stacks;
+    std::string stack;
+    for (std::size_t i = 0; i < count; ++i) {
+        const ProfileSample& sample = m_samples[i];
+        if (!sample.ready.load(std::memory_order_acquire)) {
+            continue;  // NOTE: Claimed by a handler that has not finished - rare, at the disarm edge
+        }
+        auto thread = threads.find(sample.tid);
+        if (thread == threads.end()) {
+            thread = threads.emplace(sample.tid, threadName(sample.tid)).first;
+        }
+        stack = thread->second;
+        for (int frame = sample.depth - 1; frame >= kSkipFrames; --frame) {
+            // REASON: Callers' frames hold return addresses - one byte back lands inside the call's function
+            void* pc = frame > kSkipFrames ? static_cast<char*>(sample.frames[frame]) - 1 : sample.frames[frame];
+            auto symbol = symbols.find(pc);
+            if (symbol == symbols.end()) {
+                symbol = symbols.emplace(pc, frameName(pc)).first;
+            }
+            stack += ';';
+            stack += symbol->second;
+        }
+        ++stacks[stack];
+    }
+    return stacks;
+}
+
+void SamplingProfiler::write(const std::string& folded, std::size_t count) {
+    const std::int64_t epochMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string path = m_config.dir + "/profile-" + std::to_string(epochMs) + ".folded";
+    std::ofstream out(path, std::ios::trunc);
+    if (out) {
+        out << folded;
+        out.close();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_lastProfile = path;
+        }
+        std::cout << "[PROFILER] " << count << " samples written to " << path << "\n";
+    } else {
+        std::cerr << "[PROFILER] Cannot write " << path << "\n";
+    }
+    if (!m_config.key.empty()) {
+        try {
+            sw::redis::Redis redis(m_redisUri);
+            redis.set(m_config.key, folded);
+            std::cout << "[PROFILER] Folded stacks stored under " << m_config.key << "\n";
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[PROFILER] Cannot store " << m_config.key << ": " << e.what() << "\n";
+        }
+    }
+    m_profiles.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,166 @@
+// SessionReport.cpp - Session report thread and its two targets (Redis hash, JSON file)
+
+#include "SessionReport.h"
+#include "AsyncLogger.h"
+#include "Serialization.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+std::int64_t wallClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Writes path.tmp, then renames it over path (a crash never leaves a truncated report)
+bool writeReportFile(const std::string& path, const JsonBuffer& json, std::string& error) {
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::trunc | std::ios::binary);
+        if (!out || !out.write(json.data(), static_cast<std::streamsize>(json.size())) || !(out << '\n').flush()) {
+            error = temporary + ": write failed";
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        error = path + ": rename failed";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SessionReporter::SessionReporter(const std::string& uri, SessionReportConfig config, Collect collect,
+                                 CollectHistograms histograms)
+    : m_uri(uri)
+    , m_config(std::move(config))
+    , m_collect(std::move(collect))
+    , m_collectHistograms(std::move(histograms))
+    , m_lifetime(std::make_unique<SessionHistograms>()) {
+}
+
+SessionReporter::~SessionReporter() {
+    stop();
+}
+
+void SessionReporter::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    SessionSample sample;
+    m_collect(sample);
+    m_collectHistograms(*m_lifetime);
+    m_accumulator.begin(wallClockMs(), std::chrono::duration_cast<std::chrono::milliseconds>(m_config.sessionReset).count(),
+                        sample, *m_lifetime);
+    m_begun = true;
+    m_thread = std::thread([this]() { run(); });
+}
+
+void SessionReporter::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SessionReporter::finish() {
+    stop();
+    if (!m_begun) {
+        return;
+    }
+    m_begun = false;  // REASON: Once - the destructor or a second call must not write it again
+    SessionSample sample;
+    m_collect(sample);
+    m_collectHistograms(*m_lifetime);
+    write(m_accumulator.finish(wallClockMs(), sample, *m_lifetime, false));
+}
+
+void SessionReporter::run() {
+    nameCurrentThread("tws-report");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    SessionSample previous;
+    m_collect(previous);
+    auto sampledAt = std::chrono::steady_clock::now();
+    while (m_running.load()) {
+        pause(m_config.interval);
+        if (!m_running.load()) {
+            break;
+        }
+        SessionSample current;
+        m_collect(current);
+        const auto now = std::chrono::steady_clock::now();
+        m_accumulator.observe(makeStatusReport(previous.status, current.status, now - sampledAt));
+        previous = current;
+        sampledAt = now;
+        const std::int64_t nowMs = wallClockMs();
+        if (m_accumulator.rolled(nowMs)) {
+            // PERFORMANCE: The only histogram copies of the day - one per stage at the boundary
+            m_collectHistograms(*m_lifetime);
+            write(m_accumulator.finish(nowMs, current, *m_lifetime, true));
+            m_accumulator.next();
+        }
+    }
+}
+
+// NOTE: Both targets are tried - a Redis outage at the boundary still leaves the file (and the reverse)
+void SessionReporter::write(const SessionReport& report) {
+    const std::string id = sessionReportId(report);
+    std::string file;
+    bool failed = false;
+    if (!m_config.directory.empty()) {
+        JsonBuffer json;
+        serializeSessionReport(report, json);
+        std::error_code created;
+        std::filesystem::create_directories(m_config.directory, created);
+        file = m_config.directory + "/session-" + id + ".json";
+        std::string error;
+        if (!writeReportFile(file, json, error)) {
+            std::cerr << "[REPORT] " << error << "\n";
+            file.clear();
+            failed = true;
+        }
+    }
+    if (!m_config.keyPrefix.empty()) {
+        try {
+            // REASON: Dedicated short-lived connection - one report per session is not worth a standing one
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.connect_timeout = m_config.socketTimeout;
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+            const std::string key = m_config.keyPrefix + id;
+            const auto fields = sessionReportFields(report, file);
+            auto pipe = redis.pipeline(false);
+            pipe.hset(key, fields.begin(), fields.end());
+            if (m_config.retention.count() > 0) {
+                pipe.expire(key, std::chrono::duration_cast<std::chrono::seconds>(m_config.retention));
+            }
+            pipe.exec();
+        } catch (const sw::redis::Error& e) {
+            BRIDGE_LOG(LogLevel::Error, "[REPORT] Session {} not stored in Redis: {}", id, e.what());
+            failed = true;
+        }
+    }
+    (failed ? m_counters.errors : m_counters.written).fetch_add(1, std::memory_order_relaxed);
+    std::cout << "[REPORT] Session " << id << ": " << report.ticksIn << " ticks in, peak "
+              << static_cast<std::uint64_t>(report.peakTicksIn) << "/s, end-to-end p99 "
+              << report.histograms[static_cast<std::size_t>(SessionHistogram::EndToEnd)].valueAt(99.0) / 1000
+              << " us" << (file.empty() ? "" : ", " + file) << "\n";
+}
+
+} // namespace tws_bridge
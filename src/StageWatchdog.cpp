@@ -0,0 +1,123 @@
+// StageWatchdog.cpp - Watchdog thread: stall reports, stack dumps, status events
+
+#include "StageWatchdog.h"
+#include "AsyncLogger.h"
+#include "Serialization.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <execinfo.h>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+namespace tws_bridge {
+
+namespace {
+
+// Runs on the stalled thread itself - the only portable way to walk its stack
+// PITFALL: backtrace() is not formally async-signal-safe; it is primed once in installStackDump() so
+// the handler never loads libgcc (the allocation that makes it unsafe), and writes straight to fd 2
+extern "C" void dumpStackHandler(int) {
+    void* frames[64];
+    const int depth = ::backtrace(frames, 64);
+    ::backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+}
+
+void installStackDump() {
+    static std::once_flag installed;
+    std::call_once(installed, []() {
+        void* prime[1];
+        ::backtrace(prime, 1);
+        struct sigaction action{};
+        action.sa_handler = dumpStackHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        ::sigaction(SIGUSR2, &action, nullptr);
+    });
+}
+
+} // namespace
+
+StageWatchdog::~StageWatchdog() {
+    stop();
+}
+
+void StageWatchdog::start() {
+    if (m_watched.empty() || m_running.exchange(true)) {
+        return;
+    }
+    if (m_config.stackDump) {
+        installStackDump();
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void StageWatchdog::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void StageWatchdog::run() {
+    nameCurrentThread("tws-watchdog");
+    std::cout << "[WATCHDOG] Watching " << m_watched.size() << " stages (stall after " << m_config.stallAfter.count()
+              << " ms)\n";
+    // REASON: Sleep in short steps so stop() stays responsive
+    const auto step = std::min(m_config.interval, std::chrono::milliseconds(100));
+    auto nextCheck = Clock::now();
+    while (m_running.load()) {
+        std::this_thread::sleep_for(step);
+        const auto now = Clock::now();
+        if (now < nextCheck) {
+            continue;
+        }
+        nextCheck = now + m_config.interval;
+        check(now,
+              [this](Watched& watched, Clock::duration silentFor) {
+                  if (m_config.stackDump && watched.heartbeat->attached()) {
+                      std::cerr << "[WATCHDOG] Stack of the stalled " << stageName(watched.stage) << " thread:\n";
+                      ::pthread_kill(watched.heartbeat->thread(), SIGUSR2);
+                  }
+                  report(watched, true, silentFor);
+                  if (m_config.reconnect && watched.recover) {
+                      std::cerr << "[WATCHDOG] Forcing a reconnect of connection " << watched.index << "\n";
+                      watched.recover();
+                  }
+              },
+              [this](Watched& watched) { report(watched, false, Clock::duration::zero()); });
+    }
+    std::cout << "[WATCHDOG] Stopped\n";
+}
+
+// Log line + status event
+// NOTE: Own short-lived connection per event - stalls are rare, and the worker's publisher may be the stalled stage
+void StageWatchdog::report(const Watched& watched, bool stalled, Clock::duration silentFor) {
+    const std::int64_t silentMs = std::chrono::duration_cast<std::chrono::milliseconds>(silentFor).count();
+    if (stalled) {
+        BRIDGE_LOG(LogLevel::Error, "[WATCHDOG] {} {} stalled: no heartbeat for {} ms", stageName(watched.stage),
+                   watched.index, silentMs);
+    } else {
+        BRIDGE_LOG(LogLevel::Warn, "[WATCHDOG] {} {} running again", stageName(watched.stage), watched.index);
+    }
+    if (m_redisUri.empty() || m_config.statusChannel.empty()) {
+        return;
+    }
+    try {
+        JsonBuffer json;
+        const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        serializeStallStatus(stalled, stageName(watched.stage), watched.index, nowMs, silentMs, json);
+        sw::redis::ConnectionOptions opts(m_redisUri);
+        opts.connect_timeout = std::chrono::milliseconds(500);
+        opts.socket_timeout = std::chrono::milliseconds(500);  // REASON: A stalled Redis must not stall the watchdog
+        sw::redis::Redis redis(opts);
+        redis.publish(m_config.statusChannel, sw::redis::StringView(json.data(), json.size()));
+    } catch (const sw::redis::Error& e) {
+        BRIDGE_LOG_EVERY_MS(10000, LogLevel::Error, "[WATCHDOG] Status event not published: {}", e.what());
+    }
+}
+
+} // namespace tws_bridge
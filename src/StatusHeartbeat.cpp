@@ -0,0 +1,85 @@
+// StatusHeartbeat.cpp - Periodic TWS:STATUS heartbeat implementation
+
+#include "StatusHeartbeat.h"
+#include "AsyncLogger.h"
+#include "Serialization.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+StatusHeartbeat::StatusHeartbeat(const std::string& uri, StatusConfig config, Collect collect)
+    : m_uri(uri)
+    , m_config(std::move(config))
+    , m_collect(std::move(collect)) {
+}
+
+StatusHeartbeat::~StatusHeartbeat() {
+    stop();
+}
+
+void StatusHeartbeat::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void StatusHeartbeat::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void StatusHeartbeat::run() {
+    nameCurrentThread("tws-status");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    JsonBuffer json;
+    StatusSample previous;
+    m_collect(previous);
+    auto sampledAt = std::chrono::steady_clock::now();
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - the heartbeat must not queue behind (or stall with) a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.connect_timeout = m_config.socketTimeout;
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+            while (m_running.load()) {
+                pause(m_config.interval);
+                if (!m_running.load()) {
+                    break;
+                }
+                StatusSample current;
+                m_collect(current);
+                const auto now = std::chrono::steady_clock::now();
+                const StatusReport report = makeStatusReport(previous, current, now - sampledAt);
+                previous = current;
+                sampledAt = now;
+                const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                serializeHeartbeatStatus(nowMs, report, json);
+                redis.publish(m_config.channel, sw::redis::StringView(json.data(), json.size()));
+                m_counters.published.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (const sw::redis::Error& e) {
+            // NOTE: Rates resume from the last sample - the next heartbeat covers the outage as one long interval
+            BRIDGE_LOG_EVERY_MS(10000, LogLevel::Error, "[STATUS] Heartbeat not published: {}", e.what());
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            pause(m_config.reconnectDelay);
+        }
+    }
+}
+
+} // namespace tws_bridge
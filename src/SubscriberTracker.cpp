@@ -0,0 +1,97 @@
+// SubscriberTracker.cpp - PUBSUB NUMSUB prober implementation
+
+#include "SubscriberTracker.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+SubscriberTracker::SubscriberTracker(const std::string& uri, const InstrumentRegistry& registry,
+                                     SubscriberTrackerConfig config)
+    : m_uri(uri)
+    , m_registry(registry)
+    , m_config(std::move(config))
+    , m_table(registry.capacity()) {
+}
+
+SubscriberTracker::~SubscriberTracker() {
+    stop();
+}
+
+void SubscriberTracker::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void SubscriberTracker::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SubscriberTracker::run() {
+    nameCurrentThread("tws-watch");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    std::vector<std::string> args;
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - probes never queue behind a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+
+            while (m_running.load()) {
+                // NOTE: Slots registered mid-pass are picked up by the next one (they start watched)
+                const std::size_t registered = m_registry.size();
+                std::uint64_t watched = 0;
+                for (std::size_t first = 0; first < registered; first += m_config.slotsPerProbe) {
+                    const std::size_t last = std::min(registered, first + m_config.slotsPerProbe);
+                    args.assign({"PUBSUB", "NUMSUB"});
+                    for (std::size_t slot = first; slot < last; ++slot) {
+                        const InstrumentChannels& channels = m_registry.channels(static_cast<SlotId>(slot));
+                        args.push_back(channels.ticks);
+                        args.push_back(channels.binaryTicks);
+                    }
+                    // Reply: [channel, count, channel, count, ...] in argument order
+                    sw::redis::ReplyUPtr reply = redis.command(args.begin(), args.end());
+                    if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 * 2 * (last - first)) {
+                        throw sw::redis::Error("Unexpected PUBSUB NUMSUB reply");
+                    }
+                    for (std::size_t slot = first; slot < last; ++slot) {
+                        const std::size_t at = 4 * (slot - first);
+                        const bool subscribed = reply->element[at + 1]->integer > 0 || reply->element[at + 3]->integer > 0;
+                        m_table.update(static_cast<SlotId>(slot), subscribed);
+                        watched += subscribed ? 1 : 0;
+                    }
+                }
+                m_table.publish();
+                m_counters.watched.store(watched, std::memory_order_relaxed);
+                m_counters.probes.fetch_add(1, std::memory_order_relaxed);
+                pause(m_config.probeInterval);
+            }
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[WATCH] Redis error: " << e.what() << ", publishing every symbol, retrying in "
+                      << m_config.reconnectDelay.count() << "ms\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            m_table.markAllWatched();
+            pause(m_config.reconnectDelay);
+        }
+    }
+    std::cout << "[WATCH] Subscriber tracker stopped\n";
+}
+
+} // namespace tws_bridge
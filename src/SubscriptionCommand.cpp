@@ -0,0 +1,142 @@
+// SubscriptionCommand.cpp - TWS:COMMANDS parser (RapidJSON DOM, cold path)
+
+#include "SubscriptionCommand.h"
+#include "rapidjson/document.h"
+
+namespace tws_bridge {
+
+namespace {
+
+// Copies an optional string member, false if present but not a string
+bool readString(const rapidjson::Document& doc, const char* name, std::string& out, std::string& error) {
+    auto it = doc.FindMember(name);
+    if (it == doc.MemberEnd() || it->value.IsNull()) {
+        return true;  // Keep the default
+    }
+    if (!it->value.IsString()) {
+        error = std::string("\"") + name + "\" must be a string";
+        return false;
+    }
+    out.assign(it->value.GetString(), it->value.GetStringLength());
+    return true;
+}
+
+// Copies an optional numeric member, false if present but not a number
+bool readDouble(const rapidjson::Document& doc, const char* name, double& out, std::string& error) {
+    auto it = doc.FindMember(name);
+    if (it == doc.MemberEnd() || it->value.IsNull()) {
+        return true;
+    }
+    if (!it->value.IsNumber()) {
+        error = std::string("\"") + name + "\" must be a number";
+        return false;
+    }
+    out = it->value.GetDouble();
+    return true;
+}
+
+} // namespace
+
+bool parseSubscriptionCommand(const char* data, std::size_t length, SubscriptionCommand& out, std::string& error) {
+    rapidjson::Document doc;
+    doc.Parse(data, length);
+    if (doc.HasParseError() || !doc.IsObject()) {
+        error = "invalid JSON object";
+        return false;
+    }
+
+    std::string action;
+    if (!readString(doc, "action", action, error)) {
+        return false;
+    }
+    if (action == "subscribe") {
+        out.action = CommandAction::Subscribe;
+    } else if (action == "unsubscribe") {
+        out.action = CommandAction::Unsubscribe;
+    } else if (action == "interest") {
+        out.action = CommandAction::Interest;
+    } else if (action == "release") {
+        out.action = CommandAction::Release;
+    } else if (action == "profile") {
+        out.action = CommandAction::Profile;
+    } else {
+        error = action.empty() ? "missing \"action\"" : "unknown action \"" + action + "\"";
+        return false;
+    }
+
+    if (!readString(doc, "symbol", out.symbol, error) || !readString(doc, "secType", out.secType, error)
+        || !readString(doc, "exchange", out.exchange, error) || !readString(doc, "currency", out.currency, error)
+        || !readString(doc, "primaryExchange", out.primaryExchange, error)
+        || !readString(doc, "requestId", out.requestId, error)
+        || !readString(doc, "consumer", out.consumer, error)) {
+        return false;
+    }
+    std::string feed;
+    if (!readString(doc, "feed", feed, error)) {
+        return false;
+    }
+    if (feed.empty() || feed == "auto") {
+        out.feed = FeedType::Auto;
+    } else if (feed == "tickByTick") {
+        out.feed = FeedType::TickByTick;
+    } else if (feed == "topOfBook") {
+        out.feed = FeedType::TopOfBook;
+    } else if (feed == "midPoint") {
+        out.feed = FeedType::MidPoint;
+    } else if (feed == "optionChain") {
+        out.feed = FeedType::OptionChain;
+    } else {
+        error = "unknown feed \"" + feed + "\"";
+        return false;
+    }
+    auto priority = doc.FindMember("priority");
+    if (priority != doc.MemberEnd() && !priority->value.IsNull()) {
+        if (!priority->value.IsInt()) {
+            error = "\"priority\" must be an integer";
+            return false;
+        }
+        out.priority = priority->value.GetInt();
+    }
+    auto expiries = doc.FindMember("expiries");
+    if (expiries != doc.MemberEnd() && !expiries->value.IsNull()) {
+        if (!expiries->value.IsInt() || expiries->value.GetInt() < 1) {
+            error = "\"expiries\" must be a positive integer";
+            return false;
+        }
+        out.chain.expiries = expiries->value.GetInt();
+    }
+    if (!readDouble(doc, "minStrike", out.chain.minStrike, error)
+        || !readDouble(doc, "maxStrike", out.chain.maxStrike, error)) {
+        return false;
+    }
+    auto ttl = doc.FindMember("ttl");
+    if (ttl != doc.MemberEnd() && !ttl->value.IsNull()) {
+        if (!ttl->value.IsInt() || ttl->value.GetInt() < 1) {
+            error = "\"ttl\" must be a positive integer";
+            return false;
+        }
+        out.ttl = std::chrono::seconds(ttl->value.GetInt());
+    }
+    auto duration = doc.FindMember("duration");
+    if (duration != doc.MemberEnd() && !duration->value.IsNull()) {
+        if (!duration->value.IsInt() || duration->value.GetInt() < 1) {
+            error = "\"duration\" must be a positive integer";
+            return false;
+        }
+        out.duration = std::chrono::seconds(duration->value.GetInt());
+    }
+    if (out.action == CommandAction::Profile) {
+        return true;  // NOTE: Process-wide, no symbol
+    }
+    if (out.symbol.empty()) {
+        error = "missing \"symbol\"";
+        return false;
+    }
+    if ((out.action == CommandAction::Interest || out.action == CommandAction::Release) && out.consumer.empty()) {
+        error = "missing \"consumer\"";
+        return false;
+    }
+    return true;
+}
+
+} // namespace tws_bridge
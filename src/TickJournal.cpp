@@ -0,0 +1,797 @@
+// TickJournal.cpp - Segment lifecycle (open / sync / retire), block sealing, the segment reader and its index
+
+#include "TickJournal.h"
+#include "JournalCodec.h"
+#include "ThreadAffinity.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+std::size_t pageSize() {
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+// "YYYYMMDDTHHMMSSmmmZ" (file-name safe, sorts chronologically, a restart gets a new session)
+std::string sessionName(std::int64_t wallNs) {
+    const std::time_t seconds = static_cast<std::time_t>(wallNs / 1000000000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char buffer[32];
+    const std::size_t length = std::strftime(buffer, sizeof(buffer), "%Y%m%dT%H%M%S", &utc);
+    std::snprintf(buffer + length, sizeof(buffer) - length, "%03dZ", static_cast<int>(wallNs / 1000000 % 1000));
+    return buffer;
+}
+
+} // namespace
+
+TickJournal::TickJournal(const InstrumentRegistry& registry, JournalConfig config)
+    : m_registry(registry), m_config(std::move(config)) {
+}
+
+TickJournal::~TickJournal() {
+    stop();
+}
+
+bool TickJournal::start() {
+    if (m_running.load()) {
+        return true;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(m_config.directory, error);
+    if (error) {
+        std::cerr << "[JOURNAL] Cannot create " << m_config.directory << ": " << error.message() << "\n";
+        return false;
+    }
+    m_sessionStartNs = journal_detail::wallClockNs();
+    m_session = sessionName(m_sessionStartNs);
+    m_nextIndex = 0;
+    m_announced.assign(m_registry.capacity(), 0);
+    m_encoder = m_config.format == JournalFormat::Compressed
+        ? std::make_unique<JournalBlockEncoder>(m_config.blockBytes, m_registry.capacity())
+        : nullptr;
+    m_index = m_config.index ? std::make_unique<JournalIndexBuilder>(m_registry.capacity()) : nullptr;
+
+    std::unique_ptr<Segment> first = openSegment(m_nextIndex++);
+    if (!first) {
+        return false;
+    }
+    activate(std::move(first));
+    m_spare = openSegment(m_nextIndex++);  // REASON: Not fatal - the sync thread retries
+
+    m_running.store(true);
+    m_thread = std::thread([this]() { run(); });
+    std::cout << "[JOURNAL] Capturing to " << m_config.directory << "/" << m_session << "-*" << kJournalExtension << "\n";
+    return true;
+}
+
+void TickJournal::stop() {
+    if (m_encoder && m_running.load()) {
+        sealBlock();  // REASON: Still the writer's thread (no append() runs) - and rotate() needs m_running
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running.exchange(false)) {
+            return;
+        }
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    // NOTE: Both threads are gone - no lock needed past this point
+    if (m_active && m_index) {
+        m_index->close();  // REASON: Raw records since the last full span (a compressed block is sealed above)
+        m_active->seekIndex = m_index->take();
+    }
+    for (std::unique_ptr<Segment>& segment : m_retired) {
+        retire(std::move(segment));
+    }
+    m_retired.clear();
+    if (m_active) {
+        retire(std::move(m_active));
+    }
+    if (m_spare) {
+        ::unlink(m_spare->path.c_str());  // REASON: Never written - header only
+        retire(std::move(m_spare));
+    }
+    m_current = nullptr;
+    m_cursor = nullptr;
+    m_limit = nullptr;
+}
+
+// NOTE: Message thread - the tick's Symbol record goes into every block that holds the slot
+void TickJournal::appendEncoded(const TickUpdate& update, std::int64_t receiveNs) {
+    JournalBlockEncoder& encoder = *m_encoder;
+    if (update.slot < m_announced.size() && !encoder.announced(update.slot)) {
+        encoder.addSymbol(update.slot, m_registry.symbol(update.slot), receiveNs);
+    }
+    encoder.addTick(update, receiveNs);
+    if (m_index) {
+        m_index->add(update.slot, receiveNs);
+    }
+    // REASON: A quiet symbol set still reaches the disk within a sync interval (of its own receive times)
+    const std::int64_t maxAgeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(m_config.syncInterval).count();
+    if (encoder.full() || receiveNs - encoder.firstReceiveNs() >= maxAgeNs) {
+        sealBlock();
+    }
+}
+
+// PERFORMANCE: One LZ4 pass per block (~64 KiB of records, tens of μs) instead of a memcpy per tick
+void TickJournal::sealBlock() {
+    JournalBlockEncoder& encoder = *m_encoder;
+    if (encoder.empty()) {
+        return;
+    }
+    const std::string_view sealed = encoder.seal();
+    const std::size_t size = (sizeof(JournalBlockHeader) + sealed.size() + 7) & ~std::size_t{7};
+    if (static_cast<std::size_t>(m_limit - m_cursor) < size && !rotate()) {
+        m_counters.dropped.store(m_counters.dropped.load(std::memory_order_relaxed) + encoder.ticks(),
+                                 std::memory_order_relaxed);
+        encoder.reset();
+        if (m_index) {
+            m_index->discard();
+        }
+        return;
+    }
+    if (m_index) {
+        m_index->close(static_cast<std::size_t>(m_cursor - m_current->base));  // REASON: After a rotation
+    }
+    const JournalBlockHeader header{kJournalBlockMagic, static_cast<std::uint32_t>(sealed.size()),
+                                    static_cast<std::uint32_t>(encoder.encoded().size()), encoder.records(),
+                                    encoder.firstReceiveNs(), encoder.lastReceiveNs()};
+    std::memcpy(m_cursor, &header, sizeof(header));
+    std::memcpy(m_cursor + sizeof(header), sealed.data(), sealed.size());
+    m_cursor += size;
+    m_current->used.store(static_cast<std::size_t>(m_cursor - m_current->base), std::memory_order_release);
+    m_counters.records.store(m_counters.records.load(std::memory_order_relaxed) + encoder.ticks(),
+                             std::memory_order_relaxed);
+    m_counters.bytes.store(m_counters.bytes.load(std::memory_order_relaxed) + size, std::memory_order_relaxed);
+    bump(m_counters.blocks);
+    encoder.reset();
+}
+
+void TickJournal::appendSymbol(SlotId slot, std::int64_t receiveNs) {
+    using namespace journal_detail;
+    const std::string& symbol = m_registry.symbol(slot);
+    const std::size_t symbolBytes = std::min(symbol.size(), kMaxSymbolBytes);
+    const std::size_t payload = sizeof(slot) + symbolBytes;
+
+    JournalRecordHeader header{JournalRecordKind::Symbol, static_cast<std::uint16_t>(payload), 0, receiveNs};
+    std::memcpy(m_cursor, &header, sizeof(header));
+    std::memcpy(m_cursor + sizeof(header), &slot, sizeof(slot));
+    std::memcpy(m_cursor + sizeof(header) + sizeof(slot), symbol.data(), symbolBytes);
+    m_cursor += recordBytes(payload);
+    m_announced[slot] = m_segmentSerial;
+}
+
+// NOTE: Message thread, once per segment - normally just takes the pre-opened spare
+bool TickJournal::rotate() {
+    if (!m_running.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_spare && m_spareOpening) {
+        // REASON: Its index precedes any we could take - opening another one would reorder the files
+        bump(m_counters.stalls);
+        m_spareReady.wait(lock, [this]() { return !m_spareOpening; });
+    }
+    std::unique_ptr<Segment> next = std::move(m_spare);
+    if (!next) {
+        if (m_inlineOpenFailed) {
+            return false;  // REASON: One failed open per spare attempt, not one per tick
+        }
+        bump(m_counters.stalls);
+        const std::uint32_t index = m_nextIndex++;
+        lock.unlock();
+        next = openSegment(index);  // PITFALL: File create + fallocate + mmap on the message thread
+        lock.lock();
+        if (!next) {
+            m_inlineOpenFailed = true;
+            m_wake.notify_one();
+            return false;
+        }
+    }
+    m_inlineOpenFailed = false;
+    if (m_index) {
+        // REASON: Raw records so far belong to the full segment - an open compressed block moves to the next one
+        if (!m_encoder) {
+            m_index->close();
+        }
+        m_active->seekIndex = m_index->take();
+    }
+    m_retired.push_back(std::move(m_active));
+    activate(std::move(next));
+    lock.unlock();
+    m_wake.notify_one();  // REASON: Retire the full segment and open the next spare now, not at the next tick
+    return true;
+}
+
+void TickJournal::activate(std::unique_ptr<Segment> segment) {
+    m_current = segment.get();
+    m_cursor = segment->base + segment->used.load(std::memory_order_relaxed);
+    m_limit = segment->base + segment->capacity;
+    m_segmentSerial = segment->index + 1;
+    m_wallOffsetNs = segment->wallOffsetNs;
+    m_active = std::move(segment);
+}
+
+std::unique_ptr<TickJournal::Segment> TickJournal::openSegment(std::uint32_t index) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s-%06u%s", m_session.c_str(), index, kJournalExtension);
+    auto segment = std::make_unique<Segment>();
+    segment->index = index;
+    segment->path = m_config.directory + "/" + name;
+
+    const std::size_t page = pageSize();
+    // REASON: A compressed segment holds at least one incompressible block
+    const std::size_t minimum = sizeof(JournalSegmentHeader)
+        + std::max(64 * journal_detail::kMaxRecordBytes,
+                   m_encoder ? sizeof(JournalBlockHeader) + m_encoder->maxSealedBytes() + 8 : std::size_t{0});
+    segment->capacity = (std::max(m_config.segmentBytes, minimum) + page - 1) / page * page;
+
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (segment->fd < 0) {
+        std::cerr << "[JOURNAL] Cannot create " << segment->path << ": " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+    // PITFALL: Reserve the blocks now - a full disk on a store into the mapping is a SIGBUS
+    const int reserved = ::posix_fallocate(segment->fd, 0, static_cast<off_t>(segment->capacity));
+    void* base = reserved == 0
+        ? ::mmap(nullptr, segment->capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0)
+        : MAP_FAILED;
+    if (base == MAP_FAILED) {
+        std::cerr << "[JOURNAL] Cannot preallocate " << segment->path << ": "
+                  << std::strerror(reserved != 0 ? reserved : errno) << "\n";
+        ::close(segment->fd);
+        ::unlink(segment->path.c_str());
+        return nullptr;
+    }
+    segment->base = static_cast<char*>(base);
+    segment->wallOffsetNs = journal_detail::wallClockNs() - latencyNowNs();
+    prefault(*segment);
+
+    JournalSegmentHeader header{};
+    std::memcpy(header.magic, kJournalMagic, sizeof(header.magic));
+    header.version = m_encoder ? kJournalCompressedVersion : kJournalVersion;
+    header.segmentIndex = index;
+    header.sessionStartNs = m_sessionStartNs;
+    header.createdNs = journal_detail::wallClockNs();
+    std::memcpy(segment->base, &header, sizeof(header));
+    segment->used.store(sizeof(header), std::memory_order_relaxed);
+    m_counters.segments.fetch_add(1, std::memory_order_relaxed);
+    return segment;
+}
+
+// Sync thread: flush the pages written since the last call
+void TickJournal::syncSegment(Segment& segment) {
+    const std::size_t used = segment.used.load(std::memory_order_acquire);
+    if (used <= segment.synced) {
+        return;
+    }
+    const std::size_t from = segment.synced & ~(pageSize() - 1);  // REASON: msync needs a page-aligned start
+    if (::msync(segment.base + from, used - from, MS_SYNC) != 0) {
+        m_counters.syncErrors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    segment.synced = used;
+}
+
+// PERFORMANCE: Write-faults the pages ahead of the cursor from this side, the first store into a page
+// on the message thread is then a plain store (no page fault)
+void TickJournal::prefault(Segment& segment) {
+#ifdef MADV_POPULATE_WRITE
+    const std::size_t page = pageSize();
+    const std::size_t used = segment.used.load(std::memory_order_acquire);
+    const std::size_t target = std::min(segment.capacity, (used + m_config.prefaultBytes + page - 1) / page * page);
+    if (target > segment.prefaulted) {
+        // NOTE: Best effort - EINVAL on kernels < 5.14, the pages then fault on first write as usual
+        ::madvise(segment.base + segment.prefaulted, target - segment.prefaulted, MADV_POPULATE_WRITE);
+        segment.prefaulted = target;
+    }
+#else
+    (void)segment;
+#endif
+}
+
+void TickJournal::retire(std::unique_ptr<Segment> segment) {
+    if (!segment) {
+        return;
+    }
+    syncSegment(*segment);
+    const std::size_t used = segment->used.load(std::memory_order_acquire);
+    ::munmap(segment->base, segment->capacity);
+    // REASON: Closed segments hold records only - readers and audits see the real size
+    if (::ftruncate(segment->fd, static_cast<off_t>(used)) != 0) {
+        m_counters.syncErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+    ::close(segment->fd);
+    // NOTE: Symbols come from the registry (slots never change owner within a session)
+    if (!segment->seekIndex.empty()
+        && !JournalIndex::write(JournalIndex::pathFor(segment->path), segment->seekIndex, used,
+                                [this](SlotId slot) -> const std::string& { return m_registry.symbol(slot); })) {
+        m_counters.syncErrors.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void TickJournal::run() {
+    nameCurrentThread("tws-journal");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running.load()) {
+        m_wake.wait_for(lock, m_config.syncInterval);
+        std::vector<std::unique_ptr<Segment>> retired;
+        retired.swap(m_retired);
+        Segment* active = m_active.get();  // REASON: Only this thread frees segments - valid unlocked
+        const bool needSpare = !m_spare && m_running.load();
+        const std::uint32_t spareIndex = needSpare ? m_nextIndex++ : 0;
+        m_spareOpening = needSpare;
+        lock.unlock();
+
+        for (std::unique_ptr<Segment>& segment : retired) {
+            retire(std::move(segment));
+        }
+        if (active) {
+            syncSegment(*active);
+            prefault(*active);
+        }
+        std::unique_ptr<Segment> spare = needSpare ? openSegment(spareIndex) : nullptr;
+
+        lock.lock();
+        if (spare) {
+            m_spare = std::move(spare);
+        }
+        m_spareOpening = false;
+        m_spareReady.notify_all();
+    }
+}
+
+// ========== TickJournalReader ==========
+
+TickJournalReader::TickJournalReader() = default;  // REASON: JournalBlockDecoder is complete here
+
+TickJournalReader::~TickJournalReader() {
+    close();
+}
+
+bool TickJournalReader::open(const std::string& path) {
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    void* base = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(JournalSegmentHeader)) {
+        base = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);  // REASON: The mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    m_data = static_cast<const char*>(base);
+    m_size = static_cast<std::size_t>(info.st_size);
+    std::memcpy(&m_header, m_data, sizeof(m_header));
+    if (std::memcmp(m_header.magic, kJournalMagic, sizeof(kJournalMagic)) != 0
+        || (m_header.version != kJournalVersion && m_header.version != kJournalCompressedVersion
+            && m_header.version != kJournalLegacyVersion)) {
+        close();
+        return false;
+    }
+    if (compressed() && !m_block) {
+        m_block = std::make_unique<JournalBlockDecoder>();
+    }
+    char* mapped = const_cast<char*>(m_data);
+    ::madvise(mapped, m_size, MADV_SEQUENTIAL);  // REASON: Aggressive kernel read-ahead, pages dropped behind
+#ifdef MADV_HUGEPAGE
+    ::madvise(mapped, m_size, MADV_HUGEPAGE);    // NOTE: Best effort - file THP depends on the filesystem
+#endif
+    m_offset = sizeof(JournalSegmentHeader);
+    m_end = m_size;
+    m_prefetched = 0;
+    prefetch();
+    return true;
+}
+
+bool TickJournalReader::seek(std::size_t begin, std::size_t end) {
+    if (!m_data || begin < sizeof(JournalSegmentHeader) || begin > end || end > m_size) {
+        return false;
+    }
+    m_offset = begin;
+    m_end = end;
+    if (m_block) {
+        m_block->clear();
+    }
+    m_prefetched = begin & ~(pageSize() - 1);  // REASON: madvise needs a page-aligned start
+    prefetch();
+    return true;
+}
+
+void TickJournalReader::prefetch() {
+    if (m_prefetched >= m_size) {
+        return;
+    }
+    const std::size_t length = std::min(kPrefetchBytes, m_size - m_prefetched);
+    ::madvise(const_cast<char*>(m_data) + m_prefetched, length, MADV_WILLNEED);
+    m_prefetched += length;
+}
+
+void TickJournalReader::close() {
+    if (m_data) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_offset = 0;
+    m_end = 0;
+    m_prefetched = 0;
+    if (m_block) {
+        m_block->clear();
+    }
+}
+
+// Loads the block at m_offset, false at the end of the segment (or at a truncated / corrupt block)
+bool TickJournalReader::nextBlock() {
+    if (m_offset + sizeof(JournalBlockHeader) > m_end) {
+        return false;
+    }
+    if (m_offset + kPrefetchBytes / 2 >= m_prefetched) {
+        prefetch();
+    }
+    JournalBlockHeader header;
+    std::memcpy(&header, m_data + m_offset, sizeof(header));
+    const std::size_t size = (sizeof(header) + header.sealedBytes + 7) & ~std::size_t{7};
+    if (header.magic != kJournalBlockMagic || m_offset + size > m_end) {
+        return false;
+    }
+    const std::string_view sealed(m_data + m_offset + sizeof(header), header.sealedBytes);
+    m_offset += size;
+    return m_block->load(sealed, header.encodedBytes);
+}
+
+bool TickJournalReader::next(JournalEntry& entry) {
+    using namespace journal_detail;
+    if (compressed()) {
+        while (m_block->exhausted()) {
+            if (!nextBlock()) {
+                return false;
+            }
+        }
+        return m_block->next(entry);
+    }
+    while (m_offset + sizeof(JournalRecordHeader) <= m_end) {
+        if (m_offset + kPrefetchBytes / 2 >= m_prefetched) {
+            prefetch();  // REASON: Next window is paged in while this one is replayed
+        }
+        JournalRecordHeader header;
+        std::memcpy(&header, m_data + m_offset, sizeof(header));
+        const std::size_t size = recordBytes(header.length);
+        if (header.kind == JournalRecordKind::End || m_offset + size > m_end) {
+            return false;
+        }
+        const char* payload = m_data + m_offset + sizeof(header);
+        m_offset += size;
+
+        entry.kind = header.kind;
+        entry.receiveNs = header.receiveNs;
+        if (header.kind == JournalRecordKind::Tick) {
+            if (header.length < kTickHeaderBytes || header.length > sizeof(TickUpdate)) {
+                return false;
+            }
+            entry.update = TickUpdate{};
+            std::memcpy(&entry.update, payload, header.length);
+            if (static_cast<std::size_t>(entry.update.type) >= kTickUpdateTypeCount) {
+                return false;
+            }
+            if (legacy() && entry.update.type == TickUpdateType::AllLast) {
+                // REASON: Version 1 trades end after the size - the exchange byte read is its padding
+                if (header.length != kLegacyAllLastBytes) {
+                    return false;
+                }
+                entry.update.allLast.exchange = kUnknownExchange;
+                entry.update.allLast.conditions = 0;
+                return true;
+            }
+            return header.length == tickPayloadBytes(entry.update.type);
+        }
+        if (header.kind == JournalRecordKind::Symbol) {
+            if (header.length < sizeof(SlotId)) {
+                return false;
+            }
+            std::memcpy(&entry.slot, payload, sizeof(SlotId));
+            entry.symbol.assign(payload + sizeof(SlotId), header.length - sizeof(SlotId));
+            return true;
+        }
+        // NOTE: Unknown kinds (newer writer) are skipped, their length is still valid
+    }
+    return false;
+}
+
+std::vector<std::string> TickJournalReader::segments(const std::string& directory, const std::string& session) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(directory, error)) {
+        const std::string name = file.path().filename().string();
+        if (!file.is_regular_file(error) || file.path().extension() != kJournalExtension) {
+            continue;
+        }
+        if (session.empty() || name.rfind(session + "-", 0) == 0) {
+            paths.push_back(file.path().string());
+        }
+    }
+    // REASON: Fixed-width session + index names - lexicographic order is chronological
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+// ========== JournalIndex ==========
+
+std::string JournalIndex::pathFor(const std::string& segmentPath) {
+    return std::filesystem::path(segmentPath).replace_extension(kJournalIndexExtension).string();
+}
+
+// REASON: Written to a temporary name and renamed - a reader never sees a half-written index
+bool JournalIndex::writeFile(const std::string& path, const std::string& contents) {
+    const std::string temporary = path + ".tmp";
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[JOURNAL] Cannot create " << temporary << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    std::size_t written = 0;
+    while (written < contents.size()) {
+        const ssize_t result = ::write(fd, contents.data() + written, contents.size() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            break;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    const bool complete = written == contents.size() && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!complete || ::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::cerr << "[JOURNAL] Cannot write " << path << ": " << std::strerror(errno) << "\n";
+        ::unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool JournalIndex::load(const std::string& path, std::size_t segmentBytes) {
+    m_index = JournalSegmentIndex{};
+    m_symbols.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    JournalIndexHeader header;
+    if (contents.size() < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, contents.data(), sizeof(header));
+    const std::size_t blockBytes = std::size_t{header.blocks} * sizeof(JournalIndexBlock);
+    const std::size_t bitmapBytes = std::size_t{header.blocks} * header.bitmapWords * sizeof(std::uint64_t);
+    if (std::memcmp(header.magic, kJournalIndexMagic, sizeof(kJournalIndexMagic)) != 0
+        || header.segmentBytes != segmentBytes || contents.size() < sizeof(header) + blockBytes + bitmapBytes) {
+        return false;  // REASON: Not ours, or the segment changed since (crash recovery rewrote it)
+    }
+    m_index.words = header.bitmapWords;
+    m_index.blocks.resize(header.blocks);
+    m_index.bitmaps.resize(std::size_t{header.blocks} * header.bitmapWords);
+    std::memcpy(m_index.blocks.data(), contents.data() + sizeof(header), blockBytes);
+    std::memcpy(m_index.bitmaps.data(), contents.data() + sizeof(header) + blockBytes, bitmapBytes);
+    bool valid = true;
+    for (const JournalIndexBlock& block : m_index.blocks) {
+        valid = valid && block.offset >= sizeof(JournalSegmentHeader) && block.offset <= segmentBytes;
+    }
+
+    std::size_t offset = sizeof(header) + blockBytes + bitmapBytes;
+    for (std::uint32_t i = 0; valid && i < header.symbols; ++i) {
+        SlotId slot;
+        valid = offset + sizeof(slot) + 1 <= contents.size();
+        if (valid) {
+            std::memcpy(&slot, contents.data() + offset, sizeof(slot));
+            const std::size_t length = static_cast<std::uint8_t>(contents[offset + sizeof(slot)]);
+            offset += sizeof(slot) + 1;
+            valid = offset + length <= contents.size();
+            if (valid) {
+                m_symbols.emplace_back(slot, contents.substr(offset, length));
+                offset += length;
+            }
+        }
+    }
+    if (!valid) {
+        m_index = JournalSegmentIndex{};
+        m_symbols.clear();
+    }
+    return valid;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> JournalIndex::select(const std::vector<std::uint64_t>* slots,
+                                                                      std::int64_t fromNs, std::int64_t toNs) const {
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    const std::vector<JournalIndexBlock>& blocks = m_index.blocks;
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].lastReceiveNs < fromNs || blocks[i].firstReceiveNs > toNs) {
+            continue;
+        }
+        bool holds = slots == nullptr;
+        for (std::size_t word = 0; !holds && word < m_index.words && word < slots->size(); ++word) {
+            holds = (m_index.bitmaps[i * m_index.words + word] & (*slots)[word]) != 0;
+        }
+        if (!holds) {
+            continue;
+        }
+        const std::size_t begin = blocks[i].offset;
+        const std::size_t end = i + 1 < blocks.size() ? blocks[i + 1].offset : SIZE_MAX;
+        if (!ranges.empty() && ranges.back().second == begin) {
+            ranges.back().second = end;  // REASON: Adjacent blocks - one seek, one read-ahead stream
+        } else {
+            ranges.emplace_back(begin, end);
+        }
+    }
+    return ranges;
+}
+
+// ========== TickJournalScan ==========
+
+bool parseJournalTime(const std::string& text, std::int64_t& ns) {
+    if (!text.empty() && std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        if (text.size() > 10) {
+            return false;  // REASON: Seconds only - a ms / ns stamp would overflow (and is ambiguous)
+        }
+        ns = std::stoll(text) * 1000000000;
+        return true;
+    }
+    std::tm utc{};
+    int consumed = 0;
+    if (std::sscanf(text.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d%n", &utc.tm_year, &utc.tm_mon, &utc.tm_mday,
+                    &utc.tm_hour, &utc.tm_min, &utc.tm_sec, &consumed) != 6) {
+        return false;
+    }
+    std::int64_t fraction = 0;
+    std::size_t position = static_cast<std::size_t>(consumed);
+    if (position < text.size() && text[position] == '.') {
+        std::int64_t scale = 100000000;
+        for (++position; position < text.size() && text[position] >= '0' && text[position] <= '9'; ++position) {
+            fraction += (text[position] - '0') * scale;
+            scale /= 10;
+        }
+    }
+    if (position + 1 != text.size() || text[position] != 'Z' || utc.tm_mon < 1 || utc.tm_mon > 12) {
+        return false;
+    }
+    utc.tm_year -= 1900;
+    utc.tm_mon -= 1;
+    ns = static_cast<std::int64_t>(::timegm(&utc)) * 1000000000 + fraction;
+    return true;
+}
+
+bool parseReplaySpeed(const std::string& text, double& speed) {
+    if (text == "max") {
+        speed = 0.0;
+        return true;
+    }
+    std::string number = text;
+    if (!number.empty() && (number.back() == 'x' || number.back() == 'X')) {
+        number.pop_back();
+    }
+    char* end = nullptr;
+    const double value = std::strtod(number.c_str(), &end);
+    if (number.empty() || end != number.c_str() + number.size() || !(value > 0.0)) {
+        return false;
+    }
+    speed = value;
+    return true;
+}
+
+TickJournalScan::TickJournalScan(JournalFilter filter)
+    : m_filter(std::move(filter))
+    , m_symbols(m_filter.symbols.begin(), m_filter.symbols.end())
+    , m_wanted((std::size_t{std::numeric_limits<SlotId>::max()} + 1) / 64, 0) {
+}
+
+bool TickJournalScan::open(const std::string& path) {
+    m_indexed = false;
+    m_ranges.clear();
+    m_range = 0;
+    m_inRange = false;
+    m_announce = 0;
+    std::fill(m_wanted.begin(), m_wanted.end(), 0);
+    if (!m_reader.open(path)) {
+        return false;
+    }
+    // REASON: An unfiltered read is sequential either way - no index to load
+    if (m_filter.all() || !m_index.load(JournalIndex::pathFor(path), m_reader.size())) {
+        return true;
+    }
+    m_indexed = true;
+    for (const auto& [slot, symbol] : m_index.symbols()) {
+        if (wantedSymbol(symbol)) {
+            m_wanted[slot / 64] |= std::uint64_t{1} << (slot % 64);
+        }
+    }
+    m_ranges = m_index.select(m_symbols.empty() ? nullptr : &m_wanted, m_filter.fromNs, m_filter.toNs);
+    const std::size_t records = m_reader.size() - sizeof(JournalSegmentHeader);
+    std::size_t read = 0;
+    for (auto& [begin, end] : m_ranges) {
+        end = std::min(end, m_reader.size());
+        read += end - begin;
+    }
+    m_skippedBytes += records - std::min(read, records);
+    return true;
+}
+
+bool TickJournalScan::next(JournalEntry& entry) {
+    if (m_filter.all()) {
+        return m_reader.next(entry);
+    }
+    // Indexed: the segment's symbol table replaces the Symbol records of the blocks skipped
+    if (m_indexed) {
+        const std::vector<std::pair<SlotId, std::string>>& symbols = m_index.symbols();
+        while (m_announce < symbols.size()) {
+            const auto& [slot, symbol] = symbols[m_announce++];
+            if (wantedSlot(slot)) {
+                entry.kind = JournalRecordKind::Symbol;
+                entry.receiveNs = 0;
+                entry.slot = slot;
+                entry.symbol = symbol;
+                return true;
+            }
+        }
+    }
+    for (;;) {
+        if (m_indexed && !m_inRange) {
+            if (m_range == m_ranges.size()) {
+                return false;
+            }
+            const auto [begin, end] = m_ranges[m_range++];
+            m_inRange = m_reader.seek(begin, end);
+            continue;
+        }
+        if (!m_reader.next(entry)) {
+            if (!m_indexed) {
+                return false;
+            }
+            m_inRange = false;
+            continue;
+        }
+        if (entry.kind == JournalRecordKind::Symbol) {
+            if (m_indexed) {
+                continue;  // REASON: Already handed out from the index
+            }
+            const bool wanted = wantedSymbol(entry.symbol);
+            std::uint64_t& word = m_wanted[entry.slot / 64];
+            const std::uint64_t bit = std::uint64_t{1} << (entry.slot % 64);
+            word = wanted ? word | bit : word & ~bit;
+            if (wanted) {
+                return true;
+            }
+            continue;
+        }
+        if (wantedSlot(entry.update.slot) && entry.receiveNs >= m_filter.fromNs && entry.receiveNs <= m_filter.toNs) {
+            return true;
+        }
+    }
+}
+
+} // namespace tws_bridge
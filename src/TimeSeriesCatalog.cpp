@@ -0,0 +1,126 @@
+// TimeSeriesCatalog.cpp - RedisTimeSeries series / compaction rule setup implementation
+
+#include "TimeSeries.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+// TS.CREATE, or TS.ALTER when the key is left over from an earlier run (settings may have changed)
+void createSeries(sw::redis::Redis& redis, const std::string& key, std::chrono::milliseconds retention,
+                  const char* duplicatePolicy, const std::string& symbol, const char* field) {
+    const std::string retentionMs = std::to_string(retention.count());
+    try {
+        redis.command("TS.CREATE", key, "RETENTION", retentionMs, "DUPLICATE_POLICY", duplicatePolicy,
+                      "LABELS", "symbol", symbol, "field", field);
+    } catch (const sw::redis::ReplyError& e) {
+        if (std::string_view(e.what()).find("already exists") == std::string_view::npos) {
+            throw;
+        }
+        redis.command("TS.ALTER", key, "RETENTION", retentionMs, "DUPLICATE_POLICY", duplicatePolicy);
+    }
+}
+
+} // namespace
+
+TimeSeriesCatalog::TimeSeriesCatalog(const std::string& uri, const InstrumentRegistry& registry,
+                                     TimeSeriesConfig config)
+    : m_uri(uri)
+    , m_registry(registry)
+    , m_config(std::move(config))
+    , m_capacity(registry.capacity())
+    , m_ready(std::make_unique<std::atomic<std::uint8_t>[]>(registry.capacity())) {
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        m_ready[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+TimeSeriesCatalog::~TimeSeriesCatalog() {
+    stop();
+}
+
+void TimeSeriesCatalog::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void TimeSeriesCatalog::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void TimeSeriesCatalog::run() {
+    nameCurrentThread("tws-series");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    std::size_t next = 0;  // First slot without its series
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - setup replies (and errors) never mix with a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+
+            while (m_running.load()) {
+                // NOTE: Slots registered mid-pass are picked up by the next one (their samples wait until then)
+                for (const std::size_t registered = m_registry.size(); next < registered && m_running.load(); ++next) {
+                    const SlotId slot = static_cast<SlotId>(next);
+                    const std::string& symbol = m_registry.symbol(slot);
+                    const std::string& prefix = m_registry.channels(slot).series;
+                    for (std::size_t i = 0; i < kSeriesFieldCount; ++i) {
+                        const SeriesField field = static_cast<SeriesField>(i);
+                        const std::string key = prefix + seriesFieldName(field);
+                        createSeries(redis, key, m_config.retention, seriesDuplicatePolicy(field), symbol,
+                                     seriesFieldName(field));
+                        for (const TimeSeriesCompaction& compaction : m_config.compactions) {
+                            const std::string bucket = bucketLabel(compaction.bucket);
+                            const std::string destination = key + ":" + bucket;
+                            // NOTE: Compacted series take samples from their rule only - duplicates cannot occur
+                            createSeries(redis, destination, compaction.retention, "LAST", symbol,
+                                         seriesFieldName(field));
+                            try {
+                                redis.command("TS.CREATERULE", key, destination, "AGGREGATION",
+                                              seriesAggregation(field), std::to_string(compaction.bucket.count()));
+                            } catch (const sw::redis::ReplyError&) {
+                                // REASON: The rule is left over from an earlier run - TS.CREATERULE has no upsert
+                            }
+                        }
+                    }
+                    m_ready[slot].store(1, std::memory_order_release);
+                    m_counters.created.fetch_add(1, std::memory_order_relaxed);
+                }
+                pause(m_config.scanInterval);
+            }
+        } catch (const sw::redis::ReplyError& e) {
+            // PITFALL: Module missing (unknown command) or key of another type - retrying cannot fix either
+            std::cerr << "[SERIES] TS setup rejected for " << m_registry.symbol(static_cast<SlotId>(next)) << ": "
+                      << e.what() << ", time series disabled\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            break;
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[SERIES] Redis error: " << e.what() << ", retrying in " << m_config.reconnectDelay.count()
+                      << "ms\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            pause(m_config.reconnectDelay);
+        }
+    }
+    std::cout << "[SERIES] Time series catalog stopped (" << m_counters.created.load() << " symbols)\n";
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,82 @@
+// TopMovers.cpp - Movers publisher implementation
+
+#include "TopMovers.h"
+#include "AsyncLogger.h"
+#include "Serialization.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <utility>
+
+namespace tws_bridge {
+
+MoversPublisher::MoversPublisher(const std::string& uri, MoversExchange& exchange, const InstrumentRegistry& registry,
+                                 MoversConfig config)
+    : m_uri(uri)
+    , m_exchange(exchange)
+    , m_registry(registry)
+    , m_config(std::move(config)) {
+}
+
+MoversPublisher::~MoversPublisher() {
+    stop();
+}
+
+void MoversPublisher::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void MoversPublisher::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void MoversPublisher::run() {
+    nameCurrentThread("tws-movers");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    MoverRanking ranking;
+    JsonBuffer json;
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - the ranking never queues behind a worker's pipeline
+            sw::redis::ConnectionOptions opts(m_uri);
+            opts.connect_timeout = m_config.socketTimeout;
+            opts.socket_timeout = m_config.socketTimeout;
+            sw::redis::Redis redis(opts);
+            while (m_running.load()) {
+                pause(m_config.interval);
+                if (!m_running.load()) {
+                    break;
+                }
+                m_exchange.merge(m_config.top, ranking);
+                const std::int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                serializeMovers(ranking, m_registry, nowMs, json);
+                const sw::redis::StringView payload(json.data(), json.size());
+                auto pipe = redis.pipeline(false);
+                pipe.publish(m_config.channel, payload);
+                pipe.set(m_config.channel, payload);  // NOTE: A dashboard opening mid-interval GETs the latest
+                pipe.exec();
+                m_counters.published.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (const sw::redis::Error& e) {
+            BRIDGE_LOG_EVERY_MS(10000, LogLevel::Error, "[MOVERS] Redis error: {}", e.what());
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            pause(m_config.reconnectDelay);
+        }
+    }
+}
+
+} // namespace tws_bridge
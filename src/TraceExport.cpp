@@ -0,0 +1,162 @@
+// TraceExport.cpp - Writer thread: trace-event JSON of sampled ticks
+
+#include "TraceExport.h"
+#include "ThreadAffinity.h"
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+// Trace-event timestamps are microseconds (fractions keep the nanoseconds)
+double micros(std::int64_t ns) {
+    return static_cast<double>(ns) / 1000.0;
+}
+
+} // namespace
+
+TraceExport::TraceExport(TraceConfig config, const InstrumentRegistry* registry)
+    : m_config(std::move(config))
+    , m_registry(registry)
+    , m_queue(m_config.bufferSpans) {
+    m_scratch.resize(1024);
+}
+
+TraceExport::~TraceExport() {
+    stop();
+}
+
+bool TraceExport::start() {
+    if (m_running.load()) {
+        return true;
+    }
+    m_file = std::fopen(m_config.path.c_str(), "we");
+    if (m_file == nullptr) {
+        std::cerr << "[TRACE] Cannot write " << m_config.path << "\n";
+        return false;
+    }
+    std::fputs("[", m_file);
+    m_firstEvent = true;
+    m_running.store(true);
+    m_thread = std::thread([this]() { run(); });
+    std::cout << "[TRACE] Sampling 1 in " << m_config.sampleEvery << " ticks to " << m_config.path << "\n";
+    return true;
+}
+
+void TraceExport::stop() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    flush();
+    std::fputs("\n]\n", m_file);
+    std::fclose(m_file);
+    m_file = nullptr;
+    std::cout << "[TRACE] " << written() << " spans written, " << dropped() << " dropped\n";
+}
+
+void TraceExport::run() {
+    nameCurrentThread("tws-trace");
+    // REASON: Sleep in short steps so stop() stays responsive
+    const auto step = std::min(m_config.flushInterval, std::chrono::milliseconds(100));
+    auto nextFlush = std::chrono::steady_clock::now() + m_config.flushInterval;
+    while (m_running.load()) {
+        std::this_thread::sleep_for(step);
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextFlush) {
+            nextFlush = now + m_config.flushInterval;
+            flush();
+        }
+    }
+}
+
+std::size_t TraceExport::flush() {
+    if (m_file == nullptr) {
+        return 0;
+    }
+    std::size_t total = 0;
+    std::size_t count = 0;
+    while ((count = m_queue.try_dequeue_bulk(m_scratch.data(), m_scratch.size())) > 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            writeSpan(m_scratch[i]);
+        }
+        total += count;
+    }
+    if (total > 0) {
+        // PERFORMANCE: One write syscall per flush interval, on this thread only
+        std::fflush(m_file);
+        m_written.fetch_add(total, std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Thread names as Perfetto / chrome://tracing track titles
+// NOTE: Read from /proc on the span's first appearance - the recording thread pays nothing
+void TraceExport::writeThreadName(std::uint32_t tid) {
+    if (!m_namedThreads.insert(tid).second) {
+        return;
+    }
+    std::string name;
+    std::ifstream comm("/proc/self/task/" + std::to_string(tid) + "/comm");
+    if (!std::getline(comm, name) || name.empty()) {
+        name = "thread-" + std::to_string(tid);
+    }
+    std::fprintf(m_file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                 m_firstEvent ? "\n" : ",\n", static_cast<int>(::getpid()), tid, name.c_str());
+    m_firstEvent = false;
+}
+
+void TraceExport::writeSpan(const TraceSpan& span) {
+    writeThreadName(span.tid);
+    const char* name = traceStageName(span.stage);
+    switch (span.stage) {
+    case TraceStage::Queued:
+        // REASON: Waiting in the queue is no thread's work - async slice keyed by the trace id
+        writeEvent("b", name, span.beginNs, span.tid, span, 0);
+        writeEvent("e", name, span.endNs, span.tid, span, 0);
+        return;
+    case TraceStage::Enqueue:
+        writeEvent("X", name, span.beginNs, span.tid, span, span.endNs - span.beginNs);
+        writeEvent("s", "tick", span.beginNs, span.tid, span, 0);  // Flow arrow: message thread → worker
+        return;
+    case TraceStage::Aggregate:
+        writeEvent("X", name, span.beginNs, span.tid, span, span.endNs - span.beginNs);
+        writeEvent("f", "tick", span.beginNs, span.tid, span, 0);
+        return;
+    default:
+        writeEvent("X", name, span.beginNs, span.tid, span, span.endNs - span.beginNs);
+        return;
+    }
+}
+
+void TraceExport::writeEvent(const char* ph, const char* name, std::int64_t ns, std::uint32_t tid,
+                             const TraceSpan& span, std::int64_t durationNs) {
+    std::fprintf(m_file, "%s{\"ph\":\"%s\",\"cat\":\"tick\",\"name\":\"%s\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f",
+                 m_firstEvent ? "\n" : ",\n", ph, name, static_cast<int>(::getpid()), tid, micros(ns));
+    m_firstEvent = false;
+    if (ph[0] == 'X') {
+        std::fprintf(m_file, ",\"dur\":%.3f", micros(std::max<std::int64_t>(durationNs, 0)));
+    } else {
+        std::fprintf(m_file, ",\"id\":%u", span.traceId);
+        if (ph[0] == 'f') {
+            std::fputs(",\"bp\":\"e\"", m_file);
+        }
+    }
+    if (ph[0] == 'X' || ph[0] == 'b') {
+        if (m_registry != nullptr && span.slot < m_registry->size()) {
+            std::fprintf(m_file, ",\"args\":{\"tick\":%u,\"symbol\":%s}", span.traceId,
+                         m_registry->symbolJson(span.slot).c_str());
+        } else {
+            std::fprintf(m_file, ",\"args\":{\"tick\":%u,\"slot\":%u}", span.traceId, static_cast<unsigned>(span.slot));
+        }
+    }
+    std::fputs("}", m_file);
+}
+
+} // namespace tws_bridge
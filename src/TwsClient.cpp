@@ -4,89 +4,858 @@
 // 2. Inbound: Receive callbacks from TWS (via EWrapper interface)
 
 #include "TwsClient.h"
-#include "EClientSocket.h"
+#include "AllocationTracker.h"
+#include "AsyncLogger.h"
+#include "DecimalSize.h"
+#include "CorkedClientSocket.h"
 #include "Contract.h"
+#include "ScannerSubscription.h"
+#include "OrderBook.h"
+#include "ProfilerSignal.h"
+#include "TickJournal.h"
+#include "Tracepoints.h"
+#include <sys/socket.h>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <thread>
 #include <chrono>
 
 namespace tws_bridge {
 
-TwsClient::TwsClient(moodycamel::ConcurrentQueue<TickUpdate>& queue)
-    : m_queue(queue)
-    , m_signal(std::make_unique<EReaderOSSignal>())
-    , m_client(std::make_unique<EClientSocket>(this, m_signal.get())) {
+template <typename Sink>
+BasicTwsClient<Sink>::BasicTwsClient(typename Sink::Target& target, InstrumentRegistry& registry,
+                                     PacingConfig pacing)
+    : m_sink(target)
+    , m_topOfBook(registry.capacity())
+    , m_barSizes(RequestTable::kDefaultCapacity)  // REASON: Value-initialized (BarSize::Unknown)
+    , m_pacer(pacing)
+    , m_maxTickByTick(pacing.maxTickByTick)
+    // REASON: Bounded wait (ms) - processMessages() must return to send paced requests
+    , m_signal(std::make_unique<EReaderOSSignal>(100))
+    , m_client(std::make_unique<CorkedClientSocket>(this, m_signal.get()))
+    , m_registry(registry)
+    , m_watermarks(registry.capacity()) {
     // NOTE: "this" pointer passed to EClientSocket - TWS stores it and calls our callbacks
 }
 
-TwsClient::~TwsClient() {
+template <typename Sink>
+BasicTwsClient<Sink>::~BasicTwsClient() {
     disconnect();
 }
 
 // ========== Outbound API: Commands we send TO TWS ==========
 
-bool TwsClient::createConnection(const std::string& host, unsigned int port, int clientId) {
-    std::cout << "[TWS] Attempting connection to " << host << ":" << port << "\n";
+template <typename Sink>
+bool BasicTwsClient<Sink>::createConnection(const std::string& host, unsigned int port, int clientId,
+                                             ReaderMode readerMode) {
+    // REASON: Kept for reconnect() - the same session is re-established in place
+    m_host = host;
+    m_port = port;
+    m_clientId = clientId;
+    m_requestedReaderMode = readerMode;
+    m_connectionLost.store(false);
+    return openConnection();
+}
+
+template <typename Sink>
+bool BasicTwsClient<Sink>::openConnection() {
+    std::cout << "[TWS] Attempting connection to " << m_host << ":" << m_port << "\n";
     
-    bool success = m_client->eConnect(host.c_str(), port, clientId, false);
+    const ReaderMode readerMode = m_requestedReaderMode;
+    // REASON: The vendored handshake select (eConnect) and EReader's select disconnect on EINTR - SIGPROF
+    // stays off this thread until the session is up, and the reader threads started below inherit the block
+    ProfilerSignalBlock noSigprof;
+    m_ready.store(false);  // REASON: A new session is not ready before its own nextValidId
+    bool success = m_client->eConnect(m_host.c_str(), m_port, m_clientId, false);
     if (!success) {
         std::cerr << "[TWS] eConnect failed\n";
         return false;
     }
+    // REASON: EClientSocket opens the socket inside eConnect - tuned per session, before any data flows
+    std::string refused;
+    if (!applySocketTuning(m_client->fd(), m_socketTuning, refused)) {
+        std::cerr << "[TWS] Socket options not applied (" << refused << ")\n";
+    }
     
-    // ========== START THREAD 3: EReader Socket Reader ==========
+    // ========== START THREAD 3: Socket Reader ==========
     // This spawns a new thread that reads from TWS socket and signals main thread
+    if (readerMode != ReaderMode::TwsApi) {
+        // PITFALL: eConnect registered its temporary handshake EReader (now destroyed) for
+        // eDisconnect() to stop - clear it, BridgeReader is stopped by disconnect() instead
+        m_client->registerEReader(nullptr);
+        m_readerMode = readerMode;
+        BridgeReaderConfig readerConfig;
+        readerConfig.inlineDispatch = readerMode == ReaderMode::Inline;
+        readerConfig.thread = m_readerThread;
+        readerConfig.pollTimeout = m_readerPoll;
+        readerConfig.quickAck = m_socketTuning.quickAck;
+        readerConfig.messages = m_messageFilter;
+        readerConfig.heartbeat = &m_readerHeartbeat;
+        m_bridgeReader = std::make_unique<BridgeReader>(m_client.get(), this, readerConfig, this);
+        if (m_bridgeReader->start()) {
+            m_connected.store(true);
+            std::cout << "[TWS] Connection established, "
+                      << (readerConfig.inlineDispatch ? "inline reader (no reader thread)" : "bridge reader thread started")
+                      << "\n";
+            return true;
+        }
+        std::cerr << "[TWS] Bridge reader unavailable, falling back to EReader\n";
+        m_bridgeReader.reset();
+        m_readerMode = ReaderMode::TwsApi;
+    }
     m_reader = std::make_unique<EReader>(m_client.get(), m_signal.get());
-    m_reader->start();  // <-- Internal std::thread created here by TWS API
+    {
+        // REASON: EReader's pthread inherits this thread's name, affinity and policy at creation
+        ScopedThreadConfig placement("tws-reader", m_readerThread);
+        m_reader->start();  // <-- Internal std::thread created here by TWS API
+    }
     m_connected.store(true);
     
     std::cout << "[TWS] Connection established, EReader thread started\n";
     return true;
 }
 
-void TwsClient::disconnect() {
+template <typename Sink>
+void BasicTwsClient<Sink>::disconnect() {
     if (m_connected.load()) {
         std::cout << "[TWS] Disconnecting...\n";
         m_connected.store(false);
+        if (m_bridgeReader) {
+            // REASON: Stop reading before the socket closes (EReader gets this from eDisconnect)
+            m_bridgeReader->stop();
+        }
         m_client->eDisconnect();
+        // REASON: Wakes a msgThread in waitForSignal() now, not at its timeout (shutdown in milliseconds)
+        m_signal->issueSignal();
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::abortConnection() {
+    if (!isConnected()) {
+        return;
     }
+    // REASON: shutdown(), not close() - the fd stays owned by the message thread, blocked reads and
+    // writes on it return at once and the normal socket-error path (reconnect()) takes over
+    const int fd = m_client->fd();
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+    m_signal->issueSignal();
 }
 
-bool TwsClient::isConnected() const {
+template <typename Sink>
+bool BasicTwsClient<Sink>::isConnected() const {
     return m_connected.load() && m_client->isConnected();
 }
 
-void TwsClient::subscribeTickByTick(const std::string& symbol, int tickerId) {
-    std::cout << "[TWS] Subscribing to tick-by-tick for " << symbol << " (tickerId=" << tickerId << ")\n";
+template <typename Sink>
+void BasicTwsClient<Sink>::releaseConnection() {
+    // REASON: Reader first (stops touching the socket), then the socket, then the old reader objects
+    m_connected.store(false);
+    if (m_bridgeReader) {
+        m_bridgeReader->stop();
+    }
+    m_client->eDisconnect();
+    m_bridgeReader.reset();
+    m_reader.reset();  // NOTE: Joins EReader's thread (the closed socket ended its read loop)
+}
+
+template <typename Sink>
+bool BasicTwsClient<Sink>::reconnect(const std::atomic<bool>& running) {
+    if (!m_reconnectPolicy.enabled || m_host.empty()) {
+        m_connectionLost.store(true);
+        return false;
+    }
+    releaseConnection();
+    std::cout << "[TWS] Connection lost, reconnecting (client ID " << m_clientId << ")\n";
+    BRIDGE_TRACE1(tws_reconnect, m_clientId);
     
-    // Store tickerId → symbol mapping for callback routing
-    m_tickerToSymbol[tickerId] = symbol;
+    const auto lostAt = std::chrono::steady_clock::now();
+    ReconnectBackoff backoff(m_reconnectPolicy);
+    while (running.load()) {
+        if (backoff.exhausted()) {
+            std::cerr << "[TWS] Giving up after " << backoff.attempts() << " reconnect attempts\n";
+            m_connectionLost.store(true);
+            return false;
+        }
+        // REASON: Sleep in short steps - shutdown must not wait out a long back-off
+        const auto deadline = std::chrono::steady_clock::now() + backoff.next();
+        while (running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        if (!running.load()) {
+            break;
+        }
+        if (openConnection()) {
+            // PERFORMANCE: Registry slots, tickerId routes, L1 books and worker state are untouched -
+            // the replayed streams land on warm InstrumentState, only the pacer limits recovery time
+            const std::size_t replayed = replaySubscriptions();
+            m_counters.reconnects.fetch_add(1, std::memory_order_relaxed);
+            const auto outage = std::chrono::steady_clock::now() - lostAt;
+            m_counters.reconnectTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(outage).count());
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(outage);
+            BRIDGE_TRACE3(tws_reconnected, m_clientId, backoff.attempts(), elapsed.count());
+            std::cout << "[TWS] Reconnected after " << elapsed.count() << " ms (" << backoff.attempts()
+                      << " attempts), replaying " << replayed << " subscriptions\n";
+            return true;
+        }
+        releaseConnection();
+    }
+    return false;
+}
+
+template <typename Sink>
+std::size_t BasicTwsClient<Sink>::replaySubscriptions() {
+    const std::size_t dropped = m_pacer.resetSession();
+    if (dropped != 0) {
+        std::cout << "[TWS] Dropped " << dropped << " cancels of the previous session\n";
+    }
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    // REASON: Withdraw first - a request still queued from the old session must not go out twice
+    auto resubmit = [this](RequestPacer::Ticket& ticket, const Replay& replay) {
+        m_pacer.withdraw(ticket);
+        ticket = submit(replay);
+    };
+    for (auto& entry : m_subscriptions) {
+        resubmit(entry.second.ticket, entry.second.replay);
+    }
+    if (m_backfillPolicy.enabled) {
+        openGaps();
+    }
+    for (auto& entry : m_depth) {
+        // REASON: TWS resends the whole book - drop the worker's copy first (as for error 317)
+        emitDepth(entry.second.tickerId, 0, depth::kReset, depth::kBid, 0.0, 0);
+        resubmit(entry.second.ticket, entry.second.replay);
+    }
+    for (auto& entry : m_realTimeBars) {
+        resubmit(entry.second.ticket, entry.second.replay);
+    }
+    if (m_accountFeed) {
+        // REASON: reqPositions answers every position again - each gets a fresh reqPnLSingle
+        m_pnlSingleReqIds.clear();
+        m_pnlSingleConIds.clear();
+        resubmit(m_accountTicket, m_accountReplay);
+    }
+    for (std::size_t i = 0; i < m_scanReplays.size(); ++i) {
+        m_scanCycles[i].clear();  // REASON: A cycle cut off by the disconnect is not posted half-filled
+        resubmit(m_scanTickets[i], m_scanReplays[i]);
+    }
+    for (std::size_t i = 0; i < m_newsReplays.size(); ++i) {
+        resubmit(m_newsTickets[i], m_newsReplays[i]);  // NOTE: Recent headlines come again - ArticleFilter drops them
+    }
+    for (auto& entry : m_sessionSeeds) {
+        if (!entry.second.answered) {
+            resubmit(entry.second.ticket, entry.second.replay);  // NOTE: Bars already delivered are seeded again
+        }
+    }
+    for (auto& entry : m_chains) {
+        ChainSubscription& chain = entry.second;
+        if (chain.definitionReqId != 0) {
+            // REASON: A partial answer of the old session is discarded - the new reqId starts the rows over
+            m_pacer.withdraw(chain.definitionTicket);
+            m_chainDefinitions.erase(chain.definitionReqId);
+            requestChainDefinition(entry.first, chain);
+        }
+        for (std::uint32_t leg = 0; leg < chain.tickets.size(); ++leg) {
+            m_pacer.withdraw(chain.tickets[leg]);
+            if (chain.listed[leg]) {
+                chain.tickets[leg] = submitChainLeg(entry.first, chain, leg);
+            }
+        }
+    }
+    m_counters.replays.fetch_add(1, std::memory_order_relaxed);
+    return m_subscriptions.size() + m_depth.size() + m_realTimeBars.size() + m_chains.size();
+}
+
+template <typename Sink>
+SlotId BasicTwsClient<Sink>::registerRequest(const std::string& symbol, int tickerId) {
+    // REASON: Subscribe calls may come from any thread; callbacks never take this lock
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    SlotId slot = m_registry.registerInstrument(symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        std::cerr << "[TWS] Instrument registry full, cannot subscribe " << symbol << "\n";
+        return kInvalidSlot;
+    }
+    if (!mapRequest(tickerId, slot)) {
+        return kInvalidSlot;
+    }
+    return slot;
+}
+
+template <typename Sink>
+bool BasicTwsClient<Sink>::mapRequest(int reqId, SlotId slot) {
+    if (!m_requests.publish(reqId, slot)) {
+        std::cerr << "[TWS] tickerId " << reqId << " outside request table (capacity "
+                  << m_requests.capacity() << ")\n";
+        return false;
+    }
+    return true;
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::resolveContract(Contract& contract, SlotId slot) {
+    // NOTE: The cache is keyed by bare symbol - only the bridge's default STK / USD contracts use it
+    if (m_contractCache == nullptr || contract.conId != 0 || contract.secType != "STK" || contract.currency != "USD") {
+        return;
+    }
+    CachedContract cached;
+    const bool hit = m_contractCache->find(contract.symbol, cached);
+    if (hit) {
+        // PERFORMANCE: conId identifies the contract outright - no ambiguity, no lookup before streaming
+        contract.conId = cached.conId;
+        if (contract.primaryExchange.empty()) {
+            contract.primaryExchange = cached.primaryExchange;
+        }
+        m_registry.setContract(slot, cached.conId, exchangeCode(cached.primaryExchange));
+        m_counters.contractHits.fetch_add(1, std::memory_order_relaxed);
+    }
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                                 std::chrono::system_clock::now().time_since_epoch()).count();
+    if (hit && !ContractCache::stale(cached, now, m_contractMaxAge)) {
+        return;
+    }
     
+    // REASON: Lazy refresh - a miss still subscribes by symbol right away, the answer is cached for next time
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    if (m_resolving.count(contract.symbol) != 0) {
+        return;
+    }
+    const int reqId = m_nextContractReqId++;
+    m_resolving.emplace(contract.symbol, reqId);
+    m_contractLookups.emplace(reqId, ContractLookup{contract.symbol, 0});
+    m_counters.contractLookups.fetch_add(1, std::memory_order_relaxed);
+    Contract lookup;
+    lookup.symbol = contract.symbol;
+    lookup.secType = contract.secType;
+    lookup.exchange = contract.exchange;
+    lookup.currency = contract.currency;
+    lookup.primaryExchange = hit ? std::string() : contract.primaryExchange;
+    // BACKPRESSURE: Lowest priority - every subscription goes out before the lookups
+    m_pacer.submit(std::numeric_limits<int>::min(), 1, 0, [this, reqId, lookup]() {
+        m_client->reqContractDetails(reqId, lookup);
+    });
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::finishContractLookup(int reqId, bool failed) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    const auto it = m_contractLookups.find(reqId);
+    if (it == m_contractLookups.end()) {
+        return;
+    }
+    if (failed) {
+        m_counters.contractFailures.fetch_add(1, std::memory_order_relaxed);
+    } else if (it->second.answers > 1) {
+        std::cerr << "[TWS] " << it->second.symbol << " is ambiguous (" << it->second.answers
+                  << " contracts), kept the first - subscribe with primaryExchange to choose\n";
+    }
+    // NOTE: contractDetails() starts a waiting chain - one still waiting here got no conId
+    const auto chain = m_chains.find(it->second.symbol);
+    if (chain != m_chains.end() && chain->second.awaitingConId) {
+        dropChain(it->second.symbol, "contract lookup failed");
+    }
+    m_resolving.erase(it->second.symbol);
+    m_contractLookups.erase(it);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::setBarSize(int tickerId, BarSize size) {
+    // NOTE: Relaxed - ordered before the callback's lookup by RequestTable::publish (release)
+    if (static_cast<unsigned>(tickerId) < m_barSizes.size()) {
+        m_barSizes[static_cast<std::size_t>(tickerId)].store(size, std::memory_order_relaxed);
+    }
+}
+
+template <typename Sink>
+BarSize BasicTwsClient<Sink>::barSizeOf(TickerId reqId) const {
+    if (static_cast<unsigned long long>(reqId) >= m_barSizes.size()) {
+        return BarSize::Unknown;
+    }
+    return m_barSizes[static_cast<std::size_t>(reqId)].load(std::memory_order_relaxed);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeTickByTick(const std::string& symbol, int tickerId, int priority) {
     // Create stock contract for US equities
     Contract contract;
     contract.symbol = symbol;
     contract.secType = "STK";
     contract.exchange = "SMART";
     contract.currency = "USD";
+    requestTickByTick(contract, tickerId, priority);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::requestTickByTick(Contract contract, int tickerId, int priority) {
+    std::cout << "[TWS] Subscribing to tick-by-tick for " << contract.symbol << " (tickerId=" << tickerId << ")\n";
+    
+    // Store tickerId → slot mapping for callback routing
+    // REASON: BidAsk and AllLast ids share one slot (one InstrumentState)
+    SlotId slot = registerRequest(contract.symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    resolveContract(contract, slot);
+    {
+        std::lock_guard<std::mutex> lock(m_subscribeMutex);
+        if (!mapRequest(tickerId + 10000, slot)) {
+            return;
+        }
+        
+        // Subscribe to both BidAsk and AllLast tick types (2 messages, 2 tick-by-tick streams)
+        // Convention: BidAsk uses base tickerId, AllLast uses tickerId + 10000
+        // REASON: Submitted under the lock - an unsubscribe always finds the ticket
+        Replay replay{priority, 2, 2, [this, contract, tickerId]() {
+            m_client->reqTickByTickData(tickerId, contract, "BidAsk", 0, true);
+            m_client->reqTickByTickData(tickerId + 10000, contract, "AllLast", 0, true);
+        }};
+        RequestPacer::Ticket ticket = submit(replay);
+        m_subscriptions[contract.symbol] = Subscription{tickerId, ticket, FeedType::TickByTick, std::move(replay),
+                                                        std::make_shared<const Contract>(contract)};
+        m_tickByTickStreams += 2;
+        requestSessionSeed(slot, contract);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeMarketData(const std::string& symbol, int tickerId, int priority) {
+    Contract contract;
+    contract.symbol = symbol;
+    contract.secType = "STK";
+    contract.exchange = "SMART";
+    contract.currency = "USD";
+    requestMarketData(contract, tickerId, priority);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::requestMarketData(Contract contract, int tickerId, int priority) {
+    std::cout << "[TWS] Subscribing to top-of-book for " << contract.symbol << " (tickerId=" << tickerId << ")\n";
+    
+    // REASON: One id carries bid, ask and last (TICK_PRICE / TICK_SIZE by tickType)
+    SlotId slot = registerRequest(contract.symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    resolveContract(contract, slot);
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    // 1 message, no tick-by-tick stream (L1 lines have their own, much larger allowance)
+    // Parameters: tickerId, contract, genericTicks (none), snapshot, regulatorySnapshot, options
+    Replay replay{priority, 1, 0, [this, contract, tickerId]() {
+        m_client->reqMktData(tickerId, contract, "", false, false, TagValueListSPtr());
+    }};
+    RequestPacer::Ticket ticket = submit(replay);
+    m_subscriptions[contract.symbol] = Subscription{tickerId, ticket, FeedType::TopOfBook, std::move(replay),
+                                                    std::make_shared<const Contract>(contract)};
+    requestSessionSeed(slot, contract);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeMidPoint(const std::string& symbol, int tickerId, int priority) {
+    Contract contract;
+    contract.symbol = symbol;
+    contract.secType = "STK";
+    contract.exchange = "SMART";
+    contract.currency = "USD";
+    requestMidPoint(contract, tickerId, priority);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::requestMidPoint(Contract contract, int tickerId, int priority) {
+    std::cout << "[TWS] Subscribing to tick-by-tick midpoint for " << contract.symbol << " (tickerId=" << tickerId
+              << ")\n";
     
-    // Subscribe to both BidAsk and AllLast tick types
-    // Convention: BidAsk uses base tickerId, AllLast uses tickerId + 10000
-    m_client->reqTickByTickData(tickerId, contract, "BidAsk", 0, true);
-    m_client->reqTickByTickData(tickerId + 10000, contract, "AllLast", 0, true);
+    SlotId slot = registerRequest(contract.symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    resolveContract(contract, slot);
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    // 1 message, 1 tick-by-tick stream (half of a BidAsk + AllLast pair)
+    Replay replay{priority, 1, 1, [this, contract, tickerId]() {
+        m_client->reqTickByTickData(tickerId, contract, "MidPoint", 0, true);
+    }};
+    RequestPacer::Ticket ticket = submit(replay);
+    m_subscriptions[contract.symbol] = Subscription{tickerId, ticket, FeedType::MidPoint, std::move(replay),
+                                                    std::make_shared<const Contract>(contract)};
+    m_tickByTickStreams += 1;
+    requestSessionSeed(slot, contract);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::unsubscribe(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    auto it = m_subscriptions.find(symbol);
+    if (it == m_subscriptions.end()) {
+        std::cerr << "[TWS] Not subscribed to " << symbol << "\n";
+        return;
+    }
+    const Subscription subscription = it->second;
+    const int tickerId = subscription.tickerId;
+    const bool tickByTick = subscription.feed == FeedType::TickByTick;
+    const bool midPoint = subscription.feed == FeedType::MidPoint;
+    m_subscriptions.erase(it);
+    // REASON: Unroute before cancelling - ticks still in flight for these ids are dropped
+    // NOTE: Registry slot is kept (worker state stays valid, a re-subscribe reuses it)
+    m_requests.publish(tickerId, kInvalidSlot);
+    if (tickByTick) {
+        m_requests.publish(tickerId + 10000, kInvalidSlot);
+        m_tickByTickStreams -= 2;
+    } else if (midPoint) {
+        m_tickByTickStreams -= 1;
+    }
     
-    // Store second tickerId mapping for AllLast
-    m_tickerToSymbol[tickerId + 10000] = symbol;
+    std::cout << "[TWS] Unsubscribing " << (tickByTick ? "tick-by-tick" : midPoint ? "midpoint" : "top-of-book")
+              << " for " << symbol
+              << " (tickerId=" << tickerId << ")\n";
+    if (m_pacer.withdraw(subscription.ticket)) {
+        return;  // Request never went out, nothing to cancel
+    }
+    // PERFORMANCE: Cancels go first - they free streams for waiting subscriptions
+    if (tickByTick) {
+        m_pacer.submit(RequestPacer::kCancelPriority, 2, -2, [this, tickerId]() {
+            m_client->cancelTickByTickData(tickerId);
+            m_client->cancelTickByTickData(tickerId + 10000);
+        });
+    } else if (midPoint) {
+        m_pacer.submit(RequestPacer::kCancelPriority, 1, -1, [this, tickerId]() {
+            m_client->cancelTickByTickData(tickerId);
+        });
+    } else {
+        m_pacer.submit(RequestPacer::kCancelPriority, 1, 0, [this, tickerId]() {
+            m_client->cancelMktData(tickerId);
+        });
+    }
 }
 
-void TwsClient::subscribeHistoricalBars(const std::string& symbol, int tickerId,
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeMarketDepth(const std::string& symbol, int tickerId, int numRows,
+                                                 bool smartDepth, int priority) {
+    std::cout << "[TWS] Subscribing to market depth for " << symbol << " (tickerId=" << tickerId
+              << ", rows=" << numRows << (smartDepth ? ", smart" : "") << ")\n";
+    
+    // REASON: Same slot as the symbol's quotes - the worker keys its book by slot
+    SlotId slot = registerRequest(symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    
+    Contract contract;
+    contract.symbol = symbol;
+    contract.secType = "STK";
+    contract.exchange = "SMART";
+    contract.currency = "USD";
+    resolveContract(contract, slot);
+    
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    // Parameters: tickerId, contract, numRows, isSmartDepth, mktDepthOptions
+    Replay replay{priority, 1, 0, [this, contract, tickerId, numRows, smartDepth]() {
+        m_client->reqMktDepth(tickerId, contract, numRows, smartDepth, TagValueListSPtr());
+    }};
+    RequestPacer::Ticket ticket = submit(replay);
+    m_depth[symbol] = DepthSubscription{tickerId, ticket, smartDepth, std::move(replay)};
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::unsubscribeMarketDepth(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    auto it = m_depth.find(symbol);
+    if (it == m_depth.end()) {
+        std::cerr << "[TWS] Not subscribed to market depth for " << symbol << "\n";
+        return;
+    }
+    const DepthSubscription subscription = it->second;
+    m_depth.erase(it);
+    m_requests.publish(subscription.tickerId, kInvalidSlot);
+    
+    std::cout << "[TWS] Unsubscribing market depth for " << symbol << " (tickerId=" << subscription.tickerId << ")\n";
+    if (m_pacer.withdraw(subscription.ticket)) {
+        return;
+    }
+    const int tickerId = subscription.tickerId;
+    const bool smartDepth = subscription.smartDepth;
+    m_pacer.submit(RequestPacer::kCancelPriority, 1, 0, [this, tickerId, smartDepth]() {
+        m_client->cancelMktDepth(tickerId, smartDepth);
+    });
+}
+
+// ========== Option Chains: secdef → legs → TICK_OPTION_COMPUTATION ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeOptionChain(const std::string& symbol, ChainRequest request, int priority) {
+    std::cout << "[TWS] Subscribing to the option chain of " << symbol << " (expiries=" << request.expiries << ")\n";
+    SlotId slot = kInvalidSlot;
+    {
+        std::lock_guard<std::mutex> lock(m_subscribeMutex);
+        if (m_chains.count(symbol) != 0) {
+            std::cout << "[TWS] Already subscribed to the option chain of " << symbol << "\n";
+            return;
+        }
+        // REASON: Greeks travel on the underlying's slot - same shard and worker state as its quotes
+        slot = m_registry.registerInstrument(symbol);
+    }
+    if (slot == kInvalidSlot) {
+        std::cerr << "[TWS] Instrument registry full, cannot subscribe the option chain of " << symbol << "\n";
+        return;
+    }
+    ChainSubscription chain;
+    chain.slot = slot;
+    chain.request = request;
+    chain.priority = priority;
+    const std::int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                                 std::chrono::system_clock::now().time_since_epoch()).count();
+    const bool cached = m_chainCache.find(symbol, now, chain.layout);
+    if (!cached) {
+        // NOTE: reqSecDefOptParams is keyed by the underlying's conId - a cache miss queues its lookup
+        chain.conId = m_registry.conId(slot);
+        if (chain.conId == 0) {
+            Contract contract;
+            contract.symbol = symbol;
+            contract.secType = "STK";
+            contract.exchange = "SMART";
+            contract.currency = "USD";
+            resolveContract(contract, slot);
+            chain.conId = static_cast<int>(contract.conId);
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    ChainSubscription& entry = m_chains[symbol] = std::move(chain);
+    if (cached) {
+        if (!startChainLegs(symbol, entry)) {
+            m_chains.erase(symbol);
+        }
+    } else if (entry.conId != 0) {
+        requestChainDefinition(symbol, entry);
+    } else if (m_resolving.count(symbol) != 0) {
+        entry.awaitingConId = true;
+    } else {
+        dropChain(symbol, "no conId (contract cache off)");
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::unsubscribeOptionChain(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    auto it = m_chains.find(symbol);
+    if (it == m_chains.end()) {
+        std::cerr << "[TWS] Not subscribed to the option chain of " << symbol << "\n";
+        return;
+    }
+    const ChainSubscription chain = std::move(it->second);
+    m_chains.erase(it);
+    if (chain.definitionReqId != 0) {
+        // NOTE: reqSecDefOptParams has no cancel - a late answer finds no definition and is ignored
+        m_pacer.withdraw(chain.definitionTicket);
+        m_chainDefinitions.erase(chain.definitionReqId);
+    }
+    std::size_t cancels = 0;
+    for (std::uint32_t leg = 0; leg < chain.tickets.size(); ++leg) {
+        const int tickerId = chain.firstTickerId + static_cast<int>(leg);
+        // REASON: Unroute before cancelling - greeks still in flight for the leg are dropped
+        m_optionLegs[static_cast<std::size_t>(tickerId - kOptionTickerIdBase)].slot = kInvalidSlot;
+        if (m_pacer.withdraw(chain.tickets[leg]) || !chain.listed[leg]) {
+            continue;  // Never sent, or refused by TWS (error 200) - nothing to cancel
+        }
+        m_pacer.submit(RequestPacer::kCancelPriority, 1, 0, [this, tickerId]() {
+            m_client->cancelMktData(tickerId);
+        });
+        ++cancels;
+    }
+    std::cout << "[TWS] Unsubscribing the option chain of " << symbol << " (" << chain.tickets.size() << " legs, "
+              << cancels << " cancels)\n";
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::requestChainDefinition(const std::string& symbol, ChainSubscription& chain) {
+    const int reqId = m_nextChainReqId++;
+    chain.definitionReqId = reqId;
+    chain.layout = OptionChainLayout();
+    chain.layoutRank = -1;
+    m_chainDefinitions[reqId] = symbol;
+    const int conId = chain.conId;
+    // Parameters: reqId, underlying symbol, futFopExchange ("" = equity / index options), secType, conId
+    chain.definitionTicket = m_pacer.submit(chain.priority, 1, 0, [this, reqId, symbol, conId]() {
+        m_client->reqSecDefOptParams(reqId, symbol, "", "STK", conId);
+    });
+}
+
+template <typename Sink>
+bool BasicTwsClient<Sink>::startChainLegs(const std::string& symbol, ChainSubscription& chain) {
+    chain.selection = selectChain(chain.layout, chain.request, expiryCodeOn(std::time(nullptr)));
+    const std::size_t legs = chain.selection.legCount();
+    if (legs == 0 || legs > kMaxChainLegs) {
+        std::cerr << "[TWS] Option chain of " << symbol << ": " << legs << " legs selected (1-" << kMaxChainLegs
+                  << "), narrow expiries / strikes\n";
+        return false;
+    }
+    chain.firstTickerId = m_nextOptionTickerId;
+    m_nextOptionTickerId += static_cast<int>(legs);
+    m_optionLegs.resize(static_cast<std::size_t>(m_nextOptionTickerId - kOptionTickerIdBase));
+    chain.tickets.assign(legs, 0);
+    chain.listed.assign(legs, true);
+    for (std::uint32_t leg = 0; leg < legs; ++leg) {
+        OptionLegRoute& route = m_optionLegs[static_cast<std::size_t>(chain.firstTickerId - kOptionTickerIdBase) + leg];
+        route.leg = leg;
+        route.expiry = expiryCode(chain.selection.expiryOf(leg));
+        route.put = ChainSelection::isPut(leg);
+        route.strike = chain.selection.strikeOf(leg);
+        route.slot = chain.slot;
+        chain.tickets[leg] = submitChainLeg(symbol, chain, leg);
+    }
+    std::cout << "[TWS] Option chain of " << symbol << ": " << chain.selection.expirations.size() << " expirations x "
+              << chain.selection.strikes.size() << " strikes (" << legs << " legs, tickerIds from "
+              << chain.firstTickerId << ")\n";
+    return true;
+}
+
+template <typename Sink>
+RequestPacer::Ticket BasicTwsClient<Sink>::submitChainLeg(const std::string& symbol, const ChainSubscription& chain,
+                                                          std::uint32_t leg) {
+    Contract contract;
+    contract.symbol = symbol;
+    contract.secType = "OPT";
+    contract.lastTradeDateOrContractMonth = chain.selection.expiryOf(leg);
+    contract.strike = chain.selection.strikeOf(leg);
+    contract.right = ChainSelection::isPut(leg) ? "P" : "C";
+    contract.multiplier = chain.layout.multiplier;
+    contract.tradingClass = chain.layout.tradingClass;
+    contract.exchange = "SMART";
+    contract.currency = "USD";
+    const int tickerId = chain.firstTickerId + static_cast<int>(leg);
+    // 1 message, an L1 line per leg (no tick-by-tick stream) - the model greeks arrive with it
+    // NOTE: The line's own bid / ask ticks find no RequestTable entry and are ignored (applyTopOfBook)
+    return m_pacer.submit(chain.priority, 1, 0, [this, tickerId, contract]() {
+        m_client->reqMktData(tickerId, contract, "", false, false, TagValueListSPtr());
+    });
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::dropChain(std::string symbol, const char* reason) {
+    const auto it = m_chains.find(symbol);
+    if (it == m_chains.end()) {
+        return;
+    }
+    std::cerr << "[TWS] Option chain of " << symbol << " dropped: " << reason << "\n";
+    if (it->second.definitionReqId != 0) {
+        m_chainDefinitions.erase(it->second.definitionReqId);
+    }
+    m_chains.erase(it);
+}
+
+template <typename Sink>
+int BasicTwsClient<Sink>::allocateTickerId() {
+    // Next id whose BidAsk and AllLast (+10000) entries are both unrouted, wraps within [1, 10000)
+    // NOTE: Callers passing explicit ids (main's bootstrap subscriptions) subscribe before commands run
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    for (int attempt = 1; attempt < 10000; ++attempt) {
+        int tickerId = m_nextCommandTickerId;
+        m_nextCommandTickerId = m_nextCommandTickerId % 9999 + 1;
+        if (m_requests.lookup(tickerId) == kInvalidSlot && m_requests.lookup(tickerId + 10000) == kInvalidSlot) {
+            return tickerId;
+        }
+    }
+    return -1;
+}
+
+template <typename Sink>
+std::size_t BasicTwsClient<Sink>::applyCommands(CommandQueue& commands) {
+    // REASON: Bounded per pass - a burst of commands must not stall tick dispatch
+    // (TWS paces requests anyway, the rest is applied on the next iterations)
+    constexpr std::size_t kMaxCommandsPerPass = 16;
+    SubscriptionCommand command;
+    std::size_t applied = 0;
+    while (applied < kMaxCommandsPerPass && commands.try_dequeue(command)) {
+        applyCommand(command);
+        ++applied;
+    }
+    return applied;
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::applyCommand(const SubscriptionCommand& command) {
+    if (command.action == CommandAction::Interest || command.action == CommandAction::Release) {
+        // NOTE: Consumer interest belongs to the main thread (SubscriptionDemand) - CommandListener routes it there
+        std::cerr << "[TWS] Interest command for " << command.symbol << " ignored\n";
+        return;
+    }
+    std::cout << "[TWS] Command" << (command.requestId.empty() ? "" : " " + command.requestId) << ": "
+              << (command.action == CommandAction::Subscribe ? "subscribe " : "unsubscribe ")
+              << command.symbol << "\n";
+    if (!isConnected()) {
+        std::cerr << "[TWS] Not connected, command dropped\n";
+        return;
+    }
+    // REASON: A chain is its own subscription next to the underlying's quotes - subscribed and cancelled alone
+    if (command.feed == FeedType::OptionChain) {
+        if (command.action == CommandAction::Subscribe) {
+            subscribeOptionChain(command.symbol, command.chain, command.priority);
+        } else {
+            unsubscribeOptionChain(command.symbol);
+        }
+        return;
+    }
+    if (command.action == CommandAction::Unsubscribe) {
+        unsubscribe(command.symbol);
+        return;
+    }
+    FeedType feed = command.feed;
+    {
+        std::lock_guard<std::mutex> lock(m_subscribeMutex);
+        if (m_subscriptions.count(command.symbol) != 0) {
+            std::cout << "[TWS] Already subscribed to " << command.symbol << "\n";
+            return;
+        }
+        if (feed == FeedType::Auto) {
+            // REASON: First come first served - streams go to the symbols subscribed (and paced) first
+            const bool streamsLeft = m_maxTickByTick == 0 || m_tickByTickStreams + 2 <= m_maxTickByTick;
+            feed = streamsLeft ? FeedType::TickByTick : FeedType::TopOfBook;
+        }
+    }
+    int tickerId = allocateTickerId();
+    if (tickerId < 0) {
+        std::cerr << "[TWS] No free tickerId, cannot subscribe " << command.symbol << "\n";
+        return;
+    }
+    
+    Contract contract;
+    contract.symbol = command.symbol;
+    contract.secType = command.secType;
+    contract.exchange = command.exchange;
+    contract.currency = command.currency;
+    contract.primaryExchange = command.primaryExchange;
+    if (feed == FeedType::TopOfBook) {
+        requestMarketData(contract, tickerId, command.priority);
+    } else if (feed == FeedType::MidPoint) {
+        requestMidPoint(contract, tickerId, command.priority);
+    } else {
+        requestTickByTick(contract, tickerId, command.priority);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeHistoricalBars(const std::string& symbol, int tickerId,
                                          const std::string& duration,
-                                         const std::string& barSize) {
+                                         const std::string& barSize,
+                                         bool keepUpToDate) {
     std::cout << "[TWS] Subscribing to historical bars for " << symbol 
               << " (tickerId=" << tickerId << ", duration=" << duration 
-              << ", barSize=" << barSize << ")\n";
+              << ", barSize=" << barSize << (keepUpToDate ? ", kept up to date" : "") << ")\n";
     
-    // Store tickerId → symbol mapping
-    m_tickerToSymbol[tickerId] = symbol;
+    // Store tickerId → slot mapping
+    const BarSize size = barSizeFromTws(barSize);
+    if (size == BarSize::Unknown) {
+        std::cerr << "[TWS] Unknown bar size \"" << barSize << "\" - bars of tickerId=" << tickerId
+                  << " will not be stored\n";
+    }
+    setBarSize(tickerId, size);
+    const SlotId slot = registerRequest(symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
     
     // Create stock contract
     Contract contract;
@@ -94,22 +863,69 @@ void TwsClient::subscribeHistoricalBars(const std::string& symbol, int tickerId,
     contract.secType = "STK";
     contract.exchange = "SMART";
     contract.currency = "USD";
+    resolveContract(contract, slot);
     
     // Request historical data
     // Parameters: tickerId, contract, endDateTime (empty=now), duration, barSize, 
     //             whatToShow, useRTH, formatDate, keepUpToDate, chartOptions
-    m_client->reqHistoricalData(tickerId, contract, "", duration, barSize, 
-                                 "TRADES", 1, 1, false, TagValueListSPtr());
+    // PERFORMANCE: formatDate=2 - intraday bars arrive as epoch seconds (no zone conversion)
+    // NOTE: keepUpToDate needs endDateTime empty (it is) - one request covers the backfill and the live bars
+    Replay replay{0, 1, 0, [this, tickerId, contract, duration, barSize, keepUpToDate]() {
+        m_client->reqHistoricalData(tickerId, contract, "", duration, barSize, 
+                                     "TRADES", 1, 2, keepUpToDate, TagValueListSPtr());
+    }};
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    RequestPacer::Ticket ticket = submit(replay);
+    if (keepUpToDate) {
+        m_realTimeBars[tickerId] = BarSubscription{ticket, std::move(replay)};
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::backfillHistoricalBars(const std::string& symbol, const std::string& endDateTime,
+                                                  const std::string& duration, const std::string& barSize) {
+    int reqId = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_subscribeMutex);
+        reqId = m_nextHistoryReqId++;
+        if (m_nextHistoryReqId >= static_cast<int>(RequestTable::kDefaultCapacity)) {
+            m_nextHistoryReqId = kHistoryReqIdBase;  // REASON: One-shot - ids that old were answered long ago
+        }
+    }
+    std::cout << "[TWS] Backfilling historical bars for " << symbol << " (reqId=" << reqId << ", end="
+              << endDateTime << ", duration=" << duration << ", barSize=" << barSize << ")\n";
+    setBarSize(reqId, barSizeFromTws(barSize));
+    const SlotId slot = registerRequest(symbol, reqId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    Contract contract;
+    contract.symbol = symbol;
+    contract.secType = "STK";
+    contract.exchange = "SMART";
+    contract.currency = "USD";
+    resolveContract(contract, slot);
+    Replay replay{0, 1, 0, [this, reqId, contract, endDateTime, duration, barSize]() {
+        m_client->reqHistoricalData(reqId, contract, endDateTime, duration, barSize,
+                                     "TRADES", 1, 2, false, TagValueListSPtr());
+    }};
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    submit(replay);
 }
 
-void TwsClient::subscribeRealTimeBars(const std::string& symbol, int tickerId,
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeRealTimeBars(const std::string& symbol, int tickerId,
                                        int barSize, const std::string& whatToShow) {
     std::cout << "[TWS] Subscribing to real-time bars for " << symbol 
               << " (tickerId=" << tickerId << ", barSize=" << barSize 
               << "s, whatToShow=" << whatToShow << ")\n";
     
-    // Store tickerId → symbol mapping
-    m_tickerToSymbol[tickerId] = symbol;
+    // Store tickerId → slot mapping
+    setBarSize(tickerId, barSizeFromSeconds(barSize));
+    const SlotId slot = registerRequest(symbol, tickerId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
     
     // Create stock contract
     Contract contract;
@@ -117,14 +933,60 @@ void TwsClient::subscribeRealTimeBars(const std::string& symbol, int tickerId,
     contract.secType = "STK";
     contract.exchange = "SMART";
     contract.currency = "USD";
+    resolveContract(contract, slot);
     
     // Request real-time bars
     // Parameters: tickerId, contract, barSize (seconds: 5 only), whatToShow, useRTH, realTimeBarsOptions
     // NOTE: TWS only supports 5-second bars for real-time
-    m_client->reqRealTimeBars(tickerId, contract, barSize, whatToShow, true, TagValueListSPtr());
+    Replay replay{0, 1, 0, [this, tickerId, contract, barSize, whatToShow]() {
+        m_client->reqRealTimeBars(tickerId, contract, barSize, whatToShow, true, TagValueListSPtr());
+    }};
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    RequestPacer::Ticket ticket = submit(replay);
+    m_realTimeBars[tickerId] = BarSubscription{ticket, std::move(replay)};
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::processMessages() {
+    processMessages(m_readerPoll);
 }
 
-void TwsClient::processMessages() {
+template <typename Sink>
+void BasicTwsClient<Sink>::processMessages(std::chrono::milliseconds inlineWait) {
+    m_dispatchHeartbeat.beat();
+    dispatchMessages(inlineWait);
+    // PERFORMANCE: The whole burst goes out in one bulk enqueue (and one wake-up) per shard
+    m_sink.flush();
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::dispatchMessages(std::chrono::milliseconds inlineWait) {
+    if (m_replayRequested) {
+        m_replayRequested = false;
+        std::cout << "[TWS] Market data lost (1101), replayed " << replaySubscriptions() << " subscriptions\n";
+    }
+    // REASON: TWS accepts requests once nextValidId arrived - earlier ones stay queued instead of
+    // being sent into the handshake (no fixed startup sleep needed)
+    if (isConnected() && m_ready.load()) {
+        // BACKPRESSURE: Sends only what the token bucket / stream limit allow, rest stays queued
+        // PERFORMANCE: The burst leaves in one write
+        CorkedClientSocket::Batch batch(*m_client);
+        m_pacer.pump();
+    }
+    if (m_bridgeReader && m_readerMode == ReaderMode::Inline) {
+        // PERFORMANCE: recv + decode + callbacks on this thread (no reader thread hop)
+        if (isConnected()) {
+            m_bridgeReader->pollInline(inlineWait);
+        }
+        return;
+    }
+    if (m_bridgeReader) {
+        // PERFORMANCE: eventfd wake-up, lock-free hand-off (timeout keeps shutdown responsive)
+        if (isConnected() && m_bridgeReader->waitForMessages(std::chrono::milliseconds(100))) {
+            m_bridgeReader->processMsgs();
+        }
+        return;
+    }
     if (!isConnected() || !m_reader) {
         return;
     }
@@ -138,29 +1000,155 @@ void TwsClient::processMessages() {
     }
 }
 
+template <typename Sink>
+std::size_t BasicTwsClient<Sink>::subscriptionCount() {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    return m_subscriptions.size();
+}
+
+// CRITICAL PATH: Handed to the sink policy, inlined (production: staged in a thread-local buffer - no queue
+// atomics, no wake-up per update)
+// NOTE: Always true - overflow is decided (and counted) when the sink is flushed
+template <typename Sink>
+bool BasicTwsClient<Sink>::enqueueUpdate(const TickUpdate& update) {
+    // PERFORMANCE: Relaxed add on this thread's own counter line (overflow is counted by the shard)
+    m_counters.ticksIn[static_cast<std::size_t>(update.type)].add();
+    // REASON: Journaled before the enqueue - the capture includes updates an overflow policy drops
+    if (m_journal) {
+        m_journal->append(update);
+    }
+    BRIDGE_TRACE2(tick_enqueue, update.slot, static_cast<int>(update.type));
+    m_sink.stage(update);
+    return true;
+}
+
 // ========== Inbound API: Callbacks TWS invokes ON us ==========
 
-void TwsClient::connectAck() {
+template <typename Sink>
+void BasicTwsClient<Sink>::connectAck() {
     std::cout << "[TWS] Connection acknowledged\n";
 }
 
 // ========== Critical Callbacks: Market Data ==========
 
-void TwsClient::nextValidId(OrderId orderId) {
+template <typename Sink>
+void BasicTwsClient<Sink>::nextValidId(OrderId orderId) {
     std::cout << "[TWS] nextValidId: " << orderId << " (connection confirmed)\n";
     m_nextValidOrderId.store(orderId);
+    m_readyAt.store(std::chrono::steady_clock::now().time_since_epoch().count());
+    m_ready.store(true);
 }
 
-void TwsClient::connectionClosed() {
+template <typename Sink>
+void BasicTwsClient<Sink>::contractDetails(int reqId, const ContractDetails& contractDetails) {
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(m_subscribeMutex);
+        const auto it = m_contractLookups.find(reqId);
+        if (it == m_contractLookups.end() || ++it->second.answers > 1) {
+            return;
+        }
+        symbol = it->second.symbol;
+    }
+    const Contract& contract = contractDetails.contract;
+    CachedContract cached;
+    cached.conId = static_cast<int>(contract.conId);
+    cached.primaryExchange = contract.primaryExchange;
+    cached.resolvedAt = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::system_clock::now().time_since_epoch()).count();
+    m_contractCache->store(symbol, cached);
+    // REASON: Workers pick it up on the symbol's next update (snapshot conId / primaryExchange)
+    const SlotId slot = m_registry.find(symbol);
+    if (slot != kInvalidSlot) {
+        m_registry.setContract(slot, cached.conId, exchangeCode(cached.primaryExchange));
+    }
+    std::cout << "[TWS] Resolved " << symbol << ": conId " << cached.conId << " (" << cached.primaryExchange << ")\n";
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    const auto chain = m_chains.find(symbol);
+    if (chain != m_chains.end() && chain->second.awaitingConId) {
+        chain->second.awaitingConId = false;
+        chain->second.conId = cached.conId;
+        requestChainDefinition(symbol, chain->second);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::contractDetailsEnd(int reqId) {
+    finishContractLookup(reqId, false);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::connectionClosed() {
     std::cout << "[TWS] Connection closed by server\n";
     m_connected.store(false);
 }
 
-void TwsClient::error(int id, time_t errorTime, int errorCode, const std::string& errorString, 
+template <typename Sink>
+void BasicTwsClient<Sink>::error(int id, time_t errorTime, int errorCode, const std::string& errorString, 
                       const std::string& advancedOrderRejectJson) {
     (void)errorTime;  // Unused in MVP
     (void)advancedOrderRejectJson;
     
+    // REASON: 317 = depth stream reset, TWS resends the book from scratch - drop the worker's copy
+    if (errorCode == 317) {
+        emitDepth(id, 0, depth::kReset, depth::kBid, 0.0, 0);
+    }
+    // REASON: 1101 = TWS ↔ IB connectivity restored but market data lost (socket stayed up) - same
+    // replay as a reconnect, run by processMessages() outside this callback (1102 = data kept, nothing to do)
+    if (errorCode == 1101) {
+        m_replayRequested = true;
+    }
+    // NOTE: A failed lookup (e.g. 200 = no security definition) ends without contractDetailsEnd
+    if (id >= kContractReqIdBase && id < kChainReqIdBase) {
+        finishContractLookup(id, true);
+    }
+    if (seedSlot(id) != kInvalidSlot) {
+        // NOTE: e.g. 162 (no historical data permission) - the statistics start from the live trades alone
+        finishSessionSeed(seedSlot(id));
+    } else if (id >= kNewsTickerIdBase) {
+        // NOTE: e.g. 10276 (news feed not subscribed) - the symbol's line stays silent, the others keep publishing
+    } else if (id >= kScannerReqIdBase) {
+        // NOTE: e.g. 162 (scan parameters invalid) - a partial cycle is dropped, never posted
+        const std::size_t scan = scanIndex(id);
+        if (scan < m_scanCycles.size()) {
+            m_scanCycles[scan].clear();
+        }
+    } else if (id >= kAccountReqIdBase) {
+        // NOTE: Nothing to undo - a failed reqPnL / reqPnLSingle leaves its row unwritten (logged below)
+    } else if (id >= kBackfillReqIdBase) {
+        // NOTE: e.g. 162 (pacing, no permissions) - the window stays unfilled, what arrived is written
+        const auto job = m_backfillJobs.find(id);
+        if (job != m_backfillJobs.end()) {
+            TickUpdate end;
+            end.slot = job->second.slot;
+            end.type = TickUpdateType::HistoryEnd;
+            end.flags = TickFlags::Backfill;
+            enqueueUpdate(end);
+            m_backfillJobs.erase(job);
+        }
+    } else if (id >= kOptionTickerIdBase) {
+        // REASON: 200 on a leg = strike not listed for that expiry (strikes are the union over all
+        // expirations) - expected for part of most chains: unrouted, not replayed, not logged one by one
+        const std::size_t index = static_cast<std::size_t>(id - kOptionTickerIdBase);
+        if (errorCode == 200 && index < m_optionLegs.size() && m_optionLegs[index].slot != kInvalidSlot) {
+            OptionLegRoute& route = m_optionLegs[index];
+            std::lock_guard<std::mutex> lock(m_subscribeMutex);
+            const auto chain = m_chains.find(m_registry.symbol(route.slot));
+            if (chain != m_chains.end()) {
+                chain->second.listed[route.leg] = false;
+            }
+            route.slot = kInvalidSlot;
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Info, "[TWS] Option leg {} not listed, dropped", id);
+            return;
+        }
+    } else if (id >= kChainReqIdBase) {
+        std::lock_guard<std::mutex> lock(m_subscribeMutex);
+        const auto definition = m_chainDefinitions.find(id);
+        if (definition != m_chainDefinitions.end()) {
+            dropChain(definition->second, "reqSecDefOptParams failed");
+        }
+    }
+    
     // Filter informational messages (TWS connection status codes)
     if (errorCode == 2104 || errorCode == 2106 || errorCode == 2158) {
         std::cout << "[TWS] Info [" << errorCode << "]: " << errorString << "\n";
@@ -169,120 +1157,626 @@ void TwsClient::error(int id, time_t errorTime, int errorCode, const std::string
     }
 }
 
-void TwsClient::tickByTickBidAsk(int reqId, time_t time, double bidPrice, double askPrice,
+template <typename Sink>
+void BasicTwsClient<Sink>::tickByTickBidAsk(int reqId, time_t time, double bidPrice, double askPrice,
                                  Decimal bidSize, Decimal askSize, 
                                  const TickAttribBidAsk& tickAttribBidAsk) {
     (void)tickAttribBidAsk;  // MVP doesn't use bid/ask attributes
+    emitBidAsk(reqId, static_cast<std::int64_t>(time) * 1000, bidPrice, askPrice,
+               decimalToQuantity(bidSize), decimalToQuantity(askSize));
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::tickByTickAllLast(int reqId, int tickType, time_t time, double price,
+                                  Decimal size, const TickAttribLast& tickAttribLast,
+                                  const std::string& exchange, const std::string& specialConditions) {
+    (void)tickType;
+    emitAllLast(reqId, static_cast<std::int64_t>(time) * 1000, price, decimalToQuantity(size), tickAttribLast.pastLimit,
+                exchangeCode(exchange), parseTradeConditions(specialConditions));
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::tickByTickMidPoint(int reqId, time_t time, double midPoint) {
+    emitMidPoint(reqId, static_cast<std::int64_t>(time) * 1000, midPoint);
+}
+
+// ========== Fast Path: TICK_BY_TICK without EDecoder ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::onTickByTick(const TickByTickFields& fields) {
+    // PERFORMANCE: Scaled-integer sizes + string_view exchange, no Decimal / std::string temporaries
+    switch (fields.tickType) {
+    case tick_by_tick::kBidAsk:
+        emitBidAsk(fields.reqId, fields.time * 1000, fields.bidPrice, fields.askPrice,
+                   Quantity{fields.bidSize, fields.sizeScale}, Quantity{fields.askSize, fields.sizeScale});
+        break;
+    case tick_by_tick::kLast:
+    case tick_by_tick::kAllLast:
+        // PERFORMANCE: Exchange / conditions become codes straight from the frame views (no std::string)
+        emitAllLast(fields.reqId, fields.time * 1000, fields.price, Quantity{fields.size, fields.sizeScale},
+                    (fields.attrMask & 0x1) != 0, exchangeCode(fields.exchange),
+                    parseTradeConditions(fields.specialConditions));
+        break;
+    case tick_by_tick::kMidPoint:
+        emitMidPoint(fields.reqId, fields.time * 1000, fields.midPoint);
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::onMarketDataTick(const MarketDataTickFields& fields) {
+    // PERFORMANCE: TICK_PRICE applies price + paired size at once - one update, not two
+    const Quantity size{fields.size, fields.sizeScale};
+    applyTopOfBook(fields.reqId, fields.tickType, fields.hasPrice ? &fields.price : nullptr, &size,
+                   (fields.attrMask & 0x2) != 0);
+}
+
+// ========== L1 Aggregation: TICK_PRICE / TICK_SIZE → BidAsk / AllLast ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::applyTopOfBook(int reqId, int tickType, const double* price, const Quantity* size,
+                                           bool pastLimit) {
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot || slot >= m_topOfBook.size()) {
+        return;  // NOTE: Also HIGH / LOW / CLOSE ... of unrouted ids - no log on this path
+    }
+    tickType = tick_by_tick::liveTickType(tickType);  // DELAYED_* (reqMarketDataType 3/4)
     
-    // Look up symbol from tickerId
-    auto it = m_tickerToSymbol.find(reqId);
-    if (it == m_tickerToSymbol.end()) {
-        std::cerr << "[TWS] Unknown tickerId: " << reqId << "\n";
+    // REASON: L1 carries no exchange time - stamp on receipt (only when something is emitted)
+    auto now = []() {
+        return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    };
+    TopOfBook& book = m_topOfBook[slot];
+    switch (tickType) {
+    case tick_by_tick::kBid:
+    case tick_by_tick::kBidSize:
+        if (price) {
+            book.bidPrice = *price;
+        }
+        if (size) {
+            book.bidSize = *size;
+        }
+        break;
+    case tick_by_tick::kAsk:
+    case tick_by_tick::kAskSize:
+        if (price) {
+            book.askPrice = *price;
+        }
+        if (size) {
+            book.askSize = *size;
+        }
+        break;
+    case tick_by_tick::kLastPrice:
+        if (price) {
+            book.lastPrice = *price;
+            book.lastPastLimit = pastLimit;
+        }
+        if (size) {
+            emitAllLast(reqId, now(), book.lastPrice, *size, book.lastPastLimit);
+        }
+        return;
+    case tick_by_tick::kLastSize:
+        // NOTE: Paired size after tickPrice(LAST), or a standalone print at the last price
+        if (size && book.lastPrice > 0.0) {
+            emitAllLast(reqId, now(), book.lastPrice, *size, book.lastPastLimit);
+        }
+        return;
+    default:
+        return;  // Other L1 fields (HIGH, LOW, VOLUME, ...) are not aggregated
+    }
+    if (size) {
+        emitBidAsk(reqId, now(), book.bidPrice, book.askPrice, book.bidSize, book.askSize);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::emitBidAsk(int reqId, std::int64_t timestamp, double bidPrice, double askPrice,
+                                       Quantity bidSize, Quantity askSize) {
+    const std::int64_t entryNs = latencyEntry();  // NOTE: Every callback / fast path branch starts here
+    BRIDGE_TRACE2(tick_callback, reqId, static_cast<int>(TickUpdateType::BidAsk));
+    // PERFORMANCE: Flat array lookup (no hashing)
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        // PERFORMANCE: Per-tick path - a stale stream after unsubscribe must not flood the console
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId: {}", reqId);
         return;
     }
+    noteLiveTick(slot, timestamp);  // NOTE: Before the guard - the first tick after a reconnect queues backfill
     
-    // CRITICAL PATH: Construct update on stack, enqueue without heap allocation
+    // CRITICAL PATH: Construct update on stack, enqueue without heap allocation (guarded in Debug builds)
+    AllocationGuard noAlloc;
     TickUpdate update;
-    update.tickerId = reqId;
+    update.slot = slot;
     update.type = TickUpdateType::BidAsk;
-    update.timestamp = time * 1000;  // Convert to milliseconds
-    update.bidPrice = bidPrice;
-    update.askPrice = askPrice;
-    update.bidSize = static_cast<int>(bidSize);
-    update.askSize = static_cast<int>(askSize);
+    update.timestamp = timestamp;
+    update.bidAsk.bidPrice = bidPrice;
+    update.bidAsk.askPrice = askPrice;
+    update.setQuoteSizes(bidSize, askSize);
+    update.bidAsk.stamps.receiveNs = receiveStamp();
     
     // CRITICAL: Non-blocking enqueue, target < 1μs
-    if (!m_queue.try_enqueue(update)) {
-        std::cerr << "[TWS] Queue full! Dropping BidAsk update\n";
-    }
+    // BACKPRESSURE: Overflow handled + counted by the shard policy, reported by the worker
+    stampUpdate(update, entryNs);
+    enqueueUpdate(update);
 }
 
-void TwsClient::tickByTickAllLast(int reqId, int tickType, time_t time, double price,
-                                  Decimal size, const TickAttribLast& tickAttribLast,
-                                  const std::string& exchange, const std::string& specialConditions) {
-    (void)tickType;
-    (void)exchange;
-    (void)specialConditions;
-    auto it = m_tickerToSymbol.find(reqId);
-    if (it == m_tickerToSymbol.end()) {
-        std::cerr << "[TWS] Unknown tickerId: " << reqId << "\n";
+template <typename Sink>
+void BasicTwsClient<Sink>::emitAllLast(int reqId, std::int64_t timestamp, double price, Quantity size,
+                                        bool pastLimit, ExchangeCode exchange, TradeConditions conditions) {
+    const std::int64_t entryNs = latencyEntry();  // NOTE: Every callback / fast path branch starts here
+    BRIDGE_TRACE2(tick_callback, reqId, static_cast<int>(TickUpdateType::AllLast));
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        // PERFORMANCE: Per-tick path - a stale stream after unsubscribe must not flood the console
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId: {}", reqId);
         return;
     }
+    noteLiveTick(slot, timestamp);
     
+    AllocationGuard noAlloc;
     TickUpdate update;
-    update.tickerId = reqId;
+    update.slot = slot;
     update.type = TickUpdateType::AllLast;
-    update.timestamp = time * 1000;  // Convert to milliseconds
-    update.lastPrice = price;
-    update.lastSize = static_cast<int>(size);
-    update.pastLimit = tickAttribLast.pastLimit;
+    update.timestamp = timestamp;
+    update.allLast.price = price;
+    update.setTradeSize(size);
+    update.allLast.exchange = exchange;
+    update.allLast.conditions = conditions;
+    update.allLast.stamps.receiveNs = receiveStamp();
+    if (pastLimit) {
+        update.flags |= TickFlags::PastLimit;
+    }
     
-    if (!m_queue.try_enqueue(update)) {
-        std::cerr << "[TWS] Queue full! Dropping AllLast update\n";
+    // BACKPRESSURE: Overflow handled + counted by the shard policy, reported by the worker
+    stampUpdate(update, entryNs);
+    enqueueUpdate(update);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::emitMidPoint(int reqId, std::int64_t timestamp, double midPoint) {
+    const std::int64_t entryNs = latencyEntry();  // NOTE: Every callback / fast path branch starts here
+    BRIDGE_TRACE2(tick_callback, reqId, static_cast<int>(TickUpdateType::MidPoint));
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId: {}", reqId);
+        return;
     }
+    
+    AllocationGuard noAlloc;
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::MidPoint;
+    update.timestamp = timestamp;
+    update.midPoint.midPoint = midPoint;
+    update.midPoint.stamps.receiveNs = receiveStamp();
+    
+    // BACKPRESSURE: Coalesced like BidAsk (same key) - a slow shard publishes the latest midpoint only
+    stampUpdate(update, entryNs);
+    enqueueUpdate(update);
 }
 
-// ========== Unused Callbacks (stub implementations) ==========
+// ========== Option Chain Callbacks: secdef rows, model greeks ==========
 
-void TwsClient::tickPrice(TickerId tickerId, TickType field, double price, const TickAttrib& attribs) {
-    (void)tickerId; (void)field; (void)price; (void)attribs;
-    // Not used in tick-by-tick mode
+template <typename Sink>
+void BasicTwsClient<Sink>::securityDefinitionOptionalParameter(int reqId, const std::string& exchange,
+                                                                int underlyingConId, const std::string& tradingClass,
+                                                                const std::string& multiplier,
+                                                                const std::set<std::string>& expirations,
+                                                                const std::set<double>& strikes) {
+    (void)underlyingConId;
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    const auto definition = m_chainDefinitions.find(reqId);
+    if (definition == m_chainDefinitions.end()) {
+        return;
+    }
+    ChainSubscription& chain = m_chains.at(definition->second);
+    const int rank = chainRowRank(exchange, tradingClass, definition->second);
+    if (rank <= chain.layoutRank) {
+        return;  // REASON: One row per exchange / class - only the best one is kept
+    }
+    chain.layoutRank = rank;
+    chain.layout.exchange = exchange;
+    chain.layout.tradingClass = tradingClass;
+    chain.layout.multiplier = multiplier;
+    // NOTE: std::set is ordered - YYYYMMDD strings sort by date, strikes ascending
+    chain.layout.expirations.assign(expirations.begin(), expirations.end());
+    chain.layout.strikes.assign(strikes.begin(), strikes.end());
 }
 
-void TwsClient::tickSize(TickerId tickerId, TickType field, Decimal size) {
-    (void)tickerId; (void)field; (void)size;
-    // Not used in tick-by-tick mode
+template <typename Sink>
+void BasicTwsClient<Sink>::securityDefinitionOptionalParameterEnd(int reqId) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    const auto definition = m_chainDefinitions.find(reqId);
+    if (definition == m_chainDefinitions.end()) {
+        return;
+    }
+    const std::string symbol = definition->second;
+    m_chainDefinitions.erase(definition);
+    ChainSubscription& chain = m_chains.at(symbol);
+    chain.definitionReqId = 0;
+    if (chain.layoutRank < 0) {
+        dropChain(symbol, "no options listed");
+        return;
+    }
+    chain.layout.resolvedAt = std::chrono::duration_cast<std::chrono::seconds>(
+                                  std::chrono::system_clock::now().time_since_epoch()).count();
+    m_chainCache.store(symbol, chain.layout);
+    if (!startChainLegs(symbol, chain)) {
+        m_chains.erase(symbol);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::tickOptionComputation(TickerId tickerId, TickType tickType, int tickAttrib,
+                                                  double impliedVol, double delta, double optPrice,
+                                                  double pvDividend, double gamma, double vega, double theta,
+                                                  double undPrice) {
+    (void)tickAttrib;
+    (void)pvDividend;
+    // REASON: Bid / ask / last computations repeat the model per quote side - the model line is the fair value
+    if (tickType != MODEL_OPTION && tickType != DELAYED_MODEL_OPTION_COMPUTATION) {
+        return;
+    }
+    const long long index = static_cast<long long>(tickerId) - kOptionTickerIdBase;
+    if (index < 0 || static_cast<unsigned long long>(index) >= m_optionLegs.size()) {
+        return;
+    }
+    const OptionLegRoute& route = m_optionLegs[static_cast<std::size_t>(index)];
+    if (route.slot == kInvalidSlot) {
+        return;
+    }
+    emitGreeks(route.slot, route.leg, route.expiry, route.put, route.strike, impliedVol, delta, gamma, vega, theta,
+               optPrice, undPrice);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::emitGreeks(SlotId slot, std::uint32_t leg, std::uint32_t expiry, bool put, double strike,
+                                       double impliedVol, double delta, double gamma, double vega, double theta,
+                                       double optionPrice, double underlyingPrice) {
+    // REASON: EDecoder turns TWS's "not computed" sentinels into DBL_MAX - published as null
+    auto computed = [](double value) {
+        return value == DBL_MAX ? std::nan("") : value;
+    };
+    
+    AllocationGuard noAlloc;
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::Greeks;
+    update.aux = leg;
+    update.timestamp = receiveStamp() / 1000000;  // REASON: Greeks carry no time of their own
+    update.greeks.strike = strike;
+    update.greeks.optionPrice = computed(optionPrice);
+    update.greeks.underlyingPrice = computed(underlyingPrice);
+    update.greeks.impliedVol = static_cast<float>(computed(impliedVol));
+    update.greeks.delta = static_cast<float>(computed(delta));
+    update.greeks.gamma = static_cast<float>(computed(gamma));
+    update.greeks.vega = static_cast<float>(computed(vega));
+    update.greeks.theta = static_cast<float>(computed(theta));
+    update.greeks.expiry = expiry;
+    if (put) {
+        update.flags |= TickFlags::Put;
+    }
+    
+    // BACKPRESSURE: Never coalesced (one record per leg) - dropped + counted when the shard is full
+    // NOTE: No latency stamps (GreeksPayload has no room) - the chain is throttled by ChainTimer anyway
+    enqueueUpdate(update);
+}
+
+// ========== Gap Backfill: reconnect → first live tick → reqHistoricalTicks ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::openGaps() {
+    // REASON: The window ends at the first live tick - only known once the replayed request streams again
+    for (const auto& entry : m_subscriptions) {
+        const Subscription& subscription = entry.second;
+        if (subscription.feed == FeedType::MidPoint) {
+            continue;  // REASON: No historical counterpart worth a request per symbol
+        }
+        const SlotId slot = m_requests.lookup(subscription.tickerId);
+        if (slot == kInvalidSlot || m_watermarks[slot].lastMs == 0) {
+            continue;  // Nothing streamed before the drop - no gap to bound
+        }
+        // NOTE: A gap still open from an earlier drop keeps its start
+        m_openGaps.emplace(slot, OpenGap{m_watermarks[slot].lastMs, subscription.contract});
+        m_watermarks[slot].gapOpen = true;
+    }
+    // REASON: Requests of the previous session are lost - unanswered pages go out again
+    for (auto& job : m_backfillJobs) {
+        m_pacer.withdraw(job.second.ticket);
+        submitBackfill(job.first, job.second);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::closeGap(SlotId slot, std::int64_t firstLiveMs) {
+    m_watermarks[slot].gapOpen = false;
+    const auto it = m_openGaps.find(slot);
+    if (it == m_openGaps.end()) {
+        return;
+    }
+    const OpenGap gap = std::move(it->second);
+    m_openGaps.erase(it);
+    const GapWindow window = gapWindow(gap.lastMs, firstLiveMs, m_backfillPolicy.maxGap);
+    if (window.empty()) {
+        return;
+    }
+    std::cout << "[TWS] Backfilling " << gap.contract->symbol << ": " << (window.toMs - window.fromMs) / 1000
+              << " s gap\n";
+    for (bool trades : {false, true}) {
+        const int reqId = m_nextBackfillReqId++;
+        BackfillJob& job = m_backfillJobs[reqId] = BackfillJob{slot, gap.contract, window, trades};
+        job.startSeconds = window.fromMs / 1000;
+        submitBackfill(reqId, job);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::submitBackfill(int reqId, BackfillJob& job) {
+    const std::string start = historicalTicksTime(job.startSeconds);
+    const char* whatToShow = job.trades ? "TRADES" : "BID_ASK";
+    // BACKPRESSURE: Lowest priority (with the contract lookups) - every live subscription goes out first
+    // Parameters: reqId, contract, start, end ("" = from start on), numberOfTicks, whatToShow, useRth (0 = all
+    // hours), ignoreSize (false: size-only quote changes too), miscOptions
+    job.ticket = m_pacer.submit(std::numeric_limits<int>::min(), 1, 0,
+                                [this, reqId, contract = job.contract, start, whatToShow]() {
+        m_client->reqHistoricalTicks(reqId, *contract, start, "", kHistoricalTicksPage, whatToShow, 0, false,
+                                     TagValueListSPtr());
+    });
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::historicalTicksBidAsk(int reqId, const std::vector<HistoricalTickBidAsk>& ticks, bool done) {
+    const auto it = m_backfillJobs.find(reqId);
+    if (it == m_backfillJobs.end()) {
+        return;
+    }
+    BackfillJob& job = it->second;
+    for (const HistoricalTickBidAsk& tick : ticks) {
+        if (!job.window.contains(tick.time)) {
+            continue;
+        }
+        TickUpdate update;
+        update.slot = job.slot;
+        update.type = TickUpdateType::BidAsk;
+        update.flags = TickFlags::Backfill;
+        update.timestamp = tick.time * 1000;
+        update.bidAsk.bidPrice = tick.priceBid;
+        update.bidAsk.askPrice = tick.priceAsk;
+        update.setQuoteSizes(decimalToQuantity(tick.sizeBid), decimalToQuantity(tick.sizeAsk));
+        // REASON: Same queue as the live ticks - journaled, routed to the slot's shard, never blocking it
+        enqueueUpdate(update);
+        ++job.ticks;
+    }
+    if (done) {
+        finishBackfillPage(reqId, ticks.size(), ticks.empty() ? 0 : ticks.back().time);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::historicalTicksLast(int reqId, const std::vector<HistoricalTickLast>& ticks, bool done) {
+    const auto it = m_backfillJobs.find(reqId);
+    if (it == m_backfillJobs.end()) {
+        return;
+    }
+    BackfillJob& job = it->second;
+    for (const HistoricalTickLast& tick : ticks) {
+        if (!job.window.contains(tick.time)) {
+            continue;
+        }
+        TickUpdate update;
+        update.slot = job.slot;
+        update.type = TickUpdateType::AllLast;
+        update.flags = TickFlags::Backfill;
+        if (tick.tickAttribLast.pastLimit) {
+            update.flags |= TickFlags::PastLimit;
+        }
+        update.timestamp = tick.time * 1000;
+        update.allLast.price = tick.price;
+        update.setTradeSize(decimalToQuantity(tick.size));
+        update.allLast.exchange = exchangeCode(tick.exchange);
+        update.allLast.conditions = parseTradeConditions(tick.specialConditions);
+        enqueueUpdate(update);
+        ++job.ticks;
+    }
+    if (done) {
+        finishBackfillPage(reqId, ticks.size(), ticks.empty() ? 0 : ticks.back().time);
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::finishBackfillPage(int reqId, std::size_t pageTicks, std::int64_t lastTickSeconds) {
+    const auto it = m_backfillJobs.find(reqId);
+    BackfillJob& job = it->second;
+    job.ticket = 0;
+    ++job.pages;
+    std::int64_t next = 0;
+    if (job.pages < m_backfillPolicy.maxPages && nextBackfillPage(job.window, pageTicks, lastTickSeconds, next)) {
+        job.startSeconds = next;
+        submitBackfill(reqId, job);
+        return;
+    }
+    // Worker writes what it holds for the slot as the last ("complete") batch
+    TickUpdate end;
+    end.slot = job.slot;
+    end.type = TickUpdateType::HistoryEnd;
+    end.flags = TickFlags::Backfill;
+    enqueueUpdate(end);
+    std::cout << "[TWS] Backfilled " << job.contract->symbol << (job.trades ? " trades: " : " quotes: ") << job.ticks
+              << " ticks in " << job.pages << " page(s)\n";
+    m_backfillJobs.erase(it);
+}
+
+// ========== L2 Callbacks: Depth changes → worker OrderBook ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::updateMktDepth(TickerId id, int position, int operation, int side, double price,
+                                           Decimal size) {
+    emitDepth(static_cast<int>(id), position, operation, side, price, decimalToShares(size));
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::updateMktDepthL2(TickerId id, int position, const std::string& marketMaker,
+                                             int operation, int side, double price, Decimal size,
+                                             bool isSmartDepth) {
+    (void)marketMaker;  // REASON: Book is aggregated by level, not by market maker
+    (void)isSmartDepth;
+    emitDepth(static_cast<int>(id), position, operation, side, price, decimalToShares(size));
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::emitDepth(int reqId, int position, int operation, int side, double price,
+                                      std::int64_t size) {
+    const std::int64_t entryNs = latencyEntry();  // NOTE: Every callback / fast path branch starts here
+    BRIDGE_TRACE2(tick_callback, reqId, static_cast<int>(TickUpdateType::Depth));
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    // REASON: Rows beyond the fixed book never fit - drop here instead of queueing them
+    if (position < 0 || static_cast<std::size_t>(position) >= DepthSide::kMaxLevels) {
+        return;
+    }
+    
+    AllocationGuard noAlloc;
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::Depth;
+    update.depth.stamps.receiveNs = receiveStamp();
+    update.timestamp = update.depth.stamps.receiveNs / 1000000;  // REASON: Depth carries no time of its own
+    update.depth.price = price;
+    update.depth.size = size;
+    update.depth.position = static_cast<std::uint8_t>(position);
+    update.depth.operation = static_cast<std::uint8_t>(operation);
+    update.depth.side = static_cast<std::uint8_t>(side);
+    
+    // BACKPRESSURE: Never coalesced (distinct records) - dropped + counted when the shard is full
+    stampUpdate(update, entryNs);
+    enqueueUpdate(update);
+}
+
+// ========== L1 Callbacks (EDecoder path: TwsApi mode, fast-path fallbacks) ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::tickPrice(TickerId tickerId, TickType field, double price, const TickAttrib& attribs) {
+    // REASON: EDecoder follows BID / ASK / LAST with tickSize for the paired size - store the
+    // price only, tickSize emits once both are known (same single update as onMarketDataTick)
+    applyTopOfBook(static_cast<int>(tickerId), static_cast<int>(field), &price, nullptr, attribs.pastLimit);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::tickSize(TickerId tickerId, TickType field, Decimal size) {
+    const Quantity quantity = decimalToQuantity(size);
+    applyTopOfBook(static_cast<int>(tickerId), static_cast<int>(field), nullptr, &quantity, false);
 }
 
-void TwsClient::tickString(TickerId tickerId, TickType tickType, const std::string& value) {
+// ========== Unused Callbacks (stub implementations) ==========
+
+template <typename Sink>
+void BasicTwsClient<Sink>::tickString(TickerId tickerId, TickType tickType, const std::string& value) {
     (void)tickerId; (void)tickType; (void)value;
     // Not used in tick-by-tick mode
 }
 
-void TwsClient::historicalData(TickerId reqId, const Bar& bar) {
-    // Look up symbol from tickerId
-    auto it = m_tickerToSymbol.find(reqId);
-    if (it == m_tickerToSymbol.end()) {
-        std::cerr << "[TWS] Unknown tickerId in historicalData: " << reqId << "\n";
+template <typename Sink>
+void BasicTwsClient<Sink>::historicalData(TickerId reqId, const Bar& bar) {
+    const SlotId seed = seedSlot(static_cast<int>(reqId));
+    if (seed != kInvalidSlot) {
+        // NOTE: Daily bars come as "yyyyMMdd" - the session of their date, not a point in time
+        TickUpdate update;
+        update.slot = seed;
+        update.type = TickUpdateType::Bar;
+        update.flags = TickFlags::SessionSeed;
+        if (!m_barTime.parse(bar.time, update.timestamp)) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unparseable seed bar time \"{}\" (reqId={}), skipped",
+                                bar.time, reqId);
+            return;
+        }
+        update.bar.open = bar.open;
+        update.bar.high = bar.high;
+        update.bar.low = bar.low;
+        update.bar.close = bar.close;
+        update.bar.volume = decimalToShares(bar.volume);
+        update.bar.wap = decimalToDouble(bar.wap);
+        update.aux = static_cast<std::uint32_t>(bar.count);
+        enqueueUpdate(update);
+        return;
+    }
+    // PERFORMANCE: Flat array lookup (no hashing)
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId in historicalData: {}", reqId);
         return;
     }
     
-    // Parse bar timestamp from TWS format (YYYYMMDD HH:MM:SS)
-    // For MVP, use current time (TODO: parse bar.time string properly)
-    long timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()
-    ).count();
+    // REASON: True bar time - backfills dedupe / merge with real-time bars by timestamp
+    std::int64_t timestamp = 0;
+    if (!m_barTime.parse(bar.time, timestamp)) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unparseable bar time \"{}\" (reqId={}), using receipt time",
+                            bar.time, reqId);
+        timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
     
     // Construct bar update
     TickUpdate update;
-    update.tickerId = reqId;
+    update.slot = slot;
     update.type = TickUpdateType::Bar;
+    update.flags = TickFlags::Historical;  // REASON: Collected by the worker, published on historicalDataEnd
+    update.setBarSize(barSizeOf(reqId));
     update.timestamp = timestamp;
-    update.open = bar.open;
-    update.high = bar.high;
-    update.low = bar.low;
-    update.close = bar.close;
-    update.volume = bar.volume;
-    update.wap = bar.wap;
-    update.barCount = bar.count;
-    
-    // Enqueue bar data
-    if (!m_queue.try_enqueue(update)) {
-        std::cerr << "[TWS] Queue full! Dropping bar update\n";
+    update.bar.open = bar.open;
+    update.bar.high = bar.high;
+    update.bar.low = bar.low;
+    update.bar.close = bar.close;
+    update.bar.volume = decimalToShares(bar.volume);
+    update.bar.wap = decimalToDouble(bar.wap);
+    update.aux = static_cast<std::uint32_t>(bar.count);
+    
+    // PERFORMANCE: No per-bar logging - a backfill is thousands of bars in one message
+    enqueueUpdate(update);
+}
+
+// Same updates as historicalData, one request lookup per message (bar times already in ms)
+template <typename Sink>
+void BasicTwsClient<Sink>::onHistoricalBars(const HistoricalBarBatch& batch) {
+    TickUpdate update;
+    update.type = TickUpdateType::Bar;
+    update.slot = seedSlot(batch.reqId);
+    if (update.slot != kInvalidSlot) {
+        update.flags = TickFlags::SessionSeed;
     } else {
-        std::cout << "[TWS] Historical bar: " << it->second 
-                  << " | O: " << bar.open << " H: " << bar.high 
-                  << " L: " << bar.low << " C: " << bar.close 
-                  << " V: " << bar.volume << "\n";
+        // PERFORMANCE: Flat array lookup (no hashing)
+        update.slot = m_requests.lookup(batch.reqId);
+        if (update.slot == kInvalidSlot) {
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId in historicalData: {}", batch.reqId);
+            return;
+        }
+        update.flags = TickFlags::Historical;
+        update.setBarSize(barSizeOf(batch.reqId));
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        update.timestamp = batch.time[i];
+        update.bar.open = batch.open[i];
+        update.bar.high = batch.high[i];
+        update.bar.low = batch.low[i];
+        update.bar.close = batch.close[i];
+        update.bar.volume = batch.volume[i];
+        update.bar.wap = batch.wap[i];
+        update.aux = static_cast<std::uint32_t>(batch.count[i]);
+        enqueueUpdate(update);
     }
 }
 
-void TwsClient::realtimeBar(TickerId reqId, long time, double open, double high, double low, 
+template <typename Sink>
+void BasicTwsClient<Sink>::realtimeBar(TickerId reqId, long time, double open, double high, double low, 
                              double close, Decimal volume, Decimal wap, int count) {
-    // Look up symbol from tickerId
-    auto it = m_tickerToSymbol.find(reqId);
-    if (it == m_tickerToSymbol.end()) {
-        std::cerr << "[TWS] Unknown tickerId in realtimeBar: " << reqId << "\n";
+    // PERFORMANCE: Flat array lookup (no hashing)
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId in realtimeBar: {}", reqId);
         return;
     }
     
@@ -291,32 +1785,341 @@ void TwsClient::realtimeBar(TickerId reqId, long time, double open, double high,
     
     // Construct bar update
     TickUpdate update;
-    update.tickerId = reqId;
+    update.slot = slot;
     update.type = TickUpdateType::Bar;
+    update.setBarSize(barSizeOf(reqId));
     update.timestamp = timestamp;
-    update.open = open;
-    update.high = high;
-    update.low = low;
-    update.close = close;
-    update.volume = volume;
-    update.wap = wap;
-    update.barCount = count;
+    update.bar.open = open;
+    update.bar.high = high;
+    update.bar.low = low;
+    update.bar.close = close;
+    update.bar.volume = decimalToShares(volume);
+    update.bar.wap = decimalToDouble(wap);
+    update.aux = static_cast<std::uint32_t>(count);
     
     // Enqueue real-time bar data
-    if (!m_queue.try_enqueue(update)) {
-        std::cerr << "[TWS] Queue full! Dropping real-time bar update\n";
-    } else {
-        std::cout << "[TWS] Real-time bar: " << it->second 
-                  << " | O: " << open << " H: " << high 
-                  << " L: " << low << " C: " << close 
-                  << " V: " << volume << "\n";
+    if (enqueueUpdate(update)) {
+        LOG_DEBUG("[TWS] Real-time bar: {} | O: {} H: {} L: {} C: {} V: {}", m_registry.symbol(slot),
+                  open, high, low, close, update.bar.volume);
     }
 }
 
-void TwsClient::historicalDataEnd(int reqId, const std::string& startDateStr, 
+template <typename Sink>
+void BasicTwsClient<Sink>::historicalDataUpdate(TickerId reqId, const Bar& bar) {
+    // PERFORMANCE: Flat array lookup (no hashing)
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unknown tickerId in historicalDataUpdate: {}", reqId);
+        return;
+    }
+    std::int64_t timestamp = 0;
+    if (!m_barTime.parse(bar.time, timestamp)) {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[TWS] Unparseable bar time \"{}\" (reqId={}), skipped",
+                            bar.time, reqId);
+        return;  // REASON: The start time is what says revision or new bar - receipt time cannot stand in
+    }
+    
+    // REASON: Revision of the in-progress bar (same start time) or the first update of the next one - the
+    // worker tells them apart by timestamp
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::Bar;
+    update.flags = TickFlags::Live;
+    update.setBarSize(barSizeOf(reqId));
+    update.timestamp = timestamp;
+    update.bar.open = bar.open;
+    update.bar.high = bar.high;
+    update.bar.low = bar.low;
+    update.bar.close = bar.close;
+    update.bar.volume = decimalToShares(bar.volume);
+    update.bar.wap = decimalToDouble(bar.wap);
+    update.aux = static_cast<std::uint32_t>(bar.count);
+    enqueueUpdate(update);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::historicalDataEnd(int reqId, const std::string& startDateStr, 
                                    const std::string& endDateStr) {
+    const SlotId seed = seedSlot(reqId);
+    if (seed != kInvalidSlot) {
+        finishSessionSeed(seed);  // PERFORMANCE: No log line - one seed per subscribed symbol
+        return;
+    }
     std::cout << "[TWS] Historical data complete for reqId=" << reqId 
               << " (start=" << startDateStr << ", end=" << endDateStr << ")\n";
+    
+    SlotId slot = m_requests.lookup(reqId);
+    if (slot == kInvalidSlot) {
+        return;
+    }
+    // REASON: Same shard queue as the bars (routed by slot), so the marker arrives after all of them
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::HistoryEnd;
+    update.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    enqueueUpdate(update);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeAccount(AccountQueue& feed, const std::string& account) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    if (m_accountFeed) {
+        std::cerr << "[TWS] Account already subscribed, ignoring " << account << "\n";
+        return;
+    }
+    m_accountFeed = &feed;
+    m_accountId = account;
+    // REASON: Sent by the pacer on the message thread - managedAccounts has arrived by then (TWS sends it
+    // right after the handshake, before nextValidId)
+    m_accountReplay = Replay{0, 3, 0, [this]() {
+        m_account = m_accountId.empty() ? m_managedAccount : m_accountId;
+        if (m_account.empty()) {
+            std::cerr << "[TWS] No account to stream (managedAccounts empty)\n";
+            return;
+        }
+        m_client->reqPnL(kAccountReqIdBase, m_account, "");
+        m_client->reqAccountUpdates(true, m_account);
+        m_client->reqPositions();
+        std::cout << "[TWS] Streaming PnL and positions of " << m_account << "\n";
+    }};
+    m_accountTicket = submit(m_accountReplay);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::managedAccounts(const std::string& accountsList) {
+    m_managedAccount = accountsList.substr(0, accountsList.find(','));
+}
+
+namespace {
+
+// Options / futures rows read better by their local symbol ("SPY   261120C00450000")
+std::string accountSymbol(const Contract& contract) {
+    return contract.localSymbol.empty() ? contract.symbol : contract.localSymbol;
+}
+
+} // namespace
+
+template <typename Sink>
+void BasicTwsClient<Sink>::position(const std::string& account, const Contract& contract, Decimal position,
+                                    double avgCost) {
+    if (!m_accountFeed || account != m_account) {
+        return;  // REASON: reqPositions answers for every account of the login
+    }
+    const double shares = decimalToDouble(position);
+    AccountUpdate update;
+    update.account = account;
+    update.conId = static_cast<int>(contract.conId);
+    update.symbol = accountSymbol(contract);
+    update.set(AccountField::Position, shares);
+    update.setReported(AccountField::AverageCost, avgCost);
+    emitAccount(std::move(update));
+    if (shares != 0.0) {
+        requestPnlSingle(static_cast<int>(contract.conId));
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::updatePortfolio(const Contract& contract, Decimal position, double marketPrice,
+                                           double marketValue, double averageCost, double unrealizedPNL,
+                                           double realizedPNL, const std::string& accountName) {
+    if (!m_accountFeed || accountName != m_account) {
+        return;
+    }
+    AccountUpdate update;
+    update.account = accountName;
+    update.conId = static_cast<int>(contract.conId);
+    update.symbol = accountSymbol(contract);
+    update.set(AccountField::Position, decimalToDouble(position));
+    update.setReported(AccountField::MarketPrice, marketPrice);
+    update.setReported(AccountField::MarketValue, marketValue);
+    update.setReported(AccountField::AverageCost, averageCost);
+    update.setReported(AccountField::UnrealizedPnl, unrealizedPNL);
+    update.setReported(AccountField::RealizedPnl, realizedPNL);
+    emitAccount(std::move(update));
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::pnl(int reqId, double dailyPnL, double unrealizedPnL, double realizedPnL) {
+    if (!m_accountFeed || reqId != kAccountReqIdBase) {
+        return;
+    }
+    AccountUpdate update;
+    update.account = m_account;
+    update.setReported(AccountField::DailyPnl, dailyPnL);
+    update.setReported(AccountField::UnrealizedPnl, unrealizedPnL);
+    update.setReported(AccountField::RealizedPnl, realizedPnL);
+    emitAccount(std::move(update));
+}
+
+// PERFORMANCE: About once a second per position - the worker's AccountTable folds these into one HSET of
+// the fields that moved per interval
+template <typename Sink>
+void BasicTwsClient<Sink>::pnlSingle(int reqId, Decimal pos, double dailyPnL, double unrealizedPnL,
+                                     double realizedPnL, double value) {
+    const auto conId = m_pnlSingleConIds.find(reqId);
+    if (!m_accountFeed || conId == m_pnlSingleConIds.end()) {
+        return;
+    }
+    AccountUpdate update;
+    update.account = m_account;
+    update.conId = conId->second;
+    update.set(AccountField::Position, decimalToDouble(pos));
+    update.setReported(AccountField::DailyPnl, dailyPnL);
+    update.setReported(AccountField::UnrealizedPnl, unrealizedPnL);
+    update.setReported(AccountField::RealizedPnl, realizedPnL);
+    update.setReported(AccountField::Value, value);
+    emitAccount(std::move(update));
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeScanners(const ScannerConfig& config, ScanOutbox& outbox) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    if (m_scanOutbox) {
+        std::cerr << "[TWS] Scanners already subscribed, ignoring\n";
+        return;
+    }
+    m_scanOutbox = &outbox;
+    m_scanCycles.resize(config.scans.size());
+    for (std::size_t i = 0; i < config.scans.size(); ++i) {
+        const int reqId = kScannerReqIdBase + static_cast<int>(i);
+        ScannerSubscription subscription;
+        subscription.numberOfRows = config.scans[i].rows;
+        subscription.instrument = config.scans[i].instrument;
+        subscription.locationCode = config.scans[i].location;
+        subscription.scanCode = config.scans[i].scanCode;
+        // NOTE: TWS keeps the scan running and resends it each refresh - one request per session
+        m_scanReplays.push_back(Replay{0, 1, 0, [this, reqId, subscription]() {
+            m_client->reqScannerSubscription(reqId, subscription, TagValueListSPtr(), TagValueListSPtr());
+        }});
+        m_scanTickets.push_back(submit(m_scanReplays.back()));
+        std::cout << "[TWS] Scanner " << config.scans[i].id << ": " << subscription.scanCode << " @ "
+                  << subscription.locationCode << " (" << subscription.numberOfRows << " rows)\n";
+    }
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::subscribeNews(NewsLane& lane, const std::vector<std::string>& symbols) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    if (m_newsLane) {
+        std::cerr << "[TWS] News already subscribed, ignoring\n";
+        return;
+    }
+    m_newsLane = &lane;
+    const std::string genericTicks = newsGenericTicks(lane.config.providers);
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        const int tickerId = kNewsTickerIdBase + static_cast<int>(i);
+        Contract contract;
+        contract.symbol = symbols[i];
+        contract.secType = "STK";
+        contract.exchange = "SMART";
+        contract.currency = "USD";
+        m_newsSymbols.push_back(symbols[i]);
+        // BACKPRESSURE: Below every live subscription (priority 0), above the lookups and backfill - headlines
+        // never delay a quote stream, yet are not starved by a long contract-resolution backlog
+        // NOTE: "mdoff" - the line carries headlines only, no quotes on top of the symbol's market data line
+        m_newsReplays.push_back(Replay{-1, 1, 0, [this, tickerId, contract, genericTicks]() {
+            m_client->reqMktData(tickerId, contract, genericTicks, false, false, TagValueListSPtr());
+        }});
+        m_newsTickets.push_back(submit(m_newsReplays.back()));
+    }
+    std::cout << "[TWS] News: " << symbols.size() << " symbols (" << genericTicks << ")\n";
+}
+
+// PERFORMANCE: Message thread - one provider lookup (lock-free once known) and one enqueue; the strings are
+// copied once into the item, dedupe and serialization happen on the draining worker
+template <typename Sink>
+void BasicTwsClient<Sink>::tickNews(int tickerId, time_t timeStamp, const std::string& providerCode,
+                                    const std::string& articleId, const std::string& headline,
+                                    const std::string& extraData) {
+    const std::size_t line = newsIndex(tickerId);
+    if (line == m_newsSymbols.size()) {
+        return;
+    }
+    NewsItem item;
+    item.symbol = m_newsSymbols[line];
+    item.timestampMs = static_cast<std::int64_t>(timeStamp);  // NOTE: TICK_NEWS carries Unix ms, not seconds
+    item.provider = m_newsLane->providers.intern(providerCode);
+    item.articleId = articleId;
+    item.headline = headline;
+    item.extraData = extraData;
+    m_newsLane->push(std::move(item));
+}
+
+// PERFORMANCE: A row is copied into the cycle's reused strings - no allocation once the scan has been this long
+template <typename Sink>
+void BasicTwsClient<Sink>::scannerData(int reqId, int rank, const ContractDetails& contractDetails,
+                                       const std::string& /*distance*/, const std::string& /*benchmark*/,
+                                       const std::string& /*projection*/, const std::string& /*legsStr*/) {
+    const std::size_t scan = scanIndex(reqId);
+    if (scan == m_scanCycles.size()) {
+        return;
+    }
+    const Contract& contract = contractDetails.contract;
+    ScanRow& row = m_scanCycles[scan].at(rank);
+    row.conId = contract.conId;
+    row.symbol = contract.symbol;
+    row.secType = contract.secType;
+    row.currency = contract.currency;
+    row.primaryExchange = contract.primaryExchange;
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::scannerDataEnd(int reqId) {
+    const std::size_t scan = scanIndex(reqId);
+    if (scan == m_scanCycles.size()) {
+        return;
+    }
+    m_scanOutbox->post(scan, m_scanCycles[scan]);  // NOTE: Leaves the cycle holding a cleared spare
 }
 
+// One reqPnLSingle per position for the session (message thread), paced like every other request
+template <typename Sink>
+void BasicTwsClient<Sink>::requestPnlSingle(int conId) {
+    if (m_pnlSingleReqIds.count(conId) != 0) {
+        return;
+    }
+    const int reqId = m_nextPnlSingleReqId++;
+    m_pnlSingleReqIds.emplace(conId, reqId);
+    m_pnlSingleConIds.emplace(reqId, conId);
+    m_pacer.submit(0, 1, 0, [this, reqId, conId]() {
+        m_client->reqPnLSingle(reqId, m_account, "", conId);
+    });
+}
+
+// One daily-bar request per slot for its lifetime - resubscribing, or another feed of the symbol, reuses the
+// statistics the worker already holds
+template <typename Sink>
+void BasicTwsClient<Sink>::requestSessionSeed(SlotId slot, const Contract& contract) {
+    if (!m_sessionSeeding || m_sessionSeeds.count(slot) != 0) {
+        return;
+    }
+    const int reqId = kSessionSeedReqIdBase + static_cast<int>(slot);
+    // BACKPRESSURE: Lowest priority (with the backfill) - every live subscription goes out first
+    // NOTE: "5 D" of 1 day bars - the previous session is in it across weekends and most holidays; useRTH=1,
+    // formatDate=1 (daily bars are "yyyyMMdd" either way)
+    SessionSeed& seed = m_sessionSeeds[slot];
+    seed.replay = Replay{std::numeric_limits<int>::min(), 1, 0, [this, reqId, contract]() {
+        m_client->reqHistoricalData(reqId, contract, "", "5 D", "1 day", "TRADES", 1, 1, false, TagValueListSPtr());
+    }};
+    seed.ticket = submit(seed.replay);
+}
+
+template <typename Sink>
+void BasicTwsClient<Sink>::finishSessionSeed(SlotId slot) {
+    std::lock_guard<std::mutex> lock(m_subscribeMutex);
+    const auto it = m_sessionSeeds.find(slot);
+    if (it != m_sessionSeeds.end()) {
+        it->second.answered = true;
+    }
+}
+
+// REASON: Explicit instantiation keeps the implementation out of the header - a new sink policy is added here
+// (and as an extern template in TwsClient.h)
+template class BasicTwsClient<BasicIngestStage<MpmcTickQueue>>;
+template class BasicTwsClient<BasicIngestStage<SpscTickQueue>>;
+template class BasicTwsClient<QueueSink<SpscTickQueue>>;
+template class BasicTwsClient<CoalescingSink<QueueSink<SpscTickQueue>>>;
+template class BasicTwsClient<JournalTee<BasicIngestStage<SpscTickQueue>>>;
+
 } // namespace tws_bridge
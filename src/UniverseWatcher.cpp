@@ -0,0 +1,171 @@
+// UniverseWatcher.cpp - Universe file / Redis set polling implementation
+
+#include "UniverseWatcher.h"
+#include "ThreadAffinity.h"
+#include <sw/redis++/redis++.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+// SMEMBERS of the universe set, sorted
+std::vector<std::string> readSet(sw::redis::Redis& redis, const std::string& key) {
+    sw::redis::ReplyUPtr reply = redis.command("SMEMBERS", key);
+    if (!reply || reply->type != REDIS_REPLY_ARRAY) {
+        throw sw::redis::Error("Unexpected SMEMBERS reply");
+    }
+    std::vector<std::string> symbols;
+    symbols.reserve(reply->elements);
+    for (std::size_t i = 0; i < reply->elements; ++i) {
+        symbols.emplace_back(reply->element[i]->str, reply->element[i]->len);
+    }
+    std::sort(symbols.begin(), symbols.end());
+    symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+    return symbols;
+}
+
+sw::redis::ConnectionOptions connectionOptions(const std::string& uri, const UniverseConfig& config) {
+    sw::redis::ConnectionOptions opts(uri);
+    opts.socket_timeout = config.socketTimeout;
+    opts.connect_timeout = config.socketTimeout;
+    return opts;
+}
+
+} // namespace
+
+UniverseWatcher::UniverseWatcher(const std::string& uri, UniverseConfig config, std::vector<std::string> pinned,
+                                 Apply apply)
+    : m_uri(uri)
+    , m_config(std::move(config))
+    , m_pinned(std::move(pinned))
+    , m_apply(std::move(apply)) {
+    std::sort(m_pinned.begin(), m_pinned.end());
+    m_pinned.erase(std::unique(m_pinned.begin(), m_pinned.end()), m_pinned.end());
+}
+
+UniverseWatcher::~UniverseWatcher() {
+    stop();
+}
+
+bool UniverseWatcher::load() {
+    std::vector<std::string> next;
+    if (!m_config.path.empty()) {
+        if (!readFile(next)) {
+            std::cerr << "[UNIVERSE] Cannot read " << m_config.path << "\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } else {
+        try {
+            sw::redis::Redis redis(connectionOptions(m_uri, m_config));
+            next = readSet(redis, m_config.key);
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[UNIVERSE] Cannot read " << m_config.key << ": " << e.what() << "\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    applyNext(std::move(next));
+    return true;
+}
+
+void UniverseWatcher::start() {
+    if (m_running.exchange(true)) {
+        return;
+    }
+    m_thread = std::thread([this]() { run(); });
+}
+
+void UniverseWatcher::stop() {
+    m_running.store(false);
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+bool UniverseWatcher::readFile(std::vector<std::string>& next) {
+    struct stat info {};
+    if (::stat(m_config.path.c_str(), &info) != 0) {
+        return false;
+    }
+    // REASON: stat() per poll, the file is only read after a write (mtime or size changed)
+    const std::int64_t stamp = static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+    const std::int64_t size = static_cast<std::int64_t>(info.st_size);
+    if (stamp == m_fileStamp && size == m_fileSize) {
+        next = m_current;
+        return true;
+    }
+    std::ifstream file(m_config.path);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    next = parseUniverse(text.str());
+    m_fileStamp = stamp;
+    m_fileSize = size;
+    return true;
+}
+
+void UniverseWatcher::applyNext(std::vector<std::string> next) {
+    if (next == m_current && m_counters.loads.load(std::memory_order_relaxed) > 0) {
+        return;
+    }
+    const UniverseDiff diff = diffUniverse(m_current, next, m_pinned);
+    m_current = std::move(next);
+    m_counters.loads.fetch_add(1, std::memory_order_relaxed);
+    m_counters.size.store(m_current.size(), std::memory_order_relaxed);
+    m_counters.added.fetch_add(diff.added.size(), std::memory_order_relaxed);
+    m_counters.removed.fetch_add(diff.removed.size(), std::memory_order_relaxed);
+    std::cout << "[UNIVERSE] " << m_current.size() << " symbols: +" << diff.added.size() << " -" << diff.removed.size()
+              << "\n";
+    if (!diff.added.empty() || !diff.removed.empty()) {
+        m_apply(diff);
+    }
+}
+
+void UniverseWatcher::run() {
+    nameCurrentThread("tws-universe");
+    // REASON: Sleep in short steps so stop() stays responsive
+    auto pause = [this](std::chrono::milliseconds delay) {
+        const auto step = std::min(delay, std::chrono::milliseconds(100));
+        const auto deadline = std::chrono::steady_clock::now() + delay;
+        while (m_running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(step);
+        }
+    };
+    if (!m_config.path.empty()) {
+        while (m_running.load()) {
+            pause(m_config.pollInterval);
+            std::vector<std::string> next;
+            if (!readFile(next)) {
+                m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+                continue;  // NOTE: Mid-rename or deleted - the last universe stays
+            }
+            applyNext(std::move(next));
+        }
+        return;
+    }
+    while (m_running.load()) {
+        try {
+            // REASON: Dedicated connection - SMEMBERS never queues behind a worker's pipeline
+            sw::redis::Redis redis(connectionOptions(m_uri, m_config));
+            while (m_running.load()) {
+                pause(m_config.pollInterval);
+                if (m_running.load()) {
+                    applyNext(readSet(redis, m_config.key));
+                }
+            }
+        } catch (const sw::redis::Error& e) {
+            std::cerr << "[UNIVERSE] Redis error: " << e.what() << " (keeping the last universe)\n";
+            m_counters.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,203 @@
+// WarmStart.cpp - TWS:LVC:* loader + snapshot parser (RapidJSON DOM, cold path)
+
+#include "WarmStart.h"
+#include "TradeCodes.h"
+#include "rapidjson/document.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tws_bridge {
+
+namespace {
+
+// Member names of one SnapshotSchema (SnapshotFields.h kSnapshotFields / kGroupNames)
+struct LastValueKeys {
+    const char* sequence;
+    const char* conId;
+    const char* primaryExchange;
+    const char* price;
+    const char* size;
+    const char* bid;
+    const char* ask;
+    const char* last;
+    const char* timestamps;
+    const char* quote;
+    const char* trade;
+    const char* exchange;
+    const char* conditions;
+    const char* attributes;
+    const char* pastLimit;
+};
+
+constexpr LastValueKeys kVerbose{"seq", "conId", "primaryExchange", "price", "size", "bid", "ask", "last", "timestamps",
+                                 "quote", "trade", "exchange", "conditions", "tickAttrib", "pastLimit"};
+constexpr LastValueKeys kCompact{"sq", "cid", "pex", "p", "s", "b", "a", "l", "tss", "q", "t", "ex", "cnd", "attr", "pl"};
+
+// Optional member - missing or mistyped ones keep the current value
+const rapidjson::Value* member(const rapidjson::Value& object, const char* name) {
+    if (!object.IsObject()) {
+        return nullptr;
+    }
+    auto it = object.FindMember(name);
+    return it == object.MemberEnd() ? nullptr : &it->value;
+}
+
+void readDouble(const rapidjson::Value& object, const char* name, double& out) {
+    const rapidjson::Value* value = member(object, name);
+    if (value && value->IsNumber()) {
+        out = value->GetDouble();
+    }
+}
+
+template <typename Int>
+void readInt(const rapidjson::Value& object, const char* name, Int& out) {
+    const rapidjson::Value* value = member(object, name);
+    if (value && value->IsInt64()) {
+        out = static_cast<Int>(value->GetInt64());
+    }
+}
+
+// Size member into state at state.sizeScale - integers as they are, fractional sizes by their shortest
+// fixed-notation digits ("0.5", never "5e-01")
+void readSize(const rapidjson::Value& object, const char* name, InstrumentState& state, std::int64_t& out) {
+    const rapidjson::Value* value = member(object, name);
+    if (value && value->IsInt64()) {
+        out = state.sizeUnits(Quantity{value->GetInt64(), 0});
+    } else if (value && value->IsNumber()) {
+        char text[64];
+        const std::to_chars_result result =
+            std::to_chars(text, text + sizeof(text), value->GetDouble(), std::chars_format::fixed);
+        if (result.ec == std::errc()) {
+            lvc_detail::readSize(std::string_view(text, static_cast<std::size_t>(result.ptr - text)), state, out);
+        }
+    }
+}
+
+std::string_view readString(const rapidjson::Value& object, const char* name) {
+    const rapidjson::Value* value = member(object, name);
+    return value && value->IsString() ? std::string_view(value->GetString(), value->GetStringLength())
+                                      : std::string_view();
+}
+
+// PERFORMANCE: HGETALL has no multi-key form - a pipeline of them keeps it one round trip per chunk
+void loadHashes(sw::redis::Redis& redis, const InstrumentRegistry& registry, const std::vector<SlotId>& slots,
+                std::size_t perRequest, std::vector<WarmStartEntry>& entries) {
+    std::vector<std::pair<std::string_view, std::string_view>> fields;
+    for (std::size_t first = 0; first < slots.size(); first += perRequest) {
+        const std::size_t last = std::min(slots.size(), first + perRequest);
+        sw::redis::Pipeline pipe = redis.pipeline(false);
+        for (std::size_t i = first; i < last; ++i) {
+            pipe.command("HGETALL", registry.channels(slots[i]).lastValue);
+        }
+        sw::redis::QueuedReplies replies = pipe.exec();
+        if (replies.size() != last - first) {
+            throw sw::redis::Error("Unexpected HGETALL replies");
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            // Reply: flat field / value array, empty for a missing key
+            const redisReply& reply = replies.get(i - first);
+            if (reply.type != REDIS_REPLY_ARRAY || reply.elements == 0) {
+                continue;
+            }
+            fields.clear();
+            for (std::size_t j = 0; j + 1 < reply.elements; j += 2) {
+                const redisReply* name = reply.element[j];
+                const redisReply* value = reply.element[j + 1];
+                fields.emplace_back(std::string_view(name->str, name->len), std::string_view(value->str, value->len));
+            }
+            WarmStartEntry entry{slots[i], InstrumentState{}};
+            if (parseLastValueHash(fields, entry.state)) {
+                entries.push_back(std::move(entry));
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool parseLastValue(const char* data, std::size_t length, InstrumentState& state) {
+    rapidjson::Document doc;
+    doc.Parse(data, length);
+    if (doc.HasParseError() || !doc.IsObject()) {
+        return false;
+    }
+    const LastValueKeys* keys = member(doc, "instrument") ? &kVerbose : member(doc, "sym") ? &kCompact : nullptr;
+    if (keys == nullptr) {
+        return false;
+    }
+
+    readInt(doc, keys->sequence, state.sequence);  // REASON: Consumers see the sequence continue, not restart
+    readInt(doc, keys->conId, state.conId);
+    // REASON: Static TradeCodes.h names - the state keeps a view, never a copy of the document
+    state.primaryExchange = exchangeName(exchangeCode(readString(doc, keys->primaryExchange)));
+    if (const rapidjson::Value* price = member(doc, keys->price)) {
+        readDouble(*price, keys->bid, state.bidPrice);
+        readDouble(*price, keys->ask, state.askPrice);
+        readDouble(*price, keys->last, state.lastPrice);
+    }
+    if (const rapidjson::Value* size = member(doc, keys->size)) {
+        readSize(*size, keys->bid, state, state.bidSize);
+        readSize(*size, keys->ask, state, state.askSize);
+        readSize(*size, keys->last, state, state.lastSize);
+    }
+    if (const rapidjson::Value* timestamps = member(doc, keys->timestamps)) {
+        readInt(*timestamps, keys->quote, state.quoteTimestamp);
+        readInt(*timestamps, keys->trade, state.tradeTimestamp);
+    }
+    state.hasQuote = state.quoteTimestamp != 0;
+    state.hasTrade = state.tradeTimestamp != 0;
+    state.exchange = exchangeName(exchangeCode(readString(doc, keys->exchange)));
+    state.tradeConditions = parseTradeConditions(readString(doc, keys->conditions));
+    if (const rapidjson::Value* attributes = member(doc, keys->attributes)) {
+        const rapidjson::Value* pastLimit = member(*attributes, keys->pastLimit);
+        state.pastLimit = pastLimit && pastLimit->IsBool() && pastLimit->GetBool();
+    }
+    return true;
+}
+
+std::vector<WarmStartEntry> loadLastValues(const std::string& uri, const InstrumentRegistry& registry,
+                                           const std::vector<SlotId>& slots, const WarmStartConfig& config) {
+    std::vector<WarmStartEntry> entries;
+    if (slots.empty()) {
+        return entries;
+    }
+    sw::redis::ConnectionOptions opts(uri);
+    opts.socket_timeout = config.socketTimeout;
+    sw::redis::Redis redis(opts);
+
+    const std::size_t perRequest = std::max<std::size_t>(config.keysPerRequest, 1);
+    if (config.format == LastValueFormat::Hash) {
+        loadHashes(redis, registry, slots, perRequest, entries);
+        return entries;
+    }
+    std::vector<std::string> args;
+    for (std::size_t first = 0; first < slots.size(); first += perRequest) {
+        const std::size_t last = std::min(slots.size(), first + perRequest);
+        args.assign({"MGET"});
+        for (std::size_t i = first; i < last; ++i) {
+            args.push_back(registry.channels(slots[i]).lastValue);
+        }
+        // Reply: one bulk string (or nil) per key, in argument order
+        sw::redis::ReplyUPtr reply = redis.command(args.begin(), args.end());
+        if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements != last - first) {
+            throw sw::redis::Error("Unexpected MGET reply");
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            const redisReply* value = reply->element[i - first];
+            if (value->type != REDIS_REPLY_STRING) {
+                continue;  // Never written (nil)
+            }
+            WarmStartEntry entry{slots[i], InstrumentState{}};
+            if (parseLastValue(value->str, value->len, entry.state)) {
+                entries.push_back(std::move(entry));
+            }
+        }
+    }
+    return entries;
+}
+
+} // namespace tws_bridge
@@ -0,0 +1,592 @@
+// WebSocketGateway.cpp - Embedded WebSocket server implementation
+
+#include "WebSocketGateway.h"
+#include "AsyncLogger.h"
+#include "ThreadAffinity.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <utility>
+
+namespace tws_bridge {
+
+namespace {
+
+constexpr std::size_t kMaxRequest = 8192;           // Upgrade request limit (headers only)
+constexpr std::size_t kMaxCommand = 4096;           // Client frame payload limit
+constexpr std::size_t kMaxIov = 256;                // iovecs per sendmsg
+
+template <typename T>
+void eraseValue(std::vector<T>& values, const T& value) {
+    const auto it = std::find(values.begin(), values.end(), value);
+    if (it != values.end()) {
+        *it = values.back();
+        values.pop_back();
+    }
+}
+
+} // namespace
+
+WebSocketGateway::WebSocketGateway(const InstrumentRegistry& registry, WebSocketConfig config)
+    : m_registry(registry)
+    , m_config(std::move(config))
+    , m_feed(1024)
+    , m_subscribers(registry.capacity())
+    , m_latest(registry.capacity()) {
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+WebSocketGateway::~WebSocketGateway() {
+    stop();
+    if (m_wakeFd >= 0) {
+        ::close(m_wakeFd);
+    }
+}
+
+bool WebSocketGateway::start() {
+    if (m_running.load()) {
+        return true;
+    }
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_listenFd < 0 || m_epollFd < 0 || m_wakeFd < 0) {
+        std::cerr << "[WEBSOCKET] socket setup failed: " << std::strerror(errno) << "\n";
+        stop();
+        return false;
+    }
+    const int reuse = 1;
+    ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(m_config.port);
+    if (::inet_pton(AF_INET, m_config.bindAddress.c_str(), &address.sin_addr) != 1
+        || ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(m_listenFd, 64) != 0) {
+        std::cerr << "[WEBSOCKET] Cannot listen on " << m_config.bindAddress << ":" << m_config.port << ": "
+                  << std::strerror(errno) << "\n";
+        stop();
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    m_boundPort.store(ntohs(address.sin_port), std::memory_order_release);
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_listenFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &event);
+    event.data.fd = m_wakeFd;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event);
+
+    m_running.store(true);
+    m_thread = std::thread([this]() { run(); });
+    std::cout << "[WEBSOCKET] Gateway on " << m_config.bindAddress << ":" << port() << " ("
+              << (m_config.binary ? "binary" : "json") << " frames)\n";
+    return true;
+}
+
+void WebSocketGateway::stop() {
+    m_running.store(false);
+    if (m_wakeFd >= 0) {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    while (!m_connections.empty()) {
+        close(m_connections.begin()->first);
+    }
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        m_listenFd = -1;
+    }
+    if (m_epollFd >= 0) {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+}
+
+void WebSocketGateway::onBatch(const SnapshotRecord* records, std::size_t count) {
+    const WsOpcode opcode = m_config.binary ? WsOpcode::Binary : WsOpcode::Text;
+    std::size_t queued = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const SnapshotRecord& record = records[i];
+        const std::string_view payload = m_config.binary ? record.binary : record.payload;
+        if (record.slot == kInvalidSlot || payload.empty()) {
+            continue;
+        }
+        // BACKPRESSURE: A stuck gateway thread must not grow the feed without bound
+        if (m_feed.size_approx() >= m_config.maxQueuedFrames) {
+            m_counters.dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        // PERFORMANCE: Framed once here - every connection sends these same bytes
+        auto frame = std::make_shared<std::string>();
+        frame->reserve(kWsMaxHeader + payload.size());
+        appendFrame(*frame, opcode, payload);
+        m_feed.enqueue(Published{record.slot, std::move(frame)});
+        ++queued;
+    }
+    if (queued > 0) {
+        // REASON: One wakeup per batch, not per record
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+    }
+}
+
+void WebSocketGateway::run() {
+    nameCurrentThread("tws-websocket");
+    epoll_event events[64];
+    while (m_running.load()) {
+        // REASON: Timeout keeps the stall check and late symbol resolution going on a quiet feed
+        const int ready = ::epoll_wait(m_epollFd, events, 64, 100);
+        for (int i = 0; i < ready; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == m_listenFd) {
+                accept();
+                continue;
+            }
+            if (fd == m_wakeFd) {
+                std::uint64_t wakeups = 0;
+                [[maybe_unused]] const ssize_t read = ::read(m_wakeFd, &wakeups, sizeof(wakeups));
+                continue;
+            }
+            const auto it = m_connections.find(fd);
+            if (it == m_connections.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+            bool keep = true;
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                keep = readFrom(connection);
+            }
+            if (keep && (events[i].events & EPOLLOUT)) {
+                keep = flush(connection);
+            }
+            if (!keep) {
+                close(fd);
+            }
+        }
+
+        m_batch.resize(256);
+        for (std::size_t count; (count = m_feed.try_dequeue_bulk(m_batch.begin(), m_batch.size())) > 0;) {
+            for (std::size_t i = 0; i < count; ++i) {
+                broadcast(m_batch[i]);
+                m_batch[i].frame.reset();
+            }
+        }
+        if (m_registry.size() != m_registered) {
+            resolvePending();
+        }
+        // PERFORMANCE: One sendmsg per connection per loop, however many symbols changed for it
+        for (std::size_t i = 0; i < m_dirty.size(); ++i) {
+            const auto it = m_connections.find(m_dirty[i]);
+            if (it == m_connections.end()) {
+                continue;
+            }
+            it->second->dirty = false;
+            if (it->second->writable && !flush(*it->second)) {
+                close(m_dirty[i]);
+            }
+        }
+        m_dirty.clear();
+        checkStalls();
+    }
+}
+
+void WebSocketGateway::accept() {
+    for (;;) {
+        const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        if (m_connections.size() >= m_config.maxConnections) {
+            m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[WEBSOCKET] Connection refused: {} open (websocket.max_connections)",
+                                m_connections.size());
+            ::close(fd);
+            continue;
+        }
+        const int noDelay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        m_connections.emplace(fd, std::move(connection));
+        m_counters.accepted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool WebSocketGateway::readFrom(Connection& connection) {
+    char buffer[4096];
+    for (;;) {
+        const ssize_t received = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        connection.input.append(buffer, static_cast<std::size_t>(received));
+    }
+    if (!connection.upgraded && !handshake(connection)) {
+        return false;
+    }
+    std::size_t used = 0;
+    while (connection.upgraded && used < connection.input.size()) {
+        WsFrame frame;
+        std::size_t consumed = 0;
+        const WsParse result = parseClientFrame(connection.input.data() + used, connection.input.size() - used,
+                                                kMaxCommand, frame, consumed);
+        if (result == WsParse::Incomplete) {
+            break;
+        }
+        // NOTE: Commands are a few bytes - a fragmented one is treated as a protocol error like any other
+        if (result == WsParse::Error || !frame.fin || frame.opcode == WsOpcode::Continuation) {
+            m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        used += consumed;
+        if (frame.opcode == WsOpcode::Text) {
+            command(connection, frame.payload);
+        } else if (frame.opcode == WsOpcode::Ping) {
+            auto pong = std::make_shared<std::string>();
+            appendFrame(*pong, WsOpcode::Pong, frame.payload);
+            enqueue(connection, kInvalidSlot, std::move(pong));
+        } else if (frame.opcode == WsOpcode::Close) {
+            // REASON: Best effort close reply - the connection goes away either way
+            std::string reply;
+            appendFrame(reply, WsOpcode::Close, frame.payload.substr(0, std::min<std::size_t>(frame.payload.size(), 2)));
+            [[maybe_unused]] const ssize_t sent = ::send(connection.fd, reply.data(), reply.size(), MSG_NOSIGNAL);
+            return false;
+        }
+    }
+    connection.input.erase(0, used);
+    return true;
+}
+
+bool WebSocketGateway::handshake(Connection& connection) {
+    const std::size_t end = connection.input.find("\r\n\r\n");
+    if (end == std::string::npos) {
+        return connection.input.size() <= kMaxRequest;
+    }
+    const std::string_view request(connection.input.data(), end + 2);
+    const std::string_view key = upgradeKey(request);
+    if (key.empty()) {
+        static constexpr char kBadRequest[] =
+            "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        [[maybe_unused]] const ssize_t sent = ::send(connection.fd, kBadRequest, sizeof(kBadRequest) - 1, MSG_NOSIGNAL);
+        m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    enqueue(connection, kInvalidSlot, std::make_shared<std::string>(upgradeResponse(key)));
+    connection.input.erase(0, end + 4);
+    connection.upgraded = true;
+    m_counters.connections.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void WebSocketGateway::command(Connection& connection, std::string_view text) {
+    auto next = [&text]() {
+        while (!text.empty() && (text.front() == ' ' || text.front() == ',' || text.front() == '\n'
+                                 || text.front() == '\r' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        std::size_t length = 0;
+        while (length < text.size() && text[length] != ' ' && text[length] != ',' && text[length] != '\n'
+               && text[length] != '\r' && text[length] != '\t') {
+            ++length;
+        }
+        const std::string_view token = text.substr(0, length);
+        text.remove_prefix(length);
+        return token;
+    };
+    const std::string_view verb = next();
+    const bool add = verb == "SUBSCRIBE";
+    if (!add && verb != "UNSUBSCRIBE") {
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[WEBSOCKET] Unknown command '{}' ignored", std::string(verb));
+        return;
+    }
+    for (std::string_view token = next(); !token.empty(); token = next()) {
+        const std::string symbol(token);
+        if (symbol == "*") {
+            if (add && !connection.all) {
+                // REASON: Per-symbol lists are dropped - "*" alone decides what this connection gets
+                for (const SlotId slot : connection.slots) {
+                    eraseValue(m_subscribers[slot], &connection);
+                }
+                connection.slots.clear();
+                connection.unresolved.clear();
+                connection.all = true;
+                m_allSubscribers.push_back(&connection);
+                for (std::size_t slot = 0; slot < m_latest.size(); ++slot) {
+                    if (m_latest[slot]) {
+                        enqueue(connection, static_cast<SlotId>(slot), m_latest[slot]);
+                    }
+                }
+            } else if (!add && connection.all) {
+                connection.all = false;
+                eraseValue(m_allSubscribers, &connection);
+            }
+            continue;
+        }
+        if (connection.all) {
+            continue;
+        }
+        const SlotId slot = m_registry.find(symbol);
+        if (add && slot == kInvalidSlot) {
+            if (std::find(connection.unresolved.begin(), connection.unresolved.end(), symbol)
+                == connection.unresolved.end()) {
+                connection.unresolved.push_back(symbol);
+            }
+        } else if (add) {
+            subscribe(connection, slot);
+        } else if (slot == kInvalidSlot) {
+            eraseValue(connection.unresolved, symbol);
+        } else {
+            unsubscribe(connection, slot);
+        }
+    }
+}
+
+void WebSocketGateway::subscribe(Connection& connection, SlotId slot) {
+    if (std::find(connection.slots.begin(), connection.slots.end(), slot) != connection.slots.end()) {
+        return;
+    }
+    connection.slots.push_back(slot);
+    m_subscribers[slot].push_back(&connection);
+    if (m_latest[slot]) {
+        enqueue(connection, slot, m_latest[slot]);
+    }
+}
+
+void WebSocketGateway::unsubscribe(Connection& connection, SlotId slot) {
+    eraseValue(connection.slots, slot);
+    eraseValue(m_subscribers[slot], &connection);
+}
+
+void WebSocketGateway::resolvePending() {
+    m_registered = m_registry.size();
+    for (auto& [fd, connection] : m_connections) {
+        auto& unresolved = connection->unresolved;
+        for (std::size_t i = 0; i < unresolved.size();) {
+            const SlotId slot = m_registry.find(unresolved[i]);
+            if (slot == kInvalidSlot) {
+                ++i;
+                continue;
+            }
+            subscribe(*connection, slot);
+            unresolved[i] = std::move(unresolved.back());
+            unresolved.pop_back();
+        }
+    }
+}
+
+void WebSocketGateway::broadcast(const Published& published) {
+    if (published.slot >= m_latest.size()) {
+        return;
+    }
+    m_latest[published.slot] = published.frame;
+    for (Connection* connection : m_subscribers[published.slot]) {
+        enqueue(*connection, published.slot, published.frame);
+    }
+    for (Connection* connection : m_allSubscribers) {
+        enqueue(*connection, published.slot, published.frame);
+    }
+}
+
+void WebSocketGateway::enqueue(Connection& connection, SlotId slot, const Frame& frame) {
+    if (slot != kInvalidSlot) {
+        const auto it = connection.queued.find(slot);
+        if (it != connection.queued.end()) {
+            Pending& pending = connection.queue[it->second];
+            // NOTE: A frame partly on the wire must finish - the new one queues behind it
+            if (it->second != connection.head || connection.offset == 0) {
+                pending.frame = frame;
+                m_counters.conflated.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        connection.queued[slot] = connection.queue.size();
+    }
+    connection.queue.push_back(Pending{frame, slot});
+    if (!connection.dirty) {
+        connection.dirty = true;
+        m_dirty.push_back(connection.fd);
+    }
+}
+
+bool WebSocketGateway::flush(Connection& connection) {
+    iovec iov[kMaxIov];
+    while (connection.head < connection.queue.size()) {
+        std::size_t count = 0;
+        for (std::size_t i = connection.head; i < connection.queue.size() && count < kMaxIov; ++i, ++count) {
+            const std::string& bytes = *connection.queue[i].frame;
+            const std::size_t skip = i == connection.head ? connection.offset : 0;
+            iov[count].iov_base = const_cast<char*>(bytes.data() + skip);
+            iov[count].iov_len = bytes.size() - skip;
+        }
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t sent = ::sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            // BACKPRESSURE: Socket buffer full - wait for EPOLLOUT, conflation keeps the backlog bounded
+            if (connection.blockedSince == std::chrono::steady_clock::time_point{}) {
+                connection.blockedSince = std::chrono::steady_clock::now();
+            }
+            if (connection.writable) {
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT;
+                event.data.fd = connection.fd;
+                ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+                connection.writable = false;
+            }
+            break;
+        }
+        connection.blockedSince = std::chrono::steady_clock::time_point{};
+        while (sent > 0) {
+            Pending& pending = connection.queue[connection.head];
+            const std::size_t left = pending.frame->size() - connection.offset;
+            if (static_cast<std::size_t>(sent) < left) {
+                connection.offset += static_cast<std::size_t>(sent);
+                break;
+            }
+            sent -= static_cast<ssize_t>(left);
+            if (pending.slot != kInvalidSlot) {
+                m_counters.frames.fetch_add(1, std::memory_order_relaxed);
+                const auto it = connection.queued.find(pending.slot);
+                if (it != connection.queued.end() && it->second == connection.head) {
+                    connection.queued.erase(it);
+                }
+            }
+            pending.frame.reset();
+            connection.offset = 0;
+            ++connection.head;
+        }
+    }
+    // REASON: Compact the sent prefix - queue indexes in `queued` shift with it
+    if (connection.head > 0) {
+        connection.queue.erase(connection.queue.begin(),
+                               connection.queue.begin() + static_cast<std::ptrdiff_t>(connection.head));
+        for (auto& [slot, index] : connection.queued) {
+            index -= connection.head;
+        }
+        connection.head = 0;
+    }
+    if (connection.queue.empty() && !connection.writable) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.writable = true;
+    }
+    return true;
+}
+
+void WebSocketGateway::close(int fd) {
+    const auto it = m_connections.find(fd);
+    if (it == m_connections.end()) {
+        return;
+    }
+    Connection& connection = *it->second;
+    for (const SlotId slot : connection.slots) {
+        eraseValue(m_subscribers[slot], &connection);
+    }
+    if (connection.all) {
+        eraseValue(m_allSubscribers, &connection);
+    }
+    if (connection.upgraded) {
+        m_counters.connections.fetch_sub(1, std::memory_order_relaxed);
+    }
+    if (m_epollFd >= 0) {
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+    ::close(fd);
+    m_connections.erase(it);
+}
+
+void WebSocketGateway::checkStalls() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastStallCheck < std::chrono::milliseconds(100)) {
+        return;
+    }
+    m_lastStallCheck = now;
+    std::vector<int> stalled;
+    std::vector<std::pair<std::size_t, int>> backlogs;  // (bytes, fd)
+    std::size_t buffered = 0;
+    for (const auto& [fd, connection] : m_connections) {
+        if (connection->blockedSince != std::chrono::steady_clock::time_point{}
+            && now - connection->blockedSince > m_config.stallTimeout) {
+            stalled.push_back(fd);
+        }
+        // NOTE: Frames are shared - a connection's backlog is what it pins, not what it alone allocated
+        std::size_t backlog = connection->input.size();
+        for (std::size_t i = connection->head; i < connection->queue.size(); ++i) {
+            backlog += connection->queue[i].frame->size();
+        }
+        if (connection->head < connection->queue.size()) {
+            backlog -= connection->offset;
+        }
+        buffered += backlog;
+        backlogs.emplace_back(backlog, fd);
+    }
+    if (m_config.memoryBudget > 0 && buffered > m_config.memoryBudget) {
+        // BACKPRESSURE: Largest backlogs first - the slowest readers go, everyone else keeps streaming
+        std::sort(backlogs.begin(), backlogs.end(), std::greater<>());
+        for (const auto& [backlog, fd] : backlogs) {
+            if (buffered <= m_config.memoryBudget || backlog == 0) {
+                break;
+            }
+            buffered -= backlog;
+            if (std::find(stalled.begin(), stalled.end(), fd) != stalled.end()) {
+                continue;  // REASON: Closed below either way
+            }
+            m_counters.overBudget.fetch_add(1, std::memory_order_relaxed);
+            BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn,
+                                "[WEBSOCKET] Closing a connection holding {} bytes (memory budget {} bytes)", backlog,
+                                m_config.memoryBudget);
+            close(fd);
+        }
+    }
+    m_counters.bufferedBytes.store(buffered, std::memory_order_relaxed);
+    for (const int fd : stalled) {
+        // PITFALL: Conflation bounds memory, not time - a client that reads nothing holds a socket forever
+        m_counters.stalled.fetch_add(1, std::memory_order_relaxed);
+        BRIDGE_LOG_EVERY_MS(1000, LogLevel::Warn, "[WEBSOCKET] Closing a connection stalled for over {}ms",
+                            m_config.stallTimeout.count());
+        close(fd);
+    }
+}
+
+} // namespace tws_bridge
@@ -2,211 +2,1815 @@
 // ARCHITECTURE: Producer-Consumer pattern with lock-free queue
 
 #include "TwsClient.h"
+#include "AllocationTracker.h"
+#include "AsyncLogger.h"
+#include "BridgeConfig.h"
+#include "CommandListener.h"
+#include "ConnectionRouting.h"
+#include "HistoryCache.h"
+#include "JournalExport.h"
+#include "JournalReplay.h"
+#include "JournalServer.h"
+#include "JsonLinesSink.h"
+#include "KafkaSink.h"
+#include "LeaderLease.h"
+#include "MarketScanner.h"
+#include "MetricsServer.h"
+#include "PartitionMembership.h"
+#include "ProfilerSignal.h"
+#include "QueryServer.h"
 #include "RedisPublisher.h"
-#include "Serialization.h"
+#include "RedisWorker.h"
+#include "ShardRebalancer.h"
+#include "ShardRouter.h"
+#include "StateCheckpoint.h"
+#include "SubscriberTracker.h"
+#include "SubscriptionDemand.h"
+#include "TimeSeries.h"
+#include "TaskPool.h"
 #include "MarketData.h"
+#include "ThreadAffinity.h"
+#include "TickJournal.h"
+#include "TraceExport.h"
+#include "TscClock.h"
+#include "UniverseWatcher.h"
+#include "WarmStart.h"
+#include "WebSocketGateway.h"
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
 #include <thread>
 #include <atomic>
 #include <csignal>
 #include <chrono>
-#include <concurrentqueue.h>
+#include <future>
+#include <mutex>
+#include <string>
+#include <set>
+#include <sstream>
+#include <vector>
 
 using namespace tws_bridge;
 
 // REASON: Global flag for graceful shutdown on SIGINT/SIGTERM
-static std::atomic<bool> g_running{true};
+// PERFORMANCE: Own cache lines - polled by every msgThread / worker iteration, never next to a written global
+alignas(64) static std::atomic<bool> g_running{true};
+// REASON: Workers outlive ingestion on shutdown - they drain what the msgThreads queued before the stop
+alignas(64) static std::atomic<bool> g_workersRunning{true};
 
 void signalHandler(int signal) {
     std::cout << "\n[MAIN] Received signal " << signal << ", shutting down...\n";
     g_running.store(false);
 }
 
-// REASON: Consumer thread - dequeues TickUpdates, aggregates state, publishes to Redis
-void redisWorkerLoop(moodycamel::ConcurrentQueue<TickUpdate>& queue, 
-                     RedisPublisher& redis,
-                     std::atomic<bool>& running) {
-    std::cout << "[WORKER] Redis worker thread started\n";
-    
-    // REASON: InstrumentState map for aggregating BidAsk + AllLast updates
-    std::unordered_map<std::string, InstrumentState> stateMap;
-    
-    TickUpdate update;
-    while (running.load()) {
-        // REASON: Non-blocking dequeue with short timeout for responsive shutdown
-        if (queue.try_dequeue(update)) {
-            // REASON: Get symbol from tickerId map (need to pass from TwsClient)
-            // For now, derive symbol from tickerId (temporary hack)
-            std::string symbol = "UNKNOWN";
-            if (update.tickerId == 1001 || update.tickerId == 11001) symbol = "AAPL";
-            else if (update.tickerId == 1002 || update.tickerId == 11002) symbol = "SPY";
-            else if (update.tickerId == 1003 || update.tickerId == 11003) symbol = "TSLA";
-            else if (update.tickerId == 2001) symbol = "SPY";  // Historical bars
-            else if (update.tickerId == 3001) symbol = "SPY";  // Real-time bars
-            
-            // PERFORMANCE: State aggregation logic (merge BidAsk + AllLast)
-            auto& state = stateMap[symbol];
-            state.symbol = symbol;
-            state.tickerId = update.tickerId;
-            
-            if (update.type == TickUpdateType::BidAsk) {
-                state.bidPrice = update.bidPrice;
-                state.askPrice = update.askPrice;
-                state.bidSize = update.bidSize;
-                state.askSize = update.askSize;
-                state.quoteTimestamp = update.timestamp;
-                state.hasQuote = true;
-            } else if (update.type == TickUpdateType::AllLast) {
-                state.lastPrice = update.lastPrice;
-                state.lastSize = update.lastSize;
-                state.tradeTimestamp = update.timestamp;
-                state.hasTrade = true;
-                state.pastLimit = update.pastLimit;
-            } else if (update.type == TickUpdateType::Bar) {
-                // PIVOT: Bar data handling for Gate 2a-2c testing
-                std::cout << "[WORKER] Bar: " << symbol 
-                          << " | O: " << update.open << " H: " << update.high
-                          << " L: " << update.low << " C: " << update.close
-                          << " V: " << update.volume << "\n";
-                
-                // Publish bar data immediately (no aggregation needed)
-                try {
-                    std::string json = serializeBarData(symbol, update);
-                    
-                    std::string channel = "TWS:BARS:" + symbol;
-                    redis.publish(channel, json);
-                    std::cout << "[WORKER] Published bar to " << channel << "\n";
-                } catch (const std::exception& e) {
-                    std::cerr << "[WORKER] Redis publish error: " << e.what() << "\n";
-                }
-                continue;  // Skip tick aggregation logic
-            }
-            
-            // REASON: Only publish when we have both BidAsk AND AllLast
-            if (state.hasQuote && state.hasTrade) {
-                try {
-                    std::string json = serializeState(state);
-                    std::string channel = "TWS:TICKS:" + symbol;
-                    redis.publish(channel, json);
-                    
-                    // PERFORMANCE: Minimal logging (can be removed in production)
-                    std::cout << "[WORKER] Published: " << symbol 
-                              << " | Bid: " << state.bidPrice 
-                              << " | Ask: " << state.askPrice 
-                              << " | Last: " << state.lastPrice << "\n";
-                } catch (const std::exception& e) {
-                    std::cerr << "[WORKER] Redis publish error: " << e.what() << "\n";
-                }
+// REASON: SIGHUP only raises a flag, the main thread's monitor loop re-reads the configuration
+static std::atomic<bool> g_reload{false};
+
+void reloadHandler(int /*signal*/) {
+    g_reload.store(true);
+}
+
+// Where the configuration comes from (re-read on SIGHUP)
+struct ConfigSource {
+    std::string path;                     // --config ("" = built-in defaults)
+    std::vector<std::string> overrides;   // --set and the shorthand flags, applied after the file
+
+    bool load(ConfigFile& file, std::string& error) const {
+        if (!path.empty() && !file.load(path, error)) {
+            return false;
+        }
+        for (const std::string& assignment : overrides) {
+            if (!file.set(assignment, error)) {
+                return false;
             }
-        } else {
-            // REASON: Yield CPU when queue is empty (avoid busy-wait)
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
         }
+        return true;
     }
-    
-    std::cout << "[WORKER] Redis worker thread stopped\n";
+};
+
+// SIGHUP: reloadable keys take effect, other changes are only reported (they need a restart)
+// NOTE: Compared against the startup configuration - a pending restart is reported on every reload
+static void reloadConfig(const ConfigSource& source, const ConfigFile& running) {
+    ConfigFile next;
+    BridgeConfig config;
+    std::string error;
+    if (!source.load(next, error) || !applyConfig(next, config, error)) {
+        std::cerr << "[CONFIG] Reload rejected, configuration unchanged:\n" << error << "\n";
+        return;
+    }
+    std::set<std::string> keys;
+    for (const ConfigFile* file : {&running, static_cast<const ConfigFile*>(&next)}) {
+        for (const auto& entry : file->values()) {
+            keys.insert(entry.first);
+        }
+    }
+    for (const std::string& key : keys) {
+        const ConfigValue* before = running.find(key);
+        const ConfigValue* after = next.find(key);
+        if ((!before && !after) || (before && after && *before == *after)) {
+            continue;
+        }
+        std::cout << "[CONFIG] " << key << (isReloadableKey(key) ? " applied\n" : " changed - restart to apply\n");
+    }
+    AsyncLogger::instance().setLevel(config.logLevel);
 }
 
-int main(int argc, char* argv[]) {
-    (void)argc;  // REASON: Unused parameters
-    (void)argv;
-    // REASON: Suppress unused parameter warnings for future CLI argument support
-    (void)argc;
-    (void)argv;
+// Prometheus samples of one scrape (runs on the metrics thread, reads atomics / size_approx only)
+template <typename Queue>
+void collectMetrics(PrometheusWriter& out, BasicShardRouter<Queue>& router,
+                    const std::vector<std::unique_ptr<BasicRedisWorker<Queue>>>& workers,
+                    const std::vector<std::unique_ptr<RedisPublisher>>& publishers,
+                    const std::vector<std::unique_ptr<ShardedTwsClient<Queue>>>& clients, const CommandListener& commands,
+                    const std::vector<std::unique_ptr<TickJournal>>& journals, const SubscriberTracker* watch,
+                    const StageWatchdog& watchdog, const TraceExport* trace, const InstrumentRegistry& registry,
+                    const ShardRebalancer* rebalancer) {
+    auto shardLabel = [](std::size_t shard, const char* extra = nullptr) {
+        std::string labels = "shard=\"" + std::to_string(shard) + "\"";
+        if (extra) {
+            labels.append(",").append(extra);
+        }
+        return labels;
+    };
+    auto relaxed = [](const std::atomic<std::uint64_t>& counter) { return counter.load(std::memory_order_relaxed); };
     
-    std::cout << "=== TWS-Redis Bridge v0.1.0 ===\n";
+    out.family("tws_bridge_ticks_in_total", "counter", "Updates from TWS callbacks handed to the shard router");
+    for (std::size_t type = 0; type < kTickUpdateTypeCount; ++type) {
+        const std::string labels = std::string("type=\"") + tickUpdateTypeName(static_cast<TickUpdateType>(type)) + "\"";
+        std::uint64_t ticksIn = 0;
+        for (const auto& client : clients) {
+            ticksIn += client->counters().ticksIn[type].value();
+        }
+        out.sample("tws_bridge_ticks_in_total", labels, ticksIn);
+    }
     
-    // Signal handlers for graceful shutdown
-    std::signal(SIGINT, signalHandler);
-    std::signal(SIGTERM, signalHandler);
+    out.family("tws_bridge_ingest_overflow_total", "counter", "Updates that did not fit a shard queue, by policy action");
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        const OverflowCounters& overflow = router.shard(i).overflow;
+        out.sample("tws_bridge_ingest_overflow_total", shardLabel(i, "action=\"dropped\""), relaxed(overflow.dropped));
+        out.sample("tws_bridge_ingest_overflow_total", shardLabel(i, "action=\"conflated\""), relaxed(overflow.conflated));
+        out.sample("tws_bridge_ingest_overflow_total", shardLabel(i, "action=\"spilled\""), relaxed(overflow.spilled));
+    }
+    
+    out.family("tws_bridge_trades_dropped_total", "counter", "Trades lost to a full trade lane (prioritize_trades, also in dropped)");
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        out.sample("tws_bridge_trades_dropped_total", shardLabel(i), relaxed(router.shard(i).overflow.tradesDropped));
+    }
+    
+    out.family("tws_bridge_queue_depth", "gauge", "Approximate updates waiting in the shard ingest queue");
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        out.sample("tws_bridge_queue_depth", shardLabel(i), static_cast<std::uint64_t>(router.shard(i).queue.size_approx()));
+    }
+    
+    // NOTE: 0 unless ingest.sizing.enabled
+    out.family("tws_bridge_queue_high_water", "gauge", "Largest shard queue backlog seen by the worker (ingest.sizing)");
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        out.sample("tws_bridge_queue_high_water", shardLabel(i), static_cast<std::uint64_t>(router.shard(i).occupancy.highWater()));
+    }
+    out.family("tws_bridge_queue_peak_rate", "gauge", "Busiest one-second arrival rate into the shard queue, updates/s (ingest.sizing)");
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        out.sample("tws_bridge_queue_peak_rate", shardLabel(i), router.shard(i).occupancy.peakRate());
+    }
+    
+    out.family("tws_bridge_queue_age_seconds", "gauge", "Age of the oldest update in the last drained batch (0 = idle, needs stamps)");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_queue_age_seconds", shardLabel(i), std::chrono::duration<double>(workers[i]->queueAge()).count());
+    }
+    
+    out.family("tws_bridge_queue_lag_level", "gauge", "worker.lag level: 0 ok, 1 warn, 2 critical");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_queue_lag_level", shardLabel(i), static_cast<std::uint64_t>(workers[i]->lagLevel()));
+    }
+    
+    out.family("tws_bridge_queue_lag_alerts_total", "counter", "worker.lag rises to warn or critical");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_queue_lag_alerts_total", shardLabel(i), relaxed(workers[i]->counters().lagAlerts));
+    }
+    
+    out.family("tws_bridge_flight_dumps_total", "counter", "Flight recorder files written after a latency spike");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        const FlightRecorder* flight = workers[i]->flightRecorder();
+        out.sample("tws_bridge_flight_dumps_total", shardLabel(i), static_cast<std::uint64_t>(flight ? flight->dumps() : 0));
+    }
+    
+    out.family("tws_bridge_snapshots_published_total", "counter", "Snapshots handed to the Redis publisher");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_snapshots_published_total", shardLabel(i), relaxed(workers[i]->counters().published));
+    }
+    out.family("tws_bridge_snapshots_suppressed_total", "counter", "Snapshots not published, by reason");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        const WorkerCounters& counters = workers[i]->counters();
+        out.sample("tws_bridge_snapshots_suppressed_total", shardLabel(i, "reason=\"conflated\""), relaxed(counters.conflated));
+        out.sample("tws_bridge_snapshots_suppressed_total", shardLabel(i, "reason=\"unchanged\""), relaxed(counters.unchanged));
+        out.sample("tws_bridge_snapshots_suppressed_total", shardLabel(i, "reason=\"duplicate\""), relaxed(counters.duplicates));
+        out.sample("tws_bridge_snapshots_suppressed_total", shardLabel(i, "reason=\"deadband\""), relaxed(counters.deadbanded));
+        out.sample("tws_bridge_snapshots_suppressed_total", shardLabel(i, "reason=\"unwatched\""), relaxed(counters.unwatched));
+    }
+    out.family("tws_bridge_bad_ticks_total", "counter", "Quotes / trades failing worker.tick_filter, by reason");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        const WorkerCounters& counters = workers[i]->counters();
+        for (std::size_t reason = 1; reason < kBadTickReasons; ++reason) {
+            const std::string label = std::string("reason=\"") + badTickName(static_cast<BadTick>(reason)) + "\"";
+            out.sample("tws_bridge_bad_ticks_total", shardLabel(i, label.c_str()), relaxed(counters.badTicks[reason]));
+        }
+    }
+    out.family("tws_bridge_profile_deltas_total", "counter", "volume_profile: TWS:PROFILE:* deltas published");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_profile_deltas_total", shardLabel(i), relaxed(workers[i]->counters().profiles));
+    }
+    out.family("tws_bridge_session_updates_total", "counter", "session_stats: TWS:SESSION:* updates published");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_session_updates_total", shardLabel(i), relaxed(workers[i]->counters().sessions));
+    }
+    out.family("tws_bridge_series_samples_total", "counter", "time_series: samples sent with TS.MADD");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_series_samples_total", shardLabel(i), relaxed(workers[i]->counters().seriesSamples));
+    }
+    out.family("tws_bridge_tape_prints_total", "counter", "worker.tape_length: prints pushed to TWS:TAS:*");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        out.sample("tws_bridge_tape_prints_total", shardLabel(i), relaxed(workers[i]->counters().tapePrints));
+    }
+    if (watch) {
+        out.family("tws_bridge_watched_symbols", "gauge", "Symbols with a TWS:TICKS subscriber at the last PUBSUB NUMSUB pass");
+        out.sample("tws_bridge_watched_symbols", "", relaxed(watch->counters().watched));
+    }
+    if (!watchdog.watched().empty()) {
+        out.family("tws_bridge_stage_stalls_total", "counter", "Stages without a heartbeat for watchdog.stall_after");
+        for (const auto& watched : watchdog.watched()) {
+            const std::string labels = std::string("stage=\"") + stageName(watched->stage) + "\",index=\""
+                                     + std::to_string(watched->index) + "\"";
+            out.sample("tws_bridge_stage_stalls_total", labels, relaxed(watched->stalls));
+        }
+    }
+    if (rebalancer) {
+        out.family("tws_bridge_shard_load_ticks_per_second", "gauge", "Tick-rate EWMA of the slots a shard owns (ingest.rebalance)");
+        out.family("tws_bridge_shard_slots", "gauge", "Registered symbols a shard owns");
+        std::vector<std::uint64_t> owned(router.shardCount(), 0);
+        for (std::size_t slot = 0; slot < registry.size(); ++slot) {
+            ++owned[router.shardFor(static_cast<SlotId>(slot))];
+        }
+        for (std::size_t i = 0; i < router.shardCount(); ++i) {
+            out.sample("tws_bridge_shard_load_ticks_per_second", shardLabel(i), rebalancer->load(i));
+            out.sample("tws_bridge_shard_slots", shardLabel(i), owned[i]);
+        }
+        const SlotMigration& migration = router.migration();
+        out.family("tws_bridge_slot_migrations_total", "counter", "Symbols moved between shards, by outcome (abandoned: handoff timed out)");
+        out.sample("tws_bridge_slot_migrations_total", "result=\"completed\"", relaxed(migration.completed));
+        out.sample("tws_bridge_slot_migrations_total", "result=\"abandoned\"", relaxed(migration.abandoned));
+        // NOTE: Only moved symbols - the rest are on slot % shards
+        out.family("tws_bridge_slot_shard", "gauge", "Shard of a symbol moved off its default shard");
+        for (std::size_t slot = 0; slot < registry.size(); ++slot) {
+            const std::size_t shard = router.shardFor(static_cast<SlotId>(slot));
+            if (shard != slot % router.shardCount()) {
+                out.sample("tws_bridge_slot_shard", "symbol=\"" + registry.symbol(static_cast<SlotId>(slot)) + "\"",
+                           static_cast<std::uint64_t>(shard));
+            }
+        }
+    }
+    if (trace) {
+        out.family("tws_bridge_trace_spans_total", "counter", "Sampled tick spans, by outcome (dropped: writer buffer full)");
+        out.sample("tws_bridge_trace_spans_total", "result=\"written\"", trace->written());
+        out.sample("tws_bridge_trace_spans_total", "result=\"dropped\"", trace->dropped());
+    }
+    if (allocationHookInstalled()) {
+        // NOTE: Merged by name - racing threads of the same name may hold two counter slots
+        struct Totals { std::uint64_t allocations = 0, bytes = 0, hot = 0; };
+        std::map<std::string, Totals> threads;
+        forEachAllocationCounters([&](const char* name, const AllocationCounters& counters) {
+            Totals& totals = threads[name];
+            totals.allocations += relaxed(counters.allocations);
+            totals.bytes += relaxed(counters.bytes);
+            totals.hot += relaxed(counters.hotAllocations);
+        });
+        out.family("tws_bridge_allocations_total", "counter", "Heap allocations (operator new), by thread");
+        for (const auto& entry : threads) {
+            out.sample("tws_bridge_allocations_total", "thread=\"" + entry.first + "\"", entry.second.allocations);
+        }
+        out.family("tws_bridge_allocated_bytes_total", "counter", "Bytes requested from operator new, by thread");
+        for (const auto& entry : threads) {
+            out.sample("tws_bridge_allocated_bytes_total", "thread=\"" + entry.first + "\"", entry.second.bytes);
+        }
+        out.family("tws_bridge_hot_allocations_total", "counter",
+                   "Allocations inside no-alloc sections after warm-up (Debug builds only), by thread");
+        for (const auto& entry : threads) {
+            out.sample("tws_bridge_hot_allocations_total", "thread=\"" + entry.first + "\"", entry.second.hot);
+        }
+    }
+    out.family("tws_bridge_sink_batches_total", "counter", "Snapshot batches per extra sink, by outcome");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        const SinkFanout* sinks = workers[i]->sinks();
+        for (std::size_t j = 0; sinks && j < sinks->sinkCount(); ++j) {
+            const std::string delivered = std::string("sink=\"") + sinks->sinkName(j) + "\",result=\"delivered\"";
+            const std::string dropped = std::string("sink=\"") + sinks->sinkName(j) + "\",result=\"dropped\"";
+            out.sample("tws_bridge_sink_batches_total", shardLabel(i, delivered.c_str()), relaxed(sinks->counters(j).batches));
+            out.sample("tws_bridge_sink_batches_total", shardLabel(i, dropped.c_str()), relaxed(sinks->counters(j).dropped));
+        }
+    }
+    out.family("tws_bridge_shm_records_total", "counter", "Snapshots offered to the shared-memory ring, by outcome");
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        if (const ShmRingWriter* ring = workers[i]->shmRing()) {
+            out.sample("tws_bridge_shm_records_total", shardLabel(i, "result=\"written\""), ring->published());
+            out.sample("tws_bridge_shm_records_total", shardLabel(i, "result=\"oversized\""), ring->oversized());
+        }
+    }
+    
+    out.family("tws_bridge_redis_messages_total", "counter", "Pipelined Redis commands, by outcome");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        const PublisherCounters& counters = publishers[i]->counters();
+        out.sample("tws_bridge_redis_messages_total", shardLabel(i, "result=\"sent\""), relaxed(counters.sent));
+        out.sample("tws_bridge_redis_messages_total", shardLabel(i, "result=\"failed\""), relaxed(counters.failed));
+        out.sample("tws_bridge_redis_messages_total", shardLabel(i, "result=\"dropped\""), relaxed(counters.dropped));
+    }
+    out.family("tws_bridge_redis_errors_total", "counter", "Redis pipelines that raised an error");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_errors_total", shardLabel(i), relaxed(publishers[i]->counters().errors));
+    }
+    out.family("tws_bridge_redis_reconnects_total", "counter", "Redis reconnections, by connection");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_reconnects_total", shardLabel(i, "connection=\"publisher\""),
+                   relaxed(publishers[i]->counters().reconnects));
+    }
+    out.sample("tws_bridge_redis_reconnects_total", "connection=\"commands\"", relaxed(commands.counters().reconnects));
+    out.family("tws_bridge_commands_total", "counter", "TWS:COMMANDS messages, by outcome");
+    out.sample("tws_bridge_commands_total", "result=\"received\"", relaxed(commands.counters().received));
+    out.sample("tws_bridge_commands_total", "result=\"rejected\"", relaxed(commands.counters().rejected));
+    out.sample("tws_bridge_commands_total", "result=\"coalesced\"", relaxed(commands.counters().coalesced));
+    out.family("tws_bridge_command_batches_total", "counter", "TWS:COMMANDS batches routed (commands.batch_window)");
+    out.sample("tws_bridge_command_batches_total", "", relaxed(commands.counters().batches));
+    out.family("tws_bridge_redis_slot_refreshes_total", "counter", "Redis Cluster slot map reloads");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_slot_refreshes_total", shardLabel(i), relaxed(publishers[i]->counters().slotRefreshes));
+    }
+    out.family("tws_bridge_redis_function_calls_total", "counter", "FCALL tws_publish sent (redis.function_batches)");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_function_calls_total", shardLabel(i), relaxed(publishers[i]->counters().functionCalls));
+    }
+    out.family("tws_bridge_redis_function_loads_total", "counter", "FUNCTION LOAD of the tws_bridge library");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_function_loads_total", shardLabel(i), relaxed(publishers[i]->counters().functionLoads));
+    }
+    out.family("tws_bridge_redis_circuit_open", "gauge", "1 while the Redis circuit breaker is failing fast");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_circuit_open", shardLabel(i),
+                   static_cast<std::uint64_t>(publishers[i]->circuitState() == CircuitState::Open ? 1 : 0));
+    }
+    out.family("tws_bridge_redis_spill_total", "counter", "Messages parked during a Redis outage, by outcome");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        const PublisherCounters& counters = publishers[i]->counters();
+        out.sample("tws_bridge_redis_spill_total", shardLabel(i, "result=\"spilled\""), relaxed(counters.spilled));
+        out.sample("tws_bridge_redis_spill_total", shardLabel(i, "result=\"evicted\""), relaxed(counters.evicted));
+        out.sample("tws_bridge_redis_spill_total", shardLabel(i, "result=\"replayed\""), relaxed(counters.replayed));
+    }
+    out.family("tws_bridge_redis_inflight_batches", "gauge", "Batches queued to or being sent by the Redis I/O thread");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_redis_inflight_batches", shardLabel(i),
+                   static_cast<std::uint64_t>(publishers[i]->inFlightBatches()));
+    }
+    out.family("tws_bridge_payload_blocks", "gauge", "Pooled snapshot payload blocks (grows only while every block is held)");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_payload_blocks", shardLabel(i), static_cast<std::uint64_t>(publishers[i]->payloads().blocks()));
+    }
+    out.family("tws_bridge_payload_stored_total", "counter", "Snapshots stored once and shared by Redis commands and sinks");
+    for (std::size_t i = 0; i < publishers.size(); ++i) {
+        out.sample("tws_bridge_payload_stored_total", shardLabel(i), publishers[i]->payloads().stored());
+    }
+    
+    out.family("tws_bridge_subscribed_symbols", "gauge", "Symbols with an active tick-by-tick or L1 subscription");
+    std::size_t subscribed = 0;
+    for (const auto& client : clients) {
+        subscribed += client->subscriptionCount();
+    }
+    out.sample("tws_bridge_subscribed_symbols", "", static_cast<std::uint64_t>(subscribed));
+    std::uint64_t reconnects = 0;
+    for (const auto& client : clients) {
+        reconnects += relaxed(client->counters().reconnects);
+    }
+    out.family("tws_bridge_tws_reconnects_total", "counter", "TWS sessions re-established in process (subscriptions replayed)");
+    out.sample("tws_bridge_tws_reconnects_total", "", reconnects);
+    std::uint64_t contractHits = 0, contractLookups = 0, contractFailures = 0;
+    for (const auto& client : clients) {
+        contractHits += relaxed(client->counters().contractHits);
+        contractLookups += relaxed(client->counters().contractLookups);
+        contractFailures += relaxed(client->counters().contractFailures);
+    }
+    out.family("tws_bridge_contracts_total", "counter", "Contract resolution: subscribes by cached conId, lookups sent, failed lookups");
+    out.sample("tws_bridge_contracts_total", "result=\"cached\"", contractHits);
+    out.sample("tws_bridge_contracts_total", "result=\"lookup\"", contractLookups);
+    out.sample("tws_bridge_contracts_total", "result=\"failed\"", contractFailures);
     
-    // Configuration (TODO: Move to config file)
-    const std::string TWS_HOST = "127.0.0.1";
-    const unsigned int TWS_PORT = 7497;  // Paper trading port
-    const int CLIENT_ID = 1;
-    const std::string REDIS_URI = "tcp://127.0.0.1:6379";
+    // NOTE: One journal per TWS connection - summed, as they capture disjoint symbol sets
+    std::uint64_t records = 0, dropped = 0, bytes = 0, segments = 0;
+    for (const auto& journal : journals) {
+        const JournalCounters& journaled = journal->counters();
+        records += relaxed(journaled.records);
+        dropped += relaxed(journaled.dropped);
+        bytes += relaxed(journaled.bytes);
+        segments += relaxed(journaled.segments);
+    }
+    out.family("tws_bridge_journal_records_total", "counter", "Updates captured to the tick journal, by outcome");
+    out.sample("tws_bridge_journal_records_total", "result=\"written\"", records);
+    out.sample("tws_bridge_journal_records_total", "result=\"dropped\"", dropped);
+    out.family("tws_bridge_journal_bytes_total", "counter", "Bytes written to tick journal segments");
+    out.sample("tws_bridge_journal_bytes_total", "", bytes);
+    out.family("tws_bridge_journal_segments_total", "counter", "Tick journal segment files opened");
+    out.sample("tws_bridge_journal_segments_total", "", segments);
     
+    // NOTE: Empty unless latency stamping is on (WorkerConfig::latency)
+    out.family("tws_bridge_stage_latency_seconds", "histogram", "Pipeline stage latency (LatencyHistogram.h stages)");
+    LatencySnapshot snapshot;
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        const WorkerLatency& worker = workers[i]->latency();
+        const PublisherLatency& publisher = publishers[i]->latency();
+        const LatencyHistogram* histograms[kLatencyStageCount] = {&worker.ingest, &worker.queue, &worker.serialize,
+                                                                  &publisher.publish, &publisher.endToEnd};
+        for (std::size_t stage = 0; stage < kLatencyStageCount; ++stage) {
+            histograms[stage]->snapshot(snapshot);
+            const std::string stageLabel = std::string("stage=\"") + latencyStageName(static_cast<LatencyStage>(stage)) + "\"";
+            out.histogram("tws_bridge_stage_latency_seconds", shardLabel(i, stageLabel.c_str()), snapshot);
+        }
+    }
+}
+
+// ingest.sizing at shutdown: per-shard evidence, then the largest shard's recommendation (saved for sizing.adopt)
+// REASON: One queue_capacity serves every shard - the busiest one sizes them all
+template <typename Queue>
+static void reportQueueSizing(const QueueSizingConfig& sizing, std::size_t configured, BasicShardRouter<Queue>& router,
+                              const std::vector<std::unique_ptr<RedisPublisher>>& publishers) {
+    std::vector<QueueSizingReport> reports;
+    std::size_t recommended = sizing.minCapacity;
+    LatencySnapshot roundTrips;
+    for (std::size_t i = 0; i < router.shardCount() && i < publishers.size(); ++i) {
+        publishers[i]->latency().roundTrip.snapshot(roundTrips);
+        reports.push_back(summarizeQueueSizing(i, configured, router.shard(i).occupancy, roundTrips, sizing));
+        const QueueSizingReport& report = reports.back();
+        std::cout << "[SIZING] Shard " << i << ": high water " << report.highWater << " / " << configured
+                  << ", backlog p99 " << report.depthP99 << ", burst p99 " << report.burstP99Ns / 1000
+                  << " us (max " << report.burstMaxNs / 1000 << " us), peak " << static_cast<std::uint64_t>(report.peakRate)
+                  << "/s, Redis p" << sizing.stallPercentile << " " << report.stallNs / 1000 << " us\n";
+        recommended = std::max(recommended, report.recommended);
+    }
+    std::cout << "[SIZING] Recommended ingest.queue_capacity: " << recommended << " (running with " << configured << ")\n";
+    std::string error;
+    if (!sizing.path.empty() && !saveQueueCapacity(sizing.path, recommended, reports.data(), reports.size(), error)) {
+        std::cerr << "[SIZING] Recommendation not saved: " << error << "\n";
+    }
+}
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--config config.yaml] [--set section.key=value]...\n"
+              << "       " << program << " [--host <tws host>] [--port <tws port>] [--client-id <id>] [--subscribe AAPL,SPY]\n"
+              << "       " << program << " [--replay <segment.tjl | journal dir>] [--speed 1x|10x|max]\n"
+              << "       " << program << " --export <segment.tjl | journal dir> [--out <dir>]\n"
+              << "       (--replay / --export) [--symbols AAPL,SPY] [--from <time>] [--to <time>]\n"
+              << "       " << program << " [--config config.yaml] --serve-journal <journal dir>\n"
+              << "  --config  Tunables file (see config.yaml), validated at startup; SIGHUP re-reads it (log.level)\n"
+              << "  --set     Override one key after the file, e.g. --set ingest.shards=4 (repeatable)\n"
+              << "  --replay  Feed a TickJournal capture to the workers instead of connecting to TWS\n"
+              << "  --speed   Recorded pacing divided by N (default 1x), max = as fast as possible\n"
+              << "  --export  Convert a capture to Parquet: <out>/<session>/<kind>/<SYMBOL>.parquet, then exit\n"
+              << "  --out     Export directory (default export)\n"
+              << "  --symbols Replay / export these symbols only\n"
+              << "  --from    Receive-time window start, 2026-10-15T13:30:00Z (UTC) or epoch seconds\n"
+              << "  --to      Receive-time window end (inclusive) - with --symbols, seeks via the segment index\n"
+              << "  --serve-journal  Serve recorded ranges on journal_server.port until Ctrl+C (no TWS, no workers)\n";
+}
+
+// End-of-day job: no TWS, no Redis, no workers - journal segments in, Parquet files out
+static int runExport(const std::string& journalPath, const std::string& exportDir, const JournalFilter& filter) {
+    ExportConfig config;
+    config.directory = exportDir;
+    config.filter = filter;
+    JournalExporter exporter(config);
+    std::cout << "[EXPORT] " << journalPath << " → " << exportDir << "\n";
+    const auto start = std::chrono::steady_clock::now();
+    const bool exported = exporter.run(journalPath);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const ExportCounters& counters = exporter.counters();
+    std::cout << "[EXPORT] " << counters.rows << " rows from " << counters.segments << " segments into "
+              << counters.files << " files (" << counters.rowGroups << " row groups) in " << seconds << " s, "
+              << counters.unmapped << " unmapped, " << counters.errors << " failed files, "
+              << counters.skippedBytes / (1 << 20) << " MiB skipped by the index\n";
+    return exported ? 0 : 1;
+}
+
+// Research side-process: journal ranges on request over TCP (or into TWS:REPLAY:* streams) - no TWS, no workers
+static int runJournalServer(const BridgeConfig& config, const std::string& journalDir) {
+    JournalServerConfig serverConfig = config.journalServer;
+    serverConfig.directory = journalDir;
+    serverConfig.redis = parseRedisUri(config.redisUri);  // REASON: Validated by applyConfig
+    serverConfig.connection = config.connection;
+    JournalServer server(serverConfig);
+    if (!server.start()) {
+        return 1;
+    }
+    while (g_running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    server.stop();
+    const JournalServerCounters& counters = server.counters();
+    std::cout << "[JOURNAL-SERVER] " << counters.requests.load() << " requests (" << counters.rejected.load()
+              << " rejected, " << counters.failed.load() << " failed), " << counters.ticks.load() << " ticks, "
+              << counters.bytes.load() / (1 << 20) << " MiB sent (" << counters.zeroCopyBytes.load() / (1 << 20)
+              << " MiB zero-copy), " << counters.streamEntries.load() << " stream entries\n";
+    return 0;
+}
+
+// Everything after configuration: IngestQueue follows the connection count (see main)
+template <typename IngestQueue>
+static int runBridge(const BridgeConfig& config, const ConfigSource& source, const ConfigFile& loaded,
+                     const std::string& replayPath, const ReplayConfig& replayOptions) {
+    const std::size_t connections = config.clientIds.size();
+    const auto startedAt = std::chrono::steady_clock::now();
     try {
-        // REASON: Lock-free queue for producer (TWS callbacks) → consumer (Redis worker)
-        moodycamel::ConcurrentQueue<TickUpdate> queue(10000);  // Pre-allocate 10K slots
+        // REASON: Calibrated here (~10 ms) - the first socket read must not pay for it
+        if (!receiveClock().invariant()) {
+            std::cout << "[MAIN] No invariant TSC - receive stamps read system_clock\n";
+        }
+        // REASON: Dense slot table shared by every TwsClient (writers) and workers (readers)
+        InstrumentRegistry registry(config.symbolCapacity);
         
-        // Initialize Redis publisher
-        std::cout << "[MAIN] Connecting to Redis at " << REDIS_URI << "\n";
-        RedisPublisher redis(REDIS_URI);
+        // ========== Trace export (trace.enabled): stage spans of sampled ticks, written by "tws-trace" ==========
+        // REASON: Declared before clients and workers - they record into it until they are destroyed
+        TraceExport traceExport(config.trace, &registry);
+        const bool tracing = config.trace.enabled && traceExport.start();
         
-        if (!redis.isConnected()) {
-            std::cerr << "[MAIN] Failed to connect to Redis\n";
-            return 1;
+        // REASON: One lock-free queue per worker shard, routed by instrument slot
+        // memory.*: each buffer-holding instance gets an even share of its subsystem's budget
+        IngestConfig ingest = config.ingest;
+        ingest.spillBudget = budgetShare(config.memory.bytes(MemorySubsystem::IngestSpill), config.shards);
+        OutagePolicy outage = config.outage;
+        outage.spillBudget = budgetShare(config.memory.bytes(MemorySubsystem::PublishSpill), config.shards);
+        // ingest.sizing.adopt: the capacity the last run measured, preallocated up front like queue_capacity
+        std::size_t queueCapacity = config.queueCapacity;
+        if (config.sizing.adopt) {
+            std::string error;
+            if (!loadQueueCapacity(config.sizing.path, queueCapacity, error)) {
+                std::cerr << "[MAIN] " << error << " - using ingest.queue_capacity\n";
+                queueCapacity = config.queueCapacity;
+            } else if (queueCapacity != config.queueCapacity) {
+                std::cout << "[MAIN] Queue capacity " << queueCapacity << " per shard (ingest.sizing.adopt, "
+                          << config.sizing.path << ")\n";
+            }
+        }
+        BasicShardRouter<IngestQueue> router(config.shards, queueCapacity, config.wait, ingest);
+        // Hot-symbol rebalancing (ingest.rebalance): main thread decides, producer + workers move the slot
+        std::unique_ptr<ShardRebalancer> rebalancer;
+        if (config.rebalance.enabled) {
+            rebalancer = std::make_unique<ShardRebalancer>(config.rebalance, registry.capacity(), router.shardCount());
+        }
+        
+        // Initialize Redis publishers (one per shard: own pipeline, own I/O thread)
+        // PERFORMANCE: Redis handshakes run in the background while TWS connects below - a restart
+        // costs the slower of the two instead of their sum
+        std::cout << "[MAIN] Connecting to Redis at " << config.redisUri << "\n";
+        std::vector<std::future<std::unique_ptr<RedisPublisher>>> pendingPublishers;
+        for (std::size_t i = 0; i < router.shardCount(); ++i) {
+            IoThreadPolicy ioPolicy = config.io;
+            ioPolicy.thread = i < config.redisIoThreads.size() ? config.redisIoThreads[i] : ThreadConfig{};
+            pendingPublishers.push_back(std::async(std::launch::async, [&config, &outage, ioPolicy]() {
+                return std::make_unique<RedisPublisher>(config.redisUri, config.batch, config.stream, ioPolicy,
+                                                        outage, config.connection);
+            }));
+        }
+        
+        // ========== THREAD 3: Connect to TWS (starts socket reader thread per connection) ==========
+        // ========== THREAD 6: Tick journal sync (mmap'd segments, msync + rotation off the hot path) ==========
+        // REASON: TickJournal has a single writer - one journal per connection (journal/client-{id} when
+        // several), each a standalone capture of that connection's symbols
+        // NOTE: Replay mode has no TWS connection (clients stays empty)
+        // REASON: Declared first - the account feed and news lane outlive the client filling them and the worker
+        // draining them
+        AccountQueue accountFeed;
+        NewsLane newsLane(config.news);
+        std::vector<std::unique_ptr<ShardedTwsClient<IngestQueue>>> clients;
+        std::vector<std::unique_ptr<TickJournal>> journals;
+        // REASON: One cache for every connection - a symbol resolved by one is known to all on restart
+        ContractCache contractCache;
+        // REASON: Periodic saves run on the background pool - the mutex keeps a late one and the final save apart
+        std::mutex contractSaveMutex;
+        std::atomic<bool> contractSaveQueued{false};
+        auto saveContracts = [&config, &contractCache, &contractSaveMutex]() {
+            std::lock_guard<std::mutex> lock(contractSaveMutex);
+            std::string error;
+            if (!config.contracts.path.empty() && contractCache.dirty() && !contractCache.save(config.contracts.path, error)) {
+                std::cerr << "[MAIN] Contract cache not saved: " << error << "\n";
+            }
+        };
+        
+        // ========== Background pool (threads.background): jobs nothing on the tick path waits for ==========
+        // REASON: Declared after everything its jobs touch - destroyed (queued jobs run, threads joined) first
+        std::vector<int> pinnedCpus;
+        for (const auto* threads : {&config.msgThreads, &config.readerThreads, &config.workerThreads, &config.redisIoThreads}) {
+            for (const ThreadConfig& thread : *threads) {
+                pinnedCpus.push_back(thread.cpu);
+            }
+        }
+        std::unique_ptr<TaskPool> background = makeBackgroundPool(config.background, pinnedCpus);
+        std::cout << "[MAIN] Background pool: " << background->threads() << " threads on "
+                  << (background->cpus().empty() ? std::string("any core") : std::to_string(background->cpus().size()) + " cores")
+                  << "\n";
+        
+        // ========== Warm start load: last published snapshots read while TWS connects ==========
+        // REASON: Startup symbols publish complete snapshots from their first tick after a restart
+        // (symbols added later through TWS:COMMANDS start cold)
+        // PERFORMANCE: The MGETs overlap the TWS handshake on the pool - seeded below, before the workers run
+        const bool warmStart = replayPath.empty() && config.worker.writeLastValue && config.warmStart.enabled;
+        std::future<std::vector<WarmStartEntry>> pendingWarmStart;
+        std::size_t warmSlots = 0;
+        std::vector<SlotId> warmSlotIds;
+        if (warmStart && !config.connection.cluster) {
+            for (const std::string& symbol : config.symbols) {
+                // NOTE: Registered ahead of the subscribe, which then finds the same slot
+                const SlotId slot = registry.registerInstrument(symbol);
+                if (slot != kInvalidSlot) {
+                    warmSlotIds.push_back(slot);
+                }
+            }
+            warmSlots = warmSlotIds.size();
+        }
+        auto loadWarmStart = [&]() {
+            if (warmStart && !config.connection.cluster) {
+                pendingWarmStart = background->submit([&config, &registry, slots = warmSlotIds]() {
+                    return loadLastValues(config.redisUri, registry, slots, config.warmStart);
+                });
+            }
+        };
+        // NOTE: A standby loads once promoted (below) - the leader kept TWS:LVC:* current until then
+        if (!config.leader.enabled) {
+            loadWarmStart();
+        }
+        
+        auto stopJournals = [&journals]() {
+            for (auto& journal : journals) {
+                journal->stop();
+            }
+        };
+        auto disconnectClients = [&clients]() {
+            for (auto& client : clients) {
+                client->disconnect();
+            }
+        };
+        if (replayPath.empty()) {
+            if (!config.contracts.path.empty()) {
+                std::string error;
+                if (!contractCache.load(config.contracts.path, error)) {
+                    // REASON: Not fatal - the symbols after the bad line are resolved again
+                    std::cerr << "[MAIN] " << error << " (rest of the contract cache ignored)\n";
+                }
+                std::cout << "[MAIN] Contract cache: " << contractCache.size() << " symbols from " << config.contracts.path << "\n";
+            }
+            std::cout << "[MAIN] Connecting to TWS Gateway at " << config.twsHost << ":" << config.twsPort << " (x"
+                      << connections << " connections)\n";
+            for (std::size_t i = 0; i < connections; ++i) {
+                clients.push_back(std::make_unique<ShardedTwsClient<IngestQueue>>(router, registry, config.pacing));
+                ShardedTwsClient<IngestQueue>& client = *clients.back();
+                // REASON: Worker histograms, lag levels, flight records, traces and the load shedder's queue age need stamped ticks
+                client.setLatencyStamps(config.worker.latency.enabled || config.worker.lag.enabled
+                                        || config.worker.flight.enabled || config.loadShed.enabled || tracing);
+                if (tracing) {
+                    client.setTraceExport(&traceExport);
+                }
+                client.setReaderThread(i < config.readerThreads.size() ? config.readerThreads[i] : ThreadConfig{});
+                client.setMessageFilter(MessageFilter::forBridge(config.messages));
+                client.setSocketTuning(config.socket, config.readerPoll);
+                client.setReconnectPolicy(config.reconnect);
+                client.setBackfillPolicy(config.backfill);
+                client.setSessionSeeding(config.worker.sessionStats.enabled);
+                client.setContractCache(config.contracts.path.empty() ? nullptr : &contractCache, config.contracts.maxAge);
+                
+                JournalConfig journalConfig;
+                journalConfig.directory = connections == 1 ? config.journalDir
+                                                               : config.journalDir + "/client-" + std::to_string(config.clientIds[i]);
+                journalConfig.format = config.journalFormat;
+                journalConfig.blockBytes = config.journalBlockBytes;
+                journalConfig.index = config.journalIndex;
+                journals.push_back(std::make_unique<TickJournal>(registry, journalConfig));
+                if (config.journalEnabled) {
+                    if (journals.back()->start()) {
+                        client.setJournal(journals.back().get());
+                    } else {
+                        std::cerr << "[MAIN] Tick journal disabled\n";  // REASON: Not fatal - the bridge still streams
+                    }
+                }
+            }
+            
+            // NOTE: createConnection() starts the reader (BridgeReader, or EReader as fallback) - Thread 3
+            // (ReaderMode::Inline: no Thread 3, msgThread reads the socket itself)
+            // PERFORMANCE: Bridge reader - pooled buffers + SPSC ring + eventfd instead of EReader's locked deque
+            // PERFORMANCE: Connections handshake in parallel (each eConnect is a blocking round trip)
+            std::vector<std::future<bool>> pendingClients;
+            for (std::size_t i = 0; i < connections; ++i) {
+                ShardedTwsClient<IngestQueue>* client = clients[i].get();
+                const int clientId = config.clientIds[i];
+                pendingClients.push_back(std::async(std::launch::async, [&config, client, clientId]() {
+                    return client->createConnection(config.twsHost, config.twsPort, clientId, config.readerMode);
+                }));
+            }
+            bool twsConnected = true;
+            for (std::size_t i = 0; i < connections; ++i) {
+                if (!pendingClients[i].get()) {
+                    std::cerr << "[MAIN] Failed to connect to TWS Gateway (client ID " << config.clientIds[i] << ")\n";
+                    twsConnected = false;
+                }
+            }
+            if (!twsConnected) {
+                disconnectClients();
+                stopJournals();
+                return 1;  // NOTE: pendingPublishers' destructors wait for the Redis handshakes
+            }
+            std::cout << "[MAIN] TWS connected (reader thread now running)\n";
+        }
+        
+        std::vector<std::unique_ptr<RedisPublisher>> publishers;
+        for (auto& pending : pendingPublishers) {
+            publishers.push_back(pending.get());  // PITFALL: Rethrows a failed handshake (caught below)
+            if (!publishers.back()->isConnected()) {
+                std::cerr << "[MAIN] Failed to connect to Redis\n";
+                disconnectClients();
+                stopJournals();
+                return 1;
+            }
         }
         std::cout << "[MAIN] Redis connected\n";
         
-        // ========== THREAD 2: Start Redis Worker Thread ==========
-        // Consumes from lock-free queue, publishes to Redis
-        std::thread workerThread(redisWorkerLoop, std::ref(queue), std::ref(redis), std::ref(g_running));
+        // ========== Standby (leader.enabled): TWS sessions up, nothing subscribed until the lease is held ==========
+        // PERFORMANCE: Failover costs an acquire attempt plus the warm start MGET - the TWS handshakes and
+        // Redis connections are already done
+        std::unique_ptr<LeaderLease> lease;
+        if (config.leader.enabled && replayPath.empty()) {
+            lease = std::make_unique<LeaderLease>(config.redisUri, config.leader);
+            lease->start();
+            std::cout << "[MAIN] Standby as " << lease->id() << ", waiting for " << config.leader.key << "\n";
+            const auto standbyAt = std::chrono::steady_clock::now();
+            while (g_running.load() && !lease->leader() && !lease->lost()) {
+                // REASON: The msgThreads start after promotion - this services the idle sessions meanwhile
+                // (processMessages waits up to 100 ms per connected session)
+                bool serviced = false;
+                for (auto& client : clients) {
+                    if (client->isConnected()) {
+                        client->processMessages();
+                        serviced = true;
+                    }
+                }
+                if (!serviced) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+            if (!lease->leader()) {
+                lease->stop();
+                disconnectClients();
+                stopJournals();
+                std::cout << "[MAIN] Standby stopped\n";
+                AsyncLogger::instance().stop();
+                return 0;
+            }
+            std::cout << "[MAIN] Promoted to leader after "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - standbyAt).count()
+                      << " ms on standby\n";
+            loadWarmStart();
+        }
         
-        // ========== THREAD 3: Connect to TWS (starts EReader thread) ==========
-        std::cout << "[MAIN] Connecting to TWS Gateway at " << TWS_HOST << ":" << TWS_PORT << "\n";
-        TwsClient client(queue);
+        // ========== THREAD 2: Start Redis Worker Threads (one per shard) ==========
+        // Each consumes its shard queue in bulk, publishes to Redis
+        WorkerConfig workerConfig = config.worker;
+        workerConfig.trackQueueAge = config.loadShed.enabled;  // REASON: LoadShedder input
+        workerConfig.trackOccupancy = config.sizing.enabled;
+        workerConfig.memory = config.ingest.memory;
+        workerConfig.shedConflationWindow = config.loadShed.conflationWindow;
+        workerConfig.volumeProfile.sessionReset = config.worker.derivedMetrics.sessionReset;
+        workerConfig.sessionStats.sessionReset = config.worker.derivedMetrics.sessionReset;
+        workerConfig.historyBudget = budgetShare(config.memory.bytes(MemorySubsystem::History), router.shardCount());
         
-        // NOTE: client.connect() internally calls m_reader->start() which spawns Thread 3 (EReader)
-        if (!client.createConnection(TWS_HOST, TWS_PORT, CLIENT_ID)) {
-            std::cerr << "[MAIN] Failed to connect to TWS Gateway\n";
-            g_running.store(false);
-            workerThread.join();
-            return 1;
+        // REASON: Declared before the workers - they read its table until they are joined
+        SubscriberTracker subscriberTracker(config.redisUri, registry);
+        // REASON: Same - every worker's Kafka sink counts into it until the sinks are stopped
+        KafkaCounters kafkaCounters;
+        // REASON: Same - every worker's sink thread feeds it; listening before the first snapshot is framed
+        std::shared_ptr<WebSocketGateway> websocket;
+        if (config.websocket.enabled) {
+            WebSocketConfig websocketConfig = config.websocket;
+            websocketConfig.memoryBudget = config.memory.bytes(MemorySubsystem::WebSocket);
+            websocket = std::make_shared<WebSocketGateway>(registry, websocketConfig);
+            if (!websocket->start()) {
+                std::cerr << "[MAIN] WebSocket gateway unavailable\n";
+                disconnectClients();
+                stopJournals();
+                return 1;
+            }
+        }
+        // REASON: Same - workers write it until they are joined, the query thread reads it until stopped
+        std::unique_ptr<QuoteTable> quotes;
+        if (config.query.enabled) {
+            quotes = std::make_unique<QuoteTable>(registry.capacity());
+        }
+        // REASON: Same - workers read its ready flags; started now so the first symbols' series exist early
+        TimeSeriesCatalog seriesCatalog(config.redisUri, registry, config.timeSeries);
+        if (config.timeSeries.enabled) {
+            seriesCatalog.start();
+        }
+        
+        // ========== State checkpoint: previous process's slots in, this process's slots out (shared memory) ==========
+        // REASON: Declared before the workers - they write the segment and read the image until they are joined
+        std::unique_ptr<StateCheckpoint> checkpoint;
+        CheckpointImage checkpointImage;
+        if (replayPath.empty() && config.checkpoint.enabled) {
+            const CheckpointLayout layout{
+                std::chrono::duration_cast<std::chrono::milliseconds>(config.worker.derivedMetrics.sessionReset).count(),
+                std::chrono::duration_cast<std::chrono::milliseconds>(config.worker.derivedMetrics.rollingWindow).count()};
+            std::string why;
+            checkpointImage = StateCheckpoint::load(config.checkpoint.name, layout, why);
+            if (!why.empty()) {
+                std::cout << "[MAIN] State checkpoint: " << why << " at " << config.checkpoint.name << ", starting cold\n";
+            } else {
+                std::cout << "[MAIN] State checkpoint: " << checkpointImage.slots.size() << " symbols to resume from "
+                          << config.checkpoint.name << (checkpointImage.derivedValid ? "" : " (derived metrics dropped: settings changed)")
+                          << "\n";
+            }
+            checkpoint = StateCheckpoint::create(config.checkpoint.name, registry.capacity(), layout);
+        }
+        // ========== Baskets (baskets.definitions): weighted sums kept by the workers, published off-thread ==========
+        // NOTE: The book registers the constituents - built before the workers so every slot is known to them
+        std::unique_ptr<BasketBook> basketBook;
+        std::unique_ptr<BasketPublisher> basketPublisher;
+        if (!config.baskets.baskets.empty()) {
+            basketBook = std::make_unique<BasketBook>(registry, config.baskets.baskets);
+            basketPublisher = std::make_unique<BasketPublisher>(config.redisUri, *basketBook, config.baskets);
+        }
+        // ========== Top movers (movers.enabled): ranked per worker, merged and published off-thread ==========
+        MoversConfig moversConfig = config.movers;
+        moversConfig.sessionReset = config.worker.derivedMetrics.sessionReset;
+        std::unique_ptr<MoversExchange> moversExchange;
+        std::unique_ptr<MoversPublisher> moversPublisher;
+        if (moversConfig.enabled) {
+            moversExchange = std::make_unique<MoversExchange>(router.shardCount());
+            moversPublisher = std::make_unique<MoversPublisher>(config.redisUri, *moversExchange, registry, moversConfig);
+        }
+        std::vector<std::unique_ptr<BasicRedisWorker<IngestQueue>>> workers;
+        std::vector<std::thread> workerThreads;
+        for (std::size_t i = 0; i < router.shardCount(); ++i) {
+            auto& shard = router.shard(i);
+            workerConfig.shardId = i;
+            workerConfig.thread = i < config.workerThreads.size() ? config.workerThreads[i] : ThreadConfig{};
+            workers.push_back(std::make_unique<BasicRedisWorker<IngestQueue>>(shard, registry, *publishers[i],
+                                                                             workerConfig));
+            if (!config.snapshotArchive.empty()) {
+                workers.back()->addSink(std::make_shared<JsonLinesSink>(config.snapshotArchive + "-" + std::to_string(i) + ".jsonl"));
+            }
+            if (config.kafka.enabled) {
+                std::shared_ptr<SnapshotSink> kafka = makeKafkaSink(config.kafka, registry, kafkaCounters);
+                if (!kafka) {
+                    std::cerr << "[MAIN] Kafka sink unavailable\n";
+                    disconnectClients();
+                    stopJournals();
+                    return 1;
+                }
+                workers.back()->addSink(std::move(kafka));
+            }
+            if (websocket) {
+                workers.back()->addSink(websocket);
+            }
+            if (config.watchSubscribers) {
+                workers.back()->watchSubscribers(subscriberTracker.table());
+            }
+            if (config.timeSeries.enabled) {
+                workers.back()->writeTimeSeries(seriesCatalog);
+            }
+            if (basketBook) {
+                workers.back()->computeBaskets(*basketBook);
+            }
+            if (moversExchange) {
+                workers.back()->rankMovers(*moversExchange, moversConfig);
+            }
+            if (checkpoint) {
+                workers.back()->checkpointTo(*checkpoint, &checkpointImage);
+            }
+            if (quotes) {
+                workers.back()->serveQuotes(*quotes);
+            }
+            if (tracing) {
+                workers.back()->traceTo(traceExport);
+            }
+        }
+        if (config.account.enabled) {
+            // NOTE: One table for the account - shard 0's worker drains the feed of the first connection
+            workers.front()->streamAccount(accountFeed, config.account.interval);
+        }
+        if (config.news.enabled) {
+            // NOTE: One lane - shard 0's worker drains the headlines of the first connection
+            workers.front()->streamNews(newsLane);
+        }
+        
+        if (rebalancer) {
+            std::vector<BasicRedisWorker<IngestQueue>*> peers;
+            for (auto& worker : workers) {
+                peers.push_back(worker.get());
+            }
+            for (auto& worker : workers) {
+                worker->rebalanceWith(router.migration(), peers, config.rebalance.handoffTimeout);
+            }
         }
-        std::cout << "[MAIN] TWS connected (EReader thread now running)\n";
         
-        // Wait for nextValidId callback (confirms connection)
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        // ========== Warm start: last published snapshots → worker state (before the workers run) ==========
+        if (warmStart && config.connection.cluster) {
+            std::cout << "[MAIN] Warm start skipped (Redis Cluster - MGET cannot span hash slots)\n";
+        } else if (pendingWarmStart.valid()) {
+            try {
+                const auto waitStart = std::chrono::steady_clock::now();
+                const std::vector<WarmStartEntry> seeds = pendingWarmStart.get();
+                for (const WarmStartEntry& seed : seeds) {
+                    workers[router.shardFor(seed.slot)]->warmStart(seed.slot, seed.state);
+                }
+                std::cout << "[MAIN] Warm start: " << seeds.size() << "/" << warmSlots << " symbols restored from TWS:LVC:* (waited "
+                          << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - waitStart).count()
+                          << " ms)\n";
+            } catch (const std::exception& e) {
+                std::cerr << "[MAIN] Warm start skipped: " << e.what() << "\n";  // REASON: Not fatal - symbols start cold
+            }
+        }
+        // NOTE: Compact mode runs the worker on the main thread (below) - a replay still gets its thread
+        const bool compact = config.compact && replayPath.empty();
+        for (auto& worker : workers) {
+            auto* w = worker.get();
+            if (!compact) {
+                workerThreads.emplace_back([w]() { w->run(g_workersRunning); });
+            }
+        }
+        // Second shutdown phase, after every producer stopped: each worker drains its shard, then exits
+        auto stopWorkers = [&workerThreads, &router, &workers, compact]() {
+            if (compact) {
+                workers.front()->finish();  // REASON: Same thread as its start() - the main thread
+                return;
+            }
+            g_workersRunning.store(false);
+            for (std::size_t shard = 0; shard < router.shardCount(); ++shard) {
+                router.shard(shard).waiter.notify();  // REASON: Parked workers re-check the flag
+            }
+            for (auto& t : workerThreads) {
+                if (t.joinable()) {
+                    t.join();
+                }
+            }
+        };
         
-        // ========== PIVOT: Use historical bars instead of tick-by-tick (markets closed) ==========
-        std::cout << "[MAIN] Subscribing to historical bar data (markets closed)...\n";
-        std::cout << "[MAIN] Requesting 5-minute bars for last 1 hour\n";
-        client.subscribeHistoricalBars("SPY", 2001, "3600 S", "5 mins");  // 1 hour of 5-min bars
+        // ========== REPLAY MODE: journal → shard queues in place of TwsClient (no TWS connection) ==========
+        if (!replayPath.empty()) {
+            ReplayConfig replayConfig = replayOptions;
+            replayConfig.latencyStamps = workerConfig.latency.enabled || workerConfig.lag.enabled || workerConfig.flight.enabled;
+            BasicJournalReplay<IngestQueue> replay(router, registry, replayConfig);
+            std::cout << "[REPLAY] " << replayPath << " at ";
+            if (replayConfig.speed > 0) {
+                std::cout << replayConfig.speed << "x speed\n";
+            } else {
+                std::cout << "max speed\n";
+            }
+            
+            // NOTE: This thread is the only producer, as msgThread is in live mode (SPSC shard queues)
+            // REASON: Replaces msgThread as the producer
+            ScopedThreadConfig placement("tws-replay", config.msgThreads.empty() ? ThreadConfig{} : config.msgThreads[0]);
+            const auto start = std::chrono::steady_clock::now();
+            const bool replayed = replay.run(replayPath, g_running);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            const ReplayCounters& counters = replay.counters();
+            std::cout << "[REPLAY] " << counters.records.load() << " updates from " << counters.segments.load()
+                      << " segments in " << seconds << " s (" << counters.records.load() / std::max(seconds, 1e-9)
+                      << "/s), " << counters.dropped.load() << " dropped, " << counters.unmapped.load() << " unmapped, "
+                      << counters.skippedBytes.load() / (1 << 20) << " MiB skipped by the index\n";
+            
+            // REASON: Let the workers drain what is queued before stopping them
+            for (int i = 0; i < 100 && g_running.load(); ++i) {
+                bool idle = true;
+                for (std::size_t shard = 0; shard < router.shardCount(); ++shard) {
+                    idle = idle && router.shard(shard).queue.size_approx() == 0 && !router.shard(shard).hasOverflow();
+                }
+                if (idle) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            g_running.store(false);
+            stopWorkers();
+            if (config.sizing.enabled) {
+                reportQueueSizing(config.sizing, queueCapacity, router, publishers);  // NOTE: At --speed 1x, a live-like burst profile
+            }
+            AsyncLogger::instance().stop();
+            return replayed ? 0 : 1;
+        }
         
-        // Wait for historical data to complete
-        std::this_thread::sleep_for(std::chrono::seconds(3));
+        auto anyLost = [&clients]() {
+            return std::any_of(clients.begin(), clients.end(), [](const auto& client) { return client->isConnectionLost(); });
+        };
+        // REASON: Same hash as CommandListener - a symbol's subscribe / unsubscribe reach the same connection
+        auto clientFor = [&clients](const std::string& symbol) -> ShardedTwsClient<IngestQueue>& {
+            return *clients[connectionFor(symbol, clients.size())];
+        };
         
-        // ========== DAY 1 EVENING: Real-Time Bars (Gate 3a) ==========
-        std::cout << "[MAIN] Subscribing to real-time bars (5-second updates)...\n";
-        client.subscribeRealTimeBars("SPY", 3001, 5, "TRADES");  // 5-second bars
+        // ========== Startup bar subscriptions (subscriptions.historical_bars / realtime_bars) ==========
+        // NOTE: Subscriptions are queued in the pacer, msgThread sends them (processMessages) as soon as
+        // the connection's nextValidId arrives - no startup sleep, bars flow through the callbacks
+        // REASON: subscriptions.incremental_history - the bar store holds the earlier runs' bars, only the
+        // ranges it is missing are requested (a warm restart asks for minutes, not the whole window)
+        constexpr BarSize kHistoryBarSize = BarSize::Min5;  // "5 mins"
+        const std::int64_t historyBarMs = barSizeSeconds(kHistoryBarSize) * 1000;
+        const std::int64_t historyNowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        const std::int64_t historyFromMs = historyNowMs
+            - std::chrono::duration_cast<std::chrono::milliseconds>(config.history.window).count();
+        std::vector<CachedBars> cachedBars(config.historicalBars.size());
+        if (config.history.incremental && !config.historicalBars.empty()) {
+            std::vector<std::string> keys;
+            for (const std::string& symbol : config.historicalBars) {
+                // NOTE: Registered ahead of the request, which then finds the same slot
+                const SlotId slot = registry.registerInstrument(symbol);
+                keys.push_back(slot == kInvalidSlot ? std::string()
+                                                    : registry.channels(slot).barStore + barSizeLabel(kHistoryBarSize));
+            }
+            try {
+                cachedBars = loadCachedBars(config.redisUri, keys, historyFromMs, config.history);
+            } catch (const std::exception& e) {
+                std::cerr << "[MAIN] Bar store unreadable (" << e.what() << "), requesting whole windows\n";
+            }
+        }
+        for (std::size_t i = 0; i < config.historicalBars.size(); ++i) {
+            const std::string& symbol = config.historicalBars[i];
+            const std::vector<HistoryRange> ranges =
+                missingHistoryRanges(cachedBars[i], historyFromMs, historyNowMs, historyBarMs);
+            std::cout << "[MAIN] Requesting 5-minute bars: " << symbol << " (" << cachedBars[i].count << " cached, "
+                      << ranges.size() << (ranges.size() == 1 ? " range" : " ranges")
+                      << (config.keepBarsUpToDate ? ", kept up to date)\n" : ")\n");
+            // PERFORMANCE: Every range goes to the pacer at once - they are sent side by side as pacing allows
+            for (const HistoryRange& range : ranges) {
+                const std::string duration = historicalDuration(range);
+                if (range.current) {
+                    clientFor(symbol).subscribeHistoricalBars(symbol, 2001 + static_cast<int>(i), duration,
+                                                              "5 mins", config.keepBarsUpToDate);
+                } else {
+                    clientFor(symbol).backfillHistoricalBars(symbol, historicalEndTime(range), duration,
+                                                             "5 mins");
+                }
+            }
+        }
+        for (std::size_t i = 0; i < config.realTimeBars.size(); ++i) {
+            const std::string& symbol = config.realTimeBars[i];
+            std::cout << "[MAIN] Subscribing to real-time bars (5-second updates): " << symbol << "\n";
+            clientFor(symbol).subscribeRealTimeBars(symbol, 3001 + static_cast<int>(i), 5, "TRADES");
+        }
+        if (config.account.enabled) {
+            clients.front()->subscribeAccount(accountFeed, config.account.id);
+        }
+        if (config.news.enabled) {
+            clients.front()->subscribeNews(newsLane, config.news.symbols.empty() ? config.symbols : config.news.symbols);
+        }
         
         // ========== THREAD 1: Main Thread Message Loop ==========
         // Thread 3 (EReader) reads socket → signals Thread 1 → callbacks enqueue to Thread 2
         std::cout << "[MAIN] Entering message processing loop...\n";
         std::cout << "[MAIN] Thread architecture:\n";
-        std::cout << "  Thread 1 (Main):    Processes TWS messages, calls EWrapper callbacks\n";
-        std::cout << "  Thread 2 (Worker):  Dequeues updates, publishes to Redis\n";
-        std::cout << "  Thread 3 (EReader): TWS API internal socket reader\n\n";
+        std::cout << "  Thread 1 (Main):    Processes TWS messages, calls EWrapper callbacks (x" << connections << " connections)\n";
+        std::cout << "  Thread 2 (Worker):  Dequeues updates, publishes to Redis (x" << router.shardCount() << " shards)\n";
+        std::cout << "  Thread 3 (Reader):  TWS socket reader (BridgeReader ring, or EReader), one per connection\n";
+        std::cout << "  Thread 4 (Commands): TWS:COMMANDS subscriber, queues subscribe/unsubscribe\n";
+        std::cout << "  Thread 5 (Metrics): Prometheus endpoint on port " << config.metricsPort << "\n";
+        std::cout << "  Thread 6 (Journal): Tick journal msync / segment rotation" << (config.journalEnabled ? "" : " (off)") << "\n";
+        std::cout << "  Thread 7 (Watchdog): Stage heartbeat checks" << (config.watchdog.enabled ? "" : " (off)") << "\n\n";
+        
+        // ========== THREAD 4: Command Listener (dynamic subscriptions) ==========
+        // REASON: Blocking SUBSCRIBE on its own thread, requests applied by each connection's msgThread below
+        std::vector<std::unique_ptr<CommandQueue>> commandQueues;
+        std::vector<CommandQueue*> commandRoutes;
+        for (std::size_t i = 0; i < connections; ++i) {
+            commandQueues.push_back(std::make_unique<CommandQueue>());
+            commandRoutes.push_back(commandQueues.back().get());
+        }
+        // ========== Partition (partition.enabled): this instance's share of the symbols ==========
+        // NOTE: Joined before the startup symbols are submitted - they are split by the live member list
+        std::unique_ptr<SymbolPartition> partition;
+        std::unique_ptr<PartitionMembership> membership;
+        if (config.partition.enabled) {
+            partition = std::make_unique<SymbolPartition>(
+                config.partition.id.empty() ? defaultInstanceId() : config.partition.id, commandRoutes);
+            membership = std::make_unique<PartitionMembership>(config.redisUri, *partition, config.partition);
+            membership->join();
+        }
+        auto submitCommand = [&](SubscriptionCommand command) {
+            if (partition) {
+                partition->submit(std::move(command));
+            } else {
+                commandQueues[connectionFor(command.symbol, connections)]->enqueue(std::move(command));
+            }
+        };
+        // ========== Demand-driven feeds (demand.enabled): startup symbols follow consumer interest ==========
+        SubscriptionDemand demand(config.demand);
+        CommandQueue interestQueue;
+        // REASON: Startup symbols take the TWS:COMMANDS path - same routing, ticker ids and feed selection
+        for (const std::string& symbol : config.symbols) {
+            if (config.demand.enabled) {
+                if (!partition || partition->owns(symbol)) {
+                    demand.track(symbol);  // NOTE: The first housekeeping pass subscribes the idle feed
+                    if (config.demand.subscribers) {
+                        registry.registerInstrument(symbol);  // REASON: NUMSUB probes registered slots only
+                    }
+                }
+                continue;
+            }
+            SubscriptionCommand command;
+            command.symbol = symbol;
+            command.feed = config.feed;
+            command.requestId = "config";
+            submitCommand(std::move(command));
+        }
+        // REASON: Constituents trade-subscribed like startup symbols, and pinned so a universe diff never drops them
+        std::vector<std::string> pinnedSymbols = config.symbols;
+        for (const BasketDefinition& basket : config.baskets.baskets) {
+            for (const BasketConstituent& constituent : basket.constituents) {
+                if (std::find(pinnedSymbols.begin(), pinnedSymbols.end(), constituent.symbol) != pinnedSymbols.end()) {
+                    continue;
+                }
+                pinnedSymbols.push_back(constituent.symbol);
+                SubscriptionCommand command;
+                command.symbol = constituent.symbol;
+                command.feed = config.feed;
+                command.requestId = "basket";
+                submitCommand(std::move(command));
+            }
+        }
+        // ========== Symbol universe (subscriptions.universe_file / universe_key): synced as diffs ==========
+        std::unique_ptr<UniverseWatcher> universe;
+        if (!config.universe.path.empty() || !config.universe.key.empty()) {
+            universe = std::make_unique<UniverseWatcher>(config.redisUri, config.universe, pinnedSymbols,
+                                                         [&](const UniverseDiff& diff) {
+                for (const std::string& symbol : diff.removed) {
+                    SubscriptionCommand command;
+                    command.action = CommandAction::Unsubscribe;
+                    command.symbol = symbol;
+                    command.requestId = "universe";
+                    submitCommand(std::move(command));
+                }
+                for (const std::string& symbol : diff.added) {
+                    SubscriptionCommand command;
+                    command.symbol = symbol;
+                    command.feed = config.feed;
+                    command.requestId = "universe";
+                    submitCommand(std::move(command));
+                }
+            });
+            universe->load();  // NOTE: Not fatal - the watcher keeps polling
+            universe->start();
+        }
+        // ========== Market scans (scanner.scans): cycles diffed and published off-thread ==========
+        // NOTE: Entrants take the TWS:COMMANDS path (submitCommand) - same routing, partition and pacing
+        std::unique_ptr<ScanOutbox> scanOutbox;
+        std::unique_ptr<ScanPublisher> scanPublisher;
+        if (!config.scanner.scans.empty()) {
+            scanOutbox = std::make_unique<ScanOutbox>(config.scanner.scans.size());
+            scanPublisher = std::make_unique<ScanPublisher>(config.redisUri, *scanOutbox, config.scanner, submitCommand);
+            clients.front()->subscribeScanners(config.scanner, *scanOutbox);
+        }
+        if (partition) {
+            std::cout << "[MAIN] Partition: " << partition->owned() << " of " << config.symbols.size()
+                      << " startup symbols owned by " << partition->self() << " (" << partition->members() << " members)\n";
+        }
+        CommandListenerConfig commandConfig = config.commands;
+        commandConfig.statusChannel = config.worker.latency.statusChannel;
+        CommandListener commandListener(config.redisUri, commandRoutes, commandConfig);
+        commandListener.setPartition(partition.get());
+        if (config.demand.enabled) {
+            commandListener.setInterestQueue(&interestQueue);
+        }
+        std::unique_ptr<SamplingProfiler> profiler;
+        if (config.profiler.enabled) {
+            profiler = std::make_unique<SamplingProfiler>(config.redisUri, config.profiler);
+            profiler->start();
+            commandListener.setProfiler(profiler.get());
+        }
+        commandListener.start();
+        if (membership) {
+            membership->start();
+        }
+        if (config.watchSubscribers) {
+            subscriberTracker.start();
+        }
+        
+        // ========== THREAD 7: Stage watchdog (heartbeats of every pipeline thread) ==========
+        // NOTE: Stages registered here, the thread starts once the message threads run
+        WatchdogConfig watchdogConfig = config.watchdog;
+        watchdogConfig.statusChannel = config.worker.latency.statusChannel;
+        StageWatchdog watchdog(watchdogConfig, config.redisUri);
+        if (config.watchdog.enabled) {
+            for (std::size_t i = 0; i < connections; ++i) {
+                ShardedTwsClient<IngestQueue>* client = clients[i].get();
+                auto abort = [client]() { client->abortConnection(); };
+                watchdog.watch(Stage::Reader, i, client->readerHeartbeat(), abort);
+                watchdog.watch(Stage::Dispatch, i, client->dispatchHeartbeat(), abort);
+            }
+            for (std::size_t i = 0; i < workers.size(); ++i) {
+                watchdog.watch(Stage::Worker, i, workers[i]->heartbeat());
+                const SinkFanout* sinks = workers[i]->sinks();
+                for (std::size_t j = 0; sinks && j < sinks->sinkCount(); ++j) {
+                    watchdog.watch(Stage::Sink, i, sinks->heartbeat(j));
+                }
+            }
+        }
+        
+        // ========== THREAD 8: Snapshot query endpoint (query.enabled): lookups answered from the QuoteTable ==========
+        std::unique_ptr<QueryServer> queryServer;
+        if (quotes) {
+            const QueryEncoding encoding{config.worker.snapshotSchema, config.worker.priceFormat,
+                                         config.worker.isoTimestamps};
+            queryServer = std::make_unique<QueryServer>(registry, *quotes, config.query, encoding);
+            if (!queryServer->start()) {
+                std::cerr << "[MAIN] Query endpoint disabled\n";  // REASON: Not fatal - the bridge still streams
+                queryServer.reset();
+            }
+        }
+        
+        // ========== THREAD 5: Prometheus endpoint (GET /metrics) ==========
+        // REASON: Counters are aggregated per scrape on this thread - the pipeline only does relaxed adds
+        MetricsServerConfig metricsConfig;
+        metricsConfig.port = config.metricsPort;
+        MetricsServer metricsServer(metricsConfig);
+        metricsServer.addCollector([&](PrometheusWriter& out) {
+            collectMetrics(out, router, workers, publishers, clients, commandListener, journals,
+                           config.watchSubscribers ? &subscriberTracker : nullptr, watchdog,
+                           tracing ? &traceExport : nullptr, registry, rebalancer.get());
+        });
+        metricsServer.addCollector([&](PrometheusWriter& out) {
+            // REASON: Summed per scrape - each shard / publisher / worker only measures its own buffers
+            std::uint64_t bytes[static_cast<std::size_t>(MemorySubsystem::Count)] = {};
+            std::uint64_t degraded[static_cast<std::size_t>(MemorySubsystem::Count)] = {};
+            for (std::size_t i = 0; i < router.shardCount(); ++i) {
+                bytes[static_cast<std::size_t>(MemorySubsystem::IngestSpill)] += router.shard(i).spillBytes();
+                degraded[static_cast<std::size_t>(MemorySubsystem::IngestSpill)] +=
+                    router.shard(i).overflow.spillOverBudget.load(std::memory_order_relaxed);
+            }
+            for (const auto& publisher : publishers) {
+                bytes[static_cast<std::size_t>(MemorySubsystem::PublishSpill)] +=
+                    publisher->counters().spillBytes.load(std::memory_order_relaxed);
+                degraded[static_cast<std::size_t>(MemorySubsystem::PublishSpill)] +=
+                    publisher->counters().overBudget.load(std::memory_order_relaxed);
+            }
+            for (const auto& worker : workers) {
+                // NOTE: Signed - a slot migrating between workers is briefly counted on the wrong one
+                bytes[static_cast<std::size_t>(MemorySubsystem::History)] += static_cast<std::uint64_t>(
+                    std::max<std::int64_t>(0, worker->counters().historyBytes.load(std::memory_order_relaxed)));
+                degraded[static_cast<std::size_t>(MemorySubsystem::History)] +=
+                    worker->counters().historyTrims.load(std::memory_order_relaxed);
+            }
+            if (websocket) {
+                bytes[static_cast<std::size_t>(MemorySubsystem::WebSocket)] =
+                    websocket->counters().bufferedBytes.load(std::memory_order_relaxed);
+                degraded[static_cast<std::size_t>(MemorySubsystem::WebSocket)] =
+                    websocket->counters().overBudget.load(std::memory_order_relaxed);
+            }
+            out.family("tws_bridge_memory_bytes", "gauge", "Bytes held by the growable buffers, by subsystem");
+            for (std::size_t i = 0; i < static_cast<std::size_t>(MemorySubsystem::Count); ++i) {
+                out.sample("tws_bridge_memory_bytes",
+                           std::string("subsystem=\"") + memorySubsystemName(static_cast<MemorySubsystem>(i)) + "\"",
+                           bytes[i]);
+            }
+            out.family("tws_bridge_memory_budget_bytes", "gauge", "Configured memory.* budget, 0 = unbounded");
+            for (std::size_t i = 0; i < static_cast<std::size_t>(MemorySubsystem::Count); ++i) {
+                const auto subsystem = static_cast<MemorySubsystem>(i);
+                out.sample("tws_bridge_memory_budget_bytes",
+                           std::string("subsystem=\"") + memorySubsystemName(subsystem) + "\"",
+                           static_cast<std::uint64_t>(config.memory.bytes(subsystem)));
+            }
+            out.family("tws_bridge_memory_degraded_total", "counter",
+                       "Budget enforcements (updates dropped, messages evicted, chunks cut, clients closed)");
+            for (std::size_t i = 0; i < static_cast<std::size_t>(MemorySubsystem::Count); ++i) {
+                out.sample("tws_bridge_memory_degraded_total",
+                           std::string("subsystem=\"") + memorySubsystemName(static_cast<MemorySubsystem>(i)) + "\"",
+                           degraded[i]);
+            }
+        });
+        if (config.kafka.enabled) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                out.family("tws_bridge_kafka_records_total", "counter", "Snapshots produced to kafka.topic, by outcome");
+                out.sample("tws_bridge_kafka_records_total", "outcome=\"delivered\"",
+                           kafkaCounters.delivered.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_kafka_records_total", "outcome=\"failed\"",
+                           kafkaCounters.failed.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_kafka_records_total", "outcome=\"dropped\"",
+                           kafkaCounters.dropped.load(std::memory_order_relaxed));
+            });
+        }
+        if (websocket) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const WebSocketCounters& counters = websocket->counters();
+                out.family("tws_bridge_websocket_connections", "gauge", "Open WebSocket gateway connections");
+                out.sample("tws_bridge_websocket_connections", "", counters.connections.load(std::memory_order_relaxed));
+                out.family("tws_bridge_websocket_frames_total", "counter", "Snapshot frames to WebSocket clients, by outcome");
+                out.sample("tws_bridge_websocket_frames_total", "outcome=\"sent\"",
+                           counters.frames.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_websocket_frames_total", "outcome=\"conflated\"",
+                           counters.conflated.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_websocket_frames_total", "outcome=\"dropped\"",
+                           counters.dropped.load(std::memory_order_relaxed));
+                out.family("tws_bridge_websocket_disconnects_total", "counter", "WebSocket connections refused or closed by the gateway, by reason");
+                out.sample("tws_bridge_websocket_disconnects_total", "reason=\"rejected\"",
+                           counters.rejected.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_websocket_disconnects_total", "reason=\"stalled\"",
+                           counters.stalled.load(std::memory_order_relaxed));
+            });
+        }
+        if (queryServer) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const QueryCounters& counters = queryServer->counters();
+                out.family("tws_bridge_query_requests_total", "counter", "Snapshot lookup datagrams answered");
+                out.sample("tws_bridge_query_requests_total", "", counters.requests.load(std::memory_order_relaxed));
+                out.family("tws_bridge_query_symbols_total", "counter", "Symbols looked up, by result");
+                out.sample("tws_bridge_query_symbols_total", "result=\"found\"",
+                           counters.found.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_query_symbols_total", "result=\"missed\"",
+                           counters.missed.load(std::memory_order_relaxed));
+            });
+        }
+        if (universe) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const UniverseCounters& counters = universe->counters();
+                out.family("tws_bridge_universe_symbols", "gauge", "Symbols in the current subscription universe");
+                out.sample("tws_bridge_universe_symbols", "", counters.size.load(std::memory_order_relaxed));
+                out.family("tws_bridge_universe_changes_total", "counter", "Subscription commands issued by universe diffs");
+                out.sample("tws_bridge_universe_changes_total", "change=\"added\"", counters.added.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_universe_changes_total", "change=\"removed\"", counters.removed.load(std::memory_order_relaxed));
+                out.family("tws_bridge_universe_errors_total", "counter", "Universe file / set reads that failed");
+                out.sample("tws_bridge_universe_errors_total", "", counters.errors.load(std::memory_order_relaxed));
+            });
+        }
+        if (membership) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const PartitionCounters& counters = membership->counters();
+                out.family("tws_bridge_partition_members", "gauge", "Live bridge instances sharing the symbol set");
+                out.sample("tws_bridge_partition_members", "", static_cast<std::uint64_t>(partition->members()));
+                out.family("tws_bridge_partition_owned_symbols", "gauge", "Symbols this instance subscribes");
+                out.sample("tws_bridge_partition_owned_symbols", "", static_cast<std::uint64_t>(partition->owned()));
+                out.family("tws_bridge_partition_moved_total", "counter", "Subscribes and cancels issued by rebalances");
+                out.sample("tws_bridge_partition_moved_total", "", counters.moved.load(std::memory_order_relaxed));
+                out.family("tws_bridge_partition_errors_total", "counter", "Membership heartbeat Redis errors");
+                out.sample("tws_bridge_partition_errors_total", "", counters.errors.load(std::memory_order_relaxed));
+            });
+        }
+        if (lease) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const LeaderCounters& counters = lease->counters();
+                out.family("tws_bridge_leader", "gauge", "1 while this bridge holds leader.key");
+                out.sample("tws_bridge_leader", "", std::uint64_t{lease->leader() ? 1u : 0u});
+                out.family("tws_bridge_leader_renewals_total", "counter", "Leader lease renewals");
+                out.sample("tws_bridge_leader_renewals_total", "", counters.renewals.load(std::memory_order_relaxed));
+                out.family("tws_bridge_leader_failures_total", "counter", "Leader lease Redis errors and lost ownership");
+                out.sample("tws_bridge_leader_failures_total", "", counters.failures.load(std::memory_order_relaxed));
+            });
+        }
+        if (basketPublisher) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const BasketCounters& counters = basketPublisher->counters();
+                out.family("tws_bridge_basket_value", "gauge", "baskets.definitions: sum of weight x last trade");
+                out.family("tws_bridge_basket_priced", "gauge", "Basket constituents with a trade so far");
+                for (std::size_t i = 0; i < basketBook->size(); ++i) {
+                    const std::string labels = "basket=\"" + basketBook->definition(i).name + "\"";
+                    out.sample("tws_bridge_basket_value", labels, basketBook->value(i));
+                    out.sample("tws_bridge_basket_priced", labels, std::uint64_t{basketBook->priced(i)});
+                }
+                out.family("tws_bridge_basket_published_total", "counter", "Basket snapshots published on TWS:TICKS:*");
+                out.sample("tws_bridge_basket_published_total", "", counters.published.load(std::memory_order_relaxed));
+                out.family("tws_bridge_basket_errors_total", "counter", "Basket publisher Redis errors");
+                out.sample("tws_bridge_basket_errors_total", "", counters.errors.load(std::memory_order_relaxed));
+            });
+        }
+        if (moversPublisher) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const MoversCounters& counters = moversPublisher->counters();
+                out.family("tws_bridge_movers_published_total", "counter", "Movers rankings published on movers.channel");
+                out.sample("tws_bridge_movers_published_total", "", counters.published.load(std::memory_order_relaxed));
+                out.family("tws_bridge_movers_errors_total", "counter", "Movers publisher Redis errors");
+                out.sample("tws_bridge_movers_errors_total", "", counters.errors.load(std::memory_order_relaxed));
+            });
+        }
+        if (scanPublisher) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const ScanCounters& counters = scanPublisher->counters();
+                out.family("tws_bridge_scan_cycles_total", "counter", "Completed scanner cycles, by outcome");
+                out.sample("tws_bridge_scan_cycles_total", "outcome=\"published\"",
+                           counters.published.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_scan_cycles_total", "outcome=\"unchanged\"",
+                           counters.unchanged.load(std::memory_order_relaxed));
+                out.family("tws_bridge_scan_subscribed_total", "counter", "Scan entrants subscribed (scanner.auto_subscribe)");
+                out.sample("tws_bridge_scan_subscribed_total", "", counters.subscribed.load(std::memory_order_relaxed));
+                out.family("tws_bridge_scan_errors_total", "counter", "Scan publisher Redis errors");
+                out.sample("tws_bridge_scan_errors_total", "", counters.errors.load(std::memory_order_relaxed));
+            });
+        }
+        if (config.news.enabled) {
+            metricsServer.addCollector([&](PrometheusWriter& out) {
+                const NewsCounters& counters = newsLane.counters;
+                out.family("tws_bridge_news_total", "counter", "Headlines on the news lane, by outcome");
+                out.sample("tws_bridge_news_total", "outcome=\"published\"",
+                           counters.published.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_news_total", "outcome=\"duplicate\"",
+                           counters.duplicates.load(std::memory_order_relaxed));
+                out.sample("tws_bridge_news_total", "outcome=\"dropped\"",
+                           counters.dropped.load(std::memory_order_relaxed));
+                out.family("tws_bridge_news_received_total", "counter", "tickNews callbacks on the news lines");
+                out.sample("tws_bridge_news_received_total", "", counters.received.load(std::memory_order_relaxed));
+            });
+        }
+        if (config.metricsEnabled && !metricsServer.start()) {
+            std::cerr << "[MAIN] Metrics endpoint disabled\n";  // REASON: Not fatal - the bridge still streams
+        }
+        
+        // ========== Status heartbeat (status.enabled): one compact TWS:STATUS message per interval ==========
+        // REASON: Same counters as /metrics, summed on the heartbeat thread - no stage is paused or signalled
+        StatusConfig statusConfig = config.status;
+        statusConfig.channel = config.worker.latency.statusChannel;
+        auto collectStatus = [&](StatusSample& sample) {
+            auto relaxed = [](const std::atomic<std::uint64_t>& counter) { return counter.load(std::memory_order_relaxed); };
+            for (const auto& client : clients) {
+                for (std::size_t type = 0; type < kTickUpdateTypeCount; ++type) {
+                    sample.ticksIn += client->counters().ticksIn[type].value();
+                }
+                sample.twsConnected += client->isConnected() ? 1 : 0;
+                sample.subscriptions += client->subscriptionCount();  // NOTE: Command lock, not the tick path
+            }
+            sample.twsConnections = clients.size();
+            for (std::size_t i = 0; i < router.shardCount(); ++i) {
+                const OverflowCounters& overflow = router.shard(i).overflow;
+                sample.dropped += relaxed(overflow.dropped);
+                sample.conflated += relaxed(overflow.conflated);
+                sample.queueDepth = std::max(sample.queueDepth, router.shard(i).queue.size_approx());
+            }
+            for (const auto& worker : workers) {
+                sample.published += relaxed(worker->counters().published);
+                sample.conflated += relaxed(worker->counters().conflated);
+                sample.queueAge = std::max<std::chrono::nanoseconds>(sample.queueAge, worker->queueAge());
+            }
+            for (const auto& publisher : publishers) {
+                const PublisherCounters& counters = publisher->counters();
+                sample.sent += relaxed(counters.sent);
+                sample.dropped += relaxed(counters.dropped) + relaxed(counters.failed);
+                sample.redisRtt = std::max(sample.redisRtt, publisher->lastRoundTrip());
+                sample.redisDown += publisher->isConnected() ? 0 : 1;
+            }
+        };
+        StatusHeartbeat statusHeartbeat(config.redisUri, statusConfig, collectStatus);
+        if (config.status.enabled && !statusConfig.channel.empty()) {
+            statusHeartbeat.start();
+        }
+        
+        // ========== Session report (report.enabled): latency / throughput of each trading session ==========
+        // REASON: The status counters plus the lifetime histograms /metrics exports - copied at session
+        // boundaries only, nothing new is recorded on a pipeline thread
+        SessionReportConfig reportConfig = config.report;
+        reportConfig.sessionReset = config.worker.derivedMetrics.sessionReset;
+        SessionReporter sessionReporter(config.redisUri, reportConfig, [&](SessionSample& sample) {
+            auto relaxed = [](const std::atomic<std::uint64_t>& counter) { return counter.load(std::memory_order_relaxed); };
+            collectStatus(sample.status);
+            for (const auto& worker : workers) {
+                const WorkerCounters& counters = worker->counters();
+                sample.suppressed += relaxed(counters.unchanged) + relaxed(counters.duplicates)
+                                   + relaxed(counters.deadbanded) + relaxed(counters.unwatched);
+            }
+            for (const auto& client : clients) {
+                sample.twsReconnects += relaxed(client->counters().reconnects);
+            }
+            for (const auto& publisher : publishers) {
+                sample.redisReconnects += relaxed(publisher->counters().reconnects);
+            }
+        }, [&](SessionHistograms& lifetime) {
+            // NOTE: Summed over shards / connections - a session's percentiles are the whole bridge's
+            LatencySnapshot snapshot;
+            auto add = [&snapshot](const LatencyHistogram& histogram, LatencySnapshot& sum) {
+                histogram.snapshot(snapshot);
+                for (std::size_t i = 0; i < LatencySnapshot::kBuckets; ++i) {
+                    sum.counts[i] += snapshot.counts[i];
+                }
+            };
+            for (LatencySnapshot& sum : lifetime) {
+                sum.counts.fill(0);
+            }
+            auto at = [&lifetime](SessionHistogram histogram) -> LatencySnapshot& {
+                return lifetime[static_cast<std::size_t>(histogram)];
+            };
+            for (std::size_t i = 0; i < workers.size(); ++i) {
+                const WorkerLatency& worker = workers[i]->latency();
+                const PublisherLatency& publisher = publishers[i]->latency();
+                add(worker.ingest, at(SessionHistogram::Ingest));
+                add(worker.queue, at(SessionHistogram::Queue));
+                add(worker.serialize, at(SessionHistogram::Serialize));
+                add(publisher.publish, at(SessionHistogram::Publish));
+                add(publisher.endToEnd, at(SessionHistogram::EndToEnd));
+                add(publisher.roundTrip, at(SessionHistogram::RedisRoundTrip));
+            }
+            for (const auto& client : clients) {
+                add(client->counters().reconnectTime, at(SessionHistogram::TwsReconnect));
+            }
+        });
+        if (config.report.enabled) {
+            sessionReporter.start();
+        }
+        if (basketPublisher) {
+            basketPublisher->start();
+        }
+        if (moversPublisher) {
+            moversPublisher->start();
+        }
+        if (scanPublisher) {
+            scanPublisher->start();
+        }
         
         // REASON: Use separate thread for TWS message processing to avoid blocking on waitForSignal()
         // This allows main thread to respond to signals immediately
-        std::thread msgThread([&client]() {
-            while (g_running.load() && client.isConnected()) {
-                client.processMessages();
+        // PERFORMANCE: One per connection - decoding and callbacks scale with connections (and cores)
+        std::vector<std::thread> msgThreads;
+        for (std::size_t i = 0; i < connections && !compact; ++i) {
+            ShardedTwsClient<IngestQueue>* client = clients[i].get();
+            CommandQueue* commands = commandQueues[i].get();
+            const ThreadConfig placement = i < config.msgThreads.size() ? config.msgThreads[i] : ThreadConfig{};
+            const std::string name = connections == 1 ? "tws-msg" : "tws-msg-" + std::to_string(i);
+            msgThreads.emplace_back([client, commands, placement, name]() {
+                configureCurrentThread(name.c_str(), placement);
+                profileCurrentThread();  // NOTE: reconnect() connects under a ProfilerSignalBlock
+                Heartbeat& heartbeat = client->dispatchHeartbeat();
+                heartbeat.attach();
+                while (g_running.load()) {
+                    // NOTE: Blocks in back-off until the session is back (false: shutdown or gave up)
+                    if (!client->isConnected()) {
+                        heartbeat.park(true);  // REASON: Back-off is waiting, not stalling
+                        if (!client->reconnect(g_running)) {
+                            break;
+                        }
+                        heartbeat.park(false);
+                    }
+                    // NOTE: Between iterations - no callback is running while a subscription changes
+                    client->applyCommands(*commands);
+                    client->processMessages();
+                }
+                heartbeat.park(true);
+                std::cout << "[MSG] Message processing thread stopped (" << name << ")\n";
+            });
+        }
+        
+        watchdog.start();
+        
+        // ========== Load shedding (load_shed): sampled every main loop iteration ==========
+        // REASON: Worst shard decides - one overloaded shard stalls its symbols as badly as all of them
+        LoadShedder loadShedder(config.loadShed);
+        auto resubscribe = [&](FeedType feed) {
+            for (const std::string& symbol : config.loadShed.lowPriority) {
+                if (partition && !partition->owns(symbol)) {
+                    continue;  // REASON: Another instance's symbol - it sheds its own
+                }
+                SubscriptionCommand command;
+                command.symbol = symbol;
+                command.requestId = "load_shed";
+                command.action = CommandAction::Unsubscribe;
+                commandQueues[connectionFor(symbol, connections)]->enqueue(command);
+                command.action = CommandAction::Subscribe;
+                command.feed = feed;
+                commandQueues[connectionFor(symbol, connections)]->enqueue(std::move(command));
             }
-            std::cout << "[MSG] Message processing thread stopped\n";
-        });
+        };
+        auto updateLoadShed = [&]() {
+            LoadSample sample;
+            for (std::size_t i = 0; i < workers.size(); ++i) {
+                sample.queueAge = std::max(sample.queueAge, workers[i]->queueAge());
+                sample.queueDepth = std::max(sample.queueDepth, router.shard(i).queue.size_approx());
+                sample.publishLatency = std::max(sample.publishLatency, publishers[i]->lastRoundTrip());
+                sample.redisDown = sample.redisDown || !publishers[i]->isConnected();
+            }
+            const ShedLevel previous = loadShedder.level();
+            if (!loadShedder.update(sample, std::chrono::steady_clock::now())) {
+                return;
+            }
+            const ShedLevel level = loadShedder.level();
+            std::cout << "[MAIN] Load shedding: " << shedLevelName(previous) << " -> " << shedLevelName(level) << "\n";
+            for (auto& worker : workers) {
+                worker->setShedLevel(level);
+            }
+            // NOTE: Through the command queues - the msgThreads own the subscriptions
+            if (level == ShedLevel::DowngradeFeeds) {
+                resubscribe(FeedType::TopOfBook);
+            } else if (previous == ShedLevel::DowngradeFeeds) {
+                resubscribe(config.feed);
+            }
+        };
         
+        auto lastRebalance = std::chrono::steady_clock::now();
+        auto updateRebalance = [&]() {
+            const auto now = std::chrono::steady_clock::now();
+            if (now - lastRebalance < config.rebalance.interval) {
+                return;
+            }
+            const double seconds = std::chrono::duration<double>(now - lastRebalance).count();
+            lastRebalance = now;
+            rebalancer->observe([&router](SlotId slot) { return router.ticks(slot); }, registry.size(), seconds);
+            const auto move = rebalancer->plan([&router](SlotId slot) { return router.shardFor(slot); }, registry.size());
+            // NOTE: Refused while the previous move is still in flight - planned again next interval
+            if (move && router.requestMigration(move->slot, move->to)) {
+                std::cout << "[MAIN] Rebalancing " << registry.symbol(move->slot) << " (" << static_cast<int>(move->rate)
+                          << " ticks/s): shard " << move->from << " -> " << move->to << "\n";
+            }
+        };
+        
+        // REASON: Transitions take the TWS:COMMANDS path - unsubscribe the old feed, subscribe the new one
+        // PITFALL: NUMSUB fails open (every slot watched until the first pass, and again after a probe error) -
+        // it only counts once a pass has completed, and demand.upgrade_after should outlast a Redis hiccup
+        auto updateDemand = [&]() {
+            const auto now = std::chrono::steady_clock::now();
+            SubscriptionCommand command;
+            while (interestQueue.try_dequeue(command)) {
+                if (command.action == CommandAction::Interest) {
+                    demand.interest(command.symbol, command.consumer, command.ttl, now);
+                } else {
+                    demand.release(command.symbol, command.consumer);
+                }
+            }
+            const bool probed = config.watchSubscribers && subscriberTracker.counters().probes.load() > 0;
+            demand.update(now,
+                [&](const std::string& symbol) {
+                    const SlotId slot = registry.find(symbol);
+                    return probed && slot != kInvalidSlot && subscriberTracker.table().watched(slot);
+                },
+                [&](const std::string& symbol, DemandLevel from, DemandLevel to) {
+                    std::cout << "[MAIN] Demand " << symbol << ": " << demandLevelName(from) << " -> "
+                              << demandLevelName(to) << " (" << demand.interested(symbol) << " consumers)\n";
+                    for (SubscriptionCommand& change : demand.commands(symbol, from, to)) {
+                        submitCommand(std::move(change));
+                    }
+                });
+        };
         // REASON: Main thread just monitors shutdown flag
-        while (g_running.load() && client.isConnected()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        // PITFALL: A connection that cannot be re-established stops the bridge - its symbols would
+        // silently go stale otherwise
+        bool ready = false;
+        auto lastSave = std::chrono::steady_clock::now();
+        auto lastRebase = lastSave;
+        auto readyAt = lastSave;
+        // PITFALL: So does a lost leader lease - the standby may already be taking over
+        auto housekeeping = [&]() {
+            // REASON: Follows NTP on the wall clock, keeps TSC drift between anchors sub-microsecond
+            if (std::chrono::steady_clock::now() - lastRebase >= std::chrono::seconds(1)) {
+                lastRebase = std::chrono::steady_clock::now();
+                receiveClock().rebase();
+            }
+            if (!ready && std::all_of(clients.begin(), clients.end(), [](const auto& client) { return client->isReady(); })) {
+                ready = true;  // NOTE: Restart time = data missed during market hours
+                readyAt = startedAt;
+                for (const auto& client : clients) {
+                    readyAt = std::max(readyAt, client->readyAt());  // The last connection's nextValidId
+                }
+                std::cout << "[MAIN] All connections ready in "
+                          << std::chrono::duration_cast<std::chrono::milliseconds>(readyAt - startedAt).count()
+                          << " ms\n";
+            }
+            // REASON: Armed once warm - subscriptions, pools and per-slot buffers allocate while starting up
+            if (ready && allocationHookInstalled() && allocationGuardMode() != config.allocations.guard
+                && std::chrono::steady_clock::now() - readyAt >= config.allocations.warmup) {
+                setAllocationGuardMode(config.allocations.guard);
+                std::cout << "[MAIN] Allocation guard armed\n";
+            }
+            if (g_reload.exchange(false)) {
+                reloadConfig(source, loaded);
+            }
+            if (config.loadShed.enabled) {
+                updateLoadShed();
+            }
+            if (rebalancer) {
+                updateRebalance();
+            }
+            if (config.demand.enabled) {
+                updateDemand();
+            }
+            // REASON: Lookups trickle in behind the subscriptions - persisted in batches, not per answer
+            // PERFORMANCE: The rewrite runs on the pool - at most one queued, the main loop never waits on the disk
+            if (std::chrono::steady_clock::now() - lastSave >= std::chrono::seconds(10)) {
+                lastSave = std::chrono::steady_clock::now();
+                if (!contractSaveQueued.exchange(true)) {
+                    background->post([&saveContracts, &contractSaveQueued]() {
+                        contractSaveQueued.store(false);
+                        saveContracts();
+                    });
+                }
+            }
+        };
+        auto stopRequested = [&]() { return !g_running.load() || anyLost() || (lease && lease->lost()); };
+        if (!compact) {
+            while (!stopRequested()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                housekeeping();
+            }
+        } else {
+            // ========== COMPACT MODE: socket read, decode, aggregation and publish on this thread ==========
+            // PERFORMANCE: No reader ring, shard queue wake-up or Redis I/O hand-off - a tick is recv'd, applied
+            // and pipelined without leaving the cache of one core. The shard queue is a same-thread buffer here.
+            // NOTE: The socket wait ends at the worker's next timer (tiers, bar sweeps, stats) or housekeeping
+            // PITFALL: Nothing publishes while reconnect() backs off - conflated state goes out once it is back
+            ShardedTwsClient<IngestQueue>& client = *clients.front();
+            BasicRedisWorker<IngestQueue>& worker = *workers.front();
+            configureCurrentThread("tws-compact", config.msgThreads.empty() ? ThreadConfig{} : config.msgThreads[0]);
+            worker.start();
+            Heartbeat& heartbeat = client.dispatchHeartbeat();
+            heartbeat.attach();
+            std::cout << "[MAIN] Compact mode: reader, worker and publisher on one thread\n";
+            auto housekeepingAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+            while (!stopRequested()) {
+                if (!client.isConnected()) {
+                    heartbeat.park(true);  // REASON: Back-off is waiting, not stalling
+                    if (!client.reconnect(g_running)) {
+                        break;
+                    }
+                    heartbeat.park(false);
+                }
+                client.applyCommands(*commandQueues.front());
+                const auto now = std::chrono::steady_clock::now();
+                const auto wakeAt = std::min(worker.nextDeadline(), housekeepingAt);
+                client.processMessages(wakeAt > now ? std::chrono::duration_cast<std::chrono::milliseconds>(wakeAt - now)
+                                                    : std::chrono::milliseconds(0));
+                while (worker.poll()) {
+                    // REASON: Drains the burst processMessages() just staged, then runs the idle publishes once
+                }
+                if (std::chrono::steady_clock::now() >= housekeepingAt) {
+                    housekeepingAt = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+                    housekeeping();
+                }
+            }
+            heartbeat.park(true);
+        }
+        g_running.store(false);  // REASON: Other msgThreads must not start reconnecting on disconnect()
+        const auto stoppingAt = std::chrono::steady_clock::now();
+        const bool leaseLost = lease && lease->lost();
+        if (leaseLost) {
+            std::cerr << "[MAIN] Leader lease lost, stopping (restart to rejoin as standby)\n";
         }
         
-        // REASON: Clean shutdown sequence
+        // ========== Shutdown phase 1: stop ingestion (no producer left for the shard queues) ==========
+        std::cout << "[MAIN] Stopping command listener...\n";
+        commandListener.stop();
+        if (profiler) {
+            profiler->stop();  // NOTE: A profile still running is cut short and written
+        }
+        if (universe) {
+            universe->stop();
+        }
+        if (membership) {
+            membership->stop();  // REASON: Leaves the member set now - the others take over while this one drains
+        }
+        subscriberTracker.stop();
+        seriesCatalog.stop();
+        metricsServer.stop();
+        statusHeartbeat.stop();
+        if (basketPublisher) {
+            basketPublisher->stop();
+        }
+        if (moversPublisher) {
+            moversPublisher->stop();
+        }
+        if (scanPublisher) {
+            scanPublisher->stop();
+        }
+        if (queryServer) {
+            queryServer->stop();
+        }
+        if (websocket) {
+            websocket->stop();  // NOTE: Workers still drain into its feed - nothing reads it from here on
+        }
+        watchdog.stop();  // REASON: Stages stop beating from here on
+        
         std::cout << "[MAIN] Disconnecting from TWS...\n";
-        client.disconnect();
+        for (auto& client : clients) {
+            client->disconnect();
+        }
         
-        std::cout << "[MAIN] Waiting for message thread...\n";
-        if (msgThread.joinable()) {
-            msgThread.join();
+        std::cout << "[MAIN] Waiting for message threads...\n";
+        for (auto& t : msgThreads) {
+            if (t.joinable()) {
+                t.join();
+            }
         }
         
-        std::cout << "[MAIN] Waiting for worker thread...\n";
-        workerThread.join();
+        stopJournals();  // REASON: After the msgThreads - no append() can race the final msync / truncate
+        saveContracts();
         
-        std::cout << "[MAIN] Shutdown complete\n";
+        // ========== Shutdown phase 2: drain the shard queues into Redis (worker.drain_timeout) ==========
+        std::cout << "[MAIN] Draining worker queues...\n";
+        stopWorkers();
+        if (config.sizing.enabled) {
+            reportQueueSizing(config.sizing, queueCapacity, router, publishers);
+        }
+        if (config.report.enabled) {
+            sessionReporter.finish();  // REASON: After the drain - the run's last publishes are in it
+        }
+        traceExport.stop();  // REASON: After the workers - their last publish spans are in the file
+        if (lease) {
+            lease->stop();  // REASON: Released after the drain - the standby's warm start reads the final TWS:LVC:*
+        }
+        
+        std::cout << "[MAIN] Shutdown complete in "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - stoppingAt).count()
+                  << " ms\n";
+        AsyncLogger::instance().stop();  // REASON: Flush queued records before exit
+        if (leaseLost) {
+            return 1;  // NOTE: Non-zero so a supervisor restarts it
+        }
         
     } catch (const std::exception& e) {
         std::cerr << "[MAIN] Fatal error: " << e.what() << "\n";
@@ -215,3 +1819,100 @@ int main(int argc, char* argv[]) {
     
     return 0;
 }
+
+int main(int argc, char* argv[]) {
+    // REASON: Before any thread starts - every thread inherits the block, the profiled ones lift it (ProfilerSignal.h)
+    blockProfilerSignal();
+    ConfigSource source;
+    std::string replayPath;
+    ReplayConfig replayOptions;
+    std::string exportPath;
+    std::string exportDir = "export";
+    std::string serveDir;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        static const char* const kFlags[] = {"--config", "--set", "--host", "--port", "--client-id", "--subscribe",
+                                             "--replay", "--speed", "--export", "--out", "--symbols", "--from", "--to",
+                                             "--serve-journal"};
+        if (i + 1 >= argc || std::find(std::begin(kFlags), std::end(kFlags), flag) == std::end(kFlags)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--config") {
+            source.path = value;
+        } else if (flag == "--set") {
+            source.overrides.push_back(value);
+        } else if (flag == "--host") {
+            source.overrides.push_back("tws.host=" + value);
+        } else if (flag == "--port") {
+            source.overrides.push_back("tws.port=" + value);
+        } else if (flag == "--client-id") {
+            source.overrides.push_back("tws.client_ids=[" + value + "]");
+        } else if (flag == "--subscribe") {
+            source.overrides.push_back("subscriptions.symbols=[" + value + "]");
+        } else if (flag == "--replay") {
+            replayPath = value;
+        } else if (flag == "--export") {
+            exportPath = value;
+        } else if (flag == "--out") {
+            exportDir = value;
+        } else if (flag == "--serve-journal") {
+            serveDir = value;
+        } else if (flag == "--symbols") {
+            std::stringstream list(value);
+            for (std::string symbol; std::getline(list, symbol, ',');) {
+                if (!symbol.empty()) {
+                    replayOptions.filter.symbols.push_back(symbol);
+                }
+            }
+        } else if (flag == "--from" || flag == "--to") {
+            if (!parseJournalTime(value, flag == "--from" ? replayOptions.filter.fromNs : replayOptions.filter.toNs)) {
+                std::cerr << "[MAIN] Invalid " << flag << " " << value << "\n";
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (!parseReplaySpeed(value, replayOptions.speed)) {
+            std::cerr << "[MAIN] Invalid --speed " << value << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    std::cout << "=== TWS-Redis Bridge v0.1.0 ===\n";
+    if (!exportPath.empty()) {
+        return runExport(exportPath, exportDir, replayOptions.filter);
+    }
+    
+    // REASON: Validated before any thread starts - a typo fails the start, not the trading day
+    ConfigFile loaded;
+    BridgeConfig config;
+    std::string error;
+    if (!source.load(loaded, error) || !applyConfig(loaded, config, error)) {
+        std::cerr << "[CONFIG] Invalid configuration:\n" << error << "\n";
+        return 1;
+    }
+    if (!source.path.empty()) {
+        std::cout << "[CONFIG] Loaded " << source.path << " (" << loaded.values().size() << " keys)\n";
+    }
+    
+    // Signal handlers for graceful shutdown
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+    std::signal(SIGHUP, reloadHandler);
+    
+    if (!serveDir.empty()) {
+        return runJournalServer(config, serveDir);
+    }
+    
+    // Hot-path logging (per tick / per bar / per publish) goes through the async logger
+    AsyncLogger::instance().setLevel(config.logLevel);  // Debug: every published snapshot and bar
+    AsyncLogger::instance().start();
+    
+    // PERFORMANCE: SPSC ring per shard - msgThread is the only producer, one worker per shard
+    // REASON: Several connections = several msgThreads enqueueing to every shard (MpmcTickQueue)
+    if (config.clientIds.size() == 1) {
+        return runBridge<SpscTickQueue>(config, source, loaded, replayPath, replayOptions);
+    }
+    return runBridge<MpmcTickQueue>(config, source, loaded, replayPath, replayOptions);
+}
@@ -0,0 +1,61 @@
+// JournalTestSupport.h - Fixtures shared by the journal tests (scratch directory, synthetic recording)
+
+#pragma once
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "TickJournal.h"
+#include <unistd.h>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace tws_bridge::journal_test {
+
+// Fresh, empty directory per test case, removed on scope exit
+// NOTE: The pid keeps test binaries that run in parallel (ctest -j) out of each other's directories
+struct TempDirectory {
+    std::string path;
+    explicit TempDirectory(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / ("tws-journal-" + name + "-" + std::to_string(::getpid()))).string()) {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() { std::filesystem::remove_all(path); }
+};
+
+inline constexpr std::int64_t kBaseNs = 1700000000000000000;
+inline constexpr int kRareEvery = 5000;  // RARE ticks once per ~4 raw spans
+
+// Records `ticks` quotes: AAPL / MSFT alternate, RARE every kRareEvery-th tick; receive time = kBaseNs + i μs
+// and timestamp = 1700000000000 + i ms, so a tick's index is recoverable from either
+inline void recordAlternating(InstrumentRegistry& registry, const std::string& directory, JournalFormat format,
+                              int ticks) {
+    const SlotId aapl = registry.registerInstrument("AAPL", 1);
+    const SlotId msft = registry.registerInstrument("MSFT", 2);
+    const SlotId rare = registry.registerInstrument("RARE", 3);
+
+    JournalConfig config;
+    config.directory = directory;
+    config.format = format;
+    config.blockBytes = 4096;
+    config.segmentBytes = 1 << 20;
+    TickJournal journal(registry, config);
+    REQUIRE(journal.start());
+    for (int i = 0; i < ticks; ++i) {
+        TickUpdate update;
+        update.slot = i % kRareEvery == kRareEvery - 1 ? rare : i % 2 == 0 ? aapl : msft;
+        update.type = TickUpdateType::BidAsk;
+        update.timestamp = 1700000000000 + i;
+        update.bidAsk.bidPrice = 100.0 + (i % 13) * 0.01;
+        update.bidAsk.askPrice = update.bidAsk.bidPrice + 0.01;
+        update.bidAsk.bidSize = 100;
+        update.bidAsk.askSize = 200;
+        update.bidAsk.stamps.receiveNs = kBaseNs + std::int64_t{i} * 1000;
+        journal.append(update);
+    }
+    journal.stop();
+    REQUIRE(journal.counters().dropped.load() == 0);
+}
+
+} // namespace tws_bridge::journal_test
@@ -0,0 +1,225 @@
+// TwsTestSupport.h - Fixtures shared by the in-process TWS tests (loopback fake Gateway, wire framing)
+
+#pragma once
+
+#include "EWrapper.h"
+#include "EClient.h"  // REASON: After EWrapper.h (EClient.h relies on its <map> include)
+#include "EDecoder.h"
+#include "TwsClient.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tws_bridge::tws_test {
+
+using namespace ibapi::client_constants;  // Request ids (EDecoder.h: server message ids)
+
+inline constexpr int kServerVersion = 200;  // REASON: Below MIN_SERVER_VER_PROTOBUF - text message ids both ways
+
+// Subscription request as it arrived on the wire
+struct Request {
+    int msgId;
+    int reqId;
+    std::string symbol;
+    std::string tickType;  // Tick-by-tick only
+    bool operator==(const Request& other) const {
+        return msgId == other.msgId && reqId == other.reqId && symbol == other.symbol && tickType == other.tickType;
+    }
+    bool operator<(const Request& other) const {
+        return reqId != other.reqId ? reqId < other.reqId : tickType < other.tickType;
+    }
+};
+
+inline std::uint32_t readInt32(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return (std::uint32_t{bytes[0]} << 24) | (std::uint32_t{bytes[1]} << 16) | (std::uint32_t{bytes[2]} << 8) | bytes[3];
+}
+
+// 4-byte big-endian length + NUL-terminated text fields (the handshake answer has no message id either)
+inline std::string frame(const std::vector<std::string>& fields) {
+    std::string payload;
+    for (const std::string& field : fields) {
+        payload.append(field).push_back('\0');
+    }
+    std::string out;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>((payload.size() >> shift) & 0xFF));
+    }
+    return out + payload;
+}
+
+// Serves API sessions one after the other: handshake, nextValidId on startApi, records the tick-by-tick
+// and reqMktData requests per session; drop() closes the current session's socket (a Gateway restart)
+class FakeGateway {
+public:
+    FakeGateway() {
+        m_listen = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        ::getsockname(m_listen, reinterpret_cast<sockaddr*>(&address), &length);
+        m_port = ntohs(address.sin_port);
+        ::listen(m_listen, 1);
+        m_thread = std::thread([this]() { serve(); });
+    }
+
+    ~FakeGateway() {
+        m_running.store(false);
+        m_thread.join();
+        ::close(m_listen);
+    }
+
+    unsigned int port() const { return m_port; }
+
+    std::vector<Request> requests(std::size_t session) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return session < m_sessions.size() ? m_sessions[session] : std::vector<Request>{};
+    }
+
+    // Sessions accepted so far (a reconnect opens the next one)
+    std::size_t sessions() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_sessions.size();
+    }
+
+    void drop() { m_drop.store(true); }
+
+    // Queued for the current session, written by the serving thread
+    void send(std::string bytes) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_out += bytes;
+    }
+
+private:
+    void serve() {
+        while (m_running.load()) {
+            pollfd listener{m_listen, POLLIN, 0};
+            if (::poll(&listener, 1, 20) <= 0) {
+                continue;
+            }
+            const int fd = ::accept(m_listen, nullptr, nullptr);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_sessions.emplace_back();
+                m_out.clear();
+            }
+            m_drop.store(false);
+            session(fd);
+            ::close(fd);
+        }
+    }
+
+    void session(int fd) {
+        std::string in;
+        bool greeted = false;
+        while (m_running.load() && !m_drop.load()) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_out.empty()) {
+                    ::send(fd, m_out.data(), m_out.size(), MSG_NOSIGNAL);
+                    m_out.clear();
+                }
+            }
+            pollfd client{fd, POLLIN, 0};
+            if (::poll(&client, 1, 20) <= 0) {
+                continue;
+            }
+            char buffer[4096];
+            const ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (got <= 0) {
+                return;
+            }
+            in.append(buffer, static_cast<std::size_t>(got));
+            if (!greeted) {
+                // Client: "API\0" + framed "v100..203" - answered with "<version>\0<time>\0"
+                if (in.size() < 8 || in.size() < 8 + readInt32(in.data() + 4)) {
+                    continue;
+                }
+                in.erase(0, 8 + readInt32(in.data() + 4));
+                send(frame({std::to_string(kServerVersion), "20231114 22:13:20 UTC"}));
+                greeted = true;
+            }
+            while (in.size() >= 4 && in.size() - 4 >= readInt32(in.data())) {
+                const std::size_t length = readInt32(in.data());
+                std::vector<std::string> fields;
+                for (std::size_t start = 4; start < 4 + length;) {
+                    const std::size_t end = in.find('\0', start);
+                    fields.push_back(in.substr(start, std::min(end, 4 + length) - start));
+                    start = std::min(end, 4 + length) + 1;
+                }
+                in.erase(0, 4 + length);
+                handle(fields);
+            }
+        }
+    }
+
+    // NOTE: Field positions follow EClient's encoding for server version 200 (as fake_tws)
+    void handle(const std::vector<std::string>& fields) {
+        const auto field = [&fields](std::size_t index) { return index < fields.size() ? fields[index] : std::string(); };
+        const int msgId = std::atoi(field(0).c_str());
+        switch (msgId) {
+        case START_API:
+            send(frame({std::to_string(NEXT_VALID_ID), "1", "1"}));
+            return;
+        case REQ_TICK_BY_TICK_DATA:
+            // reqId, contract (conId, symbol, ... tradingClass), tickType, numberOfTicks, ignoreSize
+            record({msgId, std::atoi(field(1).c_str()), field(3), field(14)});
+            return;
+        case REQ_MKT_DATA:
+            // version, tickerId, contract (conId, symbol, ...)
+            record({msgId, std::atoi(field(2).c_str()), field(4), ""});
+            return;
+        default:
+            return;
+        }
+    }
+
+    void record(Request request) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_sessions.back().push_back(std::move(request));
+    }
+
+    int m_listen = -1;
+    unsigned int m_port = 0;
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_drop{false};
+    std::mutex m_mutex;
+    std::vector<std::vector<Request>> m_sessions;  // Requests per accepted session (m_mutex)
+    std::string m_out;                             // Pending bytes for the current session (m_mutex)
+    std::thread m_thread;
+};
+
+using Client = BasicTwsClient<QueueSink<SpscTickQueue>>;
+
+// Plays the msgThread until done() holds or timeout passed
+inline bool pump(Client& client, const std::function<bool()>& done,
+                 std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        if (client.isConnected()) {
+            client.processMessages();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    return true;
+}
+
+} // namespace tws_bridge::tws_test
@@ -0,0 +1,501 @@
+// benchmark_consumer_decode.cpp - Consumer-side decode cost of each output format: what a subscriber pays
+// per tick to turn the bridge's payloads back into a row per symbol
+// OBJECTIVE: ns/message, heap allocations/message and bytes/message per format, so the format choice
+// can be priced end to end (bridge-side cost: benchmark_serialization, benchmark_pipeline)
+//
+// Formats (all produced by the bridge's own encoders from the same synthetic tick stream):
+//   json            TWS:TICKS verbose snapshots (worker.snapshot_schema: verbose)
+//   json_compact    compact field names
+//   json_delta      worker.delta: changed fields + keyframes (verbose names)
+//   binary          TWS:BIN:TICKS v1 snapshots
+//   binary_delta    v1 deltas + keyframes
+//   json_lz4_batch  worker.aggregate arrays of --batch snapshots, LZ4-framed (worker.compression.aggregate)
+// JSON is decoded the way a typical consumer does it (RapidJSON DOM per message, fields copied into the
+// symbol's row, deltas merged); binary through the consumer SDK (BinaryReader.h TickBook, no copies)
+//
+// Usage: benchmark_consumer_decode [options]
+//   --symbols N     Symbols in the synthetic stream (default 200)
+//   --messages N    Ticks per format (default 100000)
+//   --batch N       Snapshots per json_lz4_batch array (default 50)
+//   --passes N      Timed passes over each corpus (default 5, the best one is reported)
+//   --dump FILE     Write the corpus for scripts/consumer_decode_bench.py (same messages, Python decoders)
+//   --input FILE    Decode a corpus written by --dump instead of generating one
+//   --format F      text | csv (default text)
+
+#include "BinaryEncoder.h"
+#include "BinaryReader.h"
+#include "Lz4Frame.h"
+#include "MarketData.h"
+#include "SnapshotDelta.h"
+#include "SnapshotEncoder.h"
+#include "rapidjson/document.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace tws_bridge;
+
+// ========== Allocation Counter ==========
+// REASON: RapidJSON's CrtAllocator calls malloc directly - an operator new hook would miss the DOM
+// NOTE: glibc only (__libc_malloc), like the rest of the bridge's Linux-specific tooling
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* p, std::size_t size);
+void __libc_free(void* p);
+}
+
+static std::atomic<std::uint64_t> g_allocations{0};
+
+extern "C" void* malloc(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* p, std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+
+extern "C" void free(void* p) {
+    __libc_free(p);
+}
+
+namespace {
+
+enum class Format : std::uint8_t { Json, JsonCompact, JsonDelta, Binary, BinaryDelta, JsonLz4Batch };
+constexpr std::size_t kFormats = 6;
+constexpr const char* kFormatNames[kFormats] = {"json", "json_compact", "json_delta", "binary", "binary_delta",
+                                                "json_lz4_batch"};
+constexpr char kDumpMagic[8] = {'T', 'W', 'S', 'D', 'E', 'C', '1', '\n'};
+
+// One payload as a consumer receives it, ticks = snapshots it carries (json_lz4_batch: --batch)
+struct Message {
+    std::string payload;
+    std::uint32_t ticks = 1;
+};
+
+struct Corpus {
+    std::vector<Message> messages[kFormats];
+};
+
+struct Options {
+    int symbols = 200;
+    int messages = 100000;
+    int batch = 50;
+    int passes = 5;
+    std::string dump;
+    std::string input;
+    std::string format = "text";
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << '\n';
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--symbols") {
+            options.symbols = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--messages") {
+            options.messages = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--batch") {
+            options.batch = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--passes") {
+            options.passes = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--dump") {
+            options.dump = value;
+        } else if (arg == "--input") {
+            options.input = value;
+        } else if (arg == "--format") {
+            options.format = value;
+        } else {
+            std::cerr << "Unknown option " << arg << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+// ========== Synthetic stream: quote-heavy random walk, every tick encoded in every format ==========
+
+void generate(const Options& options, Corpus& corpus) {
+    static constexpr std::string_view kExchanges[] = {"NASDAQ", "ARCA", "NYSE", "BATS"};
+    std::mt19937_64 random(42);
+    std::vector<std::string> symbols;
+    std::vector<InstrumentState> states(static_cast<std::size_t>(options.symbols));
+    std::vector<DeltaTrack> jsonTracks(states.size());
+    std::vector<DeltaTrack> binaryTracks(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        char name[24];
+        std::snprintf(name, sizeof(name), "SYM%04zu", i);
+        InstrumentState& state = states[i];
+        state.symbol = name;
+        state.conId = static_cast<long>(100000 + i);
+        state.bidPrice = 50.0 + static_cast<double>(i % 400);
+        state.askPrice = state.bidPrice + 0.01;
+        state.lastPrice = state.bidPrice;
+        state.bidSize = 100;
+        state.askSize = 200;
+        state.lastSize = 100;
+        state.exchange = kExchanges[0];
+        state.hasQuote = true;
+        state.hasTrade = true;
+    }
+
+    const DeltaConfig deltas{true, 100, std::chrono::seconds(5)};
+    JsonBuffer json;
+    std::string binary;
+    SnapshotArray array;
+    std::size_t arrayTicks = 0;
+    Lz4Compressor lz4;
+    std::int64_t nowMs = 1700000000000;
+    for (int n = 0; n < options.messages; ++n) {
+        InstrumentState& state = states[random() % states.size()];
+        const std::size_t index = static_cast<std::size_t>(&state - states.data());
+        nowMs += 1;
+        if (random() % 5 != 0) {
+            const double move = (static_cast<int>(random() % 3) - 1) * 0.01;
+            state.bidPrice += move;
+            state.askPrice = state.bidPrice + 0.01 * static_cast<double>(1 + random() % 2);
+            state.bidSize = 100 * static_cast<std::int64_t>(1 + random() % 20);
+            state.askSize = 100 * static_cast<std::int64_t>(1 + random() % 20);
+            state.quoteTimestamp = nowMs;
+        } else {
+            state.lastPrice = random() % 2 ? state.bidPrice : state.askPrice;
+            state.lastSize = static_cast<std::int64_t>(1 + random() % 500);
+            state.exchange = kExchanges[random() % 4];
+            state.tradeTimestamp = nowMs;
+        }
+        ++state.sequence;
+
+        encodeSnapshot(state, json);
+        corpus.messages[static_cast<std::size_t>(Format::Json)].push_back({json.str(), 1});
+        array.append(std::string_view(json.data(), json.size()));
+        if (++arrayTicks == static_cast<std::size_t>(options.batch) || n + 1 == options.messages) {
+            Message batch;
+            lz4.compressFrame(array.close(), batch.payload);
+            batch.ticks = static_cast<std::uint32_t>(arrayTicks);
+            corpus.messages[static_cast<std::size_t>(Format::JsonLz4Batch)].push_back(std::move(batch));
+            array.clear();
+            arrayTicks = 0;
+        }
+        encodeSnapshot(state, json, SnapshotSchema::Compact);
+        corpus.messages[static_cast<std::size_t>(Format::JsonCompact)].push_back({json.str(), 1});
+        encodeSnapshotBinary(state, binary);
+        corpus.messages[static_cast<std::size_t>(Format::Binary)].push_back({binary, 1});
+
+        DeltaTrack& jsonTrack = jsonTracks[index];
+        const bool jsonKeyframe = jsonTrack.keyframeDue(state, deltas);
+        if (jsonKeyframe) {
+            encodeSnapshot(state, json);
+        } else {
+            encodeSnapshotDelta(state, jsonTrack.baseline().changes(state, false), json);
+        }
+        jsonTrack.sent(state, jsonKeyframe);
+        corpus.messages[static_cast<std::size_t>(Format::JsonDelta)].push_back({json.str(), 1});
+
+        DeltaTrack& binaryTrack = binaryTracks[index];
+        const bool binaryKeyframe = binaryTrack.keyframeDue(state, deltas);
+        if (binaryKeyframe) {
+            encodeSnapshotBinary(state, binary);
+        } else {
+            encodeSnapshotBinaryDelta(state, binaryTrack.baseline().changes(state, false), binary);
+        }
+        binaryTrack.sent(state, binaryKeyframe);
+        corpus.messages[static_cast<std::size_t>(Format::BinaryDelta)].push_back({binary, 1});
+    }
+}
+
+// ========== Corpus file: magic, then per message u8 format | u32 LE ticks | u32 LE length | payload ==========
+
+void writeLE32(std::ofstream& out, std::uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    out.write(bytes, 4);
+}
+
+bool dumpCorpus(const std::string& path, const Corpus& corpus) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot write " << path << '\n';
+        return false;
+    }
+    out.write(kDumpMagic, sizeof(kDumpMagic));
+    for (std::size_t f = 0; f < kFormats; ++f) {
+        for (const Message& message : corpus.messages[f]) {
+            out.put(static_cast<char>(f));
+            writeLE32(out, message.ticks);
+            writeLE32(out, static_cast<std::uint32_t>(message.payload.size()));
+            out.write(message.payload.data(), static_cast<std::streamsize>(message.payload.size()));
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+bool loadCorpus(const std::string& path, Corpus& corpus) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(kDumpMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kDumpMagic, sizeof(magic)) != 0) {
+        std::cerr << path << ": not a benchmark_consumer_decode corpus\n";
+        return false;
+    }
+    char header[9];
+    while (in.read(header, sizeof(header))) {
+        const std::size_t format = static_cast<unsigned char>(header[0]);
+        const std::uint32_t ticks = binary_wire::loadLE<std::uint32_t>(header + 1);
+        const std::uint32_t length = binary_wire::loadLE<std::uint32_t>(header + 5);
+        Message message;
+        message.ticks = ticks;
+        message.payload.resize(length);
+        if (format >= kFormats || !in.read(message.payload.data(), length)) {
+            std::cerr << path << ": truncated or unknown format " << format << '\n';
+            return false;
+        }
+        corpus.messages[format].push_back(std::move(message));
+    }
+    return true;
+}
+
+// ========== Consumer decoders: payload → the symbol's TickRow (binary_wire layout for every format) ==========
+
+struct JsonNames {
+    const char* symbol;
+    const char* sequence;
+    const char* timestamp;
+    const char* exchange;
+    const char* price;
+    const char* size;
+    const char* timestamps;
+    const char* bid;
+    const char* ask;
+    const char* last;
+    const char* quote;
+    const char* trade;
+};
+
+constexpr JsonNames kVerboseNames{"instrument", "seq", "timestamp", "exchange", "price", "size", "timestamps",
+                                  "bid", "ask", "last", "quote", "trade"};
+constexpr JsonNames kCompactNames{"sym", "sq", "ts", "ex", "p", "s", "tss", "b", "a", "l", "q", "t"};
+
+// TickRow + the trade's exchange (the binary wire has no exchange - its consumers read conditions)
+struct JsonRow {
+    binary_wire::TickRow tick;
+    char exchange[8];
+};
+
+// Latest row per symbol, fields a message carries overwrite it (a full snapshot carries all of them)
+class JsonBook {
+public:
+    explicit JsonBook(const JsonNames& names) : m_names(names) {}
+
+    bool apply(const rapidjson::Value& message) {
+        if (!message.IsObject()) {
+            return false;
+        }
+        const auto symbol = message.FindMember(m_names.symbol);
+        if (symbol == message.MemberEnd() || !symbol->value.IsString()) {
+            return false;
+        }
+        m_key.assign(symbol->value.GetString(), symbol->value.GetStringLength());
+        JsonRow& entry = m_rows[m_key];
+        binary_wire::TickRow& row = entry.tick;
+        readInt(message, m_names.sequence, row.sequence);
+        readInt(message, m_names.timestamp, row.timestamp);
+        const auto exchange = message.FindMember(m_names.exchange);
+        if (exchange != message.MemberEnd() && exchange->value.IsString()) {
+            const std::size_t length = std::min<std::size_t>(exchange->value.GetStringLength(), sizeof(entry.exchange));
+            std::memcpy(entry.exchange, exchange->value.GetString(), length);
+            std::memset(entry.exchange + length, 0, sizeof(entry.exchange) - length);
+        }
+        const auto price = message.FindMember(m_names.price);
+        if (price != message.MemberEnd() && price->value.IsObject()) {
+            readDouble(price->value, m_names.bid, row.bid);
+            readDouble(price->value, m_names.ask, row.ask);
+            readDouble(price->value, m_names.last, row.last);
+        }
+        const auto size = message.FindMember(m_names.size);
+        if (size != message.MemberEnd() && size->value.IsObject()) {
+            readInt(size->value, m_names.bid, row.bidSize);
+            readInt(size->value, m_names.ask, row.askSize);
+            readInt(size->value, m_names.last, row.lastSize);
+        }
+        const auto timestamps = message.FindMember(m_names.timestamps);
+        if (timestamps != message.MemberEnd() && timestamps->value.IsObject()) {
+            readInt(timestamps->value, m_names.quote, row.quoteTimestamp);
+            readInt(timestamps->value, m_names.trade, row.tradeTimestamp);
+        }
+        return true;
+    }
+
+    std::size_t size() const { return m_rows.size(); }
+
+private:
+    template <typename T>
+    static void readInt(const rapidjson::Value& object, const char* name, T& out) {
+        const auto member = object.FindMember(name);
+        if (member != object.MemberEnd() && member->value.IsNumber()) {
+            out = static_cast<T>(member->value.GetDouble());  // NOTE: Fractional sizes arrive as 0.5
+        }
+    }
+
+    static void readDouble(const rapidjson::Value& object, const char* name, double& out) {
+        const auto member = object.FindMember(name);
+        if (member != object.MemberEnd() && member->value.IsNumber()) {
+            out = member->value.GetDouble();
+        }
+    }
+
+    JsonNames m_names;
+    std::unordered_map<std::string, JsonRow> m_rows;
+    std::string m_key;
+};
+
+// Decodes every message of one format once, returns the ticks decoded
+std::size_t decodeAll(Format format, const std::vector<Message>& messages) {
+    std::size_t ticks = 0;
+    if (format == Format::Binary || format == Format::BinaryDelta) {
+        binary_wire::TickBook book;
+        for (const Message& message : messages) {
+            ticks += book.apply(message.payload) ? 1 : 0;
+        }
+        return ticks;
+    }
+    JsonBook book(format == Format::JsonCompact ? kCompactNames : kVerboseNames);
+    if (format == Format::JsonLz4Batch) {
+        std::string plain;
+        for (const Message& message : messages) {
+            plain.clear();
+            if (!decompressLz4Frame(message.payload, plain)) {
+                continue;
+            }
+            rapidjson::Document document;
+            document.Parse(plain.data(), plain.size());
+            if (document.HasParseError() || !document.IsArray()) {
+                continue;
+            }
+            for (const rapidjson::Value& snapshot : document.GetArray()) {
+                ticks += book.apply(snapshot) ? 1 : 0;
+            }
+        }
+        return ticks;
+    }
+    for (const Message& message : messages) {
+        rapidjson::Document document;  // REASON: What a consumer's handler does - one DOM per message
+        document.Parse(message.payload.data(), message.payload.size());
+        ticks += !document.HasParseError() && book.apply(document) ? 1 : 0;
+    }
+    return ticks;
+}
+
+struct Result {
+    std::size_t ticks = 0;
+    double bytesPerTick = 0.0;
+    double nsPerTick = 0.0;
+    double allocsPerTick = 0.0;
+};
+
+Result measure(Format format, const std::vector<Message>& messages, int passes) {
+    Result result;
+    std::size_t bytes = 0;
+    std::size_t carried = 0;
+    for (const Message& message : messages) {
+        bytes += message.payload.size();
+        carried += message.ticks;
+    }
+    result.bytesPerTick = carried ? static_cast<double>(bytes) / static_cast<double>(carried) : 0.0;
+    decodeAll(format, messages);  // REASON: Warm-up - page in the corpus, grow the allocator's arenas
+    double bestNs = 0.0;
+    for (int pass = 0; pass < passes; ++pass) {
+        const std::uint64_t allocsBefore = g_allocations.load(std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        result.ticks = decodeAll(format, messages);
+        const double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        const std::uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - allocsBefore;
+        if (pass == 0 || ns < bestNs) {
+            bestNs = ns;
+        }
+        result.allocsPerTick = result.ticks ? static_cast<double>(allocs) / static_cast<double>(result.ticks) : 0.0;
+    }
+    result.nsPerTick = result.ticks ? bestNs / static_cast<double>(result.ticks) : 0.0;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    Corpus corpus;
+    if (!options.input.empty()) {
+        if (!loadCorpus(options.input, corpus)) {
+            return 1;
+        }
+    } else {
+        generate(options, corpus);
+    }
+    if (!options.dump.empty()) {
+        if (!dumpCorpus(options.dump, corpus)) {
+            return 1;
+        }
+        std::cout << "Corpus written to " << options.dump << " (scripts/consumer_decode_bench.py " << options.dump
+                  << ")\n";
+    }
+
+    const bool text = options.format != "csv";
+    if (text) {
+        std::cout << "=== Consumer Decode Benchmark ===\n";
+        std::cout << "Corpus: " << (options.input.empty() ? "synthetic" : options.input) << " | Symbols: "
+                  << options.symbols << " | Passes: " << options.passes << " (best)\n\n";
+        std::cout << std::left << std::setw(16) << "format" << std::right << std::setw(10) << "ticks"
+                  << std::setw(12) << "bytes/tick" << std::setw(12) << "ns/tick" << std::setw(14) << "allocs/tick"
+                  << std::setw(14) << "ticks/s (M)" << '\n';
+    } else {
+        std::cout << "format,ticks,bytes_per_tick,ns_per_tick,allocs_per_tick\n";
+    }
+    for (std::size_t f = 0; f < kFormats; ++f) {
+        if (corpus.messages[f].empty()) {
+            continue;
+        }
+        const Result result = measure(static_cast<Format>(f), corpus.messages[f], options.passes);
+        if (text) {
+            std::cout << std::left << std::setw(16) << kFormatNames[f] << std::right << std::setw(10) << result.ticks
+                      << std::fixed << std::setprecision(1) << std::setw(12) << result.bytesPerTick << std::setw(12)
+                      << result.nsPerTick << std::setprecision(2) << std::setw(14) << result.allocsPerTick
+                      << std::setw(14) << (result.nsPerTick > 0 ? 1000.0 / result.nsPerTick : 0.0) << '\n';
+        } else {
+            std::cout << kFormatNames[f] << ',' << result.ticks << ',' << std::fixed << std::setprecision(1)
+                      << result.bytesPerTick << ',' << result.nsPerTick << ',' << std::setprecision(3)
+                      << result.allocsPerTick << '\n';
+        }
+    }
+    if (text) {
+        std::cout << "\nbytes/tick: payload bytes on the wire (json_lz4_batch: compressed array / snapshots in it)\n"
+                  << "Bridge-side cost of the same formats: benchmark_serialization, benchmark_pipeline\n";
+    }
+    return 0;
+}
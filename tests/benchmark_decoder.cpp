@@ -0,0 +1,446 @@
+// benchmark_decoder.cpp - Decoder microbenchmark: raw TWS frames through EDecoder::parseAndProcessMsg
+// (no-op DefaultEWrapper) and through the BridgeReader fast decoders (TickByTickDecoder.h)
+// OBJECTIVE: ns/message + allocations/message per message kind, to justify and guard the fast paths
+//
+// Usage: benchmark_decoder [options]
+//   --capture FILE       Frames as read from the socket (4-byte big-endian length + payload, repeated),
+//                        default: synthetic frames in the fake_tws layouts
+//   --server-version N   Server version the frames were written for (default 200)
+//   --passes N           Timed passes over the frames of each kind (default 2000)
+//   --variants N         Synthetic frames per kind (default 64)
+//   --history-bars N     Bars per synthetic HISTORICAL_DATA frame (default 100)
+//   --format F           text | csv (default text)
+//   --min-speedup X      Fail (exit 2) if a fast decoder is less than X times faster than EDecoder
+//   --max-fast-allocs N  Fail (exit 2) if a fast decoder allocates more than N times per message
+
+#include "EWrapper.h"
+#include "EClient.h"  // REASON: After EWrapper.h (EClient.h relies on its <map> include)
+#include "EDecoder.h"
+#include "DefaultEWrapper.h"
+#include "DecimalSize.h"
+#include "TickByTickDecoder.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+using namespace ibapi::client_constants;  // Server message ids (EDecoder.h)
+
+// ========== Allocation Counter ==========
+// REASON: Global operator new replacement counts every heap allocation in the process
+static std::atomic<std::uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// ========== Options ==========
+namespace {
+
+struct Options {
+    std::string capture;
+    int serverVersion = 200;
+    int passes = 2000;
+    int variants = 64;
+    int historyBars = 100;
+    std::string format = "text";
+    double minSpeedup = 0.0;
+    double maxFastAllocs = -1.0;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << '\n';
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--capture") {
+            options.capture = value;
+        } else if (arg == "--server-version") {
+            options.serverVersion = std::atoi(value.c_str());
+        } else if (arg == "--passes") {
+            options.passes = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--variants") {
+            options.variants = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--history-bars") {
+            options.historyBars = std::max(1, std::atoi(value.c_str()));
+        } else if (arg == "--format") {
+            options.format = value;
+        } else if (arg == "--min-speedup") {
+            options.minSpeedup = std::atof(value.c_str());
+        } else if (arg == "--max-fast-allocs") {
+            options.maxFastAllocs = std::atof(value.c_str());
+        } else {
+            std::cerr << "Unknown option " << arg << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+// ========== Frames ==========
+// Kinds reported, in table order - "other" collects captured frames of any remaining message type
+enum class Kind { BidAsk, AllLast, TickByTickOther, TickPrice, TickSize, RealTimeBar, History, Depth, DepthL2, Other };
+constexpr std::size_t kKinds = 10;
+
+const char* kindName(Kind kind) {
+    switch (kind) {
+    case Kind::BidAsk: return "tbt_bidask";
+    case Kind::AllLast: return "tbt_alllast";
+    case Kind::TickByTickOther: return "tbt_other";
+    case Kind::TickPrice: return "tick_price";
+    case Kind::TickSize: return "tick_size";
+    case Kind::RealTimeBar: return "realtime_bar";
+    case Kind::History: return "historical_data";
+    case Kind::Depth: return "depth";
+    case Kind::DepthL2: return "depth_l2";
+    case Kind::Other: return "other";
+    }
+    return "unknown";
+}
+
+// Frame payloads (no length prefix - what EReader hands EDecoder) of one kind, back to back
+struct FrameSet {
+    std::string bytes;
+    std::vector<std::pair<std::size_t, std::size_t>> frames;  // Offset, length into bytes
+
+    void add(std::string_view payload) {
+        frames.emplace_back(bytes.size(), payload.size());
+        bytes.append(payload.data(), payload.size());
+    }
+};
+
+// Same framing as fake_tws MessageWriter, one payload at a time
+class FrameWriter {
+public:
+    FrameWriter(int serverVersion, int msgId) {
+        if (serverVersion >= MIN_SERVER_VER_PROTOBUF) {
+            for (int i = 0; i < 4; ++i) {
+                m_out.push_back(static_cast<char>((static_cast<std::uint32_t>(msgId) >> (24 - 8 * i)) & 0xFF));
+            }
+        } else {
+            field(msgId);
+        }
+    }
+
+    FrameWriter& field(std::string_view value) {
+        m_out.append(value.data(), value.size());
+        m_out.push_back('\0');
+        return *this;
+    }
+    FrameWriter& field(const char* value) { return field(std::string_view(value)); }
+    FrameWriter& field(long long value) { return format("%lld", value); }
+    FrameWriter& field(int value) { return format("%d", value); }
+    FrameWriter& field(double value) { return format("%.10g", value); }
+
+    const std::string& payload() const { return m_out; }
+
+private:
+    template <typename T>
+    FrameWriter& format(const char* spec, T value) {
+        char text[64];
+        const int n = std::snprintf(text, sizeof(text), spec, value);
+        return field(std::string_view(text, static_cast<std::size_t>(n)));
+    }
+
+    std::string m_out;
+};
+
+Kind classify(std::string_view payload, int serverVersion) {
+    int msgId = 0;
+    const char* body = nullptr;
+    const char* end = payload.data() + payload.size();
+    if (!readMessageId(payload.data(), end, serverVersion, msgId, body)) {
+        return Kind::Other;
+    }
+    switch (msgId) {
+    case TICK_BY_TICK: {
+        TickByTickFields fields;
+        if (parseTickByTickFields(body, end, fields, &bidTextToQuantity) != TickByTickParse::Parsed) {
+            return Kind::TickByTickOther;
+        }
+        return fields.tickType == tick_by_tick::kBidAsk    ? Kind::BidAsk
+               : fields.tickType == tick_by_tick::kAllLast ? Kind::AllLast
+                                                           : Kind::TickByTickOther;
+    }
+    case TICK_PRICE: return Kind::TickPrice;
+    case TICK_SIZE: return Kind::TickSize;
+    case REAL_TIME_BARS: return Kind::RealTimeBar;
+    case HISTORICAL_DATA: return Kind::History;
+    case MARKET_DEPTH: return Kind::Depth;
+    case MARKET_DEPTH_L2: return Kind::DepthL2;
+    default: return Kind::Other;
+    }
+}
+
+// PITFALL: A truncated capture ends at the last whole frame - the partial tail is dropped, not decoded
+bool loadCapture(const std::string& path, int serverVersion, std::vector<FrameSet>& sets) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << path << '\n';
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::size_t offset = 0;
+    while (data.size() - offset >= 4) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data.data() + offset);
+        const std::size_t length = (std::size_t{bytes[0]} << 24) | (std::size_t{bytes[1]} << 16)
+                                   | (std::size_t{bytes[2]} << 8) | std::size_t{bytes[3]};
+        if (length == 0 || data.size() - offset - 4 < length) {
+            break;
+        }
+        const std::string_view payload(data.data() + offset + 4, length);
+        sets[static_cast<std::size_t>(classify(payload, serverVersion))].add(payload);
+        offset += 4 + length;
+    }
+    return true;
+}
+
+// Layouts as fake_tws writes them (TICK_PRICE version 6, REAL_TIME_BARS version 3, HISTORICAL_DATA
+// without a version field), depth as EDecoder::processMarketDepth(L2)Msg reads it
+void synthesize(const Options& options, std::vector<FrameSet>& sets) {
+    const int v = options.serverVersion;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> ticks(-500, 500);
+    const long long time = 1760536800;
+    static const char* const kExchanges[] = {"NYSE", "ARCA", "NASDAQ", "IEX", "BATS"};
+    for (int i = 0; i < options.variants; ++i) {
+        const double price = 150.0 + ticks(rng) * 0.01;
+        const int reqId = 1 + i;
+        const int size = 100 * (1 + i % 9);
+        auto add = [&sets](Kind kind, const FrameWriter& writer) {
+            sets[static_cast<std::size_t>(kind)].add(writer.payload());
+        };
+        add(Kind::BidAsk, FrameWriter(v, TICK_BY_TICK).field(reqId).field(3).field(time + i).field(price - 0.01)
+                              .field(price + 0.01).field(size).field(size + 100).field(0));
+        add(Kind::AllLast, FrameWriter(v, TICK_BY_TICK).field(reqId).field(2).field(time + i).field(price)
+                               .field(size).field(0).field(kExchanges[i % 5]).field(i % 4 == 0 ? "T I" : ""));
+        add(Kind::TickPrice, FrameWriter(v, TICK_PRICE).field(6).field(reqId).field(1 + i % 2).field(price)
+                                 .field(size).field(0));
+        add(Kind::TickSize, FrameWriter(v, TICK_SIZE).field(6).field(reqId).field(i % 2 == 0 ? 0 : 3).field(size));
+        add(Kind::RealTimeBar, FrameWriter(v, REAL_TIME_BARS).field(3).field(reqId).field(time + 5LL * i)
+                                   .field(price).field(price + 0.05).field(price - 0.05).field(price)
+                                   .field(1000LL + i).field(price).field(10));
+        add(Kind::Depth, FrameWriter(v, MARKET_DEPTH).field(1).field(reqId).field(i % 10).field(i % 3)
+                             .field(i % 2).field(price).field(size));
+        FrameWriter l2(v, MARKET_DEPTH_L2);
+        l2.field(1).field(reqId).field(i % 10).field(kExchanges[i % 5]).field(i % 3).field(i % 2).field(price)
+            .field(size);
+        if (v >= MIN_SERVER_VER_SMART_DEPTH) {
+            l2.field(1);
+        }
+        add(Kind::DepthL2, l2);
+
+        FrameWriter history(v, HISTORICAL_DATA);
+        history.field(reqId).field(options.historyBars);
+        double close = price;
+        for (int bar = 0; bar < options.historyBars; ++bar) {
+            const double open = close;
+            close = std::max(1.0, close + ticks(rng) * 0.001);
+            history.field(time - 300LL * (options.historyBars - bar)).field(open).field(std::max(open, close) + 0.02)
+                .field(std::min(open, close) - 0.02).field(close).field(1000LL + bar).field((open + close) / 2.0)
+                .field(25);
+        }
+        add(Kind::History, history);
+    }
+}
+
+// ========== Decoders ==========
+// Fast path of BridgeReader::dispatch for the kinds it has one (msg id + fields, no callback)
+// Returns false for kinds EDecoder alone handles
+volatile std::int64_t g_sink = 0;  // REASON: Keeps decoded fields observable so the loops are not elided
+
+bool hasFastDecoder(Kind kind) {
+    return kind == Kind::BidAsk || kind == Kind::AllLast || kind == Kind::TickByTickOther
+           || kind == Kind::TickPrice || kind == Kind::TickSize || kind == Kind::History;
+}
+
+// Same reuse as BridgeReader: one parser + one batch for every HISTORICAL_DATA frame
+BarTimeParser g_barTime;
+HistoricalBarBatch g_bars;
+
+bool fastDecode(const char* begin, const char* end, int serverVersion) {
+    int msgId = 0;
+    const char* body = nullptr;
+    if (!readMessageId(begin, end, serverVersion, msgId, body)) {
+        return false;
+    }
+    if (msgId == tick_by_tick::kMsgId) {
+        TickByTickFields fields;
+        const bool parsed = parseTickByTickFields(body, end, fields, &bidTextToQuantity) == TickByTickParse::Parsed;
+        g_sink = fields.reqId + fields.size + fields.bidSize;
+        return parsed;
+    }
+    if (msgId == tick_by_tick::kHistoricalDataMsgId) {
+        const bool parsed = parseHistoricalDataFields(body, end, serverVersion, g_barTime, g_bars,
+                                                      &bidTextToQuantity) == TickByTickParse::Parsed;
+        g_sink = static_cast<std::int64_t>(g_bars.size()) + (g_bars.size() > 0 ? g_bars.volume.back() : 0);
+        return parsed;
+    }
+    MarketDataTickFields fields;
+    TickByTickParse result = TickByTickParse::OtherMessage;
+    if (msgId == tick_by_tick::kTickPriceMsgId) {
+        result = parseTickPriceFields(body, end, fields, &bidTextToQuantity);
+    } else if (msgId == tick_by_tick::kTickSizeMsgId) {
+        result = parseTickSizeFields(body, end, fields, &bidTextToQuantity);
+    }
+    g_sink = fields.reqId + fields.size;
+    return result == TickByTickParse::Parsed;
+}
+
+struct Measurement {
+    double nsPerMessage = 0.0;
+    double allocsPerMessage = 0.0;
+    std::size_t decoded = 0;  // Frames of one pass the decoder accepted (EDecoder: consumed > 0)
+};
+
+template <typename Decode>
+Measurement measure(const FrameSet& set, int passes, Decode&& decode) {
+    Measurement m;
+    for (const auto& [offset, length] : set.frames) {  // Warm-up pass, also counts accepted frames
+        m.decoded += decode(set.bytes.data() + offset, set.bytes.data() + offset + length) ? 1 : 0;
+    }
+    const std::uint64_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+    const auto start = steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const auto& [offset, length] : set.frames) {
+            decode(set.bytes.data() + offset, set.bytes.data() + offset + length);
+        }
+    }
+    const double elapsed = static_cast<double>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+    const double messages = static_cast<double>(set.frames.size()) * passes;
+    m.nsPerMessage = elapsed / messages;
+    m.allocsPerMessage = static_cast<double>(g_allocations.load(std::memory_order_relaxed) - allocationsBefore) / messages;
+    return m;
+}
+
+// ========== Output ==========
+struct Row {
+    Kind kind;
+    std::size_t frames = 0;
+    double bytesPerFrame = 0.0;
+    Measurement edecoder;
+    bool hasFast = false;
+    Measurement fast;
+};
+
+void printRow(const Row& r, const std::string& format) {
+    const double speedup = r.hasFast && r.fast.nsPerMessage > 0 ? r.edecoder.nsPerMessage / r.fast.nsPerMessage : 0.0;
+    if (format == "csv") {
+        std::cout << kindName(r.kind) << ',' << r.frames << ',' << std::fixed << std::setprecision(1)
+                  << r.bytesPerFrame << ',' << r.edecoder.nsPerMessage << ',' << std::setprecision(3)
+                  << r.edecoder.allocsPerMessage << ',';
+        if (r.hasFast) {
+            std::cout << std::setprecision(1) << r.fast.nsPerMessage << ',' << std::setprecision(3)
+                      << r.fast.allocsPerMessage << ',' << std::setprecision(2) << speedup << '\n';
+        } else {
+            std::cout << ",,\n";
+        }
+        return;
+    }
+    std::cout << std::left << std::setw(16) << kindName(r.kind) << std::right << std::setw(7) << r.frames
+              << std::fixed << std::setprecision(0) << std::setw(8) << r.bytesPerFrame << " B"
+              << " | EDecoder " << std::setprecision(1) << std::setw(9) << r.edecoder.nsPerMessage << " ns "
+              << std::setprecision(2) << std::setw(7) << r.edecoder.allocsPerMessage << " allocs";
+    if (r.hasFast) {
+        std::cout << " | fast " << std::setprecision(1) << std::setw(8) << r.fast.nsPerMessage << " ns "
+                  << std::setprecision(2) << std::setw(6) << r.fast.allocsPerMessage << " allocs | x"
+                  << std::setprecision(1) << speedup;
+        if (r.fast.decoded < r.frames) {
+            std::cout << " (" << r.frames - r.fast.decoded << " fallback)";
+        }
+    } else {
+        std::cout << " | fast -";
+    }
+    std::cout << '\n';
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    std::vector<FrameSet> sets(kKinds);
+    if (!options.capture.empty()) {
+        if (!loadCapture(options.capture, options.serverVersion, sets)) {
+            return 1;
+        }
+    } else {
+        synthesize(options, sets);
+    }
+
+    DefaultEWrapper wrapper;
+    EDecoder decoder(options.serverVersion, &wrapper, nullptr);
+    const int serverVersion = options.serverVersion;
+
+    const bool text = options.format != "csv";
+    if (text) {
+        std::cout << "=== Decoder Benchmark ===\n";
+        std::cout << "Frames: " << (options.capture.empty() ? "synthetic" : options.capture) << " | Server version: "
+                  << serverVersion << " | Passes: " << options.passes << "\n\n";
+    } else {
+        std::cout << "kind,frames,bytes_per_frame,edecoder_ns,edecoder_allocs,fast_ns,fast_allocs,speedup\n";
+    }
+
+    bool failed = false;
+    for (std::size_t k = 0; k < kKinds; ++k) {
+        const FrameSet& set = sets[k];
+        if (set.frames.empty()) {
+            continue;
+        }
+        Row row;
+        row.kind = static_cast<Kind>(k);
+        row.frames = set.frames.size();
+        row.bytesPerFrame = static_cast<double>(set.bytes.size()) / static_cast<double>(set.frames.size());
+        // NOTE: EDecoder copies its fields into std::string members and calls the (no-op) wrapper - the
+        // allocations counted are the ones BridgeReader pays whenever it falls back to it
+        row.edecoder = measure(set, options.passes, [&decoder](const char* begin, const char* end) {
+            const char* ptr = begin;
+            return decoder.parseAndProcessMsg(ptr, end) > 0;
+        });
+        row.hasFast = hasFastDecoder(row.kind);
+        if (row.hasFast) {
+            row.fast = measure(set, options.passes, [serverVersion](const char* begin, const char* end) {
+                return fastDecode(begin, end, serverVersion);
+            });
+            if (options.minSpeedup > 0 && row.edecoder.nsPerMessage < options.minSpeedup * row.fast.nsPerMessage) {
+                failed = true;
+            }
+            if (options.maxFastAllocs >= 0 && row.fast.allocsPerMessage > options.maxFastAllocs) {
+                failed = true;
+            }
+        }
+        printRow(row, options.format);
+    }
+    if (failed) {
+        std::cerr << "FAIL: a fast decoder is below --min-speedup " << options.minSpeedup
+                  << " or above --max-fast-allocs " << options.maxFastAllocs << '\n';
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+// benchmark_depth.cpp - L2 order book replay benchmark
+// OBJECTIVE: O(depth) book updates + top-N snapshots with zero heap allocations per update
+//
+// Usage: benchmark_depth [recording] [passes]
+//   recording: one depth change per line "side operation position price size" (comma or space
+//              separated, '#' comments - e.g. dumped from updateMktDepthL2), synthetic if omitted
+
+#include "OrderBook.h"
+#include "Serialization.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+
+// ========== Allocation Counter ==========
+// REASON: Global operator new replacement counts every heap allocation in the process
+static std::atomic<std::uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+struct DepthChange {
+    int side;
+    int operation;
+    std::size_t position;
+    double price;
+    std::int64_t size;
+};
+
+static bool loadRecording(const std::string& path, std::vector<DepthChange>& out) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        for (char& c : line) {
+            if (c == ',') {
+                c = ' ';
+            }
+        }
+        std::istringstream fields(line);
+        DepthChange change{};
+        if (fields >> change.side >> change.operation >> change.position >> change.price >> change.size) {
+            out.push_back(change);
+        }
+    }
+    return true;
+}
+
+// 10-level book churn: mostly size updates near the top, inserts / deletes keep it valid
+static std::vector<DepthChange> synthesize(std::size_t count) {
+    constexpr std::size_t kRows = 10;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::geometric_distribution<std::size_t> depthBias(0.35);
+    std::size_t levels[2] = {0, 0};
+
+    std::vector<DepthChange> out;
+    out.reserve(count);
+    while (out.size() < count) {
+        const int side = pick(rng) & 1;
+        std::size_t& size = levels[side];
+        const int roll = pick(rng);
+        DepthChange change{};
+        change.side = side;
+        change.size = 100 * (1 + pick(rng));
+        if (size < kRows && (size == 0 || roll < 20)) {
+            change.operation = depth::kInsert;
+            change.position = std::min(depthBias(rng), size);
+            ++size;
+        } else if (roll < 40) {
+            change.operation = depth::kDelete;
+            change.position = std::min(depthBias(rng), size - 1);
+            --size;
+        } else {
+            change.operation = depth::kUpdate;
+            change.position = std::min(depthBias(rng), size - 1);
+        }
+        const double offset = 0.01 * static_cast<double>(change.position + 1);
+        change.price = side == depth::kBid ? 100.0 - offset : 100.0 + offset;
+        out.push_back(change);
+    }
+    return out;
+}
+
+struct Result {
+    double nsPerUpdate;
+    double allocsPerUpdate;
+    std::uint64_t rejected;
+    std::size_t snapshotBytes;  // Last snapshot size (0 = book only)
+};
+
+// snapshotEvery: serialize top-10 after every N updates (0 = book only)
+static Result replay(const std::vector<DepthChange>& changes, int passes, std::size_t snapshotEvery) {
+    OrderBook book;
+    JsonBuffer json;
+    std::uint64_t rejected = 0;
+
+    auto run = [&]() {
+        book.clear();
+        for (std::size_t i = 0; i < changes.size(); ++i) {
+            const DepthChange& c = changes[i];
+            if (!book.apply(c.side, c.position, c.operation, c.price, c.size)) {
+                ++rejected;
+            }
+            if (snapshotEvery != 0 && i % snapshotEvery == 0) {
+                serializeDepthSnapshot("AAPL", book, 10, json);
+            }
+        }
+    };
+
+    run();  // Warm-up: grows the JSON buffer once
+    rejected = 0;
+    std::uint64_t allocsBefore = g_allocations.load();
+    auto start = steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        run();
+    }
+    auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    std::uint64_t allocs = g_allocations.load() - allocsBefore;
+
+    const double updates = static_cast<double>(changes.size()) * passes;
+    return {static_cast<double>(elapsed) / updates, static_cast<double>(allocs) / updates,
+            rejected / static_cast<std::uint64_t>(passes), snapshotEvery != 0 ? json.size() : 0};
+}
+
+static void print(const std::string& label, const Result& result) {
+    std::cout << "  " << std::left << std::setw(26) << label
+              << std::fixed << std::setprecision(1) << result.nsPerUpdate << " ns/update, "
+              << std::setprecision(3) << result.allocsPerUpdate << " allocs/update, "
+              << result.rejected << " rejected, " << result.snapshotBytes << " bytes/snapshot\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== L2 Order Book Replay Benchmark ===\n";
+
+    std::vector<DepthChange> changes;
+    if (argc > 1) {
+        if (!loadRecording(argv[1], changes) || changes.empty()) {
+            std::cerr << "Cannot read depth recording: " << argv[1] << "\n";
+            return 1;
+        }
+        std::cout << "Recording: " << argv[1] << "\n";
+    } else {
+        changes = synthesize(1000000);
+        std::cout << "Recording: synthetic (10 rows per side)\n";
+    }
+    int passes = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (passes < 1) {
+        passes = 1;
+    }
+    std::cout << "Updates: " << changes.size() << " x " << passes << " passes\n\n";
+
+    Result bookOnly = replay(changes, passes, 0);
+    Result batched = replay(changes, passes, 16);
+    Result everyUpdate = replay(changes, passes, 1);
+
+    print("Book only", bookOnly);
+    print("Snapshot per 16 updates", batched);
+    print("Snapshot per update", everyUpdate);
+
+    if (bookOnly.allocsPerUpdate == 0.0 && batched.allocsPerUpdate == 0.0 && everyUpdate.allocsPerUpdate == 0.0) {
+        std::cout << "\n✅ PASSED: Zero heap allocations per depth update\n";
+        return 0;
+    }
+    std::cout << "\n❌ FAILED: " << everyUpdate.allocsPerUpdate << " allocations per update\n";
+    return 1;
+}
@@ -0,0 +1,287 @@
+// benchmark_ingest.cpp - Ingest sink policies side by side: synthetic tick-by-tick feed → BasicTwsClient<Sink>
+// callbacks → sink target, drained by one consumer thread (no aggregation, no Redis)
+// OBJECTIVE: Producer-side cost of each queue / staging / overflow strategy (IngestSink.h) on the same feed
+//
+// Usage: benchmark_ingest [options]
+//   --symbols N        Subscribed symbols (default 100)
+//   --ticks N          Ticks per variant (default 5000000)
+//   --burst N          Ticks per processMessages() cycle, i.e. per sink flush (default 64)
+//   --trades PCT       Share of AllLast ticks in % (default 20, rest BidAsk)
+//   --capacity N       Queue capacity (default 65536)
+//   --journal DIR      Also run JournalTee<BasicIngestStage> with a TickJournal session in DIR
+//   --decimals N       Decimal conversions per path in the DecimalSize.h section, 0 = skip (default 10000000)
+
+#include "CoalescingTable.h"
+#include "DecimalSize.h"
+#include "IngestSink.h"
+#include "InstrumentRegistry.h"
+#include "ShardRouter.h"
+#include "TickByTickDecoder.h"
+#include "TickJournal.h"
+#include "TwsClient.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+
+struct Options {
+    std::size_t symbols = 100;
+    std::uint64_t ticks = 5000000;
+    std::size_t burst = 64;
+    int tradesPercent = 20;
+    std::size_t capacity = 65536;
+    std::string journalDirectory;
+    std::uint64_t decimals = 10000000;
+};
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--symbols") {
+            options.symbols = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--ticks") {
+            options.ticks = std::stoull(value);
+        } else if (flag == "--burst") {
+            options.burst = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--trades") {
+            options.tradesPercent = std::clamp(std::stoi(value), 0, 100);
+        } else if (flag == "--capacity") {
+            options.capacity = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--journal") {
+            options.journalDirectory = value;
+        } else if (flag == "--decimals") {
+            options.decimals = std::stoull(value);
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Feeds options.ticks ticks through a BasicTwsClient<Sink> on this thread (playing msgThread) while
+// `drain` empties the target on a consumer thread
+// drain(): updates taken in one pass (0 = nothing pending)
+template <typename Sink, typename Drain>
+static void runVariant(const char* name, const Options& options, InstrumentRegistry& registry,
+                       typename Sink::Target& target, Drain drain) {
+    BasicTwsClient<Sink> client(target, registry);
+    for (std::size_t i = 0; i < options.symbols; ++i) {
+        // NOTE: Not connected - requests stay in the pacer, only the reqId → slot routing is used
+        client.subscribeTickByTick("SYM" + std::to_string(i), static_cast<int>(i + 1));
+    }
+
+    std::atomic<bool> producing{true};
+    std::uint64_t delivered = 0;
+    std::thread consumer([&]() {
+        while (true) {
+            const bool last = !producing.load(std::memory_order_acquire);
+            const std::size_t count = drain();
+            delivered += count;
+            // REASON: One more pass after the producer stopped - everything flushed before is visible
+            if (count == 0 && last) {
+                break;
+            }
+        }
+    });
+
+    // REASON: Same seed for every variant - identical feed
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> drift(-5, 5);
+    std::vector<double> prices(options.symbols, 100.0);
+    const std::int64_t epochSeconds = duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+    TickByTickFields fields;
+
+    const auto start = steady_clock::now();
+    std::uint64_t generated = 0;
+    while (generated < options.ticks) {
+        const std::uint64_t burstEnd = std::min<std::uint64_t>(options.ticks, generated + options.burst);
+        for (; generated < burstEnd; ++generated) {
+            const std::size_t symbol = static_cast<std::size_t>(generated % options.symbols);
+            double& price = prices[symbol];
+            price = std::max(1.0, price + drift(rng) * 0.01);
+            fields.time = epochSeconds + static_cast<std::int64_t>(generated / 100000);
+            if (percent(rng) < options.tradesPercent) {
+                fields.reqId = static_cast<int>(symbol + 1 + 10000);
+                fields.tickType = tick_by_tick::kAllLast;
+                fields.price = price;
+                fields.size = 100;
+            } else {
+                fields.reqId = static_cast<int>(symbol + 1);
+                fields.tickType = tick_by_tick::kBidAsk;
+                fields.bidPrice = price - 0.01;
+                fields.askPrice = price + 0.01;
+                fields.bidSize = 200;
+                fields.askSize = 300;
+            }
+            client.onTickByTick(fields);
+        }
+        client.processMessages();  // NOTE: Not connected - only the end-of-cycle sink flush
+    }
+    const double seconds = duration<double>(steady_clock::now() - start).count();
+    producing.store(false, std::memory_order_release);
+    consumer.join();
+
+    std::cout << "  " << std::left << std::setw(44) << name << std::right
+              << std::setw(12) << static_cast<std::uint64_t>(generated / seconds) << " ticks/s"
+              << " | " << std::setw(6) << std::setprecision(1) << seconds * 1e9 / generated << " ns/tick"
+              << " | delivered " << std::setw(10) << delivered
+              << " | dropped / coalesced " << std::setw(10) << generated - delivered << "\n";
+}
+
+// ns per conversion of `convert` over values, cycled options.decimals times
+// REASON: The running sum keeps the conversions from being optimized away
+template <typename Value, typename Convert>
+static void runConversion(const char* name, const Options& options, const std::vector<Value>& values,
+                          Convert convert) {
+    double sum = 0.0;
+    const auto start = steady_clock::now();
+    for (std::uint64_t i = 0; i < options.decimals; ++i) {
+        sum += static_cast<double>(convert(values[i % values.size()]));
+    }
+    const double seconds = duration<double>(steady_clock::now() - start).count();
+    std::cout << "  " << std::left << std::setw(44) << name << std::right << std::setw(8) << std::setprecision(1)
+              << seconds * 1e9 / static_cast<double>(options.decimals) << " ns/op | checksum " << std::setprecision(0)
+              << sum << "\n";
+}
+
+// DecimalSize.h fast paths against the libbid calls they replace, on TWS-shaped sizes and prices
+static void runDecimalConversions(const Options& options) {
+    std::vector<std::string> texts;
+    for (int i = 1; i <= 64; ++i) {
+        texts.push_back(std::to_string(i * 100));                        // Whole-share sizes
+        texts.push_back(std::to_string(i) + ".5");                       // Fractional shares
+        texts.push_back(std::to_string(100 + i) + "." + std::to_string(10 + i));  // WAP / position-shaped
+    }
+    std::vector<Decimal> decimals;
+    for (const std::string& text : texts) {
+        decimals.push_back(DecimalFunctions::stringToDecimal(text));
+    }
+
+    std::cout << "Decimal conversions (" << options.decimals << " per path):\n";
+    runConversion("DecimalFunctions::decimalToDouble", options, decimals,
+                  [](Decimal value) { return DecimalFunctions::decimalToDouble(value); });
+    runConversion("tws_bridge::decimalToDouble", options, decimals,
+                  [](Decimal value) { return decimalToDouble(value); });
+    runConversion("llround(DecimalFunctions::decimalToDouble)", options, decimals,
+                  [](Decimal value) { return std::llround(DecimalFunctions::decimalToDouble(value)); });
+    runConversion("decimalToShares", options, decimals, [](Decimal value) { return decimalToShares(value); });
+    runConversion("stringToDecimal (SizeFallback before)", options, texts, [](const std::string& text) {
+        return std::llround(DecimalFunctions::decimalToDouble(DecimalFunctions::stringToDecimal(text)));
+    });
+    runConversion("bidTextToQuantity", options, texts, [](const std::string& text) {
+        std::int64_t units = 0;
+        int scale = 0;
+        bidTextToQuantity(text, units, scale);
+        return units;
+    });
+    std::cout << "\n";
+}
+
+// Takes everything currently in one ring
+static std::size_t drainQueue(SpscTickQueue& queue, TickUpdate* buffer, std::size_t size) {
+    std::size_t total = 0;
+    std::size_t count;
+    while ((count = queue.try_dequeue_bulk(buffer, size)) != 0) {
+        total += count;
+    }
+    return total;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::cout << "=== Ingest Sink Benchmark ===\n";
+    std::cout << "Symbols: " << options.symbols << " | Ticks: " << options.ticks << " | Burst: " << options.burst
+              << " | Trades: " << options.tradesPercent << "% | Capacity: " << options.capacity << "\n\n";
+    std::cout << std::fixed;
+
+    if (options.decimals != 0) {
+        runDecimalConversions(options);
+    }
+
+    InstrumentRegistry registry;
+    constexpr std::size_t kDrainBatch = 256;
+    TickUpdate buffer[kDrainBatch];
+
+    // Production: staged bursts, one bulk enqueue per shard per cycle
+    {
+        IngestConfig ingest;
+        ingest.slotCapacity = registry.capacity();
+        BasicShardRouter<SpscTickQueue> router(1, options.capacity, WaitConfig{}, ingest);
+        runVariant<BasicIngestStage<SpscTickQueue>>(
+            "BasicIngestStage<SpscTickQueue>", options, registry, router,
+            [&]() { return drainQueue(router.shard(0).queue, buffer, kDrainBatch); });
+    }
+
+    // One enqueue per tick, drop when full
+    {
+        SpscTickQueue queue(options.capacity);
+        runVariant<QueueSink<SpscTickQueue>>("QueueSink<SpscTickQueue>", options, registry, queue,
+                                             [&]() { return drainQueue(queue, buffer, kDrainBatch); });
+    }
+
+    // Latest tick per slot in place, nothing else in this feed reaches the queue
+    {
+        SpscTickQueue queue(options.capacity);
+        CoalescingTable table(registry.capacity() * 2);
+        CoalescingSink<QueueSink<SpscTickQueue>>::Target target{table, queue};
+        runVariant<CoalescingSink<QueueSink<SpscTickQueue>>>(
+            "CoalescingSink<QueueSink<SpscTickQueue>>", options, registry, target, [&]() {
+                std::size_t total = drainQueue(queue, buffer, kDrainBatch);
+                std::size_t count;
+                while ((count = table.drain(buffer, kDrainBatch)) != 0) {
+                    total += count;
+                }
+                return total;
+            });
+    }
+
+    // Journal capture in front of the production sink (compile-time counterpart of setJournal)
+    // NOTE: Raw records, then delta + varint + LZ4 blocks (JournalFormat::Compressed) - bytes per tick printed
+    for (JournalFormat format : {JournalFormat::Raw, JournalFormat::Compressed}) {
+        if (options.journalDirectory.empty()) {
+            break;
+        }
+        JournalConfig journalConfig;
+        journalConfig.directory = options.journalDirectory;
+        journalConfig.format = format;
+        TickJournal journal(registry, journalConfig);
+        if (!journal.start()) {
+            return 1;
+        }
+        IngestConfig ingest;
+        ingest.slotCapacity = registry.capacity();
+        BasicShardRouter<SpscTickQueue> router(1, options.capacity, WaitConfig{}, ingest);
+        JournalTee<BasicIngestStage<SpscTickQueue>>::Target target{journal, router};
+        runVariant<JournalTee<BasicIngestStage<SpscTickQueue>>>(
+            format == JournalFormat::Raw ? "JournalTee<BasicIngestStage<SpscTickQueue>> (raw)"
+                                         : "JournalTee<BasicIngestStage<SpscTickQueue>> (compressed)",
+            options, registry, target, [&]() { return drainQueue(router.shard(0).queue, buffer, kDrainBatch); });
+        journal.stop();
+        const std::uint64_t records = journal.counters().records.load();
+        std::cout << "  journal: " << records << " ticks, "
+                  << (records == 0 ? 0.0 : static_cast<double>(journal.counters().bytes.load()) / records)
+                  << " bytes/tick\n";
+    }
+    return 0;
+}
@@ -0,0 +1,471 @@
+// benchmark_pipeline.cpp - Full-pipeline benchmark: synthetic TWS feed → TwsClient → shard queues →
+// RedisWorker (aggregation + serialization) → RedisPublisher → Redis (in-process RESP sink or real server)
+// OBJECTIVE: Sustained throughput + per-stage latency percentiles, usable as a regression gate
+//
+// Usage: benchmark_pipeline [options]
+//   --symbols N        Subscribed symbols (default 100)
+//   --rate N           Generated ticks/s across all symbols, 0 = as fast as possible (default 100000)
+//   --profile P        steady | burst (default steady)
+//   --burst N          Ticks per burst for --profile burst (default 1000, same average rate)
+//   --trades PCT       Share of AllLast ticks in % (default 20, rest BidAsk)
+//   --duration S       Generation time in seconds (default 5)
+//   --shards N         Worker shards (default 1)
+//   --redis URI        Real Redis (e.g. tcp://127.0.0.1:6379), default: in-process sink on loopback
+//   --journal DIR      Also capture every tick to a TickJournal session in DIR (measures its cost)
+//   --max-p99-us N     Fail (exit 2) if end-to-end p99 exceeds N μs
+//   --min-rate N       Fail (exit 2) if the sustained generated rate is below N ticks/s
+
+#include "InstrumentRegistry.h"
+#include "LatencyHistogram.h"
+#include "RedisPublisher.h"
+#include "RedisWorker.h"
+#include "ShardRouter.h"
+#include "TickByTickDecoder.h"
+#include "TickJournal.h"
+#include "TwsClient.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+
+using IngestQueue = SpscTickQueue;  // Same as main.cpp: msgThread is the only producer
+
+// ========== In-process Redis sink ==========
+// REASON: Real network path (redis++ pipelines over loopback) without an external server - replies
+// to every pipelined command, counts them, stores nothing
+class RespSink {
+public:
+    bool start() {
+        m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = 0;
+        ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (m_listenFd < 0 || ::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || ::listen(m_listenFd, 16) != 0) {
+            return false;
+        }
+        socklen_t length = sizeof(address);
+        ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+        m_port = ntohs(address.sin_port);
+        m_running.store(true);
+        m_acceptThread = std::thread([this]() { acceptLoop(); });
+        return true;
+    }
+
+    void stop() {
+        m_running.store(false);
+        if (m_acceptThread.joinable()) {
+            m_acceptThread.join();
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& thread : m_connections) {
+            thread.join();
+        }
+        m_connections.clear();
+        ::close(m_listenFd);
+    }
+
+    std::string uri() const { return "tcp://127.0.0.1:" + std::to_string(m_port); }
+    std::uint64_t commands() const { return m_commands.load(std::memory_order_relaxed); }
+
+private:
+    void acceptLoop() {
+        while (m_running.load()) {
+            pollfd listener{m_listenFd, POLLIN, 0};
+            if (::poll(&listener, 1, 50) <= 0) {
+                continue;
+            }
+            const int client = ::accept(m_listenFd, nullptr, nullptr);
+            if (client >= 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_connections.emplace_back([this, client]() { serve(client); });
+            }
+        }
+    }
+
+    // Parses RESP arrays of bulk strings, one reply per command (pipelines arrive back to back)
+    void serve(int fd) {
+        std::string in;
+        std::string replies;
+        char buffer[65536];
+        while (m_running.load()) {
+            pollfd connection{fd, POLLIN, 0};
+            if (::poll(&connection, 1, 50) <= 0) {
+                continue;
+            }
+            const ssize_t received = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                break;
+            }
+            in.append(buffer, static_cast<std::size_t>(received));
+            std::size_t consumed = 0;
+            std::string command;
+            while (parseCommand(in, consumed, command)) {
+                replies.append(replyFor(command));
+                m_commands.fetch_add(1, std::memory_order_relaxed);
+            }
+            in.erase(0, consumed);
+            if (!replies.empty()) {
+                ::send(fd, replies.data(), replies.size(), MSG_NOSIGNAL);
+                replies.clear();
+            }
+        }
+        ::close(fd);
+    }
+
+    // true + advances `pos` past one complete command, `name` = its first argument (upper case)
+    static bool parseCommand(const std::string& in, std::size_t& pos, std::string& name) {
+        std::size_t cursor = pos;
+        auto readLine = [&in, &cursor](char prefix, long& value) {
+            if (cursor >= in.size() || in[cursor] != prefix) {
+                return false;
+            }
+            const std::size_t end = in.find("\r\n", cursor);
+            if (end == std::string::npos) {
+                return false;
+            }
+            value = std::strtol(in.c_str() + cursor + 1, nullptr, 10);
+            cursor = end + 2;
+            return true;
+        };
+        long count = 0;
+        if (!readLine('*', count)) {
+            return false;
+        }
+        for (long i = 0; i < count; ++i) {
+            long length = 0;
+            if (!readLine('$', length) || cursor + static_cast<std::size_t>(length) + 2 > in.size()) {
+                return false;
+            }
+            if (i == 0) {
+                name.assign(in, cursor, static_cast<std::size_t>(length));
+                std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::toupper(c); });
+            }
+            cursor += static_cast<std::size_t>(length) + 2;
+        }
+        pos = cursor;
+        return true;
+    }
+
+    static const char* replyFor(const std::string& command) {
+        if (command == "PING") {
+            return "+PONG\r\n";
+        }
+        if (command == "PUBLISH" || command == "ZADD" || command == "ZREMRANGEBYSCORE") {
+            return ":0\r\n";
+        }
+        if (command == "XADD") {
+            return "$3\r\n1-0\r\n";
+        }
+        return "+OK\r\n";  // SET, and anything the pool sends on connect
+    }
+
+    int m_listenFd = -1;
+    std::uint16_t m_port = 0;
+    std::atomic<bool> m_running{false};
+    std::atomic<std::uint64_t> m_commands{0};
+    std::thread m_acceptThread;
+    std::mutex m_mutex;
+    std::vector<std::thread> m_connections;
+};
+
+// ========== Options ==========
+struct Options {
+    std::size_t symbols = 100;
+    double rate = 100000.0;
+    bool burst = false;
+    std::size_t burstSize = 1000;
+    int tradesPercent = 20;
+    double duration = 5.0;
+    std::size_t shards = 1;
+    std::string redisUri;
+    std::string journalDirectory;
+    double maxP99Us = 0.0;
+    double minRate = 0.0;
+};
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--symbols") {
+            options.symbols = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--rate") {
+            options.rate = std::stod(value);
+        } else if (flag == "--profile") {
+            options.burst = value == "burst";
+        } else if (flag == "--burst") {
+            options.burstSize = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--trades") {
+            options.tradesPercent = std::clamp(std::stoi(value), 0, 100);
+        } else if (flag == "--duration") {
+            options.duration = std::stod(value);
+        } else if (flag == "--shards") {
+            options.shards = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--redis") {
+            options.redisUri = value;
+        } else if (flag == "--journal") {
+            options.journalDirectory = value;
+        } else if (flag == "--max-p99-us") {
+            options.maxP99Us = std::stod(value);
+        } else if (flag == "--min-rate") {
+            options.minRate = std::stod(value);
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static void printStage(const char* name, const LatencySnapshot& snapshot) {
+    const LatencyReport::Stage stage = LatencyReport::summarize(snapshot);
+    std::cout << "  " << std::left << std::setw(10) << name << std::right
+              << " count " << std::setw(10) << stage.count
+              << " | p50 " << std::setw(9) << stage.p50 / 1000.0 << " μs"
+              << " | p99 " << std::setw(9) << stage.p99 / 1000.0 << " μs"
+              << " | p99.9 " << std::setw(9) << stage.p999 / 1000.0 << " μs"
+              << " | max " << std::setw(9) << stage.max / 1000.0 << " μs\n";
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::cout << "=== Pipeline Benchmark ===\n";
+    std::cout << "Symbols: " << options.symbols << " | Rate: "
+              << (options.rate > 0 ? std::to_string(static_cast<long long>(options.rate)) + " ticks/s" : "max")
+              << " | Profile: " << (options.burst ? "burst x" + std::to_string(options.burstSize) : "steady")
+              << " | Trades: " << options.tradesPercent << "% | Shards: " << options.shards
+              << " | Duration: " << options.duration << " s\n";
+
+    RespSink sink;
+    std::string uri = options.redisUri;
+    if (uri.empty()) {
+        if (!sink.start()) {
+            std::cerr << "Cannot start the in-process Redis sink\n";
+            return 1;
+        }
+        uri = sink.uri();
+    }
+    std::cout << "Redis: " << (options.redisUri.empty() ? "in-process sink " : "") << uri << "\n\n";
+
+    // REASON: Same building blocks and settings as main.cpp, latency stamping on
+    InstrumentRegistry registry;
+    WaitConfig waitConfig;
+    waitConfig.mode = WaitMode::Hybrid;
+    IngestConfig ingestConfig;
+    ingestConfig.mode = IngestMode::Queue;
+    ingestConfig.policy = OverflowPolicy::ConflateLatest;
+    ingestConfig.slotCapacity = registry.capacity();
+    BasicShardRouter<IngestQueue> router(options.shards, 10000, waitConfig, ingestConfig);
+
+    BatchPolicy batchPolicy;
+    batchPolicy.maxMessages = 64;
+    batchPolicy.maxDelay = microseconds(500);
+    IoThreadPolicy ioPolicy;
+    ioPolicy.enabled = true;
+    ioPolicy.maxInFlightBatches = 16;
+    std::vector<std::unique_ptr<RedisPublisher>> publishers;
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        publishers.push_back(std::make_unique<RedisPublisher>(uri, batchPolicy, StreamPolicy{}, ioPolicy));
+        if (!publishers.back()->isConnected()) {
+            std::cerr << "Cannot connect to Redis at " << uri << "\n";
+            return 1;
+        }
+    }
+
+    JournalConfig journalConfig;
+    journalConfig.directory = options.journalDirectory;
+    TickJournal journal(registry, journalConfig);
+    if (!options.journalDirectory.empty() && !journal.start()) {
+        return 1;
+    }
+
+    WorkerConfig workerConfig;
+    workerConfig.latency.enabled = true;
+    workerConfig.latency.interval = seconds(3600);  // NOTE: Lifetime histograms are read at the end instead
+    workerConfig.statsInterval = seconds(3600);
+    std::vector<std::unique_ptr<BasicRedisWorker<IngestQueue>>> workers;
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        workerConfig.shardId = i;
+        workers.push_back(std::make_unique<BasicRedisWorker<IngestQueue>>(router.shard(i), registry, *publishers[i],
+                                                                         workerConfig));
+    }
+    std::atomic<bool> running{true};
+    std::vector<std::thread> workerThreads;
+    for (auto& worker : workers) {
+        auto* w = worker.get();
+        workerThreads.emplace_back([w, &running]() { w->run(running); });
+    }
+
+    ShardedTwsClient<IngestQueue> client(router, registry);
+    client.setLatencyStamps(true);
+    if (journal.running()) {
+        client.setJournal(&journal);
+    }
+    for (std::size_t i = 0; i < options.symbols; ++i) {
+        // NOTE: Not connected - requests stay in the pacer, only the reqId → slot routing is used
+        client.subscribeTickByTick("SYM" + std::to_string(i), static_cast<int>(i + 1));
+    }
+    std::cout << "\n";
+
+    // ========== Synthetic feed (this thread plays msgThread) ==========
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::uniform_int_distribution<int> drift(-5, 5);
+    std::vector<double> prices(options.symbols, 100.0);
+    const std::int64_t epochSeconds = duration_cast<seconds>(system_clock::now().time_since_epoch()).count();
+
+    const auto start = steady_clock::now();
+    const auto end = start + duration_cast<steady_clock::duration>(duration<double>(options.duration));
+    const std::size_t step = options.burst ? options.burstSize : 1;
+    const double stepSeconds = options.rate > 0 ? static_cast<double>(step) / options.rate : 0.0;
+    std::uint64_t generated = 0;
+    std::uint64_t steps = 0;
+    TickByTickFields fields;
+    while (true) {
+        const auto now = steady_clock::now();
+        if (now >= end) {
+            break;
+        }
+        if (options.rate > 0) {
+            // REASON: Absolute schedule - a late step is sent immediately, the average rate holds
+            const auto due = start + duration_cast<steady_clock::duration>(duration<double>(steps * stepSeconds));
+            if (now < due) {
+                continue;
+            }
+        }
+        for (std::size_t i = 0; i < step; ++i) {
+            const std::size_t symbol = static_cast<std::size_t>(generated % options.symbols);
+            double& price = prices[symbol];
+            price = std::max(1.0, price + drift(rng) * 0.01);
+            fields.time = epochSeconds + static_cast<std::int64_t>(generated / 100000);
+            if (percent(rng) < options.tradesPercent) {
+                fields.reqId = static_cast<int>(symbol + 1 + 10000);
+                fields.tickType = tick_by_tick::kAllLast;
+                fields.price = price;
+                fields.size = 100;
+            } else {
+                fields.reqId = static_cast<int>(symbol + 1);
+                fields.tickType = tick_by_tick::kBidAsk;
+                fields.bidPrice = price - 0.01;
+                fields.askPrice = price + 0.01;
+                fields.bidSize = 200;
+                fields.askSize = 300;
+            }
+            client.onTickByTick(fields);
+            ++generated;
+        }
+        ++steps;
+    }
+    const double seconds = duration<double>(steady_clock::now() - start).count();
+
+    // REASON: Let workers drain and the last pipelines complete before reading counters
+    std::this_thread::sleep_for(milliseconds(500));
+    running.store(false);
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        router.shard(i).waiter.notify();  // REASON: Parked workers re-check `running`
+    }
+    for (auto& thread : workerThreads) {
+        thread.join();
+    }
+    journal.stop();
+
+    // ========== Report ==========
+    std::uint64_t published = 0;
+    std::uint64_t suppressed = 0;
+    std::uint64_t ingestDropped = 0;
+    std::uint64_t ingestConflated = 0;
+    std::uint64_t redisSent = 0;
+    std::uint64_t redisDropped = 0;
+    LatencySnapshot totals[kLatencyStageCount];
+    LatencySnapshot snapshot;
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        const WorkerCounters& counters = workers[i]->counters();
+        published += counters.published.load();
+        suppressed += counters.conflated.load() + counters.unchanged.load() + counters.duplicates.load();
+        ingestDropped += router.shard(i).overflow.dropped.load();
+        ingestConflated += router.shard(i).overflow.conflated.load();
+        redisSent += publishers[i]->counters().sent.load();
+        redisDropped += publishers[i]->counters().dropped.load();
+        const LatencyHistogram* histograms[kLatencyStageCount] = {
+            &workers[i]->latency().ingest, &workers[i]->latency().queue, &workers[i]->latency().serialize,
+            &publishers[i]->latency().publish, &publishers[i]->latency().endToEnd};
+        for (std::size_t stage = 0; stage < kLatencyStageCount; ++stage) {
+            histograms[stage]->snapshot(snapshot);
+            for (std::size_t b = 0; b < LatencySnapshot::kBuckets; ++b) {
+                totals[stage].counts[b] += snapshot.counts[b];
+            }
+        }
+    }
+    publishers.clear();  // REASON: Joins the I/O threads before the sink goes away
+
+    const double rate = generated / seconds;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Throughput:\n";
+    std::cout << "  Generated:  " << generated << " ticks (" << rate << " ticks/s)\n";
+    std::cout << "  Published:  " << published << " snapshots (" << published / seconds << "/s), "
+              << suppressed << " conflated/suppressed\n";
+    std::cout << "  Ingest:     " << ingestDropped << " dropped, " << ingestConflated << " conflated\n";
+    std::cout << "  Redis:      " << redisSent << " commands sent, " << redisDropped << " dropped";
+    if (options.redisUri.empty()) {
+        std::cout << " (sink received " << sink.commands() << ")";
+    }
+    if (journal.counters().records.load() != 0) {
+        const JournalCounters& counters = journal.counters();
+        std::cout << "\n  Journal:    " << counters.records.load() << " records, " << counters.bytes.load() / (1 << 20)
+                  << " MiB in " << counters.segments.load() << " segments, " << counters.stalls.load() << " stalls, "
+                  << counters.dropped.load() << " dropped";
+    }
+    std::cout << "\n\nLatency (per stage, LatencyHistogram.h - endToEnd: oldest tick per pipeline):\n";
+    std::cout << std::setprecision(2);
+    for (std::size_t stage = 0; stage < kLatencyStageCount; ++stage) {
+        printStage(latencyStageName(static_cast<LatencyStage>(stage)), totals[stage]);
+    }
+    if (options.redisUri.empty()) {
+        sink.stop();
+    }
+
+    // ========== Regression Gates ==========
+    bool pass = true;
+    const double p99Us = totals[static_cast<std::size_t>(LatencyStage::EndToEnd)].valueAt(99.0) / 1000.0;
+    if (options.maxP99Us > 0 && p99Us > options.maxP99Us) {
+        std::cout << "\nFAIL: end-to-end p99 " << p99Us << " μs > " << options.maxP99Us << " μs\n";
+        pass = false;
+    }
+    if (options.minRate > 0 && rate < options.minRate) {
+        std::cout << "\nFAIL: sustained rate " << rate << " ticks/s < " << options.minRate << " ticks/s\n";
+        pass = false;
+    }
+    if (pass && (options.maxP99Us > 0 || options.minRate > 0)) {
+        std::cout << "\nPASS: regression gates met\n";
+    }
+    return pass ? 0 : 2;
+}
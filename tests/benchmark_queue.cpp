@@ -1,222 +1,491 @@
-// benchmark_queue.cpp - Lock-free queue performance benchmark
-// OBJECTIVE: Validate < 1μs enqueue/dequeue latency (Gate 3b requirement)
+// benchmark_queue.cpp - Ingest queue comparison suite: producer → consumer latency and throughput per
+// queue implementation, operation mode (single / bulk) and arrival pattern (steady / burst), per offered rate
+// OBJECTIVE: Latency-vs-throughput curves (CSV / JSON) for choosing the shard queue (ShardRouter.h)
+//
+// Usage: benchmark_queue [options]
+//   --queues LIST      Comma-separated subset of mpmc, mpmc_token, blocking, spsc, coalescing (default all)
+//   --ops LIST         single, bulk (default both)
+//   --arrival LIST     steady, burst (default both)
+//   --rates LIST       Offered rates in messages/s, 0 = as fast as possible (default 100000,1000000,0)
+//   --messages N       Messages per scenario (default 1000000)
+//   --warmup N         Leading messages left out of the histogram (default 10000)
+//   --bulk N           Elements per bulk enqueue / dequeue (default 64)
+//   --burst N          Messages released at once for --arrival burst (default 256, same average rate)
+//   --capacity N       Queue capacity (default 65536)
+//   --keys N           Distinct slots the producer cycles through - coalescing table size (default 1024)
+//   --cpus P,C         Pin producer / consumer threads (default: not pinned)
+//   --format F         text | csv | json (default text)
+//   --max-p99-us N     Fail (exit 2) if any scenario's p99 exceeds N μs
+//
+// Timing: rdtsc on x86 (calibrated against steady_clock), steady_clock elsewhere; latencies go into
+// the bridge's HDR-style LatencySnapshot (≤ 3% relative error)
+// PITFALL: rdtsc is compared across the two threads - needs an invariant, synchronized TSC (any x86
+// server CPU of the last decade; check constant_tsc / nonstop_tsc in /proc/cpuinfo)
 
+#include "CoalescingTable.h"
+#include "LatencyHistogram.h"
 #include "MarketData.h"
+#include "SpscRing.h"
+#include "ThreadAffinity.h"
+#include <blockingconcurrentqueue.h>
 #include <concurrentqueue.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include <algorithm>
+#include <atomic>
 #include <chrono>
-#include <iostream>
+#include <cstdint>
+#include <cstdlib>
 #include <iomanip>
-#include <vector>
-#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono;
+using namespace tws_bridge;
+
+// ========== Clock ==========
+class TscClock {
+public:
+    TscClock() {
+#if defined(__x86_64__) || defined(__i386__)
+        // REASON: 50 ms calibration keeps the ns-per-tick error far below the histogram's 3% buckets
+        const auto wallStart = steady_clock::now();
+        const std::uint64_t tscStart = __rdtsc();
+        std::this_thread::sleep_for(milliseconds(50));
+        const std::uint64_t tscEnd = __rdtsc();
+        const auto wallEnd = steady_clock::now();
+        m_nsPerTick = static_cast<double>(duration_cast<nanoseconds>(wallEnd - wallStart).count())
+                    / static_cast<double>(tscEnd - tscStart);
+#endif
+    }
+
+    // PERFORMANCE: ~7 ns per read (rdtsc) vs ~20 ns (clock_gettime through the vDSO)
+    static std::int64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return static_cast<std::int64_t>(__rdtsc());
+#else
+        return latencyNowNs();
+#endif
+    }
 
-// PERFORMANCE: High-resolution timestamp measurement
-inline auto now() {
-    return high_resolution_clock::now();
+    std::int64_t toNs(std::int64_t ticks) const { return static_cast<std::int64_t>(static_cast<double>(ticks) * m_nsPerTick); }
+    double nsPerTick() const { return m_nsPerTick; }
+
+private:
+    double m_nsPerTick = 1.0;
+};
+
+// ========== Queue adapters ==========
+// Same three operations for every implementation: push / pushBulk (producer), pop (consumer, up to max)
+enum class QueueKind { Mpmc, MpmcToken, Blocking, Spsc, Coalescing };
+
+inline const char* queueKindName(QueueKind kind) {
+    switch (kind) {
+    case QueueKind::Mpmc:
+        return "mpmc";
+    case QueueKind::MpmcToken:
+        return "mpmc_token";
+    case QueueKind::Blocking:
+        return "blocking";
+    case QueueKind::Spsc:
+        return "spsc";
+    case QueueKind::Coalescing:
+        return "coalescing";
+    }
+    return "";
 }
 
-// PERFORMANCE: Calculate latency statistics
-struct Stats {
-    double min_us;
-    double max_us;
-    double mean_us;
-    double p50_us;
-    double p95_us;
-    double p99_us;
-    
-    void calculate(std::vector<double>& latencies) {
-        if (latencies.empty()) return;
-        
-        std::sort(latencies.begin(), latencies.end());
-        
-        min_us = latencies.front();
-        max_us = latencies.back();
-        
-        double sum = 0;
-        for (auto l : latencies) sum += l;
-        mean_us = sum / latencies.size();
-        
-        p50_us = latencies[latencies.size() * 50 / 100];
-        p95_us = latencies[latencies.size() * 95 / 100];
-        p99_us = latencies[latencies.size() * 99 / 100];
-    }
-    
-    void print(const std::string& label) const {
-        std::cout << "\n" << label << " Latency Statistics:\n";
-        std::cout << "  Min:  " << std::fixed << std::setprecision(3) << min_us << " μs\n";
-        std::cout << "  Mean: " << mean_us << " μs\n";
-        std::cout << "  P50:  " << p50_us << " μs\n";
-        std::cout << "  P95:  " << p95_us << " μs\n";
-        std::cout << "  P99:  " << p99_us << " μs\n";
-        std::cout << "  Max:  " << max_us << " μs\n";
+// moodycamel::ConcurrentQueue, implicit producer (MpmcTickQueue as the router uses it without a handle)
+class MpmcAdapter {
+public:
+    MpmcAdapter(std::size_t capacity, std::size_t /*keys*/) : m_queue(capacity) {}
+    bool push(const TickUpdate& update) { return m_queue.try_enqueue(update); }
+    bool pushBulk(const TickUpdate* updates, std::size_t count) { return m_queue.try_enqueue_bulk(updates, count); }
+    std::size_t pop(TickUpdate* out, std::size_t max) { return m_queue.try_dequeue_bulk(out, max); }
+    std::size_t superseded() const { return 0; }
+
+private:
+    moodycamel::ConcurrentQueue<TickUpdate> m_queue;
+};
+
+// ConcurrentQueue with explicit producer / consumer tokens (ProducerHandle<MpmcTickQueue>)
+class MpmcTokenAdapter {
+public:
+    MpmcTokenAdapter(std::size_t capacity, std::size_t /*keys*/)
+        : m_queue(capacity)
+        , m_producer(m_queue)
+        , m_consumer(m_queue) {}
+    bool push(const TickUpdate& update) { return m_queue.try_enqueue(m_producer, update); }
+    bool pushBulk(const TickUpdate* updates, std::size_t count) {
+        return m_queue.try_enqueue_bulk(m_producer, updates, count);
     }
+    std::size_t pop(TickUpdate* out, std::size_t max) { return m_queue.try_dequeue_bulk(m_consumer, out, max); }
+    std::size_t superseded() const { return 0; }
+
+private:
+    moodycamel::ConcurrentQueue<TickUpdate> m_queue;
+    moodycamel::ProducerToken m_producer;
+    moodycamel::ConsumerToken m_consumer;
 };
 
-// REASON: Single-threaded enqueue benchmark (producer-only)
-void benchmarkEnqueue(int iterations) {
-    std::cout << "\n=== Single-Threaded Enqueue Benchmark ===\n";
-    std::cout << "Iterations: " << iterations << "\n";
-    
-    moodycamel::ConcurrentQueue<TickUpdate> queue(iterations);
-    std::vector<double> latencies;
-    latencies.reserve(iterations);
-    
-    // Warm-up: 1000 iterations
-    TickUpdate warmup;
-    for (int i = 0; i < 1000; ++i) {
-        queue.try_enqueue(warmup);
-    }
-    
-    // Benchmark
-    for (int i = 0; i < iterations; ++i) {
-        TickUpdate update;
-        update.tickerId = i;
-        update.type = TickUpdateType::BidAsk;
-        update.timestamp = i * 1000;
-        update.bidPrice = 100.0 + i * 0.01;
-        update.askPrice = 100.05 + i * 0.01;
-        update.bidSize = 100;
-        update.askSize = 100;
-        
-        auto start = now();
-        queue.try_enqueue(update);
-        auto end = now();
-        
-        double latency_us = duration_cast<nanoseconds>(end - start).count() / 1000.0;
-        latencies.push_back(latency_us);
-    }
-    
-    Stats stats;
-    stats.calculate(latencies);
-    stats.print("Enqueue");
-    
-    // Gate 3b validation
-    if (stats.p50_us < 1.0) {
-        std::cout << "\n✅ GATE 3b PASSED: Enqueue latency < 1μs (p50 = " 
-                  << stats.p50_us << " μs)\n";
-    } else {
-        std::cout << "\n❌ GATE 3b FAILED: Enqueue latency >= 1μs (p50 = " 
-                  << stats.p50_us << " μs)\n";
+// BlockingConcurrentQueue - the consumer sleeps on the semaphore instead of spinning
+class BlockingAdapter {
+public:
+    BlockingAdapter(std::size_t capacity, std::size_t /*keys*/) : m_queue(capacity) {}
+    bool push(const TickUpdate& update) { return m_queue.try_enqueue(update); }
+    bool pushBulk(const TickUpdate* updates, std::size_t count) { return m_queue.try_enqueue_bulk(updates, count); }
+    std::size_t pop(TickUpdate* out, std::size_t max) {
+        return m_queue.wait_dequeue_bulk_timed(out, max, std::int64_t{1000});  // 1 ms: end-of-run check
     }
+    std::size_t superseded() const { return 0; }
+
+private:
+    moodycamel::BlockingConcurrentQueue<TickUpdate> m_queue;
+};
+
+// SpscRing (SpscTickQueue, the router's default)
+class SpscAdapter {
+public:
+    SpscAdapter(std::size_t capacity, std::size_t /*keys*/) : m_queue(capacity) {}
+    bool push(const TickUpdate& update) { return m_queue.try_enqueue(update); }
+    bool pushBulk(const TickUpdate* updates, std::size_t count) { return m_queue.try_enqueue_bulk(updates, count); }
+    std::size_t pop(TickUpdate* out, std::size_t max) { return m_queue.try_dequeue_bulk(out, max); }
+    std::size_t superseded() const { return 0; }
+
+private:
+    SpscRing<TickUpdate> m_queue;
+};
+
+// CoalescingTable keyed by slot - never full, a write over an undrained entry supersedes it
+class CoalescingAdapter {
+public:
+    CoalescingAdapter(std::size_t /*capacity*/, std::size_t keys) : m_table(keys) {}
+    bool push(const TickUpdate& update) {
+        m_superseded += m_table.write(update.slot % m_table.keys(), update) ? 1 : 0;
+        return true;
+    }
+    bool pushBulk(const TickUpdate* updates, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            push(updates[i]);
+        }
+        return true;
+    }
+    std::size_t pop(TickUpdate* out, std::size_t max) { return m_table.drain(out, max); }
+    std::size_t superseded() const { return m_superseded; }  // NOTE: Read after the producer joined
+
+private:
+    CoalescingTable m_table;
+    std::size_t m_superseded = 0;
+};
+
+// ========== Options ==========
+struct Options {
+    std::vector<QueueKind> queues{QueueKind::Mpmc, QueueKind::MpmcToken, QueueKind::Blocking, QueueKind::Spsc,
+                                  QueueKind::Coalescing};
+    std::vector<bool> bulk{false, true};
+    std::vector<bool> burst{false, true};
+    std::vector<double> rates{100000.0, 1000000.0, 0.0};
+    std::size_t messages = 1000000;
+    std::size_t warmup = 10000;
+    std::size_t bulkSize = 64;
+    std::size_t burstSize = 256;
+    std::size_t capacity = 65536;
+    std::size_t keys = 1024;
+    int producerCpu = -1;
+    int consumerCpu = -1;
+    std::string format = "text";
+    double maxP99Us = 0.0;
+};
+
+static std::vector<std::string> splitList(const std::string& value) {
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
 }
 
-// REASON: Single-threaded dequeue benchmark (consumer-only)
-void benchmarkDequeue(int iterations) {
-    std::cout << "\n=== Single-Threaded Dequeue Benchmark ===\n";
-    std::cout << "Iterations: " << iterations << "\n";
-    
-    moodycamel::ConcurrentQueue<TickUpdate> queue(iterations);
-    std::vector<double> latencies;
-    latencies.reserve(iterations);
-    
-    // Pre-populate queue
-    for (int i = 0; i < iterations; ++i) {
-        TickUpdate update;
-        update.tickerId = i;
-        update.type = TickUpdateType::BidAsk;
-        update.timestamp = i * 1000;
-        update.bidPrice = 100.0 + i * 0.01;
-        update.askPrice = 100.05 + i * 0.01;
-        queue.try_enqueue(update);
-    }
-    
-    // Benchmark
-    TickUpdate update;
-    for (int i = 0; i < iterations; ++i) {
-        auto start = now();
-        queue.try_dequeue(update);
-        auto end = now();
-        
-        double latency_us = duration_cast<nanoseconds>(end - start).count() / 1000.0;
-        latencies.push_back(latency_us);
-    }
-    
-    Stats stats;
-    stats.calculate(latencies);
-    stats.print("Dequeue");
-    
-    // Gate 3b validation
-    if (stats.p50_us < 1.0) {
-        std::cout << "\n✅ GATE 3b PASSED: Dequeue latency < 1μs (p50 = " 
-                  << stats.p50_us << " μs)\n";
-    } else {
-        std::cout << "\n❌ GATE 3b FAILED: Dequeue latency >= 1μs (p50 = " 
-                  << stats.p50_us << " μs)\n";
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--queues") {
+            options.queues.clear();
+            for (const std::string& name : splitList(value)) {
+                bool known = false;
+                for (QueueKind kind : {QueueKind::Mpmc, QueueKind::MpmcToken, QueueKind::Blocking, QueueKind::Spsc,
+                                       QueueKind::Coalescing}) {
+                    if (name == queueKindName(kind)) {
+                        options.queues.push_back(kind);
+                        known = true;
+                    }
+                }
+                if (!known) {
+                    std::cerr << "Unknown queue " << name << "\n";
+                    return false;
+                }
+            }
+        } else if (flag == "--ops") {
+            options.bulk.clear();
+            for (const std::string& name : splitList(value)) {
+                options.bulk.push_back(name == "bulk");
+            }
+        } else if (flag == "--arrival") {
+            options.burst.clear();
+            for (const std::string& name : splitList(value)) {
+                options.burst.push_back(name == "burst");
+            }
+        } else if (flag == "--rates") {
+            options.rates.clear();
+            for (const std::string& rate : splitList(value)) {
+                options.rates.push_back(std::stod(rate));
+            }
+        } else if (flag == "--messages") {
+            options.messages = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--warmup") {
+            options.warmup = std::stoul(value);
+        } else if (flag == "--bulk") {
+            options.bulkSize = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--burst") {
+            options.burstSize = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--capacity") {
+            options.capacity = std::max<std::size_t>(2, std::stoul(value));
+        } else if (flag == "--keys") {
+            options.keys = std::clamp<std::size_t>(std::stoul(value), 1, 65535);
+        } else if (flag == "--cpus") {
+            const std::vector<std::string> cpus = splitList(value);
+            options.producerCpu = cpus.size() > 0 ? std::stoi(cpus[0]) : -1;
+            options.consumerCpu = cpus.size() > 1 ? std::stoi(cpus[1]) : -1;
+        } else if (flag == "--format") {
+            options.format = value;
+        } else if (flag == "--max-p99-us") {
+            options.maxP99Us = std::stod(value);
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
     }
+    return true;
 }
 
-// REASON: Producer-consumer benchmark (realistic workload)
-void benchmarkProducerConsumer(int iterations) {
-    std::cout << "\n=== Producer-Consumer Benchmark ===\n";
-    std::cout << "Iterations: " << iterations << "\n";
-    
-    moodycamel::ConcurrentQueue<TickUpdate> queue(iterations);
-    std::atomic<int> enqueued{0};
-    std::atomic<int> dequeued{0};
-    std::vector<double> latencies;
-    
-    // Use mutex for latencies vector to avoid concurrent modification
-    std::mutex latencies_mutex;
-    
-    // Producer thread: enqueue with timestamps
-    std::thread producer([&]() {
-        for (int i = 0; i < iterations; ++i) {
-            TickUpdate update;
-            update.tickerId = i;
-            update.type = TickUpdateType::BidAsk;
-            update.timestamp = duration_cast<nanoseconds>(now().time_since_epoch()).count();
-            update.bidPrice = 100.0 + i * 0.01;
-            update.askPrice = 100.05 + i * 0.01;
-            
-            queue.enqueue(update);
-            enqueued.fetch_add(1, std::memory_order_release);
+// ========== Scenario ==========
+struct Scenario {
+    QueueKind queue;
+    bool bulk;
+    bool burst;
+    double rate;                                    // Offered messages/s, 0 = producer runs flat out
+};
+
+struct Result {
+    Scenario scenario;
+    std::uint64_t produced = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t superseded = 0;                   // Coalescing: overwritten before the consumer saw them
+    std::uint64_t fullRetries = 0;                  // Producer found the queue full and retried
+    double seconds = 0.0;
+    LatencyReport::Stage latency;                   // Push → pop, ns
+};
+
+// Producer: messages released by the arrival schedule, stamped just before the push
+// Consumer: pops up to 1 (single) or bulkSize (bulk), records pop time - stamp
+template <typename Adapter>
+Result runScenario(const Scenario& scenario, const Options& options, const TscClock& clock) {
+    Adapter queue(options.capacity, options.keys);
+    std::atomic<bool> producerDone{false};
+    Result result;
+    result.scenario = scenario;
+    LatencySnapshot histogram;
+
+    const std::size_t group = scenario.burst ? options.burstSize : 1;  // Messages available at once
+    const std::size_t chunk = scenario.bulk ? options.bulkSize : 1;    // Elements per queue operation
+    const double groupSeconds = scenario.rate > 0 ? static_cast<double>(group) / scenario.rate : 0.0;
+
+    std::thread consumer([&]() {
+        pinCurrentThread(options.consumerCpu);
+        std::vector<TickUpdate> buffer(chunk);
+        for (;;) {
+            std::size_t count = queue.pop(buffer.data(), chunk);
+            if (count == 0) {
+                // REASON: Re-check after the flag - the producer's last push may land between the two
+                if (!producerDone.load(std::memory_order_acquire)) {
+                    continue;
+                }
+                count = queue.pop(buffer.data(), chunk);
+                if (count == 0) {
+                    break;
+                }
+            }
+            const std::int64_t now = TscClock::ticks();
+            for (std::size_t i = 0; i < count; ++i) {
+                if (buffer[i].aux >= options.warmup) {
+                    ++histogram.counts[LatencySnapshot::bucketOf(clock.toNs(now - buffer[i].timestamp))];
+                }
+            }
+            result.delivered += count;
         }
     });
-    
-    // Consumer thread: dequeue and measure end-to-end latency
-    std::thread consumer([&]() {
-        TickUpdate update;
-        
-        while (dequeued.load(std::memory_order_acquire) < iterations) {
-            if (queue.try_dequeue(update)) {
-                auto now_ns = duration_cast<nanoseconds>(now().time_since_epoch()).count();
-                double latency_us = (now_ns - update.timestamp) / 1000.0;
-                
-                std::lock_guard<std::mutex> lock(latencies_mutex);
-                latencies.push_back(latency_us);
-                dequeued.fetch_add(1, std::memory_order_release);
-            } else {
-                // Brief sleep to avoid busy-wait
-                std::this_thread::sleep_for(std::chrono::microseconds(1));
+
+    std::thread producer([&]() {
+        pinCurrentThread(options.producerCpu);
+        std::vector<TickUpdate> updates(group);
+        const auto start = steady_clock::now();
+        std::uint64_t groups = 0;
+        for (std::size_t sent = 0; sent < options.messages; ++groups) {
+            if (scenario.rate > 0) {
+                // REASON: Absolute schedule - a late group goes out at once, the average rate holds
+                const auto due = start + duration_cast<steady_clock::duration>(
+                                             duration<double>(static_cast<double>(groups) * groupSeconds));
+                while (steady_clock::now() < due) {
+                }
+            }
+            const std::size_t count = std::min(group, options.messages - sent);
+            for (std::size_t i = 0; i < count; ++i) {
+                TickUpdate& update = updates[i];
+                update.slot = static_cast<std::uint16_t>((sent + i) % options.keys);
+                update.type = TickUpdateType::BidAsk;
+                update.aux = static_cast<std::uint32_t>(sent + i);
+                update.bidAsk.bidPrice = 100.0;
+                update.bidAsk.askPrice = 100.01;
+                update.bidAsk.bidSize = 100;
+                update.bidAsk.askSize = 100;
             }
+            for (std::size_t offset = 0; offset < count; offset += chunk) {
+                const std::size_t n = std::min(chunk, count - offset);
+                TickUpdate* first = updates.data() + offset;
+                const std::int64_t stamp = TscClock::ticks();
+                for (std::size_t i = 0; i < n; ++i) {
+                    first[i].timestamp = stamp;
+                }
+                while (!(n == 1 ? queue.push(*first) : queue.pushBulk(first, n))) {
+                    ++result.fullRetries;
+                }
+            }
+            sent += count;
         }
+        producerDone.store(true, std::memory_order_release);
     });
-    
+
+    const auto start = steady_clock::now();
     producer.join();
     consumer.join();
-    
-    Stats stats;
-    stats.calculate(latencies);
-    stats.print("End-to-End (Producer → Consumer)");
+    result.seconds = duration<double>(steady_clock::now() - start).count();
+    result.produced = options.messages;
+    result.superseded = queue.superseded();
+    result.latency = LatencyReport::summarize(histogram);
+    return result;
+}
+
+static Result run(const Scenario& scenario, const Options& options, const TscClock& clock) {
+    switch (scenario.queue) {
+    case QueueKind::Mpmc:
+        return runScenario<MpmcAdapter>(scenario, options, clock);
+    case QueueKind::MpmcToken:
+        return runScenario<MpmcTokenAdapter>(scenario, options, clock);
+    case QueueKind::Blocking:
+        return runScenario<BlockingAdapter>(scenario, options, clock);
+    case QueueKind::Spsc:
+        return runScenario<SpscAdapter>(scenario, options, clock);
+    case QueueKind::Coalescing:
+        return runScenario<CoalescingAdapter>(scenario, options, clock);
+    }
+    return Result{};
+}
+
+// ========== Output ==========
+static const char* kColumns = "queue,ops,arrival,offered_rate,produced,delivered,superseded,full_retries,seconds,"
+                              "throughput,p50_ns,p99_ns,p999_ns,max_ns";
+
+static void printRow(const Result& r, const std::string& format, bool first) {
+    const Scenario& s = r.scenario;
+    const double throughput = r.seconds > 0 ? static_cast<double>(r.delivered) / r.seconds : 0.0;
+    if (format == "csv") {
+        std::cout << queueKindName(s.queue) << ',' << (s.bulk ? "bulk" : "single") << ','
+                  << (s.burst ? "burst" : "steady") << ',' << static_cast<long long>(s.rate) << ',' << r.produced
+                  << ',' << r.delivered << ',' << r.superseded << ',' << r.fullRetries << ',' << std::fixed
+                  << std::setprecision(4) << r.seconds << ',' << std::setprecision(0) << throughput << ','
+                  << r.latency.p50 << ',' << r.latency.p99 << ',' << r.latency.p999 << ',' << r.latency.max << '\n';
+    } else if (format == "json") {
+        std::cout << (first ? "  " : ",\n  ") << "{\"queue\":\"" << queueKindName(s.queue) << "\",\"ops\":\""
+                  << (s.bulk ? "bulk" : "single") << "\",\"arrival\":\"" << (s.burst ? "burst" : "steady")
+                  << "\",\"offered_rate\":" << static_cast<long long>(s.rate) << ",\"produced\":" << r.produced
+                  << ",\"delivered\":" << r.delivered << ",\"superseded\":" << r.superseded
+                  << ",\"full_retries\":" << r.fullRetries << ",\"seconds\":" << std::fixed << std::setprecision(4)
+                  << r.seconds << ",\"throughput\":" << std::setprecision(0) << throughput << ",\"p50_ns\":"
+                  << r.latency.p50 << ",\"p99_ns\":" << r.latency.p99 << ",\"p999_ns\":" << r.latency.p999
+                  << ",\"max_ns\":" << r.latency.max << "}";
+    } else {
+        std::cout << std::left << std::setw(11) << queueKindName(s.queue) << std::setw(7)
+                  << (s.bulk ? "bulk" : "single") << std::setw(7) << (s.burst ? "burst" : "steady") << std::right
+                  << std::setw(9) << (s.rate > 0 ? std::to_string(static_cast<long long>(s.rate)) : "max")
+                  << std::setw(11) << static_cast<long long>(throughput) << "/s"
+                  << " | p50 " << std::setw(8) << r.latency.p50 << " ns"
+                  << " | p99 " << std::setw(8) << r.latency.p99 << " ns"
+                  << " | p99.9 " << std::setw(9) << r.latency.p999 << " ns"
+                  << " | max " << std::setw(10) << r.latency.max << " ns";
+        if (r.superseded > 0) {
+            std::cout << " | superseded " << r.superseded;
+        }
+        if (r.fullRetries > 0) {
+            std::cout << " | full " << r.fullRetries;
+        }
+        std::cout << '\n';
+    }
 }
 
 int main(int argc, char* argv[]) {
-    std::cout << "=== Lock-Free Queue Performance Benchmark ===\n";
-    std::cout << "Target: < 1μs enqueue/dequeue latency (Gate 3b)\n";
-    
-    int iterations = 100000;  // 100K iterations for statistical significance
-    
-    if (argc > 1) {
-        iterations = std::atoi(argv[1]);
-    }
-    
-    benchmarkEnqueue(iterations);
-    benchmarkDequeue(iterations);
-    benchmarkProducerConsumer(iterations);
-    
-    std::cout << "\n=== Benchmark Complete ===\n";
-    
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    const TscClock clock;
+    const bool text = options.format != "csv" && options.format != "json";
+    if (text) {
+        std::cout << "=== Queue Comparison ===\n";
+        std::cout << "Messages: " << options.messages << " (warm-up " << options.warmup << ") | Bulk: "
+                  << options.bulkSize << " | Burst: " << options.burstSize << " | Capacity: " << options.capacity
+                  << " | Keys: " << options.keys << " | sizeof(TickUpdate): " << sizeof(TickUpdate) << " B"
+                  << " | " << std::setprecision(4) << clock.nsPerTick() << " ns/tick\n\n";
+    } else if (options.format == "csv") {
+        std::cout << kColumns << '\n';
+    } else {
+        std::cout << "[\n";
+    }
+
+    bool failed = false;
+    bool first = true;
+    for (QueueKind queue : options.queues) {
+        for (bool bulk : options.bulk) {
+            for (bool burst : options.burst) {
+                for (double rate : options.rates) {
+                    const Result result = run(Scenario{queue, bulk, burst, rate}, options, clock);
+                    printRow(result, options.format, first);
+                    first = false;
+                    if (options.maxP99Us > 0 && result.latency.p99 / 1000.0 > options.maxP99Us) {
+                        failed = true;
+                    }
+                }
+            }
+        }
+    }
+    if (options.format == "json") {
+        std::cout << "\n]\n";
+    }
+    if (failed) {
+        std::cerr << "FAIL: p99 above " << options.maxP99Us << " μs in at least one scenario\n";
+        return 2;
+    }
     return 0;
 }
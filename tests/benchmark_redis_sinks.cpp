@@ -0,0 +1,331 @@
+// benchmark_redis_sinks.cpp - Redis output mode matrix: one synthetic snapshot workload sent to a real Redis
+// through RedisPublisher in each output mode the bridge offers
+// OBJECTIVE: msgs/s, per-message latency percentiles and Redis server CPU per mode - the numbers behind a
+// deployment's redis.* / worker.* output settings
+//
+// Usage: benchmark_redis_sinks --redis URI [options]
+//   --redis URI        Real Redis, required (server CPU comes from its INFO cpu)
+//   --modes LIST       Comma-separated subset of publish, pipeline, aggregate, stream, lvc_hash, fanout,
+//                      function, direct, io_uring (default all)
+//   --depths LIST      Snapshots per round trip for pipeline (default 1,16,64,256)
+//   --batch N          Snapshots per round trip for the other batched modes (default 64)
+//   --messages N       Snapshots per mode (default 200000)
+//   --symbols N        Distinct instruments the snapshots cycle through (default 100)
+//   --format F         text | csv (default text)
+//
+// Modes (what each round trip carries, N = depth / batch):
+//   publish    1 PUBLISH, not pipelined (RedisPublisher::publish)
+//   pipeline   N PUBLISH TWS:TICKS:{SYMBOL} (redis++ pipeline, one per depth)
+//   aggregate  1 PUBLISH TWS:ALL:TICKS of an N-snapshot array (worker.aggregate)
+//   stream     N XADD TWS:STREAM:{SYMBOL} MAXLEN ~ 10000
+//   lvc_hash   N HSET TWS:LVC:{SYMBOL} bid / ask / last (worker.last_value_format: hash)
+//   fanout     N x (PUBLISH + XADD + SET) of one stored payload - the worker's full output per snapshot
+//   function   fanout as FCALL tws_publish (redis.function_batches, Redis 7+)
+//   direct     N PUBLISH over the direct RESP socket (redis.direct_resp)
+//   io_uring   direct with redis.resp_backend: io_uring (Linux 5.6+)
+//
+// Latency: buffered → round trip completed, per snapshot (a batch's first snapshot waits for the rest)
+// Server CPU: used_cpu_sys + used_cpu_user delta over the mode, as % of one core and μs per snapshot
+// PITFALL: The modes write real keys (TWS:BENCH:*) - point it at a scratch instance or database
+// NOTE: The I/O-thread mode is left out - flush() returns before the round trip, so there is no completion
+// to time per snapshot; its throughput equals pipeline at the same depth
+
+#include "LatencyHistogram.h"
+#include "RedisPublisher.h"
+#include "SnapshotEncoder.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+
+struct Options {
+    std::string redisUri;
+    std::vector<std::string> modes{"publish", "pipeline", "aggregate", "stream", "lvc_hash", "fanout", "function",
+                                   "direct", "io_uring"};
+    std::vector<std::size_t> depths{1, 16, 64, 256};
+    std::size_t batch = 64;
+    std::size_t messages = 200000;
+    std::size_t symbols = 100;
+    std::string format = "text";
+};
+
+static std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> out;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            out.push_back(item);
+        }
+    }
+    return out;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--redis") {
+            options.redisUri = value;
+        } else if (flag == "--modes") {
+            options.modes = split(value);
+        } else if (flag == "--depths") {
+            options.depths.clear();
+            for (const std::string& depth : split(value)) {
+                options.depths.push_back(std::max<std::size_t>(1, std::stoul(depth)));
+            }
+        } else if (flag == "--batch") {
+            options.batch = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--messages") {
+            options.messages = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--symbols") {
+            options.symbols = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--format") {
+            options.format = value;
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    if (options.redisUri.empty()) {
+        std::cerr << "--redis is required (tcp://host:port)\n";
+        return false;
+    }
+    return true;
+}
+
+// ========== Workload ==========
+// REASON: Encoded once up front - every mode sends the same bytes, the matrix compares Redis paths only
+struct Workload {
+    std::vector<std::string> channels;             // TWS:BENCH:TICKS:{SYMBOL}
+    std::vector<std::string> streams;              // TWS:BENCH:STREAM:{SYMBOL}
+    std::vector<std::string> lastValues;           // TWS:BENCH:LVC:{SYMBOL}
+    std::vector<std::string> snapshots;            // JSON, symbols x kVariants
+    std::vector<std::string> hashes;               // "bid\n...\nask\n...\nlast\n..." (HSET fields)
+
+    static constexpr std::size_t kVariants = 16;
+
+    explicit Workload(std::size_t symbols) {
+        char buffer[256];
+        for (std::size_t s = 0; s < symbols; ++s) {
+            const std::string symbol = "SYM" + std::to_string(s);
+            channels.push_back("TWS:BENCH:TICKS:" + symbol);
+            streams.push_back("TWS:BENCH:STREAM:" + symbol);
+            lastValues.push_back("TWS:BENCH:LVC:" + symbol);
+            for (std::size_t v = 0; v < kVariants; ++v) {
+                const double bid = 100.0 + static_cast<double>(s % 50) + static_cast<double>(v) * 0.01;
+                std::snprintf(buffer, sizeof(buffer),
+                              "{\"instrument\":\"%s\",\"timestamp\":%lld,\"bid\":%.2f,\"ask\":%.2f,\"last\":%.2f,"
+                              "\"bidSize\":%zu,\"askSize\":%zu,\"lastSize\":%zu}",
+                              symbol.c_str(), 1700000000000LL + static_cast<long long>(v), bid, bid + 0.01,
+                              bid + 0.005, 100 + v, 200 + v, 10 + v);
+                snapshots.emplace_back(buffer);
+                std::snprintf(buffer, sizeof(buffer), "bid\n%.2f\nask\n%.2f\nlast\n%.2f", bid, bid + 0.01, bid + 0.005);
+                hashes.emplace_back(buffer);
+            }
+        }
+    }
+
+    std::size_t symbol(std::size_t i) const { return i % channels.size(); }
+    std::size_t variant(std::size_t i) const { return symbol(i) * kVariants + (i / channels.size()) % kVariants; }
+};
+
+// ========== Server CPU ==========
+// used_cpu_sys + used_cpu_user of INFO cpu, seconds (-1 if unreadable)
+static double serverCpuSeconds(sw::redis::Redis& redis) {
+    const std::string info = redis.info("cpu");
+    double total = 0.0;
+    bool found = false;
+    for (const char* key : {"used_cpu_sys:", "used_cpu_user:"}) {
+        const std::size_t at = info.find(key);
+        if (at != std::string::npos) {
+            total += std::strtod(info.c_str() + at + std::char_traits<char>::length(key), nullptr);
+            found = true;
+        }
+    }
+    return found ? total : -1.0;
+}
+
+// ========== Modes ==========
+struct Scenario {
+    std::string mode;
+    std::size_t depth = 1;                         // Snapshots per round trip
+};
+
+struct Result {
+    Scenario scenario;
+    std::size_t messages = 0;
+    double seconds = 0.0;
+    double cpuSeconds = -1.0;
+    std::uint64_t failed = 0;                      // RedisPublisher errors (failed round trips)
+    LatencySnapshot latency;
+};
+
+static RedisConnectionPolicy connectionFor(const std::string& mode) {
+    RedisConnectionPolicy connection;
+    connection.functionBatches = mode == "function";
+    connection.directResp = mode == "direct" || mode == "io_uring";
+    connection.respBackend = mode == "io_uring" ? RespBackend::IoUring : RespBackend::Socket;
+    return connection;
+}
+
+static Result run(const Scenario& scenario, const Options& options, const Workload& work, sw::redis::Redis& admin) {
+    Result result;
+    result.scenario = scenario;
+    BatchPolicy policy;
+    // REASON: flush() is called explicitly per round trip - the size limit must never cut a batch first
+    policy.maxMessages = scenario.depth * 4 + 1;
+    policy.maxDelay = seconds(60);
+    StreamPolicy streamPolicy;
+    RedisPublisher publisher(options.redisUri, policy, streamPolicy, IoThreadPolicy{}, OutagePolicy{},
+                             connectionFor(scenario.mode));
+    const std::string& mode = scenario.mode;
+    const std::string aggregateChannel = "TWS:BENCH:ALL:TICKS";
+    SnapshotArray array;
+    LatencyHistogram histogram;
+    std::vector<steady_clock::time_point> buffered(scenario.depth);
+
+    const double cpuBefore = serverCpuSeconds(admin);
+    const auto start = steady_clock::now();
+    std::size_t sent = 0;
+    while (sent < options.messages) {
+        const std::size_t count = std::min(scenario.depth, options.messages - sent);
+        if (mode == "publish") {
+            const std::size_t i = sent;
+            const auto begin = steady_clock::now();
+            publisher.publish(work.channels[work.symbol(i)], work.snapshots[work.variant(i)]);
+            histogram.record(duration_cast<nanoseconds>(steady_clock::now() - begin).count());
+            ++sent;
+            continue;
+        }
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t i = sent + k;
+            const std::string& snapshot = work.snapshots[work.variant(i)];
+            const std::size_t symbol = work.symbol(i);
+            buffered[k] = steady_clock::now();
+            if (mode == "aggregate") {
+                array.append(snapshot);
+            } else if (mode == "stream") {
+                publisher.streamAddBuffered(work.streams[symbol], snapshot.data(), snapshot.size());
+            } else if (mode == "lvc_hash") {
+                const std::string& fields = work.hashes[work.variant(i)];
+                publisher.hashSetBuffered(work.lastValues[symbol], fields.data(), fields.size());
+            } else if (mode == "fanout" || mode == "function") {
+                // NOTE: As the worker does it - one stored copy referenced by all three commands
+                const SharedPayload stored = publisher.payloads().store(snapshot);
+                publisher.publishBuffered(work.channels[symbol], stored);
+                publisher.streamAddBuffered(work.streams[symbol], stored);
+                publisher.setBuffered(work.lastValues[symbol], stored);
+            } else {
+                publisher.publishBuffered(work.channels[symbol], snapshot.data(), snapshot.size());
+            }
+        }
+        if (mode == "aggregate") {
+            const std::string_view payload = array.close();
+            publisher.publishBuffered(aggregateChannel, payload.data(), payload.size());
+            array.clear();
+        }
+        publisher.flush();
+        const auto done = steady_clock::now();
+        for (std::size_t k = 0; k < count; ++k) {
+            histogram.record(duration_cast<nanoseconds>(done - buffered[k]).count());
+        }
+        sent += count;
+    }
+    result.seconds = duration<double>(steady_clock::now() - start).count();
+    const double cpuAfter = serverCpuSeconds(admin);
+    result.cpuSeconds = cpuBefore >= 0.0 && cpuAfter >= 0.0 ? cpuAfter - cpuBefore : -1.0;
+    result.messages = sent;
+    result.failed = publisher.counters().errors.load(std::memory_order_relaxed);
+    histogram.snapshot(result.latency);
+    return result;
+}
+
+static const char* kColumns = "mode,depth,messages,msgs_per_s,p50_us,p99_us,p999_us,server_cpu_pct,server_cpu_us_per_msg,errors";
+
+static void printRow(const Result& result, const std::string& format) {
+    const LatencyReport::Stage stage = LatencyReport::summarize(result.latency);
+    const double rate = result.seconds > 0.0 ? static_cast<double>(result.messages) / result.seconds : 0.0;
+    const double cpuPercent = result.cpuSeconds >= 0.0 && result.seconds > 0.0 ? result.cpuSeconds / result.seconds * 100.0 : -1.0;
+    const double cpuPerMessage = result.cpuSeconds >= 0.0 && result.messages > 0
+        ? result.cpuSeconds * 1e6 / static_cast<double>(result.messages) : -1.0;
+    if (format == "csv") {
+        std::cout << result.scenario.mode << ',' << result.scenario.depth << ',' << result.messages << ','
+                  << static_cast<long long>(rate) << ',' << stage.p50 / 1000.0 << ',' << stage.p99 / 1000.0 << ','
+                  << stage.p999 / 1000.0 << ',' << cpuPercent << ',' << cpuPerMessage << ',' << result.failed << '\n';
+        return;
+    }
+    std::cout << std::left << std::setw(10) << result.scenario.mode << std::right
+              << " x" << std::setw(4) << result.scenario.depth
+              << " | " << std::setw(10) << static_cast<long long>(rate) << " msgs/s"
+              << " | p50 " << std::setw(9) << stage.p50 / 1000.0 << " μs"
+              << " | p99 " << std::setw(9) << stage.p99 / 1000.0 << " μs"
+              << " | server CPU " << std::setw(6) << std::setprecision(3) << cpuPercent << " % ("
+              << std::setw(6) << cpuPerMessage << " μs/msg)" << std::setprecision(6)
+              << (result.failed != 0 ? " | errors " + std::to_string(result.failed) : "") << '\n';
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    const Workload work(options.symbols);
+    std::unique_ptr<sw::redis::Redis> admin;
+    try {
+        admin = std::make_unique<sw::redis::Redis>(options.redisUri);
+        admin->ping();
+    } catch (const std::exception& e) {
+        std::cerr << "Cannot reach " << options.redisUri << ": " << e.what() << "\n";
+        return 1;
+    }
+    if (options.format == "csv") {
+        std::cout << kColumns << '\n';
+    } else {
+        std::cout << "=== Redis Output Modes ===\n";
+        std::cout << "Redis: " << options.redisUri << " | Snapshots: " << options.messages << " per mode | Symbols: "
+                  << options.symbols << " | Batch: " << options.batch << "\n\n";
+    }
+
+    bool failed = false;
+    for (const std::string& mode : options.modes) {
+        std::vector<std::size_t> depths{mode == "publish" ? 1 : options.batch};
+        if (mode == "pipeline") {
+            depths = options.depths;
+        }
+        for (std::size_t depth : depths) {
+            try {
+                const Result result = run(Scenario{mode, depth}, options, work, *admin);
+                printRow(result, options.format);
+                failed = failed || result.failed != 0;
+            } catch (const std::exception& e) {
+                // NOTE: e.g. io_uring unavailable, Redis < 7 for function - the other modes still run
+                std::cerr << mode << ": skipped (" << e.what() << ")\n";
+            }
+        }
+    }
+    // REASON: Streams and hashes would otherwise stay behind in the instance
+    try {
+        for (std::size_t s = 0; s < work.channels.size(); ++s) {
+            admin->command("DEL", work.streams[s], work.lastValues[s]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Cleanup failed: " << e.what() << "\n";
+    }
+    return failed ? 2 : 0;
+}
@@ -0,0 +1,305 @@
+// benchmark_serialization.cpp - JSON serialization allocation/latency benchmark
+// OBJECTIVE: Prove zero heap allocations per tick on the serialize + publish-buffer path
+// Also times the per-message helpers around it (formatTimestamp, bars, state merge, channel names)
+// against the "10-50μs per message" budget in Serialization.h
+//
+// Usage: benchmark_serialization [iterations]
+
+#include "InstrumentRegistry.h"
+#include "MarketData.h"
+#include "Serialization.h"
+#include "SnapshotEncoder.h"
+#include "BinaryEncoder.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std::chrono;
+
+// ========== Allocation Counter ==========
+// REASON: Global operator new replacement counts every heap allocation in the process
+static std::atomic<std::uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static InstrumentState makeState() {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.tickerId = 1001;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.lastSize = 50;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.exchange = "NASDAQ";
+    return state;
+}
+
+// REASON: Mirrors RedisPublisher::publishBuffered slot reuse without a Redis connection
+struct PendingSlot {
+    std::string channel;
+    std::string payload;
+};
+
+static void copyToSlot(PendingSlot& slot, const std::string& channel,
+                       const char* data, std::size_t length) {
+    slot.channel.assign(channel);
+    slot.payload.assign(data, length);
+}
+
+struct Result {
+    double nsPerOp;
+    double allocsPerOp;
+    std::size_t payloadBytes;  // Last message size (bandwidth per snapshot)
+};
+
+// Legacy path: fresh StringBuffer + returned std::string + per-publish channel concat
+static Result benchmarkLegacy(InstrumentState& state, int iterations) {
+    PendingSlot slot;
+    std::uint64_t allocsBefore = g_allocations.load();
+    auto start = steady_clock::now();
+    
+    for (int i = 0; i < iterations; ++i) {
+        state.bidPrice = 171.55 + (i % 100) * 0.01;
+        std::string json = serializeState(state);
+        std::string channel = "TWS:TICKS:" + state.symbol;
+        copyToSlot(slot, channel, json.data(), json.size());
+    }
+    
+    auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    std::uint64_t allocs = g_allocations.load() - allocsBefore;
+    return {static_cast<double>(elapsed) / iterations, static_cast<double>(allocs) / iterations, slot.payload.size()};
+}
+
+// Buffer path: reused JsonBuffer + precomputed channel name
+template <typename Encode>
+static Result benchmarkReusedBuffer(InstrumentState& state, int iterations, Encode encode) {
+    const std::string channel = "TWS:TICKS:" + state.symbol;  // Subscribe time
+    PendingSlot slot;
+    JsonBuffer json;
+    
+    // Warm-up: grow buffer, writer stack and slot capacity once
+    for (int i = 0; i < 1000; ++i) {
+        encode(state, json);
+        copyToSlot(slot, channel, json.data(), json.size());
+    }
+    
+    std::uint64_t allocsBefore = g_allocations.load();
+    auto start = steady_clock::now();
+    
+    for (int i = 0; i < iterations; ++i) {
+        state.bidPrice = 171.55 + (i % 100) * 0.01;
+        encode(state, json);
+        copyToSlot(slot, channel, json.data(), json.size());
+    }
+    
+    auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    std::uint64_t allocs = g_allocations.load() - allocsBefore;
+    return {static_cast<double>(elapsed) / iterations, static_cast<double>(allocs) / iterations, json.size()};
+}
+
+// Any per-message operation: warm-up, then timed loop with the allocation delta
+template <typename Op>
+static Result benchmarkOp(int iterations, Op op) {
+    for (int i = 0; i < 1000; ++i) {
+        op(i);
+    }
+    std::uint64_t allocsBefore = g_allocations.load();
+    auto start = steady_clock::now();
+    std::size_t bytes = 0;
+    for (int i = 0; i < iterations; ++i) {
+        bytes = op(i);
+    }
+    auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    std::uint64_t allocs = g_allocations.load() - allocsBefore;
+    return {static_cast<double>(elapsed) / iterations, static_cast<double>(allocs) / iterations, bytes};
+}
+
+static TickUpdate makeBar() {
+    TickUpdate bar;
+    bar.type = TickUpdateType::Bar;
+    bar.timestamp = 1700000000000;
+    bar.setBarSize(tws_bridge::BarSize::Sec5);
+    bar.bar.open = 171.50;
+    bar.bar.high = 171.80;
+    bar.bar.low = 171.40;
+    bar.bar.close = 171.60;
+    bar.bar.volume = 12500;
+    bar.bar.wap = 171.58;
+    bar.aux = 42;
+    return bar;
+}
+
+// REASON: Mirrors the BidAsk / AllLast merge of RedisWorker::applyUpdate (private, needs a publisher)
+static void mergeUpdate(InstrumentState& state, const TickUpdate& update) {
+    if (update.type == TickUpdateType::BidAsk) {
+        state.bidPrice = update.bidAsk.bidPrice;
+        state.askPrice = update.bidAsk.askPrice;
+        state.bidSize = state.sizeUnits(update.bidQuantity());
+        state.askSize = state.sizeUnits(update.askQuantity());
+        state.quoteTimestamp = update.timestamp;
+        state.hasQuote = true;
+    } else if (update.type == TickUpdateType::AllLast) {
+        state.lastPrice = update.allLast.price;
+        state.lastSize = state.sizeUnits(update.tradeQuantity());
+        state.tradeTimestamp = update.timestamp;
+        state.hasTrade = true;
+        state.pastLimit = update.pastLimit();
+    }
+}
+
+static void print(const std::string& label, const Result& result) {
+    std::cout << "  " << std::left << std::setw(22) << label
+              << std::fixed << std::setprecision(1) << result.nsPerOp << " ns/op, "
+              << std::setprecision(3) << result.allocsPerOp << " allocs/op, "
+              << result.payloadBytes << " bytes/msg\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::cout << "=== Serialization Allocation Benchmark ===\n";
+    
+    int iterations = 100000;
+    if (argc > 1) {
+        iterations = std::atoi(argv[1]);
+    }
+    std::cout << "Iterations: " << iterations << "\n\n";
+    
+    InstrumentState state = makeState();
+    Result legacy = benchmarkLegacy(state, iterations);
+    Result reused = benchmarkReusedBuffer(state, iterations,
+        [](const InstrumentState& s, JsonBuffer& out) { serializeState(s, out); });
+    Result encoder = benchmarkReusedBuffer(state, iterations,
+        [](const InstrumentState& s, JsonBuffer& out) { encodeSnapshot(s, out); });
+    Result compactReference = benchmarkReusedBuffer(state, iterations,
+        [](const InstrumentState& s, JsonBuffer& out) { serializeStateCompact(s, out); });
+    Result compact = benchmarkReusedBuffer(state, iterations,
+        [](const InstrumentState& s, JsonBuffer& out) { encodeSnapshot(s, out, SnapshotSchema::Compact); });
+    Result fixedPoint = benchmarkReusedBuffer(state, iterations,
+        [](const InstrumentState& s, JsonBuffer& out) {
+            encodeSnapshot(s, out, SnapshotSchema::Verbose, false, false, PriceFormat::FixedPoint);
+        });
+    
+    print("Legacy (std::string)", legacy);
+    print("Reused JsonBuffer", reused);
+    print("Fixed-schema encoder", encoder);
+    print("Compact (RapidJSON)", compactReference);
+    print("Compact encoder", compact);
+    print("Fixed-point prices", fixedPoint);
+    
+    // Binary v1 (TWS:BIN:TICKS:*), adapted to the JsonBuffer-shaped benchmark
+    std::string binary;
+    Result binaryResult = benchmarkReusedBuffer(state, iterations,
+        [&binary](const InstrumentState& s, JsonBuffer& out) {
+            encodeSnapshotBinary(s, binary);
+            out.buffer.Clear();
+            std::memcpy(out.buffer.Push(binary.size()), binary.data(), binary.size());
+        });
+    print("Binary v1", binaryResult);
+    
+    // ========== Per-message helpers ==========
+    std::cout << "\n  Helpers:\n";
+    Result timestamp = benchmarkOp(iterations, [](int i) {
+        return formatTimestamp(1700000000000L + i).size();
+    });
+    print("formatTimestamp", timestamp);
+    char iso[tws_bridge::IsoTimestampFormatter::kLength];
+    Result isoTimestamp = benchmarkOp(iterations, [&iso](int i) {
+        tws_bridge::formatIsoTimestamp(1700000000000L + i, iso);
+        return sizeof(iso);
+    });
+    print("formatIsoTimestamp", isoTimestamp);
+    Result encoderIso = benchmarkReusedBuffer(state, iterations,
+        [](const InstrumentState& s, JsonBuffer& out) { encodeSnapshot(s, out, SnapshotSchema::Verbose, false, true); });
+    print("Encoder + ISO time", encoderIso);
+    
+    TickUpdate bar = makeBar();
+    Result barLegacy = benchmarkOp(iterations, [&state, &bar](int i) {
+        bar.bar.close = 171.60 + (i % 100) * 0.01;
+        return serializeBarData(state.symbol, bar).size();
+    });
+    print("Bar (std::string)", barLegacy);
+    JsonBuffer barJson;
+    Result barReused = benchmarkOp(iterations, [&state, &bar, &barJson](int i) {
+        bar.bar.close = 171.60 + (i % 100) * 0.01;
+        serializeBarData(state.symbol, bar, barJson);
+        return barJson.size();
+    });
+    print("Bar (JsonBuffer)", barReused);
+    Result barEncoder = benchmarkOp(iterations, [&state, &bar, &barJson](int i) {
+        bar.bar.close = 171.60 + (i % 100) * 0.01;
+        encodeBar(state.symbol, bar, barJson);
+        return barJson.size();
+    });
+    print("Bar encoder (kBarFields)", barEncoder);
+    
+    TickUpdate updates[2];
+    updates[0].type = TickUpdateType::BidAsk;
+    updates[0].bidAsk.bidPrice = 171.55;
+    updates[0].bidAsk.askPrice = 171.57;
+    updates[0].bidAsk.bidSize = 100;
+    updates[0].bidAsk.askSize = 200;
+    updates[1].type = TickUpdateType::AllLast;
+    updates[1].allLast.price = 171.56;
+    updates[1].allLast.size = 50;
+    InstrumentState merged = makeState();
+    Result merge = benchmarkOp(iterations, [&merged, &updates](int i) {
+        TickUpdate& update = updates[i & 1];
+        update.timestamp = 1700000000000 + i;
+        mergeUpdate(merged, update);
+        return std::size_t{0};
+    });
+    print("State merge", merge);
+    
+    // Channel name: per-publish concatenation vs InstrumentRegistry's subscribe-time channels
+    Result channelConcat = benchmarkOp(iterations, [&state](int) {
+        std::string channel = "TWS:TICKS:" + state.symbol;
+        return channel.size();
+    });
+    print("Channel (concat)", channelConcat);
+    tws_bridge::InstrumentRegistry registry(16);
+    const tws_bridge::SlotId slot = registry.registerInstrument(state.symbol, state.tickerId);
+    Result channelRegistry = benchmarkOp(iterations, [&registry, slot](int) {
+        return registry.channels(slot).ticks.size();
+    });
+    print("Channel (registry)", channelRegistry);
+    
+    // PERFORMANCE: Bandwidth comparison (network-bound Redis at the open)
+    std::cout << "\n  Compact/verbose payload: " << std::setprecision(1)
+              << 100.0 * compact.payloadBytes / encoder.payloadBytes << "%\n";
+    
+    // REASON: Serialization.h budget is 10-50μs per message - the whole snapshot path must stay far below it
+    const double perMessageUs = (encoder.nsPerOp + merge.nsPerOp + channelRegistry.nsPerOp) / 1000.0;
+    std::cout << "  Merge + encode + channel: " << std::setprecision(3) << perMessageUs
+              << " μs/message (budget: 10-50 μs)\n";
+    
+    if (reused.allocsPerOp == 0.0 && encoder.allocsPerOp == 0.0 && compact.allocsPerOp == 0.0
+        && binaryResult.allocsPerOp == 0.0 && barReused.allocsPerOp == 0.0 && merge.allocsPerOp == 0.0
+        && channelRegistry.allocsPerOp == 0.0 && isoTimestamp.allocsPerOp == 0.0 && encoderIso.allocsPerOp == 0.0) {
+        std::cout << "\n✅ PASSED: Zero heap allocations per tick (serialize + publish buffer)\n";
+        return 0;
+    }
+    std::cout << "\n❌ FAILED: " << reused.allocsPerOp << " / " << encoder.allocsPerOp << " / " << barReused.allocsPerOp
+              << " / " << merge.allocsPerOp << " / " << channelRegistry.allocsPerOp << " / " << isoTimestamp.allocsPerOp
+              << " / " << encoderIso.allocsPerOp << " allocations per tick\n";
+    return 1;
+}
@@ -0,0 +1,488 @@
+// chaos_probe.cpp - Reconnect chaos test: subscribes to the bridge's Redis channels like a consumer, injects
+// faults under a steady feed (fake_tws socket resets, TWS error 1100 outages, Redis restarts) and measures
+// how long each symbol takes to tick again
+// OBJECTIVE: Comparable recovery report per build - time-to-first-tick per symbol, time-to-full-coverage,
+// lost messages - so reconnect, warm-state and pacing changes can be quantified
+//
+// Usage: fake_tws --rate N &  tws_bridge &  chaos_probe --tws-pid $(pidof fake_tws) [options]
+//   --redis URI          Redis to subscribe on (default tcp://127.0.0.1:6379)
+//   --pattern P          Channel pattern, repeatable (default TWS:TICKS:*)
+//   --faults LIST        Fault cycle, comma separated: reset, 1100, redis (default reset,1100)
+//   --rounds N           Cycles through --faults (default 3)
+//   --warmup S           Steady-state time before the first fault; its channels are the expected symbols (default 10)
+//   --symbols N          Also wait for N channels before the first fault (default 0)
+//   --settle S           Give up on symbols that have not ticked S seconds after a fault (default 60)
+//   --quiet S            Pause after full coverage before the next fault (default 5)
+//   --drain-ms N         Messages within N ms of a fault are in flight, not recovery (default 50)
+//   --tws-pid PID        fake_tws process: SIGUSR1 = reset, SIGUSR2 = 1100 outage (fake_tws --outage / --restore-code)
+//   --redis-restart CMD  Shell command restarting Redis (e.g. "docker restart redis"), run for the redis fault
+//   --label NAME         First CSV column, to tell builds apart (default run)
+//   --csv PATH           One row per fault, appended (header written to a new file)
+//   --max-coverage-ms N  Fail (exit 2) if a fault takes longer than N ms to full coverage, or never gets there
+//
+// NOTE: Times run from the injection - the 1100 ones include the scripted outage (fake_tws --outage), the
+// redis ones the restart command and this probe's own resubscribe
+
+#include <sw/redis++/redis++.h>
+#include <signal.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono;
+
+static volatile std::sig_atomic_t g_stop = 0;
+
+static void onSignal(int) {
+    g_stop = 1;
+}
+
+// ========== Options ==========
+enum class Fault { Reset, Outage, Redis };
+
+static const char* faultName(Fault fault) {
+    switch (fault) {
+    case Fault::Reset: return "reset";
+    case Fault::Outage: return "1100";
+    case Fault::Redis: return "redis";
+    }
+    return "unknown";
+}
+
+struct Options {
+    std::string redisUri = "tcp://127.0.0.1:6379";
+    std::vector<std::string> patterns;
+    std::vector<Fault> faults;
+    int rounds = 3;
+    double warmup = 10.0;
+    std::size_t symbols = 0;
+    double settle = 60.0;
+    double quiet = 5.0;
+    int drainMs = 50;
+    pid_t twsPid = 0;
+    std::string redisRestart;
+    std::string label = "run";
+    std::string csvPath;
+    double maxCoverageMs = 0.0;
+};
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--redis") {
+            options.redisUri = value;
+        } else if (flag == "--pattern") {
+            options.patterns.push_back(value);
+        } else if (flag == "--faults") {
+            std::stringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (item == "reset") {
+                    options.faults.push_back(Fault::Reset);
+                } else if (item == "1100") {
+                    options.faults.push_back(Fault::Outage);
+                } else if (item == "redis") {
+                    options.faults.push_back(Fault::Redis);
+                } else if (!item.empty()) {
+                    std::cerr << "Unknown fault " << item << " (reset, 1100, redis)\n";
+                    return false;
+                }
+            }
+        } else if (flag == "--rounds") {
+            options.rounds = std::max(1, std::stoi(value));
+        } else if (flag == "--warmup") {
+            options.warmup = std::max(0.1, std::stod(value));
+        } else if (flag == "--symbols") {
+            options.symbols = std::stoul(value);
+        } else if (flag == "--settle") {
+            options.settle = std::max(0.1, std::stod(value));
+        } else if (flag == "--quiet") {
+            options.quiet = std::max(0.0, std::stod(value));
+        } else if (flag == "--drain-ms") {
+            options.drainMs = std::max(0, std::stoi(value));
+        } else if (flag == "--tws-pid") {
+            options.twsPid = static_cast<pid_t>(std::stol(value));
+        } else if (flag == "--redis-restart") {
+            options.redisRestart = value;
+        } else if (flag == "--label") {
+            options.label = value;
+        } else if (flag == "--csv") {
+            options.csvPath = value;
+        } else if (flag == "--max-coverage-ms") {
+            options.maxCoverageMs = std::stod(value);
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    if (options.patterns.empty()) {
+        options.patterns.push_back("TWS:TICKS:*");
+    }
+    if (options.faults.empty()) {
+        options.faults = {Fault::Reset, Fault::Outage};
+    }
+    for (Fault fault : options.faults) {
+        if (fault != Fault::Redis && options.twsPid <= 0) {
+            std::cerr << "Fault " << faultName(fault) << " needs --tws-pid (fake_tws)\n";
+            return false;
+        }
+        if (fault == Fault::Redis && options.redisRestart.empty()) {
+            std::cerr << "Fault redis needs --redis-restart CMD\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// ========== Payload scan ==========
+// "seq" / "sq" of a per-symbol snapshot or delta, 0 if none
+// REASON: No JSON parse - same scan as latency_probe
+static std::uint64_t findSequence(std::string_view payload) {
+    if (payload.empty() || payload.front() != '{') {
+        return 0;
+    }
+    for (const std::string_view key : {std::string_view("\"seq\":"), std::string_view("\"sq\":")}) {
+        const std::size_t at = payload.find(key);
+        if (at == std::string_view::npos) {
+            continue;
+        }
+        std::uint64_t number = 0;
+        for (std::size_t cursor = at + key.size(); cursor < payload.size() && payload[cursor] >= '0'
+                                                   && payload[cursor] <= '9';
+             ++cursor) {
+            number = number * 10 + static_cast<std::uint64_t>(payload[cursor] - '0');
+        }
+        return number;
+    }
+    return 0;
+}
+
+// ========== Probe ==========
+struct SymbolState {
+    bool expected = false;                          // Ticked during the warm-up
+    double rate = 0.0;                              // Warm-up messages/s
+    std::uint64_t warmupMessages = 0;
+    std::uint64_t lastSequence = 0;
+    steady_clock::time_point lastMessage{};
+    steady_clock::time_point lastBeforeFault{};     // lastMessage at the injection
+    steady_clock::time_point recoveredAt{};         // First message after the drain window, {} = not yet
+};
+
+// One injected fault
+struct FaultResult {
+    int round = 0;
+    Fault fault = Fault::Reset;
+    std::size_t expected = 0;
+    std::size_t recovered = 0;
+    double ttftP50Ms = 0.0;                         // Time to first tick across the recovered symbols
+    double ttftP99Ms = 0.0;
+    double ttftMaxMs = 0.0;
+    double coverageMs = -1.0;                       // Time to full coverage, -1 = not within --settle
+    std::uint64_t sequenceGaps = 0;                 // Messages the bridge numbered that never arrived
+    std::uint64_t missedEstimate = 0;               // Warm-up rate × dark time, summed over symbols
+};
+
+class Probe {
+public:
+    enum class Phase { Warmup, Recovering, Quiet, Done };
+
+    explicit Probe(const Options& options) : m_options(options), m_phaseStart(steady_clock::now()) {}
+
+    void onMessage(const std::string& channel, const std::string& payload) {
+        const auto now = steady_clock::now();
+        SymbolState& state = m_symbols[channel];
+        if (m_phase == Phase::Warmup) {
+            state.expected = true;
+            ++state.warmupMessages;
+        }
+        const std::uint64_t sequence = findSequence(payload);
+        if (sequence != 0) {
+            if (state.lastSequence != 0 && sequence > state.lastSequence + 1 && m_phase == Phase::Recovering) {
+                m_gaps += sequence - state.lastSequence - 1;
+            }
+            state.lastSequence = std::max(state.lastSequence, sequence);
+        }
+        state.lastMessage = now;
+        if (m_phase == Phase::Recovering && state.expected && state.recoveredAt == steady_clock::time_point{}
+            && now - m_injectedAt >= milliseconds(m_options.drainMs)) {
+            state.recoveredAt = now;
+            ++m_recovered;
+        }
+    }
+
+    // Advances the schedule, returns the fault to inject now (if any)
+    std::optional<Fault> tick() {
+        const auto now = steady_clock::now();
+        const double inPhase = duration<double>(now - m_phaseStart).count();
+        switch (m_phase) {
+        case Phase::Warmup:
+            if (inPhase >= m_options.warmup && expectedCount() > 0 && expectedCount() >= m_options.symbols) {
+                for (auto& entry : m_symbols) {
+                    entry.second.rate = static_cast<double>(entry.second.warmupMessages) / inPhase;
+                }
+                std::cout << "[CHAOS] Warm-up done: " << expectedCount() << " symbols\n";
+                return inject(now);
+            }
+            return std::nullopt;
+        case Phase::Recovering:
+            if (m_recovered >= m_expected || inPhase >= m_options.settle) {
+                finishFault(now);
+                m_phase = m_next < m_options.faults.size() * static_cast<std::size_t>(m_options.rounds)
+                    ? Phase::Quiet : Phase::Done;
+                m_phaseStart = now;
+            }
+            return std::nullopt;
+        case Phase::Quiet:
+            return inPhase >= m_options.quiet ? inject(now) : std::nullopt;
+        case Phase::Done:
+            return std::nullopt;
+        }
+        return std::nullopt;
+    }
+
+    bool done() const { return m_phase == Phase::Done; }
+
+    // Summary per fault kind + CSV rows, returns the exit code (2 = --max-coverage-ms exceeded)
+    int finish() {
+        if (m_phase == Phase::Recovering) {
+            finishFault(steady_clock::now());
+        }
+        std::cout << "\n=== Recovery (" << m_options.label << ", " << expectedCount() << " symbols) ===\n";
+        bool failed = false;
+        for (Fault fault : {Fault::Reset, Fault::Outage, Fault::Redis}) {
+            std::vector<double> coverage;
+            std::vector<double> firstTicks;
+            std::size_t unrecovered = 0;
+            std::uint64_t gaps = 0;
+            std::uint64_t missed = 0;
+            for (const FaultResult& r : m_results) {
+                if (r.fault != fault) {
+                    continue;
+                }
+                firstTicks.push_back(r.ttftP50Ms);
+                if (r.coverageMs >= 0) {
+                    coverage.push_back(r.coverageMs);
+                }
+                unrecovered += r.expected - r.recovered;
+                gaps += r.sequenceGaps;
+                missed += r.missedEstimate;
+                if (m_options.maxCoverageMs > 0 && (r.coverageMs < 0 || r.coverageMs > m_options.maxCoverageMs)) {
+                    failed = true;
+                }
+            }
+            if (firstTicks.empty()) {
+                continue;
+            }
+            std::cout << "  " << std::left << std::setw(6) << faultName(fault) << std::right << " x" << firstTicks.size()
+                      << std::fixed << std::setprecision(0) << " | first tick p50 " << std::setw(7)
+                      << median(firstTicks) << " ms | full coverage median " << std::setw(7)
+                      << (coverage.empty() ? -1.0 : median(coverage)) << " ms, max " << std::setw(7)
+                      << (coverage.empty() ? -1.0 : *std::max_element(coverage.begin(), coverage.end()))
+                      << " ms | unrecovered " << unrecovered << " | seq gaps " << gaps << " | missed ~" << missed
+                      << "\n";
+        }
+        if (!m_options.csvPath.empty()) {
+            std::ifstream existing(m_options.csvPath);
+            const bool header = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+            std::ofstream csv(m_options.csvPath, std::ios::app);
+            if (header) {
+                csv << "label,round,fault,symbols,recovered,ttft_p50_ms,ttft_p99_ms,ttft_max_ms,coverage_ms,"
+                       "seq_gaps,missed_est\n";
+            }
+            for (const FaultResult& r : m_results) {
+                csv << m_options.label << ',' << r.round << ',' << faultName(r.fault) << ',' << r.expected << ','
+                    << r.recovered << ',' << std::fixed << std::setprecision(1) << r.ttftP50Ms << ',' << r.ttftP99Ms
+                    << ',' << r.ttftMaxMs << ',' << r.coverageMs << ',' << r.sequenceGaps << ',' << r.missedEstimate
+                    << '\n';
+            }
+            if (!csv.good()) {
+                std::cerr << "Cannot write " << m_options.csvPath << "\n";
+            }
+        }
+        if (failed) {
+            std::cout << "FAIL: full coverage above " << m_options.maxCoverageMs << " ms (or never reached)\n";
+            return 2;
+        }
+        return 0;
+    }
+
+private:
+    std::size_t expectedCount() const {
+        std::size_t count = 0;
+        for (const auto& entry : m_symbols) {
+            count += entry.second.expected ? 1 : 0;
+        }
+        return count;
+    }
+
+    static double median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        return values[values.size() / 2];
+    }
+
+    std::optional<Fault> inject(steady_clock::time_point now) {
+        const Fault fault = m_options.faults[m_next % m_options.faults.size()];
+        ++m_next;
+        m_injectedAt = now;
+        m_phaseStart = now;
+        m_phase = Phase::Recovering;
+        m_recovered = 0;
+        m_expected = 0;
+        m_gaps = 0;
+        for (auto& entry : m_symbols) {
+            SymbolState& state = entry.second;
+            state.lastBeforeFault = state.lastMessage;
+            state.recoveredAt = steady_clock::time_point{};
+            m_expected += state.expected ? 1 : 0;
+        }
+        return fault;
+    }
+
+    void finishFault(steady_clock::time_point now) {
+        FaultResult result;
+        result.round = static_cast<int>((m_next - 1) / m_options.faults.size()) + 1;
+        result.fault = m_options.faults[(m_next - 1) % m_options.faults.size()];
+        result.expected = m_expected;
+        result.recovered = m_recovered;
+        result.sequenceGaps = m_gaps;
+        std::vector<double> firstTicks;
+        double missed = 0.0;
+        for (const auto& entry : m_symbols) {
+            const SymbolState& state = entry.second;
+            if (!state.expected) {
+                continue;
+            }
+            const bool recovered = state.recoveredAt != steady_clock::time_point{};
+            if (recovered) {
+                firstTicks.push_back(duration<double, std::milli>(state.recoveredAt - m_injectedAt).count());
+            }
+            const auto darkFrom = std::min(state.lastBeforeFault, m_injectedAt);
+            missed += state.rate * duration<double>((recovered ? state.recoveredAt : now) - darkFrom).count();
+        }
+        result.missedEstimate = static_cast<std::uint64_t>(missed);
+        if (!firstTicks.empty()) {
+            std::sort(firstTicks.begin(), firstTicks.end());
+            result.ttftP50Ms = firstTicks[firstTicks.size() / 2];
+            result.ttftP99Ms = firstTicks[std::min(firstTicks.size() - 1, firstTicks.size() * 99 / 100)];
+            result.ttftMaxMs = firstTicks.back();
+        }
+        if (m_recovered >= m_expected) {
+            result.coverageMs = result.ttftMaxMs;
+        }
+        std::cout << "[CHAOS] Round " << result.round << " " << faultName(result.fault) << ": " << result.recovered
+                  << "/" << result.expected << " symbols | first tick p50 " << std::fixed << std::setprecision(0)
+                  << result.ttftP50Ms << " ms, p99 " << result.ttftP99Ms << " ms | full coverage "
+                  << (result.coverageMs >= 0 ? std::to_string(static_cast<long long>(result.coverageMs)) + " ms"
+                                             : std::string("not reached"))
+                  << " | seq gaps " << result.sequenceGaps << " | missed ~" << result.missedEstimate << "\n";
+        m_results.push_back(result);
+    }
+
+    const Options& m_options;
+    // NOTE: std::map - channels appear once, iteration order keeps reports stable between runs
+    std::map<std::string, SymbolState> m_symbols;
+    std::vector<FaultResult> m_results;
+    Phase m_phase = Phase::Warmup;
+    steady_clock::time_point m_phaseStart;
+    steady_clock::time_point m_injectedAt{};
+    std::size_t m_next = 0;                         // Faults injected so far
+    std::size_t m_expected = 0;
+    std::size_t m_recovered = 0;
+    std::uint64_t m_gaps = 0;
+};
+
+// ========== Faults ==========
+static void injectFault(Fault fault, const Options& options) {
+    std::cout << "[CHAOS] Injecting " << faultName(fault) << "\n";
+    switch (fault) {
+    case Fault::Reset:
+        ::kill(options.twsPid, SIGUSR1);
+        return;
+    case Fault::Outage:
+        ::kill(options.twsPid, SIGUSR2);
+        return;
+    case Fault::Redis:
+        // PITFALL: Blocks until the command returns - nothing is consumed meanwhile, Redis is down anyway
+        if (std::system(options.redisRestart.c_str()) != 0) {
+            std::cerr << "[CHAOS] --redis-restart command failed\n";
+        }
+        return;
+    }
+}
+
+// Subscriber with every pattern, std::nullopt while Redis is unreachable
+static std::optional<sw::redis::Subscriber> subscribe(sw::redis::Redis& redis, Probe& probe, const Options& options) {
+    try {
+        auto subscriber = redis.subscriber();
+        subscriber.on_pmessage([&probe](std::string /*pattern*/, std::string channel, std::string payload) {
+            probe.onMessage(channel, payload);
+        });
+        for (const std::string& pattern : options.patterns) {
+            subscriber.psubscribe(pattern);
+        }
+        return subscriber;
+    } catch (const sw::redis::Error&) {
+        return std::nullopt;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::cout << "=== Chaos Probe ===\n";
+    std::cout << "Redis: " << options.redisUri << " | Faults:";
+    for (Fault fault : options.faults) {
+        std::cout << " " << faultName(fault);
+    }
+    std::cout << " x" << options.rounds << " | Warm-up: " << options.warmup << " s | Settle: " << options.settle
+              << " s\n\n";
+
+    Probe probe(options);
+    sw::redis::ConnectionOptions connection(options.redisUri);
+    // REASON: consume() returns at least every 100 ms - the fault schedule stays on time when idle
+    connection.socket_timeout = milliseconds(100);
+    sw::redis::Redis redis(connection);
+    std::optional<sw::redis::Subscriber> subscriber;
+    while (g_stop == 0 && !probe.done()) {
+        if (!subscriber) {
+            subscriber = subscribe(redis, probe, options);
+            if (!subscriber) {
+                std::this_thread::sleep_for(milliseconds(100));
+            }
+        } else {
+            try {
+                subscriber->consume();
+            } catch (const sw::redis::TimeoutError&) {
+                // REASON: Timeout is the idle path
+            } catch (const sw::redis::Error&) {
+                subscriber.reset();  // REASON: Redis went away (the redis fault) - resubscribe on the next pass
+            }
+        }
+        if (const auto fault = probe.tick()) {
+            injectFault(*fault, options);
+        }
+    }
+    return probe.finish();
+}
@@ -0,0 +1,900 @@
+// fake_tws.cpp - Fake TWS / IB Gateway: API handshake + synthetic or recorded market data at a set rate
+// OBJECTIVE: Load-test the real TwsClient end to end (EClientSocket, EReader, EDecoder, callbacks) on
+// loopback - no paper account, no market hours, reproducible rates
+//
+// Usage: fake_tws [options]   then: tws_bridge with tws.host 127.0.0.1 / tws.port <port>
+//   --port N           Listen port on 127.0.0.1 (default 7497)
+//   --server-version N Version answered in the handshake, 196..203 (default 200; 201+ = binary message ids)
+//   --rate N           Ticks/s per connection across its subscriptions, 0 = as fast as possible (default 10000)
+//   --profile P        steady | burst (default steady)
+//   --burst N          Ticks per burst for --profile burst (default 1000, same average rate)
+//   --trades PCT       Share of trades in % where both streams are subscribed (default 20, rest quotes)
+//   --bar-interval S   Real-time bar period in seconds (default 5, as TWS)
+//   --history-bars N   Bars answered to every reqHistoricalData (default 100)
+//   --journal DIR      Replay a TickJournal session instead of synthetic ticks (matched by symbol)
+//   --speed X          Journal replay speed, 0 = as fast as possible (default 1)
+//   --duration S       Close each connection S seconds after its first subscription (default 0 = never)
+//   --outage S         Length of a SIGUSR2 connectivity outage in seconds (default 5)
+//   --restore-code N   Error sent when the outage ends: 1102 data maintained, 1101 data lost (default 1102)
+//
+// Faults (every open connection, for chaos_probe): SIGUSR1 resets the socket (RST, as a TWS restart),
+// SIGUSR2 sends error 1100, withholds all data for --outage S, then sends --restore-code - with 1101 the
+// subscriptions are dropped at the start of the outage, as TWS does, and must be requested again
+//
+// Answered requests: startApi, reqIds, reqTickByTickData (BidAsk / AllLast / Last / MidPoint), reqMktData,
+// reqRealTimeBars, reqHistoricalData, reqContractDetails (empty answer) and their cancels; everything
+// else (depth, market data type, ...) is read and ignored
+
+#include "EWrapper.h"
+#include "EClient.h"  // REASON: After EWrapper.h (EClient.h relies on its <map> include)
+#include "EDecoder.h"
+#include "Quantity.h"
+#include "TickJournal.h"
+#include "TradeCodes.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+using namespace ibapi::client_constants;  // Request ids (EDecoder.h: server message ids)
+
+static std::atomic<bool> g_running{true};
+
+static void onSignal(int) {
+    g_running.store(false);
+}
+
+// Fault generations - each session compares them with the ones it has seen (SIGUSR1 / SIGUSR2)
+static std::atomic<std::uint32_t> g_resets{0};
+static std::atomic<std::uint32_t> g_outages{0};
+
+static void onFault(int signal) {
+    (signal == SIGUSR1 ? g_resets : g_outages).fetch_add(1);
+}
+
+// ========== Options ==========
+struct Options {
+    std::uint16_t port = 7497;
+    int serverVersion = 200;
+    double rate = 10000.0;
+    bool burst = false;
+    std::size_t burstSize = 1000;
+    int tradesPercent = 20;
+    int barIntervalSeconds = 5;
+    int historyBars = 100;
+    std::string journalDirectory;
+    double speed = 1.0;
+    double duration = 0.0;
+    double outage = 5.0;
+    int restoreCode = 1102;
+};
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--port") {
+            options.port = static_cast<std::uint16_t>(std::stoul(value));
+        } else if (flag == "--server-version") {
+            options.serverVersion = std::clamp(std::stoi(value), MIN_SERVER_VER_HISTORICAL_DATA_END, MAX_CLIENT_VER);
+        } else if (flag == "--rate") {
+            options.rate = std::stod(value);
+        } else if (flag == "--profile") {
+            options.burst = value == "burst";
+        } else if (flag == "--burst") {
+            options.burstSize = std::max<std::size_t>(1, std::stoul(value));
+        } else if (flag == "--trades") {
+            options.tradesPercent = std::clamp(std::stoi(value), 0, 100);
+        } else if (flag == "--bar-interval") {
+            options.barIntervalSeconds = std::max(1, std::stoi(value));
+        } else if (flag == "--history-bars") {
+            options.historyBars = std::max(0, std::stoi(value));
+        } else if (flag == "--journal") {
+            options.journalDirectory = value;
+        } else if (flag == "--speed") {
+            options.speed = std::max(0.0, std::stod(value));
+        } else if (flag == "--duration") {
+            options.duration = std::stod(value);
+        } else if (flag == "--outage") {
+            options.outage = std::max(0.0, std::stod(value));
+        } else if (flag == "--restore-code") {
+            options.restoreCode = std::stoi(value) == 1101 ? 1101 : 1102;
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// ========== Wire format ==========
+// Every message: 4-byte big-endian length, then the message id (text field, or a 4-byte big-endian
+// int from server version 201) and NUL-terminated text fields
+class MessageWriter {
+public:
+    explicit MessageWriter(int serverVersion) : m_rawIds(serverVersion >= MIN_SERVER_VER_PROTOBUF) {}
+
+    MessageWriter& begin(int msgId) {
+        m_start = m_out.size();
+        m_out.append(4, '\0');
+        if (m_rawIds) {
+            appendInt32(static_cast<std::uint32_t>(msgId));
+        } else {
+            field(msgId);
+        }
+        return *this;
+    }
+
+    MessageWriter& field(std::string_view value) {
+        m_out.append(value.data(), value.size());
+        m_out.push_back('\0');
+        return *this;
+    }
+    MessageWriter& field(const char* value) { return field(std::string_view(value)); }
+    MessageWriter& field(const std::string& value) { return field(std::string_view(value)); }
+    MessageWriter& field(long long value) { return format("%lld", value); }
+    MessageWriter& field(int value) { return format("%d", value); }
+    MessageWriter& field(double value) { return format("%.10g", value); }
+    MessageWriter& field(Quantity value) {
+        char text[kQuantityMaxChars];
+        return field(std::string_view(text, static_cast<std::size_t>(writeQuantity(text, value) - text)));
+    }
+
+    void end() {
+        const auto length = static_cast<std::uint32_t>(m_out.size() - m_start - 4);
+        for (int i = 0; i < 4; ++i) {
+            m_out[m_start + static_cast<std::size_t>(i)] = static_cast<char>((length >> (24 - 8 * i)) & 0xFF);
+        }
+        ++m_messages;
+    }
+
+    std::string& buffer() { return m_out; }
+    std::uint64_t messages() const { return m_messages; }
+
+private:
+    template <typename T>
+    MessageWriter& format(const char* spec, T value) {
+        char text[32];
+        const int length = std::snprintf(text, sizeof(text), spec, value);
+        return field(std::string_view(text, static_cast<std::size_t>(std::max(length, 0))));
+    }
+
+    void appendInt32(std::uint32_t value) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            m_out.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
+    }
+
+    bool m_rawIds;
+    std::string m_out;
+    std::size_t m_start = 0;
+    std::uint64_t m_messages = 0;
+};
+
+static std::uint32_t readInt32(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return (std::uint32_t{bytes[0]} << 24) | (std::uint32_t{bytes[1]} << 16) | (std::uint32_t{bytes[2]} << 8) | bytes[3];
+}
+
+// "5 secs" / "1 min" / "1 hour" / "1 day" → seconds (60 when unknown)
+static long long barSeconds(std::string_view barSize) {
+    const long long count = std::max(1LL, std::atoll(std::string(barSize).c_str()));
+    const std::size_t space = barSize.find(' ');
+    const std::string_view unit = space == std::string_view::npos ? std::string_view() : barSize.substr(space + 1);
+    if (unit.rfind("sec", 0) == 0) {
+        return count;
+    }
+    if (unit.rfind("hour", 0) == 0) {
+        return count * 3600;
+    }
+    if (unit.rfind("day", 0) == 0) {
+        return count * 86400;
+    }
+    if (unit.rfind("week", 0) == 0) {
+        return count * 7 * 86400;
+    }
+    return count * 60;
+}
+
+// ========== One API connection ==========
+// REASON: One thread per connection, like TWS - the bridge's multi-client mode opens several
+class Session {
+public:
+    Session(int fd, std::size_t id, const Options& options)
+        : m_fd(fd)
+        , m_id(id)
+        , m_options(options)
+        , m_writer(options.serverVersion)
+        , m_rng(static_cast<std::uint32_t>(42 + id))
+        , m_resetsSeen(g_resets.load())
+        , m_outagesSeen(g_outages.load()) {}
+
+    void run() {
+        if (handshake()) {
+            loop();
+        }
+        report();
+        ::close(m_fd);
+    }
+
+private:
+    enum class Feed : std::uint8_t { Quote, Trade, Level1, Bars };
+
+    struct Instrument {
+        std::string symbol;
+        double price = 100.0;
+        int quoteReqId = -1;                        // Tick-by-tick BidAsk / MidPoint
+        bool midPoint = false;
+        int tradeReqId = -1;                        // Tick-by-tick AllLast / Last
+        bool last = false;
+        int level1ReqId = -1;                       // reqMktData
+        int barReqId = -1;                          // reqRealTimeBars
+        bool streaming() const { return quoteReqId >= 0 || tradeReqId >= 0 || level1ReqId >= 0; }
+    };
+
+    // ========== Requests ==========
+    bool handshake() {
+        // Client: "API\0" + framed "v100..203" (+ connect options)
+        std::size_t framed = 0;
+        while (g_running.load()) {
+            if (m_in.size() >= 8 && m_in.compare(0, 4, std::string("API\0", 4)) == 0) {
+                const std::uint32_t length = readInt32(m_in.data() + 4);
+                if (m_in.size() >= 8 + length) {
+                    framed = 8 + length;
+                    break;
+                }
+            }
+            if (!receive(100)) {
+                return false;
+            }
+        }
+        if (framed == 0) {
+            return false;
+        }
+        std::cout << "[FAKE] Connection " << m_id << ": client offers " << m_in.substr(4 + 4, framed - 8).c_str()
+                  << ", server version " << m_options.serverVersion << "\n";
+        m_in.erase(0, framed);
+
+        // Server: framed "<version>\0<time>\0" - the only message without a message id
+        char now[32];
+        const std::time_t seconds = std::time(nullptr);
+        std::tm utc{};
+        ::gmtime_r(&seconds, &utc);
+        std::strftime(now, sizeof(now), "%Y%m%d %H:%M:%S UTC", &utc);
+        std::string& out = m_writer.buffer();
+        const std::string version = std::to_string(m_options.serverVersion);
+        const auto length = static_cast<std::uint32_t>(version.size() + 1 + std::strlen(now) + 1);
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((length >> shift) & 0xFF));
+        }
+        out.append(version).push_back('\0');
+        out.append(now).push_back('\0');
+        return flush();
+    }
+
+    // Splits complete frames off m_in and answers them
+    void handleFrames() {
+        std::size_t offset = 0;
+        std::vector<std::string_view> fields;
+        while (m_in.size() - offset >= 4) {
+            const std::uint32_t length = readInt32(m_in.data() + offset);
+            if (m_in.size() - offset - 4 < length) {
+                break;
+            }
+            const char* payload = m_in.data() + offset + 4;
+            const char* payloadEnd = payload + length;
+            offset += 4 + length;
+
+            int msgId = 0;
+            const char* cursor = payload;
+            if (m_options.serverVersion >= MIN_SERVER_VER_PROTOBUF) {
+                if (length < 4) {
+                    continue;
+                }
+                msgId = static_cast<int>(readInt32(payload));
+                cursor += 4;
+            }
+            fields.clear();
+            while (cursor < payloadEnd) {
+                const char* terminator = static_cast<const char*>(std::memchr(cursor, '\0', payloadEnd - cursor));
+                const char* fieldEnd = terminator != nullptr ? terminator : payloadEnd;
+                fields.emplace_back(cursor, static_cast<std::size_t>(fieldEnd - cursor));
+                cursor = fieldEnd + 1;
+            }
+            if (m_options.serverVersion < MIN_SERVER_VER_PROTOBUF) {
+                if (fields.empty()) {
+                    continue;
+                }
+                msgId = std::atoi(std::string(fields.front()).c_str());
+                fields.erase(fields.begin());
+            }
+            handle(msgId, fields);
+        }
+        m_in.erase(0, offset);
+    }
+
+    static int intField(const std::vector<std::string_view>& fields, std::size_t index) {
+        return index < fields.size() ? std::atoi(std::string(fields[index]).c_str()) : 0;
+    }
+    static std::string_view textField(const std::vector<std::string_view>& fields, std::size_t index) {
+        return index < fields.size() ? fields[index] : std::string_view();
+    }
+
+    // NOTE: Field positions follow EClient's encoding for server versions 196..203
+    void handle(int msgId, const std::vector<std::string_view>& fields) {
+        ++m_requests;
+        switch (msgId) {
+        case START_API:
+            sendNextValidId();
+            m_writer.begin(MANAGED_ACCTS).field(1).field("DU0000000").end();
+            return;
+        case REQ_IDS:
+            sendNextValidId();
+            return;
+        case REQ_TICK_BY_TICK_DATA: {
+            // reqId, contract (conId, symbol, ... tradingClass), tickType, numberOfTicks, ignoreSize
+            Instrument& instrument = instrumentFor(textField(fields, 2));
+            const std::string_view type = textField(fields, 13);
+            if (type == "BidAsk" || type == "MidPoint") {
+                instrument.quoteReqId = intField(fields, 0);
+                instrument.midPoint = type == "MidPoint";
+            } else {
+                instrument.tradeReqId = intField(fields, 0);
+                instrument.last = type == "Last";
+            }
+            subscribed();
+            return;
+        }
+        case CANCEL_TICK_BY_TICK_DATA:
+            cancel(intField(fields, 0));
+            return;
+        case REQ_MKT_DATA:
+            // version, tickerId, contract (conId, symbol, ...)
+            instrumentFor(textField(fields, 3)).level1ReqId = intField(fields, 1);
+            subscribed();
+            return;
+        case CANCEL_MKT_DATA:
+            cancel(intField(fields, 1));
+            return;
+        case REQ_REAL_TIME_BARS:
+            // version, tickerId, contract (conId, symbol, ...)
+            instrumentFor(textField(fields, 3)).barReqId = intField(fields, 1);
+            subscribed();
+            return;
+        case CANCEL_REAL_TIME_BARS:
+            cancel(intField(fields, 1));
+            return;
+        case REQ_HISTORICAL_DATA:
+            // tickerId, contract (conId, symbol, ... includeExpired), endDateTime, barSize, duration, useRTH,
+            // whatToShow, formatDate
+            sendHistory(intField(fields, 0), instrumentFor(textField(fields, 2)), textField(fields, 15),
+                        intField(fields, 19));
+            return;
+        case REQ_CONTRACT_DATA:
+            // REASON: Empty answer - the bridge then subscribes by symbol, as on a lookup miss
+            m_writer.begin(CONTRACT_DATA_END).field(1).field(intField(fields, 1)).end();
+            return;
+        default:
+            --m_requests;
+            ++m_ignored;
+            return;
+        }
+    }
+
+    void sendNextValidId() { m_writer.begin(NEXT_VALID_ID).field(1).field(m_nextOrderId++).end(); }
+
+    // System message (id -1): 1100 connectivity lost, 1101 / 1102 restored
+    void sendError(int code, std::string_view text) {
+        m_writer.begin(ERR_MSG);
+        if (m_options.serverVersion < MIN_SERVER_VER_ERROR_TIME) {
+            m_writer.field(2);
+        }
+        m_writer.field(-1).field(code).field(text);
+        if (m_options.serverVersion >= MIN_SERVER_VER_ADVANCED_ORDER_REJECT) {
+            m_writer.field("");
+        }
+        if (m_options.serverVersion >= MIN_SERVER_VER_ERROR_TIME) {
+            m_writer.field(static_cast<long long>(
+                duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()));
+        }
+        m_writer.end();
+    }
+
+    Instrument& instrumentFor(std::string_view symbol) {
+        const auto it = m_bySymbol.find(std::string(symbol));
+        if (it != m_bySymbol.end()) {
+            return m_instruments[it->second];
+        }
+        m_bySymbol.emplace(std::string(symbol), m_instruments.size());
+        Instrument instrument;
+        instrument.symbol = std::string(symbol);
+        // Distinct, stable start price per symbol (20..500)
+        instrument.price = 20.0 + static_cast<double>(std::hash<std::string>{}(instrument.symbol) % 48000) / 100.0;
+        m_instruments.push_back(std::move(instrument));
+        return m_instruments.back();
+    }
+
+    void cancel(int reqId) {
+        for (Instrument& instrument : m_instruments) {
+            for (int* id : {&instrument.quoteReqId, &instrument.tradeReqId, &instrument.level1ReqId,
+                            &instrument.barReqId}) {
+                if (*id == reqId) {
+                    *id = -1;
+                }
+            }
+        }
+    }
+
+    // REASON: The schedule starts at the first subscription - nothing is owed for the handshake time
+    void subscribed() {
+        if (m_streamStart == steady_clock::time_point{}) {
+            m_streamStart = steady_clock::now();
+            m_nextBar = m_streamStart + seconds(m_options.barIntervalSeconds);
+            if (!m_options.journalDirectory.empty()) {
+                openJournal();
+            }
+        }
+    }
+
+    // ========== Market data ==========
+    void sendQuote(Instrument& instrument, long long time, double bid, double ask, Quantity bidSize, Quantity askSize) {
+        if (m_dark) {
+            ++m_withheld;
+            return;
+        }
+        if (instrument.quoteReqId >= 0) {
+            m_writer.begin(TICK_BY_TICK).field(instrument.quoteReqId).field(instrument.midPoint ? 4 : 3).field(time);
+            if (instrument.midPoint) {
+                m_writer.field((bid + ask) / 2.0).end();
+            } else {
+                m_writer.field(bid).field(ask).field(bidSize).field(askSize).field(0).end();
+            }
+        } else if (instrument.level1ReqId >= 0) {
+            // TICK_PRICE version 6: tickerId, tickType (1 bid, 2 ask), price, size, attrMask
+            m_writer.begin(TICK_PRICE).field(6).field(instrument.level1ReqId).field(1).field(bid).field(bidSize).field(0).end();
+            m_writer.begin(TICK_PRICE).field(6).field(instrument.level1ReqId).field(2).field(ask).field(askSize).field(0).end();
+        } else {
+            return;
+        }
+        ++m_ticks;
+    }
+
+    void sendTrade(Instrument& instrument, long long time, double price, Quantity size, std::string_view exchange) {
+        if (m_dark) {
+            ++m_withheld;
+            return;
+        }
+        if (instrument.tradeReqId >= 0) {
+            m_writer.begin(TICK_BY_TICK).field(instrument.tradeReqId).field(instrument.last ? 1 : 2).field(time)
+                .field(price).field(size).field(0).field(exchange).field("").end();
+        } else if (instrument.level1ReqId >= 0) {
+            m_writer.begin(TICK_PRICE).field(6).field(instrument.level1ReqId).field(4).field(price).field(size).field(0).end();
+        } else {
+            return;
+        }
+        ++m_ticks;
+    }
+
+    void sendBar(int reqId, long long time, double open, double high, double low, double close, long long volume,
+                 double wap, int count) {
+        if (m_dark) {
+            return;
+        }
+        m_writer.begin(REAL_TIME_BARS).field(3).field(reqId).field(time).field(open).field(high).field(low).field(close)
+            .field(volume).field(wap).field(count).end();
+        ++m_bars;
+    }
+
+    // One synthetic tick: random walk, trade or quote per --trades on instruments that have both
+    void syntheticTick(long long time) {
+        Instrument& instrument = m_instruments[m_cursor++ % m_instruments.size()];
+        if (!instrument.streaming()) {
+            return;
+        }
+        std::uniform_int_distribution<int> drift(-5, 5);
+        instrument.price = std::max(1.0, instrument.price + drift(m_rng) * 0.01);
+        const bool hasQuotes = instrument.quoteReqId >= 0 || instrument.level1ReqId >= 0;
+        const bool hasTrades = instrument.tradeReqId >= 0 || instrument.level1ReqId >= 0;
+        const bool trade = hasTrades && (!hasQuotes || m_percent(m_rng) < m_options.tradesPercent);
+        if (trade) {
+            sendTrade(instrument, time, instrument.price, Quantity{100, 0}, "NYSE");
+        } else {
+            sendQuote(instrument, time, instrument.price - 0.01, instrument.price + 0.01, Quantity{200, 0}, Quantity{300, 0});
+        }
+    }
+
+    void syntheticBars(steady_clock::time_point now, long long time) {
+        while (now >= m_nextBar) {
+            m_nextBar += seconds(m_options.barIntervalSeconds);
+            for (Instrument& instrument : m_instruments) {
+                if (instrument.barReqId >= 0) {
+                    const double p = instrument.price;
+                    sendBar(instrument.barReqId, time, p, p + 0.05, p - 0.05, p, 1000, p, 10);
+                }
+            }
+        }
+    }
+
+    void sendHistory(int reqId, const Instrument& instrument, std::string_view barSize, int formatDate) {
+        const long long step = barSeconds(barSize);
+        const long long end = static_cast<long long>(std::time(nullptr)) / step * step;
+        const long long start = end - step * m_options.historyBars;
+        auto dateText = [formatDate](long long seconds) {
+            if (formatDate == 2) {
+                return std::to_string(seconds);
+            }
+            char text[32];
+            const std::time_t value = static_cast<std::time_t>(seconds);
+            std::tm utc{};
+            ::gmtime_r(&value, &utc);
+            std::strftime(text, sizeof(text), "%Y%m%d %H:%M:%S UTC", &utc);
+            return std::string(text);
+        };
+        m_writer.begin(HISTORICAL_DATA).field(reqId).field(m_options.historyBars);
+        double price = instrument.price;
+        std::uniform_int_distribution<int> drift(-20, 20);
+        for (int i = 0; i < m_options.historyBars; ++i) {
+            const double open = price;
+            price = std::max(1.0, price + drift(m_rng) * 0.01);
+            m_writer.field(dateText(start + step * i)).field(open).field(std::max(open, price) + 0.02)
+                .field(std::min(open, price) - 0.02).field(price).field(1000LL + i).field((open + price) / 2.0)
+                .field(25);
+        }
+        m_writer.end();
+        m_writer.begin(HISTORICAL_DATA_END).field(reqId).field(dateText(start)).field(dateText(end)).end();
+        ++m_historyRequests;
+    }
+
+    // ========== Recorded ticks ==========
+    void openJournal() {
+        m_segments = TickJournalReader::segments(m_options.journalDirectory);
+        m_segment = 0;
+        m_journalOpen = false;
+        if (m_segments.empty()) {
+            std::cerr << "[FAKE] No journal segments in " << m_options.journalDirectory << "\n";
+        }
+    }
+
+    // Next journal tick (Symbol records only update the slot map), false at the end of the session
+    bool nextJournalTick(JournalEntry& entry) {
+        while (m_segment < m_segments.size()) {
+            if (!m_journalOpen) {
+                m_journalOpen = m_reader.open(m_segments[m_segment]);
+                m_slotSymbols.clear();  // NOTE: Every segment repeats its Symbol records
+                if (!m_journalOpen) {
+                    ++m_segment;
+                    continue;
+                }
+            }
+            if (!m_reader.next(entry)) {
+                m_reader.close();
+                m_journalOpen = false;
+                ++m_segment;
+                continue;
+            }
+            if (entry.kind == JournalRecordKind::Symbol) {
+                if (entry.slot >= m_slotSymbols.size()) {
+                    m_slotSymbols.resize(static_cast<std::size_t>(entry.slot) + 1);
+                }
+                m_slotSymbols[entry.slot] = entry.symbol;
+                continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void sendRecorded(const JournalEntry& entry) {
+        const TickUpdate& update = entry.update;
+        if (update.slot >= m_slotSymbols.size()) {
+            return;
+        }
+        const auto it = m_bySymbol.find(m_slotSymbols[update.slot]);
+        if (it == m_bySymbol.end()) {
+            return;  // Not subscribed on this connection
+        }
+        Instrument& instrument = m_instruments[it->second];
+        const long long time = update.timestamp / 1000;
+        switch (update.type) {
+        case TickUpdateType::BidAsk:
+            sendQuote(instrument, time, update.bidAsk.bidPrice, update.bidAsk.askPrice, update.bidQuantity(),
+                      update.askQuantity());
+            break;
+        case TickUpdateType::AllLast:
+            sendTrade(instrument, time, update.allLast.price, update.tradeQuantity(),
+                      exchangeName(static_cast<ExchangeCode>(update.allLast.exchange)));
+            break;
+        case TickUpdateType::Bar:
+            if (instrument.barReqId >= 0) {
+                sendBar(instrument.barReqId, time, update.bar.open, update.bar.high, update.bar.low, update.bar.close,
+                        update.bar.volume, update.bar.wap, static_cast<int>(update.aux));
+            }
+            break;
+        default:
+            break;  // Depth / history markers are not replayed
+        }
+    }
+
+    // ========== Loop ==========
+    // PERFORMANCE: Absolute schedule - everything due is written in one send, a late step is not
+    // skipped (the average rate holds); a slow reader blocks send(), as a full TWS socket would
+    void loop() {
+        const std::size_t step = m_options.burst ? m_options.burstSize : 1;
+        const double stepSeconds = m_options.rate > 0 ? static_cast<double>(step) / m_options.rate : 0.0;
+        const bool recorded = !m_options.journalDirectory.empty();
+        JournalEntry entry;
+        bool havePending = false;
+        std::int64_t journalBaseNs = 0;
+        std::uint64_t steps = 0;
+
+        while (g_running.load()) {
+            const auto now = steady_clock::now();
+            const bool streaming = m_streamStart != steady_clock::time_point{} && !m_instruments.empty();
+            if (streaming && m_options.duration > 0
+                && now - m_streamStart >= duration_cast<steady_clock::duration>(duration<double>(m_options.duration))) {
+                std::cout << "[FAKE] Connection " << m_id << ": --duration reached, closing\n";
+                return;
+            }
+            if (!injectFaults(now)) {
+                return;
+            }
+            const long long epochSeconds = static_cast<long long>(std::time(nullptr));
+
+            // REASON: Bounded work per pass - requests (cancels) are still read under full load
+            std::size_t budget = 8192;
+            steady_clock::time_point nextDue = now + milliseconds(50);
+            if (streaming && recorded) {
+                while (budget > 0) {
+                    if (!havePending) {
+                        havePending = nextJournalTick(entry);
+                        if (!havePending) {
+                            break;
+                        }
+                        if (journalBaseNs == 0) {
+                            journalBaseNs = entry.receiveNs;
+                        }
+                    }
+                    const auto due = m_options.speed > 0
+                        ? m_streamStart + duration_cast<steady_clock::duration>(
+                              nanoseconds(static_cast<std::int64_t>((entry.receiveNs - journalBaseNs) / m_options.speed)))
+                        : now;
+                    if (due > now) {
+                        nextDue = std::min(nextDue, due);
+                        break;
+                    }
+                    sendRecorded(entry);
+                    havePending = false;
+                    --budget;
+                }
+                if (budget == 0) {
+                    nextDue = now;
+                }
+            } else if (streaming) {
+                while (budget > 0) {
+                    const auto due = m_streamStart + duration_cast<steady_clock::duration>(
+                                                         duration<double>(static_cast<double>(steps) * stepSeconds));
+                    if (due > now) {
+                        nextDue = std::min(nextDue, due);
+                        break;
+                    }
+                    for (std::size_t i = 0; i < step; ++i) {
+                        syntheticTick(epochSeconds);
+                    }
+                    ++steps;
+                    budget = budget > step ? budget - step : 0;
+                }
+                if (budget == 0) {
+                    nextDue = now;
+                }
+                syntheticBars(now, epochSeconds);
+                nextDue = std::min(nextDue, m_nextBar);
+            }
+            if (!flush()) {
+                return;
+            }
+            const auto wait = duration_cast<nanoseconds>(nextDue - steady_clock::now());
+            if (!receive(std::max<std::int64_t>(wait.count(), 0) / 1000000)) {
+                return;
+            }
+            handleFrames();
+            if (!flush()) {
+                return;
+            }
+        }
+    }
+
+    // ========== Faults ==========
+    // False once the connection is to be reset (run() closes it with SO_LINGER 0 → RST)
+    // NOTE: Withheld ticks keep the schedule moving - the feed resumes at the rate it left off, without a
+    // catch-up burst (TWS does not replay what it never sent)
+    bool injectFaults(steady_clock::time_point now) {
+        if (g_resets.load() != m_resetsSeen) {
+            const linger reset{1, 0};
+            ::setsockopt(m_fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+            std::cout << "[FAKE] Connection " << m_id << ": reset (SIGUSR1)\n";
+            return false;
+        }
+        if (g_outages.load() != m_outagesSeen) {
+            m_outagesSeen = g_outages.load();
+            if (!m_dark) {
+                sendError(1100, "Connectivity between IB and Trader Workstation has been lost.");
+                if (m_options.restoreCode == 1101) {
+                    for (Instrument& instrument : m_instruments) {
+                        instrument.quoteReqId = instrument.tradeReqId = instrument.level1ReqId = instrument.barReqId = -1;
+                    }
+                }
+                m_dark = true;
+                m_withheld = 0;
+                std::cout << "[FAKE] Connection " << m_id << ": error 1100, no data for " << m_options.outage << " s\n";
+            }
+            m_outageEnd = now + duration_cast<steady_clock::duration>(duration<double>(m_options.outage));
+        }
+        if (m_dark && now >= m_outageEnd) {
+            m_dark = false;
+            sendError(m_options.restoreCode, m_options.restoreCode == 1101
+                ? "Connectivity between IB and Trader Workstation has been restored - data lost."
+                : "Connectivity between IB and Trader Workstation has been restored - data maintained.");
+            std::cout << "[FAKE] Connection " << m_id << ": error " << m_options.restoreCode << ", " << m_withheld
+                      << " ticks withheld\n";
+        }
+        return true;
+    }
+
+    // Waits up to timeoutMs for input and appends it, false once the client disconnected
+    bool receive(std::int64_t timeoutMs) {
+        pollfd connection{m_fd, POLLIN, 0};
+        const int ready = ::poll(&connection, 1, static_cast<int>(timeoutMs));
+        if (ready <= 0) {
+            return ready == 0 || errno == EINTR;
+        }
+        char buffer[65536];
+        const ssize_t received = ::recv(m_fd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            return false;
+        }
+        m_in.append(buffer, static_cast<std::size_t>(received));
+        return true;
+    }
+
+    bool flush() {
+        std::string& out = m_writer.buffer();
+        std::size_t sent = 0;
+        while (sent < out.size()) {
+            const ssize_t written = ::send(m_fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                out.clear();
+                return false;
+            }
+            sent += static_cast<std::size_t>(written);
+        }
+        m_bytes += sent;
+        out.clear();
+        return true;
+    }
+
+    void report() const {
+        const double seconds = m_streamStart != steady_clock::time_point{}
+            ? duration<double>(steady_clock::now() - m_streamStart).count() : 0.0;
+        std::cout << "[FAKE] Connection " << m_id << " closed: " << m_instruments.size() << " symbols, " << m_ticks
+                  << " ticks (" << static_cast<long long>(seconds > 0 ? m_ticks / seconds : 0.0) << "/s), " << m_bars
+                  << " bars, " << m_historyRequests << " history requests, " << m_writer.messages() << " messages, "
+                  << m_bytes / 1024 << " KiB sent, " << m_requests << " requests (" << m_ignored << " ignored)\n";
+    }
+
+    int m_fd;
+    std::size_t m_id;
+    const Options& m_options;
+    MessageWriter m_writer;
+    std::string m_in;
+    std::mt19937 m_rng;
+    std::uniform_int_distribution<int> m_percent{0, 99};
+
+    std::vector<Instrument> m_instruments;
+    std::unordered_map<std::string, std::size_t> m_bySymbol;
+    std::size_t m_cursor = 0;
+    int m_nextOrderId = 1;
+    steady_clock::time_point m_streamStart{};
+    steady_clock::time_point m_nextBar{};
+    std::uint32_t m_resetsSeen;
+    std::uint32_t m_outagesSeen;
+    bool m_dark = false;                            // Inside a SIGUSR2 outage
+    steady_clock::time_point m_outageEnd{};
+    std::uint64_t m_withheld = 0;                   // Ticks not sent during the current / last outage
+
+    std::vector<std::string> m_segments;
+    std::size_t m_segment = 0;
+    bool m_journalOpen = false;
+    TickJournalReader m_reader;
+    std::vector<std::string> m_slotSymbols;         // Journal slot → symbol, current segment
+
+    std::uint64_t m_ticks = 0;
+    std::uint64_t m_bars = 0;
+    std::uint64_t m_historyRequests = 0;
+    std::uint64_t m_requests = 0;
+    std::uint64_t m_ignored = 0;
+    std::uint64_t m_bytes = 0;
+};
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGUSR1, onFault);
+    std::signal(SIGUSR2, onFault);
+
+    const int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    const int reuse = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+    ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listenFd, 16) != 0) {
+        std::cerr << "Cannot listen on 127.0.0.1:" << options.port << "\n";
+        return 1;
+    }
+
+    std::cout << "=== Fake TWS ===\n";
+    std::cout << "Port: " << options.port << " | Server version: " << options.serverVersion << " | Feed: "
+              << (options.journalDirectory.empty()
+                      ? (options.rate > 0 ? std::to_string(static_cast<long long>(options.rate)) + " ticks/s" : "max")
+                            + (options.burst ? " burst x" + std::to_string(options.burstSize) : " steady")
+                            + ", " + std::to_string(options.tradesPercent) + "% trades"
+                      : "journal " + options.journalDirectory + " x" + std::to_string(options.speed))
+              << "\n";
+
+    std::vector<std::thread> sessions;
+    std::size_t nextId = 1;
+    while (g_running.load()) {
+        pollfd listener{listenFd, POLLIN, 0};
+        if (::poll(&listener, 1, 100) <= 0) {
+            continue;
+        }
+        const int client = ::accept(listenFd, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        // PERFORMANCE: No Nagle delay - TWS streams small messages as they happen
+        const int noDelay = 1;
+        ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        const std::size_t id = nextId++;
+        sessions.emplace_back([client, id, &options]() { Session(client, id, options).run(); });
+    }
+    for (auto& session : sessions) {
+        session.join();
+    }
+    ::close(listenFd);
+    return 0;
+}
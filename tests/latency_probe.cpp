@@ -0,0 +1,342 @@
+// latency_probe.cpp - End-to-end delivery probe: subscribes to the bridge's Redis channels like a consumer
+// and measures bridge → consumer latency from the "sent" stamp (worker.send_timestamps) of each snapshot
+// OBJECTIVE: Reproducible TWS → consumer benchmark together with fake_tws (compare schemas, batching
+// modes, delta / aggregate output, sinks) - per-channel rates, latency percentiles, sequence gaps
+//
+// Usage: latency_probe [options]
+//   --redis URI        Redis to subscribe on (default tcp://127.0.0.1:6379)
+//   --pattern P        Channel pattern, repeatable (default TWS:TICKS:*)
+//   --interval S       Report period in seconds (default 5)
+//   --duration S       Stop after S seconds, 0 = until Ctrl-C (default 0)
+//   --top N            Busiest channels listed per report (default 10)
+//   --csv PATH         Also write one row per channel and interval (plus "*" = all channels)
+//   --max-p99-us N     Fail (exit 2) if the lifetime p99 exceeds N μs
+//
+// PITFALL: "sent" is the bridge host's wall clock - across hosts the result includes their clock offset
+// (PTP / chrony keep it in the μs range); negative latencies are counted as skewed and recorded as 0
+
+#include "LatencyHistogram.h"
+#include <sw/redis++/redis++.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+
+static volatile std::sig_atomic_t g_stop = 0;
+
+static void onSignal(int) {
+    g_stop = 1;
+}
+
+// ========== Options ==========
+struct Options {
+    std::string redisUri = "tcp://127.0.0.1:6379";
+    std::vector<std::string> patterns;
+    double interval = 5.0;
+    double duration = 0.0;
+    std::size_t top = 10;
+    std::string csvPath;
+    double maxP99Us = 0.0;
+};
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (flag == "--redis") {
+            options.redisUri = value;
+        } else if (flag == "--pattern") {
+            options.patterns.push_back(value);
+        } else if (flag == "--interval") {
+            options.interval = std::max(0.1, std::stod(value));
+        } else if (flag == "--duration") {
+            options.duration = std::stod(value);
+        } else if (flag == "--top") {
+            options.top = std::stoul(value);
+        } else if (flag == "--csv") {
+            options.csvPath = value;
+        } else if (flag == "--max-p99-us") {
+            options.maxP99Us = std::stod(value);
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    if (options.patterns.empty()) {
+        options.patterns.push_back("TWS:TICKS:*");
+    }
+    return true;
+}
+
+// ========== Payload scan ==========
+// Integer after the first `key` at or after `from` → position after the number (npos: no such key)
+// REASON: No JSON parse - the probe must stay cheaper than the bridge it measures
+static std::size_t findNumber(std::string_view payload, std::string_view key, std::size_t from, std::int64_t& value) {
+    const std::size_t at = payload.find(key, from);
+    if (at == std::string_view::npos) {
+        return std::string_view::npos;
+    }
+    std::size_t cursor = at + key.size();
+    const bool negative = cursor < payload.size() && payload[cursor] == '-';
+    cursor += negative ? 1 : 0;
+    std::int64_t number = 0;
+    while (cursor < payload.size() && payload[cursor] >= '0' && payload[cursor] <= '9') {
+        number = number * 10 + (payload[cursor] - '0');
+        ++cursor;
+    }
+    value = negative ? -number : number;
+    return cursor;
+}
+
+struct ChannelStats {
+    LatencySnapshot interval;                       // Reset every report
+    std::uint64_t messages = 0;                     // Interval
+    std::uint64_t totalMessages = 0;
+    std::uint64_t snapshots = 0;                    // Interval, stamped snapshots (an aggregate payload holds many)
+    std::uint64_t gaps = 0;                         // Interval, "seq" jumps (messages Redis dropped or never sent)
+    std::uint64_t lastSequence = 0;
+};
+
+class Probe {
+public:
+    explicit Probe(const Options& options) : m_options(options) {
+        if (!options.csvPath.empty()) {
+            m_csv.open(options.csvPath, std::ios::trunc);
+            m_csv << "elapsed_s,channel,messages,rate,snapshots,p50_us,p99_us,p999_us,max_us,gaps\n";
+        }
+        m_start = steady_clock::now();
+        m_lastReport = m_start;
+    }
+
+    bool csvOk() const { return m_options.csvPath.empty() || m_csv.good(); }
+
+    void onMessage(const std::string& channel, const std::string& payload) {
+        const std::int64_t nowNs = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+        ChannelStats& stats = m_channels[channel];
+        ++stats.messages;
+        ++stats.totalMessages;
+        ++m_all.messages;
+        const std::string_view view(payload);
+
+        // One "sent" per snapshot: a plain snapshot has one, an aggregate array one per element
+        std::size_t cursor = 0;
+        bool stamped = false;
+        for (const std::string_view key : {std::string_view("\"sent\":"), std::string_view("\"sn\":")}) {
+            std::int64_t sentNs = 0;
+            while ((cursor = findNumber(view, key, cursor, sentNs)) != std::string_view::npos) {
+                std::int64_t latencyNs = nowNs - sentNs;
+                if (latencyNs < 0) {
+                    ++m_skewed;
+                    latencyNs = 0;
+                }
+                const std::size_t bucket = LatencySnapshot::bucketOf(latencyNs);
+                ++stats.interval.counts[bucket];
+                ++m_all.interval.counts[bucket];
+                ++m_lifetime.counts[bucket];
+                ++stats.snapshots;
+                ++m_all.snapshots;
+                stamped = true;
+            }
+            if (stamped) {
+                break;
+            }
+            cursor = 0;
+        }
+        if (!stamped) {
+            ++m_unstamped;  // NOTE: Binary / LZ4 payloads and send_timestamps off land here
+        }
+
+        // Per-symbol channels carry one sequence (full snapshots and deltas alike)
+        if (!view.empty() && view.front() == '{') {
+            std::int64_t sequence = 0;
+            if (findNumber(view, "\"seq\":", 0, sequence) != std::string_view::npos
+                || findNumber(view, "\"sq\":", 0, sequence) != std::string_view::npos) {
+                const auto value = static_cast<std::uint64_t>(sequence);
+                if (stats.lastSequence != 0 && value > stats.lastSequence + 1) {
+                    stats.gaps += value - stats.lastSequence - 1;
+                    m_all.gaps += value - stats.lastSequence - 1;
+                }
+                stats.lastSequence = std::max(stats.lastSequence, value);
+            }
+        }
+    }
+
+    // Prints (and writes) the interval when due, true once --duration is over
+    bool tick() {
+        const auto now = steady_clock::now();
+        if (now - m_lastReport >= duration_cast<steady_clock::duration>(duration<double>(m_options.interval))) {
+            report(now);
+        }
+        return m_options.duration > 0
+            && now - m_start >= duration_cast<steady_clock::duration>(duration<double>(m_options.duration));
+    }
+
+    // Lifetime summary, returns the exit code (2 = --max-p99-us exceeded)
+    int finish() {
+        report(steady_clock::now());
+        const LatencyReport::Stage stage = LatencyReport::summarize(m_lifetime);
+        const double seconds = duration<double>(steady_clock::now() - m_start).count();
+        std::uint64_t messages = 0;
+        for (const auto& entry : m_channels) {
+            messages += entry.second.totalMessages;
+        }
+        std::cout << "\n=== Lifetime (" << std::fixed << std::setprecision(1) << seconds << " s, "
+                  << m_channels.size() << " channels) ===\n"
+                  << "  messages " << messages << " (" << static_cast<long long>(seconds > 0 ? messages / seconds : 0)
+                  << "/s) | snapshots " << stage.count << " | unstamped " << m_unstamped << " | skewed "
+                  << m_skewed << "\n";
+        printLatency("  sent → here", stage);
+        if (stage.count == 0) {
+            std::cout << "  (no \"sent\" stamps - enable worker.send_timestamps on the bridge)\n";
+        }
+        if (m_options.maxP99Us > 0 && stage.p99 / 1000.0 > m_options.maxP99Us) {
+            std::cout << "FAIL: p99 " << stage.p99 / 1000.0 << " μs > " << m_options.maxP99Us << " μs\n";
+            return 2;
+        }
+        return 0;
+    }
+
+private:
+    static void printLatency(const std::string& name, const LatencyReport::Stage& stage) {
+        std::cout << name << std::fixed << std::setprecision(1)
+                  << " | p50 " << std::setw(9) << stage.p50 / 1000.0 << " μs"
+                  << " | p99 " << std::setw(9) << stage.p99 / 1000.0 << " μs"
+                  << " | p99.9 " << std::setw(9) << stage.p999 / 1000.0 << " μs"
+                  << " | max " << std::setw(9) << stage.max / 1000.0 << " μs\n";
+    }
+
+    void writeCsv(double elapsed, const std::string& channel, const ChannelStats& stats, double seconds) {
+        const LatencyReport::Stage stage = LatencyReport::summarize(stats.interval);
+        m_csv << std::fixed << std::setprecision(3) << elapsed << ',' << channel << ',' << stats.messages << ','
+              << stats.messages / seconds << ',' << stats.snapshots << ',' << stage.p50 / 1000.0 << ','
+              << stage.p99 / 1000.0 << ',' << stage.p999 / 1000.0 << ',' << stage.max / 1000.0 << ','
+              << stats.gaps << '\n';
+    }
+
+    void report(steady_clock::time_point now) {
+        const double seconds = std::max(1e-9, duration<double>(now - m_lastReport).count());
+        const double elapsed = duration<double>(now - m_start).count();
+        m_lastReport = now;
+
+        std::cout << "[PROBE] " << std::fixed << std::setprecision(1) << elapsed << " s | " << m_all.messages
+                  << " msgs (" << static_cast<long long>(m_all.messages / seconds) << "/s) | snapshots "
+                  << m_all.snapshots << " | gaps " << m_all.gaps << "\n";
+        printLatency("  all channels     ", LatencyReport::summarize(m_all.interval));
+
+        std::vector<std::pair<const std::string*, ChannelStats*>> busiest;
+        for (auto& entry : m_channels) {
+            if (entry.second.messages > 0) {
+                busiest.emplace_back(&entry.first, &entry.second);
+            }
+        }
+        std::sort(busiest.begin(), busiest.end(),
+                  [](const auto& a, const auto& b) { return a.second->messages > b.second->messages; });
+        for (std::size_t i = 0; i < std::min(m_options.top, busiest.size()); ++i) {
+            const ChannelStats& stats = *busiest[i].second;
+            std::cout << "  " << std::left << std::setw(24) << *busiest[i].first << std::right << std::setw(8)
+                      << static_cast<long long>(stats.messages / seconds) << "/s";
+            if (stats.gaps > 0) {
+                std::cout << " (" << stats.gaps << " gaps)";
+            }
+            printLatency("", LatencyReport::summarize(stats.interval));
+        }
+
+        if (m_csv.is_open()) {
+            writeCsv(elapsed, "*", m_all, seconds);
+            for (const auto& entry : busiest) {
+                writeCsv(elapsed, *entry.first, *entry.second, seconds);
+            }
+            m_csv.flush();
+        }
+
+        // Next interval
+        for (auto& entry : busiest) {
+            ChannelStats& stats = *entry.second;
+            stats.interval.counts.fill(0);
+            stats.messages = 0;
+            stats.snapshots = 0;
+            stats.gaps = 0;
+        }
+        m_all.interval.counts.fill(0);
+        m_all.messages = 0;
+        m_all.snapshots = 0;
+        m_all.gaps = 0;
+    }
+
+    const Options& m_options;
+    // NOTE: std::map - channels appear once, iteration order keeps the CSV stable between runs
+    std::map<std::string, ChannelStats> m_channels;
+    ChannelStats m_all;
+    LatencySnapshot m_lifetime;
+    std::uint64_t m_unstamped = 0;
+    std::uint64_t m_skewed = 0;
+    std::ofstream m_csv;
+    steady_clock::time_point m_start;
+    steady_clock::time_point m_lastReport;
+};
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::cout << "=== Latency Probe ===\n";
+    std::cout << "Redis: " << options.redisUri << " | Patterns:";
+    for (const std::string& pattern : options.patterns) {
+        std::cout << " " << pattern;
+    }
+    std::cout << " | Interval: " << options.interval << " s\n\n";
+
+    Probe probe(options);
+    if (!probe.csvOk()) {
+        std::cerr << "Cannot write " << options.csvPath << "\n";
+        return 1;
+    }
+    try {
+        sw::redis::ConnectionOptions connection(options.redisUri);
+        // REASON: consume() returns at least every 100 ms - reports and Ctrl-C stay on time when idle
+        connection.socket_timeout = milliseconds(100);
+        sw::redis::Redis redis(connection);
+        auto subscriber = redis.subscriber();
+        subscriber.on_pmessage([&probe](std::string /*pattern*/, std::string channel, std::string payload) {
+            probe.onMessage(channel, payload);
+        });
+        for (const std::string& pattern : options.patterns) {
+            subscriber.psubscribe(pattern);
+        }
+        while (g_stop == 0) {
+            try {
+                subscriber.consume();
+            } catch (const sw::redis::TimeoutError&) {
+                // REASON: Timeout is the idle path
+            }
+            if (probe.tick()) {
+                break;
+            }
+        }
+    } catch (const sw::redis::Error& e) {
+        std::cerr << "Redis error: " << e.what() << "\n";
+        return 1;
+    }
+    return probe.finish();
+}
@@ -0,0 +1,524 @@
+// replay_diff.cpp - Replays a TickJournal capture through two or more snapshot output paths and diffs the
+// message streams semantically (parsed JSON, not bytes)
+// OBJECTIVE: Evidence that a faster output path (fixed-schema encoder, fixed-point prices, deltas) says the
+// same thing as the RapidJSON reference before it is enabled in production - plus each path's throughput
+//
+// Usage: replay_diff --journal <segment.tjl | journal dir> [options]
+//   --baseline P       Path every candidate is compared against (default reference)
+//   --candidate P      Path to check, repeatable (default encoder, fixed, delta)
+//   --schema S         verbose | compact (default verbose)
+//   --derived          Include the "derived" object (worker.derived_metrics)
+//   --iso              Include the ISO "time" field (worker.iso_timestamps)
+//   --keyframe-every N Delta path: full snapshot after N deltas (default 100, as delta.keyframe_every)
+//   --tolerance X      Relative tolerance for non-integer numbers (default 1e-9)
+//   --limit N          Replay at most N ticks, 0 = all (default 0)
+//   --show N           Mismatches printed in full (default 10)
+//
+// Paths:
+//   reference  serializeState / serializeStateCompact (RapidJSON Writer)
+//   encoder    encodeSnapshot, shortest round-trip prices (worker.price_format: shortest)
+//   fixed      encodeSnapshot, fixed-point prices (worker.price_format: fixed)
+//   delta      keyframes + encodeSnapshotDelta, merged the way a consumer applies them (delta.enabled)
+//
+// Every path sees the same updates in journal order and emits one snapshot per quote / trade (no
+// conflation, duplicate suppression or publish policy - those decide *whether* to send, not *what*).
+// Throughput: one timed pass per path over the in-memory capture (apply + encode, no I/O, no diff).
+// Exit: 0 = equivalent, 2 = mismatches, 1 = usage / input error
+
+#include "MarketData.h"
+#include "Serialization.h"
+#include "SnapshotDelta.h"
+#include "SnapshotEncoder.h"
+#include "TickJournal.h"
+#include "TradeCodes.h"
+#include <rapidjson/document.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
+
+using namespace std::chrono;
+using namespace tws_bridge;
+
+// ========== Options ==========
+enum class OutputPath { Reference, Encoder, Fixed, Delta };
+
+static const char* pathName(OutputPath path) {
+    switch (path) {
+    case OutputPath::Reference: return "reference";
+    case OutputPath::Encoder: return "encoder";
+    case OutputPath::Fixed: return "fixed";
+    case OutputPath::Delta: return "delta";
+    }
+    return "";
+}
+
+static bool parsePath(const std::string& text, OutputPath& path) {
+    for (OutputPath candidate : {OutputPath::Reference, OutputPath::Encoder, OutputPath::Fixed, OutputPath::Delta}) {
+        if (text == pathName(candidate)) {
+            path = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Options {
+    std::string journal;
+    OutputPath baseline = OutputPath::Reference;
+    std::vector<OutputPath> candidates;
+    SnapshotSchema schema = SnapshotSchema::Verbose;
+    bool derived = false;
+    bool iso = false;
+    std::uint32_t keyframeEvery = 100;
+    double tolerance = 1e-9;
+    std::size_t limit = 0;
+    std::size_t show = 10;
+};
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--derived") {
+            options.derived = true;
+            continue;
+        }
+        if (flag == "--iso") {
+            options.iso = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << flag << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        OutputPath path;
+        if (flag == "--journal") {
+            options.journal = value;
+        } else if (flag == "--baseline" || flag == "--candidate") {
+            if (!parsePath(value, path)) {
+                std::cerr << "Unknown path " << value << " (reference, encoder, fixed, delta)\n";
+                return false;
+            }
+            if (flag == "--baseline") {
+                options.baseline = path;
+            } else {
+                options.candidates.push_back(path);
+            }
+        } else if (flag == "--schema") {
+            if (value != "verbose" && value != "compact") {
+                std::cerr << "Unknown schema " << value << " (verbose, compact)\n";
+                return false;
+            }
+            options.schema = value == "compact" ? SnapshotSchema::Compact : SnapshotSchema::Verbose;
+        } else if (flag == "--keyframe-every") {
+            options.keyframeEvery = static_cast<std::uint32_t>(std::max(1ul, std::stoul(value)));
+        } else if (flag == "--tolerance") {
+            options.tolerance = std::stod(value);
+        } else if (flag == "--limit") {
+            options.limit = std::stoul(value);
+        } else if (flag == "--show") {
+            options.show = std::stoul(value);
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return false;
+        }
+    }
+    if (options.journal.empty()) {
+        std::cerr << "Usage: replay_diff --journal <segment.tjl | journal dir> [--baseline P] [--candidate P ...]\n";
+        return false;
+    }
+    if (options.candidates.empty()) {
+        for (OutputPath path : {OutputPath::Encoder, OutputPath::Fixed, OutputPath::Delta}) {
+            if (path != options.baseline) {
+                options.candidates.push_back(path);
+            }
+        }
+    }
+    return true;
+}
+
+// ========== Capture: every quote / trade of the journal, in memory ==========
+// REASON: Loaded once up front - the timed passes measure the output path, not the page cache
+struct Capture {
+    std::vector<std::string> symbols;                // Capture slot → symbol (merged across sessions by name)
+    std::vector<TickUpdate> ticks;                   // slot = capture slot
+    std::uint64_t skipped = 0;                       // Depth / bars / ticks without a Symbol record
+};
+
+static bool loadCapture(const Options& options, Capture& capture) {
+    struct stat info{};
+    std::vector<std::string> segments;
+    if (::stat(options.journal.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+        segments = TickJournalReader::segments(options.journal);
+    } else {
+        segments.push_back(options.journal);
+    }
+    std::unordered_map<std::string, SlotId> bySymbol;
+    std::size_t opened = 0;
+    for (const std::string& path : segments) {
+        TickJournalReader reader;
+        if (!reader.open(path)) {
+            std::cerr << "Cannot read segment " << path << "\n";
+            continue;
+        }
+        ++opened;
+        std::vector<SlotId> slots;                   // NOTE: Every segment repeats its Symbol records
+        JournalEntry entry;
+        while (reader.next(entry)) {
+            if (entry.kind == JournalRecordKind::Symbol) {
+                auto inserted = bySymbol.emplace(entry.symbol, static_cast<SlotId>(capture.symbols.size()));
+                if (inserted.second) {
+                    capture.symbols.push_back(entry.symbol);
+                }
+                if (entry.slot >= slots.size()) {
+                    slots.resize(static_cast<std::size_t>(entry.slot) + 1, kInvalidSlot);
+                }
+                slots[entry.slot] = inserted.first->second;
+                continue;
+            }
+            TickUpdate update = entry.update;
+            const bool tick = update.type == TickUpdateType::BidAsk || update.type == TickUpdateType::AllLast;
+            if (!tick || update.slot >= slots.size() || slots[update.slot] == kInvalidSlot) {
+                ++capture.skipped;
+                continue;
+            }
+            update.slot = slots[update.slot];
+            capture.ticks.push_back(update);
+            if (options.limit != 0 && capture.ticks.size() >= options.limit) {
+                return true;
+            }
+        }
+    }
+    return opened > 0;
+}
+
+// ========== Output path: worker state aggregation + one encoder configuration ==========
+class PathRunner {
+public:
+    PathRunner(OutputPath path, const Options& options, const Capture& capture)
+        : m_path(path), m_options(options), m_states(capture.symbols.size()), m_deltas(capture.symbols.size()) {
+        for (std::size_t slot = 0; slot < m_states.size(); ++slot) {
+            m_states[slot].symbol = capture.symbols[slot];
+            m_states[slot].derived.rolling.setWindow(60000);  // NOTE: DerivedMetricsConfig::rollingWindow default
+        }
+        m_delta.enabled = true;
+        m_delta.keyframeEvery = options.keyframeEvery;
+    }
+
+    // Applies the update like BasicRedisWorker::applyUpdate, then encodes the slot's next message
+    std::string_view next(const TickUpdate& update) {
+        InstrumentState& state = m_states[update.slot];
+        apply(state, update);
+        ++state.sequence;
+        const bool compact = m_options.schema == SnapshotSchema::Compact;
+        switch (m_path) {
+        case OutputPath::Reference:
+            if (compact) {
+                serializeStateCompact(state, m_json, m_options.derived, m_options.iso);
+            } else {
+                serializeState(state, m_json, m_options.derived, m_options.iso);
+            }
+            break;
+        case OutputPath::Encoder:
+            encodeSnapshot(state, m_json, m_options.schema, m_options.derived, m_options.iso, PriceFormat::Shortest);
+            break;
+        case OutputPath::Fixed:
+            encodeSnapshot(state, m_json, m_options.schema, m_options.derived, m_options.iso, PriceFormat::FixedPoint);
+            break;
+        case OutputPath::Delta: {
+            // REASON: Same keyframe / baseline sequence as BasicRedisWorker::publishDelta
+            DeltaTrack& track = m_deltas[update.slot];
+            const bool keyframe = track.keyframeDue(state, m_delta);
+            const std::uint16_t changed = keyframe ? 0 : track.baseline().changes(state, m_options.derived);
+            track.sent(state, keyframe);
+            if (keyframe) {
+                encodeSnapshot(state, m_json, m_options.schema, m_options.derived, m_options.iso, PriceFormat::FixedPoint);
+            } else {
+                encodeSnapshotDelta(state, changed, m_json, m_options.schema, m_options.iso, PriceFormat::FixedPoint);
+            }
+            break;
+        }
+        }
+        return std::string_view(m_json.data(), m_json.size());
+    }
+
+private:
+    void apply(InstrumentState& state, const TickUpdate& update) const {
+        if (update.type == TickUpdateType::BidAsk) {
+            state.bidPrice = update.bidAsk.bidPrice;
+            state.askPrice = update.bidAsk.askPrice;
+            state.bidSize = state.sizeUnits(update.bidQuantity());
+            state.askSize = state.sizeUnits(update.askQuantity());
+            state.quoteTimestamp = update.timestamp;
+            state.hasQuote = true;
+            if (m_options.derived) {
+                state.derived.onQuote(state.bidPrice, state.askPrice);
+            }
+            return;
+        }
+        state.lastPrice = update.allLast.price;
+        state.lastSize = state.sizeUnits(update.tradeQuantity());
+        state.tradeTimestamp = update.timestamp;
+        state.hasTrade = true;
+        state.pastLimit = update.pastLimit();
+        state.exchange = exchangeName(update.allLast.exchange);
+        state.tradeConditions = update.allLast.conditions;
+        if (m_options.derived) {
+            state.derived.onTrade(update.timestamp, update.allLast.price, wholeUnits(update.tradeQuantity()),
+                                  9 * 3600 * 1000);  // NOTE: DerivedMetricsConfig::sessionReset default
+        }
+    }
+
+    OutputPath m_path;
+    const Options& m_options;
+    std::vector<InstrumentState> m_states;
+    std::vector<DeltaTrack> m_deltas;
+    DeltaConfig m_delta;
+    JsonBuffer m_json;
+};
+
+// ========== Semantic comparison ==========
+// One scalar of a parsed message, keyed by its path ("price.bid", "conditions")
+struct Leaf {
+    enum class Kind : std::uint8_t { Null, Bool, Integer, Real, String };
+    Kind kind = Kind::Null;
+    std::int64_t integer = 0;                        // Bool: 0 / 1
+    double real = 0.0;
+    std::string text;
+};
+
+using FlatMessage = std::map<std::string, Leaf>;
+
+static void flatten(const rapidjson::Value& value, const std::string& path, FlatMessage& out) {
+    if (value.IsObject()) {
+        for (auto member = value.MemberBegin(); member != value.MemberEnd(); ++member) {
+            const std::string name(member->name.GetString(), member->name.GetStringLength());
+            flatten(member->value, path.empty() ? name : path + "." + name, out);
+        }
+        return;
+    }
+    if (value.IsArray()) {
+        for (rapidjson::SizeType i = 0; i < value.Size(); ++i) {
+            flatten(value[i], path + "[" + std::to_string(i) + "]", out);
+        }
+        return;
+    }
+    Leaf& leaf = out[path];
+    leaf = Leaf{};
+    if (value.IsBool()) {
+        leaf.kind = Leaf::Kind::Bool;
+        leaf.integer = value.GetBool() ? 1 : 0;
+    } else if (value.IsInt64()) {
+        leaf.kind = Leaf::Kind::Integer;
+        leaf.integer = value.GetInt64();
+    } else if (value.IsNumber()) {
+        leaf.kind = Leaf::Kind::Real;
+        leaf.real = value.GetDouble();
+    } else if (value.IsString()) {
+        leaf.kind = Leaf::Kind::String;
+        leaf.text.assign(value.GetString(), value.GetStringLength());
+    }
+}
+
+static std::string describe(const Leaf& leaf) {
+    std::ostringstream out;
+    switch (leaf.kind) {
+    case Leaf::Kind::Null: out << "null"; break;
+    case Leaf::Kind::Bool: out << (leaf.integer != 0 ? "true" : "false"); break;
+    case Leaf::Kind::Integer: out << leaf.integer; break;
+    case Leaf::Kind::Real: out << std::setprecision(17) << leaf.real; break;
+    case Leaf::Kind::String: out << '"' << leaf.text << '"'; break;
+    }
+    return out.str();
+}
+
+static bool sameLeaf(const Leaf& expected, const Leaf& actual, double tolerance) {
+    const bool numeric = (expected.kind == Leaf::Kind::Integer || expected.kind == Leaf::Kind::Real)
+                      && (actual.kind == Leaf::Kind::Integer || actual.kind == Leaf::Kind::Real);
+    if (!numeric || (expected.kind == Leaf::Kind::Integer && actual.kind == Leaf::Kind::Integer)) {
+        return expected.kind == actual.kind && expected.integer == actual.integer && expected.text == actual.text;
+    }
+    // REASON: Fixed-point prices drop binary artifacts (0.30000000000000004 → 0.3) - equal within tolerance;
+    // "1.0" vs "1" is the same number in every JSON consumer
+    const double a = expected.kind == Leaf::Kind::Real ? expected.real : static_cast<double>(expected.integer);
+    const double b = actual.kind == Leaf::Kind::Real ? actual.real : static_cast<double>(actual.integer);
+    return a == b || (std::isnan(a) && std::isnan(b)) || std::fabs(a - b) <= tolerance * std::max(std::fabs(a), std::fabs(b));
+}
+
+// First difference as "field: expected vs actual" ("" = equivalent), fields in name order
+static std::string difference(const FlatMessage& expected, const FlatMessage& actual, double tolerance) {
+    auto e = expected.begin();
+    auto a = actual.begin();
+    while (e != expected.end() || a != actual.end()) {
+        if (a == actual.end() || (e != expected.end() && e->first < a->first)) {
+            return e->first + ": missing (expected " + describe(e->second) + ")";
+        }
+        if (e == expected.end() || a->first < e->first) {
+            return a->first + ": unexpected " + describe(a->second);
+        }
+        if (!sameLeaf(e->second, a->second, tolerance)) {
+            return e->first + ": " + describe(e->second) + " vs " + describe(a->second);
+        }
+        ++e;
+        ++a;
+    }
+    return "";
+}
+
+// Consumer view of one path: the slot's last full snapshot with every later delta applied
+class ConsumerView {
+public:
+    // deltaFlag: "delta" (verbose) / "dl" (compact)
+    ConsumerView(std::size_t slots, const char* deltaFlag) : m_slots(slots), m_deltaFlag(deltaFlag) {}
+
+    // false if the message is not a JSON object (or a delta arrives before any keyframe)
+    bool receive(SlotId slot, std::string_view message) {
+        rapidjson::Document parsed;
+        parsed.Parse(message.data(), message.size());
+        if (parsed.HasParseError() || !parsed.IsObject()) {
+            return false;
+        }
+        FlatMessage& view = m_slots[slot];
+        if (!parsed.HasMember(m_deltaFlag)) {
+            view.clear();
+            flatten(parsed, "", view);
+            return true;
+        }
+        if (view.empty()) {
+            return false;
+        }
+        // NOTE: A delta carries changed members only - every other field keeps the keyframe's value
+        flatten(parsed, "", view);
+        view.erase(m_deltaFlag);
+        return true;
+    }
+
+    const FlatMessage& view(SlotId slot) const { return m_slots[slot]; }
+
+private:
+    std::vector<FlatMessage> m_slots;
+    const char* m_deltaFlag;
+};
+
+// ========== Passes ==========
+struct Throughput {
+    double seconds = 0.0;
+    std::uint64_t bytes = 0;
+};
+
+static Throughput timePath(OutputPath path, const Options& options, const Capture& capture) {
+    PathRunner runner(path, options, capture);
+    Throughput result;
+    const auto start = steady_clock::now();
+    for (const TickUpdate& update : capture.ticks) {
+        result.bytes += runner.next(update).size();
+    }
+    result.seconds = duration<double>(steady_clock::now() - start).count();
+    return result;
+}
+
+struct DiffResult {
+    std::uint64_t compared = 0;
+    std::uint64_t mismatches = 0;
+    std::unordered_map<std::string, std::uint64_t> byField;  // First differing field → messages
+};
+
+static DiffResult diffPaths(OutputPath candidate, const Options& options, const Capture& capture) {
+    PathRunner expected(options.baseline, options, capture);
+    PathRunner actual(candidate, options, capture);
+    const char* deltaFlag = options.schema == SnapshotSchema::Compact ? "dl" : "delta";
+    ConsumerView expectedView(capture.symbols.size(), deltaFlag);
+    ConsumerView actualView(capture.symbols.size(), deltaFlag);
+    DiffResult result;
+    for (std::size_t i = 0; i < capture.ticks.size(); ++i) {
+        const TickUpdate& update = capture.ticks[i];
+        const std::string_view expectedMessage = expected.next(update);
+        const std::string_view actualMessage = actual.next(update);
+        ++result.compared;
+        std::string diff;
+        if (!expectedView.receive(update.slot, expectedMessage)) {
+            diff = "message: baseline unreadable";
+        } else if (!actualView.receive(update.slot, actualMessage)) {
+            diff = "message: candidate unreadable";
+        } else {
+            diff = difference(expectedView.view(update.slot), actualView.view(update.slot), options.tolerance);
+        }
+        if (diff.empty()) {
+            continue;
+        }
+        ++result.mismatches;
+        ++result.byField[diff.substr(0, diff.find(':'))];
+        if (result.mismatches <= options.show) {
+            std::cout << "  #" << i << " " << capture.symbols[update.slot] << " " << diff << "\n"
+                      << "    " << pathName(options.baseline) << ": " << expectedMessage << "\n"
+                      << "    " << pathName(candidate) << ": " << actualMessage << "\n";
+        }
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    Capture capture;
+    if (!loadCapture(options, capture)) {
+        std::cerr << "No readable journal segment at " << options.journal << "\n";
+        return 1;
+    }
+    std::cout << "=== Replay Diff ===\n";
+    std::cout << "Journal: " << options.journal << " | Ticks: " << capture.ticks.size() << " | Symbols: "
+              << capture.symbols.size() << " | Skipped: " << capture.skipped << " (depth / bars / unmapped)\n";
+    std::cout << "Schema: " << (options.schema == SnapshotSchema::Compact ? "compact" : "verbose")
+              << (options.derived ? " + derived" : "") << (options.iso ? " + iso time" : "") << "\n\n";
+    if (capture.ticks.empty()) {
+        return 0;
+    }
+
+    std::vector<OutputPath> paths{options.baseline};
+    paths.insert(paths.end(), options.candidates.begin(), options.candidates.end());
+    std::cout << "Throughput (apply + encode, one pass each):\n";
+    std::cout << std::left << std::setw(12) << "  path" << std::right << std::setw(14) << "msgs/s" << std::setw(12)
+              << "MB/s" << std::setw(14) << "bytes/msg" << std::setw(10) << "ns/msg" << "\n";
+    for (OutputPath path : paths) {
+        const Throughput result = timePath(path, options, capture);
+        const double messages = static_cast<double>(capture.ticks.size());
+        std::cout << "  " << std::left << std::setw(10) << pathName(path) << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(14) << messages / result.seconds << std::setprecision(1)
+                  << std::setw(12) << static_cast<double>(result.bytes) / result.seconds / 1e6 << std::setw(14)
+                  << static_cast<double>(result.bytes) / messages << std::setw(10) << result.seconds * 1e9 / messages
+                  << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    std::cout << "\n";
+
+    bool equivalent = true;
+    for (OutputPath candidate : options.candidates) {
+        std::cout << pathName(options.baseline) << " vs " << pathName(candidate) << ":\n";
+        const DiffResult result = diffPaths(candidate, options, capture);
+        if (result.mismatches == 0) {
+            std::cout << "  equivalent (" << result.compared << " messages)\n";
+            continue;
+        }
+        equivalent = false;
+        std::cout << "  " << result.mismatches << " of " << result.compared << " messages differ, first difference by field:\n";
+        std::vector<std::pair<std::string, std::uint64_t>> fields(result.byField.begin(), result.byField.end());
+        std::sort(fields.begin(), fields.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+        for (const auto& field : fields) {
+            std::cout << "    " << std::left << std::setw(32) << field.first << std::right << field.second << "\n";
+        }
+    }
+    return equivalent ? 0 : 2;
+}
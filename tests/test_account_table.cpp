@@ -0,0 +1,104 @@
+// test_account_table.cpp - Unit tests for the worker's coalescing account PnL / position table
+
+#include <catch2/catch_test_macros.hpp>
+#include "AccountTable.h"
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+struct Written {
+    std::vector<std::pair<std::string, std::string>> hashes;
+
+    auto sink() {
+        return [this](const std::string& key, std::string_view payload) {
+            hashes.emplace_back(key, std::string(payload));
+        };
+    }
+};
+
+AccountUpdate position(int conId, const std::string& symbol, double shares, double averageCost) {
+    AccountUpdate update;
+    update.account = "DU1234567";
+    update.conId = conId;
+    update.symbol = symbol;
+    update.set(AccountField::Position, shares);
+    update.set(AccountField::AverageCost, averageCost);
+    return update;
+}
+
+} // namespace
+
+TEST_CASE("Rows are keyed by account and conId", "[account]") {
+    REQUIRE(AccountTable::rowKey("DU1234567", 0) == "TWS:PNL:DU1234567");
+    REQUIRE(AccountTable::rowKey("DU1234567", 265598) == "TWS:POSITION:DU1234567:265598");
+}
+
+TEST_CASE("First flush writes every field received", "[account]") {
+    AccountTable table;
+    REQUIRE(table.apply(position(265598, "AAPL", 100.0, 187.5)));
+
+    Written written;
+    REQUIRE(table.flush(written.sink()) == 1);
+    REQUIRE(written.hashes[0].first == "TWS:POSITION:DU1234567:265598");
+    REQUIRE(written.hashes[0].second == "symbol\nAAPL\nposition\n100\navgCost\n187.5");
+
+    written.hashes.clear();
+    REQUIRE(table.flush(written.sink()) == 0);  // Nothing pending
+}
+
+TEST_CASE("Repeated updates coalesce into the changed fields only", "[account]") {
+    AccountTable table;
+    table.apply(position(265598, "AAPL", 100.0, 187.5));
+    Written written;
+    table.flush(written.sink());
+    written.hashes.clear();
+
+    // Same position again (updatePortfolio repeats itself): nothing to write
+    REQUIRE_FALSE(table.apply(position(265598, "AAPL", 100.0, 187.5)));
+
+    for (int i = 1; i <= 10; ++i) {
+        AccountUpdate pnl;
+        pnl.account = "DU1234567";
+        pnl.conId = 265598;
+        pnl.set(AccountField::UnrealizedPnl, 10.0 * i);
+        REQUIRE(table.apply(pnl));
+    }
+    REQUIRE(table.flush(written.sink()) == 1);
+    REQUIRE(written.hashes[0].second == "unrealizedPnl\n100");
+}
+
+TEST_CASE("Account totals and positions are separate rows", "[account]") {
+    AccountTable table;
+    AccountUpdate totals;
+    totals.account = "DU1234567";
+    totals.set(AccountField::DailyPnl, -12.25);
+    totals.set(AccountField::UnrealizedPnl, 150.0);
+    totals.set(AccountField::RealizedPnl, 0.0);
+    table.apply(totals);
+    table.apply(position(8314, "IBM", -50.0, 140.0));
+    REQUIRE(table.rows() == 2);
+
+    Written written;
+    REQUIRE(table.flush(written.sink()) == 2);
+    REQUIRE(written.hashes[0].first == "TWS:PNL:DU1234567");
+    REQUIRE(written.hashes[0].second == "dailyPnl\n-12.25\nunrealizedPnl\n150\nrealizedPnl\n0");
+    REQUIRE(written.hashes[1].first == "TWS:POSITION:DU1234567:8314");
+}
+
+TEST_CASE("An unchanged NaN is not rewritten", "[account]") {
+    AccountTable table;
+    AccountUpdate update;
+    update.account = "U1";
+    update.conId = 1;
+    update.set(AccountField::Value, std::nan(""));
+    REQUIRE(table.apply(update));
+    Written written;
+    table.flush(written.sink());
+    REQUIRE_FALSE(table.apply(update));
+    REQUIRE(table.flush(written.sink()) == 0);
+}
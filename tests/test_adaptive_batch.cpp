@@ -0,0 +1,68 @@
+// test_adaptive_batch.cpp - Queue-depth-driven batch / pipeline limits
+
+#include <catch2/catch_test_macros.hpp>
+#include "AdaptiveBatch.h"
+
+using namespace tws_bridge;
+using std::chrono::microseconds;
+
+static AdaptiveBatchConfig makeConfig() {
+    AdaptiveBatchConfig config;
+    config.enabled = true;
+    config.maxBatch = 1024;
+    config.maxPipeline = 256;
+    config.maxAddedLatency = microseconds(500);
+    return config;
+}
+
+TEST_CASE("Calm market flushes every batch at base limits", "[adaptive]") {
+    AdaptiveBatcher batcher(makeConfig(), 128, 64);
+    batcher.observe(0);
+    REQUIRE(batcher.batchLimit() == 128);
+    REQUIRE(batcher.pipelineLimit() == 64);
+    REQUIRE(batcher.flushDue(0, 1, microseconds(0)));
+    REQUIRE_FALSE(batcher.flushDue(0, 0, microseconds(0)));  // Nothing to send
+}
+
+TEST_CASE("Burst grows limits to their ceiling, catching up resets them", "[adaptive]") {
+    AdaptiveBatcher batcher(makeConfig(), 128, 64);
+    batcher.observe(5000);
+    REQUIRE(batcher.batchLimit() == 256);
+    REQUIRE(batcher.pipelineLimit() == 128);
+    REQUIRE_FALSE(batcher.flushDue(5000, 100, microseconds(50)));  // Pipeline still filling
+    REQUIRE(batcher.flushDue(5000, 128, microseconds(50)));
+
+    for (int i = 0; i < 10; ++i) {
+        batcher.observe(5000);
+    }
+    REQUIRE(batcher.batchLimit() == 1024);
+    REQUIRE(batcher.pipelineLimit() == 256);
+
+    batcher.observe(100);  // Less than a batch left: batch limit holds
+    REQUIRE(batcher.batchLimit() == 1024);
+
+    batcher.observe(0);
+    REQUIRE(batcher.batchLimit() == 128);
+    REQUIRE(batcher.pipelineLimit() == 64);
+}
+
+TEST_CASE("Latency budget forces a flush and shrinks the pipeline", "[adaptive]") {
+    AdaptiveBatcher batcher(makeConfig(), 128, 64);
+    for (int i = 0; i < 4; ++i) {
+        batcher.observe(5000);
+    }
+    REQUIRE(batcher.pipelineLimit() == 256);
+    REQUIRE(batcher.flushDue(5000, 10, microseconds(500)));
+    REQUIRE(batcher.pipelineLimit() == 128);
+}
+
+TEST_CASE("Ceilings never fall below the base limits", "[adaptive]") {
+    AdaptiveBatchConfig config = makeConfig();
+    config.maxBatch = 16;
+    config.maxPipeline = 8;
+    AdaptiveBatcher batcher(config, 128, 64);
+    REQUIRE(batcher.maxBatch() == 128);
+    batcher.observe(5000);
+    REQUIRE(batcher.batchLimit() == 128);
+    REQUIRE(batcher.pipelineLimit() == 64);
+}
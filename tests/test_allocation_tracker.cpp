@@ -0,0 +1,190 @@
+// test_allocation_tracker.cpp - Allocation counters, the hot-path guard, and no-alloc regression checks
+// NOTE: Linked with src/AllocationHook.cpp and TWS_BRIDGE_ALLOC_GUARD - every operator new here is counted
+
+#include <catch2/catch_test_macros.hpp>
+#include "AllocationTracker.h"
+#include "CoalescingTable.h"
+#include "MarketData.h"
+#include "SnapshotEncoder.h"
+#include "SpscRing.h"
+#include "TickByTickDecoder.h"
+#include "ThreadAffinity.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+// PITFALL: Optimized builds may elide an unused new / delete pair - the pointer escapes to keep it
+template <typename T>
+std::unique_ptr<T> allocate(T value) {
+    std::unique_ptr<T> ptr = std::make_unique<T>(value);
+    asm volatile("" : : "g"(ptr.get()) : "memory");
+    return ptr;
+}
+
+// Allocations of the calling thread while fn runs
+template <typename Fn>
+std::uint64_t allocationsDuring(Fn&& fn) {
+    const std::uint64_t before = threadAllocations();
+    fn();
+    return threadAllocations() - before;
+}
+
+const AllocationCounters* countersOf(const char* thread) {
+    const AllocationCounters* found = nullptr;
+    forEachAllocationCounters([&](const char* name, const AllocationCounters& counters) {
+        if (std::strcmp(name, thread) == 0) {
+            found = &counters;
+        }
+    });
+    return found;
+}
+
+} // namespace
+
+TEST_CASE("Hook counts allocations and bytes of the calling thread", "[allocations]") {
+    REQUIRE(allocationHookInstalled());
+    auto warm = allocate(1);  // Claims this thread's counters
+
+    const std::uint64_t count = allocationsDuring([]() {
+        auto value = allocate<std::int64_t>(7);
+        std::vector<char> buffer;
+        buffer.reserve(1000);
+        asm volatile("" : : "g"(buffer.data()) : "memory");
+    });
+    REQUIRE(count == 2);
+}
+
+TEST_CASE("Counters are kept per thread name", "[allocations]") {
+    std::thread worker([]() {
+        nameCurrentThread("alloc-test");
+        for (int i = 0; i < 5; ++i) {
+            auto value = allocate(i);
+        }
+    });
+    worker.join();
+
+    const AllocationCounters* counters = countersOf("alloc-test");
+    REQUIRE(counters != nullptr);
+    REQUIRE(counters->allocations.load() >= 5);
+    REQUIRE(counters->bytes.load() >= 5 * sizeof(int));
+}
+
+TEST_CASE("Guard counts allocations inside marked sections once armed", "[allocations]") {
+    nameCurrentThread("alloc-guard");
+    auto warm = allocate(0);
+    const AllocationCounters* counters = countersOf("alloc-guard");
+    REQUIRE(counters != nullptr);
+    const std::uint64_t before = counters->hotAllocations.load();
+
+    SECTION("Disarmed (warming up): not counted") {
+        setAllocationGuardMode(AllocationGuardMode::Off);
+        {
+            AllocationGuard guard;
+            auto value = allocate(1);
+        }
+        REQUIRE(counters->hotAllocations.load() == before);
+    }
+
+    SECTION("Armed: only allocations inside the guard, nested guards once") {
+        setAllocationGuardMode(AllocationGuardMode::Count);
+        auto outside = allocate(1);
+        {
+            AllocationGuard outer;
+            auto first = allocate(2);
+            {
+                AllocationGuard inner;
+                auto second = allocate(3);
+            }
+        }
+        auto after = allocate(4);
+        REQUIRE(counters->hotAllocations.load() == before + 2);
+    }
+    setAllocationGuardMode(AllocationGuardMode::Off);
+}
+
+// ========== Regression checks: warm hot-path building blocks must not allocate ==========
+
+TEST_CASE("Warm snapshot encoding does not allocate", "[allocations]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.quoteTimestamp = 1700000000000;
+    state.exchange = "NASDAQ";
+    state.tradeConditions = parseTradeConditions("I F");
+
+    JsonBuffer out;
+    encodeSnapshot(state, out);  // REASON: First encode sizes the buffer
+    encodeSnapshot(state, out, SnapshotSchema::Compact, true, true, PriceFormat::FixedPoint, 1);
+
+    REQUIRE(allocationsDuring([&]() {
+        for (int i = 0; i < 1000; ++i) {
+            state.bidPrice += 0.01;
+            state.quoteTimestamp += 1;
+            encodeSnapshot(state, out);
+            encodeSnapshot(state, out, SnapshotSchema::Compact, true, true, PriceFormat::FixedPoint, 1700000000000000000);
+            encodeSnapshotDelta(state, DeltaField::BidPrice, out);
+        }
+    }) == 0);
+}
+
+TEST_CASE("Ingest queues do not allocate per tick", "[allocations]") {
+    TickUpdate update;
+    update.type = TickUpdateType::BidAsk;
+    std::vector<TickUpdate> batch(64);
+
+    SECTION("SpscRing") {
+        SpscRing<TickUpdate> ring(1024);
+        REQUIRE(allocationsDuring([&]() {
+            for (int round = 0; round < 100; ++round) {
+                for (std::uint16_t slot = 0; slot < 64; ++slot) {
+                    update.slot = slot;
+                    ring.try_enqueue(update);
+                }
+                ring.try_dequeue_bulk(batch.data(), batch.size());
+            }
+        }) == 0);
+    }
+
+    SECTION("CoalescingTable") {
+        CoalescingTable table(64);
+        REQUIRE(allocationsDuring([&]() {
+            for (int round = 0; round < 100; ++round) {
+                for (std::uint16_t slot = 0; slot < 64; ++slot) {
+                    update.slot = slot;
+                    update.timestamp = round;
+                    table.write(slot, update);
+                }
+                table.drain(batch.data(), batch.size());
+            }
+        }) == 0);
+    }
+}
+
+TEST_CASE("Tick-by-tick fast path parses without allocating", "[allocations]") {
+    std::string bytes = "99";
+    bytes.push_back('\0');
+    for (const char* field : {"1001", "2", "1700000000", "189.25", "100", "0", "ARCA", "I F"}) {
+        bytes += field;
+        bytes.push_back('\0');
+    }
+
+    TickByTickFields fields;
+    REQUIRE(allocationsDuring([&]() {
+        for (int i = 0; i < 1000; ++i) {
+            parseTickByTick(bytes.data(), bytes.data() + bytes.size(), 187, fields, nullptr);
+            exchangeCode(fields.exchange);
+            parseTradeConditions(fields.specialConditions);
+        }
+    }) == 0);
+    REQUIRE(fields.reqId == 1001);
+}
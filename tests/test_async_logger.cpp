@@ -0,0 +1,87 @@
+// test_async_logger.cpp - Async logger record capture, formatting and rate limiting
+#include <catch2/catch_test_macros.hpp>
+#include "AsyncLogger.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+TEST_CASE("Records format placeholders on the log thread side", "[logger]") {
+    LogRecord record;
+    record.timestampUs = 1700000000123456;  // 22:13:20.123456 UTC
+    record.level = LogLevel::Warn;
+    record.format = "[TWS] {} bid={} size={} ok={} missing={}";
+    record.argCount = 4;
+    record.args[0].type = LogArg::Type::String;
+    std::string symbol = "AAPL";
+    symbol.copy(record.args[0].s, symbol.size());
+    record.args[0].length = static_cast<std::uint8_t>(symbol.size());
+    record.args[1].type = LogArg::Type::Double;
+    record.args[1].d = 171.55;
+    record.args[2].type = LogArg::Type::Int;
+    record.args[2].i = -100;
+    record.args[3].type = LogArg::Type::Bool;
+    record.args[3].b = true;
+
+    std::string line;
+    AsyncLogger::format(record, line);
+    REQUIRE(line == "22:13:20.123456 WARN  [TWS] AAPL bid=171.55 size=-100 ok=true missing=");
+}
+
+TEST_CASE("Disabled levels are not queued, enabled ones are written", "[logger]") {
+    AsyncLogger& logger = AsyncLogger::instance();
+    logger.setLevel(LogLevel::Warn);
+    REQUIRE_FALSE(logger.enabled(LogLevel::Info));
+    REQUIRE(logger.enabled(LogLevel::Error));
+
+    const std::uint64_t before = logger.counters().written.load();
+    LOG_INFO("not queued {}", 1);
+    LOG_WARN("queued {} {}", std::string("a very long symbol name that will be truncated"), 2u);
+    logger.start();
+    logger.stop();  // Drains before joining
+    REQUIRE(logger.counters().written.load() == before + 1);
+    REQUIRE(logger.counters().dropped.load() == 0);
+}
+
+TEST_CASE("Rate limit admits one record per interval", "[logger]") {
+    LogRateLimit limit(std::chrono::milliseconds(100));
+    REQUIRE(limit.allow(1000000));
+    REQUIRE_FALSE(limit.allow(1050000));
+    REQUIRE_FALSE(limit.allow(1099999));
+    REQUIRE(limit.allow(1100000));
+    REQUIRE(limit.suppressed() == 2);
+}
+
+TEST_CASE("One thread logs through one ring whatever the argument types", "[logger]") {
+    AsyncLogger& logger = AsyncLogger::instance();
+    logger.setLevel(LogLevel::Info);
+    const std::size_t before = logger.rings();
+    std::thread producer([]() {
+        LOG_INFO("first {}", 1);
+        LOG_INFO("second {} {}", std::string("AAPL"), 171.5);
+        LOG_INFO("third");
+        LOG_INFO("fourth {} {}", true, 7u);
+        LOG_INFO("fifth {}", 2);
+    });
+    producer.join();
+    REQUIRE(logger.rings() == before + 1);
+
+    std::ostringstream captured;
+    std::streambuf* previous = std::cout.rdbuf(captured.rdbuf());
+    logger.start();
+    logger.stop();
+    std::cout.rdbuf(previous);
+    const std::string out = captured.str();
+    const std::size_t first = out.find("first 1");
+    const std::size_t second = out.find("second AAPL 171.5");
+    const std::size_t third = out.find("third");
+    const std::size_t fourth = out.find("fourth true 7");
+    const std::size_t fifth = out.find("fifth 2");
+    REQUIRE(fifth != std::string::npos);
+    REQUIRE(first < second);
+    REQUIRE(second < third);
+    REQUIRE(third < fourth);
+    REQUIRE(fourth < fifth);
+}
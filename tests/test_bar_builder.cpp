@@ -0,0 +1,83 @@
+// test_bar_builder.cpp - Server-side OHLCV bars from trades
+#include <catch2/catch_test_macros.hpp>
+#include "BarBuilder.h"
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+struct Closed {
+    BarSize size;
+    BuiltBar bar;
+};
+
+const BarSize kFrames[] = {BarSize::Sec1, BarSize::Sec5, BarSize::Min1};
+
+} // namespace
+
+TEST_CASE("Trades fold into OHLCV per timeframe", "[bar_builder]") {
+    BarBuilder builder(kFrames, 3);
+    std::vector<Closed> closed;
+    auto onClose = [&](BarSize size, const BuiltBar& bar) { closed.push_back({size, bar}); };
+
+    const std::int64_t t0 = 1700000000000;  // Minute-aligned
+    REQUIRE(builder.addTrade(t0, 100.0, 10, onClose));
+    REQUIRE(builder.addTrade(t0 + 200, 101.0, 30, onClose));
+    REQUIRE(builder.addTrade(t0 + 900, 99.0, 10, onClose));
+    REQUIRE(closed.empty());
+
+    // Next second closes the 1s bar only
+    REQUIRE(builder.addTrade(t0 + 1000, 100.5, 10, onClose));
+    REQUIRE(closed.size() == 1);
+    REQUIRE(closed[0].size == BarSize::Sec1);
+    const BuiltBar& bar = closed[0].bar;
+    REQUIRE(bar.start == t0);
+    REQUIRE(bar.open == 100.0);
+    REQUIRE(bar.high == 101.0);
+    REQUIRE(bar.low == 99.0);
+    REQUIRE(bar.close == 99.0);
+    REQUIRE(bar.volume == 50);
+    REQUIRE(bar.count == 3);
+    REQUIRE(bar.wap() == (100.0 * 10 + 101.0 * 30 + 99.0 * 10) / 50);
+
+    // 5s boundary closes 1s + 5s, the 5s bar spans all four trades
+    closed.clear();
+    REQUIRE(builder.addTrade(t0 + 5000, 102.0, 5, onClose));
+    REQUIRE(closed.size() == 2);
+    REQUIRE(closed[1].size == BarSize::Sec5);
+    REQUIRE(closed[1].bar.volume == 60);
+    REQUIRE(closed[1].bar.close == 100.5);
+    REQUIRE(builder.history(1).size() == 1);
+    REQUIRE(builder.history(0).size() == 2);
+    REQUIRE(builder.history(0)[0].start == t0 + 1000);  // Newest first
+}
+
+TEST_CASE("Quiet bars close after the grace period, late trades are rejected", "[bar_builder]") {
+    BarBuilder builder(kFrames, 3);
+    std::vector<Closed> closed;
+    auto onClose = [&](BarSize size, const BuiltBar& bar) { closed.push_back({size, bar}); };
+
+    const std::int64_t t0 = 1700000000000;
+    builder.addTrade(t0 + 100, 50.0, 1, onClose);
+    builder.closeExpired(t0 + 1000, 500, onClose);
+    REQUIRE(closed.empty());
+    builder.closeExpired(t0 + 1500, 500, onClose);
+    REQUIRE(closed.size() == 1);
+    REQUIRE(closed[0].size == BarSize::Sec1);
+
+    // Its 1s bar is already out - applied to the 5s / 1m bars only
+    REQUIRE_FALSE(builder.addTrade(t0 + 900, 51.0, 1, onClose));
+    builder.closeExpired(t0 + 60000 + 500, 500, onClose);
+    REQUIRE(closed.size() == 3);
+    REQUIRE(closed[1].bar.count == 2);
+    REQUIRE(closed[2].size == BarSize::Min1);
+    REQUIRE(closed[2].bar.high == 51.0);
+}
+
+TEST_CASE("Unsupported timeframes are ignored", "[bar_builder]") {
+    const BarSize frames[] = {BarSize::Unknown, BarSize::Day1, BarSize::Min5};
+    BarBuilder builder(frames, 3);
+    REQUIRE(builder.timeframes() == 1);
+    REQUIRE(builder.timeframe(0) == BarSize::Min5);
+}
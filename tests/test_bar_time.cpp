@@ -0,0 +1,70 @@
+// test_bar_time.cpp - Unit tests for the Bar.time parser
+
+#include <catch2/catch_test_macros.hpp>
+#include "BarTime.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("Epoch seconds (formatDate=2) are taken as is", "[bartime]") {
+    BarTimeParser parser;
+    std::int64_t ms = 0;
+    REQUIRE(parser.parse("1700000000", ms));
+    REQUIRE(ms == 1700000000000LL);
+}
+
+TEST_CASE("Daily bars are stamped at midnight UTC", "[bartime]") {
+    BarTimeParser parser;
+    std::int64_t ms = 0;
+    REQUIRE(parser.parse("20240102", ms));
+    REQUIRE(ms == 1704153600000LL);
+    REQUIRE(parser.parse("19700101", ms));
+    REQUIRE(ms == 0);
+}
+
+TEST_CASE("Local times convert with the zone's daylight saving rule", "[bartime]") {
+    BarTimeParser parser;
+    std::int64_t ms = 0;
+    // Winter: EST (UTC-5)
+    REQUIRE(parser.parse("20240102 09:30:00 US/Eastern", ms));
+    REQUIRE(ms == 1704205800000LL);
+    // Summer: EDT (UTC-4)
+    REQUIRE(parser.parse("20240701 09:30:00 America/New_York", ms));
+    REQUIRE(ms == 1719840600000LL);
+    // 2024 switch days: 10 March (spring forward), 3 November (fall back)
+    REQUIRE(parser.parse("20240310 01:59:00 US/Eastern", ms));
+    REQUIRE(ms == 1710053940000LL);  // 06:59 UTC
+    REQUIRE(parser.parse("20240310 03:00:00 US/Eastern", ms));
+    REQUIRE(ms == 1710054000000LL);  // 07:00 UTC
+    REQUIRE(parser.parse("20241103 02:00:00 US/Eastern", ms));
+    REQUIRE(ms == 1730617200000LL);  // 07:00 UTC (standard again)
+    // Europe: last Sunday of March / October at 01:00 UTC
+    REQUIRE(parser.parse("20240331 03:00:00 Europe/Berlin", ms));
+    REQUIRE(ms == 1711846800000LL);  // 01:00 UTC, CEST
+    REQUIRE(parser.parse("20240115 12:00:00 Europe/London", ms));
+    REQUIRE(ms == 1705320000000LL);
+    REQUIRE(parser.parse("20240115 12:00:00 Asia/Tokyo", ms));
+    REQUIRE(ms == 1705287600000LL);
+}
+
+TEST_CASE("Zone-less times use the default zone, dash-separated times are UTC", "[bartime]") {
+    BarTimeParser eastern;
+    BarTimeParser utc("UTC");
+    std::int64_t ms = 0;
+    REQUIRE(eastern.parse("20240102 09:30:00", ms));
+    REQUIRE(ms == 1704205800000LL);
+    REQUIRE(utc.parse("20240102 14:30:00", ms));
+    REQUIRE(ms == 1704205800000LL);
+    REQUIRE(eastern.parse("20240102-14:30:00", ms));
+    REQUIRE(ms == 1704205800000LL);
+}
+
+TEST_CASE("Malformed times and unknown zones are rejected", "[bartime]") {
+    BarTimeParser parser;
+    std::int64_t ms = 42;
+    REQUIRE_FALSE(parser.parse("", ms));
+    REQUIRE_FALSE(parser.parse("2024010", ms));
+    REQUIRE_FALSE(parser.parse("20241302", ms));
+    REQUIRE_FALSE(parser.parse("20240102 9:30:00", ms));
+    REQUIRE_FALSE(parser.parse("20240102 09:30:00 Mars/Olympus", ms));
+    REQUIRE(ms == 42);
+}
@@ -0,0 +1,100 @@
+// test_basket_index.cpp - Basket definitions and the incremental weighted values
+
+#include <catch2/catch_test_macros.hpp>
+#include "BasketIndex.h"
+#include "InstrumentRegistry.h"
+#include "Serialization.h"
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::vector<BasketDefinition> baskets(std::initializer_list<const char*> texts) {
+    std::vector<BasketDefinition> out;
+    for (const char* text : texts) {
+        BasketDefinition basket;
+        REQUIRE(parseBasket(text, basket));
+        out.push_back(basket);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("Basket definitions parse and malformed ones are rejected", "[baskets]") {
+    BasketDefinition basket;
+    REQUIRE(parseBasket("SEMIS=NVDA:0.5,AMD:0.25,INTC:-1", basket));
+    REQUIRE(basket.name == "SEMIS");
+    REQUIRE(basket.constituents.size() == 3);
+    REQUIRE(basket.constituents[1].symbol == "AMD");
+    REQUIRE(basket.constituents[1].weight == 0.25);
+    REQUIRE(basket.constituents[2].weight == -1.0);  // NOTE: Spreads / pairs are baskets with a short leg
+    REQUIRE_FALSE(parseBasket("SEMIS", basket));
+    REQUIRE_FALSE(parseBasket("=NVDA:1", basket));
+    REQUIRE_FALSE(parseBasket("SEMIS=", basket));
+    REQUIRE_FALSE(parseBasket("SEMIS=NVDA", basket));
+    REQUIRE_FALSE(parseBasket("SEMIS=NVDA:x", basket));
+    REQUIRE_FALSE(parseBasket("SEMIS=NVDA:1,:2", basket));
+    REQUIRE_FALSE(parseBasket("SEMIS=NVDA:nan", basket));
+}
+
+TEST_CASE("Trades move basket values by their weighted delta", "[baskets]") {
+    InstrumentRegistry registry(8);
+    BasketBook book(registry, baskets({"TECH=AAPL:2,MSFT:1", "MEGA=AAPL:1"}));
+    const SlotId aapl = registry.find("AAPL");
+    const SlotId msft = registry.find("MSFT");
+    REQUIRE(aapl != kInvalidSlot);  // REASON: Registered by the book
+    REQUIRE(msft != kInvalidSlot);
+    REQUIRE(book.contains(aapl));
+    REQUIRE(book.version(0) == 0);
+
+    book.onTrade(aapl, 100.0);
+    REQUIRE(book.value(0) == 200.0);
+    REQUIRE(book.priced(0) == 1);
+    REQUIRE(book.value(1) == 100.0);
+    REQUIRE(book.priced(1) == 1);
+
+    book.onTrade(msft, 50.5);
+    REQUIRE(book.value(0) == 250.5);
+    REQUIRE(book.priced(0) == 2);
+    REQUIRE(book.version(1) == 1);  // NOTE: MSFT is not in MEGA
+
+    book.onTrade(aapl, 99.0);
+    REQUIRE(book.value(0) == 248.5);
+    REQUIRE(book.priced(0) == 2);
+    REQUIRE(book.value(1) == 99.0);
+
+    const std::uint64_t version = book.version(0);
+    book.onTrade(aapl, 99.0);  // Same price - nothing to publish
+    REQUIRE(book.version(0) == version);
+}
+
+TEST_CASE("A long session of deltas lands exactly on the recomputed sum", "[baskets]") {
+    InstrumentRegistry registry(8);
+    BasketBook book(registry, baskets({"IDX=A:0.1,B:0.3,C:1.7"}));
+    const SlotId slots[] = {registry.find("A"), registry.find("B"), registry.find("C")};
+    const double weights[] = {0.1, 0.3, 1.7};
+    double last[] = {0.0, 0.0, 0.0};
+    for (int i = 0; i < 100000; ++i) {
+        const int member = i % 3;
+        last[member] = 10.0 + (i % 977) * 0.01;
+        book.onTrade(slots[member], last[member]);
+    }
+    std::int64_t expected = 0;
+    for (int member = 0; member < 3; ++member) {
+        expected += static_cast<std::int64_t>(std::llround(weights[member] * last[member] * BasketBook::kScale));
+    }
+    REQUIRE(book.value(0) == static_cast<double>(expected) / BasketBook::kScale);
+}
+
+TEST_CASE("Basket snapshots serialize as a synthetic instrument", "[baskets]") {
+    JsonBuffer out;
+    serializeBasketSnapshot("SEMIS", 123.5, 2, 3, 9, 1700000000000, out);
+    REQUIRE(out.str() == "{\"instrument\":\"SEMIS\",\"type\":\"basket\",\"value\":123.5,\"priced\":2,\"constituents\":3,"
+                         "\"seq\":9,\"timestamp\":1700000000000}");
+}
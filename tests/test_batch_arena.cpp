@@ -0,0 +1,121 @@
+// test_batch_arena.cpp - Unit tests for the per-batch monotonic arena and the pooled payloads it references
+
+#include <catch2/catch_test_macros.hpp>
+#include "BatchArena.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("Copies stay intact until reset", "[arena]") {
+    BatchArena arena(256);
+    const std::string channel = "TWS:TICKS:AAPL";
+    const std::string payload = R"({"instrument":"AAPL","bid":189.5})";
+    const std::string_view a = arena.copy(channel.data(), channel.size());
+    const std::string_view b = arena.copy(payload.data(), payload.size());
+
+    REQUIRE(a == channel);
+    REQUIRE(b == payload);
+    REQUIRE(a.data() != channel.data());
+    REQUIRE(arena.used() == channel.size() + payload.size());
+    REQUIRE(arena.copy("", 0).empty());
+
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.grows() == 0);
+}
+
+TEST_CASE("Reset reuses the block from its start", "[arena]") {
+    BatchArena arena(256);
+    const std::string_view first = arena.copy("abc", 3);
+    arena.reset();
+    const std::string_view second = arena.copy("xyz", 3);
+    REQUIRE(second.data() == first.data());
+    REQUIRE(second == "xyz");
+}
+
+TEST_CASE("A batch larger than the block spills, then the block grows", "[arena]") {
+    BatchArena arena(64);
+    const std::string payload(40, 'p');
+    std::vector<std::string_view> copies;
+    for (int i = 0; i < 10; ++i) {
+        copies.push_back(arena.copy(payload.data(), payload.size()));
+    }
+    for (std::string_view copy : copies) {
+        REQUIRE(copy == payload);  // Spilled copies are as valid as in-block ones
+    }
+    REQUIRE(arena.used() == 400);
+
+    arena.reset();
+    REQUIRE(arena.grows() == 1);
+    REQUIRE(arena.blockSize() >= 400);
+
+    // Same batch again fits the grown block - no further growth
+    for (int i = 0; i < 10; ++i) {
+        arena.copy(payload.data(), payload.size());
+    }
+    arena.reset();
+    REQUIRE(arena.grows() == 1);
+}
+
+TEST_CASE("pmr containers allocate from the arena", "[arena]") {
+    BatchArena arena(4096);
+    std::pmr::vector<int> values(arena.resource());
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+    REQUIRE(values.size() == 100);
+    REQUIRE(values[99] == 99);
+}
+
+TEST_CASE("Pooled payloads are stored back to back and shared by reference", "[arena][payload]") {
+    PayloadPool pool(64, 1);
+    const SharedPayload first = pool.store("{\"bid\":1}");
+    const SharedPayload second = pool.store("{\"bid\":2}");
+    REQUIRE(first.bytes == "{\"bid\":1}");
+    REQUIRE(second.block == first.block);
+    REQUIRE(second.bytes.data() == first.bytes.data() + first.bytes.size());
+
+    BatchArena publish(64);
+    BatchArena sinks(64);
+    const std::string_view a = publish.reference(first);
+    const std::string_view b = publish.reference(second);
+    const std::string_view c = sinks.reference(first);
+    REQUIRE(a.data() == first.bytes.data());  // NOTE: No copy anywhere
+    REQUIRE(b.data() == second.bytes.data());
+    REQUIRE(c.data() == first.bytes.data());
+    REQUIRE(publish.used() == 0);
+    REQUIRE(pool.stored() == 2);
+}
+
+TEST_CASE("A block returns to the pool once the worker moved on and every holder reset", "[arena][payload]") {
+    PayloadPool pool(16, 1);
+    BatchArena publish(64);
+    BatchArena sinks(64);
+    const SharedPayload held = pool.store(std::string(16, 'a'));
+    publish.reference(held);
+    sinks.reference(held);
+
+    // The open block is full: the next store moves on, and with the first block still held the pool grows
+    const SharedPayload next = pool.store(std::string(16, 'b'));
+    REQUIRE(next.block != held.block);
+    REQUIRE(pool.blocks() == 2);
+    REQUIRE(held.bytes == std::string(16, 'a'));  // REASON: Still referenced - untouched
+
+    publish.reset();
+    sinks.reset();  // Last holder: the first block is free again
+    const SharedPayload reused = pool.store(std::string(16, 'c'));
+    REQUIRE(reused.block == held.block);
+    REQUIRE(pool.blocks() == 2);
+}
+
+TEST_CASE("An oversized payload gets a block of its own size", "[arena][payload]") {
+    PayloadPool pool(16, 2);
+    const std::string large(100, 'x');
+    const SharedPayload stored = pool.store(large);
+    REQUIRE(stored.bytes == large);
+    REQUIRE(pool.blocks() == 3);
+    const SharedPayload small = pool.store("y");
+    REQUIRE(small.block != stored.block);  // NOTE: The large block is full, the next store opens a pooled one
+}
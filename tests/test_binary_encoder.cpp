@@ -0,0 +1,98 @@
+// test_binary_encoder.cpp - Unit tests for v1 binary wire format
+
+#include <catch2/catch_test_macros.hpp>
+#include "BinaryEncoder.h"
+#include "MarketData.h"
+#include <cstring>
+
+// Little-endian reader mirroring a consumer-side struct.unpack
+template <typename T>
+static T loadLE(const std::string& msg, std::size_t offset) {
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(msg[offset + i])) << (8 * i);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+TEST_CASE("Binary snapshot layout", "[binary]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.lastSize = 50;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.exchange = "NASDAQ";
+    state.pastLimit = true;
+    
+    std::string msg;
+    encodeSnapshotBinary(state, msg);
+    
+    REQUIRE(msg.size() == binary_wire::kHeaderSize + binary_wire::kSnapshotBodySize + 4 + 1 + 6);
+    REQUIRE(loadLE<std::uint8_t>(msg, 0) == binary_wire::kVersion);
+    REQUIRE(loadLE<std::uint8_t>(msg, 1) == static_cast<std::uint8_t>(binary_wire::Kind::Snapshot));
+    REQUIRE(loadLE<std::uint8_t>(msg, 2) == binary_wire::Flags::PastLimit);
+    REQUIRE(loadLE<std::uint8_t>(msg, 3) == 4);
+    REQUIRE(loadLE<std::int32_t>(msg, 4) == 265598);
+    REQUIRE(loadLE<std::int64_t>(msg, 8) == 1700000000500);
+    REQUIRE(loadLE<double>(msg, 16) == 171.55);
+    REQUIRE(loadLE<double>(msg, 24) == 171.57);
+    REQUIRE(loadLE<double>(msg, 32) == 171.56);
+    REQUIRE(loadLE<std::int32_t>(msg, 40) == 100);
+    REQUIRE(loadLE<std::int32_t>(msg, 44) == 200);
+    REQUIRE(loadLE<std::int32_t>(msg, 48) == 50);
+    REQUIRE(loadLE<std::int64_t>(msg, 52) == 1700000000000);
+    REQUIRE(loadLE<std::int64_t>(msg, 60) == 1700000000500);
+    REQUIRE(msg.substr(68, 4) == "AAPL");
+    REQUIRE(loadLE<std::uint8_t>(msg, 72) == 6);
+    REQUIRE(msg.substr(73) == "NASDAQ");
+}
+
+TEST_CASE("Binary snapshot appends the sequence when set", "[binary]") {
+    InstrumentState state;
+    state.symbol = "SPY";
+    state.exchange = "ARCA";
+    state.pastLimit = true;
+    state.sequence = 43;
+
+    std::string msg;
+    encodeSnapshotBinary(state, msg);
+
+    REQUIRE(msg.size() == binary_wire::kHeaderSize + binary_wire::kSnapshotBodySize + 3 + 1 + 4 + 8);
+    REQUIRE(loadLE<std::uint8_t>(msg, 2) == (binary_wire::Flags::PastLimit | binary_wire::Flags::Sequence));
+    REQUIRE(msg.substr(msg.size() - 12, 4) == "ARCA");
+    REQUIRE(loadLE<std::uint64_t>(msg, msg.size() - 8) == 43);
+}
+
+TEST_CASE("Binary bar layout", "[binary]") {
+    TickUpdate update;
+    update.type = TickUpdateType::Bar;
+    update.timestamp = 1700000000000;
+    update.bar.open = 450.0;
+    update.bar.high = 451.5;
+    update.bar.low = 449.25;
+    update.bar.close = 451.0;
+    update.bar.volume = 12345;
+    update.bar.wap = 450.5;
+    update.aux = 42;
+    
+    std::string msg;
+    encodeBarBinary("SPY", update, msg);
+    
+    REQUIRE(msg.size() == binary_wire::kHeaderSize + binary_wire::kBarBodySize + 3);
+    REQUIRE(loadLE<std::uint8_t>(msg, 1) == static_cast<std::uint8_t>(binary_wire::Kind::Bar));
+    REQUIRE(loadLE<std::int64_t>(msg, 8) == 1700000000000);
+    REQUIRE(loadLE<double>(msg, 16) == 450.0);
+    REQUIRE(loadLE<double>(msg, 40) == 451.0);
+    REQUIRE(loadLE<std::int64_t>(msg, 48) == 12345);
+    REQUIRE(loadLE<double>(msg, 56) == 450.5);
+    REQUIRE(loadLE<std::uint32_t>(msg, 64) == 42);
+    REQUIRE(msg.substr(68) == "SPY");
+}
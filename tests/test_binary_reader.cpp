@@ -0,0 +1,199 @@
+// test_binary_reader.cpp - Consumer SDK: views over encoder output, delta completion, stale rows, malformed input
+
+#include <catch2/catch_test_macros.hpp>
+#include "BinaryEncoder.h"
+#include "BinaryReader.h"
+#include "MarketData.h"
+#include <string>
+
+using namespace binary_wire;
+
+namespace {
+
+InstrumentState makeState() {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.lastSize = 50;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.exchange = "NASDAQ";
+    state.sequence = 7;
+    return state;
+}
+
+} // namespace
+
+TEST_CASE("Snapshot view reads every field in place", "[binary][reader]") {
+    InstrumentState state = makeState();
+    state.pastLimit = true;
+    std::string msg;
+    encodeSnapshotBinary(state, msg);
+
+    SnapshotView view;
+    REQUIRE(view.parse(msg));
+    REQUIRE(view.conId() == 265598);
+    REQUIRE(view.pastLimit());
+    REQUIRE(view.timestamp() == 1700000000500);
+    REQUIRE(view.bid() == 171.55);
+    REQUIRE(view.ask() == 171.57);
+    REQUIRE(view.last() == 171.56);
+    REQUIRE(view.bidSize() == 100);
+    REQUIRE(view.askSize() == 200);
+    REQUIRE(view.lastSize() == 50);
+    REQUIRE(view.quoteTimestamp() == 1700000000000);
+    REQUIRE(view.tradeTimestamp() == 1700000000500);
+    REQUIRE(view.symbol() == "AAPL");
+    REQUIRE(view.exchange() == "NASDAQ");
+    REQUIRE(view.sequence() == 7);
+
+    state.sequence = 0;
+    encodeSnapshotBinary(state, msg);
+    REQUIRE(view.parse(msg));
+    REQUIRE(view.sequence() == 0);
+}
+
+TEST_CASE("Delta view finds each changed field", "[binary][reader]") {
+    InstrumentState state = makeState();
+    state.tradeConditions = 0x15;
+    state.derived.mid = 171.56;
+    state.derived.spread = 0.02;
+    state.derived.vwap = 171.4;
+    std::string msg;
+    const std::uint16_t changed = DeltaBits::AskPrice | DeltaBits::AskSize | DeltaBits::Exchange
+                                | DeltaBits::Conditions | DeltaBits::Derived;
+    encodeSnapshotBinaryDelta(state, changed, msg);
+
+    DeltaView view;
+    REQUIRE(view.parse(msg));
+    REQUIRE(view.changed() == changed);
+    REQUIRE(view.sequence() == 7);
+    REQUIRE(view.timestamp() == 1700000000500);
+    REQUIRE(view.has(DeltaBits::AskPrice));
+    REQUIRE_FALSE(view.has(DeltaBits::BidPrice));
+    REQUIRE(view.ask() == 171.57);
+    REQUIRE(view.askSize() == 200);
+    REQUIRE(view.exchange() == "NASDAQ");
+    REQUIRE(view.conditions() == 0x15);
+    REQUIRE(view.mid() == 171.56);
+    REQUIRE(view.spread() == 0.02);
+    REQUIRE(view.vwap() == 171.4);
+    REQUIRE(view.rollingVolume() == 0);
+    REQUIRE(view.symbol() == "AAPL");
+}
+
+TEST_CASE("Tick book completes deltas from the last snapshot", "[binary][reader]") {
+    InstrumentState state = makeState();
+    std::string msg;
+    TickBook book;
+
+    encodeSnapshotBinary(state, msg);
+    const TickRow* row = book.apply(msg);
+    REQUIRE(row != nullptr);
+    REQUIRE(row->changed == DeltaBits::All);
+    REQUIRE(row->kind == static_cast<std::uint8_t>(Kind::Snapshot));
+    REQUIRE(std::string(row->symbol) == "AAPL");
+    REQUIRE(std::string(row->exchange) == "NASDAQ");
+
+    state.sequence = 8;
+    state.bidPrice = 171.60;
+    state.bidSize = 300;
+    encodeSnapshotBinaryDelta(state, DeltaBits::BidPrice | DeltaBits::BidSize, msg);
+    row = book.apply(msg);
+    REQUIRE(row != nullptr);
+    REQUIRE(row->bid == 171.60);
+    REQUIRE(row->bidSize == 300);
+    REQUIRE(row->ask == 171.57);          // From the snapshot
+    REQUIRE(row->lastSize == 50);
+    REQUIRE(row->sequence == 8);
+    REQUIRE(row->changed == (DeltaBits::BidPrice | DeltaBits::BidSize));
+    REQUIRE((row->flags & RowFlags::Stale) == 0);
+
+    SECTION("A sequence gap marks the row stale until the next snapshot") {
+        state.sequence = 10;
+        state.askPrice = 171.70;
+        encodeSnapshotBinaryDelta(state, DeltaBits::AskPrice, msg);
+        row = book.apply(msg);
+        REQUIRE(row->ask == 171.70);
+        REQUIRE((row->flags & RowFlags::Stale) != 0);
+
+        state.sequence = 11;
+        encodeSnapshotBinaryDelta(state, DeltaBits::PastLimit, msg);
+        REQUIRE((book.apply(msg)->flags & RowFlags::Stale) != 0);  // REASON: Contiguous again, still unrepaired
+
+        state.sequence = 12;
+        encodeSnapshotBinary(state, msg);
+        REQUIRE((book.apply(msg)->flags & RowFlags::Stale) == 0);
+    }
+
+    SECTION("A delta for an unseen symbol is stale") {
+        InstrumentState other = makeState();
+        other.symbol = "MSFT";
+        encodeSnapshotBinaryDelta(other, DeltaBits::LastPrice, msg);
+        row = book.apply(msg);
+        REQUIRE(row->last == 171.56);
+        REQUIRE(row->bid == 0.0);
+        REQUIRE((row->flags & RowFlags::Stale) != 0);
+        REQUIRE(book.size() == 2);
+        REQUIRE(book.find("MSFT") == row);
+        REQUIRE(book.find("SPY") == nullptr);
+    }
+}
+
+TEST_CASE("Bar view and row", "[binary][reader]") {
+    TickUpdate update;
+    update.type = TickUpdateType::Bar;
+    update.timestamp = 1700000000000;
+    update.bar.open = 171.0;
+    update.bar.high = 172.0;
+    update.bar.low = 170.5;
+    update.bar.close = 171.5;
+    update.bar.volume = 12345;
+    update.bar.wap = 171.3;
+    update.aux = 42;
+    std::string msg;
+    encodeBarBinary("SPY", update, msg);
+
+    BarView view;
+    REQUIRE(view.parse(msg));
+    BarRow row{};
+    applyBar(view, row);
+    REQUIRE(row.timestamp == 1700000000000);
+    REQUIRE(row.open == 171.0);
+    REQUIRE(row.high == 172.0);
+    REQUIRE(row.low == 170.5);
+    REQUIRE(row.close == 171.5);
+    REQUIRE(row.volume == 12345);
+    REQUIRE(row.wap == 171.3);
+    REQUIRE(row.barCount == 42);
+    REQUIRE(std::string(row.symbol) == "SPY");
+}
+
+TEST_CASE("Malformed payloads are rejected, not read past", "[binary][reader]") {
+    std::string msg;
+    encodeSnapshotBinary(makeState(), msg);
+    SnapshotView snapshot;
+    DeltaView delta;
+    BarView bar;
+    TickBook book;
+
+    REQUIRE_FALSE(snapshot.parse(std::string_view(msg).substr(0, msg.size() - 1)));  // Sequence cut
+    REQUIRE_FALSE(snapshot.parse(std::string_view(msg).substr(0, 20)));
+    REQUIRE_FALSE(delta.parse(msg));                                                 // Wrong kind
+    REQUIRE_FALSE(bar.parse(msg));
+    REQUIRE_FALSE(snapshot.parse("{\"instrument\":\"AAPL\"}"));                      // JSON channel
+    msg[0] = 2;
+    REQUIRE_FALSE(snapshot.parse(msg));                                              // Future version
+    REQUIRE(book.apply(msg) == nullptr);
+
+    InstrumentState state = makeState();
+    encodeSnapshotBinaryDelta(state, DeltaBits::Exchange | DeltaBits::Derived, msg);
+    REQUIRE(delta.parse(msg));
+    REQUIRE_FALSE(delta.parse(std::string_view(msg).substr(0, msg.size() - 1)));
+    REQUIRE(book.size() == 0);
+}
@@ -0,0 +1,726 @@
+// test_bridge_config.cpp - Unit tests for config.yaml → BridgeConfig binding and startup validation
+
+#include <catch2/catch_test_macros.hpp>
+#include "BridgeConfig.h"
+
+using namespace tws_bridge;
+
+namespace {
+
+bool apply(const char* yaml, BridgeConfig& config, std::string& error) {
+    ConfigFile file;
+    return file.parse(yaml, error) && applyConfig(file, config, error);
+}
+
+} // namespace
+
+TEST_CASE("Defaults match the previously hardcoded bridge", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(applyConfig(ConfigFile{}, config, error));
+    REQUIRE(config.twsPort == 7497);
+    REQUIRE(config.clientIds == std::vector<int>{1});
+    REQUIRE(config.queueCapacity == 10000);
+    REQUIRE(config.io.enabled);
+    REQUIRE(config.ingest.policy == OverflowPolicy::ConflateLatest);
+    REQUIRE(config.ingest.slotCapacity == config.symbolCapacity);
+    REQUIRE_FALSE(config.rebalance.enabled);
+    REQUIRE_FALSE(config.ingest.movableSlots);
+    REQUIRE_FALSE(config.ingest.memory.enabled);
+    REQUIRE_FALSE(config.ingest.memory.lock);
+    REQUIRE(config.worker.numaLocal);
+    REQUIRE(config.background.threads == 0);
+    REQUIRE(config.background.cpus.empty());
+    REQUIRE(config.historicalBars == std::vector<std::string>{"SPY"});
+}
+
+TEST_CASE("Keys reach their settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(apply("tws:\n"
+                  "  port: 4002\n"
+                  "  client_ids: [1, 2]\n"
+                  "  reader: inline\n"
+                  "  messages:\n"
+                  "    allow: [6, 7]\n"
+                  "  backfill:\n"
+                  "    enabled: true\n"
+                  "    max_gap: 2m\n"
+                  "redis:\n"
+                  "  direct_resp: true\n"
+                  "  resp_backend: io_uring\n"
+                  "  batch:\n"
+                  "    max_messages: 128\n"
+                  "    max_delay: 250us\n"
+                  "ingest:\n"
+                  "  shards: 4\n"
+                  "  queue_capacity: 65536\n"
+                  "  wait:\n"
+                  "    mode: busy_spin\n"
+                  "  huge_pages: true\n"
+                  "  lock_memory: true\n"
+                  "worker:\n"
+                  "  schema: compact\n"
+                  "  send_timestamps: true\n"
+                  "  warm_start: false\n"
+                  "  last_value_format: hash\n"
+                  "  drain_timeout: 500ms\n"
+                  "  tape_length: 500\n"
+                  "  adaptive:\n"
+                  "    enabled: true\n"
+                  "    max_added_latency: 2ms\n"
+                  "  checkpoint:\n"
+                  "    enabled: true\n"
+                  "    name: /bridge-state-test\n"
+                  "  publish_policy: field_change\n"
+                  "  publish_fields: [bid_price, ask_size]\n"
+                  "  conflation:\n"
+                  "    enabled: true\n"
+                  "    window: 2ms\n"
+                  "  aggregate:\n"
+                  "    enabled: true\n"
+                  "    window: 5ms\n"
+                  "    encoder_threads: 3\n"
+                  "  delta:\n"
+                  "    enabled: true\n"
+                  "    keyframe_every: 20\n"
+                  "  compression:\n"
+                  "    aggregate: true\n"
+                  "    min_bytes: 2048\n"
+                  "  tiers: [10hz, 1Hz]\n"
+                  "  options:\n"
+                  "    interval: 1s\n"
+                  "  lag:\n"
+                  "    enabled: true\n"
+                  "    warn: 50ms\n"
+                  "  flight:\n"
+                  "    enabled: true\n"
+                  "    threshold: 20ms\n"
+                  "  bar_builder:\n"
+                  "    timeframes: [5s, 1m]\n"
+                  "load_shed:\n"
+                  "  enabled: true\n"
+                  "  queue_age: 100ms\n"
+                  "  low_priority: [IWM]\n"
+                  "threads:\n"
+                  "  worker:\n"
+                  "    cpus: [2, 3, 4, 5]\n"
+                  "    priority: 80\n"
+                  "  background:\n"
+                  "    threads: 2\n"
+                  "    cpus: [6, 7]\n"
+                  "watchdog:\n"
+                  "  enabled: true\n"
+                  "  reconnect: true\n"
+                  "trace:\n"
+                  "  enabled: true\n"
+                  "  sample_every: 100\n"
+                  "allocations:\n"
+                  "  guard: abort\n"
+                  "  warmup: 30s\n"
+                  "memory:\n"
+                  "  publish_spill_mb: 64\n"
+                  "  websocket_mb: 16\n"
+                  "contracts:\n"
+                  "  cache_path: \"\"\n"
+                  "  max_age: 24h\n"
+                  "account:\n"
+                  "  enabled: true\n"
+                  "  id: DU1234567\n"
+                  "kafka:\n"
+                  "  enabled: true\n"
+                  "  partitioner: slot\n"
+                  "  linger: 20ms\n"
+                  "  compression: zstd\n"
+                  "websocket:\n"
+                  "  enabled: true\n"
+                  "  port: 9000\n"
+                  "  format: binary\n"
+                  "  stall_timeout: 2s\n"
+                  "query:\n"
+                  "  enabled: true\n"
+                  "  socket: /run/tws/query.sock\n"
+                  "leader:\n"
+                  "  enabled: true\n"
+                  "  id: bridge-a\n"
+                  "  ttl: 3s\n"
+                  "  renew_interval: 1s\n"
+                  "partition:\n"
+                  "  enabled: true\n"
+                  "  heartbeat: 500ms\n"
+                  "  member_timeout: 3s\n"
+                  "time_series:\n"
+                  "  enabled: true\n"
+                  "  compactions: [1m:720h, 1h:8760h]\n"
+                  "log:\n"
+                  "  level: debug\n"
+                  "subscriptions:\n"
+                  "  symbols: [AAPL, MSFT]\n"
+                  "  feed: top_of_book\n"
+                  "  universe_key: TWS:UNIVERSE:EQUITIES\n"
+                  "  universe_poll: 2s\n",
+                  config, error));
+    REQUIRE(config.twsPort == 4002);
+    REQUIRE(config.clientIds == std::vector<int>{1, 2});
+    REQUIRE(config.readerMode == ReaderMode::Inline);
+    REQUIRE(config.messages.enabled);
+    REQUIRE(config.messages.allow == std::vector<int>{6, 7});
+    REQUIRE(config.backfill.enabled);
+    REQUIRE(config.backfill.maxGap == std::chrono::minutes(2));
+    REQUIRE(config.backfill.maxPages == 10);
+    REQUIRE(config.connection.directResp);
+    REQUIRE(config.connection.respBackend == RespBackend::IoUring);
+    REQUIRE(config.batch.maxMessages == 128);
+    REQUIRE(config.batch.maxDelay == std::chrono::microseconds(250));
+    REQUIRE(config.shards == 4);
+    REQUIRE(config.queueCapacity == 65536);
+    REQUIRE(config.wait.mode == WaitMode::BusySpin);
+    REQUIRE(config.ingest.memory.enabled);
+    REQUIRE(config.ingest.memory.lock);
+    REQUIRE(config.worker.snapshotSchema == SnapshotSchema::Compact);
+    REQUIRE(config.worker.sendTimestamps);
+    REQUIRE_FALSE(config.warmStart.enabled);
+    REQUIRE(config.worker.lastValueFormat == LastValueFormat::Hash);
+    REQUIRE(config.warmStart.format == LastValueFormat::Hash);
+    REQUIRE(config.worker.drainTimeout == std::chrono::milliseconds(500));
+    REQUIRE(config.worker.tapeLength == 500);
+    REQUIRE(config.checkpoint.enabled);
+    REQUIRE(config.checkpoint.name == "/bridge-state-test");
+    REQUIRE(config.worker.publishPolicy.policy == PublishPolicy::FieldChange);
+    REQUIRE(config.worker.publishPolicy.fields == (SnapshotFields::BidPrice | SnapshotFields::AskSize));
+    REQUIRE(config.worker.conflation.window == std::chrono::microseconds(2000));
+    REQUIRE(config.worker.aggregate.enabled);
+    REQUIRE(config.worker.aggregate.channel == "TWS:ALL:TICKS");
+    REQUIRE(config.worker.aggregate.window == std::chrono::microseconds(5000));
+    REQUIRE(config.worker.aggregate.encoderThreads == 3);
+    REQUIRE(config.worker.aggregate.encoderBatches == 16);
+    REQUIRE(config.worker.delta.enabled);
+    REQUIRE(config.worker.delta.keyframeEvery == 20);
+    REQUIRE(config.worker.delta.keyframeInterval == std::chrono::seconds(5));
+    REQUIRE(config.worker.compression.aggregate);
+    REQUIRE_FALSE(config.worker.compression.stream);
+    REQUIRE(config.worker.compression.minBytes == 2048);
+    REQUIRE(config.worker.adaptive.enabled);
+    REQUIRE(config.worker.adaptive.maxBatch == 4096);
+    REQUIRE(config.worker.adaptive.maxAddedLatency == std::chrono::milliseconds(2));
+    REQUIRE(config.worker.tiers.size() == 2);
+    REQUIRE(config.worker.tiers[0].name == "10HZ");
+    REQUIRE(config.worker.tiers[0].interval == std::chrono::milliseconds(100));
+    REQUIRE(config.worker.tiers[1].name == "1HZ");
+    REQUIRE(config.worker.options.interval == std::chrono::seconds(1));
+    REQUIRE(config.worker.options.keyframeEvery == 20);
+    REQUIRE(config.worker.barBuilder.timeframes[0] == BarSize::Sec5);
+    REQUIRE(config.worker.barBuilder.timeframes[1] == BarSize::Min1);
+    REQUIRE(config.worker.barBuilder.timeframes[2] == BarSize::Unknown);
+    REQUIRE(config.worker.lag.enabled);
+    REQUIRE(config.worker.lag.warn == std::chrono::milliseconds(50));
+    REQUIRE(config.worker.lag.critical == std::chrono::seconds(1));
+    REQUIRE(config.worker.flight.enabled);
+    REQUIRE(config.worker.flight.threshold == std::chrono::milliseconds(20));
+    REQUIRE(config.worker.flight.capacity == 65536);
+    REQUIRE(config.loadShed.enabled);
+    REQUIRE(config.loadShed.queueAge == std::chrono::milliseconds(100));
+    REQUIRE(config.loadShed.recoverAfter == std::chrono::seconds(10));
+    REQUIRE(config.loadShed.lowPriority == std::vector<std::string>{"IWM"});
+    REQUIRE(config.workerThreads.size() == 4);
+    REQUIRE(config.workerThreads[1].cpu == 3);
+    REQUIRE(config.workerThreads[1].fifoPriority == 80);
+    REQUIRE(config.background.threads == 2);
+    REQUIRE(config.background.cpus == std::vector<int>{6, 7});
+    REQUIRE(config.contracts.path.empty());
+    REQUIRE(config.contracts.maxAge == std::chrono::hours(24));
+    REQUIRE(config.account.enabled);
+    REQUIRE(config.account.id == "DU1234567");
+    REQUIRE(config.account.interval == std::chrono::milliseconds(500));
+    REQUIRE(config.kafka.enabled);
+    REQUIRE(config.kafka.partitioner == KafkaPartitioner::Slot);
+    REQUIRE(config.kafka.format == KafkaFormat::Binary);
+    REQUIRE(config.kafka.linger == std::chrono::milliseconds(20));
+    REQUIRE(config.kafka.compression == "zstd");
+    REQUIRE(config.websocket.enabled);
+    REQUIRE(config.websocket.port == 9000);
+    REQUIRE(config.websocket.binary);
+    REQUIRE(config.websocket.maxConnections == 256);
+    REQUIRE(config.websocket.stallTimeout == std::chrono::seconds(2));
+    REQUIRE(config.query.enabled);
+    REQUIRE(config.query.socketPath == "/run/tws/query.sock");
+    REQUIRE(config.leader.enabled);
+    REQUIRE(config.leader.key == "TWS:LEADER");
+    REQUIRE(config.leader.id == "bridge-a");
+    REQUIRE(config.leader.ttl == std::chrono::seconds(3));
+    REQUIRE(config.leader.renewInterval == std::chrono::seconds(1));
+    REQUIRE(config.partition.enabled);
+    REQUIRE(config.partition.membersKey == "TWS:MEMBERS");
+    REQUIRE(config.partition.heartbeat == std::chrono::milliseconds(500));
+    REQUIRE(config.partition.memberTimeout == std::chrono::seconds(3));
+    REQUIRE(config.timeSeries.enabled);
+    REQUIRE(config.timeSeries.retention == std::chrono::hours(24));
+    REQUIRE(config.timeSeries.compactions.size() == 2);
+    REQUIRE(config.timeSeries.compactions[0].bucket == std::chrono::minutes(1));
+    REQUIRE(config.timeSeries.compactions[1].retention == std::chrono::hours(8760));
+    REQUIRE(config.watchdog.enabled);
+    REQUIRE(config.watchdog.reconnect);
+    REQUIRE(config.watchdog.stallAfter == std::chrono::seconds(5));
+    REQUIRE(config.status.enabled);
+    REQUIRE(config.status.interval == std::chrono::seconds(1));
+    REQUIRE(config.trace.enabled);
+    REQUIRE(config.trace.sampleEvery == 100);
+    REQUIRE(config.trace.path == "tws-bridge-trace.json");
+    REQUIRE(config.allocations.guard == AllocationGuardMode::Abort);
+    REQUIRE(config.allocations.warmup == std::chrono::seconds(30));
+    REQUIRE(config.memory.bytes(MemorySubsystem::PublishSpill) == 64u << 20);
+    REQUIRE(config.memory.websocketMb == 16);
+    REQUIRE(config.memory.ingestSpillMb == 0);
+    REQUIRE(config.logLevel == LogLevel::Debug);
+    REQUIRE(config.symbols == std::vector<std::string>{"AAPL", "MSFT"});
+    REQUIRE(config.feed == FeedType::TopOfBook);
+    REQUIRE(config.universe.key == "TWS:UNIVERSE:EQUITIES");
+    REQUIRE(config.universe.path.empty());
+    REQUIRE(config.universe.pollInterval == std::chrono::seconds(2));
+}
+
+TEST_CASE("Every problem is reported at once", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(apply("tws:\n"
+                        "  port: 70000\n"
+                        "  hots: 10.0.0.1\n"
+                        "ingest:\n"
+                        "  wait:\n"
+                        "    mode: sleepy\n"
+                        "redis:\n"
+                        "  batch:\n"
+                        "    max_delay: 500\n",
+                        config, error));
+    REQUIRE(error.find("tws.port (line 2)") != std::string::npos);
+    REQUIRE(error.find("tws.hots (line 3): unknown key") != std::string::npos);
+    REQUIRE(error.find("expected busy_spin / hybrid / blocking / reactor") != std::string::npos);
+    REQUIRE(error.find("redis.batch.max_delay (line 9)") != std::string::npos);
+}
+
+TEST_CASE("Inconsistent settings fail validation", "[bridge-config]") {
+    std::string error;
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("tws:\n  client_ids: [3, 3]\n", config, error));
+        REQUIRE(error.find("duplicate client ID") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("redis:\n  uri: \"unix:///run/redis.sock\"\n  cluster: true\n", config, error));
+        REQUIRE(error.find("redis.cluster") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("redis:\n  cluster: true\n  direct_resp: true\n", config, error));
+        REQUIRE(error.find("redis.direct_resp") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("redis:\n  resp_backend: io_uring\n", config, error));
+        REQUIRE(error.find("redis.resp_backend: needs redis.direct_resp") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE(apply("redis:\n  function_batches: true\n", config, error));
+        REQUIRE(config.connection.functionBatches);
+        REQUIRE_FALSE(apply("redis:\n  function_batches: true\n  direct_resp: true\n", config, error));
+        REQUIRE(error.find("redis.function_batches") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("redis:\n  uri: \"ftp://host\"\n", config, error));
+        REQUIRE(error.find("redis.uri") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("threads:\n  worker:\n    cpus: [1, 2]\n", config, error));
+        REQUIRE(error.find("2 entries for 1 shards") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("worker:\n  aggregate:\n    encoder_threads: 2\n", config, error));
+        REQUIRE(error.find("worker.aggregate.encoder_threads") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("tws:\n  client_ids: [1, 2]\ningest:\n  overflow: prioritize_trades\n"
+                            "  rebalance:\n    enabled: true\n",
+                            config, error));
+        REQUIRE(error.find("needs ingest.shards > 1") != std::string::npos);
+        REQUIRE(error.find("needs a single TWS connection") != std::string::npos);
+        REQUIRE(error.find("not with ingest.overflow prioritize_trades") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("ingest:\n  lock_memory: true\n", config, error));
+        REQUIRE(error.find("ingest.lock_memory: needs ingest.huge_pages") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("leader:\n  enabled: true\n  ttl: 1s\n  renew_interval: 800ms\n", config, error));
+        REQUIRE(error.find("leader.renew_interval: must be positive and at most half of leader.ttl") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("partition:\n  enabled: true\n  heartbeat: 1s\n  member_timeout: 2s\n", config, error));
+        REQUIRE(error.find("partition.member_timeout: must be at least 3 heartbeats") != std::string::npos);
+    }
+    {
+        BridgeConfig config;
+        REQUIRE_FALSE(apply("baskets:\n  definitions: [\"A=X:1\", \"A=Y:2\", \"B=X\"]\n", config, error));
+        REQUIRE(error.find("'B=X' is not NAME=SYMBOL:weight") != std::string::npos);
+        REQUIRE(error.find("duplicate basket name") != std::string::npos);
+    }
+}
+
+TEST_CASE("Rebalancing makes router slots movable", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(apply("ingest:\n"
+                  "  shards: 4\n"
+                  "  rebalance:\n"
+                  "    enabled: true\n"
+                  "    interval: 2s\n"
+                  "    half_life: 10s\n"
+                  "    threshold: 1.25\n"
+                  "    min_rate: 100\n"
+                  "    handoff_timeout: 500ms\n",
+                  config, error));
+    REQUIRE(config.rebalance.enabled);
+    REQUIRE(config.ingest.movableSlots);
+    REQUIRE(config.rebalance.interval == std::chrono::seconds(2));
+    REQUIRE(config.rebalance.halfLife == std::chrono::seconds(10));
+    REQUIRE(config.rebalance.threshold == 1.25);
+    REQUIRE(config.rebalance.minRate == 100.0);
+    REQUIRE(config.rebalance.handoffTimeout == std::chrono::milliseconds(500));
+}
+
+TEST_CASE("Basket definitions parse into constituents", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(apply("baskets:\n"
+                  "  definitions:\n"
+                  "    - SEMIS=NVDA:0.5,AMD:0.3,INTC:0.2\n"
+                  "  interval: 250ms\n",
+                  config, error));
+    REQUIRE(config.baskets.baskets.size() == 1);
+    REQUIRE(config.baskets.baskets[0].name == "SEMIS");
+    REQUIRE(config.baskets.baskets[0].constituents.size() == 3);
+    REQUIRE(config.baskets.baskets[0].constituents[2].symbol == "INTC");
+    REQUIRE(config.baskets.baskets[0].constituents[2].weight == 0.2);
+    REQUIRE(config.baskets.interval == std::chrono::milliseconds(250));
+    BridgeConfig partitioned;
+    REQUIRE_FALSE(apply("partition:\n  enabled: true\nbaskets:\n  definitions: [\"SEMIS=NVDA:1\"]\n", partitioned, error));
+    REQUIRE(error.find("baskets.definitions: not with partition.enabled") != std::string::npos);
+}
+
+TEST_CASE("TWS socket tuning", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(config.socket.noDelay);
+    REQUIRE(config.readerPoll == std::chrono::milliseconds(100));
+    REQUIRE(apply("tws:\n  reader_poll: 0ms\n  socket:\n    no_delay: false\n    receive_buffer: 4194304\n"
+                  "    busy_poll_us: 50\n    quick_ack: true\n", config, error));
+    REQUIRE(config.readerPoll == std::chrono::milliseconds(0));
+    REQUIRE_FALSE(config.socket.noDelay);
+    REQUIRE(config.socket.receiveBuffer == 4194304);
+    REQUIRE(config.socket.busyPollUs == 50);
+    REQUIRE(config.socket.quickAck);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("tws:\n  socket:\n    busy_poll_us: -1\n", bad, error));
+    REQUIRE(error.find("tws.socket.busy_poll_us") != std::string::npos);
+}
+
+TEST_CASE("Compact mode settings and their conflicts", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.compact);
+    REQUIRE(apply("threads:\n  compact: true\ntws:\n  reader: bridge_ring\n", config, error));
+    REQUIRE(config.compact);
+    REQUIRE(config.readerMode == ReaderMode::Inline);
+    REQUIRE_FALSE(config.io.enabled);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("threads:\n  compact: true\ntws:\n  client_ids: [1, 2]\ningest:\n  shards: 2\n", bad, error));
+    REQUIRE(error.find("threads.compact: needs exactly one tws.client_ids entry") != std::string::npos);
+    REQUIRE(error.find("threads.compact: needs ingest.shards: 1") != std::string::npos);
+}
+
+TEST_CASE("keepUpToDate bar settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.keepBarsUpToDate);
+    REQUIRE(config.worker.liveBarInterval == std::chrono::milliseconds(1000));
+    REQUIRE(apply("subscriptions:\n  keep_bars_up_to_date: true\nworker:\n  live_bar_interval: 250ms\n", config, error));
+    REQUIRE(config.keepBarsUpToDate);
+    REQUIRE(config.worker.liveBarInterval == std::chrono::milliseconds(250));
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("worker:\n  live_bar_interval: 0ms\n", bad, error));
+    REQUIRE(error.find("worker.live_bar_interval: must be positive") != std::string::npos);
+}
+
+TEST_CASE("Incremental history settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.history.incremental);
+    REQUIRE(config.history.window == std::chrono::seconds(3600));
+    REQUIRE(apply("subscriptions:\n  incremental_history: true\n  history_window: 2h\nworker:\n  bar_store:\n"
+                  "    enabled: true\n", config, error));
+    REQUIRE(config.history.incremental);
+    REQUIRE(config.history.window == std::chrono::seconds(7200));
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("subscriptions:\n  incremental_history: true\n  history_window: 0s\n", bad, error));
+    REQUIRE(error.find("subscriptions.incremental_history: needs worker.bar_store.enabled") != std::string::npos);
+    REQUIRE(error.find("subscriptions.history_window: must be positive") != std::string::npos);
+}
+
+TEST_CASE("Demand settings and their conflicts", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.demand.enabled);
+    REQUIRE(config.demand.idleFeed == DemandIdle::TopOfBook);
+    REQUIRE(apply("demand:\n  enabled: true\n  active_feed: tick_by_tick\n  idle_feed: none\n  default_ttl: 10s\n"
+                  "  upgrade_after: 2s\n  downgrade_after: 60s\n  subscribers: true\nredis:\n  watch_subscribers: true\n",
+                  config, error));
+    REQUIRE(config.demand.enabled);
+    REQUIRE(config.demand.activeFeed == FeedType::TickByTick);
+    REQUIRE(config.demand.idleFeed == DemandIdle::None);
+    REQUIRE(config.demand.defaultTtl == std::chrono::seconds(10));
+    REQUIRE(config.demand.upgradeAfter == std::chrono::milliseconds(2000));
+    REQUIRE(config.demand.downgradeAfter == std::chrono::seconds(60));
+    REQUIRE(config.demand.subscribers);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("demand:\n  enabled: true\n  subscribers: true\n  downgrade_after: 0s\n  default_ttl: 2h\n",
+                        bad, error));
+    REQUIRE(error.find("demand.subscribers: needs redis.watch_subscribers") != std::string::npos);
+    REQUIRE(error.find("demand.downgrade_after: must be positive") != std::string::npos);
+    REQUIRE(error.find("demand.default_ttl") != std::string::npos);
+}
+
+TEST_CASE("Movers settings and their conflicts", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.movers.enabled);
+    REQUIRE(apply("movers:\n  enabled: true\n  top: 25\n  interval: 500ms\n  channel: TWS:MOVERS:US\n", config, error));
+    REQUIRE(config.movers.enabled);
+    REQUIRE(config.movers.top == 25);
+    REQUIRE(config.movers.interval == std::chrono::milliseconds(500));
+    REQUIRE(config.movers.channel == "TWS:MOVERS:US");
+    BridgeConfig partitioned;
+    REQUIRE_FALSE(apply("movers:\n  enabled: true\n  top: 0\npartition:\n  enabled: true\n", partitioned, error));
+    REQUIRE(error.find("movers.top") != std::string::npos);
+    REQUIRE(error.find("movers.enabled: not with partition.enabled") != std::string::npos);
+}
+
+TEST_CASE("Deadband defaults and classes", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.worker.deadband.enabled);
+    REQUIRE(apply("worker:\n  deadband:\n    enabled: true\n    min_move: 0.01\n    min_size_change_pct: 20\n"
+                  "    heartbeat: 2s\n    classes:\n      - FX=EURUSD,GBPUSD move=0.0001 heartbeat=5s\n"
+                  "      - TSLA=TSLA size=50%\n", config, error));
+    const DeadbandConfig& deadband = config.worker.deadband;
+    REQUIRE(deadband.enabled);
+    REQUIRE(deadband.defaults.minMove == 0.01);
+    REQUIRE(deadband.defaults.minSizeChange == 0.2);
+    REQUIRE(deadband.defaults.heartbeat == std::chrono::seconds(2));
+    REQUIRE(deadband.classes.size() == 2);
+    REQUIRE(deadband.classes[0].symbols == std::vector<std::string>{"EURUSD", "GBPUSD"});
+    REQUIRE(deadband.ruleFor("GBPUSD").minMove == 0.0001);
+    REQUIRE(deadband.ruleFor("GBPUSD").minSizeChange == 0.2);  // Left out: the default
+    REQUIRE(deadband.ruleFor("GBPUSD").heartbeat == std::chrono::seconds(5));
+    REQUIRE(deadband.ruleFor("TSLA").minSizeChange == 0.5);
+    REQUIRE(deadband.ruleFor("TSLA").minMove == 0.01);
+    REQUIRE(deadband.ruleFor("AAPL").heartbeat == std::chrono::seconds(2));
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("worker:\n  deadband:\n    classes:\n      - FX\n      - FX=EURUSD size=20\n", bad, error));
+    REQUIRE(error.find("'FX'") != std::string::npos);
+    REQUIRE(error.find("'FX=EURUSD size=20'") != std::string::npos);
+}
+
+TEST_CASE("Tick filter settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.worker.tickFilter.enabled);
+    REQUIRE(apply("worker:\n  tick_filter:\n    enabled: true\n    action: count\n    reject_locked: false\n"
+                  "    outlier_spreads: 25\n    spread_window: 64\n    outlier_confirm: 5\n", config, error));
+    const TickFilterConfig& filter = config.worker.tickFilter;
+    REQUIRE(filter.enabled);
+    REQUIRE_FALSE(filter.drop);
+    REQUIRE_FALSE(filter.rejectLocked);
+    REQUIRE(filter.outlierSpreads == 25.0);
+    REQUIRE(filter.spreadWindow == 64);
+    REQUIRE(filter.outlierConfirm == 5);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("worker:\n  tick_filter:\n    action: flag\n    outlier_confirm: 0\n", bad, error));
+    REQUIRE(error.find("worker.tick_filter.action") != std::string::npos);
+    REQUIRE(error.find("worker.tick_filter.outlier_confirm") != std::string::npos);
+}
+
+TEST_CASE("Volume profile settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.worker.volumeProfile.enabled);
+    REQUIRE(apply("worker:\n  volume_profile:\n    enabled: true\n    bucket_width: 0.25\n    chunk_buckets: 32\n"
+                  "    max_buckets: 2048\n    interval: 500ms\n", config, error));
+    const VolumeProfileConfig& profile = config.worker.volumeProfile;
+    REQUIRE(profile.enabled);
+    REQUIRE(profile.bucketWidth == 0.25);
+    REQUIRE(profile.chunkBuckets == 32);
+    REQUIRE(profile.maxBuckets == 2048);
+    REQUIRE(profile.interval == std::chrono::milliseconds(500));
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("worker:\n  volume_profile:\n    enabled: true\n    bucket_width: 0\n", bad, error));
+    REQUIRE(error.find("worker.volume_profile.bucket_width") != std::string::npos);
+}
+
+TEST_CASE("Session statistics settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.worker.sessionStats.enabled);
+    REQUIRE(apply("worker:\n  session_stats:\n    enabled: true\n    interval: 5s\n", config, error));
+    REQUIRE(config.worker.sessionStats.enabled);
+    REQUIRE(config.worker.sessionStats.interval == std::chrono::milliseconds(5000));
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("worker:\n  session_stats:\n    enabled: true\n    interval: 0ms\n", bad, error));
+    REQUIRE(error.find("worker.session_stats.interval") != std::string::npos);
+}
+
+TEST_CASE("Scanner definitions", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(config.scanner.scans.empty());
+    REQUIRE(apply("scanner:\n  scans: [GAINERS=TOP_PERC_GAIN@STK.US.MAJOR:25, HOT=HOT_BY_VOLUME@STK.US]\n"
+                  "  auto_subscribe: true\n  feed: auto\n  priority: -5\n", config, error));
+    REQUIRE(config.scanner.scans.size() == 2);
+    const ScanDefinition& gainers = config.scanner.scans[0];
+    REQUIRE(gainers.id == "GAINERS");
+    REQUIRE(gainers.scanCode == "TOP_PERC_GAIN");
+    REQUIRE(gainers.instrument == "STK");
+    REQUIRE(gainers.location == "STK.US.MAJOR");
+    REQUIRE(gainers.rows == 25);
+    REQUIRE(config.scanner.scans[1].rows == 50);
+    REQUIRE(config.scanner.autoSubscribe);
+    REQUIRE(config.scanner.feed == FeedType::Auto);
+    REQUIRE(config.scanner.priority == -5);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("scanner:\n  scans: [GAINERS=TOP_PERC_GAIN]\n", bad, error));
+    REQUIRE(error.find("scanner.scans") != std::string::npos);
+    BridgeConfig duplicate;
+    REQUIRE_FALSE(apply("scanner:\n  scans: [A=X@STK.US, A=Y@STK.US]\n", duplicate, error));
+    REQUIRE(error.find("duplicate scan id") != std::string::npos);
+}
+
+TEST_CASE("Command batching settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE(config.commands.batchWindow == std::chrono::milliseconds(20));
+    REQUIRE(config.commands.acks);
+    REQUIRE(apply("commands:\n  channel: DESK:COMMANDS\n  batch_window: 0ms\n  max_batch: 256\n  acks: false\n",
+                  config, error));
+    REQUIRE(config.commands.channel == "DESK:COMMANDS");
+    REQUIRE(config.commands.batchWindow == std::chrono::milliseconds(0));
+    REQUIRE(config.commands.maxBatch == 256);
+    REQUIRE_FALSE(config.commands.acks);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("commands:\n  max_batch: 0\n", bad, error));
+    REQUIRE(error.find("commands.max_batch") != std::string::npos);
+}
+
+TEST_CASE("Profiler settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.profiler.enabled);
+    REQUIRE(apply("profiler:\n  enabled: true\n  frequency: 199\n  default_duration: 10s\n  max_duration: 60s\n"
+                  "  max_samples: 4096\n  dir: /tmp\n  key: TWS:PROFILER:LAST\n", config, error));
+    REQUIRE(config.profiler.enabled);
+    REQUIRE(config.profiler.frequency == 199);
+    REQUIRE(config.profiler.defaultDuration == std::chrono::seconds(10));
+    REQUIRE(config.profiler.maxDuration == std::chrono::seconds(60));
+    REQUIRE(config.profiler.maxSamples == 4096);
+    REQUIRE(config.profiler.dir == "/tmp");
+    REQUIRE(config.profiler.key == "TWS:PROFILER:LAST");
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("profiler:\n  enabled: true\n  default_duration: 600s\n  frequency: 5000\n", bad, error));
+    REQUIRE(error.find("profiler.default_duration") != std::string::npos);
+    REQUIRE(error.find("profiler.frequency") != std::string::npos);
+}
+
+TEST_CASE("Queue sizing settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.sizing.enabled);
+    REQUIRE(apply("ingest:\n  sizing:\n    enabled: true\n    adopt: true\n    path: /var/lib/bridge/sizing.txt\n"
+                  "    stall_percentile: 99.9\n    headroom: 2\n    min_capacity: 4096\n    max_capacity: 65536\n",
+                  config, error));
+    REQUIRE(config.sizing.enabled);
+    REQUIRE(config.sizing.adopt);
+    REQUIRE(config.sizing.path == "/var/lib/bridge/sizing.txt");
+    REQUIRE(config.sizing.stallPercentile == 99.9);
+    REQUIRE(config.sizing.headroom == 2.0);
+    REQUIRE(config.sizing.minCapacity == 4096);
+    REQUIRE(config.sizing.maxCapacity == 65536);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("ingest:\n  sizing:\n    adopt: true\n", bad, error));
+    REQUIRE(error.find("ingest.sizing.adopt") != std::string::npos);
+    BridgeConfig inverted;
+    REQUIRE_FALSE(apply("ingest:\n  sizing:\n    min_capacity: 8192\n    max_capacity: 1024\n", inverted, error));
+    REQUIRE(error.find("ingest.sizing.min_capacity") != std::string::npos);
+}
+
+TEST_CASE("News settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.news.enabled);
+    REQUIRE(config.news.providers.size() == 3);
+    REQUIRE(apply("news:\n  enabled: true\n  providers: [BRFG, DJNL]\n  symbols: [AAPL, MSFT]\n  interval: 100ms\n"
+                  "  max_per_pass: 64\n  queue_limit: 1000\n  dedupe_capacity: 4096\n",
+                  config, error));
+    REQUIRE(config.news.enabled);
+    REQUIRE(config.news.providers == std::vector<std::string>{"BRFG", "DJNL"});
+    REQUIRE(config.news.symbols == std::vector<std::string>{"AAPL", "MSFT"});
+    REQUIRE(config.news.interval == std::chrono::milliseconds(100));
+    REQUIRE(config.news.maxPerPass == 64);
+    REQUIRE(config.news.queueLimit == 1000);
+    REQUIRE(config.news.dedupeCapacity == 4096);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("news:\n  enabled: true\n  providers: [\"BRFG+DJNL\"]\n", bad, error));
+    REQUIRE(error.find("news.providers") != std::string::npos);
+    BridgeConfig empty;
+    REQUIRE_FALSE(apply("news:\n  enabled: true\n  providers: []\n", empty, error));
+    REQUIRE(error.find("news.providers") != std::string::npos);
+}
+
+TEST_CASE("Session report settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.report.enabled);
+    REQUIRE(apply("report:\n  enabled: true\n  interval: 5s\n  directory: /var/log/bridge\n  key_prefix: \"BRIDGE:REPORT:\"\n"
+                  "  retention: 0h\n",
+                  config, error));
+    REQUIRE(config.report.enabled);
+    REQUIRE(config.report.interval == std::chrono::seconds(5));
+    REQUIRE(config.report.directory == "/var/log/bridge");
+    REQUIRE(config.report.keyPrefix == "BRIDGE:REPORT:");
+    REQUIRE(config.report.retention.count() == 0);
+    BridgeConfig nowhere;
+    REQUIRE_FALSE(apply("report:\n  enabled: true\n  directory: \"\"\n  key_prefix: \"\"\n", nowhere, error));
+    REQUIRE(error.find("report.directory") != std::string::npos);
+}
+
+TEST_CASE("Batch quote reduction settings", "[bridge-config]") {
+    BridgeConfig config;
+    std::string error;
+    REQUIRE_FALSE(config.worker.conflation.reduceBatch);
+    REQUIRE(apply("worker:\n  conflation:\n    enabled: true\n    reduce_batch: true\n", config, error));
+    REQUIRE(config.worker.conflation.reduceBatch);
+    BridgeConfig bad;
+    REQUIRE_FALSE(apply("worker:\n  conflation:\n    reduce_batch: true\n", bad, error));
+    REQUIRE(error.find("worker.conflation.reduce_batch") != std::string::npos);
+}
+
+TEST_CASE("Only the log level reloads", "[bridge-config]") {
+    REQUIRE(isReloadableKey("log.level"));
+    REQUIRE_FALSE(isReloadableKey("ingest.shards"));
+    REQUIRE_FALSE(isReloadableKey("tws.host"));
+}
@@ -0,0 +1,64 @@
+// test_cache_layout.cpp - Cross-thread state keeps to its own cache lines (false-sharing guard)
+
+#include <catch2/catch_test_macros.hpp>
+#include "RedisPublisher.h"
+#include "RedisWorker.h"
+#include "ShardRouter.h"
+#include "WaitStrategy.h"
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace tws_bridge;
+
+namespace {
+
+constexpr std::size_t kLine = 64;
+
+bool ownLines(const void* begin, std::size_t bytes) {
+    return reinterpret_cast<std::uintptr_t>(begin) % kLine == 0 && bytes % kLine == 0;
+}
+
+} // namespace
+
+TEST_CASE("Counter blocks start and end on cache line boundaries", "[cache-layout]") {
+    REQUIRE(alignof(WorkerCounters) == kLine);
+    REQUIRE(alignof(PublisherCounters) == kLine);
+    REQUIRE(alignof(OverflowCounters) == kLine);
+    WorkerCounters worker;
+    REQUIRE(ownLines(&worker, sizeof(worker)));
+    OverflowCounters overflow;
+    REQUIRE(ownLines(&overflow, sizeof(overflow)));
+}
+
+TEST_CASE("A shard's waiter does not share lines with its queue or overflow counters", "[cache-layout]") {
+    REQUIRE(alignof(ConsumerWaiter) == kLine);
+    REQUIRE(sizeof(ConsumerWaiter) % kLine == 0);
+    SpscShardRouter router(2, 64);
+    auto& shard = router.shard(1);
+    const auto line = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) / kLine; };
+    REQUIRE(ownLines(&shard.waiter, sizeof(shard.waiter)));
+    REQUIRE(line(&shard.overflow) != line(&shard.coalescing));
+    REQUIRE(line(&shard.overflow) != line(&shard.waiter));
+    REQUIRE(ownLines(&shard.overflow, sizeof(shard.overflow)));
+}
+
+TEST_CASE("Instrument state keeps its per-tick fields ahead of the metadata", "[cache-layout]") {
+    REQUIRE(alignof(InstrumentState) == kLine);
+    REQUIRE(sizeof(InstrumentQuote) == 2 * kLine);
+    InstrumentState state;
+    const auto* base = reinterpret_cast<const char*>(&state);
+    const auto at = [base](const void* field) {
+        return static_cast<std::size_t>(reinterpret_cast<const char*>(field) - base);
+    };
+    // Prices, sizes and TWS timestamps share the first line
+    REQUIRE(at(&state.bidPrice) == 0);
+    REQUIRE(at(&state.tradeTimestamp) < kLine);
+    REQUIRE(at(&state.lastSize) < kLine);
+    // Flags, sequence and trade attributes the second, the symbol and conId only after both
+    REQUIRE(at(&state.sizeScale) < 2 * kLine);
+    REQUIRE(at(&state.sequence) < 2 * kLine);
+    REQUIRE(at(&state.symbol) >= 2 * kLine);
+    REQUIRE(at(&state.conId) >= 2 * kLine);
+    REQUIRE(at(&state.derived) >= 2 * kLine);
+}
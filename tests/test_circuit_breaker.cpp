@@ -0,0 +1,89 @@
+// test_circuit_breaker.cpp - Unit tests for the Redis circuit breaker state machine
+
+#include <catch2/catch_test_macros.hpp>
+#include "CircuitBreaker.h"
+
+using namespace tws_bridge;
+using std::chrono::milliseconds;
+
+namespace {
+
+CircuitBreakerPolicy testPolicy() {
+    CircuitBreakerPolicy policy;
+    policy.failureThreshold = 3;
+    policy.probeInterval = milliseconds(100);
+    policy.maxProbeInterval = milliseconds(300);
+    return policy;
+}
+
+} // namespace
+
+TEST_CASE("Circuit opens after consecutive failures only", "[circuit]") {
+    CircuitBreaker breaker(testPolicy());
+    const auto t0 = CircuitBreaker::Clock::time_point{};
+
+    REQUIRE_FALSE(breaker.recordFailure(t0));
+    REQUIRE_FALSE(breaker.recordFailure(t0));
+    breaker.recordSuccess();  // Resets the streak
+    REQUIRE_FALSE(breaker.recordFailure(t0));
+    REQUIRE_FALSE(breaker.recordFailure(t0));
+    REQUIRE(breaker.state() == CircuitState::Closed);
+
+    REQUIRE(breaker.recordFailure(t0));
+    REQUIRE(breaker.state() == CircuitState::Open);
+    REQUIRE(breaker.consecutiveFailures() == 3);
+}
+
+TEST_CASE("Open circuit fails fast until the probe is due", "[circuit]") {
+    CircuitBreaker breaker(testPolicy());
+    const auto t0 = CircuitBreaker::Clock::time_point{};
+    for (int i = 0; i < 3; ++i) {
+        breaker.recordFailure(t0);
+    }
+
+    REQUIRE_FALSE(breaker.allow(t0));
+    REQUIRE_FALSE(breaker.allow(t0 + milliseconds(99)));
+    REQUIRE(breaker.allow(t0 + milliseconds(100)));
+    REQUIRE(breaker.state() == CircuitState::HalfOpen);
+
+    breaker.recordSuccess();
+    REQUIRE(breaker.state() == CircuitState::Closed);
+    REQUIRE(breaker.allow(t0 + milliseconds(100)));
+}
+
+TEST_CASE("Failed probes back off up to the cap", "[circuit]") {
+    CircuitBreaker breaker(testPolicy());
+    auto now = CircuitBreaker::Clock::time_point{};
+    for (int i = 0; i < 3; ++i) {
+        breaker.recordFailure(now);
+    }
+
+    now += milliseconds(100);
+    REQUIRE(breaker.allow(now));
+    REQUIRE(breaker.recordFailure(now));  // HalfOpen → Open, next probe in 200 ms
+    REQUIRE_FALSE(breaker.allow(now + milliseconds(199)));
+    now += milliseconds(200);
+    REQUIRE(breaker.allow(now));
+    REQUIRE(breaker.recordFailure(now));  // 400 ms capped at 300 ms
+    REQUIRE_FALSE(breaker.allow(now + milliseconds(299)));
+    now += milliseconds(300);
+    REQUIRE(breaker.allow(now));
+
+    breaker.recordSuccess();  // Interval restarts at probeInterval
+    for (int i = 0; i < 3; ++i) {
+        breaker.recordFailure(now);
+    }
+    REQUIRE(breaker.allow(now + milliseconds(100)));
+}
+
+TEST_CASE("Disabled breaker never opens", "[circuit]") {
+    CircuitBreakerPolicy policy = testPolicy();
+    policy.enabled = false;
+    CircuitBreaker breaker(policy);
+    const auto t0 = CircuitBreaker::Clock::time_point{};
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE_FALSE(breaker.recordFailure(t0));
+    }
+    REQUIRE(breaker.state() == CircuitState::Closed);
+    REQUIRE(breaker.allow(t0));
+}
@@ -0,0 +1,48 @@
+// test_cluster_slots.cpp - Unit tests for Redis Cluster hash slots and slot → node routing
+
+#include <catch2/catch_test_macros.hpp>
+#include "ClusterSlots.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("CRC16 matches the Redis Cluster reference", "[cluster]") {
+    REQUIRE(clusterCrc16("123456789") == 0x31C3);  // Redis cluster spec test vector
+    REQUIRE(clusterSlot("foo") == 12182);
+    REQUIRE(clusterSlot("bar") == 5061);
+    REQUIRE(clusterSlot("hello") == 866);
+}
+
+TEST_CASE("Hash tags hash only the first non-empty tag", "[cluster]") {
+    REQUIRE(clusterSlot("{user1000}.following") == clusterSlot("{user1000}.followers"));
+    REQUIRE(clusterSlot("TWS:TICKS:{AAPL}") == clusterSlot("AAPL"));
+    REQUIRE(clusterSlot("foo{}{bar}") == clusterSlot("foo{}{bar}"));  // Empty tag: whole key
+    REQUIRE(clusterSlot("foo{}{bar}") != clusterSlot("bar"));
+    REQUIRE(clusterSlot("foo{{bar}}zap") == clusterSlot("{bar"));
+    REQUIRE(clusterSlot("foo{bar") == clusterCrc16("foo{bar") % kClusterSlots);
+}
+
+TEST_CASE("Tag for a slot routes to that slot", "[cluster]") {
+    for (std::uint16_t slot : {0, 1, 866, 5061, 12182, 16383}) {
+        REQUIRE(clusterSlot(clusterTagForSlot(slot)) == slot);
+    }
+}
+
+TEST_CASE("Slot map assigns ranges to deduplicated nodes", "[cluster]") {
+    ClusterSlotMap map;
+    map.assign(0, 5460, "10.0.0.1:7000");
+    map.assign(5461, 10922, "10.0.0.2:7000");
+    map.assign(10923, 16383, "10.0.0.3:7000");
+    map.assign(100, 100, "10.0.0.2:7000");  // Migrated slot, existing node
+
+    REQUIRE(map.nodeCount() == 3);
+    REQUIRE(map.node(0) == 0);
+    REQUIRE(map.node(100) == 1);
+    REQUIRE(map.node(5461) == 1);
+    REQUIRE(map.node(16383) == 2);
+    REQUIRE(map.nodeOf("foo") == 2);  // Slot 12182
+    REQUIRE(map.firstSlot(2) == 10923);
+
+    map.clear();
+    REQUIRE(map.nodeCount() == 0);
+    REQUIRE(map.node(0) == ClusterSlotMap::kNoNode);
+}
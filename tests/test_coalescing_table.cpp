@@ -0,0 +1,90 @@
+// test_coalescing_table.cpp - Unit tests for latest-value mailboxes
+
+#include <catch2/catch_test_macros.hpp>
+#include "CoalescingTable.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+static TickUpdate makeQuote(std::uint16_t slot, std::int64_t timestamp) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.timestamp = timestamp;
+    update.bidAsk.bidPrice = 100.0 + timestamp;
+    return update;
+}
+
+TEST_CASE("Rewrites before a drain keep only the latest value", "[coalescing]") {
+    CoalescingTable table(8);
+    REQUIRE_FALSE(table.hasPending());
+    
+    REQUIRE_FALSE(table.write(3, makeQuote(3, 1)));
+    REQUIRE(table.write(3, makeQuote(3, 2)));  // Superseded before drain
+    REQUIRE_FALSE(table.write(5, makeQuote(5, 7)));
+    REQUIRE(table.isPending(3));
+    REQUIRE_FALSE(table.isPending(4));
+    
+    std::vector<TickUpdate> out(8);
+    REQUIRE(table.drain(out.data(), out.size()) == 2);
+    REQUIRE(out[0].slot == 3);
+    REQUIRE(out[0].timestamp == 2);
+    REQUIRE(out[0].bidAsk.bidPrice == 102.0);
+    REQUIRE(out[1].slot == 5);
+    REQUIRE_FALSE(table.hasPending());
+    REQUIRE(table.drain(out.data(), out.size()) == 0);
+}
+
+TEST_CASE("Partial drain leaves the remaining keys pending", "[coalescing]") {
+    CoalescingTable table(200);
+    for (std::uint16_t key = 60; key < 70; ++key) {  // REASON: Crosses a bitmap word boundary
+        table.write(key, makeQuote(key, key));
+    }
+    
+    std::vector<TickUpdate> out(4);
+    REQUIRE(table.drain(out.data(), out.size()) == 4);
+    REQUIRE(out[3].slot == 63);
+    REQUIRE(table.isPending(64));
+    
+    std::vector<TickUpdate> rest(16);
+    REQUIRE(table.drain(rest.data(), rest.size()) == 6);
+    REQUIRE(rest[0].slot == 64);
+    REQUIRE(rest[5].slot == 69);
+}
+
+TEST_CASE("Concurrent writer never produces a torn read", "[coalescing]") {
+    CoalescingTable table(4);
+    const std::int64_t total = 200000;
+    std::atomic<bool> done{false};
+    
+    std::thread writer([&]() {
+        for (std::int64_t t = 1; t <= total; ++t) {
+            table.write(t % 4, makeQuote(static_cast<std::uint16_t>(t % 4), t));
+        }
+        done.store(true);
+    });
+    
+    bool consistent = true;
+    std::vector<std::int64_t> lastSeen(4, 0);
+    std::vector<TickUpdate> out(4);
+    while (!done.load() || table.hasPending()) {
+        std::size_t count = table.drain(out.data(), out.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            const TickUpdate& update = out[i];
+            // Every field must come from the same write, and values never go backwards
+            consistent = consistent && update.bidAsk.bidPrice == 100.0 + update.timestamp
+                         && update.slot == update.timestamp % 4
+                         && update.timestamp >= lastSeen[update.slot];
+            lastSeen[update.slot] = update.timestamp;
+        }
+    }
+    writer.join();
+    
+    REQUIRE(consistent);
+    for (std::size_t key = 0; key < 4; ++key) {
+        REQUIRE(lastSeen[key] == total - static_cast<std::int64_t>((total - key) % 4));
+    }
+}
@@ -0,0 +1,116 @@
+// test_command_batch.cpp - Per-symbol net change of a TWS:COMMANDS burst and its acks
+
+#include <catch2/catch_test_macros.hpp>
+#include "CommandBatch.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+SubscriptionCommand command(CommandAction action, const std::string& symbol, const std::string& requestId,
+                            FeedType feed = FeedType::Auto) {
+    SubscriptionCommand out;
+    out.action = action;
+    out.symbol = symbol;
+    out.requestId = requestId;
+    out.feed = feed;
+    return out;
+}
+
+// "U:AAPL:r2" per routed command, in order
+std::vector<std::string> routed(CommandBatch& batch) {
+    std::vector<std::string> out;
+    for (const BatchedCommand& next : batch.net()) {
+        const char* action = next.command.action == CommandAction::Subscribe ? "S"
+                           : next.command.action == CommandAction::Unsubscribe ? "U" : "I";
+        out.push_back(std::string(action) + ":" + next.command.symbol + ":" + next.command.requestId);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("Redundant subscribe / unsubscribe pairs collapse to the net change", "[command-batch]") {
+    CommandBatch batch;
+    batch.add(command(CommandAction::Subscribe, "AAPL", "r1"), "p1");
+    batch.add(command(CommandAction::Unsubscribe, "AAPL", "r2"), "p2");
+    batch.add(command(CommandAction::Subscribe, "MSFT", "r3"), "p3");
+    batch.add(command(CommandAction::Subscribe, "MSFT", "r4"), "p4");
+    batch.add(command(CommandAction::Unsubscribe, "TSLA", "r5"), "p5");
+    batch.add(command(CommandAction::Subscribe, "TSLA", "r6"), "p6");
+    batch.add(command(CommandAction::Unsubscribe, "IBM", "r7"), "p7");
+    batch.add(command(CommandAction::Unsubscribe, "IBM", "r8"), "p8");
+
+    REQUIRE(batch.size() == 8);
+    REQUIRE(batch.coalesced() == 3);
+    // NOTE: The unsubscribe survives a subscribe in the same batch - AAPL may have been subscribed before it
+    REQUIRE(routed(batch) == std::vector<std::string>{"U:AAPL:r2", "S:MSFT:r4", "U:TSLA:r5", "S:TSLA:r6", "U:IBM:r7"});
+
+    const std::vector<CommandAck>& acks = batch.acks();
+    REQUIRE(acks.size() == 8);
+    REQUIRE(acks[0].status == AckStatus::Coalesced);
+    REQUIRE(acks[1].status == AckStatus::Queued);
+    REQUIRE(acks[2].status == AckStatus::Coalesced);
+    REQUIRE(acks[3].status == AckStatus::Queued);
+    REQUIRE(acks[4].status == AckStatus::Queued);
+    REQUIRE(acks[5].status == AckStatus::Queued);
+    REQUIRE(acks[6].status == AckStatus::Queued);
+    REQUIRE(acks[7].status == AckStatus::Coalesced);
+    REQUIRE(acks[7].requestId == "r8");
+}
+
+TEST_CASE("Resubscribe after a cancelled subscribe keeps one unsubscribe and the last subscribe", "[command-batch]") {
+    CommandBatch batch;
+    batch.add(command(CommandAction::Subscribe, "SPY", "r1"), "p1");
+    batch.add(command(CommandAction::Unsubscribe, "SPY", "r2"), "p2");
+    batch.add(command(CommandAction::Subscribe, "SPY", "r3"), "p3");
+    batch.add(command(CommandAction::Unsubscribe, "SPY", "r4"), "p4");
+    batch.add(command(CommandAction::Subscribe, "SPY", "r5"), "p5");
+
+    std::vector<BatchedCommand>& net = batch.net();
+    REQUIRE(net.size() == 2);
+    REQUIRE(net[0].command.requestId == "r2");
+    REQUIRE(net[1].command.requestId == "r5");
+    REQUIRE(net[1].payload == "p5");
+    REQUIRE(batch.coalesced() == 3);
+}
+
+TEST_CASE("An option chain and the symbol's own feed are coalesced separately", "[command-batch]") {
+    CommandBatch batch;
+    batch.add(command(CommandAction::Subscribe, "SPY", "r1"), "");
+    batch.add(command(CommandAction::Subscribe, "SPY", "r2", FeedType::OptionChain), "");
+    batch.add(command(CommandAction::Unsubscribe, "SPY", "r3", FeedType::OptionChain), "");
+
+    REQUIRE(routed(batch) == std::vector<std::string>{"S:SPY:r1", "U:SPY:r3"});
+    REQUIRE(batch.coalesced() == 1);
+}
+
+TEST_CASE("Interest, release, profiles and rejections are acked but never coalesced", "[command-batch]") {
+    CommandBatch batch;
+    batch.addPassThrough(command(CommandAction::Interest, "AAPL", "r1"), "p1");
+    batch.addPassThrough(command(CommandAction::Interest, "AAPL", "r2"), "p2");
+    batch.reject(command(CommandAction::Subscribe, "", "r3"), "symbol: required");
+    batch.acknowledge(command(CommandAction::Profile, "", "r4"));
+
+    REQUIRE(routed(batch) == std::vector<std::string>{"I:AAPL:r1", "I:AAPL:r2"});
+    REQUIRE(batch.coalesced() == 0);
+    REQUIRE(batch.acks().size() == 4);
+    REQUIRE(batch.acks()[3].status == AckStatus::Queued);
+    REQUIRE(batch.acks()[2].status == AckStatus::Rejected);
+    REQUIRE(batch.acks()[2].error == "symbol: required");
+    REQUIRE(std::string(ackStatusName(batch.acks()[2].status)) == "rejected");
+}
+
+TEST_CASE("A cleared batch starts over", "[command-batch]") {
+    CommandBatch batch;
+    batch.add(command(CommandAction::Subscribe, "AAPL", "r1"), "");
+    batch.add(command(CommandAction::Subscribe, "AAPL", "r2"), "");
+    REQUIRE(routed(batch).size() == 1);
+    batch.clear();
+    REQUIRE(batch.empty());
+    REQUIRE(batch.coalesced() == 0);
+    batch.add(command(CommandAction::Unsubscribe, "AAPL", "r3"), "");
+    REQUIRE(routed(batch) == std::vector<std::string>{"U:AAPL:r3"});
+}
@@ -0,0 +1,131 @@
+// test_config_file.cpp - Unit tests for the config.yaml subset parser and typed scalars
+
+#include <catch2/catch_test_macros.hpp>
+#include "ConfigFile.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("Nested mappings flatten to dotted keys", "[config]") {
+    ConfigFile file;
+    std::string error;
+    REQUIRE(file.parse("# bridge\n"
+                       "tws:\n"
+                       "  host: 10.0.0.5   # gateway\n"
+                       "  pacing:\n"
+                       "    burst: 5\n"
+                       "redis:\n"
+                       "  uri: \"unix:///run/redis.sock\"\n",
+                       error));
+    REQUIRE(file.values().size() == 3);
+    REQUIRE(file.find("tws.host")->text == "10.0.0.5");
+    REQUIRE(file.find("tws.pacing.burst")->text == "5");
+    REQUIRE(file.find("tws.pacing.burst")->line == 5);
+    REQUIRE(file.find("redis.uri")->text == "unix:///run/redis.sock");
+    REQUIRE(file.find("tws.port") == nullptr);
+}
+
+TEST_CASE("Flow and block lists", "[config]") {
+    ConfigFile file;
+    std::string error;
+    REQUIRE(file.parse("subscriptions:\n"
+                       "  symbols: [AAPL, 'BRK B', SPY]\n"
+                       "  realtime_bars:\n"
+                       "  - SPY\n"
+                       "  - QQQ\n"
+                       "  historical_bars: []\n"
+                       "threads:\n"
+                       "  worker:\n"
+                       "    cpus:\n"
+                       "      - 2\n"
+                       "      - 3\n",
+                       error));
+    const ConfigValue* symbols = file.find("subscriptions.symbols");
+    REQUIRE(symbols->list);
+    REQUIRE(symbols->items == std::vector<std::string>{"AAPL", "BRK B", "SPY"});
+    REQUIRE(file.find("subscriptions.realtime_bars")->items == std::vector<std::string>{"SPY", "QQQ"});
+    REQUIRE(file.find("subscriptions.historical_bars")->list);
+    REQUIRE(file.find("subscriptions.historical_bars")->items.empty());
+    REQUIRE(file.find("threads.worker.cpus")->items == std::vector<std::string>{"2", "3"});
+}
+
+TEST_CASE("Malformed files report the line", "[config]") {
+    std::string error;
+    {
+        ConfigFile file;
+        REQUIRE_FALSE(file.parse("tws:\n  host: a\n  host: b\n", error));
+        REQUIRE(error == "3: duplicate key 'tws.host'");
+    }
+    {
+        ConfigFile file;
+        REQUIRE_FALSE(file.parse("tws:\n\thost: a\n", error));
+        REQUIRE(error.rfind("2: ", 0) == 0);
+    }
+    {
+        ConfigFile file;
+        REQUIRE_FALSE(file.parse("- AAPL\n", error));
+        REQUIRE(error == "1: list item without a key");
+    }
+    {
+        ConfigFile file;
+        REQUIRE_FALSE(file.parse("tws host\n", error));
+        REQUIRE(error == "1: expected 'key: value'");
+    }
+    {
+        ConfigFile file;
+        REQUIRE_FALSE(file.parse("symbols: [AAPL, \"SPY]\n", error));
+    }
+}
+
+TEST_CASE("Command-line overrides replace file values", "[config]") {
+    ConfigFile file;
+    std::string error;
+    REQUIRE(file.parse("ingest:\n  shards: 1\n", error));
+    REQUIRE(file.set("ingest.shards=4", error));
+    REQUIRE(file.set("subscriptions.symbols=[AAPL,SPY]", error));
+    REQUIRE(file.find("ingest.shards")->text == "4");
+    REQUIRE(file.find("ingest.shards")->line == 0);
+    REQUIRE(file.find("subscriptions.symbols")->items.size() == 2);
+    REQUIRE_FALSE(file.set("ingest.shards", error));
+    REQUIRE_FALSE(file.set("=4", error));
+}
+
+TEST_CASE("Typed scalars", "[config]") {
+    long long integer = 0;
+    REQUIRE(parseConfigInt("-42", integer));
+    REQUIRE(integer == -42);
+    REQUIRE_FALSE(parseConfigInt("42x", integer));
+    REQUIRE_FALSE(parseConfigInt("", integer));
+
+    double number = 0.0;
+    REQUIRE(parseConfigDouble("45.5", number));
+    REQUIRE(number == 45.5);
+    REQUIRE_FALSE(parseConfigDouble("fast", number));
+
+    bool flag = false;
+    REQUIRE(parseConfigBool("yes", flag));
+    REQUIRE(flag);
+    REQUIRE(parseConfigBool("off", flag));
+    REQUIRE_FALSE(flag);
+    REQUIRE_FALSE(parseConfigBool("1", flag));
+}
+
+TEST_CASE("Durations need a unit and whole target ticks", "[config]") {
+    std::chrono::microseconds micros{0};
+    REQUIRE(parseConfigDuration("500us", micros));
+    REQUIRE(micros.count() == 500);
+    REQUIRE(parseConfigDuration("2ms", micros));
+    REQUIRE(micros.count() == 2000);
+
+    std::chrono::milliseconds millis{7};
+    REQUIRE(parseConfigDuration("30s", millis));
+    REQUIRE(millis.count() == 30000);
+    REQUIRE_FALSE(parseConfigDuration("500us", millis));  // Not a whole millisecond
+    REQUIRE_FALSE(parseConfigDuration("100", millis));    // No unit
+    REQUIRE_FALSE(parseConfigDuration("ms", millis));
+    REQUIRE_FALSE(parseConfigDuration("5 days", millis));
+    REQUIRE(millis.count() == 30000);  // Unchanged on failure
+
+    std::chrono::minutes minutes{0};
+    REQUIRE(parseConfigDuration("2h", minutes));
+    REQUIRE(minutes.count() == 120);
+}
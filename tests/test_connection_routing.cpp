@@ -0,0 +1,39 @@
+// test_connection_routing.cpp - Unit tests for symbol → TWS connection assignment
+
+#include <catch2/catch_test_macros.hpp>
+#include "ConnectionRouting.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("A single connection owns every symbol", "[routing]") {
+    REQUIRE(connectionFor("AAPL", 1) == 0);
+    REQUIRE(connectionFor("SPY", 0) == 0);
+    REQUIRE(connectionFor("", 1) == 0);
+}
+
+TEST_CASE("Assignment is stable and in range", "[routing]") {
+    for (std::size_t connections : {2u, 3u, 4u, 7u}) {
+        for (const char* symbol : {"AAPL", "SPY", "QQQ", "TSLA", "BRK B", ""}) {
+            const std::size_t connection = connectionFor(symbol, connections);
+            REQUIRE(connection < connections);
+            REQUIRE(connectionFor(std::string(symbol), connections) == connection);
+        }
+    }
+    // REASON: Fixed hash - the same symbol keeps its connection across restarts
+    REQUIRE(connectionFor("AAPL", 4) == connectionFor("AAPL", 4));
+}
+
+TEST_CASE("Symbols spread across connections", "[routing]") {
+    constexpr std::size_t kConnections = 4;
+    constexpr std::size_t kSymbols = 400;
+    std::vector<std::size_t> counts(kConnections, 0);
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        ++counts[connectionFor("SYM" + std::to_string(i), kConnections)];
+    }
+    for (std::size_t count : counts) {
+        REQUIRE(count > kSymbols / kConnections / 2);
+        REQUIRE(count < kSymbols / kConnections * 2);
+    }
+}
@@ -0,0 +1,107 @@
+// test_contract_cache.cpp - Unit tests for the persistent symbol → conId cache
+
+#include <catch2/catch_test_macros.hpp>
+#include "ContractCache.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+using namespace tws_bridge;
+
+namespace {
+
+struct TempFile {
+    explicit TempFile(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / ("tws-contracts-" + name + "-" + std::to_string(::getpid()))).string()) {
+        std::filesystem::remove(path);
+    }
+    ~TempFile() { std::filesystem::remove(path); }
+    std::string path;
+};
+
+void write(const std::string& path, const std::string& text) {
+    std::ofstream out(path, std::ios::trunc);
+    out << text;
+}
+
+} // namespace
+
+TEST_CASE("Missing cache file loads as empty", "[contracts]") {
+    TempFile file("missing");
+    ContractCache cache;
+    std::string error;
+
+    REQUIRE(cache.load(file.path, error));
+    REQUIRE(cache.size() == 0);
+    REQUIRE_FALSE(cache.dirty());
+}
+
+TEST_CASE("Stored contracts survive a save / load round trip", "[contracts]") {
+    TempFile file("roundtrip");
+    std::string error;
+    {
+        ContractCache cache;
+        cache.store("AAPL", CachedContract{265598, "NASDAQ", 1700000000});
+        cache.store("SPY", CachedContract{756733, "ARCA", 1700000100});
+        REQUIRE(cache.dirty());
+        REQUIRE(cache.save(file.path, error));
+        REQUIRE_FALSE(cache.dirty());
+        REQUIRE_FALSE(std::filesystem::exists(file.path + ".tmp"));
+    }
+
+    ContractCache cache;
+    REQUIRE(cache.load(file.path, error));
+    REQUIRE(cache.size() == 2);
+    CachedContract contract;
+    REQUIRE(cache.find("SPY", contract));
+    REQUIRE(contract.conId == 756733);
+    REQUIRE(contract.primaryExchange == "ARCA");
+    REQUIRE(contract.resolvedAt == 1700000100);
+    REQUIRE_FALSE(cache.find("TSLA", contract));
+}
+
+TEST_CASE("Store replaces an existing entry", "[contracts]") {
+    ContractCache cache;
+    cache.store("AAPL", CachedContract{1, "NYSE", 10});
+    cache.store("AAPL", CachedContract{265598, "NASDAQ", 20});
+
+    CachedContract contract;
+    REQUIRE(cache.find("AAPL", contract));
+    REQUIRE(contract.conId == 265598);
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("Malformed line stops the load with its line number", "[contracts]") {
+    TempFile file("malformed");
+    write(file.path, "# comment\nAAPL\t265598\tNASDAQ\t1700000000\nSPY\tnot-a-number\tARCA\t1\nMSFT\t272093\tNASDAQ\t1\n");
+    ContractCache cache;
+    std::string error;
+
+    REQUIRE_FALSE(cache.load(file.path, error));
+    REQUIRE(error == file.path + ":3: expected SYMBOL<TAB>conId<TAB>exchange<TAB>time");
+    REQUIRE(cache.size() == 1);  // Lines before the bad one are kept
+}
+
+TEST_CASE("Empty primary exchange is allowed, conId is not", "[contracts]") {
+    TempFile file("fields");
+    std::string error;
+
+    write(file.path, "AAPL\t265598\t\t1700000000\n");
+    ContractCache cache;
+    REQUIRE(cache.load(file.path, error));
+    CachedContract contract;
+    REQUIRE(cache.find("AAPL", contract));
+    REQUIRE(contract.primaryExchange.empty());
+
+    write(file.path, "AAPL\t0\tNASDAQ\t1700000000\n");
+    ContractCache zero;
+    REQUIRE_FALSE(zero.load(file.path, error));
+}
+
+TEST_CASE("Entries past max age are stale", "[contracts]") {
+    const CachedContract contract{265598, "NASDAQ", 1000};
+
+    REQUIRE_FALSE(ContractCache::stale(contract, 1000 + 3600, std::chrono::hours(1)));
+    REQUIRE(ContractCache::stale(contract, 1000 + 3601, std::chrono::hours(1)));
+}
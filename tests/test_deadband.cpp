@@ -0,0 +1,82 @@
+// test_deadband.cpp - Deadband thresholds against the last published snapshot
+
+#include <catch2/catch_test_macros.hpp>
+#include "Deadband.h"
+
+using namespace tws_bridge;
+
+namespace {
+
+const DeadbandQuote kPublished{100.00, 100.02, 100.01, 1000, 800, 100};
+
+} // namespace
+
+TEST_CASE("Without thresholds every change is significant", "[deadband]") {
+    const DeadbandRule any;
+    REQUIRE_FALSE(deadbandMoved(any, kPublished, kPublished));
+    DeadbandQuote widened = kPublished;
+    widened.bidPrice = 99.99;
+    widened.askPrice = 100.03;  // Same mid
+    REQUIRE(deadbandMoved(any, kPublished, widened));
+    DeadbandQuote resized = kPublished;
+    resized.askSize = 801;
+    REQUIRE(deadbandMoved(any, kPublished, resized));
+}
+
+TEST_CASE("Mid and last must move by the minimum", "[deadband]") {
+    DeadbandRule rule;
+    rule.minMove = 0.01;
+    rule.minSizeChange = 1.0;
+    DeadbandQuote current = kPublished;
+    current.askPrice = 100.03;  // Mid +0.005
+    REQUIRE_FALSE(deadbandMoved(rule, kPublished, current));
+    current.bidPrice = 100.01;  // Mid +0.01 (0.00999... in binary)
+    REQUIRE(deadbandMoved(rule, kPublished, current));
+    current = kPublished;
+    current.lastPrice = 100.02;
+    REQUIRE(deadbandMoved(rule, kPublished, current));
+    current.lastPrice = 100.015;
+    REQUIRE_FALSE(deadbandMoved(rule, kPublished, current));
+}
+
+TEST_CASE("A one-sided quote compares each side", "[deadband]") {
+    DeadbandRule rule;
+    rule.minMove = 0.05;
+    DeadbandQuote current = kPublished;
+    current.askPrice = 0.0;  // Ask pulled
+    REQUIRE(deadbandMoved(rule, kPublished, current));
+    DeadbandQuote published = current;
+    current.bidPrice = 100.01;
+    REQUIRE_FALSE(deadbandMoved(rule, published, current));
+}
+
+TEST_CASE("Sizes must change by more than the fraction", "[deadband]") {
+    DeadbandRule rule;
+    rule.minMove = 1.0;
+    rule.minSizeChange = 0.2;
+    DeadbandQuote current = kPublished;
+    current.bidSize = 1200;  // Exactly 20%
+    REQUIRE_FALSE(deadbandMoved(rule, kPublished, current));
+    current.bidSize = 1201;
+    REQUIRE(deadbandMoved(rule, kPublished, current));
+    current = kPublished;
+    current.lastSize = 50;
+    REQUIRE(deadbandMoved(rule, kPublished, current));
+    DeadbandQuote empty = kPublished;
+    empty.askSize = 0;
+    current = empty;
+    current.askSize = 1;  // From nothing: any size is a change
+    REQUIRE(deadbandMoved(rule, empty, current));
+}
+
+TEST_CASE("The first class listing a symbol wins", "[deadband]") {
+    DeadbandConfig config;
+    config.defaults.minMove = 0.01;
+    DeadbandClass fx{"FX", {"EURUSD", "GBPUSD"}, {}};
+    fx.rule.minMove = 0.0001;
+    DeadbandClass euro{"EUR", {"EURUSD"}, {}};
+    euro.rule.minMove = 0.5;
+    config.classes = {fx, euro};
+    REQUIRE(config.ruleFor("EURUSD").minMove == 0.0001);
+    REQUIRE(config.ruleFor("AAPL").minMove == 0.01);
+}
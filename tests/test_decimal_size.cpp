@@ -0,0 +1,64 @@
+// test_decimal_size.cpp - BID64 sizes and prices decoded without libbid, libbid fallback for the rest
+
+#include <catch2/catch_test_macros.hpp>
+#include "DecimalSize.h"
+#include <cstdint>
+
+using namespace tws_bridge;
+
+namespace {
+
+// ±coefficient * 10^exponent in the small-coefficient BID64 encoding
+Decimal bid64(std::uint64_t coefficient, int exponent, bool negative = false) {
+    return (negative ? std::uint64_t{1} << 63 : 0) | static_cast<std::uint64_t>(exponent + 398) << 53 | coefficient;
+}
+
+} // namespace
+
+TEST_CASE("Common exponents decode to the correctly rounded double", "[decimal_size]") {
+    REQUIRE(decimalToDouble(bid64(100, 0)) == 100.0);
+    REQUIRE(decimalToDouble(bid64(12345, -2)) == 123.45);
+    REQUIRE(decimalToDouble(bid64(1, -1)) == 0.1);
+    REQUIRE(decimalToDouble(bid64(5, 2)) == 500.0);
+    REQUIRE(decimalToDouble(bid64(1234567, -4, true)) == -123.4567);
+    REQUIRE(decimalToDouble(bid64(0, 0)) == 0.0);
+}
+
+TEST_CASE("Sizes round to whole shares half away from zero", "[decimal_size]") {
+    REQUIRE(decimalToShares(bid64(100, 0)) == 100);
+    REQUIRE(decimalToShares(bid64(25, -1)) == 3);
+    REQUIRE(decimalToShares(bid64(24999, -4)) == 2);
+    REQUIRE(decimalToShares(bid64(25, -1, true)) == -3);
+    REQUIRE(decimalToShares(bid64(3, 2)) == 300);
+    REQUIRE(decimalToShares(bid64(1, -18)) == 0);
+    REQUIRE(decimalToShares(bid64(99, 18)) == 0);  // NOTE: Past int64
+    REQUIRE(decimalToShares(UNSET_DECIMAL) == 0);
+}
+
+TEST_CASE("Sizes decode to exact scaled integers", "[decimal_size]") {
+    auto same = [](Quantity a, std::int64_t units, int scale) { return a.units == units && a.scale == scale; };
+    REQUIRE(same(decimalToQuantity(bid64(100, 0)), 100, 0));
+    REQUIRE(same(decimalToQuantity(bid64(3, 2)), 300, 0));
+    REQUIRE(same(decimalToQuantity(bid64(2500, -3)), 25, 1));  // Trailing zeros stripped
+    REQUIRE(same(decimalToQuantity(bid64(12345678, -8)), 12345678, 8));
+    REQUIRE(same(decimalToQuantity(bid64(15, -10)), 0, 8));  // NOTE: Past kMaxQuantityScale, rounded
+    REQUIRE(same(decimalToQuantity(bid64(25, -1, true)), -25, 1));
+    REQUIRE(same(decimalToQuantity(UNSET_DECIMAL), 0, 0));
+}
+
+TEST_CASE("Plain size text is parsed in place, the rest goes through libbid", "[decimal_size]") {
+    std::int64_t units = 0;
+    int scale = 0;
+    REQUIRE(bidTextToQuantity("100", units, scale));
+    REQUIRE((units == 100 && scale == 0));
+    REQUIRE(bidTextToQuantity("0.5", units, scale));
+    REQUIRE((units == 5 && scale == 1));
+    REQUIRE(bidTextToQuantity("1200.25", units, scale));
+    REQUIRE((units == 120025 && scale == 2));
+    REQUIRE(bidTextToQuantity("7.", units, scale));
+    REQUIRE((units == 7 && scale == 0));
+
+    REQUIRE(bidTextToQuantity("1E3", units, scale));
+    REQUIRE((units == 1000 && scale == 0));
+    REQUIRE_FALSE(bidTextToQuantity("abc", units, scale));
+}
@@ -0,0 +1,51 @@
+// test_derived_metrics.cpp - Incremental mid / spread / VWAP / rolling volume
+#include <catch2/catch_test_macros.hpp>
+#include "DerivedMetrics.h"
+
+using namespace tws_bridge;
+
+constexpr std::int64_t kReset = 9 * 3600 * 1000;    // 09:00 UTC
+constexpr std::int64_t kDay = 1699920000000;       // 2023-11-14 00:00 UTC
+
+TEST_CASE("Mid and spread need both sides", "[derived]") {
+    DerivedMetrics metrics;
+    metrics.onQuote(100.0, 100.5);
+    REQUIRE(metrics.mid == 100.25);
+    REQUIRE(metrics.spread == 0.5);
+    metrics.onQuote(0.0, 100.5);
+    REQUIRE(metrics.mid == 0.0);
+    REQUIRE(metrics.spread == 0.0);
+}
+
+TEST_CASE("Session VWAP resets at the session boundary", "[derived]") {
+    DerivedMetrics metrics;
+    metrics.onTrade(kDay + kReset + 1000, 10.0, 100, kReset);
+    metrics.onTrade(kDay + kReset + 2000, 20.0, 300, kReset);
+    REQUIRE(metrics.vwap == (10.0 * 100 + 20.0 * 300) / 400);
+    REQUIRE(metrics.sessionVolume == 400);
+
+    // 08:59 UTC next day: still the same session
+    metrics.onTrade(kDay + 86400000 + kReset - 60000, 30.0, 100, kReset);
+    REQUIRE(metrics.sessionVolume == 500);
+
+    // 09:00 UTC: new session
+    metrics.onTrade(kDay + 86400000 + kReset, 40.0, 50, kReset);
+    REQUIRE(metrics.sessionVolume == 50);
+    REQUIRE(metrics.vwap == 40.0);
+}
+
+TEST_CASE("Rolling volume drops trades leaving the window", "[derived]") {
+    RollingVolume rolling;
+    rolling.setWindow(60000);  // 1s buckets
+    rolling.add(kDay, 100);
+    rolling.add(kDay + 30000, 200);
+    REQUIRE(rolling.total() == 300);
+    rolling.add(kDay + 59999, 1);
+    REQUIRE(rolling.total() == 301);
+    rolling.add(kDay + 60000, 10);   // First bucket expires
+    REQUIRE(rolling.total() == 211);
+    rolling.add(kDay + 10, 5);       // Older than the window
+    REQUIRE(rolling.total() == 211);
+    rolling.add(kDay + 3600000, 7);  // Long gap clears everything
+    REQUIRE(rolling.total() == 7);
+}
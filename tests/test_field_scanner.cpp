@@ -0,0 +1,74 @@
+// test_field_scanner.cpp - Unit tests for the one-pass NUL terminator index
+
+#include <catch2/catch_test_macros.hpp>
+#include "FieldScanner.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+// Terminator offsets the slow way
+static std::vector<std::uint32_t> expectedEnds(const std::string& bytes) {
+    std::vector<std::uint32_t> ends;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        if (bytes[i] == '\0') {
+            ends.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return ends;
+}
+
+static std::vector<std::uint32_t> scannedEnds(const std::string& bytes, bool& complete) {
+    FieldIndex index;
+    scanFieldTerminators(bytes.data(), bytes.data() + bytes.size(), index);
+    complete = index.complete;
+    return std::vector<std::uint32_t>(index.ends, index.ends + index.count);
+}
+
+TEST_CASE("Terminators are found across 16-byte blocks and in the tail", "[scanner]") {
+    // Field lengths chosen so terminators land on block edges (15, 16, 31) and in a short tail
+    std::string bytes;
+    for (std::size_t length : {15u, 0u, 14u, 1u, 3u, 17u, 0u, 5u}) {
+        bytes.append(length, 'x');
+        bytes.push_back('\0');
+    }
+    bytes += "tail";  // Unterminated last field
+    bool complete = false;
+    REQUIRE(scannedEnds(bytes, complete) == expectedEnds(bytes));
+    REQUIRE(complete);
+}
+
+TEST_CASE("Every frame length and alignment matches a bytewise scan", "[scanner]") {
+    const std::string pattern = "99\0" "12\0" "3\0" "1700000000\0" "171.55\0" "171.57\0" "100\0" "200\0" "0\0";
+    for (std::size_t offset = 0; offset < 16; ++offset) {
+        for (std::size_t length = 0; length + offset <= pattern.size(); ++length) {
+            const std::string bytes = pattern.substr(offset, length);
+            bool complete = false;
+            REQUIRE(scannedEnds(bytes, complete) == expectedEnds(bytes));
+            REQUIRE(complete);
+        }
+    }
+}
+
+TEST_CASE("Frames with more fields than the index stop early", "[scanner]") {
+    std::string bytes;
+    for (std::size_t i = 0; i < FieldIndex::kMaxFields + 3; ++i) {
+        bytes += "ab";
+        bytes.push_back('\0');
+    }
+    bool complete = true;
+    const std::vector<std::uint32_t> ends = scannedEnds(bytes, complete);
+    REQUIRE_FALSE(complete);
+    REQUIRE(ends.size() == FieldIndex::kMaxFields);
+    const std::vector<std::uint32_t> all = expectedEnds(bytes);
+    REQUIRE(std::equal(ends.begin(), ends.end(), all.begin()));
+
+    std::string exact;
+    for (std::size_t i = 0; i < FieldIndex::kMaxFields; ++i) {
+        exact += "ab";
+        exact.push_back('\0');
+    }
+    REQUIRE(scannedEnds(exact, complete).size() == FieldIndex::kMaxFields);
+    REQUIRE(complete);
+}
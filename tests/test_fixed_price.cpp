@@ -0,0 +1,45 @@
+// test_fixed_price.cpp - Unit tests for 1e-4 tick prices and their integer formatting
+
+#include <catch2/catch_test_macros.hpp>
+#include "FixedPrice.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+using namespace tws_bridge;
+
+static std::string formatPrice(double price) {
+    std::int64_t ticks = 0;
+    REQUIRE(toPriceTicks(price, ticks));
+    char buffer[24];
+    return std::string(buffer, writeFixedPrice(buffer, ticks));
+}
+
+TEST_CASE("Decimal prices round to their exact tick", "[fixed-price]") {
+    std::int64_t ticks = 0;
+    REQUIRE(toPriceTicks(171.55, ticks));
+    REQUIRE(ticks == 1715500);
+    REQUIRE(toPriceTicks(0.1 + 0.2, ticks));
+    REQUIRE(ticks == 3000);
+    REQUIRE(toPriceTicks(-0.0001, ticks));
+    REQUIRE(ticks == -1);
+}
+
+TEST_CASE("Fixed-point layout trims trailing zeros", "[fixed-price]") {
+    REQUIRE(formatPrice(171.55) == "171.55");
+    REQUIRE(formatPrice(172.0) == "172.0");
+    REQUIRE(formatPrice(0.0) == "0.0");
+    REQUIRE(formatPrice(0.0001) == "0.0001");
+    REQUIRE(formatPrice(0.1 + 0.2) == "0.3");
+    REQUIRE(formatPrice(-3.5) == "-3.5");
+    REQUIRE(formatPrice(-0.0203) == "-0.0203");
+    REQUIRE(formatPrice(123456789.25) == "123456789.25");
+}
+
+TEST_CASE("Values without a tick representation are rejected", "[fixed-price]") {
+    std::int64_t ticks = 0;
+    REQUIRE_FALSE(toPriceTicks(std::numeric_limits<double>::quiet_NaN(), ticks));
+    REQUIRE_FALSE(toPriceTicks(std::numeric_limits<double>::infinity(), ticks));
+    REQUIRE_FALSE(toPriceTicks(1e20, ticks));
+}
@@ -0,0 +1,89 @@
+// test_flight_recorder.cpp - Flight recorder: ring wrap, spike trigger, cooldown, dump file
+
+#include <catch2/catch_test_macros.hpp>
+#include "FlightRecorder.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+FlightRecord tick(std::int64_t callbackNs, SlotId slot) {
+    return FlightRecord{callbackNs, callbackNs + 1000, callbackNs + 5000, callbackNs + 8000, 0, slot,
+                        TickUpdateType::BidAsk};
+}
+
+bool waitForDumps(const FlightRecorder& recorder, std::uint64_t count) {
+    for (int i = 0; i < 500 && recorder.dumps() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return recorder.dumps() >= count;
+}
+
+} // namespace
+
+TEST_CASE("The ring keeps the newest records, oldest first", "[flight]") {
+    FlightRecorderConfig config;
+    config.capacity = 6;  // Rounded up to 8
+    FlightRecorder recorder(config, 0, nullptr);
+    for (std::int64_t i = 1; i <= 20; ++i) {
+        recorder.stage(tick(i * 1000000, static_cast<SlotId>(i)));
+        recorder.commit(i * 1000000 + 10000, 0, std::chrono::nanoseconds(0));
+    }
+    REQUIRE(recorder.written() == 20);
+    REQUIRE(recorder.pending() == 0);
+
+    std::vector<FlightRecord> records;
+    REQUIRE(recorder.copy(recorder.written(), records) == 8);
+    REQUIRE(records.front().slot == 13);
+    REQUIRE(records.back().slot == 20);
+    REQUIRE(records.back().publishNs == 20 * 1000000 + 10000);
+    REQUIRE(recorder.copy(5, records) == 0);  // Long overwritten
+}
+
+TEST_CASE("A slow tick dumps the ring once per cooldown", "[flight]") {
+    FlightRecorderConfig config;
+    config.capacity = 64;
+    config.threshold = std::chrono::microseconds(5000);
+    config.cooldown = std::chrono::seconds(10);
+    config.dir = ".";
+    FlightRecorder recorder(config, 7, nullptr);
+    recorder.start();
+
+    const std::int64_t second = 1000000000;
+    recorder.stage(tick(second, 1));
+    recorder.commit(second + 2000000, 3, std::chrono::microseconds(800));  // 2 ms: fine
+    REQUIRE(recorder.dumps() == 0);
+
+    recorder.stage(tick(2 * second, 2));
+    recorder.stage(tick(2 * second + 4000000, 3));
+    recorder.commit(2 * second + 20000000, 1200, std::chrono::microseconds(900));  // Slot 2 took 20 ms
+    REQUIRE(waitForDumps(recorder, 1));
+
+    // Within the cooldown: recorded, not dumped
+    recorder.stage(tick(3 * second, 4));
+    recorder.commit(3 * second + 30000000, 0, std::chrono::nanoseconds(0));
+    recorder.stop();
+    REQUIRE(recorder.dumps() == 1);
+    REQUIRE(recorder.written() == 4);
+
+    const std::string path = recorder.lastDump();
+    std::ifstream in(path);
+    REQUIRE(in.good());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    in.close();
+    std::remove(path.c_str());
+    REQUIRE(lines.size() == 6);
+    REQUIRE(lines[0] == "# shard 7, trigger 2 bid_ask 20000.0 us callback -> publish (threshold 5000 us)");
+    REQUIRE(lines[1] == "# queue_depth 1200, redis_rtt_us 900.0, 3 records");
+    REQUIRE(lines[2] == "symbol,type,callback_ns,enqueue_us,dequeue_us,serialize_us,publish_us");
+    REQUIRE(lines[4] == "2,bid_ask,2000000000,1.0,5.0,8.0,20000.0");
+}
@@ -0,0 +1,69 @@
+// test_gap_backfill.cpp - Unit tests for the reconnect gap window and reqHistoricalTicks paging
+
+#include <catch2/catch_test_macros.hpp>
+#include "GapBackfill.h"
+#include "MarketData.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("Gap window spans the outage, capped at maxGap", "[backfill]") {
+    const GapWindow window = gapWindow(1700000000500, 1700000060000, std::chrono::seconds(600));
+    REQUIRE(window.fromMs == 1700000000500);
+    REQUIRE(window.toMs == 1700000060000);
+    REQUIRE_FALSE(window.empty());
+
+    // Longer than maxGap: only its most recent part
+    const GapWindow capped = gapWindow(1700000000000, 1700003600000, std::chrono::seconds(600));
+    REQUIRE(capped.fromMs == 1700003000000);
+    REQUIRE(capped.toMs == 1700003600000);
+
+    // Within one second: nothing a whole-second tick could fill
+    REQUIRE(gapWindow(1700000000000, 1700000001000, std::chrono::seconds(600)).empty());
+}
+
+TEST_CASE("Only ticks strictly inside the gap are kept", "[backfill]") {
+    const GapWindow window = gapWindow(1700000000000, 1700000010000, std::chrono::seconds(600));
+    REQUIRE_FALSE(window.contains(1700000000));   // Second of the last live tick
+    REQUIRE(window.contains(1700000001));
+    REQUIRE(window.contains(1700000009));
+    REQUIRE_FALSE(window.contains(1700000010));   // Second of the first live tick
+
+    // L1 watermark inside a second: that second is before the gap
+    const GapWindow l1 = gapWindow(1700000000700, 1700000010000, std::chrono::seconds(600));
+    REQUIRE_FALSE(l1.contains(1700000000));
+    REQUIRE(l1.contains(1700000001));
+}
+
+TEST_CASE("Full pages continue a second after their last tick", "[backfill]") {
+    const GapWindow window = gapWindow(1700000000000, 1700000600000, std::chrono::seconds(600));
+    std::int64_t next = 0;
+    REQUIRE(nextBackfillPage(window, kHistoricalTicksPage, 1700000120, next));
+    REQUIRE(next == 1700000121);
+    // A page completing its last second holds more than numberOfTicks
+    REQUIRE(nextBackfillPage(window, kHistoricalTicksPage + 7, 1700000240, next));
+    REQUIRE(next == 1700000241);
+
+    REQUIRE_FALSE(nextBackfillPage(window, 999, 1700000120, next));              // Short page: last one
+    REQUIRE_FALSE(nextBackfillPage(window, kHistoricalTicksPage, 1700000600, next));  // Reached live ticks
+}
+
+TEST_CASE("Start times are UTC in the reqHistoricalTicks format", "[backfill]") {
+    REQUIRE(historicalTicksTime(0) == "19700101-00:00:00");
+    REQUIRE(historicalTicksTime(1792081805) == "20261015-16:30:05");
+}
+
+TEST_CASE("Backfilled quotes and trades are never coalesced", "[backfill]") {
+    TickUpdate update;
+    update.type = TickUpdateType::BidAsk;
+    REQUIRE(isCoalescable(update));
+    update.flags = TickFlags::Backfill;
+    REQUIRE(update.backfilled());
+    REQUIRE_FALSE(isCoalescable(update));
+
+    update.type = TickUpdateType::AllLast;
+    update.flags = TickFlags::PastLimit;
+    REQUIRE(isCoalescable(update));
+    update.flags |= TickFlags::Backfill;
+    REQUIRE(update.pastLimit());
+    REQUIRE_FALSE(isCoalescable(update));
+}
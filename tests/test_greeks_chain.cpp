@@ -0,0 +1,110 @@
+// test_greeks_chain.cpp - Unit tests for the worker's per-chain greeks table and batch encoder
+
+#include <catch2/catch_test_macros.hpp>
+#include "GreeksChain.h"
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+TickUpdate makeGreeks(std::uint32_t leg, std::uint32_t expiry, double strike, bool put, float delta,
+                      std::int64_t timestamp) {
+    TickUpdate update;
+    update.slot = 4;
+    update.type = TickUpdateType::Greeks;
+    update.aux = leg;
+    update.flags = put ? TickFlags::Put : 0;
+    update.timestamp = timestamp;
+    update.greeks.strike = strike;
+    update.greeks.optionPrice = 5.25;
+    update.greeks.underlyingPrice = 450.5;
+    update.greeks.impliedVol = 0.25f;
+    update.greeks.delta = delta;
+    update.greeks.gamma = 0.0125f;
+    update.greeks.vega = 0.5f;
+    update.greeks.theta = -0.125f;
+    update.greeks.expiry = expiry;
+    return update;
+}
+
+struct Published {
+    std::vector<std::pair<std::string, std::string>> batches;
+
+    auto sink() {
+        return [this](std::string_view channel, std::string_view payload) {
+            batches.emplace_back(std::string(channel), std::string(payload));
+        };
+    }
+};
+
+} // namespace
+
+TEST_CASE("Greeks update legs in place, one batch per changed expiry", "[greeks]") {
+    GreeksChain chain("TWS:CHAIN:SPY:");
+    JsonBuffer json;
+    Published published;
+
+    REQUIRE(chain.apply(makeGreeks(0, 20261120, 450.0, false, 0.5f, 1000)));
+    REQUIRE(chain.apply(makeGreeks(1, 20261120, 450.0, true, -0.5f, 1001)));
+    REQUIRE(chain.apply(makeGreeks(0, 20261120, 450.0, false, 0.625f, 1002)));  // Same leg again
+    REQUIRE(chain.apply(makeGreeks(2, 20261218, 450.0, false, 0.5f, 1003)));
+    REQUIRE(chain.legs() == 3);
+    REQUIRE(chain.expiries() == 2);
+
+    REQUIRE(chain.flush("SPY", 20, json, published.sink()) == 2);
+    REQUIRE(published.batches[0].first == "TWS:CHAIN:SPY:20261120");
+    REQUIRE(published.batches[0].second ==
+            "{\"instrument\":\"SPY\",\"expiry\":\"20261120\",\"timestamp\":1002,\"full\":true,\"legs\":["
+            "{\"k\":450.0,\"r\":\"C\",\"iv\":0.25,\"d\":0.625,\"g\":0.0125,\"v\":0.5,\"t\":-0.125,\"p\":5.25,\"u\":450.5},"
+            "{\"k\":450.0,\"r\":\"P\",\"iv\":0.25,\"d\":-0.5,\"g\":0.0125,\"v\":0.5,\"t\":-0.125,\"p\":5.25,\"u\":450.5}]}");
+    REQUIRE(published.batches[1].first == "TWS:CHAIN:SPY:20261218");
+
+    // Nothing changed - nothing published
+    REQUIRE(chain.flush("SPY", 20, json, published.sink()) == 0);
+}
+
+TEST_CASE("Delta batches carry changed legs only, keyframes all of them", "[greeks]") {
+    GreeksChain chain("TWS:CHAIN:SPY:");
+    JsonBuffer json;
+    Published published;
+
+    for (std::uint32_t leg = 0; leg < 4; ++leg) {
+        chain.apply(makeGreeks(leg, 20261120, 440.0 + 5.0 * (leg / 2), (leg & 1) != 0, 0.5f, 1000));
+    }
+    REQUIRE(chain.flush("SPY", 3, json, published.sink()) == 1);  // Batch 0: keyframe
+
+    chain.apply(makeGreeks(3, 20261120, 445.0, true, -0.375f, 2000));
+    REQUIRE(chain.flush("SPY", 3, json, published.sink()) == 1);  // Batch 1: delta
+    const std::string& delta = published.batches.back().second;
+    REQUIRE(delta.find("\"full\":false") != std::string::npos);
+    REQUIRE(delta.find("\"k\":445.0,\"r\":\"P\",\"iv\":0.25,\"d\":-0.375") != std::string::npos);
+    REQUIRE(delta.find("\"k\":440.0") == std::string::npos);
+
+    chain.apply(makeGreeks(3, 20261120, 445.0, true, -0.25f, 3000));
+    chain.flush("SPY", 3, json, published.sink());                  // Batch 2: delta
+    chain.apply(makeGreeks(3, 20261120, 445.0, true, -0.125f, 4000));
+    chain.flush("SPY", 3, json, published.sink());                  // Batch 3: keyframe
+    const std::string& keyframe = published.batches.back().second;
+    REQUIRE(keyframe.find("\"full\":true") != std::string::npos);
+    REQUIRE(keyframe.find("\"k\":440.0,\"r\":\"C\"") != std::string::npos);
+    REQUIRE(keyframe.find("\"timestamp\":4000") != std::string::npos);
+}
+
+TEST_CASE("Uncomputed greeks encode as null, bad leg indexes are rejected", "[greeks]") {
+    GreeksChain chain("TWS:CHAIN:SPY:");
+    JsonBuffer json;
+    Published published;
+
+    TickUpdate update = makeGreeks(0, 20261120, 450.0, false, 0.5f, 1000);
+    update.greeks.impliedVol = std::nanf("");
+    REQUIRE(chain.apply(update));
+    chain.flush("SPY", 0, json, published.sink());
+    REQUIRE(published.batches[0].second.find("\"iv\":null,\"d\":0.5") != std::string::npos);
+    REQUIRE(published.batches[0].second.find("\"full\":false") != std::string::npos);  // keyframeEvery 0 = never
+
+    REQUIRE_FALSE(chain.apply(makeGreeks(GreeksChain::kMaxLegs, 20261120, 450.0, false, 0.5f, 1000)));
+}
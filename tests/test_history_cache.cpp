@@ -0,0 +1,72 @@
+// test_history_cache.cpp - Incremental startup backfill: missing ranges against the bar store, request strings
+
+#include <catch2/catch_test_macros.hpp>
+#include "HistoryCache.h"
+
+using namespace tws_bridge;
+
+namespace {
+
+constexpr std::int64_t kBarMs = 300000;                    // 5 mins
+constexpr std::int64_t kNowMs = 1760538600000;             // 2025-10-15 14:30:00 UTC
+constexpr std::int64_t kFromMs = kNowMs - 3600000;         // One hour window
+
+CachedBars cached(std::int64_t oldestMs, std::int64_t newestMs, std::size_t count) {
+    CachedBars bars;
+    bars.oldestMs = oldestMs;
+    bars.newestMs = newestMs;
+    bars.count = count;
+    return bars;
+}
+
+} // namespace
+
+TEST_CASE("An empty cache requests the whole window", "[history-cache]") {
+    const auto ranges = missingHistoryRanges(CachedBars{}, kFromMs, kNowMs, kBarMs);
+    REQUIRE(ranges.size() == 1);
+    REQUIRE(ranges[0].fromMs == kFromMs);
+    REQUIRE(ranges[0].toMs == kNowMs);
+    REQUIRE(ranges[0].current);
+    REQUIRE(historicalDuration(ranges[0]) == "3600 S");
+    REQUIRE(historicalEndTime(ranges[0]).empty());
+}
+
+TEST_CASE("A warm cache requests the minutes since its newest bar", "[history-cache]") {
+    const auto ranges = missingHistoryRanges(cached(kFromMs, kNowMs - 2 * kBarMs, 11), kFromMs, kNowMs, kBarMs);
+    REQUIRE(ranges.size() == 1);
+    REQUIRE(ranges[0].fromMs == kNowMs - 2 * kBarMs);      // The newest stored bar again
+    REQUIRE(ranges[0].current);
+    REQUIRE(historicalDuration(ranges[0]) == "600 S");
+}
+
+TEST_CASE("A cache starting late also requests the window's start", "[history-cache]") {
+    const std::int64_t oldestMs = kFromMs + 4 * kBarMs;
+    const auto ranges = missingHistoryRanges(cached(oldestMs, kNowMs - kBarMs, 8), kFromMs, kNowMs, kBarMs);
+    REQUIRE(ranges.size() == 2);
+    REQUIRE(ranges[0].fromMs == kFromMs);
+    REQUIRE(ranges[0].toMs == oldestMs);
+    REQUIRE_FALSE(ranges[0].current);
+    REQUIRE(historicalDuration(ranges[0]) == "1200 S");
+    REQUIRE(historicalEndTime(ranges[0]) == "20251015-13:50:00");
+    REQUIRE(ranges[1].current);
+
+    // Less than a bar short of the window start: nothing older is missing
+    const auto close = missingHistoryRanges(cached(kFromMs + 1000, kNowMs - kBarMs, 11), kFromMs, kNowMs, kBarMs);
+    REQUIRE(close.size() == 1);
+}
+
+TEST_CASE("A cache older than the window counts as empty", "[history-cache]") {
+    const auto ranges = missingHistoryRanges(cached(kFromMs - 10 * kBarMs, kFromMs - kBarMs, 9), kFromMs, kNowMs, kBarMs);
+    REQUIRE(ranges.size() == 1);
+    REQUIRE(ranges[0].fromMs == kFromMs);
+}
+
+TEST_CASE("Durations past a day switch to whole days", "[history-cache]") {
+    HistoryRange range;
+    range.toMs = 86400000;
+    REQUIRE(historicalDuration(range) == "86400 S");
+    range.toMs = 86400001;
+    REQUIRE(historicalDuration(range) == "2 D");
+    range.toMs = 10;
+    REQUIRE(historicalDuration(range) == "1 S");
+}
@@ -0,0 +1,77 @@
+// test_huge_pages.cpp - Unit tests for 2 MB page backing of the shard queue and coalescing table
+
+#include <catch2/catch_test_macros.hpp>
+#include "CoalescingTable.h"
+#include "HugePages.h"
+#include "SpscRing.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("Regions are whole 2 MB pages, aligned and prefaulted", "[huge-pages]") {
+    HugePageRegion region(100000, false);
+    REQUIRE(region.data() != nullptr);
+    REQUIRE(region.size() == kHugePageBytes);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(region.data()) % kHugePageBytes == 0);
+    REQUIRE(region.backing().prefaulted);
+    REQUIRE((region.backing().hugetlb || region.backing().transparent));
+    static_cast<char*>(region.data())[region.size() - 1] = 1;  // Whole mapping writable
+
+    HugePageRegion moved(std::move(region));
+    REQUIRE(region.data() == nullptr);
+    REQUIRE(moved.size() == kHugePageBytes);
+    REQUIRE(HugePageRegion(0, false).data() == nullptr);
+}
+
+TEST_CASE("A ring on huge pages behaves like one on the heap", "[huge-pages]") {
+    HugePageConfig memory;
+    memory.enabled = true;
+    SpscRing<std::uint64_t> ring(1000, memory);
+    REQUIRE(ring.capacity() == 1024);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(ring.storage()) % kHugePageBytes == 0);
+    REQUIRE(ring.backing().prefaulted);
+    for (std::uint64_t round = 0; round < 3; ++round) {
+        for (std::uint64_t i = 0; i < 1024; ++i) {
+            REQUIRE(ring.try_enqueue(round * 1024 + i));
+        }
+        REQUIRE_FALSE(ring.try_enqueue(0));
+        std::vector<std::uint64_t> out(1024);
+        REQUIRE(ring.try_dequeue_bulk(out.begin(), 1024) == 1024);
+        REQUIRE(out.back() == round * 1024 + 1023);
+    }
+
+    SpscRing<std::uint64_t> heap(16);
+    REQUIRE_FALSE(heap.backing().prefaulted);
+}
+
+TEST_CASE("A coalescing table on huge pages starts clean", "[huge-pages]") {
+    HugePageConfig memory;
+    memory.enabled = true;
+    CoalescingTable table(10000, memory);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(table.storage()) % kHugePageBytes == 0);
+    REQUIRE(table.backing().prefaulted);
+    REQUIRE_FALSE(table.hasPending());
+
+    TickUpdate update;
+    update.slot = 7;
+    update.bidAsk.bidPrice = 1.5;
+    REQUIRE_FALSE(table.write(9999, update));
+    TickUpdate out;
+    REQUIRE(table.take(9999, out));
+    REQUIRE(out.bidAsk.bidPrice == 1.5);
+}
+
+TEST_CASE("Advising an existing buffer keeps its contents", "[huge-pages]") {
+    std::vector<std::uint32_t> states(3 * kHugePageBytes / sizeof(std::uint32_t));
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        states[i] = static_cast<std::uint32_t>(i);
+    }
+    const HugePageBacking backing = adviseHugePages(states.data(), states.size() * sizeof(std::uint32_t), false);
+    REQUIRE(backing.prefaulted);
+    REQUIRE_FALSE(backing.locked);
+    for (std::size_t i = 0; i < states.size(); i += 4099) {
+        REQUIRE(states[i] == i);
+    }
+}
@@ -0,0 +1,84 @@
+// test_instrument_registry.cpp - Unit tests for dense instrument slot assignment
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("Slots are dense and stable per symbol", "[registry]") {
+    InstrumentRegistry registry(8);
+    
+    SlotId aapl = registry.registerInstrument("AAPL", 1001);
+    SlotId spy = registry.registerInstrument("SPY", 2001);
+    
+    REQUIRE(aapl == 0);
+    REQUIRE(spy == 1);
+    REQUIRE(registry.registerInstrument("AAPL", 11001) == aapl);
+    REQUIRE(registry.tickerId(aapl) == 1001);  // First registration wins
+    REQUIRE(registry.size() == 2);
+    REQUIRE(registry.symbol(spy) == "SPY");
+    REQUIRE(registry.channels(spy).ticks == "TWS:TICKS:SPY");
+    REQUIRE(registry.channels(spy).stream == "TWS:STREAM:SPY");
+    REQUIRE(registry.find("SPY") == spy);
+    REQUIRE(registry.find("TSLA") == kInvalidSlot);
+}
+
+TEST_CASE("Contract identity is unresolved until set", "[registry]") {
+    InstrumentRegistry registry(4);
+    SlotId aapl = registry.registerInstrument("AAPL");
+    
+    REQUIRE(registry.conId(aapl) == 0);
+    REQUIRE(registry.primaryExchange(aapl) == kUnknownExchange);
+    
+    registry.setContract(aapl, 265598, exchangeCode("NASDAQ"));
+    REQUIRE(registry.conId(aapl) == 265598);
+    REQUIRE(exchangeName(registry.primaryExchange(aapl)) == "NASDAQ");
+    
+    // NOTE: conIds use the full int range
+    registry.setContract(aapl, 2147483647, kUnknownExchange);
+    REQUIRE(registry.conId(aapl) == 2147483647);
+    REQUIRE(registry.primaryExchange(aapl) == kUnknownExchange);
+}
+
+TEST_CASE("Registry rejects symbols beyond capacity", "[registry]") {
+    InstrumentRegistry registry(2);
+    
+    REQUIRE(registry.registerInstrument("AAPL") != kInvalidSlot);
+    REQUIRE(registry.registerInstrument("SPY") != kInvalidSlot);
+    REQUIRE(registry.registerInstrument("TSLA") == kInvalidSlot);
+    REQUIRE(registry.size() == 2);
+}
+
+TEST_CASE("Symbols are pre-escaped as JSON literals at registration", "[registry]") {
+    InstrumentRegistry registry(4);
+
+    SlotId aapl = registry.registerInstrument("AAPL");
+    SlotId odd = registry.registerInstrument("BRK \"B\"\\\n");
+
+    REQUIRE(registry.symbolJson(aapl) == "\"AAPL\"");
+    REQUIRE(registry.symbolJson(odd) == "\"BRK \\\"B\\\"\\\\\\n\"");
+}
+
+TEST_CASE("Concurrent registration from several connections keeps one slot per symbol", "[registry]") {
+    InstrumentRegistry registry(64);
+    std::vector<SlotId> slots[2];
+    auto subscribe = [&registry](std::vector<SlotId>& out) {
+        for (int i = 0; i < 32; ++i) {
+            out.push_back(registry.registerInstrument("SYM" + std::to_string(i)));
+        }
+    };
+    std::thread first(subscribe, std::ref(slots[0]));
+    std::thread second(subscribe, std::ref(slots[1]));
+    first.join();
+    second.join();
+    
+    REQUIRE(registry.size() == 32);
+    REQUIRE(slots[0] == slots[1]);
+    for (int i = 0; i < 32; ++i) {
+        REQUIRE(registry.symbol(slots[0][i]) == "SYM" + std::to_string(i));
+    }
+}
@@ -0,0 +1,83 @@
+// test_iso_timestamp.cpp - Cached ISO 8601 formatter vs gmtime_r / strftime
+
+#include <catch2/catch_test_macros.hpp>
+#include "IsoTimestamp.h"
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <string>
+
+using namespace tws_bridge;
+
+static std::string format(IsoTimestampFormatter& formatter, std::int64_t timestampMs) {
+    char buffer[IsoTimestampFormatter::kLength];
+    char* end = formatter.format(timestampMs, buffer);
+    REQUIRE(end == buffer + sizeof(buffer));
+    return std::string(buffer, end);
+}
+
+static std::string reference(std::int64_t timestampMs) {
+    std::int64_t seconds = timestampMs / 1000;
+    std::int64_t millis = timestampMs % 1000;
+    if (millis < 0) {
+        seconds -= 1;
+        millis += 1000;
+    }
+    const std::time_t time = static_cast<std::time_t>(seconds);
+    std::tm utc{};
+    gmtime_r(&time, &utc);
+    char buffer[64];
+    const std::size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &utc);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%03dZ", static_cast<int>(millis));
+    return buffer;
+}
+
+TEST_CASE("Known instants", "[iso]") {
+    IsoTimestampFormatter formatter;
+    REQUIRE(format(formatter, 0) == "1970-01-01T00:00:00.000Z");
+    REQUIRE(format(formatter, 1700000000123) == "2023-11-14T22:13:20.123Z");
+    REQUIRE(format(formatter, 951782400000) == "2000-02-29T00:00:00.000Z");    // Leap day, 400-year rule
+    REQUIRE(format(formatter, 4107542399999) == "2100-02-28T23:59:59.999Z");   // 2100 is not a leap year
+    REQUIRE(format(formatter, 4107542400000) == "2100-03-01T00:00:00.000Z");
+    REQUIRE(format(formatter, -1) == "1969-12-31T23:59:59.999Z");
+}
+
+TEST_CASE("Cache follows second, minute and day boundaries", "[iso]") {
+    IsoTimestampFormatter formatter;
+    const std::int64_t base = 1704067199000;  // 2023-12-31T23:59:59.000Z
+    REQUIRE(format(formatter, base) == "2023-12-31T23:59:59.000Z");
+    REQUIRE(format(formatter, base + 999) == "2023-12-31T23:59:59.999Z");
+    REQUIRE(format(formatter, base + 1000) == "2024-01-01T00:00:00.000Z");
+    REQUIRE(format(formatter, base + 1001) == "2024-01-01T00:00:00.001Z");
+    REQUIRE(format(formatter, base + 2000) == "2024-01-01T00:00:01.000Z");
+    REQUIRE(format(formatter, base) == "2023-12-31T23:59:59.000Z");          // Going back in time
+}
+
+TEST_CASE("Matches gmtime for random and sequential timestamps", "[iso]") {
+    IsoTimestampFormatter formatter;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<std::int64_t> any(-2208988800000, 4102444800000);  // 1900 - 2100
+    for (int i = 0; i < 20000; ++i) {
+        const std::int64_t timestampMs = any(rng);
+        REQUIRE(format(formatter, timestampMs) == reference(timestampMs));
+    }
+    // REASON: A tick stream mostly hits the cached second / minute paths
+    std::int64_t timestampMs = 1700000000000;
+    for (int i = 0; i < 20000; ++i) {
+        timestampMs += static_cast<std::int64_t>(rng() % 50);
+        REQUIRE(format(formatter, timestampMs) == reference(timestampMs));
+    }
+}
+
+TEST_CASE("Out-of-range timestamps are clamped to years 0000-9999", "[iso]") {
+    IsoTimestampFormatter formatter;
+    REQUIRE(format(formatter, INT64_MAX) == "9999-12-31T23:59:59.999Z");
+    REQUIRE(format(formatter, INT64_MIN) == "0000-01-01T00:00:00.000Z");
+}
+
+TEST_CASE("Per-thread convenience function", "[iso]") {
+    char buffer[IsoTimestampFormatter::kLength];
+    formatIsoTimestamp(1700000000123, buffer);
+    REQUIRE(std::string(buffer, sizeof(buffer)) == "2023-11-14T22:13:20.123Z");
+}
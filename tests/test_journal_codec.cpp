@@ -0,0 +1,186 @@
+// test_journal_codec.cpp - Compressed journal blocks: lossless round trip, price escapes, block restarts
+
+#include <catch2/catch_test_macros.hpp>
+#include "JournalCodec.h"
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::vector<JournalEntry> decode(JournalBlockEncoder& encoder) {
+    JournalBlockDecoder decoder;
+    REQUIRE(decoder.load(encoder.seal(), encoder.encoded().size()));
+    std::vector<JournalEntry> entries;
+    JournalEntry entry;
+    while (!decoder.exhausted()) {
+        REQUIRE(decoder.next(entry));
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+} // namespace
+
+TEST_CASE("Every update type decodes to the fields it was encoded from", "[journal_codec]") {
+    JournalBlockEncoder encoder(4096, 4);
+    encoder.addSymbol(2, "AAPL", 1000);
+    REQUIRE(encoder.announced(2));
+    REQUIRE_FALSE(encoder.announced(1));
+
+    TickUpdate quote;
+    quote.slot = 2;
+    quote.timestamp = 1700000000000;
+    quote.flags = TickFlags::Backfill | static_cast<std::uint8_t>(1u << TickFlags::SizeScaleShift);
+    quote.bidAsk.bidPrice = 171.55;
+    quote.bidAsk.askPrice = 1.083451;  // NOTE: Below a 1e-4 tick - escaped to the raw double
+    quote.bidAsk.bidSize = 15;
+    quote.bidAsk.askSize = -3;
+    encoder.addTick(quote, 1500);
+
+    TickUpdate trade;
+    trade.slot = 2;
+    trade.type = TickUpdateType::AllLast;
+    trade.timestamp = 1699999999000;  // Older than the quote - negative delta
+    trade.allLast.price = std::numeric_limits<double>::quiet_NaN();
+    trade.allLast.size = 100;
+    trade.allLast.exchange = 7;
+    trade.allLast.conditions = TradeConditions{1} << 63;
+    encoder.addTick(trade, 1400);
+
+    TickUpdate depth;
+    depth.slot = 2;
+    depth.type = TickUpdateType::Depth;
+    depth.depth.price = -0.0;
+    depth.depth.size = std::int64_t{1} << 40;
+    depth.depth.position = 9;
+    depth.depth.operation = 1;
+    depth.depth.side = 1;
+    encoder.addTick(depth, 1600);
+
+    TickUpdate bar;
+    bar.slot = 2;
+    bar.type = TickUpdateType::Bar;
+    bar.aux = 42;
+    bar.bar = BarPayload{171.0, 172.5, 170.25, 171.75, 123456, 171.3333};
+    encoder.addTick(bar, 1700);
+
+    TickUpdate greeks;
+    greeks.slot = 2;
+    greeks.type = TickUpdateType::Greeks;
+    greeks.aux = 3;
+    greeks.greeks.strike = 170.0;
+    greeks.greeks.delta = 0.51f;
+    greeks.greeks.expiry = 20261120;
+    encoder.addTick(greeks, 1800);
+
+    TickUpdate mid;
+    mid.slot = 2;
+    mid.type = TickUpdateType::MidPoint;
+    mid.midPoint.midPoint = 171.56;
+    encoder.addTick(mid, 1900);
+    REQUIRE(encoder.records() == 7);
+    REQUIRE(encoder.ticks() == 6);
+
+    const std::vector<JournalEntry> entries = decode(encoder);
+    REQUIRE(entries.size() == 7);
+    REQUIRE(entries[0].kind == JournalRecordKind::Symbol);
+    REQUIRE(entries[0].slot == 2);
+    REQUIRE(entries[0].symbol == "AAPL");
+    REQUIRE(entries[0].receiveNs == 1000);
+
+    const TickUpdate& q = entries[1].update;
+    REQUIRE(q.type == TickUpdateType::BidAsk);
+    REQUIRE(q.flags == quote.flags);
+    REQUIRE(q.timestamp == quote.timestamp);
+    REQUIRE(q.bidAsk.bidPrice == 171.55);
+    REQUIRE(q.bidAsk.askPrice == 1.083451);
+    REQUIRE(q.bidAsk.bidSize == 15);
+    REQUIRE(q.bidAsk.askSize == -3);
+    REQUIRE(entries[1].receiveNs == 1500);
+
+    const TickUpdate& t = entries[2].update;
+    REQUIRE(t.timestamp == 1699999999000);
+    REQUIRE(std::isnan(t.allLast.price));
+    REQUIRE(t.allLast.size == 100);
+    REQUIRE(t.allLast.exchange == 7);
+    REQUIRE(t.allLast.conditions == trade.allLast.conditions);
+    REQUIRE(entries[2].receiveNs == 1400);
+
+    const TickUpdate& d = entries[3].update;
+    REQUIRE(std::signbit(d.depth.price));
+    REQUIRE(d.depth.size == depth.depth.size);
+    REQUIRE((d.depth.position == 9 && d.depth.operation == 1 && d.depth.side == 1));
+
+    const TickUpdate& b = entries[4].update;
+    REQUIRE(b.aux == 42);
+    REQUIRE(b.bar.open == 171.0);
+    REQUIRE(b.bar.high == 172.5);
+    REQUIRE(b.bar.low == 170.25);
+    REQUIRE(b.bar.close == 171.75);
+    REQUIRE(b.bar.wap == 171.3333);
+    REQUIRE(b.bar.volume == 123456);
+
+    const TickUpdate& g = entries[5].update;
+    REQUIRE(g.aux == 3);
+    REQUIRE(g.greeks.strike == 170.0);
+    REQUIRE(g.greeks.delta == 0.51f);
+    REQUIRE(g.greeks.expiry == 20261120);
+
+    REQUIRE(entries[6].update.midPoint.midPoint == 171.56);
+}
+
+TEST_CASE("Each block decodes without the blocks before it", "[journal_codec]") {
+    JournalBlockEncoder encoder(4096, 2);
+    TickUpdate quote;
+    quote.slot = 1;
+    quote.timestamp = 1700000000000;
+    quote.bidAsk.bidPrice = 100.0;
+    quote.bidAsk.askPrice = 100.01;
+    encoder.addSymbol(1, "SPY", 10);
+    encoder.addTick(quote, 10);
+    const std::string first(encoder.seal());
+    const std::size_t firstEncoded = encoder.encoded().size();
+    encoder.reset();
+
+    REQUIRE_FALSE(encoder.announced(1));  // REASON: Every block repeats its Symbol records
+    encoder.addSymbol(1, "SPY", 20);
+    quote.timestamp += 5;
+    quote.bidAsk.bidPrice = 100.02;
+    encoder.addTick(quote, 20);
+
+    // Second block alone - full values, not deltas to the first block
+    const std::vector<JournalEntry> entries = decode(encoder);
+    REQUIRE(entries.size() == 2);
+    REQUIRE(entries[1].update.timestamp == 1700000000005);
+    REQUIRE(entries[1].update.bidAsk.bidPrice == 100.02);
+    REQUIRE(entries[1].receiveNs == 20);
+
+    JournalBlockDecoder decoder;
+    REQUIRE_FALSE(decoder.load(first, firstEncoded + 1));  // Length mismatch = corrupt
+    REQUIRE(decoder.load(first, firstEncoded));
+}
+
+TEST_CASE("Repeated quotes compress well below the raw record size", "[journal_codec]") {
+    JournalBlockEncoder encoder(JournalBlockEncoder::kDefaultBlockBytes, 8);
+    for (SlotId slot = 0; slot < 8; ++slot) {
+        encoder.addSymbol(slot, "SYM" + std::to_string(slot), 0);
+    }
+    int ticks = 0;
+    while (!encoder.full()) {
+        TickUpdate quote;
+        quote.slot = static_cast<SlotId>(ticks % 8);
+        quote.timestamp = 1700000000000 + ticks / 8;
+        quote.bidAsk.bidPrice = 50.0 + (ticks % 5) * 0.01;
+        quote.bidAsk.askPrice = quote.bidAsk.bidPrice + 0.01;
+        quote.bidAsk.bidSize = 100 * (1 + ticks % 3);
+        quote.bidAsk.askSize = 200;
+        encoder.addTick(quote, 1700000000000000000 + ticks * 2500);
+        ++ticks;
+    }
+    REQUIRE(encoder.encoded().size() / ticks < 24);
+    REQUIRE(encoder.seal().size() < encoder.encoded().size());
+}
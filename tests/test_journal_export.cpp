@@ -0,0 +1,191 @@
+// test_journal_export.cpp - Parquet file framing, delta compactness, journal → per-symbol export layout
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "JournalExport.h"
+#include "ParquetWriter.h"
+#include "TickJournal.h"
+#include "JournalTestSupport.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::journal_test;
+
+namespace {
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// "PAR1" ... footer, uint32 footer length, "PAR1"
+void requireParquetFraming(const std::string& bytes) {
+    REQUIRE(bytes.size() >= 12);
+    REQUIRE(bytes.compare(0, 4, "PAR1") == 0);
+    REQUIRE(bytes.compare(bytes.size() - 4, 4, "PAR1") == 0);
+    std::uint32_t footer = 0;
+    std::memcpy(&footer, bytes.data() + bytes.size() - 8, sizeof(footer));
+    REQUIRE(footer > 0);
+    REQUIRE(footer <= bytes.size() - 12);
+}
+
+TickUpdate bidAsk(SlotId slot, std::int64_t timestamp, double bid) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.timestamp = timestamp;
+    update.bidAsk.bidPrice = bid;
+    update.bidAsk.askPrice = bid + 0.02;
+    update.bidAsk.bidSize = 100;
+    update.bidAsk.askSize = 200;
+    return update;
+}
+
+} // namespace
+
+TEST_CASE("Parquet writer frames row groups and footer", "[parquet]") {
+    TempDirectory directory("framing");
+    const std::string path = directory.path + "/table.parquet";
+    ParquetWriter writer(path, {{"symbol", ParquetType::String, ParquetEncoding::Dictionary},
+                                {"time", ParquetType::Int64, ParquetEncoding::Delta, ParquetTimeUnit::Millis},
+                                {"price", ParquetType::Double},
+                                {"size", ParquetType::Int32},
+                                {"flag", ParquetType::Boolean}});
+    for (int group = 0; group < 2; ++group) {
+        for (int i = 0; i < 100; ++i) {
+            writer.column(0).append(std::string_view(i % 3 == 0 ? "AAPL" : "MSFT"));
+            writer.column(1).append(static_cast<std::int64_t>(1700000000000 + i));
+            writer.column(2).append(171.5 + i);
+            writer.column(3).append(static_cast<std::int64_t>(i));
+            writer.column(4).append(static_cast<std::int64_t>(i % 2));
+        }
+        REQUIRE(writer.bufferedRows() == 100);
+        REQUIRE(writer.flush());
+        REQUIRE(writer.bufferedRows() == 0);
+    }
+    REQUIRE(writer.close({{"source", "test"}}));
+    REQUIRE(writer.rows() == 200);
+    REQUIRE(writer.rowGroups() == 2);
+
+    const std::string bytes = readFile(path);
+    requireParquetFraming(bytes);
+    REQUIRE(bytes.find("AAPL") != std::string::npos);    // Dictionary page
+    REQUIRE(bytes.find("source") != std::string::npos);  // Footer key/value metadata
+}
+
+TEST_CASE("Parquet writer rejects ragged columns and writes valid empty files", "[parquet]") {
+    TempDirectory directory("ragged");
+    ParquetWriter empty(directory.path + "/empty.parquet", {{"time", ParquetType::Int64}});
+    REQUIRE(empty.close());
+    requireParquetFraming(readFile(directory.path + "/empty.parquet"));
+
+    ParquetWriter ragged(directory.path + "/ragged.parquet", {{"a", ParquetType::Int64}, {"b", ParquetType::Double}});
+    ragged.column(0).append(std::int64_t{1});
+    REQUIRE_FALSE(ragged.flush());
+    REQUIRE(ragged.bufferedRows() == 0);  // Dropped, not retried
+    REQUIRE_FALSE(ragged.close());
+}
+
+TEST_CASE("Delta encoding packs regular timestamps far below 8 bytes per row", "[parquet]") {
+    TempDirectory directory("delta");
+    const std::size_t rows = 100000;
+    ParquetWriter plain(directory.path + "/plain.parquet", {{"time", ParquetType::Int64}});
+    ParquetWriter delta(directory.path + "/delta.parquet",
+                        {{"time", ParquetType::Int64, ParquetEncoding::Delta, ParquetTimeUnit::Nanos}});
+    std::int64_t time = 1700000000000000000;
+    for (std::size_t i = 0; i < rows; ++i) {
+        time += 1000 + static_cast<std::int64_t>(i % 7) * 100;  // ~1μs apart, jittered
+        plain.column(0).append(time);
+        delta.column(0).append(time);
+    }
+    REQUIRE(plain.close());
+    REQUIRE(delta.close());
+    const auto plainBytes = std::filesystem::file_size(directory.path + "/plain.parquet");
+    const auto deltaBytes = std::filesystem::file_size(directory.path + "/delta.parquet");
+    REQUIRE(plainBytes >= rows * 8);
+    REQUIRE(deltaBytes < rows * 2);  // 10-bit deltas
+}
+
+TEST_CASE("Export writes one file per symbol and update kind", "[export]") {
+    TempDirectory journalDir("journal");
+    TempDirectory exportDir("out");
+    InstrumentRegistry registry(16);
+    const SlotId aapl = registry.registerInstrument("AAPL", 1);
+    const SlotId brk = registry.registerInstrument("BRK B", 2);
+
+    JournalConfig journalConfig;
+    journalConfig.directory = journalDir.path;
+    journalConfig.segmentBytes = 1 << 20;
+    TickJournal journal(registry, journalConfig);
+    REQUIRE(journal.start());
+    for (int i = 0; i < 10; ++i) {
+        journal.append(bidAsk(aapl, 1700000000000 + i, 171.0 + i));
+        journal.append(bidAsk(brk, 1700000000000 + i, 350.0 + i));
+    }
+    TickUpdate trade;
+    trade.slot = aapl;
+    trade.type = TickUpdateType::AllLast;
+    trade.timestamp = 1700000000010;
+    trade.allLast.price = 171.5;
+    trade.allLast.size = 300;
+    journal.append(trade);
+    TickUpdate bar;
+    bar.slot = aapl;
+    bar.type = TickUpdateType::Bar;
+    bar.setBarSize(BarSize::Min1);
+    bar.timestamp = 1700000000000;
+    bar.bar.close = 171.4;
+    journal.append(bar);
+    TickUpdate end;
+    end.slot = aapl;
+    end.type = TickUpdateType::HistoryEnd;
+    journal.append(end);
+    journal.stop();
+
+    ExportConfig config;
+    config.directory = exportDir.path;
+    config.rowGroupRows = 4;  // Several row groups per quotes file
+    JournalExporter exporter(config);
+    REQUIRE(exporter.run(journalDir.path));
+
+    const ExportCounters& counters = exporter.counters();
+    REQUIRE(counters.rows == 22);  // HistoryEnd carries no data
+    REQUIRE(counters.files == 4);
+    REQUIRE(counters.segments == 1);
+    REQUIRE(counters.unmapped == 0);
+    REQUIRE(counters.errors == 0);
+    REQUIRE(counters.rowGroups == 3 + 3 + 1 + 1);
+
+    const std::string session = exportDir.path + "/" + journal.session();
+    for (const char* file : {"/quotes/AAPL.parquet", "/quotes/BRK_B.parquet", "/trades/AAPL.parquet", "/bars/AAPL.parquet"}) {
+        INFO(file);
+        REQUIRE(std::filesystem::exists(session + file));
+        requireParquetFraming(readFile(session + file));
+    }
+    REQUIRE_FALSE(std::filesystem::exists(session + "/trades/BRK_B.parquet"));
+    REQUIRE_FALSE(std::filesystem::exists(session + "/depth"));
+
+    TempDirectory filteredDir("filtered");
+    config.directory = filteredDir.path;
+    config.filter.symbols = {"BRK B"};
+    JournalExporter filtered(config);
+    REQUIRE(filtered.run(journalDir.path));
+    REQUIRE(filtered.counters().rows == 10);
+    REQUIRE(filtered.counters().files == 1);
+    REQUIRE(std::filesystem::exists(filteredDir.path + "/" + journal.session() + "/quotes/BRK_B.parquet"));
+}
+
+TEST_CASE("Export rejects input that is not a journal", "[export]") {
+    TempDirectory directory("invalid");
+    { std::ofstream(directory.path + "/bogus.tjl") << "not a journal"; }
+    ExportConfig config;
+    config.directory = directory.path + "/out";
+    JournalExporter exporter(config);
+    REQUIRE_FALSE(exporter.run(directory.path));
+    REQUIRE(exporter.counters().files == 0);
+}
@@ -0,0 +1,175 @@
+// test_journal_index.cpp - Segment index (.tjx) contents, index-guided scans vs sequential scans, time parsing
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "InstrumentRegistry.h"
+#include "JournalIndex.h"
+#include "TickJournal.h"
+#include "JournalTestSupport.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::journal_test;
+
+namespace {
+
+constexpr int kTicks = 60000;
+
+struct ScanResult {
+    std::vector<std::int64_t> ticks;      // Timestamps of the ticks handed out
+    std::vector<std::string> symbols;     // Symbols announced (first segment)
+    std::uint64_t skippedBytes = 0;
+    int indexedSegments = 0;
+};
+
+ScanResult scan(const std::string& directory, const JournalFilter& filter) {
+    ScanResult result;
+    TickJournalScan reader(filter);
+    bool first = true;
+    for (const std::string& path : TickJournalReader::segments(directory)) {
+        REQUIRE(reader.open(path));
+        result.indexedSegments += reader.indexed() ? 1 : 0;
+        JournalEntry entry;
+        while (reader.next(entry)) {
+            if (entry.kind == JournalRecordKind::Tick) {
+                result.ticks.push_back(entry.update.timestamp);
+            } else if (first) {
+                result.symbols.push_back(entry.symbol);
+            }
+        }
+        first = false;
+    }
+    result.skippedBytes = reader.skippedBytes();
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Closed segments get an index of blocks, slots and receive times", "[journal][index]") {
+    const JournalFormat format = GENERATE(JournalFormat::Raw, JournalFormat::Compressed);
+    TempDirectory directory(format == JournalFormat::Raw ? "raw" : "compressed");
+    InstrumentRegistry registry(16);
+    recordAlternating(registry, directory.path, format, kTicks);
+
+    const std::vector<std::string> segments = TickJournalReader::segments(directory.path);
+    REQUIRE(!segments.empty());
+    std::uint64_t records = 0;
+    for (const std::string& path : segments) {
+        JournalIndex index;
+        REQUIRE(index.load(JournalIndex::pathFor(path), std::filesystem::file_size(path)));
+        const JournalSegmentIndex& entries = index.entries();
+        REQUIRE(entries.blocks.size() > 1);
+        REQUIRE(entries.words == 1);
+        REQUIRE(entries.blocks.front().offset == sizeof(JournalSegmentHeader));
+        for (std::size_t i = 0; i < entries.blocks.size(); ++i) {
+            const JournalIndexBlock& block = entries.blocks[i];
+            REQUIRE(block.firstReceiveNs <= block.lastReceiveNs);
+            if (i > 0) {
+                REQUIRE(block.offset > entries.blocks[i - 1].offset);
+                REQUIRE(block.firstReceiveNs > entries.blocks[i - 1].lastReceiveNs);
+            }
+            REQUIRE(entries.contains(i, 0));
+            REQUIRE(entries.contains(i, 1));
+            records += block.records;
+        }
+        REQUIRE(index.symbols().size() >= 2);
+        REQUIRE(index.symbols()[0] == std::pair<SlotId, std::string>{0, "AAPL"});
+        REQUIRE(index.symbols()[1] == std::pair<SlotId, std::string>{1, "MSFT"});
+    }
+    REQUIRE(records == kTicks);
+}
+
+TEST_CASE("Index-guided scans match sequential scans and skip blocks", "[journal][index]") {
+    const JournalFormat format = GENERATE(JournalFormat::Raw, JournalFormat::Compressed);
+    TempDirectory directory(format == JournalFormat::Raw ? "scan-raw" : "scan-compressed");
+    InstrumentRegistry registry(16);
+    recordAlternating(registry, directory.path, format, kTicks);
+
+    JournalFilter filter;
+    filter.symbols = {"RARE"};
+    std::vector<std::int64_t> expected;
+    for (int i = kRareEvery - 1; i < kTicks; i += kRareEvery) {
+        expected.push_back(1700000000000 + i);
+    }
+
+    SECTION("Symbol filter") {
+        const ScanResult indexed = scan(directory.path, filter);
+        REQUIRE(indexed.indexedSegments > 0);
+        REQUIRE(indexed.ticks == expected);
+        REQUIRE(indexed.symbols == std::vector<std::string>{"RARE"});
+        REQUIRE(indexed.skippedBytes > 0);
+
+        for (const std::string& path : TickJournalReader::segments(directory.path)) {
+            std::filesystem::remove(JournalIndex::pathFor(path));
+        }
+        const ScanResult sequential = scan(directory.path, filter);
+        REQUIRE(sequential.indexedSegments == 0);
+        REQUIRE(sequential.ticks == expected);
+        REQUIRE(sequential.skippedBytes == 0);
+    }
+
+    SECTION("Time window") {
+        filter.symbols.clear();
+        filter.fromNs = kBaseNs + 20000 * 1000;
+        filter.toNs = kBaseNs + 20999 * 1000;  // Inclusive
+        const ScanResult indexed = scan(directory.path, filter);
+        REQUIRE(indexed.ticks.size() == 1000);
+        REQUIRE(indexed.ticks.front() == 1700000000000 + 20000);
+        REQUIRE(indexed.ticks.back() == 1700000000000 + 20999);
+        REQUIRE(indexed.skippedBytes > 0);
+    }
+
+    SECTION("Symbols and window together") {
+        filter.fromNs = kBaseNs + 10000 * 1000;
+        filter.toNs = kBaseNs + 30000 * 1000;
+        const ScanResult indexed = scan(directory.path, filter);
+        REQUIRE(indexed.ticks == std::vector<std::int64_t>{1700000000000 + 14999, 1700000000000 + 19999,
+                                                           1700000000000 + 24999, 1700000000000 + 29999});
+    }
+}
+
+TEST_CASE("A stale or foreign index is ignored", "[journal][index]") {
+    TempDirectory directory("stale");
+    InstrumentRegistry registry(16);
+    recordAlternating(registry, directory.path, JournalFormat::Raw, kTicks);
+    const std::string segment = TickJournalReader::segments(directory.path).front();
+    const std::string indexPath = JournalIndex::pathFor(segment);
+    const std::uintmax_t size = std::filesystem::file_size(segment);
+
+    JournalIndex index;
+    REQUIRE(index.load(indexPath, size));
+    REQUIRE_FALSE(index.load(indexPath, size + 8));  // Segment changed since the index was written
+    REQUIRE(index.entries().empty());
+    REQUIRE_FALSE(index.load(indexPath + ".missing", size));
+
+    std::filesystem::resize_file(indexPath, 40);  // Header survives, blocks are cut
+    REQUIRE_FALSE(index.load(indexPath, size));
+    {
+        std::ofstream(indexPath, std::ios::binary | std::ios::trunc) << "not an index at all, just text";
+    }
+    REQUIRE_FALSE(index.load(indexPath, size));
+
+    JournalFilter filter;
+    filter.symbols = {"RARE"};
+    const ScanResult result = scan(directory.path, filter);
+    REQUIRE(result.ticks.size() >= 1);  // REASON: First segment read sequentially, the others via their index
+}
+
+TEST_CASE("Journal times parse as UTC or epoch seconds", "[journal][index]") {
+    std::int64_t ns = 0;
+    REQUIRE(parseJournalTime("2023-11-14T22:13:20Z", ns));
+    REQUIRE(ns == kBaseNs);
+    REQUIRE(parseJournalTime("2023-11-14T22:13:20.250Z", ns));
+    REQUIRE(ns == kBaseNs + 250000000);
+    REQUIRE(parseJournalTime("1700000000", ns));
+    REQUIRE(ns == kBaseNs);
+
+    REQUIRE_FALSE(parseJournalTime("", ns));
+    REQUIRE_FALSE(parseJournalTime("2023-11-14T22:13:20", ns));   // UTC must be explicit
+    REQUIRE_FALSE(parseJournalTime("2023-11-14 22:13:20Z", ns));
+    REQUIRE_FALSE(parseJournalTime("2023-13-14T22:13:20Z", ns));
+    REQUIRE_FALSE(parseJournalTime("1700000000000", ns));         // Milliseconds: ambiguous
+}
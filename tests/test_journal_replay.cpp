@@ -0,0 +1,143 @@
+// test_journal_replay.cpp - Journal replay order, slot remapping, pacing, speed parsing
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "JournalReplay.h"
+#include "ShardRouter.h"
+#include "TickJournal.h"
+#include "JournalTestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::journal_test;
+
+namespace {
+
+// ingestNs drives the recorded receive time, so the test controls the gaps
+TickUpdate bidAsk(SlotId slot, std::int64_t timestamp, double bid, std::int64_t ingestNs) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.timestamp = timestamp;
+    update.bidAsk.bidPrice = bid;
+    update.bidAsk.askPrice = bid + 0.02;
+    update.bidAsk.stamps.ingestNs = ingestNs;
+    return update;
+}
+
+// Records AAPL, MSFT, AAPL spaced by gapNs
+void record(const std::string& directory, std::int64_t gapNs) {
+    InstrumentRegistry registry(16);
+    const SlotId aapl = registry.registerInstrument("AAPL", 1);
+    const SlotId msft = registry.registerInstrument("MSFT", 2);
+    JournalConfig config;
+    config.directory = directory;
+    config.segmentBytes = 1 << 20;
+    TickJournal journal(registry, config);
+    REQUIRE(journal.start());
+    journal.append(bidAsk(aapl, 1, 100.0, 1000000000));
+    journal.append(bidAsk(msft, 2, 200.0, 1000000000 + gapNs));
+    journal.append(bidAsk(aapl, 3, 101.0, 1000000000 + 2 * gapNs));
+    journal.stop();
+}
+
+std::vector<TickUpdate> drain(ShardRouter& router) {
+    std::vector<TickUpdate> updates;
+    TickUpdate update;
+    while (router.shard(0).queue.try_dequeue(update)) {
+        updates.push_back(update);
+    }
+    return updates;
+}
+
+double replaySeconds(const std::string& directory, double speed) {
+    InstrumentRegistry registry(16);
+    ShardRouter router(1, 64);
+    ReplayConfig config;
+    config.speed = speed;
+    JournalReplay replay(router, registry, config);
+    std::atomic<bool> running{true};
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(replay.run(directory, running));
+    REQUIRE(replay.counters().records.load() == 3);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+TEST_CASE("Replay re-registers symbols and preserves recorded order", "[replay]") {
+    TempDirectory directory("order");
+    record(directory.path, 1000);
+
+    // Different registry layout than the recording session: slots must be remapped by symbol
+    InstrumentRegistry registry(16);
+    const SlotId spy = registry.registerInstrument("SPY", 9);
+    const SlotId msft = registry.registerInstrument("MSFT", 2);
+    ShardRouter router(1, 64);
+    ReplayConfig config;
+    config.speed = 0.0;
+    JournalReplay replay(router, registry, config);
+    std::atomic<bool> running{true};
+    REQUIRE(replay.run(directory.path, running));
+
+    const std::vector<TickUpdate> updates = drain(router);
+    REQUIRE(updates.size() == 3);
+    const SlotId aapl = registry.find("AAPL");
+    REQUIRE(aapl != kInvalidSlot);
+    REQUIRE(aapl != spy);
+    REQUIRE(updates[0].slot == aapl);
+    REQUIRE(updates[1].slot == msft);
+    REQUIRE(updates[2].slot == aapl);
+    REQUIRE(updates[0].timestamp == 1);
+    REQUIRE(updates[2].bidAsk.bidPrice == 101.0);
+    REQUIRE(updates[0].bidAsk.stamps.ingestNs == 0);  // Not stamped unless latencyStamps
+    REQUIRE(replay.counters().segments.load() == 1);
+    REQUIRE(replay.counters().unmapped.load() == 0);
+}
+
+TEST_CASE("Replay paces by the recorded gaps scaled by speed", "[replay]") {
+    TempDirectory directory("pace");
+    record(directory.path, 100000000);  // 2 × 100ms recorded
+
+    REQUIRE(replaySeconds(directory.path, 1.0) >= 0.19);
+    const double fast = replaySeconds(directory.path, 10.0);
+    REQUIRE(fast >= 0.019);
+    REQUIRE(fast < 0.15);
+    REQUIRE(replaySeconds(directory.path, 0.0) < 0.05);
+}
+
+TEST_CASE("Replay stops when running is cleared and rejects missing input", "[replay]") {
+    TempDirectory directory("stop");
+    record(directory.path, 1000);
+
+    InstrumentRegistry registry(16);
+    ShardRouter router(1, 64);
+    JournalReplay replay(router, registry);
+    std::atomic<bool> running{false};
+    replay.run(directory.path, running);
+    REQUIRE(replay.counters().records.load() == 0);
+
+    running = true;
+    REQUIRE_FALSE(replay.run(directory.path + "/missing.tjl", running));
+}
+
+TEST_CASE("Replay speed parsing", "[replay]") {
+    double speed = -1.0;
+    REQUIRE(parseReplaySpeed("1x", speed));
+    REQUIRE(speed == 1.0);
+    REQUIRE(parseReplaySpeed("10x", speed));
+    REQUIRE(speed == 10.0);
+    REQUIRE(parseReplaySpeed("2.5", speed));
+    REQUIRE(speed == 2.5);
+    REQUIRE(parseReplaySpeed("max", speed));
+    REQUIRE(speed == 0.0);
+    REQUIRE_FALSE(parseReplaySpeed("", speed));
+    REQUIRE_FALSE(parseReplaySpeed("x", speed));
+    REQUIRE_FALSE(parseReplaySpeed("0x", speed));
+    REQUIRE_FALSE(parseReplaySpeed("-2", speed));
+    REQUIRE_FALSE(parseReplaySpeed("fast", speed));
+}
@@ -0,0 +1,205 @@
+// test_journal_server.cpp - Request parsing, frame stream contents (zero-copy and filtered), paced and bad requests
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include "InstrumentRegistry.h"
+#include "JournalCodec.h"
+#include "JournalServer.h"
+#include "TickJournal.h"
+#include "JournalTestSupport.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::journal_test;
+
+namespace {
+
+constexpr int kTicks = 40000;
+
+// Everything the server sent for one request line, decoded
+struct Reply {
+    int segments = 0;
+    std::vector<std::string> ticks;                   // "SYMBOL@timestamp" in stream order
+    std::uint64_t endTicks = 0;
+    bool ended = false;
+    std::string error;
+};
+
+std::string fetch(std::uint16_t port, const std::string& request) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(fd >= 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    REQUIRE(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+    REQUIRE(::send(fd, request.data(), request.size(), 0) == static_cast<ssize_t>(request.size()));
+    std::string bytes;
+    char buffer[65536];
+    for (ssize_t received; (received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0;) {
+        bytes.append(buffer, static_cast<std::size_t>(received));
+    }
+    ::close(fd);
+    return bytes;
+}
+
+Reply decode(const std::string& bytes) {
+    Reply reply;
+    std::map<SlotId, std::string> symbols;            // Per segment
+    const auto take = [&](const JournalEntry& entry) {
+        if (entry.kind == JournalRecordKind::Symbol) {
+            symbols[entry.slot] = entry.symbol;
+        } else {
+            REQUIRE(symbols.count(entry.update.slot) == 1);  // Announced before its first tick
+            reply.ticks.push_back(symbols[entry.update.slot] + "@" + std::to_string(entry.update.timestamp));
+        }
+    };
+    std::size_t offset = 0;
+    while (offset + sizeof(JournalFrameHeader) <= bytes.size()) {
+        JournalFrameHeader frame;
+        std::memcpy(&frame, bytes.data() + offset, sizeof(frame));
+        offset += sizeof(frame);
+        REQUIRE(offset + frame.length <= bytes.size());
+        const std::string_view payload(bytes.data() + offset, frame.length);
+        offset += frame.length;
+        switch (frame.kind) {
+        case JournalFrameKind::Segment:
+            REQUIRE(payload.size() == sizeof(JournalSegmentHeader));
+            ++reply.segments;
+            symbols.clear();
+            break;
+        case JournalFrameKind::Records:
+            for (std::size_t at = 0; at < payload.size();) {
+                JournalRecordHeader header;
+                std::memcpy(&header, payload.data() + at, sizeof(header));
+                JournalEntry entry;
+                entry.kind = header.kind;
+                if (header.kind == JournalRecordKind::Tick) {
+                    std::memcpy(&entry.update, payload.data() + at + sizeof(header), header.length);
+                } else {
+                    std::memcpy(&entry.slot, payload.data() + at + sizeof(header), sizeof(SlotId));
+                    entry.symbol.assign(payload.data() + at + sizeof(header) + sizeof(SlotId), header.length - sizeof(SlotId));
+                }
+                take(entry);
+                at += journal_detail::recordBytes(header.length);
+            }
+            break;
+        case JournalFrameKind::Blocks:
+            for (std::size_t at = 0; at < payload.size();) {
+                JournalBlockHeader header;
+                std::memcpy(&header, payload.data() + at, sizeof(header));
+                REQUIRE(header.magic == kJournalBlockMagic);
+                JournalBlockDecoder decoder;
+                REQUIRE(decoder.load(payload.substr(at + sizeof(header), header.sealedBytes), header.encodedBytes));
+                JournalEntry entry;
+                while (decoder.next(entry)) {
+                    take(entry);
+                }
+                at += (sizeof(header) + header.sealedBytes + 7) & ~std::size_t{7};
+            }
+            break;
+        case JournalFrameKind::End:
+            REQUIRE(payload.size() == sizeof(std::uint64_t));
+            std::memcpy(&reply.endTicks, payload.data(), sizeof(reply.endTicks));
+            reply.ended = true;
+            break;
+        case JournalFrameKind::Error:
+            reply.error.assign(payload);
+            break;
+        }
+    }
+    REQUIRE(offset == bytes.size());
+    return reply;
+}
+
+} // namespace
+
+TEST_CASE("Serve requests parse symbols, window, speed and target", "[journal][server]") {
+    JournalServeRequest request;
+    std::string error;
+    REQUIRE(parseServeRequest("REPLAY symbols=AAPL,SPY from=1700000000 to=2023-11-14T22:13:21Z speed=10x "
+                              "session=20231114T221320000Z stream=alice.1\r\n", request, error));
+    REQUIRE(request.filter.symbols == std::vector<std::string>{"AAPL", "SPY"});
+    REQUIRE(request.filter.fromNs == kBaseNs);
+    REQUIRE(request.filter.toNs == kBaseNs + 1000000000);
+    REQUIRE(request.speed == 10.0);
+    REQUIRE(request.session == "20231114T221320000Z");
+    REQUIRE(request.stream == "alice.1");
+
+    REQUIRE(parseServeRequest("REPLAY", request, error));
+    REQUIRE(request.filter.all());
+    REQUIRE(request.speed == 0.0);
+
+    REQUIRE_FALSE(parseServeRequest("", request, error));
+    REQUIRE_FALSE(parseServeRequest("GET / HTTP/1.1", request, error));
+    REQUIRE_FALSE(parseServeRequest("REPLAY color=red", request, error));
+    REQUIRE_FALSE(parseServeRequest("REPLAY speed=fast", request, error));
+    REQUIRE_FALSE(parseServeRequest("REPLAY from=1700000001 to=1700000000", request, error));
+    REQUIRE_FALSE(parseServeRequest("REPLAY stream=TWS:TICKS*", request, error));
+}
+
+TEST_CASE("Journal server streams exactly the requested ranges", "[journal][server]") {
+    const JournalFormat format = GENERATE(JournalFormat::Raw, JournalFormat::Compressed);
+    TempDirectory directory(format == JournalFormat::Raw ? "raw" : "compressed");
+    InstrumentRegistry registry(16);
+    recordAlternating(registry, directory.path, format, kTicks);
+
+    JournalServerConfig config;
+    config.directory = directory.path;
+    config.port = 0;
+    JournalServer server(config);
+    REQUIRE(server.start());
+
+    SECTION("Everything at max speed goes out zero-copy") {
+        const Reply reply = decode(fetch(server.port(), "REPLAY\n"));
+        REQUIRE(reply.error.empty());
+        REQUIRE(reply.ended);
+        REQUIRE(reply.ticks.size() == kTicks);
+        REQUIRE(reply.endTicks == kTicks);
+        REQUIRE(reply.ticks[1] == "MSFT@1700000000001");
+        REQUIRE(reply.ticks[kRareEvery - 1] == "RARE@" + std::to_string(1700000000000 + kRareEvery - 1));
+        REQUIRE(server.counters().zeroCopyBytes.load() > 0);
+    }
+
+    SECTION("One symbol: blocks shared with others are filtered") {
+        const Reply reply = decode(fetch(server.port(), "REPLAY symbols=RARE\n"));
+        REQUIRE(reply.ended);
+        REQUIRE(reply.ticks.size() == kTicks / kRareEvery);
+        for (int i = 0; i < kTicks / kRareEvery; ++i) {
+            REQUIRE(reply.ticks[i] == "RARE@" + std::to_string(1700000000000 + (i + 1) * kRareEvery - 1));
+        }
+        REQUIRE(server.counters().zeroCopyBytes.load() == 0);  // REASON: RARE never has a block of its own
+    }
+
+    SECTION("A window sends its inner blocks zero-copy and trims the edges") {
+        const Reply reply = decode(fetch(server.port(), "REPLAY symbols=AAPL,MSFT,RARE from=2023-11-14T22:13:20.010Z "
+                                                        "to=2023-11-14T22:13:20.030Z\n"));
+        REQUIRE(reply.ticks.size() == 20001);  // Ticks 10000 ... 30000 (1 μs apart)
+        REQUIRE(reply.ticks.front() == "AAPL@1700000010000");
+        REQUIRE(reply.ticks.back() == "AAPL@1700000030000");
+        REQUIRE(server.counters().zeroCopyBytes.load() > 0);
+    }
+
+    SECTION("Paced requests are filtered record by record") {
+        const Reply reply = decode(fetch(server.port(), "REPLAY symbols=MSFT from=2023-11-14T22:13:20.001Z "
+                                                        "to=2023-11-14T22:13:20.002Z speed=2x\n"));
+        REQUIRE(reply.ticks.size() == 500);
+        REQUIRE(reply.endTicks == 500);
+        REQUIRE(server.counters().zeroCopyBytes.load() == 0);
+    }
+
+    SECTION("Bad requests get an Error frame") {
+        const Reply reply = decode(fetch(server.port(), "REPLAY symbols=AAPL speed=warp\n"));
+        REQUIRE_FALSE(reply.ended);
+        REQUIRE(reply.error == "bad speed: warp");
+        REQUIRE(server.counters().rejected.load() == 1);
+    }
+    server.stop();
+}
@@ -0,0 +1,45 @@
+// test_kafka_sink.cpp - Unit tests for the Kafka sink's producer properties and slot partitioner
+
+#include <catch2/catch_test_macros.hpp>
+#include "KafkaSink.h"
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string property(const KafkaConfig& config, const std::string& key) {
+    for (const auto& [name, value] : kafkaProperties(config)) {
+        if (name == key) {
+            return value;
+        }
+    }
+    return "<unset>";
+}
+
+} // namespace
+
+TEST_CASE("Producer properties carry the linger, batch and compression settings", "[kafka]") {
+    KafkaConfig config;
+    config.brokers = "k1:9092,k2:9092";
+    config.linger = std::chrono::milliseconds(20);
+    config.batchBytes = 262144;
+    config.compression = "zstd";
+    REQUIRE(property(config, "bootstrap.servers") == "k1:9092,k2:9092");
+    REQUIRE(property(config, "linger.ms") == "20");
+    REQUIRE(property(config, "batch.size") == "262144");
+    REQUIRE(property(config, "compression.type") == "zstd");
+    REQUIRE(property(config, "partitioner") == "murmur2_random");
+    REQUIRE(property(config, "enable.idempotence") == "true");
+
+    config.acks = "1";
+    REQUIRE(property(config, "enable.idempotence") == "<unset>");
+}
+
+TEST_CASE("Slot partitioning spreads slots round robin, symbol partitioning defers to the key", "[kafka]") {
+    REQUIRE(kafkaPartition(KafkaPartitioner::Slot, 0, 4) == 0);
+    REQUIRE(kafkaPartition(KafkaPartitioner::Slot, 7, 4) == 3);
+    REQUIRE(kafkaPartition(KafkaPartitioner::Slot, 7, 0) == -1);         // Partition count unknown
+    REQUIRE(kafkaPartition(KafkaPartitioner::Slot, kInvalidSlot, 4) == -1);
+    REQUIRE(kafkaPartition(KafkaPartitioner::Symbol, 7, 4) == -1);
+}
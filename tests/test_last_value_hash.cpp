@@ -0,0 +1,115 @@
+// test_last_value_hash.cpp - Unit tests for the field-level TWS:LVC:* hash writer and its warm-start parser
+
+#include <catch2/catch_test_macros.hpp>
+#include "LastValueHash.h"
+#include "PublishMessage.h"
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+InstrumentState quoted() {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.sequence = 1;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.quoteTimestamp = 1700000000000;
+    state.hasQuote = true;
+    return state;
+}
+
+// HSET payload → (field, value) pairs, as HGETALL would return them
+std::vector<std::pair<std::string, std::string>> pairs(const std::string& payload) {
+    std::vector<std::string> parts;
+    forEachHashPart(payload, [&parts](std::string_view part) { parts.emplace_back(part); });
+    std::vector<std::pair<std::string, std::string>> fields;
+    for (std::size_t i = 0; i + 1 < parts.size(); i += 2) {
+        fields.emplace_back(parts[i], parts[i + 1]);
+    }
+    return fields;
+}
+
+} // namespace
+
+TEST_CASE("First write carries identity and every field", "[lvc-hash]") {
+    LastValueTrack track;
+    std::string payload;
+    track.encode(quoted(), false, payload);
+    REQUIRE(payload.rfind("instrument\nAAPL\nconId\n265598\nprimaryExchange\n\nseq\n1\nbid\n171.55\nask\n171.56\n", 0) == 0);
+    REQUIRE(pairs(payload).size() == 15);  // 3 identity + seq + 11 snapshot fields
+}
+
+TEST_CASE("Later writes carry seq and the changed fields only", "[lvc-hash]") {
+    LastValueTrack track;
+    std::string payload;
+    InstrumentState state = quoted();
+    track.encode(state, false, payload);
+
+    state.sequence = 2;
+    state.bidPrice = 171.54;
+    state.bidSize = 300;
+    track.encode(state, false, payload);
+    REQUIRE(payload == "seq\n2\nbid\n171.54\nbidSize\n300");
+
+    state.sequence = 3;
+    state.lastPrice = 171.55;
+    state.lastSize = 50;
+    state.tradeTimestamp = 1700000000001;
+    state.tradeConditions = parseTradeConditions("I");
+    track.encode(state, false, payload);
+    REQUIRE(payload == "seq\n3\nlast\n171.55\nlastSize\n50\ntradeTime\n1700000000001\nconditions\nI");
+
+    track.resync();
+    state.sequence = 4;
+    track.encode(state, false, payload);
+    REQUIRE(pairs(payload).size() == 15);
+}
+
+TEST_CASE("An empty value keeps the payload's pairs aligned", "[lvc-hash]") {
+    LastValueTrack track;
+    std::string payload;
+    InstrumentState state = quoted();
+    state.tradeConditions = parseTradeConditions("I");
+    track.encode(state, false, payload);
+    state.sequence = 2;
+    state.tradeConditions = 0;
+    track.encode(state, false, payload);
+    REQUIRE(payload == "seq\n2\nconditions\n");
+    REQUIRE(forEachHashPart(payload, [](std::string_view) {}) == 4);
+}
+
+TEST_CASE("Hash fields restore the quote / trade state", "[lvc-hash]") {
+    LastValueTrack track;
+    std::string payload;
+    InstrumentState written = quoted();
+    written.sequence = 42;
+    written.lastPrice = 171.5;
+    written.lastSize = 10;
+    written.tradeTimestamp = 1700000000005;
+    written.pastLimit = true;
+    track.encode(written, false, payload);
+
+    InstrumentState restored;
+    REQUIRE(parseLastValueHash(pairs(payload), restored));
+    REQUIRE(restored.sequence == 42);
+    REQUIRE(restored.conId == 265598);
+    REQUIRE(restored.bidPrice == 171.55);
+    REQUIRE(restored.askSize == 200);
+    REQUIRE(restored.lastPrice == 171.5);
+    REQUIRE(restored.tradeTimestamp == 1700000000005);
+    REQUIRE(restored.pastLimit);
+    REQUIRE(restored.hasQuote);
+    REQUIRE(restored.hasTrade);
+
+    const std::vector<std::pair<std::string, std::string>> foreign{{"bid", "1.0"}};
+    InstrumentState untouched;
+    REQUIRE_FALSE(parseLastValueHash(foreign, untouched));
+}
@@ -0,0 +1,83 @@
+// test_latency_histogram.cpp - Bucketing, percentiles and interval deltas of LatencyHistogram
+
+#include <catch2/catch_test_macros.hpp>
+#include "LatencyHistogram.h"
+#include "MarketData.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("LatencySnapshot buckets are exact below 64 ns, ~3% above", "[latency]") {
+    for (std::int64_t v = 0; v < 64; ++v) {
+        REQUIRE(LatencySnapshot::bucketUpperBound(LatencySnapshot::bucketOf(v)) == v);
+    }
+    for (std::int64_t v : {64LL, 100LL, 1000LL, 12345LL, 1000000LL, 50000000LL, 987654321LL}) {
+        const std::int64_t upper = LatencySnapshot::bucketUpperBound(LatencySnapshot::bucketOf(v));
+        REQUIRE(upper >= v);
+        REQUIRE(static_cast<double>(upper - v) <= static_cast<double>(v) / 32.0);
+    }
+    // Contiguous: every bucket boundary maps to its own bucket
+    for (std::size_t b = 1; b < LatencySnapshot::kBuckets; ++b) {
+        REQUIRE(LatencySnapshot::bucketOf(LatencySnapshot::bucketUpperBound(b - 1) + 1) == b);
+    }
+    REQUIRE(LatencySnapshot::bucketOf(-5) == 0);
+    REQUIRE(LatencySnapshot::bucketOf(INT64_MAX) == LatencySnapshot::kBuckets - 1);
+}
+
+TEST_CASE("LatencySnapshot percentiles", "[latency]") {
+    LatencyHistogram histogram;
+    for (std::int64_t v = 1; v <= 1000; ++v) {
+        histogram.record(v * 1000);  // 1..1000 us
+    }
+    LatencySnapshot snapshot;
+    histogram.snapshot(snapshot);
+    REQUIRE(snapshot.total() == 1000);
+    const LatencyReport::Stage stage = LatencyReport::summarize(snapshot);
+    REQUIRE(stage.count == 1000);
+    REQUIRE(stage.p50 >= 500000);
+    REQUIRE(stage.p50 <= 500000 + 500000 / 32);
+    REQUIRE(stage.p99 >= 990000);
+    REQUIRE(stage.p99 <= 990000 + 990000 / 32);
+    REQUIRE(stage.p999 >= 999000);
+    REQUIRE(stage.max >= 1000000);
+    REQUIRE(stage.max <= 1000000 + 1000000 / 32);
+    
+    LatencySnapshot empty;
+    REQUIRE(empty.valueAt(99.0) == 0);
+    REQUIRE(empty.max() == 0);
+}
+
+TEST_CASE("LatencySnapshot::advance yields per-interval counts", "[latency]") {
+    LatencyHistogram histogram;
+    LatencySnapshot previous;
+    LatencySnapshot interval;
+    
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(1000);
+    }
+    histogram.snapshot(interval);
+    interval.advance(previous);
+    REQUIRE(interval.total() == 10);
+    
+    for (int i = 0; i < 5; ++i) {
+        histogram.record(2000000);
+    }
+    histogram.snapshot(interval);
+    interval.advance(previous);
+    REQUIRE(interval.total() == 5);
+    REQUIRE(interval.valueAt(50.0) >= 2000000);  // Earlier 1 us samples are not in this interval
+    REQUIRE(previous.total() == 15);
+}
+
+TEST_CASE("TickStamps live in the spare payload bytes of tick arms", "[latency]") {
+    static_assert(sizeof(TickUpdate) <= 64, "TickUpdate must fit one cache line");
+    TickUpdate update;
+    update.type = TickUpdateType::BidAsk;
+    REQUIRE(update.stamps() == &update.bidAsk.stamps);
+    REQUIRE(update.stamps()->ingestNs == 0);  // Zero unless stamped
+    update.type = TickUpdateType::AllLast;
+    REQUIRE(update.stamps() == &update.allLast.stamps);
+    update.type = TickUpdateType::Depth;
+    REQUIRE(update.stamps() == &update.depth.stamps);
+    update.type = TickUpdateType::Bar;
+    REQUIRE(update.stamps() == nullptr);
+}
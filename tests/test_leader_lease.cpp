@@ -0,0 +1,46 @@
+// test_leader_lease.cpp - Leader lease ids, step-down deadline and behaviour without Redis
+
+#include <catch2/catch_test_macros.hpp>
+#include "LeaderLease.h"
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+TEST_CASE("Default id is hostname:pid", "[leader]") {
+    const std::string id = defaultInstanceId();
+    const std::size_t colon = id.rfind(':');
+    REQUIRE(colon != std::string::npos);
+    REQUIRE(colon > 0);
+    REQUIRE(id.substr(colon + 1) == std::to_string(::getpid()));
+
+    LeaderLease named("tcp://127.0.0.1:1", LeaderConfig{});
+    REQUIRE(named.id() == id);
+    LeaderConfig config;
+    config.id = "bridge-a";
+    LeaderLease configured("tcp://127.0.0.1:1", config);
+    REQUIRE(configured.id() == "bridge-a");
+}
+
+TEST_CASE("A leader steps down one renew interval before its key can expire", "[leader]") {
+    LeaderConfig config;
+    config.ttl = std::chrono::milliseconds(2000);
+    config.renewInterval = std::chrono::milliseconds(500);
+    const auto renewed = std::chrono::steady_clock::time_point{} + std::chrono::seconds(10);
+    REQUIRE(leaseStepDownAt(renewed, config) == renewed + std::chrono::milliseconds(1500));
+    REQUIRE(leaseStepDownAt(renewed, config) < renewed + config.ttl);
+}
+
+TEST_CASE("Without Redis the lease stays on standby", "[leader]") {
+    LeaderConfig config;
+    config.renewInterval = std::chrono::milliseconds(50);
+    config.socketTimeout = std::chrono::milliseconds(50);
+    LeaderLease lease("tcp://127.0.0.1:1", config);  // NOTE: Nothing listens on port 1
+    lease.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE_FALSE(lease.leader());
+    REQUIRE_FALSE(lease.lost());  // REASON: Never held - nothing to step down from
+    lease.stop();
+    REQUIRE_FALSE(lease.leader());
+}
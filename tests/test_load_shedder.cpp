@@ -0,0 +1,85 @@
+// test_load_shedder.cpp - Overload controller: breach detection, stepwise escalation and recovery
+
+#include <catch2/catch_test_macros.hpp>
+#include "LoadShedder.h"
+
+using namespace tws_bridge;
+using Clock = LoadShedder::Clock;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+namespace {
+
+LoadSample overloaded() {
+    LoadSample sample;
+    sample.queueAge = milliseconds(500);
+    return sample;
+}
+
+} // namespace
+
+TEST_CASE("Any limit or a Redis outage is a breach", "[load_shed]") {
+    LoadShedder shedder(LoadShedConfig{});
+    REQUIRE_FALSE(shedder.breached(LoadSample{}));
+    REQUIRE(shedder.breached(overloaded()));
+
+    LoadSample deep;
+    deep.queueDepth = 50000;
+    REQUIRE(shedder.breached(deep));
+
+    LoadSample slow;
+    slow.publishLatency = milliseconds(200);
+    REQUIRE(shedder.breached(slow));
+
+    LoadSample down;
+    down.redisDown = true;
+    REQUIRE(shedder.breached(down));
+}
+
+TEST_CASE("Sustained breach escalates one level per escalateAfter", "[load_shed]") {
+    LoadShedder shedder(LoadShedConfig{});
+    // NOTE: time_point{} marks "not breaching" - samples start later
+    const Clock::time_point start = Clock::time_point{} + seconds(1);
+
+    REQUIRE_FALSE(shedder.update(overloaded(), start));
+    REQUIRE_FALSE(shedder.update(overloaded(), start + milliseconds(1900)));
+    REQUIRE(shedder.level() == ShedLevel::Normal);
+    REQUIRE(shedder.update(overloaded(), start + seconds(2)));
+    REQUIRE(shedder.level() == ShedLevel::ConflateQuotes);
+
+    // Each level gets its own escalateAfter
+    REQUIRE_FALSE(shedder.update(overloaded(), start + milliseconds(3900)));
+    REQUIRE(shedder.update(overloaded(), start + seconds(4)));
+    REQUIRE(shedder.level() == ShedLevel::DropTiers);
+    REQUIRE(shedder.update(overloaded(), start + seconds(6)));
+    REQUIRE(shedder.level() == ShedLevel::DowngradeFeeds);
+    REQUIRE_FALSE(shedder.update(overloaded(), start + seconds(60)));
+    REQUIRE(shedder.level() == ShedLevel::DowngradeFeeds);
+}
+
+TEST_CASE("A healthy gap resets escalation, recovery steps back one level at a time", "[load_shed]") {
+    LoadShedder shedder(LoadShedConfig{});
+    const Clock::time_point start = Clock::time_point{} + seconds(1);
+
+    shedder.update(overloaded(), start);
+    shedder.update(LoadSample{}, start + seconds(1));
+    REQUIRE_FALSE(shedder.update(overloaded(), start + seconds(2)));
+    REQUIRE(shedder.level() == ShedLevel::Normal);  // Breach restarted at 2 s
+    REQUIRE(shedder.update(overloaded(), start + seconds(4)));
+    REQUIRE(shedder.update(overloaded(), start + seconds(6)));
+    REQUIRE(shedder.level() == ShedLevel::DropTiers);
+
+    REQUIRE_FALSE(shedder.update(LoadSample{}, start + seconds(7)));
+    REQUIRE_FALSE(shedder.update(LoadSample{}, start + seconds(16)));
+    REQUIRE(shedder.update(LoadSample{}, start + seconds(17)));
+    REQUIRE(shedder.level() == ShedLevel::ConflateQuotes);
+    REQUIRE(shedder.update(LoadSample{}, start + seconds(27)));
+    REQUIRE(shedder.level() == ShedLevel::Normal);
+    REQUIRE_FALSE(shedder.update(LoadSample{}, start + seconds(100)));
+    REQUIRE(shedder.level() == ShedLevel::Normal);
+}
+
+TEST_CASE("Level names match the status event", "[load_shed]") {
+    REQUIRE(std::string(shedLevelName(ShedLevel::Normal)) == "normal");
+    REQUIRE(std::string(shedLevelName(ShedLevel::DowngradeFeeds)) == "downgrade_feeds");
+}
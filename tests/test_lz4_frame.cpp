@@ -0,0 +1,89 @@
+// test_lz4_frame.cpp - LZ4 frame compression round trips and frame layout
+
+#include <catch2/catch_test_macros.hpp>
+#include "Lz4Frame.h"
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string snapshotBatch(int count) {
+    std::string batch = "[";
+    for (int i = 0; i < count; ++i) {
+        batch += i == 0 ? "" : ",";
+        batch += R"({"instrument":"AAPL","seq":)" + std::to_string(i) + R"(,"price":{"bid":171.)" +
+                 std::to_string(i % 97) + R"(,"ask":171.57},"size":{"bid":100,"ask":200}})";
+    }
+    return batch + "]";
+}
+
+std::string roundTrip(const std::string& input, std::string& frame) {
+    Lz4Compressor compressor;
+    frame.clear();
+    compressor.compressFrame(input, frame);
+    std::string output;
+    REQUIRE(decompressLz4Frame(frame, output));
+    return output;
+}
+
+} // namespace
+
+TEST_CASE("LZ4 frame header matches the reference encoder", "[lz4]") {
+    // XXH32-based descriptor checksum: lz4 CLI default frame 04 22 4D 18 64 40 A7
+    const std::uint8_t cliDescriptor[2] = {0x64, 0x40};
+    REQUIRE(((lz4_detail::xxh32Short(cliDescriptor, 2) >> 8) & 0xFF) == 0xA7);
+
+    std::string frame;
+    REQUIRE(roundTrip("", frame).empty());
+    REQUIRE(frame == std::string("\x04\x22\x4D\x18\x60\x70", 6) + static_cast<char>(lz4_detail::kHeaderChecksum) +
+                         std::string(4, '\0'));
+}
+
+TEST_CASE("Snapshot batches shrink and round trip", "[lz4]") {
+    const std::string batch = snapshotBatch(200);
+    std::string frame;
+    REQUIRE(roundTrip(batch, frame) == batch);
+    REQUIRE(frame.size() * 4 < batch.size());
+    REQUIRE(static_cast<std::uint8_t>(frame[0]) == 0x04);  // Consumers' compressed-payload flag
+}
+
+TEST_CASE("Edge inputs round trip", "[lz4]") {
+    std::string frame;
+    SECTION("Shorter than a match") {
+        REQUIRE(roundTrip("abc", frame) == "abc");
+    }
+    SECTION("Long run (overlapping matches, long length bytes)") {
+        const std::string run(100000, 'a');
+        REQUIRE(roundTrip(run, frame) == run);
+        REQUIRE(frame.size() < 1000);
+    }
+    SECTION("Incompressible input is stored") {
+        std::string noise;
+        std::uint32_t x = 2463534242u;
+        for (int i = 0; i < 70000; ++i) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            noise += static_cast<char>(x & 0xFF);
+        }
+        REQUIRE(roundTrip(noise, frame) == noise);
+        REQUIRE(frame.size() <= noise.size() + 15);
+    }
+    SECTION("Several blocks") {
+        std::string large;
+        while (large.size() <= lz4_detail::kBlockMax + 1000) {
+            large += snapshotBatch(50);
+        }
+        REQUIRE(roundTrip(large, frame) == large);
+    }
+}
+
+TEST_CASE("Malformed frames are rejected", "[lz4]") {
+    std::string output;
+    REQUIRE_FALSE(decompressLz4Frame("{\"instrument\":\"AAPL\"}", output));
+
+    std::string frame;
+    roundTrip(snapshotBatch(20), frame);
+    REQUIRE_FALSE(decompressLz4Frame(std::string_view(frame).substr(0, frame.size() - 6), output));
+}
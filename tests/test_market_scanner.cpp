@@ -0,0 +1,111 @@
+// test_market_scanner.cpp - Scan definitions, cycle reuse, rank diffs and the outbox handoff
+
+#include <catch2/catch_test_macros.hpp>
+#include "MarketScanner.h"
+#include "Serialization.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+void fill(ScanCycle& cycle, std::initializer_list<const char*> symbols) {
+    int rank = 0;
+    for (const char* symbol : symbols) {
+        ScanRow& row = cycle.at(rank++);
+        row.symbol = symbol;
+        row.conId = static_cast<long long>(std::hash<std::string>{}(symbol) % 1000000);
+        row.secType = "STK";
+    }
+}
+
+} // namespace
+
+TEST_CASE("Scan definitions parse ID=CODE@LOCATION[:rows]", "[scanner]") {
+    ScanDefinition scan;
+    REQUIRE(parseScanDefinition("VOL=HOT_BY_VOLUME@STK.NASDAQ:10", scan));
+    REQUIRE(scan.id == "VOL");
+    REQUIRE(scan.scanCode == "HOT_BY_VOLUME");
+    REQUIRE(scan.instrument == "STK");
+    REQUIRE(scan.location == "STK.NASDAQ");
+    REQUIRE(scan.rows == 10);
+    REQUIRE_FALSE(parseScanDefinition("=HOT@STK.US", scan));
+    REQUIRE_FALSE(parseScanDefinition("VOL=@STK.US", scan));
+    REQUIRE_FALSE(parseScanDefinition("VOL=HOT@", scan));
+    REQUIRE_FALSE(parseScanDefinition("VOL=HOT@STK.US:0", scan));
+    REQUIRE_FALSE(parseScanDefinition("VOL=HOT@STK.US:51", scan));
+}
+
+TEST_CASE("Only ranks holding a different contract are changed", "[scanner]") {
+    ScanCycle previous;
+    ScanCycle current;
+    std::vector<std::size_t> changed;
+    std::vector<std::size_t> entrants;
+    fill(previous, {"AAPL", "MSFT", "NVDA"});
+    fill(current, {"AAPL", "MSFT", "NVDA"});
+    diffScan(previous, current, changed, entrants);
+    REQUIRE(changed.empty());
+    REQUIRE(entrants.empty());
+
+    current.clear();
+    fill(current, {"AAPL", "NVDA", "MSFT", "AMD"});
+    diffScan(previous, current, changed, entrants);
+    REQUIRE(changed == std::vector<std::size_t>{1, 2, 3});
+    REQUIRE(entrants == std::vector<std::size_t>{3});  // NOTE: Swapped ranks are changes, not entrants
+
+    current.clear();
+    fill(current, {"AAPL"});
+    diffScan(previous, current, changed, entrants);
+    REQUIRE(changed.empty());  // NOTE: Shrinking is carried by size
+    REQUIRE(current.size == 1);
+}
+
+TEST_CASE("A cycle keeps its rows across scans", "[scanner]") {
+    ScanCycle cycle;
+    fill(cycle, {"AAPL", "MSFT"});
+    const ScanRow* rows = cycle.rows.data();
+    cycle.clear();
+    fill(cycle, {"TSLA", "AMD"});
+    REQUIRE(cycle.rows.data() == rows);
+    REQUIRE(cycle.size == 2);
+    REQUIRE(cycle.rows[0].symbol == "TSLA");
+    cycle.clear();
+    cycle.at(2).symbol = "META";  // NOTE: A skipped rank is an empty row, not the stale one
+    REQUIRE(cycle.size == 3);
+    REQUIRE(cycle.rows[0].symbol.empty());
+}
+
+TEST_CASE("The outbox hands the latest cycle over once", "[scanner]") {
+    ScanOutbox outbox(2);
+    ScanCycle cycle;
+    ScanCycle taken;
+    REQUIRE_FALSE(outbox.take(0, taken));
+    fill(cycle, {"AAPL", "MSFT"});
+    outbox.post(0, cycle);
+    REQUIRE(cycle.size == 0);
+    fill(cycle, {"NVDA"});
+    outbox.post(0, cycle);  // NOTE: Replaces the untaken one
+    REQUIRE(outbox.take(0, taken));
+    REQUIRE(taken.size == 1);
+    REQUIRE(taken.rows[0].symbol == "NVDA");
+    REQUIRE_FALSE(outbox.take(0, taken));
+    REQUIRE_FALSE(outbox.take(1, taken));
+}
+
+TEST_CASE("A scan delta lists the changed ranks and the new size", "[scanner]") {
+    ScanCycle cycle;
+    fill(cycle, {"AAPL", "AMD"});
+    const std::vector<std::size_t> changed{1};
+    JsonBuffer json;
+    serializeScan("GAINERS", cycle, &changed, 7, 1700000000000, json);
+    const std::string delta(json.data(), json.size());
+    REQUIRE(delta.find("\"scan\":\"GAINERS\"") != std::string::npos);
+    REQUIRE(delta.find("\"seq\":7") != std::string::npos);
+    REQUIRE(delta.find("\"size\":2") != std::string::npos);
+    REQUIRE(delta.find("\"instrument\":\"AMD\"") != std::string::npos);
+    REQUIRE(delta.find("AAPL") == std::string::npos);
+    serializeScan("GAINERS", cycle, nullptr, 7, 1700000000000, json);
+    REQUIRE(std::string(json.data(), json.size()).find("AAPL") != std::string::npos);
+}
@@ -0,0 +1,45 @@
+// test_message_filter.cpp - Unit tests for the inbound msg id allowlist
+
+#include <catch2/catch_test_macros.hpp>
+#include "MessageFilter.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("Default filter passes every message", "[message-filter]") {
+    MessageFilter filter;
+    REQUIRE_FALSE(filter.enabled());
+    REQUIRE(filter.allows(5));    // OPEN_ORDER
+    REQUIRE(filter.allows(99));
+}
+
+TEST_CASE("Bridge filter keeps handled ids, drops the rest", "[message-filter]") {
+    const MessageFilter filter = MessageFilter::forBridge(MessageFilterConfig{});
+    REQUIRE(filter.enabled());
+    for (int msgId : kBridgeMessageIds) {
+        REQUIRE(filter.allows(msgId));
+    }
+    REQUIRE_FALSE(filter.allows(3));   // ORDER_STATUS
+    REQUIRE_FALSE(filter.allows(6));   // ACCT_VALUE
+    REQUIRE_FALSE(filter.allows(8));   // ACCT_UPDATE_TIME
+    REQUIRE_FALSE(filter.allows(11));  // EXECUTION_DATA
+    REQUIRE(filter.allows(7));         // PORTFOLIO_VALUE (account feed)
+    REQUIRE(filter.allows(61));        // POSITION_DATA
+    REQUIRE(filter.allows(84));        // TICK_NEWS (news feed)
+}
+
+TEST_CASE("Protobuf ids map back to their EDecoder id", "[message-filter]") {
+    const MessageFilter filter = MessageFilter::forBridge(MessageFilterConfig{});
+    REQUIRE(filter.allows(MessageFilter::kProtobufOffset + 4));        // ERR_MSG
+    REQUIRE_FALSE(filter.allows(MessageFilter::kProtobufOffset + 3));  // ORDER_STATUS
+}
+
+TEST_CASE("Extra ids and unknown ids pass", "[message-filter]") {
+    MessageFilterConfig config;
+    config.allow = {6};
+    const MessageFilter filter = MessageFilter::forBridge(config);
+    REQUIRE(filter.allows(6));
+    REQUIRE(filter.allows(MessageFilter::kProtobufOffset + MessageFilter::kMaxMsgId));
+
+    config.enabled = false;
+    REQUIRE(MessageFilter::forBridge(config).allows(3));
+}
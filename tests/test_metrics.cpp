@@ -0,0 +1,112 @@
+// test_metrics.cpp - PerThreadCounter aggregation, Prometheus text format, /metrics endpoint
+
+#include <catch2/catch_test_macros.hpp>
+#include "Metrics.h"
+#include "MetricsServer.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string httpGet(std::uint16_t port, const std::string& path) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return "";
+    }
+    const std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ::send(fd, request.data(), request.size(), 0);
+    std::string response;
+    char buffer[4096];
+    ssize_t received = 0;
+    while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<std::size_t>(received));
+    }
+    ::close(fd);
+    return response;
+}
+
+} // namespace
+
+TEST_CASE("PerThreadCounter sums every writer thread", "[metrics]") {
+    static_assert(alignof(PerThreadCounter) >= 64, "Slots must be cache-line aligned");
+    PerThreadCounter counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 10000; ++i) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    counter.add(5);
+    REQUIRE(counter.value() == 40005);
+}
+
+TEST_CASE("PrometheusWriter emits families, samples and cumulative histograms", "[metrics]") {
+    PrometheusWriter out;
+    out.family("tws_bridge_ticks_in_total", "counter", "Updates in");
+    out.sample("tws_bridge_ticks_in_total", "type=\"bid_ask\"", std::uint64_t{42});
+    out.sample("tws_bridge_subscribed_symbols", "", std::uint64_t{3});
+    REQUIRE(out.str() == "# HELP tws_bridge_ticks_in_total Updates in\n"
+                         "# TYPE tws_bridge_ticks_in_total counter\n"
+                         "tws_bridge_ticks_in_total{type=\"bid_ask\"} 42\n"
+                         "tws_bridge_subscribed_symbols 3\n");
+    
+    out.clear();
+    LatencyHistogram histogram;
+    histogram.record(800);        // < 1 us
+    histogram.record(40000);      // < 50 us
+    histogram.record(2000000000); // > 1 s
+    LatencySnapshot snapshot;
+    histogram.snapshot(snapshot);
+    out.histogram("lat_seconds", "stage=\"queue\"", snapshot);
+    const std::string& text = out.str();
+    REQUIRE(text.find("lat_seconds_bucket{stage=\"queue\",le=\"1e-06\"} 1\n") != std::string::npos);
+    REQUIRE(text.find("lat_seconds_bucket{stage=\"queue\",le=\"1e-05\"} 1\n") != std::string::npos);
+    REQUIRE(text.find("lat_seconds_bucket{stage=\"queue\",le=\"5e-05\"} 2\n") != std::string::npos);
+    REQUIRE(text.find("lat_seconds_bucket{stage=\"queue\",le=\"1\"} 2\n") != std::string::npos);
+    REQUIRE(text.find("lat_seconds_bucket{stage=\"queue\",le=\"+Inf\"} 3\n") != std::string::npos);
+    REQUIRE(text.find("lat_seconds_count{stage=\"queue\"} 3\n") != std::string::npos);
+    REQUIRE(text.find("lat_seconds_sum{stage=\"queue\"} ") != std::string::npos);
+}
+
+TEST_CASE("MetricsServer serves collectors on GET /metrics", "[metrics]") {
+    MetricsServerConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = 0;  // Ephemeral
+    MetricsServer server(config);
+    std::atomic<std::uint64_t> value{7};
+    server.addCollector([&value](PrometheusWriter& out) {
+        out.sample("test_value", "", value.load());
+    });
+    REQUIRE(server.start());
+    REQUIRE(server.port() != 0);
+    
+    const std::string response = httpGet(server.port(), "/metrics");
+    REQUIRE(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+    REQUIRE(response.find("Content-Type: text/plain; version=0.0.4") != std::string::npos);
+    REQUIRE(response.find("\r\n\r\ntest_value 7\n") != std::string::npos);
+    
+    value.store(8);
+    REQUIRE(httpGet(server.port(), "/metrics").find("test_value 8\n") != std::string::npos);
+    REQUIRE(httpGet(server.port(), "/other").rfind("HTTP/1.1 404", 0) == 0);
+    
+    server.stop();
+    REQUIRE(server.counters().scrapes.load() == 2);
+    REQUIRE(server.counters().rejected.load() == 1);
+}
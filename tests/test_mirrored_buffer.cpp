@@ -0,0 +1,39 @@
+// test_mirrored_buffer.cpp - Unit tests for the double-mapped ring storage
+
+#include <catch2/catch_test_macros.hpp>
+#include "MirroredBuffer.h"
+#include <cstring>
+#include <string>
+
+using namespace tws_bridge;
+
+TEST_CASE("Both halves alias the same bytes", "[mirrored]") {
+    MirroredBuffer buffer(64 * 1024);
+    REQUIRE(buffer.size() == 64 * 1024);
+    REQUIRE(buffer.mirrored());  // Linux test host
+
+    buffer.data()[10] = 'x';
+    REQUIRE(buffer.data()[buffer.size() + 10] == 'x');
+    buffer.data()[buffer.size() + 20] = 'y';
+    REQUIRE(buffer.data()[20] == 'y');
+}
+
+TEST_CASE("Writes across the end land at the start", "[mirrored]") {
+    MirroredBuffer buffer(64 * 1024);
+    REQUIRE(buffer.mirrored());
+
+    const std::string message = "frame crossing the ring end";
+    const std::size_t start = buffer.size() - 5;
+    std::memcpy(buffer.data() + start, message.data(), message.size());
+
+    REQUIRE(std::string(buffer.data() + start, message.size()) == message);
+    REQUIRE(std::string(buffer.data(), message.size() - 5) == message.substr(5));
+}
+
+TEST_CASE("Sizes that are not a page multiple fall back to plain memory", "[mirrored]") {
+    MirroredBuffer buffer(1000);
+    REQUIRE_FALSE(buffer.mirrored());
+    REQUIRE(buffer.data() != nullptr);
+    REQUIRE(buffer.size() == 1000);
+    std::memset(buffer.data(), 0, buffer.size());
+}
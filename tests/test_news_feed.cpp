@@ -0,0 +1,98 @@
+// test_news_feed.cpp - Provider interning, article dedupe and the bounded news lane (NewsFeed.h)
+
+#include <catch2/catch_test_macros.hpp>
+#include "NewsFeed.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("Generic tick list joins the providers", "[news]") {
+    REQUIRE(newsGenericTicks({"BRFG", "DJNL"}) == "mdoff,292:BRFG+DJNL");
+    REQUIRE(newsGenericTicks({"BRFG"}) == "mdoff,292:BRFG");
+}
+
+TEST_CASE("Provider codes intern to stable ids", "[news]") {
+    ProviderCodes codes;
+    const std::uint8_t brfg = codes.intern("BRFG");
+    const std::uint8_t djnl = codes.intern("DJNL");
+    REQUIRE(brfg != djnl);
+    REQUIRE(codes.intern("BRFG") == brfg);
+    REQUIRE(codes.name(brfg) == "BRFG");
+    REQUIRE(codes.name(djnl) == "DJNL");
+    REQUIRE(codes.size() == 2);
+    REQUIRE(codes.name(ProviderCodes::kOther) == "other");
+}
+
+TEST_CASE("Provider table full maps new codes to other", "[news]") {
+    ProviderCodes codes;
+    for (std::size_t i = 0; i < ProviderCodes::kMaxProviders; ++i) {
+        REQUIRE(codes.intern("P" + std::to_string(i)) == i);
+    }
+    REQUIRE(codes.intern("LATE") == ProviderCodes::kOther);
+    REQUIRE(codes.intern("P7") == 7);
+}
+
+TEST_CASE("Concurrent interning agrees on one id per code", "[news]") {
+    ProviderCodes codes;
+    std::vector<std::uint8_t> ids[4];
+    std::vector<std::thread> threads;
+    for (auto& out : ids) {
+        threads.emplace_back([&codes, &out]() {
+            for (int round = 0; round < 1000; ++round) {
+                out.push_back(codes.intern(round % 2 == 0 ? "BRFG" : "DJNL"));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(codes.size() == 2);
+    for (const auto& out : ids) {
+        REQUIRE(codes.name(out[0]) == "BRFG");
+        REQUIRE(codes.name(out[1]) == "DJNL");
+    }
+}
+
+TEST_CASE("Article filter drops repeats per symbol", "[news]") {
+    ArticleFilter filter(1024);
+    REQUIRE(filter.insert(articleFingerprint("BRFG$1", "AAPL")));
+    REQUIRE_FALSE(filter.insert(articleFingerprint("BRFG$1", "AAPL")));
+    // Same story tagged on another symbol is news on that channel too
+    REQUIRE(filter.insert(articleFingerprint("BRFG$1", "MSFT")));
+    REQUIRE(filter.insert(articleFingerprint("BRFG$2", "AAPL")));
+}
+
+TEST_CASE("Article filter remembers the newest half capacity across a generation swap", "[news]") {
+    ArticleFilter filter(64);  // Swaps after 32 inserts
+    for (int i = 0; i < 40; ++i) {
+        REQUIRE(filter.insert(articleFingerprint("A" + std::to_string(i), "SPY")));
+    }
+    // 0..31 moved to the older generation, 32..39 in the current one - all still known
+    for (int i = 0; i < 40; ++i) {
+        REQUIRE_FALSE(filter.insert(articleFingerprint("A" + std::to_string(i), "SPY")));
+    }
+    // Another full generation pushes 0..31 out
+    for (int i = 40; i < 72; ++i) {
+        REQUIRE(filter.insert(articleFingerprint("A" + std::to_string(i), "SPY")));
+    }
+    REQUIRE(filter.insert(articleFingerprint("A0", "SPY")));
+}
+
+TEST_CASE("Lane drops headlines beyond its limit", "[news]") {
+    NewsConfig config;
+    config.queueLimit = 2;
+    NewsLane lane(config);
+    for (int i = 0; i < 3; ++i) {
+        NewsItem item;
+        item.symbol = "AAPL";
+        item.articleId = std::to_string(i);
+        lane.push(std::move(item));
+    }
+    REQUIRE(lane.counters.received.load() == 3);
+    REQUIRE(lane.counters.dropped.load() == 1);
+    NewsItem item;
+    REQUIRE(lane.queue.try_dequeue(item));
+    REQUIRE(item.articleId == "0");
+}
@@ -0,0 +1,40 @@
+// test_numa_placement.cpp - NUMA node lookup and best-effort page migration
+
+#include <catch2/catch_test_macros.hpp>
+#include "NumaPlacement.h"
+#include <cstdint>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("NUMA topology is reported for the calling thread", "[numa]") {
+    const int nodes = numaNodeCount();
+    REQUIRE(nodes >= 1);
+    const int node = currentNumaNode();
+    REQUIRE(node >= 0);
+    REQUIRE(node < nodes);
+}
+
+TEST_CASE("Migration skips ranges without a whole page", "[numa]") {
+    std::uint64_t value = 42;
+    REQUIRE_FALSE(migrateToNumaNode(&value, sizeof(value), currentNumaNode()));
+    std::vector<std::uint8_t> buffer(1 << 20);
+    REQUIRE_FALSE(migrateToNumaNode(buffer.data(), buffer.size(), -1));
+    REQUIRE_FALSE(migrateToNumaNode(buffer.data(), buffer.size(), 64));
+}
+
+TEST_CASE("Migration keeps page contents", "[numa]") {
+    std::vector<std::uint32_t> buffer(1 << 18);
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<std::uint32_t>(i * 2654435761u);
+    }
+    // Refusal (seccomp / no CAP_SYS_NICE) is allowed - the data must survive either way
+    const bool moved = migrateToNumaNode(buffer.data(), buffer.size() * sizeof(std::uint32_t), currentNumaNode());
+    if (moved) {
+        const int node = numaNodeOf(buffer.data() + buffer.size() / 2);
+        REQUIRE((node == -1 || node == currentNumaNode()));
+    }
+    for (std::size_t i = 0; i < buffer.size(); ++i) {
+        REQUIRE(buffer[i] == static_cast<std::uint32_t>(i * 2654435761u));
+    }
+}
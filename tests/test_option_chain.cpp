@@ -0,0 +1,84 @@
+// test_option_chain.cpp - Unit tests for option chain leg selection, numbering and the layout cache
+
+#include <catch2/catch_test_macros.hpp>
+#include "OptionChain.h"
+
+using namespace tws_bridge;
+
+static OptionChainLayout makeLayout() {
+    OptionChainLayout layout;
+    layout.exchange = "SMART";
+    layout.tradingClass = "SPY";
+    layout.multiplier = "100";
+    layout.expirations = {"20261016", "20261019", "20261020", "20261120"};
+    layout.strikes = {440.0, 445.0, 450.0, 455.0, 460.0};
+    layout.resolvedAt = 1760000000;
+    return layout;
+}
+
+TEST_CASE("Expiry codes parse YYYYMMDD only", "[options]") {
+    REQUIRE(expiryCode("20261120") == 20261120u);
+    REQUIRE(expiryCode("202611") == 0u);
+    REQUIRE(expiryCode("2026112x") == 0u);
+    REQUIRE(expiryCodeOn(0) == 19700101u);
+    REQUIRE(expiryCodeOn(1792454400) == 20261020u);  // 2026-10-20T00:00:00Z
+}
+
+TEST_CASE("Selection keeps the nearest live expiries and the strike range", "[options]") {
+    const OptionChainLayout layout = makeLayout();
+    ChainRequest request;
+    request.expiries = 2;
+    request.minStrike = 445.0;
+    request.maxStrike = 455.0;
+
+    const ChainSelection selection = selectChain(layout, request, 20261019);
+    REQUIRE(selection.expirations == std::vector<std::string>{"20261019", "20261020"});
+    REQUIRE(selection.strikes == std::vector<double>{445.0, 450.0, 455.0});
+    REQUIRE(selection.legCount() == 12);
+
+    ChainRequest all;
+    all.expiries = 10;
+    const ChainSelection everything = selectChain(layout, all, 20261017);
+    REQUIRE(everything.expirations.size() == 3);
+    REQUIRE(everything.strikes.size() == 5);
+    REQUIRE(selectChain(layout, all, 20261121).legCount() == 0);
+}
+
+TEST_CASE("Leg numbers are dense and invertible", "[options]") {
+    ChainSelection selection;
+    selection.expirations = {"20261019", "20261020"};
+    selection.strikes = {445.0, 450.0, 455.0};
+
+    std::uint32_t expected = 0;
+    for (std::size_t e = 0; e < selection.expirations.size(); ++e) {
+        for (std::size_t s = 0; s < selection.strikes.size(); ++s) {
+            for (bool put : {false, true}) {
+                const std::uint32_t leg = selection.leg(e, s, put);
+                REQUIRE(leg == expected++);
+                REQUIRE(selection.expiryOf(leg) == selection.expirations[e]);
+                REQUIRE(selection.strikeOf(leg) == selection.strikes[s]);
+                REQUIRE(ChainSelection::isPut(leg) == put);
+            }
+        }
+    }
+    REQUIRE(expected == selection.legCount());
+}
+
+TEST_CASE("SMART row of the underlying's own class is preferred", "[options]") {
+    REQUIRE(chainRowRank("SMART", "SPY", "SPY") > chainRowRank("SMART", "2SPY", "SPY"));
+    REQUIRE(chainRowRank("SMART", "2SPY", "SPY") > chainRowRank("CBOE", "SPY", "SPY"));
+    REQUIRE(chainRowRank("CBOE", "SPY", "SPY") > chainRowRank("CBOE", "2SPY", "SPY"));
+}
+
+TEST_CASE("Layout cache answers until the entry is stale", "[options]") {
+    OptionChainCache cache;
+    OptionChainLayout found;
+    REQUIRE_FALSE(cache.find("SPY", 1760000000, found));
+
+    cache.store("SPY", makeLayout());
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.find("SPY", 1760000000 + 3600, found));
+    REQUIRE(found.strikes.size() == 5);
+    const std::int64_t maxAge = std::chrono::seconds(OptionChainCache::kChainMaxAge).count();
+    REQUIRE_FALSE(cache.find("SPY", 1760000000 + maxAge + 1, found));
+}
@@ -0,0 +1,91 @@
+// test_order_book.cpp - Unit tests for the fixed-depth L2 order book
+
+#include <catch2/catch_test_macros.hpp>
+#include "OrderBook.h"
+#include "Serialization.h"
+#include <string>
+
+using namespace tws_bridge;
+
+TEST_CASE("Inserts shift deeper levels down, deletes shift them up", "[orderbook]") {
+    OrderBook book;
+    REQUIRE(book.apply(depth::kBid, 0, depth::kInsert, 100.00, 200));
+    REQUIRE(book.apply(depth::kBid, 0, depth::kInsert, 100.01, 100));  // New best bid
+    REQUIRE(book.apply(depth::kBid, 2, depth::kInsert, 99.99, 300));
+    REQUIRE(book.bids.size() == 3);
+    REQUIRE(book.bids[0].price == 100.01);
+    REQUIRE(book.bids[1].price == 100.00);
+    REQUIRE(book.bids[2].size == 300);
+
+    REQUIRE(book.apply(depth::kBid, 1, depth::kUpdate, 100.00, 250));
+    REQUIRE(book.bids[1].size == 250);
+
+    REQUIRE(book.apply(depth::kBid, 0, depth::kDelete, 0.0, 0));
+    REQUIRE(book.bids.size() == 2);
+    REQUIRE(book.bids[0].price == 100.00);
+    REQUIRE(book.bids[1].price == 99.99);
+    REQUIRE(book.asks.size() == 0);
+}
+
+TEST_CASE("Out-of-sync operations are rejected without touching the book", "[orderbook]") {
+    OrderBook book;
+    REQUIRE_FALSE(book.apply(depth::kAsk, 1, depth::kInsert, 101.0, 100));  // Gap
+    REQUIRE_FALSE(book.apply(depth::kAsk, 0, depth::kDelete, 0.0, 0));     // Empty side
+    REQUIRE_FALSE(book.apply(depth::kAsk, 0, 7, 101.0, 100));               // Unknown operation
+    REQUIRE_FALSE(book.apply(5, 0, depth::kInsert, 101.0, 100));            // Unknown side
+    REQUIRE(book.asks.size() == 0);
+
+    // NOTE: Update of the first empty row is accepted (TWS sends those)
+    REQUIRE(book.apply(depth::kAsk, 0, depth::kUpdate, 101.0, 100));
+    REQUIRE(book.asks.size() == 1);
+    REQUIRE_FALSE(book.apply(depth::kAsk, 2, depth::kUpdate, 101.2, 100));
+}
+
+TEST_CASE("A full side drops its deepest level on insert", "[orderbook]") {
+    DepthSide side;
+    for (std::size_t i = 0; i < DepthSide::kMaxLevels; ++i) {
+        REQUIRE(side.apply(i, depth::kInsert, 100.0 + static_cast<double>(i), 1));
+    }
+    REQUIRE_FALSE(side.apply(DepthSide::kMaxLevels, depth::kInsert, 1.0, 1));
+    REQUIRE(side.apply(0, depth::kInsert, 99.0, 1));
+    REQUIRE(side.size() == DepthSide::kMaxLevels);
+    REQUIRE(side[0].price == 99.0);
+    REQUIRE(side[DepthSide::kMaxLevels - 1].price == 100.0 + static_cast<double>(DepthSide::kMaxLevels - 2));
+}
+
+TEST_CASE("Reset clears both sides", "[orderbook]") {
+    OrderBook book;
+    REQUIRE(book.apply(depth::kBid, 0, depth::kInsert, 100.0, 1));
+    REQUIRE(book.apply(depth::kAsk, 0, depth::kInsert, 100.1, 1));
+    REQUIRE(book.apply(depth::kBid, 0, depth::kReset, 0.0, 0));
+    REQUIRE(book.bids.size() == 0);
+    REQUIRE(book.asks.size() == 0);
+}
+
+TEST_CASE("Snapshots publish the top levels of each side", "[orderbook][serialization]") {
+    OrderBook book;
+    book.timestamp = 1700000000000;
+    REQUIRE(book.apply(depth::kBid, 0, depth::kInsert, 100.5, 200));
+    REQUIRE(book.apply(depth::kBid, 1, depth::kInsert, 100.25, 300));
+    REQUIRE(book.apply(depth::kAsk, 0, depth::kInsert, 100.75, 100));
+
+    JsonBuffer out;
+    serializeDepthSnapshot("AAPL", book, 1, out);
+    REQUIRE(out.str() == R"({"symbol":"AAPL","timestamp":1700000000000,"bids":[[100.5,200]],"asks":[[100.75,100]]})");
+}
+
+TEST_CASE("Deltas name the side and operation", "[orderbook][serialization]") {
+    TickUpdate update;
+    update.type = TickUpdateType::Depth;
+    update.timestamp = 5;
+    update.depth.price = 100.5;
+    update.depth.size = 200;
+    update.depth.position = 1;
+    update.depth.operation = depth::kDelete;
+    update.depth.side = depth::kAsk;
+
+    JsonBuffer out;
+    serializeDepthDelta("AAPL", update, out);
+    REQUIRE(out.str()
+            == R"({"symbol":"AAPL","timestamp":5,"side":"ask","op":"delete","position":1,"price":100.5,"size":200})");
+}
@@ -0,0 +1,67 @@
+// test_profiler_signal.cpp - SIGPROF reaches profiled threads only: a profile leaves a tws_api reader connected
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "ProfilerSignal.h"
+#include "SamplingProfiler.h"
+#include "TwsTestSupport.h"
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::tws_test;
+
+namespace {
+
+// Every thread of this process, the ones third-party code started included
+std::vector<pid_t> processThreads() {
+    std::vector<pid_t> tids;
+    for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task")) {
+        tids.push_back(static_cast<pid_t>(std::atoi(entry.path().filename().c_str())));
+    }
+    return tids;
+}
+
+} // namespace
+
+TEST_CASE("A profile leaves a tws_api reader connected", "[profiler][tws]") {
+    blockProfilerSignal();  // REASON: As main() does - the gateway's and the client's threads inherit the block
+    FakeGateway gateway;
+    ProfilerConfig config;
+    config.enabled = true;
+    config.frequency = 1000;
+    config.dir = "/tmp";
+    SamplingProfiler profiler("tcp://127.0.0.1:6379", config);
+    profiler.start();
+
+    InstrumentRegistry registry(16);
+    SpscTickQueue queue(1024);
+    Client client(queue, registry);
+    REQUIRE(profileCurrentThread());  // This thread plays tws-msg: profiled before it connects
+    REQUIRE(client.createConnection("127.0.0.1", gateway.port(), 7, ReaderMode::TwsApi));
+
+    std::string error;
+    REQUIRE(profiler.request(std::chrono::seconds(1), error));
+    // REASON: Beyond the profiler's own timer, tick every thread as a process-wide ITIMER_PROF could - the
+    // EReader thread's select would return EINTR and disconnect if SIGPROF were not blocked there
+    while (profiler.profiles() == 0) {
+        for (pid_t tid : processThreads()) {
+            syscall(SYS_tgkill, getpid(), tid, SIGPROF);
+        }
+        pump(client, []() { return false; }, std::chrono::milliseconds(10));
+    }
+    profiler.stop();
+
+    REQUIRE(profiler.samples() > 0);
+    REQUIRE(client.isConnected());
+    REQUIRE(gateway.sessions() == 1);
+    std::filesystem::remove(profiler.lastProfile());
+    client.disconnect();
+}
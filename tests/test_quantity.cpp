@@ -0,0 +1,84 @@
+// test_quantity.cpp - Scaled-integer sizes: wire text parse, JSON text, rescale and tick payload narrowing
+
+#include <catch2/catch_test_macros.hpp>
+#include "MarketData.h"
+#include "Quantity.h"
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string text(std::int64_t units, int scale) {
+    std::string out;
+    appendQuantity(out, Quantity{units, scale});
+    return out;
+}
+
+bool parsed(std::string_view wire, std::int64_t units, int scale) {
+    Quantity quantity;
+    return parseQuantity(wire, quantity) && quantity.units == units && quantity.scale == scale;
+}
+
+} // namespace
+
+TEST_CASE("Size text parses at the fewest decimal places that hold it", "[quantity]") {
+    REQUIRE(parsed("100", 100, 0));
+    REQUIRE(parsed("0.5", 5, 1));
+    REQUIRE(parsed("1.50", 15, 1));
+    REQUIRE(parsed("7.", 7, 0));
+    REQUIRE(parsed(".25", 25, 2));
+    REQUIRE(parsed("0.00000001", 1, 8));
+    REQUIRE(parsed("0.000000015", 2, 8));  // NOTE: Past kMaxQuantityScale, rounded half away from zero
+    REQUIRE(parsed("000120", 120, 0));
+
+    Quantity quantity;
+    REQUIRE_FALSE(parseQuantity("", quantity));
+    REQUIRE_FALSE(parseQuantity(".", quantity));
+    REQUIRE_FALSE(parseQuantity("-2", quantity));
+    REQUIRE_FALSE(parseQuantity("1E3", quantity));
+    REQUIRE_FALSE(parseQuantity("1.2.3", quantity));
+    REQUIRE_FALSE(parseQuantity("1234567890123.1234567", quantity));
+}
+
+TEST_CASE("JSON text drops trailing fraction zeros", "[quantity]") {
+    REQUIRE(text(100, 0) == "100");
+    REQUIRE(text(1000, 1) == "100");
+    REQUIRE(text(5, 1) == "0.5");
+    REQUIRE(text(5, 3) == "0.005");
+    REQUIRE(text(120025, 2) == "1200.25");
+    REQUIRE(text(-125, 2) == "-1.25");
+    REQUIRE(text(0, 8) == "0");
+}
+
+TEST_CASE("Rescaling widens exactly and narrows half away from zero", "[quantity]") {
+    REQUIRE(rescaleUnits(15, 1, 3) == 1500);
+    REQUIRE(rescaleUnits(15, 1, 0) == 2);
+    REQUIRE(rescaleUnits(-15, 1, 0) == -2);
+    REQUIRE(rescaleUnits(14, 1, 0) == 1);
+    REQUIRE(wholeUnits(Quantity{12345, 2}) == 123);
+
+    std::int64_t first = 123456789012;  // 1234567890.12 at scale 2
+    std::int64_t second = 5;
+    REQUIRE(narrowQuantities(first, second, 2) == 0);
+    REQUIRE(first == 1234567890);
+    REQUIRE(second == 0);
+}
+
+TEST_CASE("Instrument sizes widen to the finest scale seen", "[quantity]") {
+    InstrumentState state;
+    state.bidSize = state.sizeUnits(Quantity{300, 0});
+    state.askSize = state.sizeUnits(Quantity{25, 1});
+    REQUIRE(state.sizeScale == 1);
+    REQUIRE(state.bidSize == 3000);
+    REQUIRE(state.askSize == 25);
+    state.lastSize = state.sizeUnits(Quantity{7, 0});
+    REQUIRE(state.lastSize == 70);
+    REQUIRE(text(state.bidQuantity().units, state.bidQuantity().scale) == "300");
+
+    TickUpdate tick;
+    tick.setQuoteSizes(Quantity{5, 1}, Quantity{125, 2});
+    REQUIRE(tick.sizeScale() == 2);
+    REQUIRE(tick.bidQuantity().units == 50);
+    REQUIRE(tick.askQuantity().units == 125);
+}
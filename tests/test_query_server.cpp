@@ -0,0 +1,131 @@
+// test_query_server.cpp - QuoteTable seqlock records and snapshot lookups over the Unix datagram socket
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "QueryServer.h"
+#include "QuoteTable.h"
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+namespace {
+
+InstrumentState quote(double bid, double ask) {
+    InstrumentState state;
+    state.bidPrice = bid;
+    state.askPrice = ask;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.quoteTimestamp = 1700000000;
+    state.hasQuote = true;
+    state.sequence = 7;
+    state.primaryExchange = "NASDAQ";
+    return state;
+}
+
+} // namespace
+
+TEST_CASE("Quote records round-trip and unwritten slots read as absent", "[query]") {
+    QuoteTable table(4);
+    QuoteRecord record{};
+    REQUIRE_FALSE(table.read(1, record));
+    REQUIRE_FALSE(table.read(9, record));
+
+    table.write(1, makeQuoteRecord(quote(101.25, 101.5)));
+    REQUIRE(table.read(1, record));
+    InstrumentState state;
+    restoreQuoteRecord(record, state);
+    REQUIRE(state.bidPrice == 101.25);
+    REQUIRE(state.askPrice == 101.5);
+    REQUIRE(state.askSize == 200);
+    REQUIRE(state.sequence == 7);
+    REQUIRE(state.primaryExchange == "NASDAQ");
+    REQUIRE(state.hasQuote);
+    REQUIRE_FALSE(state.hasTrade);
+}
+
+TEST_CASE("Concurrent reads never see a torn record", "[query]") {
+    QuoteTable table(1);
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (int i = 1; i <= 200000; ++i) {
+            InstrumentState state;
+            state.bidPrice = i;
+            state.askPrice = i;
+            state.bidSize = i;
+            state.askSize = i;
+            table.write(0, makeQuoteRecord(state));
+        }
+        done.store(true);
+    });
+    bool consistent = true;
+    while (!done.load()) {
+        QuoteRecord record{};
+        if (table.read(0, record)) {
+            consistent = consistent && record.bidPrice == record.askPrice && record.bidSize == record.askSize
+                      && record.bidPrice == record.bidSize;
+        }
+    }
+    writer.join();
+    REQUIRE(consistent);
+}
+
+TEST_CASE("Answers list snapshots in request order, null for unknown or empty slots", "[query]") {
+    InstrumentRegistry registry(8);
+    const SlotId aapl = registry.registerInstrument("AAPL");
+    registry.registerInstrument("MSFT");  // Registered, nothing published yet
+    QuoteTable table(registry.capacity());
+    table.write(aapl, makeQuoteRecord(quote(190.5, 190.75)));
+
+    QueryServer server(registry, table, QueryConfig{});
+    const std::string& reply = server.answer("AAPL, MSFT NOPE");
+    REQUIRE(reply.front() == '[');
+    REQUIRE(reply.find("\"instrument\":\"AAPL\"") != std::string::npos);
+    REQUIRE(reply.find("190.5") != std::string::npos);
+    REQUIRE(reply.find("\"seq\":7") != std::string::npos);
+    REQUIRE(reply.substr(reply.size() - 11) == ",null,null]");
+    REQUIRE(server.counters().found.load() == 1);
+    REQUIRE(server.counters().missed.load() == 2);
+    REQUIRE(server.answer("   ") == "[]");
+}
+
+TEST_CASE("Datagram lookups are answered to the sender", "[query]") {
+    InstrumentRegistry registry(4);
+    const SlotId spy = registry.registerInstrument("SPY");
+    QuoteTable table(registry.capacity());
+    table.write(spy, makeQuoteRecord(quote(450.1, 450.2)));
+
+    QueryConfig config;
+    config.socketPath = "/tmp/tws-bridge-test-query-" + std::to_string(::getpid()) + ".sock";
+    QueryServer server(registry, table, config);
+    REQUIRE(server.start());
+
+    const int fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    sockaddr_un self{};
+    self.sun_family = AF_UNIX;
+    REQUIRE(::bind(fd, reinterpret_cast<sockaddr*>(&self), sizeof(sa_family_t)) == 0);  // NOTE: Linux autobind
+    timeval timeout{2, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_un target{};
+    target.sun_family = AF_UNIX;
+    std::memcpy(target.sun_path, config.socketPath.c_str(), config.socketPath.size());
+    const std::string request = "SPY";
+    REQUIRE(::sendto(fd, request.data(), request.size(), 0, reinterpret_cast<sockaddr*>(&target), sizeof(target))
+            == static_cast<ssize_t>(request.size()));
+    char reply[4096];
+    const ssize_t received = ::recv(fd, reply, sizeof(reply), 0);
+    REQUIRE(received > 0);
+    const std::string text(reply, static_cast<std::size_t>(received));
+    REQUIRE(text.find("\"instrument\":\"SPY\"") != std::string::npos);
+    REQUIRE(text.find("450.1") != std::string::npos);
+    ::close(fd);
+    server.stop();
+    REQUIRE(::access(config.socketPath.c_str(), F_OK) != 0);  // REASON: Removed on stop
+}
@@ -0,0 +1,97 @@
+// test_queue_sizing.cpp - Occupancy telemetry and capacity recommendation (QueueSizing.h)
+
+#include <catch2/catch_test_macros.hpp>
+#include "QueueSizing.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+using namespace tws_bridge;
+
+namespace {
+constexpr std::int64_t kMs = 1000000;
+}
+
+TEST_CASE("Occupancy tracks the high water mark and bursts", "[queue-sizing]") {
+    QueueOccupancy occupancy;
+    occupancy.sample(10, 0, 1 * kMs);
+    occupancy.sample(256, 700, 2 * kMs);   // Burst starts: the batch could not empty the queue
+    occupancy.sample(256, 300, 3 * kMs);
+    occupancy.sample(256, 0, 7 * kMs);     // ... and ends 5 ms later
+    REQUIRE(occupancy.highWater() == 956);
+
+    LatencySnapshot bursts;
+    occupancy.bursts(bursts);
+    REQUIRE(bursts.total() == 1);
+    REQUIRE(bursts.max() >= 5 * kMs);
+    REQUIRE(bursts.max() < 6 * kMs);
+
+    LatencySnapshot depth;
+    occupancy.depth(depth);
+    REQUIRE(depth.total() == 4);
+}
+
+TEST_CASE("Peak rate counts arrivals, not the drain after a stall", "[queue-sizing]") {
+    QueueOccupancy occupancy;
+    occupancy.sample(0, 0, 0 + 1);
+    // 1 s stall: nothing dequeued, 50000 arrived and wait
+    occupancy.sample(0, 50000, 1000 * kMs + 1);
+    REQUIRE(occupancy.peakRate() >= 49000.0);
+    REQUIRE(occupancy.peakRate() <= 51000.0);
+    // Next second drains all of it while 1000 more arrive - 1000/s, not 51000/s
+    occupancy.sample(51000, 0, 2000 * kMs + 1);
+    REQUIRE(occupancy.peakRate() <= 51000.0);
+    REQUIRE(occupancy.peakRate() >= 49000.0);
+}
+
+TEST_CASE("Recommendation covers the stall at peak rate with headroom", "[queue-sizing]") {
+    QueueSizingConfig config;
+    // 100k/s × 50 ms = 5000 updates, × 1.5 = 7500 → 8192
+    REQUIRE(recommendQueueCapacity(100000.0, 50 * kMs, 100, config) == 8192);
+    // Observed high water dominates a short stall
+    REQUIRE(recommendQueueCapacity(100000.0, 1 * kMs, 20000, config) == 32768);
+    // Clamped to [min, max]
+    REQUIRE(recommendQueueCapacity(0.0, 0, 0, config) == config.minCapacity);
+    config.maxCapacity = 65536;
+    REQUIRE(recommendQueueCapacity(1e7, 1000 * kMs, 0, config) == 65536);
+}
+
+TEST_CASE("Report takes the stall percentile from the round trips", "[queue-sizing]") {
+    QueueSizingConfig config;
+    config.stallPercentile = 99.0;
+    QueueOccupancy occupancy;
+    occupancy.sample(0, 0, 1);
+    occupancy.sample(20000, 0, 1000 * kMs + 1);
+    LatencySnapshot roundTrips;
+    roundTrips.counts[LatencySnapshot::bucketOf(200000)] = 98;      // 200 us
+    roundTrips.counts[LatencySnapshot::bucketOf(40 * kMs)] = 2;     // 40 ms stalls
+    const QueueSizingReport report = summarizeQueueSizing(3, 10000, occupancy, roundTrips, config);
+    REQUIRE(report.shard == 3);
+    REQUIRE(report.configured == 10000);
+    REQUIRE(report.highWater == 20000);
+    REQUIRE(report.stallNs >= 40 * kMs);
+    REQUIRE(report.recommended == 32768);
+}
+
+TEST_CASE("Recommendation file round-trips", "[queue-sizing]") {
+    const std::string path = "test_queue_sizing_" + std::to_string(::getpid()) + ".txt";
+    std::size_t capacity = 10000;
+    std::string error;
+    REQUIRE(loadQueueCapacity(path, capacity, error));  // Missing: nothing to adopt
+    REQUIRE(capacity == 10000);
+
+    QueueSizingReport report;
+    report.recommended = 16384;
+    REQUIRE(saveQueueCapacity(path, 16384, &report, 1, error));
+    REQUIRE(loadQueueCapacity(path, capacity, error));
+    REQUIRE(capacity == 16384);
+
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "# comment only\nqueue_capacity lots\n";
+    }
+    REQUIRE_FALSE(loadQueueCapacity(path, capacity, error));
+    REQUIRE(error.find("queue_capacity") != std::string::npos);
+    std::remove(path.c_str());
+}
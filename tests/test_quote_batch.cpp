@@ -0,0 +1,89 @@
+// test_quote_batch.cpp - Unit tests for the per-batch quote reduction (QuoteBatchReducer)
+
+#include <catch2/catch_test_macros.hpp>
+#include "QuoteBatch.h"
+#include <cstdint>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+TickUpdate quote(std::uint16_t slot, double bid) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.bidAsk.bidPrice = bid;
+    update.bidAsk.askPrice = bid + 0.01;
+    return update;
+}
+
+TickUpdate trade(std::uint16_t slot, double price) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::AllLast;
+    update.allLast.price = price;
+    return update;
+}
+
+// Prices of the kept updates, in order
+std::vector<double> kept(const std::vector<TickUpdate>& batch, std::size_t first) {
+    std::vector<double> prices;
+    for (std::size_t i = first; i < batch.size(); ++i) {
+        prices.push_back(batch[i].type == TickUpdateType::AllLast ? batch[i].allLast.price : batch[i].bidAsk.bidPrice);
+    }
+    return prices;
+}
+
+} // namespace
+
+TEST_CASE("Only the last quote of each slot survives, in batch order", "[quote-batch]") {
+    QuoteBatchReducer reducer(8);
+    std::vector<TickUpdate> batch{quote(1, 10.0), quote(2, 20.0), quote(1, 11.0), quote(3, 30.0), quote(1, 12.0),
+                                  quote(2, 21.0)};
+    const std::size_t first = reducer.reduce(batch.data(), batch.size(), false);
+    REQUIRE(first == 3);
+    REQUIRE(kept(batch, first) == std::vector<double>{30.0, 12.0, 21.0});
+    REQUIRE(batch[first].slot == 3);
+}
+
+TEST_CASE("Trades are never dropped and fence quotes only when they publish alone", "[quote-batch]") {
+    QuoteBatchReducer reducer(4);
+    const std::vector<TickUpdate> input{quote(1, 10.0), trade(1, 10.5), trade(1, 10.6), quote(1, 11.0)};
+
+    std::vector<TickUpdate> conflated = input;
+    std::size_t first = reducer.reduce(conflated.data(), conflated.size(), false);
+    REQUIRE(kept(conflated, first) == std::vector<double>{10.5, 10.6, 11.0});
+
+    // REASON: The trade's own snapshot must carry the 10.0 quote
+    std::vector<TickUpdate> individual = input;
+    first = reducer.reduce(individual.data(), individual.size(), true);
+    REQUIRE(first == 0);
+    REQUIRE(kept(individual, first) == std::vector<double>{10.0, 10.5, 10.6, 11.0});
+}
+
+TEST_CASE("Backfill, other types and unknown slots pass through", "[quote-batch]") {
+    QuoteBatchReducer reducer(4);
+    TickUpdate history = quote(1, 9.0);
+    history.flags |= TickFlags::Backfill;
+    TickUpdate depth;
+    depth.slot = 1;
+    depth.type = TickUpdateType::Depth;
+    std::vector<TickUpdate> batch{history, quote(1, 10.0), depth, quote(9, 90.0), quote(9, 91.0), quote(1, 11.0)};
+    const std::size_t first = reducer.reduce(batch.data(), batch.size(), true);
+    REQUIRE(first == 1);
+    REQUIRE(batch[first].backfilled());
+    REQUIRE(batch[first + 1].type == TickUpdateType::Depth);
+    REQUIRE(batch[first + 2].slot == 9);
+    REQUIRE(batch[first + 3].slot == 9);
+    REQUIRE(batch[first + 4].bidAsk.bidPrice == 11.0);
+}
+
+TEST_CASE("A slot covered in one batch is not covered in the next", "[quote-batch]") {
+    QuoteBatchReducer reducer(4);
+    std::vector<TickUpdate> batch{quote(1, 10.0)};
+    REQUIRE(reducer.reduce(batch.data(), batch.size(), false) == 0);
+    batch = {quote(1, 11.0)};
+    REQUIRE(reducer.reduce(batch.data(), batch.size(), false) == 0);
+    REQUIRE(batch[0].bidAsk.bidPrice == 11.0);
+}
@@ -0,0 +1,46 @@
+// test_reconnect_backoff.cpp - Unit tests for the TWS reconnect back-off schedule
+
+#include <catch2/catch_test_macros.hpp>
+#include "ReconnectBackoff.h"
+
+using namespace tws_bridge;
+using std::chrono::milliseconds;
+
+TEST_CASE("Delays double from the initial delay up to the cap", "[reconnect]") {
+    ReconnectPolicy policy;
+    policy.initialDelay = milliseconds(250);
+    policy.maxDelay = milliseconds(1500);
+    ReconnectBackoff backoff(policy);
+
+    REQUIRE(backoff.next() == milliseconds(250));
+    REQUIRE(backoff.next() == milliseconds(500));
+    REQUIRE(backoff.next() == milliseconds(1000));
+    REQUIRE(backoff.next() == milliseconds(1500));
+    REQUIRE(backoff.next() == milliseconds(1500));
+    REQUIRE(backoff.attempts() == 5);
+    REQUIRE_FALSE(backoff.exhausted());  // maxAttempts = 0: retry until shutdown
+
+    backoff.reset();
+    REQUIRE(backoff.attempts() == 0);
+    REQUIRE(backoff.next() == milliseconds(250));
+}
+
+TEST_CASE("Initial delay above the cap is capped", "[reconnect]") {
+    ReconnectPolicy policy;
+    policy.initialDelay = milliseconds(5000);
+    policy.maxDelay = milliseconds(2000);
+    ReconnectBackoff backoff(policy);
+    REQUIRE(backoff.next() == milliseconds(2000));
+    REQUIRE(backoff.next() == milliseconds(2000));
+}
+
+TEST_CASE("Attempts run out at maxAttempts", "[reconnect]") {
+    ReconnectPolicy policy;
+    policy.maxAttempts = 2;
+    ReconnectBackoff backoff(policy);
+    REQUIRE_FALSE(backoff.exhausted());
+    backoff.next();
+    REQUIRE_FALSE(backoff.exhausted());
+    backoff.next();
+    REQUIRE(backoff.exhausted());
+}
@@ -0,0 +1,77 @@
+// test_redis_function.cpp - FCALL arguments built from a batch's PUBLISH / SET / XADD runs
+
+#include <catch2/catch_test_macros.hpp>
+#include "RedisFunction.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::vector<std::string> strings(const std::vector<std::string_view>& args) {
+    return std::vector<std::string>(args.begin(), args.end());
+}
+
+} // namespace
+
+TEST_CASE("One snapshot's commands share one payload argument", "[redis_function]") {
+    const std::string stored = "{\"instrument\":\"AAPL\"}";
+    const PublishMessage messages[] = {
+        {"TWS:TICKS:AAPL", stored, RedisCommand::Publish, 0.0},
+        {"TWS:STREAM:AAPL", stored, RedisCommand::StreamAdd, 0.0},
+        {"TWS:LAST:AAPL", stored, RedisCommand::Set, 0.0},
+    };
+    FunctionBatch batch;
+    const auto args = strings(batch.build(messages, 3, 10000, true));
+
+    REQUIRE(batch.groups() == 1);
+    REQUIRE(args == std::vector<std::string>{"FCALL", "tws_publish", "2", "TWS:STREAM:AAPL", "TWS:LAST:AAPL",
+                                             "10000", "1", "PXS", "TWS:TICKS:AAPL", stored});
+}
+
+TEST_CASE("Separately encoded payloads stay separate groups", "[redis_function]") {
+    const std::string first = "{\"seq\":1}";
+    const std::string copy = first;  // NOTE: Same bytes, different storage - not merged
+    const PublishMessage messages[] = {
+        {"TWS:TICKS:AAPL", first, RedisCommand::Publish, 0.0},
+        {"TWS:LAST:AAPL", copy, RedisCommand::Set, 0.0},
+        {"TWS:TICKS:MSFT", copy, RedisCommand::Publish, 0.0},
+    };
+    FunctionBatch batch;
+    const auto args = strings(batch.build(messages, 3, 0, false));
+
+    REQUIRE(batch.groups() == 2);
+    REQUIRE(args == std::vector<std::string>{"FCALL", "tws_publish", "1", "TWS:LAST:AAPL", "0", "0",
+                                             "P", "TWS:TICKS:AAPL", first,
+                                             "SP", "TWS:TICKS:MSFT", copy});
+}
+
+TEST_CASE("A group carries one channel", "[redis_function]") {
+    const std::string stored = "{}";
+    const PublishMessage messages[] = {
+        {"A", stored, RedisCommand::Publish, 0.0},
+        {"B", stored, RedisCommand::Publish, 0.0},
+        {"C", stored, RedisCommand::StreamAdd, 0.0},
+    };
+    FunctionBatch batch;
+    const auto args = strings(batch.build(messages, 3, -1, true));
+
+    REQUIRE(batch.groups() == 2);
+    REQUIRE(args == std::vector<std::string>{"FCALL", "tws_publish", "1", "C", "-1", "1",
+                                             "P", "A", stored, "PX", "B", stored});
+
+    // NOTE: Rebuilding reuses the buffers, the previous views are not referenced
+    const auto again = strings(batch.build(messages, 1, 500, false));
+    REQUIRE(again == std::vector<std::string>{"FCALL", "tws_publish", "0", "500", "0", "P", "A", stored});
+}
+
+TEST_CASE("Only Publish, Set and StreamAdd are fusable", "[redis_function]") {
+    PublishMessage message;
+    REQUIRE(FunctionBatch::fusable(message));
+    message.command = RedisCommand::HashSet;
+    REQUIRE_FALSE(FunctionBatch::fusable(message));
+    message.command = RedisCommand::SortedSetAdd;
+    REQUIRE_FALSE(FunctionBatch::fusable(message));
+}
@@ -0,0 +1,48 @@
+// test_redis_uri.cpp - Unit tests for Redis endpoint URI parsing
+
+#include <catch2/catch_test_macros.hpp>
+#include "RedisUri.h"
+
+#include <stdexcept>
+
+using namespace tws_bridge;
+
+TEST_CASE("TCP URIs parse host, port, password and db", "[redis_uri]") {
+    RedisEndpoint endpoint = parseRedisUri("tcp://10.0.0.5:6380");
+    REQUIRE_FALSE(endpoint.unixSocket);
+    REQUIRE(endpoint.host == "10.0.0.5");
+    REQUIRE(endpoint.port == 6380);
+    REQUIRE(endpoint.db == 0);
+
+    endpoint = parseRedisUri("redis://:secret@cache.local/3");
+    REQUIRE(endpoint.host == "cache.local");
+    REQUIRE(endpoint.port == 6379);
+    REQUIRE(endpoint.password == "secret");
+    REQUIRE(endpoint.db == 3);
+
+    endpoint = parseRedisUri("localhost");
+    REQUIRE(endpoint.host == "localhost");
+    REQUIRE(endpoint.port == 6379);
+}
+
+TEST_CASE("Unix socket URIs keep the path", "[redis_uri]") {
+    RedisEndpoint endpoint = parseRedisUri("unix:///var/run/redis/redis.sock");
+    REQUIRE(endpoint.unixSocket);
+    REQUIRE(endpoint.path == "/var/run/redis/redis.sock");
+    REQUIRE(endpoint.db == 0);
+
+    endpoint = parseRedisUri("unix://:pw@/tmp/redis.sock?db=2");
+    REQUIRE(endpoint.path == "/tmp/redis.sock");
+    REQUIRE(endpoint.password == "pw");
+    REQUIRE(endpoint.db == 2);
+}
+
+TEST_CASE("Malformed URIs are rejected", "[redis_uri]") {
+    REQUIRE_THROWS_AS(parseRedisUri("http://host:6379"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseRedisUri("tcp://host:0"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseRedisUri("tcp://host:70000"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseRedisUri("tcp://host:port"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseRedisUri("tcp://:6379"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseRedisUri("unix://relative.sock"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parseRedisUri("tcp://host/x"), std::invalid_argument);
+}
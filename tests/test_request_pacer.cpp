@@ -0,0 +1,117 @@
+// test_request_pacer.cpp - Unit tests for the outbound request token bucket
+
+#include <catch2/catch_test_macros.hpp>
+#include "RequestPacer.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using Clock = RequestPacer::Clock;
+using std::chrono::milliseconds;
+
+TEST_CASE("Burst is sent at once, the rest at the refill rate", "[pacer]") {
+    const Clock::time_point start{};
+    PacingConfig config;
+    config.messagesPerSecond = 10.0;
+    config.burst = 4.0;
+    RequestPacer pacer(config, start);
+
+    int sent = 0;
+    for (int i = 0; i < 10; ++i) {
+        pacer.submit(0, 1, 0, [&sent]() { ++sent; });
+    }
+    REQUIRE(pacer.pump(start) == 4);
+    REQUIRE(sent == 4);
+    REQUIRE(pacer.pump(start + milliseconds(50)) == 0);   // Half a token
+    REQUIRE(pacer.pump(start + milliseconds(300)) == 3);  // 3 tokens refilled
+    REQUIRE(pacer.pump(start + milliseconds(10000)) == 3);  // Capped at burst, 3 left anyway
+    REQUIRE(sent == 10);
+    REQUIRE(pacer.counters().messages == 10);
+}
+
+TEST_CASE("Higher priority goes first, FIFO within a priority", "[pacer]") {
+    const Clock::time_point start{};
+    RequestPacer pacer(PacingConfig{}, start);
+    std::vector<std::string> order;
+    pacer.submit(0, 1, 0, [&order]() { order.push_back("thin-1"); });
+    pacer.submit(5, 1, 0, [&order]() { order.push_back("liquid-1"); });
+    pacer.submit(0, 1, 0, [&order]() { order.push_back("thin-2"); });
+    pacer.submit(5, 1, 0, [&order]() { order.push_back("liquid-2"); });
+
+    REQUIRE(pacer.pump(start) == 4);
+    REQUIRE(order == std::vector<std::string>{"liquid-1", "liquid-2", "thin-1", "thin-2"});
+}
+
+TEST_CASE("Multi-message requests wait for enough tokens", "[pacer]") {
+    const Clock::time_point start{};
+    PacingConfig config;
+    config.messagesPerSecond = 10.0;
+    config.burst = 3.0;
+    RequestPacer pacer(config, start);
+    pacer.submit(1, 2, 0, []() {});
+    pacer.submit(1, 2, 0, []() {});
+    pacer.submit(0, 1, 0, []() {});
+
+    REQUIRE(pacer.pump(start) == 1);  // 1 token left - the second pair must not be overtaken
+    REQUIRE(pacer.pending() == 2);
+    REQUIRE(pacer.pump(start + milliseconds(100)) == 1);
+    REQUIRE(pacer.pump(start + milliseconds(200)) == 1);
+}
+
+TEST_CASE("Tick-by-tick stream limit holds subscriptions until a cancel frees streams", "[pacer]") {
+    const Clock::time_point start{};
+    PacingConfig config;
+    config.maxTickByTick = 4;
+    RequestPacer pacer(config, start);
+    int bars = 0;
+    pacer.submit(0, 2, 2, []() {});
+    pacer.submit(0, 2, 2, []() {});
+    pacer.submit(0, 2, 2, []() {});
+    pacer.submit(0, 1, 0, [&bars]() { ++bars; });  // Not a stream - not blocked
+
+    REQUIRE(pacer.pump(start) == 3);
+    REQUIRE(bars == 1);
+    REQUIRE(pacer.activeStreams() == 4);
+    REQUIRE(pacer.pending() == 1);
+    REQUIRE(pacer.counters().streamWaits == 1);
+
+    pacer.submit(RequestPacer::kCancelPriority, 2, -2, []() {});
+    REQUIRE(pacer.pump(start + milliseconds(1000)) == 2);  // Cancel, then the waiting subscription
+    REQUIRE(pacer.activeStreams() == 4);
+    REQUIRE(pacer.pending() == 0);
+}
+
+TEST_CASE("Unsent requests can be withdrawn", "[pacer]") {
+    const Clock::time_point start{};
+    RequestPacer pacer(PacingConfig{}, start);
+    bool sent = false;
+    auto ticket = pacer.submit(0, 2, 2, [&sent]() { sent = true; });
+    REQUIRE(pacer.withdraw(ticket));
+    REQUIRE_FALSE(pacer.withdraw(ticket));
+    REQUIRE(pacer.pump(start) == 0);
+    REQUIRE_FALSE(sent);
+    REQUIRE(pacer.counters().withdrawn == 1);
+}
+
+TEST_CASE("A new session drops pending cancels and frees every stream", "[pacer]") {
+    const Clock::time_point start{};
+    PacingConfig config;
+    config.burst = 2.0;
+    config.maxTickByTick = 2;
+    RequestPacer pacer(config, start);
+    std::vector<std::string> order;
+    pacer.submit(0, 2, 2, [&order]() { order.push_back("AAPL"); });
+    REQUIRE(pacer.pump(start) == 1);
+    REQUIRE(pacer.activeStreams() == 2);
+
+    // Socket lost with a cancel and a subscription still queued
+    pacer.submit(RequestPacer::kCancelPriority, 2, -2, [&order]() { order.push_back("cancel AAPL"); });
+    pacer.submit(0, 2, 2, [&order]() { order.push_back("SPY"); });
+    REQUIRE(pacer.resetSession() == 1);
+    REQUIRE(pacer.activeStreams() == 0);
+    REQUIRE(pacer.pending() == 1);
+
+    REQUIRE(pacer.pump(start + milliseconds(1000)) == 1);  // Not stream-blocked by the old session
+    REQUIRE(order == std::vector<std::string>{"AAPL", "SPY"});
+    REQUIRE(pacer.activeStreams() == 2);
+}
@@ -0,0 +1,50 @@
+// test_request_table.cpp - Unit tests for the flat reqId → slot table
+
+#include <catch2/catch_test_macros.hpp>
+#include "RequestTable.h"
+#include <atomic>
+#include <thread>
+
+using namespace tws_bridge;
+
+TEST_CASE("Published ids resolve, unknown ids are invalid", "[requests]") {
+    RequestTable table(100);
+    REQUIRE(table.lookup(7) == kInvalidSlot);
+    
+    REQUIRE(table.publish(7, 3));
+    REQUIRE(table.publish(99, 4));
+    REQUIRE(table.lookup(7) == 3);
+    REQUIRE(table.lookup(99) == 4);
+    REQUIRE(table.lookup(8) == kInvalidSlot);
+}
+
+TEST_CASE("Out-of-range ids are rejected", "[requests]") {
+    RequestTable table(100);
+    REQUIRE_FALSE(table.publish(100, 1));
+    REQUIRE_FALSE(table.publish(-1, 1));
+    REQUIRE(table.lookup(100) == kInvalidSlot);
+    REQUIRE(table.lookup(-1) == kInvalidSlot);
+    REQUIRE(table.lookup(4294967297LL) == kInvalidSlot);  // Would wrap to 1 as a 32-bit id
+}
+
+TEST_CASE("Ids published while a reader is polling become visible", "[requests]") {
+    RequestTable table(1024);
+    std::atomic<bool> sawAll{false};
+    
+    std::thread reader([&]() {
+        for (int id = 0; id < 1024; ++id) {
+            while (table.lookup(id) == kInvalidSlot) {
+                std::this_thread::yield();
+            }
+        }
+        sawAll.store(true);
+    });
+    
+    for (int id = 0; id < 1024; ++id) {
+        table.publish(id, static_cast<SlotId>(id % 64));
+    }
+    reader.join();
+    
+    REQUIRE(sawAll.load());
+    REQUIRE(table.lookup(1023) == 1023 % 64);
+}
@@ -0,0 +1,100 @@
+// test_resp_connection.cpp - Direct RESP round trips against an in-process fake Redis (both backends)
+
+#include <catch2/catch_test_macros.hpp>
+#include "RespConnection.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+namespace {
+
+// Accepts one connection, reads until `expect` bytes arrived, answers `replies`
+class FakeRedis {
+public:
+    FakeRedis(std::size_t expect, std::string replies) {
+        m_listen = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(m_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        ::getsockname(m_listen, reinterpret_cast<sockaddr*>(&address), &length);
+        m_port = ntohs(address.sin_port);
+        ::listen(m_listen, 1);
+        m_thread = std::thread([this, expect, replies]() {
+            const int fd = ::accept(m_listen, nullptr, nullptr);
+            char buffer[4096];
+            std::size_t total = 0;
+            while (total < expect) {
+                const ssize_t got = ::recv(fd, buffer, sizeof(buffer), 0);
+                if (got <= 0) {
+                    break;
+                }
+                m_received.append(buffer, static_cast<std::size_t>(got));
+                total += static_cast<std::size_t>(got);
+            }
+            ::send(fd, replies.data(), replies.size(), MSG_NOSIGNAL);
+            ::recv(fd, buffer, sizeof(buffer), 0);  // Until the client closes
+            ::close(fd);
+        });
+    }
+
+    ~FakeRedis() {
+        m_thread.join();
+        ::close(m_listen);
+    }
+
+    int port() const { return m_port; }
+    const std::string& received() const { return m_received; }
+
+private:
+    int m_listen = -1;
+    int m_port = 0;
+    std::string m_received;
+    std::thread m_thread;
+};
+
+const std::string kBatch = "*3\r\n$7\r\nPUBLISH\r\n$1\r\nA\r\n$1\r\nx\r\n"
+                           "*3\r\n$3\r\nSET\r\n$1\r\nK\r\n$1\r\ny\r\n";
+
+void roundTrip(RespBackend backend) {
+    FakeRedis redis(kBatch.size(), ":2\r\n+OK\r\n");
+    RedisEndpoint endpoint;
+    endpoint.port = redis.port();
+    RedisConnectionPolicy policy;
+    policy.respBackend = backend;
+    policy.socketTimeout = std::chrono::milliseconds(1000);
+    {
+        RespConnection connection(endpoint, policy, 100, true);
+        const PublishMessage batch[] = {{"A", "x", RedisCommand::Publish}, {"K", "y", RedisCommand::Set}};
+        connection.send(batch, 2);
+        REQUIRE(connection.isOpen());
+    }
+    REQUIRE(redis.received() == kBatch);
+}
+
+} // namespace
+
+TEST_CASE("Socket backend sends the batch and reads every reply", "[resp-connection]") {
+    roundTrip(RespBackend::Socket);
+}
+
+TEST_CASE("io_uring backend (or its socket fallback) behaves the same", "[resp-connection]") {
+    roundTrip(RespBackend::IoUring);
+}
+
+TEST_CASE("Error replies throw but keep the connection", "[resp-connection]") {
+    FakeRedis redis(kBatch.size(), ":2\r\n-WRONGTYPE bad\r\n");
+    RedisEndpoint endpoint;
+    endpoint.port = redis.port();
+    RespConnection connection(endpoint, RedisConnectionPolicy{}, 100, true);
+    const PublishMessage batch[] = {{"A", "x", RedisCommand::Publish}, {"K", "y", RedisCommand::Set}};
+    REQUIRE_THROWS_AS(connection.send(batch, 2), std::runtime_error);
+    REQUIRE(connection.isOpen());
+}
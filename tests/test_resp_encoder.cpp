@@ -0,0 +1,87 @@
+// test_resp_encoder.cpp - Unit tests for direct RESP batch encoding and reply scanning
+
+#include <catch2/catch_test_macros.hpp>
+#include "RespEncoder.h"
+#include <string>
+
+using namespace tws_bridge;
+
+TEST_CASE("Batch commands are encoded back to back", "[resp]") {
+    RespEncoder encoder(1000, true);
+    REQUIRE(encoder.append(PublishMessage{"TWS:TICKS:AAPL", "{\"p\":1}", RedisCommand::Publish}) == 1);
+    REQUIRE(encoder.append(PublishMessage{"TWS:LVC:AAPL", "v", RedisCommand::Set}) == 1);
+    REQUIRE(encoder.buffer() == "*3\r\n$7\r\nPUBLISH\r\n$14\r\nTWS:TICKS:AAPL\r\n$7\r\n{\"p\":1}\r\n"
+                                "*3\r\n$3\r\nSET\r\n$12\r\nTWS:LVC:AAPL\r\n$1\r\nv\r\n");
+
+    encoder.clear();
+    REQUIRE(encoder.buffer().empty());
+}
+
+TEST_CASE("XADD carries the stream trim policy", "[resp]") {
+    RespEncoder approximate(500, true);
+    approximate.append(PublishMessage{"S", "x", RedisCommand::StreamAdd});
+    REQUIRE(approximate.buffer() == "*8\r\n$4\r\nXADD\r\n$1\r\nS\r\n$6\r\nMAXLEN\r\n$1\r\n~\r\n$3\r\n500\r\n"
+                                    "$1\r\n*\r\n$4\r\ndata\r\n$1\r\nx\r\n");
+
+    RespEncoder exact(7, false);
+    exact.append(PublishMessage{"S", "x", RedisCommand::StreamAdd});
+    REQUIRE(exact.buffer() == "*7\r\n$4\r\nXADD\r\n$1\r\nS\r\n$6\r\nMAXLEN\r\n$1\r\n7\r\n"
+                              "$1\r\n*\r\n$4\r\ndata\r\n$1\r\nx\r\n");
+}
+
+TEST_CASE("Sorted set upsert is two commands, trim is exclusive", "[resp]") {
+    RespEncoder encoder;
+    REQUIRE(encoder.append(PublishMessage{"Z", "bar", RedisCommand::SortedSetAdd, 1700000000000.0}) == 2);
+    REQUIRE(encoder.buffer() == "*4\r\n$16\r\nZREMRANGEBYSCORE\r\n$1\r\nZ\r\n$13\r\n1700000000000\r\n$13\r\n1700000000000\r\n"
+                                "*4\r\n$4\r\nZADD\r\n$1\r\nZ\r\n$13\r\n1700000000000\r\n$3\r\nbar\r\n");
+
+    encoder.clear();
+    REQUIRE(encoder.append(PublishMessage{"Z", "", RedisCommand::SortedSetTrim, 42.0}) == 1);
+    REQUIRE(encoder.buffer() == "*4\r\n$16\r\nZREMRANGEBYSCORE\r\n$1\r\nZ\r\n$4\r\n-inf\r\n$3\r\n(42\r\n");
+}
+
+TEST_CASE("HSET carries every field / value pair of the payload", "[resp]") {
+    RespEncoder encoder;
+    REQUIRE(encoder.append(PublishMessage{"H", "position\n100\nvalue\n-2.5", RedisCommand::HashSet}) == 1);
+    REQUIRE(encoder.buffer() == "*6\r\n$4\r\nHSET\r\n$1\r\nH\r\n$8\r\nposition\r\n$3\r\n100\r\n"
+                                "$5\r\nvalue\r\n$4\r\n-2.5\r\n");
+}
+
+TEST_CASE("TS.MADD carries every key / timestamp / value triple of the payload", "[resp]") {
+    RespEncoder encoder;
+    REQUIRE(encoder.append(PublishMessage{"", "A:bid\n1000\n1.5\nB:last\n2000\n7", RedisCommand::TimeSeriesAdd}) == 1);
+    REQUIRE(encoder.buffer() == "*7\r\n$7\r\nTS.MADD\r\n$5\r\nA:bid\r\n$4\r\n1000\r\n$3\r\n1.5\r\n"
+                                "$6\r\nB:last\r\n$4\r\n2000\r\n$1\r\n7\r\n");
+}
+
+TEST_CASE("LPUSH of every element is followed by one LTRIM", "[resp]") {
+    RespEncoder encoder;
+    REQUIRE(encoder.append(PublishMessage{"T", "{a}\n{b}", RedisCommand::ListPush, 500.0}) == 2);
+    REQUIRE(encoder.buffer() == "*4\r\n$5\r\nLPUSH\r\n$1\r\nT\r\n$3\r\n{a}\r\n$3\r\n{b}\r\n"
+                                "*4\r\n$5\r\nLTRIM\r\n$1\r\nT\r\n$1\r\n0\r\n$3\r\n499\r\n");
+}
+
+TEST_CASE("Replies are counted without parsing values", "[resp]") {
+    const std::string replies = ":3\r\n+OK\r\n$15\r\n1700000000000-0\r\n$-1\r\n*2\r\n:1\r\n$1\r\na\r\n";
+    const RespScan scan = scanRespReplies(replies.data(), replies.size(), 10);
+    REQUIRE(scan.replies == 5);
+    REQUIRE(scan.errors == 0);
+    REQUIRE(scan.consumed == replies.size());
+    REQUIRE_FALSE(scan.malformed);
+}
+
+TEST_CASE("Partial replies wait for the rest, errors are reported", "[resp]") {
+    const std::string replies = ":1\r\n-ERR wrong type\r\n$10\r\nabc";
+    RespScan scan = scanRespReplies(replies.data(), replies.size(), 10);
+    REQUIRE(scan.replies == 2);
+    REQUIRE(scan.errors == 1);
+    REQUIRE(scan.firstError == "ERR wrong type");
+    REQUIRE(scan.consumed == 21);
+
+    scan = scanRespReplies(replies.data(), replies.size(), 1);
+    REQUIRE(scan.replies == 1);
+    REQUIRE(scan.consumed == 4);
+
+    const std::string garbage = "hello\r\n";
+    REQUIRE(scanRespReplies(garbage.data(), garbage.size(), 1).malformed);
+}
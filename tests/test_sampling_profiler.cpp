@@ -0,0 +1,88 @@
+// test_sampling_profiler.cpp - Folded-stack format and a short profile of a busy thread
+
+#include <catch2/catch_test_macros.hpp>
+#include "ProfilerSignal.h"
+#include "SamplingProfiler.h"
+#include "ThreadAffinity.h"
+#include <unistd.h>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+namespace {
+
+// Kept out of line so the stack has a frame of its own
+__attribute__((noinline)) std::uint64_t spin(const std::atomic<bool>& running) {
+    std::uint64_t sum = 0;
+    while (running.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 1000; ++i) {
+            sum = sum * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+    }
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("Folded stacks are one line per stack with its count", "[profiler]") {
+    std::map<std::string, std::uint64_t> stacks{{"tws-worker-0;run;publish", 7}, {"tws-msg-0;processMessages", 3}};
+    REQUIRE(formatFoldedStacks(stacks) == "tws-msg-0;processMessages 3\ntws-worker-0;run;publish 7\n");
+    REQUIRE(formatFoldedStacks({}).empty());
+}
+
+TEST_CASE("A profile samples the profiled threads that burn CPU", "[profiler]") {
+    ProfilerConfig config;
+    config.enabled = true;
+    config.frequency = 500;
+    config.dir = "/tmp";
+    SamplingProfiler profiler("tcp://127.0.0.1:6379", config);
+    profiler.start();
+
+    std::atomic<bool> running{true};
+    std::thread busy([&running]() {
+        nameCurrentThread("tws-busy");
+        profileCurrentThread();
+        volatile std::uint64_t sink = spin(running);
+        (void)sink;
+    });
+    // NOTE: Burns as much CPU, but never enrolled - no timer, no SIGPROF
+    std::thread unprofiled([&running]() {
+        nameCurrentThread("tws-unprofiled");
+        volatile std::uint64_t sink = spin(running);
+        (void)sink;
+    });
+    while (profiledThreads().empty()) {
+        std::this_thread::yield();
+    }
+
+    std::string error;
+    REQUIRE(profiler.request(std::chrono::seconds(1), error));
+    REQUIRE_FALSE(profiler.request(std::chrono::seconds(1), error));
+    REQUIRE(error == "a profile is already running");
+    while (profiler.profiles() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    running.store(false);
+    busy.join();
+    unprofiled.join();
+    profiler.stop();
+
+    REQUIRE(profiler.samples() > 100);
+    REQUIRE(profiler.dropped() == 0);
+    const std::string path = profiler.lastProfile();
+    REQUIRE_FALSE(path.empty());
+    std::ifstream in(path);
+    std::stringstream folded;
+    folded << in.rdbuf();
+    REQUIRE(folded.str().find("tws-busy;") != std::string::npos);
+    REQUIRE(folded.str().find("tws-unprofiled;") == std::string::npos);
+    unlink(path.c_str());
+
+    SamplingProfiler second("tcp://127.0.0.1:6379", config);
+    REQUIRE_FALSE(second.request(std::chrono::seconds(1), error));
+    REQUIRE(error == "another profiler owns SIGPROF");
+}
@@ -3,6 +3,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Serialization.h"
 #include "MarketData.h"
+#include <memory>
+#include <vector>
 
 TEST_CASE("InstrumentState serialization", "[serialization]") {
     InstrumentState state;
@@ -21,6 +23,7 @@ TEST_CASE("InstrumentState serialization", "[serialization]") {
     state.hasTrade = true;
     state.exchange = "NASDAQ";
     state.pastLimit = false;
+    state.sequence = 42;
     
     SECTION("Serialize to JSON") {
         std::string json = serializeState(state);
@@ -30,6 +33,7 @@ TEST_CASE("InstrumentState serialization", "[serialization]") {
         REQUIRE(json.find("\"bid\":171.55") != std::string::npos);
         REQUIRE(json.find("\"ask\":171.57") != std::string::npos);
         REQUIRE(json.find("\"last\":171.56") != std::string::npos);
+        REQUIRE(json.find("\"seq\":42") != std::string::npos);
     }
 }
 
@@ -41,3 +45,161 @@ TEST_CASE("Empty InstrumentState", "[serialization]") {
     REQUIRE(!json.empty());
     REQUIRE(json.find("\"instrument\":\"TEST\"") != std::string::npos);
 }
+
+TEST_CASE("Reused JsonBuffer matches string serialization", "[serialization]") {
+    InstrumentState state;
+    state.symbol = "SPY";
+    state.bidPrice = 450.25;
+    
+    JsonBuffer out;
+    serializeState(state, out);
+    serializeState(state, out);  // Second call must clear, not append
+    
+    REQUIRE(out.str() == serializeState(state));
+}
+
+TEST_CASE("Historical series serialize as one array payload", "[serialization]") {
+    std::vector<TickUpdate> bars(2);
+    for (std::size_t i = 0; i < bars.size(); ++i) {
+        bars[i].type = TickUpdateType::Bar;
+        bars[i].flags = TickFlags::Historical;
+        bars[i].timestamp = 1700000000000 + static_cast<std::int64_t>(i) * 300000;
+        bars[i].bar.open = 100.0;
+        bars[i].bar.high = 101.0;
+        bars[i].bar.low = 99.5;
+        bars[i].bar.close = 100.5;
+        bars[i].bar.volume = 1000;
+        bars[i].bar.wap = 100.25;
+        bars[i].aux = 7;
+    }
+
+    JsonBuffer out;
+    serializeBarHistory("SPY", bars.data(), bars.size(), true, out);
+    const std::string bar0 = R"({"timestamp":1700000000000,"open":100.0,"high":101.0,"low":99.5,"close":100.5,"volume":1000,"wap":100.25,"barCount":7})";
+    const std::string bar1 = R"({"timestamp":1700000300000,"open":100.0,"high":101.0,"low":99.5,"close":100.5,"volume":1000,"wap":100.25,"barCount":7})";
+    REQUIRE(out.str() == R"({"symbol":"SPY","complete":true,"bars":[)" + bar0 + "," + bar1 + "]}");
+
+    serializeBarHistory("SPY", nullptr, 0, false, out);
+    REQUIRE(out.str() == R"({"symbol":"SPY","complete":false,"bars":[]})");
+}
+
+TEST_CASE("Bar store members are positional arrays", "[serialization]") {
+    TickUpdate bar;
+    bar.type = TickUpdateType::Bar;
+    bar.timestamp = 1700000000000;
+    bar.bar.open = 100.0;
+    bar.bar.high = 101.0;
+    bar.bar.low = 99.5;
+    bar.bar.close = 100.5;
+    bar.bar.volume = 1000;
+    bar.bar.wap = 100.25;
+    bar.aux = 7;
+
+    JsonBuffer out;
+    serializeBarCompact(bar, out);
+    REQUIRE(out.str() == "[1700000000000,100.0,101.0,99.5,100.5,1000,100.25,7]");
+}
+
+TEST_CASE("Bar size codes round-trip through TickUpdate flags", "[serialization]") {
+    using tws_bridge::BarSize;
+    REQUIRE(tws_bridge::barSizeFromTws("5 mins") == BarSize::Min5);
+    REQUIRE(tws_bridge::barSizeFromTws("1 min") == BarSize::Min1);
+    REQUIRE(tws_bridge::barSizeFromTws("1 secs") == BarSize::Sec1);
+    REQUIRE(tws_bridge::barSizeFromTws("1 sec") == BarSize::Sec1);
+    REQUIRE(tws_bridge::barSizeFromTws("1 day") == BarSize::Day1);
+    REQUIRE(tws_bridge::barSizeFromTws("7 mins") == BarSize::Unknown);
+    REQUIRE(tws_bridge::barSizeFromSeconds(5) == BarSize::Sec5);
+    REQUIRE(std::string(tws_bridge::barSizeLabel(BarSize::Hour1)) == "1h");
+    REQUIRE(tws_bridge::barSizeSeconds(BarSize::Min5) == 300);
+
+    TickUpdate bar;
+    bar.flags = TickFlags::Historical;
+    bar.setBarSize(BarSize::Month1);
+    REQUIRE(bar.barSize() == BarSize::Month1);
+    REQUIRE((bar.flags & TickFlags::Historical) != 0);
+    bar.setBarSize(BarSize::Sec5);
+    REQUIRE(bar.barSize() == BarSize::Sec5);
+
+    TickUpdate live;
+    live.flags = TickFlags::Live;
+    live.setBarSize(BarSize::Month1);
+    REQUIRE(live.barSize() == BarSize::Month1);
+    REQUIRE((live.flags & TickFlags::Live) != 0);
+    REQUIRE((live.flags & TickFlags::Historical) == 0);
+}
+
+TEST_CASE("Latency status lists every stage", "[serialization]") {
+    tws_bridge::LatencyReport report;
+    report.stages[static_cast<std::size_t>(tws_bridge::LatencyStage::Queue)] = {3, 1000, 2000, 2500, 2600};
+
+    JsonBuffer out;
+    serializeLatencyStatus(1, 1700000000000, 10000, report, out);
+    const std::string json = out.str();
+    REQUIRE(json.rfind("{\"type\":\"latency\",\"shard\":1,\"timestamp\":1700000000000,\"intervalMs\":10000,"
+                       "\"unit\":\"ns\",\"stages\":{\"ingest\":{\"count\":0,", 0) == 0);
+    REQUIRE(json.find("\"queue\":{\"count\":3,\"p50\":1000,\"p99\":2000,\"p999\":2500,\"max\":2600}")
+            != std::string::npos);
+    REQUIRE(json.find("\"endToEnd\":{") != std::string::npos);
+}
+
+TEST_CASE("Heartbeat status is one compact event", "[serialization][status]") {
+    tws_bridge::StatusSample current;
+    current.ticksIn = 1500;
+    current.dropped = 3;
+    current.queueAge = std::chrono::microseconds(2500);
+    current.queueDepth = 12;
+    current.redisRtt = std::chrono::microseconds(180);
+    current.twsConnected = 1;
+    current.twsConnections = 2;
+    current.subscriptions = 250;
+    const tws_bridge::StatusReport report = tws_bridge::makeStatusReport(tws_bridge::StatusSample{}, current, std::chrono::seconds(1));
+
+    JsonBuffer out;
+    serializeHeartbeatStatus(1700000000000, report, out);
+    REQUIRE(out.str() == "{\"type\":\"heartbeat\",\"timestamp\":1700000000000,\"intervalMs\":1000,"
+                         "\"rates\":{\"ingest\":1500,\"publish\":0,\"redis\":0},\"dropped\":3,\"conflated\":0,"
+                         "\"queueAgeMs\":2,\"queueDepth\":12,\"redisRttUs\":180,\"redisDown\":0,"
+                         "\"tws\":{\"connected\":1,\"total\":2},\"subscriptions\":250}");
+}
+
+TEST_CASE("Queue lag status carries both levels", "[serialization]") {
+    JsonBuffer out;
+    serializeLagStatus(2, 1700000000000, "critical", "warn", 1250, 40000, out);
+    REQUIRE(out.str() == "{\"type\":\"queue_lag\",\"shard\":2,\"timestamp\":1700000000000,\"level\":\"critical\","
+                         "\"previous\":\"warn\",\"ageMs\":1250,\"queueDepth\":40000}");
+}
+
+TEST_CASE("News carries extraData only when the provider sent it", "[serialization]") {
+    tws_bridge::NewsItem item;
+    item.symbol = "AAPL";
+    item.timestampMs = 1700000000000;
+    item.articleId = "BRFG$0b3c1a2d";
+    item.headline = "Apple \"beats\" estimates";
+    JsonBuffer out;
+    serializeNews(item, "BRFG", out);
+    REQUIRE(out.str() == "{\"type\":\"news\",\"instrument\":\"AAPL\",\"timestamp\":1700000000000,\"provider\":\"BRFG\","
+                         "\"articleId\":\"BRFG$0b3c1a2d\",\"headline\":\"Apple \\\"beats\\\" estimates\"}");
+
+    item.extraData = "K:0.85";
+    serializeNews(item, "BRFG", out);
+    REQUIRE(out.str().find(",\"extraData\":\"K:0.85\"}") != std::string::npos);
+}
+
+TEST_CASE("Session report lists non-empty histogram buckets", "[serialization]") {
+    auto report = std::make_unique<tws_bridge::SessionReport>();
+    report->session = 20376;
+    report->startMs = 1760518800000;
+    report->endMs = 1760605200000;
+    report->complete = true;
+    report->ticksIn = 42;
+    report->histograms[0].counts[tws_bridge::LatencySnapshot::bucketOf(10)] = 3;
+    JsonBuffer out;
+    serializeSessionReport(*report, out);
+    const std::string json = out.str();
+    REQUIRE(json.rfind("{\"type\":\"session_report\",\"session\":\"2025-10-15\",\"start\":1760518800000,", 0) == 0);
+    REQUIRE(json.find("\"totals\":{\"ticksIn\":42,") != std::string::npos);
+    REQUIRE(json.find("\"ingest\":{\"count\":3,\"p50\":10,\"p99\":10,\"p999\":10,\"max\":10,\"buckets\":[[10,3]]}")
+            != std::string::npos);
+    REQUIRE(json.find("\"twsReconnect\":{\"count\":0,\"p50\":0,\"p99\":0,\"p999\":0,\"max\":0,\"buckets\":[]}")
+            != std::string::npos);
+}
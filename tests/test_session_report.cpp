@@ -0,0 +1,96 @@
+// test_session_report.cpp - Session bookkeeping, report id and hash fields (SessionReport.h)
+
+#include <catch2/catch_test_macros.hpp>
+#include "SessionReport.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+constexpr std::int64_t kDayMs = 86400000;
+constexpr std::int64_t kResetMs = 9 * 3600000;             // 09:00 UTC
+constexpr std::int64_t kSession = 20376;                   // 2025-10-15
+constexpr std::int64_t kOpenMs = kSession * kDayMs + kResetMs;
+
+SessionSample sampleOf(std::uint64_t ticksIn, std::uint64_t dropped, std::uint64_t reconnects) {
+    SessionSample sample;
+    sample.status.ticksIn = ticksIn;
+    sample.status.dropped = dropped;
+    sample.twsReconnects = reconnects;
+    return sample;
+}
+
+const std::string* fieldOf(const std::vector<std::pair<std::string, std::string>>& fields, const std::string& name) {
+    const auto it = std::find_if(fields.begin(), fields.end(), [&name](const auto& field) { return field.first == name; });
+    return it == fields.end() ? nullptr : &it->second;
+}
+}
+
+TEST_CASE("Session date and report id", "[session-report]") {
+    REQUIRE(sessionDate(kSession) == "2025-10-15");
+    SessionReport report;
+    report.session = kSession;
+    report.complete = true;
+    REQUIRE(sessionReportId(report) == "2025-10-15");
+    report.complete = false;
+    report.startMs = kOpenMs + 4 * 3600000 + 20 * 60000 + 5000;  // 13:20:05
+    REQUIRE(sessionReportId(report) == "2025-10-15-132005");
+}
+
+TEST_CASE("Accumulator reports deltas and peaks of one session", "[session-report]") {
+    auto lifetime = std::make_unique<SessionHistograms>();
+    (*lifetime)[0].counts[LatencySnapshot::bucketOf(1000)] = 5;  // Before the run's first sample
+
+    SessionAccumulator accumulator;
+    accumulator.begin(kOpenMs + 3600000, kResetMs, sampleOf(100, 1, 0), *lifetime);
+    REQUIRE(accumulator.session() == kSession);
+    REQUIRE_FALSE(accumulator.rolled(kOpenMs + kDayMs - 1));
+    REQUIRE(accumulator.rolled(kOpenMs + kDayMs));
+
+    StatusReport busy;
+    busy.ticksInPerSecond = 50000.0;
+    busy.current.queueDepth = 700;
+    accumulator.observe(busy);
+    StatusReport quiet;
+    quiet.ticksInPerSecond = 10.0;
+    quiet.current.queueDepth = 3;
+    accumulator.observe(quiet);
+
+    (*lifetime)[0].counts[LatencySnapshot::bucketOf(1000)] = 8;
+    (*lifetime)[0].counts[LatencySnapshot::bucketOf(2000000)] = 1;
+    const SessionReport& report = accumulator.finish(kOpenMs + kDayMs, sampleOf(60100, 4, 2), *lifetime, true);
+    REQUIRE(report.ticksIn == 60000);
+    REQUIRE(report.dropped == 3);
+    REQUIRE(report.twsReconnects == 2);
+    REQUIRE(report.peakTicksIn == 50000.0);
+    REQUIRE(report.peakQueueDepth == 700);
+    REQUIRE(report.histograms[0].total() == 4);             // 3 at 1 us + 1 at 2 ms, not the 5 before the run
+    REQUIRE(report.histograms[0].max() >= 2000000);
+    REQUIRE_FALSE(report.complete);                          // Started mid-session
+
+    accumulator.next();
+    REQUIRE(accumulator.session() == kSession + 1);
+    const SessionReport& next = accumulator.finish(kOpenMs + 2 * kDayMs, sampleOf(60150, 4, 2), *lifetime, true);
+    REQUIRE(next.complete);
+    REQUIRE(next.ticksIn == 50);
+    REQUIRE(next.peakTicksIn == 0.0);                        // Peaks start over
+    REQUIRE(next.histograms[0].total() == 0);
+}
+
+TEST_CASE("Hash fields carry counts, peaks and percentiles", "[session-report]") {
+    SessionReport report;
+    report.session = kSession;
+    report.ticksIn = 1234;
+    report.peakSent = 999.7;
+    report.histograms[static_cast<std::size_t>(SessionHistogram::RedisRoundTrip)].counts[LatencySnapshot::bucketOf(40)] = 2;
+    const auto fields = sessionReportFields(report, "reports/session-2025-10-15.json");
+    REQUIRE(*fieldOf(fields, "ticks_in") == "1234");
+    REQUIRE(*fieldOf(fields, "peak_sent_per_second") == "999");
+    REQUIRE(*fieldOf(fields, "redisRtt_count") == "2");
+    REQUIRE(*fieldOf(fields, "redisRtt_p99_ns") == "40");
+    REQUIRE(*fieldOf(fields, "twsReconnect_max_ns") == "0");
+    REQUIRE(*fieldOf(fields, "file") == "reports/session-2025-10-15.json");
+    REQUIRE(fieldOf(sessionReportFields(report, ""), "file") == nullptr);
+}
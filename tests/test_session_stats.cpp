@@ -0,0 +1,69 @@
+// test_session_stats.cpp - Session open / high / low / previous close from trades, seed bars and rollover
+
+#include <catch2/catch_test_macros.hpp>
+#include "SessionStats.h"
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+constexpr std::int64_t kDayMs = 86400000;
+constexpr std::int64_t kResetMs = 9 * 3600000;  // 09:00 UTC
+
+} // namespace
+
+TEST_CASE("Trades build the session and roll it over", "[session_stats]") {
+    SessionStats stats;
+    const std::int64_t day = 20000;
+    stats.onTrade(sessionNumber(day * kDayMs + kResetMs + 1000, kResetMs), 100.0, 10);
+    stats.onTrade(day, 102.0, 5);
+    stats.onTrade(day, 99.0, 5);
+    stats.onTrade(day, 101.0, 1);
+    REQUIRE(stats.session == day);
+    REQUIRE(stats.open == 100.0);
+    REQUIRE(stats.high == 102.0);
+    REQUIRE(stats.low == 99.0);
+    REQUIRE(stats.last == 101.0);
+    REQUIRE(stats.volume == 21);
+    REQUIRE(stats.prevClose == 0.0);
+
+    stats.roll(day + 1);
+    REQUIRE(stats.prevClose == 101.0);
+    REQUIRE(stats.open == 0.0);
+    REQUIRE(stats.volume == 0);
+    stats.onTrade(day, 50.0, 1);  // NOTE: Late print of the previous session
+    REQUIRE(stats.open == 0.0);
+    stats.onTrade(day + 1, 103.0, 2);
+    REQUIRE(stats.open == 103.0);
+    REQUIRE(stats.prevClose == 101.0);
+}
+
+TEST_CASE("Daily bars seed the previous close and today's open", "[session_stats]") {
+    SessionStats stats;
+    const std::int64_t today = 20000;
+    stats.onTrade(today, 105.0, 100);
+    stats.seed(sessionOfDate((today - 3) * kDayMs), today, 90.0, 95.0, 89.0, 94.0, 1000);
+    stats.seed(sessionOfDate((today - 1) * kDayMs), today, 95.0, 99.0, 94.0, 98.0, 1000);
+    stats.seed(sessionOfDate(today * kDayMs), today, 99.5, 104.0, 99.0, 103.0, 5000);
+    REQUIRE(stats.seeded);
+    REQUIRE(stats.prevClose == 98.0);
+    REQUIRE(stats.open == 99.5);
+    REQUIRE(stats.high == 105.0);
+    REQUIRE(stats.low == 99.0);
+    REQUIRE(stats.last == 105.0);
+    REQUIRE(stats.volume == 5000);
+
+    std::string json;
+    stats.encode("\"AAPL\"", json);
+    REQUIRE(json.find("\"instrument\":\"AAPL\"") != std::string::npos);
+    REQUIRE(json.find("\"prev_close\":98,") != std::string::npos);
+    REQUIRE(json.find("\"seeded\":true}") != std::string::npos);
+}
+
+TEST_CASE("Rollover deadline is the next session start", "[session_stats]") {
+    const std::int64_t day = 20000;
+    REQUIRE(nextSessionStartMs(day * kDayMs + kResetMs - 1, kResetMs) == day * kDayMs + kResetMs);
+    REQUIRE(nextSessionStartMs(day * kDayMs + kResetMs, kResetMs) == (day + 1) * kDayMs + kResetMs);
+    REQUIRE(sessionOfDate(-1) == -1);
+}
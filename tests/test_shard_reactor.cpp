@@ -0,0 +1,73 @@
+// test_shard_reactor.cpp - Unit tests for the per-shard epoll loop (wake-ups, deadlines, registered fds)
+
+#include <catch2/catch_test_macros.hpp>
+#include "ShardReactor.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace tws_bridge;
+
+TEST_CASE("A wake from another thread ends the wait", "[reactor]") {
+    ShardReactor reactor;
+    REQUIRE(reactor.valid());
+    std::thread producer([&reactor]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        reactor.wake();
+    });
+    REQUIRE(reactor.wait(ShardReactor::Clock::time_point::max()) == 1);
+    producer.join();
+    REQUIRE(reactor.counters().wakes == 1);
+
+    // REASON: Wakes before the wait coalesce into one
+    reactor.wake();
+    reactor.wake();
+    REQUIRE(reactor.wait(ShardReactor::Clock::time_point::max()) == 1);
+    REQUIRE(reactor.counters().wakes == 2);
+}
+
+TEST_CASE("Deadlines fire when due, past ones at once", "[reactor]") {
+    ShardReactor reactor;
+    const auto start = ShardReactor::Clock::now();
+    reactor.wait(start + std::chrono::milliseconds(15));
+    REQUIRE(ShardReactor::Clock::now() - start >= std::chrono::milliseconds(15));
+    REQUIRE(reactor.counters().deadlines == 1);
+
+    reactor.wait(start);  // Already passed
+    REQUIRE(reactor.counters().deadlines == 2);
+
+    // NOTE: A later deadline re-arms the one-shot timer
+    const auto later = ShardReactor::Clock::now() + std::chrono::milliseconds(5);
+    reactor.wait(later);
+    REQUIRE(ShardReactor::Clock::now() >= later);
+    REQUIRE(reactor.counters().deadlines == 3);
+}
+
+TEST_CASE("Registered fds run their handler on the waiting thread", "[reactor]") {
+    ShardReactor reactor;
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    std::vector<char> received;
+    REQUIRE(reactor.add(fds[0], EPOLLIN, [&](std::uint32_t events) {
+        REQUIRE((events & EPOLLIN) != 0);
+        char c = 0;
+        REQUIRE(read(fds[0], &c, 1) == 1);
+        received.push_back(c);
+    }));
+    REQUIRE_FALSE(reactor.add(-1, EPOLLIN, [](std::uint32_t) {}));
+
+    REQUIRE(write(fds[1], "x", 1) == 1);
+    REQUIRE(reactor.wait(ShardReactor::Clock::time_point::max()) == 1);
+    REQUIRE(received == std::vector<char>{'x'});
+    REQUIRE(reactor.counters().events == 1);
+
+    reactor.remove(fds[0]);
+    REQUIRE(write(fds[1], "y", 1) == 1);
+    reactor.wait(ShardReactor::Clock::now() + std::chrono::milliseconds(5));  // Only the deadline ends it
+    REQUIRE(received.size() == 1);
+    close(fds[0]);
+    close(fds[1]);
+}
@@ -0,0 +1,203 @@
+// test_shard_rebalancer.cpp - Unit tests for hot-symbol detection and the router side of a slot move
+
+#include <catch2/catch_test_macros.hpp>
+#include "ShardRebalancer.h"
+#include "ShardRouter.h"
+
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+TickUpdate quote(SlotId slot, double bid) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.bidAsk.bidPrice = bid;
+    update.bidAsk.askPrice = bid + 0.01;
+    return update;
+}
+
+IngestConfig movable(OverflowPolicy policy = OverflowPolicy::DropNewest) {
+    IngestConfig ingest;
+    ingest.policy = policy;
+    ingest.slotCapacity = 16;
+    ingest.movableSlots = true;
+    return ingest;
+}
+
+std::vector<TickUpdate> drain(SpscShardRouter& router, std::size_t shard) {
+    std::vector<TickUpdate> out;
+    TickUpdate update;
+    while (router.shard(shard).queue.try_dequeue(update)) {
+        out.push_back(update);
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("Tick rates follow the counters with the configured half-life", "[rebalance]") {
+    RebalanceConfig config;
+    config.halfLife = std::chrono::seconds(1);
+    ShardRebalancer rebalancer(config, 4, 2);
+    std::vector<std::uint32_t> ticks(4, 0);
+    auto counter = [&ticks](SlotId slot) { return ticks[slot]; };
+
+    ticks[1] = 1000;
+    rebalancer.observe(counter, 4, 1.0);
+    REQUIRE(rebalancer.rate(1) == 500.0);  // One half-life: halfway from 0 to 1000/s
+    ticks[1] += 1000;
+    rebalancer.observe(counter, 4, 1.0);
+    REQUIRE(rebalancer.rate(1) == 750.0);
+    REQUIRE(rebalancer.rate(0) == 0.0);
+
+    // REASON: Counters wrap - the unsigned difference is still the tick count
+    ticks[2] = 0xFFFFFFF0u;
+    rebalancer.observe(counter, 4, 1.0);
+    ticks[2] += 32;
+    const double before = rebalancer.rate(2);
+    rebalancer.observe(counter, 4, 1.0);
+    REQUIRE(rebalancer.rate(2) == before + (32.0 - before) / 2);
+}
+
+TEST_CASE("Plan moves the slot that best halves the gap off the busiest shard", "[rebalance]") {
+    RebalanceConfig config;
+    config.halfLife = std::chrono::seconds(0);  // REASON: Rate = last interval's, exact loads
+    config.minRate = 10.0;
+    ShardRebalancer rebalancer(config, 8, 2);
+    // Shard 0 (even slots): 1000 + 300 + 5, shard 1 (odd slots): 400
+    std::vector<std::uint32_t> ticks = {1000, 400, 300, 0, 5, 0, 0, 0};
+    rebalancer.observe([&ticks](SlotId slot) { return ticks[slot]; }, 8, 1.0);
+    auto owner = [](SlotId slot) { return static_cast<std::size_t>(slot % 2); };
+
+    const auto move = rebalancer.plan(owner, 8);
+    REQUIRE(move);
+    REQUIRE(move->slot == 2);  // Gap 905: 300 takes 300 off, 1000 would only swap the sides
+    REQUIRE(move->from == 0);
+    REQUIRE(move->to == 1);
+    REQUIRE(move->rate == 300.0);
+    REQUIRE(rebalancer.load(0) == 1305.0);
+    REQUIRE(rebalancer.load(1) == 400.0);
+}
+
+TEST_CASE("Plan leaves balanced shards and lone hot symbols alone", "[rebalance]") {
+    RebalanceConfig config;
+    config.halfLife = std::chrono::seconds(0);
+    config.threshold = 1.5;
+    config.minRate = 10.0;
+    auto owner = [](SlotId slot) { return static_cast<std::size_t>(slot % 2); };
+    {
+        ShardRebalancer rebalancer(config, 4, 2);
+        std::vector<std::uint32_t> ticks = {400, 300, 300, 300};  // 700 vs 600: below 1.5 x mean
+        rebalancer.observe([&ticks](SlotId slot) { return ticks[slot]; }, 4, 1.0);
+        REQUIRE_FALSE(rebalancer.plan(owner, 4));
+    }
+    {
+        ShardRebalancer rebalancer(config, 4, 2);
+        std::vector<std::uint32_t> ticks = {1000, 0, 5, 0};  // Only the hot symbol itself is busy
+        rebalancer.observe([&ticks](SlotId slot) { return ticks[slot]; }, 4, 1.0);
+        REQUIRE_FALSE(rebalancer.plan(owner, 4));  // Moving either takes 5 ticks/s off the busier shard
+    }
+}
+
+TEST_CASE("Movable slots start on slot % shards and count their ticks", "[rebalance]") {
+    SpscShardRouter router(4, 64, WaitConfig{}, movable());
+    SpscIngestStage stage(router);
+    REQUIRE(router.movableSlots());
+    REQUIRE(router.shardFor(5) == 1);
+    REQUIRE(router.shardFor(12) == 0);
+    stage.stage(quote(5, 1.0));
+    stage.stage(quote(5, 1.1));
+    stage.flush();
+    REQUIRE(router.ticks(5) == 2);
+    REQUIRE(router.ticks(6) == 0);
+    REQUIRE(drain(router, 1).size() == 2);
+
+    SpscShardRouter fixed(4, 64);
+    REQUIRE_FALSE(fixed.movableSlots());
+    REQUIRE_FALSE(fixed.requestMigration(5, 2));
+}
+
+TEST_CASE("A move queues the marker behind the slot's last updates, then routes to the new shard", "[rebalance]") {
+    SpscShardRouter router(2, 64, WaitConfig{}, movable());
+    SpscIngestStage stage(router);
+    stage.stage(quote(3, 1.0));
+    stage.flush();
+
+    REQUIRE(router.requestMigration(3, 0));
+    REQUIRE_FALSE(router.requestMigration(5, 0));  // One move at a time
+    REQUIRE(router.shardFor(3) == 1);              // NOTE: Requested only - the producer flips at its next flush
+    stage.stage(quote(3, 1.1));
+    stage.flush();
+    REQUIRE(router.migration().phase.load() == MigrationPhase::Flipped);
+    REQUIRE(router.shardFor(3) == 0);
+
+    stage.stage(quote(3, 1.2));
+    stage.flush();
+    const std::vector<TickUpdate> old = drain(router, 1);
+    REQUIRE(old.size() == 3);
+    REQUIRE(old[0].bidAsk.bidPrice == 1.0);
+    REQUIRE(old[1].bidAsk.bidPrice == 1.1);
+    REQUIRE(old[2].type == TickUpdateType::Handoff);
+    REQUIRE(old[2].slot == 3);
+    REQUIRE(old[2].aux == router.migration().generation.load());
+    const std::vector<TickUpdate> moved = drain(router, 0);
+    REQUIRE(moved.size() == 1);
+    REQUIRE(moved[0].bidAsk.bidPrice == 1.2);
+}
+
+TEST_CASE("A full old shard delays the flip until the marker fits", "[rebalance]") {
+    SpscShardRouter router(2, 2, WaitConfig{}, movable());
+    SpscIngestStage stage(router);
+    stage.stage(quote(1, 1.0));
+    stage.stage(quote(1, 1.1));
+    stage.flush();
+
+    REQUIRE(router.requestMigration(1, 0));
+    stage.flush();
+    REQUIRE(router.migration().phase.load() == MigrationPhase::Requested);
+    REQUIRE(router.shardFor(1) == 1);
+
+    REQUIRE(drain(router, 1).size() == 2);
+    stage.flush();
+    REQUIRE(router.migration().phase.load() == MigrationPhase::Flipped);
+    REQUIRE(router.shardFor(1) == 0);
+    REQUIRE(router.shard(1).overflow.dropped.load() == 0);  // NOTE: A delayed marker is not a dropped update
+}
+
+TEST_CASE("Spilling shards carry the marker on the spill queue", "[rebalance]") {
+    SpscShardRouter router(2, 2, WaitConfig{}, movable(OverflowPolicy::Spill));
+    SpscIngestStage stage(router);
+    stage.stage(quote(1, 1.0));
+    stage.stage(quote(1, 1.1));
+    stage.stage(quote(1, 1.2));  // Queue full: spilled
+    stage.flush();
+    REQUIRE(router.requestMigration(1, 0));
+    stage.flush();
+    REQUIRE(router.migration().phase.load() == MigrationPhase::Flipped);
+
+    TickUpdate spilled[4];
+    REQUIRE(router.shard(1).spill->try_dequeue_bulk(spilled, 4) == 2);
+    REQUIRE(spilled[0].bidAsk.bidPrice == 1.2);
+    REQUIRE(spilled[1].type == TickUpdateType::Handoff);
+}
+
+TEST_CASE("Movable slots keep their coalescing key on every shard", "[rebalance]") {
+    SpscShardRouter router(2, 2, WaitConfig{}, movable(OverflowPolicy::ConflateLatest));
+    SpscIngestStage stage(router);
+    stage.stage(quote(3, 1.0));
+    stage.stage(quote(3, 1.1));
+    stage.stage(quote(3, 1.2));  // Queue full: conflated under the slot's own key
+    stage.stage(quote(3, 1.3));
+    stage.flush();
+
+    CoalescingTable& table = *router.shard(1).coalescing;
+    REQUIRE(table.keys() == 16 * 2);
+    TickUpdate update;
+    REQUIRE_FALSE(table.take(slotCoalescingKey(3, TickUpdateType::AllLast), update));
+    REQUIRE(table.take(slotCoalescingKey(3, TickUpdateType::BidAsk), update));
+    REQUIRE(update.bidAsk.bidPrice == 1.3);
+    REQUIRE_FALSE(table.hasPending());
+}
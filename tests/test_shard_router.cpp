@@ -0,0 +1,296 @@
+// test_shard_router.cpp - Unit tests for slot-based shard routing
+
+#include <catch2/catch_test_macros.hpp>
+#include "ShardRouter.h"
+#include <vector>
+
+using namespace tws_bridge;
+
+static TickUpdate makeUpdate(SlotId slot, std::int64_t timestamp) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.timestamp = timestamp;
+    return update;
+}
+
+TEST_CASE("Updates land on the shard owning their slot", "[shard]") {
+    ShardRouter router(4, 64);
+    REQUIRE(router.shardCount() == 4);
+    
+    for (SlotId slot = 0; slot < 8; ++slot) {
+        REQUIRE(router.try_enqueue(makeUpdate(slot, slot)));
+    }
+    
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        TickUpdate update;
+        std::size_t received = 0;
+        while (router.shard(i).queue.try_dequeue(update)) {
+            REQUIRE(router.shardFor(update.slot) == i);
+            ++received;
+        }
+        REQUIRE(received == 2);
+    }
+}
+
+TEST_CASE("Per-symbol ordering is preserved within a shard", "[shard]") {
+    ShardRouter router(3, 256);
+    
+    for (std::int64_t t = 0; t < 100; ++t) {
+        REQUIRE(router.try_enqueue(makeUpdate(static_cast<SlotId>(t % 5), t)));
+    }
+    
+    std::vector<std::int64_t> lastSeen(5, -1);
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        TickUpdate update;
+        while (router.shard(i).queue.try_dequeue(update)) {
+            REQUIRE(update.timestamp > lastSeen[update.slot]);
+            lastSeen[update.slot] = update.timestamp;
+        }
+    }
+}
+
+TEST_CASE("Zero shard count falls back to a single shard", "[shard]") {
+    ShardRouter router(0, 16);
+    REQUIRE(router.shardCount() == 1);
+    REQUIRE(router.shardFor(1234) == 0);
+}
+
+TEST_CASE("SPSC shards route the same way and reject when full", "[shard]") {
+    SpscShardRouter router(2, 2);
+    REQUIRE(router.try_enqueue(makeUpdate(0, 1)));
+    REQUIRE(router.try_enqueue(makeUpdate(2, 2)));
+    REQUIRE_FALSE(router.try_enqueue(makeUpdate(4, 3)));  // Shard 0 full
+    REQUIRE(router.try_enqueue(makeUpdate(1, 4)));        // Shard 1 unaffected
+    
+    TickUpdate update;
+    REQUIRE(router.shard(0).queue.try_dequeue(update));
+    REQUIRE(update.timestamp == 1);
+}
+
+TEST_CASE("DropNewest rejects and counts when the shard is full", "[shard][overflow]") {
+    SpscShardRouter router(1, 2);
+    REQUIRE(router.try_enqueue(makeUpdate(0, 1)));
+    REQUIRE(router.try_enqueue(makeUpdate(0, 2)));
+    REQUIRE_FALSE(router.try_enqueue(makeUpdate(0, 3)));
+    REQUIRE(router.shard(0).overflow.dropped.load() == 1);
+    REQUIRE_FALSE(router.shard(0).hasOverflow());
+}
+
+TEST_CASE("ConflateLatest keeps the newest update per symbol once full", "[shard][overflow]") {
+    IngestConfig overflow;
+    overflow.policy = OverflowPolicy::ConflateLatest;
+    overflow.slotCapacity = 16;
+    SpscShardRouter router(2, 2, WaitConfig{}, overflow);
+    auto& shard = router.shard(0);
+    
+    REQUIRE(router.try_enqueue(makeUpdate(0, 1)));
+    REQUIRE(router.try_enqueue(makeUpdate(2, 2)));
+    for (std::int64_t t = 3; t <= 10; ++t) {
+        REQUIRE(router.try_enqueue(makeUpdate(4, t)));  // Queue full: coalesced in place
+    }
+    REQUIRE(shard.overflow.conflated.load() == 8);
+    REQUIRE(shard.hasOverflow());
+    
+    TickUpdate update;
+    REQUIRE(shard.queue.try_dequeue(update));
+    // PITFALL: Slot 4 still pending, so it must not overtake through the freed queue slot
+    REQUIRE(router.try_enqueue(makeUpdate(4, 11)));
+    REQUIRE(shard.queue.size_approx() == 1);
+    
+    std::vector<TickUpdate> out(4);
+    REQUIRE(shard.coalescing->drain(out.data(), out.size()) == 1);
+    REQUIRE(out[0].slot == 4);
+    REQUIRE(out[0].timestamp == 11);
+    
+    // Bars are never coalesced
+    TickUpdate bar = makeUpdate(6, 12);
+    bar.type = TickUpdateType::Bar;
+    REQUIRE(router.try_enqueue(bar));          // Room left by the dequeue above
+    REQUIRE_FALSE(router.try_enqueue(bar));
+    REQUIRE(shard.overflow.dropped.load() == 1);
+}
+
+TEST_CASE("Spill keeps every update in order across both queues", "[shard][overflow]") {
+    IngestConfig overflow;
+    overflow.policy = OverflowPolicy::Spill;
+    SpscShardRouter router(1, 4, WaitConfig{}, overflow);
+    auto& shard = router.shard(0);
+    
+    for (std::int64_t t = 0; t < 20; ++t) {
+        REQUIRE(router.try_enqueue(makeUpdate(1, t)));
+    }
+    REQUIRE(shard.overflow.spilled.load() == 16);
+    
+    TickUpdate update;
+    REQUIRE(shard.queue.try_dequeue(update));
+    REQUIRE(router.try_enqueue(makeUpdate(1, 20)));  // Still spilling: spill queue not empty
+    REQUIRE(shard.queue.size_approx() == 3);
+    
+    std::int64_t expected = 1;
+    while (shard.queue.try_dequeue(update)) {
+        REQUIRE(update.timestamp == expected++);
+    }
+    while (shard.spill->try_dequeue(update)) {
+        REQUIRE(update.timestamp == expected++);
+    }
+    REQUIRE(expected == 21);
+}
+
+TEST_CASE("Spill stops growing at its byte budget", "[shard][overflow][memory]") {
+    IngestConfig overflow;
+    overflow.policy = OverflowPolicy::Spill;
+    overflow.spillBudget = 3 * sizeof(TickUpdate);
+    SpscShardRouter router(1, 4, WaitConfig{}, overflow);
+    auto& shard = router.shard(0);
+
+    for (std::int64_t t = 0; t < 7; ++t) {
+        REQUIRE(router.try_enqueue(makeUpdate(1, t)));
+    }
+    REQUIRE(shard.spillBytes() == 3 * sizeof(TickUpdate));
+    REQUIRE_FALSE(router.try_enqueue(makeUpdate(1, 7)));  // BACKPRESSURE: Newest refused, spilled ones kept
+    REQUIRE(shard.overflow.spillOverBudget.load() == 1);
+    REQUIRE(shard.overflow.dropped.load() == 1);
+    REQUIRE(shard.overflow.spilled.load() == 3);
+}
+
+TEST_CASE("Midpoints coalesce in the quote lane, trades in their own", "[shard][coalesce]") {
+    REQUIRE(slotCoalescingKey(7, TickUpdateType::MidPoint) == slotCoalescingKey(7, TickUpdateType::BidAsk));
+    REQUIRE(slotCoalescingKey(7, TickUpdateType::AllLast) != slotCoalescingKey(7, TickUpdateType::BidAsk));
+    REQUIRE(isCoalescable(TickUpdateType::MidPoint));
+}
+
+TEST_CASE("Coalesce mode bypasses the queue for ticks, not for bars", "[shard][coalesce]") {
+    IngestConfig ingest;
+    ingest.mode = IngestMode::Coalesce;
+    ingest.slotCapacity = 8;
+    ShardRouter router(2, 4, WaitConfig{}, ingest);
+    auto& shard = router.shard(1);
+    
+    for (std::int64_t t = 0; t < 100; ++t) {
+        REQUIRE(router.try_enqueue(makeUpdate(3, t)));
+        REQUIRE(router.try_enqueue(makeUpdate(5, t)));
+    }
+    TickUpdate bar = makeUpdate(3, 100);
+    bar.type = TickUpdateType::Bar;
+    REQUIRE(router.try_enqueue(bar));
+    
+    REQUIRE(shard.queue.size_approx() == 1);  // Only the bar
+    REQUIRE(shard.overflow.superseded.load() == 198);
+    REQUIRE(shard.overflow.conflated.load() == 0);
+    
+    std::vector<TickUpdate> out(8);
+    REQUIRE(shard.coalescing->drain(out.data(), out.size()) == 2);
+    REQUIRE(out[0].slot == 3);
+    REQUIRE(out[0].timestamp == 99);
+    REQUIRE(out[1].slot == 5);
+    REQUIRE(out[1].timestamp == 99);
+    REQUIRE_FALSE(shard.hasOverflow());
+}
+
+TEST_CASE("Staged updates reach their shard only on flush, in order", "[shard][stage]") {
+    ShardRouter router(2, 256);
+    IngestStage stage(router);
+    
+    for (std::int64_t t = 0; t < 10; ++t) {
+        stage.stage(makeUpdate(static_cast<SlotId>(t % 4), t));
+    }
+    REQUIRE(router.shard(0).queue.size_approx() == 0);
+    REQUIRE(router.shard(1).queue.size_approx() == 0);
+    REQUIRE(stage.flush() == 0);
+    REQUIRE(stage.empty());
+    
+    std::vector<std::int64_t> lastSeen(4, -1);
+    std::size_t received = 0;
+    for (std::size_t i = 0; i < router.shardCount(); ++i) {
+        TickUpdate update;
+        while (router.shard(i).queue.try_dequeue(update)) {
+            REQUIRE(router.shardFor(update.slot) == i);
+            REQUIRE(update.timestamp > lastSeen[update.slot]);
+            lastSeen[update.slot] = update.timestamp;
+            ++received;
+        }
+    }
+    REQUIRE(received == 10);
+}
+
+TEST_CASE("A full stage buffer is flushed without waiting for the cycle", "[shard][stage]") {
+    SpscShardRouter router(1, 256);
+    SpscIngestStage stage(router);
+    for (std::size_t i = 0; i < SpscIngestStage::kCapacity + 3; ++i) {
+        stage.stage(makeUpdate(0, static_cast<std::int64_t>(i)));
+    }
+    REQUIRE(router.shard(0).queue.size_approx() == SpscIngestStage::kCapacity);
+    stage.flush();
+    REQUIRE(router.shard(0).queue.size_approx() == SpscIngestStage::kCapacity + 3);
+}
+
+TEST_CASE("A staged burst that does not fit keeps the overflow policy per update", "[shard][stage][overflow]") {
+    SECTION("DropNewest enqueues what fits and drops the rest") {
+        SpscShardRouter router(1, 4);
+        SpscIngestStage stage(router);
+        for (std::int64_t t = 0; t < 6; ++t) {
+            stage.stage(makeUpdate(0, t));
+        }
+        REQUIRE(stage.flush() == 2);
+        REQUIRE(router.shard(0).queue.size_approx() == 4);
+        REQUIRE(router.shard(0).overflow.dropped.load() == 2);
+        
+        TickUpdate update;
+        REQUIRE(router.shard(0).queue.try_dequeue(update));
+        REQUIRE(update.timestamp == 0);  // Oldest kept, newest dropped
+    }
+    SECTION("ConflateLatest coalesces the overflow") {
+        IngestConfig overflow;
+        overflow.policy = OverflowPolicy::ConflateLatest;
+        overflow.slotCapacity = 16;
+        SpscShardRouter router(1, 2, WaitConfig{}, overflow);
+        SpscIngestStage stage(router);
+        for (std::int64_t t = 0; t < 5; ++t) {
+            stage.stage(makeUpdate(1, t));
+        }
+        REQUIRE(stage.flush() == 0);
+        REQUIRE(router.shard(0).queue.size_approx() == 2);
+        REQUIRE(router.shard(0).overflow.conflated.load() == 3);
+        REQUIRE(router.shard(0).hasOverflow());
+    }
+}
+
+TEST_CASE("PrioritizeTrades keeps trades on their own lane and conflates quotes", "[shard][overflow]") {
+    IngestConfig overflow;
+    overflow.policy = OverflowPolicy::PrioritizeTrades;
+    overflow.slotCapacity = 16;
+    SpscShardRouter router(1, 4, WaitConfig{}, overflow);
+    auto& shard = router.shard(0);
+
+    for (std::int64_t t = 0; t < 10; ++t) {
+        REQUIRE(router.try_enqueue(makeUpdate(1, t)));  // Quotes: 4 queued, the rest coalesced
+        if (t < 4) {
+            TickUpdate trade = makeUpdate(1, 100 + t);
+            trade.type = TickUpdateType::AllLast;
+            REQUIRE(router.try_enqueue(trade));         // Trades: own lane, never conflated
+        }
+    }
+    REQUIRE(shard.queue.size_approx() == 4);
+    REQUIRE(shard.overflow.conflated.load() == 6);
+    REQUIRE(shard.overflow.dropped.load() == 0);
+    REQUIRE(shard.hasOverflow());
+
+    // Only a full trade lane loses a trade
+    TickUpdate late = makeUpdate(1, 104);
+    late.type = TickUpdateType::AllLast;
+    REQUIRE_FALSE(router.try_enqueue(late));
+    REQUIRE(shard.overflow.tradesDropped.load() == 1);
+
+    TickUpdate update;
+    std::int64_t expected = 100;
+    while (shard.trades->try_dequeue(update)) {
+        REQUIRE(update.type == TickUpdateType::AllLast);
+        REQUIRE(update.timestamp == expected++);
+    }
+    REQUIRE(expected == 104);
+
+    std::vector<TickUpdate> out(4);
+    REQUIRE(shard.coalescing->drain(out.data(), out.size()) == 1);
+    REQUIRE(out[0].timestamp == 9);  // Latest quote
+}
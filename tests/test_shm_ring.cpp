@@ -0,0 +1,104 @@
+// test_shm_ring.cpp - Unit tests for the shared-memory snapshot ring (writer + reader library)
+
+#include <catch2/catch_test_macros.hpp>
+#include "ShmRing.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string ringName(const char* test) {
+    return "/tws-bridge-test-" + std::string(test) + "-" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST_CASE("Reader sees records written after it attached", "[shm]") {
+    const std::string name = ringName("basic");
+    auto writer = ShmRingWriter::create(name, 8, 64);
+    REQUIRE(writer);
+    REQUIRE(writer->write("TWS:TICKS:AAPL", "{\"bid\":1}"));
+
+    auto reader = ShmRingReader::open(name);
+    REQUIRE(reader);
+    ShmRecord record;
+    REQUIRE(reader->read(record) == ShmReadStatus::Empty);  // Starts at the next new record
+
+    REQUIRE(writer->write("TWS:TICKS:MSFT", "{\"bid\":2}"));
+    REQUIRE(reader->read(record) == ShmReadStatus::Ok);
+    REQUIRE(record.channel == "TWS:TICKS:MSFT");
+    REQUIRE(record.payload == "{\"bid\":2}");
+    REQUIRE(record.sequence == 1);
+    REQUIRE(reader->read(record) == ShmReadStatus::Empty);
+
+    auto replay = ShmRingReader::open(name, true);
+    REQUIRE(replay->read(record) == ShmReadStatus::Ok);
+    REQUIRE(record.channel == "TWS:TICKS:AAPL");
+}
+
+TEST_CASE("Lapped reader skips to the oldest surviving record", "[shm]") {
+    const std::string name = ringName("lap");
+    auto writer = ShmRingWriter::create(name, 4, 32);
+    auto reader = ShmRingReader::open(name);
+    REQUIRE(reader);
+    for (int i = 0; i < 10; ++i) {
+        writer->write("C", std::to_string(i));
+    }
+    ShmRecord record;
+    REQUIRE(reader->read(record) == ShmReadStatus::Ok);
+    REQUIRE(record.payload == "6");
+    REQUIRE(reader->lost() == 6);
+}
+
+TEST_CASE("Oversized records are skipped and counted", "[shm]") {
+    const std::string name = ringName("big");
+    auto writer = ShmRingWriter::create(name, 4, 16);
+    REQUIRE_FALSE(writer->write("TWS:TICKS:AAPL", "0123456789"));
+    REQUIRE(writer->oversized() == 1);
+    REQUIRE(writer->published() == 0);
+}
+
+TEST_CASE("Missing ring cannot be opened", "[shm]") {
+    REQUIRE_FALSE(ShmRingReader::open(ringName("absent")));
+}
+
+TEST_CASE("Concurrent reader never sees a torn record", "[shm]") {
+    const std::string name = ringName("race");
+    auto writer = ShmRingWriter::create(name, 16, 64);
+    auto reader = ShmRingReader::open(name);
+    REQUIRE(reader);
+    constexpr int kRecords = 200000;
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        std::string payload;
+        for (int i = 0; i < kRecords; ++i) {
+            payload.assign(static_cast<std::size_t>(i % 40), static_cast<char>('a' + i % 26));
+            writer->write(std::to_string(i), payload);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    std::uint64_t seen = 0;
+    bool consistent = true;
+    ShmRecord record;
+    for (;;) {
+        const bool finished = done.load(std::memory_order_acquire);
+        while (reader->read(record) == ShmReadStatus::Ok) {
+            const int i = std::stoi(std::string(record.channel));
+            consistent = consistent && record.sequence == static_cast<std::uint64_t>(i)
+                         && record.payload == std::string(static_cast<std::size_t>(i % 40), static_cast<char>('a' + i % 26));
+            ++seen;
+        }
+        if (finished) {
+            break;
+        }
+    }
+    producer.join();
+    REQUIRE(consistent);
+    REQUIRE(seen + reader->lost() == kRecords);
+}
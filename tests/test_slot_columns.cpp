@@ -0,0 +1,92 @@
+// test_slot_columns.cpp - Unit tests for the per-slot columns and the vectorized changed-slot sweep
+
+#include <catch2/catch_test_macros.hpp>
+#include "SlotColumns.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace tws_bridge;
+
+static std::vector<std::size_t> sweep(const SlotColumn& current, SlotColumn& seen, std::size_t slots) {
+    std::vector<std::size_t> changed;
+    forEachChanged(current, seen, slots, [&](std::size_t slot) { changed.push_back(slot); });
+    return changed;
+}
+
+TEST_CASE("Columns are zeroed and padded to whole blocks", "[columns]") {
+    SlotColumn column(100);
+    REQUIRE(column.size() == 128);
+    for (std::size_t slot = 0; slot < column.size(); ++slot) {
+        REQUIRE(column[slot] == 0);
+    }
+    REQUIRE(SlotColumn(128).size() == 128);
+    REQUIRE(SlotColumn(0).size() == 0);
+}
+
+TEST_CASE("Changed mask has one bit per differing slot of a block", "[columns]") {
+    SlotColumn current(64);
+    SlotColumn seen(64);
+    REQUIRE(changedMask(current.data(), seen.data()) == 0);
+    // Lane edges of both vector widths and the last bit
+    for (std::size_t slot : {0u, 3u, 4u, 7u, 8u, 31u, 32u, 63u}) {
+        current[slot] = 1;
+    }
+    const std::uint64_t expected = (1ull << 0) | (1ull << 3) | (1ull << 4) | (1ull << 7) | (1ull << 8)
+                                 | (1ull << 31) | (1ull << 32) | (1ull << 63);
+    REQUIRE(changedMask(current.data(), seen.data()) == expected);
+}
+
+TEST_CASE("Sweep reports changed slots in order and catches up", "[columns]") {
+    SlotColumn current(300);
+    SlotColumn seen(300);
+    ++current[5];
+    ++current[64];
+    ++current[64];
+    ++current[250];
+    REQUIRE(sweep(current, seen, 300) == std::vector<std::size_t>{5, 64, 250});
+    REQUIRE(sweep(current, seen, 300).empty());  // Nothing new since the last sweep
+
+    ++current[64];
+    REQUIRE(sweep(current, seen, 300) == std::vector<std::size_t>{64});
+}
+
+TEST_CASE("Sweep stops at the slot limit and leaves later slots pending", "[columns]") {
+    SlotColumn current(256);
+    SlotColumn seen(256);
+    ++current[10];
+    ++current[70];
+    ++current[200];
+    REQUIRE(sweep(current, seen, 71) == std::vector<std::size_t>{10, 70});
+    // REASON: Slots registered after the first sweep are still delivered by the next one
+    REQUIRE(sweep(current, seen, 256) == std::vector<std::size_t>{200});
+}
+
+TEST_CASE("Assign marks every slot as seen", "[columns]") {
+    SlotColumn current(128);
+    SlotColumn seen(128);
+    ++current[1];
+    ++current[127];
+    seen.assign(current);
+    REQUIRE(sweep(current, seen, 128).empty());
+}
+
+TEST_CASE("Sweep matches a scalar compare on random columns", "[columns]") {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, 4999);
+    SlotColumn current(5000);
+    SlotColumn seen(5000);
+    for (int round = 0; round < 20; ++round) {
+        std::vector<std::uint32_t> before(seen.data(), seen.data() + seen.size());
+        for (int i = 0; i < 300; ++i) {
+            ++current[pick(rng)];
+        }
+        std::vector<std::size_t> expected;
+        for (std::size_t slot = 0; slot < 5000; ++slot) {
+            if (current[slot] != before[slot]) {
+                expected.push_back(slot);
+            }
+        }
+        REQUIRE(sweep(current, seen, 5000) == expected);
+    }
+}
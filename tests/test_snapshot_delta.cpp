@@ -0,0 +1,121 @@
+// test_snapshot_delta.cpp - Delta snapshots: baseline, keyframe schedule, JSON / binary delta encoding
+
+#include <catch2/catch_test_macros.hpp>
+#include "BinaryEncoder.h"
+#include "SnapshotDelta.h"
+#include "SnapshotEncoder.h"
+#include "MarketData.h"
+#include <cstring>
+
+using namespace tws_bridge;
+
+static InstrumentState makeState() {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.lastSize = 50;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000400;
+    state.exchange = "NASDAQ";
+    return state;
+}
+
+template <typename T>
+static T loadLE(const std::string& msg, std::size_t offset) {
+    std::uint64_t bits = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(msg[offset + i])) << (8 * i);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+}
+
+TEST_CASE("Delta track schedules keyframes by count and event time", "[delta]") {
+    DeltaConfig config;
+    config.keyframeEvery = 3;
+    config.keyframeInterval = std::chrono::seconds(5);
+    InstrumentState state = makeState();
+    DeltaTrack track;
+
+    REQUIRE(track.keyframeDue(state, config));  // First message
+    track.sent(state, true);
+    for (int delta = 0; delta < 3; ++delta) {
+        REQUIRE_FALSE(track.keyframeDue(state, config));
+        track.sent(state, false);
+    }
+    REQUIRE(track.keyframeDue(state, config));  // keyframeEvery deltas sent
+    track.sent(state, true);
+
+    state.tradeTimestamp += 4999;
+    REQUIRE_FALSE(track.keyframeDue(state, config));
+    state.tradeTimestamp += 1;
+    REQUIRE(track.keyframeDue(state, config));  // 5 s of event time
+
+    track.sent(state, true);
+    track.resync();
+    REQUIRE(track.keyframeDue(state, config));
+}
+
+TEST_CASE("Delta baseline reports changed fields only", "[delta]") {
+    InstrumentState state = makeState();
+    DeltaBaseline baseline;
+    baseline.capture(state);
+    REQUIRE(baseline.changes(state, true) == 0);
+
+    state.bidPrice = 171.56;
+    state.bidSize = 300;
+    state.quoteTimestamp += 100;
+    REQUIRE(baseline.changes(state, false) == (DeltaField::BidPrice | DeltaField::BidSize | DeltaField::QuoteTime));
+
+    state.derived.onQuote(state.bidPrice, state.askPrice);
+    REQUIRE((baseline.changes(state, true) & DeltaField::Derived) != 0);
+    REQUIRE((baseline.changes(state, false) & DeltaField::Derived) == 0);
+}
+
+TEST_CASE("JSON delta carries sequence and changed members", "[delta]") {
+    InstrumentState state = makeState();
+    JsonBuffer out;
+
+    state.sequence = 7;
+    const std::uint16_t quote = DeltaField::BidPrice | DeltaField::BidSize | DeltaField::QuoteTime;
+    encodeSnapshotDelta(state, quote, out);
+    REQUIRE(out.str() == R"({"instrument":"AAPL","seq":7,"delta":true,"timestamp":1700000000400,)"
+                         R"("price":{"bid":171.55},"size":{"bid":100},"timestamps":{"quote":1700000000000}})");
+
+    const std::uint16_t trade = DeltaField::LastPrice | DeltaField::AskPrice | DeltaField::Exchange
+                              | DeltaField::Conditions | DeltaField::PastLimit;
+    state.sequence = 8;
+    encodeSnapshotDelta(state, trade, out, SnapshotSchema::Compact);
+    REQUIRE(out.str() == R"({"sym":"AAPL","sq":8,"dl":true,"ts":1700000000400,"p":{"a":171.57,"l":171.56},)"
+                         R"("ex":"NASDAQ","cnd":"","attr":{"pl":false}})");
+
+    state.sequence = 9;
+    encodeSnapshotDelta(state, 0, out);
+    REQUIRE(out.str() == R"({"instrument":"AAPL","seq":9,"delta":true,"timestamp":1700000000400})");
+}
+
+TEST_CASE("Binary delta layout", "[delta][binary]") {
+    InstrumentState state = makeState();
+    state.sequence = 42;
+    std::string msg;
+    const std::uint16_t changed = DeltaField::AskPrice | DeltaField::AskSize | DeltaField::Exchange;
+    encodeSnapshotBinaryDelta(state, changed, msg);
+
+    REQUIRE(msg.size() == binary_wire::kHeaderSize + binary_wire::kDeltaFixedSize + 8 + 4 + 1 + 6 + 4);
+    REQUIRE(loadLE<std::uint8_t>(msg, 1) == static_cast<std::uint8_t>(binary_wire::Kind::Delta));
+    REQUIRE(loadLE<std::int32_t>(msg, 4) == 265598);
+    REQUIRE(loadLE<std::uint64_t>(msg, 8) == 42);
+    REQUIRE(loadLE<std::uint16_t>(msg, 16) == changed);
+    REQUIRE(loadLE<std::int64_t>(msg, 18) == 1700000000400);
+    REQUIRE(loadLE<double>(msg, 26) == 171.57);
+    REQUIRE(loadLE<std::int32_t>(msg, 34) == 200);
+    REQUIRE(loadLE<std::uint8_t>(msg, 38) == 6);
+    REQUIRE(msg.substr(39, 6) == "NASDAQ");
+    REQUIRE(msg.substr(45) == "AAPL");
+}
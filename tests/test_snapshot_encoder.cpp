@@ -0,0 +1,326 @@
+// test_snapshot_encoder.cpp - Fixed-schema encoder vs RapidJSON reference
+
+#include <catch2/catch_test_macros.hpp>
+#include "SnapshotEncoder.h"
+#include "Serialization.h"
+#include "MarketData.h"
+
+static std::string formatDouble(double value) {
+    char buffer[64];
+    char* end = snapshot_detail::writeDouble(buffer, value);
+    return std::string(buffer, end);
+}
+
+TEST_CASE("Double formatting matches RapidJSON Writer", "[encoder]") {
+    // Expected strings follow RapidJSON's dtoa/Prettify rules
+    REQUIRE(formatDouble(0.0) == "0.0");
+    REQUIRE(formatDouble(-0.0) == "-0.0");
+    REQUIRE(formatDouble(1.0) == "1.0");
+    REQUIRE(formatDouble(171.55) == "171.55");
+    REQUIRE(formatDouble(1234567.8) == "1234567.8");
+    REQUIRE(formatDouble(-79.39773355813419) == "-79.39773355813419");
+    REQUIRE(formatDouble(0.000001) == "0.000001");
+    REQUIRE(formatDouble(0.0000001) == "1e-7");
+    REQUIRE(formatDouble(1e21) == "1e21");
+    REQUIRE(formatDouble(1e20) == "100000000000000000000.0");
+    REQUIRE(formatDouble(1.234567890123456e30) == "1.234567890123456e30");
+    REQUIRE(formatDouble(1.7976931348623157e308) == "1.7976931348623157e308");
+    REQUIRE(formatDouble(5e-324) == "5e-324");
+}
+
+TEST_CASE("Snapshot encoder output is identical to serializeState", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.primaryExchange = "NASDAQ";
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.lastSize = 50;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.exchange = "NASDAQ";
+    
+    JsonBuffer out;
+    
+    SECTION("Typical quote") {
+        encodeSnapshot(state, out);
+        REQUIRE(out.str() == serializeState(state));
+    }
+    
+    SECTION("Largest sequence number") {
+        state.sequence = UINT64_MAX;
+        encodeSnapshot(state, out);
+        REQUIRE(out.str() == serializeState(state));
+        REQUIRE(out.str().find("\"seq\":18446744073709551615,") != std::string::npos);
+    }
+    
+    SECTION("Edge values and buffer reuse") {
+        encodeSnapshot(state, out);  // Warm buffer, next encode must clear it
+        
+        state.bidPrice = 0.0;
+        state.askPrice = -3.5;
+        state.lastPrice = 123456789.25;
+        state.bidSize = -1;
+        state.askSize = 0;
+        state.conId = 2147483647;
+        state.exchange = "";
+        state.pastLimit = true;
+        encodeSnapshot(state, out);
+        REQUIRE(out.str() == serializeState(state));
+    }
+    
+    SECTION("Escaped symbol") {
+        state.symbol = "BRK \"B\"\\\n";
+        encodeSnapshot(state, out);
+        REQUIRE(out.str() == serializeState(state));
+    }
+    
+    SECTION("Trade exchange and sale conditions") {
+        state.exchange = tws_bridge::exchangeName(tws_bridge::exchangeCode("ARCA"));
+        state.tradeConditions = tws_bridge::parseTradeConditions("I F #");
+        encodeSnapshot(state, out);
+        REQUIRE(out.str() == serializeState(state));
+        REQUIRE(out.str().find("\"exchange\":\"ARCA\",\"conditions\":\"F I ?\"") != std::string::npos);
+    }
+    
+    SECTION("Pre-escaped symbol literal") {
+        state.symbol = "BRK \"B\"\\\n";
+        const std::string literal = tws_bridge::escapeJsonString(state.symbol);
+        state.symbolJson = literal;
+        encodeSnapshot(state, out);
+        REQUIRE(out.str() == serializeState(state));
+        JsonBuffer reference;
+        encodeSnapshot(state, out, SnapshotSchema::Compact);
+        serializeStateCompact(state, reference);
+        REQUIRE(out.str() == reference.str());
+    }
+}
+
+TEST_CASE("Compact schema matches RapidJSON reference and is smaller", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.exchange = "NASDAQ";
+    state.tradeConditions = tws_bridge::parseTradeConditions("T");
+    state.pastLimit = true;
+    
+    JsonBuffer compact;
+    JsonBuffer reference;
+    encodeSnapshot(state, compact, SnapshotSchema::Compact);
+    serializeStateCompact(state, reference);
+    
+    REQUIRE(compact.str() == reference.str());
+    REQUIRE(compact.str().find("\"sym\":\"AAPL\"") != std::string::npos);
+    REQUIRE(compact.size() < serializeState(state).size());
+}
+
+TEST_CASE("Derived metrics object matches RapidJSON reference", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.derived.onQuote(state.bidPrice, state.askPrice);
+    state.derived.onTrade(1700000000000, 171.56, 100, 9 * 3600 * 1000);
+    state.derived.onTrade(1700000000500, 171.60, 300, 9 * 3600 * 1000);
+    
+    JsonBuffer encoded;
+    JsonBuffer reference;
+    encodeSnapshot(state, encoded, SnapshotSchema::Verbose, true);
+    serializeState(state, reference, true);
+    REQUIRE(encoded.str() == reference.str());
+    REQUIRE(encoded.str().find("\"rollingVolume\":400}") != std::string::npos);
+    
+    encodeSnapshot(state, encoded, SnapshotSchema::Compact, true);
+    serializeStateCompact(state, reference, true);
+    REQUIRE(encoded.str() == reference.str());
+    
+    encodeSnapshot(state, encoded);
+    REQUIRE(encoded.str() == serializeState(state));
+    REQUIRE(encoded.str().find("derived") == std::string::npos);
+}
+
+TEST_CASE("ISO time field matches RapidJSON reference", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.quoteTimestamp = 1700000000123;
+    state.tradeTimestamp = 1700000000456;
+    
+    JsonBuffer encoded;
+    JsonBuffer reference;
+    encodeSnapshot(state, encoded, SnapshotSchema::Verbose, false, true);
+    serializeState(state, reference, false, true);
+    REQUIRE(encoded.str() == reference.str());
+    REQUIRE(encoded.str().find(",\"timestamp\":1700000000456,\"time\":\"2023-11-14T22:13:20.456Z\",") != std::string::npos);
+    
+    encodeSnapshot(state, encoded, SnapshotSchema::Compact, true, true);
+    serializeStateCompact(state, reference, true, true);
+    REQUIRE(encoded.str() == reference.str());
+    REQUIRE(encoded.str().find("\"tm\":\"2023-11-14T22:13:20.456Z\"") != std::string::npos);
+}
+
+TEST_CASE("Sent field follows the timestamp only when set", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.bidPrice = 171.55;
+    state.quoteTimestamp = 1700000000123;
+
+    JsonBuffer plain;
+    JsonBuffer sent;
+    encodeSnapshot(state, plain);
+    encodeSnapshot(state, sent, SnapshotSchema::Verbose, false, false, PriceFormat::Shortest, 0);
+    REQUIRE(sent.str() == plain.str());
+
+    encodeSnapshot(state, sent, SnapshotSchema::Verbose, false, false, PriceFormat::Shortest, 1700000000123456789);
+    REQUIRE(sent.str().find(",\"timestamp\":1700000000123,\"sent\":1700000000123456789,") != std::string::npos);
+
+    encodeSnapshot(state, sent, SnapshotSchema::Compact, false, true, PriceFormat::Shortest, 1700000000123456789);
+    REQUIRE(sent.str().find("\"tm\":\"2023-11-14T22:13:20.123Z\",\"sn\":1700000000123456789,") != std::string::npos);
+
+    encodeSnapshotDelta(state, tws_bridge::DeltaField::BidPrice, sent, SnapshotSchema::Verbose, false, PriceFormat::Shortest, 42);
+    REQUIRE(sent.str().find(",\"sent\":42,") != std::string::npos);
+}
+
+TEST_CASE("Received stamp follows the exchange time only when known", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.bidPrice = 171.55;
+    state.quoteTimestamp = 1700000000000;
+
+    JsonBuffer encoded;
+    JsonBuffer reference;
+    encodeSnapshot(state, encoded);
+    REQUIRE(encoded.str().find("received") == std::string::npos);
+
+    state.receiveNs = 1700000000731402117;
+    encodeSnapshot(state, encoded);
+    serializeState(state, reference);
+    REQUIRE(encoded.str() == reference.str());
+    REQUIRE(encoded.str().find(",\"timestamp\":1700000000000,\"received\":1700000000731402117,") != std::string::npos);
+
+    encodeSnapshot(state, encoded, SnapshotSchema::Compact, false, false, PriceFormat::Shortest, 42);
+    REQUIRE(encoded.str().find(",\"sn\":42,\"rc\":1700000000731402117,") != std::string::npos);
+
+    encodeSnapshotDelta(state, tws_bridge::DeltaField::BidPrice, encoded);
+    REQUIRE(encoded.str().find(",\"received\":1700000000731402117,\"price\":{\"bid\":171.55}") != std::string::npos);
+}
+
+TEST_CASE("Fixed-point prices keep ordinary prices byte-identical", "[encoder]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 172.0;
+    
+    JsonBuffer shortest;
+    JsonBuffer fixed;
+    encodeSnapshot(state, shortest);
+    encodeSnapshot(state, fixed, SnapshotSchema::Verbose, false, false, PriceFormat::FixedPoint);
+    REQUIRE(fixed.str() == shortest.str());
+    
+    // Binary artifacts of double arithmetic disappear
+    state.lastPrice = 0.1 + 0.2;
+    encodeSnapshot(state, shortest);
+    encodeSnapshot(state, fixed, SnapshotSchema::Verbose, false, false, PriceFormat::FixedPoint);
+    REQUIRE(shortest.str().find("\"last\":0.30000000000000004") != std::string::npos);
+    REQUIRE(fixed.str().find("\"last\":0.3}") != std::string::npos);
+}
+
+TEST_CASE("Bar encoders match the RapidJSON references", "[encoder]") {
+    TickUpdate bars[3];
+    for (std::size_t i = 0; i < 3; ++i) {
+        bars[i].type = TickUpdateType::Bar;
+        bars[i].timestamp = 1700000000000 + static_cast<std::int64_t>(i) * 5000;
+        bars[i].bar.open = 450.0 + static_cast<double>(i);
+        bars[i].bar.high = 451.5;
+        bars[i].bar.low = 449.25;
+        bars[i].bar.close = 0.1 + 0.2;
+        bars[i].bar.volume = 12345;
+        bars[i].bar.wap = 450.5;
+        bars[i].aux = 4294967295u;
+    }
+
+    JsonBuffer encoded;
+    JsonBuffer reference;
+    encodeBar("S\"Q", bars[0], encoded);
+    serializeBarData("S\"Q", bars[0], reference);
+    REQUIRE(encoded.str() == reference.str());
+
+    encodeBarArray(bars[1], encoded);
+    serializeBarCompact(bars[1], reference);
+    REQUIRE(encoded.str() == reference.str());
+
+    for (bool complete : {false, true}) {
+        for (std::size_t count = 0; count <= 3; ++count) {
+            encodeBarHistory("SPY", bars, count, complete, encoded);
+            serializeBarHistory("SPY", bars, count, complete, reference);
+            REQUIRE(encoded.str() == reference.str());
+        }
+    }
+}
+
+TEST_CASE("Midpoint encoder writes the tick-by-tick midpoint", "[encoder]") {
+    TickUpdate update;
+    update.type = TickUpdateType::MidPoint;
+    update.timestamp = 1700000000000;
+    update.midPoint.midPoint = 450.125;
+    update.midPoint.stamps = TickStamps{};
+
+    JsonBuffer encoded;
+    encodeMidPoint("SPY", update, encoded);
+    REQUIRE(encoded.str() == "{\"instrument\":\"SPY\",\"mid\":450.125,\"timestamp\":1700000000000}");
+
+    update.midPoint.stamps.receiveNs = 1700000000731402117;
+    encodeMidPoint("S\"Q", update, encoded);
+    REQUIRE(encoded.str() == "{\"instrument\":\"S\\\"Q\",\"mid\":450.125,\"timestamp\":1700000000000,"
+                             "\"received\":1700000000731402117}");
+}
+
+TEST_CASE("Backfill encoder writes quote and trade runs", "[encoder]") {
+    TickUpdate ticks[2];
+    ticks[0].type = TickUpdateType::BidAsk;
+    ticks[0].timestamp = 1700000001000;
+    ticks[0].bidAsk.bidPrice = 450.25;
+    ticks[0].bidAsk.askPrice = 450.5;
+    ticks[0].bidAsk.bidSize = 300;
+    ticks[0].bidAsk.askSize = 100;
+    ticks[1].type = TickUpdateType::AllLast;
+    ticks[1].timestamp = 1700000002000;
+    ticks[1].allLast.price = 450.5;
+    ticks[1].allLast.size = 25;
+
+    JsonBuffer encoded;
+    encodeTickBackfill("SPY", ticks, 2, true, encoded);
+    REQUIRE(encoded.str() == "{\"instrument\":\"SPY\",\"backfill\":true,\"complete\":true,\"ticks\":["
+                             "{\"type\":\"quote\",\"bid\":450.25,\"ask\":450.5,\"bidSize\":300,\"askSize\":100,"
+                             "\"timestamp\":1700000001000},"
+                             "{\"type\":\"trade\",\"price\":450.5,\"size\":25,\"timestamp\":1700000002000}]}");
+
+    encodeTickBackfill("SPY", ticks, 0, false, encoded);
+    REQUIRE(encoded.str() == "{\"instrument\":\"SPY\",\"backfill\":true,\"complete\":false,\"ticks\":[]}");
+}
+
+TEST_CASE("Snapshot array joins encoded snapshots", "[encoder]") {
+    SnapshotArray array;
+    REQUIRE(array.empty());
+
+    array.append(R"({"symbol":"AAPL"})");
+    array.append(R"({"symbol":"MSFT"})");
+    REQUIRE(array.count() == 2);
+    REQUIRE(array.close() == R"([{"symbol":"AAPL"},{"symbol":"MSFT"}])");
+
+    // Reused for the next batch
+    array.clear();
+    REQUIRE(array.empty());
+    array.append(R"({"symbol":"SPY"})");
+    REQUIRE(array.close() == R"([{"symbol":"SPY"}])");
+}
@@ -0,0 +1,78 @@
+// test_snapshot_fields.cpp - Field table rows and the key text generated from them
+
+#include <catch2/catch_test_macros.hpp>
+#include "SnapshotFields.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge::fields;
+
+namespace {
+
+std::string text(const KeyText& key) {
+    return std::string(key.data, key.size);
+}
+
+// Member names of the full snapshot, nested ones as "group.name"
+std::vector<std::string> snapshotMembers(bool compact) {
+    std::vector<std::string> names;
+    forEachField<kSnapshotFields>([&](auto index) {
+        constexpr auto& row = std::get<decltype(index)::value>(kSnapshotFields);
+        if constexpr (row.presence != Presence::DeltaOnly) {
+            const Names& group = kGroupNames[static_cast<std::size_t>(row.group)];
+            std::string name = row.group == Group::Top ? "" : std::string(compact ? group.compact : group.verbose) + ".";
+            names.push_back(name + (compact ? row.names.compact : row.names.verbose));
+        }
+    });
+    return names;
+}
+
+} // namespace
+
+TEST_CASE("Snapshot rows follow docs/PROJECT-SPECIFICATION.md §3.4.2", "[fields]") {
+    REQUIRE(snapshotMembers(false) == std::vector<std::string>{
+        "instrument", "seq", "conId", "primaryExchange", "timestamp", "time", "sent", "received",
+        "price.bid", "price.ask", "price.last", "size.bid", "size.ask", "size.last",
+        "timestamps.quote", "timestamps.trade", "exchange", "conditions", "tickAttrib.pastLimit",
+        "derived.mid", "derived.spread", "derived.vwap", "derived.rollingVolume"});
+    REQUIRE(snapshotMembers(true) == std::vector<std::string>{
+        "sym", "sq", "cid", "pex", "ts", "tm", "sn", "rc", "p.b", "p.a", "p.l", "s.b", "s.a", "s.l",
+        "tss.q", "tss.t", "ex", "cnd", "attr.pl", "d.m", "d.sp", "d.vw", "d.rv"});
+}
+
+TEST_CASE("Key text opens groups on their first row only", "[fields]") {
+    // Built at compile time
+    static_assert(kMemberKey<kSnapshotFields, 0, false>.size == sizeof(",\"instrument\":") - 1);
+
+    REQUIRE(text(kMemberKey<kSnapshotFields, 0, false>) == ",\"instrument\":");
+    REQUIRE(text(kMemberKey<kSnapshotFields, 6, false>) == ",\"time\":\"");
+    REQUIRE(text(kMemberKey<kSnapshotFields, 9, false>) == ",\"price\":{\"bid\":");
+    REQUIRE(text(kMemberKey<kSnapshotFields, 10, false>) == ",\"ask\":");
+    REQUIRE(text(kMemberKey<kSnapshotFields, 12, true>) == ",\"s\":{\"b\":");
+    REQUIRE(text(kMemberKey<kSnapshotFields, 18, true>) == ",\"cnd\":\"");
+    REQUIRE(text(kDeltaMemberKey<kSnapshotFields, 10, false>) == "\"ask\":");
+    REQUIRE(text(kGroupOpener<Group::Timestamps, true>) == ",\"tss\":{");
+
+    REQUIRE_FALSE(closesGroup<kSnapshotFields, 9>());
+    REQUIRE(closesGroup<kSnapshotFields, 11>());
+    REQUIRE(closesGroup<kSnapshotFields, 19>());
+    REQUIRE(closesGroup<kSnapshotFields, kFieldCount<kSnapshotFields> - 1>());
+}
+
+TEST_CASE("Accessors read the record", "[fields]") {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.receiveNs = 1700000000731402117;
+    state.askSize = 300;
+    REQUIRE(std::get<0>(kSnapshotFields).get(state).value == "AAPL");
+    REQUIRE(std::get<5>(kSnapshotFields).get(state) == 1700000000500);
+    REQUIRE(std::get<8>(kSnapshotFields).get(state) == 1700000000731402117);
+    REQUIRE(std::get<13>(kSnapshotFields).get(state).units == 300);
+    REQUIRE(std::get<13>(kSnapshotFields).get(state).scale == 0);
+
+    TickUpdate bar;
+    bar.aux = 42;
+    REQUIRE(std::get<kFieldCount<kBarFields> - 1>(kBarFields).get(bar) == 42u);
+}
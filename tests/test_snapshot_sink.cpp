@@ -0,0 +1,158 @@
+// test_snapshot_sink.cpp - Unit tests for the snapshot sink fan-out
+
+#include <catch2/catch_test_macros.hpp>
+#include "SnapshotSink.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+class RecordingSink : public SnapshotSink {
+public:
+    explicit RecordingSink(std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : m_delay(delay) {}
+
+    const char* name() const override { return "recording"; }
+
+    void onBatch(const SnapshotRecord* records, std::size_t count) override {
+        std::this_thread::sleep_for(m_delay);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (std::size_t i = 0; i < count; ++i) {
+            m_payloads.emplace_back(records[i].payload);
+            m_channels.emplace_back(records[i].channel);
+        }
+    }
+
+    void onStop() override { m_stopped = true; }
+
+    std::vector<std::string> payloads() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_payloads;
+    }
+    std::vector<std::string> channels() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_channels;
+    }
+    bool stopped() const { return m_stopped; }
+
+private:
+    std::chrono::milliseconds m_delay;
+    mutable std::mutex m_mutex;
+    std::vector<std::string> m_payloads;
+    std::vector<std::string> m_channels;
+    bool m_stopped = false;
+};
+
+} // namespace
+
+TEST_CASE("Every sink receives every committed record in order", "[sink]") {
+    auto first = std::make_shared<RecordingSink>();
+    auto second = std::make_shared<RecordingSink>();
+    SinkFanout fanout(32);  // More pooled batches than commits - nothing can be exhausted
+    fanout.add(first);
+    fanout.add(second);
+    fanout.start();
+
+    for (int batch = 0; batch < 20; ++batch) {
+        for (int i = 0; i < 5; ++i) {
+            const std::string payload = std::to_string(batch * 5 + i);
+            fanout.append("TWS:TICKS:AAPL", payload, 3);
+        }
+        fanout.commit();
+    }
+    fanout.stop();
+
+    REQUIRE(first->stopped());
+    REQUIRE(second->stopped());
+    for (const auto& sink : {first, second}) {
+        const std::vector<std::string> payloads = sink->payloads();
+        REQUIRE(payloads.size() == 100);
+        for (std::size_t i = 0; i < payloads.size(); ++i) {
+            REQUIRE(payloads[i] == std::to_string(i));
+        }
+        REQUIRE(sink->channels().front() == "TWS:TICKS:AAPL");
+    }
+    REQUIRE(fanout.counters(0).records == 100);
+    REQUIRE(fanout.counters(1).dropped == 0);
+}
+
+TEST_CASE("A slow sink drops its own batches without stalling the others", "[sink]") {
+    auto fast = std::make_shared<RecordingSink>();
+    auto slow = std::make_shared<RecordingSink>(std::chrono::milliseconds(20));
+    SinkPolicy small;
+    small.maxQueuedBatches = 2;
+    SinkFanout fanout(64);
+    fanout.add(fast);
+    fanout.add(slow, small);
+    fanout.start();
+
+    for (int batch = 0; batch < 30; ++batch) {
+        fanout.append("C", std::to_string(batch), 0);
+        fanout.commit();
+    }
+    fanout.stop();
+
+    REQUIRE(fast->payloads().size() == 30);
+    REQUIRE(fanout.counters(1).dropped > 0);
+    REQUIRE(slow->payloads().size() + fanout.counters(1).dropped == 30);
+    REQUIRE(fanout.exhausted() == 0);
+}
+
+TEST_CASE("Pooled payloads reach every sink without a copy and return to the pool", "[sink]") {
+    auto first = std::make_shared<RecordingSink>();
+    auto second = std::make_shared<RecordingSink>();
+    PayloadPool pool(64, 1);
+    {
+        SinkFanout fanout(4);
+        fanout.add(first);
+        fanout.add(second);
+        fanout.start();
+        const SharedPayload stored = pool.store("{\"bid\":1}");
+        fanout.append("TWS:TICKS:AAPL", stored, 0);
+        fanout.commit();
+        fanout.stop();
+    }
+    REQUIRE(first->payloads() == std::vector<std::string>{"{\"bid\":1}"});
+    REQUIRE(second->payloads() == first->payloads());
+    // REASON: Both sinks released the batch - after the open block fills, the pool reuses it, no growth
+    pool.store(std::string(64, 'x'));
+    pool.store("y");
+    REQUIRE(pool.blocks() == 1);
+}
+
+TEST_CASE("Fan-out without sinks ignores appends", "[sink]") {
+    SinkFanout fanout(2);
+    fanout.append("C", "x", 0);
+    fanout.commit();
+    REQUIRE(fanout.sinkCount() == 0);
+}
+
+TEST_CASE("The binary copy travels with the record once a sink asks for it", "[sink]") {
+    class BinarySink : public RecordingSink {
+    public:
+        bool wantsBinary() const override { return true; }
+        void onBatch(const SnapshotRecord* records, std::size_t count) override {
+            for (std::size_t i = 0; i < count; ++i) {
+                binaries.emplace_back(records[i].binary);
+            }
+        }
+        std::vector<std::string> binaries;
+    };
+    auto sink = std::make_shared<BinarySink>();
+    SinkFanout fanout(4);
+    REQUIRE_FALSE(fanout.wantsBinary());
+    fanout.add(sink);
+    REQUIRE(fanout.wantsBinary());
+    fanout.start();
+    fanout.append("C", "{}", 0, std::string_view("\x01\x00\x02", 3));
+    fanout.commit();
+    fanout.stop();
+
+    REQUIRE(sink->binaries.size() == 1);
+    REQUIRE(sink->binaries[0] == std::string("\x01\x00\x02", 3));
+}
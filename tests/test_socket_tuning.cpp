@@ -0,0 +1,48 @@
+// test_socket_tuning.cpp - TWS socket options applied to a real TCP socket
+
+#include <catch2/catch_test_macros.hpp>
+#include "SocketTuning.h"
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+int option(int fd, int level, int name) {
+    int value = 0;
+    socklen_t length = sizeof(value);
+    ::getsockopt(fd, level, name, &value, &length);
+    return value;
+}
+
+} // namespace
+
+TEST_CASE("Nagle and the receive buffer are set on the socket", "[socket-tuning]") {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(fd >= 0);
+    SocketTuning tuning;
+    tuning.receiveBuffer = 64 * 1024;
+    std::string refused;
+    REQUIRE(applySocketTuning(fd, tuning, refused));
+    REQUIRE(refused.empty());
+    REQUIRE(option(fd, IPPROTO_TCP, TCP_NODELAY) != 0);
+    REQUIRE(option(fd, SOL_SOCKET, SO_RCVBUF) >= 64 * 1024);  // NOTE: Linux reports twice the request
+
+    tuning.noDelay = false;
+    REQUIRE(applySocketTuning(fd, tuning, refused));
+    REQUIRE(option(fd, IPPROTO_TCP, TCP_NODELAY) == 0);
+    ::close(fd);
+}
+
+TEST_CASE("Refused options are reported, not thrown", "[socket-tuning]") {
+    SocketTuning tuning;
+    tuning.quickAck = true;
+    std::string refused;
+    REQUIRE_FALSE(applySocketTuning(-1, tuning, refused));
+    REQUIRE(refused.find("TCP_NODELAY") != std::string::npos);
+    REQUIRE(refused.find("TCP_QUICKACK") != std::string::npos);
+}
@@ -0,0 +1,87 @@
+// test_spill_ring.cpp - Unit tests for the Redis outage spill ring
+
+#include <catch2/catch_test_macros.hpp>
+#include "MemoryBudget.h"
+#include "PublishMessage.h"
+
+#include <string>
+
+using namespace tws_bridge;
+
+TEST_CASE("Spill ring keeps owned copies in order", "[spill]") {
+    SpillRing ring(4);
+    {
+        std::string channel = "market:AAPL";
+        std::string payload = "{\"bid\":1}";
+        REQUIRE_FALSE(ring.push(PublishMessage{channel, payload}));
+        channel = "overwritten";  // Ring must not point into the caller's buffer
+        payload = "x";
+    }
+    REQUIRE_FALSE(ring.push(PublishMessage{"stream:AAPL", "{\"bid\":2}", RedisCommand::StreamAdd}));
+    REQUIRE_FALSE(ring.push(PublishMessage{"history:AAPL", "bar", RedisCommand::SortedSetAdd, 60.0}));
+
+    REQUIRE(ring.size() == 3);
+    REQUIRE(ring.at(0).channel == "market:AAPL");
+    REQUIRE(ring.at(0).payload == "{\"bid\":1}");
+    REQUIRE(ring.at(1).command == RedisCommand::StreamAdd);
+    REQUIRE(ring.at(2).score == 60.0);
+
+    ring.pop(2);
+    REQUIRE(ring.size() == 1);
+    REQUIRE(ring.at(0).channel == "history:AAPL");
+}
+
+TEST_CASE("Full spill ring evicts the oldest", "[spill]") {
+    SpillRing ring(2);
+    REQUIRE_FALSE(ring.push(PublishMessage{"a", "1"}));
+    REQUIRE_FALSE(ring.push(PublishMessage{"b", "2"}));
+    REQUIRE(ring.push(PublishMessage{"c", "3"}));
+    REQUIRE(ring.size() == 2);
+    REQUIRE(ring.at(0).channel == "b");
+    REQUIRE(ring.at(1).channel == "c");
+
+    ring.pop(5);  // More than held
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.push(PublishMessage{"d", "4"}));
+    REQUIRE(ring.at(0).channel == "d");
+}
+
+TEST_CASE("Zero-capacity spill ring drops everything", "[spill]") {
+    SpillRing ring(0);
+    REQUIRE(ring.push(PublishMessage{"a", "1"}));
+    REQUIRE(ring.empty());
+    REQUIRE(ring.capacity() == 0);
+}
+
+TEST_CASE("Spill ring trims the oldest messages to a byte budget", "[spill][memory]") {
+    SpillRing ring(8);
+    REQUIRE_FALSE(ring.push(PublishMessage{"a", "12345"}));    // 6 bytes
+    REQUIRE_FALSE(ring.push(PublishMessage{"bb", "1234"}));    // 6 bytes
+    REQUIRE_FALSE(ring.push(PublishMessage{"ccc", "123"}));    // 6 bytes
+    REQUIRE(ring.bytes() == 18);
+
+    REQUIRE(ring.trim(18) == 0);
+    REQUIRE(ring.trim(12) == 1);
+    REQUIRE(ring.bytes() == 12);
+    REQUIRE(ring.at(0).channel == "bb");
+    ring.pop(1);
+    REQUIRE(ring.bytes() == 6);
+    REQUIRE(ring.trim(0) == 1);
+    REQUIRE(ring.empty());
+    REQUIRE(ring.bytes() == 0);
+}
+
+TEST_CASE("Budget shares split evenly and never round down to unbounded", "[memory]") {
+    MemoryBudgetConfig memory;
+    memory.publishSpillMb = 64;
+    REQUIRE(memory.bytes(MemorySubsystem::PublishSpill) == 64u << 20);
+    REQUIRE(memory.bytes(MemorySubsystem::History) == 0);
+    REQUIRE(budgetShare(memory.bytes(MemorySubsystem::PublishSpill), 4) == 16u << 20);
+    REQUIRE(budgetShare(0, 4) == 0);
+    REQUIRE(budgetShare(3, 4) == 1);
+    REQUIRE(budgetShare(10, 0) == 10);
+    REQUIRE_FALSE(overBudget(100, 0));
+    REQUIRE_FALSE(overBudget(100, 100));
+    REQUIRE(overBudget(101, 100));
+    REQUIRE(std::string(memorySubsystemName(MemorySubsystem::WebSocket)) == "websocket");
+}
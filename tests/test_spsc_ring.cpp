@@ -0,0 +1,96 @@
+// test_spsc_ring.cpp - Unit tests for the bounded SPSC ingest ring
+
+#include <catch2/catch_test_macros.hpp>
+#include "SpscRing.h"
+#include "MarketData.h"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("Capacity rounds up to a power of two", "[spsc]") {
+    REQUIRE(SpscRing<int>(1000).capacity() == 1024);
+    REQUIRE(SpscRing<int>(1024).capacity() == 1024);
+    REQUIRE(SpscRing<int>(0).capacity() == 2);
+}
+
+TEST_CASE("Full ring rejects, empty ring returns nothing", "[spsc]") {
+    SpscRing<int> ring(4);
+    int value = 0;
+    REQUIRE_FALSE(ring.try_dequeue(value));
+    
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(ring.try_enqueue(i));
+    }
+    REQUIRE_FALSE(ring.try_enqueue(99));
+    REQUIRE(ring.size_approx() == 4);
+    
+    REQUIRE(ring.try_dequeue(value));
+    REQUIRE(value == 0);
+    REQUIRE(ring.try_enqueue(4));  // Slot freed by the dequeue
+}
+
+TEST_CASE("Indices wrap around preserving FIFO order", "[spsc]") {
+    SpscRing<int> ring(8);
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(ring.try_enqueue(next++));
+        }
+        int value = 0;
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(ring.try_dequeue(value));
+            REQUIRE(value == expected++);
+        }
+    }
+    REQUIRE(ring.size_approx() == 0);
+}
+
+TEST_CASE("Bulk dequeue is bounded by available items and max", "[spsc]") {
+    SpscRing<TickUpdate> ring(16);
+    for (std::uint16_t slot = 0; slot < 10; ++slot) {
+        TickUpdate update;
+        update.slot = slot;
+        REQUIRE(ring.try_enqueue(update));
+    }
+    
+    std::vector<TickUpdate> batch(8);
+    REQUIRE(ring.try_dequeue_bulk(batch.data(), batch.size()) == 8);
+    REQUIRE(batch[0].slot == 0);
+    REQUIRE(batch[7].slot == 7);
+    REQUIRE(ring.try_dequeue_bulk(batch.data(), batch.size()) == 2);
+    REQUIRE(batch[1].slot == 9);
+    REQUIRE(ring.try_dequeue_bulk(batch.data(), batch.size()) == 0);
+}
+
+TEST_CASE("Producer and consumer threads see every item in order", "[spsc]") {
+    const std::int64_t total = 200000;
+    SpscRing<TickUpdate> ring(64);  // REASON: Small ring forces full/empty transitions
+    
+    std::thread producer([&]() {
+        for (std::int64_t i = 0; i < total; ++i) {
+            TickUpdate update;
+            update.timestamp = i;
+            while (!ring.try_enqueue(update)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    std::int64_t expected = 0;
+    bool ordered = true;
+    std::vector<TickUpdate> batch(32);
+    while (expected < total) {
+        std::size_t count = ring.try_dequeue_bulk(batch.data(), batch.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            ordered = ordered && batch[i].timestamp == expected;
+            ++expected;
+        }
+    }
+    producer.join();
+    
+    REQUIRE(ordered);
+    REQUIRE(expected == total);
+}
@@ -0,0 +1,87 @@
+// test_stage_watchdog.cpp - Stall detection: silent stages, recovery, parked stages
+
+#include <catch2/catch_test_macros.hpp>
+#include "StageWatchdog.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using Clock = StageWatchdog::Clock;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+
+namespace {
+
+struct Events {
+    std::vector<std::string> log;
+
+    void check(StageWatchdog& watchdog, Clock::time_point now) {
+        watchdog.check(
+            now,
+            [this](StageWatchdog::Watched& watched, Clock::duration silentFor) {
+                log.push_back(std::string("stall ") + stageName(watched.stage) + " "
+                              + std::to_string(std::chrono::duration_cast<milliseconds>(silentFor).count()));
+            },
+            [this](StageWatchdog::Watched& watched) { log.push_back(std::string("clear ") + stageName(watched.stage)); });
+    }
+};
+
+} // namespace
+
+TEST_CASE("A stage without beats is reported once, then cleared by its next beat", "[watchdog]") {
+    WatchdogConfig config;
+    config.stallAfter = seconds(5);
+    StageWatchdog watchdog(config);
+    Heartbeat worker;
+    Heartbeat sink;
+    worker.attach();
+    sink.attach();
+    watchdog.watch(Stage::Worker, 0, worker);
+    watchdog.watch(Stage::Sink, 0, sink);
+
+    Events events;
+    const Clock::time_point start = Clock::time_point{} + seconds(1);
+    for (int second = 0; second <= 8; ++second) {
+        sink.beat();  // The sink keeps running, the worker is stuck
+        events.check(watchdog, start + seconds(second));
+    }
+    REQUIRE(events.log == std::vector<std::string>{"stall worker 5000"});
+    REQUIRE(watchdog.watched()[0]->stalls.load() == 1);
+    REQUIRE(watchdog.watched()[1]->stalls.load() == 0);
+
+    worker.beat();
+    events.check(watchdog, start + seconds(9));
+    REQUIRE(events.log.back() == "clear worker");
+
+    // A second stall counts again
+    sink.beat();
+    events.check(watchdog, start + seconds(14));
+    REQUIRE(events.log.back() == "stall worker 5000");
+    REQUIRE(watchdog.watched()[0]->stalls.load() == 2);
+}
+
+TEST_CASE("Parked and unattached stages are never stalled", "[watchdog]") {
+    StageWatchdog watchdog(WatchdogConfig{});
+    Heartbeat dispatch;
+    Heartbeat reader;  // Never attached (inline reader mode: no reader thread)
+    dispatch.attach();
+    watchdog.watch(Stage::Dispatch, 0, dispatch);
+    watchdog.watch(Stage::Reader, 0, reader);
+
+    Events events;
+    const Clock::time_point start = Clock::time_point{} + seconds(1);
+    events.check(watchdog, start);
+    dispatch.park(true);  // Reconnect back-off
+    for (int second = 1; second <= 30; ++second) {
+        events.check(watchdog, start + seconds(second));
+    }
+    REQUIRE(events.log.empty());
+
+    // The stall timer restarts when the stage resumes
+    dispatch.park(false);
+    events.check(watchdog, start + seconds(31));
+    events.check(watchdog, start + milliseconds(35500));
+    REQUIRE(events.log.empty());
+    events.check(watchdog, start + seconds(36));
+    REQUIRE(events.log == std::vector<std::string>{"stall dispatch 5000"});
+}
@@ -0,0 +1,138 @@
+// test_state_checkpoint.cpp - Unit tests for the shared-memory worker state checkpoint
+
+#include <catch2/catch_test_macros.hpp>
+#include "StateCheckpoint.h"
+
+#include <cstring>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string segmentName(const char* test) {
+    return "/tws-bridge-test-state-" + std::string(test) + "-" + std::to_string(::getpid());
+}
+
+void setSymbol(SlotCheckpoint& out, const char* symbol) {
+    std::memset(out.symbol, 0, sizeof(out.symbol));
+    std::memcpy(out.symbol, symbol, std::strlen(symbol));
+}
+
+constexpr CheckpointLayout kLayout{32400000, 60000};
+
+} // namespace
+
+TEST_CASE("Records survive the writer and are found by symbol", "[checkpoint]") {
+    const std::string name = segmentName("basic");
+    {
+        auto checkpoint = StateCheckpoint::create(name, 8, kLayout);
+        REQUIRE(checkpoint);
+        checkpoint->write(3, [](SlotCheckpoint& out) {
+            out = SlotCheckpoint{};
+            setSymbol(out, "AAPL");
+            out.conId = 265598;
+            out.lastPrice = 171.5;
+            out.trades = 42;
+            out.derived.rolling.setWindow(60000);
+            out.derived.onTrade(1700000000000, 171.5, 100, 32400000);
+            out.derived.onTrade(1700000001000, 172.5, 300, 32400000);
+            out.bars[0] = {BarSize::Min1, true, 1699999980000, BuiltBar{1699999980000, 171.5, 172.5, 171.5, 172.5, 400, 68925.0, 2}};
+        });
+    }  // NOTE: The segment stays after the writer is gone (crash / upgrade)
+
+    std::string why;
+    const CheckpointImage image = StateCheckpoint::load(name, kLayout, why);
+    REQUIRE(why.empty());
+    REQUIRE(image.derivedValid);
+    REQUIRE(image.slots.size() == 1);
+    const SlotCheckpoint* saved = image.find("AAPL");
+    REQUIRE(saved);
+    REQUIRE(saved->conId == 265598);
+    REQUIRE(saved->lastPrice == 171.5);
+    REQUIRE(saved->trades == 42);
+    REQUIRE(saved->derived.sessionVolume == 400);
+    REQUIRE(saved->derived.vwap == (171.5 * 100 + 172.5 * 300) / 400);
+    REQUIRE(saved->derived.rolling.total() == 400);
+    REQUIRE(saved->bars[0].open);
+    REQUIRE(saved->bars[0].bar.volume == 400);
+    REQUIRE(image.find("MSFT") == nullptr);
+
+    // Creating the next segment discards the previous one
+    auto next = StateCheckpoint::create(name, 8, kLayout);
+    REQUIRE(StateCheckpoint::load(name, kLayout, why).slots.empty());
+    ::shm_unlink(name.c_str());
+}
+
+TEST_CASE("A record being written is not restored", "[checkpoint]") {
+    const std::string name = segmentName("torn");
+    auto checkpoint = StateCheckpoint::create(name, 4, kLayout);
+    REQUIRE(checkpoint);
+    checkpoint->write(0, [](SlotCheckpoint& out) {
+        out = SlotCheckpoint{};
+        setSymbol(out, "AAPL");
+    });
+    std::size_t seenMidWrite = 99;
+    checkpoint->write(1, [&](SlotCheckpoint& out) {
+        out = SlotCheckpoint{};
+        setSymbol(out, "MSFT");
+        std::string why;
+        seenMidWrite = StateCheckpoint::load(name, kLayout, why).slots.size();  // As if the writer crashed here
+    });
+    REQUIRE(seenMidWrite == 1);
+
+    std::string why;
+    REQUIRE(StateCheckpoint::load(name, kLayout, why).slots.size() == 2);
+    ::shm_unlink(name.c_str());
+}
+
+TEST_CASE("Changed derived metric settings invalidate only the derived fields", "[checkpoint]") {
+    const std::string name = segmentName("layout");
+    auto checkpoint = StateCheckpoint::create(name, 4, kLayout);
+    checkpoint->write(0, [](SlotCheckpoint& out) {
+        out = SlotCheckpoint{};
+        setSymbol(out, "AAPL");
+    });
+
+    std::string why;
+    const CheckpointImage image = StateCheckpoint::load(name, CheckpointLayout{32400000, 300000}, why);
+    REQUIRE(why.empty());
+    REQUIRE_FALSE(image.derivedValid);
+    REQUIRE(image.find("AAPL"));
+    ::shm_unlink(name.c_str());
+}
+
+TEST_CASE("A missing segment is a cold start", "[checkpoint]") {
+    std::string why;
+    const CheckpointImage image = StateCheckpoint::load(segmentName("missing"), kLayout, why);
+    REQUIRE(image.slots.empty());
+    REQUIRE_FALSE(why.empty());
+}
+
+TEST_CASE("Open bars resume in the builder of the same timeframe", "[checkpoint]") {
+    const BarSize sizes[] = {BarSize::Sec5, BarSize::Min1};
+    BarBuilder before(sizes, 2);
+    auto ignore = [](BarSize, const BuiltBar&) {};
+    before.addTrade(60000, 10.0, 100, ignore);
+    before.addTrade(66000, 11.0, 50, ignore);  // Closes the first 5 s bar
+
+    const BarSize reordered[] = {BarSize::Min1, BarSize::Sec1};
+    BarBuilder after(reordered, 2);
+    for (std::size_t i = 0; i < before.timeframes(); ++i) {
+        after.restoreFrame(before.frameState(i));
+    }
+    REQUIRE(after.frameState(0).open);
+    REQUIRE(after.frameState(0).bar.volume == 150);
+    REQUIRE_FALSE(after.frameState(1).open);  // 1 s was not built before
+
+    std::size_t closed = 0;
+    after.addTrade(120000, 12.0, 10, [&](BarSize size, const BuiltBar& bar) {
+        REQUIRE(size == BarSize::Min1);
+        REQUIRE(bar.open == 10.0);
+        REQUIRE(bar.close == 11.0);
+        ++closed;
+    });
+    REQUIRE(closed == 1);
+}
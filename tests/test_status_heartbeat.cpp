@@ -0,0 +1,39 @@
+// test_status_heartbeat.cpp - Interval rates of the TWS:STATUS heartbeat
+
+#include <catch2/catch_test_macros.hpp>
+#include "StatusHeartbeat.h"
+#include <chrono>
+
+using namespace tws_bridge;
+
+TEST_CASE("Interval rates come from the difference of two samples", "[status]") {
+    StatusSample previous;
+    previous.ticksIn = 1000;
+    previous.published = 400;
+    previous.sent = 380;
+    previous.dropped = 5;
+    previous.conflated = 50;
+    StatusSample current = previous;
+    current.ticksIn = 3000;
+    current.published = 1400;
+    current.sent = 1380;
+    current.dropped = 7;
+    current.conflated = 150;
+    current.queueAge = std::chrono::milliseconds(3);
+    current.subscriptions = 42;
+
+    const StatusReport report = makeStatusReport(previous, current, std::chrono::milliseconds(500));
+    REQUIRE(report.ticksInPerSecond == 4000.0);
+    REQUIRE(report.publishedPerSecond == 2000.0);
+    REQUIRE(report.sentPerSecond == 2000.0);
+    REQUIRE(report.dropped == 2);
+    REQUIRE(report.conflated == 100);
+    REQUIRE(report.intervalMs == 500);
+    REQUIRE(report.current.subscriptions == 42);
+
+    // PITFALL: A total that went backwards (component replaced) is an empty interval, not a wrap-around
+    const StatusReport reset = makeStatusReport(current, previous, std::chrono::seconds(1));
+    REQUIRE(reset.ticksInPerSecond == 0.0);
+    REQUIRE(reset.dropped == 0);
+    REQUIRE(makeStatusReport(previous, current, std::chrono::nanoseconds(0)).ticksInPerSecond == 0.0);
+}
@@ -0,0 +1,53 @@
+// test_subscriber_table.cpp - Unit tests for the per-slot subscriber flags (SubscriberTracker.h)
+
+#include <catch2/catch_test_macros.hpp>
+#include "SubscriberTracker.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("Every slot starts watched (fail open)", "[watch]") {
+    SubscriberTable table(4);
+
+    for (SlotId slot = 0; slot < 4; ++slot) {
+        REQUIRE(table.watched(slot));
+    }
+    REQUIRE(table.watched(100));  // Beyond capacity: never skipped
+    REQUIRE(table.generation() == 0);
+}
+
+TEST_CASE("Only slots turning watched bump the generation", "[watch]") {
+    SubscriberTable table(4);
+
+    table.update(1, false);
+    table.update(2, false);
+    table.publish();
+    REQUIRE_FALSE(table.watched(1));
+    REQUIRE_FALSE(table.watched(2));
+    REQUIRE(table.watched(0));
+    REQUIRE(table.generation() == 0);  // Losing subscribers needs no re-publish
+
+    table.update(1, true);
+    table.update(0, true);  // Already watched
+    REQUIRE(table.generation() == 0);  // Nothing visible before publish()
+    table.publish();
+    REQUIRE(table.watched(1));
+    REQUIRE(table.generation() == 1);
+
+    table.publish();  // Unchanged pass
+    REQUIRE(table.generation() == 1);
+}
+
+TEST_CASE("markAllWatched restores every slot after a probe error", "[watch]") {
+    SubscriberTable table(3);
+    table.update(0, false);
+    table.update(2, false);
+    table.publish();
+
+    table.markAllWatched();
+    REQUIRE(table.watched(0));
+    REQUIRE(table.watched(2));
+    REQUIRE(table.generation() == 1);
+
+    table.markAllWatched();  // Nothing turned watched this time
+    REQUIRE(table.generation() == 1);
+}
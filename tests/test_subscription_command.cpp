@@ -0,0 +1,134 @@
+// test_subscription_command.cpp - Unit tests for the TWS:COMMANDS parser
+
+#include <catch2/catch_test_macros.hpp>
+#include "SubscriptionCommand.h"
+
+using namespace tws_bridge;
+
+TEST_CASE("Full subscribe command is parsed", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(
+        R"({"action":"subscribe","symbol":"AAPL","secType":"STK","exchange":"SMART",)"
+        R"("currency":"USD","primaryExchange":"NASDAQ","requestId":"req-12345"})",
+        command, error));
+    REQUIRE(command.action == CommandAction::Subscribe);
+    REQUIRE(command.symbol == "AAPL");
+    REQUIRE(command.primaryExchange == "NASDAQ");
+    REQUIRE(command.requestId == "req-12345");
+    REQUIRE(command.priority == 0);
+}
+
+TEST_CASE("Priority orders paced subscriptions", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","priority":100})", command, error));
+    REQUIRE(command.priority == 100);
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","priority":"high"})", command, error));
+    REQUIRE(error == "\"priority\" must be an integer");
+}
+
+TEST_CASE("Feed selects tick-by-tick or top-of-book", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY"})", command, error));
+    REQUIRE(command.feed == FeedType::Auto);
+    REQUIRE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","feed":"topOfBook"})", command, error));
+    REQUIRE(command.feed == FeedType::TopOfBook);
+    REQUIRE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","feed":"tickByTick"})", command, error));
+    REQUIRE(command.feed == FeedType::TickByTick);
+    REQUIRE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","feed":"midPoint"})", command, error));
+    REQUIRE(command.feed == FeedType::MidPoint);
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","feed":"depth"})", command, error));
+    REQUIRE(error == "unknown feed \"depth\"");
+}
+
+TEST_CASE("Option chain commands carry the expiry count and strike range", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","feed":"optionChain"})", command, error));
+    REQUIRE(command.feed == FeedType::OptionChain);
+    REQUIRE(command.chain.expiries == 1);
+    REQUIRE(command.chain.minStrike == 0.0);
+    REQUIRE(command.chain.maxStrike == 0.0);
+
+    REQUIRE(parseSubscriptionCommand(
+        R"({"action":"subscribe","symbol":"SPY","feed":"optionChain","expiries":3,"minStrike":540,"maxStrike":600.5})",
+        command, error));
+    REQUIRE(command.chain.expiries == 3);
+    REQUIRE(command.chain.minStrike == 540.0);
+    REQUIRE(command.chain.maxStrike == 600.5);
+
+    SubscriptionCommand rejected;
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","expiries":0})", rejected, error));
+    REQUIRE(error == "\"expiries\" must be a positive integer");
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":"SPY","minStrike":"540"})", rejected, error));
+    REQUIRE(error == "\"minStrike\" must be a number");
+}
+
+TEST_CASE("Missing optional fields keep the schema defaults", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"unsubscribe","symbol":"TSLA"})", command, error));
+    REQUIRE(command.action == CommandAction::Unsubscribe);
+    REQUIRE(command.secType == "STK");
+    REQUIRE(command.exchange == "SMART");
+    REQUIRE(command.currency == "USD");
+    REQUIRE(command.primaryExchange.empty());
+}
+
+TEST_CASE("Invalid commands are rejected with a reason", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE_FALSE(parseSubscriptionCommand("not json", command, error));
+    REQUIRE(error == "invalid JSON object");
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"symbol":"AAPL"})", command, error));
+    REQUIRE(error == "missing \"action\"");
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"cancel","symbol":"AAPL"})", command, error));
+    REQUIRE(error == "unknown action \"cancel\"");
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"subscribe"})", command, error));
+    REQUIRE(error == "missing \"symbol\"");
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"subscribe","symbol":42})", command, error));
+    REQUIRE(error == "\"symbol\" must be a string");
+}
+
+TEST_CASE("Interest and release carry the consumer and its ttl", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"interest","symbol":"AAPL","consumer":"desk-7","ttl":45})", command, error));
+    REQUIRE(command.action == CommandAction::Interest);
+    REQUIRE(command.consumer == "desk-7");
+    REQUIRE(command.ttl == std::chrono::seconds(45));
+
+    SubscriptionCommand release;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"release","symbol":"AAPL","consumer":"desk-7"})", release, error));
+    REQUIRE(release.action == CommandAction::Release);
+    REQUIRE(release.ttl == std::chrono::seconds(0));
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"interest","symbol":"AAPL"})", command, error));
+    REQUIRE(error == "missing \"consumer\"");
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"interest","symbol":"AAPL","consumer":"a","ttl":0})", command, error));
+    REQUIRE(error == "\"ttl\" must be a positive integer");
+}
+
+TEST_CASE("Profile commands need no symbol", "[commands]") {
+    SubscriptionCommand command;
+    std::string error;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"profile","duration":30,"requestId":"p-1"})", command, error));
+    REQUIRE(command.action == CommandAction::Profile);
+    REQUIRE(command.duration == std::chrono::seconds(30));
+    REQUIRE(command.symbol.empty());
+
+    SubscriptionCommand defaults;
+    REQUIRE(parseSubscriptionCommand(R"({"action":"profile"})", defaults, error));
+    REQUIRE(defaults.duration == std::chrono::seconds(0));
+
+    REQUIRE_FALSE(parseSubscriptionCommand(R"({"action":"profile","duration":"30s"})", command, error));
+    REQUIRE(error == "\"duration\" must be a positive integer");
+}
@@ -0,0 +1,171 @@
+// test_subscription_demand.cpp - Demand-driven feeds: refcounted interest, TTL expiry, hysteresis, Pub/Sub input
+
+#include <catch2/catch_test_macros.hpp>
+#include "SubscriptionDemand.h"
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = SubscriptionDemand::Clock;
+using Change = std::tuple<std::string, DemandLevel, DemandLevel>;
+
+DemandConfig makeConfig() {
+    DemandConfig config;
+    config.enabled = true;
+    config.defaultTtl = 30s;
+    config.maxTtl = 120s;
+    config.upgradeAfter = 0ms;
+    config.downgradeAfter = 10s;
+    return config;
+}
+
+std::vector<Change> step(SubscriptionDemand& demand, Clock::time_point now, bool subscribed = false) {
+    std::vector<Change> changes;
+    demand.update(now, [&](const std::string&) { return subscribed; },
+                  [&](const std::string& symbol, DemandLevel from, DemandLevel to) {
+                      changes.emplace_back(symbol, from, to);
+                  });
+    return changes;
+}
+
+} // namespace
+
+TEST_CASE("Tracked symbols start on the idle feed", "[demand]") {
+    const Clock::time_point t0 = Clock::now();
+    SubscriptionDemand demand(makeConfig());
+    demand.track("AAPL");
+    REQUIRE(demand.level("AAPL") == DemandLevel::Off);
+
+    auto changes = step(demand, t0);
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes[0] == Change{"AAPL", DemandLevel::Off, DemandLevel::Idle});
+    REQUIRE(step(demand, t0 + 1s).empty());
+
+    DemandConfig none = makeConfig();
+    none.idleFeed = DemandIdle::None;
+    SubscriptionDemand unsubscribed(none);
+    unsubscribed.track("AAPL");
+    REQUIRE(step(unsubscribed, t0).empty());
+    REQUIRE(unsubscribed.level("AAPL") == DemandLevel::Off);
+}
+
+TEST_CASE("Interest is refcounted by consumer", "[demand]") {
+    const Clock::time_point t0 = Clock::now();
+    SubscriptionDemand demand(makeConfig());
+    demand.interest("AAPL", "a", 0s, t0);
+    demand.interest("AAPL", "b", 0s, t0);
+    demand.interest("AAPL", "a", 0s, t0);       // Heartbeat, not a second reference
+    REQUIRE(demand.interested("AAPL") == 2);
+
+    auto changes = step(demand, t0);
+    REQUIRE(changes == std::vector<Change>{{"AAPL", DemandLevel::Off, DemandLevel::Active}});
+    REQUIRE(demand.active() == 1);
+
+    demand.release("AAPL", "a");
+    REQUIRE(step(demand, t0 + 20s).empty());      // "b" still holds it
+    demand.release("AAPL", "b");
+    demand.release("MSFT", "b");                  // Unknown symbol: ignored
+    REQUIRE(demand.tracked() == 1);
+    REQUIRE(step(demand, t0 + 21s).empty());      // Hysteresis starts
+    changes = step(demand, t0 + 31s);
+    REQUIRE(changes == std::vector<Change>{{"AAPL", DemandLevel::Active, DemandLevel::Idle}});
+    REQUIRE(demand.counters().upgrades == 1);
+    REQUIRE(demand.counters().downgrades == 1);
+}
+
+TEST_CASE("Interest lapses without a heartbeat", "[demand]") {
+    const Clock::time_point t0 = Clock::now();
+    SubscriptionDemand demand(makeConfig());
+    demand.interest("SPY", "a", 5s, t0);
+    demand.interest("QQQ", "a", 600s, t0);        // Capped at maxTtl
+    step(demand, t0);
+
+    step(demand, t0 + 4s);
+    REQUIRE(demand.interested("SPY") == 1);
+    demand.interest("SPY", "a", 5s, t0 + 4s);     // Heartbeat extends it
+    step(demand, t0 + 8s);
+    REQUIRE(demand.interested("SPY") == 1);
+    step(demand, t0 + 9s);
+    REQUIRE(demand.interested("SPY") == 0);
+    REQUIRE(demand.counters().expired == 1);
+    REQUIRE(demand.level("SPY") == DemandLevel::Active);  // Until downgradeAfter
+
+    step(demand, t0 + 119s);
+    REQUIRE(demand.interested("QQQ") == 1);
+    step(demand, t0 + 120s);
+    REQUIRE(demand.interested("QQQ") == 0);
+    REQUIRE(demand.level("SPY") == DemandLevel::Idle);
+}
+
+TEST_CASE("Brief interest gaps and blips do not flap the feed", "[demand]") {
+    const Clock::time_point t0 = Clock::now();
+    DemandConfig config = makeConfig();
+    config.upgradeAfter = 2s;
+    SubscriptionDemand demand(config);
+    demand.track("AAPL");
+    step(demand, t0);
+
+    demand.interest("AAPL", "a", 1s, t0);
+    REQUIRE(step(demand, t0 + 500ms).empty());    // Not interested long enough
+    REQUIRE(step(demand, t0 + 1s).empty());       // Lapsed before the upgrade
+    demand.interest("AAPL", "a", 30s, t0 + 2s);
+    REQUIRE(step(demand, t0 + 2s).empty());
+    auto changes = step(demand, t0 + 4s);
+    REQUIRE(changes == std::vector<Change>{{"AAPL", DemandLevel::Idle, DemandLevel::Active}});
+
+    demand.release("AAPL", "a");
+    REQUIRE(step(demand, t0 + 5s).empty());
+    demand.interest("AAPL", "a", 30s, t0 + 10s);  // Back before downgradeAfter
+    REQUIRE(step(demand, t0 + 10s).empty());
+    demand.release("AAPL", "a");
+    REQUIRE(step(demand, t0 + 11s).empty());
+    REQUIRE(step(demand, t0 + 20s).empty());      // The clock restarted at t0 + 11s
+    REQUIRE(step(demand, t0 + 21s).size() == 1);
+}
+
+TEST_CASE("Pub/Sub subscribers count as interest when enabled", "[demand]") {
+    const Clock::time_point t0 = Clock::now();
+    SubscriptionDemand ignored(makeConfig());
+    ignored.track("AAPL");
+    step(ignored, t0, true);
+    REQUIRE(ignored.level("AAPL") == DemandLevel::Idle);
+
+    DemandConfig config = makeConfig();
+    config.subscribers = true;
+    SubscriptionDemand demand(config);
+    demand.track("AAPL");
+    step(demand, t0, true);
+    REQUIRE(demand.level("AAPL") == DemandLevel::Active);
+    step(demand, t0 + 5s, false);
+    REQUIRE(demand.level("AAPL") == DemandLevel::Active);
+    step(demand, t0 + 15s, false);
+    REQUIRE(demand.level("AAPL") == DemandLevel::Idle);
+}
+
+TEST_CASE("Transitions become unsubscribe / subscribe commands", "[demand]") {
+    DemandConfig config = makeConfig();
+    config.activeFeed = FeedType::TickByTick;
+    SubscriptionDemand demand(config);
+
+    auto commands = demand.commands("AAPL", DemandLevel::Off, DemandLevel::Idle);
+    REQUIRE(commands.size() == 1);
+    REQUIRE(commands[0].action == CommandAction::Subscribe);
+    REQUIRE(commands[0].feed == FeedType::TopOfBook);
+    REQUIRE(commands[0].requestId == "demand");
+
+    commands = demand.commands("AAPL", DemandLevel::Idle, DemandLevel::Active);
+    REQUIRE(commands.size() == 2);
+    REQUIRE(commands[0].action == CommandAction::Unsubscribe);
+    REQUIRE(commands[1].action == CommandAction::Subscribe);
+    REQUIRE(commands[1].feed == FeedType::TickByTick);
+    REQUIRE(commands[1].symbol == "AAPL");
+
+    commands = demand.commands("AAPL", DemandLevel::Active, DemandLevel::Off);
+    REQUIRE(commands.size() == 1);
+    REQUIRE(commands[0].action == CommandAction::Unsubscribe);
+}
@@ -0,0 +1,123 @@
+// test_symbol_partition.cpp - Rendezvous ownership and the partition's subscribe / cancel diffs
+
+#include <catch2/catch_test_macros.hpp>
+#include "SymbolPartition.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::vector<std::string> symbols(std::size_t count) {
+    std::vector<std::string> out;
+    for (std::size_t i = 0; i < count; ++i) {
+        out.push_back("SYM" + std::to_string(i));
+    }
+    return out;
+}
+
+SubscriptionCommand subscribe(const std::string& symbol) {
+    SubscriptionCommand command;
+    command.symbol = symbol;
+    return command;
+}
+
+// Drains the queue: +1 per subscribe, -1 per cancel
+int drain(CommandQueue& queue, std::vector<std::string>* seen = nullptr) {
+    int net = 0;
+    SubscriptionCommand command;
+    while (queue.try_dequeue(command)) {
+        net += command.action == CommandAction::Subscribe ? 1 : -1;
+        if (seen) {
+            seen->push_back(command.symbol);
+        }
+    }
+    return net;
+}
+
+} // namespace
+
+TEST_CASE("Owners spread evenly and a join moves only the joiner's share", "[partition]") {
+    const std::vector<std::string> universe = symbols(3000);
+    const std::vector<std::string> three{"a:1", "b:1", "c:1"};
+    const std::vector<std::string> four{"a:1", "b:1", "c:1", "d:1"};
+    std::size_t counts[3] = {};
+    std::size_t moved = 0;
+    for (const std::string& symbol : universe) {
+        const std::size_t before = partitionOwner(symbol, three);
+        const std::size_t after = partitionOwner(symbol, four);
+        ++counts[before];
+        if (after != before) {
+            REQUIRE(after == 3);  // REASON: Only the new member gains symbols, nothing moves between the others
+            ++moved;
+        }
+    }
+    for (std::size_t count : counts) {
+        REQUIRE(count > 800);
+        REQUIRE(count < 1200);
+    }
+    REQUIRE(moved > 600);
+    REQUIRE(moved < 900);
+    REQUIRE(partitionOwner("AAPL", {}) == 0);
+}
+
+TEST_CASE("Submit enqueues owned symbols only, rebalance diffs the rest", "[partition]") {
+    CommandQueue queue;
+    SymbolPartition partition("a:1", {&queue});
+    const std::vector<std::string> universe = symbols(200);
+
+    // Alone: owns everything
+    for (const std::string& symbol : universe) {
+        partition.submit(subscribe(symbol));
+    }
+    REQUIRE(drain(queue) == 200);
+    REQUIRE(partition.owned() == 200);
+
+    // A second member joins: the symbols it owns are cancelled here
+    const std::size_t moved = partition.rebalance({"a:1", "b:1"});
+    REQUIRE(drain(queue) == -static_cast<int>(moved));
+    REQUIRE(partition.owned() == 200 - moved);
+    REQUIRE(moved > 60);
+    REQUIRE(moved < 140);
+
+    // Commands for the other member's symbols are recorded, not enqueued
+    std::string theirs;
+    for (const std::string& symbol : universe) {
+        if (!partition.owns(symbol)) {
+            theirs = symbol;
+            break;
+        }
+    }
+    partition.submit(subscribe(theirs), "{\"action\":\"subscribe\",\"symbol\":\"" + theirs + "\"}");
+    REQUIRE(drain(queue) == 0);
+    REQUIRE(partition.takeWrites().empty());  // REASON: The owner writes the universe
+
+    // The member leaves: its symbols come back, nothing else is touched
+    REQUIRE(partition.rebalance({"a:1"}) == moved);
+    REQUIRE(drain(queue) == static_cast<int>(moved));
+    REQUIRE(partition.owned() == 200);
+}
+
+TEST_CASE("Symbols learned from the shared universe are subscribed once owned", "[partition]") {
+    CommandQueue queue;
+    SymbolPartition partition("a:1", {&queue});
+    UniverseEntry entry;
+    entry.command = subscribe("NVDA");
+    entry.payload = "{\"action\":\"subscribe\",\"symbol\":\"NVDA\"}";
+    std::vector<std::string> seen;
+    partition.rebalance({"a:1"}, {entry});
+    REQUIRE(drain(queue, &seen) == 1);
+    REQUIRE(seen == std::vector<std::string>{"NVDA"});
+
+    // Unsubscribe by the owner: cancelled here and removed from the shared universe
+    SubscriptionCommand cancel = subscribe("NVDA");
+    cancel.action = CommandAction::Unsubscribe;
+    partition.submit(cancel, "{\"action\":\"unsubscribe\",\"symbol\":\"NVDA\"}");
+    REQUIRE(drain(queue) == -1);
+    const std::vector<UniverseWrite> writes = partition.takeWrites();
+    REQUIRE(writes.size() == 1);
+    REQUIRE(writes[0].symbol == "NVDA");
+    REQUIRE(writes[0].payload.empty());
+    REQUIRE(partition.rebalance({"a:1"}) == 0);
+}
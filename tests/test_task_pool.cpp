@@ -0,0 +1,90 @@
+// test_task_pool.cpp - Unit tests for the background work-stealing pool
+
+#include <catch2/catch_test_macros.hpp>
+#include "TaskPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+TEST_CASE("Submitted jobs run and hand back their results", "[task-pool]") {
+    TaskPool pool(3, {});
+    std::vector<std::future<int>> results;
+    for (int n = 0; n < 100; ++n) {
+        results.push_back(pool.submit([n]() { return n * n; }));
+    }
+    for (int n = 0; n < 100; ++n) {
+        REQUIRE(results[n].get() == n * n);
+    }
+    REQUIRE(pool.threads() == 3);
+
+    std::future<void> failed = pool.submit([]() { throw std::runtime_error("no cache"); });
+    REQUIRE_THROWS_AS(failed.get(), std::runtime_error);
+}
+
+TEST_CASE("Idle threads steal the jobs a busy one queued for itself", "[task-pool]") {
+    TaskPool pool(2, {});
+    std::atomic<int> done{0};
+    // REASON: The parent blocks its thread until its children ran - only a thief can run them
+    std::future<bool> parent = pool.submit([&pool, &done]() {
+        for (int n = 0; n < 8; ++n) {
+            pool.post([&done]() { done.fetch_add(1); });
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (done.load() < 8 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        return done.load() == 8;
+    });
+    REQUIRE(parent.get());
+    REQUIRE(pool.counters().stolen.load() >= 8);
+}
+
+TEST_CASE("Stop runs the queued jobs before joining", "[task-pool]") {
+    std::atomic<int> done{0};
+    TaskPool pool(1, {});
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    pool.post([gate]() { gate.wait(); });
+    for (int n = 0; n < 20; ++n) {
+        pool.post([&done]() { done.fetch_add(1); });
+    }
+    std::thread stopper([&pool]() { pool.stop(); });
+    release.set_value();
+    stopper.join();
+    REQUIRE(done.load() == 20);
+    REQUIRE(pool.counters().executed.load() == 21);
+    pool.stop();  // NOTE: Idempotent - the destructor calls it again
+}
+
+TEST_CASE("A failing job does not take its thread down", "[task-pool]") {
+    TaskPool pool(1, {});
+    pool.post([]() { throw std::runtime_error("disk full"); });
+    REQUIRE(pool.submit([]() { return 7; }).get() == 7);
+}
+
+TEST_CASE("Background cores leave out the pinned ones", "[task-pool]") {
+    const std::vector<int> all = spareCpus({});
+    REQUIRE_FALSE(all.empty());
+    const std::vector<int> spare = spareCpus({all.front(), -1});
+    REQUIRE(spare.size() == all.size() - 1);
+    REQUIRE(std::vector<int>(all.begin() + 1, all.end()) == spare);
+    REQUIRE(spareCpus(all).empty());
+
+    TaskPoolConfig config;
+    std::unique_ptr<TaskPool> pool = makeBackgroundPool(config, all);  // Every core pinned: one floating thread
+    REQUIRE(pool->threads() == 1);
+    REQUIRE(pool->cpus().empty());
+    config.threads = 2;
+    config.cpus = {all.front()};
+    pool = makeBackgroundPool(config, {});
+    REQUIRE(pool->threads() == 2);
+    REQUIRE(pool->cpus() == std::vector<int>{all.front()});
+    REQUIRE(pool->submit([]() { return sched_getcpu(); }).get() == all.front());
+}
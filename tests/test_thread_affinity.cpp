@@ -0,0 +1,79 @@
+// test_thread_affinity.cpp - Thread naming, pinning and inherited placement (EReader hook)
+
+#include <catch2/catch_test_macros.hpp>
+#include "ThreadAffinity.h"
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string currentName() {
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    return name;
+}
+
+int allowedCpu() {
+    cpu_set_t set;
+    REQUIRE(pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0);
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+int pinnedCpuCount() {
+    cpu_set_t set;
+    REQUIRE(pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0);
+    return CPU_COUNT(&set);
+}
+
+} // namespace
+
+TEST_CASE("Thread names are truncated to the kernel limit", "[thread]") {
+    std::thread([]() {
+        nameCurrentThread("tws-worker-0");
+        REQUIRE(currentName() == "tws-worker-0");
+        nameCurrentThread("tws-a-very-long-thread-name");
+        REQUIRE(currentName() == "tws-a-very-long");
+    }).join();
+}
+
+TEST_CASE("Disabled placement leaves the thread alone", "[thread]") {
+    std::thread([]() {
+        const int before = pinnedCpuCount();
+        REQUIRE_FALSE(pinCurrentThread(-1));
+        REQUIRE_FALSE(setCurrentThreadFifo(0));
+        configureCurrentThread("tws-idle", ThreadConfig{});
+        REQUIRE(pinnedCpuCount() == before);
+        REQUIRE(currentName() == "tws-idle");
+    }).join();
+}
+
+TEST_CASE("Threads started inside ScopedThreadConfig inherit its placement", "[thread]") {
+    std::thread([]() {
+        nameCurrentThread("tws-owner");
+        const int before = pinnedCpuCount();
+        ThreadConfig config;
+        config.cpu = allowedCpu();
+        std::string childName;
+        int childCpus = 0;
+        {
+            ScopedThreadConfig placement("tws-reader", config);
+            REQUIRE(pinnedCpuCount() == 1);
+            // REASON: Same path as EReader::start - a thread created by code we don't control
+            std::thread([&]() {
+                childName = currentName();
+                childCpus = pinnedCpuCount();
+            }).join();
+        }
+        REQUIRE(childName == "tws-reader");
+        REQUIRE(childCpus == 1);
+        REQUIRE(currentName() == "tws-owner");
+        REQUIRE(pinnedCpuCount() == before);
+    }).join();
+}
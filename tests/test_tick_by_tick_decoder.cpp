@@ -0,0 +1,260 @@
+// test_tick_by_tick_decoder.cpp - Unit tests for the TICK_BY_TICK / L1 / HISTORICAL_DATA fast-path decoder
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include "TickByTickDecoder.h"
+#include <initializer_list>
+#include <string>
+
+using namespace tws_bridge;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+// Builds a frame body the way TWS sends it: NUL-terminated text fields
+// rawMsgId: msg id as 4-byte big-endian int (server version >= 201)
+std::string frame(int msgId, std::initializer_list<const char*> fields, bool rawMsgId = false) {
+    std::string out;
+    if (rawMsgId) {
+        out.push_back(static_cast<char>((msgId >> 24) & 0xFF));
+        out.push_back(static_cast<char>((msgId >> 16) & 0xFF));
+        out.push_back(static_cast<char>((msgId >> 8) & 0xFF));
+        out.push_back(static_cast<char>(msgId & 0xFF));
+    } else {
+        out += std::to_string(msgId);
+        out.push_back('\0');
+    }
+    for (const char* field : fields) {
+        out += field;
+        out.push_back('\0');
+    }
+    return out;
+}
+
+TickByTickParse parse(const std::string& bytes, TickByTickFields& fields, int serverVersion = 187,
+                      SizeFallback sizeFallback = nullptr) {
+    return parseTickByTick(bytes.data(), bytes.data() + bytes.size(), serverVersion, fields, sizeFallback);
+}
+
+// Stands in for bidTextToQuantity (libbid not linked here), records what reached it
+int g_fallbackCalls = 0;
+bool fakeBid(std::string_view text, std::int64_t& units, int& scale) {
+    ++g_fallbackCalls;
+    if (text == "1E2") {
+        units = 100;
+        scale = 0;
+        return true;
+    }
+    if (text == "5E-1") {
+        units = 5;
+        scale = 1;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("BidAsk ticks are decoded", "[decoder]") {
+    TickByTickFields fields;
+    auto bytes = frame(99, {"1001", "3", "1700000000", "189.25", "189.27", "300", "500", "2"});
+    REQUIRE(parse(bytes, fields) == TickByTickParse::Parsed);
+    REQUIRE(fields.reqId == 1001);
+    REQUIRE(fields.tickType == tick_by_tick::kBidAsk);
+    REQUIRE(fields.time == 1700000000);
+    REQUIRE_THAT(fields.bidPrice, WithinRel(189.25));
+    REQUIRE_THAT(fields.askPrice, WithinRel(189.27));
+    REQUIRE(fields.bidSize == 300);
+    REQUIRE(fields.askSize == 500);
+    REQUIRE(fields.attrMask == 2);
+}
+
+TEST_CASE("AllLast ticks expose exchange as a view into the frame", "[decoder]") {
+    TickByTickFields fields;
+    auto bytes = frame(99, {"7", "2", "1700000001", "42.5", "100", "1", "ARCA", "T"});
+    REQUIRE(parse(bytes, fields) == TickByTickParse::Parsed);
+    REQUIRE(fields.tickType == tick_by_tick::kAllLast);
+    REQUIRE_THAT(fields.price, WithinRel(42.5));
+    REQUIRE(fields.size == 100);
+    REQUIRE(fields.attrMask == 1);
+    REQUIRE(fields.exchange == "ARCA");
+    REQUIRE(fields.specialConditions == "T");
+    REQUIRE(fields.exchange.data() >= bytes.data());
+    REQUIRE(fields.exchange.data() < bytes.data() + bytes.size());
+}
+
+TEST_CASE("Raw 4-byte msg id is read for protobuf-era servers", "[decoder]") {
+    TickByTickFields fields;
+    auto bytes = frame(99, {"5", "4", "1700000002", "10.125"}, true);
+    REQUIRE(parse(bytes, fields, tick_by_tick::kServerVersionRawMsgId) == TickByTickParse::Parsed);
+    REQUIRE(fields.tickType == tick_by_tick::kMidPoint);
+    REQUIRE_THAT(fields.midPoint, WithinRel(10.125));
+}
+
+TEST_CASE("Other messages are left to EDecoder", "[decoder]") {
+    TickByTickFields fields;
+    REQUIRE(parse(frame(9, {"1", "42"}), fields) == TickByTickParse::OtherMessage);
+    REQUIRE(parse(frame(299, {"1"}, true), fields, tick_by_tick::kServerVersionRawMsgId)
+            == TickByTickParse::OtherMessage);  // Protobuf-encoded TICK_BY_TICK
+}
+
+TEST_CASE("Exponent sizes and truncated frames fall back", "[decoder]") {
+    TickByTickFields fields;
+    REQUIRE(parse(frame(99, {"7", "2", "1700000001", "42.5", "1E2", "0", "ARCA", ""}), fields)
+            == TickByTickParse::Fallback);
+    REQUIRE(parse(frame(99, {"1001", "3", "1700000000", "189.25"}), fields) == TickByTickParse::Fallback);
+
+    // Last field missing its NUL terminator
+    auto bytes = frame(99, {"5", "4", "1700000002", "10.125"});
+    bytes.pop_back();
+    REQUIRE(parse(bytes, fields) == TickByTickParse::Fallback);
+}
+
+TEST_CASE("Empty numeric fields decode as zero (atoi/atof semantics)", "[decoder]") {
+    TickByTickFields fields;
+    auto bytes = frame(99, {"1001", "3", "1700000000", "", "189.27", "", "500", ""});
+    REQUIRE(parse(bytes, fields) == TickByTickParse::Parsed);
+    REQUIRE(fields.bidPrice == 0.0);
+    REQUIRE(fields.bidSize == 0);
+    REQUIRE(fields.attrMask == 0);
+}
+
+TEST_CASE("Fractional sizes decode as scaled integers, exponents take the size fallback", "[decoder]") {
+    TickByTickFields fields;
+    g_fallbackCalls = 0;
+
+    auto integral = frame(99, {"1001", "3", "1700000000", "189.25", "189.27", "300", "500", "0"});
+    REQUIRE(parse(integral, fields, 187, &fakeBid) == TickByTickParse::Parsed);
+    REQUIRE(fields.sizeScale == 0);
+
+    auto fractional = frame(99, {"7", "2", "1700000001", "42.5", "0.50", "0", "ARCA", ""});
+    REQUIRE(parse(fractional, fields) == TickByTickParse::Parsed);
+    REQUIRE(fields.size == 5);
+    REQUIRE(fields.sizeScale == 1);
+
+    // BidAsk sizes share the finer scale
+    auto mixed = frame(99, {"1001", "3", "1700000000", "189.25", "189.27", "1.25", "3", "0"});
+    REQUIRE(parse(mixed, fields) == TickByTickParse::Parsed);
+    REQUIRE(fields.bidSize == 125);
+    REQUIRE(fields.askSize == 300);
+    REQUIRE(fields.sizeScale == 2);
+    REQUIRE(g_fallbackCalls == 0);  // No BID call for plain digits
+
+    auto exponent = frame(99, {"1001", "3", "1700000000", "189.25", "189.27", "1E2", "5E-1", "0"});
+    REQUIRE(parse(exponent, fields, 187, &fakeBid) == TickByTickParse::Parsed);
+    REQUIRE(fields.bidSize == 1000);
+    REQUIRE(fields.askSize == 5);
+    REQUIRE(fields.sizeScale == 1);
+    REQUIRE(g_fallbackCalls == 2);
+}
+
+TEST_CASE("Malformed sizes never reach the size fallback", "[decoder]") {
+    TickByTickFields fields;
+    g_fallbackCalls = 0;
+    auto bytes = frame(99, {"7", "2", "1700000001", "42.5", "12abc", "0", "ARCA", ""});
+    REQUIRE(parse(bytes, fields, 187, &fakeBid) == TickByTickParse::Fallback);
+    REQUIRE(g_fallbackCalls == 0);
+
+    auto rejected = frame(99, {"7", "2", "1700000001", "42.5", "1.2.3", "0", "ARCA", ""});
+    REQUIRE(parse(rejected, fields, 187, &fakeBid) == TickByTickParse::Fallback);
+    REQUIRE(g_fallbackCalls == 1);
+}
+
+TEST_CASE("L1 TICK_PRICE carries price, paired size and attributes", "[decoder][l1]") {
+    auto bytes = frame(1, {"6", "42", "1", "189.25", "300", "2"});
+    int msgId = 0;
+    const char* body = nullptr;
+    REQUIRE(readMessageId(bytes.data(), bytes.data() + bytes.size(), 187, msgId, body));
+    REQUIRE(msgId == tick_by_tick::kTickPriceMsgId);
+
+    MarketDataTickFields fields;
+    REQUIRE(parseTickPriceFields(body, bytes.data() + bytes.size(), fields) == TickByTickParse::Parsed);
+    REQUIRE(fields.reqId == 42);
+    REQUIRE(fields.tickType == tick_by_tick::kBid);
+    REQUIRE(fields.hasPrice);
+    REQUIRE_THAT(fields.price, WithinRel(189.25, 1e-12));
+    REQUIRE(fields.size == 300);
+    REQUIRE(fields.attrMask == 2);  // pastLimit
+}
+
+TEST_CASE("L1 TICK_SIZE decodes a standalone size", "[decoder][l1]") {
+    auto bytes = frame(2, {"6", "42", "71", "1E2"}, true);
+    int msgId = 0;
+    const char* body = nullptr;
+    REQUIRE(readMessageId(bytes.data(), bytes.data() + bytes.size(), 201, msgId, body));
+    REQUIRE(msgId == tick_by_tick::kTickSizeMsgId);
+
+    MarketDataTickFields fields;
+    REQUIRE(parseTickSizeFields(body, bytes.data() + bytes.size(), fields) == TickByTickParse::Fallback);
+    REQUIRE(parseTickSizeFields(body, bytes.data() + bytes.size(), fields, &fakeBid) == TickByTickParse::Parsed);
+    REQUIRE_FALSE(fields.hasPrice);
+    REQUIRE(fields.size == 100);
+    REQUIRE(tick_by_tick::liveTickType(fields.tickType) == tick_by_tick::kLastSize);
+}
+
+TEST_CASE("Delayed L1 types map onto their live equivalents", "[decoder][l1]") {
+    REQUIRE(tick_by_tick::liveTickType(66) == tick_by_tick::kBid);
+    REQUIRE(tick_by_tick::liveTickType(67) == tick_by_tick::kAsk);
+    REQUIRE(tick_by_tick::liveTickType(68) == tick_by_tick::kLastPrice);
+    REQUIRE(tick_by_tick::liveTickType(69) == tick_by_tick::kBidSize);
+    REQUIRE(tick_by_tick::liveTickType(70) == tick_by_tick::kAskSize);
+    REQUIRE(tick_by_tick::liveTickType(tick_by_tick::kAsk) == tick_by_tick::kAsk);
+    REQUIRE(tick_by_tick::liveTickType(6) == 6);  // HIGH: not aggregated
+}
+
+TEST_CASE("HISTORICAL_DATA bars decode into reused columns with epoch times", "[decoder][history]") {
+    auto bytes = frame(17, {"4001", "2",
+                            "1760535000", "189.25", "189.5", "189.1", "189.4", "1200", "189.3", "25",
+                            "20251015-13:35:00", "189.4", "189.6", "189.35", "189.55", "800.5", "189.47", "14"});
+    int msgId = 0;
+    const char* body = nullptr;
+    REQUIRE(readMessageId(bytes.data(), bytes.data() + bytes.size(), 200, msgId, body));
+    REQUIRE(msgId == tick_by_tick::kHistoricalDataMsgId);
+
+    BarTimeParser times;
+    HistoricalBarBatch batch;
+    REQUIRE(parseHistoricalDataFields(body, bytes.data() + bytes.size(), 200, times, batch) == TickByTickParse::Parsed);
+    REQUIRE(batch.reqId == 4001);
+    REQUIRE(batch.size() == 2);
+    REQUIRE(batch.time[0] == 1760535000000LL);
+    REQUIRE(batch.time[1] == 1760535300000LL);
+    REQUIRE_THAT(batch.high[0], WithinRel(189.5, 1e-12));
+    REQUIRE_THAT(batch.close[1], WithinRel(189.55, 1e-12));
+    REQUIRE(batch.volume[0] == 1200);
+    REQUIRE(batch.volume[1] == 801);  // Whole shares, half away from zero (decimalToShares)
+    REQUIRE_THAT(batch.wap[1], WithinRel(189.47, 1e-12));
+    REQUIRE(batch.count[0] == 25);
+
+    // Next message reuses the columns: no regrowth for a batch that fits
+    const double* columns = batch.open.data();
+    auto shorter = frame(17, {"4002", "1", "1760535600", "1", "2", "0.5", "1.5", "10", "1.2", "3"});
+    REQUIRE(readMessageId(shorter.data(), shorter.data() + shorter.size(), 200, msgId, body));
+    REQUIRE(parseHistoricalDataFields(body, shorter.data() + shorter.size(), 200, times, batch)
+            == TickByTickParse::Parsed);
+    REQUIRE(batch.reqId == 4002);
+    REQUIRE(batch.size() == 1);
+    REQUIRE(batch.open.data() == columns);
+}
+
+TEST_CASE("HISTORICAL_DATA falls back on old servers, unreadable times and truncated bars", "[decoder][history]") {
+    BarTimeParser times;
+    HistoricalBarBatch batch;
+    auto bytes = frame(17, {"4001", "1", "1760535000", "1", "2", "0.5", "1.5", "10", "1.2", "3"});
+    int msgId = 0;
+    const char* body = nullptr;
+    REQUIRE(readMessageId(bytes.data(), bytes.data() + bytes.size(), 187, msgId, body));
+    // REASON: Before MIN_SERVER_VER_HISTORICAL_DATA_END the layout has dates + hasGaps, EDecoder handles it
+    REQUIRE(parseHistoricalDataFields(body, bytes.data() + bytes.size(), 187, times, batch) == TickByTickParse::Fallback);
+
+    auto badTime = frame(17, {"4001", "1", "yesterday", "1", "2", "0.5", "1.5", "10", "1.2", "3"});
+    REQUIRE(readMessageId(badTime.data(), badTime.data() + badTime.size(), 200, msgId, body));
+    REQUIRE(parseHistoricalDataFields(body, badTime.data() + badTime.size(), 200, times, batch)
+            == TickByTickParse::Fallback);
+    REQUIRE(batch.size() == 0);
+
+    auto truncated = frame(17, {"4001", "2", "1760535000", "1", "2", "0.5", "1.5", "10", "1.2", "3", "1760535300"});
+    REQUIRE(readMessageId(truncated.data(), truncated.data() + truncated.size(), 200, msgId, body));
+    REQUIRE(parseHistoricalDataFields(body, truncated.data() + truncated.size(), 200, times, batch)
+            == TickByTickParse::Fallback);
+    REQUIRE(batch.size() == 0);
+}
@@ -0,0 +1,49 @@
+// test_tick_filter.cpp - Bad-tick reasons, the rolling spread band and outlier confirmation
+
+#include <catch2/catch_test_macros.hpp>
+#include "TickFilter.h"
+#include <cmath>
+
+using namespace tws_bridge;
+
+TEST_CASE("Zero, crossed and locked quotes fail in that order", "[tick-filter]") {
+    TickFilterConfig config;
+    TickBand band;
+    REQUIRE(band.screenQuote(config, -1.0, 100.0) == BadTick::ZeroPrice);
+    REQUIRE(band.screenQuote(config, 0.0, 0.0) == BadTick::ZeroPrice);
+    REQUIRE(band.screenQuote(config, 100.05, 100.0) == BadTick::Crossed);
+    REQUIRE(band.screenQuote(config, 100.0, 100.0) == BadTick::Locked);
+    config.rejectLocked = false;
+    REQUIRE(band.screenQuote(config, 100.0, 100.0) == BadTick::None);
+    REQUIRE(band.screenTrade(config, 0.0) == BadTick::ZeroPrice);
+    REQUIRE(band.screenTrade(config, 100.0) == BadTick::None);
+}
+
+TEST_CASE("Good quotes set the mid and the rolling spread", "[tick-filter]") {
+    TickFilterConfig config;
+    config.spreadWindow = 3;  // alpha 0.5
+    TickBand band;
+    REQUIRE(band.screenQuote(config, 100.00, 100.02) == BadTick::None);
+    REQUIRE(std::abs(band.mid() - 100.01) < 1e-12);
+    REQUIRE(std::abs(band.spread() - 0.02) < 1e-12);
+    REQUIRE(band.screenQuote(config, 100.00, 100.04) == BadTick::None);
+    REQUIRE(std::abs(band.spread() - 0.03) < 1e-12);
+    REQUIRE(band.screenQuote(config, 100.05, 100.0) == BadTick::Crossed);
+    REQUIRE(std::abs(band.mid() - 100.02) < 1e-12);  // Rejected quotes leave the reference alone
+}
+
+TEST_CASE("Outliers beyond N spreads fail until confirmed", "[tick-filter]") {
+    TickFilterConfig config;
+    config.outlierSpreads = 10.0;
+    config.outlierConfirm = 3;
+    TickBand band;
+    REQUIRE(band.screenQuote(config, 100.00, 100.02) == BadTick::None);
+    REQUIRE(band.screenTrade(config, 100.15) == BadTick::None);   // 7 spreads
+    REQUIRE(band.screenTrade(config, 101.00) == BadTick::Outlier);
+    REQUIRE(band.screenTrade(config, 100.01) == BadTick::None);   // Run broken
+    REQUIRE(band.screenQuote(config, 105.00, 105.02) == BadTick::Outlier);
+    REQUIRE(band.screenQuote(config, 105.00, 105.02) == BadTick::Outlier);
+    REQUIRE(band.screenQuote(config, 105.00, 105.02) == BadTick::None);  // Third in a row: the new level
+    REQUIRE(std::abs(band.mid() - 105.01) < 1e-12);
+    REQUIRE(band.screenTrade(config, 105.01) == BadTick::None);
+}
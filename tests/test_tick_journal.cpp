@@ -0,0 +1,277 @@
+// test_tick_journal.cpp - Journal round trip, segment rotation, reader validation
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "TickJournal.h"
+#include "JournalTestSupport.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::journal_test;
+
+namespace {
+
+TickUpdate bidAsk(SlotId slot, std::int64_t timestamp, double bid) {
+    TickUpdate update;
+    update.slot = slot;
+    update.type = TickUpdateType::BidAsk;
+    update.timestamp = timestamp;
+    update.bidAsk.bidPrice = bid;
+    update.bidAsk.askPrice = bid + 0.02;
+    update.bidAsk.bidSize = 100;
+    update.bidAsk.askSize = 200;
+    update.bidAsk.stamps.ingestNs = 12345;  // Not journaled
+    return update;
+}
+
+std::vector<JournalEntry> readAll(const std::string& directory) {
+    std::vector<JournalEntry> entries;
+    TickJournalReader reader;
+    for (const std::string& path : TickJournalReader::segments(directory)) {
+        REQUIRE(reader.open(path));
+        JournalEntry entry;
+        while (reader.next(entry)) {
+            entries.push_back(entry);
+        }
+    }
+    return entries;
+}
+
+} // namespace
+
+TEST_CASE("Journal round trip keeps every update type", "[journal]") {
+    TempDirectory directory("roundtrip");
+    InstrumentRegistry registry(16);
+    const SlotId aapl = registry.registerInstrument("AAPL", 1);
+    const SlotId msft = registry.registerInstrument("MSFT", 2);
+
+    JournalConfig config;
+    config.directory = directory.path;
+    config.segmentBytes = 1 << 20;
+    TickJournal journal(registry, config);
+    REQUIRE(journal.start());
+
+    journal.append(bidAsk(aapl, 1700000000000, 171.55));
+    TickUpdate trade;
+    trade.slot = msft;
+    trade.type = TickUpdateType::AllLast;
+    trade.flags = TickFlags::PastLimit;
+    trade.timestamp = 1700000000001;
+    trade.allLast.price = 370.10;
+    trade.allLast.size = 300;
+    journal.append(trade);
+    TickUpdate bar;
+    bar.slot = aapl;
+    bar.type = TickUpdateType::Bar;
+    bar.aux = 42;
+    bar.timestamp = 1700000000002;
+    bar.bar.open = 1.0;
+    bar.bar.wap = 6.0;
+    bar.bar.volume = 7;
+    journal.append(bar);
+    TickUpdate end;
+    end.slot = aapl;
+    end.type = TickUpdateType::HistoryEnd;
+    journal.append(end);
+    journal.stop();
+
+    REQUIRE(journal.counters().records.load() == 4);
+    REQUIRE(journal.counters().dropped.load() == 0);
+    const std::vector<std::string> segments = TickJournalReader::segments(directory.path, journal.session());
+    REQUIRE(segments.size() == 1);  // REASON: The unused spare is removed on stop()
+    REQUIRE(std::filesystem::file_size(segments[0]) < 1024);  // Truncated to its records
+
+    const std::vector<JournalEntry> entries = readAll(directory.path);
+    REQUIRE(entries.size() == 6);  // 2 Symbol + 4 Tick
+    REQUIRE(entries[0].kind == JournalRecordKind::Symbol);
+    REQUIRE(entries[0].slot == aapl);
+    REQUIRE(entries[0].symbol == "AAPL");
+    REQUIRE(entries[1].kind == JournalRecordKind::Tick);
+    REQUIRE(entries[1].update.type == TickUpdateType::BidAsk);
+    REQUIRE(entries[1].update.bidAsk.bidPrice == 171.55);
+    REQUIRE(entries[1].update.bidAsk.askSize == 200);
+    REQUIRE(entries[1].update.bidAsk.stamps.ingestNs == 0);
+    REQUIRE(entries[1].receiveNs > 0);
+    REQUIRE(entries[2].symbol == "MSFT");
+    REQUIRE(entries[3].update.allLast.price == 370.10);
+    REQUIRE(entries[3].update.pastLimit());
+    REQUIRE(entries[4].update.type == TickUpdateType::Bar);
+    REQUIRE(entries[4].update.aux == 42);
+    REQUIRE(entries[4].update.bar.wap == 6.0);
+    REQUIRE(entries[4].update.bar.volume == 7);
+    REQUIRE(entries[5].update.type == TickUpdateType::HistoryEnd);
+    REQUIRE(entries[1].receiveNs <= entries[5].receiveNs);
+}
+
+TEST_CASE("Full segments rotate and each starts with its symbols", "[journal]") {
+    TempDirectory directory("rotate");
+    InstrumentRegistry registry(16);
+    const SlotId slot = registry.registerInstrument("SPY", 1);
+
+    JournalConfig config;
+    config.directory = directory.path;
+    config.segmentBytes = 0;  // Minimum (a few pages)
+    TickJournal journal(registry, config);
+    REQUIRE(journal.start());
+    constexpr int kTicks = 2000;
+    for (int i = 0; i < kTicks; ++i) {
+        journal.append(bidAsk(slot, 1700000000000 + i, 100.0 + i));
+    }
+    journal.stop();
+
+    REQUIRE(journal.counters().dropped.load() == 0);
+    const std::vector<std::string> segments = TickJournalReader::segments(directory.path);
+    REQUIRE(segments.size() > 3);
+
+    int ticks = 0;
+    TickJournalReader reader;
+    for (std::size_t i = 0; i < segments.size(); ++i) {
+        REQUIRE(reader.open(segments[i]));
+        REQUIRE(reader.header().segmentIndex == i);
+        JournalEntry entry;
+        REQUIRE(reader.next(entry));
+        REQUIRE(entry.kind == JournalRecordKind::Symbol);
+        REQUIRE(entry.symbol == "SPY");
+        while (reader.next(entry)) {
+            REQUIRE(entry.kind == JournalRecordKind::Tick);
+            REQUIRE(entry.update.timestamp == 1700000000000 + ticks);  // In order across segments
+            ++ticks;
+        }
+    }
+    REQUIRE(ticks == kTicks);
+}
+
+TEST_CASE("Active segment is readable up to its zero-filled tail", "[journal]") {
+    TempDirectory directory("active");
+    InstrumentRegistry registry(16);
+    const SlotId slot = registry.registerInstrument("QQQ", 1);
+
+    JournalConfig config;
+    config.directory = directory.path;
+    TickJournal journal(registry, config);
+    REQUIRE(journal.start());
+    journal.append(bidAsk(slot, 1, 1.0));
+    journal.append(bidAsk(slot, 2, 2.0));
+
+    // REASON: Same state as a crashed session - preallocated file, records, then zeros
+    TickJournalReader reader;
+    REQUIRE(reader.open(TickJournalReader::segments(directory.path).front()));
+    JournalEntry entry;
+    int ticks = 0;
+    while (reader.next(entry)) {
+        ticks += entry.kind == JournalRecordKind::Tick ? 1 : 0;
+    }
+    REQUIRE(ticks == 2);
+    journal.stop();
+}
+
+TEST_CASE("Version 1 trades read back without exchange and conditions", "[journal]") {
+    TempDirectory directory("legacy");
+    JournalSegmentHeader segment{};
+    std::memcpy(segment.magic, kJournalMagic, sizeof(kJournalMagic));
+    segment.version = kJournalLegacyVersion;
+    std::string bytes(reinterpret_cast<const char*>(&segment), sizeof(segment));
+
+    JournalEntry symbol;
+    symbol.kind = JournalRecordKind::Symbol;
+    symbol.slot = 3;
+    symbol.symbol = "MSFT";
+    appendJournalRecord(bytes, symbol);
+    // REASON: Written by hand - a version 1 AllLast record ends after price + size (32-byte payload)
+    TickUpdate trade;
+    trade.slot = 3;
+    trade.type = TickUpdateType::AllLast;
+    trade.timestamp = 1700000000001;
+    trade.allLast.price = 370.10;
+    trade.allLast.size = 300;
+    trade.allLast.exchange = 0xAB;  // Stands in for the padding byte a version 1 writer left there
+    const JournalRecordHeader header{JournalRecordKind::Tick,
+                                     static_cast<std::uint16_t>(journal_detail::kLegacyAllLastBytes), 0, 42};
+    bytes.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes.append(reinterpret_cast<const char*>(&trade), journal_detail::kLegacyAllLastBytes);
+    appendJournalRecord(bytes, JournalEntry{JournalRecordKind::Tick, 43, bidAsk(3, 1700000000002, 370.0), 0, {}});
+    const std::string path = directory.path + "/20231114T221320000Z-000000" + kJournalExtension;
+    std::ofstream(path, std::ios::binary) << bytes;
+
+    const std::vector<JournalEntry> entries = readAll(directory.path);
+    REQUIRE(entries.size() == 3);
+    REQUIRE(entries[0].symbol == "MSFT");
+    const TickUpdate& read = entries[1].update;
+    REQUIRE(read.type == TickUpdateType::AllLast);
+    REQUIRE(entries[1].receiveNs == 42);
+    REQUIRE(read.timestamp == 1700000000001);
+    REQUIRE(read.allLast.price == 370.10);
+    REQUIRE(read.allLast.size == 300);
+    REQUIRE(read.allLast.exchange == kUnknownExchange);
+    REQUIRE(read.allLast.conditions == 0);
+    REQUIRE(entries[2].update.bidAsk.bidPrice == 370.0);
+}
+
+TEST_CASE("Reader rejects files that are not journal segments", "[journal]") {
+    TempDirectory directory("invalid");
+    const std::string path = directory.path + "/bogus" + kJournalExtension;
+    std::ofstream(path) << std::string(128, 'x');
+
+    TickJournalReader reader;
+    REQUIRE_FALSE(reader.open(path));
+    REQUIRE_FALSE(reader.open(directory.path + "/missing" + kJournalExtension));
+}
+
+TEST_CASE("Compressed segments round trip and rotate on whole blocks", "[journal]") {
+    TempDirectory directory("compressed");
+    InstrumentRegistry registry(16);
+    const SlotId aapl = registry.registerInstrument("AAPL", 1);
+    const SlotId msft = registry.registerInstrument("MSFT", 2);
+
+    JournalConfig config;
+    config.directory = directory.path;
+    config.format = JournalFormat::Compressed;
+    config.blockBytes = 4096;
+    config.segmentBytes = 0;  // Minimum - a handful of blocks per segment
+    TickJournal journal(registry, config);
+    REQUIRE(journal.start());
+    constexpr int kTicks = 20000;
+    for (int i = 0; i < kTicks; ++i) {
+        TickUpdate update = bidAsk(i % 2 == 0 ? aapl : msft, 1700000000000 + i, 171.55 + (i % 7) * 0.01);
+        update.bidAsk.stamps.receiveNs = 1700000000000000000 + i * 1000;
+        journal.append(update);
+    }
+    journal.stop();
+
+    REQUIRE(journal.counters().records.load() == kTicks);
+    REQUIRE(journal.counters().dropped.load() == 0);
+    REQUIRE(journal.counters().blocks.load() > 1);
+    const std::vector<std::string> segments = TickJournalReader::segments(directory.path);
+    REQUIRE(segments.size() > 1);
+    std::uintmax_t bytes = 0;
+    for (const std::string& path : segments) {
+        bytes += std::filesystem::file_size(path);
+    }
+    REQUIRE(bytes < kTicks * 56 / 4);  // NOTE: Raw records are 56 bytes per BidAsk
+
+    int ticks = 0;
+    TickJournalReader reader;
+    for (const std::string& path : segments) {
+        REQUIRE(reader.open(path));
+        REQUIRE(reader.compressed());
+        JournalEntry entry;
+        REQUIRE(reader.next(entry));
+        REQUIRE(entry.kind == JournalRecordKind::Symbol);  // REASON: Every block announces its slots
+        while (reader.next(entry)) {
+            if (entry.kind != JournalRecordKind::Tick) {
+                continue;
+            }
+            REQUIRE(entry.update.slot == (ticks % 2 == 0 ? aapl : msft));
+            REQUIRE(entry.update.timestamp == 1700000000000 + ticks);
+            REQUIRE(entry.update.bidAsk.bidPrice == 171.55 + (ticks % 7) * 0.01);
+            REQUIRE(entry.update.bidAsk.askSize == 200);
+            REQUIRE(entry.receiveNs == 1700000000000000000 + ticks * 1000);
+            ++ticks;
+        }
+    }
+    REQUIRE(ticks == kTicks);
+}
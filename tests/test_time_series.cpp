@@ -0,0 +1,76 @@
+// test_time_series.cpp - Unit tests for the TS.MADD batch and per-slot series sampling
+
+#include <catch2/catch_test_macros.hpp>
+#include "TimeSeries.h"
+#include <chrono>
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+InstrumentState quote(double bid, double ask, long timestamp) {
+    InstrumentState state;
+    state.bidPrice = bid;
+    state.askPrice = ask;
+    state.quoteTimestamp = timestamp;
+    state.hasQuote = true;
+    return state;
+}
+
+} // namespace
+
+TEST_CASE("A batch lists key, timestamp and value of every sample", "[series]") {
+    TimeSeriesBatch batch;
+    REQUIRE(batch.empty());
+    batch.add("TWS:TS:SPY:", SeriesField::Bid, 1700000000000, 450.25);
+    batch.add("TWS:TS:QQQ:", SeriesField::Volume, 1700000001000, 300);
+    REQUIRE(batch.samples() == 2);
+    REQUIRE(batch.payload() == "TWS:TS:SPY:bid\n1700000000000\n450.25\nTWS:TS:QQQ:volume\n1700000001000\n300");
+
+    batch.clear();
+    REQUIRE(batch.empty());
+    REQUIRE(batch.payload().empty());
+}
+
+TEST_CASE("Prices are sampled when they move", "[series]") {
+    TimeSeriesTrack track;
+    TimeSeriesBatch batch;
+    REQUIRE(track.collect(quote(100.0, 100.5, 1000), "S:", batch) == 2);
+    REQUIRE(batch.payload() == "S:bid\n1000\n100\nS:ask\n1000\n100.5");
+
+    batch.clear();
+    REQUIRE(track.collect(quote(100.0, 100.5, 2000), "S:", batch) == 0);
+    REQUIRE(track.collect(quote(100.0, 100.75, 3000), "S:", batch) == 1);
+    REQUIRE(batch.payload() == "S:ask\n3000\n100.75");
+}
+
+TEST_CASE("Volume sums every trade since the last sample", "[series]") {
+    TimeSeriesTrack track;
+    TimeSeriesBatch batch;
+    InstrumentState state;
+    state.lastPrice = 50.0;
+    state.tradeTimestamp = 5000;
+    state.hasTrade = true;
+    track.onTrade(100);
+    track.onTrade(200);  // NOTE: Conflated into the same snapshot
+    REQUIRE(track.collect(state, "S:", batch) == 2);
+    REQUIRE(batch.payload() == "S:last\n5000\n50\nS:volume\n5000\n300");
+
+    batch.clear();
+    REQUIRE(track.collect(state, "S:", batch) == 0);  // REASON: Republished snapshot, no new trade
+
+    track.onTrade(10);
+    track.skip();  // Series not ready yet
+    state.tradeTimestamp = 6000;
+    REQUIRE(track.collect(state, "S:", batch) == 1);
+    REQUIRE(batch.payload() == "S:last\n6000\n50");
+}
+
+TEST_CASE("Compaction keys carry the bucket in its largest whole unit", "[series]") {
+    REQUIRE(bucketLabel(std::chrono::milliseconds(500)) == "500ms");
+    REQUIRE(bucketLabel(std::chrono::seconds(30)) == "30s");
+    REQUIRE(bucketLabel(std::chrono::minutes(1)) == "1m");
+    REQUIRE(bucketLabel(std::chrono::minutes(90)) == "90m");
+    REQUIRE(bucketLabel(std::chrono::hours(48)) == "2d");
+}
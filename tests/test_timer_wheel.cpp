@@ -0,0 +1,117 @@
+// test_timer_wheel.cpp - Hierarchical timer wheel: ordering, cascades, cancel, re-arm from callbacks
+
+#include <catch2/catch_test_macros.hpp>
+#include "TimerWheel.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace tws_bridge;
+using Clock = TimerWheel::Clock;
+using std::chrono::milliseconds;
+
+TEST_CASE("Timers fire at their deadline, never early", "[timer_wheel]") {
+    const Clock::time_point start{};
+    TimerWheel wheel(start);
+    wheel.arm(start + milliseconds(5), 1);
+    wheel.arm(start + std::chrono::microseconds(2500), 2);  // Rounds up to tick 3
+    REQUIRE(wheel.size() == 2);
+    REQUIRE(wheel.nextDeadline() == start + milliseconds(3));
+
+    std::vector<std::uint32_t> fired;
+    auto record = [&fired](std::uint32_t tag) { fired.push_back(tag); };
+    REQUIRE(wheel.advance(start + milliseconds(2), record) == 0);
+    REQUIRE(wheel.advance(start + milliseconds(4), record) == 1);
+    REQUIRE(wheel.advance(start + milliseconds(100), record) == 1);
+    REQUIRE(fired == std::vector<std::uint32_t>{2, 1});
+    REQUIRE(wheel.empty());
+    REQUIRE(wheel.nextDeadline() == Clock::time_point::max());
+}
+
+TEST_CASE("Far deadlines cascade through every level", "[timer_wheel]") {
+    const Clock::time_point start{};
+    TimerWheel wheel(start);
+    const std::vector<std::int64_t> deadlinesMs = {63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000,
+                                                   16777215, 16777216, 40000000};
+    for (std::size_t i = 0; i < deadlinesMs.size(); ++i) {
+        wheel.arm(start + milliseconds(deadlinesMs[i]), static_cast<std::uint32_t>(i));
+    }
+    for (std::size_t i = 0; i < deadlinesMs.size(); ++i) {
+        std::vector<std::uint32_t> fired;
+        wheel.advance(start + milliseconds(deadlinesMs[i] - 1), [&fired](std::uint32_t tag) { fired.push_back(tag); });
+        REQUIRE(fired.empty());
+        REQUIRE(wheel.nextDeadline() <= start + milliseconds(deadlinesMs[i]));
+        wheel.advance(start + milliseconds(deadlinesMs[i]), [&fired](std::uint32_t tag) { fired.push_back(tag); });
+        REQUIRE(fired == std::vector<std::uint32_t>{static_cast<std::uint32_t>(i)});
+    }
+}
+
+TEST_CASE("Random deadlines fire in order at the right tick", "[timer_wheel]") {
+    const Clock::time_point start{};
+    TimerWheel wheel(start);
+    std::mt19937 random(7);
+    std::vector<std::int64_t> deadlines;
+    for (std::uint32_t i = 0; i < 2000; ++i) {
+        deadlines.push_back(static_cast<std::int64_t>(random() % 600000));
+        wheel.arm(start + milliseconds(deadlines.back()), i);
+    }
+    std::int64_t nowMs = 0;
+    std::int64_t lastMs = -1;
+    std::size_t fired = 0;
+    while (!wheel.empty()) {
+        // REASON: Irregular steps, like a loop that sometimes stalls
+        nowMs += static_cast<std::int64_t>(random() % 900) + 1;
+        wheel.advance(start + milliseconds(nowMs), [&](std::uint32_t tag) {
+            REQUIRE(deadlines[tag] <= nowMs);
+            REQUIRE(deadlines[tag] > nowMs - 901);
+            REQUIRE(deadlines[tag] >= lastMs);
+            lastMs = deadlines[tag];
+            ++fired;
+        });
+    }
+    REQUIRE(fired == deadlines.size());
+}
+
+TEST_CASE("Cancel and re-arm from the callback", "[timer_wheel]") {
+    const Clock::time_point start{};
+    TimerWheel wheel(start);
+    TimerHandle dropped = wheel.arm(start + milliseconds(10), 1);
+    REQUIRE(wheel.cancel(dropped));
+    REQUIRE_FALSE(wheel.cancel(dropped));
+    REQUIRE_FALSE(wheel.armed(dropped));
+
+    // Periodic timer re-armed by its callback; it also cancels a timer due in the same tick (armed later,
+    // so it fires later)
+    TimerHandle periodic = wheel.arm(start + milliseconds(20), 3);
+    TimerHandle sibling = wheel.arm(start + milliseconds(20), 2);
+    int periods = 0;
+    Clock::time_point now = start;
+    auto onExpired = [&](std::uint32_t tag) {
+        REQUIRE(tag == 3);
+        ++periods;
+        wheel.cancel(sibling);
+        periodic = wheel.arm(now + milliseconds(20), 3);
+    };
+    for (int step = 1; step <= 10; ++step) {
+        now = start + milliseconds(20 * step);
+        wheel.advance(now, onExpired);
+    }
+    REQUIRE(periods == 10);
+    REQUIRE(wheel.size() == 1);
+    REQUIRE(wheel.armed(periodic));
+
+    // Handles of recycled nodes stay invalid
+    TimerHandle reused = wheel.arm(now + milliseconds(1), 4);
+    REQUIRE_FALSE(wheel.armed(dropped));
+    REQUIRE(wheel.cancel(reused));
+}
+
+TEST_CASE("Deadlines in the past fire on the next advance", "[timer_wheel]") {
+    const Clock::time_point start{};
+    TimerWheel wheel(start);
+    std::size_t fired = wheel.advance(start + milliseconds(50), [](std::uint32_t) {});
+    REQUIRE(fired == 0);
+    wheel.arm(start + milliseconds(10), 1);
+    REQUIRE(wheel.advance(start + milliseconds(50), [](std::uint32_t) {}) == 0);
+    REQUIRE(wheel.advance(start + milliseconds(51), [](std::uint32_t) {}) == 1);
+}
@@ -0,0 +1,136 @@
+// test_top_movers.cpp - Per-worker movers boards, the cross-worker merge and the TWS:MOVERS message
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "Serialization.h"
+#include "TopMovers.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+constexpr std::int64_t kSessionStart = 1700038800000;  // 2023-11-15 09:00 UTC, a session boundary at 09:00
+constexpr std::chrono::minutes kReset{9 * 60};
+
+} // namespace
+
+TEST_CASE("Boards rank change from the session's first trade and session volume", "[movers]") {
+    MoverBoard board(8, kReset);
+    const std::int64_t t = kSessionStart + 1000;
+    board.onTrade(0, t, 100.0, 10);
+    board.onTrade(1, t, 50.0, 500);
+    board.onTrade(2, t, 20.0, 40);
+    board.onTrade(0, t + 1, 110.0, 10);   // +10%
+    board.onTrade(1, t + 2, 45.0, 100);   // -10%
+    board.onTrade(2, t + 3, 21.0, 40);    // +5%
+    REQUIRE(board.due(t + 4));
+
+    MoverRanking ranking;
+    board.top(2, t + 4, ranking);
+    REQUIRE_FALSE(board.due(t + 4));
+    REQUIRE(ranking.gainers.size() == 2);
+    REQUIRE(ranking.gainers[0].slot == 0);
+    REQUIRE(ranking.gainers[0].change == 10.0);
+    REQUIRE(ranking.gainers[0].last == 110.0);
+    REQUIRE(ranking.gainers[1].slot == 2);
+    REQUIRE(ranking.losers.size() == 1);    // NOTE: Only symbols that are down
+    REQUIRE(ranking.losers[0].slot == 1);
+    REQUIRE(ranking.losers[0].change == -10.0);
+    REQUIRE(ranking.volume[0].slot == 1);
+    REQUIRE(ranking.volume[0].volume == 600);
+    REQUIRE(ranking.volume[1].slot == 2);
+
+    board.onTrade(2, t + 5, 30.0, 1000);  // +50%, now the volume leader as well
+    board.top(2, t + 6, ranking);
+    REQUIRE(ranking.gainers[0].slot == 2);
+    REQUIRE(ranking.volume[0].slot == 2);
+    REQUIRE(ranking.volume[0].volume == 1080);
+}
+
+TEST_CASE("A new session restarts the reference and retires yesterday's rows", "[movers]") {
+    MoverBoard board(4, kReset);
+    constexpr std::int64_t kDay = 86400000;
+    board.onTrade(0, kSessionStart + 1000, 100.0, 10);
+    board.onTrade(0, kSessionStart + 2000, 120.0, 10);
+    board.onTrade(1, kSessionStart + 3000, 10.0, 10);
+    board.onTrade(1, kSessionStart + 4000, 11.0, 10);
+    MoverRanking ranking;
+    board.top(5, kSessionStart + 5000, ranking);
+    REQUIRE(ranking.gainers.size() == 2);
+
+    REQUIRE(board.due(kSessionStart + kDay));  // REASON: Yesterday's posted rows must be replaced
+    board.top(5, kSessionStart + kDay, ranking);
+    REQUIRE(ranking.gainers.empty());
+    REQUIRE(ranking.volume.empty());
+
+    board.onTrade(0, kSessionStart + kDay + 1000, 90.0, 5);  // Today's first trade: the new reference
+    board.onTrade(0, kSessionStart + kDay + 2000, 99.0, 5);
+    board.top(5, kSessionStart + kDay + 3000, ranking);
+    REQUIRE(ranking.gainers.size() == 1);
+    REQUIRE(ranking.gainers[0].slot == 0);
+    REQUIRE(ranking.gainers[0].change == 10.0);
+    REQUIRE(ranking.volume[0].volume == 10);
+}
+
+TEST_CASE("Adopted slots move between boards with their session state", "[movers]") {
+    MoverBoard from(4, kReset);
+    MoverBoard to(4, kReset);
+    const std::int64_t t = kSessionStart + 1000;
+    from.onTrade(3, t, 10.0, 100);
+    from.onTrade(3, t + 1, 12.0, 100);
+    MoverRanking ranking;
+    from.top(5, t + 2, ranking);
+
+    to.adopt(from, 3);
+    REQUIRE(from.due(t + 3));
+    from.top(5, t + 3, ranking);
+    REQUIRE(ranking.gainers.empty());
+    to.onTrade(3, t + 4, 13.0, 100);
+    to.top(5, t + 5, ranking);
+    REQUIRE(ranking.gainers.size() == 1);
+    REQUIRE(ranking.gainers[0].change == 30.0);  // Reference kept from the old owner
+    REQUIRE(ranking.volume[0].volume == 300);
+}
+
+TEST_CASE("The exchange merges every shard's rows into one top n", "[movers]") {
+    MoversExchange exchange(2);
+    MoverRanking first;
+    first.gainers = {{0, 11.0, 10.0, 100}, {1, 10.5, 5.0, 50}};
+    first.volume = {{0, 11.0, 10.0, 100}, {1, 10.5, 5.0, 50}};
+    MoverRanking second;
+    second.gainers = {{2, 30.0, 7.0, 900}, {0, 11.0, 9.0, 90}};  // Slot 0 mid-migration: the better row wins
+    second.losers = {{3, 8.0, -2.0, 10}};
+    second.volume = {{2, 30.0, 7.0, 900}};
+    exchange.post(0, first);
+    exchange.post(1, second);
+    REQUIRE(first.gainers.empty());  // NOTE: Handed back the shard's previous (empty) post
+
+    MoverRanking merged;
+    exchange.merge(2, merged);
+    REQUIRE(merged.gainers.size() == 2);
+    REQUIRE(merged.gainers[0].slot == 0);
+    REQUIRE(merged.gainers[0].change == 10.0);
+    REQUIRE(merged.gainers[1].slot == 2);
+    REQUIRE(merged.losers.size() == 1);
+    REQUIRE(merged.volume[0].slot == 2);
+    REQUIRE(merged.volume[1].slot == 0);
+}
+
+TEST_CASE("Rankings serialize as one movers message", "[movers]") {
+    InstrumentRegistry registry(4);
+    const SlotId aapl = registry.registerInstrument("AAPL");
+    const SlotId msft = registry.registerInstrument("MSFT");
+    MoverRanking ranking;
+    ranking.gainers = {{aapl, 110.5, 2.5, 1000}};
+    ranking.losers = {{msft, 300.0, -1.25, 200}};
+    ranking.volume = {{aapl, 110.5, 2.5, 1000}};
+    JsonBuffer out;
+    serializeMovers(ranking, registry, 1700000000000, out);
+    REQUIRE(out.str() == "{\"type\":\"movers\",\"timestamp\":1700000000000,"
+                         "\"gainers\":[{\"instrument\":\"AAPL\",\"last\":110.5,\"change\":2.5,\"volume\":1000}],"
+                         "\"losers\":[{\"instrument\":\"MSFT\",\"last\":300.0,\"change\":-1.25,\"volume\":200}],"
+                         "\"volume\":[{\"instrument\":\"AAPL\",\"last\":110.5,\"change\":2.5,\"volume\":1000}]}");
+}
@@ -0,0 +1,72 @@
+// test_trace_export.cpp - Trace-event file: stage spans, flow arrows, async queue slices
+
+#include <catch2/catch_test_macros.hpp>
+#include "TraceExport.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+std::size_t occurrences(const std::string& text, const std::string& needle) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Trace ids are never 0", "[trace]") {
+    TraceExport trace(TraceConfig{}, nullptr);
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(trace.nextTraceId() != 0);
+    }
+}
+
+TEST_CASE("Every stage of a sampled tick lands in the trace file", "[trace]") {
+    TraceConfig config;
+    config.path = "test-trace-export.json";
+    config.flushInterval = std::chrono::milliseconds(10);
+    TraceExport trace(config, nullptr);
+    REQUIRE(trace.start());
+
+    const std::uint32_t id = trace.nextTraceId();
+    std::thread messageThread([&]() { trace.record(TraceStage::Enqueue, 1000000, 1002500, id, 7); });
+    messageThread.join();
+    trace.record(TraceStage::Queued, 1002500, 1010000, id, 7);
+    trace.record(TraceStage::Aggregate, 1010000, 1010400, id, 7);
+    trace.record(TraceStage::Serialize, 1011000, 1012000, id, 7);
+    trace.record(TraceStage::Publish, 1012000, 1050000, id, 7);
+    trace.stop();
+
+    REQUIRE(trace.written() == 5);
+    REQUIRE(trace.dropped() == 0);
+    const std::string text = readFile(config.path);
+    std::remove(config.path.c_str());
+    REQUIRE(text.front() == '[');
+    REQUIRE(text.substr(text.size() - 3) == "\n]\n");
+    // Two threads recorded spans: one name record each
+    REQUIRE(occurrences(text, "\"name\":\"thread_name\"") == 2);
+    REQUIRE(text.find("\"ph\":\"X\",\"cat\":\"tick\",\"name\":\"enqueue\"") != std::string::npos);
+    REQUIRE(text.find("\"ts\":1000.000,\"dur\":2.500,\"args\":{\"tick\":" + std::to_string(id) + ",\"slot\":7}")
+            != std::string::npos);
+    REQUIRE(text.find("\"ph\":\"s\",\"cat\":\"tick\",\"name\":\"tick\"") != std::string::npos);
+    REQUIRE(text.find("\"ph\":\"f\",\"cat\":\"tick\",\"name\":\"tick\"") != std::string::npos);
+    REQUIRE(text.find("\"ph\":\"b\",\"cat\":\"tick\",\"name\":\"queued\"") != std::string::npos);
+    REQUIRE(text.find("\"ph\":\"e\",\"cat\":\"tick\",\"name\":\"queued\"") != std::string::npos);
+    REQUIRE(text.find("\"name\":\"publish\"") != std::string::npos);
+    REQUIRE(text.find("\"ts\":1012.000,\"dur\":38.000") != std::string::npos);
+}
@@ -0,0 +1,51 @@
+// test_trade_codes.cpp - Unit tests for exchange / sale condition codes
+
+#include <catch2/catch_test_macros.hpp>
+#include "TradeCodes.h"
+#include <string>
+
+using namespace tws_bridge;
+
+static std::string render(TradeConditions mask) {
+    char buffer[kTradeConditionsMaxChars];
+    return std::string(buffer, writeTradeConditions(buffer, mask));
+}
+
+TEST_CASE("Known exchanges round-trip through their code", "[trade-codes]") {
+    for (std::string_view name : kExchangeNames) {
+        const ExchangeCode code = exchangeCode(name);
+        REQUIRE(code != kUnknownExchange);
+        REQUIRE(exchangeName(code) == name);
+    }
+    REQUIRE(exchangeName(exchangeCode("ARCA")) == "ARCA");
+}
+
+TEST_CASE("Unknown exchanges map to the empty name", "[trade-codes]") {
+    REQUIRE(exchangeCode("") == kUnknownExchange);
+    REQUIRE(exchangeCode("XNYS") == kUnknownExchange);
+    REQUIRE(exchangeCode("arca") == kUnknownExchange);
+    REQUIRE(exchangeName(kUnknownExchange).empty());
+    REQUIRE(exchangeName(0xFF).empty());
+}
+
+TEST_CASE("Sale conditions become one bit per code", "[trade-codes]") {
+    REQUIRE(parseTradeConditions("") == 0);
+    REQUIRE(parseTradeConditions("   ") == 0);
+    REQUIRE(parseTradeConditions("F I") == parseTradeConditions("I F"));
+    REQUIRE(parseTradeConditions("F I F") == parseTradeConditions("FI"));
+    REQUIRE(render(parseTradeConditions("  T")) == "T");
+    REQUIRE(render(parseTradeConditions("I 4 F @")) == "4 F I @");
+    REQUIRE(render(parseTradeConditions("Z")) == "Z");
+}
+
+TEST_CASE("Unknown condition codes collapse into Other", "[trade-codes]") {
+    const TradeConditions mask = parseTradeConditions("a # F");
+    REQUIRE((mask & TradeCondition::Other) != 0);
+    REQUIRE(render(mask) == "F ?");
+
+    TradeConditions all = 0;
+    for (char c : std::string("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ@%")) {
+        all |= parseTradeConditions(std::string_view(&c, 1));
+    }
+    REQUIRE(render(all).size() == kTradeConditionsMaxChars);
+}
@@ -0,0 +1,69 @@
+// test_trade_tape.cpp - Time and sales prints and their per-symbol batching
+
+#include <catch2/catch_test_macros.hpp>
+#include "TradeTape.h"
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+TickUpdate trade(SlotId slot, std::int64_t timestamp, double price, std::int32_t size) {
+    TickUpdate update{};
+    update.type = TickUpdateType::AllLast;
+    update.slot = slot;
+    update.timestamp = timestamp;
+    update.allLast.price = price;
+    update.allLast.size = size;
+    update.allLast.exchange = exchangeCode("NYSE");
+    update.allLast.conditions = parseTradeConditions("@T");
+    return update;
+}
+
+struct Flushed {
+    SlotId slot;
+    std::string payload;
+    std::size_t prints;
+};
+
+} // namespace
+
+TEST_CASE("A print is one compact JSON element", "[tape]") {
+    std::string out;
+    appendTapePrint(trade(1, 1700000000000, 190.55, 100), out);
+    REQUIRE(out == "{\"time\":1700000000000,\"price\":190.55,\"size\":100,\"exchange\":\"NYSE\",\"conditions\":\"T @\"}");
+}
+
+TEST_CASE("One list push per symbol per batch, oldest first, trimmed to keep", "[tape]") {
+    TapeBatch tape(2, 16);
+    tape.add(trade(3, 1, 10.0, 1));
+    tape.add(trade(1, 2, 20.0, 1));
+    tape.add(trade(3, 3, 11.0, 1));
+    tape.add(trade(3, 4, 12.0, 1));
+    REQUIRE_FALSE(tape.empty());
+
+    std::vector<Flushed> flushed;
+    tape.flush([&](SlotId slot, const std::string& payload, std::size_t prints) {
+        flushed.push_back({slot, payload, prints});
+    });
+    REQUIRE(tape.empty());
+    REQUIRE(flushed.size() == 2);
+    REQUIRE(flushed[0].slot == 1);
+    REQUIRE(flushed[0].prints == 1);
+    REQUIRE(flushed[1].slot == 3);
+    REQUIRE(flushed[1].prints == 2);  // REASON: The oldest print would be trimmed anyway - never encoded
+    REQUIRE(flushed[1].payload.find("\"price\":10,") == std::string::npos);
+    REQUIRE(flushed[1].payload.find("\"price\":11,") < flushed[1].payload.find('\n'));
+    REQUIRE(flushed[1].payload.find("\"price\":12,") > flushed[1].payload.find('\n'));
+}
+
+TEST_CASE("Prints beyond the batch capacity are not stored", "[tape]") {
+    TapeBatch tape(500, 2);
+    for (std::int64_t t = 0; t < 5; ++t) {
+        tape.add(trade(0, t, 1.0, 1));
+    }
+    std::size_t total = 0;
+    tape.flush([&](SlotId, const std::string&, std::size_t prints) { total += prints; });
+    REQUIRE(total == 2);
+}
@@ -0,0 +1,41 @@
+// test_tsc_clock.cpp - Unit tests for the TSC-backed receive clock
+
+#include <catch2/catch_test_macros.hpp>
+#include "TscClock.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace tws_bridge;
+
+TEST_CASE("TSC clock tracks the wall clock", "[tsc-clock]") {
+    TscClock clock;
+    const std::int64_t before = systemNowNs();
+    const std::int64_t stamp = clock.nowNs();
+    const std::int64_t after = systemNowNs();
+    // REASON: Calibration error over a 10 ms window - generous bound, the test box may be busy
+    REQUIRE(stamp >= before - 1000000);
+    REQUIRE(stamp <= after + 1000000);
+
+    if (clock.invariant()) {
+        REQUIRE(clock.ticksPerNs() > 0.0);
+    } else {
+        REQUIRE(clock.ticksPerNs() == 0.0);
+    }
+}
+
+TEST_CASE("TSC clock stamps advance and survive a rebase", "[tsc-clock]") {
+    TscClock clock;
+    const std::int64_t first = clock.nowNs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    const std::int64_t second = clock.nowNs();
+    REQUIRE(second - first >= 4000000);
+
+    clock.rebase();
+    const std::int64_t before = systemNowNs();
+    const std::int64_t third = clock.nowNs();
+    REQUIRE(third > second);
+    REQUIRE(third >= before - 1000000);
+    REQUIRE(&receiveClock() == &receiveClock());
+}
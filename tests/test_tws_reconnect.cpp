@@ -0,0 +1,73 @@
+// test_tws_reconnect.cpp - In-process reconnect against a loopback fake Gateway: subscriptions replayed once
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "ShardRouter.h"
+#include "TwsTestSupport.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace tws_bridge;
+using namespace tws_bridge::tws_test;
+
+namespace {
+
+std::vector<Request> sorted(std::vector<Request> requests) {
+    std::sort(requests.begin(), requests.end());
+    return requests;
+}
+
+} // namespace
+
+TEST_CASE("Reconnect re-requests every active subscription once under its original tickerId", "[tws][reconnect]") {
+    FakeGateway gateway;
+    InstrumentRegistry registry(16);
+    SpscTickQueue queue(1024);
+    Client client(queue, registry);
+    ReconnectPolicy policy;
+    policy.initialDelay = std::chrono::milliseconds(10);
+    policy.maxAttempts = 20;
+    client.setReconnectPolicy(policy);
+
+    client.subscribeTickByTick("AAPL", 1);
+    client.subscribeMarketData("MSFT", 2);
+    const SlotId aapl = registry.find("AAPL");
+    const SlotId msft = registry.find("MSFT");
+    REQUIRE(aapl != kInvalidSlot);
+    REQUIRE(msft != kInvalidSlot);
+
+    REQUIRE(client.createConnection("127.0.0.1", gateway.port(), 7, ReaderMode::BridgeRing));  // Bridge default
+    const std::vector<Request> expected{{REQ_TICK_BY_TICK_DATA, 1, "AAPL", "BidAsk"},
+                                        {REQ_MKT_DATA, 2, "MSFT", ""},
+                                        {REQ_TICK_BY_TICK_DATA, 10001, "AAPL", "AllLast"}};
+    REQUIRE(pump(client, [&]() { return gateway.requests(0).size() == expected.size(); }));
+    REQUIRE(sorted(gateway.requests(0)) == sorted(expected));
+
+    gateway.drop();
+    REQUIRE(pump(client, [&]() { return !client.isConnected(); }));
+    std::atomic<bool> running{true};
+    REQUIRE(client.reconnect(running));
+    REQUIRE(pump(client, [&]() { return gateway.requests(1).size() >= expected.size(); }));
+
+    // REASON: Keep dispatching a while - a request queued twice (old ticket + replay) would show up late
+    const auto settle = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    pump(client, [&]() { return std::chrono::steady_clock::now() > settle; });
+    REQUIRE(sorted(gateway.requests(1)) == sorted(expected));
+    REQUIRE(client.counters().reconnects.load() == 1);
+    REQUIRE(client.subscriptionCount() == 2);
+    REQUIRE(registry.size() == 2);  // Nothing registered again
+
+    // The replayed tickerId still routes to the slot of the first session
+    // TICK_BY_TICK BidAsk: reqId, tickType 3, time, bid, ask, bidSize, askSize, attrMask
+    gateway.send(frame({std::to_string(TICK_BY_TICK), "1", "3", "1700000000", "171.5", "171.52", "100", "200", "0"}));
+    TickUpdate update;
+    REQUIRE(pump(client, [&]() { return queue.try_dequeue(update); }));
+    REQUIRE(update.slot == aapl);
+    REQUIRE(update.type == TickUpdateType::BidAsk);
+    REQUIRE(update.bidAsk.bidPrice == 171.5);
+
+    client.disconnect();
+}
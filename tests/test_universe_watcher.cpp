@@ -0,0 +1,78 @@
+// test_universe_watcher.cpp - Universe file parsing, diffs and file polling
+
+#include <catch2/catch_test_macros.hpp>
+#include "UniverseWatcher.h"
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tws_bridge;
+
+namespace {
+
+std::vector<std::string> universe(std::size_t count) {
+    std::vector<std::string> symbols;
+    for (std::size_t i = 0; i < count; ++i) {
+        symbols.push_back("S" + std::to_string(100000 + i));
+    }
+    return symbols;  // NOTE: Fixed width - already sorted
+}
+
+} // namespace
+
+TEST_CASE("Universe files list symbols with comments, in any separator", "[universe]") {
+    const std::vector<std::string> symbols = parseUniverse("# equities\nMSFT\nAAPL, NVDA  # mega caps\r\n\nAAPL\tSPY\n#QQQ\n");
+    REQUIRE(symbols == std::vector<std::string>{"AAPL", "MSFT", "NVDA", "SPY"});
+    REQUIRE(parseUniverse("").empty());
+    REQUIRE(parseUniverse("# nothing\n").empty());
+}
+
+TEST_CASE("Changing 2,000 symbols by 10 names costs 10 commands", "[universe]") {
+    const std::vector<std::string> current = universe(2000);
+    std::vector<std::string> next(current.begin() + 5, current.end());
+    for (int i = 0; i < 5; ++i) {
+        next.push_back("T" + std::to_string(i));
+    }
+    std::sort(next.begin(), next.end());
+    const UniverseDiff diff = diffUniverse(current, next);
+    REQUIRE(diff.added.size() == 5);
+    REQUIRE(diff.removed.size() == 5);
+    REQUIRE(diff.removed.front() == "S100000");
+
+    // Pinned symbols (subscriptions.symbols) are neither added nor cancelled
+    const UniverseDiff pinned = diffUniverse({"AAPL", "MSFT"}, {"MSFT", "NVDA"}, {"AAPL", "NVDA"});
+    REQUIRE(pinned.added.empty());
+    REQUIRE(pinned.removed.empty());
+}
+
+TEST_CASE("A rewritten universe file is applied as a diff, a missing one is skipped", "[universe]") {
+    const std::string path = "/tmp/tws-bridge-test-universe-" + std::to_string(::getpid()) + ".txt";
+    std::ofstream(path) << "AAPL\nMSFT\nSPY\n";
+    UniverseConfig config;
+    config.path = path;
+    config.pollInterval = std::chrono::milliseconds(20);
+    std::vector<UniverseDiff> diffs;
+    UniverseWatcher watcher("", config, {"SPY"}, [&diffs](const UniverseDiff& diff) { diffs.push_back(diff); });
+    REQUIRE(watcher.load());
+    REQUIRE(diffs.size() == 1);
+    REQUIRE(diffs[0].added == std::vector<std::string>{"AAPL", "MSFT"});
+
+    watcher.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    REQUIRE(diffs.size() == 1);  // REASON: Unchanged file - no diff
+    std::ofstream(path) << "AAPL\nNVDA\nSPY\nTSLA\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    ::unlink(path.c_str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    watcher.stop();
+
+    REQUIRE(diffs.size() == 2);
+    REQUIRE(diffs[1].added == std::vector<std::string>{"NVDA", "TSLA"});
+    REQUIRE(diffs[1].removed == std::vector<std::string>{"MSFT"});
+    REQUIRE(watcher.counters().size.load() == 4);
+    REQUIRE(watcher.counters().errors.load() > 0);  // NOTE: The unlinked file - the universe stays
+}
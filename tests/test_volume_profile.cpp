@@ -0,0 +1,86 @@
+// test_volume_profile.cpp - Volume at price buckets, chunked growth and the delta / full payloads
+
+#include <catch2/catch_test_macros.hpp>
+#include "VolumeProfile.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+constexpr std::int64_t kSessionStart = 1700038800000;  // 2023-11-15 09:00 UTC, a session boundary at 09:00
+
+VolumeProfileConfig config(std::size_t chunk, std::size_t max) {
+    VolumeProfileConfig result;
+    result.bucketWidth = 0.05;
+    result.chunkBuckets = chunk;
+    result.maxBuckets = max;
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Trades add to the bucket of their price", "[volume-profile]") {
+    VolumeProfile profile(config(8, 64), "TWS:PROFILE:AAPL");
+    const std::int64_t t = kSessionStart + 1000;
+    profile.onTrade(t, 100.00, 100);
+    profile.onTrade(t, 100.02, 50);   // Rounds to the open's bucket
+    profile.onTrade(t, 100.05, 10);
+    profile.onTrade(t, 99.95, 5);
+    REQUIRE(profile.volumeAt(100.00) == 150);
+    REQUIRE(profile.volumeAt(100.05) == 10);
+    REQUIRE(profile.volumeAt(99.95) == 5);
+    REQUIRE(profile.buckets() == 8);
+    profile.onTrade(t, 0.0, 10);      // Ignored
+    REQUIRE(profile.volumeAt(0.0) == 0);
+}
+
+TEST_CASE("The array grows by chunks and folds into the edge at the cap", "[volume-profile]") {
+    VolumeProfile profile(config(8, 24), "TWS:PROFILE:AAPL");
+    const std::int64_t t = kSessionStart + 1000;
+    profile.onTrade(t, 100.00, 1);
+    profile.onTrade(t, 100.50, 2);    // Bucket 10: past 3, one chunk up
+    REQUIRE(profile.buckets() == 16);
+    REQUIRE(profile.volumeAt(100.50) == 2);
+    profile.onTrade(t, 99.50, 3);     // Bucket -10: past -4, one chunk down
+    REQUIRE(profile.buckets() == 24);
+    REQUIRE(profile.volumeAt(99.50) == 3);
+    profile.onTrade(t, 110.00, 4);    // At the cap: the top bucket takes it
+    REQUIRE(profile.buckets() == 24);
+    REQUIRE(profile.volumeAt(100.55) == 4);
+}
+
+TEST_CASE("Deltas carry the changed buckets, the full profile all of them", "[volume-profile]") {
+    VolumeProfile profile(config(8, 64), "TWS:PROFILE:AAPL");
+    const std::int64_t t = kSessionStart + 1000;
+    std::string out;
+    profile.onTrade(t, 100.00, 100);
+    profile.onTrade(t, 100.05, 10);
+    REQUIRE(profile.changed());
+    profile.encode("\"AAPL\"", false, out);
+    REQUIRE(out == "{\"instrument\":\"AAPL\",\"session\":19676,\"open\":100.00,\"width\":0.05,\"seq\":1,\"total\":110,"
+                   "\"reset\":true,\"buckets\":[[100.00,100],[100.05,10]]}");
+    REQUIRE_FALSE(profile.changed());
+    profile.onTrade(t, 100.05, 5);
+    profile.encode("\"AAPL\"", false, out);
+    REQUIRE(out == "{\"instrument\":\"AAPL\",\"session\":19676,\"open\":100.00,\"width\":0.05,\"seq\":2,\"total\":115,"
+                   "\"buckets\":[[100.05,15]]}");
+    profile.encode("\"AAPL\"", true, out);
+    REQUIRE(out == "{\"instrument\":\"AAPL\",\"session\":19676,\"open\":100.00,\"width\":0.05,\"seq\":2,\"total\":115,"
+                   "\"reset\":true,\"buckets\":[[100.00,100],[100.05,15]]}");
+}
+
+TEST_CASE("A new session recenters and resets", "[volume-profile]") {
+    VolumeProfile profile(config(8, 64), "TWS:PROFILE:AAPL");
+    std::string out;
+    profile.onTrade(kSessionStart + 1000, 100.00, 100);
+    profile.encode("\"AAPL\"", false, out);
+    profile.onTrade(kSessionStart + 86400000, 120.00, 7);
+    REQUIRE(profile.volumeAt(100.00) == 0);
+    REQUIRE(profile.volumeAt(120.00) == 7);
+    profile.encode("\"AAPL\"", false, out);
+    REQUIRE(out.find("\"reset\":true") != std::string::npos);
+    REQUIRE(out.find("\"open\":120.00") != std::string::npos);
+}
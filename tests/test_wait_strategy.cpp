@@ -0,0 +1,119 @@
+// test_wait_strategy.cpp - Unit tests for consumer wait strategies
+
+#include <catch2/catch_test_macros.hpp>
+#include "WaitStrategy.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace tws_bridge;
+
+TEST_CASE("Blocking waiter parks until timeout when idle", "[wait]") {
+    WaitConfig config;
+    config.mode = WaitMode::Blocking;
+    config.parkTimeout = std::chrono::microseconds(2000);
+    ConsumerWaiter waiter(config);
+    
+    auto start = std::chrono::steady_clock::now();
+    waiter.idle([]() { return false; });
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    REQUIRE(waiter.parkCount() == 1);
+    REQUIRE(elapsed >= std::chrono::microseconds(1000));
+}
+
+TEST_CASE("Waiter re-checks for work before parking", "[wait]") {
+    WaitConfig config;
+    config.mode = WaitMode::Blocking;
+    config.parkTimeout = std::chrono::seconds(5);
+    ConsumerWaiter waiter(config);
+    
+    waiter.idle([]() { return true; });
+    REQUIRE(waiter.parkCount() == 0);
+}
+
+TEST_CASE("Producer notify wakes a parked consumer", "[wait]") {
+    WaitConfig config;
+    config.mode = WaitMode::Blocking;
+    config.parkTimeout = std::chrono::seconds(5);
+    ConsumerWaiter waiter(config);
+    std::atomic<bool> work{false};
+    
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        work.store(true);
+        waiter.notify();
+    });
+    
+    auto start = std::chrono::steady_clock::now();
+    while (!work.load()) {
+        waiter.idle([&]() { return work.load(); });
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    producer.join();
+    
+    REQUIRE(elapsed < std::chrono::seconds(2));
+}
+
+TEST_CASE("Hybrid waiter spins before parking", "[wait]") {
+    WaitConfig config;
+    config.mode = WaitMode::Hybrid;
+    config.spinIterations = 10;
+    config.yieldIterations = 5;
+    config.parkTimeout = std::chrono::microseconds(100);
+    ConsumerWaiter waiter(config);
+    
+    for (int i = 0; i < 15; ++i) {
+        waiter.idle([]() { return false; });
+    }
+    REQUIRE(waiter.parkCount() == 0);
+    
+    waiter.idle([]() { return false; });
+    REQUIRE(waiter.parkCount() == 1);
+    
+    waiter.reset();
+    waiter.idle([]() { return false; });
+    REQUIRE(waiter.parkCount() == 1);
+}
+
+TEST_CASE("Reactor waiter wakes on notify, not on its park timeout", "[wait]") {
+    WaitConfig config;
+    config.mode = WaitMode::Reactor;
+    config.parkTimeout = std::chrono::seconds(5);
+    ConsumerWaiter waiter(config);
+    REQUIRE(waiter.reactor() != nullptr);
+    std::atomic<bool> work{false};
+
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        work.store(true);
+        waiter.notify();
+    });
+    const auto start = std::chrono::steady_clock::now();
+    while (!work.load()) {
+        waiter.idle([&]() { return work.load(); });
+    }
+    producer.join();
+    REQUIRE(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+    REQUIRE(waiter.reactor()->counters().wakes >= 1);
+}
+
+TEST_CASE("Reactor waiter sleeps until the consumer's deadline", "[wait]") {
+    WaitConfig config;
+    config.mode = WaitMode::Reactor;
+    config.parkTimeout = std::chrono::seconds(5);
+    ConsumerWaiter waiter(config);
+
+    const auto start = std::chrono::steady_clock::now();
+    waiter.idle([]() { return false; }, start + std::chrono::milliseconds(10));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    REQUIRE(elapsed >= std::chrono::milliseconds(10));
+    REQUIRE(elapsed < std::chrono::seconds(2));
+    REQUIRE(waiter.reactor()->counters().deadlines == 1);
+
+    // NOTE: No deadline - park_timeout still bounds the wait
+    config.parkTimeout = std::chrono::milliseconds(5);
+    ConsumerWaiter capped(config);
+    capped.idle([]() { return false; });
+    REQUIRE(capped.parkCount() == 1);
+}
@@ -0,0 +1,113 @@
+// test_warm_start.cpp - Unit tests for rebuilding instrument state from last-value snapshots
+
+#include <catch2/catch_test_macros.hpp>
+#include "WarmStart.h"
+#include "SnapshotEncoder.h"
+#include <cstring>
+#include <string>
+
+using namespace tws_bridge;
+
+namespace {
+
+InstrumentState publishedState() {
+    InstrumentState state;
+    state.symbol = "AAPL";
+    state.conId = 265598;
+    state.primaryExchange = "NASDAQ";
+    state.bidPrice = 171.55;
+    state.askPrice = 171.57;
+    state.lastPrice = 171.56;
+    state.bidSize = 100;
+    state.askSize = 200;
+    state.lastSize = 50;
+    state.quoteTimestamp = 1700000000000;
+    state.tradeTimestamp = 1700000000500;
+    state.hasQuote = true;
+    state.hasTrade = true;
+    state.exchange = "ARCA";
+    state.tradeConditions = parseTradeConditions("F I");
+    state.pastLimit = true;
+    state.sequence = 4711;
+    return state;
+}
+
+void requireRestored(const InstrumentState& restored, const InstrumentState& expected) {
+    REQUIRE(restored.sequence == expected.sequence);
+    REQUIRE(restored.conId == expected.conId);
+    REQUIRE(restored.primaryExchange == expected.primaryExchange);
+    REQUIRE(restored.bidPrice == expected.bidPrice);
+    REQUIRE(restored.askPrice == expected.askPrice);
+    REQUIRE(restored.lastPrice == expected.lastPrice);
+    REQUIRE(restored.bidSize == expected.bidSize);
+    REQUIRE(restored.askSize == expected.askSize);
+    REQUIRE(restored.lastSize == expected.lastSize);
+    REQUIRE(restored.quoteTimestamp == expected.quoteTimestamp);
+    REQUIRE(restored.tradeTimestamp == expected.tradeTimestamp);
+    REQUIRE(restored.hasQuote == expected.hasQuote);
+    REQUIRE(restored.hasTrade == expected.hasTrade);
+    REQUIRE(restored.exchange == expected.exchange);
+    REQUIRE(restored.tradeConditions == expected.tradeConditions);
+    REQUIRE(restored.pastLimit == expected.pastLimit);
+}
+
+} // namespace
+
+TEST_CASE("Snapshots of every schema and price format are restored", "[warm-start]") {
+    const InstrumentState published = publishedState();
+    JsonBuffer json;
+
+    SECTION("Verbose") {
+        encodeSnapshot(published, json, SnapshotSchema::Verbose);
+    }
+    SECTION("Compact") {
+        encodeSnapshot(published, json, SnapshotSchema::Compact);
+    }
+    SECTION("Fixed point prices with ISO time and derived metrics") {
+        encodeSnapshot(published, json, SnapshotSchema::Compact, true, true, PriceFormat::FixedPoint);
+    }
+
+    InstrumentState restored;
+    REQUIRE(parseLastValue(json.data(), json.size(), restored));
+    requireRestored(restored, published);
+    REQUIRE(restored.symbol.empty());  // Owned by the worker (registry slot)
+}
+
+TEST_CASE("Exchange names are mapped onto the static TradeCodes table", "[warm-start]") {
+    const InstrumentState published = publishedState();
+    JsonBuffer json;
+    encodeSnapshot(published, json);
+    const std::string copy = json.str();
+
+    InstrumentState restored;
+    REQUIRE(parseLastValue(copy.data(), copy.size(), restored));
+    REQUIRE(restored.exchange.data() == exchangeName(exchangeCode("ARCA")).data());
+    REQUIRE(restored.primaryExchange.data() == exchangeName(exchangeCode("NASDAQ")).data());
+}
+
+TEST_CASE("Partial snapshots restore only what was seen", "[warm-start]") {
+    InstrumentState published = publishedState();
+    published.tradeTimestamp = 0;
+    published.lastPrice = 0.0;
+    published.lastSize = 0;
+    published.exchange = "VENUE-X";  // Not in TradeCodes.h
+    JsonBuffer json;
+    encodeSnapshot(published, json);
+
+    InstrumentState restored;
+    REQUIRE(parseLastValue(json.data(), json.size(), restored));
+    REQUIRE(restored.hasQuote);
+    REQUIRE_FALSE(restored.hasTrade);
+    REQUIRE(restored.exchange.empty());
+}
+
+TEST_CASE("Anything but a snapshot object is rejected", "[warm-start]") {
+    InstrumentState restored;
+    const char* notJson = "{\"instrument\":";
+    const char* array = "[1,2]";
+    const char* bar = "{\"timestamp\":1700000000000,\"open\":100.0}";
+
+    REQUIRE_FALSE(parseLastValue(notJson, std::strlen(notJson), restored));
+    REQUIRE_FALSE(parseLastValue(array, std::strlen(array), restored));
+    REQUIRE_FALSE(parseLastValue(bar, std::strlen(bar), restored));
+}
@@ -0,0 +1,239 @@
+// test_websocket.cpp - RFC 6455 handshake / framing and the WebSocket gateway over loopback
+
+#include <catch2/catch_test_macros.hpp>
+#include "InstrumentRegistry.h"
+#include "WebSocket.h"
+#include "WebSocketGateway.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace tws_bridge;
+
+namespace {
+
+// Masked client frame (what a browser sends)
+std::string clientFrame(WsOpcode opcode, const std::string& payload) {
+    const char mask[4] = {0x12, 0x34, 0x56, 0x78};
+    std::string frame;
+    frame += static_cast<char>(0x80 | static_cast<std::uint8_t>(opcode));
+    frame += static_cast<char>(0x80 | payload.size());  // NOTE: Test payloads stay under 126 bytes
+    frame.append(mask, 4);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        frame += static_cast<char>(payload[i] ^ mask[i % 4]);
+    }
+    return frame;
+}
+
+int connectTo(std::uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    timeval timeout{2, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    ::inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void sendText(int fd, const std::string& bytes) {
+    REQUIRE(::send(fd, bytes.data(), bytes.size(), 0) == static_cast<ssize_t>(bytes.size()));
+}
+
+// Reads until `count` bytes arrived (or the receive timeout hits)
+std::string receive(int fd, std::size_t count) {
+    std::string out;
+    char buffer[4096];
+    while (out.size() < count) {
+        const ssize_t received = ::recv(fd, buffer, std::min(sizeof(buffer), count - out.size()), 0);
+        if (received <= 0) {
+            break;
+        }
+        out.append(buffer, static_cast<std::size_t>(received));
+    }
+    return out;
+}
+
+// Payload of the next unmasked server frame (short frames only)
+std::string receiveFrame(int fd) {
+    const std::string header = receive(fd, 2);
+    if (header.size() != 2) {
+        return "<none>";
+    }
+    return receive(fd, static_cast<std::uint8_t>(header[1]));
+}
+
+} // namespace
+
+TEST_CASE("Accept key matches the RFC 6455 example", "[websocket]") {
+    REQUIRE(websocketAccept("dGhlIHNhbXBsZSBub25jZQ==") == "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+    const std::string request = "GET /ticks HTTP/1.1\r\nHost: bridge\r\nUpgrade: WebSocket\r\n"
+                                "Connection: Upgrade\r\nsec-websocket-key:  dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                                "Sec-WebSocket-Version: 13\r\n";
+    REQUIRE(upgradeKey(request) == "dGhlIHNhbXBsZSBub25jZQ==");
+    REQUIRE(upgradeKey("GET / HTTP/1.1\r\nHost: bridge\r\n").empty());
+    REQUIRE(upgradeResponse("dGhlIHNhbXBsZSBub25jZQ==").find("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n")
+            != std::string::npos);
+}
+
+TEST_CASE("Server frame headers use the shortest length encoding", "[websocket]") {
+    char header[kWsMaxHeader];
+    REQUIRE(writeFrameHeader(header, WsOpcode::Text, 125) == 2);
+    REQUIRE(static_cast<std::uint8_t>(header[0]) == 0x81);
+    REQUIRE(header[1] == 125);
+    REQUIRE(writeFrameHeader(header, WsOpcode::Binary, 300) == 4);
+    REQUIRE(static_cast<std::uint8_t>(header[0]) == 0x82);
+    REQUIRE(static_cast<std::uint8_t>(header[1]) == 126);
+    REQUIRE(((static_cast<std::uint8_t>(header[2]) << 8) | static_cast<std::uint8_t>(header[3])) == 300);
+    REQUIRE(writeFrameHeader(header, WsOpcode::Text, 70000) == 10);
+    REQUIRE(static_cast<std::uint8_t>(header[1]) == 127);
+}
+
+TEST_CASE("Client frames are unmasked in place and checked", "[websocket]") {
+    std::string bytes = clientFrame(WsOpcode::Text, "SUBSCRIBE AAPL") + clientFrame(WsOpcode::Ping, "");
+    WsFrame frame;
+    std::size_t consumed = 0;
+    REQUIRE(parseClientFrame(bytes.data(), 5, 4096, frame, consumed) == WsParse::Incomplete);
+    REQUIRE(parseClientFrame(bytes.data(), bytes.size(), 4096, frame, consumed) == WsParse::Frame);
+    REQUIRE(frame.fin);
+    REQUIRE(frame.opcode == WsOpcode::Text);
+    REQUIRE(frame.payload == "SUBSCRIBE AAPL");
+    REQUIRE(parseClientFrame(bytes.data() + consumed, bytes.size() - consumed, 4096, frame, consumed)
+            == WsParse::Frame);
+    REQUIRE(frame.opcode == WsOpcode::Ping);
+
+    // PITFALL: Unmasked and oversize frames close the connection
+    std::string unmasked;
+    appendFrame(unmasked, WsOpcode::Text, "SUBSCRIBE AAPL");
+    REQUIRE(parseClientFrame(unmasked.data(), unmasked.size(), 4096, frame, consumed) == WsParse::Error);
+    std::string large = clientFrame(WsOpcode::Text, "SUBSCRIBE AAPL");
+    REQUIRE(parseClientFrame(large.data(), large.size(), 8, frame, consumed) == WsParse::Error);
+}
+
+TEST_CASE("Gateway upgrades, sends the latest snapshot on subscribe, then live ones", "[websocket]") {
+    InstrumentRegistry registry(16);
+    const SlotId aapl = registry.registerInstrument("AAPL");
+    const SlotId msft = registry.registerInstrument("MSFT");
+    WebSocketConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = 0;
+    WebSocketGateway gateway(registry, config);
+    REQUIRE(gateway.start());
+
+    // Published before anyone subscribed - kept as the symbol's latest
+    SnapshotRecord before{"TWS:TICKS:AAPL", "{\"bid\":1}", aapl, {}};
+    gateway.onBatch(&before, 1);
+
+    const int fd = connectTo(gateway.port());
+    REQUIRE(fd >= 0);
+    sendText(fd, "GET / HTTP/1.1\r\nHost: bridge\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                 "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Version: 13\r\n\r\n");
+    const std::string expected = upgradeResponse("dGhlIHNhbXBsZSBub25jZQ==");
+    REQUIRE(receive(fd, expected.size()) == expected);
+
+    sendText(fd, clientFrame(WsOpcode::Text, "SUBSCRIBE AAPL"));
+    REQUIRE(receiveFrame(fd) == "{\"bid\":1}");
+
+    // Only subscribed symbols arrive
+    SnapshotRecord live[2] = {{"TWS:TICKS:MSFT", "{\"bid\":9}", msft, {}}, {"TWS:TICKS:AAPL", "{\"bid\":2}", aapl, {}}};
+    gateway.onBatch(live, 2);
+    REQUIRE(receiveFrame(fd) == "{\"bid\":2}");
+
+    // A symbol registered after the subscription is picked up once it exists
+    sendText(fd, clientFrame(WsOpcode::Text, "SUBSCRIBE NVDA"));
+    sendText(fd, clientFrame(WsOpcode::Ping, "hi"));
+    REQUIRE(receiveFrame(fd) == "hi");  // Pong: the command before it was handled
+    const SlotId nvda = registry.registerInstrument("NVDA");
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    SnapshotRecord late{"TWS:TICKS:NVDA", "{\"bid\":5}", nvda, {}};
+    gateway.onBatch(&late, 1);
+    REQUIRE(receiveFrame(fd) == "{\"bid\":5}");
+
+    REQUIRE(gateway.counters().connections.load() == 1);
+    ::close(fd);
+    gateway.stop();  // REASON: Joins the gateway thread - frames is counted just after the bytes went out
+    REQUIRE(gateway.counters().frames.load() == 3);
+}
+
+TEST_CASE("A client that stops reading gets conflated frames, not a growing backlog", "[websocket]") {
+    InstrumentRegistry registry(4);
+    const SlotId aapl = registry.registerInstrument("AAPL");
+    WebSocketConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = 0;
+    WebSocketGateway gateway(registry, config);
+    REQUIRE(gateway.start());
+    const int fd = connectTo(gateway.port());
+    REQUIRE(fd >= 0);
+    sendText(fd, "GET / HTTP/1.1\r\nUpgrade: websocket\r\nSec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n\r\n");
+    sendText(fd, clientFrame(WsOpcode::Text, "SUBSCRIBE AAPL"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // NOTE: Far more than the socket buffers hold - the rest must conflate into one queued frame
+    const std::string payload(256 * 1024, 'x');
+    for (int i = 0; i < 64; ++i) {
+        SnapshotRecord record{"TWS:TICKS:AAPL", payload, aapl, {}};
+        gateway.onBatch(&record, 1);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    REQUIRE(gateway.counters().conflated.load() > 0);
+    REQUIRE(gateway.counters().frames.load() + gateway.counters().conflated.load() <= 64);
+    ::close(fd);
+    gateway.stop();
+}
+
+TEST_CASE("Past the memory budget the connection with the largest backlog is closed", "[websocket][memory]") {
+    InstrumentRegistry registry(4);
+    const SlotId aapl = registry.registerInstrument("AAPL");
+    WebSocketConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = 0;
+    config.memoryBudget = 64 * 1024;
+    WebSocketGateway gateway(registry, config);
+    REQUIRE(gateway.start());
+    const int fd = connectTo(gateway.port());
+    REQUIRE(fd >= 0);
+    sendText(fd, "GET / HTTP/1.1\r\nUpgrade: websocket\r\nSec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n\r\n");
+    sendText(fd, clientFrame(WsOpcode::Text, "SUBSCRIBE AAPL"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // NOTE: The client reads nothing - its backlog outgrows the budget once the socket buffers fill
+    const std::string payload(256 * 1024, 'x');
+    for (int i = 0; i < 64; ++i) {
+        SnapshotRecord record{"TWS:TICKS:AAPL", payload, aapl, {}};
+        gateway.onBatch(&record, 1);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    REQUIRE(gateway.counters().overBudget.load() == 1);
+    REQUIRE(gateway.counters().connections.load() == 0);
+    REQUIRE(gateway.counters().bufferedBytes.load() <= config.memoryBudget);
+    ::close(fd);
+    gateway.stop();
+}
+
+TEST_CASE("Gateway answers a plain HTTP request with 400", "[websocket]") {
+    InstrumentRegistry registry(4);
+    WebSocketConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = 0;
+    WebSocketGateway gateway(registry, config);
+    REQUIRE(gateway.start());
+    const int fd = connectTo(gateway.port());
+    REQUIRE(fd >= 0);
+    sendText(fd, "GET /metrics HTTP/1.1\r\nHost: bridge\r\n\r\n");
+    REQUIRE(receive(fd, 12) == "HTTP/1.1 400");
+    ::close(fd);
+    gateway.stop();
+    REQUIRE(gateway.counters().rejected.load() == 1);
+}